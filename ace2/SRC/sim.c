@@ -1,3 +1,8 @@
+#include <stdint.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
 #include "vtr_assert.h"
 
 #include "ace.h"
@@ -7,10 +12,11 @@
 #include "bdd/cudd/cuddInt.h"
 
 void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int cycle);
-int * getFaninValues(Abc_Obj_t * obj_ptr);
+int getFaninValues(Abc_Obj_t * obj_ptr, int * faninValues);
 ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr);
-void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int cycle);
+void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int cycle, int * faninValues);
 void update_FFs(Abc_Ntk_t * ntk);
+void ace_sim_activities_bit_parallel(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, Vec_Ptr_t * logic_nodes, int max_cycles);
 
 void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * /*nodes*/, int cycle) {
 	Abc_Obj_t * obj;
@@ -19,113 +25,112 @@ void get_pi_values(Abc_Ntk_t * ntk, Vec_Ptr_t * /*nodes*/, int cycle) {
 	double prob0to1, prob1to0, rand_num;
 
 	//Vec_PtrForEachEntry(Abc_Obj_t *, nodes, obj, i)
-	Abc_NtkForEachObj(ntk, obj, i)
+	Abc_NtkForEachPi(ntk, obj, i)
 	{
 		info = Ace_ObjInfo(obj);
-		if (Abc_ObjType(obj) == ABC_OBJ_PI) {
-			if (info->values) {
-				if (info->status == ACE_UNDEF) {
-					info->status = ACE_NEW;
+		if (info->values) {
+			if (info->status == ACE_UNDEF) {
+				info->status = ACE_NEW;
+				if (info->values[cycle] == 1) {
+					info->value = 1;
+					info->num_toggles = 1;
+					info->num_ones = 1;
+				} else {
+					info->value = 0;
+					info->num_toggles = 0;
+					info->num_ones = 0;
+				}
+			} else {
+				switch (info->value) {
+				case 0:
 					if (info->values[cycle] == 1) {
 						info->value = 1;
-						info->num_toggles = 1;
-						info->num_ones = 1;
+						info->status = ACE_NEW;
+						info->num_toggles++;
+						info->num_ones++;
 					} else {
-						info->value = 0;
-						info->num_toggles = 0;
-						info->num_ones = 0;
+						info->status = ACE_OLD;
 					}
-				} else {
-					switch (info->value) {
-					case 0:
-						if (info->values[cycle] == 1) {
-							info->value = 1;
-							info->status = ACE_NEW;
-							info->num_toggles++;
-							info->num_ones++;
-						} else {
-							info->status = ACE_OLD;
-						}
-						break;
-
-					case 1:
-						if (info->values[cycle] == 0) {
-							info->value = 0;
-							info->status = ACE_NEW;
-							info->num_toggles++;
-						} else {
-							info->num_ones++;
-							info->status = ACE_OLD;
-						}
-						break;
-
-					default:
-						printf("Bad Value\n");
-						VTR_ASSERT(0);
-						break;
+					break;
+
+				case 1:
+					if (info->values[cycle] == 0) {
+						info->value = 0;
+						info->status = ACE_NEW;
+						info->num_toggles++;
+					} else {
+						info->num_ones++;
+						info->status = ACE_OLD;
 					}
+					break;
+
+				default:
+					printf("Bad Value\n");
+					VTR_ASSERT(0);
+					break;
 				}
-			} else {
-				prob0to1 = ACE_P0TO1(info->static_prob, info->switch_prob);
-				prob1to0 = ACE_P1TO0(info->static_prob, info->switch_prob);
+			}
+		} else {
+			prob0to1 = ACE_P0TO1(info->static_prob, info->switch_prob);
+			prob1to0 = ACE_P1TO0(info->static_prob, info->switch_prob);
 
                 //We don't need a cryptographically secure random number
                 //generator so suppress warning in coverity
                 //
                 //coverity[dont_call]
-				rand_num = (double) rand() / (double) RAND_MAX;
-
-				if (info->status == ACE_UNDEF) {
-					info->status = ACE_NEW;
+			rand_num = (double) rand() / (double) RAND_MAX;
+
+			if (info->status == ACE_UNDEF) {
+				info->status = ACE_NEW;
+				if (rand_num < prob0to1) {
+					info->value = 1;
+					info->num_toggles = 1;
+					info->num_ones = 1;
+				} else {
+					info->value = 0;
+					info->num_toggles = 0;
+					info->num_ones = 0;
+				}
+			} else {
+				switch (info->value) {
+				case 0:
 					if (rand_num < prob0to1) {
 						info->value = 1;
-						info->num_toggles = 1;
-						info->num_ones = 1;
+						info->status = ACE_NEW;
+						info->num_toggles++;
+						info->num_ones++;
 					} else {
-						info->value = 0;
-						info->num_toggles = 0;
-						info->num_ones = 0;
+						info->status = ACE_OLD;
 					}
-				} else {
-					switch (info->value) {
-					case 0:
-						if (rand_num < prob0to1) {
-							info->value = 1;
-							info->status = ACE_NEW;
-							info->num_toggles++;
-							info->num_ones++;
-						} else {
-							info->status = ACE_OLD;
-						}
-						break;
-
-					case 1:
-						if (rand_num < prob1to0) {
-							info->value = 0;
-							info->status = ACE_NEW;
-							info->num_toggles++;
-						} else {
-							info->num_ones++;
-							info->status = ACE_OLD;
-						}
-						break;
-
-					default:
-						printf("Bad value\n");
-						VTR_ASSERT(FALSE);
-						break;
+					break;
+
+				case 1:
+					if (rand_num < prob1to0) {
+						info->value = 0;
+						info->status = ACE_NEW;
+						info->num_toggles++;
+					} else {
+						info->num_ones++;
+						info->status = ACE_OLD;
 					}
+					break;
+
+				default:
+					printf("Bad value\n");
+					VTR_ASSERT(FALSE);
+					break;
 				}
 			}
 		}
 	}
 }
 
-int * getFaninValues(Abc_Obj_t * obj_ptr) {
+/* Fills the values of the fan-ins of a node, in a buffer large enough for
+ * all of them. Returns FALSE if none of the fan-ins has changed */
+int getFaninValues(Abc_Obj_t * obj_ptr, int * faninValues) {
 	Abc_Obj_t * fanin;
 	int i;
 	Ace_Obj_Info_t * info;
-	int * faninValues;
 
 	Abc_ObjForEachFanin(obj_ptr, fanin, i)
 	{
@@ -140,17 +145,16 @@ int * getFaninValues(Abc_Obj_t * obj_ptr) {
 
 	if (i >= Abc_ObjFaninNum(obj_ptr)) {
 		// inputs haven't changed
-		return NULL;
+		return FALSE;
 	}
 
-	faninValues = (int*) malloc(Abc_ObjFaninNum(obj_ptr) * sizeof(int));
 	Abc_ObjForEachFanin(obj_ptr, fanin, i)
 	{
 		info = Ace_ObjInfo(fanin);
 		faninValues[i] = info->value;
 	}
 
-	return faninValues;
+	return TRUE;
 }
 
 ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr) {
@@ -177,12 +181,12 @@ ace_status_t getFaninStatus(Abc_Obj_t * obj_ptr) {
 	return ACE_OLD;
 }
 
-void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
+void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/, int * faninValues) {
 	Abc_Obj_t * obj;
 	Ace_Obj_Info_t * info;
 	int i;
 	int value = -1;
-	int * faninValues;
+	int changed;
 	ace_status_t status;
 	DdNode * dd_node;
 
@@ -210,8 +214,8 @@ void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
 				break;
 			case ACE_NEW:
 				if (Abc_ObjIsNode(obj)) {
-					faninValues = getFaninValues(obj);
-					VTR_ASSERT(faninValues);
+					changed = getFaninValues(obj, faninValues);
+					VTR_ASSERT(changed);
 					dd_node = Cudd_Eval((DdManager*) ntk->pManFunc, (DdNode*) obj->pData, faninValues);
 					VTR_ASSERT(Cudd_IsConstant(dd_node));
 					if (dd_node == Cudd_ReadOne((DdManager*) ntk->pManFunc)) {
@@ -221,7 +225,6 @@ void evaluate_circuit(Abc_Ntk_t * ntk, Vec_Ptr_t * node_vec, int /*cycle*/) {
 					} else {
 						VTR_ASSERT(0);
 					}
-					free(faninValues);
 				} else {
 					Ace_Obj_Info_t * fanin_info = Ace_ObjInfo(
 							Abc_ObjFanin0(obj));
@@ -289,6 +292,151 @@ void update_FFs(Abc_Ntk_t * ntk) {
 	}
 }
 
+/* Number of cycles simulated at once by the bit-parallel simulation */
+#define ACE_SIM_WORD_BITS 64
+
+static int count_ones(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_popcountll(word);
+#else
+	int count = 0;
+	for (; word; word &= word - 1) {
+		count++;
+	}
+	return count;
+#endif
+}
+
+/* Evaluates a BDD for the values of its variables in a number of cycles at
+ * once, where bit c of a word is the value in the c-th cycle.
+ * The results of the (regular) BDD nodes are stored in results, as the
+ * nodes may be shared by several paths */
+static uint64_t evaluate_bdd_word(DdManager * dd, DdNode * dd_node,
+		const std::vector<uint64_t>& var_words,
+		std::unordered_map<DdNode*, uint64_t>& results) {
+	DdNode * regular = Cudd_Regular(dd_node);
+	uint64_t word;
+
+	if (cuddIsConstant(regular)) {
+		VTR_ASSERT(regular == DD_ONE(dd));
+		word = ~(uint64_t) 0;
+	} else {
+		auto result = results.find(regular);
+		if (result != results.end()) {
+			word = result->second;
+		} else {
+			uint64_t var_word = var_words[regular->index];
+			uint64_t then_word = evaluate_bdd_word(dd, cuddT(regular), var_words, results);
+			uint64_t else_word = evaluate_bdd_word(dd, cuddE(regular), var_words, results);
+			word = (var_word & then_word) | (~var_word & else_word);
+			results[regular] = word;
+		}
+	}
+
+	return Cudd_IsComplement(dd_node) ? ~word : word;
+}
+
+/* Simulates a network without latches, ACE_SIM_WORD_BITS cycles at a time:
+ * the values of an object in consecutive cycles are packed in a word, the
+ * nodes are evaluated with word-wide operations and their ones and toggles
+ * are counted on the words.
+ * The primary inputs are generated cycle by cycle (by get_pi_values, with the
+ * same random numbers), so that the activities are the same as those of the
+ * cycle-by-cycle simulation in ace_sim_activities() */
+void ace_sim_activities_bit_parallel(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes,
+		Vec_Ptr_t * logic_nodes, int max_cycles) {
+	Abc_Obj_t * obj;
+	Abc_Obj_t * fanin;
+	Ace_Obj_Info_t * info;
+	int i, j;
+	DdManager * dd = (DdManager*) ntk->pManFunc;
+
+	/* Values of each object in the cycles of the current word */
+	std::vector<uint64_t> words(Abc_NtkObjNumMax(ntk), 0);
+	/* Whether an object has been evaluated. An object is only evaluated
+	 * once one of its fan-ins has a new value, i.e., if it depends on a
+	 * primary input; otherwise it keeps its initial value (0) */
+	std::vector<char> is_evaluated(Abc_NtkObjNumMax(ntk), FALSE);
+
+	std::vector<uint64_t> fanin_words;
+	std::unordered_map<DdNode*, uint64_t> bdd_results;
+
+	for (int first_cycle = 0; first_cycle < max_cycles; first_cycle += ACE_SIM_WORD_BITS) {
+		int num_cycles = std::min(ACE_SIM_WORD_BITS, max_cycles - first_cycle);
+		uint64_t mask = (num_cycles == ACE_SIM_WORD_BITS) ? ~(uint64_t) 0 : (((uint64_t) 1 << num_cycles) - 1);
+
+		/* Primary inputs, whose ones and toggles are counted by get_pi_values */
+		Abc_NtkForEachPi(ntk, obj, i)
+		{
+			words[Abc_ObjId(obj)] = 0;
+		}
+		for (int icycle = 0; icycle < num_cycles; ++icycle) {
+			get_pi_values(ntk, nodes, first_cycle + icycle);
+			Abc_NtkForEachPi(ntk, obj, i)
+			{
+				words[Abc_ObjId(obj)] |= (uint64_t) Ace_ObjInfo(obj)->value << icycle;
+			}
+		}
+		Abc_NtkForEachPi(ntk, obj, i)
+		{
+			is_evaluated[Abc_ObjId(obj)] = TRUE;
+		}
+
+		Vec_PtrForEachEntry(Abc_Obj_t*, logic_nodes, obj, i)
+		{
+			info = Ace_ObjInfo(obj);
+
+			switch (Abc_ObjType(obj)) {
+			case ABC_OBJ_PI:
+				break;
+
+			case ABC_OBJ_PO:
+			case ABC_OBJ_NODE: {
+				bool evaluated = false;
+				Abc_ObjForEachFanin(obj, fanin, j)
+				{
+					evaluated = evaluated || is_evaluated[Abc_ObjId(fanin)];
+				}
+
+				uint64_t word = 0;
+				if (!evaluated) {
+					/* The value has never changed from the initial one */
+					VTR_ASSERT(info->value == 0);
+				} else if (Abc_ObjIsNode(obj)) {
+					fanin_words.resize(Abc_ObjFaninNum(obj));
+					Abc_ObjForEachFanin(obj, fanin, j)
+					{
+						fanin_words[j] = words[Abc_ObjId(fanin)];
+					}
+					bdd_results.clear();
+					word = evaluate_bdd_word(dd, (DdNode*) obj->pData, fanin_words, bdd_results);
+				} else {
+					word = words[Abc_ObjId(Abc_ObjFanin0(obj))];
+				}
+				word &= mask;
+
+				/* The value of the previous cycle, where the first value
+				 * of an object is not counted as a toggle */
+				uint64_t prev_value = (first_cycle == 0 || !is_evaluated[Abc_ObjId(obj)]) ? (word & 1) : (uint64_t) info->value;
+				uint64_t toggles = (word ^ ((word << 1) | prev_value)) & mask;
+				info->num_toggles += count_ones(toggles);
+				info->num_ones += count_ones(word);
+				info->value = (int) ((word >> (num_cycles - 1)) & 1);
+				info->status = ACE_OLD;
+
+				words[Abc_ObjId(obj)] = word;
+				is_evaluated[Abc_ObjId(obj)] = evaluated;
+				break;
+			}
+
+			default:
+				VTR_ASSERT(0);
+				break;
+			}
+		}
+	}
+}
+
 void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
 		double threshold) {
 	Abc_Obj_t * obj;
@@ -316,10 +464,24 @@ void ace_sim_activities(Abc_Ntk_t * ntk, Vec_Ptr_t * nodes, int max_cycles,
 	}
 
 	Vec_Ptr_t * logic_nodes = Abc_NtkDfs(ntk, TRUE);
-	for (i = 0; i < max_cycles; i++) {
-		get_pi_values(ntk, nodes, i);
-		evaluate_circuit(ntk, logic_nodes, i);
-		update_FFs(ntk);
+	if (0 == Abc_NtkLatchNum(ntk)) {
+		/* Without latches, the cycles only depend on the primary inputs,
+		 * and a number of them are simulated at once */
+		ace_sim_activities_bit_parallel(ntk, nodes, logic_nodes, max_cycles);
+	} else {
+		/* A buffer for the fan-in values of any node */
+		int max_fanins = 0;
+		Abc_NtkForEachObj(ntk, obj, i)
+		{
+			max_fanins = std::max(max_fanins, Abc_ObjFaninNum(obj));
+		}
+		std::vector<int> faninValues(max_fanins + 1);
+
+		for (i = 0; i < max_cycles; i++) {
+			get_pi_values(ntk, nodes, i);
+			evaluate_circuit(ntk, logic_nodes, i, faninValues.data());
+			update_FFs(ntk);
+		}
 	}
 
 	//Vec_PtrForEachEntry(Abc_Obj_t *, nodes, obj, i)
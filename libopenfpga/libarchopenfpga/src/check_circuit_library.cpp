@@ -6,6 +6,10 @@
  * 3. if nay circuit model miss mandatory ports 
  ***********************************************************************/
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -13,6 +17,25 @@
 
 #include "check_circuit_library.h"
 
+/************************************************************************
+ * Group the indices of the circuit models by a string (name or prefix),
+ * so that the models sharing a string are found without comparing
+ * each pair of models.
+ * The indices of each group are in ascending order
+ ***********************************************************************/
+static 
+std::unordered_map<std::string, std::vector<size_t>> group_circuit_models_by_string(const CircuitLibrary& circuit_lib,
+                                                                                  std::string (CircuitLibrary::*model_string)(const CircuitModelId&) const) {
+  std::unordered_map<std::string, std::vector<size_t>> model_groups;
+  model_groups.reserve(circuit_lib.num_models());
+
+  for (size_t i = 0; i < circuit_lib.num_models(); ++i) {
+    model_groups[(circuit_lib.*model_string)(CircuitModelId(i))].push_back(i);
+  }
+
+  return model_groups;
+}
+
 /************************************************************************
  * Circuit models have unique names, return the number of errors 
  *  If not found, we give an error
@@ -21,18 +44,14 @@ static
 size_t check_circuit_library_unique_names(const CircuitLibrary& circuit_lib) {
   size_t num_err = 0;
 
+  std::unordered_map<std::string, std::vector<size_t>> model_groups = group_circuit_models_by_string(circuit_lib, &CircuitLibrary::model_name);
+
   for (size_t i = 0; i < circuit_lib.num_models(); ++i) {
-    /* Skip for the last element, because the inner loop will access it */
-    if (i == circuit_lib.num_models() - 1) {
-      continue;
-    }
     /* Get the name of reference */
     const std::string& i_name = circuit_lib.model_name(CircuitModelId(i));
-    for (size_t j = i + 1; j < circuit_lib.num_models(); ++j) {
-      /* Compare the name of candidate */
-      const std::string& j_name = circuit_lib.model_name(CircuitModelId(j));
-      /* Compare the name and skip for different names */
-      if (0 != i_name.compare(j_name)) {
+    /* Only the models after the reference, which share its name, are reported */
+    for (const size_t& j : model_groups.at(i_name)) {
+      if (j <= i) {
         continue;
       }
       VTR_LOG_ERROR("Circuit model(index=%d) and (index=%d) share the same name, which is invalid!\n",
@@ -54,18 +73,14 @@ static
 size_t check_circuit_library_unique_prefix(const CircuitLibrary& circuit_lib) {
   size_t num_err = 0;
 
+  std::unordered_map<std::string, std::vector<size_t>> model_groups = group_circuit_models_by_string(circuit_lib, &CircuitLibrary::model_prefix);
+
   for (size_t i = 0; i < circuit_lib.num_models(); ++i) {
-    /* Skip for the last element, because the inner loop will access it */
-    if (i == circuit_lib.num_models() - 1) {
-      continue;
-    }
-    /* Get the name of reference */
+    /* Get the prefix of reference */
     const std::string& i_prefix = circuit_lib.model_prefix(CircuitModelId(i));
-    for (size_t j = i + 1; j < circuit_lib.num_models(); ++j) {
-      /* Compare the name of candidate */
-      const std::string& j_prefix = circuit_lib.model_prefix(CircuitModelId(j));
-      /* Compare the name and skip for different prefix */
-      if (0 != i_prefix.compare(j_prefix)) {
+    /* Only the models after the reference, which share its prefix, are reported */
+    for (const size_t& j : model_groups.at(i_prefix)) {
+      if (j <= i) {
         continue;
       }
       VTR_LOG_ERROR("Circuit model(name=%s) and (name=%s) share the same prefix, which is invalid!\n",
@@ -207,8 +222,14 @@ static
 size_t check_default_circuit_model_by_types(const CircuitLibrary& circuit_lib) {
   size_t num_err = 0;
 
+  /* Group the circuit models by types in a single pass over the library */
+  std::vector<std::vector<CircuitModelId>> models_by_types(NUM_CIRCUIT_MODEL_TYPES);
+  for (const CircuitModelId& model : circuit_lib.models()) {
+    models_by_types[size_t(circuit_lib.model_type(model))].push_back(model);
+  }
+
   for (size_t itype = 0; itype < NUM_CIRCUIT_MODEL_TYPES; ++itype) {
-    std::vector<CircuitModelId> curr_models = circuit_lib.models_by_type(e_circuit_model_type(itype));
+    const std::vector<CircuitModelId>& curr_models = models_by_types[itype];
     if (0 == curr_models.size()) {
        continue;
     }
@@ -358,6 +379,82 @@ size_t check_sram_circuit_model_ports(const CircuitLibrary& circuit_lib,
   return num_err;
 }
 
+/************************************************************************
+ * Check if two global ports share the same attributes:
+ * default_value, is_config, is_reset, is_set etc. 
+ ***********************************************************************/
+static 
+bool global_ports_share_attributes(const CircuitLibrary& circuit_lib,
+                                   const CircuitPortId& iport,
+                                   const CircuitPortId& jport) {
+  return (circuit_lib.port_default_value(iport) == circuit_lib.port_default_value(jport))
+      && (circuit_lib.port_is_reset(iport) == circuit_lib.port_is_reset(jport))
+      && (circuit_lib.port_is_set(iport) == circuit_lib.port_is_set(jport))
+      && (circuit_lib.port_is_config_enable(iport) == circuit_lib.port_is_config_enable(jport))
+      && (circuit_lib.port_is_prog(iport) == circuit_lib.port_is_prog(jport));
+}
+
+/************************************************************************
+ * Report each attribute which differs between two global ports 
+ * sharing the same name, return the number of errors 
+ ***********************************************************************/
+static 
+size_t check_global_port_pair_attributes(const CircuitLibrary& circuit_lib,
+                                         const CircuitPortId& iport,
+                                         const CircuitPortId& jport) {
+  size_t num_err = 0;
+
+  /* Check if a same port share the same attributes */
+  CircuitModelId iport_parent_model = circuit_lib.port_parent_model(iport);
+  CircuitModelId jport_parent_model = circuit_lib.port_parent_model(jport);
+
+  if (circuit_lib.port_default_value(iport) != circuit_lib.port_default_value(jport)) { 
+    VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different dfefault values(%lu and %lu)!\n",
+                  circuit_lib.port_prefix(iport).c_str(),
+                  circuit_lib.model_name(iport_parent_model).c_str(),
+                  circuit_lib.model_name(jport_parent_model).c_str(),
+                  circuit_lib.port_default_value(iport),
+                  circuit_lib.port_default_value(jport)
+                  ); 
+    num_err++;
+  }
+
+  if (circuit_lib.port_is_reset(iport) != circuit_lib.port_is_reset(jport)) { 
+    VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_reset attributes!\n",
+                  circuit_lib.port_prefix(iport).c_str(),
+                  circuit_lib.model_name(iport_parent_model).c_str(),
+                  circuit_lib.model_name(jport_parent_model).c_str() 
+                  ); 
+    num_err++;
+  }
+  if (circuit_lib.port_is_set(iport) != circuit_lib.port_is_set(jport)) { 
+    VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_set attributes!\n",
+                  circuit_lib.port_prefix(iport).c_str(),
+                  circuit_lib.model_name(iport_parent_model).c_str(),
+                  circuit_lib.model_name(jport_parent_model).c_str() 
+                  ); 
+    num_err++;
+  }
+  if (circuit_lib.port_is_config_enable(iport) != circuit_lib.port_is_config_enable(jport)) { 
+    VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_config_enable attributes!\n",
+                  circuit_lib.port_prefix(iport).c_str(),
+                  circuit_lib.model_name(iport_parent_model).c_str(),
+                  circuit_lib.model_name(jport_parent_model).c_str() 
+                  ); 
+    num_err++;
+  }
+  if (circuit_lib.port_is_prog(iport) != circuit_lib.port_is_prog(jport)) { 
+    VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_prog attributes!\n",
+                  circuit_lib.port_prefix(iport).c_str(),
+                  circuit_lib.model_name(iport_parent_model).c_str(),
+                  circuit_lib.model_name(jport_parent_model).c_str() 
+                  ); 
+    num_err++;
+  }
+
+  return num_err;
+}
+
 /************************************************************************
  * Check all the ports make sure, they satisfy the restriction 
  ***********************************************************************/
@@ -421,8 +518,11 @@ size_t check_circuit_library_ports(const CircuitLibrary& circuit_lib) {
 
   /* Check all the global ports which sare the same name also share the same attributes:
    * default_value, is_config, is_reset, is_set etc. 
+   * The global ports are grouped by their names, so that only the ports
+   * of a group are compared
    */
   std::vector<CircuitPortId> global_ports;
+  std::unordered_map<std::string, std::vector<CircuitPortId>> global_port_groups;
 
   /* Collect all the global ports */
   for (auto port : circuit_lib.ports()) {
@@ -431,62 +531,35 @@ size_t check_circuit_library_ports(const CircuitLibrary& circuit_lib) {
       continue;
     }
     global_ports.push_back(port);
+    global_port_groups[circuit_lib.port_prefix(port)].push_back(port);
   }
 
-  for (size_t iport = 0; iport < global_ports.size() - 1; ++iport) {
-    for (size_t jport = iport + 1; jport < global_ports.size(); ++jport) {
-      /* Bypass those do not share the same name */
-      if (0 != circuit_lib.port_prefix(global_ports[iport]).compare(circuit_lib.port_prefix(global_ports[jport]))) {
-        continue;
-      }
-
-      /* Check if a same port share the same attributes */
-      CircuitModelId iport_parent_model = circuit_lib.port_parent_model(global_ports[iport]);
-      CircuitModelId jport_parent_model = circuit_lib.port_parent_model(global_ports[jport]);
-
-      if (circuit_lib.port_default_value(global_ports[iport]) != circuit_lib.port_default_value(global_ports[jport])) { 
-        VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different dfefault values(%lu and %lu)!\n",
-                      circuit_lib.port_prefix(global_ports[iport]).c_str(),
-                      circuit_lib.model_name(iport_parent_model).c_str(),
-                      circuit_lib.model_name(jport_parent_model).c_str(),
-                      circuit_lib.port_default_value(global_ports[iport]),
-                      circuit_lib.port_default_value(global_ports[jport])
-                      ); 
-        num_err++;
+  /* A group whose ports all share the attributes of its first port has no error.
+   * Only the other groups require to compare each pair of ports
+   */
+  std::unordered_map<std::string, bool> global_port_group_conflicts;
+  for (const auto& group : global_port_groups) {
+    bool has_conflict = false;
+    for (const CircuitPortId& port : group.second) {
+      if (false == global_ports_share_attributes(circuit_lib, group.second.front(), port)) {
+        has_conflict = true;
+        break;
       }
+    }
+    global_port_group_conflicts[group.first] = has_conflict;
+  }
 
-      if (circuit_lib.port_is_reset(global_ports[iport]) != circuit_lib.port_is_reset(global_ports[jport])) { 
-        VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_reset attributes!\n",
-                      circuit_lib.port_prefix(global_ports[iport]).c_str(),
-                      circuit_lib.model_name(iport_parent_model).c_str(),
-                      circuit_lib.model_name(jport_parent_model).c_str() 
-                      ); 
-        num_err++;
-      }
-      if (circuit_lib.port_is_set(global_ports[iport]) != circuit_lib.port_is_set(global_ports[jport])) { 
-        VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_set attributes!\n",
-                      circuit_lib.port_prefix(global_ports[iport]).c_str(),
-                      circuit_lib.model_name(iport_parent_model).c_str(),
-                      circuit_lib.model_name(jport_parent_model).c_str() 
-                      ); 
-        num_err++;
-      }
-      if (circuit_lib.port_is_config_enable(global_ports[iport]) != circuit_lib.port_is_config_enable(global_ports[jport])) { 
-        VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_config_enable attributes!\n",
-                      circuit_lib.port_prefix(global_ports[iport]).c_str(),
-                      circuit_lib.model_name(iport_parent_model).c_str(),
-                      circuit_lib.model_name(jport_parent_model).c_str() 
-                      ); 
-        num_err++;
-      }
-      if (circuit_lib.port_is_prog(global_ports[iport]) != circuit_lib.port_is_prog(global_ports[jport])) { 
-        VTR_LOG_ERROR("Global ports %s from circuit model %s and %s share the same name but have different is_prog attributes!\n",
-                      circuit_lib.port_prefix(global_ports[iport]).c_str(),
-                      circuit_lib.model_name(iport_parent_model).c_str(),
-                      circuit_lib.model_name(jport_parent_model).c_str() 
-                      ); 
-        num_err++;
+  for (size_t iport = 0; iport < global_ports.size(); ++iport) {
+    const std::string& iport_prefix = circuit_lib.port_prefix(global_ports[iport]);
+    if (false == global_port_group_conflicts.at(iport_prefix)) {
+      continue;
+    }
+    /* Only the ports after the reference, which share its name, are compared */
+    for (const CircuitPortId& jport : global_port_groups.at(iport_prefix)) {
+      if (size_t(jport) <= size_t(global_ports[iport])) {
+        continue;
       }
+      num_err += check_global_port_pair_attributes(circuit_lib, global_ports[iport], jport);
     }
   }
 
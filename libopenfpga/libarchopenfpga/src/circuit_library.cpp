@@ -545,6 +545,14 @@ float CircuitLibrary::rram_wprog_reset_nmos(const CircuitModelId& model_id) cons
 CircuitPortId CircuitLibrary::model_port(const CircuitModelId& model_id, const std::string& name) const {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
+  /* Use the hash index if it is built */
+  if (false == model_port_name_lookup_.empty()) {
+    auto result = model_port_name_lookup_[model_id].find(name);
+    if (result == model_port_name_lookup_[model_id].end()) {
+      return CircuitPortId::INVALID();
+    }
+    return result->second;
+  }
   /* Walk through the ports and try to find a matched name */
   CircuitPortId ret = CircuitPortId::INVALID();
   size_t num_found = 0;
@@ -566,12 +574,7 @@ CircuitPortId CircuitLibrary::model_port(const CircuitModelId& model_id, const s
 size_t CircuitLibrary::num_model_ports(const CircuitModelId& model_id) const {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
-  /* Search the port look up and return a list */
-  size_t num_of_ports = 0;
-  for (auto model_ports_by_type : model_port_lookup_[model_id]) {
-    num_of_ports += model_ports_by_type.size();
-  }
-  return num_of_ports;
+  return model_flat_port_lookup_[model_id].size();
 }
 
 /* Access the type of a port of a circuit model 
@@ -599,17 +602,10 @@ size_t CircuitLibrary::num_model_ports_by_type(const CircuitModelId& model_id,
 }
 
 /* Find all the ports belong to a circuit model */
-std::vector<CircuitPortId> CircuitLibrary::model_ports(const CircuitModelId& model_id) const {
+const std::vector<CircuitPortId>& CircuitLibrary::model_ports(const CircuitModelId& model_id) const {
   /* validate the circuit_model_id */
   VTR_ASSERT(valid_model_id(model_id));
-  /* Search the port look up and return a list */
-  std::vector<CircuitPortId> port_ids;
-  for (auto model_ports_by_type : model_port_lookup_[model_id]) {
-    for (auto port_id : model_ports_by_type) {
-      port_ids.push_back(port_id);
-    }
-  }
-  return port_ids;
+  return model_flat_port_lookup_[model_id];
 }
 
 /* Recursively find all the global ports in the circuit model / sub circuit_model */
@@ -621,7 +617,7 @@ std::vector<CircuitPortId> CircuitLibrary::model_global_ports(const CircuitModel
   std::vector<CircuitPortId> global_ports;
 
   /* Search all the ports */
-  for (auto port : model_ports(model_id)) {
+  for (const auto& port : model_ports(model_id)) {
     /* By pass non-global ports*/
     if (false == port_is_global(port)) {
       continue;
@@ -667,17 +663,13 @@ std::vector<CircuitPortId> CircuitLibrary::model_global_ports_by_type(const Circ
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
 
-  /* Search all the ports */
+  /* Search all the ports of the type */
   std::vector<CircuitPortId> global_ports;
-  for (auto port : model_ports(model_id)) {
+  for (const auto& port : model_port_lookup_[model_id][type]) {
     /* By pass non-global ports*/
     if (false == port_is_global(port)) {
       continue;
     }
-    /* We skip unmatched ports */
-    if ( type != port_type(port) ) {
-      continue; 
-    }
     /* This is a global port, update global_ports */
     global_ports.push_back(port); 
   }
@@ -760,17 +752,11 @@ std::vector<CircuitPortId> CircuitLibrary::model_global_ports_by_type(const Circ
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified ports */
-std::vector<CircuitPortId> CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
-                                                               const enum e_circuit_model_port_type& type) const {
-  std::vector<CircuitPortId> port_ids;
-  for (const auto& port_id : model_ports(model_id)) {
-    /* We skip unmatched ports */
-    if ( type != port_type(port_id) ) {
-      continue; 
-    }
-    port_ids.push_back(port_id);
-  } 
-  return port_ids;
+const std::vector<CircuitPortId>& CircuitLibrary::model_ports_by_type(const CircuitModelId& model_id, 
+                                                                      const enum e_circuit_model_port_type& type) const {
+  /* validate the model_id */
+  VTR_ASSERT(valid_model_id(model_id));
+  return model_port_lookup_[model_id][type];
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified ports 
@@ -1082,6 +1068,14 @@ CircuitModelId CircuitLibrary::model(const char* name) const {
 
 /* Find a circuit model by a given name and return its id */
 CircuitModelId CircuitLibrary::model(const std::string& name) const { 
+  /* Use the hash index if it is built */
+  if (false == model_name_lookup_.empty()) {
+    auto result = model_name_lookup_.find(name);
+    if (result == model_name_lookup_.end()) {
+      return CircuitModelId::INVALID();
+    }
+    return result->second;
+  }
   CircuitModelId ret = CircuitModelId::INVALID();
   size_t num_found = 0;
   for (circuit_model_string_iterator it = model_names_.begin();
@@ -1213,6 +1207,7 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
 
   /* Build the fast look-up for circuit models */
   build_model_lookup();
+  invalidate_model_name_lookup();
 
   /* Add a placeholder in the fast look-up for model port
    * This is to avoid memory holes when a circuit model
@@ -1223,6 +1218,7 @@ CircuitModelId CircuitLibrary::add_model(const enum e_circuit_model_type& type)
    */
   model_port_lookup_.resize(model_ids_.size());
   model_port_lookup_[model_id].resize(NUM_CIRCUIT_MODEL_PORT_TYPES);
+  model_flat_port_lookup_.resize(model_ids_.size());
 
   return model_id;
 }
@@ -1232,6 +1228,7 @@ void CircuitLibrary::set_model_name(const CircuitModelId& model_id, const std::s
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
   model_names_[model_id] = name;
+  invalidate_model_name_lookup();
   return;
 }
 
@@ -1417,6 +1414,7 @@ CircuitPortId CircuitLibrary::add_model_port(const CircuitModelId& model_id,
  
   /* Build the fast look-up for circuit model ports */
   build_model_port_lookup();
+  invalidate_model_name_lookup();
 
   return circuit_port_id;
 }
@@ -1436,6 +1434,7 @@ void CircuitLibrary::set_port_prefix(const CircuitPortId& circuit_port_id,
   /* validate the circuit_port_id */
   VTR_ASSERT(valid_circuit_port_id(circuit_port_id));
   port_prefix_[circuit_port_id] = port_prefix;
+  invalidate_model_name_lookup();
   return;
 }
 
@@ -2127,6 +2126,9 @@ void CircuitLibrary::build_model_timing_graph(const CircuitModelId& model_id) {
  ***********************************************************************/
 /* Build the links for attributes of each model by searching the model_names */
 void CircuitLibrary::build_model_links() {
+  /* Index the names first, links are built by searching the names */
+  build_model_name_lookup();
+
   /* Walk through each circuit model, build links one by one */
   for (auto& model_id : models()) {
     /* Build links for buffers, pass-gates model */
@@ -2378,9 +2380,41 @@ void CircuitLibrary::build_model_port_lookup() {
     CircuitModelId model_id = port_model_ids_[port];
     model_port_lookup_[model_id][port_type(port)].push_back(port);
   }
+  /* Flatten the ports of each model in the order of types */
+  model_flat_port_lookup_.resize(model_ids_.size());
+  for (const auto& model_id : model_ids_) {
+    for (const auto& model_ports_by_type : model_port_lookup_[model_id]) {
+      model_flat_port_lookup_[model_id].insert(model_flat_port_lookup_[model_id].end(),
+                                               model_ports_by_type.begin(), model_ports_by_type.end());
+    }
+  }
   return;
 }
 
+/* Build hash indexes on the names of circuit models and ports
+ * The indexes are left empty if any name is not unique,
+ * so that the linear search reports the duplicated names
+ */
+void CircuitLibrary::build_model_name_lookup() {
+  invalidate_model_name_lookup();
+
+  std::unordered_map<std::string, CircuitModelId> model_name_lookup;
+  vtr::vector<CircuitModelId, std::unordered_map<std::string, CircuitPortId>> model_port_name_lookup(model_ids_.size());
+  for (const auto& model_id : model_ids_) {
+    if (false == model_name_lookup.insert(std::make_pair(model_names_[model_id], model_id)).second) {
+      return;
+    }
+    for (const auto& port : model_flat_port_lookup_[model_id]) {
+      if (false == model_port_name_lookup[model_id].insert(std::make_pair(port_prefix_[port], port)).second) {
+        return;
+      }
+    }
+  }
+
+  model_name_lookup_ = std::move(model_name_lookup);
+  model_port_name_lookup_ = std::move(model_port_name_lookup);
+}
+
 /************************************************************************
  * Internal invalidators/validators 
  ***********************************************************************/
@@ -2436,6 +2470,14 @@ void CircuitLibrary::invalidate_model_lookup() const {
 /* Empty fast lookup for circuit ports for a model */
 void CircuitLibrary::invalidate_model_port_lookup() const {
   model_port_lookup_.clear();
+  model_flat_port_lookup_.clear();
+  return;
+}
+
+/* Empty fast lookup for the names of models and ports */
+void CircuitLibrary::invalidate_model_name_lookup() const {
+  model_name_lookup_.clear();
+  model_port_name_lookup_.clear();
   return;
 }
 
@@ -13,6 +13,7 @@
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
 #include <string>
+#include <unordered_map>
 
 #include "vtr_geometry.h"
 
@@ -58,6 +59,10 @@
  *                            It classifies CircuitModelIds by their type and set the default model in the first element for each type.
  *  2. model_port_lookup_: A multi-dimension vector to provide fast look-up on ports of circuit models for users
  *                                 It classifies Ports by their types 
+ *  3. model_flat_port_lookup_: all the ports of each circuit model, in the order of model_port_lookup_
+ *  4. model_name_lookup_/model_port_name_lookup_: hash indexes on the names of circuit models and ports,
+ *                                 which are built by build_model_links() when all the names are unique
+ *                                 Otherwise, circuit models and ports are searched linearly
  *
  *  ------ Verilog generation options -----
  * 1. dump_structural_verilog_: if Verilog generator will output structural Verilog syntax for the circuit model
@@ -251,7 +256,7 @@ class CircuitLibrary {
     CircuitPortId model_port(const CircuitModelId& model_id, const std::string& name) const;
     size_t num_model_ports(const CircuitModelId& model_id) const;
     size_t num_model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type, const bool& include_global_port) const;
-    std::vector<CircuitPortId> model_ports(const CircuitModelId& model_id) const;
+    const std::vector<CircuitPortId>& model_ports(const CircuitModelId& model_id) const;
     std::vector<CircuitPortId> model_global_ports(const CircuitModelId& model_id, const bool& recursive) const;
     std::vector<CircuitPortId> model_global_ports_by_type(const CircuitModelId& model_id,
                                                           const enum e_circuit_model_port_type& type,
@@ -266,7 +271,7 @@ class CircuitLibrary {
                                                           const bool& recursive,
                                                           const bool& ignore_config_memories) const;
 
-    std::vector<CircuitPortId> model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type) const;
+    const std::vector<CircuitPortId>& model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type) const;
     std::vector<CircuitPortId> model_ports_by_type(const CircuitModelId& model_id, const enum e_circuit_model_port_type& port_type, const bool& include_global_port) const;
     std::vector<CircuitPortId> model_input_ports(const CircuitModelId& model_id) const;
     std::vector<CircuitPortId> model_output_ports(const CircuitModelId& model_id) const;
@@ -486,6 +491,7 @@ class CircuitLibrary {
   public: /* Internal mutators: build fast look-ups */
     void build_model_lookup();
     void build_model_port_lookup();
+    void build_model_name_lookup();
   public: /* Public invalidators/validators */
     bool valid_model_id(const CircuitModelId& model_id) const;
     bool valid_circuit_port_id(const CircuitPortId& circuit_port_id) const;
@@ -499,6 +505,7 @@ class CircuitLibrary {
     /* Invalidators */
     void invalidate_model_lookup() const;
     void invalidate_model_port_lookup() const;
+    void invalidate_model_name_lookup() const;
     void invalidate_model_timing_graph();
   private: /* Internal data */
     /* Fundamental information */
@@ -521,6 +528,13 @@ class CircuitLibrary {
     mutable CircuitModelLookup model_lookup_; /* [model_type][model_ids] */
     typedef vtr::vector<CircuitModelId, std::vector<std::vector<CircuitPortId>>> CircuitModelPortLookup;
     mutable CircuitModelPortLookup model_port_lookup_; /* [model_id][port_type][port_ids] */
+    mutable vtr::vector<CircuitModelId, std::vector<CircuitPortId>> model_flat_port_lookup_; /* [model_id][port_ids] */
+
+    /* fast look-up for circuit models and their ports by names
+     * Empty if it is not built yet or the names are not unique
+     */
+    mutable std::unordered_map<std::string, CircuitModelId> model_name_lookup_;
+    mutable vtr::vector<CircuitModelId, std::unordered_map<std::string, CircuitPortId>> model_port_name_lookup_;
 
     /* Verilog generator options */ 
     vtr::vector<CircuitModelId, bool> dump_structural_verilog_;
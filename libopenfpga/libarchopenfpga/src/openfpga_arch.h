@@ -1,6 +1,7 @@
 #ifndef OPENFPGA_ARCH_H
 #define OPENFPGA_ARCH_H
 
+#include <string>
 #include <vector>
 #include <map>
 
@@ -23,6 +24,11 @@ namespace openfpga {
  * This is to keep everything well modularized
  */
 struct Arch {
+  /* Secure digest of the architecture file, 
+   * which identifies the architecture, including the circuit library
+   */
+  std::string architecture_id;
+
   /* Circuit models */
   CircuitLibrary circuit_lib;
   
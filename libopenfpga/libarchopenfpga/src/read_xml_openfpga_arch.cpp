@@ -11,6 +11,7 @@
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
+#include "vtr_digest.h"
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
@@ -45,6 +46,8 @@ openfpga::Arch read_xml_openfpga_arch(const char* arch_file_name) {
   try {
     loc_data = pugiutil::load_xml(doc, arch_file_name);
 
+    openfpga_arch.architecture_id = vtr::secure_digest_file(std::string(arch_file_name));
+
     /* First node should be <openfpga_architecture> */
     auto xml_openfpga_arch = get_single_child(doc, "openfpga_architecture", loc_data); 
 
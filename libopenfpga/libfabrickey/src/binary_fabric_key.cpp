@@ -0,0 +1,235 @@
+/********************************************************************
+ * This file includes functions to write a fabric key to a compact
+ * binary file, and to read it back. Binary keys are much faster to
+ * load than XML keys for full-chip fabrics with millions of keys
+ *
+ * The file is a sequence of 64-bit words and strings, where
+ * a string is a word of its length followed by its characters
+ * (not padded):
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   magic number "OFPGAFKY"                            |
+ *   |   endian marker 0x0102030405060708                   |
+ *   |   format version                                     |
+ *   |   number of keys                                     |
+ *   |   number of regions                                  |
+ *   +------------------------------------------------------+
+ *   | Keys, key by key                                     |
+ *   |   value, name (string), alias (string)               |
+ *   +------------------------------------------------------+
+ *   | Regions, region by region                            |
+ *   |   number of keys, followed by the key ids            |
+ *   +------------------------------------------------------+
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <string>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+
+#include "binary_fabric_key.h"
+
+/********************************************************************
+ * Append a word or a string to the buffer of a binary key
+ *******************************************************************/
+static
+void append_binary_fabric_key_word(std::string& buffer,
+                                   const uint64_t& word) {
+  buffer.append(reinterpret_cast<const char*>(&word), sizeof(uint64_t));
+}
+
+static
+void append_binary_fabric_key_string(std::string& buffer,
+                                     const std::string& str) {
+  append_binary_fabric_key_word(buffer, str.size());
+  buffer.append(str);
+}
+
+/********************************************************************
+ * Check if a file starts with the magic number of binary fabric keys
+ *******************************************************************/
+bool is_binary_fabric_key_file(const char* fname) {
+  std::ifstream fp(fname, std::ifstream::binary);
+  if (!fp.is_open()) {
+    return false;
+  }
+  char magic[sizeof(uint64_t)];
+  fp.read(magic, sizeof(uint64_t));
+  return (fp.good()) && (0 == std::memcmp(magic, BINARY_FABRIC_KEY_MAGIC, sizeof(uint64_t)));
+}
+
+/********************************************************************
+ * A writer to output a fabric key to a binary file
+ *
+ * Return 0 if successful
+ * Return 2 if fail when creating files
+ *******************************************************************/
+int write_binary_fabric_key(const char* fname,
+                            const FabricKey& fabric_key) {
+
+  vtr::ScopedStartFinishTimer timer("Write Binary Fabric Key");
+
+  /* Create a file handler */
+  std::fstream fp;
+  fp.open(std::string(fname), std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  if (!fp.is_open()) {
+    return 2;
+  }
+
+  std::string buffer(BINARY_FABRIC_KEY_MAGIC, sizeof(uint64_t));
+  append_binary_fabric_key_word(buffer, BINARY_FABRIC_KEY_ENDIAN_MARKER);
+  append_binary_fabric_key_word(buffer, BINARY_FABRIC_KEY_VERSION);
+  append_binary_fabric_key_word(buffer, fabric_key.keys().size());
+  append_binary_fabric_key_word(buffer, fabric_key.regions().size());
+
+  for (const FabricKeyId& key : fabric_key.keys()) {
+    append_binary_fabric_key_word(buffer, fabric_key.key_value(key));
+    append_binary_fabric_key_string(buffer, fabric_key.key_name(key));
+    append_binary_fabric_key_string(buffer, fabric_key.key_alias(key));
+  }
+
+  for (const FabricRegionId& region : fabric_key.regions()) {
+    std::vector<FabricKeyId> region_keys = fabric_key.region_keys(region);
+    append_binary_fabric_key_word(buffer, region_keys.size());
+    for (const FabricKeyId& key : region_keys) {
+      append_binary_fabric_key_word(buffer, size_t(key));
+    }
+  }
+
+  fp.write(buffer.data(), buffer.size());
+
+  int err_code = 0;
+  if (!fp.good()) {
+    err_code = 2;
+  }
+
+  /* Close the file stream */
+  fp.close();
+
+  return err_code;
+}
+
+/********************************************************************
+ * A cursor on the content of a binary key
+ * Reading beyond the end of the content will error out
+ *******************************************************************/
+class BinaryFabricKeyCursor {
+  public: /* Public constructor */
+    BinaryFabricKeyCursor(const char* fname, const std::string& content)
+      : fname_(fname), content_(content), offset_(0) {}
+
+  public: /* Public mutators */
+    uint64_t read_word() {
+      uint64_t word = 0;
+      if (content_.size() - offset_ < sizeof(uint64_t)) {
+        archfpga_throw(fname_, 0,
+                       "Unexpected end of binary fabric key!\n");
+      }
+      std::memcpy(&word, content_.data() + offset_, sizeof(uint64_t));
+      offset_ += sizeof(uint64_t);
+      return word;
+    }
+
+    std::string read_string() {
+      uint64_t length = read_word();
+      if (content_.size() - offset_ < length) {
+        archfpga_throw(fname_, 0,
+                       "Unexpected end of binary fabric key!\n");
+      }
+      std::string str = content_.substr(offset_, length);
+      offset_ += length;
+      return str;
+    }
+
+  public: /* Public accessors */
+    bool finished() const { return offset_ == content_.size(); }
+
+  private: /* Internal data */
+    const char* fname_;
+    const std::string& content_;
+    size_t offset_;
+};
+
+/********************************************************************
+ * Read a fabric key from a binary file
+ * which is written by write_binary_fabric_key()
+ *******************************************************************/
+FabricKey read_binary_fabric_key(const char* key_fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Binary Fabric Key");
+
+  /* Load the file */
+  std::ifstream fp(key_fname, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    archfpga_throw(key_fname, 0,
+                   "Unable to open binary fabric key!\n");
+  }
+  std::string content(fp.tellg(), '\0');
+  fp.seekg(0);
+  fp.read(&content[0], content.size());
+  if (!fp.good()) {
+    archfpga_throw(key_fname, 0,
+                   "Fail to read binary fabric key!\n");
+  }
+  fp.close();
+
+  /* Check the header */
+  BinaryFabricKeyCursor cursor(key_fname, content);
+  uint64_t magic = cursor.read_word();
+  if ( (0 != std::memcmp(&magic, BINARY_FABRIC_KEY_MAGIC, sizeof(uint64_t)))
+    || (BINARY_FABRIC_KEY_ENDIAN_MARKER != cursor.read_word()) ) {
+    archfpga_throw(key_fname, 0,
+                   "File is not a binary fabric key or written by a machine with a different byte order!\n");
+  }
+  uint64_t version = cursor.read_word();
+  if (BINARY_FABRIC_KEY_VERSION != version) {
+    archfpga_throw(key_fname, 0,
+                   "Unsupported version '%lu' of binary fabric key (expect '%lu')!\n",
+                   version, BINARY_FABRIC_KEY_VERSION);
+  }
+
+  FabricKey fabric_key;
+
+  size_t num_keys = cursor.read_word();
+  size_t num_regions = cursor.read_word();
+
+  fabric_key.reserve_keys(num_keys);
+  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
+    FabricKeyId key = fabric_key.create_key();
+    fabric_key.set_key_value(key, cursor.read_word());
+    fabric_key.set_key_name(key, cursor.read_string());
+    std::string alias = cursor.read_string();
+    if (!alias.empty()) {
+      fabric_key.set_key_alias(key, alias);
+    }
+  }
+
+  fabric_key.reserve_regions(num_regions);
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    FabricRegionId region = fabric_key.create_region();
+    size_t num_region_keys = cursor.read_word();
+    fabric_key.reserve_region_keys(region, num_region_keys);
+    for (size_t ikey = 0; ikey < num_region_keys; ++ikey) {
+      FabricKeyId key = FabricKeyId(cursor.read_word());
+      if (false == fabric_key.valid_key_id(key)) {
+        archfpga_throw(key_fname, 0,
+                       "Invalid key id '%lu' in region '%lu' (in total %lu keys)!\n",
+                       size_t(key), size_t(region), num_keys);
+      }
+      fabric_key.add_key_to_region(region, key);
+    }
+  }
+
+  if (false == cursor.finished()) {
+    archfpga_throw(key_fname, 0,
+                   "Unexpected content at the end of binary fabric key!\n");
+  }
+
+  return fabric_key;
+}
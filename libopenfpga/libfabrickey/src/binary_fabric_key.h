@@ -0,0 +1,27 @@
+#ifndef BINARY_FABRIC_KEY_H
+#define BINARY_FABRIC_KEY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include "fabric_key.h"
+
+/********************************************************************
+ * Constants for the binary file format of fabric keys
+ *******************************************************************/
+constexpr char BINARY_FABRIC_KEY_MAGIC[] = "OFPGAFKY";
+constexpr uint64_t BINARY_FABRIC_KEY_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t BINARY_FABRIC_KEY_VERSION = 1;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+bool is_binary_fabric_key_file(const char* fname);
+
+int write_binary_fabric_key(const char* fname,
+                            const FabricKey& fabric_key);
+
+FabricKey read_binary_fabric_key(const char* key_fname);
+
+#endif
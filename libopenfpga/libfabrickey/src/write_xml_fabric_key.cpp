@@ -3,6 +3,7 @@
  *******************************************************************/
 /* Headers from system goes first */
 #include <string>
+#include <vector>
 #include <algorithm>
 
 /* Headers from vtr util library */
@@ -19,6 +20,11 @@
 /* Headers from fabrickey library */
 #include "write_xml_fabric_key.h"
 
+/* Size of the buffer of the file stream, 
+ * which reduces the number of writes for fabric keys with millions of keys
+ */
+constexpr size_t FABRIC_KEY_WRITER_BUFFER_SIZE = 1 << 20;
+
 /********************************************************************
  * A writer to output a component key to XML format
  *
@@ -69,8 +75,12 @@ int write_xml_fabric_key(const char* fname,
 
   vtr::ScopedStartFinishTimer timer("Write Fabric Key");
 
-  /* Create a file handler */
+  /* Create a file handler 
+   * The buffer should be set before opening the file stream
+   */
+  std::vector<char> buffer(FABRIC_KEY_WRITER_BUFFER_SIZE);
   std::fstream fp;
+  fp.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
   /* Open the file stream */
   fp.open(std::string(fname), std::fstream::out | std::fstream::trunc);
 
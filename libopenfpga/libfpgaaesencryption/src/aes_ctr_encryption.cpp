@@ -0,0 +1,205 @@
+/********************************************************************
+ * This file includes functions to encrypt data, e.g., a bitstream,
+ * with AES in the counter (CTR) mode, as defined in NIST SP 800-38A
+ *
+ * In CTR mode, each block of data is XORed with the encrypted value
+ * of its counter, which is the initial counter plus the index of 
+ * the block. As a result, blocks are independent from each other, 
+ * and they are encrypted in parallel by a number of threads.
+ * Decryption is the same operation as encryption.
+ *
+ * The AES New Instructions (AES-NI) of x86 processors are used 
+ * when available, otherwise the portable implementation 
+ * AES_Encrypt() is used
+ *******************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <wmmintrin.h>
+#define OPENFPGA_AES_X86_INTRINSICS
+#endif
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+#include "AESfunctions.h"
+#include "aes_ctr_encryption.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of blocks encrypted by a job of a thread */
+constexpr size_t AES_CTR_NUM_BLOCKS_PER_JOB = 4096;
+
+/********************************************************************
+ * Build the counter of a block, which is the initial counter plus 
+ * the index of the block. The counter is a 128-bit big-endian integer
+ *******************************************************************/
+static
+void build_aes_ctr_counter_block(const std::array<unsigned char, AES_CTR_BLOCK_SIZE>& initial_counter,
+                                 const uint64_t& block_index,
+                                 unsigned char* counter) {
+  uint64_t carry = block_index;
+  for (size_t ibyte = AES_CTR_BLOCK_SIZE; ibyte > 0; --ibyte) {
+    uint64_t sum = uint64_t(initial_counter[ibyte - 1]) + (carry & 0xff);
+    counter[ibyte - 1] = static_cast<unsigned char>(sum & 0xff);
+    carry = (carry >> 8) + (sum >> 8);
+  }
+}
+
+/********************************************************************
+ * Encrypt a range of blocks with the portable implementation
+ * The last block may be partial
+ *******************************************************************/
+static
+void encrypt_aes_ctr_blocks_portable(unsigned char* data,
+                                     const size_t& num_bytes,
+                                     unsigned char* expanded_key,
+                                     const unsigned short& num_rounds,
+                                     const std::array<unsigned char, AES_CTR_BLOCK_SIZE>& initial_counter,
+                                     const uint64_t& first_block) {
+  unsigned char counter[AES_CTR_BLOCK_SIZE];
+  unsigned int counter_words[AES_CTR_BLOCK_SIZE];
+  unsigned char key_stream[AES_CTR_BLOCK_SIZE];
+  for (size_t offset = 0; offset < num_bytes; offset += AES_CTR_BLOCK_SIZE) {
+    build_aes_ctr_counter_block(initial_counter, first_block + offset / AES_CTR_BLOCK_SIZE, counter);
+    std::copy(counter, counter + AES_CTR_BLOCK_SIZE, counter_words);
+    AES_Encrypt(counter_words, expanded_key, num_rounds, key_stream);
+    size_t block_size = std::min(AES_CTR_BLOCK_SIZE, num_bytes - offset);
+    for (size_t ibyte = 0; ibyte < block_size; ++ibyte) {
+      data[offset + ibyte] ^= key_stream[ibyte];
+    }
+  }
+}
+
+#ifdef OPENFPGA_AES_X86_INTRINSICS
+/********************************************************************
+ * Encrypt a range of blocks with the AES New Instructions
+ * Four blocks are encrypted at a time to fill the pipeline of 
+ * the AES unit. The last block may be partial
+ *******************************************************************/
+__attribute__((target("aes,sse2")))
+static
+void encrypt_aes_ctr_blocks_aesni(unsigned char* data,
+                                  const size_t& num_bytes,
+                                  const unsigned char* expanded_key,
+                                  const unsigned short& num_rounds,
+                                  const std::array<unsigned char, AES_CTR_BLOCK_SIZE>& initial_counter,
+                                  const uint64_t& first_block) {
+  /* Round keys of the expanded key have the same byte order as the AES-NI registers */
+  __m128i round_keys[Nr_max + 1];
+  for (size_t iround = 0; iround <= num_rounds; ++iround) {
+    round_keys[iround] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expanded_key + iround * AES_CTR_BLOCK_SIZE));
+  }
+
+  constexpr size_t NUM_PARALLEL_BLOCKS = 4;
+  unsigned char counters[NUM_PARALLEL_BLOCKS][AES_CTR_BLOCK_SIZE];
+  unsigned char key_stream[NUM_PARALLEL_BLOCKS][AES_CTR_BLOCK_SIZE];
+  __m128i states[NUM_PARALLEL_BLOCKS];
+
+  size_t offset = 0;
+  while (offset < num_bytes) {
+    size_t num_blocks = std::min(NUM_PARALLEL_BLOCKS, (num_bytes - offset + AES_CTR_BLOCK_SIZE - 1) / AES_CTR_BLOCK_SIZE);
+    for (size_t iblk = 0; iblk < NUM_PARALLEL_BLOCKS; ++iblk) {
+      build_aes_ctr_counter_block(initial_counter, first_block + offset / AES_CTR_BLOCK_SIZE + iblk, counters[iblk]);
+      states[iblk] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(counters[iblk])), round_keys[0]);
+    }
+    for (size_t iround = 1; iround < num_rounds; ++iround) {
+      for (size_t iblk = 0; iblk < NUM_PARALLEL_BLOCKS; ++iblk) {
+        states[iblk] = _mm_aesenc_si128(states[iblk], round_keys[iround]);
+      }
+    }
+    for (size_t iblk = 0; iblk < NUM_PARALLEL_BLOCKS; ++iblk) {
+      states[iblk] = _mm_aesenclast_si128(states[iblk], round_keys[num_rounds]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(key_stream[iblk]), states[iblk]);
+    }
+
+    for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+      size_t block_size = std::min(AES_CTR_BLOCK_SIZE, num_bytes - offset);
+      for (size_t ibyte = 0; ibyte < block_size; ++ibyte) {
+        data[offset + ibyte] ^= key_stream[iblk][ibyte];
+      }
+      offset += block_size;
+    }
+  }
+}
+#endif
+
+/********************************************************************
+ * Check if the AES New Instructions are supported by the processor
+ *******************************************************************/
+bool aes_hardware_acceleration_available() {
+#ifdef OPENFPGA_AES_X86_INTRINSICS
+  __builtin_cpu_init();
+  return (0 != __builtin_cpu_supports("aes")) && (0 != __builtin_cpu_supports("sse2"));
+#else
+  return false;
+#endif
+}
+
+/********************************************************************
+ * Encrypt data in place with AES in the counter mode
+ * The key should contain 16, 24 or 32 bytes for AES-128, AES-192
+ * and AES-256 respectively.
+ * Note that the same pair of key and initial counter should never
+ * be used to encrypt different data.
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int encrypt_aes_ctr(std::vector<unsigned char>& data,
+                    const std::vector<unsigned char>& key,
+                    const std::array<unsigned char, AES_CTR_BLOCK_SIZE>& initial_counter,
+                    const size_t& num_threads,
+                    const bool& use_hardware_acceleration) {
+  if ((16 != key.size()) && (24 != key.size()) && (32 != key.size())) {
+    VTR_LOG_ERROR("Invalid AES key size '%lu' bytes! Expect 16, 24 or 32 bytes.\n",
+                  key.size());
+    return 1;
+  }
+
+  /* Expand the key once, which is shared by all the threads */
+  unsigned short num_key_words = key.size() / rows;
+  unsigned short num_rounds = (num_key_words > Nb) ? num_key_words + 6 : Nb + 6;
+  std::vector<unsigned char> input_key(key);
+  std::vector<unsigned char> expanded_key(ExtdCipherKeyLenghth_max);
+  KeyExpansion(input_key.data(), num_key_words, expanded_key.data());
+
+  bool use_aesni = use_hardware_acceleration && aes_hardware_acceleration_available();
+
+  size_t num_blocks = (data.size() + AES_CTR_BLOCK_SIZE - 1) / AES_CTR_BLOCK_SIZE;
+  size_t num_jobs = (num_blocks + AES_CTR_NUM_BLOCKS_PER_JOB - 1) / AES_CTR_NUM_BLOCKS_PER_JOB;
+
+  parallel_for(num_jobs, num_threads,
+               [&](const size_t& ijob) {
+                 size_t first_block = ijob * AES_CTR_NUM_BLOCKS_PER_JOB;
+                 size_t offset = first_block * AES_CTR_BLOCK_SIZE;
+                 size_t num_bytes = std::min(AES_CTR_NUM_BLOCKS_PER_JOB * AES_CTR_BLOCK_SIZE, data.size() - offset);
+#ifdef OPENFPGA_AES_X86_INTRINSICS
+                 if (true == use_aesni) {
+                   encrypt_aes_ctr_blocks_aesni(data.data() + offset, num_bytes,
+                                                expanded_key.data(), num_rounds,
+                                                initial_counter, first_block);
+                   return;
+                 }
+#endif
+                 /* Each thread has its own copy of the expanded key, 
+                  * as the portable implementation does not take a const key
+                  */
+                 std::vector<unsigned char> job_expanded_key(expanded_key);
+                 encrypt_aes_ctr_blocks_portable(data.data() + offset, num_bytes,
+                                                 job_expanded_key.data(), num_rounds,
+                                                 initial_counter, first_block);
+               });
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,34 @@
+#ifndef AES_CTR_ENCRYPTION_H
+#define AES_CTR_ENCRYPTION_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/********************************************************************
+ * Constants for AES encryption
+ *******************************************************************/
+/* Number of bytes in a block of AES */
+constexpr size_t AES_CTR_BLOCK_SIZE = 16;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+bool aes_hardware_acceleration_available();
+
+int encrypt_aes_ctr(std::vector<unsigned char>& data,
+                    const std::vector<unsigned char>& key,
+                    const std::array<unsigned char, AES_CTR_BLOCK_SIZE>& initial_counter,
+                    const size_t& num_threads,
+                    const bool& use_hardware_acceleration);
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,11 +4,20 @@
 #include <algorithm>
 
 #include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_memory_usage.h"
+#include "openfpga_bit_kernels.h"
+
 #include "bitstream_manager.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of bits packed in a word of the bit storage */
+constexpr size_t BIT_VALUE_WORD_SIZE = 64;
+
 /**************************************************
  * Public Constructors
  *************************************************/
@@ -16,7 +25,6 @@ BitstreamManager::BitstreamManager() {
   num_blocks_ = 0;
   num_bits_ = 0;
   invalid_block_ids_.clear();
-  invalid_bit_ids_.clear();
 }
 
 /**************************************************
@@ -28,8 +36,8 @@ size_t BitstreamManager::num_bits() const {
 }
 
 BitstreamManager::config_bit_range BitstreamManager::bits() const {
-  return vtr::make_range(config_bit_iterator(ConfigBitId(0), invalid_bit_ids_),
-                         config_bit_iterator(ConfigBitId(num_bits_), invalid_bit_ids_));
+  return vtr::make_range(config_bit_iterator(ConfigBitId(0)),
+                         config_bit_iterator(ConfigBitId(num_bits_)));
 }
 
 size_t BitstreamManager::num_blocks() const {
@@ -45,25 +53,53 @@ BitstreamManager::config_block_range BitstreamManager::blocks() const {
 /******************************************************************************
  * Public Accessors
  ******************************************************************************/
+size_t BitstreamManager::memory_usage() const {
+  return sizeof(BitstreamManager)
+       + heap_memory_usage(invalid_block_ids_)
+       + heap_memory_usage(block_bit_id_lsbs_)
+       + heap_memory_usage(block_bit_lengths_)
+       + heap_memory_usage(block_name_ids_)
+       + heap_memory_usage(parent_block_ids_)
+       + heap_memory_usage(child_block_ids_)
+       + heap_memory_usage(block_path_ids_)
+       + heap_memory_usage(block_input_net_ids_)
+       + heap_memory_usage(block_output_net_ids_)
+       + heap_memory_usage(string_pool_)
+       + heap_memory_usage(bit_value_words_)
+       + heap_memory_usage(bit_blocks_);
+}
+
 bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  size_t bit_index = size_t(bit_id);
+  return 0 != ((bit_value_words_[bit_index / BIT_VALUE_WORD_SIZE] >> (bit_index % BIT_VALUE_WORD_SIZE)) & 1);
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Bit ranges of blocks are sorted by their lsbs and never overlap,
+   * the parent block is the last block whose lsb is not larger than the bit id
+   */
+  std::vector<ConfigBlockId>::const_iterator it = std::upper_bound(bit_blocks_.begin(), bit_blocks_.end(), size_t(bit_id),
+                                                                   [&](const size_t& bit_index, const ConfigBlockId& block) {
+                                                                     return bit_index < block_bit_id_lsbs_[block];
+                                                                   });
+  VTR_ASSERT(it != bit_blocks_.begin());
+  --it;
+  VTR_ASSERT_SAFE(size_t(bit_id) < block_bit_id_lsbs_[*it] + block_bit_lengths_[*it]);
+
+  return *it;
 }
 
 std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_names_[block_id];
+  return string_pool_.str(block_name_ids_[block_id]);
 }
 
 ConfigBlockId BitstreamManager::block_parent(const ConfigBlockId& block_id) const {
@@ -100,7 +136,156 @@ std::vector<ConfigBitId> BitstreamManager::block_bits(const ConfigBlockId& block
   return bits;
 }
 
+size_t BitstreamManager::block_num_bits(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  return block_bit_lengths_[block_id];
+}
+
+ConfigBitId BitstreamManager::block_first_bit(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  if (0 == block_bit_lengths_[block_id]) {
+    return ConfigBitId::INVALID();
+  }
+
+  return ConfigBitId(block_bit_id_lsbs_[block_id]);
+}
+
+std::vector<bool> BitstreamManager::block_bit_values(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  size_t lsb = block_bit_id_lsbs_[block_id]; 
+  size_t length = block_bit_lengths_[block_id]; 
+
+  std::vector<bool> bit_values(length, false);
+  for (size_t i = 0; i < length; ++i) {
+    size_t bit_index = lsb + i;
+    bit_values[i] = (0 != ((bit_value_words_[bit_index / BIT_VALUE_WORD_SIZE] >> (bit_index % BIT_VALUE_WORD_SIZE)) & 1));
+  }
+
+  return bit_values;
+}
+
+std::vector<uint64_t> BitstreamManager::block_bit_value_words(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  size_t lsb = block_bit_id_lsbs_[block_id]; 
+  size_t length = block_bit_lengths_[block_id]; 
+
+  std::vector<uint64_t> words((length + BIT_VALUE_WORD_SIZE - 1) / BIT_VALUE_WORD_SIZE, 0);
+  if (0 == length) {
+    return words;
+  }
+
+  /* Copy word by word, shifting when the block does not start at a word boundary */
+  size_t first_word = lsb / BIT_VALUE_WORD_SIZE;
+  size_t offset = lsb % BIT_VALUE_WORD_SIZE;
+  for (size_t iword = 0; iword < words.size(); ++iword) {
+    uint64_t word = bit_value_words_[first_word + iword] >> offset;
+    if ((0 != offset) && (first_word + iword + 1 < bit_value_words_.size())) {
+      word |= bit_value_words_[first_word + iword + 1] << (BIT_VALUE_WORD_SIZE - offset);
+    }
+    words[iword] = word;
+  }
+
+  /* Clear the positions beyond the block */
+  size_t num_tail_bits = length % BIT_VALUE_WORD_SIZE;
+  if (0 != num_tail_bits) {
+    words.back() &= (uint64_t(1) << num_tail_bits) - 1;
+  }
+
+  return words;
+}
+
+size_t BitstreamManager::num_bit_value_words() const {
+  return bit_value_words_.size();
+}
+
+uint64_t BitstreamManager::bit_value_word(const size_t& word_id) const {
+  VTR_ASSERT(word_id < bit_value_words_.size());
+
+  return bit_value_words_[word_id];
+}
+
 /* Find the child block in a bitstream manager with a given name */
+size_t BitstreamManager::num_bits_with_value(const bool& value) const {
+  /* Unused positions of the last word are zeros, which do not impact the counting */
+  size_t num_ones = count_word_ones(bit_value_words_.data(), bit_value_words_.size());
+
+  if (true == value) {
+    return num_ones;
+  }
+  return num_bits_ - num_ones;
+}
+
+size_t BitstreamManager::block_num_bits_with_value(const ConfigBlockId& block_id,
+                                                   const bool& value) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  size_t num_block_bits = block_bit_lengths_[block_id];
+  if (0 == num_block_bits) {
+    return 0;
+  }
+
+  /* The bits of a block are contiguous: count the partial words at both ends with masks
+   * and the full words in between with the word kernel
+   */
+  size_t bit_index = block_bit_id_lsbs_[block_id];
+  size_t last_bit_index = bit_index + num_block_bits;
+  size_t first_word = bit_index / BIT_VALUE_WORD_SIZE;
+  size_t last_word = (last_bit_index - 1) / BIT_VALUE_WORD_SIZE;
+
+  uint64_t head_mask = ~uint64_t(0) << (bit_index % BIT_VALUE_WORD_SIZE);
+  uint64_t tail_mask = ~uint64_t(0) >> (BIT_VALUE_WORD_SIZE - 1 - (last_bit_index - 1) % BIT_VALUE_WORD_SIZE);
+
+  size_t num_ones = 0;
+  if (first_word == last_word) {
+    num_ones = __builtin_popcountll(bit_value_words_[first_word] & head_mask & tail_mask);
+  } else {
+    num_ones = __builtin_popcountll(bit_value_words_[first_word] & head_mask)
+             + count_word_ones(bit_value_words_.data() + first_word + 1, last_word - first_word - 1)
+             + __builtin_popcountll(bit_value_words_[last_word] & tail_mask);
+  }
+
+  if (true == value) {
+    return num_ones;
+  }
+  return num_block_bits - num_ones;
+}
+
+size_t BitstreamManager::num_leading_bits_with_value(const ConfigBitId& first_bit,
+                                                     const size_t& max_num_bits,
+                                                     const bool& value) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_bit_id(first_bit));
+
+  size_t bit_index = size_t(first_bit);
+  size_t last_bit_index = std::min(num_bits_, bit_index + max_num_bits);
+  /* Flip the words when counting logic '1', so that we always look for the first '1' */
+  uint64_t flip_mask = (true == value) ? ~uint64_t(0) : uint64_t(0);
+
+  while (bit_index < last_bit_index) {
+    size_t offset = bit_index % BIT_VALUE_WORD_SIZE;
+    uint64_t word = (bit_value_words_[bit_index / BIT_VALUE_WORD_SIZE] ^ flip_mask) >> offset;
+    size_t num_word_bits = std::min(BIT_VALUE_WORD_SIZE - offset, last_bit_index - bit_index);
+    if (0 != word) {
+      size_t num_equal_bits = __builtin_ctzll(word);
+      if (num_equal_bits < num_word_bits) {
+        return bit_index + num_equal_bits - size_t(first_bit);
+      }
+    }
+    bit_index += num_word_bits;
+  }
+
+  return last_bit_index - size_t(first_bit);
+}
+
 ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id, 
                                                  const std::string& child_block_name) const {
   /* Ensure the input ids are valid */
@@ -108,8 +293,14 @@ ConfigBlockId BitstreamManager::find_child_block(const ConfigBlockId& block_id,
 
   std::vector<ConfigBlockId> candidates;
 
-  for (const ConfigBlockId& child : block_children(block_id)) {
-    if (0 == child_block_name.compare(block_name(child))) {
+  /* A name which is not in the string pool cannot be the name of any block */
+  vtr::StringId child_block_name_id = string_pool_.find(child_block_name);
+  if (vtr::StringId::INVALID() == child_block_name_id) {
+    return ConfigBlockId::INVALID();
+  }
+
+  for (const ConfigBlockId& child : child_block_ids_[block_id]) {
+    if (child_block_name_id == block_name_ids_[child]) {
       candidates.push_back(child);
     }
   }
@@ -134,36 +325,45 @@ std::string BitstreamManager::block_input_net_ids(const ConfigBlockId& block_id)
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_input_net_ids_[block_id];
+  return join_strings(block_input_net_ids_[block_id]);
 }
 
 std::string BitstreamManager::block_output_net_ids(const ConfigBlockId& block_id) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
-  return block_output_net_ids_[block_id];
+  return join_strings(block_output_net_ids_[block_id]);
 }
 
-/******************************************************************************
- * Public Mutators
- ******************************************************************************/
-ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block, const bool& bit_value) {
-  ConfigBitId bit = ConfigBitId(num_bits_);
-  /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
-  if (true == bit_value) {
-    bit_values_.push_back('1');
-  } else {
-    bit_values_.push_back('0');
+std::vector<std::string> BitstreamManager::block_input_nets(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  std::vector<std::string> nets;
+  nets.reserve(block_input_net_ids_[block_id].size());
+  for (const vtr::StringId& net_id : block_input_net_ids_[block_id]) {
+    nets.push_back(string_pool_.str(net_id));
   }
+  return nets;
+}
 
-  bit_parent_blocks_.push_back(parent_block);
+std::vector<std::string> BitstreamManager::block_output_nets(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
 
-  return bit; 
+  std::vector<std::string> nets;
+  nets.reserve(block_output_net_ids_[block_id].size());
+  for (const vtr::StringId& net_id : block_output_net_ids_[block_id]) {
+    nets.push_back(string_pool_.str(net_id));
+  }
+  return nets;
 }
 
+/******************************************************************************
+ * Public Mutators
+ ******************************************************************************/
 void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
-  block_names_.reserve(num_blocks);
+  block_name_ids_.reserve(num_blocks);
   block_bit_id_lsbs_.reserve(num_blocks);
   block_bit_lengths_.reserve(num_blocks);
   block_path_ids_.reserve(num_blocks);
@@ -174,14 +374,14 @@ void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
 }
 
 void BitstreamManager::reserve_bits(const size_t& num_bits) {
-  bit_values_.reserve(num_bits);
+  bit_value_words_.reserve((num_bits + BIT_VALUE_WORD_SIZE - 1) / BIT_VALUE_WORD_SIZE);
 }
 
 ConfigBlockId BitstreamManager::create_block() {
   ConfigBlockId block = ConfigBlockId(num_blocks_);
   /* Add a new bit, and allocate associated data structures */
   num_blocks_++;
-  block_names_.emplace_back();
+  block_name_ids_.push_back(vtr::StringPool::empty_string_id());
   block_bit_id_lsbs_.emplace_back(-1);
   block_bit_lengths_.emplace_back(0);
   block_path_ids_.push_back(-2);
@@ -204,7 +404,7 @@ void BitstreamManager::set_block_name(const ConfigBlockId& block_id,
                                       const std::string& block_name) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
-  block_names_[block_id] = block_name;
+  block_name_ids_[block_id] = string_pool_.intern(block_name);
 }
 
 void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
@@ -239,11 +439,93 @@ void BitstreamManager::add_block_bits(const ConfigBlockId& block,
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
 
+  /* Bits of a block should be added only once, so that they are contiguous */
+  VTR_ASSERT(0 == block_bit_lengths_[block]);
+
   /* Add the bit to the block, record anchors in bit indexing for block-level searching */
   block_bit_id_lsbs_[block] = num_bits_;
   block_bit_lengths_[block] = block_bitstream.size();
+  if (block_bitstream.empty()) {
+    return;
+  }
+  bit_blocks_.push_back(block);
+
   for (const bool& bit : block_bitstream) {
-    add_bit(block, bit);
+    add_bit(bit);
+  }
+}
+
+void BitstreamManager::add_block_bit_words(const ConfigBlockId& block,
+                                           const uint64_t* words,
+                                           const size_t& first_bit,
+                                           const size_t& num_bits) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+
+  /* Bits of a block should be added only once, so that they are contiguous */
+  VTR_ASSERT(0 == block_bit_lengths_[block]);
+
+  /* Add the bit to the block, record anchors in bit indexing for block-level searching */
+  block_bit_id_lsbs_[block] = num_bits_;
+  block_bit_lengths_[block] = num_bits;
+  VTR_ASSERT(size_t(block_bit_lengths_[block]) == num_bits);
+  if (0 == num_bits) {
+    return;
+  }
+  bit_blocks_.push_back(block);
+
+  /* Copy the bits by chunks of a word, each chunk may span two source words */
+  bit_value_words_.resize((num_bits_ + num_bits + BIT_VALUE_WORD_SIZE - 1) / BIT_VALUE_WORD_SIZE, 0);
+  for (size_t ibit = 0; ibit < num_bits; ibit += BIT_VALUE_WORD_SIZE) {
+    size_t src_bit = first_bit + ibit;
+    size_t src_shift = src_bit % BIT_VALUE_WORD_SIZE;
+    uint64_t chunk = words[src_bit / BIT_VALUE_WORD_SIZE] >> src_shift;
+    size_t chunk_size = std::min(BIT_VALUE_WORD_SIZE, num_bits - ibit);
+    if ((0 != src_shift) && (BIT_VALUE_WORD_SIZE - src_shift < chunk_size)) {
+      chunk |= words[src_bit / BIT_VALUE_WORD_SIZE + 1] << (BIT_VALUE_WORD_SIZE - src_shift);
+    }
+    if (chunk_size < BIT_VALUE_WORD_SIZE) {
+      chunk &= (uint64_t(1) << chunk_size) - 1;
+    }
+
+    size_t dst_bit = num_bits_ + ibit;
+    size_t dst_shift = dst_bit % BIT_VALUE_WORD_SIZE;
+    bit_value_words_[dst_bit / BIT_VALUE_WORD_SIZE] |= chunk << dst_shift;
+    if ((0 != dst_shift) && (BIT_VALUE_WORD_SIZE - dst_shift < chunk_size)) {
+      bit_value_words_[dst_bit / BIT_VALUE_WORD_SIZE + 1] |= chunk >> (BIT_VALUE_WORD_SIZE - dst_shift);
+    }
+  }
+  num_bits_ += num_bits;
+}
+
+void BitstreamManager::set_block_bits(const ConfigBlockId& block,
+                                      const std::vector<bool>& block_bitstream) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+
+  /* The bit range of the block should not be changed */
+  VTR_ASSERT(size_t(block_bit_lengths_[block]) == block_bitstream.size());
+
+  for (size_t ibit = 0; ibit < block_bitstream.size(); ++ibit) {
+    size_t bit_index = block_bit_id_lsbs_[block] + ibit;
+    uint64_t bit_mask = uint64_t(1) << (bit_index % BIT_VALUE_WORD_SIZE);
+    if (true == block_bitstream[ibit]) {
+      bit_value_words_[bit_index / BIT_VALUE_WORD_SIZE] |= bit_mask;
+    } else {
+      bit_value_words_[bit_index / BIT_VALUE_WORD_SIZE] &= ~bit_mask;
+    }
+  }
+}
+
+void BitstreamManager::set_bit_value(const ConfigBitId& bit_id, const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+
+  uint64_t bit_mask = uint64_t(1) << (size_t(bit_id) % BIT_VALUE_WORD_SIZE);
+  if (true == bit_value) {
+    bit_value_words_[size_t(bit_id) / BIT_VALUE_WORD_SIZE] |= bit_mask;
+  } else {
+    bit_value_words_[size_t(bit_id) / BIT_VALUE_WORD_SIZE] &= ~bit_mask;
   }
 }
 
@@ -261,7 +543,7 @@ void BitstreamManager::add_input_net_id_to_block(const ConfigBlockId& block,
   VTR_ASSERT(true == valid_block_id(block));
 
   /* Add the bit to the block */
-  block_input_net_ids_[block] = input_net_id;
+  block_input_net_ids_[block] = intern_net_names(input_net_id);
 }
 
 void BitstreamManager::add_output_net_id_to_block(const ConfigBlockId& block,
@@ -270,7 +552,220 @@ void BitstreamManager::add_output_net_id_to_block(const ConfigBlockId& block,
   VTR_ASSERT(true == valid_block_id(block));
 
   /* Add the bit to the block */
-  block_output_net_ids_[block] = output_net_id;
+  block_output_net_ids_[block] = intern_net_names(output_net_id);
+}
+
+void BitstreamManager::add_input_nets_to_block(const ConfigBlockId& block,
+                                               const std::vector<std::string>& input_nets) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+
+  block_input_net_ids_[block].clear();
+  block_input_net_ids_[block].reserve(input_nets.size());
+  for (const std::string& net : input_nets) {
+    block_input_net_ids_[block].push_back(string_pool_.intern(net));
+  }
+}
+
+void BitstreamManager::add_output_nets_to_block(const ConfigBlockId& block,
+                                                const std::vector<std::string>& output_nets) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+
+  block_output_net_ids_[block].clear();
+  block_output_net_ids_[block].reserve(output_nets.size());
+  for (const std::string& net : output_nets) {
+    block_output_net_ids_[block].push_back(string_pool_.intern(net));
+  }
+}
+
+void BitstreamManager::add_sub_bitstream(const ConfigBlockId& parent_block,
+                                         const BitstreamManager& sub_bitstream_manager) {
+  size_t block_offset = num_blocks_ - 1;
+  size_t bit_offset = num_bits_;
+
+  vtr::vector<vtr::StringId, vtr::StringId> string_id_map = append_sub_bitstream_bits(parent_block, sub_bitstream_manager, block_offset);
+
+  resize_blocks(block_offset + sub_bitstream_manager.num_blocks_);
+  copy_sub_bitstream_blocks(parent_block, sub_bitstream_manager, block_offset, bit_offset, string_id_map);
+}
+
+void BitstreamManager::add_sub_bitstreams(const ConfigBlockId& parent_block,
+                                          const std::vector<BitstreamManager>& sub_bitstream_managers,
+                                          const size_t& num_threads) {
+  /* Reserve the ranges of block and bit ids for each bitstream manager in order,
+   * where the bits and strings are appended serially 
+   */
+  std::vector<size_t> block_offsets;
+  std::vector<size_t> bit_offsets;
+  std::vector<vtr::vector<vtr::StringId, vtr::StringId>> string_id_maps;
+  block_offsets.reserve(sub_bitstream_managers.size());
+  bit_offsets.reserve(sub_bitstream_managers.size());
+  string_id_maps.reserve(sub_bitstream_managers.size());
+
+  size_t block_offset = num_blocks_ - 1;
+  for (const BitstreamManager& sub_bitstream_manager : sub_bitstream_managers) {
+    block_offsets.push_back(block_offset);
+    bit_offsets.push_back(num_bits_);
+    string_id_maps.push_back(append_sub_bitstream_bits(parent_block, sub_bitstream_manager, block_offset));
+    block_offset += sub_bitstream_manager.num_blocks_ - 1;
+  }
+
+  /* Allocate all the blocks at once, so that each thread only writes its own range of blocks */
+  resize_blocks(block_offset + 1);
+  parallel_for(sub_bitstream_managers.size(), num_threads, [&](const size_t& isub) {
+    copy_sub_bitstream_blocks(parent_block, sub_bitstream_managers[isub],
+                              block_offsets[isub], bit_offsets[isub], string_id_maps[isub]);
+  });
+}
+
+/******************************************************************************
+ * Private Mutators
+ ******************************************************************************/
+ConfigBitId BitstreamManager::add_bit(const bool& bit_value) {
+  ConfigBitId bit = ConfigBitId(num_bits_);
+  /* Allocate a new word when the current words are full */
+  if (0 == num_bits_ % BIT_VALUE_WORD_SIZE) {
+    bit_value_words_.push_back(0);
+  }
+  if (true == bit_value) {
+    bit_value_words_.back() |= uint64_t(1) << (num_bits_ % BIT_VALUE_WORD_SIZE);
+  }
+  /* Add a new bit */
+  num_bits_++;
+
+  return bit; 
+}
+
+std::vector<vtr::StringId> BitstreamManager::intern_net_names(const std::string& net_names) {
+  std::vector<vtr::StringId> net_ids;
+  size_t start = 0;
+  while (start < net_names.size()) {
+    size_t end = net_names.find(' ', start);
+    if (std::string::npos == end) {
+      end = net_names.size();
+    }
+    /* Skip consecutive spaces */
+    if (end > start) {
+      net_ids.push_back(string_pool_.intern(net_names.data() + start, end - start));
+    }
+    start = end + 1;
+  }
+  return net_ids;
+}
+
+std::string BitstreamManager::join_strings(const std::vector<vtr::StringId>& string_ids) const {
+  std::string joined;
+  for (size_t i = 0; i < string_ids.size(); ++i) {
+    if (0 < i) {
+      joined += ' ';
+    }
+    joined.append(string_pool_.c_str(string_ids[i]), string_pool_.length(string_ids[i]));
+  }
+  return joined;
+}
+
+void BitstreamManager::resize_blocks(const size_t& num_blocks) {
+  VTR_ASSERT(num_blocks_ <= num_blocks);
+  num_blocks_ = num_blocks;
+  block_name_ids_.resize(num_blocks, vtr::StringPool::empty_string_id());
+  block_bit_id_lsbs_.resize(num_blocks, -1);
+  block_bit_lengths_.resize(num_blocks, 0);
+  block_path_ids_.resize(num_blocks, -2);
+  block_input_net_ids_.resize(num_blocks);
+  block_output_net_ids_.resize(num_blocks);
+  parent_block_ids_.resize(num_blocks, ConfigBlockId::INVALID());
+  child_block_ids_.resize(num_blocks);
+}
+
+vtr::vector<vtr::StringId, vtr::StringId> BitstreamManager::append_sub_bitstream_bits(const ConfigBlockId& parent_block,
+                                                                const BitstreamManager& sub_bitstream_manager,
+                                                                const size_t& block_offset) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
+  /* The root block should not contain any bits and should not have a parent */
+  ConfigBlockId sub_root_block = ConfigBlockId(0);
+  VTR_ASSERT(true == sub_bitstream_manager.valid_block_id(sub_root_block));
+  VTR_ASSERT(0 == sub_bitstream_manager.block_bit_lengths_[sub_root_block]);
+  VTR_ASSERT(ConfigBlockId::INVALID() == sub_bitstream_manager.parent_block_ids_[sub_root_block]);
+  VTR_ASSERT(true == sub_bitstream_manager.invalid_block_ids_.empty());
+
+  /* Register the children of the root block to the parent block */
+  for (const ConfigBlockId& sub_child : sub_bitstream_manager.child_block_ids_[sub_root_block]) {
+    child_block_ids_[parent_block].push_back(ConfigBlockId(size_t(sub_child) + block_offset));
+  }
+
+  /* The root block has no bits, so that all the blocks with bits are shifted */
+  for (const ConfigBlockId& sub_block : sub_bitstream_manager.bit_blocks_) {
+    bit_blocks_.push_back(ConfigBlockId(size_t(sub_block) + block_offset));
+  }
+
+  /* Append the bit values word by word, shifting words when the current bits do not end at a word boundary */
+  size_t shift = num_bits_ % BIT_VALUE_WORD_SIZE;
+  for (const uint64_t& word : sub_bitstream_manager.bit_value_words_) {
+    if (0 == shift) {
+      bit_value_words_.push_back(word);
+    } else {
+      bit_value_words_.back() |= word << shift;
+      bit_value_words_.push_back(word >> (BIT_VALUE_WORD_SIZE - shift));
+    }
+  }
+  num_bits_ += sub_bitstream_manager.num_bits_;
+  bit_value_words_.resize((num_bits_ + BIT_VALUE_WORD_SIZE - 1) / BIT_VALUE_WORD_SIZE);
+
+  /* Map the strings of the other bitstream manager to the string pool here */
+  const vtr::StringPool& sub_string_pool = sub_bitstream_manager.string_pool_;
+  vtr::vector<vtr::StringId, vtr::StringId> string_id_map;
+  string_id_map.reserve(sub_string_pool.size());
+  for (size_t istr = 0; istr < sub_string_pool.size(); ++istr) {
+    vtr::StringId sub_string_id = vtr::StringId(istr);
+    string_id_map.push_back(string_pool_.intern(sub_string_pool.c_str(sub_string_id), sub_string_pool.length(sub_string_id)));
+  }
+  return string_id_map;
+}
+
+void BitstreamManager::copy_sub_bitstream_blocks(const ConfigBlockId& parent_block,
+                                                 const BitstreamManager& sub_bitstream_manager,
+                                                 const size_t& block_offset,
+                                                 const size_t& bit_offset,
+                                                 const vtr::vector<vtr::StringId, vtr::StringId>& string_id_map) {
+  ConfigBlockId sub_root_block = ConfigBlockId(0);
+  auto map_block = [&](const ConfigBlockId& sub_block) {
+    if (sub_root_block == sub_block) {
+      return parent_block;
+    }
+    VTR_ASSERT(ConfigBlockId::INVALID() != sub_block);
+    return ConfigBlockId(size_t(sub_block) + block_offset);
+  };
+  auto map_string_ids = [&](const std::vector<vtr::StringId>& sub_string_ids) {
+    std::vector<vtr::StringId> string_ids;
+    string_ids.reserve(sub_string_ids.size());
+    for (const vtr::StringId& sub_string_id : sub_string_ids) {
+      string_ids.push_back(string_id_map[sub_string_id]);
+    }
+    return string_ids;
+  };
+
+  VTR_ASSERT(block_offset + sub_bitstream_manager.num_blocks_ <= num_blocks_);
+  for (size_t iblk = 1; iblk < sub_bitstream_manager.num_blocks_; ++iblk) {
+    ConfigBlockId sub_block = ConfigBlockId(iblk);
+    ConfigBlockId block = map_block(sub_block);
+    block_name_ids_[block] = string_id_map[sub_bitstream_manager.block_name_ids_[sub_block]];
+    block_path_ids_[block] = sub_bitstream_manager.block_path_ids_[sub_block];
+    block_input_net_ids_[block] = map_string_ids(sub_bitstream_manager.block_input_net_ids_[sub_block]);
+    block_output_net_ids_[block] = map_string_ids(sub_bitstream_manager.block_output_net_ids_[sub_block]);
+    parent_block_ids_[block] = map_block(sub_bitstream_manager.parent_block_ids_[sub_block]);
+    child_block_ids_[block].reserve(sub_bitstream_manager.child_block_ids_[sub_block].size());
+    for (const ConfigBlockId& sub_child : sub_bitstream_manager.child_block_ids_[sub_block]) {
+      child_block_ids_[block].push_back(map_block(sub_child));
+    }
+    /* Blocks whose bits are never added keep an invalid lsb */
+    block_bit_lengths_[block] = sub_bitstream_manager.block_bit_lengths_[sub_block];
+    if (size_t(-1) != sub_bitstream_manager.block_bit_id_lsbs_[sub_block]) {
+      block_bit_id_lsbs_[block] = sub_bitstream_manager.block_bit_id_lsbs_[sub_block] + bit_offset;
+    }
+  }
 }
 
 /******************************************************************************
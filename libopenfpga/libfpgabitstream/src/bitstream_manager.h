@@ -29,16 +29,32 @@
  * 1. Each block inside BitstreamManager should have only 1 parent block 
  *    and multiple child block
  * 2. Each bit inside BitstreamManager should have only 1 parent block 
+ * 3. The bits of a block are added all at once (see add_block_bits()),
+ *    so that the bits of each block occupy a contiguous range of bit ids
+ * 
+ * Storage
+ * -------
+ * Bit values are packed into 64-bit words, i.e., bit 'i' is stored 
+ * in the (i % 64)-th position of the (i / 64)-th word.
+ * The parent block of a bit is not stored per bit, but derived
+ * from the bit ranges [lsb, lsb + length) of blocks
+ * Block names and net names are stored once in a pool of unique strings,
+ * while blocks only store the ids of the strings in the pool, 
+ * as most of the names repeat across the fabric
  * 
  ******************************************************************************/
 #ifndef BITSTREAM_MANAGER_H
 #define BITSTREAM_MANAGER_H
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <map>
 #include <unordered_set>
 #include <unordered_map>
 #include "vtr_vector.h"
+#include "vtr_string_pool.h"
+#include "openfpga_id_iterator.h"
 
 #include "bitstream_manager_fwd.h"
 
@@ -46,62 +62,18 @@
 namespace openfpga {
 
 class BitstreamManager {
-  public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
-      public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
-
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
-            return *this;
-        }
-
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
-
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
-
-      private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
-    };
-
   public: /* Public constructor */
     BitstreamManager();
 
   public: /* Types and ranges */
-    //Lazy iterator utility forward declaration
+    //Lazy iterator utility, which is shared by the data structures with ID spaces
+    template<class ID>
+    using lazy_id_iterator = LazyIdIterator<ID>;
+
     template<class ID>
-    class lazy_id_iterator;
+    using dense_id_iterator = DenseIdIterator<ID>;
 
-    typedef lazy_id_iterator<ConfigBitId> config_bit_iterator;
+    typedef dense_id_iterator<ConfigBitId> config_bit_iterator;
     typedef lazy_id_iterator<ConfigBlockId> config_block_iterator;
 
     typedef vtr::Range<config_bit_iterator> config_bit_range;
@@ -116,6 +88,9 @@ class BitstreamManager {
     config_block_range blocks() const;
 
   public:  /* Public Accessors */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
+
     /* Find the value of bitstream */
     bool bit_value(const ConfigBitId& bit_id) const;
 
@@ -134,22 +109,69 @@ class BitstreamManager {
     /* Find all the bits that belong to a block */
     std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
 
+    /* Find the number of bits that belong to a block */
+    size_t block_num_bits(const ConfigBlockId& block_id) const;
+
+    /* Find the first bit that belongs to a block, 
+     * Return an invalid id if the block has no bits
+     */
+    ConfigBitId block_first_bit(const ConfigBlockId& block_id) const;
+
+    /* Find the values of all the bits that belong to a block */
+    std::vector<bool> block_bit_values(const ConfigBlockId& block_id) const;
+
+    /* Find the values of all the bits that belong to a block, 
+     * packed into 64-bit words: the first bit of the block is
+     * the least significant bit of the first word.
+     * Unused positions of the last word are filled with zeros
+     */
+    std::vector<uint64_t> block_bit_value_words(const ConfigBlockId& block_id) const;
+
+    /* Find the number of 64-bit words used to store all the bit values */
+    size_t num_bit_value_words() const;
+
+    /* Find the 64-bit word which contains the values of 
+     * the bits [64 * word_id, 64 * word_id + 63] 
+     * Unused positions of the last word are filled with zeros
+     */
+    uint64_t bit_value_word(const size_t& word_id) const;
+
+    /* Count the number of bits whose value is the given one */
+    size_t num_bits_with_value(const bool& value) const;
+
+    /* Count the number of bits of a block (its child blocks excluded) 
+     * whose value is the given one. Bits are counted word by word 
+     */
+    size_t block_num_bits_with_value(const ConfigBlockId& block_id,
+                                     const bool& value) const;
+
+    /* Count the number of consecutive bits, starting from a given bit, 
+     * whose value is the given one. At most max_num_bits are counted.
+     * Bits are compared word by word 
+     */
+    size_t num_leading_bits_with_value(const ConfigBitId& first_bit,
+                                       const size_t& max_num_bits,
+                                       const bool& value) const;
+
     /* Find the child block in a bitstream manager with a given name */
     ConfigBlockId find_child_block(const ConfigBlockId& block_id, const std::string& child_block_name) const;
 
     /* Find path id of a block */
     int block_path_id(const ConfigBlockId& block_id) const;
 
-    /* Find input net ids of a block */
+    /* Find input net ids of a block, which are the net names separated by spaces */
     std::string block_input_net_ids(const ConfigBlockId& block_id) const;
 
-    /* Find input net ids of a block */
+    /* Find output net ids of a block, which are the net names separated by spaces */
     std::string block_output_net_ids(const ConfigBlockId& block_id) const;
 
-  public:  /* Public Mutators */
-    /* Add a new configuration bit to the bitstream manager */
-    ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
+    /* Find the names of the input nets of a block */
+    std::vector<std::string> block_input_nets(const ConfigBlockId& block_id) const;
+
+    /* Find the names of the output nets of a block */
+    std::vector<std::string> block_output_nets(const ConfigBlockId& block_id) const;
 
+  public:  /* Public Mutators */
     /* Reserve memory for a number of clocks */
     void reserve_blocks(const size_t& num_blocks);
 
@@ -173,19 +195,66 @@ class BitstreamManager {
     /* Set a block as a child block of another */
     void add_child_block(const ConfigBlockId& parent_block, const ConfigBlockId& child_block);
 
-    /* Add a bitstream to a block */
+    /* Add a bitstream to a block 
+     * Note that the bits of a block can be added only once
+     */
     void add_block_bits(const ConfigBlockId& block,
                         const std::vector<bool>& block_bitstream);
 
+    /* Add a bitstream to a block, whose values are packed in 64-bit words:
+     * the bits [first_bit, first_bit + num_bits - 1] of the words are added,
+     * where the i-th bit is the (i % 64)-th least significant bit of the (i / 64)-th word
+     * Note that the bits of a block can be added only once
+     */
+    void add_block_bit_words(const ConfigBlockId& block,
+                             const uint64_t* words,
+                             const size_t& first_bit,
+                             const size_t& num_bits);
+
+    /* Overwrite the bitstream of a block 
+     * Note that the new bitstream must have the same length as the existing one
+     */
+    void set_block_bits(const ConfigBlockId& block,
+                        const std::vector<bool>& block_bitstream);
+
+    /* Overwrite the value of a configuration bit */
+    void set_bit_value(const ConfigBitId& bit_id, const bool& bit_value);
+
     /* Add a path id to a block */
     void add_path_id_to_block(const ConfigBlockId& block, const int& path_id);
  
-    /* Add an input net id to a block */
+    /* Add input net ids to a block, which are the net names separated by spaces */
     void add_input_net_id_to_block(const ConfigBlockId& block, const std::string& input_net_id);
 
-    /* Add an output net id to a block */
+    /* Add output net ids to a block, which are the net names separated by spaces */
     void add_output_net_id_to_block(const ConfigBlockId& block, const std::string& output_net_id);
 
+    /* Add the names of input nets to a block */
+    void add_input_nets_to_block(const ConfigBlockId& block, const std::vector<std::string>& input_nets);
+
+    /* Add the names of output nets to a block */
+    void add_output_nets_to_block(const ConfigBlockId& block, const std::vector<std::string>& output_nets);
+
+    /* Append all the blocks and bits of another bitstream manager 
+     * The first block of the other bitstream manager is considered as its root, 
+     * which is not copied but replaced by the given parent block, 
+     * i.e., the children of the root become the children of the parent block.
+     * Block and bit ids are shifted by the current number of blocks and bits, 
+     * so that the result is exactly the same as if the blocks and bits 
+     * were added to this bitstream manager directly
+     */
+    void add_sub_bitstream(const ConfigBlockId& parent_block,
+                           const BitstreamManager& sub_bitstream_manager);
+
+    /* Append all the blocks and bits of a number of bitstream managers, 
+     * which is the same as calling add_sub_bitstream() for each of them in order.
+     * The range of block and bit ids of each bitstream manager is reserved in advance,
+     * so that the blocks are copied by multiple threads without any locking
+     */
+    void add_sub_bitstreams(const ConfigBlockId& parent_block,
+                            const std::vector<BitstreamManager>& sub_bitstream_managers,
+                            const size_t& num_threads);
+
   public:  /* Public Validators */
     bool valid_bit_id(const ConfigBitId& bit_id) const;
 
@@ -193,6 +262,38 @@ class BitstreamManager {
 
     bool valid_block_path_id(const ConfigBlockId& block_id) const;
 
+  private: /* Private Mutators */
+    /* Add a new configuration bit to the end of bitstream manager */
+    ConfigBitId add_bit(const bool& bit_value);
+
+    /* Find the ids of net names which are separated by spaces */
+    std::vector<vtr::StringId> intern_net_names(const std::string& net_names);
+
+    /* Join the strings of ids with spaces */
+    std::string join_strings(const std::vector<vtr::StringId>& string_ids) const;
+
+    /* Allocate blocks with default values until the given number of blocks is reached */
+    void resize_blocks(const size_t& num_blocks);
+
+    /* Serial part of appending another bitstream manager, whose blocks are mapped
+     * to the ids starting from (block_offset + 1), i.e., the root is skipped.
+     * Register the children of its root to the parent block, append its bits 
+     * and return the ids of its strings in the string pool
+     */
+    vtr::vector<vtr::StringId, vtr::StringId> append_sub_bitstream_bits(const ConfigBlockId& parent_block,
+                                                  const BitstreamManager& sub_bitstream_manager,
+                                                  const size_t& block_offset);
+
+    /* Copy the blocks of another bitstream manager to the blocks which are allocated already.
+     * Only the blocks in the range of the other bitstream manager are changed,
+     * so that different bitstream managers can be copied in parallel
+     */
+    void copy_sub_bitstream_blocks(const ConfigBlockId& parent_block,
+                                   const BitstreamManager& sub_bitstream_manager,
+                                   const size_t& block_offset,
+                                   const size_t& bit_offset,
+                                   const vtr::vector<vtr::StringId, vtr::StringId>& string_id_map);
+
   private: /* Internal data */
     /* Unique id of a block of bits in the Bitstream */
     size_t num_blocks_; 
@@ -207,7 +308,7 @@ class BitstreamManager {
      * Note that the blocks here all unique, unlike ModuleManager where modules can be instanciated 
      * Therefore, this block graph can be considered as a flattened graph of ModuleGraph
      */
-    vtr::vector<ConfigBlockId, std::string> block_names_; 
+    vtr::vector<ConfigBlockId, vtr::StringId> block_name_ids_; 
     vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_; 
     vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_; 
 
@@ -230,15 +331,20 @@ class BitstreamManager {
      *   -Bitstream manager will NOT check if the id is good for bitstream builders
      *    It just store the results
      */
-    vtr::vector<ConfigBlockId, std::string> block_input_net_ids_; 
-    vtr::vector<ConfigBlockId, std::string> block_output_net_ids_; 
+    vtr::vector<ConfigBlockId, std::vector<vtr::StringId>> block_input_net_ids_; 
+    vtr::vector<ConfigBlockId, std::vector<vtr::StringId>> block_output_net_ids_; 
+
+    /* Pool of unique strings, i.e., block names and net names */
+    vtr::StringPool string_pool_;
 
     /* Unique id of a bit in the Bitstream */
     size_t num_bits_; 
-    std::unordered_set<ConfigBitId> invalid_bit_ids_; 
-    /* value of a bit in the Bitstream */
-    vtr::vector<ConfigBitId, char> bit_values_;
-    vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+    /* value of the bits in the Bitstream, packed by 64 bits per word */
+    std::vector<uint64_t> bit_value_words_;
+    /* Blocks which contain bits, sorted by the lsb of their bit ranges 
+     * This is used to find the parent block of a bit 
+     */
+    std::vector<ConfigBlockId> bit_blocks_;
 };
 
 } /* end namespace openfpga */
@@ -9,12 +9,20 @@
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 
 #include "bitstream_manager_utils.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of jobs per thread to be built before merging, 
+ * which trades off the load balance and the peak memory usage */
+constexpr size_t NUM_BITSTREAM_BUILD_JOBS_PER_THREAD = 16;
+
 /********************************************************************
  * Recursively find the hierarchy of a block of bitstream manager 
  * Return a vector of the block ids, where the top-level block 
@@ -60,15 +68,11 @@ std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(const BitstreamMana
  *******************************************************************/
 size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamManager& bitstream_manager,
                                                                const ConfigBitId& bit_id) {
-  size_t curr_index = 0;
-  for (const ConfigBitId& cand_bit : bitstream_manager.block_bits(bitstream_manager.bit_parent_block(bit_id))) {
-    if (cand_bit == bit_id) {
-      break;
-    }
-    curr_index++;
-  }
+  /* Bits of a block are contiguous, the index is the offset to the first bit of the block */
+  ConfigBitId first_bit = bitstream_manager.block_first_bit(bitstream_manager.bit_parent_block(bit_id));
+  VTR_ASSERT(true == bitstream_manager.valid_bit_id(first_bit));
 
-  return curr_index;
+  return size_t(bit_id) - size_t(first_bit);
 }
 
 /********************************************************************
@@ -80,9 +84,9 @@ size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamMa
 size_t rec_find_bitstream_manager_block_sum_of_bits(const BitstreamManager& bitstream_manager,
                                                     const ConfigBlockId& block) {
   /* For leaf block, return directly with the number of bits, because it has not child block */
-  if (0 < bitstream_manager.block_bits(block).size()) {
+  if (0 < bitstream_manager.block_num_bits(block)) {
     VTR_ASSERT_SAFE(bitstream_manager.block_children(block).empty());
-    return bitstream_manager.block_bits(block).size();
+    return bitstream_manager.block_num_bits(block);
   }
 
   size_t sum_of_bits = 0;
@@ -94,4 +98,203 @@ size_t rec_find_bitstream_manager_block_sum_of_bits(const BitstreamManager& bits
   return sum_of_bits;
 }
 
+/********************************************************************
+ * Accumulate the number of configuration bits of all the blocks 
+ * under a root block (the root block included) in a post-order traversal
+ * The blocks are first collected in pre-order, where a parent block
+ * is always ahead of its child blocks. Visiting the blocks in the reversed order,
+ * the sum of bits of a block is complete when it is added to its parent
+ *
+ * Note: only the entries of the blocks under the root block are modified, 
+ *       so that different subtrees can be processed by different threads
+ *******************************************************************/
+static 
+void accumulate_bitstream_manager_subtree_sum_of_bits(const BitstreamManager& bitstream_manager,
+                                                      const ConfigBlockId& root_block,
+                                                      vtr::vector<ConfigBlockId, size_t>& block_sum_of_bits) {
+  std::vector<ConfigBlockId> preorder_blocks;
+  std::vector<ConfigBlockId> block_stack(1, root_block);
+  while (!block_stack.empty()) {
+    ConfigBlockId block = block_stack.back();
+    block_stack.pop_back();
+    preorder_blocks.push_back(block);
+    for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+      block_stack.push_back(child_block);
+    }
+  }
+
+  for (auto it = preorder_blocks.rbegin(); it != preorder_blocks.rend(); ++it) {
+    block_sum_of_bits[*it] += bitstream_manager.block_num_bits(*it);
+    if (*it != root_block) {
+      block_sum_of_bits[bitstream_manager.block_parent(*it)] += block_sum_of_bits[*it];
+    }
+  }
+}
+
+/********************************************************************
+ * Find the total number of configuration bits under every block 
+ * Unlike rec_find_bitstream_manager_block_sum_of_bits(), which visits
+ * the whole subtree for each block to be queried, this function visits
+ * each block only once, which is linear to the number of blocks
+ *
+ * The subtrees of the child blocks of the top-level blocks 
+ * can be processed in parallel, using a given number of threads
+ * Return a lookup between block ids and their sum of bits
+ *******************************************************************/
+vtr::vector<ConfigBlockId, size_t> find_bitstream_manager_block_sum_of_bits(const BitstreamManager& bitstream_manager,
+                                                                            const size_t& num_threads) {
+  vtr::vector<ConfigBlockId, size_t> block_sum_of_bits(bitstream_manager.num_blocks(), 0);
+
+  for (const ConfigBlockId& top_block : find_bitstream_manager_top_blocks(bitstream_manager)) {
+    std::vector<ConfigBlockId> child_blocks = bitstream_manager.block_children(top_block);
+    parallel_for(child_blocks.size(), num_threads,
+                 [&](const size_t& ichild) {
+                   accumulate_bitstream_manager_subtree_sum_of_bits(bitstream_manager, child_blocks[ichild], block_sum_of_bits);
+                 });
+
+    block_sum_of_bits[top_block] = bitstream_manager.block_num_bits(top_block);
+    for (const ConfigBlockId& child_block : child_blocks) {
+      block_sum_of_bits[top_block] += block_sum_of_bits[child_block];
+    }
+  }
+
+  return block_sum_of_bits;
+}
+
+/********************************************************************
+ * Build the child blocks of a parent block by a number of independent jobs,
+ * where each job adds blocks (and their bits) under the parent block.
+ *
+ * When multiple threads are used, each job is built in a private 
+ * bitstream manager, whose blocks and bits are then appended to 
+ * the bitstream manager in the order of jobs. Therefore, the block and bit ids
+ * are always the same as those built by a single thread, 
+ * and there is no need to canonicalize the ids after building.
+ *
+ * Note: 
+ *   - The jobs must only read shared data, except the bitstream manager given
+ *   - Jobs are built and merged in batches to limit the memory usage 
+ *******************************************************************/
+void build_bitstream_manager_child_blocks(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const size_t& num_jobs,
+                                          const size_t& num_threads,
+                                          const std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)>& build_job) {
+  size_t num_workers = find_num_threads(num_threads);
+
+  /* Build in place when there is a single thread */
+  if (1 == num_workers) {
+    for (size_t ijob = 0; ijob < num_jobs; ++ijob) {
+      build_job(bitstream_manager, parent_block, ijob);
+    }
+    return;
+  }
+
+  size_t batch_size = num_workers * NUM_BITSTREAM_BUILD_JOBS_PER_THREAD;
+  for (size_t batch_start = 0; batch_start < num_jobs; batch_start += batch_size) { 
+    size_t curr_batch_size = std::min(batch_size, num_jobs - batch_start);
+    std::vector<BitstreamManager> sub_bitstream_managers(curr_batch_size);
+
+    parallel_for(curr_batch_size, num_workers, [&](const size_t& ijob) {
+      BitstreamManager& sub_bitstream_manager = sub_bitstream_managers[ijob];
+      ConfigBlockId sub_root_block = sub_bitstream_manager.create_block();
+      build_job(sub_bitstream_manager, sub_root_block, batch_start + ijob);
+    });
+
+    /* Ids are reserved in the order of jobs, while blocks are copied in parallel */
+    bitstream_manager.add_sub_bitstreams(parent_block, sub_bitstream_managers, num_workers);
+  }
+}
+
+/********************************************************************
+ * Recursively copy the bits, path ids and net ids of a block 
+ * in a reference bitstream manager to a block with the same hierarchy
+ * in another bitstream manager.
+ * The ids of the configuration bits whose values are changed are collected
+ *******************************************************************/
+static 
+void rec_update_bitstream_manager_block(BitstreamManager& bitstream_manager,
+                                        const ConfigBlockId& block,
+                                        const BitstreamManager& ref_bitstream_manager,
+                                        const ConfigBlockId& ref_block,
+                                        std::vector<ConfigBitId>& changed_bits) {
+  /* The hierarchy of blocks depends only on the fabric, which should never change */
+  VTR_ASSERT(bitstream_manager.block_name(block) == ref_bitstream_manager.block_name(ref_block));
+  VTR_ASSERT(bitstream_manager.block_num_bits(block) == ref_bitstream_manager.block_num_bits(ref_block));
+
+  if (0 < ref_bitstream_manager.block_num_bits(ref_block)) {
+    std::vector<bool> ref_bit_values = ref_bitstream_manager.block_bit_values(ref_block);
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+      if (ref_bit_values[ibit] != bitstream_manager.bit_value(block_bits[ibit])) {
+        changed_bits.push_back(block_bits[ibit]);
+      }
+    }
+    bitstream_manager.set_block_bits(block, ref_bit_values);
+  }
+
+  bitstream_manager.add_path_id_to_block(block, ref_bitstream_manager.block_path_id(ref_block));
+  bitstream_manager.add_input_nets_to_block(block, ref_bitstream_manager.block_input_nets(ref_block));
+  bitstream_manager.add_output_nets_to_block(block, ref_bitstream_manager.block_output_nets(ref_block));
+
+  std::vector<ConfigBlockId> child_blocks = bitstream_manager.block_children(block);
+  std::vector<ConfigBlockId> ref_child_blocks = ref_bitstream_manager.block_children(ref_block);
+  VTR_ASSERT(child_blocks.size() == ref_child_blocks.size());
+  for (size_t ichild = 0; ichild < child_blocks.size(); ++ichild) {
+    rec_update_bitstream_manager_block(bitstream_manager, child_blocks[ichild],
+                                       ref_bitstream_manager, ref_child_blocks[ichild],
+                                       changed_bits);
+  }
+}
+
+/********************************************************************
+ * Update the child blocks of a parent block in place 
+ * with the blocks built in a reference bitstream manager,
+ * whose first block is the root of the blocks to update, 
+ * i.e., the one built by build_bitstream_manager_child_blocks()
+ *
+ * Each child block of the root is matched by its name under the parent block,
+ * and should have exactly the same hierarchy. 
+ * As a result, block and bit ids are not changed, and only bit values, 
+ * path ids and net ids are updated.
+ *
+ * The ids of the configuration bits whose values are changed 
+ * are appended to changed_bits
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if a block does not exist under the parent block,
+ *    in which case no block is updated
+ *******************************************************************/
+int update_bitstream_manager_child_blocks(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const BitstreamManager& ref_bitstream_manager,
+                                          std::vector<ConfigBitId>& changed_bits) {
+  ConfigBlockId ref_root_block = ConfigBlockId(0);
+  VTR_ASSERT(true == ref_bitstream_manager.valid_block_id(ref_root_block));
+
+  /* Find all the blocks before updating any of them */
+  std::vector<ConfigBlockId> ref_blocks = ref_bitstream_manager.block_children(ref_root_block);
+  std::vector<ConfigBlockId> blocks;
+  blocks.reserve(ref_blocks.size());
+  for (const ConfigBlockId& ref_block : ref_blocks) {
+    ConfigBlockId block = bitstream_manager.find_child_block(parent_block, ref_bitstream_manager.block_name(ref_block));
+    if (false == bitstream_manager.valid_block_id(block)) {
+      VTR_LOG_ERROR("Unable to find bitstream block '%s' under block '%s'!\n",
+                    ref_bitstream_manager.block_name(ref_block).c_str(),
+                    bitstream_manager.block_name(parent_block).c_str());
+      return 1;
+    }
+    blocks.push_back(block);
+  }
+
+  for (size_t iblock = 0; iblock < blocks.size(); ++iblock) {
+    rec_update_bitstream_manager_block(bitstream_manager, blocks[iblock],
+                                       ref_bitstream_manager, ref_blocks[iblock],
+                                       changed_bits);
+  }
+
+  return 0;
+}
+
 } /* end namespace openfpga */
@@ -4,7 +4,9 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
 #include <vector>
+#include "vtr_vector.h"
 #include "bitstream_manager.h"
 
 /********************************************************************
@@ -17,6 +19,17 @@ namespace openfpga {
 std::vector<ConfigBlockId> find_bitstream_manager_block_hierarchy(const BitstreamManager& bitstream_manager, 
                                                                   const ConfigBlockId& block);
 
+int update_bitstream_manager_child_blocks(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const BitstreamManager& ref_bitstream_manager,
+                                          std::vector<ConfigBitId>& changed_bits);
+
+void build_bitstream_manager_child_blocks(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& parent_block,
+                                          const size_t& num_jobs,
+                                          const size_t& num_threads,
+                                          const std::function<void(BitstreamManager&, const ConfigBlockId&, const size_t&)>& build_job);
+
 std::vector<ConfigBlockId> find_bitstream_manager_top_blocks(const BitstreamManager& bitstream_manager);
 
 size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamManager& bitstream_manager,
@@ -25,6 +38,9 @@ size_t find_bitstream_manager_config_bit_index_in_parent_block(const BitstreamMa
 size_t rec_find_bitstream_manager_block_sum_of_bits(const BitstreamManager& bitstream_manager,
                                                     const ConfigBlockId& block);
 
+vtr::vector<ConfigBlockId, size_t> find_bitstream_manager_block_sum_of_bits(const BitstreamManager& bitstream_manager,
+                                                                            const size_t& num_threads = 1);
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,159 @@
+/********************************************************************
+ * This file includes functions to find the differences between 
+ * two bitstream databases, e.g., from two successive runs,
+ * and to apply the differences to a bitstream database
+ *
+ * Blocks of the two databases are matched by their names in the
+ * hierarchy, so that the two databases do not have to be built
+ * in the same order. Bits of matched blocks are compared word by word
+ *******************************************************************/
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+#include "bitstream_manager_utils.h"
+#include "diff_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of bits in the word-level comparison */
+constexpr size_t DIFF_ARCH_BITSTREAM_WORD_SIZE = 64;
+
+/* When a block has more children than this number, reference children 
+ * are indexed by names rather than searched one by one
+ */
+constexpr size_t DIFF_ARCH_BITSTREAM_MIN_NUM_CHILDREN_TO_INDEX = 16;
+
+/********************************************************************
+ * Compare the bits of a block with those of a reference block word by word, 
+ * and add the different bits to the diff
+ *******************************************************************/
+static
+void diff_bitstream_manager_block_bits(const BitstreamManager& bitstream_manager,
+                                       const ConfigBlockId& block,
+                                       const BitstreamManager& ref_bitstream_manager,
+                                       const ConfigBlockId& ref_block,
+                                       ArchBitstreamDiff& bitstream_diff) {
+  if (0 == bitstream_manager.block_num_bits(block)) {
+    return;
+  }
+
+  std::vector<uint64_t> words = bitstream_manager.block_bit_value_words(block);
+  std::vector<uint64_t> ref_words = ref_bitstream_manager.block_bit_value_words(ref_block);
+  VTR_ASSERT(words.size() == ref_words.size());
+
+  size_t first_bit = size_t(bitstream_manager.block_first_bit(block));
+  for (size_t iword = 0; iword < words.size(); ++iword) {
+    uint64_t diff_word = words[iword] ^ ref_words[iword];
+    while (0 != diff_word) {
+      size_t offset = __builtin_ctzll(diff_word);
+      bitstream_diff.bits.push_back(ConfigBitId(first_bit + iword * DIFF_ARCH_BITSTREAM_WORD_SIZE + offset));
+      diff_word &= diff_word - 1;
+    }
+  }
+}
+
+/********************************************************************
+ * Walk through a block in the bitstream database and its counterpart
+ * in the reference in parallel, until we reach the leaf blocks
+ *******************************************************************/
+static
+void rec_diff_bitstream_manager_block(const BitstreamManager& bitstream_manager,
+                                      const ConfigBlockId& block,
+                                      const BitstreamManager& ref_bitstream_manager,
+                                      const ConfigBlockId& ref_block,
+                                      ArchBitstreamDiff& bitstream_diff) {
+  if (bitstream_manager.block_num_bits(block) != ref_bitstream_manager.block_num_bits(ref_block)) {
+    bitstream_diff.unmatched_blocks.push_back(block);
+  } else {
+    diff_bitstream_manager_block_bits(bitstream_manager, block, ref_bitstream_manager, ref_block, bitstream_diff);
+  }
+
+  std::vector<ConfigBlockId> children = bitstream_manager.block_children(block);
+  std::vector<ConfigBlockId> ref_children = ref_bitstream_manager.block_children(ref_block);
+
+  /* Index the reference children by names for large blocks, e.g., the top-level block */
+  std::unordered_map<std::string, ConfigBlockId> ref_child_lookup;
+  if (DIFF_ARCH_BITSTREAM_MIN_NUM_CHILDREN_TO_INDEX < ref_children.size()) {
+    ref_child_lookup.reserve(ref_children.size());
+    for (const ConfigBlockId& ref_child : ref_children) {
+      ref_child_lookup[ref_bitstream_manager.block_name(ref_child)] = ref_child;
+    }
+  }
+
+  size_t num_matched_children = 0;
+  for (const ConfigBlockId& child : children) {
+    ConfigBlockId ref_child = ConfigBlockId::INVALID();
+    if (true == ref_child_lookup.empty()) {
+      ref_child = ref_bitstream_manager.find_child_block(ref_block, bitstream_manager.block_name(child));
+    } else {
+      auto result = ref_child_lookup.find(bitstream_manager.block_name(child));
+      if (result != ref_child_lookup.end()) {
+        ref_child = result->second;
+      }
+    }
+
+    if (ConfigBlockId::INVALID() == ref_child) {
+      bitstream_diff.unmatched_blocks.push_back(child);
+      continue;
+    }
+    num_matched_children++;
+    rec_diff_bitstream_manager_block(bitstream_manager, child, ref_bitstream_manager, ref_child, bitstream_diff);
+  }
+
+  /* Children names are unique under a block, the remaining ones are only in the reference */
+  bitstream_diff.num_ref_only_blocks += ref_children.size() - num_matched_children;
+}
+
+/********************************************************************
+ * Find the configuration bits of a bitstream database whose values are
+ * different from those in a reference bitstream database
+ * Blocks which cannot be matched are reported in the diff as well,
+ * their bits are not compared
+ *******************************************************************/
+ArchBitstreamDiff diff_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                              const BitstreamManager& ref_bitstream_manager) {
+  vtr::ScopedStartFinishTimer timer("Compare architecture bitstream with the reference");
+
+  ArchBitstreamDiff bitstream_diff;
+
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  std::vector<ConfigBlockId> ref_top_blocks = find_bitstream_manager_top_blocks(ref_bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  VTR_ASSERT(1 == ref_top_blocks.size());
+
+  if (bitstream_manager.block_name(top_blocks[0]) != ref_bitstream_manager.block_name(ref_top_blocks[0])) {
+    bitstream_diff.unmatched_blocks.push_back(top_blocks[0]);
+    bitstream_diff.num_ref_only_blocks = 1;
+    return bitstream_diff;
+  }
+
+  rec_diff_bitstream_manager_block(bitstream_manager, top_blocks[0],
+                                   ref_bitstream_manager, ref_top_blocks[0],
+                                   bitstream_diff);
+
+  std::sort(bitstream_diff.bits.begin(), bitstream_diff.bits.end());
+
+  return bitstream_diff;
+}
+
+/********************************************************************
+ * Apply the differences to the bitstream database which is compared,
+ * so that the values of the bits become the same as the reference.
+ * Block and bit ids are not changed. 
+ * Note that the bits are toggled: applying the same diff twice 
+ * reverts the bitstream database
+ *******************************************************************/
+void apply_architecture_bitstream_diff(BitstreamManager& bitstream_manager,
+                                       const ArchBitstreamDiff& bitstream_diff) {
+  for (const ConfigBitId& bit : bitstream_diff.bits) {
+    bitstream_manager.set_bit_value(bit, !bitstream_manager.bit_value(bit));
+  }
+}
+
+} /* end namespace openfpga */
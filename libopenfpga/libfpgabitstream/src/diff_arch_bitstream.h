@@ -0,0 +1,40 @@
+#ifndef DIFF_ARCH_BITSTREAM_H
+#define DIFF_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <vector>
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Differences between a bitstream database and a reference one
+ * All the ids refer to the bitstream database rather than the reference
+ *******************************************************************/
+struct ArchBitstreamDiff {
+  /* Configuration bits whose values are different from the reference,
+   * sorted by their ids
+   */
+  std::vector<openfpga::ConfigBitId> bits;
+  /* Blocks which are not found in the reference, or have a different number of bits */
+  std::vector<openfpga::ConfigBlockId> unmatched_blocks;
+  /* Number of blocks in the reference which are not found in the bitstream database */
+  size_t num_ref_only_blocks = 0;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+ArchBitstreamDiff diff_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                              const BitstreamManager& ref_bitstream_manager);
+
+void apply_architecture_bitstream_diff(BitstreamManager& bitstream_manager,
+                                       const ArchBitstreamDiff& bitstream_diff);
+
+} /* end namespace openfpga */
+
+#endif
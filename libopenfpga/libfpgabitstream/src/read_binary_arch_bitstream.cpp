@@ -0,0 +1,217 @@
+/********************************************************************
+ * This file includes the functions which read a binary file of 
+ * architecture bitstream, which is written by 
+ * write_binary_architecture_bitstream(), to the bitstream database
+ * The file format is detailed in write_binary_arch_bitstream.cpp
+ *******************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "write_binary_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find a string in the string table of a binary file
+ * Return 0 if the string is found, otherwise return 1
+ *******************************************************************/
+static
+int find_binary_arch_bitstream_string(std::string& str,
+                                      const char* fname,
+                                      const std::vector<uint64_t>& string_table,
+                                      const char* chars,
+                                      const size_t& num_chars,
+                                      const uint64_t& string_id) {
+  if (string_id >= string_table.size() / 2) {
+    VTR_LOG_ERROR("Invalid string id '%lu' in binary architecture bitstream file '%s'!\n",
+                  string_id, fname);
+    return 1;
+  }
+  uint64_t offset = string_table[2 * string_id];
+  uint64_t length = string_table[2 * string_id + 1];
+  if ((offset > num_chars) || (length > num_chars - offset)) {
+    VTR_LOG_ERROR("String '%lu' is out of range in binary architecture bitstream file '%s'!\n",
+                  string_id, fname);
+    return 1;
+  }
+  str.assign(chars + offset, length);
+  return 0;
+}
+
+/********************************************************************
+ * Read a binary file of architecture bitstream
+ * The whole file is loaded with a single read, and the bitstream
+ * database is rebuilt with exactly the same block and bit ids
+ * as when it was written
+ *
+ * Return 0 if the file is read successfully, otherwise return 1.
+ * The file may be corrupted, so every id and size is checked before use,
+ * and the bitstream database is not touched if there is any error
+ *******************************************************************/
+int read_binary_architecture_bitstream(BitstreamManager& bitstream_manager,
+                                       const char* fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read binary Architecture Bitstream file");
+
+  /* Load the file */
+  std::ifstream fp(fname, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Unable to open binary architecture bitstream file '%s'!\n",
+                  fname);
+    return 1;
+  }
+  size_t file_size = fp.tellg();
+  if ((0 != file_size % sizeof(uint64_t))
+     || (file_size < BINARY_ARCH_BITSTREAM_NUM_HEADER_WORDS * sizeof(uint64_t))) {
+    VTR_LOG_ERROR("Invalid size of binary architecture bitstream file '%s'!\n",
+                  fname);
+    return 1;
+  }
+  std::vector<uint64_t> words(file_size / sizeof(uint64_t));
+  fp.seekg(0);
+  fp.read(reinterpret_cast<char*>(words.data()), file_size);
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to read binary architecture bitstream file '%s'!\n",
+                  fname);
+    return 1;
+  }
+  fp.close();
+
+  /* Check the header */
+  if ((0 != std::memcmp(words.data(), BINARY_ARCH_BITSTREAM_MAGIC, sizeof(uint64_t)))
+     || (BINARY_ARCH_BITSTREAM_ENDIAN_MARKER != words[1])) {
+    VTR_LOG_ERROR("'%s' is not a binary architecture bitstream file or written by a machine with a different byte order!\n",
+                  fname);
+    return 1;
+  }
+  if (BINARY_ARCH_BITSTREAM_VERSION != words[2]) {
+    VTR_LOG_ERROR("Unsupported version '%lu' of binary architecture bitstream file '%s' (expect '%lu')!\n",
+                  words[2], fname, BINARY_ARCH_BITSTREAM_VERSION);
+    return 1;
+  }
+  size_t num_blocks = words[3];
+  size_t num_bits = words[4];
+  size_t num_strings = words[5];
+  size_t num_children = words[6];
+  size_t num_chars = words[7];
+
+  /* Locate each section */
+  if ((num_blocks > words.size()) || (num_children > words.size())
+     || (num_strings > words.size()) || (num_chars > file_size)
+     || (num_bits > 64 * words.size())) {
+    VTR_LOG_ERROR("Size of binary architecture bitstream file '%s' does not match its header!\n",
+                  fname);
+    return 1;
+  }
+  size_t block_table_offset = BINARY_ARCH_BITSTREAM_NUM_HEADER_WORDS;
+  size_t child_table_offset = block_table_offset + BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * num_blocks;
+  size_t string_table_offset = child_table_offset + num_children;
+  size_t chars_offset = string_table_offset + 2 * num_strings;
+  size_t bits_offset = chars_offset + (num_chars + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  size_t expected_num_words = bits_offset + (num_bits + 63) / 64;
+  if (expected_num_words != words.size()) {
+    VTR_LOG_ERROR("Size of binary architecture bitstream file '%s' does not match its header!\n",
+                  fname);
+    return 1;
+  }
+
+  const uint64_t* block_table = words.data() + block_table_offset;
+  const uint64_t* child_table = words.data() + child_table_offset;
+  std::vector<uint64_t> string_table(words.begin() + string_table_offset, words.begin() + chars_offset);
+  const char* chars = reinterpret_cast<const char*>(words.data() + chars_offset);
+
+  BitstreamManager read_bitstream_manager;
+  read_bitstream_manager.reserve_blocks(num_blocks);
+  read_bitstream_manager.reserve_bits(num_bits);
+
+  /* Create blocks */
+  std::string block_name;
+  std::string input_net_ids;
+  std::string output_net_ids;
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    const uint64_t* block_words = block_table + BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * iblk;
+    if ( (0 != find_binary_arch_bitstream_string(block_name, fname, string_table, chars, num_chars, block_words[0]))
+      || (0 != find_binary_arch_bitstream_string(input_net_ids, fname, string_table, chars, num_chars, block_words[5]))
+      || (0 != find_binary_arch_bitstream_string(output_net_ids, fname, string_table, chars, num_chars, block_words[6])) ) {
+      return 1;
+    }
+    ConfigBlockId block = read_bitstream_manager.add_block(block_name);
+    VTR_ASSERT(size_t(block) == iblk);
+    read_bitstream_manager.add_path_id_to_block(block, static_cast<int>(static_cast<int64_t>(block_words[4])));
+    read_bitstream_manager.add_input_net_id_to_block(block, input_net_ids);
+    read_bitstream_manager.add_output_net_id_to_block(block, output_net_ids);
+  }
+
+  /* Link child blocks in the same order as they were written */
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    const uint64_t* block_words = block_table + BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * iblk;
+    uint64_t child_offset = block_words[7];
+    uint64_t block_num_children = block_words[8];
+    if ((child_offset > num_children) || (block_num_children > num_children - child_offset)) {
+      VTR_LOG_ERROR("Children of block '%lu' are out of range in binary architecture bitstream file '%s'!\n",
+                    iblk, fname);
+      return 1;
+    }
+    read_bitstream_manager.reserve_child_blocks(ConfigBlockId(iblk), block_num_children);
+    for (size_t ichild = 0; ichild < block_num_children; ++ichild) {
+      uint64_t child = child_table[child_offset + ichild];
+      if ((child >= num_blocks) || (child == iblk)
+         || (iblk != block_table[BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * child + 1])) {
+        VTR_LOG_ERROR("Invalid child block '%lu' of block '%lu' in binary architecture bitstream file '%s'!\n",
+                      child, iblk, fname);
+        return 1;
+      }
+      /* A block may be listed only once as a child, as a block has only one parent */
+      if (true == read_bitstream_manager.valid_block_id(read_bitstream_manager.block_parent(ConfigBlockId(child)))) {
+        VTR_LOG_ERROR("Child block '%lu' is listed more than once in binary architecture bitstream file '%s'!\n",
+                      child, fname);
+        return 1;
+      }
+      read_bitstream_manager.add_child_block(ConfigBlockId(iblk), ConfigBlockId(child));
+    }
+  }
+
+  /* Add bits block by block in the order of their first bits,
+   * so that bit ids are the same as those in the file
+   */
+  std::vector<size_t> bit_blocks;
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    if (BINARY_ARCH_BITSTREAM_INVALID_WORD != block_table[BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * iblk + 2]) {
+      bit_blocks.push_back(iblk);
+    }
+  }
+  std::sort(bit_blocks.begin(), bit_blocks.end(),
+            [&](const size_t& a, const size_t& b) {
+              return block_table[BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * a + 2] < block_table[BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * b + 2];
+            });
+  for (const size_t& iblk : bit_blocks) {
+    const uint64_t* block_words = block_table + BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * iblk;
+    if ((block_words[2] != read_bitstream_manager.num_bits())
+       || (block_words[3] > num_bits - block_words[2])) {
+      VTR_LOG_ERROR("Bits of block '%lu' are out of range or not contiguous in binary architecture bitstream file '%s'!\n",
+                    iblk, fname);
+      return 1;
+    }
+    read_bitstream_manager.add_block_bit_words(ConfigBlockId(iblk), words.data() + bits_offset, block_words[2], block_words[3]);
+  }
+  if (num_bits != read_bitstream_manager.num_bits()) {
+    VTR_LOG_ERROR("Some bits are not assigned to any block in binary architecture bitstream file '%s'!\n",
+                  fname);
+    return 1;
+  }
+
+  bitstream_manager = std::move(read_bitstream_manager);
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,20 @@
+#ifndef READ_BINARY_ARCH_BITSTREAM_H
+#define READ_BINARY_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_binary_architecture_bitstream(BitstreamManager& bitstream_manager,
+                                       const char* fname);
+
+} /* end namespace openfpga */
+
+#endif
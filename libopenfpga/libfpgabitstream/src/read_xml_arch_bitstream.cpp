@@ -1,21 +1,31 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of a fabric key to the associated
+ * which reads an XML of an architecture bitstream to the associated
  * data structures
+ *
+ * The architecture bitstream file can be huge for large FPGA fabrics.
+ * Rather than loading a whole DOM in memory, the file is parsed in a
+ * streaming way: tags are read one by one from a fixed-size buffer,
+ * and bitstream blocks and bits are created on the fly.
+ * Only the subset of XML syntax which is used by the architecture
+ * bitstream writer is supported: elements, attributes, comments,
+ * declarations and the predefined entities.
  *******************************************************************/
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <vector>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /* Headers from libarchfpga */
 #include "arch_error.h"
-#include "read_xml_util.h"
 
 #include "openfpga_reserved_words.h"
 
@@ -24,121 +34,340 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Size of the buffer used when reading the file */
+constexpr size_t XML_ARCH_BITSTREAM_READ_BUFFER_SIZE = 1 << 20;
+
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * A tag parsed from the XML file
  *******************************************************************/
-static 
-void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                  const pugiutil::loc_data& loc_data,
-                                  BitstreamManager& bitstream_manager,
-                                  const ConfigBlockId& parent_block) {
-
-  /* Find the name of this bitstream block */
-  const std::string& block_name = get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name; 
-    } 
-
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
+struct XmlArchBitstreamTag {
+  enum e_tag_type {
+    START,  /* <name ...> */
+    END,    /* </name> */
+    EMPTY   /* <name .../> */
+  };
+
+  e_tag_type type;
+  std::string name;
+  /* Attribute names and values are stored in pairs */
+  std::vector<std::pair<std::string, std::string>> attributes;
+  size_t num_attributes;
+  size_t line;
+
+  /* Return the value of an attribute, or nullptr if not defined */
+  const std::string* find_attribute(const char* attr_name) const {
+    for (size_t iattr = 0; iattr < num_attributes; ++iattr) {
+      if (attributes[iattr].first == attr_name) {
+        return &(attributes[iattr].second);
+      }
     }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str); 
+    return nullptr;
   }
+};
 
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data, pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name = get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name; 
-    } 
-
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
+/********************************************************************
+ * A tokenizer which reads tags one by one from an XML file
+ * Text between tags is ignored.
+ * The attribute storage of a tag is reused between tags
+ * to avoid memory allocation for each tag
+ *******************************************************************/
+class XmlArchBitstreamTagReader {
+  public: /* Constructor and destructor */
+    XmlArchBitstreamTagReader(const char* fname)
+      : fname_(fname), buffer_(XML_ARCH_BITSTREAM_READ_BUFFER_SIZE),
+        buffer_pos_(0), buffer_size_(0), line_(1), file_size_(0) {
+      fp_ = std::fopen(fname, "rb");
+      if (nullptr == fp_) {
+        archfpga_throw(fname, 0,
+                       "Unable to open architecture bitstream file '%s'!\n",
+                       fname);
+      }
+      /* The size is only used to bound the hints of the file, so it is left zero if unknown */
+      if (0 == std::fseek(fp_, 0, SEEK_END)) {
+        long size = std::ftell(fp_);
+        if (0 < size) {
+          file_size_ = static_cast<size_t>(size);
+        }
+      }
+      std::rewind(fp_);
     }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str); 
-  }
+    ~XmlArchBitstreamTagReader() {
+      std::fclose(fp_);
+    }
+    XmlArchBitstreamTagReader(const XmlArchBitstreamTagReader&) = delete;
+    XmlArchBitstreamTagReader& operator=(const XmlArchBitstreamTagReader&) = delete;
+
+  public: /* Public accessors */
+    size_t line() const { return line_; }
+    /* Size of the file in bytes, or zero if unknown */
+    size_t file_size() const { return file_size_; }
+
+  public: /* Public mutators */
+    /* Read the next tag. Return false when reaching the end of file */
+    bool next_tag(XmlArchBitstreamTag& tag) {
+      int c;
+      while (true) {
+        /* Skip text until the next tag */
+        do {
+          c = get_char();
+          if (EOF == c) {
+            return false;
+          }
+        } while ('<' != c);
+
+        tag.line = line_;
+        c = get_char();
+        if ('!' == c) {
+          skip_markup();
+          continue;
+        }
+        if ('?' == c) {
+          skip_until("?>");
+          continue;
+        }
+        break;
+      }
+
+      tag.num_attributes = 0;
+      if ('/' == c) {
+        tag.type = XmlArchBitstreamTag::END;
+        c = read_name(get_char(), tag.name);
+        c = skip_spaces(c);
+        expect(c, '>');
+        return true;
+      }
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data, pugiutil::ReqOpt::OPTIONAL).as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id); 
+      c = read_name(c, tag.name);
+      while (true) {
+        c = skip_spaces(c);
+        if ('>' == c) {
+          tag.type = XmlArchBitstreamTag::START;
+          return true;
+        }
+        if ('/' == c) {
+          expect(get_char(), '>');
+          tag.type = XmlArchBitstreamTag::EMPTY;
+          return true;
+        }
+        /* Parse an attribute: name="value" */
+        if (tag.num_attributes == tag.attributes.size()) {
+          tag.attributes.emplace_back();
+        }
+        std::pair<std::string, std::string>& attr = tag.attributes[tag.num_attributes];
+        c = skip_spaces(read_name(c, attr.first));
+        expect(c, '=');
+        c = skip_spaces(get_char());
+        read_attribute_value(c, attr.second);
+        tag.num_attributes++;
+        c = get_char();
+      }
     }
 
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
+    /* Error out with the current line number */
+    [[noreturn]] void error(const std::string& msg) const {
+      archfpga_throw(fname_, line_, "%s\n", msg.c_str());
+    }
+
+  private: /* Internal functions */
+    int get_char() {
+      if (buffer_pos_ == buffer_size_) {
+        buffer_size_ = std::fread(buffer_.data(), 1, buffer_.size(), fp_);
+        buffer_pos_ = 0;
+        if (0 == buffer_size_) {
+          return EOF;
+        }
+      }
+      int c = static_cast<unsigned char>(buffer_[buffer_pos_++]);
+      if ('\n' == c) {
+        line_++;
       }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
-      block_bits.push_back(1 == bit_value);
+      return c;
     }
-    /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
-  }
-  
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager, curr_block);
+
+    static bool is_space(const int& c) {
+      return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c);
     }
-  } 
+
+    int skip_spaces(int c) {
+      while (is_space(c)) {
+        c = get_char();
+      }
+      return c;
+    }
+
+    void expect(const int& c, const char& expected) {
+      if (c != expected) {
+        error(std::string("Expect '") + expected + std::string("' in XML tag!"));
+      }
+    }
+
+    /* Read a name starting from the given char, return the char after the name */
+    int read_name(int c, std::string& name) {
+      name.clear();
+      while ((EOF != c) && (false == is_space(c))
+          && ('>' != c) && ('/' != c) && ('=' != c)) {
+        name.push_back(static_cast<char>(c));
+        c = get_char();
+      }
+      if (true == name.empty()) {
+        error("Expect a name in XML tag!");
+      }
+      return c;
+    }
+
+    /* Read a quoted value and decode the predefined entities */
+    void read_attribute_value(const int& quote, std::string& value) {
+      if (('"' != quote) && ('\'' != quote)) {
+        error("Expect a quoted attribute value in XML tag!");
+      }
+      value.clear();
+      int c = get_char();
+      while (quote != c) {
+        if (EOF == c) {
+          error("Unexpected end of file in attribute value!");
+        }
+        if ('&' == c) {
+          std::string entity;
+          for (c = get_char(); (';' != c) && (EOF != c) && (entity.size() < 8); c = get_char()) {
+            entity.push_back(static_cast<char>(c));
+          }
+          if ("lt" == entity) {
+            value.push_back('<');
+          } else if ("gt" == entity) {
+            value.push_back('>');
+          } else if ("amp" == entity) {
+            value.push_back('&');
+          } else if ("quot" == entity) {
+            value.push_back('"');
+          } else if ("apos" == entity) {
+            value.push_back('\'');
+          } else {
+            error(std::string("Unsupported XML entity '&") + entity + std::string("'!"));
+          }
+        } else {
+          value.push_back(static_cast<char>(c));
+        }
+        c = get_char();
+      }
+    }
+
+    /* Skip until the given pattern has been read */
+    void skip_until(const char* pattern) {
+      const std::string pattern_str(pattern);
+      size_t num_matched = 0;
+      while (num_matched < pattern_str.size()) {
+        int c = get_char();
+        if (EOF == c) {
+          error(std::string("Unexpected end of file while looking for '") + pattern_str + std::string("'!"));
+        }
+        if (c == pattern_str[num_matched]) {
+          num_matched++;
+        } else {
+          num_matched = (c == pattern_str[0]) ? 1 : 0;
+        }
+      }
+    }
+
+    /* Skip a comment <!-- ... --> or a declaration <!...> */
+    void skip_markup() {
+      int c = get_char();
+      if ('-' == c) {
+        expect(get_char(), '-');
+        skip_until("-->");
+        return;
+      }
+      while ('>' != c) {
+        if (EOF == c) {
+          error("Unexpected end of file in XML declaration!");
+        }
+        c = get_char();
+      }
+    }
+
+  private: /* Internal data */
+    const char* fname_;
+    std::FILE* fp_;
+    std::vector<char> buffer_;
+    size_t buffer_pos_;
+    size_t buffer_size_;
+    size_t line_;
+    size_t file_size_;
+};
+
+/********************************************************************
+ * Find the value of a mandatory attribute of a tag
+ *******************************************************************/
+static
+const std::string& get_arch_bitstream_tag_attribute(const XmlArchBitstreamTagReader& reader,
+                                                    const XmlArchBitstreamTag& tag,
+                                                    const char* attr_name) {
+  const std::string* value = tag.find_attribute(attr_name);
+  if (nullptr == value) {
+    reader.error(std::string("Expect attribute '") + attr_name + std::string("' for <") + tag.name + std::string(">!"));
+  }
+  return *value;
+}
+
+/********************************************************************
+ * Find the integer value of an attribute of a tag
+ * Use the default value if the attribute is not defined
+ *******************************************************************/
+static
+int get_arch_bitstream_tag_int_attribute(const XmlArchBitstreamTagReader& reader,
+                                         const XmlArchBitstreamTag& tag,
+                                         const char* attr_name,
+                                         const int& default_value) {
+  const std::string* value = tag.find_attribute(attr_name);
+  if (nullptr == value) {
+    return default_value;
+  }
+  char* end = nullptr;
+  errno = 0;
+  long int_value = std::strtol(value->c_str(), &end, 10);
+  if ((true == value->empty()) || ('\0' != *end) || (ERANGE == errno)
+     || (std::numeric_limits<int>::min() > int_value) || (std::numeric_limits<int>::max() < int_value)) {
+    reader.error(std::string("Invalid integer '") + *value + std::string("' for attribute '") + attr_name + std::string("' of <") + tag.name + std::string(">!"));
+  }
+  return static_cast<int>(int_value);
+}
+
+/********************************************************************
+ * Find the value of an attribute of a tag which is a hint on a size,
+ * e.g., the number of bits to reserve memory for
+ * A hint never fails the parsing: zero is returned, i.e., no hint,
+ * if the attribute is not defined, is not a valid unsigned integer,
+ * or is larger than the file itself. As each block and each bit
+ * takes more than one byte in the file, such a hint can not be right
+ *******************************************************************/
+static
+size_t get_arch_bitstream_tag_size_hint(const XmlArchBitstreamTagReader& reader,
+                                        const XmlArchBitstreamTag& tag,
+                                        const char* attr_name) {
+  const std::string* value = tag.find_attribute(attr_name);
+  if (nullptr == value) {
+    return 0;
+  }
+  char* end = nullptr;
+  errno = 0;
+  unsigned long long hint = std::strtoull(value->c_str(), &end, 10);
+  if ((true == value->empty()) || (0 == std::isdigit(static_cast<unsigned char>((*value)[0])))
+     || ('\0' != *end) || (ERANGE == errno)
+     || (reader.file_size() < hint)) {
+    VTR_LOG_WARN("Ignore invalid hint '%s' for attribute '%s' of <%s> at line %lu\n",
+                 value->c_str(), attr_name, tag.name.c_str(), tag.line);
+    return 0;
+  }
+  return static_cast<size_t>(hint);
 }
 
 /********************************************************************
  * Parse XML codes about <bitstream> to an object of Bitstream
+ *
+ * The file is read in a streaming way, so that the memory usage is
+ * bounded by the bitstream database rather than the size of file.
+ * The top-level block may provide hints on the number of blocks
+ * ('num_blocks') and bits ('num_bits'), which are only used to reserve
+ * memory in the bitstream database. Invalid hints are ignored
  *******************************************************************/
 BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
@@ -146,51 +375,150 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
-
-    /* Count the child <bitstream_block> */
-
-    pugi::xml_node xml_root = get_single_child(doc, "bitstream_block", loc_data);
+  XmlArchBitstreamTagReader reader(fname);
+  XmlArchBitstreamTag tag;
+
+  /* Names of the elements which are open */
+  std::vector<std::string> element_stack;
+  /* Blocks which are open; the last one is the current block */
+  std::vector<ConfigBlockId> block_stack;
+  /* Depth of elements under an element which is not interested, e.g., <hierarchy> */
+  size_t ignore_depth = 0;
+  bool top_block_found = false;
+  const std::string top_parent_name;
+
+  /* Nets and bits of the current block, which are reused between blocks */
+  std::vector<std::string> block_nets;
+  std::vector<bool> block_bits;
+
+  while (true == reader.next_tag(tag)) {
+    if (XmlArchBitstreamTag::END != tag.type) {
+      const std::string& parent_name = element_stack.empty() ? top_parent_name : element_stack.back();
+      bool ignored = (0 < ignore_depth);
+
+      if (true == ignored) {
+        /* Skip the whole sub tree */
+      } else if (std::string("bitstream_block") == tag.name) {
+        const std::string& block_name = get_arch_bitstream_tag_attribute(reader, tag, "name");
+        if (true == parent_name.empty()) {
+          /* This is the top-level block */
+          if (true == top_block_found) {
+            reader.error("Only one top-level <bitstream_block> is allowed!");
+          }
+          if (block_name != std::string(FPGA_TOP_MODULE_NAME)) {
+            reader.error(std::string("Top-level block must be named as '") + std::string(FPGA_TOP_MODULE_NAME) + std::string("'!"));
+          }
+          /* Reserve bitstream blocks and bits in the data base when hints are given */
+          size_t num_blocks_hint = get_arch_bitstream_tag_size_hint(reader, tag, "num_blocks");
+          size_t num_bits_hint = get_arch_bitstream_tag_size_hint(reader, tag, "num_bits");
+          if (0 < num_blocks_hint) {
+            bitstream_manager.reserve_blocks(num_blocks_hint);
+          }
+          if (0 < num_bits_hint) {
+            bitstream_manager.reserve_bits(num_bits_hint);
+          }
+          block_stack.push_back(bitstream_manager.add_block(block_name));
+          top_block_found = true;
+        } else if (std::string("bitstream_block") == parent_name) {
+          /* Create the bitstream block and add it to parent block */
+          ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
+          bitstream_manager.add_child_block(block_stack.back(), curr_block);
+          block_stack.push_back(curr_block);
+        } else {
+          reader.error(std::string("Unexpected <bitstream_block> under <") + parent_name + std::string(">!"));
+        }
+      } else if (true == parent_name.empty()) {
+        reader.error(std::string("Expect <bitstream_block> as the root but get <") + tag.name + std::string(">!"));
+      } else if (1 == block_stack.size()) {
+        /* Only child blocks are allowed under the top-level block */
+        reader.error(std::string("Unexpected <") + tag.name + std::string("> under the top-level block, expect <bitstream_block>!"));
+      } else if ((std::string("input_nets") == tag.name)
+              || (std::string("output_nets") == tag.name)) {
+        if (std::string("bitstream_block") != parent_name) {
+          reader.error(std::string("Unexpected <") + tag.name + std::string("> under <") + parent_name + std::string(">!"));
+        }
+        block_nets.clear();
+      } else if (std::string("path") == tag.name) {
+        if ((std::string("input_nets") != parent_name)
+         && (std::string("output_nets") != parent_name)) {
+          reader.error(std::string("Unexpected <path> under <") + parent_name + std::string(">!"));
+        }
+        int path_id = get_arch_bitstream_tag_int_attribute(reader, tag, "id", -1);
+        if (0 > path_id) {
+          reader.error("Expect a non-negative attribute 'id' for <path>!");
+        }
+        if (size_t(path_id) >= block_nets.size()) {
+          block_nets.resize(path_id + 1);
+        }
+        block_nets[path_id] = get_arch_bitstream_tag_attribute(reader, tag, "net_name");
+      } else if (std::string("bitstream") == tag.name) {
+        if (std::string("bitstream_block") != parent_name) {
+          reader.error(std::string("Unexpected <bitstream> under <") + parent_name + std::string(">!"));
+        }
+        /* Parse path_id: -2 is an invalid value defined in the bitstream manager internally */
+        int path_id = get_arch_bitstream_tag_int_attribute(reader, tag, "path_id", -2);
+        if (-2 < path_id) {
+          bitstream_manager.add_path_id_to_block(block_stack.back(), path_id);
+        }
+        block_bits.clear();
+      } else if (std::string("bit") == tag.name) {
+        if (std::string("bitstream") != parent_name) {
+          reader.error(std::string("Unexpected <bit> under <") + parent_name + std::string(">!"));
+        }
+        const std::string& bit_value = get_arch_bitstream_tag_attribute(reader, tag, "value");
+        block_bits.push_back(std::string("1") == bit_value);
+      } else if ((std::string("input_nets") == parent_name)
+              || (std::string("output_nets") == parent_name)
+              || (std::string("bitstream") == parent_name)) {
+        reader.error(std::string("Unexpected <") + tag.name + std::string("> under <") + parent_name + std::string(">!"));
+      } else {
+        /* Other nodes, e.g., <hierarchy>, are only for readability */
+        ignored = true;
+      }
 
-    /* Find the name of the top block*/
-    const std::string& top_block_name = get_attribute(xml_root, "name", loc_data).as_string();
-    
-    if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
-                     "Top-level block must be named as '%s'!\n",
-                     FPGA_TOP_MODULE_NAME);
+      if (XmlArchBitstreamTag::START == tag.type) {
+        element_stack.push_back(tag.name);
+        if (true == ignored) {
+          ignore_depth++;
+        }
+        continue;
+      }
+      /* An empty element is closed immediately */
+      if (true == ignored) {
+        continue;
+      }
+    } else {
+      if ((true == element_stack.empty()) || (element_stack.back() != tag.name)) {
+        reader.error(std::string("Unexpected closing tag </") + tag.name + std::string(">!"));
+      }
+      element_stack.pop_back();
+      if (0 < ignore_depth) {
+        ignore_depth--;
+        continue;
+      }
     }
 
-    /* Create the top-level block */
-    ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
-
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data, pugiutil::ReqOpt::OPTIONAL);
-
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
+    /* Close the element */
+    if (std::string("bitstream_block") == tag.name) {
+      block_stack.pop_back();
+    } else if (std::string("input_nets") == tag.name) {
+      bitstream_manager.add_input_nets_to_block(block_stack.back(), block_nets);
+    } else if (std::string("output_nets") == tag.name) {
+      bitstream_manager.add_output_nets_to_block(block_stack.back(), block_nets);
+    } else if (std::string("bitstream") == tag.name) {
+      /* Link the bits to the current block */
+      bitstream_manager.add_block_bits(block_stack.back(), block_bits);
+    }
+  }
 
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
-      /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
-      }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager, top_block);
-    } 
-  } catch (pugiutil::XmlError& e) {
-    archfpga_throw(fname, e.line(),
-                   "%s", e.what());
+  if (false == top_block_found) {
+    reader.error("Expect a top-level <bitstream_block>!");
+  }
+  if (false == element_stack.empty()) {
+    reader.error(std::string("Unexpected end of file, <") + element_stack.back() + std::string("> is not closed!"));
   }
 
-  return bitstream_manager; 
+  return bitstream_manager;
 }
 
 } /* end namespace openfpga */
-
@@ -0,0 +1,82 @@
+/********************************************************************
+ * This file includes the functions to read an XML file 
+ * which describes an Engineering Change Order (ECO) of bitstream, e.g.,
+ *
+ *   <bitstream_eco>
+ *     <grid x="1" y="2"/>
+ *     <gsb x="0" y="1"/>
+ *   </bitstream_eco>
+ *******************************************************************/
+#include <string>
+
+/* Headers from pugi XML library */
+#include "pugixml.hpp"
+#include "pugixml_util.hpp"
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+#include "read_xml_util.h"
+
+#include "read_xml_bitstream_eco.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Parse XML codes of a <grid> or a <gsb> to a coordinate
+ *******************************************************************/
+static 
+vtr::Point<size_t> read_xml_bitstream_eco_coordinate(pugi::xml_node& xml_coord,
+                                                     const pugiutil::loc_data& loc_data) {
+  int x = get_attribute(xml_coord, "x", loc_data).as_int();
+  int y = get_attribute(xml_coord, "y", loc_data).as_int();
+  if ( (0 > x) || (0 > y) ) {
+    archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_coord),
+                   "Invalid coordinate (%d, %d) which should not be negative!\n",
+                   x, y);
+  }
+
+  return vtr::Point<size_t>(x, y);
+}
+
+/********************************************************************
+ * Parse XML codes about <bitstream_eco> to an object of BitstreamEco
+ *******************************************************************/
+BitstreamEco read_xml_bitstream_eco(const char* fname) {
+
+  vtr::ScopedStartFinishTimer timer("Read Bitstream ECO");
+
+  BitstreamEco bitstream_eco;
+
+  /* Parse the file */
+  pugi::xml_document doc;
+  pugiutil::loc_data loc_data;
+
+  try {
+    loc_data = pugiutil::load_xml(doc, fname);
+
+    pugi::xml_node xml_root = get_single_child(doc, "bitstream_eco", loc_data);
+
+    for (pugi::xml_node xml_coord : xml_root.children()) {
+      /* Error out if the XML child has an invalid name! */
+      if (xml_coord.name() == std::string("grid")) {
+        bitstream_eco.grids.push_back(read_xml_bitstream_eco_coordinate(xml_coord, loc_data));
+      } else if (xml_coord.name() == std::string("gsb")) {
+        bitstream_eco.gsbs.push_back(read_xml_bitstream_eco_coordinate(xml_coord, loc_data));
+      } else {
+        bad_tag(xml_coord, loc_data, xml_root, {"grid", "gsb"});
+      }
+    }
+  } catch (pugiutil::XmlError& e) {
+    archfpga_throw(fname, e.line(),
+                   "%s", e.what());
+  }
+
+  return bitstream_eco;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,31 @@
+#ifndef READ_XML_BITSTREAM_ECO_H
+#define READ_XML_BITSTREAM_ECO_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <vector>
+#include "vtr_geometry.h"
+
+/********************************************************************
+ * Data structure to store an Engineering Change Order (ECO) of bitstream,
+ * i.e., the grids and GSBs whose bitstreams should be regenerated
+ *******************************************************************/
+/* begin namespace openfpga */
+namespace openfpga {
+
+struct BitstreamEco {
+  /* Coordinates of grids in the device grid */
+  std::vector<vtr::Point<size_t>> grids;
+  /* Coordinates of General Switch Blocks (GSBs) */
+  std::vector<vtr::Point<size_t>> gsbs;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+BitstreamEco read_xml_bitstream_eco(const char* fname);
+
+} /* end namespace openfpga */
+
+#endif
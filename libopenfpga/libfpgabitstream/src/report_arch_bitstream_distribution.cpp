@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
 #include "openfpga_tokenizer.h"
 #include "openfpga_version.h"
 
@@ -29,14 +30,11 @@ namespace openfpga {
 static 
 void report_architecture_bitstream_distribution_xml_file_head(std::fstream& fp) {
   valid_file_stream(fp);
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
   fp << "<!-- " << std::endl;
   fp << "\t- Report Architecture Bitstream Distribution" << std::endl;
   fp << "\t- Version: " << openfpga::VERSION << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << generate_file_time_stamp() ;
   fp << "--> " << std::endl;
   fp << std::endl;
 }
@@ -53,6 +51,7 @@ static
 void rec_report_block_bitstream_distribution_to_xml_file(std::fstream& fp,
                                                          const BitstreamManager& bitstream_manager, 
                                                          const ConfigBlockId& block,
+                                                         const vtr::vector<ConfigBlockId, size_t>& block_sum_of_bits,
                                                          const size_t& max_hierarchy_level,
                                                          const size_t& hierarchy_level) {
   valid_file_stream(fp);
@@ -65,12 +64,13 @@ void rec_report_block_bitstream_distribution_to_xml_file(std::fstream& fp,
   write_tab_to_file(fp, hierarchy_level);
   fp << "<block";
   fp << " name=\"" << bitstream_manager.block_name(block)<< "\"";
-  fp << " number_of_bits=\"" << rec_find_bitstream_manager_block_sum_of_bits(bitstream_manager, block) << "\"";
+  fp << " number_of_bits=\"" << block_sum_of_bits[block] << "\"";
   fp << ">" << std::endl;
 
   /* Dive to child blocks if this block has any */
   for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
     rec_report_block_bitstream_distribution_to_xml_file(fp, bitstream_manager, child_block,
+                                                        block_sum_of_bits,
                                                         max_hierarchy_level, hierarchy_level + 1);
   }
 
@@ -85,10 +85,13 @@ void rec_report_block_bitstream_distribution_to_xml_file(std::fstream& fp,
  *
  * Notes: 
  *   - The output format is a table whose format is compatible with RST files
+ *   - The number of bits of all the blocks are counted in one pass
+ *     before reporting, which can be run on multiple threads
  *******************************************************************/
 int report_architecture_bitstream_distribution(const BitstreamManager& bitstream_manager,
                                                const std::string& fname,
-                                               const size_t& max_hierarchy_level) {
+                                               const size_t& max_hierarchy_level,
+                                               const size_t& num_threads) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR("Received empty file name to report bitstream!\n\tPlease specify a valid file name.\n");
@@ -112,8 +115,11 @@ int report_architecture_bitstream_distribution(const BitstreamManager& bitstream
   /* Make sure we have only 1 top block */
   VTR_ASSERT(1 == top_block.size());
 
+  /* Count the number of bits under each block */
+  vtr::vector<ConfigBlockId, size_t> block_sum_of_bits = find_bitstream_manager_block_sum_of_bits(bitstream_manager, num_threads);
+
   /* Write bitstream, block by block, in a recursive way */
-  rec_report_block_bitstream_distribution_to_xml_file(fp, bitstream_manager, top_block[0], max_hierarchy_level, 0);
+  rec_report_block_bitstream_distribution_to_xml_file(fp, bitstream_manager, top_block[0], block_sum_of_bits, max_hierarchy_level, 0);
 
   /* Close file handler */
   fp.close();
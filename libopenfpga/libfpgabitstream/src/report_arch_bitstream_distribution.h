@@ -16,7 +16,8 @@ namespace openfpga {
 
 int report_architecture_bitstream_distribution(const BitstreamManager& bitstream_manager,
                                                const std::string& fname,
-                                               const size_t& max_hierarchy_level = 1);
+                                               const size_t& max_hierarchy_level = 1,
+                                               const size_t& num_threads = 1);
 
 } /* end namespace openfpga */
 
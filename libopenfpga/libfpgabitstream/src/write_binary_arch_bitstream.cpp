@@ -0,0 +1,216 @@
+/********************************************************************
+ * This file includes functions that output bitstream database
+ * to files in binary format, which can be reloaded much faster 
+ * than the XML format
+ *
+ * The binary file is organized in 64-bit words, so that it can be
+ * mapped into memory (e.g., mmap) and accessed without any parsing:
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   word 0 : magic number "OFPGAARC"                   |
+ *   |   word 1 : endian marker 0x0102030405060708          |
+ *   |   word 2 : format version                            |
+ *   |   word 3 : number of blocks                          |
+ *   |   word 4 : number of configuration bits              |
+ *   |   word 5 : number of strings                         |
+ *   |   word 6 : number of child block ids                 |
+ *   |   word 7 : number of characters of all the strings   |
+ *   +------------------------------------------------------+
+ *   | Block table (9 words per block)                      |
+ *   |   string id of the name                              |
+ *   |   parent block id                                    |
+ *   |   id of the first bit                                |
+ *   |   number of bits                                     |
+ *   |   path id (as a signed integer)                      |
+ *   |   string id of the input net ids                     |
+ *   |   string id of the output net ids                    |
+ *   |   offset of the first child in the child table       |
+ *   |   number of children                                 |
+ *   +------------------------------------------------------+
+ *   | Child table: child block ids, block by block         |
+ *   +------------------------------------------------------+
+ *   | String table (2 words per string)                    |
+ *   |   offset of the first character                      |
+ *   |   number of characters                               |
+ *   +------------------------------------------------------+
+ *   | Characters of all the strings, 8 per word            |
+ *   +------------------------------------------------------+
+ *   | Bit values, packed by 64 bits per word               |
+ *   +------------------------------------------------------+
+ *
+ * Invalid ids are represented by words whose all bits are set.
+ * Names and net ids are interned: identical strings, e.g., 
+ * the names of memory blocks, are stored only once
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "write_binary_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A table which assigns a unique id to each string
+ *******************************************************************/
+class BinaryArchBitstreamStringTable {
+  public: /* Public mutators */
+    uint64_t intern(const std::string& str) {
+      auto result = string_ids_.insert(std::make_pair(str, strings_.size()));
+      if (true == result.second) {
+        strings_.push_back(&(result.first->first));
+        num_chars_ += str.size();
+      }
+      return result.first->second;
+    }
+
+  public: /* Public accessors */
+    size_t num_strings() const { return strings_.size(); }
+    size_t num_chars() const { return num_chars_; }
+
+    /* Build the string table and the characters in words */
+    std::vector<uint64_t> to_words() const {
+      std::vector<uint64_t> words(2 * strings_.size() + (num_chars_ + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+      char* chars = reinterpret_cast<char*>(words.data() + 2 * strings_.size());
+      size_t offset = 0;
+      for (size_t istr = 0; istr < strings_.size(); ++istr) {
+        words[2 * istr] = offset;
+        words[2 * istr + 1] = strings_[istr]->size();
+        std::memcpy(chars + offset, strings_[istr]->data(), strings_[istr]->size());
+        offset += strings_[istr]->size();
+      }
+      return words;
+    }
+
+  private: /* Internal data */
+    std::unordered_map<std::string, uint64_t> string_ids_;
+    /* Strings in the order of their ids, pointing to the keys of the map */
+    std::vector<const std::string*> strings_;
+    size_t num_chars_ = 0;
+};
+
+/********************************************************************
+ * Write a number of words to a binary file stream in one call
+ *******************************************************************/
+static
+void write_binary_arch_bitstream_words(std::fstream& fp,
+                                       const std::vector<uint64_t>& words) {
+  fp.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+}
+
+/********************************************************************
+ * Convert an id to a word, where invalid ids are represented
+ * by a word whose all bits are set
+ *******************************************************************/
+template<class ID>
+static
+uint64_t binary_arch_bitstream_id_word(const ID& id) {
+  if (ID::INVALID() == id) {
+    return BINARY_ARCH_BITSTREAM_INVALID_WORD;
+  }
+  return size_t(id);
+}
+
+/********************************************************************
+ * Write the bitstream database to a binary file
+ * The file can be read back by read_binary_architecture_bitstream()
+ * Notes:
+ *   - Words are written in the byte order of the host machine,
+ *     which can be detected by the endian marker in the header
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_binary_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                        const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(bitstream_manager.num_bits()) + std::string(" architecture independent bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Build the block table and the child table */
+  BinaryArchBitstreamStringTable string_table;
+  std::vector<uint64_t> block_table;
+  block_table.reserve(BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * bitstream_manager.num_blocks());
+  std::vector<uint64_t> child_table;
+  child_table.reserve(bitstream_manager.num_blocks());
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    /* Block ids are stored implicitly by their position in the table */
+    VTR_ASSERT(block_table.size() == BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * size_t(block));
+    std::vector<ConfigBlockId> children = bitstream_manager.block_children(block);
+
+    block_table.push_back(string_table.intern(bitstream_manager.block_name(block)));
+    block_table.push_back(binary_arch_bitstream_id_word(bitstream_manager.block_parent(block)));
+    block_table.push_back(binary_arch_bitstream_id_word(bitstream_manager.block_first_bit(block)));
+    block_table.push_back(bitstream_manager.block_num_bits(block));
+    block_table.push_back(static_cast<uint64_t>(static_cast<int64_t>(bitstream_manager.block_path_id(block))));
+    block_table.push_back(string_table.intern(bitstream_manager.block_input_net_ids(block)));
+    block_table.push_back(string_table.intern(bitstream_manager.block_output_net_ids(block)));
+    block_table.push_back(child_table.size());
+    block_table.push_back(children.size());
+
+    for (const ConfigBlockId& child : children) {
+      child_table.push_back(size_t(child));
+    }
+  }
+
+  /* Build the header */
+  std::vector<uint64_t> header(BINARY_ARCH_BITSTREAM_NUM_HEADER_WORDS, 0);
+  std::memcpy(&header[0], BINARY_ARCH_BITSTREAM_MAGIC, sizeof(uint64_t));
+  header[1] = BINARY_ARCH_BITSTREAM_ENDIAN_MARKER;
+  header[2] = BINARY_ARCH_BITSTREAM_VERSION;
+  header[3] = bitstream_manager.num_blocks();
+  header[4] = bitstream_manager.num_bits();
+  header[5] = string_table.num_strings();
+  header[6] = child_table.size();
+  header[7] = string_table.num_chars();
+
+  /* Bit values are already packed in the bitstream manager */
+  std::vector<uint64_t> bit_words(bitstream_manager.num_bit_value_words());
+  for (size_t iword = 0; iword < bit_words.size(); ++iword) {
+    bit_words[iword] = bitstream_manager.bit_value_word(iword);
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Output to the file, each part is written in one call */
+  write_binary_arch_bitstream_words(fp, header);
+  write_binary_arch_bitstream_words(fp, block_table);
+  write_binary_arch_bitstream_words(fp, child_table);
+  write_binary_arch_bitstream_words(fp, string_table.to_words());
+  write_binary_arch_bitstream_words(fp, bit_words);
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write bitstream to binary file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,37 @@
+#ifndef WRITE_BINARY_ARCH_BITSTREAM_H
+#define WRITE_BINARY_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Constants for the binary architecture bitstream file format
+ *******************************************************************/
+constexpr char BINARY_ARCH_BITSTREAM_MAGIC[] = "OFPGAARC";
+constexpr uint64_t BINARY_ARCH_BITSTREAM_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t BINARY_ARCH_BITSTREAM_VERSION = 1;
+
+/* Number of 64-bit words in the header */
+constexpr size_t BINARY_ARCH_BITSTREAM_NUM_HEADER_WORDS = 8;
+/* Number of 64-bit words to describe a block */
+constexpr size_t BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS = 9;
+/* Value of a word representing an invalid id */
+constexpr uint64_t BINARY_ARCH_BITSTREAM_INVALID_WORD = uint64_t(-1);
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_binary_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                        const std::string& fname);
+
+} /* end namespace openfpga */
+
+#endif
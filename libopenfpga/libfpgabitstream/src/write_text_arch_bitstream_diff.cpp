@@ -0,0 +1,126 @@
+/********************************************************************
+ * This file includes functions that output the differences between
+ * two bitstream databases to a plain text file
+ *
+ * Each line describes a range of consecutive bits in a block
+ * whose values are changed:
+ *   <block hierarchy> <index of the first bit in the block> <new values>
+ * where the block hierarchy is the names of blocks from the top-level
+ * block joined by '.', and the new values are the values of 
+ * the reference bitstream, e.g.,
+ *   fpga_top.sb_0__2_.mem_right_track_0 0 10
+ * Blocks which cannot be matched are listed as
+ *   // Unmatched block: <block hierarchy>
+ *******************************************************************/
+#include <chrono>
+#include <ctime>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
+#include "openfpga_version.h"
+
+#include "bitstream_manager_utils.h"
+#include "write_text_arch_bitstream_diff.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the full name of a block in the hierarchy
+ *******************************************************************/
+static
+std::string find_bitstream_manager_block_hierarchy_name(const BitstreamManager& bitstream_manager,
+                                                        const ConfigBlockId& block) {
+  std::string hierarchy_name;
+  for (const ConfigBlockId& temp_block : find_bitstream_manager_block_hierarchy(bitstream_manager, block)) {
+    if (false == hierarchy_name.empty()) {
+      hierarchy_name += std::string(".");
+    }
+    hierarchy_name += bitstream_manager.block_name(temp_block);
+  }
+  return hierarchy_name;
+}
+
+/********************************************************************
+ * Write the differences between two bitstream databases to a text file
+ * The bits of the diff should be sorted by their ids, so that
+ * consecutive bits of a block are merged into a single line
+ * Note that the diff should not be applied to the bitstream database yet,
+ * as the new values are found by toggling the current ones
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_architecture_bitstream_diff_to_text_file(const BitstreamManager& bitstream_manager,
+                                                   const ArchBitstreamDiff& bitstream_diff,
+                                                   const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream difference!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(bitstream_diff.bits.size()) + std::string(" different bits of architecture bitstream into text file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "// Architecture bitstream difference" << std::endl;
+  fp << "// Version: " << openfpga::VERSION << std::endl;
+  fp << "// Date: " << generate_file_time_stamp();
+  fp << "// Number of different bits: " << bitstream_diff.bits.size() << std::endl;
+
+  for (const ConfigBlockId& block : bitstream_diff.unmatched_blocks) {
+    fp << "// Unmatched block: " << find_bitstream_manager_block_hierarchy_name(bitstream_manager, block) << std::endl;
+  }
+
+  /* Merge consecutive bits of the same block into a range */
+  size_t ibit = 0;
+  while (ibit < bitstream_diff.bits.size()) {
+    const ConfigBitId& first_bit = bitstream_diff.bits[ibit];
+    ConfigBlockId block = bitstream_manager.bit_parent_block(first_bit);
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(block));
+
+    std::string new_values;
+    size_t jbit = ibit;
+    while ( (jbit < bitstream_diff.bits.size())
+         && (size_t(bitstream_diff.bits[jbit]) == size_t(first_bit) + jbit - ibit)
+         && (block == bitstream_manager.bit_parent_block(bitstream_diff.bits[jbit])) ) {
+      /* The values in the reference are the opposite of the current ones */
+      new_values.push_back(bitstream_manager.bit_value(bitstream_diff.bits[jbit]) ? '0' : '1');
+      jbit++;
+    }
+
+    fp << find_bitstream_manager_block_hierarchy_name(bitstream_manager, block);
+    fp << " " << size_t(first_bit) - size_t(bitstream_manager.block_first_bit(block));
+    fp << " " << new_values << std::endl;
+
+    ibit = jbit;
+  }
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write bitstream difference to text file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,24 @@
+#ifndef WRITE_TEXT_ARCH_BITSTREAM_DIFF_H
+#define WRITE_TEXT_ARCH_BITSTREAM_DIFF_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+#include "diff_arch_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_architecture_bitstream_diff_to_text_file(const BitstreamManager& bitstream_manager,
+                                                   const ArchBitstreamDiff& bitstream_diff,
+                                                   const std::string& fname);
+
+} /* end namespace openfpga */
+
+#endif
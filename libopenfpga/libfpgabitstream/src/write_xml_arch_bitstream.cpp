@@ -13,7 +13,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
-#include "openfpga_tokenizer.h"
+#include "openfpga_time_stamp.h"
 
 #include "openfpga_reserved_words.h"
 
@@ -29,15 +29,12 @@ namespace openfpga {
 static 
 void write_bitstream_xml_file_head(std::fstream& fp) {
   valid_file_stream(fp);
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
   fp << "<!--" << std::endl;
   fp << "\t- Architecture independent bitstream" << std::endl;
   fp << "\t- Author: Xifan TANG" << std::endl;
   fp << "\t- Organization: University of Utah" << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << generate_file_time_stamp() ;
   fp << "-->" << std::endl;
   fp << std::endl;
 }
@@ -62,6 +59,13 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   fp << "<bitstream_block";
   fp << " name=\"" << bitstream_manager.block_name(block)<< "\"";
   fp << " hierarchy_level=\"" << hierarchy_level << "\"";
+  /* Give the size of the database at the top-level block,
+   * so that readers can reserve memory before parsing
+   */
+  if (0 == hierarchy_level) {
+    fp << " num_blocks=\"" << bitstream_manager.num_blocks() << "\"";
+    fp << " num_bits=\"" << bitstream_manager.num_bits() << "\"";
+  }
   fp << ">" << std::endl;
 
   /* Dive to child blocks if this block has any */
@@ -69,7 +73,7 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
     rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block, hierarchy_level + 1);
   }
   
-  if (0 == bitstream_manager.block_bits(block).size()) {
+  if (0 == bitstream_manager.block_num_bits(block)) {
     write_tab_to_file(fp, hierarchy_level);
     fp << "</bitstream_block>" <<std::endl;
     return;
@@ -92,13 +96,12 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   fp << "</hierarchy>" << std::endl;
 
   /* Output input/output nets if there are any */
-  if (false == bitstream_manager.block_input_net_ids(block).empty()) {
+  std::vector<std::string> input_nets = bitstream_manager.block_input_nets(block);
+  if (false == input_nets.empty()) {
     write_tab_to_file(fp, hierarchy_level + 1);
     fp << "<input_nets>\n";
     size_t path_counter = 0;
-    /* Split with space */
-    StringToken input_net_tokenizer(bitstream_manager.block_input_net_ids(block));
-    for (const std::string& net : input_net_tokenizer.split(std::string(" "))) {
+    for (const std::string& net : input_nets) {
       write_tab_to_file(fp, hierarchy_level + 2);
       fp << "<path id=\"" << path_counter << "\"";
       fp << " net_name=\"";
@@ -112,13 +115,12 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
     fp << "</input_nets>\n";
   }
 
-  if (false == bitstream_manager.block_output_net_ids(block).empty()) {
+  std::vector<std::string> output_nets = bitstream_manager.block_output_nets(block);
+  if (false == output_nets.empty()) {
     write_tab_to_file(fp, hierarchy_level + 1);
     fp << "<output_nets>\n";
     size_t path_counter = 0;
-    /* Split with space */
-    StringToken output_net_tokenizer(bitstream_manager.block_output_net_ids(block));
-    for (const std::string& net : output_net_tokenizer.split(std::string(" "))) {
+    for (const std::string& net : output_nets) {
       write_tab_to_file(fp, hierarchy_level + 2);
       fp << "<path id=\"" << path_counter << "\"";
       fp << " net_name=\"";
@@ -142,11 +144,11 @@ void rec_write_block_bitstream_to_xml_file(std::fstream& fp,
   }
   fp << ">" << std::endl;
 
-  for (const ConfigBitId& child_bit : bitstream_manager.block_bits(block)) {
+  for (const bool& child_bit_value : bitstream_manager.block_bit_values(block)) {
     write_tab_to_file(fp, hierarchy_level + 2);
     fp << "<bit";
     fp << " memory_port=\"" << CONFIGURABLE_MEMORY_DATA_OUT_NAME << "[" << bit_counter << "]" << "\"";
-    fp << " value=\"" << bitstream_manager.bit_value(child_bit) << "\"";
+    fp << " value=\"" << child_bit_value << "\"";
     fp << "/>" << std::endl;
     bit_counter++;
   }
@@ -6,6 +6,7 @@
 #include <vector>
 #include <functional>
 #include <ctime>
+#include <chrono>
 
 #include "vtr_vector.h"
 #include "vtr_range.h"
@@ -13,6 +14,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "shell_fwd.h"
+#include "shell_script.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -85,8 +87,13 @@ class Shell {
     const CommandContext& command_context(const ShellCommandId& cmd_id) const;
     std::vector<ShellCommandId> command_dependency(const ShellCommandId& cmd_id) const;
     std::vector<ShellCommandId> commands_by_class(const ShellCommandClassId& cmd_class_id) const;
+    bool fast_exit() const;
   public: /* Public mutators */
     void add_title(const char* title);
+    /* Exit the process without destroying any data, e.g., the contexts of the commands,
+     * see exit_process()
+     */
+    void set_fast_exit(const bool& fast_exit);
     ShellCommandId add_command(const Command& cmd, const char* descr);
     void set_command_class(const ShellCommandId& cmd_id, const ShellCommandClassId& cmd_class_id);
     /* Link the execute function to a command
@@ -135,6 +142,18 @@ class Shell {
 
     void set_command_dependency(const ShellCommandId& cmd_id,
                                 const std::vector<ShellCommandId>& cmd_dependency);
+    /* Commands whose results are restored by a command, e.g., loading a checkpoint.
+     * Once the command succeeds, the provided commands are considered as executed,
+     * so that the commands depending on them are allowed to run
+     */
+    void set_command_provision(const ShellCommandId& cmd_id,
+                               const std::vector<ShellCommandId>& provided_cmds);
+    /* Commands whose results are dropped by a command, e.g., freeing a database.
+     * Once the command succeeds, the invalidated commands and all the commands
+     * depending on them are considered as never executed
+     */
+    void set_command_invalidation(const ShellCommandId& cmd_id,
+                                  const std::vector<ShellCommandId>& invalidated_cmds);
     ShellCommandClassId add_command_class(const char* name);
   public: /* Public validators */
     bool valid_command_id(const ShellCommandId& cmd_id) const;
@@ -146,6 +165,12 @@ class Shell {
     void run_script_mode(const char* script_file_name,
                          T& context,
                          const bool& batch_mode = false);
+    /* Start the server mode, where users provide the script files to run through the standard input
+     * Each script is executed in a child process cloned from the shell,
+     * so that the data loaded before (e.g., by a setup script) is shared by all the scripts
+     * Return the number of scripts which fail
+     */
+    size_t run_server_mode(T& context, const size_t& num_jobs = 1);
     /* Print all the commands by their classes. This is actually the help desk */
     void print_commands() const;
     /* Find the exit code (assume quit shell now) */
@@ -154,11 +179,40 @@ class Shell {
     int execution_errors() const;
     /* Quit the shell */
     void exit(const int& init_err = 0) const;
+    /* Terminate the process with an exit code
+     * With fast exit, the outputs are flushed and the process ends without running
+     * any destructor, which takes long for the large data of a design.
+     * Otherwise, the static data is destroyed as std::exit() does
+     */
+    void exit_process(const int& exit_code) const;
+    /* Show the wall time, CPU time and peak memory of each command executed */
+    void print_runtime_profile() const;
+    /* Output the runtime profile of each command executed to a JSON file */
+    int write_runtime_profile(const std::string& fname) const;
   private: /* Private executors */
     /* Execute a command, the command line is the user's input to launch a command
      * The common_context is the data structure to exchange data between commands
      */
     int execute_command(const char* cmd_line, T& common_context);
+    /* Execute a command from a command line which is already tokenized */
+    int execute_command(const std::vector<std::string>& tokens,
+                        const std::string& cmd_line,
+                        T& common_context);
+    /* Execute a block of commands which only read the common_context
+     * on multiple threads. The messages of each command are printed
+     * in the order of command lines, once all the commands finish
+     */
+    int execute_parallel_commands(const std::vector<const t_shell_script_line*>& cmd_lines, T& common_context);
+    /* Record the runtime profile of a command execution */
+    void add_command_profile(const ShellCommandId& cmd_id,
+                             const std::string& cmd_line,
+                             const bool& parallel,
+                             const int& status,
+                             const float& wall_time_sec,
+                             const float& cpu_time_sec,
+                             const float& delta_max_rss_mib);
+    /* Mark a command and the commands depending on it as never executed */
+    void invalidate_command(const ShellCommandId& cmd_id);
   private: /* Internal data */ 
     /* Name of the shell, this will appear in the interactive mode */
     std::string name_;
@@ -181,6 +235,11 @@ class Shell {
     /* Parsing results for each command */
     vtr::vector<ShellCommandId, CommandContext> command_contexts_;  
 
+    /* Tokens of the command line which are parsed into the command context,
+     * empty if the command context is not from a successful parsing
+     */
+    vtr::vector<ShellCommandId, std::vector<std::string>> command_parsed_tokens_;  
+
     /* Description of the command, this is going to be printed out in the help desk */
     vtr::vector<ShellCommandId, std::string> command_description_;  
 
@@ -214,13 +273,35 @@ class Shell {
      */
     vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_dependencies_;  
 
+    /* Commands whose results are provided by each command */
+    vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_provisions_;  
+
+    /* Commands whose results are dropped by each command */
+    vtr::vector<ShellCommandId, std::vector<ShellCommandId>> command_invalidations_;  
+
     /* Fast name look-up */
     std::map<std::string, ShellCommandId> command_name2ids_;
     std::map<std::string, ShellCommandClassId> command_class2ids_;
     vtr::vector<ShellCommandClassId, std::vector<ShellCommandId>> commands_by_classes_;  
 
+    /* Exit the process without destroying any data */
+    bool fast_exit_;
+
     /* Timer */
     std::clock_t time_start_;
+    std::chrono::steady_clock::time_point wall_time_start_;
+
+    /* Runtime profile of each command execution, in the order of execution
+     * A command may be executed several times, each has its own profile
+     * CPU time of commands executed in a parallel block is the CPU time of the whole block
+     */
+    std::vector<ShellCommandId> profile_commands_;
+    std::vector<std::string> profile_command_lines_;
+    std::vector<bool> profile_parallel_;
+    std::vector<int> profile_status_;
+    std::vector<float> profile_wall_times_;
+    std::vector<float> profile_cpu_times_;
+    std::vector<float> profile_delta_max_rss_;
 };
 
 } /* End namespace openfpga */
@@ -2,14 +2,24 @@
  * Member functions for class Shell
  ********************************************************************/
 #include <fstream>
+#include <iostream>
 #include <algorithm>
+#include <cstdio>
+
+/* Headers to clone processes in server mode */
+#include <unistd.h>
+#include <sys/wait.h>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_time.h"
+#include "vtr_rusage.h"
+#include "vtr_trace.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_tokenizer.h"
+#include "openfpga_parallel.h"
 
 /* Headers from readline library */
 #include <readline/readline.h>
@@ -18,6 +28,8 @@
 /* Headers from openfpgashell library */
 #include "command_parser.h"
 #include "command_echo.h"
+#include "shell_log_buffer.h"
+#include "shell_script.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -28,7 +40,9 @@ namespace openfpga {
 template<class T>
 Shell<T>::Shell(const char* name) {
   name_ = std::string(name);
+  fast_exit_ = false;
   time_start_ = 0;
+  wall_time_start_ = std::chrono::steady_clock::now();
 }
 
 /************************************************************************
@@ -77,6 +91,11 @@ std::string Shell<T>::command_class_name(const ShellCommandClassId& cmd_class_id
   return command_class_names_[cmd_class_id];
 }
 
+template<class T>
+bool Shell<T>::fast_exit() const {
+  return fast_exit_;
+}
+
 template<class T>
 const Command& Shell<T>::command(const ShellCommandId& cmd_id) const {
   VTR_ASSERT(true == valid_command_id(cmd_id));
@@ -123,6 +142,7 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr) {
   command_ids_.push_back(shell_cmd);
   commands_.emplace_back(cmd);
   command_contexts_.push_back(CommandContext(cmd));
+  command_parsed_tokens_.emplace_back();
   command_description_.push_back(descr);
   command_classes_.push_back(ShellCommandClassId::INVALID());
   command_execute_function_types_.emplace_back();
@@ -134,6 +154,8 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr) {
   command_macro_execute_functions_.emplace_back();
   command_status_.push_back(CMD_EXEC_NONE); /* By default, the command should be marked as fatal error as it has been never executed */
   command_dependencies_.emplace_back();
+  command_provisions_.emplace_back();
+  command_invalidations_.emplace_back();
 
   /* Register the name in the name2id map */
   command_name2ids_[cmd.name()] = shell_cmd;
@@ -141,6 +163,11 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr) {
   return shell_cmd;
 } 
 
+template<class T>
+void Shell<T>::set_fast_exit(const bool& fast_exit) {
+  fast_exit_ = fast_exit;
+}
+
 template<class T>
 void Shell<T>::set_command_class(const ShellCommandId& cmd_id, const ShellCommandClassId& cmd_class_id) {
   VTR_ASSERT(true == valid_command_id(cmd_id));
@@ -213,6 +240,28 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::set_command_provision(const ShellCommandId& cmd_id,
+                                     const std::vector<ShellCommandId>& provided_cmds) {
+  /* Validate the command id as well as each of the provided commands */
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  for (ShellCommandId provided_cmd : provided_cmds) {
+    VTR_ASSERT(true == valid_command_id(provided_cmd));
+  }
+  command_provisions_[cmd_id] = provided_cmds;
+}
+
+template<class T>
+void Shell<T>::set_command_invalidation(const ShellCommandId& cmd_id,
+                                        const std::vector<ShellCommandId>& invalidated_cmds) {
+  /* Validate the command id as well as each of the invalidated commands */
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  for (ShellCommandId invalidated_cmd : invalidated_cmds) {
+    VTR_ASSERT(true == valid_command_id(invalidated_cmd));
+  }
+  command_invalidations_[cmd_id] = invalidated_cmds;
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
@@ -244,6 +293,7 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
   if (false == quiet_mode) {
     /* Reset timer since it does not come from another mode */
     time_start_ = std::clock();
+    wall_time_start_ = std::chrono::steady_clock::now();
 
     VTR_LOG("Start interactive mode of %s...\n",
             name().c_str());
@@ -277,6 +327,7 @@ void Shell<T>::run_script_mode(const char* script_file_name,
                                const bool& batch_mode) {
 
   time_start_ = std::clock();
+  wall_time_start_ = std::chrono::steady_clock::now();
 
   VTR_LOG("Reading script file %s...\n", script_file_name);
 
@@ -285,101 +336,200 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     VTR_LOG("%s\n", title().c_str());
   } 
 
-  std::string line;
+  /* Read the whole script at once, the continued lines are conjuncted,
+   * and each command line is tokenized before any command is executed
+   */
+  std::vector<t_shell_script_line> script_lines;
+  if (0 != read_shell_script(script_file_name, script_lines)) {
+    VTR_LOGV(batch_mode, "OpenFPGA Abort\n");
+    if (batch_mode) {
+      exit(CMD_EXEC_FATAL_ERROR);
+    }
+    return; 
+  }
 
-  /* Create an input file stream */
-  std::ifstream fp(script_file_name);
+  /* Commands inside a 'parallel { ... }' block are cached
+   * and executed together when the block is closed
+   */
+  bool in_parallel_block = false;
+  std::vector<const t_shell_script_line*> parallel_cmd_lines;
+
+  for (const t_shell_script_line& script_line : script_lines) {
+    const std::string& cmd_line = script_line.cmd_line;
+    int status = CMD_EXEC_SUCCESS;
+    if ( (2 == script_line.tokens.size())
+      && (std::string("parallel") == script_line.tokens[0])
+      && (std::string("{") == script_line.tokens[1]) ) {
+      /* Open a parallel block */
+      if (true == in_parallel_block) {
+        VTR_LOG("Parallel blocks can not be nested!\n");
+        status = CMD_EXEC_FATAL_ERROR;
+      }
+      in_parallel_block = true;
+    } else if (std::string("}") == cmd_line) {
+      /* Close a parallel block and execute the commands inside */
+      if (false == in_parallel_block) {
+        VTR_LOG("Found '}' without a opening 'parallel {'!\n");
+        status = CMD_EXEC_FATAL_ERROR;
+      } else {
+        status = execute_parallel_commands(parallel_cmd_lines, context);
+      }
+      in_parallel_block = false;
+      parallel_cmd_lines.clear();
+    } else if (true == in_parallel_block) {
+      parallel_cmd_lines.push_back(&script_line);
+    } else {
+      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+      status = execute_command(script_line.tokens, cmd_line, context);
+    }
 
-  if (!fp.is_open()) {
-    /* Fail to open the file, ask user to check */
-    VTR_LOG("Fail to open the script file: %s! Please check its location\n",
+    /* Check the execution status of the command, 
+     * if fatal error happened, we should abort immediately 
+     */
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      VTR_LOG("Fatal error occurred at line %lu of script file %s!\n",
+              script_line.line_number, script_file_name);
+      /* If in the batch mode, we will exit with errors */ 
+      VTR_LOGV(batch_mode, "OpenFPGA Abort\n");
+      if (batch_mode) {
+        exit(CMD_EXEC_FATAL_ERROR);
+      }
+      /* If not in the batch mode, we will got to interactive mode */ 
+      VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+      break;
+    }
+  }
+
+  /* A parallel block which is never closed is not executed */
+  if (true == in_parallel_block) {
+    VTR_LOG("Parallel block is not closed by '}' at the end of script file %s!\n",
             script_file_name);
-    return; 
+    VTR_LOGV(batch_mode, "OpenFPGA Abort\n");
+    if (batch_mode) {
+      exit(CMD_EXEC_FATAL_ERROR);
+    }
   }
 
-  /* Consider that each line may not end due to the continued line charactor 
-   * Use cmd_line to conjunct multiple lines 
-   */
-  std::string cmd_line;
+  /* If not in batch mode, switch to interactive mode, stay tuned */
+  if (!batch_mode) {
+    run_interactive_mode(context, true); 
+  }
+}
 
-  /* Read line by line */
-  while (getline(fp, line)) {
-    /* Skip empty line */
-    if (true == line.empty()) {
-      continue;
+/************************************************************************
+ * Server mode reads requests from the standard input, line by line:
+ *   <script_file> [<log_file>]
+ * Each script is executed in batch mode by a child process forked
+ * from the shell, which inherits all the data of the shell and the
+ * context, while the data of the shell is never modified by the scripts.
+ * When a log file is given, the messages of the script are written
+ * to the log file, otherwise to the standard output of the server.
+ * At most num_jobs scripts are executed at the same time.
+ * The server stops at the end of the input or a line of 'exit'
+ * Return the number of scripts which fail, i.e., which exit with a non-zero code
+ * or cannot be executed
+ ***********************************************************************/
+template <class T>
+size_t Shell<T>::run_server_mode(T& context, const size_t& num_jobs) {
+  VTR_ASSERT(0 < num_jobs);
+
+  VTR_LOG("\nStart server mode of %s with %lu jobs...\n",
+          name().c_str(), num_jobs);
+  VTR_LOG("Expect requests '<script_file> [<log_file>]' from standard input\n");
+
+  /* Scripts being executed by each child process */
+  std::map<pid_t, std::string> running_scripts;
+  size_t num_scripts = 0;
+  size_t num_failed_scripts = 0;
+
+  /* Wait for any child process to finish */
+  auto wait_script = [&]() {
+    int child_status = 0;
+    pid_t pid = waitpid(-1, &child_status, 0);
+    if (0 >= pid) {
+      VTR_LOG_ERROR("Lost track of %lu scripts being executed!\n",
+                    running_scripts.size());
+      num_failed_scripts += running_scripts.size();
+      running_scripts.clear();
+      return;
+    }
+    int exit_code = CMD_EXEC_FATAL_ERROR;
+    if (WIFEXITED(child_status)) {
+      exit_code = WEXITSTATUS(child_status);
     }
+    if (0 != exit_code) {
+      num_failed_scripts++;
+    }
+    VTR_LOG("Server finished script '%s' with exit code %d\n",
+            running_scripts[pid].c_str(), exit_code);
+    running_scripts.erase(pid);
+  };
 
-    /* If the line that starts with '#', it is commented, we can skip */ 
-    if ('#' == line.front()) {
+  std::string line;
+  while (getline(std::cin, line)) {
+    StringToken tokenizer(line);
+    std::vector<std::string> tokens = tokenizer.split(" ");
+    /* Skip empty lines and comments */
+    if ((true == tokens.empty()) || ('#' == tokens[0].front())) {
       continue;
     }
-    /* Try to split the line with '#', the string before '#' is the read command we want */
-    std::string cmd_part = line;
-    std::size_t cmd_end_pos = line.find_first_of('#');
-    /* If the full line has '#', we need the part before it */
-    if (cmd_end_pos != std::string::npos) {
-      cmd_part = line.substr(0, cmd_end_pos);
+    if (std::string("exit") == tokens[0]) {
+      break;
     }
-
-    /* Remove the space at the end of the line
-     * So that we can check easily if there is a continued line in the end  
-     */
-    StringToken cmd_part_tokenizer(cmd_part);
-    cmd_part_tokenizer.rtrim(std::string(" "));
-    cmd_part = cmd_part_tokenizer.data();
-
-    /* If the line ends with '\', this is a continued line, parse the next until it ends */
-    if ('\\' == cmd_part.back()) {
-      /* Pop up the last charactor and conjunct to cmd_line */
-      cmd_part.pop_back();
- 
-      if (!cmd_part.empty()) {
-        cmd_line += cmd_part; 
-      }
-      /* Not finished yet. Parse the next line */
+    if (2 < tokens.size()) {
+      VTR_LOG_ERROR("Invalid request '%s' to server! Expect '<script_file> [<log_file>]'\n",
+                    line.c_str());
       continue;
-    } else {
-      /* End of this line, if cmd_line is empty, 
-       * there is no previous lines, cache the part we have
-       * and then execute the command 
-       */
-      cmd_line += cmd_part;
     }
 
-    /* Remove the space at the beginning of the line */
-    StringToken cmd_line_tokenizer(cmd_line);
-    cmd_line_tokenizer.ltrim(std::string(" "));
-    cmd_line = cmd_line_tokenizer.data();
+    while (num_jobs <= running_scripts.size()) {
+      wait_script();
+    }
 
-    /* Process the command only when the full command line in ended */
-    if (!cmd_line.empty()) {
-      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
-      int status = execute_command(cmd_line.c_str(), context);
-      /* Empty the line ready to start a new line */
-      cmd_line.clear();
+    /* Flush the messages, which are otherwise printed again by the child process */
+    fflush(stdout);
+    fflush(stderr);
 
-      /* Check the execution status of the command, 
-       * if fatal error happened, we should abort immediately 
-       */
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        VTR_LOG("Fatal error occurred!\n");
-        /* If in the batch mode, we will exit with errors */ 
-        VTR_LOGV(batch_mode, "OpenFPGA Abort\n");
-        if (batch_mode) {
-          exit(CMD_EXEC_FATAL_ERROR);
+    pid_t pid = fork();
+    if (0 > pid) {
+      VTR_LOG_ERROR("Fail to create a process to execute script '%s'!\n",
+                    tokens[0].c_str());
+      num_failed_scripts++;
+      continue;
+    }
+
+    if (0 == pid) {
+      /* Child process: redirect the messages and execute the script */
+      if (2 == tokens.size()) {
+        if (nullptr == freopen(tokens[1].c_str(), "w", stdout)) {
+          std::_Exit(CMD_EXEC_FATAL_ERROR);
         }
-        /* If not in the batch mode, we will got to interactive mode */ 
-        VTR_LOGV(!batch_mode, "Enter interactive mode\n");
-        break;
+        dup2(fileno(stdout), fileno(stderr));
       }
+      if (false == std::ifstream(tokens[0]).is_open()) {
+        VTR_LOG_ERROR("Fail to open the script file: %s! Please check its location\n",
+                      tokens[0].c_str());
+        fflush(stdout);
+        std::_Exit(CMD_EXEC_FATAL_ERROR);
+      }
+      run_script_mode(tokens[0].c_str(), context, true);
+      exit();
     }
+
+    running_scripts[pid] = tokens[0];
+    num_scripts++;
+    VTR_LOG("Server started script '%s' in process %d\n",
+            tokens[0].c_str(), pid);
   }
-  fp.close();
 
-  /* If not in batch mode, switch to interactive mode, stay tuned */
-  if (!batch_mode) {
-    run_interactive_mode(context, true); 
+  while (false == running_scripts.empty()) {
+    wait_script();
   }
+
+  VTR_LOG("Server executed %lu scripts, %lu failed\n",
+          num_scripts, num_failed_scripts);
+
+  return num_failed_scripts;
 }
 
 template <class T>
@@ -456,18 +606,145 @@ void Shell<T>::exit(const int& init_err) const {
   VTR_LOG("\nFinish execution with %d errors\n",
             num_err);
 
-  VTR_LOG("\nThe entire OpenFPGA flow took %g seconds\n",
+  VTR_LOG("\nThe entire OpenFPGA flow took %g seconds (CPU time %g seconds)\n",
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_time_start_).count(),
           (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
 
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
 
-  std::exit(shell_exit_code);
+  exit_process(shell_exit_code);
+}
+
+template <class T>
+void Shell<T>::exit_process(const int& exit_code) const {
+  if (true == fast_exit_) {
+    /* Neither the destructors nor the exit handlers are run,
+     * so all the outputs are flushed here 
+     */
+    vtr::write_trace();
+    std::cout.flush();
+    std::cerr.flush();
+    fflush(nullptr);
+    std::_Exit(exit_code);
+  }
+
+  std::exit(exit_code);
+}
+
+template <class T>
+void Shell<T>::print_runtime_profile() const {
+  VTR_LOG("Runtime profile of %lu command executions:\n",
+          profile_commands_.size());
+  VTR_LOG("\t%-40s %12s %12s %16s\n",
+          "Command", "Wall (sec)", "CPU (sec)", "Delta RSS (MiB)");
+  for (size_t iprof = 0; iprof < profile_commands_.size(); ++iprof) {
+    VTR_LOG("\t%-40s %12g %12g %16g%s\n",
+            commands_[profile_commands_[iprof]].name().c_str(),
+            profile_wall_times_[iprof],
+            profile_cpu_times_[iprof],
+            profile_delta_max_rss_[iprof],
+            profile_parallel_[iprof] ? " (parallel)" : "");
+  }
+  VTR_LOG("Total wall time %g seconds, CPU time %g seconds, peak memory %g MiB\n",
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_time_start_).count(),
+          (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC,
+          (double)vtr::get_max_rss() / (1024. * 1024.));
+}
+
+/************************************************************************
+ * Output the runtime profile to a JSON file
+ * Return 0 if succeed, 1 if any error occurred
+ ***********************************************************************/
+template <class T>
+int Shell<T>::write_runtime_profile(const std::string& fname) const {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to output runtime profile!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* Quote a string for JSON */
+  auto json_string = [](const std::string& str) {
+    std::string json_str("\"");
+    for (const char& ch : str) {
+      if (('"' == ch) || ('\\' == ch)) {
+        json_str += '\\';
+      }
+      json_str += ch;
+    }
+    json_str += "\"";
+    return json_str;
+  };
+
+  fp << "{\n";
+  fp << "  \"wall_time_sec\": " << std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_time_start_).count() << ",\n";
+  fp << "  \"cpu_time_sec\": " << (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC << ",\n";
+  fp << "  \"max_rss_mib\": " << (double)vtr::get_max_rss() / (1024. * 1024.) << ",\n";
+  fp << "  \"commands\": [";
+  for (size_t iprof = 0; iprof < profile_commands_.size(); ++iprof) {
+    fp << (0 == iprof ? "\n" : ",\n");
+    fp << "    {";
+    fp << "\"name\": " << json_string(commands_[profile_commands_[iprof]].name());
+    fp << ", \"command_line\": " << json_string(profile_command_lines_[iprof]);
+    fp << ", \"parallel\": " << (profile_parallel_[iprof] ? "true" : "false");
+    fp << ", \"status\": " << profile_status_[iprof];
+    fp << ", \"wall_time_sec\": " << profile_wall_times_[iprof];
+    fp << ", \"cpu_time_sec\": " << profile_cpu_times_[iprof];
+    fp << ", \"delta_max_rss_mib\": " << profile_delta_max_rss_[iprof];
+    fp << "}";
+  }
+  fp << "\n  ]\n";
+  fp << "}\n";
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write runtime profile to file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+  fp.close();
+
+  return status;
 }
 
 /************************************************************************
  * Private executors
  ***********************************************************************/
+template <class T>
+void Shell<T>::add_command_profile(const ShellCommandId& cmd_id,
+                                   const std::string& cmd_line,
+                                   const bool& parallel,
+                                   const int& status,
+                                   const float& wall_time_sec,
+                                   const float& cpu_time_sec,
+                                   const float& delta_max_rss_mib) {
+  profile_commands_.push_back(cmd_id);
+  profile_command_lines_.push_back(cmd_line);
+  profile_parallel_.push_back(parallel);
+  profile_status_.push_back(status);
+  profile_wall_times_.push_back(wall_time_sec);
+  profile_cpu_times_.push_back(cpu_time_sec);
+  profile_delta_max_rss_.push_back(delta_max_rss_mib);
+}
+
+template <class T>
+void Shell<T>::invalidate_command(const ShellCommandId& cmd_id) {
+  if (CMD_EXEC_NONE == command_status_[cmd_id]) {
+    return;
+  }
+  command_status_[cmd_id] = CMD_EXEC_NONE;
+  for (const ShellCommandId& cand_cmd : commands()) {
+    if (command_dependencies_[cand_cmd].end() != std::find(command_dependencies_[cand_cmd].begin(),
+                                                           command_dependencies_[cand_cmd].end(),
+                                                           cmd_id)) {
+      invalidate_command(cand_cmd);
+    }
+  }
+}
+
 template <class T>
 int Shell<T>::execute_command(const char* cmd_line,
                                T& common_context) {
@@ -475,6 +752,20 @@ int Shell<T>::execute_command(const char* cmd_line,
   openfpga::StringToken tokenizer(cmd_line);  
   std::vector<std::string> tokens = tokenizer.split(" ");
 
+  /* Nothing to execute for a line of spaces */
+  if (true == tokens.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  return execute_command(tokens, std::string(cmd_line), common_context);
+}
+
+template <class T>
+int Shell<T>::execute_command(const std::vector<std::string>& tokens,
+                               const std::string& cmd_line,
+                               T& common_context) {
+  VTR_ASSERT(false == tokens.empty());
+
   /* Find if the command name is valid */
   ShellCommandId cmd_id = command(tokens[0]);
   if (ShellCommandId::INVALID() == cmd_id) {
@@ -483,6 +774,9 @@ int Shell<T>::execute_command(const char* cmd_line,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* Trace the whole command, including the parsing of its options */
+  VTR_TRACE_SPAN(commands_[cmd_id].name());
+
   /* Check the dependency graph to see if all the prequistics have been met */
   for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
     if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
@@ -508,7 +802,13 @@ int Shell<T>::execute_command(const char* cmd_line,
       strcpy(argv[itok], tokens[itok].c_str());
     }
     /* Execute the marco function and record the execution status */
+    vtr::Timer macro_timer;
+    std::clock_t macro_cpu_start = std::clock();
     command_status_[cmd_id] = command_macro_execute_functions_[cmd_id](tokens.size(), argv);
+    add_command_profile(cmd_id, cmd_line, false, command_status_[cmd_id],
+                        macro_timer.elapsed_sec(),
+                        (float)(std::clock() - macro_cpu_start) / (float)CLOCKS_PER_SEC,
+                        macro_timer.delta_max_rss_mib());
     /* Free the argv */
     for (size_t itok = 0; itok < tokens.size(); ++itok) {
       free(argv[itok]);
@@ -521,19 +821,27 @@ int Shell<T>::execute_command(const char* cmd_line,
  
   /* Reset the command parse results to initial status 
    * Avoid conflict when calling the same command in the second time 
+   * The parse results are reused when the command is called again
+   * with the same options, which is common in generated scripts
    */
-  command_contexts_[cmd_id].reset();
-  if (false == parse_command(tokens, commands_[cmd_id], command_contexts_[cmd_id])) {
-    /* Echo the command */
-    print_command_options(commands_[cmd_id]);
-    command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
-    return CMD_EXEC_FATAL_ERROR;
+  if (command_parsed_tokens_[cmd_id] != tokens) {
+    command_parsed_tokens_[cmd_id].clear();
+    command_contexts_[cmd_id].reset();
+    if (false == parse_command(tokens, commands_[cmd_id], command_contexts_[cmd_id])) {
+      /* Echo the command */
+      print_command_options(commands_[cmd_id]);
+      command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    command_parsed_tokens_[cmd_id] = tokens;
   }
  
   /* Parse succeed. Let user to confirm selected options */ 
   print_command_context(commands_[cmd_id], command_contexts_[cmd_id]);
 
   /* Execute the command depending on the type of function ! */ 
+  vtr::Timer timer;
+  std::clock_t cpu_start = std::clock();
   switch (command_execute_function_types_[cmd_id]) {
   case CONST_STANDARD:
     command_status_[cmd_id] = command_const_execute_functions_[cmd_id](common_context, commands_[cmd_id], command_contexts_[cmd_id]);
@@ -561,15 +869,163 @@ int Shell<T>::execute_command(const char* cmd_line,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  add_command_profile(cmd_id, std::string(cmd_line), false, command_status_[cmd_id],
+                      timer.elapsed_sec(),
+                      (float)(std::clock() - cpu_start) / (float)CLOCKS_PER_SEC,
+                      timer.delta_max_rss_mib());
+
   /* Forbid users to return the status CMD_EXEC_NONE */
   if (CMD_EXEC_NONE == command_status_[cmd_id]) {
     VTR_LOG_ERROR("It is illegal to return never-executed status for an executed command!\n");
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* The results of the provided commands are available now,
+   * while the results of the invalidated commands are not any more
+   */
+  if (CMD_EXEC_FATAL_ERROR != command_status_[cmd_id]) {
+    for (const ShellCommandId& provided_cmd : command_provisions_[cmd_id]) {
+      command_status_[provided_cmd] = CMD_EXEC_SUCCESS;
+    }
+    for (const ShellCommandId& invalidated_cmd : command_invalidations_[cmd_id]) {
+      invalidate_command(invalidated_cmd);
+    }
+  }
+
   return command_status_[cmd_id];
 }
 
+template <class T>
+int Shell<T>::execute_parallel_commands(const std::vector<const t_shell_script_line*>& cmd_lines,
+                                        T& common_context) {
+  VTR_LOG("\nExecute %lu commands in parallel\n", cmd_lines.size());
+
+  /* Parse all the commands before any of them starts,
+   * so that a wrong command line aborts the whole block
+   */
+  std::vector<ShellCommandId> cmd_ids;
+  std::vector<CommandContext> cmd_contexts;
+  for (const t_shell_script_line* cmd_line : cmd_lines) {
+    const std::vector<std::string>& tokens = cmd_line->tokens;
+
+    ShellCommandId cmd_id = command(tokens[0]);
+    if (ShellCommandId::INVALID() == cmd_id) {
+      VTR_LOG("Try to call a command '%s' which is not defined!\n",
+              tokens[0].c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    /* Only the commands which never modify the common context can run in parallel */
+    if ( (CONST_STANDARD != command_execute_function_types_[cmd_id])
+      && (CONST_SHORT != command_execute_function_types_[cmd_id]) ) {
+      VTR_LOG("Command '%s' may modify the data of the shell and can not be executed in parallel!\n",
+              commands_[cmd_id].name().c_str());
+      command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    /* The prequistics should be met before the parallel block */
+    for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
+      if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
+        || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd])
+        || (cmd_ids.end() != std::find(cmd_ids.begin(), cmd_ids.end(), dep_cmd)) ) {
+        VTR_LOG("Command '%s' is required to be executed before command '%s' and out of the parallel block!\n",
+                commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
+        print_command_options(commands_[cmd_id]);
+        command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+        return CMD_EXEC_FATAL_ERROR;
+      } 
+    }
+
+    /* Each command line has its own parsing results,
+     * as a command may be called several times in the block
+     */
+    CommandContext cmd_context(commands_[cmd_id]);
+    if (false == parse_command(tokens, commands_[cmd_id], cmd_context)) {
+      print_command_options(commands_[cmd_id]);
+      command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+      return CMD_EXEC_FATAL_ERROR;
+    }
+
+    cmd_ids.push_back(cmd_id);
+    cmd_contexts.push_back(cmd_context);
+  }
+
+  /* Execute the commands, each on its own thread
+   * Messages are buffered per command, and printed once all the commands finish
+   */
+  std::vector<int> cmd_status(cmd_ids.size(), CMD_EXEC_NONE);
+  std::vector<float> cmd_wall_times(cmd_ids.size(), 0.);
+  std::vector<float> cmd_delta_max_rss(cmd_ids.size(), 0.);
+  std::vector<ShellLogBuffer> log_buffers(cmd_ids.size());
+  std::clock_t cpu_start = std::clock();
+
+  auto print_logs = [&]() {
+    for (size_t icmd = 0; icmd < cmd_ids.size(); ++icmd) {
+      VTR_LOG("\nCommand line executed in parallel: %s\n", cmd_lines[icmd]->cmd_line.c_str());
+      print_command_context(commands_[cmd_ids[icmd]], cmd_contexts[icmd]);
+      log_buffers[icmd].flush();
+    }
+  };
+
+  start_shell_log_capture();
+  try {
+    parallel_for(cmd_ids.size(), cmd_ids.size(), [&](const size_t& icmd) {
+      const ShellCommandId& cmd_id = cmd_ids[icmd];
+      const T& const_context = common_context;
+      set_thread_shell_log_buffer(&log_buffers[icmd]);
+      vtr::Timer timer;
+      try {
+        if (CONST_STANDARD == command_execute_function_types_[cmd_id]) {
+          cmd_status[icmd] = command_const_execute_functions_[cmd_id](const_context, commands_[cmd_id], cmd_contexts[icmd]);
+        } else {
+          VTR_ASSERT(CONST_SHORT == command_execute_function_types_[cmd_id]);
+          cmd_status[icmd] = command_short_const_execute_functions_[cmd_id](const_context);
+        }
+      } catch (...) {
+        set_thread_shell_log_buffer(nullptr);
+        throw;
+      }
+      cmd_wall_times[icmd] = timer.elapsed_sec();
+      cmd_delta_max_rss[icmd] = timer.delta_max_rss_mib();
+      set_thread_shell_log_buffer(nullptr);
+    });
+  } catch (...) {
+    /* Show what has been logged before the failure */
+    finish_shell_log_capture();
+    print_logs();
+    throw;
+  }
+  finish_shell_log_capture();
+  print_logs();
+
+  float cpu_time_sec = (float)(std::clock() - cpu_start) / (float)CLOCKS_PER_SEC;
+  for (size_t icmd = 0; icmd < cmd_ids.size(); ++icmd) {
+    add_command_profile(cmd_ids[icmd], cmd_lines[icmd]->cmd_line, true, cmd_status[icmd],
+                        cmd_wall_times[icmd], cpu_time_sec, cmd_delta_max_rss[icmd]);
+  }
+
+  /* Record the status in the order of command lines, the worst one is returned */
+  int status = CMD_EXEC_SUCCESS;
+  for (size_t icmd = 0; icmd < cmd_ids.size(); ++icmd) {
+    const ShellCommandId& cmd_id = cmd_ids[icmd];
+    /* Forbid users to return the status CMD_EXEC_NONE */
+    if (CMD_EXEC_NONE == cmd_status[icmd]) {
+      VTR_LOG_ERROR("It is illegal to return never-executed status for an executed command!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    command_status_[cmd_id] = cmd_status[icmd];
+    command_contexts_[cmd_id] = cmd_contexts[icmd];
+    command_parsed_tokens_[cmd_id] = cmd_lines[icmd]->tokens;
+    if ( (CMD_EXEC_FATAL_ERROR == cmd_status[icmd])
+      || ( (CMD_EXEC_MINOR_ERROR == cmd_status[icmd]) && (CMD_EXEC_SUCCESS == status) ) ) {
+      status = cmd_status[icmd];
+    }
+  }
+
+  return status;
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
@@ -0,0 +1,161 @@
+/*********************************************************************
+ * This file includes functions to capture the messages logged by
+ * the commands executed in parallel by the shell
+ ********************************************************************/
+#include <cstdarg>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_util.h"
+
+#include "shell_log_buffer.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/* Print handlers installed before the capture starts */
+static vtr::PrintHandlerInfo f_orig_printf = nullptr;
+static vtr::PrintHandlerInfo f_orig_printf_info = nullptr;
+static vtr::PrintHandlerWarning f_orig_printf_warning = nullptr;
+static vtr::PrintHandlerError f_orig_printf_error = nullptr;
+static vtr::PrintHandlerDirect f_orig_printf_direct = nullptr;
+
+/* Buffer of the calling thread, nullptr when the thread prints directly */
+static thread_local ShellLogBuffer* f_thread_log_buffer = nullptr;
+
+/*********************************************************************
+ * Public mutators
+ ********************************************************************/
+void ShellLogBuffer::add_message(const e_log_type& type,
+                                 const char* file_name,
+                                 const unsigned int& line_num,
+                                 const std::string& message) {
+  messages_.push_back({type, file_name, line_num, message});
+}
+
+/*********************************************************************
+ * Public executors
+ ********************************************************************/
+void ShellLogBuffer::flush() const {
+  for (const t_log_message& msg : messages_) {
+    switch (msg.type) {
+    case LOG_INFO:
+      vtr::printf_info("%s", msg.message.c_str());
+      break;
+    case LOG_DIRECT:
+      vtr::printf_direct("%s", msg.message.c_str());
+      break;
+    case LOG_WARNING:
+      vtr::printf_warning(msg.file_name, msg.line_num, "%s", msg.message.c_str());
+      break;
+    case LOG_ERROR:
+      vtr::printf_error(msg.file_name, msg.line_num, "%s", msg.message.c_str());
+      break;
+    default:
+      VTR_ASSERT_MSG(false, "Invalid type of log message");
+    }
+  }
+}
+
+/*********************************************************************
+ * Print handlers which either buffer the message for the calling
+ * thread or forward it to the original handler
+ ********************************************************************/
+static
+void capture_printf_info(const char* message, ...) {
+  va_list va_args;
+  va_start(va_args, message);
+  std::string msg = vtr::vstring_fmt(message, va_args);
+  va_end(va_args);
+
+  if (nullptr == f_thread_log_buffer) {
+    f_orig_printf_info("%s", msg.c_str());
+    return;
+  }
+  f_thread_log_buffer->add_message(ShellLogBuffer::LOG_INFO, nullptr, 0, msg);
+}
+
+static
+void capture_printf_direct(const char* message, ...) {
+  va_list va_args;
+  va_start(va_args, message);
+  std::string msg = vtr::vstring_fmt(message, va_args);
+  va_end(va_args);
+
+  if (nullptr == f_thread_log_buffer) {
+    f_orig_printf_direct("%s", msg.c_str());
+    return;
+  }
+  f_thread_log_buffer->add_message(ShellLogBuffer::LOG_DIRECT, nullptr, 0, msg);
+}
+
+static
+void capture_printf_warning(const char* file_name, unsigned int line_num, const char* message, ...) {
+  va_list va_args;
+  va_start(va_args, message);
+  std::string msg = vtr::vstring_fmt(message, va_args);
+  va_end(va_args);
+
+  if (nullptr == f_thread_log_buffer) {
+    f_orig_printf_warning(file_name, line_num, "%s", msg.c_str());
+    return;
+  }
+  f_thread_log_buffer->add_message(ShellLogBuffer::LOG_WARNING, file_name, line_num, msg);
+}
+
+static
+void capture_printf_error(const char* file_name, unsigned int line_num, const char* message, ...) {
+  va_list va_args;
+  va_start(va_args, message);
+  std::string msg = vtr::vstring_fmt(message, va_args);
+  va_end(va_args);
+
+  if (nullptr == f_thread_log_buffer) {
+    f_orig_printf_error(file_name, line_num, "%s", msg.c_str());
+    return;
+  }
+  f_thread_log_buffer->add_message(ShellLogBuffer::LOG_ERROR, file_name, line_num, msg);
+}
+
+/*********************************************************************
+ * Redirect the print handlers of vtr to the capture handlers
+ * Capture must not be nested
+ ********************************************************************/
+void start_shell_log_capture() {
+  VTR_ASSERT(nullptr == f_orig_printf);
+
+  f_orig_printf = vtr::printf;
+  f_orig_printf_info = vtr::printf_info;
+  f_orig_printf_warning = vtr::printf_warning;
+  f_orig_printf_error = vtr::printf_error;
+  f_orig_printf_direct = vtr::printf_direct;
+
+  vtr::printf = capture_printf_info;
+  vtr::printf_info = capture_printf_info;
+  vtr::printf_warning = capture_printf_warning;
+  vtr::printf_error = capture_printf_error;
+  vtr::printf_direct = capture_printf_direct;
+}
+
+void finish_shell_log_capture() {
+  VTR_ASSERT(nullptr != f_orig_printf);
+
+  vtr::printf = f_orig_printf;
+  vtr::printf_info = f_orig_printf_info;
+  vtr::printf_warning = f_orig_printf_warning;
+  vtr::printf_error = f_orig_printf_error;
+  vtr::printf_direct = f_orig_printf_direct;
+
+  f_orig_printf = nullptr;
+  f_orig_printf_info = nullptr;
+  f_orig_printf_warning = nullptr;
+  f_orig_printf_error = nullptr;
+  f_orig_printf_direct = nullptr;
+}
+
+void set_thread_shell_log_buffer(ShellLogBuffer* log_buffer) {
+  f_thread_log_buffer = log_buffer;
+}
+
+} /* End namespace openfpga */
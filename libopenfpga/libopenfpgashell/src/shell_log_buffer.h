@@ -0,0 +1,57 @@
+#ifndef SHELL_LOG_BUFFER_H
+#define SHELL_LOG_BUFFER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * A buffer of the messages logged by a command
+ * which is executed in parallel with other commands.
+ * The messages are replayed in order once the command finishes,
+ * so that the log of each command is not interleaved with the others
+ ********************************************************************/
+class ShellLogBuffer {
+  public: /* Types */
+    enum e_log_type {
+      LOG_INFO,
+      LOG_DIRECT,
+      LOG_WARNING,
+      LOG_ERROR,
+      NUM_LOG_TYPES
+    };
+  public: /* Public mutators */
+    void add_message(const e_log_type& type,
+                     const char* file_name,
+                     const unsigned int& line_num,
+                     const std::string& message);
+  public: /* Public executors */
+    /* Replay the messages through the current print handlers of vtr */
+    void flush() const;
+  private: /* Internal data */
+    struct t_log_message {
+      e_log_type type;
+      const char* file_name;
+      unsigned int line_num;
+      std::string message;
+    };
+    std::vector<t_log_message> messages_;
+};
+
+/* Redirect the print handlers of vtr to the buffer of the calling thread */
+void start_shell_log_capture();
+
+/* Restore the print handlers of vtr */
+void finish_shell_log_capture();
+
+/* Select the buffer of the calling thread, nullptr to print directly */
+void set_thread_shell_log_buffer(ShellLogBuffer* log_buffer);
+
+} /* End namespace openfpga */
+
+#endif
@@ -0,0 +1,184 @@
+/*********************************************************************
+ * This file includes functions to preprocess the script files
+ * executed by the shell. The whole script is read and tokenized
+ * at once, so that scripts generated with tens of thousands of
+ * lines are loaded in a negligible time
+ ********************************************************************/
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "shell_script.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Substitute the variables '${NAME}' in a line by the values of
+ * the environment variables, in a single pass over the line.
+ * The values are not substituted again, even if they contain '${'
+ *
+ * Return 0 if succeed
+ * Return 1 if a variable is not terminated or not defined
+ ********************************************************************/
+int substitute_shell_script_variables(const std::string& line,
+                                      std::string& substituted_line) {
+  substituted_line.clear();
+  substituted_line.reserve(line.size());
+
+  size_t pos = 0;
+  while (pos < line.size()) {
+    size_t var_start = line.find("${", pos);
+    if (std::string::npos == var_start) {
+      substituted_line.append(line, pos, std::string::npos);
+      break;
+    }
+    substituted_line.append(line, pos, var_start - pos);
+
+    size_t var_end = line.find('}', var_start + 2);
+    if (std::string::npos == var_end) {
+      VTR_LOG_ERROR("Variable starting at '%s' is not terminated by '}'!\n",
+                    line.substr(var_start).c_str());
+      return 1;
+    }
+
+    std::string var_name = line.substr(var_start + 2, var_end - var_start - 2);
+    const char* var_value = std::getenv(var_name.c_str());
+    if ( (true == var_name.empty())
+      || (nullptr == var_value) ) {
+      VTR_LOG_ERROR("Variable '%s' is not defined!\n",
+                    var_name.c_str());
+      return 1;
+    }
+    substituted_line.append(var_value);
+
+    pos = var_end + 1;
+  }
+
+  return 0;
+}
+
+/*********************************************************************
+ * Split a command line by spaces
+ ********************************************************************/
+static
+std::vector<std::string> tokenize_shell_script_line(const std::string& cmd_line) {
+  std::vector<std::string> tokens;
+  size_t pos = cmd_line.find_first_not_of(' ');
+  while (std::string::npos != pos) {
+    size_t token_end = cmd_line.find(' ', pos);
+    if (std::string::npos == token_end) {
+      token_end = cmd_line.size();
+    }
+    tokens.emplace_back(cmd_line, pos, token_end - pos);
+    pos = cmd_line.find_first_not_of(' ', token_end);
+  }
+  return tokens;
+}
+
+/*********************************************************************
+ * Read a script file into a list of command lines
+ * - Any content after a '#' is a comment and is removed
+ * - Lines ending with '\' are conjuncted with the next lines
+ * - Variables '${NAME}' are substituted by environment variables
+ * - Each command line is split into tokens by spaces
+ *
+ * Return 0 if succeed
+ * Return 1 if the file can not be read or a variable is invalid
+ ********************************************************************/
+int read_shell_script(const char* script_file_name,
+                      std::vector<t_shell_script_line>& script_lines) {
+  script_lines.clear();
+
+  /* Load the whole file in one read */
+  std::ifstream fp(script_file_name, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    VTR_LOG("Fail to open the script file: %s! Please check its location\n",
+            script_file_name);
+    return 1;
+  }
+  std::string content(fp.tellg(), '\0');
+  fp.seekg(0);
+  fp.read(&content[0], content.size());
+  if (!fp.good()) {
+    VTR_LOG("Fail to read the script file: %s!\n",
+            script_file_name);
+    return 1;
+  }
+  fp.close();
+
+  /* Consider that each line may not end due to the continued line charactor
+   * Use cmd_line to conjunct multiple lines
+   */
+  std::string cmd_line;
+  size_t cmd_line_number = 0;
+  std::string substituted_line;
+
+  size_t line_number = 0;
+  size_t line_start = 0;
+  while (line_start < content.size()) {
+    size_t line_end = content.find('\n', line_start);
+    if (std::string::npos == line_end) {
+      line_end = content.size();
+    }
+    ++line_number;
+
+    /* The string before '#' is the read command we want */
+    size_t cmd_end = content.find_first_of("#\n", line_start);
+    if ( (std::string::npos == cmd_end) || (line_end < cmd_end) ) {
+      cmd_end = line_end;
+    }
+    /* Remove the spaces at the end of the line
+     * So that we can check easily if there is a continued line in the end
+     */
+    while ( (line_start < cmd_end)
+         && ( (' ' == content[cmd_end - 1])
+           || ('\r' == content[cmd_end - 1])
+           || ('\t' == content[cmd_end - 1]) ) ) {
+      --cmd_end;
+    }
+
+    bool continued = (line_start < cmd_end) && ('\\' == content[cmd_end - 1]);
+    if (true == continued) {
+      --cmd_end;
+    }
+
+    if (true == cmd_line.empty()) {
+      cmd_line_number = line_number;
+    }
+    cmd_line.append(content, line_start, cmd_end - line_start);
+
+    line_start = line_end + 1;
+
+    /* Not finished yet. Parse the next line */
+    if ( (true == continued) && (line_start < content.size()) ) {
+      continue;
+    }
+
+    if (0 != substitute_shell_script_variables(cmd_line, substituted_line)) {
+      VTR_LOG("Invalid variable at line %lu of the script file: %s!\n",
+              cmd_line_number, script_file_name);
+      return 1;
+    }
+    cmd_line.clear();
+
+    /* Remove the spaces at the beginning of the line */
+    size_t cmd_start = substituted_line.find_first_not_of(" \t");
+    if (std::string::npos == cmd_start) {
+      continue;
+    }
+
+    t_shell_script_line script_line;
+    script_line.line_number = cmd_line_number;
+    script_line.cmd_line = substituted_line.substr(cmd_start);
+    script_line.tokens = tokenize_shell_script_line(script_line.cmd_line);
+    script_lines.push_back(std::move(script_line));
+  }
+
+  return 0;
+}
+
+} /* End namespace openfpga */
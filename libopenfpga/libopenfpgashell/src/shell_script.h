@@ -0,0 +1,33 @@
+#ifndef SHELL_SCRIPT_H
+#define SHELL_SCRIPT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * A command line of a script, with the continued lines conjuncted,
+ * the comments removed and the variables substituted
+ ********************************************************************/
+struct t_shell_script_line {
+  /* Index of the first line of the command in the script file, starting from 1 */
+  size_t line_number;
+  std::string cmd_line;
+  /* The command line split by spaces, the first token is the command name */
+  std::vector<std::string> tokens;
+};
+
+int read_shell_script(const char* script_file_name,
+                      std::vector<t_shell_script_line>& script_lines);
+
+int substitute_shell_script_variables(const std::string& line,
+                                      std::string& substituted_line);
+
+} /* End namespace openfpga */
+
+#endif
@@ -0,0 +1,161 @@
+/********************************************************************
+ * This file includes the vectorized kernels on arrays of bits,
+ * e.g., the bit values of a bitstream database, along with 
+ * their portable scalar fallbacks.
+ * The kernels of each instruction set are compiled with the target 
+ * attribute, so that the binary does not require the instruction set,
+ * and they are selected at runtime by select_simd_kernel()
+ *******************************************************************/
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define OPENFPGA_SIMD_X86_KERNELS
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#include <arm_neon.h>
+#define OPENFPGA_SIMD_NEON_KERNELS
+#endif
+
+/* Headers from openfpgautil library */
+#include "openfpga_simd_dispatch.h"
+#include "openfpga_bit_kernels.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+typedef size_t (*CountWordOnesFunc)(const uint64_t*, const size_t);
+
+static
+size_t count_word_ones_scalar(const uint64_t* words, const size_t num_words) {
+  size_t num_ones = 0;
+  for (size_t iword = 0; iword < num_words; ++iword) {
+    num_ones += __builtin_popcountll(words[iword]);
+  }
+  return num_ones;
+}
+
+#ifdef OPENFPGA_SIMD_X86_KERNELS
+/********************************************************************
+ * The builtin is compiled to the POPCNT instruction, 
+ * rather than a call to the library implementation
+ *******************************************************************/
+__attribute__((target("popcnt")))
+static
+size_t count_word_ones_sse42(const uint64_t* words, const size_t num_words) {
+  size_t num_ones = 0;
+  for (size_t iword = 0; iword < num_words; ++iword) {
+    num_ones += __builtin_popcountll(words[iword]);
+  }
+  return num_ones;
+}
+
+/********************************************************************
+ * Count the bits of each byte with a lookup table of the nibbles, 
+ * and sum the bytes of every 64-bit lane
+ *******************************************************************/
+__attribute__((target("avx2,popcnt")))
+static
+size_t count_word_ones_avx2(const uint64_t* words, const size_t num_words) {
+  const __m256i nibble_counts = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i sums = _mm256_setzero_si256();
+
+  size_t iword = 0;
+  for (; iword + 4 <= num_words; iword += 4) {
+    __m256i vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + iword));
+    __m256i low = _mm256_and_si256(vec, low_mask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(vec, 4), low_mask);
+    __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(nibble_counts, low),
+                                     _mm256_shuffle_epi8(nibble_counts, high));
+    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+
+  size_t num_ones = _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1)
+                  + _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+  for (; iword < num_words; ++iword) {
+    num_ones += __builtin_popcountll(words[iword]);
+  }
+  return num_ones;
+}
+
+/********************************************************************
+ * Same as the AVX2 kernel, with 512-bit vectors
+ *******************************************************************/
+__attribute__((target("avx512f,avx512bw,popcnt")))
+static
+size_t count_word_ones_avx512(const uint64_t* words, const size_t num_words) {
+  /* The table is repeated in each 128-bit lane, as the shuffle does not cross lanes */
+  static const uint64_t nibble_count_table[8] = {0x0302020102010100, 0x0403030203020201,
+                                                 0x0302020102010100, 0x0403030203020201,
+                                                 0x0302020102010100, 0x0403030203020201,
+                                                 0x0302020102010100, 0x0403030203020201};
+  const __m512i nibble_counts = _mm512_loadu_si512(nibble_count_table);
+  const __m512i low_mask = _mm512_set1_epi8(0x0f);
+  __m512i sums = _mm512_setzero_si512();
+
+  size_t iword = 0;
+  for (; iword + 8 <= num_words; iword += 8) {
+    __m512i vec = _mm512_loadu_si512(words + iword);
+    __m512i low = _mm512_and_si512(vec, low_mask);
+    __m512i high = _mm512_and_si512(_mm512_srli_epi16(vec, 4), low_mask);
+    __m512i counts = _mm512_add_epi8(_mm512_shuffle_epi8(nibble_counts, low),
+                                     _mm512_shuffle_epi8(nibble_counts, high));
+    sums = _mm512_add_epi64(sums, _mm512_sad_epu8(counts, _mm512_setzero_si512()));
+  }
+
+  uint64_t lane_sums[8];
+  _mm512_storeu_si512(lane_sums, sums);
+  size_t num_ones = 0;
+  for (const uint64_t& lane_sum : lane_sums) {
+    num_ones += lane_sum;
+  }
+  for (; iword < num_words; ++iword) {
+    num_ones += __builtin_popcountll(words[iword]);
+  }
+  return num_ones;
+}
+#endif
+
+#ifdef OPENFPGA_SIMD_NEON_KERNELS
+/********************************************************************
+ * Count the bits of each byte, and widen the sums to 64-bit lanes
+ *******************************************************************/
+static
+size_t count_word_ones_neon(const uint64_t* words, const size_t num_words) {
+  uint64x2_t sums = vdupq_n_u64(0);
+
+  size_t iword = 0;
+  for (; iword + 2 <= num_words; iword += 2) {
+    uint8x16_t counts = vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + iword)));
+    sums = vaddq_u64(sums, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(counts))));
+  }
+
+  size_t num_ones = vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1);
+  for (; iword < num_words; ++iword) {
+    num_ones += __builtin_popcountll(words[iword]);
+  }
+  return num_ones;
+}
+#endif
+
+size_t count_word_ones(const uint64_t* words, const size_t& num_words) {
+  static const CountWordOnesFunc kernel = select_simd_kernel<CountWordOnesFunc>({{
+    count_word_ones_scalar,
+#ifdef OPENFPGA_SIMD_X86_KERNELS
+    count_word_ones_sse42,
+    count_word_ones_avx2,
+    count_word_ones_avx512,
+#else
+    nullptr,
+    nullptr,
+    nullptr,
+#endif
+#ifdef OPENFPGA_SIMD_NEON_KERNELS
+    count_word_ones_neon
+#else
+    nullptr
+#endif
+  }});
+  return kernel(words, num_words);
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,24 @@
+#ifndef OPENFPGA_BIT_KERNELS_H
+#define OPENFPGA_BIT_KERNELS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Number of '1' bits in an array of words, 
+ * with the best kernel for the processor (see openfpga_simd_dispatch.h) 
+ */
+size_t count_word_ones(const uint64_t* words, const size_t& num_words);
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,71 @@
+/********************************************************************
+ * This file includes the member functions of the file stream
+ * with a large user-space buffer
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_trace.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_buffered_file_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors and destructor
+ ***********************************************************************/
+BufferedFileStream::BufferedFileStream(const size_t& buffer_size)
+  : buffer_(buffer_size),
+    span_start_us_(0) {
+  VTR_ASSERT(0 < buffer_size);
+  rdbuf()->pubsetbuf(buffer_.data(), buffer_.size());
+}
+
+BufferedFileStream::~BufferedFileStream() {
+  /* Output the remaining characters while the buffer is still alive,
+   * as the base class is destructed after the buffer
+   */
+  if (is_open()) {
+    close();
+  }
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void BufferedFileStream::open(const std::string& fname,
+                              std::ios_base::openmode mode) {
+  std::fstream::open(fname, mode);
+  start_write_span(fname);
+}
+
+void BufferedFileStream::close() {
+  std::fstream::close();
+  end_write_span();
+}
+
+/************************************************************************
+ * Tracing of the file written
+ ***********************************************************************/
+void BufferedFileStream::start_write_span(const std::string& fname) {
+#ifdef VTR_ENABLE_TRACING
+  if (true == vtr::is_tracing()) {
+    span_fname_ = fname;
+    span_start_us_ = vtr::trace_time_us();
+  }
+#else
+  (void)fname;
+#endif
+}
+
+void BufferedFileStream::end_write_span() {
+#ifdef VTR_ENABLE_TRACING
+  if (false == span_fname_.empty()) {
+    vtr::record_trace_span("write " + span_fname_, span_start_us_, vtr::trace_time_us());
+    span_fname_.clear();
+  }
+#endif
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,63 @@
+#ifndef OPENFPGA_BUFFERED_FILE_STREAM_H
+#define OPENFPGA_BUFFERED_FILE_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Default size of the user-space buffer of a file stream */
+constexpr size_t BUFFERED_FILE_STREAM_DEFAULT_BUFFER_SIZE = 1024 * 1024;
+
+/********************************************************************
+ * A file stream with a large user-space buffer
+ *
+ * The default buffer of std::fstream is only a few kilobytes,
+ * which causes lots of system calls when a large file is written
+ * in many small pieces, e.g., Verilog netlists.
+ * This stream can be used wherever a std::fstream is required.
+ *
+ * Usage:
+ *   BufferedFileStream fp;
+ *   fp.open(fname, std::fstream::out | std::fstream::trunc);
+ *   fp << ...;
+ *
+ * Note:
+ *   - The buffer is installed at construction, before any file is opened,
+ *     as file buffers do not accept a new buffer afterwards
+ *   - Avoid std::endl, which flushes the buffer at every line
+ *   - When tracing is compiled in (VTR_ENABLE_TRACING), the writing of a file,
+ *     from open() to close(), is recorded as a span named after the file.
+ *     open() and close() hide the ones of std::fstream, so the stream
+ *     should be opened and closed through its own type to be traced
+ *******************************************************************/
+class BufferedFileStream : public std::fstream {
+  public: /* Constructor and destructor */
+    explicit BufferedFileStream(const size_t& buffer_size = BUFFERED_FILE_STREAM_DEFAULT_BUFFER_SIZE);
+    ~BufferedFileStream();
+    BufferedFileStream(const BufferedFileStream&) = delete;
+    BufferedFileStream& operator=(const BufferedFileStream&) = delete;
+  public: /* Public mutators */
+    void open(const std::string& fname,
+              std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc);
+    void close();
+  protected: /* Tracing of the file written */
+    void start_write_span(const std::string& fname);
+    void end_write_span();
+  private: /* Internal data */
+    std::vector<char> buffer_;
+    /* The file of the span being recorded, which is empty when no span is recorded */
+    std::string span_fname_;
+    int64_t span_start_us_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
@@ -27,6 +27,14 @@ bool valid_file_stream(std::fstream& fp) {
   return true;
 }
 
+/********************************************************************
+ * Validate an output stream which may not be attached to a file directly,
+ * e.g., a stream whose contents are compressed before reaching a file
+ *******************************************************************/
+bool valid_file_stream(std::ostream& fp) {
+  return fp.good();
+}
+
 /********************************************************************
  * A most utilized function to validate the file stream
  * This function will error out for a valid/invalid file stream 
@@ -243,7 +251,7 @@ void create_directory(const std::string& dir_path, const bool& recursive) {
 /******************************************************************** 
  * Write a number of space to a file 
  ********************************************************************/
-bool write_space_to_file(std::fstream& fp,
+bool write_space_to_file(std::ostream& fp,
                          const size_t& num_space) {
   if (false == valid_file_stream(fp)) {
     return false;
@@ -259,7 +267,7 @@ bool write_space_to_file(std::fstream& fp,
 /******************************************************************** 
  * Write a number of tab to a file 
  ********************************************************************/
-bool write_tab_to_file(std::fstream& fp,
+bool write_tab_to_file(std::ostream& fp,
                        const size_t& num_tab) {
   if (false == valid_file_stream(fp)) {
     return false;
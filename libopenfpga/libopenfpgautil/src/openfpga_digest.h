@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <ostream>
 
 /********************************************************************
  * Function declaration
@@ -14,6 +15,8 @@ namespace openfpga {
 
 bool valid_file_stream(std::fstream& fp);
 
+bool valid_file_stream(std::ostream& fp);
+
 void check_file_stream(const char* fname, 
                        std::fstream& fp);
 
@@ -25,10 +28,10 @@ std::string find_path_dir_name(const std::string& file_name);
 
 void create_directory(const std::string& dir_path, const bool& recursive = true); 
 
-bool write_space_to_file(std::fstream& fp,
+bool write_space_to_file(std::ostream& fp,
                          const size_t& num_space);
 
-bool write_tab_to_file(std::fstream& fp,
+bool write_tab_to_file(std::ostream& fp,
                        const size_t& num_tab);
 
 } /* namespace openfpga ends */
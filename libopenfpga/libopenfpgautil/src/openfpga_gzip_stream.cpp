@@ -0,0 +1,177 @@
+/********************************************************************
+ * This file includes the member functions of the stream buffer
+ * which outputs characters in gzip format
+ *******************************************************************/
+#include <algorithm>
+#include <zlib.h>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_gzip_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Add 16 to the window bits of zlib to produce a gzip header and trailer */
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+constexpr int GZIP_MEM_LEVEL = 8;
+
+/********************************************************************
+ * Compress a chunk of characters to a complete gzip member
+ * Return an empty string if compression fails.
+ * Note that a gzip member is never empty, due to its header
+ *******************************************************************/
+static
+std::string compress_gzip_chunk(const std::string& chunk) {
+  z_stream zs;
+  zs.zalloc = Z_NULL;
+  zs.zfree = Z_NULL;
+  zs.opaque = Z_NULL;
+  if (Z_OK != deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                           GZIP_WINDOW_BITS, GZIP_MEM_LEVEL, Z_DEFAULT_STRATEGY)) {
+    return std::string();
+  }
+
+  /* deflateBound() does not count the gzip header and trailer, reserve some more spaces for them */
+  std::string compressed(deflateBound(&zs, chunk.size()) + 32, '\0');
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(chunk.data()));
+  zs.avail_in = chunk.size();
+  zs.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+  zs.avail_out = compressed.size();
+
+  int status = deflate(&zs, Z_FINISH);
+  size_t num_compressed_bytes = zs.total_out;
+  deflateEnd(&zs);
+
+  if (Z_STREAM_END != status) {
+    return std::string();
+  }
+  compressed.resize(num_compressed_bytes);
+  return compressed;
+}
+
+/************************************************************************
+ * Constructors and destructor
+ ***********************************************************************/
+GzipStreamBuffer::GzipStreamBuffer(std::ostream& sink,
+                                   const size_t& num_threads,
+                                   const size_t& chunk_size)
+  : sink_(sink),
+    num_threads_(find_num_threads(num_threads)),
+    chunk_(chunk_size),
+    failed_(false) {
+  VTR_ASSERT(0 < chunk_size);
+  setp(chunk_.data(), chunk_.data() + chunk_.size());
+}
+
+GzipStreamBuffer::~GzipStreamBuffer() {
+  finish();
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+bool GzipStreamBuffer::finish() {
+  if (pptr() > pbase()) {
+    submit_chunk();
+  }
+  while (!pending_chunks_.empty()) {
+    write_oldest_chunk();
+  }
+  sink_.flush();
+  return (false == failed_) && sink_.good();
+}
+
+/************************************************************************
+ * Overloaded std::streambuf functions
+ ***********************************************************************/
+GzipStreamBuffer::int_type GzipStreamBuffer::overflow(int_type ch) {
+  if (true == failed_) {
+    return traits_type::eof();
+  }
+  submit_chunk();
+  if (false == traits_type::eq_int_type(ch, traits_type::eof())) {
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+  }
+  return traits_type::not_eof(ch);
+}
+
+int GzipStreamBuffer::sync() {
+  /* Do not end the current chunk here, see the notes in the header file */
+  return (true == failed_) ? -1 : 0;
+}
+
+/************************************************************************
+ * Private mutators
+ ***********************************************************************/
+/* Send the current chunk to compression and start a new chunk */
+void GzipStreamBuffer::submit_chunk() {
+  std::string chunk(pbase(), pptr());
+  setp(chunk_.data(), chunk_.data() + chunk_.size());
+
+  if (1 == num_threads_) {
+    write_compressed_chunk(compress_gzip_chunk(chunk));
+    return;
+  }
+
+  /* Limit the number of chunks under compression, which bounds the memory usage */
+  while (num_threads_ <= pending_chunks_.size()) {
+    write_oldest_chunk();
+  }
+  pending_chunks_.push_back(std::async(std::launch::async, compress_gzip_chunk, std::move(chunk)));
+}
+
+/* Wait for the oldest chunk to be compressed and output it to the sink */
+void GzipStreamBuffer::write_oldest_chunk() {
+  VTR_ASSERT(!pending_chunks_.empty());
+  std::string compressed = pending_chunks_.front().get();
+  pending_chunks_.pop_front();
+  write_compressed_chunk(compressed);
+}
+
+/* Output a compressed chunk to the sink */
+void GzipStreamBuffer::write_compressed_chunk(const std::string& compressed) {
+  if (true == compressed.empty()) {
+    failed_ = true;
+    return;
+  }
+  sink_.write(compressed.data(), compressed.size());
+  if (!sink_.good()) {
+    failed_ = true;
+  }
+}
+
+/************************************************************************
+ * Read and decompress a gzip file
+ ***********************************************************************/
+bool read_gzip_file(const std::string& fname,
+                    std::vector<char>& content) {
+  /* Number of decompressed bytes to read at a time */
+  constexpr unsigned GZIP_READ_SIZE = 4 * 1024 * 1024;
+
+  content.clear();
+  gzFile file = gzopen(fname.c_str(), "rb");
+  if (nullptr == file) {
+    return false;
+  }
+
+  int num_read_bytes = 0;
+  do {
+    size_t num_bytes = content.size();
+    content.resize(num_bytes + GZIP_READ_SIZE);
+    num_read_bytes = gzread(file, content.data() + num_bytes, GZIP_READ_SIZE);
+    content.resize(num_bytes + std::max(num_read_bytes, 0));
+  } while (0 < num_read_bytes);
+
+  bool status = (0 == num_read_bytes);
+  if (Z_OK != gzclose(file)) {
+    status = false;
+  }
+  return status;
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,84 @@
+#ifndef OPENFPGA_GZIP_STREAM_H
+#define OPENFPGA_GZIP_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Default number of uncompressed bytes in each chunk */
+constexpr size_t GZIP_STREAM_DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+/********************************************************************
+ * A stream buffer which compresses the characters in gzip format
+ * and outputs the compressed data to a sink stream
+ *
+ * Characters are collected in chunks of a fixed size.
+ * Each chunk is compressed independently as a gzip member,
+ * and the members are output in order. A sequence of gzip members
+ * is a valid gzip file, which can be read by any gzip tools.
+ * As the chunks are independent, they can be compressed
+ * on worker threads while the writer keeps filling the next chunk.
+ * The compressed data is the same regardless of the number of threads.
+ *
+ * Usage:
+ *   std::fstream fp_file;  // opened in binary mode
+ *   GzipStreamBuffer gzip_buffer(fp_file, num_threads);
+ *   std::ostream fp(&gzip_buffer);
+ *   fp << ...;
+ *   if (false == gzip_buffer.finish()) { error handling }
+ *
+ * Note:
+ *   - Flushing the stream (e.g., std::endl) does not end a chunk,
+ *     otherwise the compression ratio drops drastically.
+ *     Call finish() to output all the data to the sink
+ *******************************************************************/
+class GzipStreamBuffer : public std::streambuf {
+  public: /* Constructor and destructor */
+    GzipStreamBuffer(std::ostream& sink,
+                     const size_t& num_threads,
+                     const size_t& chunk_size = GZIP_STREAM_DEFAULT_CHUNK_SIZE);
+    ~GzipStreamBuffer();
+    GzipStreamBuffer(const GzipStreamBuffer&) = delete;
+    GzipStreamBuffer& operator=(const GzipStreamBuffer&) = delete;
+  public: /* Public mutators */
+    /* Compress the remaining characters and output all the pending chunks to the sink.
+     * Return true if all the chunks are compressed and output successfully
+     */
+    bool finish();
+  protected: /* Overloaded std::streambuf functions */
+    int_type overflow(int_type ch) override;
+    int sync() override;
+  private: /* Private mutators */
+    void submit_chunk();
+    void write_oldest_chunk();
+    void write_compressed_chunk(const std::string& compressed);
+  private: /* Internal data */
+    std::ostream& sink_;
+    size_t num_threads_;
+    std::vector<char> chunk_;
+    /* Chunks under compression, in the order of output */
+    std::deque<std::future<std::string>> pending_chunks_;
+    bool failed_;
+};
+
+/********************************************************************
+ * Read all the characters of a gzip file, which may contain
+ * several gzip members as written by GzipStreamBuffer
+ * Return true if the file is read and decompressed successfully
+ *******************************************************************/
+bool read_gzip_file(const std::string& fname,
+                    std::vector<char>& content);
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef OPENFPGA_ID_ITERATOR_H
+#define OPENFPGA_ID_ITERATOR_H
+
+/********************************************************************
+ * Include header files that are required by class declaration
+ *******************************************************************/
+#include <cstddef>
+#include <iterator>
+#include <unordered_set>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A template used to represent a lazily calculated iterator of the 
+ * specified ID type. The key assumption made is that the ID space is 
+ * contiguous and can be walked by incrementing the underlying ID value. 
+ * To account for invalid IDs, it keeps a reference to the invalid ID set 
+ * and returns ID::INVALID() for ID values in the set.
+ *
+ * It is used to lazily create an iteration range (e.g. as returned by 
+ * ModuleManager::module_nets()) just based on the count of allocated elements,
+ * and the set of any invalid IDs.
+ *
+ * The invalid ID sets are empty in most cases, 
+ * which is checked before probing the set, so that walking through
+ * the IDs is as fast as walking through a plain vector
+ *******************************************************************/
+template<class ID>
+class LazyIdIterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
+  public:
+    //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
+    //to bring the value_type and iterator names into scope
+    typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
+    typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
+
+    LazyIdIterator(value_type init, const std::unordered_set<ID>& invalid_ids)
+        : value_(init)
+        , invalid_ids_(invalid_ids) {}
+
+    //Advance to the next ID value
+    iterator operator++() {
+        value_ = ID(size_t(value_) + 1);
+        return *this;
+    }
+
+    //Advance to the previous ID value
+    iterator operator--() {
+        value_ = ID(size_t(value_) - 1);
+        return *this;
+    }
+
+    //Dereference the iterator
+    value_type operator*() const { 
+        return ((false == invalid_ids_.empty()) && (0 < invalid_ids_.count(value_))) ? ID::INVALID() : value_;
+    }
+
+    friend bool operator==(const LazyIdIterator<ID> lhs, const LazyIdIterator<ID> rhs) { return lhs.value_ == rhs.value_; }
+    friend bool operator!=(const LazyIdIterator<ID> lhs, const LazyIdIterator<ID> rhs) { return !(lhs == rhs); }
+
+  private:
+    value_type value_;
+    const std::unordered_set<ID>& invalid_ids_;
+};
+
+/********************************************************************
+ * A lazily calculated iterator for an ID space which is contiguous 
+ * and does not contain any invalid ID, e.g., configuration bits. 
+ * Unlike LazyIdIterator, there is no need to check any invalid ID set
+ * when dereferencing
+ *******************************************************************/
+template<class ID>
+class DenseIdIterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
+  public:
+    typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
+    typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
+
+    explicit DenseIdIterator(value_type init)
+        : value_(init) {}
+
+    //Advance to the next ID value
+    iterator operator++() {
+        value_ = ID(size_t(value_) + 1);
+        return *this;
+    }
+
+    //Advance to the previous ID value
+    iterator operator--() {
+        value_ = ID(size_t(value_) - 1);
+        return *this;
+    }
+
+    //Dereference the iterator
+    value_type operator*() const { return value_; }
+
+    friend bool operator==(const DenseIdIterator<ID> lhs, const DenseIdIterator<ID> rhs) { return lhs.value_ == rhs.value_; }
+    friend bool operator!=(const DenseIdIterator<ID> lhs, const DenseIdIterator<ID> rhs) { return !(lhs == rhs); }
+
+  private:
+    value_type value_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
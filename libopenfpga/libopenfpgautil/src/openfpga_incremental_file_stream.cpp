@@ -0,0 +1,130 @@
+/********************************************************************
+ * This file includes the member functions of the file stream
+ * which only replaces a file when its contents change
+ *******************************************************************/
+#include <cstdio>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_incremental_file_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Postfix of the temporary file aside the target file */
+constexpr char INCREMENTAL_FILE_STREAM_TEMP_POSTFIX[] = ".tmp";
+
+/********************************************************************
+ * Read the next line of a file which does not start with the ignored prefix
+ * Return false if the end of the file is reached
+ *******************************************************************/
+static 
+bool read_next_compared_line(std::ifstream& fp,
+                             const std::string& ignored_line_prefix,
+                             std::string& line) {
+  while (std::getline(fp, line)) {
+    if ((true == ignored_line_prefix.empty())
+       || (0 != line.compare(0, ignored_line_prefix.size(), ignored_line_prefix))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/********************************************************************
+ * Compare the contents of two files line by line, 
+ * skipping the lines starting with the ignored prefix
+ * Return true if the contents are the same.
+ * If any file can not be opened, they are considered as different
+ *******************************************************************/
+static 
+bool same_file_contents(const std::string& fname_a,
+                        const std::string& fname_b,
+                        const std::string& ignored_line_prefix) {
+  std::ifstream fp_a(fname_a);
+  std::ifstream fp_b(fname_b);
+  if ((!fp_a.is_open()) || (!fp_b.is_open())) {
+    return false;
+  }
+
+  std::string line_a;
+  std::string line_b;
+  while (true) {
+    bool has_line_a = read_next_compared_line(fp_a, ignored_line_prefix, line_a);
+    bool has_line_b = read_next_compared_line(fp_b, ignored_line_prefix, line_b);
+    if (has_line_a != has_line_b) {
+      return false;
+    }
+    if (false == has_line_a) {
+      /* Both files reach the end, unless a file fails in the middle */
+      return fp_a.eof() && fp_b.eof();
+    }
+    if (line_a != line_b) {
+      return false;
+    }
+  }
+}
+
+/************************************************************************
+ * Constructors and destructor
+ ***********************************************************************/
+IncrementalFileStream::IncrementalFileStream(const bool& enabled,
+                                             const std::string& ignored_line_prefix)
+  : enabled_(enabled),
+    ignored_line_prefix_(ignored_line_prefix),
+    file_changed_(false) {
+}
+
+IncrementalFileStream::~IncrementalFileStream() {
+  close();
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+bool IncrementalFileStream::file_changed() const {
+  return file_changed_;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void IncrementalFileStream::open(const std::string& fname,
+                                 std::ios_base::openmode mode) {
+  file_changed_ = false;
+  if (false == enabled_) {
+    BufferedFileStream::open(fname, mode);
+    return;
+  }
+  fname_ = fname;
+  std::fstream::open(fname_ + std::string(INCREMENTAL_FILE_STREAM_TEMP_POSTFIX), mode);
+  /* Trace the target file rather than the temporary one */
+  start_write_span(fname_);
+}
+
+void IncrementalFileStream::close() {
+  if (is_open()) {
+    std::fstream::close();
+    file_changed_ = true;
+  }
+
+  if (true == fname_.empty()) {
+    end_write_span();
+    return;
+  }
+
+  std::string temp_fname = fname_ + std::string(INCREMENTAL_FILE_STREAM_TEMP_POSTFIX);
+  if (true == same_file_contents(temp_fname, fname_, ignored_line_prefix_)) {
+    std::remove(temp_fname.c_str());
+    file_changed_ = false;
+  } else if (0 != std::rename(temp_fname.c_str(), fname_.c_str())) {
+    VTR_LOG_ERROR("Fail to replace file '%s' with '%s'!\n",
+                  fname_.c_str(), temp_fname.c_str());
+  }
+  fname_.clear();
+  end_write_span();
+}
+
+} /* namespace openfpga ends */
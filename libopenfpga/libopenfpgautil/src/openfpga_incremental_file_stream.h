@@ -0,0 +1,64 @@
+#ifndef OPENFPGA_INCREMENTAL_FILE_STREAM_H
+#define OPENFPGA_INCREMENTAL_FILE_STREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <fstream>
+#include <string>
+
+#include "openfpga_buffered_file_stream.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A buffered file stream which only replaces a file when its contents change
+ *
+ * When enabled, the contents are written to a temporary file aside the target file.
+ * When the stream is closed, the temporary file is compared to the target file,
+ * where the lines starting with the ignored prefix are skipped 
+ * (e.g., the time stamps in file headers):
+ *  - if they are the same, the temporary file is removed and
+ *    the target file, including its modification time, is not touched
+ *  - otherwise, the temporary file replaces the target file
+ * This keeps the caches of downstream tools, which rely on modification times, valid.
+ * Note that it does not save any writing: the whole contents are still written
+ * to the temporary file, and the target file is read back for the comparison
+ *
+ * When disabled, the stream writes the target file directly, like a BufferedFileStream
+ *
+ * Usage:
+ *   IncrementalFileStream fp(enabled, "// Date:");
+ *   fp.open(fname);
+ *   fp << ...;
+ *   fp.close();
+ *
+ * Note:
+ *   - open() and close() hide the ones of BufferedFileStream, so the stream
+ *     should be opened and closed through its own type.
+ *     It can be passed to any function requiring a std::fstream for writing
+ *******************************************************************/
+class IncrementalFileStream : public BufferedFileStream {
+  public: /* Constructor and destructor */
+    IncrementalFileStream(const bool& enabled,
+                          const std::string& ignored_line_prefix);
+    ~IncrementalFileStream();
+  public: /* Public accessors */
+    /* Return true if the target file is written by the last close() */
+    bool file_changed() const;
+  public: /* Public mutators */
+    void open(const std::string& fname,
+              std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc);
+    void close();
+  private: /* Internal data */
+    bool enabled_;
+    std::string ignored_line_prefix_;
+    /* The target file, which is empty when no file is opened */
+    std::string fname_;
+    bool file_changed_;
+};
+
+} /* namespace openfpga ends */
+
+#endif
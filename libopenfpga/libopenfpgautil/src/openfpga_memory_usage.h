@@ -0,0 +1,183 @@
+#ifndef OPENFPGA_MEMORY_USAGE_H
+#define OPENFPGA_MEMORY_USAGE_H
+
+/********************************************************************
+ * This file includes templates to estimate the memory allocated
+ * on heap by the containers of data structures,
+ * in order to find which data structures take most of the memory.
+ *
+ * The estimation is based on the capacity of the containers,
+ * so that it includes the memory reserved but not yet used.
+ * The memory of the nodes of maps and sets is estimated
+ * without the overhead of the memory allocator.
+ *
+ * A data structure can report the memory it owns
+ * by implementing a member function
+ *   size_t memory_usage() const;
+ * which returns the size of the object plus its heap memory.
+ * Objects of the other types are considered to own no heap memory
+ *******************************************************************/
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_vector.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Declare all the templates first, so that they can call each other for nested containers */
+template <typename T>
+size_t heap_memory_usage(const T& obj);
+
+inline size_t heap_memory_usage(const std::string& str);
+
+template <typename T1, typename T2>
+size_t heap_memory_usage(const std::pair<T1, T2>& pair);
+
+template <typename T, typename Alloc>
+size_t heap_memory_usage(const std::vector<T, Alloc>& vec);
+
+template <typename Alloc>
+size_t heap_memory_usage(const std::vector<bool, Alloc>& vec);
+
+template <typename K, typename V>
+size_t heap_memory_usage(const vtr::vector<K, V>& vec);
+
+template <typename K>
+size_t heap_memory_usage(const vtr::vector<K, bool>& vec);
+
+template <typename K, typename V, typename Compare, typename Alloc>
+size_t heap_memory_usage(const std::map<K, V, Compare, Alloc>& map);
+
+template <typename K, typename Compare, typename Alloc>
+size_t heap_memory_usage(const std::set<K, Compare, Alloc>& set);
+
+template <typename K, typename V, typename Hash, typename Equal, typename Alloc>
+size_t heap_memory_usage(const std::unordered_map<K, V, Hash, Equal, Alloc>& map);
+
+template <typename K, typename Hash, typename Equal, typename Alloc>
+size_t heap_memory_usage(const std::unordered_set<K, Hash, Equal, Alloc>& set);
+
+/* Size of the pointers and the color of a node of a red-black tree */
+constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+
+/* Size of the pointer and the cached hash value of a node of a hash table */
+constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*);
+
+/********************************************************************
+ * Objects with a member function memory_usage() report their memory,
+ * the others are considered to own no heap memory
+ *******************************************************************/
+template <typename T>
+auto heap_memory_usage_of_object(const T& obj, int) -> decltype(obj.memory_usage(), size_t()) {
+  return obj.memory_usage() - sizeof(T);
+}
+
+template <typename T>
+size_t heap_memory_usage_of_object(const T&, long) {
+  return 0;
+}
+
+template <typename T>
+size_t heap_memory_usage(const T& obj) {
+  return heap_memory_usage_of_object(obj, 0);
+}
+
+/* Short strings are stored inside the string object */
+inline size_t heap_memory_usage(const std::string& str) {
+  const char* data = str.data();
+  const char* obj = reinterpret_cast<const char*>(&str);
+  if ((obj <= data) && (data < obj + sizeof(std::string))) {
+    return 0;
+  }
+  return str.capacity() + 1;
+}
+
+template <typename T1, typename T2>
+size_t heap_memory_usage(const std::pair<T1, T2>& pair) {
+  return heap_memory_usage(pair.first) + heap_memory_usage(pair.second);
+}
+
+/* The elements of trivial types own no heap memory, skip them for large vectors */
+template <typename T, typename Alloc>
+size_t heap_memory_usage(const std::vector<T, Alloc>& vec) {
+  size_t usage = vec.capacity() * sizeof(T);
+  if (!std::is_trivially_copyable<T>::value) {
+    for (const T& elem : vec) {
+      usage += heap_memory_usage(elem);
+    }
+  }
+  return usage;
+}
+
+/* Vectors of booleans are packed bit by bit */
+template <typename Alloc>
+size_t heap_memory_usage(const std::vector<bool, Alloc>& vec) {
+  return vec.capacity() / 8;
+}
+
+template <typename K, typename V>
+size_t heap_memory_usage(const vtr::vector<K, V>& vec) {
+  size_t usage = vec.capacity() * sizeof(V);
+  if (!std::is_trivially_copyable<V>::value) {
+    for (const V& elem : vec) {
+      usage += heap_memory_usage(elem);
+    }
+  }
+  return usage;
+}
+
+template <typename K>
+size_t heap_memory_usage(const vtr::vector<K, bool>& vec) {
+  return vec.capacity() / 8;
+}
+
+template <typename K, typename V, typename Compare, typename Alloc>
+size_t heap_memory_usage(const std::map<K, V, Compare, Alloc>& map) {
+  size_t usage = map.size() * (sizeof(typename std::map<K, V, Compare, Alloc>::value_type) + TREE_NODE_OVERHEAD);
+  for (const auto& elem : map) {
+    usage += heap_memory_usage(elem);
+  }
+  return usage;
+}
+
+template <typename K, typename Compare, typename Alloc>
+size_t heap_memory_usage(const std::set<K, Compare, Alloc>& set) {
+  size_t usage = set.size() * (sizeof(K) + TREE_NODE_OVERHEAD);
+  for (const K& elem : set) {
+    usage += heap_memory_usage(elem);
+  }
+  return usage;
+}
+
+template <typename K, typename V, typename Hash, typename Equal, typename Alloc>
+size_t heap_memory_usage(const std::unordered_map<K, V, Hash, Equal, Alloc>& map) {
+  size_t usage = map.bucket_count() * sizeof(void*)
+               + map.size() * (sizeof(typename std::unordered_map<K, V, Hash, Equal, Alloc>::value_type) + HASH_NODE_OVERHEAD);
+  for (const auto& elem : map) {
+    usage += heap_memory_usage(elem);
+  }
+  return usage;
+}
+
+template <typename K, typename Hash, typename Equal, typename Alloc>
+size_t heap_memory_usage(const std::unordered_set<K, Hash, Equal, Alloc>& set) {
+  size_t usage = set.bucket_count() * sizeof(void*)
+               + set.size() * (sizeof(K) + HASH_NODE_OVERHEAD);
+  for (const K& elem : set) {
+    usage += heap_memory_usage(elem);
+  }
+  return usage;
+}
+
+} /* namespace openfpga ends */
+
+#endif
@@ -0,0 +1,349 @@
+/********************************************************************
+ * This file includes functions to run independent tasks 
+ * on multiple threads in OpenFPGA framework
+ *
+ * All the functions share a pool of worker threads, which is created
+ * on the first use and grows on demand, so that commands do not pay
+ * for creating threads each time they run a parallel loop.
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h" 
+
+namespace openfpga {
+
+/********************************************************************
+ * A pool of worker threads which run the tasks of a queue
+ * in the order of submission
+ *
+ * The pool is never destroyed: the workers wait for tasks until
+ * the process exits, so that no task can outlive the pool
+ *******************************************************************/
+class ThreadPool {
+  public: /* Public accessors */
+    size_t num_workers() {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return workers_.size();
+    }
+  public: /* Public mutators */
+    /* Queue a task, and add workers until there are at least the given number */
+    void submit(const std::function<void()>& task,
+                const size_t& num_workers) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (workers_.size() < num_workers) {
+          workers_.emplace_back(&ThreadPool::run_worker, this);
+        }
+        tasks_.push_back(task);
+      }
+      task_cond_.notify_one();
+    }
+
+    /* Lock and unlock the pool around a fork() */
+    void lock() { mutex_.lock(); }
+    void unlock() { mutex_.unlock(); }
+  private: /* Internal builders */
+    void run_worker() {
+      while (true) {
+        std::function<void()> task;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          task_cond_.wait(lock, [&]() { return !tasks_.empty(); });
+          task = tasks_.front();
+          tasks_.pop_front();
+        }
+        task();
+      }
+    }
+  private: /* Internal data */
+    std::mutex mutex_;
+    std::condition_variable task_cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+};
+
+static ThreadPool* f_thread_pool = nullptr;
+static std::once_flag f_thread_pool_flag;
+
+/********************************************************************
+ * Only the thread calling fork() survives in the child process,
+ * so that the child starts over with an empty pool.
+ * The worker threads owned by the old pool do not exist in the child,
+ * the old pool is left as it is.
+ *******************************************************************/
+static
+void lock_thread_pool_before_fork() {
+  f_thread_pool->lock();
+}
+
+static
+void unlock_thread_pool_after_fork_in_parent() {
+  f_thread_pool->unlock();
+}
+
+static
+void reset_thread_pool_after_fork_in_child() {
+  f_thread_pool->unlock();
+  f_thread_pool = new ThreadPool();
+}
+
+static
+ThreadPool& thread_pool() {
+  std::call_once(f_thread_pool_flag, []() {
+    f_thread_pool = new ThreadPool();
+    pthread_atfork(lock_thread_pool_before_fork,
+                   unlock_thread_pool_after_fork_in_parent,
+                   reset_thread_pool_after_fork_in_child);
+  });
+  return *f_thread_pool;
+}
+
+/********************************************************************
+ * Find the number of threads to be used 
+ * - When 0 is given, use all the cores available on the machine
+ * - Otherwise, use the given number
+ *******************************************************************/
+size_t find_num_threads(const size_t& num_threads) {
+  if (0 < num_threads) {
+    return num_threads;
+  }
+  return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+}
+
+/********************************************************************
+ * Find the number of worker threads currently in the shared pool
+ *******************************************************************/
+size_t num_thread_pool_workers() {
+  return thread_pool().num_workers();
+}
+
+/********************************************************************
+ * The state of a parallel loop, shared by the calling thread
+ * and the workers of the pool helping it.
+ * A helper may only start after the loop is finished,
+ * so that it must not touch anything but this state
+ * unless it claims an item
+ *******************************************************************/
+struct t_parallel_job {
+  size_t num_items = 0;
+  const std::function<void(const size_t&)>* func = nullptr;
+  std::atomic<size_t> next_item{0};
+  std::atomic<size_t> num_active_helpers{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr first_exception = nullptr;
+  std::mutex mutex;
+  std::condition_variable done_cond;
+};
+
+static
+void run_parallel_job_items(t_parallel_job& job) {
+  while (false == job.failed.load()) {
+    size_t item = job.next_item.fetch_add(1);
+    if (item >= job.num_items) {
+      break;
+    }
+    try {
+      (*job.func)(item);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.mutex);
+      if (nullptr == job.first_exception) {
+        job.first_exception = std::current_exception();
+      }
+      job.failed.store(true);
+    }
+  }
+}
+
+/********************************************************************
+ * Call a function for each item in the range [0, num_items) 
+ * using a number of threads (0 means all the cores)
+ * Items are dispatched to threads dynamically, so that 
+ * the function must not depend on the order of the calls.
+ *
+ * When a single thread is requested, the items are processed
+ * in order by the calling thread, so that results are exactly
+ * the same as a plain loop.
+ *
+ * The calling thread always works on the items, and is helped by
+ * the workers of the shared pool which are free. 
+ * Therefore, a parallel loop can be nested in another one:
+ * when all the workers are busy, the inner loop is run 
+ * by the calling thread alone.
+ *
+ * If any call throws an exception, the remaining items are skipped
+ * and the first exception is rethrown to the caller
+ *******************************************************************/
+void parallel_for(const size_t& num_items,
+                  const size_t& num_threads,
+                  const std::function<void(const size_t&)>& func) {
+  size_t num_workers = std::min(find_num_threads(num_threads), num_items);
+
+  if (1 >= num_workers) {
+    for (size_t item = 0; item < num_items; ++item) {
+      func(item);
+    }
+    return;
+  }
+
+  std::shared_ptr<t_parallel_job> job = std::make_shared<t_parallel_job>();
+  job->num_items = num_items;
+  job->func = &func;
+
+  auto helper = [job]() {
+    job->num_active_helpers.fetch_add(1);
+    run_parallel_job_items(*job);
+    if (1 == job->num_active_helpers.fetch_sub(1)) {
+      std::lock_guard<std::mutex> lock(job->mutex);
+      job->done_cond.notify_all();
+    }
+  };
+
+  ThreadPool& pool = thread_pool();
+  for (size_t iworker = 0; iworker < num_workers - 1; ++iworker) {
+    pool.submit(helper, num_workers - 1);
+  }
+
+  /* The calling thread also works */
+  run_parallel_job_items(*job);
+
+  /* All the items are claimed, wait for the helpers still working on them */
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->done_cond.wait(lock, [&]() { return 0 == job->num_active_helpers.load(); });
+  }
+
+  if (nullptr != job->first_exception) {
+    std::rethrow_exception(job->first_exception);
+  }
+}
+
+/********************************************************************
+ * Call a function for each task of a graph, 
+ * where each task is given the list of the tasks it depends on,
+ * using a number of threads (0 means all the cores)
+ *
+ * The tasks are run level by level: a task is run after 
+ * all the tasks it depends on are finished. 
+ * The tasks of the same level are run in parallel
+ *******************************************************************/
+void parallel_task_graph(const std::vector<std::vector<size_t>>& task_dependencies,
+                         const size_t& num_threads,
+                         const std::function<void(const size_t&)>& func) {
+  size_t num_tasks = task_dependencies.size();
+
+  /* Sort the tasks topologically */
+  std::vector<size_t> num_pending_dependencies(num_tasks, 0);
+  std::vector<std::vector<size_t>> task_fanouts(num_tasks);
+  for (size_t task = 0; task < num_tasks; ++task) {
+    for (const size_t& dependency : task_dependencies[task]) {
+      VTR_ASSERT(dependency < num_tasks);
+      task_fanouts[dependency].push_back(task);
+    }
+    num_pending_dependencies[task] = task_dependencies[task].size();
+  }
+
+  std::vector<size_t> level_tasks;
+  for (size_t task = 0; task < num_tasks; ++task) {
+    if (0 == num_pending_dependencies[task]) {
+      level_tasks.push_back(task);
+    }
+  }
+
+  size_t num_finished_tasks = 0;
+  while (!level_tasks.empty()) {
+    parallel_for(level_tasks.size(), num_threads,
+                 [&](const size_t& itask) {
+                   func(level_tasks[itask]);
+                 });
+    num_finished_tasks += level_tasks.size();
+
+    std::vector<size_t> next_level_tasks;
+    for (const size_t& task : level_tasks) {
+      for (const size_t& fanout : task_fanouts[task]) {
+        num_pending_dependencies[fanout]--;
+        if (0 == num_pending_dependencies[fanout]) {
+          next_level_tasks.push_back(fanout);
+        }
+      }
+    }
+    level_tasks = next_level_tasks;
+  }
+
+  /* A task is never run if the graph has a cycle */
+  VTR_ASSERT(num_finished_tasks == num_tasks);
+}
+
+/********************************************************************
+ * Write the items in the range [0, num_items) to a stream, 
+ * where the items are formatted by chunks of chunk_size items 
+ * using a number of threads (0 means all the cores)
+ *
+ * Each chunk [begin, end) is formatted into its own memory buffer
+ * by format_chunk(), which returns 0 if succeed. The buffers are 
+ * written to the stream in the order of the items, so that the output
+ * is the same as a plain loop. Only a window of two chunks per thread 
+ * is kept in memory.
+ *
+ * When a single thread is requested, the chunks are formatted 
+ * directly to the stream
+ *
+ * Return the status of the first chunk which fails, otherwise 0
+ *******************************************************************/
+int parallel_write_chunks(std::ostream& fp,
+                          const size_t& num_items,
+                          const size_t& chunk_size,
+                          const size_t& num_threads,
+                          const std::function<int(std::ostream&, const size_t&, const size_t&)>& format_chunk) {
+  VTR_ASSERT(0 < chunk_size);
+  size_t num_chunks = (num_items + chunk_size - 1) / chunk_size;
+  size_t num_workers = find_num_threads(num_threads);
+
+  if ((1 >= num_workers) || (1 >= num_chunks)) {
+    return format_chunk(fp, 0, num_items);
+  }
+
+  size_t window_size = 2 * num_workers;
+  std::vector<std::string> buffers(window_size);
+  std::vector<int> statuses(window_size, 0);
+
+  for (size_t window_begin = 0; window_begin < num_chunks; window_begin += window_size) {
+    size_t num_window_chunks = std::min(window_size, num_chunks - window_begin);
+    parallel_for(num_window_chunks, num_workers,
+                 [&](const size_t& ichunk) {
+                   size_t begin = (window_begin + ichunk) * chunk_size;
+                   size_t end = std::min(begin + chunk_size, num_items);
+                   std::ostringstream chunk_fp;
+                   statuses[ichunk] = format_chunk(chunk_fp, begin, end);
+                   buffers[ichunk] = chunk_fp.str();
+                 });
+
+    for (size_t ichunk = 0; ichunk < num_window_chunks; ++ichunk) {
+      if (0 != statuses[ichunk]) {
+        return statuses[ichunk];
+      }
+      fp.write(buffers[ichunk].data(), buffers[ichunk].size());
+      /* Release the memory of the chunk early */
+      std::string().swap(buffers[ichunk]);
+    }
+  }
+
+  return 0;
+}
+
+} /* namespace openfpga ends */
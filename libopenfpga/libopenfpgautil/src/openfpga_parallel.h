@@ -0,0 +1,67 @@
+#ifndef OPENFPGA_PARALLEL_H
+#define OPENFPGA_PARALLEL_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+size_t find_num_threads(const size_t& num_threads);
+
+size_t num_thread_pool_workers();
+
+void parallel_for(const size_t& num_items,
+                  const size_t& num_threads,
+                  const std::function<void(const size_t&)>& func);
+
+void parallel_task_graph(const std::vector<std::vector<size_t>>& task_dependencies,
+                         const size_t& num_threads,
+                         const std::function<void(const size_t&)>& func);
+
+int parallel_write_chunks(std::ostream& fp,
+                          const size_t& num_items,
+                          const size_t& chunk_size,
+                          const size_t& num_threads,
+                          const std::function<int(std::ostream&, const size_t&, const size_t&)>& format_chunk);
+
+/********************************************************************
+ * Compute a value for each item in the range [0, num_items)
+ * using a number of threads (0 means all the cores),
+ * and combine the values with a reduction function.
+ *
+ * The values are always combined in the order of the items,
+ * starting from the initial value, so that the result is the same
+ * whatever the number of threads, even if the reduction function
+ * is not associative (e.g., a sum of floating-point numbers)
+ *******************************************************************/
+template <typename T>
+T parallel_reduce(const size_t& num_items,
+                  const size_t& num_threads,
+                  const T& init,
+                  const std::function<T(const size_t&)>& map_func,
+                  const std::function<T(const T&, const T&)>& reduce_func) {
+  std::vector<T> values(num_items, init);
+  parallel_for(num_items, num_threads,
+               [&](const size_t& item) {
+                 values[item] = map_func(item);
+               });
+
+  T result = init;
+  for (const T& value : values) {
+    result = reduce_func(result, value);
+  }
+  return result;
+}
+
+} /* namespace openfpga ends */
+
+#endif
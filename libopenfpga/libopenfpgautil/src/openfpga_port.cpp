@@ -1,6 +1,9 @@
 #include <numeric>
 #include <algorithm>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -10,6 +13,38 @@
 /* namespace openfpga begins */
 namespace openfpga {
 
+/************************************************************************
+ * Pool of port names
+ * A name is never removed from the pool, and its address is stable,
+ * so that the name of a port can be read without locking the pool.
+ * Each thread keeps its own look-up of the names it has interned,
+ * so that the pool is only locked for the names new to the thread.
+ * The pool is never destroyed, as ports may be used by static objects
+ ***********************************************************************/
+static 
+const std::string* intern_port_name(const std::string& name) {
+  if (true == name.empty()) {
+    return nullptr;
+  }
+
+  thread_local std::unordered_map<std::string, const std::string*> thread_names;
+  auto result = thread_names.find(name);
+  if (result != thread_names.end()) {
+    return result->second;
+  }
+
+  static std::mutex pool_mutex;
+  static std::unordered_set<std::string>* name_pool = new std::unordered_set<std::string>();
+  const std::string* pooled_name = nullptr;
+  {
+    std::lock_guard<std::mutex> pool_lock(pool_mutex);
+    pooled_name = &(*name_pool->insert(name).first);
+  }
+  thread_names[name] = pooled_name;
+
+  return pooled_name;
+}
+
 /************************************************************************
  * Member functions for BasicPort class 
  ***********************************************************************/
@@ -20,6 +55,7 @@ namespace openfpga {
 /* Default constructor */
 BasicPort::BasicPort() {
   /* By default we set an invalid port, which size is 0 */
+  name_ = nullptr;
   lsb_ = 1;
   msb_ = 0;
 
@@ -51,14 +87,14 @@ BasicPort::BasicPort(const std::string& name, const size_t& width) {
   set_origin_port_width(-1);
 }
 
-/* Copy constructor */
-BasicPort::BasicPort(const BasicPort& basic_port) {
-  set(basic_port);
-} 
-
 /************************************************************************
  * Accessors 
  ***********************************************************************/
+size_t BasicPort::memory_usage() const {
+  /* The name is shared in the name pool */
+  return sizeof(BasicPort);
+}
+
 /* get the port width */
 size_t BasicPort::get_width() const {
   if (true == is_valid()) {
@@ -78,8 +114,12 @@ size_t BasicPort::get_lsb() const {
 }
 
 /* get the name */
-std::string BasicPort::get_name() const {
-  return name_;
+const std::string& BasicPort::get_name() const {
+  static const std::string empty_name;
+  if (nullptr == name_) {
+    return empty_name;
+  }
+  return *name_;
 } 
 
 /* Make a range of the pin indices */
@@ -102,7 +142,7 @@ std::vector<size_t> BasicPort::pins() const {
 
 /* Check if a port can be merged with this port: their name should be the same */
 bool BasicPort::mergeable(const BasicPort& portA) const {
-  return (0 == this->get_name().compare(portA.get_name()));
+  return this->name_ == portA.name_;
 } 
 
 /* Check if a port is contained by this port:
@@ -127,7 +167,7 @@ size_t BasicPort::get_origin_port_width() const {
  * 3. MSBs are the same 
  */
 bool BasicPort::operator== (const BasicPort& portA) const {
-  if  ( (0 == this->get_name().compare(portA.get_name())) 
+  if  ( (this->name_ == portA.name_) 
      && (this->get_lsb() == portA.get_lsb())
      && (this->get_msb() == portA.get_msb()) ) {
     return true;
@@ -136,7 +176,7 @@ bool BasicPort::operator== (const BasicPort& portA) const {
 }
 
 bool BasicPort::operator< (const BasicPort& portA) const {
-  if  ( (0 == this->get_name().compare(portA.get_name())) 
+  if  ( (this->name_ == portA.name_) 
      && (this->get_lsb() < portA.get_lsb())
      && (this->get_msb() < portA.get_msb()) ) {
     return true;
@@ -150,7 +190,7 @@ bool BasicPort::operator< (const BasicPort& portA) const {
  ***********************************************************************/
 /* copy */
 void BasicPort::set(const BasicPort& basic_port) {
-  name_ = basic_port.get_name();
+  name_ = basic_port.name_;
   lsb_ = basic_port.get_lsb(); 
   msb_ = basic_port.get_msb(); 
   origin_port_width_ = basic_port.get_origin_port_width();
@@ -160,7 +200,7 @@ void BasicPort::set(const BasicPort& basic_port) {
 
 /* set the port LSB and MSB */
 void BasicPort::set_name(const std::string& name) { 
-  name_ = name;
+  name_ = intern_port_name(name);
   return;
 }
  
@@ -10,7 +10,11 @@
 /* namespace openfpga begins */
 namespace openfpga {
 
-/* A basic port */
+/* A basic port
+ * The name of a port is interned in a pool shared by all the ports,
+ * so that a port is trivially copyable, and copying a port or comparing
+ * the names of two ports does not touch any string
+ */
 class BasicPort {
   public: /* Constructors */
     BasicPort();
@@ -18,15 +22,16 @@ class BasicPort {
     BasicPort(const char* name, const size_t& width);
     BasicPort(const std::string& name, const size_t& lsb, const size_t& msb);
     BasicPort(const std::string& name, const size_t& width);
-    BasicPort(const BasicPort& basic_port); /* Copy constructor */
   public: /* Overloaded operators */
     bool operator== (const BasicPort& portA) const;
     bool operator< (const BasicPort& portA) const;
   public: /* Accessors */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
     size_t get_width() const; /* get the port width */
     size_t get_msb() const; /* get the LSB */
     size_t get_lsb() const; /* get the LSB */
-    std::string get_name() const; /* get the name */
+    const std::string& get_name() const; /* get the name */
     bool is_valid() const; /* check if port size is valid > 0 */
     std::vector<size_t> pins() const; /* Make a range of the pin indices */
     bool mergeable(const BasicPort& portA) const; /* Check if a port can be merged with this port */
@@ -50,7 +55,7 @@ class BasicPort {
   private: /* internal functions */
     void make_invalid(); /* Make a port invalid */
   private: /* Internal Data */
-    std::string name_; /* Name of this port */
+    const std::string* name_; /* Name of this port in the name pool, nullptr for an empty name */
     size_t msb_; /* Most Significant Bit of this port */
     size_t lsb_; /* Least Significant Bit of this port */
     size_t origin_port_width_; /* Original port width of a port, used by traceback port conversion history  */
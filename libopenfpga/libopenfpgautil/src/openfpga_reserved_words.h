@@ -25,6 +25,7 @@ constexpr char* GIO_INOUT_PREFIX = "gfpga_pad_";
 /* Grid naming constant strings */
 constexpr char* GRID_MODULE_NAME_PREFIX = "grid_"; 
 constexpr char* LOGICAL_MODULE_NAME_PREFIX = "logical_tile_"; 
+constexpr char* GRID_CORE_MODULE_POSTFIX = "_core"; 
 
 /* Memory naming constant strings */
 constexpr char* GRID_MEM_INSTANCE_PREFIX = "mem_"; 
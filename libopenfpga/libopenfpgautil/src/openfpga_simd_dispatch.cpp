@@ -0,0 +1,107 @@
+/********************************************************************
+ * This file includes the runtime detection of the instruction sets
+ * used to select the vectorized kernels, so that a binary built once
+ * runs the best kernels on both older and newer processors
+ *******************************************************************/
+#include <cstdlib>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_simd_dispatch.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Environment variable limiting the level of the kernels */
+constexpr const char* SIMD_LEVEL_ENV_VAR = "OPENFPGA_SIMD_LEVEL";
+
+std::string simd_level_name(const e_simd_level& level) {
+  switch (level) {
+  case SIMD_SCALAR:
+    return std::string("scalar");
+  case SIMD_SSE42:
+    return std::string("sse4.2");
+  case SIMD_AVX2:
+    return std::string("avx2");
+  case SIMD_AVX512:
+    return std::string("avx512");
+  case SIMD_NEON:
+    return std::string("neon");
+  default:
+    VTR_ASSERT_MSG(false, "Invalid SIMD level");
+  }
+  return std::string();
+}
+
+/********************************************************************
+ * Find the best level supported by the processor
+ * The x86 features are queried with the compiler builtins,
+ * which also check that the operating system saves the AVX registers
+ *******************************************************************/
+static
+e_simd_level find_cpu_simd_level() {
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+  __builtin_cpu_init();
+  if ((0 != __builtin_cpu_supports("avx512f"))
+     && (0 != __builtin_cpu_supports("avx512bw"))) {
+    return SIMD_AVX512;
+  }
+  if (0 != __builtin_cpu_supports("avx2")) {
+    return SIMD_AVX2;
+  }
+  if ((0 != __builtin_cpu_supports("sse4.2"))
+     && (0 != __builtin_cpu_supports("popcnt"))) {
+    return SIMD_SSE42;
+  }
+  return SIMD_SCALAR;
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+  /* Advanced SIMD is mandatory on AArch64 */
+  return SIMD_NEON;
+#else
+  return SIMD_SCALAR;
+#endif
+}
+
+e_simd_level detected_simd_level() {
+  static const e_simd_level level = find_cpu_simd_level();
+  return level;
+}
+
+/********************************************************************
+ * Limit the detected level with the environment variable, if set
+ * An unknown level is reported and ignored
+ *******************************************************************/
+static
+e_simd_level find_simd_level() {
+  e_simd_level level = detected_simd_level();
+
+  const char* env_value = std::getenv(SIMD_LEVEL_ENV_VAR);
+  if (nullptr == env_value) {
+    return level;
+  }
+
+  for (int ilevel = SIMD_SCALAR; ilevel < NUM_SIMD_LEVELS; ++ilevel) {
+    if (simd_level_name(e_simd_level(ilevel)) != std::string(env_value)) {
+      continue;
+    }
+    /* NEON and x86 levels are exclusive: only scalar may limit them both */
+    if ((SIMD_SCALAR == ilevel)
+       || ((SIMD_NEON != level) && (SIMD_NEON != ilevel) && (ilevel < level))) {
+      return e_simd_level(ilevel);
+    }
+    return level;
+  }
+
+  VTR_LOG_WARN("Ignore unknown SIMD level '%s' in %s!\n",
+               env_value, SIMD_LEVEL_ENV_VAR);
+  return level;
+}
+
+e_simd_level simd_level() {
+  static const e_simd_level level = find_simd_level();
+  return level;
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,75 @@
+#ifndef OPENFPGA_SIMD_DISPATCH_H
+#define OPENFPGA_SIMD_DISPATCH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "vtr_assert.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Instruction set levels of the vectorized kernels, from the slowest
+ * to the fastest. Each x86 level includes the ones below it.
+ * The NEON level is only detected on ARM processors, where
+ * none of the x86 levels are available
+ *******************************************************************/
+enum e_simd_level {
+  SIMD_SCALAR,  /* Portable C++ */
+  SIMD_SSE42,   /* SSE4.2 and POPCNT */
+  SIMD_AVX2,    /* AVX2, on top of SSE4.2 */
+  SIMD_AVX512,  /* AVX-512 F and BW, on top of AVX2 */
+  SIMD_NEON,    /* ARM Advanced SIMD */
+  NUM_SIMD_LEVELS
+};
+
+/* Name of a level, e.g., 'avx2', as accepted by OPENFPGA_SIMD_LEVEL */
+std::string simd_level_name(const e_simd_level& level);
+
+/* Best level supported by the processor running the binary */
+e_simd_level detected_simd_level();
+
+/* Level used to select the kernels, which is the detected level
+ * limited by the environment variable OPENFPGA_SIMD_LEVEL
+ * (e.g., 'OPENFPGA_SIMD_LEVEL=scalar') if it is set to a lower level
+ */
+e_simd_level simd_level();
+
+/********************************************************************
+ * Select the kernel of the best level which is not above simd_level()
+ * Kernels which are not implemented (or not compiled for the target
+ * architecture) are nullptr, the scalar kernel is always required.
+ *
+ * The selection is done once per kernel, by the caller, e.g.:
+ *   static const CountFunc count = select_simd_kernel<CountFunc>({{count_scalar, count_sse42, nullptr, nullptr, nullptr}});
+ *   count(words, num_words);
+ *******************************************************************/
+template <typename Func>
+Func select_simd_kernel(const std::array<Func, NUM_SIMD_LEVELS>& kernels) {
+  VTR_ASSERT(nullptr != kernels[SIMD_SCALAR]);
+  e_simd_level level = simd_level();
+  /* NEON is not above the x86 levels, it is only used on ARM processors */
+  if ((SIMD_NEON == level) && (nullptr != kernels[SIMD_NEON])) {
+    return kernels[SIMD_NEON];
+  }
+  for (int ilevel = std::min(int(level), int(SIMD_AVX512)); ilevel > SIMD_SCALAR; --ilevel) {
+    if (nullptr != kernels[ilevel]) {
+      return kernels[ilevel];
+    }
+  }
+  return kernels[SIMD_SCALAR];
+}
+
+} /* namespace openfpga ends */
+
+#endif
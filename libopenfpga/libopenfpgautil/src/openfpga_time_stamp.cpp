@@ -0,0 +1,57 @@
+/********************************************************************
+ * This file includes functions to print the time stamps
+ * in the headers of the files written by OpenFPGA
+ *
+ * In deterministic output mode, the time stamps are replaced by
+ * a fixed text, so that the files written by two runs on the same
+ * inputs are byte-identical, whatever the number of threads
+ *******************************************************************/
+#include <chrono>
+#include <ctime>
+
+/* Headers from openfpgautil library */
+#include "openfpga_time_stamp.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Text printed instead of the time stamps in deterministic output mode */
+constexpr char DETERMINISTIC_TIME_STAMP[] = "omitted for deterministic output\n";
+
+static 
+bool& deterministic_output_ref() {
+  static bool enabled = false;
+  return enabled;
+}
+
+/********************************************************************
+ * Enable or disable the deterministic output mode
+ * This should be set before any file is written, 
+ * as it is not guarded against concurrent writers
+ *******************************************************************/
+void set_deterministic_output(const bool& enabled) {
+  deterministic_output_ref() = enabled;
+}
+
+bool deterministic_output() {
+  return deterministic_output_ref();
+}
+
+/********************************************************************
+ * Generate the time stamp of a file header in the format of ctime(),
+ * ending with a line break, e.g., "Wed Jun 30 21:49:08 1993\n"
+ * Files may be written by multiple threads, so the reentrant version 
+ * of ctime() is used
+ *******************************************************************/
+std::string generate_file_time_stamp() {
+  if (true == deterministic_output()) {
+    return std::string(DETERMINISTIC_TIME_STAMP);
+  }
+
+  auto end = std::chrono::system_clock::now(); 
+  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
+  char end_time_str[32];
+  return std::string(ctime_r(&end_time, end_time_str));
+}
+
+} /* namespace openfpga ends */
@@ -0,0 +1,23 @@
+#ifndef OPENFPGA_TIME_STAMP_H
+#define OPENFPGA_TIME_STAMP_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+void set_deterministic_output(const bool& enabled);
+
+bool deterministic_output();
+
+std::string generate_file_time_stamp();
+
+} /* namespace openfpga ends */
+
+#endif
@@ -5,6 +5,13 @@
 
 #include "pin_constraints.h"
 
+/************************************************************************
+ * Key of a pin in the fast lookup, made of its name and range
+ ***********************************************************************/
+static std::string pin_lookup_key(const openfpga::BasicPort& pin) {
+  return pin.get_name() + "[" + std::to_string(pin.get_lsb()) + ":" + std::to_string(pin.get_msb()) + "]";
+}
+
 /************************************************************************
  * Member functions for class PinConstraints
  ***********************************************************************/
@@ -40,22 +47,18 @@ std::string PinConstraints::net(const PinConstraintId& pin_constraint_id) const
 
 std::string PinConstraints::pin_net(const openfpga::BasicPort& pin) const {
   std::string constrained_net_name;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
-    if (pin == pin_constraint_pins_[pin_constraint]) {
-      constrained_net_name = net(pin_constraint); 
-      break;
-    }
+  auto result = pin_constraint_lookup_.find(pin_lookup_key(pin));
+  if (result != pin_constraint_lookup_.end()) {
+    constrained_net_name = net(result->second);
   }
   return constrained_net_name;
 }
 
 openfpga::BasicPort PinConstraints::net_pin(const std::string& net) const {
   openfpga::BasicPort constrained_pin;
-  for (const PinConstraintId& pin_constraint : pin_constraints()) {
-    if (net == pin_constraint_nets_[pin_constraint]) {
-      constrained_pin = pin(pin_constraint); 
-      break;
-    }
+  auto result = net_constraint_lookup_.find(net);
+  if (result != net_constraint_lookup_.end()) {
+    constrained_pin = pin(result->second);
   }
   return constrained_pin;
 } 
@@ -71,6 +74,8 @@ void PinConstraints::reserve_pin_constraints(const size_t& num_pin_constraints)
   pin_constraint_ids_.reserve(num_pin_constraints);
   pin_constraint_pins_.reserve(num_pin_constraints);
   pin_constraint_nets_.reserve(num_pin_constraints);
+  pin_constraint_lookup_.reserve(num_pin_constraints);
+  net_constraint_lookup_.reserve(num_pin_constraints);
 }
 
 PinConstraintId PinConstraints::create_pin_constraint(const openfpga::BasicPort& pin,
@@ -81,6 +86,10 @@ PinConstraintId PinConstraints::create_pin_constraint(const openfpga::BasicPort&
   pin_constraint_ids_.push_back(pin_constraint_id);
   pin_constraint_pins_.push_back(pin);
   pin_constraint_nets_.push_back(net);
+
+  /* Only the first constraint of a pin or a net is found by the lookups */
+  pin_constraint_lookup_.emplace(pin_lookup_key(pin), pin_constraint_id);
+  net_constraint_lookup_.emplace(net, pin_constraint_id);
   
   return pin_constraint_id;
 }
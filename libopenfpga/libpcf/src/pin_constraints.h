@@ -7,6 +7,7 @@
 #include <string>
 #include <map>
 #include <array>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_vector.h"
@@ -100,6 +101,11 @@ class PinConstraints {
 
     /* Nets to constraint */
     vtr::vector<PinConstraintId, std::string> pin_constraint_nets_;
+
+    /* Fast lookups for the first constraint of a pin (by its name and range)
+     * and of a net */
+    std::unordered_map<std::string, PinConstraintId> pin_constraint_lookup_;
+    std::unordered_map<std::string, PinConstraintId> net_constraint_lookup_;
 };
 
 #endif
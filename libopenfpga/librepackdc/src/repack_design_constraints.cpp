@@ -5,6 +5,13 @@
 
 #include "repack_design_constraints.h"
 
+/************************************************************************
+ * Key of a pin in the fast lookup, made of its name and range
+ ***********************************************************************/
+static std::string pin_lookup_key(const openfpga::BasicPort& pin) {
+  return pin.get_name() + "[" + std::to_string(pin.get_lsb()) + ":" + std::to_string(pin.get_msb()) + "]";
+}
+
 /************************************************************************
  * Member functions for class RepackDesignConstraints
  ***********************************************************************/
@@ -53,12 +60,13 @@ std::string RepackDesignConstraints::net(const RepackDesignConstraintId& repack_
 std::string RepackDesignConstraints::find_constrained_pin_net(const std::string& pb_type,
                                                               const openfpga::BasicPort& pin) const {
   std::string constrained_net_name;
-  for (const RepackDesignConstraintId& design_constraint : design_constraints()) {
-    /* If found a constraint, record the net name */
-    if ( (pb_type == repack_design_constraint_pb_types_[design_constraint]) 
-       && (pin == repack_design_constraint_pins_[design_constraint])) {
-      constrained_net_name = repack_design_constraint_nets_[design_constraint];
-      break;
+  /* If found a constraint, record the net name of the first one */
+  auto pb_type_result = pin_constraint_lookup_.find(pb_type);
+  if (pb_type_result != pin_constraint_lookup_.end()) {
+    auto pin_result = pb_type_result->second.find(pin_lookup_key(pin));
+    if (pin_result != pb_type_result->second.end()) {
+      VTR_ASSERT(!pin_result->second.empty());
+      constrained_net_name = repack_design_constraint_nets_[pin_result->second.front()];
     }
   }
   return constrained_net_name;
@@ -88,6 +96,8 @@ RepackDesignConstraintId RepackDesignConstraints::create_design_constraint(const
   repack_design_constraint_pb_types_.emplace_back();
   repack_design_constraint_pins_.emplace_back();
   repack_design_constraint_nets_.emplace_back();
+
+  register_pin_constraint(repack_design_constraint_id);
   
   return repack_design_constraint_id;
 }
@@ -96,14 +106,18 @@ void RepackDesignConstraints::set_pb_type(const RepackDesignConstraintId& repack
                                           const std::string& pb_type) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  unregister_pin_constraint(repack_design_constraint_id);
   repack_design_constraint_pb_types_[repack_design_constraint_id] = pb_type;
+  register_pin_constraint(repack_design_constraint_id);
 }
 
 void RepackDesignConstraints::set_pin(const RepackDesignConstraintId& repack_design_constraint_id,
                                       const openfpga::BasicPort& pin) {
   /* validate the design_constraint_id */
   VTR_ASSERT(valid_design_constraint_id(repack_design_constraint_id));
+  unregister_pin_constraint(repack_design_constraint_id);
   repack_design_constraint_pins_[repack_design_constraint_id] = pin;
+  register_pin_constraint(repack_design_constraint_id);
 }
 
 void RepackDesignConstraints::set_net(const RepackDesignConstraintId& repack_design_constraint_id,
@@ -113,6 +127,29 @@ void RepackDesignConstraints::set_net(const RepackDesignConstraintId& repack_des
   repack_design_constraint_nets_[repack_design_constraint_id] = net;
 }
 
+/************************************************************************
+ * Internal mutators
+ ***********************************************************************/
+void RepackDesignConstraints::register_pin_constraint(const RepackDesignConstraintId& repack_design_constraint_id) {
+  std::vector<RepackDesignConstraintId>& pin_constraints = pin_constraint_lookup_[repack_design_constraint_pb_types_[repack_design_constraint_id]][pin_lookup_key(repack_design_constraint_pins_[repack_design_constraint_id])];
+  /* Keep the constraints sorted, so that the first one is found as in the constraint list */
+  pin_constraints.insert(std::lower_bound(pin_constraints.begin(), pin_constraints.end(), repack_design_constraint_id),
+                         repack_design_constraint_id);
+}
+
+void RepackDesignConstraints::unregister_pin_constraint(const RepackDesignConstraintId& repack_design_constraint_id) {
+  auto pb_type_result = pin_constraint_lookup_.find(repack_design_constraint_pb_types_[repack_design_constraint_id]);
+  VTR_ASSERT(pb_type_result != pin_constraint_lookup_.end());
+  auto pin_result = pb_type_result->second.find(pin_lookup_key(repack_design_constraint_pins_[repack_design_constraint_id]));
+  VTR_ASSERT(pin_result != pb_type_result->second.end());
+
+  std::vector<RepackDesignConstraintId>& pin_constraints = pin_result->second;
+  pin_constraints.erase(std::find(pin_constraints.begin(), pin_constraints.end(), repack_design_constraint_id));
+  if (pin_constraints.empty()) {
+    pb_type_result->second.erase(pin_result);
+  }
+}
+
 /************************************************************************
  * Internal invalidators/validators 
  ***********************************************************************/
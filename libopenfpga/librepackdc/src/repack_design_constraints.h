@@ -7,6 +7,8 @@
 #include <string>
 #include <map>
 #include <array>
+#include <vector>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_vector.h"
@@ -104,6 +106,11 @@ class RepackDesignConstraints {
      */
     bool unmapped_net(const std::string& net) const;
 
+  private: /* Internal mutators */
+    /* Add or remove a design constraint in the fast lookup of its pb_type and pin */
+    void register_pin_constraint(const RepackDesignConstraintId& repack_design_constraint_id);
+    void unregister_pin_constraint(const RepackDesignConstraintId& repack_design_constraint_id);
+
   private: /* Internal data */
     /* Unique ids for each design constraint */
     vtr::vector<RepackDesignConstraintId, RepackDesignConstraintId> repack_design_constraint_ids_;
@@ -119,6 +126,10 @@ class RepackDesignConstraints {
 
     /* Nets to constraint */
     vtr::vector<RepackDesignConstraintId, std::string> repack_design_constraint_nets_;
+
+    /* Fast lookup for the design constraints of a pin, by the pb_type name and the pin
+     * (name and range). The constraints of a pin are sorted by ascending id */
+    std::unordered_map<std::string, std::unordered_map<std::string, std::vector<RepackDesignConstraintId>>> pin_constraint_lookup_;
 };
 
 #endif
@@ -23,6 +23,25 @@ loc_data load_xml(pugi::xml_document& doc,      //Document object to be loaded w
     return location_data;
 }
 
+loc_data load_xml_inplace(pugi::xml_document& doc,
+                          const std::string filename,
+                          char* buffer,
+                          size_t size) {
+    auto location_data = loc_data(filename);
+
+    auto load_result = doc.load_buffer_inplace(buffer, size);
+    if (!load_result) {
+        std::string msg = load_result.description();
+        auto line = location_data.line(load_result.offset);
+        auto col = location_data.col(load_result.offset);
+        throw XmlError("Unable to load XML file '" + filename + "', " + msg
+                           + " (line: " + std::to_string(line) + " col: " + std::to_string(col) + ")",
+                       filename.c_str(), line);
+    }
+
+    return location_data;
+}
+
 //Gets the first child element of the given name and returns it.
 //
 //  node - The parent xml node
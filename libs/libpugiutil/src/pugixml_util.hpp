@@ -51,6 +51,17 @@ class XmlError : public std::runtime_error {
 loc_data load_xml(pugi::xml_document& doc,     //Document object to be loaded with file contents
                   const std::string filename); //Filename to load from
 
+//Loads the XML contents of the file specified by filename, which were already
+//read into buffer, into the passed pugi::xml_docment
+//
+//The buffer is parsed in place (without a copy), and must outlive the document
+//
+//Returns loc_data look-up for xml node line numbers
+loc_data load_xml_inplace(pugi::xml_document& doc,    //Document object to be loaded with the buffer
+                          const std::string filename, //Filename the buffer was read from
+                          char* buffer,               //Contents of the file
+                          size_t size);               //Size of the contents (in bytes)
+
 //Defines whether something (e.g. a node/attribute) is optional or required.
 //  We use this to improve clarity at the function call site (compared to just
 //  using boolean values).
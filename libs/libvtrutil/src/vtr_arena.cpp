@@ -0,0 +1,100 @@
+#include <utility>
+
+#include "vtr_assert.h"
+#include "vtr_arena.h"
+
+namespace vtr {
+
+constexpr size_t Arena::DEFAULT_BLOCK_SIZE;
+
+Arena::Arena(size_t block_size)
+    : block_size_(block_size) {
+    VTR_ASSERT(block_size_ > 0);
+}
+
+Arena::Arena(Arena&& other) noexcept
+    : block_size_(other.block_size_)
+    , blocks_(std::move(other.blocks_))
+    , next_(other.next_)
+    , end_(other.end_)
+    , bytes_allocated_(other.bytes_allocated_)
+    , bytes_reserved_(other.bytes_reserved_) {
+    other.blocks_.clear();
+    other.next_ = nullptr;
+    other.end_ = nullptr;
+    other.bytes_allocated_ = 0;
+    other.bytes_reserved_ = 0;
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        block_size_ = other.block_size_;
+        blocks_ = std::move(other.blocks_);
+        next_ = other.next_;
+        end_ = other.end_;
+        bytes_allocated_ = other.bytes_allocated_;
+        bytes_reserved_ = other.bytes_reserved_;
+
+        other.blocks_.clear();
+        other.next_ = nullptr;
+        other.end_ = nullptr;
+        other.bytes_allocated_ = 0;
+        other.bytes_reserved_ = 0;
+    }
+    return *this;
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    VTR_ASSERT_SAFE(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    bytes_allocated_ += size;
+
+    //Large requests get a block of their own, so that the free space
+    //of the current block is not wasted
+    if (size + alignment > block_size_ / 4) {
+        char* block = allocate_block(size + alignment, false);
+        size_t misalignment = reinterpret_cast<size_t>(block) & (alignment - 1);
+        return block + (misalignment ? alignment - misalignment : 0);
+    }
+
+    size_t misalignment = reinterpret_cast<size_t>(next_) & (alignment - 1);
+    size_t padding = misalignment ? alignment - misalignment : 0;
+    if (next_ == nullptr || size_t(end_ - next_) < size + padding) {
+        allocate_block(block_size_, true);
+        misalignment = reinterpret_cast<size_t>(next_) & (alignment - 1);
+        padding = misalignment ? alignment - misalignment : 0;
+    }
+
+    char* ptr = next_ + padding;
+    next_ = ptr + size;
+    return ptr;
+}
+
+void Arena::release() {
+    blocks_.clear();
+    blocks_.shrink_to_fit();
+    next_ = nullptr;
+    end_ = nullptr;
+    bytes_allocated_ = 0;
+    bytes_reserved_ = 0;
+}
+
+char* Arena::allocate_block(size_t size, bool make_current) {
+    std::unique_ptr<char[]> block(new char[size]);
+    char* ptr = block.get();
+    bytes_reserved_ += size;
+
+    if (make_current || blocks_.empty()) {
+        blocks_.push_back(std::move(block));
+        if (make_current) {
+            next_ = ptr;
+            end_ = ptr + size;
+        }
+    } else {
+        //Keep the current block last
+        blocks_.insert(blocks_.end() - 1, std::move(block));
+    }
+    return ptr;
+}
+
+} // namespace vtr
@@ -0,0 +1,112 @@
+#ifndef VTR_ARENA_H
+#define VTR_ARENA_H
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace vtr {
+
+//vtr::Arena is a bump allocator: memory is carved out of large blocks
+//by moving a pointer forward, and is only given back all at once,
+//when the arena is released or destroyed.
+//
+//This suits data which is built once and dropped as a whole (e.g. names),
+//as it avoids one heap allocation (and its bookkeeping) per object.
+//
+//Note that the arena does not call destructors: it should only hold
+//objects which are trivially destructible.
+class Arena {
+  public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    //The memory handed out belongs to the arena, so it can be moved but not copied
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&& other) noexcept;
+    Arena& operator=(Arena&& other) noexcept;
+
+  public: //Mutators
+    //Returns size bytes aligned on alignment (which must be a power of 2).
+    //The memory stays valid until the arena is released
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    //Returns uninitialized memory for num objects of type T
+    template<typename T>
+    T* allocate_array(size_t num) {
+        return static_cast<T*>(allocate(num * sizeof(T), alignof(T)));
+    }
+
+    //Frees all the memory handed out by the arena at once
+    void release();
+
+  public: //Accessors
+    //Number of bytes handed out
+    size_t bytes_allocated() const { return bytes_allocated_; }
+
+    //Number of bytes of the blocks owned by the arena
+    size_t bytes_reserved() const { return bytes_reserved_; }
+
+  private:
+    //Allocates a block of size bytes, which becomes the current block
+    //only if make_current is set
+    char* allocate_block(size_t size, bool make_current);
+
+  private:
+    size_t block_size_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+
+    //Free range of the current block
+    char* next_ = nullptr;
+    char* end_ = nullptr;
+
+    size_t bytes_allocated_ = 0;
+    size_t bytes_reserved_ = 0;
+};
+
+//Allocator adapter so that standard containers take their memory from an Arena, e.g.
+//
+//  vtr::Arena arena;
+//  std::vector<int, vtr::ArenaAllocator<int>> vec{vtr::ArenaAllocator<int>(arena)};
+//
+//The memory of the container is only freed when the arena is released,
+//so this should be used for containers which are not grown again and again.
+template<typename T>
+class ArenaAllocator {
+  public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(Arena& arena) noexcept
+        : arena_(&arena) {}
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_(other.arena()) {}
+
+    T* allocate(size_t num) {
+        return arena_->allocate_array<T>(num);
+    }
+
+    //Memory is given back when the arena is released
+    void deallocate(T* /*ptr*/, size_t /*num*/) noexcept {}
+
+    Arena* arena() const noexcept { return arena_; }
+
+  private:
+    Arena* arena_;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+} // namespace vtr
+
+#endif
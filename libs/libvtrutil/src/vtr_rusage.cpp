@@ -1,8 +1,20 @@
+#include <cstdint>
+#include <cstdio>
+
 #include "vtr_rusage.h"
 
 #ifdef __unix__
 #    include <sys/time.h>
 #    include <sys/resource.h>
+#    include <unistd.h>
+#endif
+
+#if defined(VTR_USE_MIMALLOC)
+#    include <mimalloc.h>
+#elif defined(VTR_USE_JEMALLOC)
+#    include <jemalloc/jemalloc.h>
+#elif defined(__GLIBC__)
+#    include <malloc.h>
 #endif
 
 namespace vtr {
@@ -26,4 +38,59 @@ size_t get_max_rss() {
     return max_rss;
 }
 
+size_t get_current_rss() {
+    size_t current_rss = 0;
+
+#ifdef __linux__
+    //The second field of statm is the number of resident pages
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm) {
+        unsigned long num_pages = 0;
+        unsigned long num_resident_pages = 0;
+        if (std::fscanf(statm, "%lu %lu", &num_pages, &num_resident_pages) == 2) {
+            current_rss = size_t(num_resident_pages) * size_t(sysconf(_SC_PAGESIZE));
+        }
+        std::fclose(statm);
+    }
+#endif
+
+    return current_rss;
+}
+
+t_malloc_stats get_malloc_stats() {
+    t_malloc_stats stats;
+
+#if defined(VTR_USE_MIMALLOC)
+    stats.allocator = "mimalloc";
+    //mimalloc only reports the memory it has committed
+    size_t elapsed_msecs, user_msecs, system_msecs, current_rss, peak_rss, peak_commit, page_faults;
+    mi_process_info(&elapsed_msecs, &user_msecs, &system_msecs,
+                    &current_rss, &peak_rss,
+                    &stats.mapped, &peak_commit, &page_faults);
+#elif defined(VTR_USE_JEMALLOC)
+    stats.allocator = "jemalloc";
+    //The statistics are only updated when the epoch is advanced
+    uint64_t epoch = 1;
+    size_t size = sizeof(epoch);
+    mallctl("epoch", &epoch, &size, &epoch, size);
+
+    size = sizeof(size_t);
+    mallctl("stats.allocated", &stats.allocated, &size, nullptr, 0);
+    size = sizeof(size_t);
+    mallctl("stats.mapped", &stats.mapped, &size, nullptr, 0);
+#elif defined(__GLIBC__)
+    stats.allocator = "glibc";
+#    if __GLIBC_PREREQ(2, 33)
+    struct mallinfo2 info = mallinfo2();
+#    else
+    //The fields of mallinfo overflow above 2 GiB
+    struct mallinfo info = mallinfo();
+#    endif
+    stats.allocated = size_t(info.uordblks) + size_t(info.hblkhd);
+    stats.mapped = size_t(info.arena) + size_t(info.hblkhd);
+#endif
+
+    return stats;
+}
+
 } // namespace vtr
@@ -7,6 +7,20 @@ namespace vtr {
 //Returns the maximum resident set size in bytes,
 //or zero if unable to determine.
 size_t get_max_rss();
+
+//Returns the current resident set size in bytes,
+//or zero if unable to determine.
+size_t get_current_rss();
+
+//Statistics of the memory allocator which serves malloc()
+//(see VTR_MALLOC in the top-level CMakeLists.txt)
+struct t_malloc_stats {
+    const char* allocator = "unknown"; //Name of the allocator
+    size_t allocated = 0;              //Bytes allocated by the program and not freed yet, zero if unknown
+    size_t mapped = 0;                 //Bytes obtained from the system by the allocator, zero if unknown
+};
+
+t_malloc_stats get_malloc_stats();
 } // namespace vtr
 
 #endif
@@ -0,0 +1,141 @@
+#include <cstring>
+#include <limits>
+
+#include "vtr_assert.h"
+#include "vtr_string_pool.h"
+
+namespace vtr {
+
+//Number of slots of the hash table of an empty pool
+constexpr size_t MIN_TABLE_SIZE = 16;
+
+StringPool::StringPool()
+    : arena_(4 * 1024)
+    , table_(MIN_TABLE_SIZE, StringId::INVALID()) {
+    intern(std::string());
+    VTR_ASSERT(valid_id(empty_string_id()));
+}
+
+StringPool::StringPool(const StringPool& other)
+    : StringPool() {
+    *this = other;
+}
+
+StringPool& StringPool::operator=(const StringPool& other) {
+    if (this != &other) {
+        clear();
+        for (const StringId& id : other.strings_.keys()) {
+            intern(other.c_str(id), other.length(id));
+        }
+    }
+    return *this;
+}
+
+StringId StringPool::find(const std::string& str) const {
+    return find(str.data(), str.size());
+}
+
+StringId StringPool::find(const char* str, size_t length) const {
+    return table_[find_slot(str, length, hash(str, length))];
+}
+
+const char* StringPool::c_str(StringId id) const {
+    VTR_ASSERT_SAFE(valid_id(id));
+    return strings_[id];
+}
+
+size_t StringPool::length(StringId id) const {
+    VTR_ASSERT_SAFE(valid_id(id));
+    return lengths_[id];
+}
+
+std::string StringPool::str(StringId id) const {
+    VTR_ASSERT_SAFE(valid_id(id));
+    return std::string(strings_[id], lengths_[id]);
+}
+
+size_t StringPool::memory_usage() const {
+    return sizeof(StringPool)
+           + arena_.bytes_reserved()
+           + strings_.capacity() * sizeof(const char*)
+           + lengths_.capacity() * sizeof(uint32_t)
+           + table_.capacity() * sizeof(StringId);
+}
+
+StringId StringPool::intern(const std::string& str) {
+    return intern(str.data(), str.size());
+}
+
+StringId StringPool::intern(const char* str, size_t length) {
+    VTR_ASSERT(length <= std::numeric_limits<uint32_t>::max());
+
+    size_t str_hash = hash(str, length);
+    size_t slot = find_slot(str, length, str_hash);
+    if (table_[slot]) {
+        return table_[slot];
+    }
+
+    //Keep the load factor of the hash table at most 1/2
+    if (2 * (size() + 1) > table_.size()) {
+        grow_table();
+        slot = find_slot(str, length, str_hash);
+    }
+
+    char* chars = arena_.allocate_array<char>(length + 1);
+    std::memcpy(chars, str, length);
+    chars[length] = '\0';
+
+    StringId id(size());
+    strings_.push_back(chars);
+    lengths_.push_back(uint32_t(length));
+    table_[slot] = id;
+
+    return id;
+}
+
+void StringPool::clear() {
+    arena_.release();
+    strings_.clear();
+    lengths_.clear();
+    table_.assign(MIN_TABLE_SIZE, StringId::INVALID());
+
+    intern(std::string());
+}
+
+//FNV-1a, which does not need a std::string to be built
+size_t StringPool::hash(const char* str, size_t length) {
+    uint64_t str_hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        str_hash ^= static_cast<unsigned char>(str[i]);
+        str_hash *= 1099511628211ULL;
+    }
+    return size_t(str_hash);
+}
+
+size_t StringPool::find_slot(const char* str, size_t length, size_t str_hash) const {
+    size_t mask = table_.size() - 1;
+    size_t slot = str_hash & mask;
+    //Linear probing: the table is never full, so an empty slot is always found
+    while (table_[slot]) {
+        StringId id = table_[slot];
+        if (lengths_[id] == length && 0 == std::memcmp(strings_[id], str, length)) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void StringPool::grow_table() {
+    table_.assign(2 * table_.size(), StringId::INVALID());
+    size_t mask = table_.size() - 1;
+    for (const StringId& id : strings_.keys()) {
+        size_t slot = hash(strings_[id], lengths_[id]) & mask;
+        while (table_[slot]) {
+            slot = (slot + 1) & mask;
+        }
+        table_[slot] = id;
+    }
+}
+
+} // namespace vtr
@@ -0,0 +1,91 @@
+#ifndef VTR_STRING_POOL_H
+#define VTR_STRING_POOL_H
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "vtr_arena.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+namespace vtr {
+
+struct string_pool_id_tag;
+typedef StrongId<string_pool_id_tag> StringId;
+
+//vtr::StringPool stores each unique string once and gives it a StringId.
+//
+//Data structures holding many copies of a few names (e.g. net names) can
+//store the ids instead of the strings: an id is 4 bytes, copying it never
+//allocates, and two ids of the same pool are equal if and only if their
+//strings are equal.
+//
+//The characters are stored in an Arena, so interning a string costs no heap
+//allocation of its own, and the whole pool is freed at once by clear().
+//The empty string is always in the pool, with the id empty_string_id().
+//
+//The const member functions do not modify the pool,
+//so they can be called concurrently.
+class StringPool {
+  public:
+    StringPool();
+
+    //Copying a pool interns the strings again, in the same order,
+    //so the ids of the copy are the same as the ids of the original
+    StringPool(const StringPool& other);
+    StringPool& operator=(const StringPool& other);
+    StringPool(StringPool&& other) = default;
+    StringPool& operator=(StringPool&& other) = default;
+
+  public: //Accessors
+    static StringId empty_string_id() { return StringId(0); }
+
+    //Number of unique strings in the pool
+    size_t size() const { return lengths_.size(); }
+
+    bool valid_id(StringId id) const { return size_t(id) < size(); }
+
+    //Returns the id of a string or StringId::INVALID() if it is not in the pool
+    StringId find(const std::string& str) const;
+    StringId find(const char* str, size_t length) const;
+
+    //The characters of a string, which stay valid until the pool is cleared
+    const char* c_str(StringId id) const;
+    size_t length(StringId id) const;
+    std::string str(StringId id) const;
+
+    //Size of the pool plus the heap memory reserved by it
+    size_t memory_usage() const;
+
+  public: //Mutators
+    //Returns the id of a string, adding the string to the pool if not found
+    StringId intern(const std::string& str);
+    StringId intern(const char* str, size_t length);
+
+    //Removes all the strings but the empty string, invalidating their ids
+    void clear();
+
+  private:
+    static size_t hash(const char* str, size_t length);
+
+    //Returns the slot of the hash table holding a string, or the empty slot where it should be inserted
+    size_t find_slot(const char* str, size_t length, size_t str_hash) const;
+
+    //Doubles the number of slots of the hash table
+    void grow_table();
+
+  private:
+    Arena arena_;
+
+    //Null-terminated characters and length of each string
+    vtr::vector<StringId, const char*> strings_;
+    vtr::vector<StringId, uint32_t> lengths_;
+
+    //Open-addressing hash table of the ids, whose size is a power of 2
+    std::vector<StringId> table_;
+};
+
+} // namespace vtr
+
+#endif
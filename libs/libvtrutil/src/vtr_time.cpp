@@ -5,7 +5,7 @@
 
 namespace vtr {
 
-int f_timer_depth = 0;
+thread_local int f_timer_depth = 0;
 
 Timer::Timer()
     : start_(clock::now())
@@ -0,0 +1,165 @@
+#include "vtr_trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "vtr_log.h"
+
+namespace vtr {
+
+namespace {
+
+struct t_trace_span {
+    std::string name;
+    int64_t start_us;
+    int64_t end_us;
+};
+
+//Spans of one thread. Each thread only appends to its own buffer, the mutex
+//only contends with write_trace()
+struct t_thread_trace {
+    int tid;
+    std::mutex mutex;
+    std::vector<t_trace_span> spans;
+};
+
+struct t_trace_registry {
+    std::mutex mutex;
+    std::string trace_file;
+    bool registered_at_exit = false;
+    std::vector<std::shared_ptr<t_thread_trace>> threads;
+};
+
+//Intentionally leaked, so that the spans are still available when the trace
+//is written at exit
+t_trace_registry& trace_registry() {
+    static t_trace_registry* registry = new t_trace_registry();
+    return *registry;
+}
+
+std::atomic<bool> f_tracing(false);
+
+const std::chrono::steady_clock::time_point f_trace_epoch = std::chrono::steady_clock::now();
+
+t_thread_trace& thread_trace() {
+    thread_local std::shared_ptr<t_thread_trace> trace;
+    if (!trace) {
+        t_trace_registry& registry = trace_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        trace = std::make_shared<t_thread_trace>();
+        trace->tid = registry.threads.size();
+        registry.threads.push_back(trace);
+    }
+    return *trace;
+}
+
+void write_json_string(FILE* fp, const std::string& str) {
+    fputc('"', fp);
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            fputc('\\', fp);
+            fputc(c, fp);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fprintf(fp, "\\u%04x", c);
+        } else {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+void write_trace_at_exit() {
+    write_trace();
+}
+
+} // namespace
+
+void start_tracing(const std::string& trace_file) {
+    t_trace_registry& registry = trace_registry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.trace_file = trace_file;
+        if (!registry.registered_at_exit) {
+            std::atexit(write_trace_at_exit);
+            registry.registered_at_exit = true;
+        }
+    }
+#ifndef VTR_ENABLE_TRACING
+    VTR_LOG_WARN("Tracing is not compiled in (VTR_ENABLE_TRACING), '%s' will only contain the spans recorded explicitly\n",
+                 trace_file.c_str());
+#endif
+    f_tracing = true;
+}
+
+bool is_tracing() {
+    return f_tracing;
+}
+
+void write_trace() {
+    t_trace_registry& registry = trace_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (registry.trace_file.empty()) {
+        return;
+    }
+
+    FILE* fp = fopen(registry.trace_file.c_str(), "w");
+    if (!fp) {
+        VTR_LOG_WARN("Failed to open trace file '%s' for writing\n", registry.trace_file.c_str());
+        return;
+    }
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+    bool first = true;
+    for (const std::shared_ptr<t_thread_trace>& thread : registry.threads) {
+        std::lock_guard<std::mutex> thread_lock(thread->mutex);
+        for (const t_trace_span& span : thread->spans) {
+            if (!first) {
+                fprintf(fp, ",\n");
+            }
+            first = false;
+            fprintf(fp, "{\"name\":");
+            write_json_string(fp, span.name);
+            fprintf(fp, ",\"ph\":\"X\",\"ts\":%lld,\"dur\":%lld,\"pid\":0,\"tid\":%d}",
+                    static_cast<long long>(span.start_us),
+                    static_cast<long long>(span.end_us - span.start_us),
+                    thread->tid);
+        }
+    }
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    fclose(fp);
+}
+
+int64_t trace_time_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - f_trace_epoch).count();
+}
+
+void record_trace_span(const std::string& name, int64_t start_us, int64_t end_us) {
+    if (!f_tracing) {
+        return;
+    }
+    t_thread_trace& trace = thread_trace();
+    std::lock_guard<std::mutex> lock(trace.mutex);
+    trace.spans.push_back({name, start_us, end_us});
+}
+
+ScopedTraceSpan::ScopedTraceSpan(std::string name)
+    : name_(std::move(name))
+    , start_us_(0)
+    , active_(f_tracing) {
+    if (active_) {
+        start_us_ = trace_time_us();
+    }
+}
+
+ScopedTraceSpan::~ScopedTraceSpan() {
+    if (active_) {
+        record_trace_span(name_, start_us_, trace_time_us());
+    }
+}
+
+} // namespace vtr
@@ -0,0 +1,73 @@
+#ifndef VTR_TRACE_H
+#define VTR_TRACE_H
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+//Records the spans of time taken by the hot spots of the flow (e.g. each
+//router iteration) and writes them as a Chrome trace (JSON) file, which can be
+//loaded in chrome://tracing or https://ui.perfetto.dev
+//
+//Tracing is only compiled in when VTR_ENABLE_TRACING is defined (cmake option
+//VTR_ENABLE_TRACING), otherwise VTR_TRACE_SPAN() expands to nothing. When
+//compiled in, spans are only recorded once vtr::start_tracing() is called.
+//
+//For example:
+//
+//      vtr::start_tracing("vpr.trace.json");
+//      ...
+//      {
+//          VTR_TRACE_SPAN("route iteration " + std::to_string(itry));
+//
+//          //Do other work
+//
+//          //The span ends when out of scope
+//      }
+
+#ifdef VTR_ENABLE_TRACING
+#    define VTR_TRACE_CONCAT_IMPL(a, b) a##b
+#    define VTR_TRACE_CONCAT(a, b) VTR_TRACE_CONCAT_IMPL(a, b)
+#    define VTR_TRACE_SPAN(name) vtr::ScopedTraceSpan VTR_TRACE_CONCAT(trace_span_, __LINE__)((vtr::is_tracing()) ? std::string(name) : std::string())
+#else
+//No-op version which avoids unused variable warnings, sizeof is evaluated at
+//compile time so there is no run-time overhead
+#    define VTR_TRACE_SPAN(name) static_cast<void>(sizeof(name))
+#endif
+
+namespace vtr {
+
+//Starts recording the spans, which are written to trace_file on write_trace()
+//or, at the latest, when the program exits
+void start_tracing(const std::string& trace_file);
+
+//Returns true if the spans are recorded
+bool is_tracing();
+
+//Writes all the spans recorded so far to the trace file
+void write_trace();
+
+//Returns the time, in microseconds, used to record spans
+int64_t trace_time_us();
+
+//Records a span of the calling thread, e.g. for spans which cannot be scoped
+void record_trace_span(const std::string& name, int64_t start_us, int64_t end_us);
+
+//Records a span for the calling thread from its construction to its destruction
+class ScopedTraceSpan {
+  public:
+    ScopedTraceSpan(std::string name);
+    ~ScopedTraceSpan();
+
+    //No copy
+    ScopedTraceSpan(ScopedTraceSpan&) = delete;
+    ScopedTraceSpan& operator=(ScopedTraceSpan&) = delete;
+
+  private:
+    std::string name_;
+    int64_t start_us_;
+    bool active_;
+};
+
+} // namespace vtr
+
+#endif
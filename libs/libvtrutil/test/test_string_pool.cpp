@@ -0,0 +1,83 @@
+#include "catch.hpp"
+
+#include "vtr_arena.h"
+#include "vtr_string_pool.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+TEST_CASE("Arena", "[vtr_arena]") {
+    vtr::Arena arena(1024);
+
+    //Allocations are aligned and do not overlap
+    std::vector<double*> values;
+    for (size_t i = 0; i < 1000; ++i) {
+        char* c = arena.allocate_array<char>(1);
+        *c = 'a';
+        double* d = arena.allocate_array<double>(1);
+        REQUIRE(reinterpret_cast<uintptr_t>(d) % alignof(double) == 0);
+        *d = double(i);
+        values.push_back(d);
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(*values[i] == double(i));
+    }
+
+    //Large allocations get their own block
+    char* large = arena.allocate_array<char>(4096);
+    large[4095] = 'b';
+    REQUIRE(arena.bytes_reserved() >= arena.bytes_allocated());
+
+    arena.release();
+    REQUIRE(arena.bytes_allocated() == 0);
+    REQUIRE(arena.bytes_reserved() == 0);
+}
+
+TEST_CASE("Arena allocator", "[vtr_arena]") {
+    vtr::Arena arena;
+    std::vector<int, vtr::ArenaAllocator<int>> vec{vtr::ArenaAllocator<int>(arena)};
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        REQUIRE(vec[i] == i);
+    }
+    REQUIRE(arena.bytes_allocated() >= 1000 * sizeof(int));
+}
+
+TEST_CASE("String pool", "[vtr_string_pool]") {
+    vtr::StringPool pool;
+    REQUIRE(pool.size() == 1);
+    REQUIRE(pool.find("") == vtr::StringPool::empty_string_id());
+
+    std::vector<vtr::StringId> ids;
+    for (size_t i = 0; i < 1000; ++i) {
+        ids.push_back(pool.intern("net_" + std::to_string(i)));
+    }
+    REQUIRE(pool.size() == 1001);
+
+    //Interning a string again gives the same id
+    for (size_t i = 0; i < 1000; ++i) {
+        std::string name = "net_" + std::to_string(i);
+        REQUIRE(pool.intern(name) == ids[i]);
+        REQUIRE(pool.find(name) == ids[i]);
+        REQUIRE(pool.str(ids[i]) == name);
+        REQUIRE(std::string(pool.c_str(ids[i])) == name);
+        REQUIRE(pool.length(ids[i]) == name.size());
+    }
+    REQUIRE(pool.size() == 1001);
+    REQUIRE(pool.find("net_1000") == vtr::StringId::INVALID());
+
+    //Copies have the same ids
+    vtr::StringPool copy(pool);
+    REQUIRE(copy.size() == pool.size());
+    for (size_t i = 0; i < 1000; ++i) {
+        REQUIRE(copy.str(ids[i]) == pool.str(ids[i]));
+    }
+
+    pool.clear();
+    REQUIRE(pool.size() == 1);
+    REQUIRE(pool.find("net_0") == vtr::StringId::INVALID());
+    REQUIRE(copy.find("net_0") == ids[0]);
+}
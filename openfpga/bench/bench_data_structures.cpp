@@ -0,0 +1,234 @@
+/********************************************************************
+ * This file includes the benchmarks of the core data structures:
+ * the module graph, the bitstream databases and the multiplexer graphs
+ *******************************************************************/
+#include <memory>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_port.h"
+
+#include "circuit_library.h"
+#include "mux_graph.h"
+#include "fabric_bitstream_utils.h"
+#include "bench_synthetic_fabric.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Results of the benchmarks are accumulated here,
+ * so that the compiler can not skip the operations measured
+ */
+static volatile size_t f_bench_checksum = 0;
+
+/********************************************************************
+ * Create the nets of the top-level module of a synthetic fabric
+ *******************************************************************/
+static
+t_bench_case create_module_manager_build_nets_benchmark(const t_bench_options& options) {
+  std::shared_ptr<ModuleManager> module_manager = std::make_shared<ModuleManager>();
+  std::shared_ptr<ModuleId> top_module = std::make_shared<ModuleId>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    *top_module = build_bench_fabric_instances(*module_manager, options);
+  };
+  bench_case.run = [=]() {
+    return build_bench_fabric_nets(*module_manager, *top_module, options);
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Visit all the sources and sinks of the nets of the top-level module,
+ * as the netlist writers do
+ *******************************************************************/
+static
+t_bench_case create_module_manager_iterate_nets_benchmark(const t_bench_options& options) {
+  std::shared_ptr<ModuleManager> module_manager = std::make_shared<ModuleManager>();
+  std::shared_ptr<ModuleId> top_module = std::make_shared<ModuleId>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    *top_module = build_bench_fabric_instances(*module_manager, options);
+    build_bench_fabric_nets(*module_manager, *top_module, options);
+  };
+  bench_case.run = [=]() {
+    size_t num_terminals = 0;
+    size_t checksum = 0;
+    for (const ModuleNetId& net : module_manager->module_nets(*top_module)) {
+      for (const ModuleNetSrcId& src : module_manager->module_net_sources(*top_module, net)) {
+        checksum += module_manager->net_source_instance(*top_module, net, src);
+        checksum += module_manager->net_source_pin(*top_module, net, src);
+        num_terminals++;
+      }
+      for (const ModuleNetSinkId& sink : module_manager->module_net_sinks(*top_module, net)) {
+        checksum += module_manager->net_sink_instance(*top_module, net, sink);
+        checksum += module_manager->net_sink_pin(*top_module, net, sink);
+        num_terminals++;
+      }
+    }
+    f_bench_checksum += checksum;
+    return num_terminals;
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Add the configuration bits of a synthetic fabric
+ *******************************************************************/
+static
+t_bench_case create_bitstream_manager_add_bits_benchmark(const t_bench_options& options) {
+  std::shared_ptr<BitstreamManager> bitstream_manager = std::make_shared<BitstreamManager>();
+
+  t_bench_case bench_case;
+  bench_case.setup = []() {};
+  bench_case.run = [=]() {
+    return build_bench_bitstream(*bitstream_manager, options);
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Read the configuration bits of a synthetic fabric block by block,
+ * as the bitstream writers do
+ *******************************************************************/
+static
+t_bench_case create_bitstream_manager_read_bits_benchmark(const t_bench_options& options) {
+  std::shared_ptr<BitstreamManager> bitstream_manager = std::make_shared<BitstreamManager>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    build_bench_bitstream(*bitstream_manager, options);
+  };
+  bench_case.run = [=]() {
+    size_t num_bits = 0;
+    size_t checksum = 0;
+    for (const ConfigBlockId& block : bitstream_manager->blocks()) {
+      for (const bool& bit_value : bitstream_manager->block_bit_values(block)) {
+        checksum += bit_value;
+        num_bits++;
+      }
+    }
+    f_bench_checksum += checksum;
+    return num_bits;
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Group the bits of a fabric bitstream by their addresses
+ * for the frame-based configuration protocol
+ *******************************************************************/
+static
+t_bench_case create_fabric_bitstream_frame_groups_benchmark(const t_bench_options& options) {
+  std::shared_ptr<BitstreamManager> bitstream_manager = std::make_shared<BitstreamManager>();
+  std::shared_ptr<FabricBitstream> fabric_bitstream = std::make_shared<FabricBitstream>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    build_bench_bitstream(*bitstream_manager, options);
+    build_bench_frame_fabric_bitstream(*fabric_bitstream, *bitstream_manager, options);
+  };
+  bench_case.run = [=]() {
+    FrameFabricBitstream fabric_bits_by_addr = build_frame_based_fabric_bitstream_by_address(*fabric_bitstream);
+    f_bench_checksum += fabric_bits_by_addr.size();
+    return fabric_bitstream->num_bits();
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Group the bits of a fabric bitstream by their addresses
+ * for the memory bank configuration protocol
+ *******************************************************************/
+static
+t_bench_case create_fabric_bitstream_memory_bank_groups_benchmark(const t_bench_options& options) {
+  std::shared_ptr<BitstreamManager> bitstream_manager = std::make_shared<BitstreamManager>();
+  std::shared_ptr<FabricBitstream> fabric_bitstream = std::make_shared<FabricBitstream>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    build_bench_bitstream(*bitstream_manager, options);
+    build_bench_memory_bank_fabric_bitstream(*fabric_bitstream, *bitstream_manager, options);
+  };
+  bench_case.run = [=]() {
+    MemoryBankFabricBitstream fabric_bits_by_addr = build_memory_bank_fabric_bitstream_by_address(*fabric_bitstream);
+    f_bench_checksum += fabric_bits_by_addr.size();
+    return fabric_bitstream->num_bits();
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Decode the memory bits of the routing multiplexers of a synthetic
+ * fabric, where each tile has a multiplexer for each track,
+ * whose size is the channel width
+ *******************************************************************/
+static
+t_bench_case create_mux_graph_decode_benchmark(const t_bench_options& options,
+                                               const e_circuit_model_structure& mux_structure) {
+  std::shared_ptr<CircuitLibrary> circuit_lib = std::make_shared<CircuitLibrary>();
+  std::shared_ptr<MuxGraph> mux_graph = std::make_shared<MuxGraph>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    CircuitModelId pass_gate_model = circuit_lib->add_model(CIRCUIT_MODEL_PASSGATE);
+    circuit_lib->set_model_name(pass_gate_model, std::string("bench_tgate"));
+
+    CircuitModelId mux_model = circuit_lib->add_model(CIRCUIT_MODEL_MUX);
+    circuit_lib->set_model_name(mux_model, std::string("bench_mux"));
+    circuit_lib->set_model_pass_gate_logic(mux_model, std::string("bench_tgate"));
+    circuit_lib->set_mux_structure(mux_model, mux_structure);
+    if (CIRCUIT_MODEL_STRUCTURE_MULTILEVEL == mux_structure) {
+      circuit_lib->set_mux_num_levels(mux_model, 2);
+    }
+    circuit_lib->build_model_links();
+
+    *mux_graph = MuxGraph(*circuit_lib, mux_model, std::max(size_t(2), options.chan_width));
+  };
+  bench_case.run = [=]() {
+    size_t num_decodes = 0;
+    size_t checksum = 0;
+    size_t num_muxes = options.fabric_size * options.fabric_size * options.chan_width;
+    for (size_t imux = 0; imux < num_muxes; ++imux) {
+      MuxInputId input = MuxInputId(imux % mux_graph->num_inputs());
+      vtr::vector<MuxMemId, bool> mem_bits = mux_graph->decode_memory_bits(input, MuxOutputId(0));
+      checksum += mem_bits.size();
+      num_decodes++;
+    }
+    f_bench_checksum += checksum;
+    return num_decodes;
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Register the benchmarks of the core data structures
+ *******************************************************************/
+void add_data_structure_benchmarks(std::vector<t_benchmark>& benchmarks) {
+  benchmarks.push_back({"module_manager_build_nets", true, "nets",
+                        create_module_manager_build_nets_benchmark});
+  benchmarks.push_back({"module_manager_iterate_nets", false, "terminals",
+                        create_module_manager_iterate_nets_benchmark});
+  benchmarks.push_back({"bitstream_manager_add_bits", true, "bits",
+                        create_bitstream_manager_add_bits_benchmark});
+  benchmarks.push_back({"bitstream_manager_read_bits", false, "bits",
+                        create_bitstream_manager_read_bits_benchmark});
+  benchmarks.push_back({"fabric_bitstream_frame_address_groups", false, "bits",
+                        create_fabric_bitstream_frame_groups_benchmark});
+  benchmarks.push_back({"fabric_bitstream_memory_bank_address_groups", false, "bits",
+                        create_fabric_bitstream_memory_bank_groups_benchmark});
+  benchmarks.push_back({"mux_graph_decode_memory_bits_tree", false, "decodes",
+                        [](const t_bench_options& options) {
+                          return create_mux_graph_decode_benchmark(options, CIRCUIT_MODEL_STRUCTURE_TREE);
+                        }});
+  benchmarks.push_back({"mux_graph_decode_memory_bits_multilevel", false, "decodes",
+                        [](const t_bench_options& options) {
+                          return create_mux_graph_decode_benchmark(options, CIRCUIT_MODEL_STRUCTURE_MULTILEVEL);
+                        }});
+}
+
+} /* end namespace openfpga */
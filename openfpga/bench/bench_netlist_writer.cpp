@@ -0,0 +1,67 @@
+/********************************************************************
+ * This file includes the benchmarks of the netlist writers
+ *******************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "verilog_module_writer.h"
+#include "bench_synthetic_fabric.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* The netlists are written to this file, which is removed after each run */
+constexpr const char* BENCH_VERILOG_FILE_NAME = "openfpga_bench_netlist.v";
+
+/********************************************************************
+ * Write the Verilog netlists of the tile and the top-level modules
+ * of a synthetic fabric
+ * The throughput is reported in bytes written
+ *******************************************************************/
+static
+t_bench_case create_verilog_write_module_benchmark(const t_bench_options& options) {
+  std::shared_ptr<ModuleManager> module_manager = std::make_shared<ModuleManager>();
+  std::shared_ptr<ModuleId> top_module = std::make_shared<ModuleId>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    *top_module = build_bench_fabric_instances(*module_manager, options);
+    build_bench_fabric_nets(*module_manager, *top_module, options);
+  };
+  bench_case.run = [=]() {
+    std::fstream fp;
+    fp.open(BENCH_VERILOG_FILE_NAME, std::fstream::out | std::fstream::trunc);
+    check_file_stream(BENCH_VERILOG_FILE_NAME, fp);
+
+    for (const char* module_name : {"bench_lut", "bench_tile"}) {
+      ModuleId module = module_manager->find_module(module_name);
+      VTR_ASSERT(true == module_manager->valid_module_id(module));
+      write_verilog_module_to_file(fp, *module_manager, module, true, VERILOG_DEFAULT_NET_TYPE_NONE);
+    }
+    write_verilog_module_to_file(fp, *module_manager, *top_module, true, VERILOG_DEFAULT_NET_TYPE_NONE);
+
+    size_t num_bytes = fp.tellp();
+    fp.close();
+    std::remove(BENCH_VERILOG_FILE_NAME);
+
+    return num_bytes;
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Register the benchmarks of the netlist writers
+ *******************************************************************/
+void add_netlist_writer_benchmarks(std::vector<t_benchmark>& benchmarks) {
+  benchmarks.push_back({"verilog_write_module", true, "bytes",
+                        create_verilog_write_module_benchmark});
+}
+
+} /* end namespace openfpga */
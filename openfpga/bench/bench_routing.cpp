@@ -0,0 +1,407 @@
+/********************************************************************
+ * This file includes the benchmarks of the routing data structures:
+ * the identification of unique routing modules of a device
+ * and the routing inside logic blocks for repacking
+ *******************************************************************/
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+
+/* Headers from vpr library */
+#include "atom_netlist.h"
+#include "rr_graph_obj.h"
+
+#include "device_rr_gsb.h"
+#include "lb_router.h"
+#include "openfpga_bench.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Create a routing track of unit length in the channel at (x, y)
+ * Even tracks are in increasing direction and odd tracks are
+ * in decreasing direction, as in a unidirectional routing architecture
+ *******************************************************************/
+static
+RRNodeId create_bench_track(RRGraph& rr_graph,
+                            const t_rr_type& chan_type,
+                            const size_t& x, const size_t& y,
+                            const size_t& track_id,
+                            const RRSegmentId& segment) {
+  RRNodeId node = rr_graph.create_node(chan_type);
+  rr_graph.set_node_xlow(node, x);
+  rr_graph.set_node_ylow(node, y);
+  rr_graph.set_node_xhigh(node, x);
+  rr_graph.set_node_yhigh(node, y);
+  rr_graph.set_node_direction(node, (0 == track_id % 2) ? INC_DIRECTION : DEC_DIRECTION);
+  rr_graph.set_node_track_num(node, track_id);
+  rr_graph.set_node_capacity(node, 1);
+  rr_graph.set_node_segment(node, segment);
+  return node;
+}
+
+/********************************************************************
+ * Create the input pins of a connection block at one side of a GSB,
+ * each of which is driven by a quarter of the routing tracks
+ *******************************************************************/
+static
+void add_bench_cb_ipins(RRGraph& rr_graph,
+                        RRGSB& rr_gsb,
+                        const e_side& ipin_side,
+                        const RRChan& rr_chan,
+                        const RRSwitchId& switch_id,
+                        const size_t& pattern,
+                        const t_bench_options& options) {
+  size_t num_ipins = std::max(size_t(1), options.chan_width / 4);
+  for (size_t ipin = 0; ipin < num_ipins; ++ipin) {
+    RRNodeId node = rr_graph.create_node(IPIN);
+    rr_graph.set_node_xlow(node, rr_gsb.get_x());
+    rr_graph.set_node_ylow(node, rr_gsb.get_y());
+    rr_graph.set_node_xhigh(node, rr_gsb.get_x());
+    rr_graph.set_node_yhigh(node, rr_gsb.get_y());
+    rr_graph.set_node_pin_num(node, ipin);
+    rr_graph.set_node_capacity(node, 1);
+    rr_graph.set_node_side(node, ipin_side);
+
+    for (size_t itrack = 0; itrack < rr_chan.get_chan_width(); ++itrack) {
+      if (0 == (itrack + ipin + pattern) % 4) {
+        rr_graph.create_edge(rr_chan.get_node(itrack), node, switch_id);
+      }
+    }
+
+    rr_gsb.add_ipin_node(node, ipin_side);
+  }
+}
+
+/********************************************************************
+ * Build the routing resource graph and the GSBs of a synthetic fabric
+ * The GSB at (x, y) contains the switch block at (x, y),
+ * the X-direction connection block at (x, y) and
+ * the Y-direction connection block at (x, y + 1).
+ *
+ * Each routing track of a switch block is driven by one track from
+ * each of the other sides. Most of the GSBs follow the same pattern,
+ * so that there are a few unique modules as in a real fabric,
+ * while a random fraction of GSBs rotate the pattern
+ *******************************************************************/
+static
+void build_bench_rr_gsbs(RRGraph& rr_graph,
+                         DeviceRRGSB& device_rr_gsb,
+                         const t_bench_options& options) {
+  std::mt19937 rng(options.seed);
+
+  size_t size = options.fabric_size;
+
+  RRSwitchId switch_id = rr_graph.create_switch(t_rr_switch_inf());
+  RRSegmentId segment = rr_graph.create_segment(t_segment_inf());
+
+  /* X-direction channels are at x = [1, size] and y = [0, size]
+   * Y-direction channels are at x = [0, size] and y = [1, size]
+   */
+  std::vector<std::vector<RRChan>> chanx(size + 1, std::vector<RRChan>(size + 1));
+  std::vector<std::vector<RRChan>> chany(size + 1, std::vector<RRChan>(size + 1));
+  for (size_t ix = 0; ix < size + 1; ++ix) {
+    for (size_t iy = 0; iy < size + 1; ++iy) {
+      chanx[ix][iy].set_type(CHANX);
+      chany[ix][iy].set_type(CHANY);
+      for (size_t itrack = 0; itrack < options.chan_width; ++itrack) {
+        if (0 < ix) {
+          chanx[ix][iy].add_node(rr_graph, create_bench_track(rr_graph, CHANX, ix, iy, itrack, segment), segment);
+        }
+        if (0 < iy) {
+          chany[ix][iy].add_node(rr_graph, create_bench_track(rr_graph, CHANY, ix, iy, itrack, segment), segment);
+        }
+      }
+    }
+  }
+
+  device_rr_gsb.reserve(vtr::Point<size_t>(size + 1, size + 1));
+
+  for (size_t ix = 0; ix < size + 1; ++ix) {
+    for (size_t iy = 0; iy < size + 1; ++iy) {
+      RRGSB rr_gsb;
+      rr_gsb.set_coordinate(ix, iy);
+      rr_gsb.init_num_sides(4);
+
+      size_t pattern = (0 == rng() % 8) ? 1 + rng() % 3 : 0;
+
+      /* Fill the routing tracks of each side, where the tracks in
+       * increasing direction leave the GSB at TOP and RIGHT sides
+       */
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        vtr::Point<size_t> coordinate = rr_gsb.get_side_block_coordinate(side_manager.get_side());
+        bool exist = false;
+        const RRChan* rr_chan = nullptr;
+        enum PORTS inc_port_dir = OUT_PORT;
+        switch (side_manager.get_side()) {
+        case TOP:
+          exist = (iy < size);
+          rr_chan = exist ? &(chany[coordinate.x()][coordinate.y()]) : nullptr;
+          break;
+        case RIGHT:
+          exist = (ix < size);
+          rr_chan = exist ? &(chanx[coordinate.x()][coordinate.y()]) : nullptr;
+          break;
+        case BOTTOM:
+          exist = (0 < iy);
+          rr_chan = exist ? &(chany[coordinate.x()][coordinate.y()]) : nullptr;
+          inc_port_dir = IN_PORT;
+          break;
+        case LEFT:
+          exist = (0 < ix);
+          rr_chan = exist ? &(chanx[coordinate.x()][coordinate.y()]) : nullptr;
+          inc_port_dir = IN_PORT;
+          break;
+        default:
+          VTR_ASSERT_MSG(false, "Invalid side");
+        }
+
+        if (false == exist) {
+          rr_gsb.clear_one_side(side_manager.get_side());
+          continue;
+        }
+
+        std::vector<enum PORTS> rr_chan_dir(rr_chan->get_chan_width());
+        for (size_t itrack = 0; itrack < rr_chan->get_chan_width(); ++itrack) {
+          if (INC_DIRECTION == rr_graph.node_direction(rr_chan->get_node(itrack))) {
+            rr_chan_dir[itrack] = inc_port_dir;
+          } else {
+            rr_chan_dir[itrack] = (OUT_PORT == inc_port_dir) ? IN_PORT : OUT_PORT;
+          }
+        }
+        rr_gsb.add_chan_node(side_manager.get_side(), *rr_chan, rr_chan_dir);
+      }
+
+      /* Connect the switch block */
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        std::vector<RRNodeId> out_tracks;
+        for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+          if (OUT_PORT == rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) {
+            out_tracks.push_back(rr_gsb.get_chan_node(side_manager.get_side(), itrack));
+          }
+        }
+        for (size_t from_side = 0; from_side < rr_gsb.get_num_sides(); ++from_side) {
+          if (from_side == side) {
+            continue;
+          }
+          SideManager from_side_manager(from_side);
+          std::vector<RRNodeId> in_tracks;
+          for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(from_side_manager.get_side()); ++itrack) {
+            if (IN_PORT == rr_gsb.get_chan_node_direction(from_side_manager.get_side(), itrack)) {
+              in_tracks.push_back(rr_gsb.get_chan_node(from_side_manager.get_side(), itrack));
+            }
+          }
+          if (true == in_tracks.empty()) {
+            continue;
+          }
+          for (size_t iout = 0; iout < out_tracks.size(); ++iout) {
+            RRNodeId in_track = in_tracks[(iout + pattern + from_side) % in_tracks.size()];
+            rr_graph.create_edge(in_track, out_tracks[iout], switch_id);
+          }
+        }
+      }
+
+      /* Connect the connection blocks */
+      if (0 < rr_gsb.get_chan_width(LEFT)) {
+        for (const e_side& ipin_side : rr_gsb.get_cb_ipin_sides(CHANX)) {
+          add_bench_cb_ipins(rr_graph, rr_gsb, ipin_side, chanx[ix][iy], switch_id, pattern, options);
+        }
+      }
+      if (0 < rr_gsb.get_chan_width(TOP)) {
+        for (const e_side& ipin_side : rr_gsb.get_cb_ipin_sides(CHANY)) {
+          add_bench_cb_ipins(rr_graph, rr_gsb, ipin_side, chany[ix][iy + 1], switch_id, pattern, options);
+        }
+      }
+
+      device_rr_gsb.add_rr_gsb(vtr::Point<size_t>(ix, iy), std::move(rr_gsb));
+    }
+  }
+  device_rr_gsb.share_chan_nodes();
+
+  rr_graph.rebuild_node_edges();
+}
+
+/********************************************************************
+ * Identify the unique switch blocks, connection blocks and GSBs
+ * of a synthetic fabric
+ *******************************************************************/
+static
+t_bench_case create_device_rr_gsb_unique_module_benchmark(const t_bench_options& options) {
+  std::shared_ptr<RRGraph> rr_graph = std::make_shared<RRGraph>();
+  std::shared_ptr<DeviceRRGSB> device_rr_gsb = std::make_shared<DeviceRRGSB>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    build_bench_rr_gsbs(*rr_graph, *device_rr_gsb, options);
+  };
+  bench_case.run = [=]() {
+    device_rr_gsb->build_unique_module(*rr_graph, options.num_threads);
+    return (options.fabric_size + 1) * (options.fabric_size + 1);
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Data of the logic block routing benchmark
+ * The atom netlist only provides the nets and pins required by the
+ * router. Its model is owned here, as the netlist points to it
+ *******************************************************************/
+struct t_lb_router_bench_data {
+  LbRRGraph lb_rr_graph;
+  std::vector<LbRRNodeId> source_nodes;
+  std::vector<LbRRNodeId> sink_nodes;
+
+  std::string model_name = "bench_lb";
+  std::string input_port_name = "in";
+  std::string output_port_name = "out";
+  t_model model;
+  t_model_ports input_port;
+  t_model_ports output_port;
+
+  AtomNetlist atom_nlist;
+  std::vector<AtomNetId> atom_nets;
+  std::vector<AtomPinId> atom_source_pins;
+  std::vector<AtomPinId> atom_sink_pins;
+
+  /* Sink node of each net in each logic block */
+  std::vector<std::vector<size_t>> net_sinks;
+
+  std::unique_ptr<LbRouter> lb_router;
+};
+
+/********************************************************************
+ * Build the routing resource graph of a logic block, where the inputs
+ * reach the LUT inputs through two stages of full crossbars:
+ *
+ *   SOURCE -> input pin -> crossbar -> middle -> crossbar -> LUT input -> SINK
+ *
+ * The middle nodes have random costs, so that the nets compete for
+ * the cheapest ones and the router has to resolve the congestion
+ *******************************************************************/
+static
+void build_bench_lb_router_data(t_lb_router_bench_data& data,
+                                const t_bench_options& options) {
+  std::mt19937 rng(options.seed);
+  std::uniform_real_distribution<float> cost_distribution(1., 2.);
+
+  size_t num_pins = std::max(size_t(2), options.chan_width);
+
+  std::vector<LbRRNodeId> input_nodes;
+  std::vector<LbRRNodeId> middle_nodes;
+  std::vector<LbRRNodeId> lut_input_nodes;
+  for (size_t ipin = 0; ipin < num_pins; ++ipin) {
+    LbRRNodeId source = data.lb_rr_graph.create_node(LB_SOURCE);
+    data.lb_rr_graph.set_node_capacity(source, 1);
+    data.source_nodes.push_back(source);
+
+    LbRRNodeId sink = data.lb_rr_graph.create_node(LB_SINK);
+    data.lb_rr_graph.set_node_capacity(sink, 1);
+    data.sink_nodes.push_back(sink);
+
+    for (std::vector<LbRRNodeId>* nodes : {&input_nodes, &middle_nodes, &lut_input_nodes}) {
+      LbRRNodeId node = data.lb_rr_graph.create_node(LB_INTERMEDIATE);
+      data.lb_rr_graph.set_node_capacity(node, 1);
+      data.lb_rr_graph.set_node_intrinsic_cost(node, (nodes == &middle_nodes) ? cost_distribution(rng) : 1.);
+      nodes->push_back(node);
+    }
+  }
+
+  for (size_t ipin = 0; ipin < num_pins; ++ipin) {
+    data.lb_rr_graph.create_edge(data.source_nodes[ipin], input_nodes[ipin], nullptr);
+    data.lb_rr_graph.create_edge(lut_input_nodes[ipin], data.sink_nodes[ipin], nullptr);
+    for (size_t jpin = 0; jpin < num_pins; ++jpin) {
+      data.lb_rr_graph.create_edge(input_nodes[ipin], middle_nodes[jpin], nullptr);
+      data.lb_rr_graph.create_edge(middle_nodes[ipin], lut_input_nodes[jpin], nullptr);
+    }
+  }
+  for (const LbRREdgeId& edge : data.lb_rr_graph.edges()) {
+    data.lb_rr_graph.set_edge_intrinsic_cost(edge, 1.);
+  }
+
+  /* Atom netlist: a driver block and a sink block connected by the nets */
+  data.model.name = &(data.model_name[0]);
+  data.input_port.name = &(data.input_port_name[0]);
+  data.input_port.dir = IN_PORT;
+  data.input_port.size = num_pins;
+  data.output_port.name = &(data.output_port_name[0]);
+  data.output_port.dir = OUT_PORT;
+  data.output_port.size = num_pins;
+  data.model.inputs = &(data.input_port);
+  data.model.outputs = &(data.output_port);
+
+  AtomBlockId driver_block = data.atom_nlist.create_block("bench_driver", &(data.model));
+  AtomPortId driver_port = data.atom_nlist.create_port(driver_block, &(data.output_port));
+  AtomBlockId sink_block = data.atom_nlist.create_block("bench_sink", &(data.model));
+  AtomPortId sink_port = data.atom_nlist.create_port(sink_block, &(data.input_port));
+  for (size_t ipin = 0; ipin < num_pins; ++ipin) {
+    AtomNetId net = data.atom_nlist.create_net("bench_net_" + std::to_string(ipin));
+    data.atom_nets.push_back(net);
+    data.atom_source_pins.push_back(data.atom_nlist.create_pin(driver_port, ipin, net, PinType::DRIVER));
+    data.atom_sink_pins.push_back(data.atom_nlist.create_pin(sink_port, ipin, net, PinType::SINK));
+  }
+
+  /* Each logic block of the fabric connects the nets to a random permutation of the LUT inputs */
+  data.net_sinks.resize(options.fabric_size * options.fabric_size);
+  for (std::vector<size_t>& net_sinks : data.net_sinks) {
+    net_sinks.resize(num_pins);
+    std::iota(net_sinks.begin(), net_sinks.end(), 0);
+    std::shuffle(net_sinks.begin(), net_sinks.end(), rng);
+  }
+
+  data.lb_router.reset(new LbRouter(data.lb_rr_graph, nullptr));
+}
+
+/********************************************************************
+ * Route all the logic blocks of a synthetic fabric, reusing a router
+ * as the repacker does
+ *******************************************************************/
+static
+t_bench_case create_lb_router_try_route_benchmark(const t_bench_options& options) {
+  std::shared_ptr<t_lb_router_bench_data> data = std::make_shared<t_lb_router_bench_data>();
+
+  t_bench_case bench_case;
+  bench_case.setup = [=]() {
+    build_bench_lb_router_data(*data, options);
+  };
+  bench_case.run = [=]() {
+    size_t num_routed_nets = 0;
+    for (const std::vector<size_t>& net_sinks : data->net_sinks) {
+      data->lb_router->reset(data->lb_rr_graph, nullptr);
+      for (size_t inet = 0; inet < net_sinks.size(); ++inet) {
+        LbRouter::NetId net = data->lb_router->create_net_to_route({data->source_nodes[inet]},
+                                                                   {data->sink_nodes[net_sinks[inet]]});
+        data->lb_router->add_net_atom_net_id(net, data->atom_nets[inet]);
+        data->lb_router->add_net_atom_pins(net, data->atom_source_pins[inet], {data->atom_sink_pins[inet]});
+      }
+      data->lb_router->set_physical_pb_modes(data->lb_rr_graph, VprDeviceAnnotation());
+      bool route_success = data->lb_router->try_route(data->lb_rr_graph, data->atom_nlist, false);
+      VTR_ASSERT(true == route_success);
+      num_routed_nets += net_sinks.size();
+    }
+    return num_routed_nets;
+  };
+  return bench_case;
+}
+
+/********************************************************************
+ * Register the benchmarks of the routing data structures
+ *******************************************************************/
+void add_routing_benchmarks(std::vector<t_benchmark>& benchmarks) {
+  benchmarks.push_back({"device_rr_gsb_build_unique_module", true, "gsbs",
+                        create_device_rr_gsb_unique_module_benchmark});
+  benchmarks.push_back({"lb_router_try_route", false, "nets",
+                        create_lb_router_try_route_benchmark});
+}
+
+} /* end namespace openfpga */
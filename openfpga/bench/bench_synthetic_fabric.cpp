@@ -0,0 +1,268 @@
+/********************************************************************
+ * This file includes functions to build the synthetic fabrics
+ * which the benchmarks run against.
+ *
+ * A synthetic fabric is an array of tiles, where each tile contains
+ * a number of 4-input LUTs and a number of configuration bits:
+ *
+ *   in[0:W-1] -> +------+      +------+      +------+ -> out[0:W-1]
+ *                | tile | ---> | tile | ---> | tile |
+ *                | [0]  |      | [1]  |      | [2]  |
+ *                +------+      +------+      +------+
+ *
+ * The outputs of a tile drive the inputs of the tile on its right,
+ * through a random permutation of the pins. The tiles of the first
+ * column are driven by the inputs of the top-level module,
+ * and the tiles of the last column drive its outputs.
+ * All the random choices come from the seed of the options,
+ * so that a fabric can be built again for another measurement
+ *******************************************************************/
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_decode.h"
+
+#include "decoder_library_utils.h"
+#include "bench_synthetic_fabric.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of inputs of the LUTs in the tiles */
+constexpr size_t BENCH_LUT_SIZE = 4;
+
+/********************************************************************
+ * Build a tile module, whose LUT inputs are driven by the tile inputs
+ * and whose outputs are driven by the LUT outputs
+ *******************************************************************/
+static
+ModuleId build_bench_tile_module(ModuleManager& module_manager,
+                                 const t_bench_options& options) {
+  ModuleId lut_module = module_manager.add_module("bench_lut");
+  ModulePortId lut_in = module_manager.add_port(lut_module, BasicPort("in", BENCH_LUT_SIZE), ModuleManager::MODULE_INPUT_PORT);
+  ModulePortId lut_out = module_manager.add_port(lut_module, BasicPort("out", 1), ModuleManager::MODULE_OUTPUT_PORT);
+
+  ModuleId tile_module = module_manager.add_module("bench_tile");
+  ModulePortId tile_in = module_manager.add_port(tile_module, BasicPort("in", options.chan_width), ModuleManager::MODULE_INPUT_PORT);
+  ModulePortId tile_out = module_manager.add_port(tile_module, BasicPort("out", options.chan_width), ModuleManager::MODULE_OUTPUT_PORT);
+
+  for (size_t ilut = 0; ilut < options.chan_width; ++ilut) {
+    module_manager.add_child_module(tile_module, lut_module);
+  }
+
+  module_manager.reserve_module_nets(tile_module, 2 * options.chan_width);
+  for (size_t ipin = 0; ipin < options.chan_width; ++ipin) {
+    ModuleNetId net = module_manager.create_module_net(tile_module);
+    module_manager.add_module_net_source(tile_module, net, tile_module, 0, tile_in, ipin);
+    for (size_t ilut_pin = 0; ilut_pin < BENCH_LUT_SIZE; ++ilut_pin) {
+      module_manager.add_module_net_sink(tile_module, net, lut_module, (ipin + ilut_pin) % options.chan_width, lut_in, ilut_pin);
+    }
+  }
+  for (size_t ilut = 0; ilut < options.chan_width; ++ilut) {
+    ModuleNetId net = module_manager.create_module_net(tile_module);
+    module_manager.add_module_net_source(tile_module, net, lut_module, ilut, lut_out, 0);
+    module_manager.add_module_net_sink(tile_module, net, tile_module, 0, tile_out, ilut);
+  }
+
+  return tile_module;
+}
+
+/********************************************************************
+ * Build the modules of a synthetic fabric and
+ * instanciate the tiles in the top-level module, without any net
+ *******************************************************************/
+ModuleId build_bench_fabric_instances(ModuleManager& module_manager,
+                                      const t_bench_options& options) {
+  ModuleId tile_module = build_bench_tile_module(module_manager, options);
+
+  ModuleId top_module = module_manager.add_module("bench_top");
+  module_manager.add_port(top_module, BasicPort("in", options.fabric_size * options.chan_width), ModuleManager::MODULE_INPUT_PORT);
+  module_manager.add_port(top_module, BasicPort("out", options.fabric_size * options.chan_width), ModuleManager::MODULE_OUTPUT_PORT);
+
+  for (size_t ix = 0; ix < options.fabric_size; ++ix) {
+    for (size_t iy = 0; iy < options.fabric_size; ++iy) {
+      size_t instance = module_manager.num_instance(top_module, tile_module);
+      module_manager.add_child_module(top_module, tile_module);
+      module_manager.set_child_instance_coordinate_name(top_module, tile_module, instance,
+                                                        std::string("tile"), vtr::Point<size_t>(ix, iy));
+    }
+  }
+
+  return top_module;
+}
+
+/********************************************************************
+ * Connect the tiles of a synthetic fabric in the top-level module
+ * Return the number of nets created
+ *******************************************************************/
+size_t build_bench_fabric_nets(ModuleManager& module_manager,
+                               const ModuleId& top_module,
+                               const t_bench_options& options) {
+  ModuleId tile_module = module_manager.find_module("bench_tile");
+  VTR_ASSERT(true == module_manager.valid_module_id(tile_module));
+  ModulePortId tile_in = module_manager.find_module_port(tile_module, "in");
+  ModulePortId tile_out = module_manager.find_module_port(tile_module, "out");
+  ModulePortId top_in = module_manager.find_module_port(top_module, "in");
+  ModulePortId top_out = module_manager.find_module_port(top_module, "out");
+
+  std::mt19937 rng(options.seed);
+  std::vector<size_t> pin_permutation(options.chan_width);
+  std::iota(pin_permutation.begin(), pin_permutation.end(), 0);
+
+  size_t num_nets = (options.fabric_size + 1) * options.fabric_size * options.chan_width;
+  module_manager.reserve_module_nets(top_module, num_nets);
+
+  /* Tiles are instanciated column by column */
+  for (size_t ix = 0; ix <= options.fabric_size; ++ix) {
+    for (size_t iy = 0; iy < options.fabric_size; ++iy) {
+      std::shuffle(pin_permutation.begin(), pin_permutation.end(), rng);
+      for (size_t ipin = 0; ipin < options.chan_width; ++ipin) {
+        ModuleNetId net = module_manager.create_module_net(top_module);
+        if (0 == ix) {
+          module_manager.add_module_net_source(top_module, net, top_module, 0, top_in, iy * options.chan_width + ipin);
+        } else {
+          module_manager.add_module_net_source(top_module, net, tile_module, (ix - 1) * options.fabric_size + iy, tile_out, ipin);
+        }
+        if (options.fabric_size == ix) {
+          module_manager.add_module_net_sink(top_module, net, top_module, 0, top_out, iy * options.chan_width + pin_permutation[ipin]);
+        } else {
+          module_manager.add_module_net_sink(top_module, net, tile_module, ix * options.fabric_size + iy, tile_in, pin_permutation[ipin]);
+        }
+      }
+    }
+  }
+
+  return num_nets;
+}
+
+/********************************************************************
+ * Build the bitstream of a synthetic fabric with random bits,
+ * where each tile has a block of configuration bits
+ * Return the number of bits
+ *******************************************************************/
+size_t build_bench_bitstream(BitstreamManager& bitstream_manager,
+                             const t_bench_options& options) {
+  std::mt19937 rng(options.seed);
+  std::bernoulli_distribution bit_dist(0.5);
+
+  size_t num_tiles = options.fabric_size * options.fabric_size;
+  bitstream_manager.reserve_blocks(num_tiles + 1);
+  bitstream_manager.reserve_bits(num_tiles * options.num_tile_bits);
+
+  ConfigBlockId top_block = bitstream_manager.add_block("bench_top");
+  bitstream_manager.reserve_child_blocks(top_block, num_tiles);
+
+  std::vector<bool> tile_bits(options.num_tile_bits);
+  for (size_t ix = 0; ix < options.fabric_size; ++ix) {
+    for (size_t iy = 0; iy < options.fabric_size; ++iy) {
+      ConfigBlockId tile_block = bitstream_manager.add_block(std::string("tile_") + std::to_string(ix) + std::string("__") + std::to_string(iy) + std::string("_"));
+      bitstream_manager.add_child_block(top_block, tile_block);
+      for (size_t ibit = 0; ibit < options.num_tile_bits; ++ibit) {
+        tile_bits[ibit] = bit_dist(rng);
+      }
+      bitstream_manager.add_block_bits(tile_block, tile_bits);
+    }
+  }
+
+  return bitstream_manager.num_bits();
+}
+
+/********************************************************************
+ * Build the fabric bitstream of a synthetic fabric for the frame-based
+ * configuration protocol, where each column of tiles is a region,
+ * so that the bits at the same row and index share the same address
+ * across regions:
+ *   <row address> <bit address>
+ *******************************************************************/
+void build_bench_frame_fabric_bitstream(FabricBitstream& fabric_bitstream,
+                                        const BitstreamManager& bitstream_manager,
+                                        const t_bench_options& options) {
+  size_t row_addr_size = find_mux_local_decoder_addr_size(options.fabric_size);
+  size_t bit_addr_size = find_mux_local_decoder_addr_size(options.num_tile_bits);
+
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_address_length(row_addr_size + bit_addr_size);
+  fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+  fabric_bitstream.reserve_regions(options.fabric_size);
+
+  std::vector<ConfigBlockId> tile_blocks = bitstream_manager.block_children(ConfigBlockId(0));
+  VTR_ASSERT(tile_blocks.size() == options.fabric_size * options.fabric_size);
+
+  std::vector<char> address;
+  for (size_t ix = 0; ix < options.fabric_size; ++ix) {
+    FabricBitRegionId region = fabric_bitstream.add_region();
+    for (size_t iy = 0; iy < options.fabric_size; ++iy) {
+      const ConfigBlockId& tile_block = tile_blocks[ix * options.fabric_size + iy];
+      std::vector<char> row_addr = itobin_charvec(iy, row_addr_size);
+      std::vector<ConfigBitId> tile_bits = bitstream_manager.block_bits(tile_block);
+      for (size_t ibit = 0; ibit < tile_bits.size(); ++ibit) {
+        address = row_addr;
+        std::vector<char> bit_addr = itobin_charvec(ibit, bit_addr_size);
+        address.insert(address.end(), bit_addr.begin(), bit_addr.end());
+
+        FabricBitId fabric_bit = fabric_bitstream.add_bit(tile_bits[ibit]);
+        fabric_bitstream.set_bit_address(fabric_bit, address);
+        fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(tile_bits[ibit]));
+        fabric_bitstream.add_bit_to_region(region, fabric_bit);
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Build the fabric bitstream of a synthetic fabric for the memory bank
+ * configuration protocol, where each column of tiles is a region.
+ * The bits of each tile are organized in an array of bit lines
+ * and word lines, so that the bits at the same row and position
+ * in the array share the same addresses across regions:
+ *   BL address: <row address> <bit line address>
+ *   WL address: <row address and word line address>
+ *******************************************************************/
+void build_bench_memory_bank_fabric_bitstream(FabricBitstream& fabric_bitstream,
+                                              const BitstreamManager& bitstream_manager,
+                                              const t_bench_options& options) {
+  size_t num_bls = find_memory_decoder_data_size(options.num_tile_bits);
+  size_t num_wls = (options.num_tile_bits + num_bls - 1) / num_bls;
+  size_t row_addr_size = find_mux_local_decoder_addr_size(options.fabric_size);
+  size_t bl_addr_size = find_mux_local_decoder_addr_size(num_bls);
+  size_t wl_addr_size = row_addr_size + find_mux_local_decoder_addr_size(num_wls);
+
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_use_wl_address(true);
+  fabric_bitstream.set_bl_address_length(row_addr_size + bl_addr_size);
+  fabric_bitstream.set_wl_address_length(wl_addr_size);
+  fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
+  fabric_bitstream.reserve_regions(options.fabric_size);
+
+  std::vector<ConfigBlockId> tile_blocks = bitstream_manager.block_children(ConfigBlockId(0));
+  VTR_ASSERT(tile_blocks.size() == options.fabric_size * options.fabric_size);
+
+  std::vector<char> bl_address;
+  for (size_t ix = 0; ix < options.fabric_size; ++ix) {
+    FabricBitRegionId region = fabric_bitstream.add_region();
+    for (size_t iy = 0; iy < options.fabric_size; ++iy) {
+      const ConfigBlockId& tile_block = tile_blocks[ix * options.fabric_size + iy];
+      std::vector<char> row_addr = itobin_charvec(iy, row_addr_size);
+      std::vector<ConfigBitId> tile_bits = bitstream_manager.block_bits(tile_block);
+      for (size_t ibit = 0; ibit < tile_bits.size(); ++ibit) {
+        bl_address = row_addr;
+        std::vector<char> bl_addr = itobin_charvec(ibit % num_bls, bl_addr_size);
+        bl_address.insert(bl_address.end(), bl_addr.begin(), bl_addr.end());
+        std::vector<char> wl_address = itobin_charvec(iy * num_wls + ibit / num_bls, wl_addr_size);
+
+        FabricBitId fabric_bit = fabric_bitstream.add_bit(tile_bits[ibit]);
+        fabric_bitstream.set_bit_bl_address(fabric_bit, bl_address);
+        fabric_bitstream.set_bit_wl_address(fabric_bit, wl_address);
+        fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(tile_bits[ibit]));
+        fabric_bitstream.add_bit_to_region(region, fabric_bit);
+      }
+    }
+  }
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,39 @@
+#ifndef BENCH_SYNTHETIC_FABRIC_H
+#define BENCH_SYNTHETIC_FABRIC_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "module_manager.h"
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "openfpga_bench.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+ModuleId build_bench_fabric_instances(ModuleManager& module_manager,
+                                      const t_bench_options& options);
+
+size_t build_bench_fabric_nets(ModuleManager& module_manager,
+                               const ModuleId& top_module,
+                               const t_bench_options& options);
+
+size_t build_bench_bitstream(BitstreamManager& bitstream_manager,
+                             const t_bench_options& options);
+
+void build_bench_frame_fabric_bitstream(FabricBitstream& fabric_bitstream,
+                                        const BitstreamManager& bitstream_manager,
+                                        const t_bench_options& options);
+
+void build_bench_memory_bank_fabric_bitstream(FabricBitstream& fabric_bitstream,
+                                              const BitstreamManager& bitstream_manager,
+                                              const t_bench_options& options);
+
+} /* end namespace openfpga */
+
+#endif
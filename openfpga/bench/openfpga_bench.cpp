@@ -0,0 +1,269 @@
+/********************************************************************
+ * Run the micro and macro benchmarks of the OpenFPGA data structures
+ * on synthetic fabrics, so that the performance of the hot operations
+ * can be tracked across changes without any architecture file.
+ *
+ * Each benchmark is repeated a number of times on a fabric built from
+ * scratch. The minimum and the median of the run times are reported,
+ * as well as the throughput and the increase of the peak memory.
+ *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+/* Header file from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+#include "vtr_log.h"
+
+/* Header file from libopenfpgashell library */
+#include "command_parser.h"
+#include "command_echo.h"
+
+/* Header file from libopenfpgautil library */
+#include "openfpga_digest.h"
+
+#include "openfpga_bench.h"
+
+/* Measurements of a benchmark over its repeats */
+struct t_bench_result {
+  std::string name;
+  size_t num_items = 0;
+  std::vector<float> run_times;
+  float delta_max_rss_mib = 0.;
+};
+
+/********************************************************************
+ * Find the median of a list of run times
+ *******************************************************************/
+static
+float find_median_run_time(std::vector<float> run_times) {
+  std::sort(run_times.begin(), run_times.end());
+  size_t mid = run_times.size() / 2;
+  if (0 == run_times.size() % 2) {
+    return (run_times[mid - 1] + run_times[mid]) / 2;
+  }
+  return run_times[mid];
+}
+
+/********************************************************************
+ * Run a benchmark a number of times, each of which on new data
+ *******************************************************************/
+static
+t_bench_result run_benchmark(const openfpga::t_benchmark& benchmark,
+                             const openfpga::t_bench_options& options,
+                             const size_t& num_repeats) {
+  t_bench_result result;
+  result.name = benchmark.name;
+
+  for (size_t irepeat = 0; irepeat < num_repeats; ++irepeat) {
+    openfpga::t_bench_case bench_case = benchmark.create(options);
+    bench_case.setup();
+
+    vtr::Timer timer;
+    result.num_items = bench_case.run();
+    result.run_times.push_back(timer.elapsed_sec());
+    result.delta_max_rss_mib = std::max(result.delta_max_rss_mib, timer.delta_max_rss_mib());
+  }
+
+  return result;
+}
+
+/********************************************************************
+ * Write the results to a JSON file, so that they can be compared
+ * between builds by scripts
+ *******************************************************************/
+static
+int write_bench_results_to_json(const char* fname,
+                                const openfpga::t_bench_options& options,
+                                const std::vector<openfpga::t_benchmark>& benchmarks,
+                                const std::vector<t_bench_result>& results) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (false == openfpga::valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Fail to open the output file '%s'!\n", fname);
+    return 1;
+  }
+
+  fp << "{\n";
+  fp << "  \"options\": {";
+  fp << "\"fabric_size\": " << options.fabric_size << ", ";
+  fp << "\"chan_width\": " << options.chan_width << ", ";
+  fp << "\"num_tile_bits\": " << options.num_tile_bits << ", ";
+  fp << "\"seed\": " << options.seed << ", ";
+  fp << "\"threads\": " << options.num_threads << "},\n";
+  fp << "  \"benchmarks\": [\n";
+  for (size_t ibench = 0; ibench < results.size(); ++ibench) {
+    const t_bench_result& result = results[ibench];
+    auto benchmark = std::find_if(benchmarks.begin(), benchmarks.end(),
+                                  [&](const openfpga::t_benchmark& bench) { return bench.name == result.name; });
+    VTR_ASSERT(benchmark != benchmarks.end());
+    float min_time = *std::min_element(result.run_times.begin(), result.run_times.end());
+    fp << "    {\"name\": \"" << result.name << "\", ";
+    fp << "\"macro\": " << (benchmark->macro ? "true" : "false") << ", ";
+    fp << "\"items\": " << result.num_items << ", ";
+    fp << "\"item_unit\": \"" << benchmark->item_unit << "\", ";
+    fp << "\"min_sec\": " << min_time << ", ";
+    fp << "\"median_sec\": " << find_median_run_time(result.run_times) << ", ";
+    fp << "\"delta_max_rss_mib\": " << result.delta_max_rss_mib << "}";
+    fp << ((ibench + 1 < results.size()) ? ",\n" : "\n");
+  }
+  fp << "  ]\n";
+  fp << "}\n";
+
+  fp.close();
+
+  return 0;
+}
+
+/********************************************************************
+ * Parse a positive integer option, or return false
+ *******************************************************************/
+static
+bool parse_bench_size_option(const openfpga::Command& cmd,
+                             const openfpga::CommandContext& cmd_context,
+                             const openfpga::CommandOptionId& opt,
+                             const bool& allow_zero,
+                             size_t& value) {
+  if (false == cmd_context.option_enable(cmd, opt)) {
+    return true;
+  }
+  int int_value = std::atoi(cmd_context.option_value(cmd, opt).c_str());
+  if ( (0 > int_value) || ((0 == int_value) && (false == allow_zero)) ) {
+    VTR_LOG_ERROR("Invalid value '%s' of option '%s'!\n",
+                  cmd_context.option_value(cmd, opt).c_str(),
+                  cmd.option_name(opt).c_str());
+    return false;
+  }
+  value = int_value;
+  return true;
+}
+
+/********************************************************************
+ * Main function of the benchmarks
+ *******************************************************************/
+int main(int argc, char** argv) {
+  openfpga::Command bench_cmd("openfpga_bench");
+
+  openfpga::CommandOptionId opt_fabric_size = bench_cmd.add_option("fabric_size", false, "Width and height of the synthetic fabrics in number of tiles. By default, it is 10");
+  bench_cmd.set_option_require_value(opt_fabric_size, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_chan_width = bench_cmd.add_option("chan_width", false, "Number of routing tracks per channel of the synthetic fabrics. By default, it is 20");
+  bench_cmd.set_option_require_value(opt_chan_width, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_num_tile_bits = bench_cmd.add_option("num_tile_bits", false, "Number of configuration bits per tile of the synthetic fabrics. By default, it is 64");
+  bench_cmd.set_option_require_value(opt_num_tile_bits, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_seed = bench_cmd.add_option("seed", false, "Seed of the random generator of the synthetic fabrics. By default, it is 1");
+  bench_cmd.set_option_require_value(opt_seed, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_threads = bench_cmd.add_option("threads", false, "Number of threads of the benchmarks using multiple threads. Use 0 for all the cores of the machine. By default, it is 1");
+  bench_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_repeat = bench_cmd.add_option("repeat", false, "Number of runs of each benchmark. By default, it is 5");
+  bench_cmd.set_option_require_value(opt_repeat, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_filter = bench_cmd.add_option("filter", false, "Only run the benchmarks whose names contain the given string");
+  bench_cmd.set_option_require_value(opt_filter, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_macro = bench_cmd.add_option("macro_only", false, "Only run the macro benchmarks, which measure full building steps");
+  openfpga::CommandOptionId opt_micro = bench_cmd.add_option("micro_only", false, "Only run the micro benchmarks, which measure single operations");
+
+  openfpga::CommandOptionId opt_list = bench_cmd.add_option("list", false, "List the benchmarks without running them");
+
+  openfpga::CommandOptionId opt_json = bench_cmd.add_option("json", false, "Write the results to a JSON file");
+  bench_cmd.set_option_require_value(opt_json, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_help = bench_cmd.add_option("help", false, "Help desk");
+  bench_cmd.set_option_short_name(opt_help, "h");
+
+  std::vector<std::string> cmd_opts;
+  cmd_opts.push_back(bench_cmd.name());
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    cmd_opts.push_back(std::string(argv[iarg]));
+  }
+
+  openfpga::CommandContext bench_cmd_context(bench_cmd);
+  if (false == parse_command(cmd_opts, bench_cmd, bench_cmd_context)) {
+    openfpga::print_command_options(bench_cmd);
+    return 1;
+  }
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_help)) {
+    openfpga::print_command_options(bench_cmd);
+    return 0;
+  }
+
+  openfpga::t_bench_options options;
+  size_t seed = options.seed;
+  size_t num_repeats = 5;
+  if ( (false == parse_bench_size_option(bench_cmd, bench_cmd_context, opt_fabric_size, false, options.fabric_size))
+    || (false == parse_bench_size_option(bench_cmd, bench_cmd_context, opt_chan_width, false, options.chan_width))
+    || (false == parse_bench_size_option(bench_cmd, bench_cmd_context, opt_num_tile_bits, false, options.num_tile_bits))
+    || (false == parse_bench_size_option(bench_cmd, bench_cmd_context, opt_seed, true, seed))
+    || (false == parse_bench_size_option(bench_cmd, bench_cmd_context, opt_threads, true, options.num_threads))
+    || (false == parse_bench_size_option(bench_cmd, bench_cmd_context, opt_repeat, false, num_repeats)) ) {
+    return 1;
+  }
+  options.seed = seed;
+
+  std::vector<openfpga::t_benchmark> benchmarks;
+  openfpga::add_data_structure_benchmarks(benchmarks);
+  openfpga::add_routing_benchmarks(benchmarks);
+  openfpga::add_netlist_writer_benchmarks(benchmarks);
+
+  /* Select the benchmarks to run */
+  std::vector<openfpga::t_benchmark> selected_benchmarks;
+  for (const openfpga::t_benchmark& benchmark : benchmarks) {
+    if ( (true == bench_cmd_context.option_enable(bench_cmd, opt_filter))
+      && (std::string::npos == benchmark.name.find(bench_cmd_context.option_value(bench_cmd, opt_filter))) ) {
+      continue;
+    }
+    if ( (true == bench_cmd_context.option_enable(bench_cmd, opt_macro))
+      && (false == benchmark.macro) ) {
+      continue;
+    }
+    if ( (true == bench_cmd_context.option_enable(bench_cmd, opt_micro))
+      && (true == benchmark.macro) ) {
+      continue;
+    }
+    selected_benchmarks.push_back(benchmark);
+  }
+
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_list)) {
+    for (const openfpga::t_benchmark& benchmark : selected_benchmarks) {
+      VTR_LOG("%s (%s, in %s)\n",
+              benchmark.name.c_str(),
+              benchmark.macro ? "macro" : "micro",
+              benchmark.item_unit.c_str());
+    }
+    return 0;
+  }
+
+  VTR_LOG("Synthetic fabric: %lux%lu tiles, channel width %lu, %lu bits per tile, seed %u\n",
+          options.fabric_size, options.fabric_size,
+          options.chan_width, options.num_tile_bits, options.seed);
+  VTR_LOG("%lu run(s) per benchmark\n\n", num_repeats);
+
+  VTR_LOG("%-45s %12s %12s %24s %12s\n",
+          "Benchmark", "Min (s)", "Median (s)", "Throughput (/s)", "dRSS (MiB)");
+  std::vector<t_bench_result> results;
+  for (const openfpga::t_benchmark& benchmark : selected_benchmarks) {
+    t_bench_result result = run_benchmark(benchmark, options, num_repeats);
+    float min_time = *std::min_element(result.run_times.begin(), result.run_times.end());
+    float median_time = find_median_run_time(result.run_times);
+    std::string throughput = (0. < median_time)
+                           ? std::to_string(size_t(result.num_items / median_time)) + " " + benchmark.item_unit
+                           : std::string("-");
+    VTR_LOG("%-45s %12.6f %12.6f %24s %12.1f\n",
+            result.name.c_str(), min_time, median_time,
+            throughput.c_str(), result.delta_max_rss_mib);
+    results.push_back(result);
+  }
+
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_json)) {
+    return write_bench_results_to_json(bench_cmd_context.option_value(bench_cmd, opt_json).c_str(),
+                                       options, selected_benchmarks, results);
+  }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+#ifndef OPENFPGA_BENCH_H
+#define OPENFPGA_BENCH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <functional>
+#include <string>
+#include <vector>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Options of the benchmarks, which define the synthetic fabrics
+ * The same options always generate the same fabrics,
+ * so that the results of different builds can be compared
+ *******************************************************************/
+struct t_bench_options {
+  /* Width and height of the synthetic fabrics, in number of tiles */
+  size_t fabric_size = 10;
+  /* Number of routing tracks per channel */
+  size_t chan_width = 20;
+  /* Number of configuration bits per tile */
+  size_t num_tile_bits = 64;
+  /* Seed of the random number generator of the synthetic fabrics */
+  unsigned int seed = 1;
+  /* Number of threads for the benchmarks which use multiple threads */
+  size_t num_threads = 1;
+};
+
+/********************************************************************
+ * A benchmark consists of a setup function, which builds the data
+ * which is not measured, and a run function which is measured.
+ * The run function returns the number of items processed,
+ * e.g., nets or bits, so that the throughput can be reported.
+ * Both functions share the data through the closure created by
+ * the factory of the benchmark
+ *******************************************************************/
+struct t_bench_case {
+  std::function<void()> setup;
+  std::function<size_t()> run;
+};
+
+struct t_benchmark {
+  std::string name;
+  /* A micro benchmark measures a single operation on prepared data,
+   * a macro benchmark measures a full building step of a fabric
+   */
+  bool macro;
+  /* Unit of the items processed by the benchmark */
+  std::string item_unit;
+  std::function<t_bench_case(const t_bench_options&)> create;
+};
+
+void add_data_structure_benchmarks(std::vector<t_benchmark>& benchmarks);
+
+void add_routing_benchmarks(std::vector<t_benchmark>& benchmarks);
+
+void add_netlist_writer_benchmarks(std::vector<t_benchmark>& benchmarks);
+
+} /* end namespace openfpga */
+
+#endif
@@ -21,6 +21,27 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Parse the content of a bitstream from the eblif file,
+ * which is organized as <.param|.attr> <identifier string>
+ * Return false if the content is not in the format
+ *******************************************************************/
+static 
+bool parse_eblif_bitstream_content(const std::string& content,
+                                   const size_t& offset,
+                                   VprBitstreamAnnotation::t_eblif_bitstream& eblif_bitstream) {
+  StringToken tokenizer(content);
+  std::vector<std::string> tokens = tokenizer.split(" ");
+  if ( (2 != tokens.size())
+    || ((std::string(".param") != tokens[0]) && (std::string(".attr") != tokens[0])) ) {
+    return false;
+  }
+  eblif_bitstream.is_attr = (std::string(".attr") == tokens[0]);
+  eblif_bitstream.identifier = tokens[1];
+  eblif_bitstream.offset = offset;
+  return true;
+}
+
 /********************************************************************
  * Annotate bitstream setting based on VPR device information
  *  - Find the pb_type and link to the bitstream source
@@ -70,6 +91,17 @@ int annotate_bitstream_pb_type_setting(const BitstreamSetting& bitstream_setting
         return CMD_EXEC_FATAL_ERROR;
       }
 
+      /* The content is parsed here rather than for each primitive in repack */
+      VprBitstreamAnnotation::t_eblif_bitstream eblif_bitstream;
+      if (false == parse_eblif_bitstream_content(bitstream_setting.pb_type_bitstream_content(bitstream_pb_type_setting_id),
+                                                 bitstream_setting.bitstream_offset(bitstream_pb_type_setting_id),
+                                                 eblif_bitstream)) {
+        VTR_LOG_ERROR("Invalid bitstream content '%s' for pb_type '%s' which is defined in bitstream setting (expect '<.param|.attr> <identifier>')\n",
+                      bitstream_setting.pb_type_bitstream_content(bitstream_pb_type_setting_id).c_str(),
+                      target_pb_type_names[0].c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+
       /* Depending on the bitstream type, annotate through different entrances
        * - For regular bitstream, set bitstream content, flags etc. 
        * - For mode-select bitstream, set mode-select bitstream content, flags etc. 
@@ -78,11 +110,13 @@ int annotate_bitstream_pb_type_setting(const BitstreamSetting& bitstream_setting
         vpr_bitstream_annotation.set_pb_type_bitstream_source(target_pb_type, VprBitstreamAnnotation::e_bitstream_source_type::BITSTREAM_SOURCE_EBLIF);
         vpr_bitstream_annotation.set_pb_type_bitstream_content(target_pb_type, bitstream_setting.pb_type_bitstream_content(bitstream_pb_type_setting_id));
         vpr_bitstream_annotation.set_pb_type_bitstream_offset(target_pb_type, bitstream_setting.bitstream_offset(bitstream_pb_type_setting_id));
+        vpr_bitstream_annotation.set_pb_type_eblif_bitstream(target_pb_type, eblif_bitstream);
       } else {
         VTR_ASSERT_SAFE(false == bitstream_setting.is_mode_select_bitstream(bitstream_pb_type_setting_id));
         vpr_bitstream_annotation.set_pb_type_mode_select_bitstream_source(target_pb_type, VprBitstreamAnnotation::e_bitstream_source_type::BITSTREAM_SOURCE_EBLIF);
         vpr_bitstream_annotation.set_pb_type_mode_select_bitstream_content(target_pb_type, bitstream_setting.pb_type_bitstream_content(bitstream_pb_type_setting_id));
         vpr_bitstream_annotation.set_pb_type_mode_select_bitstream_offset(target_pb_type, bitstream_setting.bitstream_offset(bitstream_pb_type_setting_id));
+        vpr_bitstream_annotation.set_pb_type_mode_select_eblif_bitstream(target_pb_type, eblif_bitstream);
       }
 
       link_success = true;
@@ -2,6 +2,8 @@
  * This file includes functions that are used to annotate pb_graph_node
  * and pb_graph_pins from VPR to OpenFPGA
  *******************************************************************/
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -297,21 +299,65 @@ void annotate_primitive_pb_graph_node_unique_index(const DeviceContext& vpr_devi
 }
 
 /********************************************************************
- * Evaluate if the two pb_graph pins are matched by
+ * The pins of a port of a physical pb_graph_node, and the position
+ * of the port in the order of the input, output and clock ports of the node
+ *******************************************************************/
+struct t_physical_pb_graph_port_pins {
+  t_pb_graph_pin* pins;
+  int num_pins;
+  size_t port_order;
+};
+
+/********************************************************************
+ * Index the pins of each port of a physical pb_graph_node by the port,
+ * so that the physical pin paired to an operating pin can be found
+ * by index arithmetic rather than by scanning all the physical pins 
+ *******************************************************************/
+static 
+std::unordered_map<const t_port*, t_physical_pb_graph_port_pins> build_physical_pb_graph_port_lookup(t_pb_graph_node* physical_pb_graph_node) {
+  std::unordered_map<const t_port*, t_physical_pb_graph_port_pins> port_lookup;
+  size_t port_order = 0;
+
+  auto add_ports = [&](t_pb_graph_pin** pins, int* num_pins, const int& num_ports) {
+    for (int iport = 0; iport < num_ports; ++iport) {
+      if (0 == num_pins[iport]) {
+        continue;
+      }
+      port_lookup[pins[iport][0].port] = t_physical_pb_graph_port_pins{pins[iport], num_pins[iport], port_order};
+      port_order++;
+    }
+  };
+  add_ports(physical_pb_graph_node->input_pins, physical_pb_graph_node->num_input_pins, physical_pb_graph_node->num_input_ports);
+  add_ports(physical_pb_graph_node->output_pins, physical_pb_graph_node->num_output_pins, physical_pb_graph_node->num_output_ports);
+  add_ports(physical_pb_graph_node->clock_pins, physical_pb_graph_node->num_clock_pins, physical_pb_graph_node->num_clock_ports);
+
+  return port_lookup;
+}
+
+/********************************************************************
+ * Find the physical pb_graph pin which is matched to an operating pb_graph pin by
  *  - pb_type port annotation 
  *  - LSB/MSB and pin offset
+ *
+ * When several physical pins are matched, the first one in the order
+ * of the input, output and clock ports of the physical pb_graph_node is selected
+ * Return a nullptr if no pin is matched
  *******************************************************************/
 static 
-bool try_match_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin, 
-                            t_pb_graph_pin* physical_pb_graph_pin,
-                            const VprDeviceAnnotation& vpr_device_annotation) {
-  /* If the parent ports of the two pins are not paired, fail */
+t_pb_graph_pin* find_physical_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin, 
+                                           const std::unordered_map<const t_port*, t_physical_pb_graph_port_pins>& physical_port_lookup,
+                                           const VprDeviceAnnotation& vpr_device_annotation) {
+  t_pb_graph_pin* physical_pb_graph_pin = nullptr;
+  size_t physical_port_order = 0;
+
+  /* Only the pins of the ports paired with the parent port of the operating pin can be matched */
   for (t_port* candidate_port : vpr_device_annotation.physical_pb_port(operating_pb_graph_pin->port)) {
-    if (physical_pb_graph_pin->port != candidate_port) {
-      /* Not the one we want, try the next candidate */
+    auto result = physical_port_lookup.find(candidate_port);
+    if (result == physical_port_lookup.end()) {
+      /* Not a port of the physical pb_graph_node, try the next candidate */
       continue;
     }
-    /* Check the pin number of physical pb_graph_pin matches the pin number of 
+    /* The pin number of physical pb_graph_pin should match the pin number of 
      * operating pb_graph_pin plus a rotation offset with an initial offset, 
      * which is to align the lsb between operating and physical ports
      *
@@ -336,20 +382,27 @@ bool try_match_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin,
     int acc_offset = vpr_device_annotation.physical_pb_pin_offset(operating_pb_graph_pin->port, candidate_port) + vpr_device_annotation.physical_pb_port_offset(operating_pb_graph_pin->port, candidate_port);
     int init_offset = vpr_device_annotation.physical_pb_pin_initial_offset(operating_pb_graph_pin->port, candidate_port);
     const BasicPort& physical_port_range = vpr_device_annotation.physical_pb_port_range(operating_pb_graph_pin->port, candidate_port);
-    if (physical_pb_graph_pin->pin_number != operating_pb_graph_pin->pin_number
-                                           + (int)physical_port_range.get_lsb() 
-                                           + init_offset
-                                           + acc_offset) {
+    int physical_pin_number = operating_pb_graph_pin->pin_number
+                            + (int)physical_port_range.get_lsb() 
+                            + init_offset
+                            + acc_offset;
+    if ( (0 > physical_pin_number) || (result->second.num_pins <= physical_pin_number) ) {
       /* Not the one we want, try the next candidate */
       continue;
     }
 
-    /* Reach here, it means all the requirements have been met */
-    return true;
+    /* Reach here, it means all the requirements have been met.
+     * Keep the first port of the physical pb_graph_node
+     */
+    if ( (nullptr == physical_pb_graph_pin)
+      || (result->second.port_order < physical_port_order) ) {
+      physical_pb_graph_pin = &(result->second.pins[physical_pin_number]);
+      physical_port_order = result->second.port_order;
+      VTR_ASSERT(physical_pin_number == physical_pb_graph_pin->pin_number);
+    }
   }
 
-  /* If we reach here, we failed */
-  return false;
+  return physical_pb_graph_pin;
 }
 
 /********************************************************************
@@ -378,69 +431,27 @@ void print_success_bind_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin,
 static 
 void annotate_physical_pb_graph_pin(t_pb_graph_pin* operating_pb_graph_pin, 
                                     t_pb_graph_node* physical_pb_graph_node, 
+                                    const std::unordered_map<const t_port*, t_physical_pb_graph_port_pins>& physical_port_lookup,
                                     VprDeviceAnnotation& vpr_device_annotation,
                                     const bool& verbose_output) {
-  /* Iterate over every port and pin of the operating pb_graph_node 
-   * and find the physical pins 
-   */
-  for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport]; ++ipin) {
-      if (false == try_match_pb_graph_pin(operating_pb_graph_pin, 
-                                          &(physical_pb_graph_node->input_pins[iport][ipin]),
-                                          vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation requirements 
-       * We can pair the pin and return  
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, &(physical_pb_graph_node->input_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
-      }
-      return;
-    }
-  }
-
-  for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
-      if (false == try_match_pb_graph_pin(operating_pb_graph_pin, 
-                                          &(physical_pb_graph_node->output_pins[iport][ipin]),
-                                          vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation requirements 
-       * We can pair the pin and return  
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, &(physical_pb_graph_node->output_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
-      }
-      return;
-    }
+  t_pb_graph_pin* physical_pb_graph_pin = find_physical_pb_graph_pin(operating_pb_graph_pin,
+                                                                     physical_port_lookup,
+                                                                     vpr_device_annotation);
+  if (nullptr == physical_pb_graph_pin) {
+    /* If we reach here, it means that pin pairing fails, error out! */
+    VTR_LOG_ERROR("Fail to match a physical pin for '%s' from pb_graph_node '%s'!\n",
+                  operating_pb_graph_pin->to_string().c_str(),
+                  physical_pb_graph_node->hierarchical_type_name().c_str());
+    return;
   }
 
-  for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport]; ++ipin) {
-      if (false == try_match_pb_graph_pin(operating_pb_graph_pin, 
-                                          &(physical_pb_graph_node->clock_pins[iport][ipin]),
-                                          vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation requirements 
-       * We can pair the pin and return  
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, &(physical_pb_graph_node->clock_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
-      }
-      return;
-    }
+  /* Reach here, it means the pins are matched by the annotation requirements 
+   * We can pair the pin and return  
+   */
+  vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin, physical_pb_graph_pin);
+  if (true == verbose_output) {
+    print_success_bind_pb_graph_pin(operating_pb_graph_pin, vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin)); 
   }
-
-  /* If we reach here, it means that pin pairing fails, error out! */
-  VTR_LOG_ERROR("Fail to match a physical pin for '%s' from pb_graph_node '%s'!\n",
-                operating_pb_graph_pin->to_string().c_str(),
-                physical_pb_graph_node->hierarchical_type_name().c_str());
 }
 
 /********************************************************************
@@ -454,14 +465,16 @@ void annotate_physical_pb_graph_node_pins(t_pb_graph_node* operating_pb_graph_no
                                           t_pb_graph_node* physical_pb_graph_node, 
                                           VprDeviceAnnotation& vpr_device_annotation,
                                           const bool& verbose_output) {
+  std::unordered_map<const t_port*, t_physical_pb_graph_port_pins> physical_port_lookup = build_physical_pb_graph_port_lookup(physical_pb_graph_node);
+
   /* Iterate over every port and pin of the operating pb_graph_node 
    * and find the physical pins 
    */
   for (int iport = 0; iport < operating_pb_graph_node->num_input_ports; ++iport) {
     for (int ipin = 0; ipin < operating_pb_graph_node->num_input_pins[iport]; ++ipin) {
       annotate_physical_pb_graph_pin(&(operating_pb_graph_node->input_pins[iport][ipin]),
-                                     physical_pb_graph_node, vpr_device_annotation,
-                                     verbose_output);
+                                     physical_pb_graph_node, physical_port_lookup,
+                                     vpr_device_annotation, verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_input_pins[iport]) {
@@ -476,8 +489,8 @@ void annotate_physical_pb_graph_node_pins(t_pb_graph_node* operating_pb_graph_no
   for (int iport = 0; iport < operating_pb_graph_node->num_output_ports; ++iport) {
     for (int ipin = 0; ipin < operating_pb_graph_node->num_output_pins[iport]; ++ipin) {
       annotate_physical_pb_graph_pin(&(operating_pb_graph_node->output_pins[iport][ipin]),
-                                     physical_pb_graph_node, vpr_device_annotation,
-                                     verbose_output);
+                                     physical_pb_graph_node, physical_port_lookup,
+                                     vpr_device_annotation, verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_output_pins[iport]) {
@@ -492,8 +505,8 @@ void annotate_physical_pb_graph_node_pins(t_pb_graph_node* operating_pb_graph_no
   for (int iport = 0; iport < operating_pb_graph_node->num_clock_ports; ++iport) {
     for (int ipin = 0; ipin < operating_pb_graph_node->num_clock_pins[iport]; ++ipin) {
       annotate_physical_pb_graph_pin(&(operating_pb_graph_node->clock_pins[iport][ipin]),
-                                     physical_pb_graph_node, vpr_device_annotation,
-                                     verbose_output);
+                                     physical_pb_graph_node, physical_port_lookup,
+                                     vpr_device_annotation, verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_clock_pins[iport]) {
@@ -2,10 +2,15 @@
  * This file includes functions that are used to annotate routing results
  * from VPR to OpenFPGA
  *******************************************************************/
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "annotate_routing.h"
 
 /* begin namespace openfpga */
@@ -52,93 +57,103 @@ void annotate_rr_node_nets(const DeviceContext& device_ctx,
 
 
 /********************************************************************
- * This function will find a previous node for a given rr_node
- * from the routing traces
+ * This function will find the previous nodes of the rr_nodes
+ * in the routing traces of a net
+ *
+ * The previous node of a rr_node is the node just before it
+ * in the routing traces, if it is one of the driving nodes of the rr_node.
+ *
+ * If not, it could be possible that this rr_node branches
+ * from an earlier point in the routing tree
+ *
+ *            +----- ... --->prev_node
+ *            |
+ *  src_node->+
+ *            |
+ *            +-----+ rr_node
  *
- * It requires a candidate which provided by upstream functions
- * Try to validate a candidate by searching it from driving node list
- * If not validated, try to find a right one in the routing traces
+ * and the previous node is the first node of the routing traces
+ * which drives the rr_node.
+ * This is reasonable because if there is a second-fit, it should be a longer path
+ * which should be considered in routing optimization
+ *
+ * The first position of each node in the routing traces is indexed in a single pass,
+ * so that each previous node is found by looking up the driving nodes of the rr_node,
+ * rather than by searching the routing traces again (which is quadratic on high-fanout nets)
+ *
+ * Return the pairs of (rr_node, previous node) to annotate, in the order of the traces
  *******************************************************************/
 static 
-RRNodeId find_previous_node_from_routing_traces(const RRGraph& rr_graph,
-                                                t_trace* routing_trace_head,
-                                                const RRNodeId& prev_node_candidate,
-                                                const RRNodeId& cur_rr_node) {
-  RRNodeId prev_node = prev_node_candidate;
-
-  /* For a valid prev_node, ensure prev node is one of the driving nodes for this rr_node! */
-  if (prev_node) {
-    /* Try to spot the previous node in the incoming node list of this rr_node */
-    bool valid_prev_node = false;
-    for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-      if (prev_node == rr_graph.edge_src_node(in_edge)) {
-        valid_prev_node = true;
-        break;
-      }
-    }
-
-    /* Early exit if we already validate the node */
-    if (true == valid_prev_node) {
-      return prev_node;
-    }
+std::vector<std::pair<RRNodeId, RRNodeId>> find_previous_nodes_from_routing_traces(const RRGraph& rr_graph,
+                                                                                    const t_trace* routing_trace_head) {
+  std::unordered_map<RRNodeId, size_t> trace_positions;
+  size_t num_traces = 0;
+  for (const t_trace* tptr = routing_trace_head; tptr != nullptr; tptr = tptr->next) {
+    trace_positions.insert(std::make_pair(tptr->index, num_traces));
+    num_traces++;
+  }
 
-    /* If we cannot find one, it could be possible that this rr_node branches 
-     * from an earlier point in the routing tree
-     *
-     *            +----- ... --->prev_node
-     *            |
-     *  src_node->+
-     *            |
-     *            +-----+ rr_node
-     *
-     * Our job now is to start from the head of the traces and find the prev_node 
-     * that drives this rr_node
-     *
-     * This search will find the first-fit and finish.
-     * This is reasonable because if there is a second-fit, it should be a longer path
-     * which should be considered in routing optimization
-     */
-    if (false == valid_prev_node) {
-      t_trace* tptr = routing_trace_head;
-      while (tptr != nullptr) {
-        RRNodeId cand_prev_node = tptr->index;
-        bool is_good_cand = false;
-        for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-          if (cand_prev_node == rr_graph.edge_src_node(in_edge)) {
-            is_good_cand = true;
-            break;
-          }
-        }
-  
-        if (true == is_good_cand) {
-          /* Update prev_node */
-          prev_node = cand_prev_node;
+  std::vector<std::pair<RRNodeId, RRNodeId>> prev_nodes;
+
+  /* Cache Previous nodes */
+  RRNodeId prev_node = RRNodeId::INVALID();
+  for (const t_trace* tptr = routing_trace_head; tptr != nullptr; tptr = tptr->next) {
+    RRNodeId rr_node = tptr->index;
+
+    /* For a valid prev_node, ensure prev node is one of the driving nodes for this rr_node! */
+    if (prev_node) {
+      bool valid_prev_node = false;
+      RRNodeId first_driver = RRNodeId::INVALID();
+      size_t first_driver_position = num_traces;
+      for (const RREdgeId& in_edge : rr_graph.node_in_edges(rr_node)) {
+        RRNodeId driver = rr_graph.edge_src_node(in_edge);
+        if (prev_node == driver) {
+          valid_prev_node = true;
           break;
         }
+        auto result = trace_positions.find(driver);
+        if ( (result != trace_positions.end())
+          && (result->second < first_driver_position) ) {
+          first_driver = driver;
+          first_driver_position = result->second;
+        }
+      }
 
-        /* Move on to the next */
-        tptr = tptr->next;
+      /* Otherwise, use the first driving node of the routing traces, if any */
+      if ( (false == valid_prev_node) && (first_driver) ) {
+        prev_node = first_driver;
       }
-    } 
+
+      /* Only update mapped nodes */
+      prev_nodes.push_back(std::make_pair(rr_node, prev_node));
+    }
+
+    /* Update prev_node */
+    prev_node = rr_node;
   }
 
-  return prev_node; 
+  return prev_nodes; 
 }
 
 /********************************************************************
  * Create a mapping between each rr_node and its previous node
  * based on VPR routing results
  * - Unmapped rr_node will have an invalid id of previous rr_node
+ *
+ * The previous nodes of the nets are found in parallel,
+ * and annotated in the order of the nets
  *******************************************************************/
 void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
                                      const ClusteringContext& clustering_ctx,
                                      const RoutingContext& routing_ctx,
                                      VprRoutingAnnotation& vpr_routing_annotation,
+                                     const size_t& num_threads,
                                      const bool& verbose) {
   size_t counter = 0;
   VTR_LOG("Annotating previous nodes for rr_node...");
   VTR_LOGV(verbose, "\n");
-   
+
+  std::vector<ClusterNetId> nets;
   for (auto net_id : clustering_ctx.clb_nlist.nets()) {
     /* Ignore nets that are not routed */
     if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
@@ -148,31 +163,19 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
     if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
       continue;
     }
-    
-    /* Cache Previous nodes */
-    RRNodeId prev_node = RRNodeId::INVALID();
-
-    t_trace* tptr = routing_ctx.trace[net_id].head;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = tptr->index;
-
-      /* Find the right previous node */
-      prev_node = find_previous_node_from_routing_traces(device_ctx.rr_graph,
-                                                         routing_ctx.trace[net_id].head,
-                                                         prev_node,
-                                                         rr_node);
-
-      /* Only update mapped nodes */
-      if (prev_node) {
-        vpr_routing_annotation.set_rr_node_prev_node(rr_node, prev_node);
-        counter++;
-      }
+    nets.push_back(net_id);
+  }
 
-      /* Update prev_node */
-      prev_node = rr_node;
+  std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>> net_prev_nodes(nets.size());
+  parallel_for(nets.size(), find_num_threads(num_threads), [&](const size_t& inet) {
+    net_prev_nodes[inet] = find_previous_nodes_from_routing_traces(device_ctx.rr_graph,
+                                                                   routing_ctx.trace[nets[inet]].head);
+  });
 
-      /* Move on to the next */
-      tptr = tptr->next;
+  for (const auto& prev_nodes : net_prev_nodes) {
+    for (const auto& prev_node : prev_nodes) {
+      vpr_routing_annotation.set_rr_node_prev_node(prev_node.first, prev_node.second);
+      counter++;
     }
   }
 
@@ -180,4 +183,3 @@ void annotate_rr_node_previous_nodes(const DeviceContext& device_ctx,
 }
 
 } /* end namespace openfpga */
-
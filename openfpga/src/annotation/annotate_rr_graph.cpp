@@ -2,6 +2,10 @@
  * This file includes functions that are used to annotate device-level
  * information, in particular the routing resource graph
  *******************************************************************/
+#include <map>
+#include <string>
+#include <utility>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_assert.h"
@@ -9,6 +13,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "rr_graph_obj_util.h"
@@ -403,6 +408,7 @@ RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
  *******************************************************************/
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx, 
                             DeviceRRGSB& device_rr_gsb,
+                            const size_t& num_threads,
                             const bool& verbose_output) {
 
   vtr::ScopedStartFinishTimer timer("Build General Switch Block(GSB) annotation on top of routing resource graph");
@@ -415,27 +421,35 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
            "Start annotation GSB up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      /* Here we give the builder the fringe coordinates so that it can handle the GSBs at the borderside correctly
-       * sort drive_rr_nodes should be called if required by users
-       */
-      const RRGSB& rr_gsb = build_rr_gsb(vpr_device_ctx, 
-                                         vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), 
-                                         vtr::Point<size_t>(ix, iy));
- 
-      /* Add to device_rr_gsb */
-      vtr::Point<size_t> gsb_coordinate = rr_gsb.get_sb_coordinate();
-      device_rr_gsb.add_rr_gsb(gsb_coordinate, rr_gsb);
-      gsb_cnt++; /* Update counter */
-      /* Print info */
-      VTR_LOG("[%lu%] Backannotated GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
-              ix, iy);
-    }
+  /* Each GSB only depends on the routing resource graph, and is built in parallel
+   * directly in the array. 
+   * Here we give the builder the fringe coordinates so that it can handle the GSBs at the borderside correctly
+   * sort drive_rr_nodes should be called if required by users
+   *
+   * The first GSB is built alone, as it also builds the fast look-up of the routing
+   * resource graph (when the graph is not frozen), which is then read by all the threads
+   */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = device_rr_gsb.get_gsb_coordinates();
+  auto build_one_rr_gsb = [&](const size_t& igsb) {
+    RRGSB rr_gsb = build_rr_gsb(vpr_device_ctx, 
+                                vtr::Point<size_t>(vpr_device_ctx.grid.width() - 2, vpr_device_ctx.grid.height() - 2), 
+                                gsb_coordinates[igsb]);
+    VTR_ASSERT(rr_gsb.get_sb_coordinate() == gsb_coordinates[igsb]);
+    device_rr_gsb.get_mutable_gsb(gsb_coordinates[igsb]) = std::move(rr_gsb);
+  };
+  if (!gsb_coordinates.empty()) {
+    build_one_rr_gsb(0);
+    parallel_for(gsb_coordinates.size() - 1, find_num_threads(num_threads), [&](const size_t& igsb) {
+      build_one_rr_gsb(igsb + 1);
+    });
   }
+
+  /* Each routing channel is built by the two GSBs around it, and is stored once */
+  size_t num_shared_chans = device_rr_gsb.share_chan_nodes();
+  VTR_LOGV(verbose_output,
+           "Shared %lu routing channels between adjacent GSBs\n",
+           num_shared_chans);
+
   /* Report number of unique mirrors */
   VTR_LOG("Backannotated %d General Switch Blocks (GSBs).\n",
           gsb_range.x() * gsb_range.y());
@@ -447,6 +461,7 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
  *******************************************************************/
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Sort incoming edges for each routing track output node of General Switch Block(GSB)");
 
@@ -457,29 +472,34 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraph& rr_graph,
            "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
-      RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
-      rr_gsb.sort_chan_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG("[%lu%] Sorted edges for GSB[%lu][%lu]\r",
-              100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), 
-              ix, iy);
-    } 
-  }
+  /* The edges of each GSB are sorted independently, in parallel */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = device_rr_gsb.get_gsb_coordinates();
+  parallel_for(gsb_coordinates.size(), find_num_threads(num_threads), [&](const size_t& igsb) {
+    RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinates[igsb]);
+    rr_gsb.sort_chan_node_in_edges(rr_graph);
+  });
 
   /* Report number of unique mirrors */
   VTR_LOG("Sorted edges for %d General Switch Blocks (GSBs).\n",
           gsb_range.x() * gsb_range.y());
 }
 
+/********************************************************************
+ * Find the circuit model binded to a routing circuit name
+ * in a name-to-circuit mapping of the OpenFPGA arch XML,
+ * with a single look-up of the mapping
+ * Return an invalid id if the name is not binded
+ *******************************************************************/
+static 
+CircuitModelId find_routing_circuit_model(const std::map<std::string, CircuitModelId>& name2circuit,
+                                          const std::string& name) {
+  auto result = name2circuit.find(name);
+  if (result == name2circuit.end()) {
+    return CircuitModelId::INVALID();
+  }
+  return result->second;
+}
+
 /********************************************************************
  * Build the link between rr_graph switches to their physical circuit models 
  * The binding is done based on the name of rr_switches defined in the
@@ -492,31 +512,31 @@ void annotate_rr_switch_circuit_models(const DeviceContext& vpr_device_ctx,
                                        const bool& verbose_output) {
   size_t count = 0;
 
+  const std::string delayless_switch_name(VPR_DELAYLESS_SWITCH_NAME);
+
   for (size_t iswitch = 0; iswitch < vpr_device_ctx.rr_switch_inf.size(); ++iswitch) {
     std::string switch_name(vpr_device_ctx.rr_switch_inf[iswitch].name); 
     /* Skip the delayless switch, which is only used by the edges between
      * - SOURCE and OPIN
      * - IPIN and SINK  
      */
-    if (switch_name == std::string(VPR_DELAYLESS_SWITCH_NAME)) {
+    if (switch_name == delayless_switch_name) {
       continue;
     }
 
-    CircuitModelId circuit_model = CircuitModelId::INVALID();
     /* The name-to-circuit mapping is stored in either cb_switch-to-circuit or sb_switch-to-circuit,
      * Try to find one and update the device annotation
      */ 
-    if (0 < openfpga_arch.cb_switch2circuit.count(switch_name)) {
-      circuit_model = openfpga_arch.cb_switch2circuit.at(switch_name); 
-    }
-    if (0 < openfpga_arch.sb_switch2circuit.count(switch_name)) {
+    CircuitModelId circuit_model = find_routing_circuit_model(openfpga_arch.cb_switch2circuit, switch_name);
+    CircuitModelId sb_circuit_model = find_routing_circuit_model(openfpga_arch.sb_switch2circuit, switch_name);
+    if (CircuitModelId::INVALID() != sb_circuit_model) {
       if (CircuitModelId::INVALID() != circuit_model) {
         VTR_LOG_WARN("Found a connection block and a switch block switch share the same name '%s' and binded to different circuit models '%s' and '%s'!\nWill use the switch block switch binding!\n",
                      switch_name.c_str(),
                      openfpga_arch.circuit_lib.model_name(circuit_model).c_str(),
-                     openfpga_arch.circuit_lib.model_name(openfpga_arch.sb_switch2circuit.at(switch_name)).c_str());
+                     openfpga_arch.circuit_lib.model_name(sb_circuit_model).c_str());
       }
-      circuit_model = openfpga_arch.sb_switch2circuit.at(switch_name); 
+      circuit_model = sb_circuit_model; 
     }
 
     /* Cannot find a circuit model, error out! */
@@ -561,13 +581,10 @@ void annotate_rr_segment_circuit_models(const DeviceContext& vpr_device_ctx,
 
   for (size_t iseg = 0; iseg < vpr_device_ctx.arch->Segments.size(); ++iseg) {
     std::string segment_name = vpr_device_ctx.arch->Segments[iseg].name; 
-    CircuitModelId circuit_model = CircuitModelId::INVALID();
-    /* The name-to-circuit mapping is stored in either cb_switch-to-circuit or sb_switch-to-circuit,
+    /* The name-to-circuit mapping is stored in the routing_segment-to-circuit,
      * Try to find one and update the device annotation
      */ 
-    if (0 < openfpga_arch.routing_seg2circuit.count(segment_name)) {
-      circuit_model = openfpga_arch.routing_seg2circuit.at(segment_name); 
-    }
+    CircuitModelId circuit_model = find_routing_circuit_model(openfpga_arch.routing_seg2circuit, segment_name);
     /* Cannot find a circuit model, error out! */
     if (CircuitModelId::INVALID() == circuit_model) {
       VTR_LOG_ERROR("Fail to find a circuit model for a routing segment '%s'!\nPlease check your OpenFPGA architecture XML!\n",
@@ -3,8 +3,12 @@
  * in the users' BLIF netlist that violates the syntax of OpenFPGA
  * fabric generator, i.e., Verilog generator and SPICE generator
  *******************************************************************/
+#include <array>
+#include <functional>
 #include <string>
 #include <fstream>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_time.h"
@@ -19,7 +23,9 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
+#include "openfpga_command_utils.h"
 #include "check_netlist_naming_conflict.h"
 
 /* Include global variables of VPR */
@@ -28,20 +34,57 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A look-up from each character to its fix-up character,
+ * where legal characters are mapped to '\0'.
+ * It lets a name be checked and fixed in a single pass
+ * over its characters
+ *******************************************************************/
+typedef std::array<char, 256> t_sensitive_char_lookup;
+
+static 
+t_sensitive_char_lookup build_sensitive_char_lookup(const std::string& sensitive_chars,
+                                                    const std::string& fix_chars) {
+  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
+
+  t_sensitive_char_lookup char_lookup;
+  char_lookup.fill('\0');
+  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
+    char_lookup[static_cast<unsigned char>(sensitive_chars[ichar])] = fix_chars[ichar];
+  }
+
+  return char_lookup;
+}
+
 /********************************************************************
  * This function aims to check if the name contains any of the 
  * sensitive characters in the list
  * Return a string of sensitive characters which are contained
- * in the name
+ * in the name, in the order of the list
  *******************************************************************/
 static 
 std::string name_contain_sensitive_chars(const std::string& name, 
-                                         const std::string& sensitive_chars) {
+                                         const std::string& sensitive_chars,
+                                         const t_sensitive_char_lookup& char_lookup) {
   std::string violation;
 
+  /* Most names are legal: only look for the characters found when needed */
+  std::array<bool, 256> found_chars;
+  found_chars.fill(false);
+  bool found = false;
+  for (const char& name_char : name) {
+    if ('\0' != char_lookup[static_cast<unsigned char>(name_char)]) {
+      found_chars[static_cast<unsigned char>(name_char)] = true;
+      found = true;
+    }
+  }
+
+  if (false == found) {
+    return violation;
+  }
+
   for (const char& sensitive_char : sensitive_chars) {
-    /* Return true since we find a characters */
-    if (std::string::npos != name.find(sensitive_char)) {
+    if (true == found_chars[static_cast<unsigned char>(sensitive_char)]) {
       violation.push_back(sensitive_char);
     }
   }
@@ -56,24 +99,39 @@ std::string name_contain_sensitive_chars(const std::string& name,
  *******************************************************************/
 static 
 std::string fix_name_contain_sensitive_chars(const std::string& name, 
-                                             const std::string& sensitive_chars,
-                                             const std::string& fix_chars) {
+                                             const t_sensitive_char_lookup& char_lookup) {
   std::string fixed_name = name;
 
-  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
-
-  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
-    /* Keep fixing the characters until we cannot find anymore */
-    std::string::size_type pos = 0u;
-    while (std::string::npos != (pos = fixed_name.find(sensitive_chars[ichar], pos))) {
-      fixed_name.replace(pos, 1, std::string(1, fix_chars[ichar]));
-      pos += 1;
+  for (char& name_char : fixed_name) {
+    const char& fix_char = char_lookup[static_cast<unsigned char>(name_char)];
+    if ('\0' != fix_char) {
+      name_char = fix_char;
     }
   }
 
   return fixed_name;
 }
 
+/********************************************************************
+ * Find the violations of a list of names in parallel
+ * Return the violation of each name, which is empty for legal names
+ *******************************************************************/
+template<typename T>
+static 
+std::vector<std::string> find_names_contain_sensitive_chars(const std::vector<T>& ids,
+                                                            const std::function<const std::string&(const T&)>& name_of,
+                                                            const std::string& sensitive_chars,
+                                                            const t_sensitive_char_lookup& char_lookup,
+                                                            const size_t& num_threads) {
+  std::vector<std::string> violations(ids.size());
+
+  parallel_for(ids.size(), find_num_threads(num_threads), [&](const size_t& iid) {
+    violations[iid] = name_contain_sensitive_chars(name_of(ids[iid]), sensitive_chars, char_lookup);
+  });
+
+  return violations;
+}
+
 /********************************************************************
  * Detect and report any naming conflict by checking a list of 
  * sensitive characters
@@ -81,30 +139,38 @@ std::string fix_name_contain_sensitive_chars(const std::string& name,
  *   any sensitive character
  * - Iterate over all the nets and see if any net name contain 
  *   any sensitive character
+ * The names are checked in parallel, and reported in the order
+ * of the netlist
  *******************************************************************/
 static 
 size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                    const std::string& sensitive_chars) {
+                                      const std::string& sensitive_chars,
+                                      const t_sensitive_char_lookup& char_lookup,
+                                      const size_t& num_threads) {
   size_t num_conflicts = 0;
 
   /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation = name_contain_sensitive_chars(block_name, sensitive_chars);
-    if (false == violation.empty()) {
+  std::vector<AtomBlockId> blocks(atom_netlist.blocks().begin(), atom_netlist.blocks().end());
+  std::vector<std::string> block_violations = find_names_contain_sensitive_chars<AtomBlockId>(blocks,
+                                                                                              [&](const AtomBlockId& block) -> const std::string& { return atom_netlist.block_name(block); },
+                                                                                              sensitive_chars, char_lookup, num_threads);
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    if (false == block_violations[iblk].empty()) {
       VTR_LOG("Block '%s' contains illegal characters '%s'\n",
-              block_name.c_str(), violation.c_str());
+              atom_netlist.block_name(blocks[iblk]).c_str(), block_violations[iblk].c_str());
       num_conflicts++;
     }
   }
 
   /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation = name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
+  std::vector<AtomNetId> nets(atom_netlist.nets().begin(), atom_netlist.nets().end());
+  std::vector<std::string> net_violations = find_names_contain_sensitive_chars<AtomNetId>(nets,
+                                                                                          [&](const AtomNetId& net) -> const std::string& { return atom_netlist.net_name(net); },
+                                                                                          sensitive_chars, char_lookup, num_threads);
+  for (size_t inet = 0; inet < nets.size(); ++inet) {
+    if (false == net_violations[inet].empty()) {
       VTR_LOG("Net '%s' contains illegal characters '%s'\n",
-              net_name.c_str(), violation.c_str());
+              atom_netlist.net_name(nets[inet]).c_str(), net_violations[inet].c_str());
       num_conflicts++;
     }
   }
@@ -112,6 +178,55 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
   return num_conflicts;
 } 
 
+/********************************************************************
+ * Warn about the fixed names which are the same as the name of
+ * another netlist component (fixed or not), as the fabric generators
+ * would then merge the two components.
+ * The names are hashed, so that each name is only looked up once
+ * Return the number of fixed names which collide
+ *******************************************************************/
+template<typename T>
+static 
+size_t warn_fixed_name_collisions(const std::vector<T>& ids,
+                                  const std::vector<std::string>& fixed_names,
+                                  const std::function<const std::string&(const T&)>& name_of,
+                                  const char* component_type) {
+  size_t num_collisions = 0;
+
+  /* Index the names of all the components, as they are after the fix-up.
+   * The names which are not fixed are indexed first, so that a fixed name
+   * is always reported when it collides with one of them
+   */
+  std::unordered_map<std::string, size_t> name_lookup;
+  name_lookup.reserve(ids.size());
+  for (size_t iid = 0; iid < ids.size(); ++iid) {
+    if (true == fixed_names[iid].empty()) {
+      name_lookup.emplace(name_of(ids[iid]), iid);
+    }
+  }
+  for (size_t iid = 0; iid < ids.size(); ++iid) {
+    if (false == fixed_names[iid].empty()) {
+      name_lookup.emplace(fixed_names[iid], iid);
+    }
+  }
+
+  for (size_t iid = 0; iid < ids.size(); ++iid) {
+    if (true == fixed_names[iid].empty()) {
+      continue;
+    }
+    auto result = name_lookup.find(fixed_names[iid]);
+    VTR_ASSERT(result != name_lookup.end());
+    if (result->second != iid) {
+      VTR_LOG_WARN("Fixed name '%s' of %s '%s' is the same as the name of %s '%s'\n",
+                   fixed_names[iid].c_str(), component_type, name_of(ids[iid]).c_str(),
+                   component_type, name_of(ids[result->second]).c_str());
+      num_collisions++;
+    }
+  }
+
+  return num_collisions;
+}
+
 /********************************************************************
  * Correct and report any naming conflict by checking a list of 
  * sensitive characters
@@ -119,41 +234,68 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
  *   any sensitive character
  * - Iterate over all the nets and correct any net name that contains
  *   any sensitive character
+ * The names are fixed in parallel, and renamed in the annotation
+ * in the order of the netlist
  *******************************************************************/
 static 
 void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
-                                 const std::string& sensitive_chars,
-                                 const std::string& fix_chars,
+                                 const t_sensitive_char_lookup& char_lookup,
+                                 const size_t& num_threads,
                                  VprNetlistAnnotation& vpr_netlist_annotation) {
   size_t num_fixes = 0;
 
   /* Walk through blocks in the netlist */
-  for (const auto& block : atom_netlist.blocks()) {
-    const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation = name_contain_sensitive_chars(block_name, sensitive_chars);
-
-    if (false == violation.empty()) {
+  std::vector<AtomBlockId> blocks(atom_netlist.blocks().begin(), atom_netlist.blocks().end());
+  std::function<const std::string&(const AtomBlockId&)> block_name_of = [&](const AtomBlockId& block) -> const std::string& {
+    return atom_netlist.block_name(block);
+  };
+  /* An empty name means a legal name which is not fixed */
+  std::vector<std::string> fixed_block_names(blocks.size());
+  parallel_for(blocks.size(), find_num_threads(num_threads), [&](const size_t& iblk) {
+    const std::string& block_name = atom_netlist.block_name(blocks[iblk]);
+    std::string fixed_name = fix_name_contain_sensitive_chars(block_name, char_lookup);
+    if (fixed_name != block_name) {
+      fixed_block_names[iblk] = fixed_name;
+    }
+  });
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    if (false == fixed_block_names[iblk].empty()) {
       /* Apply fix-up here */
-      vpr_netlist_annotation.rename_block(block, fix_name_contain_sensitive_chars(block_name, sensitive_chars, fix_chars)); 
+      vpr_netlist_annotation.rename_block(blocks[iblk], fixed_block_names[iblk]); 
       num_fixes++;
     }
   }
+  size_t num_collisions = warn_fixed_name_collisions<AtomBlockId>(blocks, fixed_block_names, block_name_of, "block");
 
   /* Walk through nets in the netlist */
-  for (const auto& net : atom_netlist.nets()) {
-    const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation = name_contain_sensitive_chars(net_name, sensitive_chars);
-    if (false == violation.empty()) {
+  std::vector<AtomNetId> nets(atom_netlist.nets().begin(), atom_netlist.nets().end());
+  std::function<const std::string&(const AtomNetId&)> net_name_of = [&](const AtomNetId& net) -> const std::string& {
+    return atom_netlist.net_name(net);
+  };
+  std::vector<std::string> fixed_net_names(nets.size());
+  parallel_for(nets.size(), find_num_threads(num_threads), [&](const size_t& inet) {
+    const std::string& net_name = atom_netlist.net_name(nets[inet]);
+    std::string fixed_name = fix_name_contain_sensitive_chars(net_name, char_lookup);
+    if (fixed_name != net_name) {
+      fixed_net_names[inet] = fixed_name;
+    }
+  });
+  for (size_t inet = 0; inet < nets.size(); ++inet) {
+    if (false == fixed_net_names[inet].empty()) {
       /* Apply fix-up here */
-      vpr_netlist_annotation.rename_net(net, fix_name_contain_sensitive_chars(net_name, sensitive_chars, fix_chars)); 
+      vpr_netlist_annotation.rename_net(nets[inet], fixed_net_names[inet]); 
       num_fixes++;
     }
   }
+  num_collisions += warn_fixed_name_collisions<AtomNetId>(nets, fixed_net_names, net_name_of, "net");
 
   if (0 < num_fixes) {
     VTR_LOG("Fixed %ld naming conflicts in the netlist.\n",
             num_fixes);
   }
+  VTR_LOGV_WARN(0 < num_collisions,
+                "%ld fixed names are the same as other names in the netlist. Please correct them so as to use any fabric generators.\n",
+                num_collisions);
 }
 
 /********************************************************************
@@ -224,11 +366,20 @@ int check_netlist_naming_conflict(OpenfpgaContext& openfpga_context,
   const std::string& sensitive_chars(".,:;\'\"+-<>()[]{}!@#$%^&*~`?/");
   const std::string&       fix_chars("____________________________");
 
+  t_sensitive_char_lookup char_lookup = build_sensitive_char_lookup(sensitive_chars, fix_chars);
+
   CommandOptionId opt_fix = cmd.option("fix");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_context.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Do the main job first: detect any naming in the BLIF netlist that violates the syntax */
   if (false == cmd_context.option_enable(cmd, opt_fix)) {
-    size_t num_conflicts = detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars); 
+    size_t num_conflicts = detect_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars,
+                                                          char_lookup, num_threads); 
     VTR_LOGV_ERROR((0 < num_conflicts && (false == cmd_context.option_enable(cmd, opt_fix))),
                   "Found %ld naming conflicts in the netlist. Please correct so as to use any fabric generators.\n",
                   num_conflicts);
@@ -247,8 +398,8 @@ int check_netlist_naming_conflict(OpenfpgaContext& openfpga_context,
 
   /* If the auto correction is enabled, we apply a fix */
   if (true == cmd_context.option_enable(cmd, opt_fix)) {
-    fix_netlist_naming_conflict(g_vpr_ctx.atom().nlist, sensitive_chars,
-                                fix_chars, openfpga_context.mutable_vpr_netlist_annotation());
+    fix_netlist_naming_conflict(g_vpr_ctx.atom().nlist, char_lookup,
+                                num_threads, openfpga_context.mutable_vpr_netlist_annotation());
 
     CommandOptionId opt_report = cmd.option("report");
     if (true == cmd_context.option_enable(cmd, opt_report)) {
@@ -1,8 +1,16 @@
 /************************************************************************
  * Member functions for class DeviceRRGSB
  ***********************************************************************/
+#include <unordered_map>
+#include <utility>
+
 #include "vtr_log.h"
 #include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_memory_usage.h"
+
 #include "device_rr_gsb.h"
 
 /* namespace openfpga begins */
@@ -15,6 +23,19 @@ namespace openfpga {
 /************************************************************************
  * Public accessors
  ***********************************************************************/
+size_t DeviceRRGSB::memory_usage() const {
+  return sizeof(DeviceRRGSB)
+       + heap_memory_usage(rr_gsb_)
+       + heap_memory_usage(gsb_unique_module_id_)
+       + heap_memory_usage(gsb_unique_module_)
+       + heap_memory_usage(sb_unique_module_id_)
+       + heap_memory_usage(sb_unique_module_)
+       + heap_memory_usage(cbx_unique_module_id_)
+       + heap_memory_usage(cbx_unique_module_)
+       + heap_memory_usage(cby_unique_module_id_)
+       + heap_memory_usage(cby_unique_module_);
+}
+
 /* get the max coordinate of the switch block array */
 vtr::Point<size_t> DeviceRRGSB::get_gsb_range() const {
   size_t max_y = 0;
@@ -136,6 +157,28 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(const vtr::Point<size_t>& coordin
   return get_sb_unique_module(sb_unique_module_id);
 } 
 
+/* Give a coordinate of a rr switch block, and return the id of its unique mirror */ 
+size_t DeviceRRGSB::get_sb_unique_module_id(const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  return sb_unique_module_id_[coordinate.x()][coordinate.y()];  
+} 
+
+/* Give a coordinate of a connection block, and return the id of its unique mirror */ 
+size_t DeviceRRGSB::get_cb_unique_module_id(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  VTR_ASSERT(validate_cb_type(cb_type));
+  if (CHANX == cb_type) {
+    return cbx_unique_module_id_[coordinate.x()][coordinate.y()];  
+  }
+  return cby_unique_module_id_[coordinate.x()][coordinate.y()];  
+} 
+
+/* Give a coordinate of a GSB, and return the id of its unique mirror */ 
+size_t DeviceRRGSB::get_gsb_unique_module_id(const vtr::Point<size_t>& coordinate) const {
+  VTR_ASSERT(validate_coordinate(coordinate));
+  return gsb_unique_module_id_[coordinate.x()][coordinate.y()];  
+} 
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -193,6 +236,39 @@ void DeviceRRGSB::add_rr_gsb(const vtr::Point<size_t>& coordinate,
   rr_gsb_[coordinate.x()][coordinate.y()] = rr_gsb; 
 }
 
+/* Move a switch block to the array */
+void DeviceRRGSB::add_rr_gsb(const vtr::Point<size_t>& coordinate, 
+                             RRGSB&& rr_gsb) {
+  /* Resize upon needs*/
+  resize_upon_need(coordinate);
+
+  /* Add the switch block into array */
+  rr_gsb_[coordinate.x()][coordinate.y()] = std::move(rr_gsb); 
+}
+
+/* Share the routing channels between adjacent GSBs
+ * Each GSB builds its own copy of the channels around it,
+ * while a routing channel is at the border of two GSBs
+ */
+size_t DeviceRRGSB::share_chan_nodes() {
+  size_t num_shared_chans = 0;
+  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      const RRGSB& rr_gsb = rr_gsb_[ix][iy];
+      if ( (iy + 1 < rr_gsb_[ix].size())
+        && (true == rr_gsb_[ix][iy + 1].share_chan_node(BOTTOM, rr_gsb, TOP)) ) {
+        num_shared_chans++;
+      }
+      if ( (ix + 1 < rr_gsb_.size())
+        && (iy < rr_gsb_[ix + 1].size())
+        && (true == rr_gsb_[ix + 1][iy].share_chan_node(LEFT, rr_gsb, RIGHT)) ) {
+        num_shared_chans++;
+      }
+    }
+  }
+  return num_shared_chans;
+}
+
 /* Get a rr switch block in the array with a coordinate */
 RRGSB& DeviceRRGSB::get_mutable_gsb(const vtr::Point<size_t>& coordinate) {
   VTR_ASSERT(validate_coordinate(coordinate));
@@ -205,76 +281,119 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
   return get_mutable_gsb(coordinate);
 }
 
+/* Find the coordinates of all the GSBs in the array, in the order of building unique modules */
+std::vector<vtr::Point<size_t>> DeviceRRGSB::get_gsb_coordinates() const {
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
+  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      gsb_coordinates.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
+  return gsb_coordinates;
+}
+
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type) {
+void DeviceRRGSB::build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type,
+                                         const size_t& num_threads) {
   /* Make sure a clean start */
   clear_cb_unique_module(cb_type);
 
-  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
-    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+  /* Each CB has its own signature, so that signatures can be computed in parallel */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = get_gsb_coordinates();
+  std::vector<size_t> cb_signatures(gsb_coordinates.size(), 0);
+  parallel_for(gsb_coordinates.size(), num_threads, [&](const size_t& igsb) {
+    const RRGSB& rr_gsb = rr_gsb_[gsb_coordinates[igsb].x()][gsb_coordinates[igsb].y()];
+    if (true == rr_gsb.is_cb_exist(cb_type)) {
+      cb_signatures[igsb] = rr_gsb.get_cb_signature(rr_graph, cb_type);
+    }
+  });
 
-      /* Bypass non-exist CB */
-      if ( false == rr_gsb_[ix][iy].is_cb_exist(cb_type) ) {
-        continue;
-      }
+  /* Unique modules are bucketed by their signatures,
+   * only the unique modules in the same bucket can be mirrors
+   */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
-        const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
-        if (true == rr_gsb_[ix][iy].is_cb_mirror(rr_graph, unique_module, cb_type)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          set_cb_unique_module_id(cb_type, gsb_coordinate, id); 
-          break;
-        }
-      }
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_cb_unique_module(cb_type, gsb_coordinate);
+  for (size_t igsb = 0; igsb < gsb_coordinates.size(); ++igsb) {
+    bool is_unique_module = true;
+    const vtr::Point<size_t>& gsb_coordinate = gsb_coordinates[igsb];
+    const RRGSB& rr_gsb = rr_gsb_[gsb_coordinate.x()][gsb_coordinate.y()];
+
+    /* Bypass non-exist CB */
+    if ( false == rr_gsb.is_cb_exist(cb_type) ) {
+      continue;
+    }
+
+    /* Traverse the unique_mirror list and check it is an mirror of another */
+    std::vector<size_t>& bucket = unique_module_buckets[cb_signatures[igsb]];
+    for (const size_t& id : bucket) {
+      const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
+      if (true == rr_gsb.is_cb_mirror(rr_graph, unique_module, cb_type)) {
+        /* This is a mirror, raise the flag and we finish */
+        is_unique_module = false;
         /* Record the id of unique mirror */
-        set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+        set_cb_unique_module_id(cb_type, gsb_coordinate, id); 
+        break;
       }
     }
+    /* Add to list if this is a unique mirror*/
+    if (true == is_unique_module) {
+      add_cb_unique_module(cb_type, gsb_coordinate);
+      /* Record the id of unique mirror */
+      set_cb_unique_module_id(cb_type, gsb_coordinate, get_num_cb_unique_module(cb_type) - 1); 
+      bucket.push_back(get_num_cb_unique_module(cb_type) - 1);
+    }
   } 
 }
 
 /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph) {
+void DeviceRRGSB::build_sb_unique_module(const RRGraph& rr_graph,
+                                         const size_t& num_threads) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
-  /* Build the unique module */
-  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
-    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
-      vtr::Point<size_t> sb_coordinate(ix, iy);
+  /* Each SB has its own signature, so that signatures can be computed in parallel */
+  std::vector<vtr::Point<size_t>> gsb_coordinates = get_gsb_coordinates();
+  std::vector<size_t> sb_signatures(gsb_coordinates.size(), 0);
+  parallel_for(gsb_coordinates.size(), num_threads, [&](const size_t& igsb) {
+    sb_signatures[igsb] = rr_gsb_[gsb_coordinates[igsb].x()][gsb_coordinates[igsb].y()].get_sb_signature(rr_graph);
+  });
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
-        /* Check if the two modules have the same submodules,
-         * if so, these two modules are the same, indicating the sb is not unique.
-         * else the sb is unique 
-         */
-        const RRGSB& unique_module = get_sb_unique_module(id);
-        if (true == rr_gsb_[ix][iy].is_sb_mirror(rr_graph, unique_module)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          sb_unique_module_id_[ix][iy] = id; 
-          break;
-        }
-      }
+  /* Unique modules are bucketed by their signatures,
+   * only the unique modules in the same bucket can be mirrors
+   */
+  std::unordered_map<size_t, std::vector<size_t>> unique_module_buckets;
 
-      /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        sb_unique_module_.push_back(sb_coordinate);
+  /* Build the unique module */
+  for (size_t igsb = 0; igsb < gsb_coordinates.size(); ++igsb) {
+    size_t ix = gsb_coordinates[igsb].x();
+    size_t iy = gsb_coordinates[igsb].y();
+    bool is_unique_module = true;
+    const vtr::Point<size_t>& sb_coordinate = gsb_coordinates[igsb];
+
+    /* Traverse the unique_mirror list and check it is an mirror of another */
+    std::vector<size_t>& bucket = unique_module_buckets[sb_signatures[igsb]];
+    for (const size_t& id : bucket) {
+      /* Check if the two modules have the same submodules,
+       * if so, these two modules are the same, indicating the sb is not unique.
+       * else the sb is unique 
+       */
+      const RRGSB& unique_module = get_sb_unique_module(id);
+      if (true == rr_gsb_[ix][iy].is_sb_mirror(rr_graph, unique_module)) {
+        /* This is a mirror, raise the flag and we finish */
+        is_unique_module = false;
         /* Record the id of unique mirror */
-        sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1; 
+        sb_unique_module_id_[ix][iy] = id; 
+        break;
       }
     }
+
+    /* Add to list if this is a unique mirror*/
+    if (true == is_unique_module) {
+      sb_unique_module_.push_back(sb_coordinate);
+      /* Record the id of unique mirror */
+      sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1; 
+      bucket.push_back(sb_unique_module_.size() - 1);
+    }
   } 
 }
 
@@ -316,15 +435,97 @@ void DeviceRRGSB::build_gsb_unique_module() {
   } 
 }
 
-void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph) {
-  build_sb_unique_module(rr_graph);
+void DeviceRRGSB::build_unique_module(const RRGraph& rr_graph,
+                                      const size_t& num_threads) {
+  build_sb_unique_module(rr_graph, num_threads);
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  build_cb_unique_module(rr_graph, CHANX, num_threads);
+  build_cb_unique_module(rr_graph, CHANY, num_threads);
 
   build_gsb_unique_module();
 }
 
+/* Restore the unique mirrors from their ids
+ * The unique mirror of an id is the first GSB with the id,
+ * visited in the same order as build_unique_module()
+ */
+bool DeviceRRGSB::restore_unique_module(const std::vector<std::vector<size_t>>& sb_unique_module_id,
+                                        const std::vector<std::vector<size_t>>& cbx_unique_module_id,
+                                        const std::vector<std::vector<size_t>>& cby_unique_module_id,
+                                        const std::vector<std::vector<size_t>>& gsb_unique_module_id) {
+  /* Make sure a clean start */
+  clear_sb_unique_module();
+  clear_cb_unique_module(CHANX);
+  clear_cb_unique_module(CHANY);
+  clear_gsb_unique_module();
+
+  if ( (rr_gsb_.size() != sb_unique_module_id.size())
+    || (rr_gsb_.size() != cbx_unique_module_id.size())
+    || (rr_gsb_.size() != cby_unique_module_id.size())
+    || (rr_gsb_.size() != gsb_unique_module_id.size()) ) {
+    return false;
+  }
+
+  bool valid_ids = true;
+  for (const vtr::Point<size_t>& gsb_coordinate : get_gsb_coordinates()) {
+    size_t ix = gsb_coordinate.x();
+    size_t iy = gsb_coordinate.y();
+    if ( (rr_gsb_[ix].size() != sb_unique_module_id[ix].size())
+      || (rr_gsb_[ix].size() != cbx_unique_module_id[ix].size())
+      || (rr_gsb_[ix].size() != cby_unique_module_id[ix].size())
+      || (rr_gsb_[ix].size() != gsb_unique_module_id[ix].size()) ) {
+      valid_ids = false;
+      break;
+    }
+
+    /* A new id must be the next unique mirror */
+    if (sb_unique_module_id[ix][iy] > get_num_sb_unique_module()) {
+      valid_ids = false;
+      break;
+    }
+    if (sb_unique_module_id[ix][iy] == get_num_sb_unique_module()) {
+      sb_unique_module_.push_back(gsb_coordinate);
+    }
+    sb_unique_module_id_[ix][iy] = sb_unique_module_id[ix][iy];
+
+    /* Ids of non-exist CBs are not used by CB unique mirrors but used by GSB unique mirrors */
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      size_t cb_id = (CHANX == cb_type) ? cbx_unique_module_id[ix][iy] : cby_unique_module_id[ix][iy];
+      if (true == rr_gsb_[ix][iy].is_cb_exist(cb_type)) {
+        if (cb_id > get_num_cb_unique_module(cb_type)) {
+          valid_ids = false;
+          break;
+        }
+        if (cb_id == get_num_cb_unique_module(cb_type)) {
+          add_cb_unique_module(cb_type, gsb_coordinate);
+        }
+      }
+      set_cb_unique_module_id(cb_type, gsb_coordinate, cb_id);
+    }
+    if (false == valid_ids) {
+      break;
+    }
+
+    if (gsb_unique_module_id[ix][iy] > get_num_gsb_unique_module()) {
+      valid_ids = false;
+      break;
+    }
+    if (gsb_unique_module_id[ix][iy] == get_num_gsb_unique_module()) {
+      add_gsb_unique_module(gsb_coordinate);
+    }
+    gsb_unique_module_id_[ix][iy] = gsb_unique_module_id[ix][iy];
+  }
+
+  if (false == valid_ids) {
+    clear_sb_unique_module();
+    clear_cb_unique_module(CHANX);
+    clear_cb_unique_module(CHANY);
+    clear_gsb_unique_module();
+  }
+
+  return valid_ids;
+}
+
 void DeviceRRGSB::add_gsb_unique_module(const vtr::Point<size_t>& coordinate) {
   gsb_unique_module_.push_back(coordinate); 
 }
@@ -27,7 +27,10 @@ namespace openfpga {
 class DeviceRRGSB {
   public: /* Contructors */
   public: /* Accessors */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
     vtr::Point<size_t> get_gsb_range() const; /* get the max coordinate of the switch block array */
+    std::vector<vtr::Point<size_t>> get_gsb_coordinates() const; /* Get the coordinates of all the GSBs in the array */
     const RRGSB& get_gsb(const vtr::Point<size_t>& coordinate) const; /* Get a rr switch block in the array with a coordinate */
     const RRGSB& get_gsb(const size_t& x, const size_t& y) const; /* Get a rr switch block in the array with a coordinate */
     size_t get_num_gsb_unique_module() const; /* get the number of unique mirrors of GSB */
@@ -38,14 +41,32 @@ class DeviceRRGSB {
     const RRGSB& get_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const;
     size_t get_num_cb_unique_module(const t_rr_type& cb_type) const; /* get the number of unique mirrors of CBs */
     bool is_gsb_exist(const vtr::Point<size_t> coord) const;
+    size_t get_sb_unique_module_id(const vtr::Point<size_t>& coordinate) const; /* Get the id of the unique mirror of a switch block */
+    size_t get_cb_unique_module_id(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate) const; /* Get the id of the unique mirror of a connection block */
+    size_t get_gsb_unique_module_id(const vtr::Point<size_t>& coordinate) const; /* Get the id of the unique mirror of a GSB */
   public: /* Mutators */ 
     void reserve(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_switch_block array that the device requires */ 
     void reserve_sb_unique_submodule_id(const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_sb_unique_module_id matrix that the device requires */ 
     void resize_upon_need(const vtr::Point<size_t>& coordinate); /* Resize the rr_switch_block array if needed */ 
     void add_rr_gsb(const vtr::Point<size_t>& coordinate, const RRGSB& rr_gsb); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void add_rr_gsb(const vtr::Point<size_t>& coordinate, RRGSB&& rr_gsb); /* Move a switch block to the array, without copying its content */
+    /* Store once the routing channels which are shared by two adjacent GSBs,
+     * i.e., the TOP side of GSB[x][y] and the BOTTOM side of GSB[x][y+1],
+     * and the RIGHT side of GSB[x][y] and the LEFT side of GSB[x+1][y]
+     * Return the number of routing channels which are shared
+     */
+    size_t share_chan_nodes();
     RRGSB& get_mutable_gsb(const vtr::Point<size_t>& coordinate); /* Get a rr switch block in the array with a coordinate */
     RRGSB& get_mutable_gsb(const size_t& x, const size_t& y); /* Get a rr switch block in the array with a coordinate */
-    void build_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Identify the unique mirrors of GSBs, whose signatures are computed with a number of threads (0 means all the cores) */
+    /* Restore the unique mirrors from the ids found by build_unique_module() on the same GSBs, e.g., in a previous run
+     * Each matrix is indexed by the coordinates of GSBs
+     * Return false if the ids do not match the GSB array, in which case no unique mirror is restored
+     */
+    bool restore_unique_module(const std::vector<std::vector<size_t>>& sb_unique_module_id,
+                               const std::vector<std::vector<size_t>>& cbx_unique_module_id,
+                               const std::vector<std::vector<size_t>>& cby_unique_module_id,
+                               const std::vector<std::vector<size_t>>& gsb_unique_module_id);
     void clear(); /* clean the content */
   private: /* Internal cleaners */
     void clear_gsb(); /* clean the content */
@@ -65,8 +86,8 @@ class DeviceRRGSB {
     void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
     void add_cb_unique_module(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate);
     void set_cb_unique_module_id(const t_rr_type& cb_type, const vtr::Point<size_t>& coordinate, size_t id);
-    void build_sb_unique_module(const RRGraph& rr_graph); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
-    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
+    void build_sb_unique_module(const RRGraph& rr_graph, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
+    void build_cb_unique_module(const RRGraph& rr_graph, const t_rr_type& cb_type, const size_t& num_threads); /* Add a switch block to the array, which will automatically identify and update the lists of unique side module */
     void build_gsb_unique_module(); /* Add a switch block to the array, which will automatically identify and update the lists of unique mirrors and rotatable mirrors */
   private: /* Internal Data */
     std::vector<std::vector<RRGSB>> rr_gsb_;
@@ -0,0 +1,287 @@
+/********************************************************************
+ * This file includes functions to save the unique mirrors of a
+ * DeviceRRGSB to a binary cache file, and to load them back,
+ * so that the mirror analysis can be skipped on repeated runs
+ *
+ * The file is a sequence of 64-bit words:
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   magic number "OFPGAGSB"                            |
+ *   |   endian marker 0x0102030405060708                   |
+ *   |   format version                                     |
+ *   |   fingerprint of the GSBs and the rr_graph           |
+ *   +------------------------------------------------------+
+ *   | GSB array                                            |
+ *   |   number of GSBs in x direction                      |
+ *   |   number of GSBs in y direction                      |
+ *   +------------------------------------------------------+
+ *   | Unique module ids, GSB by GSB                        |
+ *   |   per GSB: SB id, CBX id, CBY id, GSB id             |
+ *   +------------------------------------------------------+
+ *
+ * The unique mirrors themselves are not stored, as they are
+ * the first GSBs of each id (see DeviceRRGSB::restore_unique_module())
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_hash.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+#include "openfpga_digest.h"
+
+#include "device_rr_gsb_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the fingerprint of the GSBs and the rr_graph nodes and edges,
+ * which are all the inputs of the mirror analysis.
+ * The fingerprint changes with the architecture, the device,
+ * the routing channels and the sorting of the edges in GSBs
+ *******************************************************************/
+uint64_t find_device_rr_gsb_fingerprint(const DeviceRRGSB& device_rr_gsb,
+                                        const RRGraph& rr_graph) {
+  size_t fingerprint = 0;
+
+  vtr::hash_combine(fingerprint, rr_graph.nodes().size());
+  for (const RRNodeId& node : rr_graph.nodes()) {
+    vtr::hash_combine(fingerprint, size_t(rr_graph.node_type(node)));
+    vtr::hash_combine(fingerprint, rr_graph.node_xlow(node));
+    vtr::hash_combine(fingerprint, rr_graph.node_ylow(node));
+    vtr::hash_combine(fingerprint, rr_graph.node_xhigh(node));
+    vtr::hash_combine(fingerprint, rr_graph.node_yhigh(node));
+    if ((CHANX == rr_graph.node_type(node)) || (CHANY == rr_graph.node_type(node))) {
+      vtr::hash_combine(fingerprint, size_t(rr_graph.node_direction(node)));
+    }
+  }
+
+  vtr::hash_combine(fingerprint, rr_graph.edges().size());
+  for (const RREdgeId& edge : rr_graph.edges()) {
+    vtr::hash_combine(fingerprint, size_t(rr_graph.edge_src_node(edge)));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.edge_sink_node(edge)));
+    vtr::hash_combine(fingerprint, size_t(rr_graph.edge_switch(edge)));
+  }
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  vtr::hash_combine(fingerprint, gsb_range.x());
+  vtr::hash_combine(fingerprint, gsb_range.y());
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      if (false == device_rr_gsb.is_gsb_exist(gsb_coordinate)) {
+        continue;
+      }
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coordinate);
+      vtr::hash_combine(fingerprint, ix);
+      vtr::hash_combine(fingerprint, iy);
+      vtr::hash_combine(fingerprint, rr_gsb.get_num_sides());
+      for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+        SideManager side_manager(side);
+        e_side gsb_side = side_manager.get_side();
+
+        vtr::hash_combine(fingerprint, rr_gsb.get_chan_width(gsb_side));
+        for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(gsb_side); ++itrack) {
+          vtr::hash_combine(fingerprint, size_t(rr_gsb.get_chan_node(gsb_side, itrack)));
+          vtr::hash_combine(fingerprint, size_t(rr_gsb.get_chan_node_direction(gsb_side, itrack)));
+          vtr::hash_combine(fingerprint, size_t(rr_gsb.get_chan_node_segment(gsb_side, itrack)));
+          if (OUT_PORT != rr_gsb.get_chan_node_direction(gsb_side, itrack)) {
+            continue;
+          }
+          /* The order of incoming edges matters to the mirror analysis */
+          for (const RREdgeId& edge : rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, itrack)) {
+            vtr::hash_combine(fingerprint, size_t(edge));
+          }
+        }
+
+        vtr::hash_combine(fingerprint, rr_gsb.get_num_ipin_nodes(gsb_side));
+        for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(gsb_side); ++inode) {
+          vtr::hash_combine(fingerprint, size_t(rr_gsb.get_ipin_node(gsb_side, inode)));
+        }
+        vtr::hash_combine(fingerprint, rr_gsb.get_num_opin_nodes(gsb_side));
+        for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(gsb_side); ++inode) {
+          vtr::hash_combine(fingerprint, size_t(rr_gsb.get_opin_node(gsb_side, inode)));
+        }
+      }
+    }
+  }
+
+  return fingerprint;
+}
+
+/********************************************************************
+ * Append a word to the buffer of a cache file
+ *******************************************************************/
+static
+void append_device_rr_gsb_cache_word(std::string& buffer,
+                                     const uint64_t& word) {
+  buffer.append(reinterpret_cast<const char*>(&word), sizeof(uint64_t));
+}
+
+/********************************************************************
+ * Write the unique module ids of all the GSBs to a binary file
+ * The file can be read back by read_device_rr_gsb_unique_module_from_binary_file()
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_device_rr_gsb_unique_module_to_binary_file(const DeviceRRGSB& device_rr_gsb,
+                                                     const uint64_t& fingerprint,
+                                                     const std::string& fname,
+                                                     const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output unique GSB cache!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write unique GSBs into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  std::string buffer(DEVICE_RR_GSB_CACHE_MAGIC, sizeof(uint64_t));
+  append_device_rr_gsb_cache_word(buffer, DEVICE_RR_GSB_CACHE_ENDIAN_MARKER);
+  append_device_rr_gsb_cache_word(buffer, DEVICE_RR_GSB_CACHE_VERSION);
+  append_device_rr_gsb_cache_word(buffer, fingerprint);
+
+  /* The GSB array is always allocated as a full matrix by DeviceRRGSB::reserve() */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  append_device_rr_gsb_cache_word(buffer, gsb_range.x());
+  append_device_rr_gsb_cache_word(buffer, gsb_range.y());
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      append_device_rr_gsb_cache_word(buffer, device_rr_gsb.get_sb_unique_module_id(gsb_coordinate));
+      append_device_rr_gsb_cache_word(buffer, device_rr_gsb.get_cb_unique_module_id(CHANX, gsb_coordinate));
+      append_device_rr_gsb_cache_word(buffer, device_rr_gsb.get_cb_unique_module_id(CHANY, gsb_coordinate));
+      append_device_rr_gsb_cache_word(buffer, device_rr_gsb.get_gsb_unique_module_id(gsb_coordinate));
+    }
+  }
+  fp.write(buffer.data(), buffer.size());
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write unique GSBs to binary file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu unique GSBs to binary file: %s\n",
+           device_rr_gsb.get_num_gsb_unique_module(),
+           fname.c_str());
+
+  return status;
+}
+
+/********************************************************************
+ * Read the unique module ids of all the GSBs from a binary file,
+ * which is written by write_device_rr_gsb_unique_module_to_binary_file()
+ * The unique modules are restored only if the fingerprint matches,
+ * so that the caller can identify the unique modules from scratch otherwise
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the unique modules can not be restored
+ *******************************************************************/
+int read_device_rr_gsb_unique_module_from_binary_file(DeviceRRGSB& device_rr_gsb,
+                                                      const uint64_t& fingerprint,
+                                                      const std::string& fname,
+                                                      const bool& verbose) {
+  /* Load the file, which is always a sequence of words */
+  std::ifstream fp(fname, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    VTR_LOGV(verbose,
+             "Unable to open unique GSB cache file '%s'\n",
+             fname.c_str());
+    return 1;
+  }
+
+  std::string timer_message = std::string("Read unique GSBs from binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  size_t file_size = fp.tellg();
+  std::vector<uint64_t> words(file_size / sizeof(uint64_t), 0);
+  fp.seekg(0);
+  fp.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint64_t));
+  if ((!fp.good()) || (0 != file_size % sizeof(uint64_t))) {
+    VTR_LOG_WARN("Fail to read unique GSB cache file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  fp.close();
+
+  /* Check the header */
+  if ((4 > words.size())
+     || (0 != std::memcmp(&words[0], DEVICE_RR_GSB_CACHE_MAGIC, sizeof(uint64_t)))
+     || (DEVICE_RR_GSB_CACHE_ENDIAN_MARKER != words[1])
+     || (DEVICE_RR_GSB_CACHE_VERSION != words[2])) {
+    VTR_LOG_WARN("File '%s' is not a unique GSB cache of this version or written by a machine with a different byte order!\n",
+                  fname.c_str());
+    return 1;
+  }
+  if (fingerprint != words[3]) {
+    VTR_LOG_WARN("Unique GSB cache file '%s' is built from different GSBs!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* Check the GSB array, whose ids should fill the rest of the file */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  if ((6 > words.size())
+     || (gsb_range.x() != words[4])
+     || (gsb_range.y() != words[5])
+     || (words.size() - 6 != 4 * gsb_range.x() * gsb_range.y())) {
+    VTR_LOG_WARN("Unique GSB cache file '%s' is corrupted!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  std::vector<std::vector<size_t>> sb_unique_module_id(gsb_range.x(), std::vector<size_t>(gsb_range.y()));
+  std::vector<std::vector<size_t>> cbx_unique_module_id(gsb_range.x(), std::vector<size_t>(gsb_range.y()));
+  std::vector<std::vector<size_t>> cby_unique_module_id(gsb_range.x(), std::vector<size_t>(gsb_range.y()));
+  std::vector<std::vector<size_t>> gsb_unique_module_id(gsb_range.x(), std::vector<size_t>(gsb_range.y()));
+  size_t offset = 6;
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      sb_unique_module_id[ix][iy] = words[offset++];
+      cbx_unique_module_id[ix][iy] = words[offset++];
+      cby_unique_module_id[ix][iy] = words[offset++];
+      gsb_unique_module_id[ix][iy] = words[offset++];
+    }
+  }
+
+  if (false == device_rr_gsb.restore_unique_module(sb_unique_module_id,
+                                                   cbx_unique_module_id,
+                                                   cby_unique_module_id,
+                                                   gsb_unique_module_id)) {
+    VTR_LOG_WARN("Unique GSB cache file '%s' does not match the GSBs!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  VTR_LOGV(verbose,
+           "Loaded %lu unique GSBs from binary file: %s\n",
+           device_rr_gsb.get_num_gsb_unique_module(),
+           fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,41 @@
+#ifndef DEVICE_RR_GSB_CACHE_H
+#define DEVICE_RR_GSB_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include "rr_graph_obj.h"
+#include "device_rr_gsb.h"
+
+/********************************************************************
+ * Constants for the binary file format of unique GSB caches
+ *******************************************************************/
+constexpr char DEVICE_RR_GSB_CACHE_MAGIC[] = "OFPGAGSB";
+constexpr uint64_t DEVICE_RR_GSB_CACHE_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t DEVICE_RR_GSB_CACHE_VERSION = 1;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+uint64_t find_device_rr_gsb_fingerprint(const DeviceRRGSB& device_rr_gsb,
+                                        const RRGraph& rr_graph);
+
+int write_device_rr_gsb_unique_module_to_binary_file(const DeviceRRGSB& device_rr_gsb,
+                                                     const uint64_t& fingerprint,
+                                                     const std::string& fname,
+                                                     const bool& verbose);
+
+int read_device_rr_gsb_unique_module_from_binary_file(DeviceRRGSB& device_rr_gsb,
+                                                      const uint64_t& fingerprint,
+                                                      const std::string& fname,
+                                                      const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,274 @@
+/***************************************************************************************
+ * Restore the internal structure of DeviceRRGSB from the XML files
+ * written by write_device_rr_gsb_to_xml(), one file per GSB,
+ * so that the GSBs do not have to be built again from the rr_graph
+ *
+ * Only the nodes of the GSBs are restored. The unique mirrors are not in the files:
+ * they can be found by DeviceRRGSB::build_unique_module() or loaded from a cache
+ ***************************************************************************************/
+#include <string>
+
+/* Headers from pugi XML library */
+#include "pugixml.hpp"
+#include "pugixml_util.hpp"
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_side_manager.h"
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+
+#include "openfpga_naming.h"
+
+#include "read_xml_device_rr_gsb.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/***************************************************************************************
+ * Find the side of a GSB from its name, e.g., 'top'
+ * Return NUM_SIDES if the name is not a side of the GSB
+ ***************************************************************************************/
+static
+e_side find_rr_gsb_xml_side(const std::string& side_name,
+                            const size_t& num_sides) {
+  for (size_t side = 0; side < num_sides; ++side) {
+    SideManager side_manager(side);
+    if (side_name == side_manager.to_string()) {
+      return side_manager.get_side();
+    }
+  }
+  return NUM_SIDES;
+}
+
+/***************************************************************************************
+ * Find a node of the rr_graph from a 'node_id' attribute, which should be of a given type
+ * Return an invalid id otherwise
+ ***************************************************************************************/
+static
+RRNodeId find_rr_gsb_xml_node(const pugi::xml_node& xml_node,
+                              const pugiutil::loc_data& loc_data,
+                              const RRGraph& rr_graph,
+                              const t_rr_type& node_type) {
+  RRNodeId node = RRNodeId(get_attribute(xml_node, "node_id", loc_data).as_ullong());
+  if ((false == rr_graph.valid_node_id(node))
+     || (node_type != rr_graph.node_type(node))) {
+    return RRNodeId::INVALID();
+  }
+  return node;
+}
+
+/***************************************************************************************
+ * Restore a RRGSB from an XML file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the file does not describe the GSB on the rr_graph, with a message
+ ***************************************************************************************/
+static
+int read_xml_rr_gsb(RRGSB& rr_gsb,
+                    std::string& error_msg,
+                    const std::string& fname,
+                    const RRGraph& rr_graph,
+                    const vtr::Point<size_t>& gsb_coordinate,
+                    const bool& require_sorted_in_edges) {
+  pugi::xml_document doc;
+  pugiutil::loc_data loc_data;
+  try {
+    loc_data = pugiutil::load_xml(doc, fname.c_str());
+    pugi::xml_node xml_root = get_single_child(doc, "rr_gsb", loc_data);
+
+    if ((gsb_coordinate.x() != get_attribute(xml_root, "x", loc_data).as_ullong())
+       || (gsb_coordinate.y() != get_attribute(xml_root, "y", loc_data).as_ullong())) {
+      error_msg = "the coordinate is not the one of the GSB";
+      return 1;
+    }
+    if ((rr_graph.nodes().size() != get_attribute(xml_root, "num_rr_nodes", loc_data).as_ullong())
+       || (rr_graph.edges().size() != get_attribute(xml_root, "num_rr_edges", loc_data).as_ullong())) {
+      error_msg = "it is written with a different routing resource graph";
+      return 1;
+    }
+    bool sorted_in_edges = get_attribute(xml_root, "sorted_in_edges", loc_data).as_bool();
+    if ((true == require_sorted_in_edges) && (false == sorted_in_edges)) {
+      error_msg = "the incoming edges of routing tracks are not sorted";
+      return 1;
+    }
+
+    size_t num_sides = get_attribute(xml_root, "num_sides", loc_data).as_ullong();
+    rr_gsb.clear();
+    rr_gsb.set_coordinate(gsb_coordinate.x(), gsb_coordinate.y());
+    rr_gsb.init_num_sides(num_sides);
+
+    /* The incoming edges are set once all the routing channels are added */
+    std::vector<std::pair<e_side, size_t>> in_edge_tracks;
+    std::vector<std::vector<RREdgeId>> track_in_edges;
+
+    for (pugi::xml_node xml_child : xml_root.children()) {
+      std::string child_name(xml_child.name());
+      /* The drivers of routing tracks in the switch block part are not needed */
+      if ((child_name != "IPIN") && (child_name != "chan") && (child_name != "opin")) {
+        continue;
+      }
+
+      e_side side = find_rr_gsb_xml_side(get_attribute(xml_child, "side", loc_data).as_string(), num_sides);
+      if (NUM_SIDES == side) {
+        error_msg = std::string("invalid side at line ") + std::to_string(loc_data.line(xml_child));
+        return 1;
+      }
+
+      if (child_name == "IPIN") {
+        RRNodeId node = find_rr_gsb_xml_node(xml_child, loc_data, rr_graph, IPIN);
+        if ((false == rr_graph.valid_node_id(node))
+           || (rr_gsb.get_num_ipin_nodes(side) != get_attribute(xml_child, "index", loc_data).as_ullong())) {
+          error_msg = std::string("invalid IPIN at line ") + std::to_string(loc_data.line(xml_child));
+          return 1;
+        }
+        rr_gsb.add_ipin_node(node, side);
+        continue;
+      }
+
+      if (child_name == "opin") {
+        RRNodeId node = find_rr_gsb_xml_node(xml_child, loc_data, rr_graph, OPIN);
+        if ((false == rr_graph.valid_node_id(node))
+           || (rr_gsb.get_num_opin_nodes(side) != get_attribute(xml_child, "index", loc_data).as_ullong())) {
+          error_msg = std::string("invalid OPIN at line ") + std::to_string(loc_data.line(xml_child));
+          return 1;
+        }
+        rr_gsb.add_opin_node(node, side);
+        continue;
+      }
+
+      /* Routing channel */
+      std::string chan_type_name = get_attribute(xml_child, "type", loc_data).as_string();
+      t_rr_type chan_type = NUM_RR_TYPES;
+      if (chan_type_name == rr_node_typename[CHANX]) {
+        chan_type = CHANX;
+      } else if (chan_type_name == rr_node_typename[CHANY]) {
+        chan_type = CHANY;
+      } else {
+        error_msg = std::string("invalid channel type at line ") + std::to_string(loc_data.line(xml_child));
+        return 1;
+      }
+
+      RRChan rr_chan;
+      rr_chan.set_type(chan_type);
+      std::vector<enum PORTS> rr_chan_dir;
+      for (pugi::xml_node xml_track : xml_child.children()) {
+        if (xml_track.name() != std::string("track")) {
+          error_msg = std::string("unexpected child '") + xml_track.name() + std::string("' at line ") + std::to_string(loc_data.line(xml_track));
+          return 1;
+        }
+        RRNodeId node = find_rr_gsb_xml_node(xml_track, loc_data, rr_graph, chan_type);
+        RRSegmentId segment = RRSegmentId(get_attribute(xml_track, "segment_id", loc_data).as_ullong());
+        std::string direction = get_attribute(xml_track, "direction", loc_data).as_string();
+        if ((false == rr_graph.valid_node_id(node))
+           || (false == rr_graph.valid_segment_id(segment))
+           || (rr_chan_dir.size() != get_attribute(xml_track, "index", loc_data).as_ullong())
+           || ((direction != "in") && (direction != "out"))) {
+          error_msg = std::string("invalid routing track at line ") + std::to_string(loc_data.line(xml_track));
+          return 1;
+        }
+
+        if ((direction == "out") && (true == sorted_in_edges)) {
+          std::vector<RREdgeId> in_edges;
+          for (pugi::xml_node xml_in_edge : xml_track.children()) {
+            if (xml_in_edge.name() != std::string("in_edge")) {
+              error_msg = std::string("unexpected child '") + xml_in_edge.name() + std::string("' at line ") + std::to_string(loc_data.line(xml_in_edge));
+              return 1;
+            }
+            RREdgeId edge = RREdgeId(get_attribute(xml_in_edge, "id", loc_data).as_ullong());
+            if ((false == rr_graph.valid_edge_id(edge))
+               || (node != rr_graph.edge_sink_node(edge))) {
+              error_msg = std::string("invalid incoming edge at line ") + std::to_string(loc_data.line(xml_in_edge));
+              return 1;
+            }
+            in_edges.push_back(edge);
+          }
+          in_edge_tracks.push_back(std::make_pair(side, rr_chan_dir.size()));
+          track_in_edges.push_back(in_edges);
+        }
+
+        rr_chan.add_node(rr_graph, node, segment);
+        rr_chan_dir.push_back(direction == "out" ? OUT_PORT : IN_PORT);
+      }
+      rr_gsb.add_chan_node(side, rr_chan, rr_chan_dir);
+    }
+
+    for (size_t itrack = 0; itrack < in_edge_tracks.size(); ++itrack) {
+      rr_gsb.set_chan_node_in_edges(in_edge_tracks[itrack].first, in_edge_tracks[itrack].second, track_in_edges[itrack]);
+    }
+  } catch (pugiutil::XmlError& e) {
+    error_msg = std::string(e.what()) + std::string(" (line ") + std::to_string(e.line()) + std::string(")");
+    return 1;
+  }
+
+  return 0;
+}
+
+/***************************************************************************************
+ * Restore all the RRGSBs of a DeviceRRGSB from the XML files in a directory,
+ * which should contain a file for each GSB, i.e., written without the unique option
+ * The files are independent, so they are read in parallel
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if any GSB can not be restored, in which case the DeviceRRGSB is cleared
+ *    so that the caller can build the GSBs from scratch
+ ***************************************************************************************/
+int read_device_rr_gsb_from_xml(DeviceRRGSB& device_rr_gsb,
+                                const char* sb_xml_dir,
+                                const RRGraph& rr_graph,
+                                const vtr::Point<size_t>& gsb_range,
+                                const bool& require_sorted_in_edges,
+                                const size_t& num_threads,
+                                const bool& verbose) {
+  std::string xml_dir_name = format_dir_path(std::string(sb_xml_dir));
+
+  std::string timer_message = std::string("Read General Switch Blocks (GSBs) from XML files in directory '") + xml_dir_name + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  device_rr_gsb.clear();
+  device_rr_gsb.reserve(gsb_range);
+
+  std::vector<vtr::Point<size_t>> gsb_coordinates = device_rr_gsb.get_gsb_coordinates();
+  std::vector<int> gsb_status(gsb_coordinates.size(), 0);
+  std::vector<std::string> gsb_error_msgs(gsb_coordinates.size());
+  parallel_for(gsb_coordinates.size(), find_num_threads(num_threads), [&](const size_t& igsb) {
+    std::string fname = xml_dir_name + generate_switch_block_module_name(gsb_coordinates[igsb]) + std::string(".xml");
+    gsb_status[igsb] = read_xml_rr_gsb(device_rr_gsb.get_mutable_gsb(gsb_coordinates[igsb]),
+                                       gsb_error_msgs[igsb],
+                                       fname,
+                                       rr_graph,
+                                       gsb_coordinates[igsb],
+                                       require_sorted_in_edges);
+  });
+
+  /* Report the first GSB failing, in the order of coordinates */
+  for (size_t igsb = 0; igsb < gsb_coordinates.size(); ++igsb) {
+    if (0 != gsb_status[igsb]) {
+      VTR_LOG_WARN("Unable to restore the GSB [%lu][%lu] from directory '%s': %s\n",
+                   gsb_coordinates[igsb].x(), gsb_coordinates[igsb].y(),
+                   xml_dir_name.c_str(),
+                   gsb_error_msgs[igsb].c_str());
+      device_rr_gsb.clear();
+      return 1;
+    }
+  }
+
+  /* Each routing channel is stored once, as built by annotate_device_rr_gsb() */
+  size_t num_shared_chans = device_rr_gsb.share_chan_nodes();
+  VTR_LOGV(verbose,
+           "Shared %lu routing channels between adjacent GSBs\n",
+           num_shared_chans);
+
+  VTR_LOG("Restored %lu General Switch Blocks (GSBs) from XML files.\n",
+          gsb_coordinates.size());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
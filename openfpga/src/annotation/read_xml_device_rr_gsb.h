@@ -0,0 +1,29 @@
+#ifndef READ_XML_DEVICE_RR_GSB_H
+#define READ_XML_DEVICE_RR_GSB_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vtr_geometry.h"
+#include "rr_graph_obj.h"
+#include "device_rr_gsb.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_device_rr_gsb_from_xml(DeviceRRGSB& device_rr_gsb,
+                                const char* sb_xml_dir,
+                                const RRGraph& rr_graph,
+                                const vtr::Point<size_t>& gsb_range,
+                                const bool& require_sorted_in_edges,
+                                const size_t& num_threads,
+                                const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -89,6 +89,26 @@ size_t VprBitstreamAnnotation::interconnect_default_path_id(t_interconnect* inte
   return DEFAULT_PATH_ID;
 }
 
+const VprBitstreamAnnotation::t_eblif_bitstream* VprBitstreamAnnotation::pb_type_eblif_bitstream(t_pb_type* pb_type) const {
+  auto result = eblif_bitstreams_.find(pb_type);
+  if (result != eblif_bitstreams_.end()) {
+    return &(result->second);
+  }
+
+  /* Not found, the bitstream is not from eblif */
+  return nullptr;
+}
+
+const VprBitstreamAnnotation::t_eblif_bitstream* VprBitstreamAnnotation::pb_type_mode_select_eblif_bitstream(t_pb_type* pb_type) const {
+  auto result = mode_select_eblif_bitstreams_.find(pb_type);
+  if (result != mode_select_eblif_bitstreams_.end()) {
+    return &(result->second);
+  }
+
+  /* Not found, the mode-select bitstream is not from eblif */
+  return nullptr;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -127,4 +147,14 @@ void VprBitstreamAnnotation::set_interconnect_default_path_id(t_interconnect* in
   interconnect_default_path_ids_[interconnect] = default_path_id;
 }
 
+void VprBitstreamAnnotation::set_pb_type_eblif_bitstream(t_pb_type* pb_type,
+                                                         const t_eblif_bitstream& eblif_bitstream) {
+  eblif_bitstreams_[pb_type] = eblif_bitstream;
+}
+
+void VprBitstreamAnnotation::set_pb_type_mode_select_eblif_bitstream(t_pb_type* pb_type,
+                                                                     const t_eblif_bitstream& eblif_bitstream) {
+  mode_select_eblif_bitstreams_[pb_type] = eblif_bitstream;
+}
+
 } /* End namespace openfpga*/
@@ -28,6 +28,15 @@ class VprBitstreamAnnotation {
       BITSTREAM_SOURCE_EBLIF,
       NUM_BITSTREAM_SOURCE_TYPES
     };
+    /* A bitstream taken from the eblif file, whose content
+     * '<.param|.attr> <identifier>' is parsed once when annotating the bitstream setting
+     */
+    struct t_eblif_bitstream {
+      /* Take the bitstream from an attribute (.attr) rather than a parameter (.param) */
+      bool is_attr;
+      std::string identifier;
+      size_t offset;
+    };
   public:  /* Constructor */
     VprBitstreamAnnotation();
   public:  /* Public accessors */
@@ -39,6 +48,10 @@ class VprBitstreamAnnotation {
     std::string pb_type_mode_select_bitstream_content(t_pb_type* pb_type) const;
     size_t pb_type_mode_select_bitstream_offset(t_pb_type* pb_type) const;
     size_t interconnect_default_path_id(t_interconnect* interconnect) const;
+
+    /* Return nullptr if the (mode-select) bitstream of the pb_type is not taken from the eblif file */
+    const t_eblif_bitstream* pb_type_eblif_bitstream(t_pb_type* pb_type) const;
+    const t_eblif_bitstream* pb_type_mode_select_eblif_bitstream(t_pb_type* pb_type) const;
   public:  /* Public mutators */
     void set_pb_type_bitstream_source(t_pb_type* pb_type,
                                       const e_bitstream_source_type& bitstream_source);
@@ -55,6 +68,11 @@ class VprBitstreamAnnotation {
                                                   const size_t& offset);
     void set_interconnect_default_path_id(t_interconnect* interconnect,
                                           const size_t& default_path_id);
+
+    void set_pb_type_eblif_bitstream(t_pb_type* pb_type,
+                                     const t_eblif_bitstream& eblif_bitstream);
+    void set_pb_type_mode_select_eblif_bitstream(t_pb_type* pb_type,
+                                                 const t_eblif_bitstream& eblif_bitstream);
   private: /* Internal data */
     /* For regular bitstreams */
     /* A look up for pb type to find bitstream source type */
@@ -77,6 +95,12 @@ class VprBitstreamAnnotation {
      * of inputs in the context of the interconnect input string
      */
     std::map<t_interconnect*, size_t> interconnect_default_path_ids_;
+
+    /* Parsed bitstream contents and offsets of the pb_types whose bitstreams are taken from the eblif file,
+     * which are looked up once for each primitive in repack
+     */
+    std::map<t_pb_type*, t_eblif_bitstream> eblif_bitstreams_;
+    std::map<t_pb_type*, t_eblif_bitstream> mode_select_eblif_bitstreams_;
 };
 
 } /* End namespace openfpga*/
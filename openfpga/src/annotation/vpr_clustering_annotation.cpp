@@ -20,15 +20,15 @@ VprClusteringAnnotation::VprClusteringAnnotation() {
  ***********************************************************************/
 bool VprClusteringAnnotation::is_net_renamed(const ClusterBlockId& block_id, const int& pin_index) const {
   /* Ensure that the block_id is in the list */
-  if (net_names_.end() == net_names_.find(block_id)) {
+  if (size_t(block_id) >= net_names_.size()) {
     return false;
   }
-  return (net_names_.at(block_id).end() != net_names_.at(block_id).find(pin_index));
+  return (net_names_[block_id].end() != net_names_[block_id].find(pin_index));
 }
 
 ClusterNetId VprClusteringAnnotation::net(const ClusterBlockId& block_id, const int& pin_index) const {
   VTR_ASSERT(true == is_net_renamed(block_id, pin_index));
-  return net_names_.at(block_id).at(pin_index);
+  return net_names_[block_id].at(pin_index);
 }
 
 bool VprClusteringAnnotation::is_truth_table_adapted(t_pb* pb) const {
@@ -36,17 +36,18 @@ bool VprClusteringAnnotation::is_truth_table_adapted(t_pb* pb) const {
   return (block_truth_tables_.end() != block_truth_tables_.find(pb));
 }
 
-AtomNetlist::TruthTable VprClusteringAnnotation::truth_table(t_pb* pb) const {
+const AtomNetlist::TruthTable& VprClusteringAnnotation::truth_table(t_pb* pb) const {
   VTR_ASSERT(true == is_truth_table_adapted(pb));
   return block_truth_tables_.at(pb);
 }
 
-PhysicalPb VprClusteringAnnotation::physical_pb(const ClusterBlockId& block_id) const {
-  if (physical_pbs_.end() == physical_pbs_.find(block_id)) {
-    return PhysicalPb();
+const PhysicalPb& VprClusteringAnnotation::physical_pb(const ClusterBlockId& block_id) const {
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    static const PhysicalPb empty_physical_pb;
+    return empty_physical_pb;
   }
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
 /************************************************************************
@@ -55,12 +56,14 @@ PhysicalPb VprClusteringAnnotation::physical_pb(const ClusterBlockId& block_id)
 void VprClusteringAnnotation::rename_net(const ClusterBlockId& block_id, const int& pin_index,
                                                 const ClusterNetId& net_id) {
   /* Warn any override attempt */
-  if ( (net_names_.end() != net_names_.find(block_id))
-    && (net_names_.at(block_id).end() != net_names_.at(block_id).find(pin_index)) ) {
+  if (true == is_net_renamed(block_id, pin_index)) {
     VTR_LOG_WARN("Override the net '%ld' for block '%ld' pin '%d' with in clustering context annotation!\n",
                  size_t(net_id), size_t(block_id), pin_index);
   }
 
+  if (size_t(block_id) >= net_names_.size()) {
+    net_names_.resize(size_t(block_id) + 1);
+  }
   net_names_[block_id][pin_index] = net_id;
 }
 
@@ -75,21 +78,32 @@ void VprClusteringAnnotation::adapt_truth_table(t_pb* pb,
   block_truth_tables_[pb] = tt;
 }
 
+void VprClusteringAnnotation::reserve_physical_pbs(const size_t& num_blocks) {
+  if (num_blocks > physical_pbs_.size()) {
+    physical_pbs_.resize(num_blocks);
+  }
+}
+
 void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
-                                              const PhysicalPb& physical_pb) {
+                                              PhysicalPb&& physical_pb) {
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    physical_pbs_.resize(size_t(block_id) + 1);
+  }
+
   /* Warn any override attempt */
-  if (physical_pbs_.end() != physical_pbs_.find(block_id)) {
+  if (false == physical_pbs_[block_id].empty()) {
     VTR_LOG_WARN("Override the physical pb for clustered block %lu in clustering context annotation!\n",
                  size_t(block_id));
   }
 
-  physical_pbs_[block_id] = physical_pb;
+  physical_pbs_[block_id] = std::move(physical_pb);
 }
 
 PhysicalPb& VprClusteringAnnotation::mutable_physical_pb(const ClusterBlockId& block_id) {
-  VTR_ASSERT(physical_pbs_.end() != physical_pbs_.find(block_id));
+  VTR_ASSERT(size_t(block_id) < physical_pbs_.size());
+  VTR_ASSERT(false == physical_pbs_[block_id].empty());
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
 } /* End namespace openfpga*/
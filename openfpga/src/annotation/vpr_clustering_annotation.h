@@ -6,6 +6,9 @@
  *******************************************************************/
 #include <map> 
 
+/* Header from vtrutil library */
+#include "vtr_vector.h"
+
 /* Header from vpr library */
 #include "clustered_netlist.h"
 
@@ -34,21 +37,27 @@ class VprClusteringAnnotation {
     bool is_net_renamed(const ClusterBlockId& block_id, const int& pin_index) const;
     ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
     bool is_truth_table_adapted(t_pb* pb) const;
-    AtomNetlist::TruthTable truth_table(t_pb* pb) const;
-    PhysicalPb physical_pb(const ClusterBlockId& block_id) const;
+    const AtomNetlist::TruthTable& truth_table(t_pb* pb) const;
+    const PhysicalPb& physical_pb(const ClusterBlockId& block_id) const;
   public:  /* Public mutators */
     void rename_net(const ClusterBlockId& block_id, const int& pin_index,
                     const ClusterNetId& net_id);
     void adapt_truth_table(t_pb* pb, const AtomNetlist::TruthTable& tt);
-    void add_physical_pb(const ClusterBlockId& block_id, const PhysicalPb& physical_pb);
+    /* Allocate the physical pbs for a number of clustered blocks,
+     * after which the physical pbs of different blocks can be added concurrently
+     */
+    void reserve_physical_pbs(const size_t& num_blocks);
+    void add_physical_pb(const ClusterBlockId& block_id, PhysicalPb&& physical_pb);
     PhysicalPb& mutable_physical_pb(const ClusterBlockId& block_id);
   private: /* Internal data */
     /* Pair a regular pb_type to its physical pb_type */
-    std::map<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
+    vtr::vector<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
     std::map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
 
-    /* Link clustered blocks to physical pb (mapping results) */
-    std::map<ClusterBlockId, PhysicalPb> physical_pbs_;
+    /* Link clustered blocks to physical pb (mapping results)
+     * An empty physical pb means that the block has no mapping results
+     */
+    vtr::vector<ClusterBlockId, PhysicalPb> physical_pbs_;
 };
 
 } /* End namespace openfpga*/
@@ -266,30 +266,28 @@ int VprDeviceAnnotation::physical_pb_port_offset(t_port* operating_pb_port,
 }
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(pb_graph_pin);
-  if (it == physical_pb_graph_pins_.end()) {
+  /* Ensure that the pb_graph_pin is in the list */
+  size_t ordinal = pb_graph_pin_ordinal(pb_graph_pin);
+  if (ordinal >= physical_pb_graph_pins_.size()) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  return physical_pb_graph_pins_[ordinal];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(const RRSwitchId& rr_switch) const {
   /* Ensure that the rr_switch is in the list */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it == rr_switch_circuit_models_.end()) {
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_switch_circuit_models_.at(rr_switch);
+  return rr_switch_circuit_models_[rr_switch];
 }
 
 CircuitModelId VprDeviceAnnotation::rr_segment_circuit_model(const RRSegmentId& rr_segment) const {
-  /* Ensure that the rr_switch is in the list */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it == rr_segment_circuit_models_.end()) {
+  /* Ensure that the rr_segment is in the list */
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
     return CircuitModelId::INVALID();
   }
-  return rr_segment_circuit_models_.at(rr_segment);
+  return rr_segment_circuit_models_[rr_segment];
 }
 
 ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const {
@@ -300,10 +298,13 @@ ArchDirectId VprDeviceAnnotation::direct_annotation(const size_t& direct) const
   return direct_annotations_.at(direct);
 }
 
-LbRRGraph VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
-  /* Ensure that the rr_switch is in the list */
+const LbRRGraph& VprDeviceAnnotation::physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const {
+  /* Ensure that the rr_switch is in the list
+   * Return a reference rather than a copy, as the graph is looked up for each clustered block
+   */
   if (0 == physical_lb_rr_graphs_.count(pb_graph_head)) {
-    return LbRRGraph();
+    static const LbRRGraph empty_lb_rr_graph;
+    return empty_lb_rr_graph;
   }
   return physical_lb_rr_graphs_.at(pb_graph_head);
 }
@@ -549,13 +550,13 @@ void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(t_port* operating_pb
 void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operating_pb_graph_pin, 
                                                     t_pb_graph_pin* physical_pb_graph_pin) {
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it = physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  size_t ordinal = find_or_add_pb_graph_pin_ordinal(operating_pb_graph_pin);
+  if (nullptr != physical_pb_graph_pins_[ordinal]) {
     VTR_LOG_WARN("Override the annotation between operating pb_graph_pin '%s' and it physical pb_graph_pin '%s'!\n",
                  operating_pb_graph_pin->port->name, physical_pb_graph_pin->port->name);
   }
 
-  physical_pb_graph_pins_[operating_pb_graph_pin] = physical_pb_graph_pin;
+  physical_pb_graph_pins_[ordinal] = physical_pb_graph_pin;
 
   /* Update the accumulated offsets for the operating port 
    * Each time we pair two pins, we update the offset by the pin rotate offset
@@ -585,8 +586,9 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(const t_pb_graph_pin* operat
 
 void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switch, const CircuitModelId& circuit_model) {
   /* Warn any override attempt */
-  std::map<RRSwitchId, CircuitModelId>::const_iterator it = rr_switch_circuit_models_.find(rr_switch);
-  if (it != rr_switch_circuit_models_.end()) {
+  if (size_t(rr_switch) >= rr_switch_circuit_models_.size()) {
+    rr_switch_circuit_models_.resize(size_t(rr_switch) + 1, CircuitModelId::INVALID());
+  } else if (CircuitModelId::INVALID() != rr_switch_circuit_models_[rr_switch]) {
     VTR_LOG_WARN("Override the annotation between rr_switch '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_switch), size_t(circuit_model));
   }
@@ -596,8 +598,9 @@ void VprDeviceAnnotation::add_rr_switch_circuit_model(const RRSwitchId& rr_switc
 
 void VprDeviceAnnotation::add_rr_segment_circuit_model(const RRSegmentId& rr_segment, const CircuitModelId& circuit_model) {
   /* Warn any override attempt */
-  std::map<RRSegmentId, CircuitModelId>::const_iterator it = rr_segment_circuit_models_.find(rr_segment);
-  if (it != rr_segment_circuit_models_.end()) {
+  if (size_t(rr_segment) >= rr_segment_circuit_models_.size()) {
+    rr_segment_circuit_models_.resize(size_t(rr_segment) + 1, CircuitModelId::INVALID());
+  } else if (CircuitModelId::INVALID() != rr_segment_circuit_models_[rr_segment]) {
     VTR_LOG_WARN("Override the annotation between rr_segment '%ld' and its circuit_model '%ld'!\n",
                  size_t(rr_segment), size_t(circuit_model));
   }
@@ -637,4 +640,38 @@ void VprDeviceAnnotation::add_physical_tile_pin_subtile_index(t_physical_tile_ty
   physical_tile_pin_subtile_indices_[physical_tile][pin_index] = subtile_index;
 }
 
+/************************************************************************
+ * Private accessors and mutators
+ ***********************************************************************/
+/* Find the pb_graph head of a pb_graph_pin, which is only a few levels up */
+static 
+const t_pb_graph_node* find_pb_graph_pin_head(const t_pb_graph_pin* pb_graph_pin) {
+  const t_pb_graph_node* pb_graph_node = pb_graph_pin->parent_node;
+  while (false == pb_graph_node->is_root()) {
+    pb_graph_node = pb_graph_node->parent_pb_graph_node;
+  }
+  return pb_graph_node;
+}
+
+/* Return an out-of-range ordinal if the pb_graph head has no pins in the tables */
+size_t VprDeviceAnnotation::pb_graph_pin_ordinal(const t_pb_graph_pin* pb_graph_pin) const {
+  auto it = pb_graph_head_pin_ordinals_.find(find_pb_graph_pin_head(pb_graph_pin));
+  if (it == pb_graph_head_pin_ordinals_.end()) {
+    return size_t(-1);
+  }
+  return it->second + pb_graph_pin->pin_count_in_cluster;
+}
+
+/* Reserve the pins of a pb_graph head in the tables when its first pin is added */
+size_t VprDeviceAnnotation::find_or_add_pb_graph_pin_ordinal(const t_pb_graph_pin* pb_graph_pin) {
+  const t_pb_graph_node* pb_graph_head = find_pb_graph_pin_head(pb_graph_pin);
+  auto it = pb_graph_head_pin_ordinals_.find(pb_graph_head);
+  if (it == pb_graph_head_pin_ordinals_.end()) {
+    it = pb_graph_head_pin_ordinals_.insert(std::make_pair(pb_graph_head, physical_pb_graph_pins_.size())).first;
+    physical_pb_graph_pins_.resize(physical_pb_graph_pins_.size() + pb_graph_head->total_pb_pins, nullptr);
+  }
+  VTR_ASSERT(pb_graph_pin->pin_count_in_cluster < pb_graph_head->total_pb_pins);
+  return it->second + pb_graph_pin->pin_count_in_cluster;
+}
+
 } /* End namespace openfpga*/
@@ -8,6 +8,7 @@
 
 /* Header from vtrutil library */
 #include "vtr_strong_id.h"
+#include "vtr_vector.h"
 
 /* Header from archfpga library */
 #include "physical_types.h"
@@ -85,7 +86,7 @@ class VprDeviceAnnotation {
     CircuitModelId rr_switch_circuit_model(const RRSwitchId& rr_switch) const;
     CircuitModelId rr_segment_circuit_model(const RRSegmentId& rr_segment) const;
     ArchDirectId direct_annotation(const size_t& direct) const;
-    LbRRGraph physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
+    const LbRRGraph& physical_lb_rr_graph(t_pb_graph_node* pb_graph_head) const;
     BasicPort physical_tile_pin_port_info(t_physical_tile_type_ptr physical_tile,
                                           const int& pin_index) const;
     int physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
@@ -130,6 +131,10 @@ class VprDeviceAnnotation {
     void add_physical_tile_pin_subtile_index(t_physical_tile_type_ptr physical_tile,
                                              const int& pin_index,
                                              const int& subtile_index);
+  private: /* Internal accessors and mutators */
+    /* Get the index of a pb_graph_pin in the dense tables of pb_graph_pins */
+    size_t pb_graph_pin_ordinal(const t_pb_graph_pin* pb_graph_pin) const;
+    size_t find_or_add_pb_graph_pin_ordinal(const t_pb_graph_pin* pb_graph_pin);
   private: /* Internal data */
     /* Pair a regular pb_type to its physical pb_type */
     std::map<t_pb_type*, t_pb_type*> physical_pb_types_;
@@ -206,14 +211,22 @@ class VprDeviceAnnotation {
      */
     std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
 
-    /* Pair a pb_graph_pin to a physical pb_graph_pin */
-    std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+    /* Ordinal of the first pin of each pb_graph head in the dense tables of pb_graph_pins
+     * The ordinal of a pb_graph_pin is the ordinal of its pb_graph head
+     * plus its unique index in the cluster (pin_count_in_cluster)
+     */
+    std::map<const t_pb_graph_node*, size_t> pb_graph_head_pin_ordinals_;
+
+    /* Pair a pb_graph_pin to a physical pb_graph_pin
+     * Indexed by the ordinal of pb_graph_pin, which is nullptr if not paired
+     */
+    std::vector<t_pb_graph_pin*> physical_pb_graph_pins_;
 
     /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
-    std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
+    vtr::vector<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
 
     /* Pair a Routing Segment (rr_segment) to a circuit model */
-    std::map<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
+    vtr::vector<RRSegmentId, CircuitModelId> rr_segment_circuit_models_;
 
     /* Pair a direct connection (direct) to a annotation which contains circuit model id */
     std::map<size_t, ArchDirectId> direct_annotations_;
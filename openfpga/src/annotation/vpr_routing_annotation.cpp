@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
 #include "vpr_routing_annotation.h"
 
 /* namespace openfpga begins */
@@ -18,6 +19,12 @@ VprRoutingAnnotation::VprRoutingAnnotation() {
 /************************************************************************
  * Public accessors
  ***********************************************************************/
+size_t VprRoutingAnnotation::memory_usage() const {
+  return sizeof(VprRoutingAnnotation)
+       + heap_memory_usage(rr_node_nets_)
+       + heap_memory_usage(rr_node_prev_nodes_);
+}
+
 ClusterNetId VprRoutingAnnotation::rr_node_net(const RRNodeId& rr_node) const {
   /* Ensure that the node_id is in the list */
   VTR_ASSERT(size_t(rr_node) < rr_node_nets_.size());
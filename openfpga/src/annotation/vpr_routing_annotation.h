@@ -25,6 +25,8 @@ class VprRoutingAnnotation {
   public:  /* Constructor */
     VprRoutingAnnotation();
   public:  /* Public accessors */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
     ClusterNetId rr_node_net(const RRNodeId& rr_node) const;
     RRNodeId rr_node_prev_node(const RRNodeId& rr_node) const;
   public:  /* Public mutators */
@@ -1,5 +1,9 @@
 /***************************************************************************************
  * Output internal structure of DeviceRRGSB to XML format 
+ *
+ * Besides the switch block view (the drivers of IPINs and routing tracks),
+ * each file contains all the nodes and the sorted incoming edges of a GSB,
+ * so that the GSB can be restored by read_device_rr_gsb_from_xml()
  ***************************************************************************************/
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -9,6 +13,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_naming.h"
 #include "openfpga_rr_graph_utils.h"
@@ -19,7 +24,56 @@
 namespace openfpga {
 
 /***************************************************************************************
- * Output internal structure (only the switch block part) of a RRGSB to XML format 
+ * Output all the routing tracks and OPINs of a RRGSB to XML format,
+ * with the incoming edges of the output routing tracks if they are sorted.
+ * The IPINs are already in the switch block part
+ ***************************************************************************************/
+static 
+void write_rr_gsb_nodes_to_xml(std::fstream& fp,
+                               const RRGraph& rr_graph,
+                               const RRGSB& rr_gsb) {
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager gsb_side_manager(side);
+    enum e_side gsb_side = gsb_side_manager.get_side();
+
+    if (0 < rr_gsb.get_chan_width(gsb_side)) {
+      fp << "\t<chan side=\"" << gsb_side_manager.to_string()
+         << "\" type=\"" << rr_node_typename[rr_gsb.get_chan_type(gsb_side)]
+         << "\">"
+         << std::endl;
+      for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
+        bool write_in_edges = (OUT_PORT == rr_gsb.get_chan_node_direction(gsb_side, inode))
+                           && (true == rr_gsb.is_chan_node_in_edges_sorted());
+        fp << "\t\t<track index=\"" << inode
+           << "\" node_id=\"" << size_t(rr_gsb.get_chan_node(gsb_side, inode))
+           << "\" direction=\"" << (OUT_PORT == rr_gsb.get_chan_node_direction(gsb_side, inode) ? "out" : "in")
+           << "\" segment_id=\"" << size_t(rr_gsb.get_chan_node_segment(gsb_side, inode))
+           << (write_in_edges ? "\">" : "\"/>")
+           << std::endl;
+        if (false == write_in_edges) {
+          continue;
+        }
+        for (const RREdgeId& in_edge : rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, inode)) {
+          fp << "\t\t\t<in_edge id=\"" << size_t(in_edge) << "\"/>" << std::endl;
+        }
+        fp << "\t\t</track>" << std::endl;
+      }
+      fp << "\t</chan>" << std::endl;
+    }
+
+    for (size_t inode = 0; inode < rr_gsb.get_num_opin_nodes(gsb_side); ++inode) {
+      fp << "\t<opin side=\"" << gsb_side_manager.to_string()
+         << "\" index=\"" << inode
+         << "\" node_id=\"" << size_t(rr_gsb.get_opin_node(gsb_side, inode))
+         << "\"/>"
+         << std::endl;
+    }
+  }
+}
+
+/***************************************************************************************
+ * Output internal structure of a RRGSB to XML format:
+ * the switch block part, followed by the nodes of the GSB
  ***************************************************************************************/
 static 
 void write_rr_switch_block_to_xml(const std::string fname_prefix,
@@ -46,7 +100,10 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
 
   /* Output location of the Switch Block */
   fp << "<rr_gsb x=\"" << rr_gsb.get_x() << "\" y=\"" << rr_gsb.get_y() << "\""
-     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << std::endl;
+     << " num_sides=\"" << rr_gsb.get_num_sides() << "\""
+     << " num_rr_nodes=\"" << rr_graph.nodes().size() << "\""
+     << " num_rr_edges=\"" << rr_graph.edges().size() << "\""
+     << " sorted_in_edges=\"" << (rr_gsb.is_chan_node_in_edges_sorted() ? "true" : "false") << "\">" << std::endl;
 
   /* Output each side */ 
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -105,7 +162,8 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
       }
       /* Output drivers */
       const RRNodeId& cur_rr_node = rr_gsb.get_chan_node(gsb_side, inode);
-      std::vector<RREdgeId> driver_rr_edges = rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, inode);
+      RRGSB::edge_range in_edges = rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, inode);
+      std::vector<RREdgeId> driver_rr_edges(in_edges.begin(), in_edges.end());
 
       /* Output node information: location, index, side */
       const RRSegmentId& src_segment_id = rr_gsb.get_chan_node_segment(gsb_side, inode);
@@ -170,6 +228,8 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
     }
   }
 
+  write_rr_gsb_nodes_to_xml(fp, rr_graph, rr_gsb);
+
   fp << "</rr_gsb>" 
      << std::endl;
 
@@ -178,33 +238,37 @@ void write_rr_switch_block_to_xml(const std::string fname_prefix,
 }
 
 /***************************************************************************************
- * Output internal structure (only the switch block part) of all the RRGSBs
- * in a DeviceRRGSB  to XML format 
+ * Output internal structure of all the RRGSBs in a DeviceRRGSB to XML format,
+ * one file per GSB, or only the unique mirrors of switch blocks if required
+ * Each file is independent, so the files are written in parallel
  ***************************************************************************************/
 void write_device_rr_gsb_to_xml(const char* sb_xml_dir, 
                                 const RRGraph& rr_graph,
                                 const DeviceRRGSB& device_rr_gsb,
+                                const bool& unique,
+                                const size_t& num_threads,
                                 const bool& verbose) {
   std::string xml_dir_name = format_dir_path(std::string(sb_xml_dir));
 
   /* Create directories */
   create_directory(xml_dir_name);
 
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-
-  size_t gsb_counter = 0;
-
-  /* For each switch block, an XML file will be outputted */
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      write_rr_switch_block_to_xml(xml_dir_name, rr_graph, rr_gsb, verbose);
-      gsb_counter++;
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
+  if (true == unique) {
+    for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+      gsb_coordinates.push_back(device_rr_gsb.get_sb_unique_module(isb).get_sb_coordinate());
     }
+  } else {
+    gsb_coordinates = device_rr_gsb.get_gsb_coordinates();
   }
 
+  /* For each switch block, an XML file will be outputted */
+  parallel_for(gsb_coordinates.size(), find_num_threads(num_threads), [&](const size_t& igsb) {
+    write_rr_switch_block_to_xml(xml_dir_name, rr_graph, device_rr_gsb.get_gsb(gsb_coordinates[igsb]), verbose);
+  });
+
   VTR_LOG("Output %lu XML files to directory '%s'\n",
-          gsb_counter,
+          gsb_coordinates.size(),
           xml_dir_name.c_str());
 }
 
@@ -2,9 +2,24 @@
  * Add basic commands to the OpenFPGA shell interface, including:
  * - exit
  * - version
+ * - report_runtime
+ * - report_memory_usage
+ * - report_output_checksums
+ * - set_num_threads
  * - help
  *******************************************************************/
+#include <cstdlib>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "openfpga_title.h"
+#include "openfpga_memory_report.h"
+#include "openfpga_output_checksums.h"
+#include "openfpga_command_utils.h"
 #include "basic_command.h"
 
 /* begin namespace openfpga */
@@ -15,9 +30,18 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   ShellCommandClassId basic_cmd_class = shell.add_command_class("Basic");
 
   Command shell_cmd_exit("exit");
+  /* Add an option '--fast' */
+  shell_cmd_exit.add_option("fast", false, "exit without destroying the data of the design, which takes long for large designs. Outputs and logs are flushed before");
   ShellCommandId shell_cmd_exit_id = shell.add_command(shell_cmd_exit, "Exit the shell");
   shell.set_command_class(shell_cmd_exit_id, basic_cmd_class);
-  shell.set_command_execute_function(shell_cmd_exit_id, [shell](){shell.exit();});
+  shell.set_command_const_execute_function(shell_cmd_exit_id,
+                                           [&shell](const OpenfpgaContext&, const Command& cmd, const CommandContext& cmd_context) {
+                                             if (true == cmd_context.option_enable(cmd, cmd.option("fast"))) {
+                                               shell.set_fast_exit(true);
+                                             }
+                                             shell.exit();
+                                             return CMD_EXEC_SUCCESS;
+                                           });
 
   /* Version */
   Command shell_cmd_version("version");
@@ -25,13 +49,78 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   shell.set_command_class(shell_cmd_version_id, basic_cmd_class);
   shell.set_command_execute_function(shell_cmd_version_id, print_openfpga_version_info);
 
+  /* Runtime profile of the commands executed */
+  Command shell_cmd_report_runtime("report_runtime");
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_report_file = shell_cmd_report_runtime.add_option("file", false, "file path to output the runtime profile in JSON format");
+  shell_cmd_report_runtime.set_option_short_name(opt_report_file, "f");
+  shell_cmd_report_runtime.set_option_require_value(opt_report_file, openfpga::OPT_STRING);
+  ShellCommandId shell_cmd_report_runtime_id = shell.add_command(shell_cmd_report_runtime, "Report the wall time, CPU time and peak memory of each command executed");
+  shell.set_command_class(shell_cmd_report_runtime_id, basic_cmd_class);
+  shell.set_command_const_execute_function(shell_cmd_report_runtime_id,
+                                           [&shell](const OpenfpgaContext&, const Command& cmd, const CommandContext& cmd_context) {
+                                             shell.print_runtime_profile();
+                                             CommandOptionId opt_file = cmd.option("file");
+                                             if (true == cmd_context.option_enable(cmd, opt_file)) {
+                                               if (0 != shell.write_runtime_profile(cmd_context.option_value(cmd, opt_file))) {
+                                                 return CMD_EXEC_FATAL_ERROR;
+                                               }
+                                             }
+                                             return CMD_EXEC_SUCCESS;
+                                           });
+
+  /* Memory used by the data structures */
+  Command shell_cmd_report_memory_usage("report_memory_usage");
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_memory_file = shell_cmd_report_memory_usage.add_option("file", false, "file path to output the memory usage in JSON format");
+  shell_cmd_report_memory_usage.set_option_short_name(opt_memory_file, "f");
+  shell_cmd_report_memory_usage.set_option_require_value(opt_memory_file, openfpga::OPT_STRING);
+  ShellCommandId shell_cmd_report_memory_usage_id = shell.add_command(shell_cmd_report_memory_usage, "Report the estimated memory used by the data structures of OpenFPGA and VPR");
+  shell.set_command_class(shell_cmd_report_memory_usage_id, basic_cmd_class);
+  shell.set_command_const_execute_function(shell_cmd_report_memory_usage_id, report_memory_usage);
+
+  /* Checksums of the output files */
+  Command shell_cmd_report_output_checksums("report_output_checksums");
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_checksum_file = shell_cmd_report_output_checksums.add_option("file", true, "file path to output the checksums in the format of sha256sum");
+  shell_cmd_report_output_checksums.set_option_short_name(opt_checksum_file, "f");
+  shell_cmd_report_output_checksums.set_option_require_value(opt_checksum_file, openfpga::OPT_STRING);
+  /* Add an option '--directory' */
+  CommandOptionId opt_checksum_dir = shell_cmd_report_output_checksums.add_option("directory", false, "report the checksums of all the files under a directory, instead of the fabric netlists");
+  shell_cmd_report_output_checksums.set_option_require_value(opt_checksum_dir, openfpga::OPT_STRING);
+  /* Add an option '--verbose' */
+  shell_cmd_report_output_checksums.add_option("verbose", false, "show the checksum of each file");
+  ShellCommandId shell_cmd_report_output_checksums_id = shell.add_command(shell_cmd_report_output_checksums, "Report the SHA-256 checksums of the output files");
+  shell.set_command_class(shell_cmd_report_output_checksums_id, basic_cmd_class);
+  shell.set_command_const_execute_function(shell_cmd_report_output_checksums_id, report_output_checksums);
+
+  /* Number of threads used by the commands which do not specify '--num_threads' */
+  Command shell_cmd_set_num_threads("set_num_threads");
+  /* Add an option '--num_threads' in short '-j'*/
+  CommandOptionId opt_set_num_threads = shell_cmd_set_num_threads.add_option("num_threads", true, "number of threads used by the commands by default. Use 0 for all the cores of the machine");
+  shell_cmd_set_num_threads.set_option_short_name(opt_set_num_threads, "j");
+  shell_cmd_set_num_threads.set_option_require_value(opt_set_num_threads, openfpga::OPT_INT);
+  ShellCommandId shell_cmd_set_num_threads_id = shell.add_command(shell_cmd_set_num_threads, "Set the number of threads used by the commands by default");
+  shell.set_command_class(shell_cmd_set_num_threads_id, basic_cmd_class);
+  shell.set_command_execute_function(shell_cmd_set_num_threads_id,
+                                     [](OpenfpgaContext& openfpga_ctx, const Command& cmd, const CommandContext& cmd_context) {
+                                       int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+                                       if (0 > num_threads) {
+                                         return CMD_EXEC_FATAL_ERROR;
+                                       }
+                                       openfpga_ctx.mutable_flow_manager().set_num_threads(num_threads);
+                                       VTR_LOG("Commands will use %lu threads by default\n",
+                                               find_num_threads(num_threads));
+                                       return CMD_EXEC_SUCCESS;
+                                     });
+
   /* Note: 
    * help MUST be the last to add because the linking to execute function will do a snapshot on the shell 
    */
   Command shell_cmd_help("help");
   ShellCommandId shell_cmd_help_id = shell.add_command(shell_cmd_help, "Launch help desk");
   shell.set_command_class(shell_cmd_help_id, basic_cmd_class);
-  shell.set_command_execute_function(shell_cmd_help_id, [shell](){shell.print_commands();});
+  shell.set_command_execute_function(shell_cmd_help_id, [&shell](){shell.print_commands();});
 } 
 
 } /* end namespace openfpga */
@@ -3,6 +3,7 @@
  ******************************************************************************/
 #include "vtr_assert.h"
 
+#include "openfpga_memory_usage.h"
 #include "io_location_map.h"
 
 /* begin namespace openfpga */
@@ -11,28 +12,53 @@ namespace openfpga {
 /**************************************************
  * Public Accessors 
  *************************************************/
+size_t IoLocationMap::memory_usage() const {
+  return sizeof(IoLocationMap)
+       + heap_memory_usage(io_port_ids_)
+       + heap_memory_usage(io_indices_)
+       + heap_memory_usage(io_locations_);
+}
+
 size_t IoLocationMap::io_index(const size_t& x,
                                const size_t& y,
                                const size_t& z,
                                const std::string& io_port_name) const {
-  if (x >= io_indices_.size()) {
+  if ((x >= width_) || (y >= height_) || (z >= num_z_)) {
     return size_t(-1);
   }
 
-  if (y >= io_indices_[x].size()) {
+  size_t io_port = find_io_port(io_port_name);
+  if (size_t(-1) == io_port) {
     return size_t(-1);
   }
 
-  if (z >= io_indices_[x][y].size()) {
-    return size_t(-1);
-  }
+  return io_indices_[io_port][io_location_id(x, y, z)];
+}
 
-  auto result = io_indices_[x][y][z].find(io_port_name);
-  if (result == io_indices_[x][y][z].end()) {
-    return size_t(-1);
-  }
+vtr::Point<size_t> IoLocationMap::io_coordinate(const std::string& io_port_name,
+                                                const size_t& io_index) const {
+  size_t location = io_location(io_port_name, io_index);
+  return vtr::Point<size_t>(location / num_z_ / height_, location / num_z_ % height_);
+}
 
-  return result->second;
+size_t IoLocationMap::io_z(const std::string& io_port_name,
+                           const size_t& io_index) const {
+  return io_location(io_port_name, io_index) % num_z_;
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
+void IoLocationMap::resize_io_locations(const size_t& width,
+                                        const size_t& height,
+                                        const size_t& num_z) {
+  width_ = width;
+  height_ = height;
+  num_z_ = num_z;
+
+  io_port_ids_.clear();
+  io_indices_.clear();
+  io_locations_.clear();
 }
 
 void IoLocationMap::set_io_index(const size_t& x,
@@ -40,19 +66,51 @@ void IoLocationMap::set_io_index(const size_t& x,
                                  const size_t& z,
                                  const std::string& io_port_name,
                                  const size_t& io_index) {
-  if (x >= io_indices_.size()) {
-    io_indices_.resize(x + 1);
+  /* The location must be in the range given to resize_io_locations() */
+  VTR_ASSERT((x < width_) && (y < height_) && (z < num_z_));
+  VTR_ASSERT(size_t(-1) != io_index);
+
+  size_t io_port = find_io_port(io_port_name);
+  if (size_t(-1) == io_port) {
+    io_port = io_indices_.size();
+    io_port_ids_[io_port_name] = io_port;
+    io_indices_.emplace_back(width_ * height_ * num_z_, size_t(-1));
+    io_locations_.emplace_back();
   }
 
-  if (y >= io_indices_[x].size()) {
-    io_indices_[x].resize(y + 1);
+  size_t location = io_location_id(x, y, z);
+  io_indices_[io_port][location] = io_index;
+
+  if (io_index >= io_locations_[io_port].size()) {
+    io_locations_[io_port].resize(io_index + 1, size_t(-1));
   }
+  io_locations_[io_port][io_index] = location;
+}
+
+/**************************************************
+ * Internal utility
+ *************************************************/
+size_t IoLocationMap::io_location_id(const size_t& x,
+                                     const size_t& y,
+                                     const size_t& z) const {
+  return (x * height_ + y) * num_z_ + z;
+}
 
-  if (z >= io_indices_[x][y].size()) {
-    io_indices_[x][y].resize(z + 1);
+size_t IoLocationMap::find_io_port(const std::string& io_port_name) const {
+  auto result = io_port_ids_.find(io_port_name);
+  if (result == io_port_ids_.end()) {
+    return size_t(-1);
   }
+  return result->second;
+}
 
-  io_indices_[x][y][z][io_port_name] = io_index;
+size_t IoLocationMap::io_location(const std::string& io_port_name,
+                                  const size_t& io_index) const {
+  size_t io_port = find_io_port(io_port_name);
+  VTR_ASSERT(size_t(-1) != io_port);
+  VTR_ASSERT(io_index < io_locations_[io_port].size());
+  VTR_ASSERT(size_t(-1) != io_locations_[io_port][io_index]);
+  return io_locations_[io_port][io_index];
 }
 
 } /* end namespace openfpga */
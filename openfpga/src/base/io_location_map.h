@@ -9,6 +9,8 @@
 #include <string>
 #include <map>
 
+#include "vtr_geometry.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -27,22 +29,61 @@ namespace openfpga {
  *   |  [0]   |  [1]   |   |  [0]   |  [1]   |  |  [0]   |
  *   +-----------------+   +--------+--------+  +--------+
  *
+ * The I/O indices of each I/O port are stored in a dense table of
+ * all the [x][y][z] locations of the device, which is sized once
+ * by resize_io_locations(), along with the reverse lookup from the
+ * I/O index to its location.
+ *
  *******************************************************************/
 class IoLocationMap {
   public: /* Public aggregators */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
+
+    /* Return size_t(-1) if the location has no I/O of the port */
     size_t io_index(const size_t& x,
                     const size_t& y,
                     const size_t& z,
                     const std::string& io_port_name) const;
+
+    /* Location of an I/O of a port, which must have been set */
+    vtr::Point<size_t> io_coordinate(const std::string& io_port_name,
+                                     const size_t& io_index) const;
+    size_t io_z(const std::string& io_port_name,
+                const size_t& io_index) const;
   public: /* Public mutators */
+    /* Size the lookup for locations in [0, width) x [0, height) x [0, num_z) */
+    void resize_io_locations(const size_t& width,
+                             const size_t& height,
+                             const size_t& num_z);
+
     void set_io_index(const size_t& x,
                       const size_t& y,
                       const size_t& z,
                       const std::string& io_port_name,
                       const size_t& io_index);
+  private: /* Internal utility */
+    size_t io_location_id(const size_t& x,
+                          const size_t& y,
+                          const size_t& z) const;
+    size_t find_io_port(const std::string& io_port_name) const;
+    size_t io_location(const std::string& io_port_name,
+                       const size_t& io_index) const;
   private: /* Internal Data */
-    /* I/O index fast lookup by [x][y][z] location */
-    std::vector<std::vector<std::vector<std::map<std::string, size_t>>>> io_indices_;
+    /* Size of the location table */
+    size_t width_ = 0;
+    size_t height_ = 0;
+    size_t num_z_ = 0;
+
+    /* Index of each I/O port by name */
+    std::map<std::string, size_t> io_port_ids_;
+
+    /* I/O index fast lookup by [io_port][location], where the location
+     * is (x * height + y) * num_z + z, size_t(-1) for no I/O */
+    std::vector<std::vector<size_t>> io_indices_;
+
+    /* Reverse lookup of the location by [io_port][io_index] */
+    std::vector<std::vector<size_t>> io_locations_;
 };
 
 } /* End namespace openfpga*/
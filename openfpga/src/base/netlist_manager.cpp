@@ -65,13 +65,26 @@ bool NetlistManager::is_module_in_netlist(const NetlistId& netlist, const Module
 
 /* Find the netlist that a module belongs to */
 NetlistId NetlistManager::find_module_netlist(const ModuleId& module) const {
-  /* Find if the module has been added to a netlist. If used, return false! */
   /* Not found, return an invalid value */
-  if ( module_netlist_map_.end()
-    != module_netlist_map_.find(module)) {
+  if (size_t(module) >= module_netlists_.size()) {
     return NetlistId::INVALID();
   }
-  return module_netlist_map_.at(module);
+  return module_netlists_[module];
+}
+
+size_t NetlistManager::netlist_num_bytes(const NetlistId& netlist) const {
+  VTR_ASSERT(true == valid_netlist_id(netlist));
+  return netlist_num_bytes_[netlist];
+}
+
+size_t NetlistManager::netlist_hash(const NetlistId& netlist) const {
+  VTR_ASSERT(true == valid_netlist_id(netlist));
+  return netlist_hashes_[netlist];
+}
+
+bool NetlistManager::has_netlist_file_profile(const NetlistId& netlist) const {
+  VTR_ASSERT(true == valid_netlist_id(netlist));
+  return netlist_file_profiled_[netlist];
 }
 
 std::vector<NetlistId> NetlistManager::netlists_by_type(const NetlistManager::e_netlist_type& netlist_type) const {
@@ -100,11 +113,39 @@ std::vector<std::string> NetlistManager::netlist_preprocessing_flags(const Netli
   return flags;
 }
 
+/* Find all the stages which write netlists */
+NetlistManager::write_stage_range NetlistManager::write_stages() const {
+  return vtr::make_range(write_stage_ids_.begin(), write_stage_ids_.end());
+}
+
+/* Find all the netlists that are added in a stage */
+std::vector<NetlistId> NetlistManager::write_stage_netlists(const NetlistWriteStageId& stage) const {
+  VTR_ASSERT(true == valid_write_stage_id(stage));
+  return write_stage_netlists_[stage];
+}
+
+std::string NetlistManager::write_stage_name(const NetlistWriteStageId& stage) const {
+  VTR_ASSERT(true == valid_write_stage_id(stage));
+  return write_stage_names_[stage];
+}
+
+float NetlistManager::write_stage_wall_time(const NetlistWriteStageId& stage) const {
+  VTR_ASSERT(true == valid_write_stage_id(stage));
+  return write_stage_wall_times_[stage];
+}
+
+float NetlistManager::write_stage_delta_max_rss(const NetlistWriteStageId& stage) const {
+  VTR_ASSERT(true == valid_write_stage_id(stage));
+  return write_stage_delta_max_rss_[stage];
+}
+
 /******************************************************************************
  * Public mutators
  ******************************************************************************/
 /* Add a netlist to the library */
 NetlistId NetlistManager::add_netlist(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   /* Find if the name has been used. If used, return an invalid Id! */
   std::map<std::string, NetlistId>::iterator it = name_id_map_.find(name);
   if (it !=  name_id_map_.end()) {
@@ -118,6 +159,9 @@ NetlistId NetlistManager::add_netlist(const std::string& name) {
   /* Allocate related attributes */
   netlist_names_.push_back(name);
   netlist_types_.push_back(NUM_NETLIST_TYPES);
+  netlist_file_profiled_.push_back(false);
+  netlist_num_bytes_.push_back(0);
+  netlist_hashes_.push_back(0);
   included_module_ids_.emplace_back();
   included_preprocessing_flag_ids_.emplace_back();
 
@@ -129,36 +173,51 @@ NetlistId NetlistManager::add_netlist(const std::string& name) {
 
 void NetlistManager::set_netlist_type(const NetlistId& netlist,
                                       const e_netlist_type& type) {
+  std::lock_guard<std::mutex> lock(mutex_);
   VTR_ASSERT(true == valid_netlist_id(netlist));
   netlist_types_[netlist] = type;
 }
 
+void NetlistManager::set_netlist_file_profile(const NetlistId& netlist,
+                                              const size_t& num_bytes,
+                                              const size_t& hash) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(true == valid_netlist_id(netlist));
+  netlist_file_profiled_[netlist] = true;
+  netlist_num_bytes_[netlist] = num_bytes;
+  netlist_hashes_[netlist] = hash;
+}
+
 /* Add a module to a netlist in the library */
 bool NetlistManager::add_netlist_module(const NetlistId& netlist, const ModuleId& module) {
+  std::lock_guard<std::mutex> lock(mutex_);
   VTR_ASSERT(true == valid_netlist_id(netlist));
+  VTR_ASSERT(ModuleId::INVALID() != module);
 
-  /* Find if the module already in the netlist */
-  std::vector<ModuleId>::iterator module_it = std::find(included_module_ids_[netlist].begin(), included_module_ids_[netlist].end(), module);
-  if (module_it != included_module_ids_[netlist].end()) {
-    /* Already in the netlist, nothing to do */
+  /* Expand the module-to-netlist look-up to cover the module */
+  if (size_t(module) >= module_netlists_.size()) {
+    module_netlists_.resize(size_t(module) + 1, NetlistId::INVALID());
+  }
+
+  /* Find if the module already in the netlist, nothing to do */
+  if (netlist == module_netlists_[module]) {
     return true;
   }
-  /* Try to register it in module-to-netlist map */
-  /* Find if the module has been added to a netlist. If used, return false! */
-  std::map<ModuleId, NetlistId>::iterator map_it = module_netlist_map_.find(module);
-  if (map_it != module_netlist_map_.end()) {
+  /* Find if the module has been added to another netlist. If used, return false! */
+  if (NetlistId::INVALID() != module_netlists_[module]) {
     return false;
   }
 
   /* Does not exist! Should add it to the list */
   included_module_ids_[netlist].push_back(module);
-  /* Register it in module-to-netlist map */
-  module_netlist_map_[module] = netlist;
+  /* Register it in module-to-netlist look-up */
+  module_netlists_[module] = netlist;
   return true;
 }
 
 /* Add a pre-processing flag to a netlist */
 void NetlistManager::add_netlist_preprocessing_flag(const NetlistId& netlist, const std::string& preprocessing_flag) {
+  std::lock_guard<std::mutex> lock(mutex_);
   VTR_ASSERT(true == valid_netlist_id(netlist));
 
   PreprocessingFlagId flag = PreprocessingFlagId(preprocessing_flag_ids_.size());
@@ -187,6 +246,28 @@ void NetlistManager::add_netlist_preprocessing_flag(const NetlistId& netlist, co
   }
 }
 
+/* Add the profile of a stage which writes netlists */
+NetlistWriteStageId NetlistManager::add_write_stage(const std::string& name,
+                                                    const float& wall_time,
+                                                    const float& delta_max_rss,
+                                                    const size_t& num_netlists_before_stage) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  VTR_ASSERT(num_netlists_before_stage <= netlist_ids_.size());
+
+  NetlistWriteStageId stage = NetlistWriteStageId(write_stage_ids_.size());
+  write_stage_ids_.push_back(stage);
+  write_stage_names_.push_back(name);
+  write_stage_wall_times_.push_back(wall_time);
+  write_stage_delta_max_rss_.push_back(delta_max_rss);
+  write_stage_netlists_.emplace_back();
+
+  for (size_t inetlist = num_netlists_before_stage; inetlist < netlist_ids_.size(); ++inetlist) {
+    write_stage_netlists_[stage].push_back(NetlistId(inetlist));
+  }
+
+  return stage;
+}
+
 /******************************************************************************
  * Public validators/invalidators
  ******************************************************************************/
@@ -194,6 +275,10 @@ bool NetlistManager::valid_netlist_id(const NetlistId& netlist) const {
   return (size_t(netlist) < netlist_ids_.size()) && (netlist == netlist_ids_[netlist]);
 }
 
+bool NetlistManager::valid_write_stage_id(const NetlistWriteStageId& stage) const {
+  return (size_t(stage) < write_stage_ids_.size()) && (stage == write_stage_ids_[stage]);
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -205,8 +290,4 @@ void NetlistManager::invalidate_name2id_map() {
   name_id_map_.clear();
 }
 
-void NetlistManager::invalidate_module2netlist_map() {
-  module_netlist_map_.clear();
-}
-
 } /* end namespace openfpga */
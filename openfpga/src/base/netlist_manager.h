@@ -7,6 +7,16 @@
  * the netlist manager can generate the dependency on other netlists 
  * This can help us tracking the dependency and generate `include` files easily
  *
+ * The netlist manager also records the profile of the stages which
+ * write netlists, e.g., wall time and peak memory, so that the costly
+ * stages can be reported. Each netlist belongs to the stage which adds it.
+ * The size and the hash of the contents of each netlist file can be recorded,
+ * so that the netlists changed between two runs can be found.
+ *
+ * The mutators are thread-safe, so that netlists can be registered
+ * by concurrent writers. The accessors are not guarded, and should
+ * not be called while netlists are being registered.
+ *
  * Cross-reference:
  *
  *   +---------+               +---------+      
@@ -23,6 +33,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
 #include "vtr_vector.h"
 #include "netlist_manager_fwd.h"
 #include "module_manager.h"
@@ -44,6 +55,8 @@ class NetlistManager {
   public: /* Types and ranges */
     typedef vtr::vector<NetlistId, NetlistId>::const_iterator netlist_iterator;
     typedef vtr::Range<netlist_iterator> netlist_range;
+    typedef vtr::vector<NetlistWriteStageId, NetlistWriteStageId>::const_iterator write_stage_iterator;
+    typedef vtr::Range<write_stage_iterator> write_stage_range;
 
   public: /* Public aggregators */
     /* Find all the netlists */
@@ -52,6 +65,10 @@ class NetlistManager {
     std::vector<ModuleId> netlist_modules(const NetlistId& netlist) const;
     /* Find all the preprocessing flags that are included in a netlist */
     std::vector<std::string> netlist_preprocessing_flags(const NetlistId& netlist) const;
+    /* Find all the stages which write netlists */
+    write_stage_range write_stages() const;
+    /* Find all the netlists that are added in a stage */
+    std::vector<NetlistId> write_stage_netlists(const NetlistWriteStageId& stage) const;
 
   public: /* Public accessors */
     /* Find the name of a netlist */
@@ -62,10 +79,22 @@ class NetlistManager {
     std::vector<NetlistId> netlists_by_type(const e_netlist_type& netlist_type) const;
     /* Get the type of a netlist */
     e_netlist_type netlist_type(const NetlistId& netlist) const;
+    /* Get the size of a netlist file in bytes, as recorded by set_netlist_file_profile() */
+    size_t netlist_num_bytes(const NetlistId& netlist) const;
+    /* Get the hash of the contents of a netlist file, as recorded by set_netlist_file_profile() */
+    size_t netlist_hash(const NetlistId& netlist) const;
+    /* Find if the size and the hash of a netlist file have been recorded */
+    bool has_netlist_file_profile(const NetlistId& netlist) const;
     /* Find if a module belongs to a netlist */
     bool is_module_in_netlist(const NetlistId& netlist, const ModuleId& module) const;
     /* Find the netlist that a module belongs to */
     NetlistId find_module_netlist(const ModuleId& module) const;
+    /* Find the name of a stage which writes netlists */
+    std::string write_stage_name(const NetlistWriteStageId& stage) const;
+    /* Find the wall time of a stage in seconds */
+    float write_stage_wall_time(const NetlistWriteStageId& stage) const;
+    /* Find the increase of peak memory of a stage in MiB */
+    float write_stage_delta_max_rss(const NetlistWriteStageId& stage) const;
 
   public: /* Public mutators */
     /* Add a netlist to the library */
@@ -73,23 +102,37 @@ class NetlistManager {
     /* Set a netlist type */
     void set_netlist_type(const NetlistId& netlist,
                           const e_netlist_type& type);
+    /* Record the size and the hash of the contents of a netlist file */
+    void set_netlist_file_profile(const NetlistId& netlist,
+                                  const size_t& num_bytes,
+                                  const size_t& hash);
     /* Add a module to a netlist in the library */
     bool add_netlist_module(const NetlistId& netlist, const ModuleId& module);
     /* Add a pre-processing flag to a netlist */
     void add_netlist_preprocessing_flag(const NetlistId& netlist, const std::string& preprocessing_flag);
+    /* Add the profile of a stage which writes netlists,
+     * which owns all the netlists added since the given number of netlists
+     */
+    NetlistWriteStageId add_write_stage(const std::string& name,
+                                        const float& wall_time,
+                                        const float& delta_max_rss,
+                                        const size_t& num_netlists_before_stage);
 
   public: /* Public validators/invalidators */
     bool valid_netlist_id(const NetlistId& netlist) const;
+    bool valid_write_stage_id(const NetlistWriteStageId& stage) const;
 
   private: /* Private validators/invalidators */
     bool valid_preprocessing_flag_id(const PreprocessingFlagId& flag) const;
     void invalidate_name2id_map();
-    void invalidate_module2netlist_map();
 
   private: /* Internal data */
     vtr::vector<NetlistId, NetlistId> netlist_ids_;
     vtr::vector<NetlistId, std::string> netlist_names_;
     vtr::vector<NetlistId, e_netlist_type> netlist_types_;
+    vtr::vector<NetlistId, bool> netlist_file_profiled_;
+    vtr::vector<NetlistId, size_t> netlist_num_bytes_;
+    vtr::vector<NetlistId, size_t> netlist_hashes_;
 
     vtr::vector<NetlistId, std::vector<ModuleId>> included_module_ids_;
     vtr::vector<NetlistId, std::vector<PreprocessingFlagId>> included_preprocessing_flag_ids_;
@@ -97,10 +140,20 @@ class NetlistManager {
     vtr::vector<PreprocessingFlagId, PreprocessingFlagId> preprocessing_flag_ids_;
     vtr::vector<PreprocessingFlagId, std::string> preprocessing_flag_names_;
 
+    /* Profile of the stages which write netlists */
+    vtr::vector<NetlistWriteStageId, NetlistWriteStageId> write_stage_ids_;
+    vtr::vector<NetlistWriteStageId, std::string> write_stage_names_;
+    vtr::vector<NetlistWriteStageId, float> write_stage_wall_times_;
+    vtr::vector<NetlistWriteStageId, float> write_stage_delta_max_rss_;
+    vtr::vector<NetlistWriteStageId, std::vector<NetlistId>> write_stage_netlists_;
+
     /* fast look-up for netlist */
     std::map<std::string, NetlistId> name_id_map_;
-    /* fast look-up for modules in netlists */
-    std::map<ModuleId, NetlistId> module_netlist_map_;
+    /* fast look-up for modules in netlists, which is expanded when modules are added */
+    vtr::vector<ModuleId, NetlistId> module_netlists_;
+
+    /* Serialize the mutators called by concurrent writers */
+    std::mutex mutex_;
 };
 
 } /* end namespace openfpga */
@@ -14,9 +14,11 @@ namespace openfpga {
 /* Strong Ids for ModuleManager */
 struct netlist_id_tag;
 struct preprocessing_flag_id_tag;
+struct netlist_write_stage_id_tag;
 
 typedef vtr::StrongId<netlist_id_tag> NetlistId;
 typedef vtr::StrongId<preprocessing_flag_id_tag> PreprocessingFlagId;
+typedef vtr::StrongId<netlist_write_stage_id_tag> NetlistWriteStageId;
 
 class NetlistManager;
 
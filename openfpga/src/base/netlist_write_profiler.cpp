@@ -0,0 +1,223 @@
+/********************************************************************
+ * This file includes the profiler of the stages which write netlists
+ * as well as a writer to report the profile in JSON format
+ *******************************************************************/
+#include <sys/stat.h>
+#include <fstream>
+#include <map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_hash.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "netlist_write_profiler.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the size of a netlist file in bytes
+ * Return 0 if the file does not exist
+ *******************************************************************/
+static
+size_t find_netlist_file_size(const std::string& fname) {
+  struct stat file_stat;
+  if (0 != stat(fname.c_str(), &file_stat)) {
+    return 0;
+  }
+  return file_stat.st_size;
+}
+
+/********************************************************************
+ * Record the size and the hash of the contents of a netlist file
+ * in the netlist manager. The lines starting with the ignored prefix
+ * are skipped in the hash, so that it is the same between two runs
+ * writing the same netlist. Nothing is recorded if the file can not be read
+ *******************************************************************/
+static
+void record_netlist_file_profile(NetlistManager& netlist_manager,
+                                 const NetlistId& netlist,
+                                 const std::string& ignored_line_prefix) {
+  std::string fname = netlist_manager.netlist_name(netlist);
+  std::ifstream fp(fname);
+  if (!fp.is_open()) {
+    return;
+  }
+
+  size_t hash = 0;
+  std::string line;
+  while (std::getline(fp, line)) {
+    if ((false == ignored_line_prefix.empty())
+       && (0 == line.compare(0, ignored_line_prefix.size(), ignored_line_prefix))) {
+      continue;
+    }
+    vtr::hash_combine(hash, line);
+  }
+
+  netlist_manager.set_netlist_file_profile(netlist, find_netlist_file_size(fname), hash);
+}
+
+/************************************************************************
+ * Constructors and destructor
+ ***********************************************************************/
+NetlistWriteProfiler::NetlistWriteProfiler(NetlistManager& netlist_manager,
+                                           const std::string& stage_name,
+                                           const std::string& ignored_line_prefix)
+  : netlist_manager_(netlist_manager),
+    stage_name_(stage_name),
+    ignored_line_prefix_(ignored_line_prefix),
+    num_netlists_before_stage_(netlist_manager.netlists().size()) {
+}
+
+NetlistWriteProfiler::~NetlistWriteProfiler() {
+  NetlistWriteStageId stage = netlist_manager_.add_write_stage(stage_name_,
+                                                               timer_.elapsed_sec(),
+                                                               timer_.delta_max_rss_mib(),
+                                                               num_netlists_before_stage_);
+
+  /* Profile the files after the stage is timed, so that reading them is not accounted */
+  for (const NetlistId& netlist : netlist_manager_.write_stage_netlists(stage)) {
+    record_netlist_file_profile(netlist_manager_, netlist, ignored_line_prefix_);
+  }
+}
+
+/********************************************************************
+ * Quote a string for JSON, escaping the characters that are not allowed
+ *******************************************************************/
+static
+std::string generate_json_string(const std::string& str) {
+  std::string json_str("\"");
+  for (const char& ch : str) {
+    if (('"' == ch) || ('\\' == ch)) {
+      json_str += '\\';
+    }
+    json_str += ch;
+  }
+  json_str += "\"";
+  return json_str;
+}
+
+/********************************************************************
+ * Output the profile of the stages and netlists of a netlist manager
+ * The size of a netlist is the one recorded at the end of its stage,
+ * or the size of its file when reported if it is not profiled
+ *******************************************************************/
+static
+void write_netlist_manager_profile_to_json_file(std::fstream& fp,
+                                                const NetlistManager& netlist_manager) {
+  std::map<NetlistId, NetlistWriteStageId> netlist_stages;
+  std::map<NetlistId, size_t> netlist_sizes;
+  for (const NetlistId& netlist : netlist_manager.netlists()) {
+    if (true == netlist_manager.has_netlist_file_profile(netlist)) {
+      netlist_sizes[netlist] = netlist_manager.netlist_num_bytes(netlist);
+    } else {
+      netlist_sizes[netlist] = find_netlist_file_size(netlist_manager.netlist_name(netlist));
+    }
+  }
+
+  fp << "{\n";
+  fp << "    \"stages\": [";
+  bool first_entry = true;
+  for (const NetlistWriteStageId& stage : netlist_manager.write_stages()) {
+    size_t num_modules = 0;
+    size_t num_bytes = 0;
+    for (const NetlistId& netlist : netlist_manager.write_stage_netlists(stage)) {
+      netlist_stages[netlist] = stage;
+      num_modules += netlist_manager.netlist_modules(netlist).size();
+      num_bytes += netlist_sizes[netlist];
+    }
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "      {";
+    fp << "\"name\": " << generate_json_string(netlist_manager.write_stage_name(stage));
+    fp << ", \"wall_time_sec\": " << netlist_manager.write_stage_wall_time(stage);
+    fp << ", \"delta_max_rss_mib\": " << netlist_manager.write_stage_delta_max_rss(stage);
+    fp << ", \"num_netlists\": " << netlist_manager.write_stage_netlists(stage).size();
+    fp << ", \"num_modules\": " << num_modules;
+    fp << ", \"num_bytes\": " << num_bytes;
+    fp << "}";
+  }
+  fp << "\n    ],\n";
+
+  fp << "    \"netlists\": [";
+  first_entry = true;
+  for (const NetlistId& netlist : netlist_manager.netlists()) {
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "      {";
+    fp << "\"name\": " << generate_json_string(netlist_manager.netlist_name(netlist));
+    /* Netlists which are not added in any profiled stage have no stage */
+    fp << ", \"stage\": ";
+    if (netlist_stages.end() == netlist_stages.find(netlist)) {
+      fp << "null";
+    } else {
+      fp << generate_json_string(netlist_manager.write_stage_name(netlist_stages.at(netlist)));
+    }
+    fp << ", \"num_modules\": " << netlist_manager.netlist_modules(netlist).size();
+    fp << ", \"num_bytes\": " << netlist_sizes[netlist];
+    fp << ", \"hash\": ";
+    if (true == netlist_manager.has_netlist_file_profile(netlist)) {
+      /* Quoted, as JSON readers may not keep all the digits of large numbers */
+      fp << generate_json_string(std::to_string(netlist_manager.netlist_hash(netlist)));
+    } else {
+      fp << "null";
+    }
+    fp << "}";
+  }
+  fp << "\n    ]\n";
+  fp << "  }";
+}
+
+/********************************************************************
+ * Report the profile of writing Verilog and SPICE netlists to a JSON file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_netlist_write_profile_to_json_file(const NetlistManager& verilog_netlist_manager,
+                                             const NetlistManager& spice_netlist_manager,
+                                             const std::string& fname,
+                                             const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output netlist write profile!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "{\n";
+  fp << "  \"verilog\": ";
+  write_netlist_manager_profile_to_json_file(fp, verilog_netlist_manager);
+  fp << ",\n";
+  fp << "  \"spice\": ";
+  write_netlist_manager_profile_to_json_file(fp, spice_netlist_manager);
+  fp << "\n}\n";
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write netlist write profile to file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Reported the profile of %lu Verilog netlists and %lu SPICE netlists to file: %s\n",
+           verilog_netlist_manager.netlists().size(),
+           spice_netlist_manager.netlists().size(),
+           fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,56 @@
+#ifndef NETLIST_WRITE_PROFILER_H
+#define NETLIST_WRITE_PROFILER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "vtr_time.h"
+#include "netlist_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A scoped profiler for a stage which writes netlists
+ * The wall time and the increase of peak memory since construction
+ * are recorded in the netlist manager at destruction, along with
+ * all the netlists added to the netlist manager during the stage.
+ * The size and the hash of each netlist file of the stage are also recorded,
+ * where the lines starting with the ignored prefix (e.g., the time stamps
+ * in file headers) are excluded from the hash
+ *
+ * Usage:
+ *   {
+ *     NetlistWriteProfiler profiler(netlist_manager, "routing");
+ *     print_verilog_unique_routing_modules(netlist_manager, ...);
+ *   }
+ *******************************************************************/
+class NetlistWriteProfiler {
+  public: /* Constructor and destructor */
+    NetlistWriteProfiler(NetlistManager& netlist_manager,
+                         const std::string& stage_name,
+                         const std::string& ignored_line_prefix = std::string());
+    ~NetlistWriteProfiler();
+    NetlistWriteProfiler(const NetlistWriteProfiler&) = delete;
+    NetlistWriteProfiler& operator=(const NetlistWriteProfiler&) = delete;
+  private: /* Internal data */
+    NetlistManager& netlist_manager_;
+    std::string stage_name_;
+    std::string ignored_line_prefix_;
+    size_t num_netlists_before_stage_;
+    vtr::Timer timer_;
+};
+
+int write_netlist_write_profile_to_json_file(const NetlistManager& verilog_netlist_manager,
+                                             const NetlistManager& spice_netlist_manager,
+                                             const std::string& fname,
+                                             const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -14,17 +14,28 @@
 
 /* Headers from fpgabitstream library */
 #include "read_xml_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+#include "read_xml_bitstream_eco.h"
 #include "write_xml_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
 #include "report_arch_bitstream_distribution.h"
+#include "report_sparse_bitstream.h"
+#include "diff_arch_bitstream.h"
+#include "write_text_arch_bitstream_diff.h"
 
 #include "openfpga_naming.h"
 
 #include "build_device_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
+#include "write_binary_fabric_bitstream.h"
+#include "report_fabric_bitstream_stats.h"
+#include "encrypt_fabric_bitstream.h"
 #include "build_fabric_bitstream.h"
 #include "build_io_mapping_info.h"
 #include "write_xml_io_mapping.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_bitstream.h"
 
 /* Include global variables of VPR */
@@ -39,15 +50,44 @@ namespace openfpga {
 int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
                    const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_file_format = cmd.option("format");
+
+  /* Check file format requirements */
+  std::string file_format("xml"); 
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+  if ((std::string("xml") != file_format) && (std::string("binary") != file_format)) {
+    VTR_LOG_ERROR("Invalid file format '%s' for bitstream database! Expect [xml|binary]\n",
+                  file_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
-  if (true == cmd_context.option_enable(cmd, opt_read_file)) {
+  if ((true == cmd_context.option_enable(cmd, opt_read_file))
+     && (std::string("binary") == file_format)) {
+    if (0 != read_binary_architecture_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                                                cmd_context.option_value(cmd, opt_read_file).c_str())) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  } else if (true == cmd_context.option_enable(cmd, opt_read_file)) {
     openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_read_file).c_str());
   } else {
     openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(g_vpr_ctx,
                                                                       openfpga_ctx,
+                                                                      num_threads,
                                                                       cmd_context.option_enable(cmd, opt_verbose));
   }
 
@@ -57,14 +97,146 @@ int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
     /* Create directories */
     create_directory(src_dir_path);
 
-    write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
-                                     cmd_context.option_value(cmd, opt_write_file));
+    if (std::string("binary") == file_format) {
+      if (0 != write_binary_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                                   cmd_context.option_value(cmd, opt_write_file))) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    } else {
+      write_xml_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                       cmd_context.option_value(cmd, opt_write_file));
+    }
   }
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A wrapper function to call the update_device_bitstream() in FPGA bitstream
+ * The fabric-dependent bitstream, if built, is updated as well
+ *******************************************************************/
+int update_fpga_bitstream(OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_eco_file = cmd.option("eco_file");
+
+  BitstreamEco bitstream_eco = read_xml_bitstream_eco(cmd_context.option_value(cmd, opt_eco_file).c_str());
+
+  std::vector<ConfigBitId> changed_bits;
+  int status = update_device_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                                       g_vpr_ctx,
+                                       openfpga_ctx,
+                                       bitstream_eco.grids,
+                                       bitstream_eco.gsbs,
+                                       changed_bits,
+                                       cmd_context.option_enable(cmd, opt_verbose));
+
+  /* Fabric bitstream is built only when the command 'build_fabric_bitstream' has been called
+   * It is updated even on errors, so that it stays consistent with the bits already changed
+   */
+  if (0 < openfpga_ctx.fabric_bitstream().num_bits()) {
+    update_fabric_dependent_bitstream(openfpga_ctx.mutable_fabric_bitstream(),
+                                      openfpga_ctx.bitstream_manager(),
+                                      changed_bits,
+                                      cmd_context.option_enable(cmd, opt_verbose));  
+  }
+
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * A wrapper function to call the diff_architecture_bitstream() in FPGA bitstream
+ * The differences can be applied to the bitstream database and 
+ * the fabric-dependent bitstream, if built, so that both become 
+ * the same as the reference
+ *******************************************************************/
+int diff_fpga_bitstream(OpenfpgaContext& openfpga_ctx,
+                        const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_ref_file = cmd.option("ref_file");
+  CommandOptionId opt_file_format = cmd.option("format");
+  CommandOptionId opt_write_file = cmd.option("write_file");
+  CommandOptionId opt_patch = cmd.option("patch");
+  CommandOptionId opt_fail_on_diff = cmd.option("fail_on_diff");
+
+  /* Check file format requirements */
+  std::string file_format("xml"); 
+  if (true == cmd_context.option_enable(cmd, opt_file_format)) {
+    file_format = cmd_context.option_value(cmd, opt_file_format);
+  }
+
+  BitstreamManager ref_bitstream_manager;
+  if (std::string("binary") == file_format) {
+    if (0 != read_binary_architecture_bitstream(ref_bitstream_manager,
+                                                cmd_context.option_value(cmd, opt_ref_file).c_str())) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  } else if (std::string("xml") == file_format) {
+    ref_bitstream_manager = read_xml_architecture_bitstream(cmd_context.option_value(cmd, opt_ref_file).c_str());
+  } else {
+    VTR_LOG_ERROR("Invalid file format '%s' for bitstream database! Expect [xml|binary]\n",
+                  file_format.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  ArchBitstreamDiff bitstream_diff = diff_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                                                 ref_bitstream_manager);
+
+  VTR_LOG("Found %lu different configuration bits\n",
+          bitstream_diff.bits.size());
+  if ( (false == bitstream_diff.unmatched_blocks.empty())
+    || (0 < bitstream_diff.num_ref_only_blocks) ) {
+    VTR_LOG_WARN("Found %lu blocks which are not in the reference and %lu blocks which are only in the reference! Their bits are not compared.\n",
+                 bitstream_diff.unmatched_blocks.size(),
+                 bitstream_diff.num_ref_only_blocks);
+  }
+
+  if (true == cmd_context.option_enable(cmd, opt_write_file)) {
+    std::string src_dir_path = find_path_dir_name(cmd_context.option_value(cmd, opt_write_file));
+
+    /* Create directories */
+    create_directory(src_dir_path);
+
+    if (0 != write_architecture_bitstream_diff_to_text_file(openfpga_ctx.bitstream_manager(),
+                                                            bitstream_diff,
+                                                            cmd_context.option_value(cmd, opt_write_file))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Check before patching, so that the bitstream database is not touched on errors */
+  if ( (true == cmd_context.option_enable(cmd, opt_fail_on_diff))
+    && ( (false == bitstream_diff.bits.empty())
+      || (false == bitstream_diff.unmatched_blocks.empty())
+      || (0 < bitstream_diff.num_ref_only_blocks) ) ) {
+    VTR_LOG_ERROR("Bitstream database is different from the reference '%s'!\n",
+                  cmd_context.option_value(cmd, opt_ref_file).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (true == cmd_context.option_enable(cmd, opt_patch)) {
+    apply_architecture_bitstream_diff(openfpga_ctx.mutable_bitstream_manager(),
+                                      bitstream_diff);
+
+    /* Fabric bitstream is built only when the command 'build_fabric_bitstream' has been called */
+    if (0 < openfpga_ctx.fabric_bitstream().num_bits()) {
+      update_fabric_dependent_bitstream(openfpga_ctx.mutable_fabric_bitstream(),
+                                        openfpga_ctx.bitstream_manager(),
+                                        bitstream_diff.bits,
+                                        cmd_context.option_enable(cmd, opt_verbose));  
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * A wrapper function to call the build_fabric_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -73,10 +245,17 @@ int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Build fabric bitstream here */
   openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(openfpga_ctx.bitstream_manager(),
                                                                              openfpga_ctx.module_graph(),
                                                                              openfpga_ctx.arch().config_protocol,
+                                                                             num_threads,
                                                                              cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -93,6 +272,14 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_file_format = cmd.option("format");
   CommandOptionId opt_fast_config = cmd.option("fast_configuration");
+  CommandOptionId opt_compress = cmd.option("compress");
+  CommandOptionId opt_encryption_key_file = cmd.option("encryption_key_file");
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
@@ -110,12 +297,38 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
     file_format = cmd_context.option_value(cmd, opt_file_format);
   }
 
+  /* The binary file contains all the configuration bits in the order of regions,
+   * so that bitstream downloaders can map every bit. The bits can not be skipped
+   */
+  if ( (std::string("binary") == file_format)
+    && (true == cmd_context.option_enable(cmd, opt_fast_config)) ) {
+    VTR_LOG_ERROR("Option '--%s' is not applicable to the binary file format! Use the plain text file format instead.\n",
+                  cmd.option_name(opt_fast_config).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The binary file is designed to be mapped into memory, which is not possible once compressed */
+  if ( (std::string("binary") == file_format)
+    && (true == cmd_context.option_enable(cmd, opt_compress)) ) {
+    VTR_LOG_ERROR("Option '--%s' is not applicable to the binary file format! Use the plain text or XML file format instead.\n",
+                  cmd.option_name(opt_compress).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   if (std::string("xml") == file_format) {
     status = write_fabric_bitstream_to_xml_file(openfpga_ctx.bitstream_manager(),
                                                 openfpga_ctx.fabric_bitstream(),
                                                 openfpga_ctx.arch().config_protocol,
                                                 cmd_context.option_value(cmd, opt_file),
+                                                cmd_context.option_enable(cmd, opt_compress),
+                                                num_threads,
                                                 cmd_context.option_enable(cmd, opt_verbose));
+  } else if (std::string("binary") == file_format) {
+    status = write_fabric_bitstream_to_binary_file(openfpga_ctx.bitstream_manager(),
+                                                   openfpga_ctx.fabric_bitstream(),
+                                                   openfpga_ctx.arch().config_protocol,
+                                                   cmd_context.option_value(cmd, opt_file),
+                                                   cmd_context.option_enable(cmd, opt_verbose));
   } else {
     /* By default, output in plain text format */
     status = write_fabric_bitstream_to_text_file(openfpga_ctx.bitstream_manager(),
@@ -124,8 +337,19 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
                                                  openfpga_ctx.fabric_global_port_info(),
                                                  cmd_context.option_value(cmd, opt_file),
                                                  cmd_context.option_enable(cmd, opt_fast_config),
+                                                 cmd_context.option_enable(cmd, opt_compress),
+                                                 num_threads,
                                                  cmd_context.option_enable(cmd, opt_verbose));
   }
+
+  /* Encrypt the file once it is completely written */
+  if ( (CMD_EXEC_SUCCESS == status)
+    && (true == cmd_context.option_enable(cmd, opt_encryption_key_file)) ) {
+    status = encrypt_fabric_bitstream_file(cmd_context.option_value(cmd, opt_file),
+                                           cmd_context.option_value(cmd, opt_encryption_key_file),
+                                           num_threads,
+                                           cmd_context.option_enable(cmd, opt_verbose));
+  }
   
   return status;
 } 
@@ -136,6 +360,10 @@ int write_fabric_bitstream(const OpenfpgaContext& openfpga_ctx,
 int write_io_mapping(const OpenfpgaContext& openfpga_ctx,
                      const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_file = cmd.option("file");
 
@@ -144,6 +372,12 @@ int write_io_mapping(const OpenfpgaContext& openfpga_ctx,
   
   VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   std::string src_dir_path = find_path_dir_name(cmd_context.option_value(cmd, opt_file));
 
   /* Create directories */
@@ -171,6 +405,7 @@ int write_io_mapping(const OpenfpgaContext& openfpga_ctx,
 
   status = write_io_mapping_to_xml_file(io_map,
                                         cmd_context.option_value(cmd, opt_file),
+                                        size_t(num_threads),
                                         cmd_context.option_enable(cmd, opt_verbose));
   
   return status;
@@ -206,11 +441,72 @@ int report_bitstream_distribution(const OpenfpgaContext& openfpga_ctx,
     }
   }
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   status = report_architecture_bitstream_distribution(openfpga_ctx.bitstream_manager(),
                                                       cmd_context.option_value(cmd, opt_file),
-                                                      depth);
+                                                      depth,
+                                                      num_threads);
   
   return status;
 }
 
+/********************************************************************
+ * A wrapper function to call the report_sparse_bitstream() in FPGA bitstream
+ *******************************************************************/
+int report_sparse_bitstream(const OpenfpgaContext& openfpga_ctx,
+                            const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_include_bits = cmd.option("include_bits");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+
+  std::string src_dir_path = find_path_dir_name(cmd_context.option_value(cmd, opt_file));
+
+  /* Create directories */
+  create_directory(src_dir_path);
+
+  return report_sparse_bitstream(openfpga_ctx.bitstream_manager(),
+                                 openfpga_ctx.module_graph(),
+                                 cmd_context.option_value(cmd, opt_file),
+                                 cmd_context.option_enable(cmd, opt_include_bits),
+                                 cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * A wrapper function to call the report_fabric_bitstream_stats() in FPGA bitstream
+ *******************************************************************/
+int report_fabric_bitstream_stats(const OpenfpgaContext& openfpga_ctx,
+                                  const Command& cmd, const CommandContext& cmd_context) {
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+
+  std::string src_dir_path = find_path_dir_name(cmd_context.option_value(cmd, opt_file));
+
+  /* Create directories */
+  create_directory(src_dir_path);
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return report_fabric_bitstream_stats(openfpga_ctx.bitstream_manager(),
+                                       openfpga_ctx.fabric_bitstream(),
+                                       openfpga_ctx.module_graph(),
+                                       cmd_context.option_value(cmd, opt_file),
+                                       size_t(num_threads),
+                                       cmd_context.option_enable(cmd, opt_verbose));
+}
+
 } /* end namespace openfpga */
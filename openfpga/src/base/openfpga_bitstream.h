@@ -18,6 +18,12 @@ namespace openfpga {
 int fpga_bitstream(OpenfpgaContext& openfpga_ctx,
                    const Command& cmd, const CommandContext& cmd_context); 
 
+int update_fpga_bitstream(OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context);
+
+int diff_fpga_bitstream(OpenfpgaContext& openfpga_ctx,
+                        const Command& cmd, const CommandContext& cmd_context);
+
 int build_fabric_bitstream(OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context);
 
@@ -30,6 +36,12 @@ int write_io_mapping(const OpenfpgaContext& openfpga_ctx,
 int report_bitstream_distribution(const OpenfpgaContext& openfpga_ctx,
                                   const Command& cmd, const CommandContext& cmd_context);
 
+int report_sparse_bitstream(const OpenfpgaContext& openfpga_ctx,
+                            const Command& cmd, const CommandContext& cmd_context);
+
+int report_fabric_bitstream_stats(const OpenfpgaContext& openfpga_ctx,
+                                  const Command& cmd, const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
@@ -6,6 +6,8 @@
  *******************************************************************/
 #include "openfpga_repack.h"
 #include "openfpga_bitstream.h"
+#include "openfpga_context_checkpoint.h"
+#include "openfpga_memory_report.h"
 #include "openfpga_bitstream_command.h"
 
 /* begin namespace openfpga */
@@ -24,6 +26,15 @@ ShellCommandId add_openfpga_repack_command(openfpga::Shell<OpenfpgaContext>& she
   /* Add an option '--design_constraints' */
   CommandOptionId opt_design_constraints = shell_cmd.add_option("design_constraints", false, "file path to the design constraints");
   shell_cmd.set_option_require_value(opt_design_constraints, openfpga::OPT_STRING);
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to repack clustered blocks. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+  /* Add an option '--lb_rr_graph_cache' */
+  CommandOptionId opt_lb_rr_graph_cache = shell_cmd.add_option("lb_rr_graph_cache", false, "file path to the binary cache of the routing resource graphs of logical tiles");
+  shell_cmd.set_option_require_value(opt_lb_rr_graph_cache, openfpga::OPT_STRING);
+  /* Add an option '--report_stats' */
+  CommandOptionId opt_report_stats = shell_cmd.add_option("report_stats", false, "file path to report the statistics of repacking each clustered block in JSON format");
+  shell_cmd.set_option_require_value(opt_report_stats, openfpga::OPT_STRING);
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -57,6 +68,13 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   CommandOptionId opt_read_file = shell_cmd.add_option("read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--format' */
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of the bitstream database to read and write [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to build the bitstream database. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
 
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
@@ -72,6 +90,35 @@ ShellCommandId add_openfpga_build_arch_bitstream_command(openfpga::Shell<Openfpg
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: update_architecture_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_update_arch_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                          const ShellCommandClassId& cmd_class_id,
+                                                          const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("update_architecture_bitstream");
+
+  /* Add an option '--eco_file' */
+  CommandOptionId opt_eco_file = shell_cmd.add_option("eco_file", true, "file path to the grids and GSBs whose bitstream should be regenerated");
+  shell_cmd.set_option_require_value(opt_eco_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'update_architecture_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Incrementally update fabric-independent bitstream database of a few grids and routing blocks");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, update_fpga_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: report_bitstream_distribution
  * - Add associated options 
@@ -92,6 +139,10 @@ ShellCommandId add_openfpga_report_bitstream_distribution_command(openfpga::Shel
   CommandOptionId opt_depth = shell_cmd.add_option("depth", false, "Specify the max. depth of blocks which will appear in report");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to count the bits of blocks. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -106,6 +157,116 @@ ShellCommandId add_openfpga_report_bitstream_distribution_command(openfpga::Shel
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_sparse_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_sparse_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                            const ShellCommandClassId& cmd_class_id,
+                                                            const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_sparse_bitstream");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "file path to output the blocks which differ from the default bitstream of their modules");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--include_bits' */
+  shell_cmd.add_option("include_bits", false, "Write the bits of the default bitstreams and of the reported blocks");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'report_sparse_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Report the blocks whose bitstream differs from the default bitstream of their modules");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, report_sparse_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_fabric_bitstream_stats
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_fabric_bitstream_stats_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                                  const ShellCommandClassId& cmd_class_id,
+                                                                  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_fabric_bitstream_stats");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "file path to output the statistics of configuration bits in JSON format");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to count the bits of regions, tiles and frames. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'report_fabric_bitstream_stats' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Report the number of bits and logic '1' per configuration region, tile type and configuration frame");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, report_fabric_bitstream_stats);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: diff_architecture_bitstream
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_diff_arch_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                        const ShellCommandClassId& cmd_class_id,
+                                                        const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("diff_architecture_bitstream");
+
+  /* Add an option '--ref_file' */
+  CommandOptionId opt_ref_file = shell_cmd.add_option("ref_file", true, "file path to the reference bitstream database");
+  shell_cmd.set_option_require_value(opt_ref_file, openfpga::OPT_STRING);
+
+  /* Add an option '--format' */
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of the reference bitstream database [xml|binary]. Default: xml");
+  shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
+
+  /* Add an option '--write_file' */
+  CommandOptionId opt_write_file = shell_cmd.add_option("write_file", false, "file path to output the different bits");
+  shell_cmd.set_option_require_value(opt_write_file, openfpga::OPT_STRING);
+
+  /* Add an option '--patch' */
+  shell_cmd.add_option("patch", false, "Apply the differences to the bitstream database and the fabric bitstream, so that they become the same as the reference");
+
+  /* Add an option '--fail_on_diff' */
+  shell_cmd.add_option("fail_on_diff", false, "Error out if any difference is found, e.g., to check that a patch is complete");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command 'diff_architecture_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Compare fabric-independent bitstream database with a reference");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, diff_fpga_bitstream);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: build_fabric_bitstream
  * - Add associated options 
@@ -117,6 +278,10 @@ ShellCommandId add_openfpga_build_fabric_bitstream_command(openfpga::Shell<Openf
                                                            const std::vector<ShellCommandId>& dependent_cmds) {
   Command shell_cmd("build_fabric_bitstream");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to build the fabric bitstream by configuration regions. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -148,12 +313,23 @@ ShellCommandId add_openfpga_write_fabric_bitstream_command(openfpga::Shell<Openf
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
   /* Add an option '--file_format'*/
-  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+  CommandOptionId opt_file_format = shell_cmd.add_option("format", false, "file format of fabric bitstream [plain_text|xml|binary]. Default: plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
   /* Add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false, "Reduce the size of bitstream to be downloaded");
 
+  /* Add an option '--encryption_key_file' */
+  CommandOptionId opt_encryption_key_file = shell_cmd.add_option("encryption_key_file", false, "file path to the AES key and initial counter, which are used to encrypt the bitstream file in counter mode");
+  shell_cmd.set_option_require_value(opt_encryption_key_file, openfpga::OPT_STRING);
+
+  /* Add an option '--compress' */
+  shell_cmd.add_option("compress", false, "Compress the plain text or XML bitstream file in gzip format");
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to format, compress and encrypt the bitstream. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -184,6 +360,10 @@ ShellCommandId add_openfpga_write_io_mapping_command(openfpga::Shell<OpenfpgaCon
   shell_cmd.set_option_short_name(opt_file, "f");
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to format the io mapping information. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -198,6 +378,135 @@ ShellCommandId add_openfpga_write_io_mapping_command(openfpga::Shell<OpenfpgaCon
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: save_context
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_save_context_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                 const ShellCommandClassId& cmd_class_id,
+                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("save_context");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "file path to output the context checkpoint");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'save_context' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Save the fabric and architecture bitstream to a checkpoint");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, save_context);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: load_context
+ * - Add associated options 
+ * - Add command dependency and the commands whose results are loaded
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_load_context_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                 const ShellCommandClassId& cmd_class_id,
+                                                 const std::vector<ShellCommandId>& dependent_cmds,
+                                                 const std::vector<ShellCommandId>& provided_cmds) {
+  Command shell_cmd("load_context");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "file path to the context checkpoint");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--unique_gsb_cache' */
+  CommandOptionId opt_unique_gsb_cache = shell_cmd.add_option("unique_gsb_cache", false, "load the unique GSBs from a cache file if it is built from the same GSBs, otherwise write the unique GSBs to the file. Only applicable when the fabric is built with --compress_routing");
+  shell_cmd.set_option_require_value(opt_unique_gsb_cache, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'load_context' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Load the fabric and architecture bitstream from a checkpoint");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, load_context);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+  shell.set_command_provision(shell_cmd_id, provided_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_architecture_bitstream
+ * - Add the commands whose results are dropped
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_free_arch_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                        const ShellCommandClassId& cmd_class_id,
+                                                        const std::vector<ShellCommandId>& invalidated_cmds) {
+  Command shell_cmd("free_architecture_bitstream");
+
+  /* Add command 'free_architecture_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Free the architecture bitstream and the fabric bitstream which are no longer needed");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, free_arch_bitstream);
+
+  /* The bitstreams have to be built again before being used */
+  shell.set_command_invalidation(shell_cmd_id, invalidated_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_fabric_bitstream
+ * - Add the commands whose results are dropped
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_free_fabric_bitstream_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                          const ShellCommandClassId& cmd_class_id,
+                                                          const std::vector<ShellCommandId>& invalidated_cmds) {
+  Command shell_cmd("free_fabric_bitstream");
+
+  /* Add command 'free_fabric_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Free the fabric bitstream which is no longer needed");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, free_fabric_bitstream);
+
+  /* The fabric bitstream has to be built again before being used */
+  shell.set_command_invalidation(shell_cmd_id, invalidated_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_design
+ * - Add the commands whose results are dropped
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_free_design_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                const ShellCommandClassId& cmd_class_id,
+                                                const std::vector<ShellCommandId>& invalidated_cmds) {
+  Command shell_cmd("free_design");
+
+  /* Add command 'free_design' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Free the implementation results and the bitstreams of a design, so that another design can be implemented on the same fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, free_design);
+
+  /* The design has to be repacked before building its bitstreams */
+  shell.set_command_invalidation(shell_cmd_id, invalidated_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * Top-level function to add all the commands related to FPGA-Bitstream
  *******************************************************************/
@@ -224,6 +533,22 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   cmd_dependency_build_arch_bitstream.push_back(shell_cmd_repack_id);
   ShellCommandId shell_cmd_build_arch_bitstream_id = add_openfpga_build_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_build_arch_bitstream);
 
+  /******************************** 
+   * Command 'update_architecture_bitstream' 
+   */
+  /* The 'update_architecture_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_update_arch_bitstream;
+  cmd_dependency_update_arch_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_update_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_update_arch_bitstream);
+
+  /******************************** 
+   * Command 'diff_architecture_bitstream' 
+   */
+  /* The 'diff_architecture_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_diff_arch_bitstream;
+  cmd_dependency_diff_arch_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_diff_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_diff_arch_bitstream);
+
   /******************************** 
    * Command 'report_bitstream_distribution' 
    */
@@ -232,6 +557,14 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   cmd_dependency_build_arch_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
   add_openfpga_report_bitstream_distribution_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_report_bitstream_distribution);
 
+  /******************************** 
+   * Command 'report_sparse_bitstream' 
+   */
+  /* The 'report_sparse_bitstream' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_report_sparse_bitstream;
+  cmd_dependency_report_sparse_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_report_sparse_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_report_sparse_bitstream);
+
   /******************************** 
    * Command 'build_fabric_bitstream' 
    */
@@ -248,6 +581,14 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   cmd_dependency_write_fabric_bitstream.push_back(shell_cmd_build_fabric_bitstream_id);
   add_openfpga_write_fabric_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream);
 
+  /******************************** 
+   * Command 'report_fabric_bitstream_stats' 
+   */
+  /* The 'report_fabric_bitstream_stats' command should NOT be executed before 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_report_fabric_bitstream_stats;
+  cmd_dependency_report_fabric_bitstream_stats.push_back(shell_cmd_build_fabric_bitstream_id);
+  add_openfpga_report_fabric_bitstream_stats_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_report_fabric_bitstream_stats);
+
   /******************************** 
    * Command 'write_io_mapping' 
    */
@@ -255,6 +596,55 @@ void add_openfpga_bitstream_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   std::vector<ShellCommandId> cmd_dependency_write_io_mapping;
   cmd_dependency_write_io_mapping.push_back(shell_cmd_build_fabric_id);
   add_openfpga_write_io_mapping_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_write_io_mapping);
+
+  /******************************** 
+   * Command 'save_context' 
+   */
+  /* The 'save_context' command should NOT be executed before 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_save_context;
+  cmd_dependency_save_context.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_save_context_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_save_context);
+
+  /******************************** 
+   * Command 'load_context' 
+   */
+  /* The 'load_context' command should NOT be executed before 'link_openfpga_arch'
+   * It restores the results of 'build_fabric' and 'build_architecture_bitstream'
+   */
+  std::vector<ShellCommandId> cmd_dependency_load_context;
+  cmd_dependency_load_context.push_back(shell.command(std::string("link_openfpga_arch")));
+  std::vector<ShellCommandId> cmd_provision_load_context;
+  cmd_provision_load_context.push_back(shell_cmd_build_fabric_id);
+  cmd_provision_load_context.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_load_context_command(shell, openfpga_bitstream_cmd_class, cmd_dependency_load_context, cmd_provision_load_context);
+
+  /******************************** 
+   * Command 'free_architecture_bitstream' 
+   */
+  /* The 'free_architecture_bitstream' command drops the results of 'build_architecture_bitstream' and all the commands depending on it */
+  std::vector<ShellCommandId> cmd_invalidation_free_arch_bitstream;
+  cmd_invalidation_free_arch_bitstream.push_back(shell_cmd_build_arch_bitstream_id);
+  add_openfpga_free_arch_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_invalidation_free_arch_bitstream);
+
+  /******************************** 
+   * Command 'free_fabric_bitstream' 
+   */
+  /* The 'free_fabric_bitstream' command drops the results of 'build_fabric_bitstream' and all the commands depending on it */
+  std::vector<ShellCommandId> cmd_invalidation_free_fabric_bitstream;
+  cmd_invalidation_free_fabric_bitstream.push_back(shell_cmd_build_fabric_bitstream_id);
+  add_openfpga_free_fabric_bitstream_command(shell, openfpga_bitstream_cmd_class, cmd_invalidation_free_fabric_bitstream);
+
+  /******************************** 
+   * Command 'free_design' 
+   */
+  /* The 'free_design' command drops the results of the commands dealing with the netlist of a design,
+   * while the results of 'build_fabric' are kept
+   */
+  std::vector<ShellCommandId> cmd_invalidation_free_design;
+  cmd_invalidation_free_design.push_back(shell.command(std::string("pb_pin_fixup")));
+  cmd_invalidation_free_design.push_back(shell.command(std::string("lut_truth_table_fixup")));
+  cmd_invalidation_free_design.push_back(shell_cmd_repack_id);
+  add_openfpga_free_design_command(shell, openfpga_bitstream_cmd_class, cmd_invalidation_free_design);
 } 
 
 } /* end namespace openfpga */
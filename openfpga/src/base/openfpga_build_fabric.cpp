@@ -1,23 +1,37 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <set>
+#include <sstream>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_digest.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_tokenizer.h"
+
 /* Headers from fabrickey library */
 #include "read_xml_fabric_key.h"
+#include "binary_fabric_key.h"
 
 #include "device_rr_gsb.h"
 #include "device_rr_gsb_utils.h"
+#include "device_rr_gsb_cache.h"
 #include "build_device_module.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
+#include "fabric_snapshot_writer.h"
+#include "fabric_snapshot_reader.h"
+#include "fabric_tile_cluster.h"
+#include "routing_compression_report.h"
 #include "build_fabric_io_location_map.h"
 #include "build_fabric_global_port_info.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_build_fabric.h"
 
 /* Include global variables of VPR */
@@ -29,14 +43,37 @@ namespace openfpga {
 /********************************************************************
  * Identify the unique GSBs from the Device RR GSB arrays
  * This function should only be called after the GSB builder is done
+ * When a cache file is given, the unique GSBs are loaded from the cache
+ * if it is built from the same GSBs, otherwise they are identified
+ * from scratch and written to the cache
  *******************************************************************/
-static 
 void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
+                                const size_t& num_threads,
+                                const std::string& cache_fname,
                                 const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer("Identify unique General Switch Blocks (GSBs)");
 
+  bool cache_loaded = false;
+  uint64_t fingerprint = 0;
+  if (false == cache_fname.empty()) {
+    fingerprint = find_device_rr_gsb_fingerprint(openfpga_ctx.device_rr_gsb(), g_vpr_ctx.device().rr_graph);
+    cache_loaded = (0 == read_device_rr_gsb_unique_module_from_binary_file(openfpga_ctx.mutable_device_rr_gsb(),
+                                                                           fingerprint,
+                                                                           cache_fname,
+                                                                           verbose_output));
+  }
+
   /* Build unique module lists */
-  openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph);
+  if (false == cache_loaded) {
+    openfpga_ctx.mutable_device_rr_gsb().build_unique_module(g_vpr_ctx.device().rr_graph, num_threads);
+    /* A failure in writing the cache does not affect the fabric */
+    if (false == cache_fname.empty()) {
+      write_device_rr_gsb_unique_module_to_binary_file(openfpga_ctx.device_rr_gsb(),
+                                                       fingerprint,
+                                                       cache_fname,
+                                                       verbose_output);
+    }
+  }
 
   /* Report the stats */
   VTR_LOGV(verbose_output, 
@@ -63,6 +100,130 @@ void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
           100. * ((float)find_device_rr_gsb_num_gsb_modules(openfpga_ctx.device_rr_gsb()) / (float)openfpga_ctx.device_rr_gsb().get_num_gsb_unique_module() - 1.));
 }
 
+/********************************************************************
+ * Identify the device on which the fabric is built, i.e., the architectures,
+ * the grids and the routing resources
+ * A fabric can be reused by another design only if the design is
+ * implemented by VPR on the same device
+ *******************************************************************/
+std::string find_device_id(const OpenfpgaContext& openfpga_ctx,
+                           const DeviceContext& vpr_device_ctx) {
+  std::stringstream device_inputs;
+  device_inputs << "vpr_arch=" << vpr_device_ctx.arch->architecture_id << "\n";
+  device_inputs << "openfpga_arch=" << openfpga_ctx.arch().architecture_id << "\n";
+  device_inputs << "device=" << vpr_device_ctx.grid.width() << "x" << vpr_device_ctx.grid.height() << "\n";
+  device_inputs << "rr_graph=" << vpr_device_ctx.rr_graph.nodes().size() << "," << vpr_device_ctx.rr_graph.edges().size() << "\n";
+
+  return vtr::secure_digest_stream(device_inputs);
+}
+
+/********************************************************************
+ * Identify the inputs from which the fabric is built, including
+ * the architectures (with the circuit library), the device and routing
+ * resources, the fabric key and the options of building the fabric
+ * The identifier is a secure digest, which is used to key fabric snapshots
+ *******************************************************************/
+static 
+std::string find_fabric_id(const OpenfpgaContext& openfpga_ctx,
+                           const DeviceContext& vpr_device_ctx,
+                           const std::string& fabric_key_fname,
+                           const bool& frame_view,
+                           const bool& compress_routing,
+                           const bool& duplicate_grid_pin,
+                           const bool& merge_grid_modules,
+                           const bool& generate_random_fabric_key,
+                           const bool& balance_config_regions,
+                           const std::set<std::string>& requested_modules) {
+  std::stringstream fabric_inputs;
+  fabric_inputs << "vpr_arch=" << vpr_device_ctx.arch->architecture_id << "\n";
+  fabric_inputs << "openfpga_arch=" << openfpga_ctx.arch().architecture_id << "\n";
+  fabric_inputs << "device=" << vpr_device_ctx.grid.width() << "x" << vpr_device_ctx.grid.height() << "\n";
+  fabric_inputs << "rr_graph=" << vpr_device_ctx.rr_graph.nodes().size() << "," << vpr_device_ctx.rr_graph.edges().size() << "\n";
+  if (false == fabric_key_fname.empty()) {
+    fabric_inputs << "fabric_key=" << vtr::secure_digest_file(fabric_key_fname) << "\n";
+  }
+  fabric_inputs << "frame_view=" << frame_view << "\n";
+  fabric_inputs << "compress_routing=" << compress_routing << "\n";
+  fabric_inputs << "duplicate_grid_pin=" << duplicate_grid_pin << "\n";
+  fabric_inputs << "merge_identical_grid_modules=" << merge_grid_modules << "\n";
+  fabric_inputs << "generate_random_fabric_key=" << generate_random_fabric_key << "\n";
+  fabric_inputs << "balance_config_regions=" << balance_config_regions << "\n";
+  /* A partial fabric is identified by the modules requested */
+  for (const std::string& module_name : requested_modules) {
+    fabric_inputs << "module=" << module_name << "\n";
+  }
+
+  return vtr::secure_digest_stream(fabric_inputs);
+}
+
+/********************************************************************
+ * Read a fabric key from a file
+ * Binary fabric keys are detected by their magic number
+ *******************************************************************/
+static 
+FabricKey read_fabric_key_file(const std::string& fkey_fname) {
+  if (true == is_binary_fabric_key_file(fkey_fname.c_str())) {
+    return read_binary_fabric_key(fkey_fname.c_str());
+  }
+  return read_xml_fabric_key(fkey_fname.c_str());
+}
+
+/********************************************************************
+ * Check that each module requested for a partial fabric is either
+ * a physical tile or a routing module which has been built
+ * Return the number of modules which are not found
+ *******************************************************************/
+static 
+size_t check_requested_fabric_modules(const ModuleManager& module_manager,
+                                      const DeviceContext& vpr_device_ctx,
+                                      const std::set<std::string>& requested_modules) {
+  std::set<std::string> physical_tile_names;
+  for (const t_physical_tile_type& physical_tile : vpr_device_ctx.physical_tile_types) {
+    physical_tile_names.insert(std::string(physical_tile.name));
+  }
+
+  size_t num_err = 0;
+  for (const std::string& module_name : requested_modules) {
+    if ( (0 < physical_tile_names.count(module_name))
+      || (true == module_manager.valid_module_id(module_manager.find_module(module_name))) ) {
+      continue;
+    }
+    VTR_LOG_ERROR("Requested module '%s' is neither a physical tile nor a routing module of the fabric!\n",
+                  module_name.c_str());
+    num_err++;
+  }
+
+  return num_err;
+}
+
+/********************************************************************
+ * Error out for the commands which require the full fabric,
+ * e.g., the top-level module, when only a part of the fabric is built
+ *******************************************************************/
+int check_full_fabric(const OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd) {
+  if (true == openfpga_ctx.flow_manager().partial_fabric()) {
+    VTR_LOG_ERROR("Command '%s' requires the full fabric, while only a part of the fabric is built by 'build_fabric --modules'!\n",
+                  cmd.name().c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Error out for the commands which require the nets of the fabric,
+ * e.g., the netlist writers, when only the configuration layout is loaded
+ *******************************************************************/
+int check_fabric_nets(const OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd) {
+  if (true == openfpga_ctx.flow_manager().configuration_layout()) {
+    VTR_LOG_ERROR("Command '%s' requires the nets of the fabric, while only the configuration layout is loaded by 'read_configuration_layout'!\n",
+                  cmd.name().c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -72,13 +233,50 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_frame_view = cmd.option("frame_view");
   CommandOptionId opt_compress_routing = cmd.option("compress_routing");
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
+  CommandOptionId opt_merge_grid_modules = cmd.option("merge_identical_grid_modules");
   CommandOptionId opt_gen_random_fabric_key = cmd.option("generate_random_fabric_key");
+  CommandOptionId opt_balance_config_regions = cmd.option("balance_config_regions");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
+  CommandOptionId opt_read_snapshot = cmd.option("read_snapshot");
+  CommandOptionId opt_unique_gsb_cache = cmd.option("unique_gsb_cache");
+  CommandOptionId opt_modules = cmd.option("modules");
   CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Only the requested modules are built for a partial fabric */
+  std::set<std::string> requested_modules;
+  if (true == cmd_context.option_enable(cmd, opt_modules)) {
+    StringToken tokenizer(cmd_context.option_value(cmd, opt_modules));
+    for (const std::string& module_name : tokenizer.split(',')) {
+      requested_modules.insert(module_name);
+    }
+    if (true == requested_modules.empty()) {
+      VTR_LOG_ERROR("Expect at least one module name for option '--modules'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    /* A partial fabric has no top-level module, which the fabric key is about */
+    if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
+      VTR_LOG_ERROR("Option '--write_fabric_key' requires the full fabric and cannot be used with option '--modules'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  openfpga_ctx.mutable_flow_manager().set_partial_fabric(false == requested_modules.empty());
+  openfpga_ctx.mutable_flow_manager().set_configuration_layout(false);
+  openfpga_ctx.mutable_flow_manager().set_frame_view(cmd_context.option_enable(cmd, opt_frame_view));
+  openfpga_ctx.mutable_flow_manager().set_duplicate_grid_pin(cmd_context.option_enable(cmd, opt_duplicate_grid_pin));
   
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
-    compress_routing_hierarchy(openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    std::string unique_gsb_cache;
+    if (true == cmd_context.option_enable(cmd, opt_unique_gsb_cache)) {
+      unique_gsb_cache = cmd_context.option_value(cmd, opt_unique_gsb_cache);
+    }
+    compress_routing_hierarchy(openfpga_ctx, num_threads, unique_gsb_cache, cmd_context.option_enable(cmd, opt_verbose));
     /* Update flow manager to enable compress routing */
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
   }
@@ -93,30 +291,75 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
 
   /* Load fabric key from file */
   FabricKey predefined_fabric_key;
+  std::string predefined_fkey_fname;
   if (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) {
-    std::string fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
-    VTR_ASSERT(false == fkey_fname.empty());
-    predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    predefined_fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
+    VTR_ASSERT(false == predefined_fkey_fname.empty());
+    predefined_fabric_key = read_fabric_key_file(predefined_fkey_fname);
   }
 
+  /* Record the inputs of the fabric, which is required by fabric snapshots */
+  openfpga_ctx.mutable_flow_manager().set_fabric_id(find_fabric_id(openfpga_ctx,
+                                                                   g_vpr_ctx.device(),
+                                                                   predefined_fkey_fname,
+                                                                   cmd_context.option_enable(cmd, opt_frame_view),
+                                                                   cmd_context.option_enable(cmd, opt_compress_routing),
+                                                                   cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
+                                                                   cmd_context.option_enable(cmd, opt_merge_grid_modules),
+                                                                   cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+                                                                   cmd_context.option_enable(cmd, opt_balance_config_regions),
+                                                                   requested_modules));
+  openfpga_ctx.mutable_flow_manager().set_device_id(find_device_id(openfpga_ctx, g_vpr_ctx.device()));
+
   VTR_LOG("\n");
 
-  curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
-                                          openfpga_ctx.mutable_decoder_lib(),
-                                          const_cast<const OpenfpgaContext&>(openfpga_ctx),
-                                          g_vpr_ctx.device(),
-                                          cmd_context.option_enable(cmd, opt_frame_view),
-                                          cmd_context.option_enable(cmd, opt_compress_routing),
-                                          cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
-                                          predefined_fabric_key,
-                                          cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
-                                          cmd_context.option_enable(cmd, opt_verbose));
+  /* Load the fabric from a snapshot if it is built from the same inputs,
+   * otherwise, build the fabric from scratch
+   */
+  bool snapshot_loaded = false;
+  if (true == cmd_context.option_enable(cmd, opt_read_snapshot)) {
+    snapshot_loaded = (0 == read_fabric_snapshot_from_binary_file(openfpga_ctx.mutable_module_graph(),
+                                                                  openfpga_ctx.mutable_decoder_lib(),
+                                                                  openfpga_ctx.flow_manager().fabric_id(),
+                                                                  cmd_context.option_value(cmd, opt_read_snapshot),
+                                                                  cmd_context.option_enable(cmd, opt_verbose)));
+    if (false == snapshot_loaded) {
+      VTR_LOG_WARN("Unable to load the fabric snapshot. Build the fabric from scratch\n");
+    }
+  }
+
+  if (false == snapshot_loaded) {
+    curr_status = build_device_module_graph(openfpga_ctx.mutable_module_graph(),
+                                            openfpga_ctx.mutable_decoder_lib(),
+                                            const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                            g_vpr_ctx.device(),
+                                            cmd_context.option_enable(cmd, opt_frame_view),
+                                            cmd_context.option_enable(cmd, opt_compress_routing),
+                                            cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
+                                            cmd_context.option_enable(cmd, opt_merge_grid_modules),
+                                            predefined_fabric_key,
+                                            cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+                                            cmd_context.option_enable(cmd, opt_balance_config_regions),
+                                            requested_modules,
+                                            num_threads,
+                                            cmd_context.option_enable(cmd, opt_verbose));
+  }
 
   /* If there is any error, final status cannot be overwritten by a success flag */
   if (CMD_EXEC_SUCCESS != curr_status) {
     final_status = curr_status;
   }
 
+  /* A partial fabric has no top-level module, from which the I/O and global ports are found */
+  if (false == requested_modules.empty()) {
+    openfpga_ctx.mutable_io_location_map() = IoLocationMap();
+    openfpga_ctx.mutable_fabric_global_port_info() = FabricGlobalPortInfo();
+    if (0 < check_requested_fabric_modules(openfpga_ctx.module_graph(), g_vpr_ctx.device(), requested_modules)) {
+      final_status = CMD_EXEC_FATAL_ERROR;
+    }
+    return final_status;
+  }
+
   /* Build I/O location map */
   openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
                                                                         g_vpr_ctx.device().grid);
@@ -142,6 +385,71 @@ int build_fabric(OpenfpgaContext& openfpga_ctx,
   return final_status;
 } 
 
+/********************************************************************
+ * Load another fabric key on the module graph of the FPGA device:
+ * only the top-level module, whose configurable children and
+ * configuration nets depend on the fabric key, is rebuilt
+ *******************************************************************/
+int update_fabric_key(OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  if ( (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd))
+    || (CMD_EXEC_SUCCESS != check_fabric_nets(openfpga_ctx, cmd)) ) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string fkey_fname = cmd_context.option_value(cmd, opt_file);
+  VTR_ASSERT(false == fkey_fname.empty());
+  FabricKey fabric_key = read_fabric_key_file(fkey_fname);
+
+  int status = rebuild_device_top_module(openfpga_ctx.mutable_module_graph(),
+                                         openfpga_ctx.mutable_decoder_lib(),
+                                         const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                         g_vpr_ctx.device(),
+                                         openfpga_ctx.flow_manager().frame_view(),
+                                         openfpga_ctx.flow_manager().compress_routing(),
+                                         openfpga_ctx.flow_manager().duplicate_grid_pin(),
+                                         fabric_key,
+                                         num_threads);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  /* The fabric is now built from other inputs */
+  std::stringstream fabric_inputs;
+  fabric_inputs << "fabric=" << openfpga_ctx.flow_manager().fabric_id() << "\n";
+  fabric_inputs << "fabric_key=" << vtr::secure_digest_file(fkey_fname) << "\n";
+  openfpga_ctx.mutable_flow_manager().set_fabric_id(vtr::secure_digest_stream(fabric_inputs));
+
+  /* The I/O and global ports are found from the new top-level module */
+  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
+                                                                        g_vpr_ctx.device().grid);
+  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
+                                                                                 openfpga_ctx.arch().tile_annotations,
+                                                                                 openfpga_ctx.arch().circuit_lib);
+
+  /* Output fabric key if user requested */
+  if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
+    std::string write_fkey_fname = cmd_context.option_value(cmd, opt_write_fabric_key);
+    VTR_ASSERT(false == write_fkey_fname.empty());
+    status = write_fabric_key_to_xml_file(openfpga_ctx.module_graph(),
+                                          write_fkey_fname,
+                                          cmd_context.option_enable(cmd, opt_verbose));
+  }
+
+  return status;
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -150,6 +458,10 @@ int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Check the option '--file' is enabled or not 
    * Actually, it must be enabled as the shell interface will check 
    * before reaching this fuction
@@ -180,4 +492,185 @@ int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
                                              cmd_context.option_enable(cmd, opt_verbose));
 }
 
+/********************************************************************
+ * Write the module graph and decoder library to a snapshot file,
+ * which can be loaded by build_fabric in later runs
+ *******************************************************************/
+int write_fabric_snapshot(const OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  if (CMD_EXEC_SUCCESS != check_fabric_nets(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Check the option '--file' is enabled or not 
+   * Actually, it must be enabled as the shell interface will check 
+   * before reaching this fuction
+   */
+  CommandOptionId opt_file = cmd.option("file");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  int status = write_fabric_snapshot_to_binary_file(openfpga_ctx.module_graph(),
+                                                    openfpga_ctx.decoder_lib(),
+                                                    openfpga_ctx.flow_manager().fabric_id(),
+                                                    cmd_context.option_value(cmd, opt_file),
+                                                    cmd_context.option_enable(cmd, opt_verbose));
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Write the configuration layout of the fabric, i.e., the modules,
+ * their ports and configurable children without nets, which is
+ * enough to generate bitstreams by read_configuration_layout in later runs
+ *******************************************************************/
+int write_configuration_layout(const OpenfpgaContext& openfpga_ctx,
+                               const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  int status = write_configuration_layout_to_binary_file(openfpga_ctx.module_graph(),
+                                                         openfpga_ctx.decoder_lib(),
+                                                         openfpga_ctx.flow_manager().device_id(),
+                                                         openfpga_ctx.flow_manager().compress_routing(),
+                                                         cmd_context.option_value(cmd, opt_file),
+                                                         cmd_context.option_enable(cmd, opt_verbose));
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Load the configuration layout of a fabric in place of building the fabric,
+ * so that bitstreams can be generated without building the module graph
+ *******************************************************************/
+int read_configuration_layout(OpenfpgaContext& openfpga_ctx,
+                              const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  std::string layout_fname = cmd_context.option_value(cmd, opt_file);
+  VTR_ASSERT(false == layout_fname.empty());
+
+  std::string device_id = find_device_id(openfpga_ctx, g_vpr_ctx.device());
+  bool compress_routing = false;
+  if (0 != read_configuration_layout_from_binary_file(openfpga_ctx.mutable_module_graph(),
+                                                      openfpga_ctx.mutable_decoder_lib(),
+                                                      device_id,
+                                                      layout_fname,
+                                                      compress_routing,
+                                                      cmd_context.option_enable(cmd, opt_verbose))) {
+    VTR_LOG_ERROR("Unable to load the configuration layout '%s'!\n",
+                  layout_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The names of the routing modules in a compressed fabric are given by the unique GSBs */
+  if (true == compress_routing) {
+    compress_routing_hierarchy(openfpga_ctx, openfpga_ctx.flow_manager().num_threads(),
+                               std::string(), cmd_context.option_enable(cmd, opt_verbose));
+  }
+  openfpga_ctx.mutable_flow_manager().set_compress_routing(compress_routing);
+  openfpga_ctx.mutable_flow_manager().set_partial_fabric(false);
+  openfpga_ctx.mutable_flow_manager().set_configuration_layout(true);
+  /* The layout is built from inputs which are unknown, and identifies the fabric by itself */
+  openfpga_ctx.mutable_flow_manager().set_fabric_id(vtr::secure_digest_file(layout_fname));
+  openfpga_ctx.mutable_flow_manager().set_device_id(device_id);
+
+  /* Rebuild the data which is derived from the fabric, as build_fabric does */
+  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
+                                                                        g_vpr_ctx.device().grid);
+  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
+                                                                                 openfpga_ctx.arch().tile_annotations,
+                                                                                 openfpga_ctx.arch().circuit_lib);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Report the repeating clusters of tiles in the FPGA fabric,
+ * which estimates how much a hierarchical fabric can save 
+ *******************************************************************/
+int report_fabric_tile_clusters(const OpenfpgaContext& openfpga_ctx,
+                                const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Default maximum size of clusters */
+  int max_size = 4;
+  CommandOptionId opt_max_size = cmd.option("max_size");
+  if (true == cmd_context.option_enable(cmd, opt_max_size)) {
+    max_size = std::atoi(cmd_context.option_value(cmd, opt_max_size).c_str());
+    /* Error out if we have a non-positive size */
+    if (0 >= max_size) {
+      VTR_LOG_ERROR("Invalid maximum size '%d' which should be a positive number!\n",
+                    max_size);
+      return CMD_EXEC_FATAL_ERROR; 
+    }
+  }
+
+  int status = report_fabric_tile_clusters(g_vpr_ctx.device().grid,
+                                           openfpga_ctx.device_rr_gsb(),
+                                           openfpga_ctx.flow_manager().compress_routing(),
+                                           size_t(max_size),
+                                           cmd_context.option_enable(cmd, opt_verbose));
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Report how the routing blocks are compressed into unique modules,
+ * which shows where the regularity of the routing architecture breaks
+ *******************************************************************/
+int report_routing_compression(const OpenfpgaContext& openfpga_ctx,
+                               const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string json_fname;
+  if (true == cmd_context.option_enable(cmd, opt_file)) {
+    json_fname = cmd_context.option_value(cmd, opt_file);
+  }
+
+  int status = report_routing_compression(openfpga_ctx.device_rr_gsb(),
+                                          g_vpr_ctx.device().rr_graph,
+                                          openfpga_ctx.flow_manager().compress_routing(),
+                                          json_fname,
+                                          size_t(num_threads),
+                                          cmd_context.option_enable(cmd, opt_verbose));
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "command.h"
 #include "command_context.h"
 #include "openfpga_context.h"
@@ -15,12 +16,44 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void compress_routing_hierarchy(OpenfpgaContext& openfpga_ctx,
+                                const size_t& num_threads,
+                                const std::string& cache_fname,
+                                const bool& verbose_output);
+
+std::string find_device_id(const OpenfpgaContext& openfpga_ctx,
+                           const DeviceContext& vpr_device_ctx);
+
+int check_full_fabric(const OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd);
+
+int check_fabric_nets(const OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd);
+
 int build_fabric(OpenfpgaContext& openfpga_ctx,
                  const Command& cmd, const CommandContext& cmd_context); 
 
+int update_fabric_key(OpenfpgaContext& openfpga_ctx,
+                      const Command& cmd, const CommandContext& cmd_context); 
+
 int write_fabric_hierarchy(const OpenfpgaContext& openfpga_ctx,
                            const Command& cmd, const CommandContext& cmd_context); 
 
+int write_fabric_snapshot(const OpenfpgaContext& openfpga_ctx,
+                          const Command& cmd, const CommandContext& cmd_context); 
+
+int write_configuration_layout(const OpenfpgaContext& openfpga_ctx,
+                               const Command& cmd, const CommandContext& cmd_context); 
+
+int read_configuration_layout(OpenfpgaContext& openfpga_ctx,
+                              const Command& cmd, const CommandContext& cmd_context); 
+
+int report_fabric_tile_clusters(const OpenfpgaContext& openfpga_ctx,
+                                const Command& cmd, const CommandContext& cmd_context); 
+
+int report_routing_compression(const OpenfpgaContext& openfpga_ctx,
+                               const Command& cmd, const CommandContext& cmd_context); 
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,44 @@
+/********************************************************************
+ * This file includes functions that are shared by the commands
+ * of openfpga shell to parse their options
+ *******************************************************************/
+#include <cstdlib>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+#include "openfpga_command_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Find the number of threads to be used by a command:
+ *  - the value of its option (by default, '--num_threads') when enabled
+ *  - otherwise, the number given by 'set_num_threads'
+ * 0 means all the cores of the machine
+ *
+ * Return:
+ *  - the number of threads, which is 0 or positive
+ *  - a negative number if the option value is invalid, with an error message
+ *******************************************************************/
+int find_command_num_threads(const FlowManager& flow_manager,
+                             const Command& cmd, const CommandContext& cmd_context,
+                             const std::string& option_name) {
+  CommandOptionId opt_num_threads = cmd.option(option_name);
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = flow_manager.num_threads();
+  if ( (CommandOptionId::INVALID() != opt_num_threads)
+    && (true == cmd_context.option_enable(cmd, opt_num_threads)) ) {
+    num_threads = std::atoi(cmd_context.option_value(cmd, opt_num_threads).c_str());
+    /* Error out if we have negative number of threads */
+    if (0 > num_threads) {
+      VTR_LOG_ERROR("Invalid number of threads '%d' which should be 0 or a positive number!\n",
+                    num_threads);
+    }
+  }
+  return num_threads;
+}
+
+} /* end namespace openfpga */
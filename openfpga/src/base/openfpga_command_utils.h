@@ -0,0 +1,25 @@
+#ifndef OPENFPGA_COMMAND_UTILS_H
+#define OPENFPGA_COMMAND_UTILS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_flow_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int find_command_num_threads(const FlowManager& flow_manager,
+                             const Command& cmd, const CommandContext& cmd_context,
+                             const std::string& option_name = std::string("num_threads"));
+
+} /* end namespace openfpga */
+
+#endif
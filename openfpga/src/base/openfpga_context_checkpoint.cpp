@@ -0,0 +1,369 @@
+/********************************************************************
+ * This file includes functions to save the data of OpenFPGA
+ * which is built after placement and routing to a checkpoint,
+ * and to load the checkpoint, so that a flow can resume
+ * at the writers without building the fabric and bitstream again
+ *
+ * A checkpoint consists of
+ * - a fabric snapshot (see fabric_snapshot_writer.cpp)
+ *   in the file with a suffix '.fabric'
+ * - a binary architecture bitstream (see write_binary_arch_bitstream.cpp)
+ *   in the file with a suffix '.arch_bitstream'
+ * - a manifest file, which is written in the end, so that
+ *   a checkpoint is valid only when all the files are complete.
+ *   The manifest is a sequence of 64-bit words and strings, where
+ *   a string is a word of its length followed by its characters:
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   magic number "OFPGACTX"                            |
+ *   |   endian marker 0x0102030405060708                   |
+ *   |   format version                                     |
+ *   +------------------------------------------------------+
+ *   | Context id (string)                                  |
+ *   | Fabric id (string)                                   |
+ *   | Flags of the flow                                    |
+ *   | File names of the fabric snapshot and bitstream      |
+ *   |   (string, relative to the manifest)                 |
+ *   +------------------------------------------------------+
+ *
+ * The data of VPR and the annotation from OpenFPGA architecture are
+ * not in the checkpoint. They are loaded by running the same
+ * commands as the flow which saves the checkpoint (e.g., 'vpr' with
+ * the placement and routing results, 'read_openfpga_arch' and
+ * 'link_openfpga_arch'), which is checked by the context id
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_digest.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Headers from fpgabitstream library */
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+
+#include "fabric_snapshot_writer.h"
+#include "fabric_snapshot_reader.h"
+#include "build_fabric_io_location_map.h"
+#include "build_fabric_global_port_info.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_context_checkpoint.h"
+
+/* Include global variables of VPR */
+#include "globals.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Flags of the flow stored in the manifest */
+constexpr uint64_t CONTEXT_CHECKPOINT_COMPRESS_ROUTING_FLAG = 1;
+
+/********************************************************************
+ * Identify the data which a checkpoint is built upon, including
+ * the architectures, the device and routing resources,
+ * the netlists, as well as the placement and routing results
+ * The identifier is a secure digest
+ *******************************************************************/
+static
+std::string find_context_checkpoint_id(const OpenfpgaContext& openfpga_ctx,
+                                       const VprContext& vpr_ctx) {
+  std::stringstream context_inputs;
+  context_inputs << "vpr_arch=" << vpr_ctx.device().arch->architecture_id << "\n";
+  context_inputs << "openfpga_arch=" << openfpga_ctx.arch().architecture_id << "\n";
+  context_inputs << "device=" << vpr_ctx.device().grid.width() << "x" << vpr_ctx.device().grid.height() << "\n";
+  context_inputs << "rr_graph=" << vpr_ctx.device().rr_graph.nodes().size() << "," << vpr_ctx.device().rr_graph.edges().size() << "\n";
+  context_inputs << "atom_netlist=" << vpr_ctx.atom().nlist.netlist_id() << "\n";
+  context_inputs << "clb_netlist=" << vpr_ctx.clustering().clb_nlist.netlist_id() << "\n";
+
+  context_inputs << "placement=";
+  for (const ClusterBlockId& blk : vpr_ctx.clustering().clb_nlist.blocks()) {
+    const t_pl_loc& loc = vpr_ctx.placement().block_locs[blk].loc;
+    context_inputs << loc.x << "," << loc.y << "," << loc.z << ";";
+  }
+  context_inputs << "\n";
+
+  context_inputs << "routing=";
+  for (const ClusterNetId& net : vpr_ctx.clustering().clb_nlist.nets()) {
+    for (const t_trace* tptr = vpr_ctx.routing().trace[net].head; nullptr != tptr; tptr = tptr->next) {
+      context_inputs << size_t(tptr->index) << ",";
+    }
+    context_inputs << ";";
+  }
+  context_inputs << "\n";
+
+  return vtr::secure_digest_stream(context_inputs);
+}
+
+/********************************************************************
+ * Find the path of a file of a checkpoint, which is relative to the manifest
+ *******************************************************************/
+static
+std::string find_context_checkpoint_file_path(const std::string& manifest_fname,
+                                              const std::string& fname) {
+  std::string dir_path = find_path_dir_name(manifest_fname);
+  if (true == dir_path.empty()) {
+    return fname;
+  }
+  return format_dir_path(dir_path) + fname;
+}
+
+/********************************************************************
+ * Append a word or a string to the buffer of a manifest
+ *******************************************************************/
+static
+void append_context_checkpoint_word(std::string& buffer,
+                                    const uint64_t& word) {
+  buffer.append(reinterpret_cast<const char*>(&word), sizeof(uint64_t));
+}
+
+static
+void append_context_checkpoint_string(std::string& buffer,
+                                      const std::string& str) {
+  append_context_checkpoint_word(buffer, str.size());
+  buffer.append(str);
+}
+
+/********************************************************************
+ * A cursor on the content of a manifest
+ * Reading beyond the end of the content will mark the cursor as failed
+ *******************************************************************/
+class ContextCheckpointCursor {
+  public: /* Public constructor */
+    explicit ContextCheckpointCursor(const std::string& content)
+      : content_(content), offset_(0), failed_(false) {}
+
+  public: /* Public mutators */
+    uint64_t read_word() {
+      uint64_t word = 0;
+      if ((true == failed_) || (content_.size() - offset_ < sizeof(uint64_t))) {
+        failed_ = true;
+        return word;
+      }
+      std::memcpy(&word, content_.data() + offset_, sizeof(uint64_t));
+      offset_ += sizeof(uint64_t);
+      return word;
+    }
+
+    std::string read_string() {
+      uint64_t length = read_word();
+      if ((true == failed_) || (content_.size() - offset_ < length)) {
+        failed_ = true;
+        return std::string();
+      }
+      std::string str = content_.substr(offset_, length);
+      offset_ += length;
+      return str;
+    }
+
+  public: /* Public accessors */
+    bool failed() const { return failed_; }
+    bool finished() const { return offset_ == content_.size(); }
+
+  private: /* Internal data */
+    const std::string& content_;
+    size_t offset_;
+    bool failed_;
+};
+
+/********************************************************************
+ * Save the fabric and the architecture bitstream to a checkpoint
+ *******************************************************************/
+int save_context(const OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* The fabric of a checkpoint is a snapshot with nets */
+  if (CMD_EXEC_SUCCESS != check_fabric_nets(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Check the option '--file' is enabled or not 
+   * Actually, it must be enabled as the shell interface will check 
+   * before reaching this fuction
+   */
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  std::string manifest_fname = cmd_context.option_value(cmd, opt_file);
+  VTR_ASSERT(false == manifest_fname.empty());
+
+  std::string timer_message = std::string("Save context checkpoint '") + manifest_fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  if (false == find_path_dir_name(manifest_fname).empty()) {
+    create_directory(find_path_dir_name(manifest_fname));
+  }
+
+  std::string fabric_fname = find_path_file_name(manifest_fname) + std::string(".fabric");
+  std::string bitstream_fname = find_path_file_name(manifest_fname) + std::string(".arch_bitstream");
+
+  if (0 != write_fabric_snapshot_to_binary_file(openfpga_ctx.module_graph(),
+                                                openfpga_ctx.decoder_lib(),
+                                                openfpga_ctx.flow_manager().fabric_id(),
+                                                find_context_checkpoint_file_path(manifest_fname, fabric_fname),
+                                                cmd_context.option_enable(cmd, opt_verbose))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (0 != write_binary_architecture_bitstream(openfpga_ctx.bitstream_manager(),
+                                               find_context_checkpoint_file_path(manifest_fname, bitstream_fname))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The manifest is written in the end */
+  std::string buffer(CONTEXT_CHECKPOINT_MAGIC, sizeof(uint64_t));
+  append_context_checkpoint_word(buffer, CONTEXT_CHECKPOINT_ENDIAN_MARKER);
+  append_context_checkpoint_word(buffer, CONTEXT_CHECKPOINT_VERSION);
+  append_context_checkpoint_string(buffer, find_context_checkpoint_id(openfpga_ctx, g_vpr_ctx));
+  append_context_checkpoint_string(buffer, openfpga_ctx.flow_manager().fabric_id());
+  uint64_t flags = 0;
+  if (true == openfpga_ctx.flow_manager().compress_routing()) {
+    flags |= CONTEXT_CHECKPOINT_COMPRESS_ROUTING_FLAG;
+  }
+  append_context_checkpoint_word(buffer, flags);
+  append_context_checkpoint_string(buffer, fabric_fname);
+  append_context_checkpoint_string(buffer, bitstream_fname);
+
+  std::fstream fp;
+  fp.open(manifest_fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  check_file_stream(manifest_fname.c_str(), fp);
+  fp.write(buffer.data(), buffer.size());
+
+  int status = CMD_EXEC_SUCCESS;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write context checkpoint '%s'!\n",
+                  manifest_fname.c_str());
+    status = CMD_EXEC_FATAL_ERROR;
+  }
+  fp.close();
+
+  return status;
+}
+
+/********************************************************************
+ * Load the fabric and the architecture bitstream from a checkpoint
+ * The checkpoint must be saved upon the same data of VPR and
+ * OpenFPGA architecture as the current ones
+ *******************************************************************/
+int load_context(OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context) { 
+
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_unique_gsb_cache = cmd.option("unique_gsb_cache");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  std::string manifest_fname = cmd_context.option_value(cmd, opt_file);
+  VTR_ASSERT(false == manifest_fname.empty());
+
+  std::string timer_message = std::string("Load context checkpoint '") + manifest_fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Load the manifest */
+  std::ifstream fp(manifest_fname, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Unable to open context checkpoint '%s'!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  std::string content(fp.tellg(), '\0');
+  fp.seekg(0);
+  fp.read(&content[0], content.size());
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to read context checkpoint '%s'!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  fp.close();
+
+  ContextCheckpointCursor cursor(content);
+  uint64_t magic = cursor.read_word();
+  if ((true == cursor.failed())
+     || (0 != std::memcmp(&magic, CONTEXT_CHECKPOINT_MAGIC, sizeof(uint64_t)))
+     || (CONTEXT_CHECKPOINT_ENDIAN_MARKER != cursor.read_word())) {
+    VTR_LOG_ERROR("File '%s' is not a context checkpoint or written by a machine with a different byte order!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  uint64_t version = cursor.read_word();
+  if (CONTEXT_CHECKPOINT_VERSION != version) {
+    VTR_LOG_ERROR("Unsupported version '%lu' of context checkpoint '%s' (expect '%lu')!\n",
+                  version, manifest_fname.c_str(), CONTEXT_CHECKPOINT_VERSION);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  std::string context_id = cursor.read_string();
+  std::string fabric_id = cursor.read_string();
+  uint64_t flags = cursor.read_word();
+  std::string fabric_fname = cursor.read_string();
+  std::string bitstream_fname = cursor.read_string();
+  if ((true == cursor.failed()) || (false == cursor.finished())) {
+    VTR_LOG_ERROR("Context checkpoint '%s' is corrupted!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (context_id != find_context_checkpoint_id(openfpga_ctx, g_vpr_ctx)) {
+    VTR_LOG_ERROR("Context checkpoint '%s' is saved from different architectures, netlists or placement and routing results!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Identify the unique GSBs, which is not in the checkpoint */
+  bool compress_routing = (0 != (flags & CONTEXT_CHECKPOINT_COMPRESS_ROUTING_FLAG));
+  if (true == compress_routing) {
+    std::string unique_gsb_cache;
+    if (true == cmd_context.option_enable(cmd, opt_unique_gsb_cache)) {
+      unique_gsb_cache = cmd_context.option_value(cmd, opt_unique_gsb_cache);
+    }
+    compress_routing_hierarchy(openfpga_ctx, 1, unique_gsb_cache, cmd_context.option_enable(cmd, opt_verbose));
+  }
+  openfpga_ctx.mutable_flow_manager().set_compress_routing(compress_routing);
+  openfpga_ctx.mutable_flow_manager().set_fabric_id(fabric_id);
+  openfpga_ctx.mutable_flow_manager().set_device_id(find_device_id(openfpga_ctx, g_vpr_ctx.device()));
+  openfpga_ctx.mutable_flow_manager().set_configuration_layout(false);
+
+  if (0 != read_fabric_snapshot_from_binary_file(openfpga_ctx.mutable_module_graph(),
+                                                 openfpga_ctx.mutable_decoder_lib(),
+                                                 fabric_id,
+                                                 find_context_checkpoint_file_path(manifest_fname, fabric_fname),
+                                                 cmd_context.option_enable(cmd, opt_verbose))) {
+    VTR_LOG_ERROR("Unable to load the fabric of context checkpoint '%s'!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Rebuild the data which is derived from the fabric, as build_fabric does */
+  openfpga_ctx.mutable_io_location_map() = build_fabric_io_location_map(openfpga_ctx.module_graph(),
+                                                                        g_vpr_ctx.device().grid);
+  openfpga_ctx.mutable_fabric_global_port_info() = build_fabric_global_port_info(openfpga_ctx.module_graph(),
+                                                                                 openfpga_ctx.arch().tile_annotations,
+                                                                                 openfpga_ctx.arch().circuit_lib);
+
+  if (0 != read_binary_architecture_bitstream(openfpga_ctx.mutable_bitstream_manager(),
+                                              find_context_checkpoint_file_path(manifest_fname, bitstream_fname).c_str())) {
+    VTR_LOG_ERROR("Unable to load the bitstream of context checkpoint '%s'!\n",
+                  manifest_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+           "Loaded %lu modules and %lu configuration bits from context checkpoint '%s'\n",
+           openfpga_ctx.module_graph().num_modules(),
+           openfpga_ctx.bitstream_manager().num_bits(),
+           manifest_fname.c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
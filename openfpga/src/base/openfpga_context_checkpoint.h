@@ -0,0 +1,34 @@
+#ifndef OPENFPGA_CONTEXT_CHECKPOINT_H
+#define OPENFPGA_CONTEXT_CHECKPOINT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Constants for the binary file format of context checkpoints
+ *******************************************************************/
+constexpr char CONTEXT_CHECKPOINT_MAGIC[] = "OFPGACTX";
+constexpr uint64_t CONTEXT_CHECKPOINT_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t CONTEXT_CHECKPOINT_VERSION = 1;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int save_context(const OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context); 
+
+int load_context(OpenfpgaContext& openfpga_ctx,
+                 const Command& cmd, const CommandContext& cmd_context); 
+
+} /* end namespace openfpga */
+
+#endif
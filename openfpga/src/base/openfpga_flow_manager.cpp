@@ -14,6 +14,13 @@ namespace openfpga {
 FlowManager::FlowManager() {
   /* Turn off compress_routing as default */
   compress_routing_ = false;
+  /* The full fabric is built as default */
+  partial_fabric_ = false;
+  configuration_layout_ = false;
+  frame_view_ = false;
+  duplicate_grid_pin_ = false;
+  /* Use a single thread as default, so that the runtime profile is the same as before */
+  num_threads_ = 1;
 }
 
 /**************************************************
@@ -23,6 +30,34 @@ bool FlowManager::compress_routing() const {
   return compress_routing_;
 }
 
+bool FlowManager::partial_fabric() const {
+  return partial_fabric_;
+}
+
+bool FlowManager::configuration_layout() const {
+  return configuration_layout_;
+}
+
+bool FlowManager::frame_view() const {
+  return frame_view_;
+}
+
+bool FlowManager::duplicate_grid_pin() const {
+  return duplicate_grid_pin_;
+}
+
+std::string FlowManager::fabric_id() const {
+  return fabric_id_;
+}
+
+std::string FlowManager::device_id() const {
+  return device_id_;
+}
+
+size_t FlowManager::num_threads() const {
+  return num_threads_;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -30,5 +65,33 @@ void FlowManager::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FlowManager::set_partial_fabric(const bool& enabled) {
+  partial_fabric_ = enabled;
+}
+
+void FlowManager::set_configuration_layout(const bool& enabled) {
+  configuration_layout_ = enabled;
+}
+
+void FlowManager::set_frame_view(const bool& enabled) {
+  frame_view_ = enabled;
+}
+
+void FlowManager::set_duplicate_grid_pin(const bool& enabled) {
+  duplicate_grid_pin_ = enabled;
+}
+
+void FlowManager::set_fabric_id(const std::string& fabric_id) {
+  fabric_id_ = fabric_id;
+}
+
+void FlowManager::set_device_id(const std::string& device_id) {
+  device_id_ = device_id;
+}
+
+void FlowManager::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 
 } /* end namespace openfpga */
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <string>
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -19,10 +21,37 @@ class FlowManager {
     FlowManager();
   public: /* Public accessors */
     bool compress_routing() const;
+    /* Only a part of the grid and routing modules are built, without the top-level module */
+    bool partial_fabric() const;
+    /* Only the configuration layout of the fabric is loaded, i.e., the modules without nets */
+    bool configuration_layout() const;
+    /* Options of building the fabric, which are required to rebuild its top-level module */
+    bool frame_view() const;
+    bool duplicate_grid_pin() const;
+    /* Identifier of the inputs from which the fabric is built */
+    std::string fabric_id() const;
+    /* Identifier of the device on which the fabric is built, empty if no fabric is built */
+    std::string device_id() const;
+    /* Number of threads used by the commands by default (0 means all the cores) */
+    size_t num_threads() const;
   public: /* Public mutators */
     void set_compress_routing(const bool& enabled);
+    void set_partial_fabric(const bool& enabled);
+    void set_configuration_layout(const bool& enabled);
+    void set_frame_view(const bool& enabled);
+    void set_duplicate_grid_pin(const bool& enabled);
+    void set_fabric_id(const std::string& fabric_id);
+    void set_device_id(const std::string& device_id);
+    void set_num_threads(const size_t& num_threads);
   private: /* Internal Data */
     bool compress_routing_;
+    bool partial_fabric_;
+    bool configuration_layout_;
+    bool frame_view_;
+    bool duplicate_grid_pin_;
+    std::string fabric_id_;
+    std::string device_id_;
+    size_t num_threads_;
 };
 
 } /* End namespace openfpga*/
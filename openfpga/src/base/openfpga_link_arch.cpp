@@ -21,11 +21,14 @@
 #include "annotate_pb_graph.h"
 #include "annotate_routing.h"
 #include "annotate_rr_graph.h"
+#include "read_xml_device_rr_gsb.h"
 #include "annotate_simulation_setting.h"
 #include "annotate_bitstream_setting.h"
 #include "mux_library_builder.h"
 #include "build_tile_direct.h"
 #include "annotate_placement.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_link_arch.h"
 
 /* Include global variables of VPR */
@@ -71,8 +74,22 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   CommandOptionId opt_activity_file = cmd.option("activity_file");
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
+  CommandOptionId opt_gsb_xml_dir = cmd.option("gsb_xml_dir");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* When linking the architecture again, e.g., for another design on the same fabric,
+   * the annotations of the previous run of VPR refer to pb_types which are no longer used
+   */
+  openfpga_ctx.mutable_vpr_device_annotation() = VprDeviceAnnotation();
+  openfpga_ctx.mutable_vpr_bitstream_annotation() = VprBitstreamAnnotation();
+  openfpga_ctx.mutable_device_rr_gsb().clear();
+
   /* Build fast look-up between physical tile pin index and port information */
   build_physical_tile_pin2port_info(g_vpr_ctx.device(),
                                     openfpga_ctx.mutable_vpr_device_annotation());
@@ -113,6 +130,7 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
 
   annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.routing(), 
                                   openfpga_ctx.mutable_vpr_routing_annotation(),
+                                  num_threads,
                                   cmd_context.option_enable(cmd, opt_verbose));
 
 
@@ -124,19 +142,54 @@ int link_arch(OpenfpgaContext& openfpga_ctx,
     return CMD_EXEC_FATAL_ERROR;
   }
 
-  annotate_device_rr_gsb(g_vpr_ctx.device(),
-                         openfpga_ctx.mutable_device_rr_gsb(),
-                         cmd_context.option_enable(cmd, opt_verbose));
+  /* Restore the GSBs written by a previous run if required,
+   * and build them from the routing resource graph otherwise or if they do not match
+   */
+  bool gsb_restored = false;
+  if (true == cmd_context.option_enable(cmd, opt_gsb_xml_dir)) {
+    /* Note that the GSB array is smaller than the grids by 1 column and 1 row!!! */
+    vtr::Point<size_t> gsb_range(g_vpr_ctx.device().grid.width() - 1, g_vpr_ctx.device().grid.height() - 1);
+    gsb_restored = (0 == read_device_rr_gsb_from_xml(openfpga_ctx.mutable_device_rr_gsb(),
+                                                     cmd_context.option_value(cmd, opt_gsb_xml_dir).c_str(),
+                                                     g_vpr_ctx.device().rr_graph,
+                                                     gsb_range,
+                                                     cmd_context.option_enable(cmd, opt_sort_edge),
+                                                     num_threads,
+                                                     cmd_context.option_enable(cmd, opt_verbose)));
+  }
 
-  if (true == cmd_context.option_enable(cmd, opt_sort_edge)) {
-    sort_device_rr_gsb_chan_node_in_edges(g_vpr_ctx.device().rr_graph,
-                                          openfpga_ctx.mutable_device_rr_gsb(),
-                                          cmd_context.option_enable(cmd, opt_verbose));
-  } 
+  if (false == gsb_restored) {
+    annotate_device_rr_gsb(g_vpr_ctx.device(),
+                           openfpga_ctx.mutable_device_rr_gsb(),
+                           num_threads,
+                           cmd_context.option_enable(cmd, opt_verbose));
+
+    if (true == cmd_context.option_enable(cmd, opt_sort_edge)) {
+      sort_device_rr_gsb_chan_node_in_edges(g_vpr_ctx.device().rr_graph,
+                                            openfpga_ctx.mutable_device_rr_gsb(),
+                                            num_threads,
+                                            cmd_context.option_enable(cmd, opt_verbose));
+    } 
+  }
+
+  /* A fabric which has been built is reused only on the same device,
+   * whose unique GSBs have to be identified again for a compressed fabric
+   */
+  if (false == openfpga_ctx.flow_manager().device_id().empty()) {
+    if (openfpga_ctx.flow_manager().device_id() != find_device_id(openfpga_ctx, g_vpr_ctx.device())) {
+      VTR_LOG_ERROR("The device implemented by VPR is different from the one of the fabric!\nPlease run 'free_fabric' and build the fabric again\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (true == openfpga_ctx.flow_manager().compress_routing()) {
+      compress_routing_hierarchy(openfpga_ctx, num_threads, std::string(),
+                                 cmd_context.option_enable(cmd, opt_verbose));
+    }
+  }
 
   /* Build multiplexer library */
   openfpga_ctx.mutable_mux_lib() = build_device_mux_library(g_vpr_ctx.device(),
-                                                            const_cast<const OpenfpgaContext&>(openfpga_ctx)); 
+                                                            const_cast<const OpenfpgaContext&>(openfpga_ctx),
+                                                            num_threads); 
 
   /* Build tile direct annotation */
   openfpga_ctx.mutable_tile_direct() = build_device_tile_direct(g_vpr_ctx.device(),
@@ -7,6 +7,9 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
@@ -15,6 +18,7 @@
 
 #include "pb_type_utils.h"
 #include "lut_utils.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_lut_truth_table_fixup.h"
 
 /* Include global variables of VPR */
@@ -29,12 +33,14 @@ namespace openfpga {
  *
  * Note: 
  *   - pb must represents a LUT pb in the graph and it should be primitive
+ *   - the adapted truth tables are appended to a list rather than the
+ *     clustering annotation, so that clustered blocks can be fixed up in parallel
  *******************************************************************/
 static 
 void fix_up_lut_atom_block_truth_table(const AtomContext& atom_ctx,
                                        t_pb* pb,
                                        const t_pb_routes& pb_route,
-                                       VprClusteringAnnotation& vpr_clustering_annotation,
+                                       std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapted_tts,
                                        const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
   t_pb_type* pb_type = pb->pb_graph_node->pb_type;
@@ -88,8 +94,8 @@ void fix_up_lut_atom_block_truth_table(const AtomContext& atom_ctx,
      * For used inputs : find the bit in the truth table rows and move it by the given mapping
      */
     const AtomNetlist::TruthTable& orig_tt = atom_ctx.nlist.block_truth_table(atom_blk);
-    const AtomNetlist::TruthTable& adapt_tt = lut_truth_table_adaption(orig_tt, rotated_pin_map); 
-    vpr_clustering_annotation.adapt_truth_table(pb, adapt_tt);
+    adapted_tts.push_back(std::make_pair(pb, lut_truth_table_adaption(orig_tt, rotated_pin_map)));
+    const AtomNetlist::TruthTable& adapt_tt = adapted_tts.back().second;
 
     /* Print info is in the verbose mode */
     VTR_LOGV(verbose, "Original truth table\n");
@@ -135,7 +141,7 @@ static
 void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
                          t_pb* pb,
                          const t_pb_routes& pb_route,
-                         VprClusteringAnnotation& vpr_clustering_annotation,
+                         std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapted_tts,
                          const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node; 
 
@@ -149,7 +155,7 @@ void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
        * mode 1 is the regular mode
        */
       if (1 == pb->mode) {
-        fix_up_lut_atom_block_truth_table(atom_ctx, pb->child_pbs[0], pb_route, vpr_clustering_annotation, verbose);
+        fix_up_lut_atom_block_truth_table(atom_ctx, pb->child_pbs[0], pb_route, adapted_tts, verbose);
       }
     }
     return;
@@ -162,7 +168,7 @@ void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
     for (int jpb = 0; jpb < mapped_mode->pb_type_children[ipb].num_pb; ++jpb) {
       /* See if we still have any pb children to walk through */
       if ((pb->child_pbs[ipb] != nullptr) && (pb->child_pbs[ipb][jpb].name != nullptr)) {
-        rec_adapt_lut_pb_tt(atom_ctx, &(pb->child_pbs[ipb][jpb]), pb_route, vpr_clustering_annotation, verbose);
+        rec_adapt_lut_pb_tt(atom_ctx, &(pb->child_pbs[ipb][jpb]), pb_route, adapted_tts, verbose);
       }
     }
   }
@@ -171,17 +177,31 @@ void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx,
 /********************************************************************
  * Main function to fix up truth table for each LUT used in FPGA
  * This function will walk through each clustered block
+ * Clustered blocks are fixed up with a number of threads,
+ * and their truth tables are added to the clustering annotation
+ * in the order of clustered blocks, as a single-thread run does
  *******************************************************************/
 static 
 void update_lut_tt_with_post_packing_results(const AtomContext& atom_ctx,
                                              const ClusteringContext& clustering_ctx,
                                              VprClusteringAnnotation& vpr_clustering_annotation,
+                                             const size_t& num_threads,
                                              const bool& verbose) {
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
+  std::vector<ClusterBlockId> blocks(clustering_ctx.clb_nlist.blocks().begin(),
+                                     clustering_ctx.clb_nlist.blocks().end());
+  std::vector<std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>> block_adapted_tts(blocks.size());
+
+  parallel_for(blocks.size(), find_num_threads(num_threads), [&](const size_t& iblk) {
     rec_adapt_lut_pb_tt(atom_ctx,
-                        clustering_ctx.clb_nlist.block_pb(blk_id),
-                        clustering_ctx.clb_nlist.block_pb(blk_id)->pb_route,
-                        vpr_clustering_annotation, verbose);
+                        clustering_ctx.clb_nlist.block_pb(blocks[iblk]),
+                        clustering_ctx.clb_nlist.block_pb(blocks[iblk])->pb_route,
+                        block_adapted_tts[iblk], verbose);
+  });
+
+  for (const std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>& adapted_tts : block_adapted_tts) {
+    for (const std::pair<t_pb*, AtomNetlist::TruthTable>& adapted_tt : adapted_tts) {
+      vpr_clustering_annotation.adapt_truth_table(adapted_tt.first, adapted_tt.second);
+    }
   }
 }
 
@@ -203,10 +223,17 @@ int lut_truth_table_fixup(OpenfpgaContext& openfpga_context,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_context.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each packed block */
   update_lut_tt_with_post_packing_results(g_vpr_ctx.atom(), 
                                           g_vpr_ctx.clustering(),
                                           openfpga_context.mutable_vpr_clustering_annotation(),
+                                          num_threads,
                                           cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -0,0 +1,237 @@
+/********************************************************************
+ * This file includes functions to report the memory used by
+ * the data structures of OpenFPGA and VPR, 
+ * and to free the data structures which are no longer needed,
+ * in order to find and reduce the memory footprint of large fabrics
+ *
+ * The memory of a data structure is estimated from the capacity
+ * of its containers (see openfpga_memory_usage.h), so that
+ * it can be smaller than the memory reported by the system,
+ * which includes the overhead of the memory allocator.
+ * The statistics of the allocator are reported as well,
+ * so that allocators can be compared (see VTR_MALLOC in CMake)
+ *******************************************************************/
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_rusage.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
+/* Headers from vpr library */
+#include "globals.h"
+
+#include "openfpga_memory_report.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr float BYTES_PER_MIB = 1024. * 1024.;
+
+/********************************************************************
+ * Estimate the memory of the routing traces of all the nets,
+ * which are linked lists
+ *******************************************************************/
+static
+size_t find_routing_trace_memory_usage(const RoutingContext& routing_ctx) {
+  size_t usage = heap_memory_usage(routing_ctx.trace);
+  for (const t_traceback& traceback : routing_ctx.trace) {
+    for (const t_trace* trace = traceback.head; nullptr != trace; trace = trace->next) {
+      usage += sizeof(t_trace);
+    }
+  }
+  return usage;
+}
+
+/********************************************************************
+ * Estimate the memory of the legacy routing resource nodes of VPR,
+ * where the edges of each node are stored with their sink node and switch
+ *******************************************************************/
+static
+size_t find_rr_nodes_memory_usage(const DeviceContext& device_ctx) {
+  size_t usage = heap_memory_usage(device_ctx.rr_nodes);
+  for (const t_rr_node& rr_node : device_ctx.rr_nodes) {
+    usage += rr_node.num_edges() * (sizeof(int) + sizeof(short));
+  }
+  return usage;
+}
+
+/********************************************************************
+ * Collect the estimated memory of each data structure, by its name
+ *******************************************************************/
+static
+std::vector<std::pair<std::string, size_t>> find_openfpga_memory_usage(const OpenfpgaContext& openfpga_ctx) {
+  std::vector<std::pair<std::string, size_t>> usages;
+  usages.push_back(std::make_pair("module_graph", openfpga_ctx.module_graph().memory_usage()));
+  usages.push_back(std::make_pair("bitstream_manager", openfpga_ctx.bitstream_manager().memory_usage()));
+  usages.push_back(std::make_pair("fabric_bitstream", openfpga_ctx.fabric_bitstream().memory_usage()));
+  usages.push_back(std::make_pair("device_rr_gsb", openfpga_ctx.device_rr_gsb().memory_usage()));
+  usages.push_back(std::make_pair("vpr_routing_annotation", openfpga_ctx.vpr_routing_annotation().memory_usage()));
+  usages.push_back(std::make_pair("io_location_map", openfpga_ctx.io_location_map().memory_usage()));
+  return usages;
+}
+
+static
+std::vector<std::pair<std::string, size_t>> find_vpr_memory_usage() {
+  const DeviceContext& device_ctx = g_vpr_ctx.device();
+  const RoutingContext& routing_ctx = g_vpr_ctx.routing();
+
+  std::vector<std::pair<std::string, size_t>> usages;
+  usages.push_back(std::make_pair("device.rr_graph", device_ctx.rr_graph.memory_usage()));
+  usages.push_back(std::make_pair("device.rr_nodes", find_rr_nodes_memory_usage(device_ctx)));
+  usages.push_back(std::make_pair("device.rr_node_indices", heap_memory_usage(device_ctx.rr_node_indices)));
+  usages.push_back(std::make_pair("device.rr_node_track_ids", heap_memory_usage(device_ctx.rr_node_track_ids)));
+  usages.push_back(std::make_pair("routing.trace", find_routing_trace_memory_usage(routing_ctx)));
+  usages.push_back(std::make_pair("routing.trace_nodes", heap_memory_usage(routing_ctx.trace_nodes)));
+  usages.push_back(std::make_pair("routing.net_rr_terminals", heap_memory_usage(routing_ctx.net_rr_terminals)));
+  usages.push_back(std::make_pair("routing.rr_node_route_inf", heap_memory_usage(routing_ctx.rr_node_route_inf)));
+  return usages;
+}
+
+/********************************************************************
+ * Print the estimated memory of each data structure,
+ * and output them to a JSON file when specified.
+ * The memory of VPR netlists, architectures and libraries
+ * of OpenFPGA are not included, which are usually small
+ *******************************************************************/
+int report_memory_usage(const OpenfpgaContext& openfpga_ctx,
+                        const Command& cmd, const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+
+  std::vector<std::pair<std::string, std::vector<std::pair<std::string, size_t>>>> groups;
+  groups.push_back(std::make_pair("OpenFPGA", find_openfpga_memory_usage(openfpga_ctx)));
+  groups.push_back(std::make_pair("VPR", find_vpr_memory_usage()));
+
+  size_t total_usage = 0;
+  VTR_LOG("Estimated memory usage of data structures:\n");
+  for (const auto& group : groups) {
+    VTR_LOG("\t%s:\n", group.first.c_str());
+    for (const auto& usage : group.second) {
+      VTR_LOG("\t\t%s: %.2f MiB\n", usage.first.c_str(), usage.second / BYTES_PER_MIB);
+      total_usage += usage.second;
+    }
+  }
+  VTR_LOG("\tTotal: %.2f MiB\n", total_usage / BYTES_PER_MIB);
+
+  vtr::t_malloc_stats malloc_stats = vtr::get_malloc_stats();
+  VTR_LOG("Memory allocator: %s\n", malloc_stats.allocator);
+  if (0 < malloc_stats.allocated) {
+    VTR_LOG("\tAllocated: %.2f MiB\n", malloc_stats.allocated / BYTES_PER_MIB);
+  }
+  if (0 < malloc_stats.mapped) {
+    VTR_LOG("\tObtained from the system: %.2f MiB\n", malloc_stats.mapped / BYTES_PER_MIB);
+  }
+  size_t current_rss = vtr::get_current_rss();
+  if (0 < current_rss) {
+    VTR_LOG("Current memory usage of the process: %.2f MiB\n", current_rss / BYTES_PER_MIB);
+  }
+  VTR_LOG("Peak memory usage of the process: %.2f MiB\n", vtr::get_max_rss() / BYTES_PER_MIB);
+
+  if (false == cmd_context.option_enable(cmd, opt_file)) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to create file '%s' to output memory usage!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  fp << "{\n";
+  for (const auto& group : groups) {
+    fp << "  \"" << group.first << "\": {";
+    bool first_entry = true;
+    for (const auto& usage : group.second) {
+      fp << (first_entry ? "\n" : ",\n");
+      first_entry = false;
+      fp << "    \"" << usage.first << "\": " << usage.second;
+    }
+    fp << "\n  },\n";
+  }
+  fp << "  \"total\": " << total_usage << ",\n";
+  fp << "  \"allocator\": {\n";
+  fp << "    \"name\": \"" << malloc_stats.allocator << "\",\n";
+  fp << "    \"allocated\": " << malloc_stats.allocated << ",\n";
+  fp << "    \"mapped\": " << malloc_stats.mapped << "\n";
+  fp << "  },\n";
+  fp << "  \"rss\": " << current_rss << ",\n";
+  fp << "  \"max_rss\": " << vtr::get_max_rss() << "\n";
+  fp << "}\n";
+
+  int status = CMD_EXEC_SUCCESS;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write memory usage to file '%s'!\n",
+                  fname.c_str());
+    status = CMD_EXEC_FATAL_ERROR;
+  }
+  fp.close();
+
+  return status;
+}
+
+/********************************************************************
+ * Free the data structures by replacing them with empty ones,
+ * so that all the memory of their containers is released
+ *******************************************************************/
+int free_fabric_bitstream(OpenfpgaContext& openfpga_ctx) {
+  size_t usage = openfpga_ctx.fabric_bitstream().memory_usage();
+  openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+  VTR_LOG("Freed fabric bitstream (%.2f MiB)\n", usage / BYTES_PER_MIB);
+  return CMD_EXEC_SUCCESS;
+}
+
+int free_arch_bitstream(OpenfpgaContext& openfpga_ctx) {
+  size_t usage = openfpga_ctx.bitstream_manager().memory_usage()
+               + openfpga_ctx.fabric_bitstream().memory_usage();
+  /* The fabric bitstream refers to the bits of the architecture bitstream */
+  openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+  openfpga_ctx.mutable_bitstream_manager() = BitstreamManager();
+  VTR_LOG("Freed architecture and fabric bitstreams (%.2f MiB)\n", usage / BYTES_PER_MIB);
+  return CMD_EXEC_SUCCESS;
+}
+
+int free_fabric(OpenfpgaContext& openfpga_ctx) {
+  size_t usage = openfpga_ctx.module_graph().memory_usage()
+               + openfpga_ctx.io_location_map().memory_usage();
+  openfpga_ctx.mutable_module_graph() = ModuleManager();
+  openfpga_ctx.mutable_io_location_map() = IoLocationMap();
+  openfpga_ctx.mutable_fabric_global_port_info() = FabricGlobalPortInfo();
+  /* No fabric can be reused by the next design */
+  openfpga_ctx.mutable_flow_manager().set_device_id(std::string());
+  openfpga_ctx.mutable_flow_manager().set_configuration_layout(false);
+  VTR_LOG("Freed fabric module graph (%.2f MiB)\n", usage / BYTES_PER_MIB);
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Free all the data which depends on the implemented design,
+ * i.e., the annotations of the packing, placement and routing results
+ * and the bitstreams, while the fabric is kept for the next design
+ *******************************************************************/
+int free_design(OpenfpgaContext& openfpga_ctx) {
+  size_t usage = openfpga_ctx.vpr_routing_annotation().memory_usage()
+               + openfpga_ctx.bitstream_manager().memory_usage()
+               + openfpga_ctx.fabric_bitstream().memory_usage();
+  openfpga_ctx.mutable_vpr_netlist_annotation() = VprNetlistAnnotation();
+  openfpga_ctx.mutable_vpr_clustering_annotation() = VprClusteringAnnotation();
+  openfpga_ctx.mutable_vpr_placement_annotation() = VprPlacementAnnotation();
+  openfpga_ctx.mutable_vpr_routing_annotation() = VprRoutingAnnotation();
+  openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+  openfpga_ctx.mutable_bitstream_manager() = BitstreamManager();
+  VTR_LOG("Freed the implementation results and bitstreams of the design (%.2f MiB)\n", usage / BYTES_PER_MIB);
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
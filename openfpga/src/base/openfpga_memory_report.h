@@ -0,0 +1,31 @@
+#ifndef OPENFPGA_MEMORY_REPORT_H
+#define OPENFPGA_MEMORY_REPORT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_memory_usage(const OpenfpgaContext& openfpga_ctx,
+                        const Command& cmd, const CommandContext& cmd_context); 
+
+int free_fabric_bitstream(OpenfpgaContext& openfpga_ctx);
+
+int free_arch_bitstream(OpenfpgaContext& openfpga_ctx);
+
+int free_fabric(OpenfpgaContext& openfpga_ctx);
+
+int free_design(OpenfpgaContext& openfpga_ctx);
+
+} /* end namespace openfpga */
+
+#endif
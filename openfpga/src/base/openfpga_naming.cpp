@@ -17,6 +17,48 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/************************************************
+ * Get the prefix of names for a routing channel,
+ * which is either 'chanx' or 'chany'
+ ***********************************************/
+static 
+const char* generate_routing_channel_prefix(const t_rr_type& chan_type) {
+  /* Channel must be either CHANX or CHANY */
+  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
+  return (CHANX == chan_type) ? "chanx" : "chany";
+}
+
+/************************************************
+ * Append a coordinate to a name in the format of
+ * <x>__<y>_
+ * Names are built in place to avoid temporary strings,
+ * as they are generated for each block of a fabric
+ ***********************************************/
+static 
+void append_coordinate_to_name(std::string& name,
+                               const vtr::Point<size_t>& coordinate) {
+  name += std::to_string(coordinate.x());
+  name += "__";
+  name += std::to_string(coordinate.y());
+  name += '_';
+}
+
+/************************************************
+ * Append the instance name in the following format
+ * to a buffer:
+ * <instance_name>_<id>_
+ * This allows writers to reuse a buffer when naming 
+ * all the child instances of a module
+ ***********************************************/
+void append_instance_name(std::string& buffer,
+                          const std::string& instance_name,
+                          const size_t& instance_id) {
+  buffer += instance_name;
+  buffer += '_';
+  buffer += std::to_string(instance_id);
+  buffer += '_';
+}
+
 /************************************************
  * A generic function to generate the instance name
  * in the following format:
@@ -27,7 +69,9 @@ namespace openfpga {
  ***********************************************/
 std::string generate_instance_name(const std::string& instance_name,
                                    const size_t& instance_id) {
-  return instance_name + std::string("_") + std::to_string(instance_id) + std::string("_");
+  std::string name;
+  append_instance_name(name, instance_name, instance_id);
+  return name;
 }
 
 /************************************************
@@ -225,7 +269,11 @@ std::string generate_memory_module_name(const CircuitLibrary& circuit_lib,
                                         const CircuitModelId& circuit_model, 
                                         const CircuitModelId& sram_model, 
                                         const std::string& postfix) {
-  return std::string( circuit_lib.model_name(circuit_model) + "_" + circuit_lib.model_name(sram_model) + postfix );
+  std::string module_name(circuit_lib.model_name(circuit_model));
+  module_name += '_';
+  module_name += circuit_lib.model_name(sram_model);
+  module_name += postfix;
+  return module_name;
 }
 
 /*********************************************************************
@@ -252,7 +300,10 @@ std::string generate_routing_block_netlist_name(const std::string& prefix,
 std::string generate_routing_block_netlist_name(const std::string& prefix, 
                                                 const vtr::Point<size_t>& coordinate,
                                                 const std::string& postfix) {
-  return std::string( prefix + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") + postfix );
+  std::string netlist_name(prefix);
+  append_coordinate_to_name(netlist_name, coordinate);
+  netlist_name += postfix;
+  return netlist_name;
 }
 
 /*********************************************************************
@@ -282,16 +333,11 @@ std::string generate_connection_block_netlist_name(const t_rr_type& cb_type,
  *********************************************************************/
 std::string generate_routing_channel_module_name(const t_rr_type& chan_type, 
                                                  const size_t& block_id) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  return std::string( module_prefix_map[chan_type] + std::string("_") + std::to_string(block_id) + std::string("_") );
+  std::string module_name(generate_routing_channel_prefix(chan_type));
+  module_name += '_';
+  module_name += std::to_string(block_id);
+  module_name += '_';
+  return module_name;
 }
 
 /*********************************************************************
@@ -299,16 +345,13 @@ std::string generate_routing_channel_module_name(const t_rr_type& chan_type,
  *********************************************************************/
 std::string generate_routing_channel_module_name(const t_rr_type& chan_type, 
                                                  const vtr::Point<size_t>& coordinate) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  return std::string( module_prefix_map[chan_type] + std::to_string(coordinate.x()) + std::string("_") + std::to_string(coordinate.y()) + std::string("_") );
+  /* Note that the coordinate is separated by a single underscore here */
+  std::string module_name(generate_routing_channel_prefix(chan_type));
+  module_name += std::to_string(coordinate.x());
+  module_name += '_';
+  module_name += std::to_string(coordinate.y());
+  module_name += '_';
+  return module_name;
 }
 
 /*********************************************************************
@@ -321,17 +364,10 @@ std::string generate_routing_track_port_name(const t_rr_type& chan_type,
                                              const vtr::Point<size_t>& coordinate,
                                              const size_t& track_id,
                                              const PORTS& port_direction) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type]; 
-  port_name += std::string("_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("__"));
+  std::string port_name(generate_routing_channel_prefix(chan_type)); 
+  port_name += '_';
+  append_coordinate_to_name(port_name, coordinate);
+  port_name += '_';
 
   switch (port_direction) {
   case OUT_PORT:
@@ -346,7 +382,8 @@ std::string generate_routing_track_port_name(const t_rr_type& chan_type,
   }
 
   /* Add the track id to the port name */
-  port_name += std::to_string(track_id) + std::string("_");
+  port_name += std::to_string(track_id);
+  port_name += '_';
 
   return port_name;
 }
@@ -363,21 +400,12 @@ std::string generate_routing_track_port_name(const t_rr_type& chan_type,
 std::string generate_sb_module_track_port_name(const t_rr_type& chan_type, 
                                                const e_side& module_side,
                                                const PORTS& port_direction) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
-
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type]; 
-  port_name += std::string("_");
+  std::string port_name(generate_routing_channel_prefix(chan_type)); 
+  port_name += '_';
 
   SideManager side_manager(module_side);
-  port_name += std::string(side_manager.to_string());
-  port_name += std::string("_");
+  port_name += side_manager.to_string();
+  port_name += '_';
 
   switch (port_direction) {
   case OUT_PORT:
@@ -419,16 +447,13 @@ std::string generate_cb_module_track_port_name(const t_rr_type& chan_type,
   /* Channel must be either CHANX or CHANY */
   VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::map<bool, std::string>> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX][true] = std::string("chanx_left");
-  module_prefix_map[CHANX][false] = std::string("chanx_right");
-  module_prefix_map[CHANY][true] = std::string("chany_bottom");
-  module_prefix_map[CHANY][false] = std::string("chany_top");
-
-  std::string port_name = module_prefix_map[chan_type][upper_location];
-  port_name += std::string("_");
+  std::string port_name(generate_routing_channel_prefix(chan_type));
+  if (CHANX == chan_type) {
+    port_name += upper_location ? "_left" : "_right";
+  } else {
+    port_name += upper_location ? "_bottom" : "_top";
+  }
+  port_name += '_';
 
   switch (port_direction) {
   case OUT_PORT:
@@ -452,52 +477,68 @@ std::string generate_cb_module_track_port_name(const t_rr_type& chan_type,
 std::string generate_routing_track_middle_output_port_name(const t_rr_type& chan_type, 
                                                            const vtr::Point<size_t>& coordinate,
                                                            const size_t& track_id) {
-  /* Channel must be either CHANX or CHANY */
-  VTR_ASSERT( (CHANX == chan_type) || (CHANY == chan_type) );
+  std::string port_name(generate_routing_channel_prefix(chan_type)); 
+  port_name += '_';
+  append_coordinate_to_name(port_name, coordinate);
+  port_name += '_';
 
-  /* Create a map between chan_type and module_prefix */
-  std::map<t_rr_type, std::string> module_prefix_map;
-  /* TODO: use a constexpr string to replace the fixed name? */
-  module_prefix_map[CHANX] = std::string("chanx");
-  module_prefix_map[CHANY] = std::string("chany");
-
-  std::string port_name = module_prefix_map[chan_type]; 
-  port_name += std::string("_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("__"));
-
-  port_name += std::string("midout_"); 
+  port_name += "midout_"; 
 
   /* Add the track id to the port name */
-  port_name += std::to_string(track_id) + std::string("_");
+  port_name += std::to_string(track_id);
+  port_name += '_';
 
   return port_name;
 }
 
+/*********************************************************************
+ * Generate the prefix of module names for switch blocks,
+ * which is followed by the coordinate: <prefix>_<x>__<y>_
+ *********************************************************************/
+std::string generate_switch_block_module_prefix() {
+  return std::string("sb");
+}
+
 /*********************************************************************
  * Generate the module name for a switch block with a given coordinate
  *********************************************************************/
 std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordinate) {
-  return std::string( "sb_" + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  std::string module_name = generate_switch_block_module_prefix();
+  module_name += '_';
+  append_coordinate_to_name(module_name, coordinate);
+  return module_name;
 }
 
 /*********************************************************************
- * Generate the module name for a connection block with a given coordinate
+ * Generate the prefix of module names for connection blocks,
+ * which is followed by the coordinate: <prefix>_<x>__<y>_
  *********************************************************************/
-std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
-                                                  const vtr::Point<size_t>& coordinate) {
+std::string generate_connection_block_module_prefix(const t_rr_type& cb_type) {
   std::string prefix("cb");
   switch (cb_type) {
   case CHANX:
-    prefix += std::string("x_");
+    prefix += std::string("x");
     break;
   case CHANY:
-    prefix += std::string("y_");
+    prefix += std::string("y");
     break;
   default:
     VTR_LOG_ERROR("Invalid type of connection block!\n");
     exit(1);
   }
 
-  return std::string( prefix + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_") );
+  return prefix;
+}
+
+/*********************************************************************
+ * Generate the module name for a connection block with a given coordinate
+ *********************************************************************/
+std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
+                                                  const vtr::Point<size_t>& coordinate) {
+  std::string module_name = generate_connection_block_module_prefix(cb_type);
+  module_name += '_';
+  append_coordinate_to_name(module_name, coordinate);
+  return module_name;
 }
 
 /*********************************************************************
@@ -529,6 +570,28 @@ std::string generate_grid_port_name(const size_t& width,
   return port_name;
 }
 
+/*********************************************************************
+ * Generate the port name of the core module of a grid (see generate_grid_core_module_name()).
+ * The core module has a single port for each pin of the physical tile,
+ * whatever the sides and locations of the pin, so the name does not carry any of them
+ * The format is
+ * subtile_<subtile_index>__pin_<pin_name>_<pin_index>_
+ *********************************************************************/
+std::string generate_grid_core_port_name(const int& subtile_index, 
+                                         const BasicPort& pin_info) {
+  /* Ensure that the pin is 1-bit ONLY !!! */
+  VTR_ASSERT(1 == pin_info.get_width());
+
+  std::string port_name = std::string("subtile_");
+  port_name += std::to_string(subtile_index);
+  port_name += std::string("__pin_");
+  port_name += pin_info.get_name();
+  port_name += std::string("_");
+  port_name += std::to_string(pin_info.get_lsb());
+  port_name += std::string("_");
+  return port_name;
+}
+
 /*********************************************************************
  * Generate the port name for a grid with duplication 
  * This function will generate two types of port names.
@@ -1103,15 +1166,31 @@ std::string generate_grid_block_instance_name(const std::string& prefix,
   std::string module_name(prefix);
 
   module_name += generate_grid_block_netlist_name(block_name, is_block_io, io_side, std::string());
-  module_name += std::string("_");
-  module_name += std::to_string(grid_coord.x());
-  module_name += std::string("__");
-  module_name += std::to_string(grid_coord.y());
-  module_name += std::string("_");
+  module_name += '_';
+  append_coordinate_to_name(module_name, grid_coord);
 
   return module_name;
 }
 
+/*********************************************************************
+ * Generate the module name of the core of a grid block
+ * When the pins of grids are duplicated, the grid modules of a physical tile
+ * (one for each border side of I/O tiles) are wrappers of a common core module,
+ * which includes the physical blocks
+ **********************************************************************/
+std::string generate_grid_core_module_name(const std::string& prefix,
+                                           const std::string& block_name) {
+  return prefix + block_name + std::string(GRID_CORE_MODULE_POSTFIX);
+}
+
+/*********************************************************************
+ * Generate the instance name of the core of a grid block in its wrapper
+ **********************************************************************/
+std::string generate_grid_core_instance_name(const std::string& prefix,
+                                             const std::string& block_name) {
+  return generate_grid_core_module_name(prefix, block_name) + std::string("_0");
+}
+
 /*********************************************************************
  * Generate the module name of a logical block type (pb_type)
  * Since the logical block does not carry any physical attributes,
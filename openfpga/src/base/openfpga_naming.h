@@ -24,6 +24,10 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void append_instance_name(std::string& buffer,
+                          const std::string& instance_name,
+                          const size_t& instance_id);
+
 std::string generate_instance_name(const std::string& instance_name,
                                    const size_t& instance_id);
 
@@ -102,8 +106,12 @@ std::string generate_routing_track_middle_output_port_name(const t_rr_type& chan
                                                            const vtr::Point<size_t>& coordinate,
                                                            const size_t& track_id);
 
+std::string generate_switch_block_module_prefix();
+
 std::string generate_switch_block_module_name(const vtr::Point<size_t>& coordinate);
 
+std::string generate_connection_block_module_prefix(const t_rr_type& cb_type);
+
 std::string generate_connection_block_module_name(const t_rr_type& cb_type, 
                                                   const vtr::Point<size_t>& coordinate);
 
@@ -141,6 +149,9 @@ std::string generate_grid_port_name(const size_t& width,
                                     const e_side& side, 
                                     const BasicPort& pin_info);
 
+std::string generate_grid_core_port_name(const int& subtile_index, 
+                                         const BasicPort& pin_info);
+
 std::string generate_grid_duplicated_port_name(const size_t& width,
                                                const size_t& height, 
                                                const int& subtile_index, 
@@ -227,6 +238,12 @@ std::string generate_grid_block_instance_name(const std::string& prefix,
                                               const e_side& io_side,
                                               const vtr::Point<size_t>& grid_coord);
 
+std::string generate_grid_core_module_name(const std::string& prefix,
+                                           const std::string& block_name);
+
+std::string generate_grid_core_instance_name(const std::string& prefix,
+                                             const std::string& block_name);
+
 std::string generate_physical_block_module_name(t_pb_type* physical_pb_type);
 
 std::string generate_physical_block_instance_name(t_pb_type* pb_type,
@@ -0,0 +1,158 @@
+/********************************************************************
+ * This file includes functions to report the checksums of the files
+ * generated by OpenFPGA, so that the outputs of two runs, e.g., 
+ * a single-thread run and a multi-thread run, can be compared.
+ *
+ * The checksums are reported in the format of sha256sum, i.e., 
+ * '<digest>  <file path>' on each line, in the order of the file paths
+ *
+ * Note that the time stamps in file headers differ between two runs,
+ * unless OpenFPGA is launched with the option '--deterministic'
+ *******************************************************************/
+#include <dirent.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_digest.h"
+#include "vtr_error.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+
+#include "openfpga_output_checksums.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Prefix of the digests given by vtr::secure_digest_file(), which is not reported */
+constexpr char OUTPUT_CHECKSUM_DIGEST_PREFIX[] = "SHA256:";
+
+/********************************************************************
+ * Collect all the regular files under a directory recursively
+ * Return false if a directory can not be opened
+ *******************************************************************/
+static 
+bool collect_directory_files(const std::string& dir_path,
+                             std::vector<std::string>& fnames) {
+  DIR* dir = opendir(dir_path.c_str());
+  if (nullptr == dir) {
+    VTR_LOG_ERROR("Fail to open directory '%s' to report output checksums!\n",
+                  dir_path.c_str());
+    return false;
+  }
+
+  bool status = true;
+  for (struct dirent* entry = readdir(dir); nullptr != entry; entry = readdir(dir)) {
+    std::string entry_name(entry->d_name);
+    if ((std::string(".") == entry_name) || (std::string("..") == entry_name)) {
+      continue;
+    }
+    std::string entry_path = format_dir_path(dir_path) + entry_name;
+    struct stat entry_stat;
+    if (0 != stat(entry_path.c_str(), &entry_stat)) {
+      continue;
+    }
+    if (S_ISDIR(entry_stat.st_mode)) {
+      status = collect_directory_files(entry_path, fnames) && status;
+    } else if (S_ISREG(entry_stat.st_mode)) {
+      fnames.push_back(entry_path);
+    }
+  }
+  closedir(dir);
+
+  return status;
+}
+
+/********************************************************************
+ * Report the checksums of the netlists written by 'write_fabric_verilog'
+ * and 'write_fabric_spice', or of all the files under a directory when
+ * the option '--directory' is given.
+ *
+ * The files are hashed in parallel, using the number of threads 
+ * given by 'set_num_threads', while the checksums are always reported
+ * in the order of file paths
+ *******************************************************************/
+int report_output_checksums(const OpenfpgaContext& openfpga_ctx,
+                            const Command& cmd, const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_directory = cmd.option("directory");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+
+  std::vector<std::string> output_fnames;
+  if (true == cmd_context.option_enable(cmd, opt_directory)) {
+    if (false == collect_directory_files(cmd_context.option_value(cmd, opt_directory), output_fnames)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  } else {
+    for (const NetlistManager* netlist_manager : {&openfpga_ctx.verilog_netlists(), &openfpga_ctx.spice_netlists()}) {
+      for (const NetlistId& netlist : netlist_manager->netlists()) {
+        output_fnames.push_back(netlist_manager->netlist_name(netlist));
+      }
+    }
+  }
+
+  /* The report itself may be under the directory, which is skipped */
+  output_fnames.erase(std::remove(output_fnames.begin(), output_fnames.end(), fname), output_fnames.end());
+  std::sort(output_fnames.begin(), output_fnames.end());
+  output_fnames.erase(std::unique(output_fnames.begin(), output_fnames.end()), output_fnames.end());
+
+  /* A file which can not be read has an empty digest */
+  std::vector<std::string> digests(output_fnames.size());
+  parallel_for(output_fnames.size(), openfpga_ctx.flow_manager().num_threads(),
+               [&](const size_t& ifile) {
+    try {
+      digests[ifile] = vtr::secure_digest_file(output_fnames[ifile]);
+      digests[ifile].erase(0, std::string(OUTPUT_CHECKSUM_DIGEST_PREFIX).size());
+    } catch (const vtr::VtrError&) {
+      digests[ifile].clear();
+    }
+  });
+
+  std::stringstream report;
+  int status = CMD_EXEC_SUCCESS;
+  for (size_t ifile = 0; ifile < output_fnames.size(); ++ifile) {
+    if (true == digests[ifile].empty()) {
+      VTR_LOG_ERROR("Fail to read file '%s' to report its checksum!\n",
+                    output_fnames[ifile].c_str());
+      status = CMD_EXEC_FATAL_ERROR;
+      continue;
+    }
+    report << digests[ifile] << "  " << output_fnames[ifile] << "\n";
+    VTR_LOGV(cmd_context.option_enable(cmd, opt_verbose),
+             "%s  %s\n",
+             digests[ifile].c_str(), output_fnames[ifile].c_str());
+  }
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to create file '%s' to output checksums!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  fp << report.str();
+  fp.close();
+
+  /* A single checksum of all the files, which changes if any file changes */
+  std::string report_digest = vtr::secure_digest_stream(report);
+  VTR_LOG("Reported the checksums of %lu files to '%s'\n",
+          output_fnames.size(), fname.c_str());
+  VTR_LOG("Checksum of all the files: %s\n",
+          report_digest.substr(std::string(OUTPUT_CHECKSUM_DIGEST_PREFIX).size()).c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,23 @@
+#ifndef OPENFPGA_OUTPUT_CHECKSUMS_H
+#define OPENFPGA_OUTPUT_CHECKSUMS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "command.h"
+#include "command_context.h"
+#include "openfpga_context.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_output_checksums(const OpenfpgaContext& openfpga_ctx,
+                            const Command& cmd, const CommandContext& cmd_context); 
+
+} /* end namespace openfpga */
+
+#endif
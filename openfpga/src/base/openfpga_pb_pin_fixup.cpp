@@ -15,9 +15,11 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 #include "pb_type_utils.h"
 #include "openfpga_physical_tile_utils.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_pb_pin_fixup.h"
 
 /* Include global variables of VPR */
@@ -32,13 +34,14 @@ namespace openfpga {
  *    - find a corresponding node in RRGraph object
  *    - find the net id for the node in routing context
  *    - find the net id for the node in clustering context
- *    - if the net id does not match, we update the clustering context
+ *    - if the net id does not match, we add the pin and the net id
+ *      to the list of nets to rename in the clustering context
  *******************************************************************/
 static 
 void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ctx,
                                                   const ClusteringContext& clustering_ctx,
                                                   const VprRoutingAnnotation& vpr_routing_annotation,
-                                                  VprClusteringAnnotation& vpr_clustering_annotation,
+                                                  std::vector<std::pair<int, ClusterNetId>>& renamed_nets,
                                                   const vtr::Point<size_t>& grid_coord,
                                                   const ClusterBlockId& blk_id,
                                                   const e_side& border_side,
@@ -143,7 +146,7 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
     }
 
     /* Add to net modification */
-    vpr_clustering_annotation.rename_net(blk_id, j, routing_net_id);
+    renamed_nets.push_back(std::make_pair(j, routing_net_id));
  
     std::string routing_net_name("unmapped");
     if (ClusterNetId::INVALID() != routing_net_id) {
@@ -168,9 +171,19 @@ void update_cluster_pin_with_post_routing_results(const DeviceContext& device_ct
   }
 }
 
+/* A clustered block to fix up, at one of the grids it is mapped to */
+struct t_pb_pin_fixup_block {
+  vtr::Point<size_t> grid_coord;
+  ClusterBlockId blk_id;
+  e_side border_side;
+};
+
 /********************************************************************
  * Main function to fix up the pb pin mapping results 
  * This function will walk through each grid
+ * Clustered blocks are fixed up with a number of threads,
+ * and their nets are renamed in the clustering annotation
+ * in the order of the grids, as a single-thread run does
  *******************************************************************/
 static 
 void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
@@ -178,7 +191,10 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
                                              const PlacementContext& placement_ctx,
                                              const VprRoutingAnnotation& vpr_routing_annotation,
                                              VprClusteringAnnotation& vpr_clustering_annotation,
+                                             const size_t& num_threads,
                                              const bool& verbose) {
+  std::vector<t_pb_pin_fixup_block> fixup_blocks;
+
   /* Update the core logic (center blocks of the FPGA) */
   for (size_t x = 1; x < device_ctx.grid.width() - 1; ++x) {
     for (size_t y = 1; y < device_ctx.grid.height() - 1; ++y) {
@@ -193,13 +209,7 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
           continue;
         }
         /* We know the entrance to grid info and mapping results, do the fix-up for this block */
-        vtr::Point<size_t> grid_coord(x, y);
-        update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
-                                                     vpr_routing_annotation,
-                                                     vpr_clustering_annotation,
-                                                     grid_coord, cluster_blk_id, NUM_SIDES,
-                                                     placement_ctx.block_locs[cluster_blk_id].loc.z,
-                                                     verbose);
+        fixup_blocks.push_back(t_pb_pin_fixup_block{vtr::Point<size_t>(x, y), cluster_blk_id, NUM_SIDES});
       } 
     }
   }
@@ -242,15 +252,38 @@ void update_pb_pin_with_post_routing_results(const DeviceContext& device_ctx,
           continue;
         }
         /* Update on I/O grid */
-        update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
-                                                     vpr_routing_annotation,
-                                                     vpr_clustering_annotation,
-                                                     io_coord, cluster_blk_id, io_side,
-                                                     placement_ctx.block_locs[cluster_blk_id].loc.z,
-                                                     verbose);
+        fixup_blocks.push_back(t_pb_pin_fixup_block{io_coord, cluster_blk_id, io_side});
       }
     }
   }
+
+  /* The fix-up of a block only reads the routing results.
+   * The first block is fixed up alone, as it also builds the fast look-up
+   * of the routing resource graph (when the graph is not frozen),
+   * which is then read by all the threads
+   */
+  std::vector<std::vector<std::pair<int, ClusterNetId>>> block_renamed_nets(fixup_blocks.size());
+  auto fixup_one_block = [&](const size_t& iblk) {
+    const t_pb_pin_fixup_block& fixup_block = fixup_blocks[iblk];
+    update_cluster_pin_with_post_routing_results(device_ctx, clustering_ctx, 
+                                                 vpr_routing_annotation,
+                                                 block_renamed_nets[iblk],
+                                                 fixup_block.grid_coord, fixup_block.blk_id, fixup_block.border_side,
+                                                 placement_ctx.block_locs[fixup_block.blk_id].loc.z,
+                                                 verbose);
+  };
+  if (!fixup_blocks.empty()) {
+    fixup_one_block(0);
+    parallel_for(fixup_blocks.size() - 1, find_num_threads(num_threads), [&](const size_t& iblk) {
+      fixup_one_block(iblk + 1);
+    });
+  }
+
+  for (size_t iblk = 0; iblk < fixup_blocks.size(); ++iblk) {
+    for (const std::pair<int, ClusterNetId>& renamed_net : block_renamed_nets[iblk]) {
+      vpr_clustering_annotation.rename_net(fixup_blocks[iblk].blk_id, renamed_net.first, renamed_net.second);
+    }
+  }
 }
 
 /********************************************************************
@@ -271,12 +304,19 @@ int pb_pin_fixup(OpenfpgaContext& openfpga_context,
 
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_context.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each grid */
   update_pb_pin_with_post_routing_results(g_vpr_ctx.device(),
                                           g_vpr_ctx.clustering(),
                                           g_vpr_ctx.placement(), 
                                           openfpga_context.vpr_routing_annotation(),
                                           openfpga_context.mutable_vpr_clustering_annotation(),
+                                          num_threads,
                                           cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
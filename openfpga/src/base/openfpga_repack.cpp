@@ -1,9 +1,12 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <sstream>
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_digest.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -14,6 +17,7 @@
 
 #include "build_physical_truth_table.h"
 #include "repack.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_repack.h"
 
 
@@ -30,8 +34,16 @@ int repack(OpenfpgaContext& openfpga_ctx,
            const Command& cmd, const CommandContext& cmd_context) {
 
   CommandOptionId opt_design_constraints = cmd.option("design_constraints");
+  CommandOptionId opt_lb_rr_graph_cache = cmd.option("lb_rr_graph_cache");
+  CommandOptionId opt_report_stats = cmd.option("report_stats");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Load design constraints from file */
   RepackDesignConstraints repack_design_constraints;
   if (true == cmd_context.option_enable(cmd, opt_design_constraints)) {
@@ -40,6 +52,22 @@ int repack(OpenfpgaContext& openfpga_ctx,
     repack_design_constraints = read_xml_repack_design_constraints(dc_fname.c_str());
   }
 
+  /* The physical lb_rr_graphs only depend on the architectures */
+  std::string lb_rr_graph_cache_fname;
+  std::string arch_id;
+  if (true == cmd_context.option_enable(cmd, opt_lb_rr_graph_cache)) {
+    lb_rr_graph_cache_fname = cmd_context.option_value(cmd, opt_lb_rr_graph_cache);
+    std::stringstream arch_inputs;
+    arch_inputs << "vpr_arch=" << g_vpr_ctx.device().arch->architecture_id << "\n";
+    arch_inputs << "openfpga_arch=" << openfpga_ctx.arch().architecture_id << "\n";
+    arch_id = vtr::secure_digest_stream(arch_inputs);
+  }
+
+  std::string report_stats_fname;
+  if (true == cmd_context.option_enable(cmd, opt_report_stats)) {
+    report_stats_fname = cmd_context.option_value(cmd, opt_report_stats);
+  }
+
   pack_physical_pbs(g_vpr_ctx.device(),
                     g_vpr_ctx.atom(),
                     g_vpr_ctx.clustering(),
@@ -48,6 +76,10 @@ int repack(OpenfpgaContext& openfpga_ctx,
                     openfpga_ctx.vpr_bitstream_annotation(),
                     repack_design_constraints,
                     openfpga_ctx.arch().circuit_lib,
+                    arch_id,
+                    lb_rr_graph_cache_fname,
+                    report_stats_fname,
+                    num_threads,
                     cmd_context.option_enable(cmd, opt_verbose));
 
   build_physical_lut_truth_tables(openfpga_ctx.mutable_vpr_clustering_annotation(),
@@ -55,6 +87,7 @@ int repack(OpenfpgaContext& openfpga_ctx,
                                   g_vpr_ctx.clustering(),
                                   openfpga_ctx.vpr_device_annotation(),
                                   openfpga_ctx.arch().circuit_lib,
+                                  num_threads,
                                   cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -17,6 +17,8 @@
 #include "analysis_sdc_writer.h"
 #include "configuration_chain_sdc_writer.h"
 #include "configure_port_sdc_writer.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_sdc.h"
 
 /* Include global variables of VPR */
@@ -31,6 +33,10 @@ namespace openfpga {
 int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
                   const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_hierarchical = cmd.option("hierarchical");
@@ -46,6 +52,12 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_constrain_switch_block_outputs = cmd.option("constrain_switch_block_outputs");
   CommandOptionId opt_constrain_zero_delay_paths = cmd.option("constrain_zero_delay_paths");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
    */
@@ -74,6 +86,7 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
   options.set_constrain_routing_multiplexer_outputs(cmd_context.option_enable(cmd, opt_constrain_routing_multiplexer_outputs));
   options.set_constrain_switch_block_outputs(cmd_context.option_enable(cmd, opt_constrain_switch_block_outputs));
   options.set_constrain_zero_delay_paths(cmd_context.option_enable(cmd, opt_constrain_zero_delay_paths));
+  options.set_num_threads(num_threads);
 
   /* We first turn on default sdc option and then disable part of them by following users' options */
   if (false == options.generate_sdc_pnr()) {
@@ -104,6 +117,10 @@ int write_pnr_sdc(const OpenfpgaContext& openfpga_ctx,
  *******************************************************************/
 int write_configuration_chain_sdc(const OpenfpgaContext& openfpga_ctx,
                                   const Command& cmd, const CommandContext& cmd_context) {
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* If the configuration protocol is not a configuration chain, we will not write anything */
   if (CONFIG_MEM_SCAN_CHAIN != openfpga_ctx.arch().config_protocol.type()) {
     VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -118,6 +135,7 @@ int write_configuration_chain_sdc(const OpenfpgaContext& openfpga_ctx,
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_min_delay = cmd.option("min_delay");
   CommandOptionId opt_max_delay = cmd.option("max_delay");
+  CommandOptionId opt_flatten = cmd.option("flatten");
 
   std::string sdc_dir_path = format_dir_path(cmd_context.option_value(cmd, opt_output_dir));
 
@@ -128,6 +146,7 @@ int write_configuration_chain_sdc(const OpenfpgaContext& openfpga_ctx,
                                              time_unit,
                                              std::stof(cmd_context.option_value(cmd, opt_max_delay)),
                                              std::stof(cmd_context.option_value(cmd, opt_min_delay)),
+                                             cmd_context.option_enable(cmd, opt_flatten),
                                              openfpga_ctx.module_graph());
 
   return CMD_EXEC_SUCCESS;
@@ -140,6 +159,10 @@ int write_configuration_chain_sdc(const OpenfpgaContext& openfpga_ctx,
 int write_sdc_disable_timing_configure_ports(const OpenfpgaContext& openfpga_ctx,
                                              const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Get command options */
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
@@ -167,9 +190,15 @@ int write_sdc_disable_timing_configure_ports(const OpenfpgaContext& openfpga_ctx
 int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
                        const Command& cmd, const CommandContext& cmd_context) {
 
+  if ( (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd))
+    || (CMD_EXEC_SUCCESS != check_fabric_nets(openfpga_ctx, cmd)) ) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
+  CommandOptionId opt_compact_unused_resources = cmd.option("compact_unused_resources");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-SDC
    * Keep it independent from any other outside data structures
@@ -182,6 +211,7 @@ int write_analysis_sdc(const OpenfpgaContext& openfpga_ctx,
   AnalysisSdcOption options(sdc_dir_path);
   options.set_generate_sdc_analysis(true);
   options.set_flatten_names(cmd_context.option_enable(cmd, opt_flatten_names));
+  options.set_compact_unused_resources(cmd_context.option_enable(cmd, opt_compact_unused_resources));
 
   if (true == cmd_context.option_enable(cmd, opt_time_unit)) {
     options.set_time_unit(string_to_time_unit(cmd_context.option_value(cmd, opt_time_unit)));
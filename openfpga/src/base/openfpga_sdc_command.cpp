@@ -66,6 +66,10 @@ ShellCommandId add_openfpga_write_pnr_sdc_command(openfpga::Shell<OpenfpgaContex
   /* Add an option '--constrain_zero_delay_paths' */
   shell_cmd.add_option("constrain_zero_delay_paths", false, "Constrain zero-delay paths in FPGA fabric");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to write the SDC files of routing blocks and grids. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -108,6 +112,9 @@ ShellCommandId add_openfpga_write_configuration_chain_sdc_command(openfpga::Shel
   CommandOptionId max_dly_opt = shell_cmd.add_option("max_delay", false, "Specify the maximum delay to be used.");
   shell_cmd.set_option_require_value(max_dly_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--flatten' */
+  shell_cmd.add_option("flatten", false, "Constrain each link of the configuration chain with full hierarchical paths, instead of once per unique module");
+
   /* Add command 'write_configuration_chain_sdc' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate SDC files to constrain the configuration chain for FPGA fabric");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
@@ -178,6 +185,9 @@ ShellCommandId add_openfpga_write_analysis_sdc_command(openfpga::Shell<OpenfpgaC
   CommandOptionId time_unit_opt = shell_cmd.add_option("time_unit", false, "Specify the time unit in SDC files. Acceptable is [a|f|p|n|u|m|kM]s");
   shell_cmd.set_option_require_value(time_unit_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--compact_unused_resources' */
+  shell_cmd.add_option("compact_unused_resources", false, "Disable unused resources by bus ranges and wildcards rather than pin by pin");
+
   /* Add command 'write_fabric_verilog' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "generate SDC files for timing analysis a PnRed FPGA fabric mapped by a benchmark");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
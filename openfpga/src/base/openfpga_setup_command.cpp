@@ -10,6 +10,7 @@
 #include "check_netlist_naming_conflict.h"
 #include "openfpga_build_fabric.h"
 #include "openfpga_write_gsb.h"
+#include "openfpga_memory_report.h"
 #include "openfpga_setup_command.h"
 
 /* begin namespace openfpga */
@@ -180,6 +181,14 @@ ShellCommandId add_openfpga_link_arch_command(openfpga::Shell<OpenfpgaContext>&
   /* Add an option '--sort_gsb_chan_node_in_edges'*/
   shell_cmd.add_option("sort_gsb_chan_node_in_edges", false, "Sort all the incoming edges for each routing track output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--gsb_xml_dir' */
+  CommandOptionId opt_gsb_xml_dir = shell_cmd.add_option("gsb_xml_dir", false, "restore the General Switch Blocks (GSBs) from the XML files written by write_gsb_to_xml on the same device, instead of building them from the routing resource graph. The GSBs are built if the files do not match");
+  shell_cmd.set_option_require_value(opt_gsb_xml_dir, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to build the General Switch Blocks (GSBs) and the graphs of unique multiplexers, and to annotate the routing results. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
   
@@ -209,6 +218,13 @@ ShellCommandId add_openfpga_write_gsb_command(openfpga::Shell<OpenfpgaContext>&
   shell_cmd.set_option_short_name(opt_file, "f");
   shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
 
+  /* Add an option '--unique' */
+  shell_cmd.add_option("unique", false, "Only write the unique mirrors of switch blocks, which are identified by build_fabric --compress_routing");
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to write the XML files. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -242,6 +258,10 @@ ShellCommandId add_openfpga_check_netlist_naming_conflict_command(openfpga::Shel
   CommandOptionId opt_rpt = shell_cmd.add_option("report", false, "Output a report file about what any correction applied");
   shell_cmd.set_option_require_value(opt_rpt, openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to check the names of netlist blocks and nets. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add command 'check_netlist_naming_conflict' to the Shell */
   ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Check any block/net naming in users' BLIF netlist violates the syntax of fabric generator");
   shell.set_command_class(shell_cmd_id, cmd_class_id);
@@ -265,6 +285,9 @@ ShellCommandId add_openfpga_pb_pin_fixup_command(openfpga::Shell<OpenfpgaContext
 
   Command shell_cmd("pb_pin_fixup");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to fix up the pins of clustered blocks. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -290,6 +313,9 @@ ShellCommandId add_openfpga_lut_truth_table_fixup_command(openfpga::Shell<Openfp
                                                           const std::vector<ShellCommandId>& dependent_cmds) {
 
   Command shell_cmd("lut_truth_table_fixup");
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to fix up the truth tables of clustered blocks. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -322,9 +348,16 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   /* Add an option '--compress_routing' */
   shell_cmd.add_option("compress_routing", false, "Compress the number of unique routing modules by identifying the unique GSBs");
 
+  /* Add an option '--unique_gsb_cache' */
+  CommandOptionId opt_unique_gsb_cache = shell_cmd.add_option("unique_gsb_cache", false, "load the unique GSBs from a cache file if it is built from the same GSBs, otherwise write the unique GSBs to the file. Only applicable with --compress_routing");
+  shell_cmd.set_option_require_value(opt_unique_gsb_cache, openfpga::OPT_STRING);
+
   /* Add an option '--duplicate_grid_pin' */
   shell_cmd.add_option("duplicate_grid_pin", false, "Duplicate the pins on the same side of a grid");
 
+  /* Add an option '--merge_identical_grid_modules' */
+  shell_cmd.add_option("merge_identical_grid_modules", false, "Build a single module for the grids (physical tiles and pb_types) which are structurally identical");
+
   /* Add an option '--load_fabric_key' */
   CommandOptionId opt_load_fkey = shell_cmd.add_option("load_fabric_key", false, "load the fabric key from the given file");
   shell_cmd.set_option_require_value(opt_load_fkey, openfpga::OPT_STRING);
@@ -333,9 +366,24 @@ ShellCommandId add_openfpga_build_fabric_command(openfpga::Shell<OpenfpgaContext
   CommandOptionId opt_write_fkey = shell_cmd.add_option("write_fabric_key", false, "output current fabric key to a file");
   shell_cmd.set_option_require_value(opt_write_fkey, openfpga::OPT_STRING);
 
+  /* Add an option '--read_snapshot' */
+  CommandOptionId opt_read_snapshot = shell_cmd.add_option("read_snapshot", false, "load the fabric from a snapshot file if it is built from the same inputs");
+  shell_cmd.set_option_require_value(opt_read_snapshot, openfpga::OPT_STRING);
+
   /* Add an option '--generate_random_fabric_key' */
   shell_cmd.add_option("generate_random_fabric_key", false, "Create a random fabric key which will shuffle the memory address for encryption purpose");
 
+  /* Add an option '--balance_config_regions' */
+  shell_cmd.add_option("balance_config_regions", false, "Split the configurable children of the top-level module among the configurable regions so that the regions have close numbers of configuration bits, instead of the same number of children. Ignored when a fabric key is loaded");
+
+  /* Add an option '--modules' */
+  CommandOptionId opt_modules = shell_cmd.add_option("modules", false, "Build only the physical tiles and routing modules in the comma-separated list, e.g., clb,sb_1__1_, without the top-level module");
+  shell_cmd.set_option_require_value(opt_modules, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to identify and build the unique routing modules. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -385,6 +433,229 @@ ShellCommandId add_openfpga_write_fabric_hierarchy_command(openfpga::Shell<Openf
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: update_fabric_key
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_update_fabric_key_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                      const ShellCommandClassId& cmd_class_id,
+                                                      const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("update_fabric_key");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the file path of the fabric key to load");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--write_fabric_key' */
+  CommandOptionId opt_write_fkey = shell_cmd.add_option("write_fabric_key", false, "output the updated fabric key to a file");
+  shell_cmd.set_option_require_value(opt_write_fkey, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to rebuild the top-level module. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'update_fabric_key' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Load another fabric key by rebuilding only the top-level module of the FPGA fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, update_fabric_key);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: write_fabric_snapshot
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_fabric_snapshot_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                          const ShellCommandClassId& cmd_class_id,
+                                                          const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("write_fabric_snapshot");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the file name to write the fabric snapshot to");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'write_fabric_snapshot' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the FPGA fabric graph to a binary snapshot file, which can be loaded by build_fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, write_fabric_snapshot);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: write_configuration_layout
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_write_configuration_layout_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                               const ShellCommandClassId& cmd_class_id,
+                                                               const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("write_configuration_layout");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the file name to write the configuration layout to");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'write_configuration_layout' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Write the configurable modules of the FPGA fabric without nets to a binary file, which can be loaded by read_configuration_layout to generate bitstreams");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, write_configuration_layout);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: read_configuration_layout
+ * - Add associated options 
+ * - Add command dependency
+ * - Add the commands whose results are restored
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_read_configuration_layout_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                              const ShellCommandClassId& cmd_class_id,
+                                                              const std::vector<ShellCommandId>& dependent_cmds,
+                                                              const std::vector<ShellCommandId>& provided_cmds) {
+
+  Command shell_cmd("read_configuration_layout");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", true, "Specify the file name of the configuration layout");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'read_configuration_layout' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Load the configuration layout of an FPGA fabric in place of build_fabric, which is enough to generate bitstreams");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, read_configuration_layout);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  /* The fabric is considered as built once the layout is loaded */
+  shell.set_command_provision(shell_cmd_id, provided_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_fabric_tile_clusters
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_fabric_tile_clusters_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                                const ShellCommandClassId& cmd_class_id,
+                                                                const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("report_fabric_tile_clusters");
+
+  /* Add an option '--max_size' */
+  CommandOptionId opt_max_size = shell_cmd.add_option("max_size", false, "Specify the maximum width and height of tile clusters to be considered");
+  shell_cmd.set_option_require_value(opt_max_size, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command 'report_fabric_tile_clusters' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Report the repeating clusters of tiles in the FPGA fabric, without changing the fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, report_fabric_tile_clusters);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_routing_compression
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_routing_compression_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                               const ShellCommandClassId& cmd_class_id,
+                                                               const std::vector<ShellCommandId>& dependent_cmds) {
+
+  Command shell_cmd("report_routing_compression");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option("file", false, "Specify the name of a JSON file to write the statistics of each unique routing module");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to estimate the size of routing blocks. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Show the heatmaps of non-mirrored routing blocks");
+
+  /* Add command 'report_routing_compression' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Report the compression of routing blocks into unique modules");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id, report_routing_compression);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_fabric
+ * - Add the commands whose results are dropped
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_free_fabric_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                const ShellCommandClassId& cmd_class_id,
+                                                const std::vector<ShellCommandId>& invalidated_cmds) {
+  Command shell_cmd("free_fabric");
+
+  /* Add command 'free_fabric' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "Free the module graph of the FPGA fabric which is no longer needed");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, free_fabric);
+
+  /* The fabric has to be built again before being used */
+  shell.set_command_invalidation(shell_cmd_id, invalidated_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'vpr' command which is to be used in creating the dependency graph */
   const ShellCommandId& vpr_cmd_id = shell.command(std::string("vpr"));
@@ -503,6 +774,16 @@ void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
                                                                          openfpga_setup_cmd_class,
                                                                          build_fabric_dependent_cmds);
 
+  /******************************** 
+   * Command 'update_fabric_key' 
+   */
+  /* The 'update_fabric_key' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> update_fabric_key_dependent_cmds;
+  update_fabric_key_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_update_fabric_key_command(shell,
+                                         openfpga_setup_cmd_class,
+                                         update_fabric_key_dependent_cmds);
+
   /******************************** 
    * Command 'write_fabric_hierarchy' 
    */
@@ -512,6 +793,71 @@ void add_openfpga_setup_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_write_fabric_hierarchy_command(shell,
                                               openfpga_setup_cmd_class,
                                               write_fabric_hie_dependent_cmds);
+
+  /******************************** 
+   * Command 'write_fabric_snapshot' 
+   */
+  /* The 'write_fabric_snapshot' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> write_fabric_snapshot_dependent_cmds;
+  write_fabric_snapshot_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_write_fabric_snapshot_command(shell,
+                                             openfpga_setup_cmd_class,
+                                             write_fabric_snapshot_dependent_cmds);
+
+  /******************************** 
+   * Command 'write_configuration_layout' 
+   */
+  /* The 'write_configuration_layout' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> write_config_layout_dependent_cmds;
+  write_config_layout_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_write_configuration_layout_command(shell,
+                                                  openfpga_setup_cmd_class,
+                                                  write_config_layout_dependent_cmds);
+
+  /******************************** 
+   * Command 'read_configuration_layout' 
+   */
+  /* The 'read_configuration_layout' command should NOT be executed before 'link_openfpga_arch'
+   * It restores the results of 'build_fabric' which are required by bitstream generation
+   */
+  std::vector<ShellCommandId> read_config_layout_dependent_cmds;
+  read_config_layout_dependent_cmds.push_back(link_arch_cmd_id);
+  std::vector<ShellCommandId> read_config_layout_provided_cmds;
+  read_config_layout_provided_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_read_configuration_layout_command(shell,
+                                                 openfpga_setup_cmd_class,
+                                                 read_config_layout_dependent_cmds,
+                                                 read_config_layout_provided_cmds);
+
+  /******************************** 
+   * Command 'report_fabric_tile_clusters' 
+   */
+  /* The 'report_fabric_tile_clusters' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> report_fabric_tile_clusters_dependent_cmds;
+  report_fabric_tile_clusters_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_report_fabric_tile_clusters_command(shell,
+                                                   openfpga_setup_cmd_class,
+                                                   report_fabric_tile_clusters_dependent_cmds);
+
+  /******************************** 
+   * Command 'report_routing_compression' 
+   */
+  /* The 'report_routing_compression' command should NOT be executed before 'build_fabric' */
+  std::vector<ShellCommandId> report_routing_compression_dependent_cmds;
+  report_routing_compression_dependent_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_report_routing_compression_command(shell,
+                                                  openfpga_setup_cmd_class,
+                                                  report_routing_compression_dependent_cmds);
+
+  /******************************** 
+   * Command 'free_fabric' 
+   */
+  /* The 'free_fabric' command drops the results of 'build_fabric' and all the commands depending on it */
+  std::vector<ShellCommandId> free_fabric_invalidated_cmds;
+  free_fabric_invalidated_cmds.push_back(build_fabric_cmd_id);
+  add_openfpga_free_fabric_command(shell,
+                                   openfpga_setup_cmd_class,
+                                   free_fabric_invalidated_cmds);
 } 
 
 } /* end namespace openfpga */
@@ -9,6 +9,8 @@
 #include "command_exit_codes.h"
 
 #include "spice_api.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_spice.h"
 
 /* Include global variables of VPR */
@@ -23,16 +25,28 @@ namespace openfpga {
 int write_fabric_spice(OpenfpgaContext& openfpga_ctx,
                          const Command& cmd, const CommandContext& cmd_context) {
 
+  if ( (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd))
+    || (CMD_EXEC_SUCCESS != check_fabric_nets(openfpga_ctx, cmd)) ) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-SPICE
    * Keep it independent from any other outside data structures
    */
   FabricSpiceOption options;
   options.set_output_directory(cmd_context.option_value(cmd, opt_output_dir));
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
+  options.set_num_threads(size_t(num_threads));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
   
@@ -38,6 +38,10 @@ ShellCommandId add_openfpga_write_fabric_spice_command(openfpga::Shell<OpenfpgaC
   /* Add an option '--explicit_port_mapping' */
   shell_cmd.add_option("explicit_port_mapping", false, "Use explicit port mapping in Verilog netlists");
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to write the netlists of routing blocks and grids. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
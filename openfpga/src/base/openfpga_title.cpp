@@ -4,6 +4,8 @@
  *******************************************************************/
 #include "vtr_log.h"
 
+#include "openfpga_simd_dispatch.h"
+
 #include "openfpga_title.h"
 #include "openfpga_version.h"
 
@@ -66,5 +68,6 @@ void print_openfpga_version_info() {
   VTR_LOG("Compiled: %s\n", openfpga::BUILD_TIMESTAMP);
   VTR_LOG("Compiler: %s\n", openfpga::COMPILER);
   VTR_LOG("Build Info: %s\n", openfpga::BUILD_INFO);
+  VTR_LOG("SIMD: %s\n", openfpga::simd_level_name(openfpga::simd_level()).c_str());
   VTR_LOG("\n");
 }
@@ -8,7 +8,11 @@
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
 
+#include "verilog_constants.h"
 #include "verilog_api.h"
+#include "netlist_write_profiler.h"
+#include "openfpga_build_fabric.h"
+#include "openfpga_command_utils.h"
 #include "openfpga_verilog.h"
 
 /* Headers from pcf library */
@@ -26,13 +30,27 @@ namespace openfpga {
 int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
                          const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_fabric_nets(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_include_timing = cmd.option("include_timing");
   CommandOptionId opt_print_user_defined_template = cmd.option("print_user_defined_template");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_compact_top_module = cmd.option("compact_top_module");
+  CommandOptionId opt_fast_sim_models = cmd.option("fast_sim_models");
+  CommandOptionId opt_verilator_friendly = cmd.option("verilator_friendly");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
    * Keep it independent from any other outside data structures
    */
@@ -44,6 +62,11 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
     options.set_default_net_type(cmd_context.option_value(cmd, opt_default_net_type));
   }
+  options.set_num_threads(size_t(num_threads));
+  options.set_incremental(cmd_context.option_enable(cmd, opt_incremental));
+  options.set_compact_top_module(cmd_context.option_enable(cmd, opt_compact_top_module));
+  options.set_fast_sim_models(cmd_context.option_enable(cmd, opt_fast_sim_models));
+  options.set_verilator_friendly(cmd_context.option_enable(cmd, opt_verilator_friendly));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
   
@@ -67,17 +90,53 @@ int write_fabric_verilog(OpenfpgaContext& openfpga_ctx,
 int write_full_testbench(const OpenfpgaContext& openfpga_ctx,
                          const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_bitstream = cmd.option("bitstream");
   CommandOptionId opt_fabric_netlist = cmd.option("fabric_netlist_file_path");
   CommandOptionId opt_pcf = cmd.option("pin_constraints_file");
   CommandOptionId opt_reference_benchmark = cmd.option("reference_benchmark_file_path");
   CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_config_backdoor = cmd.option("config_backdoor");
+  CommandOptionId opt_config_backdoor_protocol_bits = cmd.option("config_backdoor_protocol_bits");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
+  CommandOptionId opt_verilator_friendly = cmd.option("verilator_friendly");
+  CommandOptionId opt_runtime_bitstream = cmd.option("runtime_bitstream");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* The length of the bitstream is fixed in the testbench, 
+   * which is the same for all the bitstreams of a fabric only when no bits are skipped
+   */
+  if (true == cmd_context.option_enable(cmd, opt_runtime_bitstream)) {
+    if (true == cmd_context.option_enable(cmd, opt_fast_configuration)) {
+      VTR_LOG_ERROR("Option '--fast_configuration' can not be used with '--runtime_bitstream'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (true == cmd_context.option_enable(cmd, opt_config_backdoor)) {
+      VTR_LOG_ERROR("Option '--config_backdoor' can not be used with '--runtime_bitstream'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Verilator supports neither '$deposit' nor the 'force' statements on hierarchical paths,
+   * which are used by signal initialization and configuration backdoor 
+   */
+  if (true == cmd_context.option_enable(cmd, opt_verilator_friendly)) {
+    if (true == cmd_context.option_enable(cmd, opt_include_signal_init)) {
+      VTR_LOG_ERROR("Option '--include_signal_init' can not be used with '--verilator_friendly'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (true == cmd_context.option_enable(cmd, opt_config_backdoor)) {
+      VTR_LOG_ERROR("Option '--config_backdoor' can not be used with '--verilator_friendly'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
    * Keep it independent from any other outside data structures
    */
@@ -86,10 +145,23 @@ int write_full_testbench(const OpenfpgaContext& openfpga_ctx,
   options.set_fabric_netlist_file_path(cmd_context.option_value(cmd, opt_fabric_netlist));
   options.set_reference_benchmark_file_path(cmd_context.option_value(cmd, opt_reference_benchmark));
   options.set_fast_configuration(cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_config_backdoor(cmd_context.option_enable(cmd, opt_config_backdoor));
+  if (true == cmd_context.option_enable(cmd, opt_config_backdoor_protocol_bits)) {
+    int num_protocol_bits = std::atoi(cmd_context.option_value(cmd, opt_config_backdoor_protocol_bits).c_str());
+    /* Error out if we have negative number of bits */
+    if (0 > num_protocol_bits) {
+      VTR_LOG_ERROR("Invalid number of configuration bits '%d' to load through the protocol, which should be 0 or a positive number!\n",
+                    num_protocol_bits);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    options.set_num_config_backdoor_protocol_bits(size_t(num_protocol_bits));
+  }
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_print_top_testbench(true);
   options.set_include_signal_init(cmd_context.option_enable(cmd, opt_include_signal_init));
+  options.set_verilator_friendly(cmd_context.option_enable(cmd, opt_verilator_friendly));
+  options.set_runtime_bitstream(cmd_context.option_enable(cmd, opt_runtime_bitstream));
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
     options.set_default_net_type(cmd_context.option_value(cmd, opt_default_net_type));
   }
@@ -122,12 +194,17 @@ int write_full_testbench(const OpenfpgaContext& openfpga_ctx,
 int write_preconfigured_fabric_wrapper(const OpenfpgaContext& openfpga_ctx,
                                        const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_fabric_netlist = cmd.option("fabric_netlist_file_path");
   CommandOptionId opt_pcf = cmd.option("pin_constraints_file");
   CommandOptionId opt_explicit_port_mapping = cmd.option("explicit_port_mapping");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_support_icarus_simulator = cmd.option("support_icarus_simulator");
+  CommandOptionId opt_bitstream_memory_file = cmd.option("bitstream_memory_file");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
@@ -139,6 +216,7 @@ int write_preconfigured_fabric_wrapper(const OpenfpgaContext& openfpga_ctx,
   options.set_explicit_port_mapping(cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_support_icarus_simulator(cmd_context.option_enable(cmd, opt_support_icarus_simulator));
+  options.set_bitstream_memory_file(cmd_context.option_enable(cmd, opt_bitstream_memory_file));
   options.set_print_formal_verification_top_netlist(true);
   if (true == cmd_context.option_enable(cmd, opt_default_net_type)) {
     options.set_default_net_type(cmd_context.option_value(cmd, opt_default_net_type));
@@ -169,6 +247,10 @@ int write_preconfigured_fabric_wrapper(const OpenfpgaContext& openfpga_ctx,
 int write_preconfigured_testbench(const OpenfpgaContext& openfpga_ctx,
                                   const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_pcf = cmd.option("pin_constraints_file");
   CommandOptionId opt_fabric_netlist = cmd.option("fabric_netlist_file_path");
@@ -214,11 +296,44 @@ int write_preconfigured_testbench(const OpenfpgaContext& openfpga_ctx,
 int write_simulation_task_info(const OpenfpgaContext& openfpga_ctx,
                                const Command& cmd, const CommandContext& cmd_context) {
 
+  if (CMD_EXEC_SUCCESS != check_full_fabric(openfpga_ctx, cmd)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_hdl_dir = cmd.option("hdl_dir");
   CommandOptionId opt_reference_benchmark = cmd.option("reference_benchmark_file_path");
+  CommandOptionId opt_random_seed = cmd.option("random_seed");
+  CommandOptionId opt_num_random_partitions = cmd.option("num_random_partitions");
+  CommandOptionId opt_num_simulation_shards = cmd.option("num_simulation_shards");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* By default, a single partition is simulated from the default seed of the testbenches */
+  int random_seed = VERILOG_TESTBENCH_DEFAULT_RANDOM_SEED;
+  if (true == cmd_context.option_enable(cmd, opt_random_seed)) {
+    random_seed = std::atoi(cmd_context.option_value(cmd, opt_random_seed).c_str());
+  }
+  int num_random_partitions = 1;
+  if (true == cmd_context.option_enable(cmd, opt_num_random_partitions)) {
+    num_random_partitions = std::atoi(cmd_context.option_value(cmd, opt_num_random_partitions).c_str());
+    /* Error out if we have no partition */
+    if (0 >= num_random_partitions) {
+      VTR_LOG_ERROR("Invalid number of random partitions '%d' which should be a positive number!\n",
+                    num_random_partitions);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  /* Each shard should simulate at least one partition */
+  int num_simulation_shards = 1;
+  if (true == cmd_context.option_enable(cmd, opt_num_simulation_shards)) {
+    num_simulation_shards = std::atoi(cmd_context.option_value(cmd, opt_num_simulation_shards).c_str());
+    if ((0 >= num_simulation_shards) || (num_random_partitions < num_simulation_shards)) {
+      VTR_LOG_ERROR("Invalid number of simulation shards '%d' which should be a positive number no larger than the number of random partitions '%d'!\n",
+                    num_simulation_shards, num_random_partitions);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   /* This is an intermediate data structure which is designed to modularize the FPGA-Verilog
    * Keep it independent from any other outside data structures
    */
@@ -227,9 +342,13 @@ int write_simulation_task_info(const OpenfpgaContext& openfpga_ctx,
   options.set_reference_benchmark_file_path(cmd_context.option_value(cmd, opt_reference_benchmark));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_print_simulation_ini(cmd_context.option_value(cmd, opt_file));
+  options.set_random_seed(random_seed);
+  options.set_num_random_partitions(size_t(num_random_partitions));
+  options.set_num_simulation_shards(size_t(num_simulation_shards));
 
   return fpga_verilog_simulation_task_info(openfpga_ctx.module_graph(),
                                            openfpga_ctx.bitstream_manager(),
+                                           openfpga_ctx.fabric_bitstream(),
                                            g_vpr_ctx.atom(),
                                            g_vpr_ctx.placement(),
                                            openfpga_ctx.io_location_map(),
@@ -238,4 +357,23 @@ int write_simulation_task_info(const OpenfpgaContext& openfpga_ctx,
                                            options);
 } 
 
+/********************************************************************
+ * A wrapper function to report the profile of writing Verilog and SPICE netlists
+ *******************************************************************/
+int report_netlist_write_profile(const OpenfpgaContext& openfpga_ctx,
+                                 const Command& cmd, const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  int status = write_netlist_write_profile_to_json_file(openfpga_ctx.verilog_netlists(),
+                                                        openfpga_ctx.spice_netlists(),
+                                                        cmd_context.option_value(cmd, opt_file),
+                                                        cmd_context.option_enable(cmd, opt_verbose));
+
+  if (0 != status) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+} 
+
 } /* end namespace openfpga */
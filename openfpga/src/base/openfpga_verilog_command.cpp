@@ -40,6 +40,22 @@ ShellCommandId add_openfpga_write_fabric_verilog_command(openfpga::Shell<Openfpg
   CommandOptionId default_net_type_opt = shell_cmd.add_option("default_net_type", false, "Set the default net type for Verilog netlists. Default value is 'none'");
   shell_cmd.set_option_require_value(default_net_type_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--num_threads' */
+  CommandOptionId opt_num_threads = shell_cmd.add_option("num_threads", false, "Specify the number of threads to write the netlists of routing blocks and grids. Use 0 to run on all the cores. By default, it is the number given by set_num_threads");
+  shell_cmd.set_option_require_value(opt_num_threads, openfpga::OPT_INT);
+
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false, "Only replace the netlists whose contents change, other netlists are not touched. All the netlists are still generated and compared");
+
+  /* Add an option '--compact_top_module' */
+  shell_cmd.add_option("compact_top_module", false, "Write regular instance arrays of the top-level module in generate loops over wire arrays");
+
+  /* Add an option '--fast_sim_models' */
+  shell_cmd.add_option("fast_sim_models", false, "Write behavioral models of routing multiplexers for fast simulation, which are enabled by a preprocessing flag");
+
+  /* Add an option '--verilator_friendly' */
+  shell_cmd.add_option("verilator_friendly", false, "Write netlists for compiled simulation with Verilator: multiplexers use behavioral models without high-impedance states, and a Verilator configuration file is written");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -90,6 +106,13 @@ ShellCommandId add_openfpga_write_full_testbench_command(openfpga::Shell<Openfpg
   /* add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false, "reduce the period of configuration by skip certain data points");
 
+  /* add an option '--config_backdoor' */
+  shell_cmd.add_option("config_backdoor", false, "load configuration chains by hierarchical assignments, except the bits at their heads which are checked through the configuration protocol");
+
+  /* add an option '--config_backdoor_protocol_bits' */
+  CommandOptionId config_backdoor_protocol_bits_opt = shell_cmd.add_option("config_backdoor_protocol_bits", false, "specify the number of bits at the head of each configuration chain to be loaded through the configuration protocol when the backdoor is used. Default value is 64");
+  shell_cmd.set_option_require_value(config_backdoor_protocol_bits_opt, openfpga::OPT_INT);
+
   /* add an option '--explicit_port_mapping' */
   shell_cmd.add_option("explicit_port_mapping", false, "use explicit port mapping in verilog netlists");
 
@@ -100,6 +123,12 @@ ShellCommandId add_openfpga_write_full_testbench_command(openfpga::Shell<Openfpg
   /* add an option '--include_signal_init' */
   shell_cmd.add_option("include_signal_init", false, "initialize all the signals in verilog testbenches");
 
+  /* add an option '--verilator_friendly' */
+  shell_cmd.add_option("verilator_friendly", false, "write a C++ harness to run the testbench compiled by Verilator. Can not be used with '--include_signal_init' and '--config_backdoor'");
+
+  /* add an option '--runtime_bitstream' */
+  shell_cmd.add_option("runtime_bitstream", false, "load the bitstream file given by the plusarg '+bitstream_file=<path>' when the simulation starts, so that a compiled testbench can be reused for all the bitstreams of the fabric. The file given by '--bitstream' is the default. Can not be used with '--fast_configuration' and '--config_backdoor'");
+
   /* add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "enable verbose output");
   
@@ -149,6 +178,9 @@ ShellCommandId add_openfpga_write_preconfigured_fabric_wrapper_command(openfpga:
   /* Add an option '--support_icarus_simulator' */
   shell_cmd.add_option("support_icarus_simulator", false, "Fine-tune Verilog testbenches to support icarus simulator");
 
+  /* Add an option '--bitstream_memory_file' */
+  shell_cmd.add_option("bitstream_memory_file", false, "Output the bitstream to a memory file which is loaded by the wrapper, instead of imposing it bit by bit in the netlist");
+
   /* add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "enable verbose output");
   
@@ -240,6 +272,18 @@ ShellCommandId add_openfpga_write_simulation_task_info_command(openfpga::Shell<O
   CommandOptionId ref_bm_opt = shell_cmd.add_option("reference_benchmark_file_path", true, "Specify the file path to the reference Verilog netlist");
   shell_cmd.set_option_require_value(ref_bm_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--random_seed'*/
+  CommandOptionId random_seed_opt = shell_cmd.add_option("random_seed", false, "Specify the seed of the first partition of random stimulus. By default, it is 0");
+  shell_cmd.set_option_require_value(random_seed_opt, openfpga::OPT_INT);
+
+  /* Add an option '--num_random_partitions'*/
+  CommandOptionId num_random_partitions_opt = shell_cmd.add_option("num_random_partitions", false, "Specify the number of partitions of random stimulus, each of which is simulated with a different seed. By default, it is 1");
+  shell_cmd.set_option_require_value(num_random_partitions_opt, openfpga::OPT_INT);
+
+  /* Add an option '--num_simulation_shards'*/
+  CommandOptionId num_shards_opt = shell_cmd.add_option("num_simulation_shards", false, "Specify the number of shards, between which the partitions of random stimulus are split. Each shard has its own simulation task file, so that shards can be simulated on different machines. By default, it is 1");
+  shell_cmd.set_option_require_value(num_shards_opt, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
   
@@ -254,6 +298,36 @@ ShellCommandId add_openfpga_write_simulation_task_info_command(openfpga::Shell<O
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report netlist write profile
+ * - Add associated options 
+ * - Add command dependency
+ *******************************************************************/
+static 
+ShellCommandId add_openfpga_report_netlist_write_profile_command(openfpga::Shell<OpenfpgaContext>& shell,
+                                                                 const ShellCommandClassId& cmd_class_id,
+                                                                 const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_netlist_write_profile");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId output_opt = shell_cmd.add_option("file", true, "Specify the file path to output the profile in JSON format");
+  shell_cmd.set_option_short_name(output_opt, "f");
+  shell_cmd.set_option_require_value(output_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+  
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(shell_cmd, "report the wall time, peak memory, sizes and modules of the Verilog and SPICE netlists which have been written");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, report_netlist_write_profile);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_openfpga_verilog_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Get the unique id of 'build_fabric' command which is to be used in creating the dependency graph */
   const ShellCommandId& build_fabric_cmd_id = shell.command(std::string("build_fabric"));
@@ -310,6 +384,17 @@ void add_openfpga_verilog_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_write_simulation_task_info_command(shell,
                                                   openfpga_verilog_cmd_class,
                                                   sim_task_info_dependent_cmds);
+
+  /******************************** 
+   * Command 'report_netlist_write_profile' 
+   */
+  /* The command 'report_netlist_write_profile' can be executed at any time,
+   * only the netlists which have been written are reported
+   */
+  std::vector<ShellCommandId> netlist_write_profile_dependent_cmds;
+  add_openfpga_report_netlist_write_profile_command(shell,
+                                                    openfpga_verilog_cmd_class,
+                                                    netlist_write_profile_dependent_cmds);
 } 
 
 } /* end namespace openfpga */
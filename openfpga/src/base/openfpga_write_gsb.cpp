@@ -1,6 +1,7 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+
 /* Headers from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
@@ -10,6 +11,7 @@
 
 #include "write_xml_device_rr_gsb.h"
 
+#include "openfpga_command_utils.h"
 #include "openfpga_write_gsb.h"
 
 /* Include global variables of VPR */
@@ -33,13 +35,29 @@ int write_gsb(const OpenfpgaContext& openfpga_ctx,
   VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
   VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
 
+  CommandOptionId opt_unique = cmd.option("unique");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
   std::string sb_file_name = cmd_context.option_value(cmd, opt_file);
 
+  /* The unique mirrors are only identified when the routing hierarchy is compressed */
+  if ((true == cmd_context.option_enable(cmd, opt_unique))
+     && (0 == openfpga_ctx.device_rr_gsb().get_num_sb_unique_module())) {
+    VTR_LOG_ERROR("Option '--unique' requires the unique switch blocks, which are identified by 'build_fabric --compress_routing'!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* By default, use the number of threads given by 'set_num_threads' */
+  int num_threads = find_command_num_threads(openfpga_ctx.flow_manager(), cmd, cmd_context);
+  if (0 > num_threads) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   write_device_rr_gsb_to_xml(sb_file_name.c_str(),
                              g_vpr_ctx.device().rr_graph,
                              openfpga_ctx.device_rr_gsb(),
+                             cmd_context.option_enable(cmd, opt_unique),
+                             size_t(num_threads),
                              cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -19,6 +19,150 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Memory decoders with wider addresses are built as a tree of smaller decoders,
+ * as the behavioral description of a flat decoder grows with its number of outputs
+ * and is slow to be written and synthesized
+ */
+constexpr size_t MEMORY_DECODER_MAX_FLAT_ADDR_SIZE = 8;
+
+/***************************************************************************************
+ * Find if a BL/WL decoder should be built as a tree of smaller decoders
+ * Decoders with data_inv ports are not supported and are always flat
+ ***************************************************************************************/
+static 
+bool use_memory_decoder_tree(const DecoderLibrary& decoder_lib,
+                             const DecoderId& decoder) {
+  return (MEMORY_DECODER_MAX_FLAT_ADDR_SIZE < decoder_lib.addr_size(decoder))
+      && ((size_t(1) << MEMORY_DECODER_MAX_FLAT_ADDR_SIZE) < decoder_lib.data_size(decoder))
+      && (true == decoder_lib.use_enable(decoder))
+      && (false == decoder_lib.use_data_inv_port(decoder));
+}
+
+/***************************************************************************************
+ * Build the child modules and nets of a BL/WL decoder as a tree of smaller decoders
+ * - A predecoder decodes the MSBs of the address to the enable signals of group decoders
+ * - Each group decoder decodes the LSBs of the address to a group of data outputs
+ *
+ *                  address[MSBs]
+ *                        |
+ *                        v
+ *                  +------------+
+ *       enable --->| Predecoder |
+ *                  +------------+
+ *                    |   ...   |
+ *                    v         v            
+ *  address[LSBs]-->+-------+ +-------+<-- data_in (BL decoders only)
+ *                  | Group | | Group |
+ *                  +-------+ +-------+
+ *                   | ... |   | ... |
+ *                   v     v   v     v
+ *                      Data Outputs
+ *
+ *  The group decoders are memoized in the decoder library and module manager
+ ***************************************************************************************/
+static 
+void build_memory_decoder_tree(ModuleManager& module_manager,
+                               DecoderLibrary& decoder_lib,
+                               const DecoderId& decoder,
+                               const ModuleId& module_id) {
+  size_t addr_size = decoder_lib.addr_size(decoder);
+  size_t data_size = decoder_lib.data_size(decoder);
+  bool use_data_in = decoder_lib.use_data_in(decoder);
+
+  size_t group_addr_size = MEMORY_DECODER_MAX_FLAT_ADDR_SIZE;
+  size_t group_data_size = size_t(1) << group_addr_size;
+  size_t num_groups = (data_size + group_data_size - 1) / group_data_size;
+
+  /* Find or create the predecoder, which may be a tree as well */
+  DecoderId predecoder_id = decoder_lib.find_decoder(addr_size - group_addr_size, num_groups,
+                                                     true, false, false);
+  if (DecoderId::INVALID() == predecoder_id) {
+    predecoder_id = decoder_lib.add_decoder(addr_size - group_addr_size, num_groups, true, false, false);
+  }
+  ModuleId predecoder_module = module_manager.find_module(generate_memory_decoder_subckt_name(addr_size - group_addr_size, num_groups));
+  if (ModuleId::INVALID() == predecoder_module) {
+    predecoder_module = build_wl_memory_decoder_module(module_manager, decoder_lib, predecoder_id);
+  }
+  VTR_ASSERT(ModuleId::INVALID() != predecoder_module);
+
+  /* Find or create the group decoder */
+  DecoderId group_decoder_id = decoder_lib.find_decoder(group_addr_size, group_data_size,
+                                                        true, use_data_in, false);
+  if (DecoderId::INVALID() == group_decoder_id) {
+    group_decoder_id = decoder_lib.add_decoder(group_addr_size, group_data_size, true, use_data_in, false);
+  }
+  std::string group_decoder_module_name = generate_memory_decoder_subckt_name(group_addr_size, group_data_size);
+  if (true == use_data_in) {
+    group_decoder_module_name = generate_memory_decoder_with_data_in_subckt_name(group_addr_size, group_data_size);
+  }
+  ModuleId group_decoder_module = module_manager.find_module(group_decoder_module_name);
+  if (ModuleId::INVALID() == group_decoder_module) {
+    if (true == use_data_in) {
+      group_decoder_module = build_bl_memory_decoder_module(module_manager, decoder_lib, group_decoder_id);
+    } else {
+      group_decoder_module = build_wl_memory_decoder_module(module_manager, decoder_lib, group_decoder_id);
+    }
+  }
+  VTR_ASSERT(ModuleId::INVALID() != group_decoder_module);
+
+  ModulePortId en_port = module_manager.find_module_port(module_id, std::string(DECODER_ENABLE_PORT_NAME));
+  ModulePortId addr_port = module_manager.find_module_port(module_id, std::string(DECODER_ADDRESS_PORT_NAME));
+  ModulePortId data_port = module_manager.find_module_port(module_id, std::string(DECODER_DATA_OUT_PORT_NAME));
+  ModulePortId predecoder_en_port = module_manager.find_module_port(predecoder_module, std::string(DECODER_ENABLE_PORT_NAME));
+  ModulePortId predecoder_addr_port = module_manager.find_module_port(predecoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+  ModulePortId predecoder_data_port = module_manager.find_module_port(predecoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+  ModulePortId group_en_port = module_manager.find_module_port(group_decoder_module, std::string(DECODER_ENABLE_PORT_NAME));
+  ModulePortId group_addr_port = module_manager.find_module_port(group_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+  ModulePortId group_data_port = module_manager.find_module_port(group_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+
+  /* Add the predecoder and wire the enable signal and the MSBs of the address to it */
+  size_t predecoder_instance = module_manager.num_instance(module_id, predecoder_module);
+  module_manager.add_child_module(module_id, predecoder_module);
+
+  ModuleNetId en_net = create_module_source_pin_net(module_manager, module_id, module_id, 0, en_port, 0);
+  module_manager.add_module_net_sink(module_id, en_net, predecoder_module, predecoder_instance, predecoder_en_port, 0);
+  for (size_t ipin = group_addr_size; ipin < addr_size; ++ipin) {
+    ModuleNetId addr_net = create_module_source_pin_net(module_manager, module_id, module_id, 0, addr_port, ipin);
+    module_manager.add_module_net_sink(module_id, addr_net, predecoder_module, predecoder_instance, predecoder_addr_port, ipin - group_addr_size);
+  }
+
+  /* Add the group decoders */
+  std::vector<size_t> group_instances;
+  for (size_t igroup = 0; igroup < num_groups; ++igroup) {
+    group_instances.push_back(module_manager.num_instance(module_id, group_decoder_module));
+    module_manager.add_child_module(module_id, group_decoder_module);
+
+    ModuleNetId group_en_net = create_module_source_pin_net(module_manager, module_id, predecoder_module, predecoder_instance, predecoder_data_port, igroup);
+    module_manager.add_module_net_sink(module_id, group_en_net, group_decoder_module, group_instances.back(), group_en_port, 0);
+
+    /* Only the data outputs within the data size are wired, the rest are left open */
+    for (size_t ipin = 0; ipin < group_data_size; ++ipin) {
+      size_t data_pin = igroup * group_data_size + ipin;
+      if (data_pin >= data_size) {
+        break;
+      }
+      ModuleNetId data_net = create_module_source_pin_net(module_manager, module_id, group_decoder_module, group_instances.back(), group_data_port, ipin);
+      module_manager.add_module_net_sink(module_id, data_net, module_id, 0, data_port, data_pin);
+    }
+  }
+
+  /* The LSBs of the address and the data_in are shared by all the group decoders */
+  for (size_t ipin = 0; ipin < group_addr_size; ++ipin) {
+    ModuleNetId addr_net = create_module_source_pin_net(module_manager, module_id, module_id, 0, addr_port, ipin);
+    for (const size_t& group_instance : group_instances) {
+      module_manager.add_module_net_sink(module_id, addr_net, group_decoder_module, group_instance, group_addr_port, ipin);
+    }
+  }
+  if (true == use_data_in) {
+    ModulePortId din_port = module_manager.find_module_port(module_id, std::string(DECODER_DATA_IN_PORT_NAME));
+    ModulePortId group_din_port = module_manager.find_module_port(group_decoder_module, std::string(DECODER_DATA_IN_PORT_NAME));
+    ModuleNetId din_net = create_module_source_pin_net(module_manager, module_id, module_id, 0, din_port, 0);
+    for (const size_t& group_instance : group_instances) {
+      module_manager.add_module_net_sink(module_id, din_net, group_decoder_module, group_instance, group_din_port, 0);
+    }
+  }
+}
+
 /***************************************************************************************
  * Create a module for a decoder with a given output size
  *
@@ -93,7 +237,7 @@ ModuleId build_frame_memory_decoder_module(ModuleManager& module_manager,
  *  Therefore, the number of inputs is ceil(log(num_of_outputs)/log(2))
  ***************************************************************************************/
 ModuleId build_bl_memory_decoder_module(ModuleManager& module_manager,
-                                        const DecoderLibrary& decoder_lib,
+                                        DecoderLibrary& decoder_lib,
                                         const DecoderId& decoder) {
   /* Get the number of inputs */
   size_t addr_size = decoder_lib.addr_size(decoder);
@@ -119,6 +263,14 @@ ModuleId build_bl_memory_decoder_module(ModuleManager& module_manager,
   BasicPort data_port(std::string(DECODER_DATA_OUT_PORT_NAME), data_size);
   module_manager.add_port(module_id, data_port, ModuleManager::MODULE_OUTPUT_PORT);
 
+  /* Wide decoders are built as a tree of smaller decoders,
+   * whose data port is driven by the child modules
+   */
+  if (true == use_memory_decoder_tree(decoder_lib, decoder)) {
+    build_memory_decoder_tree(module_manager, decoder_lib, decoder, module_id);
+    return module_id;
+  }
+
   /* Data port is registered. It should be outputted as 
    *   output reg [lsb:msb] data 
    */
@@ -151,7 +303,7 @@ ModuleId build_bl_memory_decoder_module(ModuleManager& module_manager,
  *  Therefore, the number of inputs is ceil(log(num_of_outputs)/log(2))
  ***************************************************************************************/
 ModuleId build_wl_memory_decoder_module(ModuleManager& module_manager,
-                                        const DecoderLibrary& decoder_lib,
+                                        DecoderLibrary& decoder_lib,
                                         const DecoderId& decoder) {
   /* Get the number of inputs */
   size_t addr_size = decoder_lib.addr_size(decoder);
@@ -174,6 +326,14 @@ ModuleId build_wl_memory_decoder_module(ModuleManager& module_manager,
   BasicPort data_port(std::string(DECODER_DATA_OUT_PORT_NAME), data_size);
   module_manager.add_port(module_id, data_port, ModuleManager::MODULE_OUTPUT_PORT);
 
+  /* Wide decoders are built as a tree of smaller decoders,
+   * whose data port is driven by the child modules
+   */
+  if (true == use_memory_decoder_tree(decoder_lib, decoder)) {
+    build_memory_decoder_tree(module_manager, decoder_lib, decoder, module_id);
+    return module_id;
+  }
+
   /* Data port is registered. It should be outputted as 
    *   output reg [lsb:msb] data 
    */
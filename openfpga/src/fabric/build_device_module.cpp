@@ -18,8 +18,10 @@
 #include "build_wire_modules.h"
 #include "build_memory_modules.h"
 #include "build_grid_modules.h"
+#include "merge_identical_grid_modules.h"
 #include "build_routing_modules.h"
 #include "build_top_module.h"
+#include "openfpga_naming.h"
 #include "build_device_module.h"
 
 /* begin namespace openfpga */
@@ -28,6 +30,12 @@ namespace openfpga {
 /********************************************************************
  * The main function to be called for building module graphs 
  * for a FPGA fabric
+ *
+ * When 'requested_modules' is not empty, a partial fabric is built:
+ * only the physical tiles and the routing modules with these names
+ * (along with the primitive modules) are built, and the top-level module
+ * is skipped, which saves the runtime and memory of the modules
+ * that are not exported
  *******************************************************************/
 int build_device_module_graph(ModuleManager& module_manager,
                               DecoderLibrary& decoder_lib,
@@ -36,8 +44,12 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& frame_view,
                               const bool& compress_routing,
                               const bool& duplicate_grid_pin,
+                              const bool& merge_grid_modules,
                               const FabricKey& fabric_key,
                               const bool& generate_random_fabric_key,
+                              const bool& balance_config_regions,
+                              const std::set<std::string>& requested_modules,
+                              const size_t& num_threads,
                               const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build fabric module graph");
 
@@ -79,6 +91,7 @@ int build_device_module_graph(ModuleManager& module_manager,
                        openfpga_ctx.arch().config_protocol.type());
 
   /* Build grid and programmable block modules */
+  size_t num_modules_before_grids = module_manager.num_modules();
   build_grid_modules(module_manager,
                      decoder_lib,
                      vpr_device_ctx,
@@ -86,7 +99,17 @@ int build_device_module_graph(ModuleManager& module_manager,
                      openfpga_ctx.arch().circuit_lib,
                      openfpga_ctx.mux_lib(),
                      openfpga_ctx.arch().config_protocol.type(),
-                     sram_model, duplicate_grid_pin, verbose);
+                     sram_model, duplicate_grid_pin,
+                     requested_modules, verbose);
+
+  /* Merge the identical grid modules, before they are instanciated by the top-level module */
+  if (true == merge_grid_modules) {
+    std::vector<ModuleId> grid_modules;
+    for (size_t imodule = num_modules_before_grids; imodule < module_manager.num_modules(); ++imodule) {
+      grid_modules.push_back(ModuleId(imodule));
+    }
+    merge_identical_grid_modules(module_manager, grid_modules, verbose);
+  }
 
   if (true == compress_routing) {
     build_unique_routing_modules(module_manager,
@@ -96,7 +119,8 @@ int build_device_module_graph(ModuleManager& module_manager,
                                  openfpga_ctx.device_rr_gsb(),
                                  openfpga_ctx.arch().circuit_lib,
                                  openfpga_ctx.arch().config_protocol.type(),
-                                 sram_model, verbose);
+                                 sram_model, requested_modules,
+                                 num_threads, verbose);
   } else {
     VTR_ASSERT_SAFE(false == compress_routing);
     build_flatten_routing_modules(module_manager,
@@ -106,24 +130,29 @@ int build_device_module_graph(ModuleManager& module_manager,
                                   openfpga_ctx.device_rr_gsb(),
                                   openfpga_ctx.arch().circuit_lib,
                                   openfpga_ctx.arch().config_protocol.type(),
-                                  sram_model, verbose);
+                                  sram_model, requested_modules,
+                                  verbose);
   }
 
-  /* Build FPGA fabric top-level module */
-  status = build_top_module(module_manager,
-                            decoder_lib,
-                            openfpga_ctx.arch().circuit_lib, 
-                            openfpga_ctx.vpr_device_annotation(),
-                            vpr_device_ctx.grid,
-                            openfpga_ctx.arch().tile_annotations, 
-                            vpr_device_ctx.rr_graph,
-                            openfpga_ctx.device_rr_gsb(), 
-                            openfpga_ctx.tile_direct(), 
-                            openfpga_ctx.arch().arch_direct, 
-                            openfpga_ctx.arch().config_protocol,
-                            sram_model,
-                            frame_view, compress_routing, duplicate_grid_pin,
-                            fabric_key, generate_random_fabric_key);
+  /* Build FPGA fabric top-level module, only for a full fabric */
+  if (true == requested_modules.empty()) {
+    status = build_top_module(module_manager,
+                              decoder_lib,
+                              openfpga_ctx.arch().circuit_lib, 
+                              openfpga_ctx.vpr_device_annotation(),
+                              vpr_device_ctx.grid,
+                              openfpga_ctx.arch().tile_annotations, 
+                              vpr_device_ctx.rr_graph,
+                              openfpga_ctx.device_rr_gsb(), 
+                              openfpga_ctx.tile_direct(), 
+                              openfpga_ctx.arch().arch_direct, 
+                              openfpga_ctx.arch().config_protocol,
+                              sram_model,
+                              frame_view, compress_routing, duplicate_grid_pin,
+                              fabric_key, generate_random_fabric_key,
+                              balance_config_regions,
+                              num_threads);
+  }
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
@@ -138,6 +167,84 @@ int build_device_module_graph(ModuleManager& module_manager,
    */
   rename_primitive_module_port_names(module_manager, openfpga_ctx.arch().circuit_lib);
 
+  /* The graph is complete: compact it for the writers */
+  module_manager.freeze();
+
+  return status;
+}
+
+/********************************************************************
+ * Rebuild the top-level module of a complete module graph
+ * with another fabric key, while the other modules are kept.
+ * The top-level module is the last module built by build_device_module_graph(),
+ * except for the decoders built for its configuration protocol.
+ * They are removed and built again, so that the module graph is the same
+ * as the one built from scratch with the fabric key
+ *
+ * Note: the options must be the same as the ones used to build the module graph
+ *******************************************************************/
+int rebuild_device_top_module(ModuleManager& module_manager,
+                              DecoderLibrary& decoder_lib,
+                              const OpenfpgaContext& openfpga_ctx,
+                              const DeviceContext& vpr_device_ctx,
+                              const bool& frame_view,
+                              const bool& compress_routing,
+                              const bool& duplicate_grid_pin,
+                              const FabricKey& fabric_key,
+                              const size_t& num_threads) {
+  vtr::ScopedStartFinishTimer timer("Rebuild fabric top-level module");
+
+  ModuleId top_module = module_manager.find_module(generate_fpga_top_module_name());
+  if (false == module_manager.valid_module_id(top_module)) {
+    VTR_LOG_ERROR("Unable to find the top-level module '%s' to rebuild!\n",
+                  generate_fpga_top_module_name().c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* The modules after the top-level module should all be built for it.
+   * Other modules, e.g., added by netlist writers, would be lost
+   */
+  std::vector<bool> built_for_top(module_manager.num_modules(), false);
+  for (size_t imodule = size_t(top_module); imodule < module_manager.num_modules(); ++imodule) {
+    for (const ModuleId& child : module_manager.child_modules(ModuleId(imodule))) {
+      built_for_top[size_t(child)] = true;
+    }
+  }
+  for (size_t imodule = size_t(top_module) + 1; imodule < module_manager.num_modules(); ++imodule) {
+    if (false == built_for_top[imodule]) {
+      VTR_LOG_ERROR("Module '%s' is added after the top-level module is built. Please rebuild the fabric from scratch!\n",
+                    module_manager.module_name(ModuleId(imodule)).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  module_manager.remove_modules_from(top_module);
+
+  CircuitModelId sram_model = openfpga_ctx.arch().config_protocol.memory_model();  
+  VTR_ASSERT(true == openfpga_ctx.arch().circuit_lib.valid_model_id(sram_model));
+
+  int status = build_top_module(module_manager,
+                                decoder_lib,
+                                openfpga_ctx.arch().circuit_lib, 
+                                openfpga_ctx.vpr_device_annotation(),
+                                vpr_device_ctx.grid,
+                                openfpga_ctx.arch().tile_annotations, 
+                                vpr_device_ctx.rr_graph,
+                                openfpga_ctx.device_rr_gsb(), 
+                                openfpga_ctx.tile_direct(), 
+                                openfpga_ctx.arch().arch_direct, 
+                                openfpga_ctx.arch().config_protocol,
+                                sram_model,
+                                frame_view, compress_routing, duplicate_grid_pin,
+                                fabric_key, false, false,
+                                num_threads);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
+  }
+
+  /* The primitive modules have been renamed when the module graph was built */
+  module_manager.freeze();
+
   return status;
 }
 
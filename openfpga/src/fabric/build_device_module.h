@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <set>
+#include <string>
 #include "vpr_context.h"
 #include "openfpga_context.h"
 #include "fabric_key.h"
@@ -22,10 +24,24 @@ int build_device_module_graph(ModuleManager& module_manager,
                               const bool& frame_view,
                               const bool& compress_routing,
                               const bool& duplicate_grid_pin,
+                              const bool& merge_grid_modules,
                               const FabricKey& fabric_key,
                               const bool& generate_random_fabric_key,
+                              const bool& balance_config_regions,
+                              const std::set<std::string>& requested_modules,
+                              const size_t& num_threads,
                               const bool& verbose);
 
+int rebuild_device_top_module(ModuleManager& module_manager,
+                              DecoderLibrary& decoder_lib,
+                              const OpenfpgaContext& openfpga_ctx,
+                              const DeviceContext& vpr_device_ctx,
+                              const bool& frame_view,
+                              const bool& compress_routing,
+                              const bool& duplicate_grid_pin,
+                              const FabricKey& fabric_key,
+                              const size_t& num_threads);
+
 } /* end namespace openfpga */
 
 #endif
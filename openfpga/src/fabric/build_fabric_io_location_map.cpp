@@ -35,22 +35,27 @@ IoLocationMap build_fabric_io_location_map(const ModuleManager& module_manager,
 
   IoLocationMap io_location_map;
 
+  /* Size the lookup once for all the locations of the device */
+  size_t max_capacity = 0;
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      max_capacity = std::max(max_capacity, size_t(grids[ix][iy].type->capacity));
+    }
+  }
+  io_location_map.resize_io_locations(grids.width(), grids.height(), max_capacity);
+
   std::map<std::string, size_t> io_counter;
 
+  t_device_grid_summary grid_summary = build_device_grid_summary(grids);
+
   /* Create the coordinate range for each side of FPGA fabric */
   std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates = generate_perimeter_grid_coordinates( grids);
 
   /* Walk through all the grids on the perimeter, which are I/O grids */
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
-      /* Bypass EMPTY grid */
-      if (true == is_empty_type(grids[io_coordinate.x()][io_coordinate.y()].type)) {
-        continue;
-      } 
-
-      /* Skip width or height > 1 tiles (mostly heterogeneous blocks) */
-      if ( (0 < grids[io_coordinate.x()][io_coordinate.y()].width_offset)
-        || (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset)) {
+      /* Bypass EMPTY grid, and skip width or height > 1 tiles (mostly heterogeneous blocks) */
+      if (false == grid_summary.roots[io_coordinate.x()][io_coordinate.y()]) {
         continue;
       }
 
@@ -58,7 +63,7 @@ IoLocationMap build_fabric_io_location_map(const ModuleManager& module_manager,
 
       /* Find the module name for this type of grid */
       std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
-      std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), io_side);
+      std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), grid_summary.io_types[io_coordinate.x()][io_coordinate.y()], io_side);
       ModuleId grid_module = module_manager.find_module(grid_module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
 
@@ -102,14 +107,8 @@ IoLocationMap build_fabric_io_location_map(const ModuleManager& module_manager,
   /* Walk through all the center grids, which may include I/O grids */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
-      /* Bypass EMPTY grid */
-      if (true == is_empty_type(grids[ix][iy].type)) {
-        continue;
-      } 
-
-      /* Skip width or height > 1 tiles (mostly heterogeneous blocks) */
-      if ( (0 < grids[ix][iy].width_offset)
-        || (0 < grids[ix][iy].height_offset)) {
+      /* Bypass EMPTY grid, and skip width or height > 1 tiles (mostly heterogeneous blocks) */
+      if (false == grid_summary.roots[ix][iy]) {
         continue;
       }
 
@@ -117,7 +116,7 @@ IoLocationMap build_fabric_io_location_map(const ModuleManager& module_manager,
 
       /* Find the module name for this type of grid */
       std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
-      std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), NUM_SIDES);
+      std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), grid_summary.io_types[ix][iy], NUM_SIDES);
       ModuleId grid_module = module_manager.find_module(grid_module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
 
@@ -9,9 +9,11 @@
  * Please follow this rules when creating new features!
  *******************************************************************/
 #include <algorithm>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -127,173 +129,294 @@ void add_grid_module_duplicated_pb_type_ports(ModuleManager& module_manager,
 }
 
 /********************************************************************
- * Add module nets to connect a port of child pb_module
- * to the duplicated pins of grid module 
- * Note: This function SHOULD be ONLY applied to pb_graph output pins 
- * of the child module.
- * For each such pin, we connect it to two outputs of the grid module
- * one is named after "upper", and the other is named after "lower"
+ * Check if a pin of a physical tile is located on any side of the tile,
+ * i.e., if it may have a port in any grid module of the tile
  *******************************************************************/
 static 
-void add_grid_module_net_connect_duplicated_pb_graph_pin(ModuleManager& module_manager,
-                                                         const ModuleId& grid_module,
-                                                         const ModuleId& child_module,
-                                                         const size_t& child_instance,
-                                                         const VprDeviceAnnotation& vpr_device_annotation,
-                                                         t_physical_tile_type_ptr grid_type_descriptor,
-                                                         t_pb_graph_pin* pb_graph_pin,
-                                                         const e_side& border_side,
-                                                         const e_pin2pin_interc_type& pin2pin_interc_type) {
-  /* Make sure this is ONLY applied to output pins */
-  VTR_ASSERT(OUTPUT2OUTPUT_INTERC == pin2pin_interc_type);
-  
-  /* Find the pin side for I/O grids*/
-  std::vector<e_side> grid_pin_sides;
-  /* For I/O grids, we care only one side
-   * Otherwise, we will iterate all the 4 sides  
-   */
-  if (true == is_io_type(grid_type_descriptor)) {
-    grid_pin_sides = find_grid_module_pin_sides(grid_type_descriptor, border_side);
-  } else {
-    grid_pin_sides = {TOP, RIGHT, BOTTOM, LEFT}; 
+bool is_grid_core_pin_located(t_physical_tile_type_ptr grid_type_descriptor,
+                              const int& ipin) {
+  for (int iwidth = 0; iwidth < grid_type_descriptor->width; ++iwidth) {
+    for (int iheight = 0; iheight < grid_type_descriptor->height; ++iheight) {
+      for (const e_side& side : {TOP, RIGHT, BOTTOM, LEFT}) {
+        if (true == grid_type_descriptor->pinloc[iwidth][iheight][side][ipin]) {
+          return true;
+        }
+      }
+    }
   }
+  return false;
+}
 
-  /* num_pins/capacity = the number of pins that each type_descriptor has.
-   * Capacity defines the number of type_descriptors in each grid
-   * so the pin index at grid level = pin_index_in_type_descriptor 
-   *                                + type_descriptor_index_in_capacity * num_pins_per_type_descriptor
-   */
+/********************************************************************
+ * Find the name of the port of the core module which is the given pin of the physical tile
+ *******************************************************************/
+static 
+std::string find_grid_core_module_port_name(const VprDeviceAnnotation& vpr_device_annotation,
+                                            t_physical_tile_type_ptr grid_type_descriptor,
+                                            const int& ipin) {
+  BasicPort pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type_descriptor, ipin);
+  VTR_ASSERT(true == pin_info.is_valid());
+  int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type_descriptor, ipin);
+  VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type_descriptor->capacity);
+  return generate_grid_core_port_name(subtile_index, pin_info);
+}
+
+/********************************************************************
+ * This function adds pb_type ports to the core module of a physical tile,
+ * which is instanciated by all the grid modules of the tile when pins are duplicated.
+ * Unlike the grid modules, the core module has a single port for each pin
+ * of the physical tile, whatever the sides and locations of the pin.
+ * Therefore, the core module does not depend on the border side of a grid,
+ * while each grid module connects the pins of its own sides to the core module
+ * (see add_grid_module_nets_connect_duplicated_core_ports())
+ *
+ * Pins which are not located on any side of the tile do not have any port,
+ * as in the grid modules without duplication
+ *******************************************************************/
+void add_grid_core_module_pb_type_ports(ModuleManager& module_manager,
+                                        const ModuleId& core_module,
+                                        const VprDeviceAnnotation& vpr_device_annotation,
+                                        t_physical_tile_type_ptr grid_type_descriptor) {
+  /* Ensure that we have a valid grid_type_descriptor */
+  VTR_ASSERT(false == is_empty_type(grid_type_descriptor));
+
+  /* Create a map between pin class type and grid pin direction */
+  std::map<e_pin_type, ModuleManager::e_module_port_type> pin_type2type_map;
+  pin_type2type_map[RECEIVER] = ModuleManager::MODULE_INPUT_PORT;
+  pin_type2type_map[DRIVER] = ModuleManager::MODULE_OUTPUT_PORT;
+
+  for (int ipin = 0; ipin < grid_type_descriptor->num_pins; ++ipin) {
+    if (false == is_grid_core_pin_located(grid_type_descriptor, ipin)) {
+      continue;
+    }
+    int class_id = grid_type_descriptor->pin_class[ipin];
+    e_pin_type pin_class_type = grid_type_descriptor->class_inf[class_id].type;
+
+    std::string port_name = find_grid_core_module_port_name(vpr_device_annotation, grid_type_descriptor, ipin);
+    BasicPort core_port(port_name, 0, 0);
+    /* Add the port to the module */
+    module_manager.add_port(core_module, core_port, pin_type2type_map[pin_class_type]);
+  }
+}
+
+/********************************************************************
+ * Add a module net to connect a pin of a logical tile module
+ * to its port in the core module of a physical tile
+ *******************************************************************/
+static 
+void add_grid_core_module_net_connect_pb_graph_pin(ModuleManager& module_manager,
+                                                   const ModuleId& core_module,
+                                                   const ModuleId& child_module,
+                                                   const size_t& child_instance,
+                                                   const VprDeviceAnnotation& vpr_device_annotation,
+                                                   t_physical_tile_type_ptr grid_type_descriptor,
+                                                   t_pb_graph_pin* pb_graph_pin,
+                                                   const e_pin2pin_interc_type& pin2pin_interc_type) {
+  /* The pin index at grid level, see add_grid_module_net_connect_pb_graph_pin() */
   size_t grid_pin_index = pb_graph_pin->pin_count_in_cluster 
                         + child_instance * grid_type_descriptor->num_pins / grid_type_descriptor->capacity;
+  if (false == is_grid_core_pin_located(grid_type_descriptor, grid_pin_index)) {
+    return;
+  }
 
-  int pin_width = grid_type_descriptor->pin_width_offset[grid_pin_index];
-  int pin_height = grid_type_descriptor->pin_height_offset[grid_pin_index];
+  std::string core_port_name = find_grid_core_module_port_name(vpr_device_annotation, grid_type_descriptor, grid_pin_index);
+  ModulePortId core_module_port_id = module_manager.find_module_port(core_module, core_port_name);
+  VTR_ASSERT(true == module_manager.valid_module_port_id(core_module, core_module_port_id));
 
-  BasicPort pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type_descriptor, grid_pin_index);
-  VTR_ASSERT(true == pin_info.is_valid());
-  int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type_descriptor, grid_pin_index);
-  VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type_descriptor->capacity);
+  std::string child_module_port_name = generate_pb_type_port_name(pb_graph_pin->port);
+  ModulePortId child_module_port_id = module_manager.find_module_port(child_module, child_module_port_name);
+  VTR_ASSERT(true == module_manager.valid_module_port_id(child_module, child_module_port_id));
+  size_t child_module_pin_id = pb_graph_pin->pin_number;
 
-  for (const e_side& side : grid_pin_sides) {
-    if (true != grid_type_descriptor->pinloc[pin_width][pin_height][side][grid_pin_index]) {
-      continue;
+  /* Core ports always have only 1 pin */
+  ModuleNetId net = module_manager.create_module_net(core_module);
+  switch (pin2pin_interc_type) {
+  case INPUT2INPUT_INTERC:
+    module_manager.add_module_net_source(core_module, net, core_module, 0, core_module_port_id, 0);
+    module_manager.add_module_net_sink(core_module, net, child_module, child_instance, child_module_port_id, child_module_pin_id);
+    break;
+  case OUTPUT2OUTPUT_INTERC:
+    module_manager.add_module_net_source(core_module, net, child_module, child_instance, child_module_port_id, child_module_pin_id);
+    module_manager.add_module_net_sink(core_module, net, core_module, 0, core_module_port_id, 0);
+    break;
+  default:
+    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid pin-to-pin interconnection type!\n");
+    exit(1);
+  }
+}
+
+/********************************************************************
+ * Add module nets to connect the ports of the core module of a physical tile
+ * (see add_grid_core_module_pb_type_ports()) to an instance of a logical tile module
+ *******************************************************************/
+void add_grid_core_module_nets_connect_pb_type_ports(ModuleManager& module_manager,
+                                                     const ModuleId& core_module,
+                                                     const ModuleId& child_module,
+                                                     const size_t& child_instance,
+                                                     const VprDeviceAnnotation& vpr_device_annotation,
+                                                     t_physical_tile_type_ptr grid_type_descriptor,
+                                                     t_pb_graph_node* top_pb_graph_node) {
+  VTR_ASSERT(nullptr != top_pb_graph_node); 
+
+  for (int iport = 0; iport < top_pb_graph_node->num_input_ports; ++iport) {
+    for (int ipin = 0; ipin < top_pb_graph_node->num_input_pins[iport]; ++ipin) {
+      add_grid_core_module_net_connect_pb_graph_pin(module_manager, core_module,
+                                                    child_module, child_instance,
+                                                    vpr_device_annotation,
+                                                    grid_type_descriptor,
+                                                    &(top_pb_graph_node->input_pins[iport][ipin]),
+                                                    INPUT2INPUT_INTERC);
     }
+  }
 
-    /* Pins for direct connection are NOT duplicated.
-     * Follow the traditional recipe when adding nets!  
-     * Xifan: I assume that each direct connection pin must have Fc=0. 
-     */
-    if (0. == find_physical_tile_pin_Fc(grid_type_descriptor, grid_pin_index)) {
-      /* Create a net to connect the grid pin to child module pin */
-      ModuleNetId net = module_manager.create_module_net(grid_module);
-      /* Find the port in grid_module */
-      std::string grid_port_name = generate_grid_port_name(pin_width, pin_height, subtile_index, side, pin_info);
-      ModulePortId grid_module_port_id = module_manager.find_module_port(grid_module, grid_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_port_id));
-
-      /* Grid port always has only 1 pin, it is assumed when adding these ports to the module
-       * if you need a change, please also change the port adding codes  
-       */
-      size_t grid_module_pin_id = 0;
-      /* Find the port in child module */
-      std::string child_module_port_name = generate_pb_type_port_name(pb_graph_pin->port);
-      ModulePortId child_module_port_id = module_manager.find_module_port(child_module, child_module_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(child_module, child_module_port_id));
-      size_t child_module_pin_id = pb_graph_pin->pin_number;
-      /* Add net sources and sinks:
-       * For output-to-output connection, net_source is pb_graph_pin, while net_sink is grid pin   
-       */
-      module_manager.add_module_net_source(grid_module, net, child_module, child_instance, child_module_port_id, child_module_pin_id);
-      module_manager.add_module_net_sink(grid_module, net, grid_module, 0, grid_module_port_id, grid_module_pin_id);
-      continue;
+  for (int iport = 0; iport < top_pb_graph_node->num_output_ports; ++iport) {
+    for (int ipin = 0; ipin < top_pb_graph_node->num_output_pins[iport]; ++ipin) {
+      add_grid_core_module_net_connect_pb_graph_pin(module_manager, core_module,
+                                                    child_module, child_instance,
+                                                    vpr_device_annotation,
+                                                    grid_type_descriptor,
+                                                    &(top_pb_graph_node->output_pins[iport][ipin]),
+                                                    OUTPUT2OUTPUT_INTERC);
     }
-    /* Reach here, it means this pin is on this side */
-    /* Create a net to connect the grid pin to child module pin */
-    ModuleNetId net = module_manager.create_module_net(grid_module);
-    /* Find the upper port in grid_module */
-    std::string grid_upper_port_name = generate_grid_duplicated_port_name(pin_width, pin_height, subtile_index, side, pin_info, true);
-    ModulePortId grid_module_upper_port_id = module_manager.find_module_port(grid_module, grid_upper_port_name);
-    VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_upper_port_id));
-
-    /* Find the lower port in grid_module */
-    std::string grid_lower_port_name = generate_grid_duplicated_port_name(pin_width, pin_height, subtile_index, side, pin_info, false);
-    ModulePortId grid_module_lower_port_id = module_manager.find_module_port(grid_module, grid_lower_port_name);
-    VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_lower_port_id));
-
-    /* Grid port always has only 1 pin, it is assumed when adding these ports to the module
-     * if you need a change, please also change the port adding codes  
-     */
-    size_t grid_module_pin_id = 0;
-    /* Find the port in child module */
-    std::string child_module_port_name = generate_pb_type_port_name(pb_graph_pin->port);
-    ModulePortId child_module_port_id = module_manager.find_module_port(child_module, child_module_port_name);
-    VTR_ASSERT(true == module_manager.valid_module_port_id(child_module, child_module_port_id));
-    size_t child_module_pin_id = pb_graph_pin->pin_number;
-
-    /* Add net sources and sinks:
-     * For output-to-output connection, 
-     * net_source is pb_graph_pin, 
-     * while net_sinks are grid upper pin and grid lower pin
-     */
-    module_manager.add_module_net_source(grid_module, net, child_module, child_instance, child_module_port_id, child_module_pin_id);
-    module_manager.add_module_net_sink(grid_module, net, grid_module, 0, grid_module_upper_port_id, grid_module_pin_id);
-    module_manager.add_module_net_sink(grid_module, net, grid_module, 0, grid_module_lower_port_id, grid_module_pin_id);
+  }
+
+  for (int iport = 0; iport < top_pb_graph_node->num_clock_ports; ++iport) {
+    for (int ipin = 0; ipin < top_pb_graph_node->num_clock_pins[iport]; ++ipin) {
+      add_grid_core_module_net_connect_pb_graph_pin(module_manager, core_module,
+                                                    child_module, child_instance,
+                                                    vpr_device_annotation,
+                                                    grid_type_descriptor,
+                                                    &(top_pb_graph_node->clock_pins[iport][ipin]),
+                                                    INPUT2INPUT_INTERC);
+    } 
   }
 }
 
 /********************************************************************
- * Add module nets to connect a port of child pb_module
- * to the duplicated ports of grid module 
+ * Add module nets to connect the duplicated ports of a grid module
+ * to the ports of its core module, which are side-independent
+ * (see add_grid_core_module_pb_type_ports())
+ *
+ * A DRIVER pin of the core module drives the upper and lower pins of the grid
+ * on all the sides and locations of the pin, except the pins for direct connection
+ * which are not duplicated.
+ * A RECEIVER pin of the core module is driven by the pin of the grid on the
+ * first side and location of the pin. As a core pin can only have one driver,
+ * the other locations of a RECEIVER pin, if any, are not connected.
+ * For I/O grids on a border of the fabric, the pins are only on the side
+ * facing the fabric, so each border variant drives all the pins of the core.
+ *
+ *                     Grid (wrapper)
+ *               +-----------------------+
+ *               |    +----------+       |
+ *    pinC ----->|--->|   Core   |------>|--->pinA_upper
+ *               |    |          |   |   |
+ *               |    +----------+   +-->|--->pinA_lower
+ *               +-----------------------+
  *******************************************************************/
-void add_grid_module_nets_connect_duplicated_pb_type_ports(ModuleManager& module_manager,
-                                                           const ModuleId& grid_module,
-                                                           const ModuleId& child_module,
-                                                           const size_t& child_instance,
-                                                           const VprDeviceAnnotation& vpr_device_annotation,
-                                                           t_physical_tile_type_ptr grid_type_descriptor,
-                                                           const e_side& border_side) {
+void add_grid_module_nets_connect_duplicated_core_ports(ModuleManager& module_manager,
+                                                        const ModuleId& grid_module,
+                                                        const ModuleId& core_module,
+                                                        const VprDeviceAnnotation& vpr_device_annotation,
+                                                        t_physical_tile_type_ptr grid_type_descriptor,
+                                                        const e_side& border_side) {
   /* Ensure that we have a valid grid_type_descriptor */
   VTR_ASSERT(false == is_empty_type(grid_type_descriptor));
 
-  for (t_logical_block_type_ptr lb_type : grid_type_descriptor->equivalent_sites) {
-    t_pb_graph_node* top_pb_graph_node = lb_type->pb_graph_head;
-    VTR_ASSERT(nullptr != top_pb_graph_node); 
+  /* Find the pin side for I/O grids*/
+  std::vector<e_side> grid_pin_sides;
+  /* For I/O grids, we care only one side
+   * Otherwise, we will iterate all the 4 sides  
+   */
+  if (true == is_io_type(grid_type_descriptor)) {
+    grid_pin_sides = find_grid_module_pin_sides(grid_type_descriptor, border_side);
+  } else {
+    grid_pin_sides = {TOP, RIGHT, BOTTOM, LEFT}; 
+  }
 
-    for (int iport = 0; iport < top_pb_graph_node->num_input_ports; ++iport) {
-      for (int ipin = 0; ipin < top_pb_graph_node->num_input_pins[iport]; ++ipin) {
-        add_grid_module_net_connect_pb_graph_pin(module_manager, grid_module,
-                                                 child_module, child_instance,
-                                                 vpr_device_annotation,
-                                                 grid_type_descriptor,
-                                                 &(top_pb_graph_node->input_pins[iport][ipin]),
-                                                 border_side,
-                                                 INPUT2INPUT_INTERC);
+  /* Grid and core ports always have only 1 pin, it is assumed when adding these ports to the module
+   * if you need a change, please also change the port adding codes  
+   */
+  size_t grid_module_pin_id = 0;
+  size_t core_module_pin_id = 0;
 
-      }
-    }
+  /* The net driven by each DRIVER pin of the core module,
+   * and the RECEIVER pins of the core module which are already driven
+   */
+  std::map<int, ModuleNetId> core_driver_nets;
+  std::vector<bool> core_receiver_driven(grid_type_descriptor->num_pins, false);
 
-    for (int iport = 0; iport < top_pb_graph_node->num_output_ports; ++iport) {
-      for (int ipin = 0; ipin < top_pb_graph_node->num_output_pins[iport]; ++ipin) {
-        add_grid_module_net_connect_duplicated_pb_graph_pin(module_manager, grid_module,
-                                                            child_module, child_instance,
-                                                            vpr_device_annotation,
-                                                            grid_type_descriptor,
-                                                            &(top_pb_graph_node->output_pins[iport][ipin]),
-                                                            border_side,
-                                                            OUTPUT2OUTPUT_INTERC);
-      }
-    }
+  for (const e_side& side : grid_pin_sides) {
+    for (int iwidth = 0; iwidth < grid_type_descriptor->width; ++iwidth) {
+      for (int iheight = 0; iheight < grid_type_descriptor->height; ++iheight) {
+        for (int ipin = 0; ipin < grid_type_descriptor->num_pins; ++ipin) {
+          if (true != grid_type_descriptor->pinloc[iwidth][iheight][side][ipin]) {
+            continue;
+          }
+          /* Reach here, it means this pin is on this side */
+          int class_id = grid_type_descriptor->pin_class[ipin];
+          e_pin_type pin_class_type = grid_type_descriptor->class_inf[class_id].type;
+
+          BasicPort pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type_descriptor, ipin);
+          VTR_ASSERT(true == pin_info.is_valid());
+          int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type_descriptor, ipin);
+          VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type_descriptor->capacity);
+
+          /* Find the port in core module */
+          std::string core_port_name = generate_grid_core_port_name(subtile_index, pin_info);
+          ModulePortId core_module_port_id = module_manager.find_module_port(core_module, core_port_name);
+          VTR_ASSERT(true == module_manager.valid_module_port_id(core_module, core_module_port_id));
+
+          std::string port_name = generate_grid_port_name(iwidth, iheight, subtile_index, side, pin_info);
 
-    for (int iport = 0; iport < top_pb_graph_node->num_clock_ports; ++iport) {
-      for (int ipin = 0; ipin < top_pb_graph_node->num_clock_pins[iport]; ++ipin) {
-        add_grid_module_net_connect_pb_graph_pin(module_manager, grid_module,
-                                                 child_module, child_instance,
-                                                 vpr_device_annotation,
-                                                 grid_type_descriptor,
-                                                 &(top_pb_graph_node->clock_pins[iport][ipin]),
-                                                 border_side,
-                                                 INPUT2INPUT_INTERC);
-      } 
+          if (RECEIVER == pin_class_type) {
+            if (true == core_receiver_driven[ipin]) {
+              continue;
+            }
+            core_receiver_driven[ipin] = true;
+            ModulePortId grid_module_port_id = module_manager.find_module_port(grid_module, port_name);
+            VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_port_id));
+            ModuleNetId net = module_manager.create_module_net(grid_module);
+            module_manager.add_module_net_source(grid_module, net, grid_module, 0, grid_module_port_id, grid_module_pin_id);
+            module_manager.add_module_net_sink(grid_module, net, core_module, 0, core_module_port_id, core_module_pin_id);
+            continue;
+          }
+
+          VTR_ASSERT(DRIVER == pin_class_type);
+          /* All the locations of a DRIVER pin share the net driven by the core module */
+          auto result = core_driver_nets.find(ipin);
+          ModuleNetId net = ModuleNetId::INVALID();
+          if (result == core_driver_nets.end()) {
+            net = module_manager.create_module_net(grid_module);
+            module_manager.add_module_net_source(grid_module, net, core_module, 0, core_module_port_id, core_module_pin_id);
+            core_driver_nets[ipin] = net;
+          } else {
+            net = result->second;
+          }
+
+          /* Pins for direct connection are NOT duplicated.
+           * Xifan: I assume that each direct connection pin must have Fc=0. 
+           */
+          if (0. == find_physical_tile_pin_Fc(grid_type_descriptor, ipin)) {
+            ModulePortId grid_module_port_id = module_manager.find_module_port(grid_module, port_name);
+            VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_port_id));
+            module_manager.add_module_net_sink(grid_module, net, grid_module, 0, grid_module_port_id, grid_module_pin_id);
+            continue;
+          }
+
+          /* Find the upper and lower ports in grid_module */
+          std::string grid_upper_port_name = generate_grid_duplicated_port_name(iwidth, iheight, subtile_index, side, pin_info, true);
+          ModulePortId grid_module_upper_port_id = module_manager.find_module_port(grid_module, grid_upper_port_name);
+          VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_upper_port_id));
+
+          std::string grid_lower_port_name = generate_grid_duplicated_port_name(iwidth, iheight, subtile_index, side, pin_info, false);
+          ModulePortId grid_module_lower_port_id = module_manager.find_module_port(grid_module, grid_lower_port_name);
+          VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, grid_module_lower_port_id));
+
+          module_manager.add_module_net_sink(grid_module, net, grid_module, 0, grid_module_upper_port_id, grid_module_pin_id);
+          module_manager.add_module_net_sink(grid_module, net, grid_module, 0, grid_module_lower_port_id, grid_module_pin_id);
+        }
+      }
     }
   }
 }
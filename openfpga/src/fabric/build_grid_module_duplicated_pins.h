@@ -22,13 +22,25 @@ void add_grid_module_duplicated_pb_type_ports(ModuleManager& module_manager,
                                               t_physical_tile_type_ptr grid_type_descriptor,
                                               const e_side& border_side);
 
-void add_grid_module_nets_connect_duplicated_pb_type_ports(ModuleManager& module_manager,
-                                                           const ModuleId& grid_module,
-                                                           const ModuleId& child_module,
-                                                           const size_t& child_instance,
-                                                           const VprDeviceAnnotation& vpr_device_annotation,
-                                                           t_physical_tile_type_ptr grid_type_descriptor,
-                                                           const e_side& border_side);
+void add_grid_core_module_pb_type_ports(ModuleManager& module_manager,
+                                        const ModuleId& core_module,
+                                        const VprDeviceAnnotation& vpr_device_annotation,
+                                        t_physical_tile_type_ptr grid_type_descriptor);
+
+void add_grid_core_module_nets_connect_pb_type_ports(ModuleManager& module_manager,
+                                                     const ModuleId& core_module,
+                                                     const ModuleId& child_module,
+                                                     const size_t& child_instance,
+                                                     const VprDeviceAnnotation& vpr_device_annotation,
+                                                     t_physical_tile_type_ptr grid_type_descriptor,
+                                                     t_pb_graph_node* top_pb_graph_node);
+
+void add_grid_module_nets_connect_duplicated_core_ports(ModuleManager& module_manager,
+                                                        const ModuleId& grid_module,
+                                                        const ModuleId& core_module,
+                                                        const VprDeviceAnnotation& vpr_device_annotation,
+                                                        t_physical_tile_type_ptr grid_type_descriptor,
+                                                        const e_side& border_side);
 
 } /* end namespace openfpga */
 
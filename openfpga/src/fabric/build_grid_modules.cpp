@@ -972,36 +972,16 @@ void rec_build_logical_tile_modules(ModuleManager& module_manager,
 }
 
 /*****************************************************************************
- * This function will create a Verilog file and print out a Verilog netlist 
- * for a type of physical block 
- *
- * For IO blocks: 
- * The param 'border_side' is required, which is specify which side of fabric
- * the I/O block locates at.
+ * Add the instances of the logical tile modules to a physical tile module
+ * (or to its core module when the pins are duplicated)
  *****************************************************************************/
 static 
-void build_physical_tile_module(ModuleManager& module_manager,
-                                DecoderLibrary& decoder_lib,
-                                const VprDeviceAnnotation& vpr_device_annotation,
-                                const CircuitLibrary& circuit_lib,
-                                const e_config_protocol_type& sram_orgz_type,
-                                const CircuitModelId& sram_model,
-                                t_physical_tile_type_ptr phy_block_type,
-                                const e_side& border_side,
-                                const bool& duplicate_grid_pin,
-                                const bool& verbose) {
-  /* Create a Module for the top-level physical block, and add to module manager */
-  std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
-                                                                 std::string(phy_block_type->name),
-                                                                 is_io_type(phy_block_type),
-                                                                 border_side);
-  VTR_LOGV(verbose, 
-           "Building physical tile '%s'...",
-           grid_module_name.c_str());
-
-  ModuleId grid_module = module_manager.add_module(grid_module_name); 
-  VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
-
+void add_physical_tile_module_pb_instances(ModuleManager& module_manager,
+                                           const ModuleId& grid_module,
+                                           const CircuitLibrary& circuit_lib,
+                                           const e_config_protocol_type& sram_orgz_type,
+                                           const CircuitModelId& sram_model,
+                                           t_physical_tile_type_ptr phy_block_type) {
   /* Now each physical tile may have a number of logical blocks
    * OpenFPGA only considers the physical implementation of the tiles.
    * So, we do not allow multiple equivalent sites to be defined 
@@ -1039,54 +1019,50 @@ void build_physical_tile_module(ModuleManager& module_manager,
       }
     }
   }
+}
 
-  /* Add grid ports(pins) to the module */
-  if (false == duplicate_grid_pin) {
-    /* Default way to add these ports by following the definition in pb_types */
-    add_grid_module_pb_type_ports(module_manager, grid_module,
-                                  vpr_device_annotation,
-                                  phy_block_type, border_side);
-    /* Add module nets to connect the pb_type ports to sub modules */
-    for (t_logical_block_type_ptr lb_type : phy_block_type->equivalent_sites) {
-      /* Bypass empty pb_graph */
-      if (nullptr == lb_type->pb_graph_head) {
-        continue;
-      }
-      std::string pb_module_name = generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
-      ModuleId pb_module = module_manager.find_module(pb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-      for (const size_t& child_instance : module_manager.child_module_instances(grid_module, pb_module)) {
-        add_grid_module_nets_connect_pb_type_ports(module_manager, grid_module,
-                                                   pb_module, child_instance,
-                                                   vpr_device_annotation,
-                                                   phy_block_type, border_side);
-      }
+/*****************************************************************************
+ * Add the ports of a physical tile module (or of its core module) by following
+ * the definition in pb_types, and the nets to connect them to the logical tile modules
+ *****************************************************************************/
+static 
+void add_physical_tile_module_pb_type_ports(ModuleManager& module_manager,
+                                            const ModuleId& grid_module,
+                                            const VprDeviceAnnotation& vpr_device_annotation,
+                                            t_physical_tile_type_ptr phy_block_type,
+                                            const e_side& border_side) {
+  add_grid_module_pb_type_ports(module_manager, grid_module,
+                                vpr_device_annotation,
+                                phy_block_type, border_side);
+  /* Add module nets to connect the pb_type ports to sub modules */
+  for (t_logical_block_type_ptr lb_type : phy_block_type->equivalent_sites) {
+    /* Bypass empty pb_graph */
+    if (nullptr == lb_type->pb_graph_head) {
+      continue;
     }
-  } else {
-    VTR_ASSERT_SAFE(true == duplicate_grid_pin);
-    /* Add these ports with duplication */
-    add_grid_module_duplicated_pb_type_ports(module_manager, grid_module,
-                                             vpr_device_annotation,
-                                             phy_block_type, border_side);
-    
-    /* Add module nets to connect the duplicated pb_type ports to sub modules */
-    for (t_logical_block_type_ptr lb_type : phy_block_type->equivalent_sites) {
-      /* Bypass empty pb_graph */
-      if (nullptr == lb_type->pb_graph_head) {
-        continue;
-      }
-      std::string pb_module_name = generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
-      ModuleId pb_module = module_manager.find_module(pb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-      for (const size_t& child_instance : module_manager.child_module_instances(grid_module, pb_module)) {
-        add_grid_module_nets_connect_duplicated_pb_type_ports(module_manager, grid_module,
-                                                              pb_module, child_instance,
-                                                              vpr_device_annotation,
-                                                              phy_block_type, border_side);
-      }
+    std::string pb_module_name = generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
+    ModuleId pb_module = module_manager.find_module(pb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+    for (const size_t& child_instance : module_manager.child_module_instances(grid_module, pb_module)) {
+      add_grid_module_nets_connect_pb_type_ports(module_manager, grid_module,
+                                                 pb_module, child_instance,
+                                                 vpr_device_annotation,
+                                                 phy_block_type, border_side);
     }
   }
+}
 
+/*****************************************************************************
+ * Add the global, GPIO and configuration ports of a physical tile module
+ * (or of its core module) from its child modules, and the configuration bus
+ *****************************************************************************/
+static 
+void add_physical_tile_module_config_ports(ModuleManager& module_manager,
+                                           DecoderLibrary& decoder_lib,
+                                           const ModuleId& grid_module,
+                                           const CircuitLibrary& circuit_lib,
+                                           const e_config_protocol_type& sram_orgz_type,
+                                           const CircuitModelId& sram_model) {
   /* Add global ports to the pb_module:
    * This is a much easier job after adding sub modules (instances), 
    * we just need to find all the global ports from the child modules and build a list of it
@@ -1124,6 +1100,142 @@ void build_physical_tile_module(ModuleManager& module_manager,
     add_module_nets_memory_config_bus(module_manager, decoder_lib, grid_module, 
                                       sram_orgz_type, circuit_lib.design_tech_type(sram_model));
   }
+}
+
+/*****************************************************************************
+ * Build the core module of a type of physical block, which is used when
+ * the pins of grids are duplicated.
+ * The core module includes the logical tile modules, with a single port for each pin
+ * of the physical tile whatever its sides,
+ * and all the grid modules of the physical tile (one for each border side of I/O tiles)
+ * are lightweight wrappers of it, which duplicate the pins of their sides.
+ *****************************************************************************/
+static 
+void build_physical_tile_core_module(ModuleManager& module_manager,
+                                     DecoderLibrary& decoder_lib,
+                                     const VprDeviceAnnotation& vpr_device_annotation,
+                                     const CircuitLibrary& circuit_lib,
+                                     const e_config_protocol_type& sram_orgz_type,
+                                     const CircuitModelId& sram_model,
+                                     t_physical_tile_type_ptr phy_block_type,
+                                     const bool& verbose) {
+  std::string core_module_name = generate_grid_core_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
+                                                                std::string(phy_block_type->name));
+  VTR_LOGV(verbose, 
+           "Building core of physical tile '%s'...",
+           core_module_name.c_str());
+
+  ModuleId core_module = module_manager.add_module(core_module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(core_module));
+
+  add_physical_tile_module_pb_instances(module_manager, core_module,
+                                        circuit_lib, sram_orgz_type, sram_model,
+                                        phy_block_type);
+
+  /* The core module has a single port for each pin, whatever the sides of the pin,
+   * so that it can be shared by the grid modules of all the border sides
+   */
+  add_grid_core_module_pb_type_ports(module_manager, core_module,
+                                     vpr_device_annotation,
+                                     phy_block_type);
+  for (t_logical_block_type_ptr lb_type : phy_block_type->equivalent_sites) {
+    /* Bypass empty pb_graph */
+    if (nullptr == lb_type->pb_graph_head) {
+      continue;
+    }
+    std::string pb_module_name = generate_physical_block_module_name(lb_type->pb_graph_head->pb_type);
+    ModuleId pb_module = module_manager.find_module(pb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+    for (const size_t& child_instance : module_manager.child_module_instances(core_module, pb_module)) {
+      add_grid_core_module_nets_connect_pb_type_ports(module_manager, core_module,
+                                                      pb_module, child_instance,
+                                                      vpr_device_annotation,
+                                                      phy_block_type, lb_type->pb_graph_head);
+    }
+  }
+
+  add_physical_tile_module_config_ports(module_manager, decoder_lib, core_module,
+                                        circuit_lib, sram_orgz_type, sram_model);
+
+  VTR_LOGV(verbose, "Done\n");
+}
+
+/*****************************************************************************
+ * This function will create a Verilog file and print out a Verilog netlist 
+ * for a type of physical block 
+ *
+ * For IO blocks: 
+ * The param 'border_side' is required, which is specify which side of fabric
+ * the I/O block locates at.
+ *
+ * When the pins are duplicated, the module is a wrapper of the core module
+ * of the physical tile (see build_physical_tile_core_module()), which must be built before
+ *****************************************************************************/
+static 
+void build_physical_tile_module(ModuleManager& module_manager,
+                                DecoderLibrary& decoder_lib,
+                                const VprDeviceAnnotation& vpr_device_annotation,
+                                const CircuitLibrary& circuit_lib,
+                                const e_config_protocol_type& sram_orgz_type,
+                                const CircuitModelId& sram_model,
+                                t_physical_tile_type_ptr phy_block_type,
+                                const e_side& border_side,
+                                const bool& duplicate_grid_pin,
+                                const bool& verbose) {
+  /* Create a Module for the top-level physical block, and add to module manager */
+  std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
+                                                                 std::string(phy_block_type->name),
+                                                                 is_io_type(phy_block_type),
+                                                                 border_side);
+  VTR_LOGV(verbose, 
+           "Building physical tile '%s'...",
+           grid_module_name.c_str());
+
+  ModuleId grid_module = module_manager.add_module(grid_module_name); 
+  VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+
+  /* Add grid ports(pins) to the module */
+  if (false == duplicate_grid_pin) {
+    add_physical_tile_module_pb_instances(module_manager, grid_module,
+                                          circuit_lib, sram_orgz_type, sram_model,
+                                          phy_block_type);
+
+    /* Default way to add these ports by following the definition in pb_types */
+    add_physical_tile_module_pb_type_ports(module_manager, grid_module,
+                                           vpr_device_annotation,
+                                           phy_block_type, border_side);
+  } else {
+    VTR_ASSERT_SAFE(true == duplicate_grid_pin);
+    /* Instanciate the core module of the physical tile */
+    std::string core_module_name = generate_grid_core_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
+                                                                  std::string(phy_block_type->name));
+    ModuleId core_module = module_manager.find_module(core_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(core_module));
+
+    module_manager.add_child_module(grid_module, core_module);
+    /* Set an instance name to bind to a block in bitstream generation */
+    module_manager.set_child_instance_name(grid_module, core_module, 0,
+                                           generate_grid_core_instance_name(std::string(GRID_MODULE_NAME_PREFIX), std::string(phy_block_type->name)));
+    if (0 < find_module_num_config_bits(module_manager, core_module,
+                                        circuit_lib, sram_model, 
+                                        sram_orgz_type)) {
+      module_manager.add_configurable_child(grid_module, core_module, 0);
+    }
+
+    /* Add these ports with duplication */
+    add_grid_module_duplicated_pb_type_ports(module_manager, grid_module,
+                                             vpr_device_annotation,
+                                             phy_block_type, border_side);
+    
+    /* Add module nets to connect the duplicated ports to the core module */
+    add_grid_module_nets_connect_duplicated_core_ports(module_manager, grid_module,
+                                                       core_module,
+                                                       vpr_device_annotation,
+                                                       phy_block_type, border_side);
+  }
+
+  add_physical_tile_module_config_ports(module_manager, decoder_lib, grid_module,
+                                        circuit_lib, sram_orgz_type, sram_model);
 
   VTR_LOGV(verbose, "Done\n");
 }
@@ -1139,6 +1251,9 @@ void build_physical_tile_module(ModuleManager& module_manager,
  *   - Only one module for each I/O on each border side (IO_TYPE)
  *   - Only one module for each CLB (FILL_TYPE)
  *   - Only one module for each heterogeneous block
+ *
+ * When 'requested_tiles' is not empty, only the physical tiles with these names,
+ * and the logical tiles which can be placed on them, are built
  ****************************************************************************/
 void build_grid_modules(ModuleManager& module_manager,
                         DecoderLibrary& decoder_lib,
@@ -1149,10 +1264,24 @@ void build_grid_modules(ModuleManager& module_manager,
                         const e_config_protocol_type& sram_orgz_type,
                         const CircuitModelId& sram_model,
                         const bool& duplicate_grid_pin,
+                        const std::set<std::string>& requested_tiles,
                         const bool& verbose) {
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Build grid modules");
 
+  /* When only a part of the physical tiles are requested,
+   * only the logical tiles which can be placed on them are built
+   */
+  std::set<t_logical_block_type_ptr> requested_logical_tiles;
+  for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+    if (0 == requested_tiles.count(std::string(physical_tile.name))) {
+      continue;
+    }
+    for (t_logical_block_type_ptr lb_type : physical_tile.equivalent_sites) {
+      requested_logical_tiles.insert(lb_type);
+    }
+  }
+
   /* Enumerate the types of logical tiles, and build a module for each 
    * Build modules for all the pb_types/pb_graph_nodes
    * use a Depth-First Search Algorithm to print the sub-modules 
@@ -1168,6 +1297,11 @@ void build_grid_modules(ModuleManager& module_manager,
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
+    /* Bypass the logical tiles which are not requested */
+    if ( (false == requested_tiles.empty())
+      && (0 == requested_logical_tiles.count(&logical_tile)) ) {
+      continue;
+    }
     rec_build_logical_tile_modules(module_manager, decoder_lib,
                                    device_annotation,
                                    circuit_lib, mux_lib,
@@ -1186,7 +1320,24 @@ void build_grid_modules(ModuleManager& module_manager,
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
       continue;
-    } else if (true == is_io_type(&physical_tile)) {
+    }
+    /* Bypass the physical tiles which are not requested */
+    if ( (false == requested_tiles.empty())
+      && (0 == requested_tiles.count(std::string(physical_tile.name))) ) {
+      continue;
+    }
+
+    /* With duplicated pins, the grid modules of the physical tile share a core module */
+    if (true == duplicate_grid_pin) {
+      build_physical_tile_core_module(module_manager, decoder_lib,
+                                      device_annotation,
+                                      circuit_lib,
+                                      sram_orgz_type, sram_model,
+                                      &physical_tile,
+                                      verbose);
+    }
+
+    if (true == is_io_type(&physical_tile)) {
       /* Special for I/O block:
        * We will search the grids and see where the I/O blocks are located:
        * - If a I/O block locates on border sides of FPGA fabric:
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <set>
+#include <string>
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 #include "module_manager.h"
@@ -26,6 +28,7 @@ void build_grid_modules(ModuleManager& module_manager,
                         const e_config_protocol_type& sram_orgz_type,
                         const CircuitModelId& sram_model,
                         const bool& duplicate_grid_pin,
+                        const std::set<std::string>& requested_tiles,
                         const bool& verbose);
 
 } /* end namespace openfpga */
@@ -483,10 +483,8 @@ void build_cmos_mux_module_mux2_multiplexing_structure(ModuleManager& module_man
     /* Get the nodes which drive the root_node */
     std::vector<MuxNodeId> input_nodes; 
     for (const auto& edge : mux_graph.node_in_edges(node)) {
-      /* Get the nodes drive the edge */
-      for (const auto& src_node : mux_graph.edge_src_nodes(edge)) {
-        input_nodes.push_back(src_node);
-      }
+      /* Get the node drives the edge */
+      input_nodes.push_back(mux_graph.edge_src_node(edge));
     }
     /* Number of inputs should match the branch_input_size!!! */
     VTR_ASSERT(input_nodes.size() == branch_size);
@@ -546,6 +544,7 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
                                                         const CircuitLibrary& circuit_lib, 
                                                         const ModuleId& mux_module, 
                                                         const CircuitModelId& circuit_model, 
+                                                        const CircuitModelId& branch_circuit_model, 
                                                         const vtr::vector<MuxInputId, ModuleNetId>& mux_module_input_nets, 
                                                         const vtr::vector<MuxOutputId, ModuleNetId>& mux_module_output_nets, 
                                                         const vtr::vector<MuxMemId, ModuleNetId>& mux_module_mem_nets, 
@@ -585,8 +584,10 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
       }
     }
 
-    /* Instanciate the branch module which is a tgate-based module */
-    std::string branch_module_name= generate_mux_branch_subckt_name(circuit_lib, circuit_model, branch_size, mems.size(), MUX_BASIS_MODULE_POSTFIX);
+    /* Instanciate the branch module which is a tgate-based module,
+     * which may be shared with another circuit model
+     */
+    std::string branch_module_name= generate_mux_branch_subckt_name(circuit_lib, branch_circuit_model, branch_size, mems.size(), MUX_BASIS_MODULE_POSTFIX);
     /* Get the moduleId for the submodule */
     ModuleId branch_module_id = module_manager.find_module(branch_module_name);
     /* We must have one */
@@ -647,10 +648,8 @@ void build_cmos_mux_module_tgate_multiplexing_structure(ModuleManager& module_ma
     /* Get the nodes which drive the root_node */
     std::vector<MuxNodeId> input_nodes; 
     for (const auto& edge : mux_graph.node_in_edges(node)) {
-      /* Get the nodes drive the edge */
-      for (const auto& src_node : mux_graph.edge_src_nodes(edge)) {
-        input_nodes.push_back(src_node);
-      }
+      /* Get the node drives the edge */
+      input_nodes.push_back(mux_graph.edge_src_node(edge));
     }
     /* Number of inputs should match the branch_input_size!!! */
     VTR_ASSERT(input_nodes.size() == branch_size);
@@ -1112,6 +1111,7 @@ static
 void build_cmos_mux_module(ModuleManager& module_manager,
                            const CircuitLibrary& circuit_lib, 
                            const CircuitModelId& mux_model, 
+                           const CircuitModelId& branch_model, 
                            const std::string& module_name, 
                            const MuxGraph& mux_graph) {
   /* Get the global ports required by MUX (and any submodules) */
@@ -1268,7 +1268,7 @@ void build_cmos_mux_module(ModuleManager& module_manager,
     build_cmos_mux_module_mux2_multiplexing_structure(module_manager, circuit_lib, mux_module, mux_model, tgate_model, mux_input_nets, mux_output_nets, mux_mem_nets, mux_graph);
   } else {
     VTR_ASSERT(CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(tgate_model));
-    build_cmos_mux_module_tgate_multiplexing_structure(module_manager, circuit_lib, mux_module, mux_model, mux_input_nets, mux_output_nets, mux_mem_nets, mux_mem_inv_nets, mux_graph);
+    build_cmos_mux_module_tgate_multiplexing_structure(module_manager, circuit_lib, mux_module, mux_model, branch_model, mux_input_nets, mux_output_nets, mux_mem_nets, mux_mem_inv_nets, mux_graph);
   }
 
   /* Add global ports to the pb_module:
@@ -1407,6 +1407,7 @@ static
 void build_mux_module(ModuleManager& module_manager,
                       const CircuitLibrary& circuit_lib, 
                       const CircuitModelId& circuit_model, 
+                      const CircuitModelId& branch_model, 
                       const MuxGraph& mux_graph) {
   std::string module_name = generate_mux_subckt_name(circuit_lib, circuit_model, 
                                                      find_mux_num_datapath_inputs(circuit_lib, circuit_model, mux_graph.num_inputs()), 
@@ -1416,7 +1417,7 @@ void build_mux_module(ModuleManager& module_manager,
   switch (circuit_lib.design_tech_type(circuit_model)) {
   case CIRCUIT_MODEL_DESIGN_CMOS:
     /* SRAM-based Multiplexer Verilog module generation */
-    build_cmos_mux_module(module_manager, circuit_lib, circuit_model, module_name, mux_graph);
+    build_cmos_mux_module(module_manager, circuit_lib, circuit_model, branch_model, module_name, mux_graph);
     break;
   case CIRCUIT_MODEL_DESIGN_RRAM:
     /* TODO: RRAM-based Multiplexer Verilog module generation */
@@ -1444,9 +1445,11 @@ void build_mux_modules(ModuleManager& module_manager,
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
     /* Create a mux graph for the branch circuit */
     std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
-    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
+    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes,
+     * named after the circuit model sharing them
+     */
     for (auto branch_mux_graph : branch_mux_graphs) {
-      build_mux_branch_module(module_manager, circuit_lib, mux_circuit_model, 
+      build_mux_branch_module(module_manager, circuit_lib, mux_lib.branch_circuit_model(mux_circuit_model), 
                               branch_mux_graph);
     }
   }
@@ -1456,7 +1459,7 @@ void build_mux_modules(ModuleManager& module_manager,
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
     /* Create MUX circuits */
-    build_mux_module(module_manager, circuit_lib, mux_circuit_model, mux_graph);
+    build_mux_module(module_manager, circuit_lib, mux_circuit_model, mux_lib.branch_circuit_model(mux_circuit_model), mux_graph);
   }
 }
 
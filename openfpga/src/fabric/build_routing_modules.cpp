@@ -5,6 +5,7 @@
  * 1. Connection blocks
  * 2. Switch blocks
  *******************************************************************/
+#include <algorithm>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -15,6 +16,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
@@ -811,7 +813,7 @@ void build_connection_block_module(ModuleManager& module_manager,
                                                                    ModuleManager::MODULE_OUTPUT_PORT);
 
   /* Add the input pins of grids, which are output ports of the connection block */
-  std::vector<enum e_side> cb_ipin_sides = rr_gsb.get_cb_ipin_sides(cb_type);
+  const std::vector<enum e_side>& cb_ipin_sides = rr_gsb.get_cb_ipin_sides(cb_type);
   for (size_t iside = 0; iside < cb_ipin_sides.size(); ++iside) {
     enum e_side cb_ipin_side = cb_ipin_sides[iside];
     for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
@@ -906,6 +908,17 @@ void build_connection_block_module(ModuleManager& module_manager,
 }
 
 
+/********************************************************************
+ * Identify if a routing module should be built:
+ * all the routing modules are built when none is requested
+ *******************************************************************/
+static 
+bool is_routing_module_requested(const std::set<std::string>& requested_modules,
+                                 const std::string& module_name) {
+  return (true == requested_modules.empty())
+      || (0 < requested_modules.count(module_name));
+}
+
 /********************************************************************
  * Iterate over all the connection blocks in a device
  * and build a module for each of them 
@@ -920,6 +933,7 @@ void build_flatten_connection_block_modules(ModuleManager& module_manager,
                                             const e_config_protocol_type& sram_orgz_type,
                                             const CircuitModelId& sram_model,
                                             const t_rr_type& cb_type,
+                                            const std::set<std::string>& requested_modules,
                                             const bool& verbose) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
@@ -934,6 +948,11 @@ void build_flatten_connection_block_modules(ModuleManager& module_manager,
       if (false == rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
+      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+      if (false == is_routing_module_requested(requested_modules,
+                                               generate_connection_block_module_name(cb_type, gsb_coordinate))) {
+        continue;
+      }
       build_connection_block_module(module_manager, 
                                     decoder_lib,
                                     device_annotation,
@@ -955,6 +974,8 @@ void build_flatten_connection_block_modules(ModuleManager& module_manager,
  * Covering:
  * 1. Connection blocks
  * 2. Switch blocks
+ * When 'requested_modules' is not empty, only the routing modules
+ * with these names are built
  *******************************************************************/
 void build_flatten_routing_modules(ModuleManager& module_manager,
                                    DecoderLibrary& decoder_lib,
@@ -964,6 +985,7 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
                                    const CircuitLibrary& circuit_lib,
                                    const e_config_protocol_type& sram_orgz_type,
                                    const CircuitModelId& sram_model,
+                                   const std::set<std::string>& requested_modules,
                                    const bool& verbose) {
 
   vtr::ScopedStartFinishTimer timer("Build routing modules...");
@@ -977,6 +999,11 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
       if (false == rr_gsb.is_sb_exist()) {
         continue;
       }
+      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+      if (false == is_routing_module_requested(requested_modules,
+                                               generate_switch_block_module_name(gsb_coordinate))) {
+        continue;
+      }
       build_switch_block_module(module_manager,
                                 decoder_lib,
                                 device_annotation,
@@ -997,6 +1024,7 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
                                          circuit_lib, 
                                          sram_orgz_type, sram_model, 
                                          CHANX,
+                                         requested_modules,
                                          verbose);
 
   build_flatten_connection_block_modules(module_manager,
@@ -1007,35 +1035,60 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
                                          circuit_lib,
                                          sram_orgz_type, sram_model, 
                                          CHANY,
+                                         requested_modules,
                                          verbose);
 }
 
 /********************************************************************
- * A top-level function of this file
- * Build all the unique modules for global routing architecture of a FPGA fabric
- * This function will use unique module list built in device_rr_gsb,
- * to build only unique modules (in terms of graph connections) of
- * 1. Connection blocks
- * 2. Switch blocks
- *
- * Note: this function SHOULD be called only when 
- * the option compact_routing_hierarchy is turned on!!!
+ * Find the name of a unique routing module, which is indexed in the sequence of
+ * 1. Switch blocks
+ * 2. X-direction connection blocks
+ * 3. Y-direction connection blocks
  *******************************************************************/
-void build_unique_routing_modules(ModuleManager& module_manager,
-                                  DecoderLibrary& decoder_lib,
-                                  const DeviceContext& device_ctx,
-                                  const VprDeviceAnnotation& device_annotation,
-                                  const DeviceRRGSB& device_rr_gsb,
-                                  const CircuitLibrary& circuit_lib,
-                                  const e_config_protocol_type& sram_orgz_type,
-                                  const CircuitModelId& sram_model,
-                                  const bool& verbose) {
+static 
+std::string find_unique_routing_module_name(const DeviceRRGSB& device_rr_gsb,
+                                            const size_t& module_index) {
+  size_t num_sbs = device_rr_gsb.get_num_sb_unique_module();
+  size_t num_cbx = device_rr_gsb.get_num_cb_unique_module(CHANX);
+
+  if (module_index < num_sbs) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(module_index);
+    return generate_switch_block_module_name(vtr::Point<size_t>(unique_mirror.get_sb_x(), unique_mirror.get_sb_y()));
+  }
 
-  vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
+  t_rr_type cb_type = CHANX;
+  size_t cb_index = module_index - num_sbs;
+  if (num_cbx <= cb_index) {
+    cb_type = CHANY;
+    cb_index -= num_cbx;
+  }
+  const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, cb_index);
+  return generate_connection_block_module_name(cb_type, vtr::Point<size_t>(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type)));
+}
+
+/********************************************************************
+ * Build a unique routing module, which is indexed in the sequence of
+ * 1. Switch blocks
+ * 2. X-direction connection blocks
+ * 3. Y-direction connection blocks
+ *******************************************************************/
+static 
+void build_unique_routing_module(ModuleManager& module_manager,
+                                 DecoderLibrary& decoder_lib,
+                                 const DeviceContext& device_ctx,
+                                 const VprDeviceAnnotation& device_annotation,
+                                 const DeviceRRGSB& device_rr_gsb,
+                                 const CircuitLibrary& circuit_lib,
+                                 const e_config_protocol_type& sram_orgz_type,
+                                 const CircuitModelId& sram_model,
+                                 const size_t& module_index,
+                                 const bool& verbose) {
+  size_t num_sbs = device_rr_gsb.get_num_sb_unique_module();
+  size_t num_cbx = device_rr_gsb.get_num_cb_unique_module(CHANX);
 
   /* Build unique switch block modules */
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
+  if (module_index < num_sbs) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(module_index);
     build_switch_block_module(module_manager,
                               decoder_lib,
                               device_annotation,
@@ -1045,12 +1098,12 @@ void build_unique_routing_modules(ModuleManager& module_manager,
                               sram_orgz_type, sram_model, 
                               unique_mirror,
                               verbose);
+    return;
   }
 
   /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
+  if (module_index < num_sbs + num_cbx) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, module_index - num_sbs);
     build_connection_block_module(module_manager, 
                                   decoder_lib,
                                   device_annotation,
@@ -1060,21 +1113,156 @@ void build_unique_routing_modules(ModuleManager& module_manager,
                                   sram_orgz_type, sram_model, 
                                   unique_mirror, CHANX,
                                   verbose);
+    return;
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
+  /* Build unique Y-direction connection block modules */
+  const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, module_index - num_sbs - num_cbx);
+  build_connection_block_module(module_manager, 
+                                decoder_lib,
+                                device_annotation,
+                                device_ctx.grid,
+                                device_ctx.rr_graph,
+                                circuit_lib, 
+                                sram_orgz_type, sram_model, 
+                                unique_mirror, CHANY,
+                                verbose);
+}
 
-    build_connection_block_module(module_manager, 
-                                  decoder_lib,
-                                  device_annotation,
-                                  device_ctx.grid,
-                                  device_ctx.rr_graph,
-                                  circuit_lib, 
-                                  sram_orgz_type, sram_model, 
-                                  unique_mirror, CHANY,
-                                  verbose);
+/********************************************************************
+ * A top-level function of this file
+ * Build all the unique modules for global routing architecture of a FPGA fabric
+ * This function will use unique module list built in device_rr_gsb,
+ * to build only unique modules (in terms of graph connections) of
+ * 1. Connection blocks
+ * 2. Switch blocks
+ *
+ * The unique routing modules only depend on the modules built before,
+ * e.g., multiplexers and memories, but not on each other.
+ * When multiple threads are used, the routing modules are split into
+ * contiguous ranges, each of which is built by a thread in a private copy
+ * of the module manager and decoder library. 
+ * The new modules and decoders are then merged in the sequence of routing modules,
+ * so that the module graph is the same as the one built by a single thread
+ *
+ * When 'requested_modules' is not empty, only the unique routing modules
+ * with these names are built
+ *
+ * Note: this function SHOULD be called only when 
+ * the option compact_routing_hierarchy is turned on!!!
+ *******************************************************************/
+void build_unique_routing_modules(ModuleManager& module_manager,
+                                  DecoderLibrary& decoder_lib,
+                                  const DeviceContext& device_ctx,
+                                  const VprDeviceAnnotation& device_annotation,
+                                  const DeviceRRGSB& device_rr_gsb,
+                                  const CircuitLibrary& circuit_lib,
+                                  const e_config_protocol_type& sram_orgz_type,
+                                  const CircuitModelId& sram_model,
+                                  const std::set<std::string>& requested_modules,
+                                  const size_t& num_threads,
+                                  const bool& verbose) {
+
+  vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
+
+  /* Collect the indices of the unique routing modules to build */
+  std::vector<size_t> routing_modules;
+  size_t num_unique_modules = device_rr_gsb.get_num_sb_unique_module()
+                            + device_rr_gsb.get_num_cb_unique_module(CHANX)
+                            + device_rr_gsb.get_num_cb_unique_module(CHANY);
+  for (size_t imodule = 0; imodule < num_unique_modules; ++imodule) {
+    if (false == is_routing_module_requested(requested_modules,
+                                             find_unique_routing_module_name(device_rr_gsb, imodule))) {
+      continue;
+    }
+    routing_modules.push_back(imodule);
+  }
+  size_t num_routing_modules = routing_modules.size();
+
+  size_t num_shards = std::min(find_num_threads(num_threads), num_routing_modules);
+  if (num_shards <= 1) {
+    for (size_t imodule = 0; imodule < num_routing_modules; ++imodule) {
+      build_unique_routing_module(module_manager, decoder_lib,
+                                  device_ctx, device_annotation, device_rr_gsb, circuit_lib,
+                                  sram_orgz_type, sram_model,
+                                  routing_modules[imodule], verbose);
+    }
+    return;
+  }
+
+  /* Build the routing modules in private copies.
+   * Record the new modules and decoders created by each routing module
+   * Verbose outputs are reported during merging, to avoid interleaving messages from threads
+   */
+  size_t num_base_modules = module_manager.num_modules();
+  size_t num_base_decoders = decoder_lib.decoders().size();
+  std::vector<ModuleManager> shard_module_managers(num_shards);
+  std::vector<DecoderLibrary> shard_decoder_libs(num_shards);
+  std::vector<size_t> first_new_modules(num_routing_modules);
+  std::vector<size_t> first_new_decoders(num_routing_modules);
+
+  parallel_for(num_shards, num_shards, [&](const size_t& ishard) {
+    shard_module_managers[ishard] = module_manager;
+    shard_decoder_libs[ishard] = decoder_lib;
+    for (size_t imodule = ishard * num_routing_modules / num_shards;
+         imodule < (ishard + 1) * num_routing_modules / num_shards;
+         ++imodule) {
+      first_new_modules[imodule] = shard_module_managers[ishard].num_modules();
+      first_new_decoders[imodule] = shard_decoder_libs[ishard].decoders().size();
+      build_unique_routing_module(shard_module_managers[ishard], shard_decoder_libs[ishard],
+                                  device_ctx, device_annotation, device_rr_gsb, circuit_lib,
+                                  sram_orgz_type, sram_model,
+                                  routing_modules[imodule], false);
+    }
+  });
+
+  /* Merge the shards in the sequence of routing modules */
+  for (size_t ishard = 0; ishard < num_shards; ++ishard) {
+    const ModuleManager& shard_module_manager = shard_module_managers[ishard];
+    const DecoderLibrary& shard_decoder_lib = shard_decoder_libs[ishard];
+
+    /* The modules built before are the same in all the shards */
+    vtr::vector<ModuleId, ModuleId> module_map(num_base_modules);
+    for (size_t imodule = 0; imodule < num_base_modules; ++imodule) {
+      module_map[ModuleId(imodule)] = ModuleId(imodule);
+    }
+
+    size_t begin = ishard * num_routing_modules / num_shards;
+    size_t end = (ishard + 1) * num_routing_modules / num_shards;
+    for (size_t imodule = begin; imodule < end; ++imodule) {
+      /* New modules and decoders of a routing module end where the next routing module begins */
+      size_t last_new_module = (imodule + 1 == end) ? shard_module_manager.num_modules() : first_new_modules[imodule + 1];
+      size_t last_new_decoder = (imodule + 1 == end) ? shard_decoder_lib.decoders().size() : first_new_decoders[imodule + 1];
+
+      for (size_t idecoder = first_new_decoders[imodule]; idecoder < last_new_decoder; ++idecoder) {
+        VTR_ASSERT(num_base_decoders <= idecoder);
+        DecoderId shard_decoder = DecoderId(idecoder);
+        DecoderId decoder = decoder_lib.find_decoder(shard_decoder_lib.addr_size(shard_decoder),
+                                                     shard_decoder_lib.data_size(shard_decoder),
+                                                     shard_decoder_lib.use_enable(shard_decoder),
+                                                     shard_decoder_lib.use_data_in(shard_decoder),
+                                                     shard_decoder_lib.use_data_inv_port(shard_decoder));
+        if (DecoderId::INVALID() == decoder) {
+          decoder_lib.add_decoder(shard_decoder_lib.addr_size(shard_decoder),
+                                  shard_decoder_lib.data_size(shard_decoder),
+                                  shard_decoder_lib.use_enable(shard_decoder),
+                                  shard_decoder_lib.use_data_in(shard_decoder),
+                                  shard_decoder_lib.use_data_inv_port(shard_decoder));
+        }
+      }
+
+      std::vector<ModuleId> new_modules;
+      for (size_t ishard_module = first_new_modules[imodule]; ishard_module < last_new_module; ++ishard_module) {
+        new_modules.push_back(ModuleId(ishard_module));
+      }
+      module_manager.add_modules_from(shard_module_manager, new_modules, module_map);
+
+      for (const ModuleId& new_module : new_modules) {
+        VTR_LOGV(verbose,
+                 "Built module '%s'\n",
+                 shard_module_manager.module_name(new_module).c_str());
+      }
+    }
   }
 }
 
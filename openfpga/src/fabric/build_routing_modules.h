@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <set>
+#include <string>
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 #include "device_rr_gsb.h"
@@ -27,6 +29,7 @@ void build_flatten_routing_modules(ModuleManager& module_manager,
                                    const CircuitLibrary& circuit_lib,
                                    const e_config_protocol_type& sram_orgz_type,
                                    const CircuitModelId& sram_model,
+                                   const std::set<std::string>& requested_modules,
                                    const bool& verbose);
 
 void build_unique_routing_modules(ModuleManager& module_manager,
@@ -37,6 +40,8 @@ void build_unique_routing_modules(ModuleManager& module_manager,
                                   const CircuitLibrary& circuit_lib,
                                   const e_config_protocol_type& sram_orgz_type,
                                   const CircuitModelId& sram_model,
+                                  const std::set<std::string>& requested_modules,
+                                  const size_t& num_threads,
                                   const bool& verbose); 
 
 } /* end namespace openfpga */
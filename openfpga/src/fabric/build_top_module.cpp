@@ -50,11 +50,11 @@ size_t add_top_module_grid_instance(ModuleManager& module_manager,
   size_t grid_instance = module_manager.num_instance(top_module, grid_module);
   /* Add the module to top_module */ 
   module_manager.add_child_module(top_module, grid_module);
-  /* Set an unique name to the instance
+  /* Set an unique name to the instance, which is the same as generate_grid_block_instance_name()
+   * The name is derived from the module name and coordinate on demand, not stored for each instance
    * Note: it is your risk to gurantee the name is unique!
    */
-  std::string instance_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side, grid_coord);
-  module_manager.set_child_instance_name(top_module, grid_module, grid_instance, instance_name);
+  module_manager.set_child_instance_coordinate_name(top_module, grid_module, grid_instance, grid_module_name, grid_coord);
 
   return grid_instance;
 }
@@ -204,9 +204,10 @@ vtr::Matrix<size_t> add_top_module_switch_block_instances(ModuleManager& module_
       /* Set an unique name to the instance
        * Note: it is your risk to gurantee the name is unique!
        */
-      module_manager.set_child_instance_name(top_module, sb_module, 
-                                             sb_instance_ids[rr_gsb.get_sb_x()][rr_gsb.get_sb_y()],
-                                             generate_switch_block_module_name(vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y())));
+      module_manager.set_child_instance_coordinate_name(top_module, sb_module, 
+                                                        sb_instance_ids[rr_gsb.get_sb_x()][rr_gsb.get_sb_y()],
+                                                        generate_switch_block_module_prefix(),
+                                                        vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y()));
     }
   }
 
@@ -260,10 +261,10 @@ vtr::Matrix<size_t> add_top_module_connection_block_instances(ModuleManager& mod
       /* Set an unique name to the instance
        * Note: it is your risk to gurantee the name is unique!
        */
-      std::string cb_instance_name = generate_connection_block_module_name(cb_type, vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type)));
-      module_manager.set_child_instance_name(top_module, cb_module, 
-                                             cb_instance_ids[rr_gsb.get_cb_x(cb_type)][rr_gsb.get_cb_y(cb_type)],
-                                             cb_instance_name); 
+      module_manager.set_child_instance_coordinate_name(top_module, cb_module, 
+                                                        cb_instance_ids[rr_gsb.get_cb_x(cb_type)][rr_gsb.get_cb_y(cb_type)],
+                                                        generate_connection_block_module_prefix(cb_type),
+                                                        vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type))); 
     }
   }
 
@@ -297,7 +298,9 @@ int build_top_module(ModuleManager& module_manager,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
                      const FabricKey& fabric_key,
-                     const bool& generate_random_fabric_key) {
+                     const bool& generate_random_fabric_key,
+                     const bool& balance_config_regions,
+                     const size_t& num_threads) {
 
   vtr::ScopedStartFinishTimer timer("Build FPGA fabric module");
 
@@ -333,7 +336,8 @@ int build_top_module(ModuleManager& module_manager,
                                                vpr_device_annotation, 
                                                grids, grid_instance_ids, 
                                                rr_graph, device_rr_gsb, sb_instance_ids, cb_instance_ids,
-                                               compact_routing_hierarchy, duplicate_grid_pin);
+                                               compact_routing_hierarchy, duplicate_grid_pin,
+                                               num_threads);
     /* Add inter-CLB direct connections */
     add_top_module_nets_tile_direct_connections(module_manager, top_module, circuit_lib, 
                                                 vpr_device_annotation,
@@ -368,7 +372,8 @@ int build_top_module(ModuleManager& module_manager,
                                        circuit_lib, config_protocol, sram_model,
                                        grids, grid_instance_ids, 
                                        device_rr_gsb, sb_instance_ids, cb_instance_ids,
-                                       compact_routing_hierarchy);
+                                       compact_routing_hierarchy,
+                                       balance_config_regions);
   } else {
     VTR_ASSERT_SAFE(false == fabric_key.empty());
     /* Throw a fatal error when the fabric key has a mismatch in region organization.
@@ -391,7 +396,7 @@ int build_top_module(ModuleManager& module_manager,
 
   /* Shuffle the configurable children in a random sequence */
   if (true == generate_random_fabric_key) {
-    shuffle_top_module_configurable_children(module_manager, top_module, config_protocol);
+    shuffle_top_module_configurable_children(module_manager, top_module, circuit_lib, sram_model, config_protocol, balance_config_regions);
   }
 
   /* Add shared SRAM ports from the sub-modules under this Verilog module
@@ -43,7 +43,9 @@ int build_top_module(ModuleManager& module_manager,
                      const bool& compact_routing_hierarchy,
                      const bool& duplicate_grid_pin,
                      const FabricKey& fabric_key,
-                     const bool& generate_random_fabric_key);
+                     const bool& generate_random_fabric_key,
+                     const bool& balance_config_regions,
+                     const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -2,6 +2,9 @@
  * This file include most utilized functions for building connections 
  * inside the module graph for FPGA fabric
  *******************************************************************/
+#include <array>
+#include <map>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -11,6 +14,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -30,6 +34,373 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The ports of the grid, switch block and connection block modules
+ * which are connected to each other in the top-level module.
+ * The port of each pin is resolved once for each unique module,
+ * and shared by all its instances, rather than finding the port
+ * by its name for each pin of each instance
+ *******************************************************************/
+struct t_top_module_port_pins {
+  ModulePortId port = ModulePortId::INVALID();
+  size_t lsb = 0;
+  size_t width = 0;
+};
+
+/* Ports of a grid module
+ *  - ports: the port of each pin of the tile at each side
+ *           [pin_side][tile_pin]
+ *  - duplicated_ports: the port of each pin when the grid pins are duplicated,
+ *                      [use_upper_postfix][pin_side][tile_pin]
+ */
+struct t_top_module_grid_ports {
+  t_physical_tile_type_ptr grid_type = nullptr;
+  std::vector<std::vector<t_top_module_port_pins>> ports;
+  std::array<std::vector<std::vector<t_top_module_port_pins>>, 2> duplicated_ports;
+};
+
+/* Ports of a switch block or a connection block module, 
+ * which are resolved from the GSB of the unique module
+ *  - grid_ports: the ports connected to grid pins 
+ *                [side][opin_node] for a switch block
+ *                [index of the side in get_cb_ipin_sides()][ipin_node] for a connection block
+ *  - track_ports: the port of each routing track of a switch block, [side][track]
+ *  - cb_track_ports: the routing track ports of a connection block, [is_output][use_upper_port]
+ */
+struct t_top_module_routing_ports {
+  vtr::Point<size_t> module_gsb_coordinate;
+  t_rr_type cb_type = NUM_RR_TYPES;
+  std::vector<std::vector<t_top_module_port_pins>> grid_ports;
+  std::vector<std::vector<t_top_module_port_pins>> track_ports;
+  std::array<std::array<t_top_module_port_pins, 2>, 2> cb_track_ports;
+};
+
+/* The modules placed at each coordinate and their ports
+ *  - grid_modules: the module of each grid, [x][y]
+ *  - sb_modules: the switch block module of each GSB, [x][y],
+ *                which is invalid if the switch block does not exist
+ *  - cb_modules: the connection block module of each GSB, [cb_type][x][y],
+ *                which is invalid if the connection block does not exist
+ */
+struct t_top_module_gsb_port_lookup {
+  vtr::Matrix<ModuleId> grid_modules;
+  vtr::Matrix<ModuleId> sb_modules;
+  std::map<t_rr_type, vtr::Matrix<ModuleId>> cb_modules;
+  std::map<ModuleId, t_top_module_grid_ports> grid_ports;
+  std::map<ModuleId, t_top_module_routing_ports> sb_ports;
+  std::map<ModuleId, t_top_module_routing_ports> cb_ports;
+};
+
+/********************************************************************
+ * A connection between the ports of two instances in the top-level module,
+ * for which a net is created for each pin
+ *******************************************************************/
+struct t_top_module_port_connection {
+  ModuleId src_module;
+  size_t src_instance;
+  ModulePortId src_port;
+  size_t src_pin;
+  ModuleId sink_module;
+  size_t sink_instance;
+  ModulePortId sink_port;
+  size_t sink_pin;
+  size_t num_pins;
+};
+
+/********************************************************************
+ * Find a port of a module by its name, 
+ * which is invalid if the module does not have such a port
+ *******************************************************************/
+static 
+t_top_module_port_pins find_top_module_port_pins(const ModuleManager& module_manager,
+                                                 const ModuleId& module,
+                                                 const std::string& port_name) {
+  t_top_module_port_pins port_pins;
+  port_pins.port = module_manager.find_module_port(module, port_name);
+  if (true == module_manager.valid_module_port_id(module, port_pins.port)) {
+    BasicPort port = module_manager.module_port(module, port_pins.port);
+    port_pins.lsb = port.get_lsb();
+    port_pins.width = port.get_width();
+  }
+  return port_pins;
+}
+
+/********************************************************************
+ * Resolve the port of each pin of a grid module at each side
+ * Pins which are not located on a side are left invalid
+ *******************************************************************/
+static 
+void build_top_module_grid_ports(t_top_module_grid_ports& grid_ports,
+                                 const ModuleManager& module_manager,
+                                 const VprDeviceAnnotation& vpr_device_annotation,
+                                 const ModuleId& grid_module,
+                                 const bool& duplicate_grid_pin) {
+  t_physical_tile_type_ptr grid_type = grid_ports.grid_type;
+  std::vector<std::vector<t_top_module_port_pins>> empty_ports(NUM_SIDES, std::vector<t_top_module_port_pins>(grid_type->num_pins));
+  grid_ports.ports = empty_ports;
+  if (true == duplicate_grid_pin) {
+    grid_ports.duplicated_ports[0] = empty_ports;
+    grid_ports.duplicated_ports[1] = empty_ports;
+  }
+
+  for (int ipin = 0; ipin < grid_type->num_pins; ++ipin) {
+    BasicPort pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type, ipin);
+    int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type, ipin);
+    if ((false == pin_info.is_valid()) || (OPEN == subtile_index)) {
+      continue;
+    }
+    size_t pin_width = grid_type->pin_width_offset[ipin];
+    size_t pin_height = grid_type->pin_height_offset[ipin];
+    for (size_t side = 0; side < NUM_SIDES; ++side) {
+      SideManager side_manager(side);
+      if (true != grid_type->pinloc[pin_width][pin_height][side][ipin]) {
+        continue;
+      }
+      std::string port_name = generate_grid_port_name(pin_width, pin_height, subtile_index,
+                                                      side_manager.get_side(), pin_info);
+      grid_ports.ports[side][ipin] = find_top_module_port_pins(module_manager, grid_module, port_name);
+
+      if (false == duplicate_grid_pin) {
+        continue;
+      }
+      /* Pins for direct connection are NOT duplicated.
+       * Xifan: I assume that each direct connection pin must have Fc=0. 
+       */
+      if (0. == find_physical_tile_pin_Fc(grid_type, ipin)) {
+        grid_ports.duplicated_ports[0][side][ipin] = grid_ports.ports[side][ipin];
+        grid_ports.duplicated_ports[1][side][ipin] = grid_ports.ports[side][ipin];
+        continue;
+      }
+      for (size_t upper = 0; upper < 2; ++upper) {
+        std::string duplicated_port_name = generate_grid_duplicated_port_name(pin_width, pin_height, subtile_index,
+                                                                              side_manager.get_side(), pin_info,
+                                                                              1 == upper);
+        grid_ports.duplicated_ports[upper][side][ipin] = find_top_module_port_pins(module_manager, grid_module, duplicated_port_name);
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Resolve the ports of a switch block module which are connected to
+ * the grid output pins and to the routing tracks
+ *******************************************************************/
+static 
+void build_top_module_sb_ports(t_top_module_routing_ports& sb_ports,
+                               const ModuleManager& module_manager,
+                               const VprDeviceAnnotation& vpr_device_annotation,
+                               const DeviceGrid& grids,
+                               const RRGraph& rr_graph,
+                               const DeviceRRGSB& device_rr_gsb,
+                               const ModuleId& sb_module) {
+  const RRGSB& module_sb = device_rr_gsb.get_gsb(sb_ports.module_gsb_coordinate);
+  sb_ports.grid_ports.resize(module_sb.get_num_sides());
+  sb_ports.track_ports.resize(module_sb.get_num_sides());
+
+  for (size_t side = 0; side < module_sb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t inode = 0; inode < module_sb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
+      RRNodeId opin_node = module_sb.get_opin_node(side_manager.get_side(), inode);
+      std::string port_name = generate_sb_module_grid_port_name(side_manager.get_side(),
+                                                                rr_graph.node_side(opin_node),
+                                                                grids,
+                                                                vpr_device_annotation,
+                                                                rr_graph,
+                                                                opin_node); 
+      sb_ports.grid_ports[side].push_back(find_top_module_port_pins(module_manager, sb_module, port_name));
+    }
+    for (size_t itrack = 0; itrack < module_sb.get_chan_width(side_manager.get_side()); ++itrack) {
+      std::string port_name = generate_sb_module_track_port_name(rr_graph.node_type(module_sb.get_chan_node(side_manager.get_side(), itrack)),
+                                                                 side_manager.get_side(), 
+                                                                 module_sb.get_chan_node_direction(side_manager.get_side(), itrack));
+      sb_ports.track_ports[side].push_back(find_top_module_port_pins(module_manager, sb_module, port_name));
+    }
+  }
+}
+
+/********************************************************************
+ * Resolve the ports of a connection block module which are connected to
+ * the grid input pins and to the routing tracks
+ *******************************************************************/
+static 
+void build_top_module_cb_ports(t_top_module_routing_ports& cb_ports,
+                               const ModuleManager& module_manager,
+                               const VprDeviceAnnotation& vpr_device_annotation,
+                               const DeviceGrid& grids,
+                               const RRGraph& rr_graph,
+                               const DeviceRRGSB& device_rr_gsb,
+                               const ModuleId& cb_module) {
+  const RRGSB& module_cb = device_rr_gsb.get_gsb(cb_ports.module_gsb_coordinate);
+  const std::vector<enum e_side>& cb_ipin_sides = module_cb.get_cb_ipin_sides(cb_ports.cb_type);
+  cb_ports.grid_ports.resize(cb_ipin_sides.size());
+
+  for (size_t iside = 0; iside < cb_ipin_sides.size(); ++iside) {
+    enum e_side cb_ipin_side = cb_ipin_sides[iside];
+    for (size_t inode = 0; inode < module_cb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
+      std::string port_name = generate_cb_module_grid_port_name(cb_ipin_side,
+                                                                grids,
+                                                                vpr_device_annotation,
+                                                                rr_graph,
+                                                                module_cb.get_ipin_node(cb_ipin_side, inode)); 
+      cb_ports.grid_ports[iside].push_back(find_top_module_port_pins(module_manager, cb_module, port_name));
+    }
+  }
+
+  for (size_t is_output = 0; is_output < 2; ++is_output) {
+    for (size_t use_upper_port = 0; use_upper_port < 2; ++use_upper_port) {
+      std::string port_name = generate_cb_module_track_port_name(cb_ports.cb_type,
+                                                                 (1 == is_output) ? OUT_PORT : IN_PORT,
+                                                                 1 == use_upper_port);
+      cb_ports.cb_track_ports[is_output][use_upper_port] = find_top_module_port_pins(module_manager, cb_module, port_name);
+    }
+  }
+}
+
+/********************************************************************
+ * Find the modules of the grids and GSBs in the top-level module,
+ * and resolve the ports of each unique module
+ * The unique modules are collected in the order of coordinates,
+ * and their ports are then resolved in parallel
+ *******************************************************************/
+static 
+t_top_module_gsb_port_lookup build_top_module_gsb_port_lookup(const ModuleManager& module_manager,
+                                                              const VprDeviceAnnotation& vpr_device_annotation,
+                                                              const DeviceGrid& grids,
+                                                              const RRGraph& rr_graph,
+                                                              const DeviceRRGSB& device_rr_gsb,
+                                                              const bool& compact_routing_hierarchy,
+                                                              const bool& duplicate_grid_pin,
+                                                              const size_t& num_threads) {
+  t_top_module_gsb_port_lookup lookup;
+
+  /* Find the module of each grid */
+  lookup.grid_modules.resize({grids.width(), grids.height()}, ModuleId::INVALID());
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      t_physical_tile_type_ptr grid_type = grids[ix][iy].type;
+      if (true == is_empty_type(grid_type)) {
+        continue;
+      }
+      vtr::Point<size_t> grid_coordinate(ix, iy);
+      std::string grid_module_name = generate_grid_block_module_name_in_top_module(std::string(GRID_MODULE_NAME_PREFIX), grids, grid_coordinate); 
+      ModuleId grid_module = module_manager.find_module(grid_module_name);
+      if (false == module_manager.valid_module_id(grid_module)) {
+        continue;
+      }
+      lookup.grid_modules[ix][iy] = grid_module;
+      lookup.grid_ports[grid_module].grid_type = grid_type;
+    }
+  }
+
+  /* Find the switch block and connection block modules of each GSB
+   * If we use compact routing hierarchy, we should find the unique module, which is added to the top module
+   */
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  lookup.sb_modules.resize({gsb_range.x(), gsb_range.y()}, ModuleId::INVALID());
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    lookup.cb_modules[cb_type].resize({gsb_range.x(), gsb_range.y()}, ModuleId::INVALID());
+  }
+  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      vtr::Point<size_t> gsb_coordinate(ix, iy);
+      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coordinate);
+
+      if (true == rr_gsb.is_sb_exist()) {
+        vtr::Point<size_t> module_gsb_coordinate = gsb_coordinate;
+        if (true == compact_routing_hierarchy) {
+          const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(gsb_coordinate);
+          module_gsb_coordinate = vtr::Point<size_t>(unique_mirror.get_x(), unique_mirror.get_y());
+        }
+        const RRGSB& module_sb = device_rr_gsb.get_gsb(module_gsb_coordinate);
+        vtr::Point<size_t> module_sb_coordinate(module_sb.get_sb_x(), module_sb.get_sb_y());
+        ModuleId sb_module = module_manager.find_module(generate_switch_block_module_name(module_sb_coordinate));
+        VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+        lookup.sb_modules[ix][iy] = sb_module;
+        lookup.sb_ports[sb_module].module_gsb_coordinate = module_gsb_coordinate;
+      }
+
+      for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+        if (false == rr_gsb.is_cb_exist(cb_type)) {
+          continue;
+        }
+        vtr::Point<size_t> module_gsb_coordinate = gsb_coordinate;
+        if (true == compact_routing_hierarchy) {
+          const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, gsb_coordinate);
+          module_gsb_coordinate = vtr::Point<size_t>(unique_mirror.get_x(), unique_mirror.get_y());
+        }
+        const RRGSB& module_cb = device_rr_gsb.get_gsb(module_gsb_coordinate);
+        vtr::Point<size_t> module_cb_coordinate(module_cb.get_cb_x(cb_type), module_cb.get_cb_y(cb_type));
+        ModuleId cb_module = module_manager.find_module(generate_connection_block_module_name(cb_type, module_cb_coordinate));
+        VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+        lookup.cb_modules[cb_type][ix][iy] = cb_module;
+        t_top_module_routing_ports& cb_ports = lookup.cb_ports[cb_module];
+        cb_ports.module_gsb_coordinate = module_gsb_coordinate;
+        cb_ports.cb_type = cb_type;
+      }
+    }
+  }
+
+  /* Resolve the ports of the unique modules in parallel, 
+   * each of which only writes its own entry in the lookup
+   */
+  std::vector<std::pair<const ModuleId, t_top_module_grid_ports>*> grid_items;
+  for (auto& grid_item : lookup.grid_ports) {
+    grid_items.push_back(&grid_item);
+  }
+  parallel_for(grid_items.size(), num_threads, [&](const size_t& iitem) {
+    build_top_module_grid_ports(grid_items[iitem]->second, module_manager, vpr_device_annotation,
+                                grid_items[iitem]->first, duplicate_grid_pin);
+  });
+
+  std::vector<std::pair<const ModuleId, t_top_module_routing_ports>*> sb_items;
+  for (auto& sb_item : lookup.sb_ports) {
+    sb_items.push_back(&sb_item);
+  }
+  parallel_for(sb_items.size(), num_threads, [&](const size_t& iitem) {
+    build_top_module_sb_ports(sb_items[iitem]->second, module_manager, vpr_device_annotation,
+                              grids, rr_graph, device_rr_gsb, sb_items[iitem]->first);
+  });
+
+  std::vector<std::pair<const ModuleId, t_top_module_routing_ports>*> cb_items;
+  for (auto& cb_item : lookup.cb_ports) {
+    cb_items.push_back(&cb_item);
+  }
+  parallel_for(cb_items.size(), num_threads, [&](const size_t& iitem) {
+    build_top_module_cb_ports(cb_items[iitem]->second, module_manager, vpr_device_annotation,
+                              grids, rr_graph, device_rr_gsb, cb_items[iitem]->first);
+  });
+
+  return lookup;
+}
+
+/********************************************************************
+ * Record a connection between the pins of two instances in the top-level module
+ *******************************************************************/
+static 
+void add_top_module_port_connection(std::vector<t_top_module_port_connection>& connections,
+                                    const ModuleId& src_module, const size_t& src_instance,
+                                    const t_top_module_port_pins& src_port, const size_t& src_pin,
+                                    const ModuleId& sink_module, const size_t& sink_instance,
+                                    const t_top_module_port_pins& sink_port, const size_t& sink_pin,
+                                    const size_t& num_pins) {
+  VTR_ASSERT(ModulePortId::INVALID() != src_port.port);
+  VTR_ASSERT(ModulePortId::INVALID() != sink_port.port);
+  VTR_ASSERT((src_port.lsb <= src_pin) && (src_pin + num_pins <= src_port.lsb + src_port.width));
+  VTR_ASSERT((sink_port.lsb <= sink_pin) && (sink_pin + num_pins <= sink_port.lsb + sink_port.width));
+
+  t_top_module_port_connection connection;
+  connection.src_module = src_module;
+  connection.src_instance = src_instance;
+  connection.src_port = src_port.port;
+  connection.src_pin = src_pin;
+  connection.sink_module = sink_module;
+  connection.sink_instance = sink_instance;
+  connection.sink_port = sink_port.port;
+  connection.sink_pin = sink_pin;
+  connection.num_pins = num_pins;
+  connections.push_back(connection);
+}
+
 /********************************************************************
  * Add module nets to connect a GSB to adjacent grid ports/pins 
  * as well as connection blocks
@@ -59,111 +430,8 @@ namespace openfpga {
  *    |   [x][y]   |                |  [x+1][y]  |
  *    |            |                |            |
  *    +------------+                +------------+
-
  *
- *******************************************************************/
-static 
-void add_top_module_nets_connect_grids_and_sb(ModuleManager& module_manager, 
-                                              const ModuleId& top_module, 
-                                              const VprDeviceAnnotation& vpr_device_annotation,
-                                              const DeviceGrid& grids,
-                                              const vtr::Matrix<size_t>& grid_instance_ids,
-                                              const RRGraph& rr_graph,
-                                              const DeviceRRGSB& device_rr_gsb,
-                                              const RRGSB& rr_gsb, 
-                                              const vtr::Matrix<size_t>& sb_instance_ids,
-                                              const bool& compact_routing_hierarchy) {
-
-  /* Skip those Switch blocks that do not exist */
-  if (false == rr_gsb.is_sb_exist()) {
-    return;
-  }
-
-  /* We could have two different coordinators, one is the instance, the other is the module */
-  vtr::Point<size_t> instance_sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-  vtr::Point<size_t> module_gsb_coordinate(rr_gsb.get_x(), rr_gsb.get_y());
-
-  /* If we use compact routing hierarchy, we should find the unique module of CB, which is added to the top module */
-  if (true == compact_routing_hierarchy) {
-    vtr::Point<size_t> gsb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(gsb_coord);
-    module_gsb_coordinate.set_x(unique_mirror.get_x()); 
-    module_gsb_coordinate.set_y(unique_mirror.get_y()); 
-  } 
-
-  /* This is the source cb that is added to the top module */
-  const RRGSB& module_sb = device_rr_gsb.get_gsb(module_gsb_coordinate);
-  vtr::Point<size_t> module_sb_coordinate(module_sb.get_sb_x(), module_sb.get_sb_y());
-
-  /* Collect sink-related information */
-  std::string sink_sb_module_name = generate_switch_block_module_name(module_sb_coordinate);
-  ModuleId sink_sb_module = module_manager.find_module(sink_sb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(sink_sb_module));
-  size_t sink_sb_instance = sb_instance_ids[instance_sb_coordinate.x()][instance_sb_coordinate.y()];
-
-  /* Connect grid output pins (OPIN) to switch block grid pins */
-  for (size_t side = 0; side < module_sb.get_num_sides(); ++side) {
-    SideManager side_manager(side);
-    for (size_t inode = 0; inode < module_sb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
-      /* Collect source-related information */
-      /* Generate the grid module name by considering if it locates on the border */
-      vtr::Point<size_t> grid_coordinate(rr_graph.node_xlow(rr_gsb.get_opin_node(side_manager.get_side(), inode)), 
-                                         rr_graph.node_ylow(rr_gsb.get_opin_node(side_manager.get_side(), inode)));
-      std::string src_grid_module_name = generate_grid_block_module_name_in_top_module(std::string(GRID_MODULE_NAME_PREFIX), grids, grid_coordinate); 
-      ModuleId src_grid_module = module_manager.find_module(src_grid_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(src_grid_module));
-      size_t src_grid_instance = grid_instance_ids[grid_coordinate.x()][grid_coordinate.y()];
-      size_t src_grid_pin_index = rr_graph.node_pin_num(rr_gsb.get_opin_node(side_manager.get_side(), inode));
-
-      t_physical_tile_type_ptr grid_type_descriptor = grids[grid_coordinate.x()][grid_coordinate.y()].type;
-      size_t src_grid_pin_width = grid_type_descriptor->pin_width_offset[src_grid_pin_index];
-      size_t src_grid_pin_height = grid_type_descriptor->pin_height_offset[src_grid_pin_index];
-      BasicPort src_grid_pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type_descriptor, src_grid_pin_index);
-      VTR_ASSERT(true == src_grid_pin_info.is_valid());
-      int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type_descriptor, src_grid_pin_index);
-      VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type_descriptor->capacity);
-      std::string src_grid_port_name = generate_grid_port_name(src_grid_pin_width, src_grid_pin_height, subtile_index,
-                                                               rr_graph.node_side(rr_gsb.get_opin_node(side_manager.get_side(), inode)),
-                                                               src_grid_pin_info);
-      ModulePortId src_grid_port_id = module_manager.find_module_port(src_grid_module, src_grid_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(src_grid_module, src_grid_port_id));
-      BasicPort src_grid_port = module_manager.module_port(src_grid_module, src_grid_port_id); 
-
-      /* Collect sink-related information */
-      vtr::Point<size_t> sink_sb_port_coord(rr_graph.node_xlow(module_sb.get_opin_node(side_manager.get_side(), inode)),
-                                            rr_graph.node_ylow(module_sb.get_opin_node(side_manager.get_side(), inode)));
-      std::string sink_sb_port_name = generate_sb_module_grid_port_name(side_manager.get_side(),
-                                                                        rr_graph.node_side(module_sb.get_opin_node(side_manager.get_side(), inode)),
-                                                                        grids,
-                                                                        vpr_device_annotation,
-                                                                        rr_graph,
-                                                                        module_sb.get_opin_node(side_manager.get_side(), inode)); 
-      ModulePortId sink_sb_port_id = module_manager.find_module_port(sink_sb_module, sink_sb_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(sink_sb_module, sink_sb_port_id));
-      BasicPort sink_sb_port =  module_manager.module_port(sink_sb_module, sink_sb_port_id); 
-
-      /* Source and sink port should match in size */
-      VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
-      
-      /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()[pin_id]);
-      }
-    } 
-  }
-}
-
-/********************************************************************
- * Add module nets to connect a GSB to adjacent grid ports/pins 
- * as well as connection blocks
- * This function will create nets for the following types of connections
- * between grid output pins of Switch block and adjacent grids
- * In this case, the net source is the grid pin, while the net sink
- * is the switch block pin
- *
- * In particular, this function considers the duplicated output pins of grids
+ * When the grid pins are duplicated, this function considers the duplicated output pins of grids
  * when creating the connecting nets.
  * The follow figure shows the different pin postfix to be considered when
  * connecting the grid pins to SB inputs
@@ -192,118 +460,55 @@ void add_top_module_nets_connect_grids_and_sb(ModuleManager& module_manager,
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(ModuleManager& module_manager, 
-                                                                   const ModuleId& top_module, 
-                                                                   const VprDeviceAnnotation& vpr_device_annotation,
-                                                                   const DeviceGrid& grids,
-                                                                   const vtr::Matrix<size_t>& grid_instance_ids,
-                                                                   const RRGraph& rr_graph,
-                                                                   const DeviceRRGSB& device_rr_gsb,
-                                                                   const RRGSB& rr_gsb, 
-                                                                   const vtr::Matrix<size_t>& sb_instance_ids,
-                                                                   const bool& compact_routing_hierarchy) {
-
+void add_top_module_connections_between_grids_and_sb(std::vector<t_top_module_port_connection>& connections,
+                                                     const t_top_module_gsb_port_lookup& lookup,
+                                                     const vtr::Matrix<size_t>& grid_instance_ids,
+                                                     const RRGraph& rr_graph,
+                                                     const DeviceRRGSB& device_rr_gsb,
+                                                     const RRGSB& rr_gsb, 
+                                                     const vtr::Matrix<size_t>& sb_instance_ids,
+                                                     const bool& duplicate_grid_pin) {
   /* Skip those Switch blocks that do not exist */
-  if (false == rr_gsb.is_sb_exist()) {
+  ModuleId sink_sb_module = lookup.sb_modules[rr_gsb.get_x()][rr_gsb.get_y()];
+  if (ModuleId::INVALID() == sink_sb_module) {
     return;
   }
 
-  /* We could have two different coordinators, one is the instance, the other is the module */
-  vtr::Point<size_t> instance_sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-  vtr::Point<size_t> module_gsb_coordinate(rr_gsb.get_x(), rr_gsb.get_y());
-
-  /* If we use compact routing hierarchy, we should find the unique module of CB, which is added to the top module */
-  if (true == compact_routing_hierarchy) {
-    vtr::Point<size_t> gsb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(gsb_coord);
-    module_gsb_coordinate.set_x(unique_mirror.get_x()); 
-    module_gsb_coordinate.set_y(unique_mirror.get_y()); 
-  } 
-
-  /* This is the source cb that is added to the top module */
-  const RRGSB& module_sb = device_rr_gsb.get_gsb(module_gsb_coordinate);
-  vtr::Point<size_t> module_sb_coordinate(module_sb.get_sb_x(), module_sb.get_sb_y());
-
-  /* Collect sink-related information */
-  std::string sink_sb_module_name = generate_switch_block_module_name(module_sb_coordinate);
-  ModuleId sink_sb_module = module_manager.find_module(sink_sb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(sink_sb_module));
-  size_t sink_sb_instance = sb_instance_ids[instance_sb_coordinate.x()][instance_sb_coordinate.y()];
-
-  /* Create a truth table for the postfix to be used regarding to the different side of switch blocks */
-  std::map<e_side, bool> sb_side2postfix_map;
-  /* Boolean variable "true" indicates the upper postfix in naming functions 
-   * Boolean variable "false" indicates the lower postfix in naming functions 
-   */
-  sb_side2postfix_map[TOP] = false;
-  sb_side2postfix_map[RIGHT] = true;
-  sb_side2postfix_map[BOTTOM] = true;
-  sb_side2postfix_map[LEFT] = false;
+  /* The pins of the module follow its unique module, while the instance id follows the instance coordinate */
+  const t_top_module_routing_ports& sink_sb_ports = lookup.sb_ports.at(sink_sb_module);
+  const RRGSB& module_sb = device_rr_gsb.get_gsb(sink_sb_ports.module_gsb_coordinate);
+  size_t sink_sb_instance = sb_instance_ids[rr_gsb.get_sb_x()][rr_gsb.get_sb_y()];
 
   /* Connect grid output pins (OPIN) to switch block grid pins */
   for (size_t side = 0; side < module_sb.get_num_sides(); ++side) {
     SideManager side_manager(side);
+    /* The upper postfix of duplicated grid pins is used on the right and bottom sides of switch blocks */
+    size_t use_upper_postfix = ((RIGHT == side_manager.get_side()) || (BOTTOM == side_manager.get_side())) ? 1 : 0;
     for (size_t inode = 0; inode < module_sb.get_num_opin_nodes(side_manager.get_side()); ++inode) {
       /* Collect source-related information */
-      /* Generate the grid module name by considering if it locates on the border */
-      vtr::Point<size_t> grid_coordinate(rr_graph.node_xlow(rr_gsb.get_opin_node(side_manager.get_side(), inode)),
-                                         rr_graph.node_ylow(rr_gsb.get_opin_node(side_manager.get_side(), inode)));
-      std::string src_grid_module_name = generate_grid_block_module_name_in_top_module(std::string(GRID_MODULE_NAME_PREFIX), grids, grid_coordinate); 
-      ModuleId src_grid_module = module_manager.find_module(src_grid_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(src_grid_module));
+      RRNodeId src_opin_node = rr_gsb.get_opin_node(side_manager.get_side(), inode);
+      vtr::Point<size_t> grid_coordinate(rr_graph.node_xlow(src_opin_node), rr_graph.node_ylow(src_opin_node));
+      ModuleId src_grid_module = lookup.grid_modules[grid_coordinate.x()][grid_coordinate.y()];
+      VTR_ASSERT(ModuleId::INVALID() != src_grid_module);
       size_t src_grid_instance = grid_instance_ids[grid_coordinate.x()][grid_coordinate.y()];
-      size_t src_grid_pin_index = rr_graph.node_pin_num(rr_gsb.get_opin_node(side_manager.get_side(), inode));
+      size_t src_grid_pin_index = rr_graph.node_pin_num(src_opin_node);
+      size_t src_grid_pin_side = size_t(rr_graph.node_side(src_opin_node));
 
-      t_physical_tile_type_ptr grid_type_descriptor = grids[grid_coordinate.x()][grid_coordinate.y()].type;
-      size_t src_grid_pin_width = grid_type_descriptor->pin_width_offset[src_grid_pin_index];
-      size_t src_grid_pin_height = grid_type_descriptor->pin_height_offset[src_grid_pin_index];
-
-      BasicPort src_grid_pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type_descriptor, src_grid_pin_index);
-      VTR_ASSERT(true == src_grid_pin_info.is_valid());
-      int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type_descriptor, src_grid_pin_index);
-      VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type_descriptor->capacity);
-
-      /* Pins for direct connection are NOT duplicated.
-       * Follow the traditional recipe when adding nets!  
-       * Xifan: I assume that each direct connection pin must have Fc=0. 
-       * For other duplicated pins, we follow the new naming
-       */
-      std::string src_grid_port_name;
-      if (0. == find_physical_tile_pin_Fc(grid_type_descriptor, src_grid_pin_index)) {
-        src_grid_port_name = generate_grid_port_name(src_grid_pin_width, src_grid_pin_height, subtile_index,
-                                                     rr_graph.node_side(rr_gsb.get_opin_node(side_manager.get_side(), inode)),
-                                                     src_grid_pin_info);
-      } else {
-       src_grid_port_name = generate_grid_duplicated_port_name(src_grid_pin_width, src_grid_pin_height, subtile_index, 
-                                                               rr_graph.node_side(rr_gsb.get_opin_node(side_manager.get_side(), inode)),
-                                                               src_grid_pin_info, sb_side2postfix_map[side_manager.get_side()]);
-      }
-      ModulePortId src_grid_port_id = module_manager.find_module_port(src_grid_module, src_grid_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(src_grid_module, src_grid_port_id));
-      BasicPort src_grid_port = module_manager.module_port(src_grid_module, src_grid_port_id); 
+      const t_top_module_grid_ports& src_grid_ports = lookup.grid_ports.at(src_grid_module);
+      const t_top_module_port_pins& src_grid_port = (true == duplicate_grid_pin) 
+                                                  ? src_grid_ports.duplicated_ports[use_upper_postfix][src_grid_pin_side][src_grid_pin_index]
+                                                  : src_grid_ports.ports[src_grid_pin_side][src_grid_pin_index];
 
       /* Collect sink-related information */
-      vtr::Point<size_t> sink_sb_port_coord(rr_graph.node_xlow(module_sb.get_opin_node(side_manager.get_side(), inode)),
-                                            rr_graph.node_ylow(module_sb.get_opin_node(side_manager.get_side(), inode)));
-      std::string sink_sb_port_name = generate_sb_module_grid_port_name(side_manager.get_side(),
-                                                                        rr_graph.node_side(module_sb.get_opin_node(side_manager.get_side(), inode)),
-                                                                        grids,
-                                                                        vpr_device_annotation,
-                                                                        rr_graph,
-                                                                        module_sb.get_opin_node(side_manager.get_side(), inode)); 
-      ModulePortId sink_sb_port_id = module_manager.find_module_port(sink_sb_module, sink_sb_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(sink_sb_module, sink_sb_port_id));
-      BasicPort sink_sb_port =  module_manager.module_port(sink_sb_module, sink_sb_port_id); 
+      const t_top_module_port_pins& sink_sb_port = sink_sb_ports.grid_ports[side][inode];
 
       /* Source and sink port should match in size */
-      VTR_ASSERT(src_grid_port.get_width() == sink_sb_port.get_width());
-      
-      /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_grid_module, src_grid_instance, src_grid_port_id, src_grid_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module, sink_sb_instance, sink_sb_port_id, sink_sb_port.pins()[pin_id]);
-      }
+      VTR_ASSERT(src_grid_port.width == sink_sb_port.width);
+
+      add_top_module_port_connection(connections,
+                                     src_grid_module, src_grid_instance, src_grid_port, src_grid_port.lsb,
+                                     sink_sb_module, sink_sb_instance, sink_sb_port, sink_sb_port.lsb,
+                                     src_grid_port.width);
     } 
   }
 }
@@ -364,23 +569,17 @@ void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(ModuleManager
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager, 
-                                              const ModuleId& top_module, 
-                                              const VprDeviceAnnotation& vpr_device_annotation,
-                                              const DeviceGrid& grids,
-                                              const vtr::Matrix<size_t>& grid_instance_ids,
-                                              const RRGraph& rr_graph,
-                                              const DeviceRRGSB& device_rr_gsb,
-                                              const RRGSB& rr_gsb, 
-                                              const t_rr_type& cb_type,
-                                              const vtr::Matrix<size_t>& cb_instance_ids,
-                                              const bool& compact_routing_hierarchy) {
-  /* We could have two different coordinators, one is the instance, the other is the module */
-  vtr::Point<size_t> instance_cb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-  vtr::Point<size_t> module_gsb_coordinate(rr_gsb.get_x(), rr_gsb.get_y());
-
+void add_top_module_connections_between_grids_and_cb(std::vector<t_top_module_port_connection>& connections,
+                                                     const t_top_module_gsb_port_lookup& lookup,
+                                                     const vtr::Matrix<size_t>& grid_instance_ids,
+                                                     const RRGraph& rr_graph,
+                                                     const DeviceRRGSB& device_rr_gsb,
+                                                     const RRGSB& rr_gsb, 
+                                                     const t_rr_type& cb_type,
+                                                     const vtr::Matrix<size_t>& cb_instance_ids) {
   /* Skip those Connection blocks that do not exist */
-  if (false == rr_gsb.is_cb_exist(cb_type)) {
+  ModuleId src_cb_module = lookup.cb_modules.at(cb_type)[rr_gsb.get_x()][rr_gsb.get_y()];
+  if (ModuleId::INVALID() == src_cb_module) {
     return;
   }
 
@@ -389,42 +588,18 @@ void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager,
     return;
   }
 
-  /* If we use compact routing hierarchy, we should find the unique module of CB, which is added to the top module */
-  if (true == compact_routing_hierarchy) {
-    vtr::Point<size_t> gsb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, gsb_coord);
-    module_gsb_coordinate.set_x(unique_mirror.get_x()); 
-    module_gsb_coordinate.set_y(unique_mirror.get_y()); 
-  } 
-
-  /* This is the source cb that is added to the top module */
-  const RRGSB& module_cb = device_rr_gsb.get_gsb(module_gsb_coordinate);
-  vtr::Point<size_t> module_cb_coordinate(module_cb.get_cb_x(cb_type), module_cb.get_cb_y(cb_type));
-
-  /* Collect source-related information */
-  std::string src_cb_module_name = generate_connection_block_module_name(cb_type, module_cb_coordinate);
-  ModuleId src_cb_module = module_manager.find_module(src_cb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(src_cb_module));
-  /* Instance id should follow the instance cb coordinate */
-  size_t src_cb_instance = cb_instance_ids[instance_cb_coordinate.x()][instance_cb_coordinate.y()];
+  /* The pins of the module follow its unique module, while the instance id follows the instance coordinate */
+  const t_top_module_routing_ports& src_cb_ports = lookup.cb_ports.at(src_cb_module);
+  const RRGSB& module_cb = device_rr_gsb.get_gsb(src_cb_ports.module_gsb_coordinate);
+  size_t src_cb_instance = cb_instance_ids[rr_gsb.get_cb_x(cb_type)][rr_gsb.get_cb_y(cb_type)];
 
   /* Iterate over the output pins of the Connection Block */
-  std::vector<enum e_side> cb_ipin_sides = module_cb.get_cb_ipin_sides(cb_type);
+  const std::vector<enum e_side>& cb_ipin_sides = module_cb.get_cb_ipin_sides(cb_type);
   for (size_t iside = 0; iside < cb_ipin_sides.size(); ++iside) {
     enum e_side cb_ipin_side = cb_ipin_sides[iside];
     for (size_t inode = 0; inode < module_cb.get_num_ipin_nodes(cb_ipin_side); ++inode) {
       /* Collect source-related information */
-      RRNodeId module_ipin_node = module_cb.get_ipin_node(cb_ipin_side, inode);
-      vtr::Point<size_t> cb_src_port_coord(rr_graph.node_xlow(module_ipin_node),
-                                           rr_graph.node_ylow(module_ipin_node));
-      std::string src_cb_port_name = generate_cb_module_grid_port_name(cb_ipin_side,
-                                                                       grids,
-                                                                       vpr_device_annotation,
-                                                                       rr_graph,
-                                                                       module_ipin_node); 
-      ModulePortId src_cb_port_id = module_manager.find_module_port(src_cb_module, src_cb_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(src_cb_module, src_cb_port_id));
-      BasicPort src_cb_port = module_manager.module_port(src_cb_module, src_cb_port_id); 
+      const t_top_module_port_pins& src_cb_port = src_cb_ports.grid_ports[iside][inode];
 
       /* Collect sink-related information */
       /* Note that we use the instance cb pin here!!!
@@ -433,35 +608,20 @@ void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager,
       RRNodeId instance_ipin_node = rr_gsb.get_ipin_node(cb_ipin_side, inode);
       vtr::Point<size_t> grid_coordinate(rr_graph.node_xlow(instance_ipin_node), 
                                          rr_graph.node_ylow(instance_ipin_node));
-      std::string sink_grid_module_name = generate_grid_block_module_name_in_top_module(std::string(GRID_MODULE_NAME_PREFIX), grids, grid_coordinate); 
-      ModuleId sink_grid_module = module_manager.find_module(sink_grid_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sink_grid_module));
+      ModuleId sink_grid_module = lookup.grid_modules[grid_coordinate.x()][grid_coordinate.y()];
+      VTR_ASSERT(ModuleId::INVALID() != sink_grid_module);
       size_t sink_grid_instance = grid_instance_ids[grid_coordinate.x()][grid_coordinate.y()];
       size_t sink_grid_pin_index = rr_graph.node_pin_num(instance_ipin_node);
-
-      t_physical_tile_type_ptr grid_type_descriptor = grids[grid_coordinate.x()][grid_coordinate.y()].type;
-      size_t sink_grid_pin_width = grid_type_descriptor->pin_width_offset[sink_grid_pin_index];
-      size_t sink_grid_pin_height = grid_type_descriptor->pin_height_offset[sink_grid_pin_index];
-      BasicPort sink_grid_pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type_descriptor, sink_grid_pin_index);
-      VTR_ASSERT(true == sink_grid_pin_info.is_valid());
-      int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type_descriptor, sink_grid_pin_index);
-      VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type_descriptor->capacity);
-      std::string sink_grid_port_name = generate_grid_port_name(sink_grid_pin_width, sink_grid_pin_height, subtile_index,
-                                                                rr_graph.node_side(rr_gsb.get_ipin_node(cb_ipin_side, inode)),
-                                                                sink_grid_pin_info);
-      ModulePortId sink_grid_port_id = module_manager.find_module_port(sink_grid_module, sink_grid_port_name);
-      VTR_ASSERT(true == module_manager.valid_module_port_id(sink_grid_module, sink_grid_port_id));
-      BasicPort sink_grid_port = module_manager.module_port(sink_grid_module, sink_grid_port_id); 
+      size_t sink_grid_pin_side = size_t(rr_graph.node_side(instance_ipin_node));
+      const t_top_module_port_pins& sink_grid_port = lookup.grid_ports.at(sink_grid_module).ports[sink_grid_pin_side][sink_grid_pin_index];
 
       /* Source and sink port should match in size */
-      VTR_ASSERT(src_cb_port.get_width() == sink_grid_port.get_width());
-      
-      /* Create a net for each pin */
-      for (size_t pin_id = 0; pin_id < src_cb_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, src_cb_module, src_cb_instance, src_cb_port_id, src_cb_port.pins()[pin_id]);
-        /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_grid_module, sink_grid_instance, sink_grid_port_id, sink_grid_port.pins()[pin_id]);
-      }
+      VTR_ASSERT(src_cb_port.width == sink_grid_port.width);
+
+      add_top_module_port_connection(connections,
+                                     src_cb_module, src_cb_instance, src_cb_port, src_cb_port.lsb,
+                                     sink_grid_module, sink_grid_instance, sink_grid_port, sink_grid_port.lsb,
+                                     src_cb_port.width);
     }
   }
 }
@@ -506,40 +666,23 @@ void add_top_module_nets_connect_grids_and_cb(ModuleManager& module_manager,
  *
  *******************************************************************/
 static 
-void add_top_module_nets_connect_sb_and_cb(ModuleManager& module_manager, 
-                                           const ModuleId& top_module, 
-                                           const RRGraph& rr_graph,
-                                           const DeviceRRGSB& device_rr_gsb,
-                                           const RRGSB& rr_gsb, 
-                                           const vtr::Matrix<size_t>& sb_instance_ids,
-                                           const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-                                           const bool& compact_routing_hierarchy) {
-  /* We could have two different coordinators, one is the instance, the other is the module */
-  vtr::Point<size_t> instance_sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-  vtr::Point<size_t> module_gsb_sb_coordinate(rr_gsb.get_x(), rr_gsb.get_y());
-
+void add_top_module_connections_between_sb_and_cb(std::vector<t_top_module_port_connection>& connections,
+                                                  const t_top_module_gsb_port_lookup& lookup,
+                                                  const DeviceRRGSB& device_rr_gsb,
+                                                  const RRGSB& rr_gsb, 
+                                                  const vtr::Matrix<size_t>& sb_instance_ids,
+                                                  const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids) {
   /* Skip those Switch blocks that do not exist */
-  if (false == rr_gsb.is_sb_exist()) {
+  ModuleId sb_module_id = lookup.sb_modules[rr_gsb.get_x()][rr_gsb.get_y()];
+  if (ModuleId::INVALID() == sb_module_id) {
     return;
   }
 
-  /* If we use compact routing hierarchy, we should find the unique module of CB, which is added to the top module */
-  if (true == compact_routing_hierarchy) {
-    vtr::Point<size_t> gsb_coord(rr_gsb.get_x(), rr_gsb.get_y());
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(gsb_coord);
-    module_gsb_sb_coordinate.set_x(unique_mirror.get_x()); 
-    module_gsb_sb_coordinate.set_y(unique_mirror.get_y()); 
-  } 
-
-  /* This is the source cb that is added to the top module */
-  const RRGSB& module_sb = device_rr_gsb.get_gsb(module_gsb_sb_coordinate);
-  vtr::Point<size_t> module_sb_coordinate(module_sb.get_sb_x(), module_sb.get_sb_y());
-  std::string sb_module_name = generate_switch_block_module_name(module_sb_coordinate);
-  ModuleId sb_module_id = module_manager.find_module(sb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(sb_module_id));
-  size_t sb_instance = sb_instance_ids[instance_sb_coordinate.x()][instance_sb_coordinate.y()];
+  /* The pins of the module follow its unique module, while the instance id follows the instance coordinate */
+  const t_top_module_routing_ports& sb_ports = lookup.sb_ports.at(sb_module_id);
+  const RRGSB& module_sb = device_rr_gsb.get_gsb(sb_ports.module_gsb_coordinate);
+  size_t sb_instance = sb_instance_ids[rr_gsb.get_sb_x()][rr_gsb.get_sb_y()];
 
-  /* Connect grid output pins (OPIN) to switch block grid pins */
   for (size_t side = 0; side < module_sb.get_num_sides(); ++side) {
     SideManager side_manager(side);
     /* Iterate over the routing tracks on this side */
@@ -553,88 +696,72 @@ void add_top_module_nets_connect_sb_and_cb(ModuleManager& module_manager,
      */
     t_rr_type cb_type = find_top_module_cb_type_by_sb_side(side_manager.get_side());
     vtr::Point<size_t> instance_gsb_cb_coordinate = find_top_module_gsb_coordinate_by_sb_side(rr_gsb, side_manager.get_side());
-    vtr::Point<size_t> module_gsb_cb_coordinate = find_top_module_gsb_coordinate_by_sb_side(rr_gsb, side_manager.get_side());
 
     /* Skip those Connection blocks that do not exist:
-     * 1. The CB does not exist in the device level! We should skip! 
-     * 2. The CB does exist but we need to make sure if the GSB includes such CBs 
-     *    For TOP and LEFT side, check the existence using RRGSB method is_cb_exist()
-     *    FOr RIGHT and BOTTOM side, find the adjacent RRGSB and then use is_cb_exist()
+     * For TOP and LEFT side, the CB belongs to this GSB 
+     * For RIGHT and BOTTOM side, the CB belongs to the adjacent GSB
      */
-    if ( TOP == side_manager.get_side() || LEFT == side_manager.get_side() ) {
-      if ( false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-    }
-
-    if ( RIGHT == side_manager.get_side() || BOTTOM == side_manager.get_side() ) {
-      const RRGSB& adjacent_gsb = device_rr_gsb.get_gsb(module_gsb_cb_coordinate);
-      if ( false == adjacent_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
+    ModuleId cb_module_id = lookup.cb_modules.at(cb_type)[instance_gsb_cb_coordinate.x()][instance_gsb_cb_coordinate.y()];
+    if (ModuleId::INVALID() == cb_module_id) {
+      continue;
     }
 
-    /* If we use compact routing hierarchy, we should find the unique module of CB, which is added to the top module */
-    if (true == compact_routing_hierarchy) {
-      const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, module_gsb_cb_coordinate);
-      module_gsb_cb_coordinate.set_x(unique_mirror.get_x()); 
-      module_gsb_cb_coordinate.set_y(unique_mirror.get_y()); 
-    } 
-  
-    const RRGSB& module_cb = device_rr_gsb.get_gsb(module_gsb_cb_coordinate);
-    vtr::Point<size_t> module_cb_coordinate(module_cb.get_cb_x(cb_type), module_cb.get_cb_y(cb_type));
-    std::string cb_module_name = generate_connection_block_module_name(cb_type, module_cb_coordinate);
-    ModuleId cb_module_id = module_manager.find_module(cb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(cb_module_id));
+    const t_top_module_routing_ports& cb_ports = lookup.cb_ports.at(cb_module_id);
     const RRGSB& instance_cb = device_rr_gsb.get_gsb(instance_gsb_cb_coordinate);
-    vtr::Point<size_t> instance_cb_coordinate(instance_cb.get_cb_x(cb_type), instance_cb.get_cb_y(cb_type));
-    size_t cb_instance = cb_instance_ids.at(cb_type)[instance_cb_coordinate.x()][instance_cb_coordinate.y()];
+    size_t cb_instance = cb_instance_ids.at(cb_type)[instance_cb.get_cb_x(cb_type)][instance_cb.get_cb_y(cb_type)];
+
+    /* Upper CB port is required if the routing tracks are on the top or right sides of 
+     * the switch block, which indicated bottom and left sides of the connection blocks
+     */
+    size_t use_cb_upper_port = ((TOP == side_manager.get_side()) || (RIGHT == side_manager.get_side())) ? 1 : 0;
  
     for (size_t itrack = 0; itrack < module_sb.get_chan_width(side_manager.get_side()); ++itrack) {
-      std::string sb_port_name = generate_sb_module_track_port_name(rr_graph.node_type(module_sb.get_chan_node(side_manager.get_side(), itrack)),
-                                                                    side_manager.get_side(), 
-                                                                    module_sb.get_chan_node_direction(side_manager.get_side(), itrack));
-      /* Prepare SB-related port information */
-      ModulePortId sb_port_id = module_manager.find_module_port(sb_module_id, sb_port_name); 
-      VTR_ASSERT(true == module_manager.valid_module_port_id(sb_module_id, sb_port_id));
-      BasicPort sb_port = module_manager.module_port(sb_module_id, sb_port_id);
-     
-      /* Prepare CB-related port information */ 
-      PORTS cb_port_direction = OUT_PORT;
-      /* The cb port direction should be opposite to the sb port !!! */
-      if (OUT_PORT == module_sb.get_chan_node_direction(side_manager.get_side(), itrack)) {
-        cb_port_direction = IN_PORT;
-      } else {
-        VTR_ASSERT(IN_PORT == module_sb.get_chan_node_direction(side_manager.get_side(), itrack));
-      }  
-     
-      /* Upper CB port is required if the routing tracks are on the top or right sides of 
-       * the switch block, which indicated bottom and left sides of the connection blocks
-       */
-      bool use_cb_upper_port = (TOP == side_manager.get_side()) || (RIGHT == side_manager.get_side());
-      std::string cb_port_name = generate_cb_module_track_port_name(cb_type,
-                                                                    cb_port_direction,
-                                                                    use_cb_upper_port);
-      ModulePortId cb_port_id = module_manager.find_module_port(cb_module_id, cb_port_name); 
-      VTR_ASSERT(true == module_manager.valid_module_port_id(cb_module_id, cb_port_id));
-      BasicPort cb_port = module_manager.module_port(cb_module_id, cb_port_id);
+      const t_top_module_port_pins& sb_port = sb_ports.track_ports[side][itrack];
 
       /* Configure the net source and sink:
        * If sb port is an output (source), cb port is an input (sink) 
        * If sb port is an input (sink), cb port is an output (source) 
        */
       if (OUT_PORT == module_sb.get_chan_node_direction(side_manager.get_side(), itrack)) {
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, sb_module_id, sb_instance, sb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, cb_module_id, cb_instance, cb_port_id, itrack / 2);
+        const t_top_module_port_pins& cb_port = cb_ports.cb_track_ports[0][use_cb_upper_port];
+        add_top_module_port_connection(connections,
+                                       sb_module_id, sb_instance, sb_port, itrack / 2,
+                                       cb_module_id, cb_instance, cb_port, itrack / 2,
+                                       1);
       } else {
         VTR_ASSERT(IN_PORT == module_sb.get_chan_node_direction(side_manager.get_side(), itrack));
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module, cb_module_id, cb_instance, cb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, sb_module_id, sb_instance, sb_port_id, itrack / 2);
+        const t_top_module_port_pins& cb_port = cb_ports.cb_track_ports[1][use_cb_upper_port];
+        add_top_module_port_connection(connections,
+                                       cb_module_id, cb_instance, cb_port, itrack / 2,
+                                       sb_module_id, sb_instance, sb_port, itrack / 2,
+                                       1);
       }
     }
   }
 }
 
+/********************************************************************
+ * Create the nets of connections in the top-level module, in their order
+ * A net is shared by the connections driven by the same source pin
+ *******************************************************************/
+static 
+void add_top_module_nets_for_connections(ModuleManager& module_manager, 
+                                         const ModuleId& top_module, 
+                                         const std::vector<t_top_module_port_connection>& connections) {
+  for (const t_top_module_port_connection& connection : connections) {
+    /* Create a net for each pin */
+    for (size_t ipin = 0; ipin < connection.num_pins; ++ipin) {
+      ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
+                                                     connection.src_module, connection.src_instance,
+                                                     connection.src_port, connection.src_pin + ipin);
+      /* Configure the net sink */
+      module_manager.add_module_net_sink(top_module, net,
+                                         connection.sink_module, connection.sink_instance,
+                                         connection.sink_port, connection.sink_pin + ipin);
+    }
+  }
+}
+
 /********************************************************************
  * Add module nets to connect the grid ports/pins to Connection Blocks
  * and Switch Blocks
@@ -678,49 +805,50 @@ void add_top_module_nets_connect_grids_and_gsbs(ModuleManager& module_manager,
                                                 const vtr::Matrix<size_t>& sb_instance_ids,
                                                 const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
                                                 const bool& compact_routing_hierarchy,
-                                                const bool& duplicate_grid_pin) {
+                                                const bool& duplicate_grid_pin,
+                                                const size_t& num_threads) {
 
   vtr::ScopedStartFinishTimer timer("Add module nets between grids and GSBs");
 
+  t_top_module_gsb_port_lookup lookup = build_top_module_gsb_port_lookup(module_manager,
+                                                                         vpr_device_annotation,
+                                                                         grids, rr_graph, device_rr_gsb,
+                                                                         compact_routing_hierarchy,
+                                                                         duplicate_grid_pin,
+                                                                         num_threads);
+
   vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
+  /* The connections of the GSBs in a column are found in parallel,
+   * and their nets are then created in the order of GSBs,
+   * so that the nets do not depend on the number of threads.
+   * The net creation itself is sequential, as it updates the net lookup of the top-level module
+   */
+  std::vector<std::vector<t_top_module_port_connection>> gsb_connections(gsb_range.y());
+
   for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+    parallel_for(gsb_range.y(), num_threads, [&](const size_t& iy) {
+      std::vector<t_top_module_port_connection>& connections = gsb_connections[iy];
+      connections.clear();
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
 
       /* Connect the grid pins of the GSB to adjacent grids */
-      if (false == duplicate_grid_pin) {
-        add_top_module_nets_connect_grids_and_sb(module_manager, top_module, 
-                                                 vpr_device_annotation,
-                                                 grids, grid_instance_ids,
-                                                 rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
-                                                 compact_routing_hierarchy);
-      } else {
-        VTR_ASSERT_SAFE(true == duplicate_grid_pin);
-        add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(module_manager, top_module, 
-                                                                      vpr_device_annotation,
-                                                                      grids, grid_instance_ids,
-                                                                      rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
-                                                                      compact_routing_hierarchy);
-      }
+      add_top_module_connections_between_grids_and_sb(connections, lookup, grid_instance_ids,
+                                                       rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, 
+                                                       duplicate_grid_pin);
 
-      add_top_module_nets_connect_grids_and_cb(module_manager, top_module, 
-                                               vpr_device_annotation,
-                                               grids, grid_instance_ids,
-                                               rr_graph, device_rr_gsb, rr_gsb, CHANX, cb_instance_ids.at(CHANX),
-                                               compact_routing_hierarchy);
+      add_top_module_connections_between_grids_and_cb(connections, lookup, grid_instance_ids,
+                                                       rr_graph, device_rr_gsb, rr_gsb, CHANX, cb_instance_ids.at(CHANX));
 
-      add_top_module_nets_connect_grids_and_cb(module_manager, top_module, 
-                                               vpr_device_annotation,
-                                               grids, grid_instance_ids,
-                                               rr_graph, device_rr_gsb, rr_gsb, CHANY, cb_instance_ids.at(CHANY),
-                                               compact_routing_hierarchy);
+      add_top_module_connections_between_grids_and_cb(connections, lookup, grid_instance_ids,
+                                                       rr_graph, device_rr_gsb, rr_gsb, CHANY, cb_instance_ids.at(CHANY));
 
-      add_top_module_nets_connect_sb_and_cb(module_manager, top_module, 
-                                            rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids, cb_instance_ids,
-                                            compact_routing_hierarchy);
+      add_top_module_connections_between_sb_and_cb(connections, lookup, device_rr_gsb, rr_gsb,
+                                                   sb_instance_ids, cb_instance_ids);
+    });
 
+    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+      add_top_module_nets_for_connections(module_manager, top_module, gsb_connections[iy]);
     }
   }
 }
@@ -4,6 +4,8 @@
  * in the top-level module of a FPGA fabric
  *******************************************************************/
 #include <algorithm>
+#include <map>
+#include <utility>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -25,6 +27,133 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The modules and ports used by the tile direct connections,
+ * which are resolved once and shared by all the direct connections
+ *  - grid_modules: the grid module of each tile type and border side
+ *  - grid_ports: the port of each pin of a grid module at each side
+ *                [grid_module][pin_side][tile_pin]
+ *  - direct_modules: the direct connection module of each direct
+ *                    definition, with its input and output ports
+ *******************************************************************/
+struct t_direct_module_ports {
+  ModuleId module;
+  ModulePortId input_port;
+  ModulePortId output_port;
+};
+
+struct t_tile_direct_module_lookup {
+  std::map<std::pair<t_physical_tile_type_ptr, e_side>, ModuleId> grid_modules;
+  std::map<ModuleId, std::vector<std::vector<ModulePortId>>> grid_ports;
+  std::map<ArchDirectId, t_direct_module_ports> direct_modules;
+};
+
+/********************************************************************
+ * Find the grid module of a tile at a given coordinate
+ *******************************************************************/
+static 
+ModuleId find_tile_direct_grid_module(t_tile_direct_module_lookup& lookup,
+                                      const ModuleManager& module_manager,
+                                      const DeviceGrid& grids,
+                                      const vtr::Point<size_t>& grid_coord) {
+  vtr::Point<size_t> device_size(grids.width(), grids.height());
+  t_physical_tile_type_ptr grid_type = grids[grid_coord.x()][grid_coord.y()].type;
+  e_side grid_border_side = find_grid_border_side(device_size, grid_coord);
+
+  auto result = lookup.grid_modules.find(std::make_pair(grid_type, grid_border_side));
+  if (result != lookup.grid_modules.end()) {
+    return result->second;
+  }
+
+  std::string module_name_prefix(GRID_MODULE_NAME_PREFIX);
+  std::string module_name = generate_grid_block_module_name(module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), grid_border_side);
+  ModuleId grid_module = module_manager.find_module(module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
+  lookup.grid_modules[std::make_pair(grid_type, grid_border_side)] = grid_module;
+  return grid_module;
+}
+
+/********************************************************************
+ * Find the port of a grid module for a pin of the tile at a given side
+ *******************************************************************/
+static 
+ModulePortId find_tile_direct_grid_port(t_tile_direct_module_lookup& lookup,
+                                        const ModuleManager& module_manager,
+                                        const VprDeviceAnnotation& vpr_device_annotation,
+                                        const ModuleId& grid_module,
+                                        t_physical_tile_type_ptr grid_type,
+                                        const e_side& pin_grid_side,
+                                        const size_t& tile_pin) {
+  std::vector<std::vector<ModulePortId>>& grid_ports = lookup.grid_ports[grid_module];
+  if (grid_ports.empty()) {
+    grid_ports.resize(NUM_SIDES, std::vector<ModulePortId>(grid_type->num_pins, ModulePortId::INVALID()));
+  }
+  VTR_ASSERT(tile_pin < grid_ports[size_t(pin_grid_side)].size());
+  ModulePortId& port_id = grid_ports[size_t(pin_grid_side)][tile_pin];
+  if (ModulePortId::INVALID() != port_id) {
+    return port_id;
+  }
+
+  /* Generate the pin name of the port/pin in the grid */
+  size_t pin_width = grid_type->pin_width_offset[tile_pin]; 
+  size_t pin_height = grid_type->pin_height_offset[tile_pin]; 
+
+  BasicPort pin_info = vpr_device_annotation.physical_tile_pin_port_info(grid_type, tile_pin);
+  VTR_ASSERT(true == pin_info.is_valid());
+  int subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(grid_type, tile_pin);
+  VTR_ASSERT(OPEN != subtile_index && subtile_index < grid_type->capacity);
+  std::string port_name = generate_grid_port_name(pin_width, pin_height, subtile_index, pin_grid_side, pin_info);
+  port_id = module_manager.find_module_port(grid_module, port_name); 
+  if (true != module_manager.valid_module_port_id(grid_module, port_id)) {
+    VTR_LOG_ERROR("Fail to find port '%s.%s'\n",
+                  module_manager.module_name(grid_module).c_str(),
+                  port_name.c_str());
+  }
+  VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module, port_id));
+  VTR_ASSERT(1 == module_manager.module_port(grid_module, port_id).get_width());
+
+  return port_id;
+}
+
+/********************************************************************
+ * Find the module of a direct connection, and its input and output ports
+ *******************************************************************/
+static 
+const t_direct_module_ports& find_tile_direct_module(t_tile_direct_module_lookup& lookup,
+                                                     const ModuleManager& module_manager,
+                                                     const CircuitLibrary& circuit_lib,
+                                                     const ArchDirect& arch_direct,
+                                                     const ArchDirectId& arch_direct_id) {
+  auto result = lookup.direct_modules.find(arch_direct_id);
+  if (result != lookup.direct_modules.end()) {
+    return result->second;
+  }
+
+  t_direct_module_ports direct_module_ports;
+
+  /* Find the module id of a direct connection module */
+  CircuitModelId direct_circuit_model = arch_direct.circuit_model(arch_direct_id);
+  std::string direct_module_name = circuit_lib.model_name(direct_circuit_model);
+  ModuleId direct_module = module_manager.find_module(direct_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(direct_module));
+  direct_module_ports.module = direct_module;
+
+  /* Find inputs and outputs of the direct circuit module */
+  std::vector<CircuitPortId> direct_input_ports = circuit_lib.model_ports_by_type(direct_circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  VTR_ASSERT(1 == direct_input_ports.size());
+  direct_module_ports.input_port = module_manager.find_module_port(direct_module, circuit_lib.port_prefix(direct_input_ports[0]));
+  VTR_ASSERT(true == module_manager.valid_module_port_id(direct_module, direct_module_ports.input_port));
+  VTR_ASSERT(1 == module_manager.module_port(direct_module, direct_module_ports.input_port).get_width());
+
+  std::vector<CircuitPortId> direct_output_ports = circuit_lib.model_ports_by_type(direct_circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
+  VTR_ASSERT(1 == direct_output_ports.size());
+  direct_module_ports.output_port = module_manager.find_module_port(direct_module, circuit_lib.port_prefix(direct_output_ports[0]));
+  VTR_ASSERT(true == module_manager.valid_module_port_id(direct_module, direct_module_ports.output_port));
+  VTR_ASSERT(1 == module_manager.module_port(direct_module, direct_module_ports.output_port).get_width());
+
+  return lookup.direct_modules.emplace(arch_direct_id, direct_module_ports).first->second;
+}
+
 /********************************************************************
  * Add module net for one direction connection between two CLBs or
  * two grids
@@ -36,9 +165,11 @@ namespace openfpga {
  * in order to connect the source pin to the input of the top module
  * 4. add a second module net and configure its source and sink, 
  * in order to connect the sink pin to the output of the top module
+ * The modules and ports are found through the look-up shared by all the directs
  *******************************************************************/
 static 
 void add_module_nets_tile_direct_connection(ModuleManager& module_manager, 
+                                            t_tile_direct_module_lookup& lookup,
                                             const ModuleId& top_module,  
                                             const CircuitLibrary& circuit_lib, 
                                             const VprDeviceAnnotation& vpr_device_annotation,
@@ -47,87 +178,34 @@ void add_module_nets_tile_direct_connection(ModuleManager& module_manager,
                                             const TileDirect& tile_direct,
                                             const TileDirectId& tile_direct_id,
                                             const ArchDirect& arch_direct) {
-  vtr::Point<size_t> device_size(grids.width(), grids.height());
-
-  /* Find the module name of source clb */
+  /* Find the module of source clb */
   vtr::Point<size_t> src_clb_coord = tile_direct.from_tile_coordinate(tile_direct_id);
-  t_physical_tile_type_ptr src_grid_type = grids[src_clb_coord.x()][src_clb_coord.y()].type;
-  e_side src_grid_border_side = find_grid_border_side(device_size, src_clb_coord);
-  std::string src_module_name_prefix(GRID_MODULE_NAME_PREFIX);
-  std::string src_module_name = generate_grid_block_module_name(src_module_name_prefix, std::string(src_grid_type->name), is_io_type(src_grid_type), src_grid_border_side);
-  ModuleId src_grid_module = module_manager.find_module(src_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(src_grid_module));
+  ModuleId src_grid_module = find_tile_direct_grid_module(lookup, module_manager, grids, src_clb_coord);
   /* Record the instance id */
   size_t src_grid_instance = grid_instance_ids[src_clb_coord.x()][src_clb_coord.y()];
 
-  /* Find the module name of sink clb */
+  /* Find the module of sink clb */
   vtr::Point<size_t> des_clb_coord = tile_direct.to_tile_coordinate(tile_direct_id);
-  t_physical_tile_type_ptr sink_grid_type = grids[des_clb_coord.x()][des_clb_coord.y()].type;
-  e_side sink_grid_border_side = find_grid_border_side(device_size, des_clb_coord);
-  std::string sink_module_name_prefix(GRID_MODULE_NAME_PREFIX);
-  std::string sink_module_name = generate_grid_block_module_name(sink_module_name_prefix, std::string(sink_grid_type->name), is_io_type(sink_grid_type), sink_grid_border_side);
-  ModuleId sink_grid_module = module_manager.find_module(sink_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(sink_grid_module));
+  ModuleId sink_grid_module = find_tile_direct_grid_module(lookup, module_manager, grids, des_clb_coord);
   /* Record the instance id */
   size_t sink_grid_instance = grid_instance_ids[des_clb_coord.x()][des_clb_coord.y()];
 
   /* Find the module id of a direct connection module */
-  CircuitModelId direct_circuit_model = arch_direct.circuit_model(tile_direct.arch_direct(tile_direct_id));
-  std::string direct_module_name = circuit_lib.model_name(direct_circuit_model);
-  ModuleId direct_module = module_manager.find_module(direct_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(direct_module));
+  const t_direct_module_ports& direct_module_ports = find_tile_direct_module(lookup, module_manager, circuit_lib,
+                                                                            arch_direct, tile_direct.arch_direct(tile_direct_id));
+  const ModuleId& direct_module = direct_module_ports.module;
 
-  /* Find inputs and outputs of the direct circuit module */
-  std::vector<CircuitPortId> direct_input_ports = circuit_lib.model_ports_by_type(direct_circuit_model, CIRCUIT_MODEL_PORT_INPUT, true);
-  VTR_ASSERT(1 == direct_input_ports.size());
-  ModulePortId direct_input_port_id = module_manager.find_module_port(direct_module, circuit_lib.port_prefix(direct_input_ports[0]));
-  VTR_ASSERT(true == module_manager.valid_module_port_id(direct_module, direct_input_port_id));
-  VTR_ASSERT(1 == module_manager.module_port(direct_module, direct_input_port_id).get_width());
+  /* Find the source port/pin in the grid */
+  ModulePortId src_port_id = find_tile_direct_grid_port(lookup, module_manager, vpr_device_annotation,
+                                                        src_grid_module, grids[src_clb_coord.x()][src_clb_coord.y()].type,
+                                                        tile_direct.from_tile_side(tile_direct_id),
+                                                        tile_direct.from_tile_pin(tile_direct_id));
 
-  std::vector<CircuitPortId> direct_output_ports = circuit_lib.model_ports_by_type(direct_circuit_model, CIRCUIT_MODEL_PORT_OUTPUT, true);
-  VTR_ASSERT(1 == direct_output_ports.size());
-  ModulePortId direct_output_port_id = module_manager.find_module_port(direct_module, circuit_lib.port_prefix(direct_output_ports[0]));
-  VTR_ASSERT(true == module_manager.valid_module_port_id(direct_module, direct_output_port_id));
-  VTR_ASSERT(1 == module_manager.module_port(direct_module, direct_output_port_id).get_width());
-
-  /* Generate the pin name of source port/pin in the grid */
-  e_side src_pin_grid_side = tile_direct.from_tile_side(tile_direct_id);
-  size_t src_tile_pin = tile_direct.from_tile_pin(tile_direct_id);
-
-  t_physical_tile_type_ptr src_grid_type_descriptor = grids[src_clb_coord.x()][src_clb_coord.y()].type;
-  size_t src_pin_width = src_grid_type_descriptor->pin_width_offset[src_tile_pin]; 
-  size_t src_pin_height = src_grid_type_descriptor->pin_height_offset[src_tile_pin]; 
-
-  BasicPort src_pin_info = vpr_device_annotation.physical_tile_pin_port_info(src_grid_type_descriptor, src_tile_pin);
-  VTR_ASSERT(true == src_pin_info.is_valid());
-  int src_subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(src_grid_type_descriptor, src_tile_pin);
-  VTR_ASSERT(OPEN != src_subtile_index && src_subtile_index < src_grid_type_descriptor->capacity);
-  std::string src_port_name = generate_grid_port_name(src_pin_width, src_pin_height, src_subtile_index, src_pin_grid_side, src_pin_info);
-  ModulePortId src_port_id = module_manager.find_module_port(src_grid_module, src_port_name); 
-  if (true != module_manager.valid_module_port_id(src_grid_module, src_port_id)) {
-    VTR_LOG_ERROR("Fail to find port '%s[%lu][%lu].%s'\n",
-                  src_module_name.c_str(), src_clb_coord.x(), src_clb_coord.y(),
-                  src_port_name.c_str());
-  }
-  VTR_ASSERT(true == module_manager.valid_module_port_id(src_grid_module, src_port_id));
-  VTR_ASSERT(1 == module_manager.module_port(src_grid_module, src_port_id).get_width());
-
-  /* Generate the pin name of sink port/pin in the grid */
-  e_side sink_pin_grid_side = tile_direct.to_tile_side(tile_direct_id);
-  size_t sink_tile_pin = tile_direct.to_tile_pin(tile_direct_id);
-
-  t_physical_tile_type_ptr sink_grid_type_descriptor = grids[des_clb_coord.x()][des_clb_coord.y()].type;
-  size_t sink_pin_width = sink_grid_type_descriptor->pin_width_offset[src_tile_pin]; 
-  size_t sink_pin_height = sink_grid_type_descriptor->pin_height_offset[src_tile_pin]; 
-
-  BasicPort sink_pin_info = vpr_device_annotation.physical_tile_pin_port_info(sink_grid_type_descriptor, sink_tile_pin);
-  VTR_ASSERT(true == sink_pin_info.is_valid());
-  int sink_subtile_index = vpr_device_annotation.physical_tile_pin_subtile_index(sink_grid_type_descriptor, sink_tile_pin);
-  VTR_ASSERT(OPEN != src_subtile_index && src_subtile_index < sink_grid_type_descriptor->capacity);
-  std::string sink_port_name = generate_grid_port_name(sink_pin_width, sink_pin_height, sink_subtile_index, sink_pin_grid_side, sink_pin_info);
-  ModulePortId sink_port_id = module_manager.find_module_port(sink_grid_module, sink_port_name); 
-  VTR_ASSERT(true == module_manager.valid_module_port_id(sink_grid_module, sink_port_id));
-  VTR_ASSERT(1 == module_manager.module_port(sink_grid_module, sink_port_id).get_width());
+  /* Find the sink port/pin in the grid */
+  ModulePortId sink_port_id = find_tile_direct_grid_port(lookup, module_manager, vpr_device_annotation,
+                                                         sink_grid_module, grids[des_clb_coord.x()][des_clb_coord.y()].type,
+                                                         tile_direct.to_tile_side(tile_direct_id),
+                                                         tile_direct.to_tile_pin(tile_direct_id));
 
   /* Add a submodule of direct connection module to the top-level module */
   size_t direct_instance_id = module_manager.num_instance(top_module, direct_module);
@@ -137,12 +215,12 @@ void add_module_nets_tile_direct_connection(ModuleManager& module_manager,
   ModuleNetId net_direct_src = module_manager.create_module_net(top_module); 
   /* Connect the wire between src_pin of clb and direct_instance input*/
   module_manager.add_module_net_source(top_module, net_direct_src, src_grid_module, src_grid_instance, src_port_id, 0);
-  module_manager.add_module_net_sink(top_module, net_direct_src, direct_module, direct_instance_id, direct_input_port_id, 0);
+  module_manager.add_module_net_sink(top_module, net_direct_src, direct_module, direct_instance_id, direct_module_ports.input_port, 0);
 
   /* Create the 2nd module net
    * Connect the wire between direct_instance output and sink_pin of clb
    */
-  ModuleNetId net_direct_sink = create_module_source_pin_net(module_manager, top_module, direct_module, direct_instance_id, direct_output_port_id, 0);
+  ModuleNetId net_direct_sink = create_module_source_pin_net(module_manager, top_module, direct_module, direct_instance_id, direct_module_ports.output_port, 0);
   module_manager.add_module_net_sink(top_module, net_direct_sink, sink_grid_module, sink_grid_instance, sink_port_id, 0);
 }
 
@@ -163,8 +241,13 @@ void add_top_module_nets_tile_direct_connections(ModuleManager& module_manager,
 
   vtr::ScopedStartFinishTimer timer("Add module nets for inter-tile connections");
 
+  /* Each direct connection creates two nets in the top module */
+  size_t num_directs = std::distance(tile_direct.directs().begin(), tile_direct.directs().end());
+  module_manager.reserve_module_nets(top_module, module_manager.num_nets(top_module) + 2 * num_directs);
+
+  t_tile_direct_module_lookup lookup;
   for (const TileDirectId& tile_direct_id : tile_direct.directs()) {
-    add_module_nets_tile_direct_connection(module_manager, top_module, circuit_lib, 
+    add_module_nets_tile_direct_connection(module_manager, lookup, top_module, circuit_lib, 
                                            vpr_device_annotation,
                                            grids, grid_instance_ids,
                                            tile_direct, tile_direct_id,  
@@ -3,6 +3,11 @@
  * in the top module of FPGA fabric
  *******************************************************************/
 #include <cmath>
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -176,6 +181,114 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
   }
 }
 
+/********************************************************************
+ * Find the number of regions required to split a list of configurable children,
+ * where each region contains consecutive children and 
+ * is limited to a given number of configuration bits
+ *******************************************************************/
+static 
+size_t find_num_configurable_regions_with_capacity(const std::vector<size_t>& child_num_config_bits,
+                                                   const size_t& region_capacity) {
+  size_t num_regions = 1;
+  size_t region_num_config_bits = 0;
+  for (const size_t& num_config_bits : child_num_config_bits) {
+    if (region_num_config_bits + num_config_bits > region_capacity) {
+      num_regions++;
+      region_num_config_bits = 0;
+    }
+    region_num_config_bits += num_config_bits;
+  }
+  return num_regions;
+}
+
+/********************************************************************
+ * Split a list of configurable children into a number of regions,
+ * where each region contains consecutive children, so that
+ * the spatial locality of the children is kept.
+ * The largest number of configuration bits among the regions is minimized,
+ * which determines the number of clock cycles to configure the fabric,
+ * by a binary search on the capacity of regions
+ *
+ * Return the number of children in each region
+ *******************************************************************/
+static 
+std::vector<size_t> find_balanced_configurable_region_sizes(const std::vector<size_t>& child_num_config_bits,
+                                                            const size_t& num_regions) {
+  VTR_ASSERT(num_regions <= child_num_config_bits.size());
+
+  size_t min_capacity = 0;
+  size_t max_capacity = 0;
+  for (const size_t& num_config_bits : child_num_config_bits) {
+    min_capacity = std::max(min_capacity, num_config_bits);
+    max_capacity += num_config_bits;
+  }
+
+  /* Find the smallest capacity which requires no more than the given number of regions */
+  while (min_capacity < max_capacity) {
+    size_t capacity = min_capacity + (max_capacity - min_capacity) / 2;
+    if (find_num_configurable_regions_with_capacity(child_num_config_bits, capacity) <= num_regions) {
+      max_capacity = capacity;
+    } else {
+      min_capacity = capacity + 1;
+    }
+  }
+
+  /* Fill the regions in order until the capacity is reached,
+   * while leaving at least one child for each of the remaining regions.
+   * The last region takes all the remaining children
+   */
+  std::vector<size_t> region_sizes(num_regions, 0);
+  size_t ichild = 0;
+  for (size_t iregion = 0; iregion < num_regions - 1; ++iregion) {
+    size_t region_num_config_bits = 0;
+    while (child_num_config_bits.size() - ichild > num_regions - iregion - 1) {
+      if ( (0 < region_sizes[iregion])
+        && (region_num_config_bits + child_num_config_bits[ichild] > max_capacity) ) {
+        break;
+      }
+      region_num_config_bits += child_num_config_bits[ichild];
+      region_sizes[iregion]++;
+      ichild++;
+    }
+  }
+  region_sizes.back() = child_num_config_bits.size() - ichild;
+
+  return region_sizes;
+}
+
+/********************************************************************
+ * Split a list of configurable children into a number of regions,
+ * where each region contains the same number of consecutive children,
+ * except the last region which takes all the remaining children
+ *
+ * Note: the decoders of configuration protocols are excluded
+ * when counting the children for each region
+ *
+ * Return the number of children in each region
+ *******************************************************************/
+static 
+std::vector<size_t> find_even_configurable_region_sizes(const size_t& num_children,
+                                                        const size_t& num_regions,
+                                                        const e_config_protocol_type& config_protocol_type) {
+  VTR_ASSERT(num_regions <= num_children);
+
+  /* Exclude decoders from the list */
+  size_t num_decoders = 0;
+  if (CONFIG_MEM_MEMORY_BANK == config_protocol_type) {
+    num_decoders = 2;
+  } else if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
+    num_decoders = 1;
+  }
+  size_t num_configurable_children = std::max(num_children, num_decoders) - num_decoders;
+
+  /* Each region has at least one child */
+  size_t num_children_per_region = std::max(size_t(1), num_configurable_children / num_regions);
+
+  std::vector<size_t> region_sizes(num_regions, num_children_per_region);
+  region_sizes.back() = num_children - (num_regions - 1) * num_children_per_region;
+
+  return region_sizes;
+}
 
 /********************************************************************
  * Split memory modules into different configurable regions
@@ -212,14 +325,23 @@ void organize_top_module_tile_memory_modules(ModuleManager& module_manager,
  *  | +------+ +------+     |
  *  +-----------------------+
  *
+ * Configurable children are placed in regions in their order,
+ * so that each region covers a continuous part of the fabric.
+ * By default, each region has the same number of children.
+ * When balanced, the regions have close numbers of configuration bits instead
+ *
  * Note:
  *   - This function should NOT modify configurable children
+ *   - Decoders of configuration protocols are added to regions later
  *
  *******************************************************************/
 static  
 void build_top_module_configurable_regions(ModuleManager& module_manager,
                                            const ModuleId& top_module,
-                                           const ConfigProtocol& config_protocol) {
+                                           const CircuitLibrary& circuit_lib,
+                                           const CircuitModelId& sram_model,
+                                           const ConfigProtocol& config_protocol,
+                                           const bool& balance_config_regions) {
 
   vtr::ScopedStartFinishTimer timer("Build configurable regions for the top module");
 
@@ -229,45 +351,67 @@ void build_top_module_configurable_regions(ModuleManager& module_manager,
   /* Ensure that our region definition is valid */
   VTR_ASSERT(1 <= config_protocol.num_regions());
 
-  /* Exclude decoders from the list */
-  size_t num_configurable_children = module_manager.configurable_children(top_module).size();
-  if (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) {
-    num_configurable_children -= 2;
-  } else if (CONFIG_MEM_FRAME_BASED == config_protocol.type()) {
-    num_configurable_children -= 1;
-  }
-
-  /* Evenly place each configurable child to each region */
-  size_t num_children_per_region = num_configurable_children / config_protocol.num_regions(); 
-  size_t region_child_counter = 0;
-  bool create_region = true;
-  ConfigRegionId curr_region = ConfigRegionId::INVALID();
-  for (size_t ichild = 0; ichild < module_manager.configurable_children(top_module).size(); ++ichild) {
-    if (true == create_region) {
-      curr_region = module_manager.add_config_region(top_module);
+  const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(top_module);
+  const std::vector<size_t>& configurable_child_instances = module_manager.configurable_child_instances(top_module);
+
+  /* Find the number of configuration bits of each child, which is shared by the instances of a module */
+  vtr::vector<ModuleId, size_t> module_num_config_bits(module_manager.num_modules(), size_t(-1));
+  std::vector<size_t> child_num_config_bits;
+  child_num_config_bits.reserve(configurable_children.size());
+  for (const ModuleId& child : configurable_children) {
+    if (size_t(-1) == module_num_config_bits[child]) {
+      module_num_config_bits[child] = find_module_num_config_bits(module_manager, child,
+                                                                  circuit_lib, sram_model,
+                                                                  config_protocol.type());
     }
+    child_num_config_bits.push_back(module_num_config_bits[child]);
+  }
 
-    /* Add the child to a region */
-    module_manager.add_configurable_child_to_region(top_module,
-                                                    curr_region,
-                                                    module_manager.configurable_children(top_module)[ichild],
-                                                    module_manager.configurable_child_instances(top_module)[ichild],
-                                                    ichild);
+  std::vector<size_t> region_sizes;
+  if (true == balance_config_regions) {
+    region_sizes = find_balanced_configurable_region_sizes(child_num_config_bits, config_protocol.num_regions());
+  } else {
+    region_sizes = find_even_configurable_region_sizes(configurable_children.size(), config_protocol.num_regions(), config_protocol.type());
+  }
 
-    /* See if the current region is full or not:
-     * For the last region, we will keep adding until we finish all the children 
-     */
-    region_child_counter++;
-    if (region_child_counter < num_children_per_region) {
-      create_region = false;
-    } else if (size_t(curr_region) < (size_t)config_protocol.num_regions() - 1) {
-      create_region = true;
-      region_child_counter = 0;
+  size_t ichild = 0;
+  size_t max_region_num_config_bits = 0;
+  size_t min_region_num_config_bits = size_t(-1);
+  for (const size_t& region_size : region_sizes) {
+    ConfigRegionId curr_region = module_manager.add_config_region(top_module);
+    size_t region_num_config_bits = 0;
+    for (size_t ichild_in_region = 0; ichild_in_region < region_size; ++ichild_in_region) {
+      /* Add the child to a region */
+      module_manager.add_configurable_child_to_region(top_module,
+                                                      curr_region,
+                                                      configurable_children[ichild],
+                                                      configurable_child_instances[ichild],
+                                                      ichild);
+      region_num_config_bits += child_num_config_bits[ichild];
+      ichild++;
     }
+    max_region_num_config_bits = std::max(max_region_num_config_bits, region_num_config_bits);
+    min_region_num_config_bits = std::min(min_region_num_config_bits, region_num_config_bits);
   }
+  VTR_ASSERT(configurable_children.size() == ichild);
 
   /* Ensure that the number of configurable regions created matches the definition */
   VTR_ASSERT((size_t)config_protocol.num_regions() == module_manager.regions(top_module).size());
+
+  VTR_LOG("Split %lu configuration bits among %lu regions (%lu to %lu bits per region)\n",
+          std::accumulate(child_num_config_bits.begin(), child_num_config_bits.end(), size_t(0)),
+          region_sizes.size(),
+          min_region_num_config_bits,
+          max_region_num_config_bits);
+
+  /* For configuration chains, the configuration time is limited by the longest regional bitstream,
+   * plus one clock cycle to reset, without fast configuration.
+   * Other protocols are limited by the addresses rather than the bits of regions
+   */
+  if (CONFIG_MEM_SCAN_CHAIN == config_protocol.type()) {
+    VTR_LOG("Configuration chains require %lu configuration clock cycles\n",
+            1 + max_region_num_config_bits);
+  }
 }
 
 /********************************************************************
@@ -374,7 +518,8 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
                                         const vtr::Matrix<size_t>& sb_instance_ids,
                                         const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-                                        const bool& compact_routing_hierarchy) {
+                                        const bool& compact_routing_hierarchy,
+                                        const bool& balance_config_regions) {
 
   /* Ensure clean vectors to return */
   VTR_ASSERT(true == module_manager.configurable_children(top_module).empty());
@@ -464,7 +609,7 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
   }
 
   /* Split memory modules into different regions */
-  build_top_module_configurable_regions(module_manager, top_module, config_protocol);  
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib, sram_model, config_protocol, balance_config_regions);  
 }
 
 
@@ -483,7 +628,10 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
  ********************************************************************/
 void shuffle_top_module_configurable_children(ModuleManager& module_manager, 
                                               const ModuleId& top_module,
-                                              const ConfigProtocol& config_protocol) {
+                                              const CircuitLibrary& circuit_lib,
+                                              const CircuitModelId& sram_model,
+                                              const ConfigProtocol& config_protocol,
+                                              const bool& balance_config_regions) {
   size_t num_keys = module_manager.configurable_children(top_module).size();
   std::vector<size_t> shuffled_keys;
   shuffled_keys.reserve(num_keys);
@@ -508,7 +656,30 @@ void shuffle_top_module_configurable_children(ModuleManager& module_manager,
 
   /* Reset configurable regions */
   module_manager.clear_config_region(top_module);
-  build_top_module_configurable_regions(module_manager, top_module, config_protocol);  
+  build_top_module_configurable_regions(module_manager, top_module, circuit_lib, sram_model, config_protocol, balance_config_regions);  
+}
+
+/********************************************************************
+ * Build a fast look-up from the names of the child instances of 
+ * the top-level module to their module and instance ids.
+ * Only named instances are indexed. If two instances have the same name,
+ * the first one in the child list is kept, the same as
+ * find_module_manager_instance_module_info() does
+ ********************************************************************/
+static 
+std::unordered_map<std::string, std::pair<ModuleId, size_t>> build_top_module_instance_name_lookup(const ModuleManager& module_manager,
+                                                                                                    const ModuleId& top_module) {
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>> instance_name_lookup;
+  for (const ModuleId& child : module_manager.child_modules(top_module)) {
+    for (const size_t& child_instance : module_manager.child_module_instances(top_module, child)) {
+      std::string instance_name = module_manager.instance_name(top_module, child, child_instance);
+      if (true == instance_name.empty()) {
+        continue;
+      }
+      instance_name_lookup.insert(std::make_pair(instance_name, std::make_pair(child, child_instance)));
+    }
+  }
+  return instance_name_lookup;
 }
 
 /********************************************************************
@@ -531,6 +702,25 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
 
   size_t curr_configurable_child_id = 0;
 
+  /* Index the instance names only when there are keys with alias only,
+   * which would otherwise search through all the child modules
+   */
+  bool require_instance_name_lookup = false;
+  for (const FabricKeyId& key : fabric_key.keys()) {
+    if ( (!fabric_key.key_alias(key).empty())
+      && (fabric_key.key_name(key).empty()) ) {
+      require_instance_name_lookup = true;
+      break;
+    }
+  }
+  std::unordered_map<std::string, std::pair<ModuleId, size_t>> instance_name_lookup;
+  if (true == require_instance_name_lookup) {
+    instance_name_lookup = build_top_module_instance_name_lookup(module_manager, top_module);
+  }
+
+  /* The number of configuration bits of each child module, which is found on the first use */
+  vtr::vector<ModuleId, size_t> module_num_config_bits(module_manager.num_modules(), size_t(-1));
+
   for (const FabricRegionId& region : fabric_key.regions()) {
     /* Create a configurable region in the top module */
     ConfigRegionId top_module_config_region = module_manager.add_config_region(top_module);
@@ -546,7 +736,13 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
           instance_info.first = module_manager.find_module(fabric_key.key_name(key));
           instance_info.second = module_manager.instance_id(top_module, instance_info.first, fabric_key.key_alias(key));
         } else {
-          instance_info = find_module_manager_instance_module_info(module_manager, top_module, fabric_key.key_alias(key)); 
+          auto result = instance_name_lookup.find(fabric_key.key_alias(key));
+          if (result != instance_name_lookup.end()) {
+            instance_info = result->second;
+          } else {
+            /* Names which are not generated by the module manager may still be parsed */
+            instance_info = find_module_manager_instance_module_info(module_manager, top_module, fabric_key.key_alias(key)); 
+          }
         }
       } else { 
         /* If we do not have an alias, we use the name and value to build the info deck */
@@ -577,9 +773,12 @@ int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager
       }
 
       /* If the the child has not configuration bits, error out */
-      if (0 == find_module_num_config_bits(module_manager, instance_info.first,
-                                           circuit_lib, config_protocol.memory_model(), 
-                                           config_protocol.type())) {
+      if (size_t(-1) == module_num_config_bits[instance_info.first]) {
+        module_num_config_bits[instance_info.first] = find_module_num_config_bits(module_manager, instance_info.first,
+                                                                                  circuit_lib, config_protocol.memory_model(), 
+                                                                                  config_protocol.type());
+      }
+      if (0 == module_num_config_bits[instance_info.first]) {
         if (!fabric_key.key_alias(key).empty()) {
           VTR_LOG_ERROR("Invalid key alias '%s' which has zero configuration bits!\n",
                         fabric_key.key_alias(key).c_str()); 
@@ -1049,7 +1248,6 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
     BasicPort wl_decoder_en_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_en_port);
 
     ModulePortId wl_decoder_addr_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-    BasicPort wl_decoder_addr_port_info = module_manager.module_port(wl_decoder_module, bl_decoder_addr_port);
 
     /* Top module Enable port -> WL Decoder Enable port */
     add_module_bus_nets(module_manager,
@@ -1063,80 +1261,107 @@ void add_top_module_nets_cmos_memory_bank_config_bus(ModuleManager& module_manag
                         top_module, 0, wl_addr_port,
                         wl_decoder_module, curr_wl_decoder_instance_id, wl_decoder_addr_port);
 
-    /************************************************************** 
-     * Add nets from BL data out to each configurable child
-     */
-    size_t cur_bl_index = 0;
+    std::vector<ModuleId> region_configurable_children = module_manager.region_configurable_children(top_module, config_region);
+    std::vector<size_t> region_configurable_child_instances = module_manager.region_configurable_child_instances(top_module, config_region);
 
     ModulePortId bl_decoder_dout_port = module_manager.find_module_port(bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
     BasicPort bl_decoder_dout_port_info = module_manager.module_port(bl_decoder_module, bl_decoder_dout_port);
 
-    for (size_t child_id = 0; child_id < module_manager.region_configurable_children(top_module, config_region).size(); ++child_id) {
-      ModuleId child_module = module_manager.region_configurable_children(top_module, config_region)[child_id];
-      size_t child_instance = module_manager.region_configurable_child_instances(top_module, config_region)[child_id];
-
-      /* Find the BL port */
-      ModulePortId child_bl_port = module_manager.find_module_port(child_module, std::string(MEMORY_BL_PORT_NAME));
-      BasicPort child_bl_port_info = module_manager.module_port(child_module, child_bl_port);
+    ModulePortId wl_decoder_dout_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
+    BasicPort wl_decoder_dout_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_dout_port);
 
-      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
-        /* Find the BL decoder data index: 
-         * It should be the residual when divided by the number of BLs
-         */
-        size_t bl_pin_id = std::floor(cur_bl_index / num_bls);
-        if (!(bl_pin_id < bl_decoder_dout_port_info.pins().size()))
-          VTR_ASSERT(bl_pin_id < bl_decoder_dout_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                       bl_decoder_module, curr_bl_decoder_instance_id,
-                                                       bl_decoder_dout_port,
-                                                       bl_decoder_dout_port_info.pins()[bl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net,
-                                           child_module, child_instance, child_bl_port, sink_bl_pin);
-
-        /* Increment the BL index */
-        cur_bl_index++;
+    /************************************************************** 
+     * Plan the nets from BL/WL data out to configurable children
+     * Each data output of the decoders drives a net,
+     * which fans out to many BLs/WLs of configurable children.
+     * The BLs/WLs of the region are numbered in the order of configurable children,
+     * so the range of each child is found from the port widths of the child,
+     * and the decoder output driving each BL/WL is found arithmetically
+     *  - the i-th BL is driven by the (i / num_bls)-th BL decoder output
+     *  - the i-th WL is driven by the (i % num_wls)-th WL decoder output
+     * The BL/WL ports of a child module are only searched once, 
+     * as many configurable children are instances of the same module
+     */
+    std::map<ModuleId, std::array<ModulePortId, 2>> child_bl_wl_ports;
+    std::vector<std::array<BasicPort, 2>> child_bl_wl_port_info;
+    child_bl_wl_port_info.reserve(region_configurable_children.size());
+    size_t num_region_bls = 0;
+    size_t num_region_wls = 0;
+    for (size_t child_id = 0; child_id < region_configurable_children.size(); ++child_id) {
+      ModuleId child_module = region_configurable_children[child_id];
+      auto result = child_bl_wl_ports.find(child_module);
+      if (result == child_bl_wl_ports.end()) {
+        std::array<ModulePortId, 2> bl_wl_ports = {{module_manager.find_module_port(child_module, std::string(MEMORY_BL_PORT_NAME)),
+                                                    module_manager.find_module_port(child_module, std::string(MEMORY_WL_PORT_NAME))}};
+        result = child_bl_wl_ports.emplace(child_module, bl_wl_ports).first;
       }
+      child_bl_wl_port_info.push_back({{module_manager.module_port(child_module, result->second[0]),
+                                        module_manager.module_port(child_module, result->second[1])}});
+      num_region_bls += child_bl_wl_port_info.back()[0].get_width();
+      num_region_wls += child_bl_wl_port_info.back()[1].get_width();
     }
 
-    /************************************************************** 
-     * Add nets from WL data out to each configurable child
-     */
-    size_t cur_wl_index = 0;
+    /* Create the nets driven by the decoder outputs, each of which has its sinks reserved */
+    size_t num_bl_nets = (0 == num_region_bls) ? 0 : (num_region_bls + num_bls - 1) / num_bls;
+    size_t num_wl_nets = std::min(num_region_wls, num_wls);
+    VTR_ASSERT(num_bl_nets <= bl_decoder_dout_port_info.get_width());
+    VTR_ASSERT(num_wl_nets <= wl_decoder_dout_port_info.get_width());
+    reserve_module_manager_additional_module_nets(module_manager, top_module, num_bl_nets + num_wl_nets);
+
+    std::vector<ModuleNetId> bl_nets(num_bl_nets, ModuleNetId::INVALID());
+    for (size_t bl_pin_id = 0; bl_pin_id < num_bl_nets; ++bl_pin_id) {
+      /* Create net, which drives the next num_bls BLs */
+      bl_nets[bl_pin_id] = create_module_source_pin_net(module_manager, top_module,
+                                                        bl_decoder_module, curr_bl_decoder_instance_id,
+                                                        bl_decoder_dout_port,
+                                                        bl_decoder_dout_port_info.get_lsb() + bl_pin_id,
+                                                        std::min(num_bls, num_region_bls - bl_pin_id * num_bls));
+      VTR_ASSERT(ModuleNetId::INVALID() != bl_nets[bl_pin_id]);
+    }
 
-    ModulePortId wl_decoder_dout_port = module_manager.find_module_port(wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-    BasicPort wl_decoder_dout_port_info = module_manager.module_port(wl_decoder_module, wl_decoder_dout_port);
+    std::vector<ModuleNetId> wl_nets(num_wl_nets, ModuleNetId::INVALID());
+    for (size_t wl_pin_id = 0; wl_pin_id < num_wl_nets; ++wl_pin_id) {
+      /* Create net, which drives every num_wls-th WL */
+      wl_nets[wl_pin_id] = create_module_source_pin_net(module_manager, top_module,
+                                                        wl_decoder_module, curr_wl_decoder_instance_id,
+                                                        wl_decoder_dout_port,
+                                                        wl_decoder_dout_port_info.get_lsb() + wl_pin_id,
+                                                        (num_region_wls - wl_pin_id + num_wls - 1) / num_wls);
+      VTR_ASSERT(ModuleNetId::INVALID() != wl_nets[wl_pin_id]);
+    }
 
-    for (size_t child_id = 0; child_id < module_manager.region_configurable_children(top_module, config_region).size(); ++child_id) {
-      ModuleId child_module = module_manager.region_configurable_children(top_module, config_region)[child_id];
-      size_t child_instance = module_manager.region_configurable_child_instances(top_module, config_region)[child_id];
+    /************************************************************** 
+     * Add the BLs of each configurable child as sinks of the BL nets
+     */
+    size_t cur_bl_index = 0;
 
-      /* Find the WL port */
-      ModulePortId child_wl_port = module_manager.find_module_port(child_module, std::string(MEMORY_WL_PORT_NAME));
-      BasicPort child_wl_port_info = module_manager.module_port(child_module, child_wl_port);
+    for (size_t child_id = 0; child_id < region_configurable_children.size(); ++child_id) {
+      ModuleId child_module = region_configurable_children[child_id];
+      size_t child_instance = region_configurable_child_instances[child_id];
+      ModulePortId child_bl_port = child_bl_wl_ports.at(child_module)[0];
+      const BasicPort& child_bl_port_info = child_bl_wl_port_info[child_id][0];
 
-      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
-        /* Find the BL decoder data index: 
-         * It should be the residual when divided by the number of BLs
-         */
-        size_t wl_pin_id = cur_wl_index % num_wls;
+      for (size_t ipin = 0; ipin < child_bl_port_info.get_width(); ++ipin) {
+        module_manager.add_module_net_sink(top_module, bl_nets[cur_bl_index / num_bls],
+                                           child_module, child_instance, child_bl_port, child_bl_port_info.get_lsb() + ipin);
+        cur_bl_index++;
+      }
+    }
 
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(module_manager, top_module,
-                                                       wl_decoder_module, curr_wl_decoder_instance_id,
-                                                       wl_decoder_dout_port,
-                                                       wl_decoder_dout_port_info.pins()[wl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
+    /************************************************************** 
+     * Add the WLs of each configurable child as sinks of the WL nets
+     */
+    size_t cur_wl_index = 0;
 
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net,
-                                           child_module, child_instance, child_wl_port, sink_wl_pin);
+    for (size_t child_id = 0; child_id < region_configurable_children.size(); ++child_id) {
+      ModuleId child_module = region_configurable_children[child_id];
+      size_t child_instance = region_configurable_child_instances[child_id];
+      ModulePortId child_wl_port = child_bl_wl_ports.at(child_module)[1];
+      const BasicPort& child_wl_port_info = child_bl_wl_port_info[child_id][1];
 
-        /* Increment the WL index */
+      for (size_t ipin = 0; ipin < child_wl_port_info.get_width(); ++ipin) {
+        module_manager.add_module_net_sink(top_module, wl_nets[cur_wl_index % num_wls],
+                                           child_module, child_instance, child_wl_port, child_wl_port_info.get_lsb() + ipin);
         cur_wl_index++;
       }
     }
@@ -1190,8 +1415,17 @@ static
 void add_top_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_manager,
                                                       const ModuleId& parent_module,
                                                       const ConfigProtocol& config_protocol) {
+  /* Each region has a net per configurable child plus the net to the chain tail */
+  size_t num_chain_nets = 0;
+  for (const ConfigRegionId& config_region : module_manager.regions(parent_module)) {
+    num_chain_nets += module_manager.region_configurable_children(parent_module, config_region).size() + 1;
+  }
+  reserve_module_manager_additional_module_nets(module_manager, parent_module, num_chain_nets);
+
   for (const ConfigRegionId& config_region : module_manager.regions(parent_module)) {
-    for (size_t mem_index = 0; mem_index < module_manager.region_configurable_children(parent_module, config_region).size(); ++mem_index) {
+    std::vector<ModuleId> region_configurable_children = module_manager.region_configurable_children(parent_module, config_region);
+    std::vector<size_t> region_configurable_child_instances = module_manager.region_configurable_child_instances(parent_module, config_region);
+    for (size_t mem_index = 0; mem_index < region_configurable_children.size(); ++mem_index) {
       ModuleId net_src_module_id;
       size_t net_src_instance_id;
       ModulePortId net_src_port_id;
@@ -1212,22 +1446,22 @@ void add_top_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_mana
 
         /* Find the port name of next memory module */
         std::string sink_port_name = generate_configuration_chain_head_name();
-        net_sink_module_id = module_manager.region_configurable_children(parent_module, config_region)[mem_index]; 
-        net_sink_instance_id = module_manager.region_configurable_child_instances(parent_module, config_region)[mem_index];
+        net_sink_module_id = region_configurable_children[mem_index]; 
+        net_sink_instance_id = region_configurable_child_instances[mem_index];
         net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
         net_sink_pin_id = 0;
       } else {
         /* Find the port name of previous memory module */
         std::string src_port_name = generate_configuration_chain_tail_name();
-        net_src_module_id = module_manager.region_configurable_children(parent_module, config_region)[mem_index - 1]; 
-        net_src_instance_id = module_manager.region_configurable_child_instances(parent_module, config_region)[mem_index - 1];
+        net_src_module_id = region_configurable_children[mem_index - 1]; 
+        net_src_instance_id = region_configurable_child_instances[mem_index - 1];
         net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
         net_src_pin_id = 0;
 
         /* Find the port name of next memory module */
         std::string sink_port_name = generate_configuration_chain_head_name();
-        net_sink_module_id = module_manager.region_configurable_children(parent_module, config_region)[mem_index]; 
-        net_sink_instance_id = module_manager.region_configurable_child_instances(parent_module, config_region)[mem_index];
+        net_sink_module_id = region_configurable_children[mem_index]; 
+        net_sink_instance_id = region_configurable_child_instances[mem_index];
         net_sink_port_id = module_manager.find_module_port(net_sink_module_id, sink_port_name); 
         net_sink_pin_id = 0;
       }
@@ -1252,8 +1486,8 @@ void add_top_module_nets_cmos_memory_chain_config_bus(ModuleManager& module_mana
      */
     /* Find the port name of previous memory module */
     std::string src_port_name = generate_configuration_chain_tail_name();
-    ModuleId net_src_module_id = module_manager.region_configurable_children(parent_module, config_region).back(); 
-    size_t net_src_instance_id = module_manager.region_configurable_child_instances(parent_module, config_region).back();
+    ModuleId net_src_module_id = region_configurable_children.back(); 
+    size_t net_src_instance_id = region_configurable_child_instances.back();
     ModulePortId net_src_port_id = module_manager.find_module_port(net_src_module_id, src_port_name); 
     size_t net_src_pin_id = 0;
 
@@ -1450,6 +1684,29 @@ void add_top_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& mod
   size_t decoder_instance = module_manager.num_instance(parent_module, decoder_module);
   module_manager.add_child_module(parent_module, decoder_module);
 
+  /* Plan the nets driven by the address port of the parent module:
+   * The first few bits drive the address port of the decoder and
+   * the last few bits drive the address ports of all the configurable children.
+   * Count the sinks of each address bit first, so that the high fan-out nets
+   * are allocated in one step
+   */
+  ModulePortId decoder_addr_port = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+  BasicPort decoder_addr_port_info = module_manager.module_port(decoder_module, decoder_addr_port);
+  std::vector<size_t> parent_addr_pin_num_sinks(parent_addr_port_info.get_width(), 0);
+  for (size_t ipin = 0; ipin < decoder_addr_port_info.get_width(); ++ipin) {
+    parent_addr_pin_num_sinks[parent_addr_port_info.get_width() - 1 - ipin]++;
+  }
+  for (size_t mem_index = 0; mem_index < configurable_children.size(); ++mem_index) {
+    ModuleId child_module = configurable_children[mem_index]; 
+    ModulePortId child_addr_port = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    for (size_t ipin = 0; ipin < module_manager.module_port(child_module, child_addr_port).get_width(); ++ipin) {
+      parent_addr_pin_num_sinks[ipin]++;
+    }
+  }
+  /* Other nets include address bits, the data_in and an enable signal per child */
+  size_t num_addr_nets = parent_addr_port_info.get_width() - std::count(parent_addr_pin_num_sinks.begin(), parent_addr_pin_num_sinks.end(), 0);
+  reserve_module_manager_additional_module_nets(module_manager, parent_module, num_addr_nets + 1 + configurable_children.size());
+
   /* Connect the enable (EN) port of memory modules under the parent module
    * to the frame decoder inputs
    */
@@ -1462,14 +1719,13 @@ void add_top_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& mod
   /* Connect the address port of the parent module to the frame decoder address port
    * Note that we only connect to the first few bits of address port
    */
-  ModulePortId decoder_addr_port = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-  BasicPort decoder_addr_port_info = module_manager.module_port(decoder_module, decoder_addr_port);
   for (size_t ipin = 0; ipin < decoder_addr_port_info.get_width(); ++ipin) {
     /* Create a net for the addr pin */
     ModuleNetId addr_net = create_module_source_pin_net(module_manager, parent_module, 
                                                         parent_module, 0, 
                                                         parent_addr_port,
-                                                        parent_addr_port_info.pins()[parent_addr_port_info.get_width() - 1 - ipin]);
+                                                        parent_addr_port_info.pins()[parent_addr_port_info.get_width() - 1 - ipin],
+                                                        parent_addr_pin_num_sinks[parent_addr_port_info.get_width() - 1 - ipin]);
     VTR_ASSERT(ModuleNetId::INVALID() != addr_net);
 
     /* Configure the net sink */
@@ -1491,7 +1747,8 @@ void add_top_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& mod
       ModuleNetId addr_net = create_module_source_pin_net(module_manager, parent_module, 
                                                           parent_module, 0, 
                                                           parent_addr_port,
-                                                          parent_addr_port_info.pins()[ipin]);
+                                                          parent_addr_port_info.pins()[ipin],
+                                                          parent_addr_pin_num_sinks[ipin]);
       VTR_ASSERT(ModuleNetId::INVALID() != addr_net);
 
       /* Configure the net sink */
@@ -1521,7 +1778,8 @@ void add_top_module_nets_cmos_memory_frame_decoder_config_bus(ModuleManager& mod
     ModuleNetId din_net = create_module_source_pin_net(module_manager, parent_module, 
                                                        parent_module, 0, 
                                                        parent_din_port,
-                                                       parent_din_port_info.pins()[size_t(config_region)]);
+                                                       parent_din_port_info.pins()[size_t(config_region)],
+                                                       configurable_children.size());
     VTR_ASSERT(ModuleNetId::INVALID() != din_net);
 
     /* Configure the net sink */
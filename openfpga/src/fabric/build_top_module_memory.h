@@ -36,11 +36,15 @@ void organize_top_module_memory_modules(ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
                                         const vtr::Matrix<size_t>& sb_instance_ids,
                                         const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-                                        const bool& compact_routing_hierarchy);
+                                        const bool& compact_routing_hierarchy,
+                                        const bool& balance_config_regions);
 
 void shuffle_top_module_configurable_children(ModuleManager& module_manager, 
                                               const ModuleId& top_module,
-                                              const ConfigProtocol& config_protocol);
+                                              const CircuitLibrary& circuit_lib,
+                                              const CircuitModelId& sram_model,
+                                              const ConfigProtocol& config_protocol,
+                                              const bool& balance_config_regions);
 
 int load_top_module_memory_modules_from_fabric_key(ModuleManager& module_manager,
                                                    const ModuleId& top_module,
@@ -1,6 +1,9 @@
 /***************************************************************************************
  * Output internal structure of Module Graph hierarchy to file formats
  ***************************************************************************************/
+#include <string>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -16,21 +19,29 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Size of the buffer to be filled before flushing to the file */
+constexpr size_t HIERARCHY_WRITER_BUFFER_SIZE = 1 << 20;
+
 /***************************************************************************************
- * Recursively output child module of the parent_module to a text file
+ * Output child module of the parent_module to a text file
  * We use Depth-First Search (DFS) here so that we can output a tree down to leaf first
  * Add space (indent) based on the depth in hierarchy
  * e.g. depth = 1 means a space as indent
+ *
+ * The DFS uses an explicit stack rather than recursion, where each entry is
+ * the child list of a module and the index of the next child to visit,
+ * so that deep hierarchies do not grow the call stack.
+ * Outputs are collected in a buffer which is flushed in large blocks
  ***************************************************************************************/
 static 
-int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
-                                             const size_t& hie_depth_to_stop,
-                                             const size_t& current_hie_depth,
-                                             const ModuleManager& module_manager,  
-                                             const ModuleId& parent_module,
-                                             const bool& verbose) {
+int output_module_hierarchy_to_text_file(std::fstream& fp,
+                                         const size_t& hie_depth_to_stop,
+                                         const size_t& start_hie_depth,
+                                         const ModuleManager& module_manager,  
+                                         const ModuleId& parent_module,
+                                         const bool& verbose) {
   /* Stop if hierarchy depth is beyond the stop line */
-  if (hie_depth_to_stop < current_hie_depth) {
+  if (hie_depth_to_stop < start_hie_depth) {
     return 0;
   }
 
@@ -38,43 +49,70 @@ int rec_output_module_hierarchy_to_text_file(std::fstream& fp,
     return 2;
   }
 
-  /* Iterate over all the child module */
-  for (const ModuleId& child_module : module_manager.child_modules(parent_module)) {
-    if (false == write_space_to_file(fp, current_hie_depth * 2)) {
-      return 2;
+  std::string buffer;
+  buffer.reserve(HIERARCHY_WRITER_BUFFER_SIZE + 1024);
+
+  /* The depth of a stack entry is the start depth plus its index in the stack */
+  std::vector<std::pair<const std::vector<ModuleId>*, size_t>> stack;
+  stack.push_back(std::make_pair(&module_manager.child_modules(parent_module), 0));
+
+  while (false == stack.empty()) {
+    const std::vector<ModuleId>& child_modules = *stack.back().first;
+    size_t& child_index = stack.back().second;
+    size_t current_hie_depth = start_hie_depth + stack.size() - 1;
+
+    /* All the child modules have been visited, go back to upper level */
+    if (child_index == child_modules.size()) {
+      stack.pop_back();
+      continue;
     }
 
+    const ModuleId& child_module = child_modules[child_index];
+    ++child_index;
+
+    buffer.append(current_hie_depth * 2, ' ');
+
     if (true != module_manager.valid_module_id(child_module)) {
+      fp << buffer;
       VTR_LOGV_ERROR(verbose,
                      "Unable to find the child module '%u'!\n",
                      size_t(child_module));
       return 1;
     }
 
-    fp << "- ";
-    fp << module_manager.module_name(child_module);
+    buffer += "- ";
+    buffer += module_manager.module_name(child_module);
 
     /* If this is the leaf node, we leave a new line 
      * Otherwise, we will leave a ':' to be compatible to YAML file format 
      */
-    if ( (0 != module_manager.child_modules(child_module).size())
-      && (hie_depth_to_stop >= current_hie_depth + 1) ) {
-      fp << ":";
+    const std::vector<ModuleId>& grandchild_modules = module_manager.child_modules(child_module);
+    bool go_next_level = (0 != grandchild_modules.size())
+                      && (hie_depth_to_stop >= current_hie_depth + 1);
+    if (true == go_next_level) {
+      buffer += ":";
+    }
+    buffer += "\n";
+
+    if (HIERARCHY_WRITER_BUFFER_SIZE <= buffer.size()) {
+      fp << buffer;
+      buffer.clear();
+      if (false == valid_file_stream(fp)) {
+        return 2;
+      }
     }
-    fp << "\n";
 
     /* Go to next level */
-    int status = rec_output_module_hierarchy_to_text_file(fp,
-                                                          hie_depth_to_stop,
-                                                          current_hie_depth + 1, /* Increment the depth for the next level */
-                                                          module_manager,
-                                                          child_module,
-                                                          verbose);
-    if (0 != status) {
-      return status;
+    if (true == go_next_level) {
+      stack.push_back(std::make_pair(&grandchild_modules, 0));
     }
   }
 
+  fp << buffer;
+  if (false == valid_file_stream(fp)) {
+    return 2;
+  }
+
   return 0;
 }
 
@@ -134,13 +172,13 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
 
   fp << top_module_name << ":" << "\n";
 
-  /* Visit child module recursively and output the hierarchy */
-  int err_code = rec_output_module_hierarchy_to_text_file(fp,
-                                                          hie_depth_to_stop,
-                                                          hie_depth + 1, /* Start with level 1 */
-                                                          module_manager,  
-                                                          top_module,
-                                                          verbose);
+  /* Visit child module in depth-first order and output the hierarchy */
+  int err_code = output_module_hierarchy_to_text_file(fp,
+                                                      hie_depth_to_stop,
+                                                      hie_depth + 1, /* Start with level 1 */
+                                                      module_manager,  
+                                                      top_module,
+                                                      verbose);
 
   /* close a file */
   fp.close();
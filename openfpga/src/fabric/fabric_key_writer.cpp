@@ -1,6 +1,9 @@
 /***************************************************************************************
  * Output fabric key of Module Graph to file formats
  ***************************************************************************************/
+#include <string>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -11,6 +14,7 @@
 
 /* Headers from archopenfpga library */
 #include "write_xml_fabric_key.h"
+#include "binary_fabric_key.h"
 
 #include "openfpga_naming.h"
 
@@ -19,8 +23,22 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Extension of the files to output fabric keys in binary format */
+constexpr char BINARY_FABRIC_KEY_FILE_EXTENSION[] = ".bin";
+
+/***************************************************************************************
+ * Find if a fabric key should be written in binary format by the extension of the file
+ ***************************************************************************************/
+static 
+bool is_binary_fabric_key_file_name(const std::string& fname) {
+  std::string extension(BINARY_FABRIC_KEY_FILE_EXTENSION);
+  return (fname.size() >= extension.size())
+      && (0 == fname.compare(fname.size() - extension.size(), extension.size(), extension));
+}
+
 /***************************************************************************************
  * Write the fabric key of top module to an XML file
+ * or a binary file if the file has an extension of '.bin'
  * We will use the writer API in libfabrickey
  *
  * Return 0 if successful
@@ -65,18 +83,22 @@ int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
   /* Create regions for the keys and load keys by region */
   for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
     FabricRegionId fabric_region = fabric_key.create_region();
-    fabric_key.reserve_region_keys(fabric_region, module_manager.region_configurable_children(top_module, config_region).size());
+    /* Both lists are built on the fly, fetch them once per region */
+    const std::vector<ModuleId> region_children = module_manager.region_configurable_children(top_module, config_region);
+    const std::vector<size_t> region_child_instances = module_manager.region_configurable_child_instances(top_module, config_region);
+    fabric_key.reserve_region_keys(fabric_region, region_children.size());
 
-    for (size_t ichild = 0; ichild < module_manager.region_configurable_children(top_module, config_region).size(); ++ichild) {
-      ModuleId child_module = module_manager.region_configurable_children(top_module, config_region)[ichild];
-      size_t child_instance = module_manager.region_configurable_child_instances(top_module, config_region)[ichild];
+    for (size_t ichild = 0; ichild < region_children.size(); ++ichild) {
+      const ModuleId& child_module = region_children[ichild];
+      const size_t& child_instance = region_child_instances[ichild];
 
       FabricKeyId key = fabric_key.create_key();
       fabric_key.set_key_name(key, module_manager.module_name(child_module));
       fabric_key.set_key_value(key, child_instance);
 
-      if (false == module_manager.instance_name(top_module, child_module, child_instance).empty()) {
-        fabric_key.set_key_alias(key, module_manager.instance_name(top_module, child_module, child_instance));
+      std::string child_instance_name = module_manager.instance_name(top_module, child_module, child_instance);
+      if (false == child_instance_name.empty()) {
+        fabric_key.set_key_alias(key, child_instance_name);
       }
 
       /* Add keys to the region */
@@ -88,8 +110,15 @@ int write_fabric_key_to_xml_file(const ModuleManager& module_manager,
            "Created %lu regions and %lu keys for the top module %s.\n",
            num_regions, num_keys, top_module_name.c_str());
 
-  /* Call the XML writer for fabric key */
-  int err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
+  /* Call the writer for fabric key: 
+   * binary format for files with an extension of '.bin', XML format otherwise
+   */
+  int err_code = 0;
+  if (true == is_binary_fabric_key_file_name(fname)) {
+    err_code = write_binary_fabric_key(fname.c_str(), fabric_key);
+  } else {
+    err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
+  }
 
   return err_code;
 }
@@ -0,0 +1,390 @@
+/********************************************************************
+ * This file includes the functions which read a binary fabric snapshot,
+ * which is written by write_fabric_snapshot_to_binary_file(),
+ * to the module graph and decoder library
+ * The file format is detailed in fabric_snapshot_writer.cpp
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+#include "fabric_snapshot_writer.h"
+#include "fabric_snapshot_reader.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A cursor on the content of a snapshot file
+ * Reading beyond the end of the content will mark the cursor as failed
+ * and return zeros or empty strings
+ *******************************************************************/
+class FabricSnapshotCursor {
+  public: /* Public constructor */
+    explicit FabricSnapshotCursor(const std::string& content)
+      : content_(content), offset_(0), failed_(false) {}
+
+  public: /* Public mutators */
+    uint64_t read_word() {
+      uint64_t word = 0;
+      if ((true == failed_) || (content_.size() - offset_ < sizeof(uint64_t))) {
+        failed_ = true;
+        return word;
+      }
+      std::memcpy(&word, content_.data() + offset_, sizeof(uint64_t));
+      offset_ += sizeof(uint64_t);
+      return word;
+    }
+
+    std::string read_string() {
+      uint64_t length = read_word();
+      if ((true == failed_) || (content_.size() - offset_ < length)) {
+        failed_ = true;
+        return std::string();
+      }
+      std::string str = content_.substr(offset_, length);
+      offset_ += length;
+      return str;
+    }
+
+  public: /* Public accessors */
+    bool failed() const { return failed_; }
+    bool finished() const { return offset_ == content_.size(); }
+
+  private: /* Internal data */
+    const std::string& content_;
+    size_t offset_;
+    bool failed_;
+};
+
+/********************************************************************
+ * Read a terminal of a net and add it to the net
+ * Return false if the terminal is not valid in the module
+ *******************************************************************/
+static
+bool read_fabric_snapshot_net_terminal(FabricSnapshotCursor& cursor,
+                                       ModuleManager& module_manager,
+                                       const ModuleId& module,
+                                       const ModuleNetId& net,
+                                       const bool& is_source) {
+  ModuleId term_module = ModuleId(cursor.read_word());
+  size_t term_instance = cursor.read_word();
+  ModulePortId term_port = ModulePortId(cursor.read_word());
+  size_t term_pin = cursor.read_word();
+
+  if ((true == cursor.failed())
+     || (false == module_manager.valid_module_port_id(term_module, term_port))
+     || ((term_module != module) && (term_instance >= module_manager.num_instance(module, term_module)))
+     || (term_pin >= module_manager.module_port(term_module, term_port).get_width())) {
+    return false;
+  }
+
+  if (true == is_source) {
+    module_manager.add_module_net_source(module, net, term_module, term_instance, term_port, term_pin);
+  } else {
+    module_manager.add_module_net_sink(module, net, term_module, term_instance, term_port, term_pin);
+  }
+  return true;
+}
+
+/********************************************************************
+ * Read the child modules, configurable children, configuration regions
+ * and nets of a module
+ * Return false if the content is not valid
+ *******************************************************************/
+static
+bool read_fabric_snapshot_module_graph(FabricSnapshotCursor& cursor,
+                                       ModuleManager& module_manager,
+                                       const ModuleId& module) {
+  size_t num_children = cursor.read_word();
+  for (size_t ichild = 0; (false == cursor.failed()) && (ichild < num_children); ++ichild) {
+    ModuleId child_module = ModuleId(cursor.read_word());
+    size_t num_instances = cursor.read_word();
+    if ((true == cursor.failed()) || (false == module_manager.valid_module_id(child_module))) {
+      return false;
+    }
+    for (size_t inst = 0; inst < num_instances; ++inst) {
+      module_manager.add_child_module(module, child_module);
+    }
+
+    /* The names generated from coordinates stay generated on demand */
+    std::string coord_prefix = cursor.read_string();
+    size_t num_coord_instances = cursor.read_word();
+    for (size_t icoord = 0; (false == cursor.failed()) && (icoord < num_coord_instances); ++icoord) {
+      size_t inst = cursor.read_word();
+      size_t x = cursor.read_word();
+      size_t y = cursor.read_word();
+      if ((true == cursor.failed()) || (inst >= num_instances) || (size_t(-1) == x)) {
+        return false;
+      }
+      module_manager.set_child_instance_coordinate_name(module, child_module, inst, coord_prefix, vtr::Point<size_t>(x, y));
+    }
+
+    /* Names set explicitly are restored after coordinates, as they have the priority */
+    size_t num_inst_names = cursor.read_word();
+    for (size_t iname = 0; (false == cursor.failed()) && (iname < num_inst_names); ++iname) {
+      size_t inst = cursor.read_word();
+      std::string inst_name = cursor.read_string();
+      if ((true == cursor.failed()) || (inst >= num_instances)) {
+        return false;
+      }
+      module_manager.set_child_instance_name(module, child_module, inst, inst_name);
+    }
+  }
+
+  size_t num_config_children = cursor.read_word();
+  for (size_t ichild = 0; (false == cursor.failed()) && (ichild < num_config_children); ++ichild) {
+    ModuleId child_module = ModuleId(cursor.read_word());
+    size_t child_instance = cursor.read_word();
+    if ((true == cursor.failed())
+       || (false == module_manager.valid_module_id(child_module))
+       || (child_instance >= module_manager.num_instance(module, child_module))) {
+      return false;
+    }
+    module_manager.add_configurable_child(module, child_module, child_instance);
+  }
+
+  size_t num_regions = cursor.read_word();
+  for (size_t iregion = 0; (false == cursor.failed()) && (iregion < num_regions); ++iregion) {
+    ConfigRegionId region = module_manager.add_config_region(module);
+    size_t num_region_children = cursor.read_word();
+    for (size_t ichild = 0; (false == cursor.failed()) && (ichild < num_region_children); ++ichild) {
+      size_t config_child_id = cursor.read_word();
+      if ((true == cursor.failed())
+         || (config_child_id >= module_manager.configurable_children(module).size())) {
+        return false;
+      }
+      module_manager.add_configurable_child_to_region(module, region,
+                                                      module_manager.configurable_children(module)[config_child_id],
+                                                      module_manager.configurable_child_instances(module)[config_child_id],
+                                                      config_child_id);
+    }
+  }
+
+  size_t num_nets = cursor.read_word();
+  for (size_t inet = 0; (false == cursor.failed()) && (inet < num_nets); ++inet) {
+    std::string net_name = cursor.read_string();
+    size_t num_sources = cursor.read_word();
+    size_t num_sinks = cursor.read_word();
+    if (true == cursor.failed()) {
+      return false;
+    }
+    ModuleNetId net = module_manager.create_module_net(module);
+    module_manager.set_net_name(module, net, net_name);
+    for (size_t isrc = 0; isrc < num_sources; ++isrc) {
+      if (false == read_fabric_snapshot_net_terminal(cursor, module_manager, module, net, true)) {
+        return false;
+      }
+    }
+    for (size_t isink = 0; isink < num_sinks; ++isink) {
+      if (false == read_fabric_snapshot_net_terminal(cursor, module_manager, module, net, false)) {
+        return false;
+      }
+    }
+  }
+
+  return false == cursor.failed();
+}
+
+/********************************************************************
+ * Read a binary fabric snapshot or configuration layout
+ * to the module graph and decoder library
+ * The file is loaded only if its id matches the given one,
+ * otherwise the databases are not touched, so that the caller can
+ * build the fabric from scratch
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the file can not be loaded
+ *******************************************************************/
+static
+int read_fabric_snapshot_file(ModuleManager& module_manager,
+                              DecoderLibrary& decoder_lib,
+                              const std::string& fabric_id,
+                              const bool& is_layout,
+                              const std::string& fname,
+                              uint64_t& flags,
+                              const bool& verbose) {
+  std::string file_type = (false == is_layout) ? std::string("fabric snapshot") : std::string("configuration layout");
+  std::string timer_message = std::string("Read ") + file_type + std::string(" from binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Load the file */
+  std::ifstream fp(fname, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    VTR_LOG_WARN("Unable to open %s file '%s'!\n",
+                 file_type.c_str(), fname.c_str());
+    return 1;
+  }
+  std::string content(fp.tellg(), '\0');
+  fp.seekg(0);
+  fp.read(&content[0], content.size());
+  if (!fp.good()) {
+    VTR_LOG_WARN("Fail to read %s file '%s'!\n",
+                 file_type.c_str(), fname.c_str());
+    return 1;
+  }
+  fp.close();
+
+  /* Check the header */
+  FabricSnapshotCursor cursor(content);
+  uint64_t magic = cursor.read_word();
+  if ((true == cursor.failed())
+     || (0 != std::memcmp(&magic, FABRIC_SNAPSHOT_MAGIC, sizeof(uint64_t)))
+     || (FABRIC_SNAPSHOT_ENDIAN_MARKER != cursor.read_word())) {
+    VTR_LOG_WARN("File '%s' is not a %s or written by a machine with a different byte order!\n",
+                 fname.c_str(), file_type.c_str());
+    return 1;
+  }
+  uint64_t version = cursor.read_word();
+  if (FABRIC_SNAPSHOT_VERSION != version) {
+    VTR_LOG_WARN("Unsupported version '%lu' of %s file '%s' (expect '%lu')!\n",
+                 version, file_type.c_str(), fname.c_str(), FABRIC_SNAPSHOT_VERSION);
+    return 1;
+  }
+  if (fabric_id != cursor.read_string()) {
+    VTR_LOG_WARN("The %s file '%s' is built from different architectures or options!\n",
+                 file_type.c_str(), fname.c_str());
+    return 1;
+  }
+  flags = cursor.read_word();
+  if ((true == cursor.failed())
+     || (is_layout != (0 != (flags & FABRIC_SNAPSHOT_LAYOUT_FLAG)))) {
+    VTR_LOG_WARN("File '%s' is not a %s!\n",
+                 fname.c_str(), file_type.c_str());
+    return 1;
+  }
+
+  /* Build the databases aside, so that they are not touched when the snapshot is not valid */
+  DecoderLibrary snapshot_decoder_lib;
+  size_t num_decoders = cursor.read_word();
+  for (size_t idecoder = 0; (false == cursor.failed()) && (idecoder < num_decoders); ++idecoder) {
+    size_t addr_size = cursor.read_word();
+    size_t data_size = cursor.read_word();
+    uint64_t decoder_flags = cursor.read_word();
+    snapshot_decoder_lib.add_decoder(addr_size, data_size,
+                                     0 != (decoder_flags & 1), 0 != (decoder_flags & 2), 0 != (decoder_flags & 4));
+  }
+
+  ModuleManager snapshot_module_manager;
+  size_t num_modules = cursor.read_word();
+  bool valid_content = false == cursor.failed();
+  for (size_t imodule = 0; (true == valid_content) && (imodule < num_modules); ++imodule) {
+    ModuleId module = snapshot_module_manager.add_module(cursor.read_string());
+    uint64_t usage = cursor.read_word();
+    size_t num_ports = cursor.read_word();
+    if ((true == cursor.failed())
+       || (false == snapshot_module_manager.valid_module_id(module))
+       || (ModuleManager::NUM_MODULE_USAGE_TYPES <= usage)) {
+      valid_content = false;
+      break;
+    }
+    snapshot_module_manager.set_module_usage(module, ModuleManager::e_module_usage_type(usage));
+
+    for (size_t iport = 0; iport < num_ports; ++iport) {
+      std::string port_name = cursor.read_string();
+      size_t lsb = cursor.read_word();
+      size_t msb = cursor.read_word();
+      size_t origin_port_width = cursor.read_word();
+      uint64_t port_type = cursor.read_word();
+      uint64_t port_flags = cursor.read_word();
+      std::string preproc_flag = cursor.read_string();
+      if ((true == cursor.failed())
+         || (ModuleManager::NUM_MODULE_PORT_TYPES <= port_type)) {
+        valid_content = false;
+        break;
+      }
+      BasicPort port_info(port_name, lsb, msb);
+      port_info.set_origin_port_width(origin_port_width);
+      ModulePortId port = snapshot_module_manager.add_port(module, port_info, ModuleManager::e_module_port_type(port_type));
+      /* Wire and register flags are set by port names, which are the default values otherwise */
+      if (0 != (port_flags & 1)) {
+        snapshot_module_manager.set_port_is_wire(module, port_name, true);
+      }
+      snapshot_module_manager.set_port_is_mappable_io(module, port, 0 != (port_flags & 2));
+      if (0 != (port_flags & 4)) {
+        snapshot_module_manager.set_port_is_register(module, port_name, true);
+      }
+      snapshot_module_manager.set_port_preproc_flag(module, port, preproc_flag);
+    }
+  }
+
+  for (const ModuleId& module : snapshot_module_manager.modules()) {
+    if (false == valid_content) {
+      break;
+    }
+    valid_content = read_fabric_snapshot_module_graph(cursor, snapshot_module_manager, module);
+  }
+
+  /* Module aliases */
+  size_t num_aliases = (true == valid_content) ? cursor.read_word() : 0;
+  for (size_t ialias = 0; (true == valid_content) && (ialias < num_aliases); ++ialias) {
+    ModuleId module = ModuleId(cursor.read_word());
+    ModuleId target_module = ModuleId(cursor.read_word());
+    if ((true == cursor.failed())
+       || (false == snapshot_module_manager.valid_module_id(module))
+       || (false == snapshot_module_manager.valid_module_id(target_module))
+       || (module == target_module)
+       || (false == snapshot_module_manager.parent_modules(module).empty())) {
+      valid_content = false;
+      break;
+    }
+    snapshot_module_manager.set_module_alias(module, target_module);
+  }
+
+  if ((false == valid_content) || (false == cursor.finished())) {
+    VTR_LOG_WARN("The %s file '%s' is corrupted!\n",
+                 file_type.c_str(), fname.c_str());
+    return 1;
+  }
+
+  module_manager = std::move(snapshot_module_manager);
+  decoder_lib = std::move(snapshot_decoder_lib);
+
+  VTR_LOGV(verbose,
+           "Loaded %lu modules from %s file: %s\n",
+           module_manager.num_modules(),
+           file_type.c_str(),
+           fname.c_str());
+
+  return 0;
+}
+
+/********************************************************************
+ * Read a binary fabric snapshot to the module graph and decoder library
+ * The snapshot is loaded only if its fabric id matches the given one
+ *******************************************************************/
+int read_fabric_snapshot_from_binary_file(ModuleManager& module_manager,
+                                          DecoderLibrary& decoder_lib,
+                                          const std::string& fabric_id,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  uint64_t flags = 0;
+  return read_fabric_snapshot_file(module_manager, decoder_lib,
+                                   fabric_id, false,
+                                   fname, flags, verbose);
+}
+
+/********************************************************************
+ * Read a binary configuration layout to the module graph and decoder library
+ * The layout is loaded only if it is written on the same device
+ *******************************************************************/
+int read_configuration_layout_from_binary_file(ModuleManager& module_manager,
+                                               DecoderLibrary& decoder_lib,
+                                               const std::string& device_id,
+                                               const std::string& fname,
+                                               bool& compress_routing,
+                                               const bool& verbose) {
+  uint64_t flags = 0;
+  int status = read_fabric_snapshot_file(module_manager, decoder_lib,
+                                         device_id, true,
+                                         fname, flags, verbose);
+  compress_routing = (0 != (flags & FABRIC_SNAPSHOT_COMPRESS_ROUTING_FLAG));
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,33 @@
+#ifndef FABRIC_SNAPSHOT_READER_H
+#define FABRIC_SNAPSHOT_READER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "module_manager.h"
+#include "decoder_library.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int read_fabric_snapshot_from_binary_file(ModuleManager& module_manager,
+                                          DecoderLibrary& decoder_lib,
+                                          const std::string& fabric_id,
+                                          const std::string& fname,
+                                          const bool& verbose);
+
+int read_configuration_layout_from_binary_file(ModuleManager& module_manager,
+                                               DecoderLibrary& decoder_lib,
+                                               const std::string& device_id,
+                                               const std::string& fname,
+                                               bool& compress_routing,
+                                               const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,336 @@
+/********************************************************************
+ * This file includes functions that output the module graph and
+ * decoder library of a FPGA fabric to a binary snapshot file,
+ * which can be reloaded much faster than building the fabric again
+ *
+ * The file is a sequence of 64-bit words and strings, where
+ * a string is a word of its length followed by its characters
+ * (not padded). All the ids are the same as in the databases:
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   magic number "OFPGAFAB"                            |
+ *   |   endian marker 0x0102030405060708                   |
+ *   |   format version                                     |
+ *   |   fabric id (string)                                 |
+ *   |   flags                                              |
+ *   +------------------------------------------------------+
+ *   | Decoders                                             |
+ *   |   number of decoders                                 |
+ *   |   per decoder: address size, data size, flags        |
+ *   +------------------------------------------------------+
+ *   | Modules                                              |
+ *   |   number of modules                                  |
+ *   |   per module: name (string), usage, number of ports  |
+ *   |     per port: name (string), lsb, msb, origin width, |
+ *   |               type, flags, pre-processing flag       |
+ *   +------------------------------------------------------+
+ *   | Module graph, module by module                       |
+ *   |   number of child modules                            |
+ *   |     per child: module id, number of instances,       |
+ *   |                coordinate prefix (string),           |
+ *   |                number of instances named by          |
+ *   |                coordinates, then each as instance    |
+ *   |                id, x, y,                             |
+ *   |                number of names set explicitly, then  |
+ *   |                each as instance id, name (string)    |
+ *   |   number of configurable children                    |
+ *   |     per child: module id, instance id                |
+ *   |   number of configuration regions                    |
+ *   |     per region: number of children,                  |
+ *   |                 index of each configurable child     |
+ *   |   number of nets                                     |
+ *   |     per net: name (string), number of sources,       |
+ *   |              number of sinks, then each terminal as  |
+ *   |              module id, instance id, port id, pin    |
+ *   +------------------------------------------------------+
+ *   | Module aliases                                       |
+ *   |   number of modules merged into identical modules    |
+ *   |     per alias: module id, id of the identical module |
+ *   +------------------------------------------------------+
+ *
+ * The names of instances which are generated from coordinates
+ * (see ModuleManager::set_child_instance_coordinate_name()) are stored
+ * as coordinates, so that they are still generated on demand after loading.
+ *
+ * The fabric id identifies the inputs from which the fabric is built.
+ * A snapshot is only loaded when the fabric id matches.
+ *
+ * A configuration layout is a snapshot without nets, i.e., the modules,
+ * their ports and the configurable children, which is all what the
+ * bitstream generator requires. The fabric id of a layout is replaced
+ * by the device id, since the layout describes a fabric which has been
+ * built on the device, whatever the options of building it.
+ *******************************************************************/
+#include <fstream>
+#include <map>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "fabric_snapshot_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Append a word or a string to the buffer of a snapshot
+ *******************************************************************/
+static
+void append_fabric_snapshot_word(std::string& buffer,
+                                 const uint64_t& word) {
+  buffer.append(reinterpret_cast<const char*>(&word), sizeof(uint64_t));
+}
+
+static
+void append_fabric_snapshot_string(std::string& buffer,
+                                   const std::string& str) {
+  append_fabric_snapshot_word(buffer, str.size());
+  buffer.append(str);
+}
+
+/********************************************************************
+ * Append the child modules, configurable children, configuration regions
+ * and nets of a module to the buffer of a snapshot
+ *******************************************************************/
+static
+void append_fabric_snapshot_module_graph(std::string& buffer,
+                                         const ModuleManager& module_manager,
+                                         const ModuleId& module,
+                                         const bool& include_nets) {
+  const std::vector<ModuleId>& child_modules = module_manager.child_modules(module);
+  append_fabric_snapshot_word(buffer, child_modules.size());
+  for (const ModuleId& child_module : child_modules) {
+    size_t num_instances = module_manager.num_instance(module, child_module);
+    append_fabric_snapshot_word(buffer, size_t(child_module));
+    append_fabric_snapshot_word(buffer, num_instances);
+
+    /* Only the coordinates of the instances named by coordinates are stored, not their names */
+    append_fabric_snapshot_string(buffer, module_manager.instance_coordinate_prefix(module, child_module));
+    std::vector<size_t> coord_instances;
+    for (size_t inst = 0; inst < num_instances; ++inst) {
+      if (size_t(-1) != module_manager.instance_coordinate(module, child_module, inst).x()) {
+        coord_instances.push_back(inst);
+      }
+    }
+    append_fabric_snapshot_word(buffer, coord_instances.size());
+    for (const size_t& inst : coord_instances) {
+      vtr::Point<size_t> coord = module_manager.instance_coordinate(module, child_module, inst);
+      append_fabric_snapshot_word(buffer, inst);
+      append_fabric_snapshot_word(buffer, coord.x());
+      append_fabric_snapshot_word(buffer, coord.y());
+    }
+
+    const std::map<size_t, std::string>& inst_names = module_manager.explicit_instance_names(module, child_module);
+    append_fabric_snapshot_word(buffer, inst_names.size());
+    for (const auto& inst_name : inst_names) {
+      append_fabric_snapshot_word(buffer, inst_name.first);
+      append_fabric_snapshot_string(buffer, inst_name.second);
+    }
+  }
+
+  const std::vector<ModuleId>& config_children = module_manager.configurable_children(module);
+  const std::vector<size_t>& config_child_instances = module_manager.configurable_child_instances(module);
+  append_fabric_snapshot_word(buffer, config_children.size());
+  for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+    append_fabric_snapshot_word(buffer, size_t(config_children[ichild]));
+    append_fabric_snapshot_word(buffer, config_child_instances[ichild]);
+  }
+
+  /* Regions refer to the configurable children by their indices */
+  append_fabric_snapshot_word(buffer, module_manager.regions(module).size());
+  if (0 < module_manager.regions(module).size()) {
+    std::map<std::pair<ModuleId, size_t>, size_t> config_child_indices;
+    for (size_t ichild = 0; ichild < config_children.size(); ++ichild) {
+      config_child_indices.insert(std::make_pair(std::make_pair(config_children[ichild], config_child_instances[ichild]), ichild));
+    }
+    for (const ConfigRegionId& region : module_manager.regions(module)) {
+      std::vector<ModuleId> region_children = module_manager.region_configurable_children(module, region);
+      std::vector<size_t> region_child_instances = module_manager.region_configurable_child_instances(module, region);
+      append_fabric_snapshot_word(buffer, region_children.size());
+      for (size_t ichild = 0; ichild < region_children.size(); ++ichild) {
+        append_fabric_snapshot_word(buffer, config_child_indices.at(std::make_pair(region_children[ichild], region_child_instances[ichild])));
+      }
+    }
+  }
+
+  if (false == include_nets) {
+    append_fabric_snapshot_word(buffer, 0);
+    return;
+  }
+
+  append_fabric_snapshot_word(buffer, module_manager.num_nets(module));
+  for (const ModuleNetId& net : module_manager.module_nets(module)) {
+    append_fabric_snapshot_string(buffer, module_manager.net_name(module, net));
+    append_fabric_snapshot_word(buffer, module_manager.module_net_sources(module, net).size());
+    append_fabric_snapshot_word(buffer, module_manager.module_net_sinks(module, net).size());
+    for (const ModuleNetSrcId& src : module_manager.module_net_sources(module, net)) {
+      append_fabric_snapshot_word(buffer, size_t(module_manager.net_source_module(module, net, src)));
+      append_fabric_snapshot_word(buffer, module_manager.net_source_instance(module, net, src));
+      append_fabric_snapshot_word(buffer, size_t(module_manager.net_source_port(module, net, src)));
+      append_fabric_snapshot_word(buffer, module_manager.net_source_pin(module, net, src));
+    }
+    for (const ModuleNetSinkId& sink : module_manager.module_net_sinks(module, net)) {
+      append_fabric_snapshot_word(buffer, size_t(module_manager.net_sink_module(module, net, sink)));
+      append_fabric_snapshot_word(buffer, module_manager.net_sink_instance(module, net, sink));
+      append_fabric_snapshot_word(buffer, size_t(module_manager.net_sink_port(module, net, sink)));
+      append_fabric_snapshot_word(buffer, module_manager.net_sink_pin(module, net, sink));
+    }
+  }
+}
+
+/********************************************************************
+ * Write the module graph and decoder library to a binary file,
+ * with the nets unless the file is a configuration layout
+ * Notes:
+ *   - Words are written in the byte order of the host machine,
+ *     which can be detected by the endian marker in the header
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static
+int write_fabric_snapshot_file(const ModuleManager& module_manager,
+                               const DecoderLibrary& decoder_lib,
+                               const std::string& fabric_id,
+                               const uint64_t& flags,
+                               const std::string& fname,
+                               const bool& verbose) {
+  bool include_nets = (0 == (flags & FABRIC_SNAPSHOT_LAYOUT_FLAG));
+  std::string file_type = (true == include_nets) ? std::string("fabric snapshot") : std::string("configuration layout");
+
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output %s!\n\tPlease specify a valid file name.\n",
+                  file_type.c_str());
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + file_type + std::string(" into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Header and decoders */
+  std::string buffer(FABRIC_SNAPSHOT_MAGIC, sizeof(uint64_t));
+  append_fabric_snapshot_word(buffer, FABRIC_SNAPSHOT_ENDIAN_MARKER);
+  append_fabric_snapshot_word(buffer, FABRIC_SNAPSHOT_VERSION);
+  append_fabric_snapshot_string(buffer, fabric_id);
+  append_fabric_snapshot_word(buffer, flags);
+
+  append_fabric_snapshot_word(buffer, decoder_lib.decoders().size());
+  for (const DecoderId& decoder : decoder_lib.decoders()) {
+    append_fabric_snapshot_word(buffer, decoder_lib.addr_size(decoder));
+    append_fabric_snapshot_word(buffer, decoder_lib.data_size(decoder));
+    append_fabric_snapshot_word(buffer, uint64_t(decoder_lib.use_enable(decoder))
+                                      | (uint64_t(decoder_lib.use_data_in(decoder)) << 1)
+                                      | (uint64_t(decoder_lib.use_data_inv_port(decoder)) << 2));
+  }
+
+  /* Modules and ports */
+  append_fabric_snapshot_word(buffer, module_manager.num_modules());
+  for (const ModuleId& module : module_manager.modules()) {
+    append_fabric_snapshot_string(buffer, module_manager.module_name(module));
+    append_fabric_snapshot_word(buffer, module_manager.module_usage(module));
+    append_fabric_snapshot_word(buffer, module_manager.module_ports(module).size());
+    for (const ModulePortId& port : module_manager.module_ports(module)) {
+      BasicPort port_info = module_manager.module_port(module, port);
+      append_fabric_snapshot_string(buffer, port_info.get_name());
+      append_fabric_snapshot_word(buffer, port_info.get_lsb());
+      append_fabric_snapshot_word(buffer, port_info.get_msb());
+      append_fabric_snapshot_word(buffer, port_info.get_origin_port_width());
+      append_fabric_snapshot_word(buffer, module_manager.port_type(module, port));
+      append_fabric_snapshot_word(buffer, uint64_t(module_manager.port_is_wire(module, port))
+                                        | (uint64_t(module_manager.port_is_mappable_io(module, port)) << 1)
+                                        | (uint64_t(module_manager.port_is_register(module, port)) << 2));
+      append_fabric_snapshot_string(buffer, module_manager.port_preproc_flag(module, port));
+    }
+  }
+  fp.write(buffer.data(), buffer.size());
+
+  /* Module graph, which is flushed module by module to limit memory usage */
+  for (const ModuleId& module : module_manager.modules()) {
+    buffer.clear();
+    append_fabric_snapshot_module_graph(buffer, module_manager, module, include_nets);
+    fp.write(buffer.data(), buffer.size());
+  }
+
+  /* Module aliases */
+  buffer.clear();
+  std::vector<ModuleId> alias_modules;
+  for (const ModuleId& module : module_manager.modules()) {
+    if (true == module_manager.valid_module_id(module_manager.module_alias_target(module))) {
+      alias_modules.push_back(module);
+    }
+  }
+  append_fabric_snapshot_word(buffer, alias_modules.size());
+  for (const ModuleId& module : alias_modules) {
+    append_fabric_snapshot_word(buffer, size_t(module));
+    append_fabric_snapshot_word(buffer, size_t(module_manager.module_alias_target(module)));
+  }
+  fp.write(buffer.data(), buffer.size());
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write %s to binary file '%s'!\n",
+                  file_type.c_str(), fname.c_str());
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu modules to %s file: %s\n",
+           module_manager.num_modules(),
+           file_type.c_str(),
+           fname.c_str());
+
+  return status;
+}
+
+/********************************************************************
+ * Write the module graph and decoder library to a binary snapshot file
+ * The file can be read back by read_fabric_snapshot_from_binary_file()
+ *******************************************************************/
+int write_fabric_snapshot_to_binary_file(const ModuleManager& module_manager,
+                                         const DecoderLibrary& decoder_lib,
+                                         const std::string& fabric_id,
+                                         const std::string& fname,
+                                         const bool& verbose) {
+  return write_fabric_snapshot_file(module_manager, decoder_lib,
+                                    fabric_id, 0,
+                                    fname, verbose);
+}
+
+/********************************************************************
+ * Write the configuration layout of a fabric to a binary file
+ * The file can be read back by read_configuration_layout_from_binary_file()
+ *******************************************************************/
+int write_configuration_layout_to_binary_file(const ModuleManager& module_manager,
+                                              const DecoderLibrary& decoder_lib,
+                                              const std::string& device_id,
+                                              const bool& compress_routing,
+                                              const std::string& fname,
+                                              const bool& verbose) {
+  uint64_t flags = FABRIC_SNAPSHOT_LAYOUT_FLAG;
+  if (true == compress_routing) {
+    flags |= FABRIC_SNAPSHOT_COMPRESS_ROUTING_FLAG;
+  }
+  return write_fabric_snapshot_file(module_manager, decoder_lib,
+                                    device_id, flags,
+                                    fname, verbose);
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,46 @@
+#ifndef FABRIC_SNAPSHOT_WRITER_H
+#define FABRIC_SNAPSHOT_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include "module_manager.h"
+#include "decoder_library.h"
+
+/********************************************************************
+ * Constants for the binary fabric snapshot file format
+ *******************************************************************/
+constexpr char FABRIC_SNAPSHOT_MAGIC[] = "OFPGAFAB";
+constexpr uint64_t FABRIC_SNAPSHOT_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t FABRIC_SNAPSHOT_VERSION = 4;
+/* Flags of the file: a configuration layout has no nets,
+ * and its routing modules may be compressed
+ */
+constexpr uint64_t FABRIC_SNAPSHOT_LAYOUT_FLAG = 0x1;
+constexpr uint64_t FABRIC_SNAPSHOT_COMPRESS_ROUTING_FLAG = 0x2;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_snapshot_to_binary_file(const ModuleManager& module_manager,
+                                         const DecoderLibrary& decoder_lib,
+                                         const std::string& fabric_id,
+                                         const std::string& fname,
+                                         const bool& verbose);
+
+int write_configuration_layout_to_binary_file(const ModuleManager& module_manager,
+                                              const DecoderLibrary& decoder_lib,
+                                              const std::string& device_id,
+                                              const bool& compress_routing,
+                                              const std::string& fname,
+                                              const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
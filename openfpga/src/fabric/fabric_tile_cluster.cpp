@@ -0,0 +1,209 @@
+/********************************************************************
+ * This file includes functions that detect the repeating clusters of tiles
+ * in the core of a FPGA fabric. A cluster of NxM tiles includes the grids,
+ * switch blocks and connection blocks of the tiles. Two clusters are the same
+ * if all their tiles have the same grid types and unique routing modules.
+ *
+ * The report estimates how many instances a module graph would contain 
+ * if each unique cluster is built as a module and tiled in the top-level module,
+ * compared to instanciating all the grids and routing blocks in the top-level module
+ *
+ * Note that this is an analysis only: no module is built for the clusters,
+ * and the top-level module still instanciates all the grids and routing blocks
+ *******************************************************************/
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_ndmatrix.h"
+
+#include "fabric_tile_cluster.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Each tile is modeled by the type and offsets of its grid and the unique modules of its SB, CBX and CBY */
+typedef std::tuple<int, int, int, size_t, size_t, size_t, size_t, size_t, size_t> t_fabric_tile_signature;
+
+/********************************************************************
+ * Find the coordinate of the module which is used by a routing block
+ * Return an invalid coordinate if the routing block does not exist
+ *******************************************************************/
+static 
+vtr::Point<size_t> find_tile_sb_module_coordinate(const DeviceRRGSB& device_rr_gsb,
+                                                  const vtr::Point<size_t>& gsb_coord,
+                                                  const bool& compact_routing_hierarchy) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  if (false == rr_gsb.is_sb_exist()) {
+    return vtr::Point<size_t>(size_t(-1), size_t(-1));
+  } 
+  if (true == compact_routing_hierarchy) {
+    return device_rr_gsb.get_sb_unique_module(gsb_coord).get_sb_coordinate();
+  }
+  return rr_gsb.get_sb_coordinate();
+}
+
+static 
+vtr::Point<size_t> find_tile_cb_module_coordinate(const DeviceRRGSB& device_rr_gsb,
+                                                  const vtr::Point<size_t>& gsb_coord,
+                                                  const t_rr_type& cb_type,
+                                                  const bool& compact_routing_hierarchy) {
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return vtr::Point<size_t>(size_t(-1), size_t(-1));
+  } 
+  if (true == compact_routing_hierarchy) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, gsb_coord);
+    return vtr::Point<size_t>(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type));
+  }
+  return vtr::Point<size_t>(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+}
+
+/********************************************************************
+ * Label each tile in the core of the fabric with an id,
+ * where tiles with the same id have the same grid and routing modules
+ * The core excludes the I/O grids on the perimeter
+ *******************************************************************/
+static 
+vtr::Matrix<size_t> build_fabric_core_tile_ids(const DeviceGrid& grids,
+                                               const DeviceRRGSB& device_rr_gsb,
+                                               const bool& compact_routing_hierarchy,
+                                               size_t& num_unique_tiles) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  size_t core_width = std::min(grids.width() - 2, gsb_range.x() - 1);
+  size_t core_height = std::min(grids.height() - 2, gsb_range.y() - 1);
+
+  vtr::Matrix<size_t> tile_ids({core_width, core_height});
+  std::map<t_fabric_tile_signature, size_t> unique_tiles;
+
+  for (size_t ix = 0; ix < core_width; ++ix) {
+    for (size_t iy = 0; iy < core_height; ++iy) {
+      vtr::Point<size_t> tile_coord(ix + 1, iy + 1);
+      const t_grid_tile& grid_tile = grids[tile_coord.x()][tile_coord.y()];
+      vtr::Point<size_t> sb_coord = find_tile_sb_module_coordinate(device_rr_gsb, tile_coord, compact_routing_hierarchy);
+      vtr::Point<size_t> cbx_coord = find_tile_cb_module_coordinate(device_rr_gsb, tile_coord, CHANX, compact_routing_hierarchy);
+      vtr::Point<size_t> cby_coord = find_tile_cb_module_coordinate(device_rr_gsb, tile_coord, CHANY, compact_routing_hierarchy);
+      t_fabric_tile_signature signature = std::make_tuple(grid_tile.type->index, grid_tile.width_offset, grid_tile.height_offset,
+                                                          sb_coord.x(), sb_coord.y(),
+                                                          cbx_coord.x(), cbx_coord.y(),
+                                                          cby_coord.x(), cby_coord.y());
+      auto result = unique_tiles.insert(std::make_pair(signature, unique_tiles.size()));
+      tile_ids[ix][iy] = result.first->second;
+    }
+  }
+
+  num_unique_tiles = unique_tiles.size();
+  return tile_ids;
+}
+
+/********************************************************************
+ * Report the repeating clusters of tiles for each cluster size
+ * up to max_cluster_size x max_cluster_size
+ * Clusters are aligned to the bottom-left corner of the core,
+ * the tiles which can not form a complete cluster are left as they are.
+ *
+ * The number of instances is estimated as 4 instances (a grid, a SB, a CBX and a CBY) per tile:
+ *  - flat: all the tiles are instanciated in the top-level module
+ *  - clustered: cluster instances and remaining tiles in the top-level module,
+ *               and the tiles in each unique cluster module
+ *
+ * Return 0 if succeed, otherwise return 1
+ *******************************************************************/
+int report_fabric_tile_clusters(const DeviceGrid& grids,
+                                const DeviceRRGSB& device_rr_gsb,
+                                const bool& compact_routing_hierarchy,
+                                const size_t& max_cluster_size,
+                                const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Report tile clusters of FPGA fabric");
+
+  if (0 == max_cluster_size) {
+    VTR_LOG_ERROR("The maximum size of tile clusters should be at least 1!\n");
+    return 1;
+  }
+
+  if ((grids.width() < 3) || (grids.height() < 3)) {
+    VTR_LOG_WARN("The fabric has no core tiles to be clustered.\n");
+    return 0;
+  }
+
+  if (false == compact_routing_hierarchy) {
+    VTR_LOG_WARN("Routing hierarchy is not compressed, each routing block is unique and no tile clusters can be repeated.\n");
+  }
+
+  size_t num_unique_tiles = 0;
+  vtr::Matrix<size_t> tile_ids = build_fabric_core_tile_ids(grids, device_rr_gsb, compact_routing_hierarchy, num_unique_tiles);
+  size_t core_width = tile_ids.dim_size(0);
+  size_t core_height = tile_ids.dim_size(1);
+  size_t num_tiles = core_width * core_height;
+
+  VTR_LOG("Found %lu unique tiles among the %lux%lu core tiles\n",
+          num_unique_tiles, core_width, core_height);
+
+  constexpr size_t NUM_INSTANCES_PER_TILE = 4;
+  size_t num_flat_instances = num_tiles * NUM_INSTANCES_PER_TILE;
+
+  VTR_LOG("%10s %10s %10s %12s %14s %8s\n",
+          "Cluster", "Clusters", "Unique", "Uncovered", "Instances", "Ratio");
+
+  size_t best_width = 1;
+  size_t best_height = 1;
+  size_t best_num_instances = num_flat_instances;
+
+  for (size_t width = 1; width <= std::min(max_cluster_size, core_width); ++width) {
+    for (size_t height = 1; height <= std::min(max_cluster_size, core_height); ++height) {
+      size_t num_cluster_cols = core_width / width;
+      size_t num_cluster_rows = core_height / height;
+
+      std::map<std::vector<size_t>, size_t> unique_clusters;
+      for (size_t icol = 0; icol < num_cluster_cols; ++icol) {
+        for (size_t irow = 0; irow < num_cluster_rows; ++irow) {
+          std::vector<size_t> cluster_signature;
+          cluster_signature.reserve(width * height);
+          for (size_t ix = icol * width; ix < (icol + 1) * width; ++ix) {
+            for (size_t iy = irow * height; iy < (irow + 1) * height; ++iy) {
+              cluster_signature.push_back(tile_ids[ix][iy]);
+            }
+          }
+          unique_clusters[cluster_signature]++;
+        }
+      }
+
+      size_t num_clusters = num_cluster_cols * num_cluster_rows;
+      size_t num_uncovered_tiles = num_tiles - num_clusters * width * height;
+      size_t num_instances = num_clusters 
+                           + num_uncovered_tiles * NUM_INSTANCES_PER_TILE
+                           + unique_clusters.size() * width * height * NUM_INSTANCES_PER_TILE;
+
+      VTR_LOG("%7lux%-2lu %10lu %10lu %12lu %14lu %8.3f\n",
+              width, height, num_clusters, unique_clusters.size(), num_uncovered_tiles,
+              num_instances, float(num_instances) / float(num_flat_instances));
+
+      VTR_LOGV(verbose,
+               "\tThe most used cluster is repeated %lu times\n",
+               std::max_element(unique_clusters.begin(), unique_clusters.end(),
+                                [](const std::pair<const std::vector<size_t>, size_t>& a,
+                                   const std::pair<const std::vector<size_t>, size_t>& b) {
+                                  return a.second < b.second;
+                                })->second);
+
+      if (num_instances < best_num_instances) {
+        best_width = width;
+        best_height = height;
+        best_num_instances = num_instances;
+      }
+    }
+  }
+
+  VTR_LOG("Best cluster size is %lux%lu, which requires %lu instances (%.3f of %lu instances of a flat fabric)\n",
+          best_width, best_height, best_num_instances,
+          float(best_num_instances) / float(num_flat_instances), num_flat_instances);
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,25 @@
+#ifndef FABRIC_TILE_CLUSTER_H
+#define FABRIC_TILE_CLUSTER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "device_grid.h"
+#include "device_rr_gsb.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_fabric_tile_clusters(const DeviceGrid& grids,
+                                const DeviceRRGSB& device_rr_gsb,
+                                const bool& compact_routing_hierarchy,
+                                const size_t& max_cluster_size,
+                                const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
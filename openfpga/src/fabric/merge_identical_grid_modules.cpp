@@ -0,0 +1,280 @@
+/********************************************************************
+ * This file includes functions to merge the grid modules which are
+ * structurally identical, e.g., the physical tiles on different borders
+ * of the fabric, or the pb_types which are duplicated in several tiles,
+ * so that each of them is built once in the module graph and output once
+ * in the netlists
+ *******************************************************************/
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_hash.h"
+
+#include "merge_identical_grid_modules.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Order the modules so that the children of a module come before it,
+ * as modules can only be identical once their children are merged
+ *******************************************************************/
+static 
+void rec_sort_grid_modules(const ModuleManager& module_manager,
+                           const ModuleId& module,
+                           const std::unordered_set<ModuleId>& grid_modules,
+                           std::unordered_set<ModuleId>& visited_modules,
+                           std::vector<ModuleId>& sorted_modules) {
+  if (false == visited_modules.insert(module).second) {
+    return;
+  }
+  for (const ModuleId& child : module_manager.child_modules(module)) {
+    if (0 < grid_modules.count(child)) {
+      rec_sort_grid_modules(module_manager, child, grid_modules, visited_modules, sorted_modules);
+    }
+  }
+  sorted_modules.push_back(module);
+}
+
+/********************************************************************
+ * Hash the features of a module which are cheap to find,
+ * to only compare the modules which are likely identical
+ *******************************************************************/
+static 
+size_t module_structural_hash(const ModuleManager& module_manager,
+                              const ModuleId& module) {
+  size_t hash = 0;
+  vtr::hash_combine(hash, size_t(module_manager.module_usage(module)));
+  for (const ModulePortId& port : module_manager.module_ports(module)) {
+    const BasicPort& port_info = module_manager.module_port(module, port);
+    vtr::hash_combine(hash, port_info.get_name());
+    vtr::hash_combine(hash, port_info.get_width());
+    vtr::hash_combine(hash, size_t(module_manager.port_type(module, port)));
+  }
+  for (const ModuleId& child : module_manager.child_modules(module)) {
+    vtr::hash_combine(hash, size_t(child));
+    vtr::hash_combine(hash, module_manager.num_instance(module, child));
+  }
+  vtr::hash_combine(hash, module_manager.num_nets(module));
+  return hash;
+}
+
+/********************************************************************
+ * Identify if the terminals of two nets (sources or sinks) are the same,
+ * where a terminal on a port of the module itself is the same
+ * as a terminal on the same port of the other module
+ *******************************************************************/
+static 
+bool same_net_terminals(const ModuleId& module_a,
+                        const vtr::vector<ModuleNetSrcId, ModuleId>& modules_a,
+                        const vtr::vector<ModuleNetSrcId, size_t>& instances_a,
+                        const vtr::vector<ModuleNetSrcId, ModulePortId>& ports_a,
+                        const vtr::vector<ModuleNetSrcId, size_t>& pins_a,
+                        const ModuleId& module_b,
+                        const vtr::vector<ModuleNetSrcId, ModuleId>& modules_b,
+                        const vtr::vector<ModuleNetSrcId, size_t>& instances_b,
+                        const vtr::vector<ModuleNetSrcId, ModulePortId>& ports_b,
+                        const vtr::vector<ModuleNetSrcId, size_t>& pins_b) {
+  if (modules_a.size() != modules_b.size()) {
+    return false;
+  }
+  for (size_t iterm = 0; iterm < modules_a.size(); ++iterm) {
+    ModuleNetSrcId term = ModuleNetSrcId(iterm);
+    bool self_a = (module_a == modules_a[term]);
+    bool self_b = (module_b == modules_b[term]);
+    if ( (self_a != self_b)
+      || ((false == self_a) && (modules_a[term] != modules_b[term]))
+      || (instances_a[term] != instances_b[term])
+      || (ports_a[term] != ports_b[term])
+      || (pins_a[term] != pins_b[term]) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* The sink terminals are compared as the source terminals */
+template<typename T>
+static 
+vtr::vector<ModuleNetSrcId, T> as_source_terminals(const vtr::vector<ModuleNetSinkId, T>& sink_terminals) {
+  return vtr::vector<ModuleNetSrcId, T>(sink_terminals.begin(), sink_terminals.end());
+}
+
+/********************************************************************
+ * Identify if two modules are identical: same ports, same child instances
+ * (with the same names, which are used to build the bitstream),
+ * same configurable children and same nets
+ *******************************************************************/
+static 
+bool modules_identical(const ModuleManager& module_manager,
+                       const ModuleId& module_a,
+                       const ModuleId& module_b) {
+  if (module_manager.module_usage(module_a) != module_manager.module_usage(module_b)) {
+    return false;
+  }
+
+  /* Ports */
+  if (module_manager.module_ports(module_a).size() != module_manager.module_ports(module_b).size()) {
+    return false;
+  }
+  for (const ModulePortId& port : module_manager.module_ports(module_a)) {
+    const BasicPort& port_a = module_manager.module_port(module_a, port);
+    const BasicPort& port_b = module_manager.module_port(module_b, port);
+    if ( (false == (port_a == port_b))
+      || (port_a.get_origin_port_width() != port_b.get_origin_port_width())
+      || (module_manager.port_type(module_a, port) != module_manager.port_type(module_b, port))
+      || (module_manager.port_is_wire(module_a, port) != module_manager.port_is_wire(module_b, port))
+      || (module_manager.port_is_mappable_io(module_a, port) != module_manager.port_is_mappable_io(module_b, port))
+      || (module_manager.port_is_register(module_a, port) != module_manager.port_is_register(module_b, port))
+      || (module_manager.port_preproc_flag(module_a, port) != module_manager.port_preproc_flag(module_b, port)) ) {
+      return false;
+    }
+  }
+
+  /* Child instances */
+  if (module_manager.child_modules(module_a) != module_manager.child_modules(module_b)) {
+    return false;
+  }
+  for (const ModuleId& child : module_manager.child_modules(module_a)) {
+    size_t num_instances = module_manager.num_instance(module_a, child);
+    if (num_instances != module_manager.num_instance(module_b, child)) {
+      return false;
+    }
+    for (size_t inst = 0; inst < num_instances; ++inst) {
+      if (module_manager.instance_name(module_a, child, inst) != module_manager.instance_name(module_b, child, inst)) {
+        return false;
+      }
+    }
+  }
+
+  /* Configurable children and regions */
+  if ( (module_manager.configurable_children(module_a) != module_manager.configurable_children(module_b))
+    || (module_manager.configurable_child_instances(module_a) != module_manager.configurable_child_instances(module_b))
+    || (module_manager.regions(module_a).size() != module_manager.regions(module_b).size()) ) {
+    return false;
+  }
+  for (const ConfigRegionId& region : module_manager.regions(module_a)) {
+    if ( (module_manager.region_configurable_children(module_a, region) != module_manager.region_configurable_children(module_b, region))
+      || (module_manager.region_configurable_child_instances(module_a, region) != module_manager.region_configurable_child_instances(module_b, region)) ) {
+      return false;
+    }
+  }
+
+  /* Nets */
+  if (module_manager.num_nets(module_a) != module_manager.num_nets(module_b)) {
+    return false;
+  }
+  for (const ModuleNetId& net : module_manager.module_nets(module_a)) {
+    if ( (false == module_manager.valid_module_net_id(module_b, net))
+      || (module_manager.net_name(module_a, net) != module_manager.net_name(module_b, net)) ) {
+      return false;
+    }
+    if (false == same_net_terminals(module_a,
+                                    module_manager.net_source_modules(module_a, net),
+                                    module_manager.net_source_instances(module_a, net),
+                                    module_manager.net_source_ports(module_a, net),
+                                    module_manager.net_source_pins(module_a, net),
+                                    module_b,
+                                    module_manager.net_source_modules(module_b, net),
+                                    module_manager.net_source_instances(module_b, net),
+                                    module_manager.net_source_ports(module_b, net),
+                                    module_manager.net_source_pins(module_b, net))) {
+      return false;
+    }
+    if (false == same_net_terminals(module_a,
+                                    as_source_terminals(module_manager.net_sink_modules(module_a, net)),
+                                    as_source_terminals(module_manager.net_sink_instances(module_a, net)),
+                                    as_source_terminals(module_manager.net_sink_ports(module_a, net)),
+                                    as_source_terminals(module_manager.net_sink_pins(module_a, net)),
+                                    module_b,
+                                    as_source_terminals(module_manager.net_sink_modules(module_b, net)),
+                                    as_source_terminals(module_manager.net_sink_instances(module_b, net)),
+                                    as_source_terminals(module_manager.net_sink_ports(module_b, net)),
+                                    as_source_terminals(module_manager.net_sink_pins(module_b, net)))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Merge the grid modules which are structurally identical:
+ * the parents of a module identical to an earlier module instanciate
+ * the earlier module instead, and the name of the module gives the
+ * earlier module, so that the top-level module, which is built later,
+ * also instanciates the earlier module.
+ * The modules are processed from the leaves, so that the parents of
+ * merged modules can be identical in turn.
+ *
+ * A module is not merged into a module which is already a child of
+ * one of its parents, as the instances of both would have to be renumbered.
+ *
+ * Return the number of merged modules
+ *******************************************************************/
+size_t merge_identical_grid_modules(ModuleManager& module_manager,
+                                    const std::vector<ModuleId>& grid_modules,
+                                    const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Merge identical grid modules");
+
+  std::unordered_set<ModuleId> grid_module_set(grid_modules.begin(), grid_modules.end());
+  std::unordered_set<ModuleId> visited_modules;
+  std::vector<ModuleId> sorted_modules;
+  for (const ModuleId& module : grid_modules) {
+    rec_sort_grid_modules(module_manager, module, grid_module_set, visited_modules, sorted_modules);
+  }
+
+  /* The unique modules found so far, by structural hash */
+  std::unordered_map<size_t, std::vector<ModuleId>> unique_modules;
+  size_t num_merged_modules = 0;
+
+  for (const ModuleId& module : sorted_modules) {
+    std::vector<ModuleId>& candidates = unique_modules[module_structural_hash(module_manager, module)];
+
+    ModuleId target_module = ModuleId::INVALID();
+    for (const ModuleId& candidate : candidates) {
+      if (false == modules_identical(module_manager, candidate, module)) {
+        continue;
+      }
+      const std::vector<ModuleId>& parents = module_manager.parent_modules(module);
+      bool conflict = std::any_of(parents.begin(), parents.end(), [&](const ModuleId& parent) {
+        const std::vector<ModuleId>& children = module_manager.child_modules(parent);
+        return children.end() != std::find(children.begin(), children.end(), candidate);
+      });
+      if (false == conflict) {
+        target_module = candidate;
+        break;
+      }
+    }
+
+    if (false == module_manager.valid_module_id(target_module)) {
+      candidates.push_back(module);
+      continue;
+    }
+
+    VTR_LOGV(verbose,
+             "Merged module '%s' into identical module '%s'\n",
+             module_manager.module_name(module).c_str(),
+             module_manager.module_name(target_module).c_str());
+
+    /* Copy the parents, as they are removed from the list when replacing the child module */
+    std::vector<ModuleId> parents = module_manager.parent_modules(module);
+    for (const ModuleId& parent : parents) {
+      module_manager.replace_child_module(parent, module, target_module);
+    }
+    module_manager.set_module_alias(module, target_module);
+    num_merged_modules++;
+  }
+
+  VTR_LOG("Merged %lu identical grid modules out of %lu\n",
+          num_merged_modules, grid_modules.size());
+
+  return num_merged_modules;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,23 @@
+#ifndef MERGE_IDENTICAL_GRID_MODULES_H
+#define MERGE_IDENTICAL_GRID_MODULES_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <vector>
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t merge_identical_grid_modules(ModuleManager& module_manager,
+                                    const std::vector<ModuleId>& grid_modules,
+                                    const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,17 +2,60 @@
  * Memember functions for data structure ModuleManager
  ******************************************************************************/
 #include <string>
+#include <cstring>
+#include <cstdlib>
 #include <numeric>
 #include <algorithm>
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
+#include "openfpga_memory_usage.h"
+
 #include "circuit_library.h"
 #include "module_manager.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/******************************************************************************
+ * Generate the name of an instance named after a coordinate: <prefix>_<x>__<y>_
+ * Note that the format should be the same as the instance names of
+ * grid, switch block and connection block in openfpga_naming.cpp
+ ******************************************************************************/
+static 
+std::string generate_coordinate_instance_name(const std::string& prefix,
+                                              const vtr::Point<size_t>& coordinate) {
+  return prefix + std::string("_") + std::to_string(coordinate.x()) + std::string("__") + std::to_string(coordinate.y()) + std::string("_");
+}
+
+/******************************************************************************
+ * Find the coordinate from an instance name, which is generated by
+ * generate_coordinate_instance_name() with the given prefix
+ * Return false if the name is not in the format
+ ******************************************************************************/
+static 
+bool parse_coordinate_instance_name(const std::string& instance_name,
+                                    const std::string& prefix,
+                                    vtr::Point<size_t>& coordinate) {
+  if (0 != instance_name.compare(0, prefix.size() + 1, prefix + std::string("_"))) {
+    return false;
+  }
+  const char* x_start = instance_name.c_str() + prefix.size() + 1;
+  char* x_end = nullptr;
+  unsigned long x = std::strtoul(x_start, &x_end, 10);
+  if ((x_end == x_start) || (0 != std::strncmp(x_end, "__", 2))) {
+    return false;
+  }
+  char* y_end = nullptr;
+  unsigned long y = std::strtoul(x_end + 2, &y_end, 10);
+  if (y_end == x_end + 2) {
+    return false;
+  }
+  coordinate = vtr::Point<size_t>(x, y);
+  /* Reject the names which are not generated exactly in the format, e.g., with leading zeros */
+  return instance_name == generate_coordinate_instance_name(prefix, coordinate);
+}
+
 /******************************************************************************
  * Public Constructors
  ******************************************************************************/
@@ -41,12 +84,19 @@ ModuleManager::module_net_range ModuleManager::module_nets(const ModuleId& modul
 }
 
 /* Find all the child modules under a parent module */
-std::vector<ModuleId> ModuleManager::child_modules(const ModuleId& parent_module) const {
+const std::vector<ModuleId>& ModuleManager::child_modules(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
   return children_[parent_module];
 }
 
+/* Find all the parent modules of a module */
+const std::vector<ModuleId>& ModuleManager::parent_modules(const ModuleId& child_module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(child_module));
+  return parents_[child_module];
+}
+
 /* Find all the instances under a parent module */
 std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent_module, const ModuleId& child_module) const {
   /* Validate the module_id */
@@ -69,7 +119,7 @@ std::vector<size_t> ModuleManager::child_module_instances(const ModuleId& parent
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& parent_module) const {
+const std::vector<ModuleId>& ModuleManager::configurable_children(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -77,7 +127,7 @@ std::vector<ModuleId> ModuleManager::configurable_children(const ModuleId& paren
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
+const std::vector<size_t>& ModuleManager::configurable_child_instances(const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
@@ -88,14 +138,16 @@ std::vector<size_t> ModuleManager::configurable_child_instances(const ModuleId&
 ModuleManager::module_net_src_range ModuleManager::module_net_sources(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_src_ids_[module][net].begin(), net_src_ids_[module][net].end());
+  return vtr::make_range(module_net_src_iterator(ModuleNetSrcId(0), invalid_net_src_ids_),
+                         module_net_src_iterator(ModuleNetSrcId(net_srcs_[module][net].size()), invalid_net_src_ids_));
 }
 
 /* Find the sink ids of modules */
 ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
-  return vtr::make_range(net_sink_ids_[module][net].begin(), net_sink_ids_[module][net].end());
+  return vtr::make_range(module_net_sink_iterator(ModuleNetSinkId(0), invalid_net_sink_ids_),
+                         module_net_sink_iterator(ModuleNetSinkId(net_sinks_[module][net].size()), invalid_net_sink_ids_));
 }
 
 ModuleManager::region_range ModuleManager::regions(const ModuleId& module) const {
@@ -138,6 +190,57 @@ std::vector<size_t> ModuleManager::region_configurable_child_instances(const Mod
 /******************************************************************************
  * Public Accessors
  ******************************************************************************/
+size_t ModuleManager::ChildInstanceNames::memory_usage() const {
+  return sizeof(ChildInstanceNames)
+       + heap_memory_usage(coordinate_prefix)
+       + heap_memory_usage(coordinates)
+       + heap_memory_usage(names)
+       + heap_memory_usage(name_lookup);
+}
+
+size_t ModuleManager::memory_usage() const {
+  return sizeof(ModuleManager)
+       + heap_memory_usage(ids_)
+       + heap_memory_usage(names_)
+       + heap_memory_usage(usages_)
+       + heap_memory_usage(parents_)
+       + heap_memory_usage(children_)
+       + heap_memory_usage(num_child_instances_)
+       + heap_memory_usage(child_instance_names_)
+       + heap_memory_usage(alias_targets_)
+       + heap_memory_usage(configurable_children_)
+       + heap_memory_usage(configurable_child_instances_)
+       + heap_memory_usage(configurable_child_regions_)
+       + heap_memory_usage(config_region_ids_)
+       + heap_memory_usage(config_region_children_)
+       + heap_memory_usage(port_ids_)
+       + heap_memory_usage(ports_)
+       + heap_memory_usage(port_types_)
+       + heap_memory_usage(port_is_mappable_io_)
+       + heap_memory_usage(port_is_wire_)
+       + heap_memory_usage(port_is_register_)
+       + heap_memory_usage(port_preproc_flags_)
+       + heap_memory_usage(num_nets_)
+       + heap_memory_usage(invalid_net_ids_)
+       + heap_memory_usage(net_names_)
+       + heap_memory_usage(net_srcs_)
+       + heap_memory_usage(net_sinks_)
+       + heap_memory_usage(invalid_net_src_ids_)
+       + heap_memory_usage(invalid_net_sink_ids_)
+       + heap_memory_usage(string_pool_)
+       + heap_memory_usage(name_id_map_)
+       + heap_memory_usage(port_lookup_)
+       + heap_memory_usage(port_name_lookup_)
+       + heap_memory_usage(child_index_lookup_)
+       + heap_memory_usage(port_first_pins_)
+       + heap_memory_usage(num_pins_)
+       + heap_memory_usage(net_lookup_);
+}
+
+bool ModuleManager::frozen() const {
+  return frozen_;
+}
+
 /* Return number of modules */
 size_t ModuleManager::num_modules() const {
   return ids_.size();
@@ -209,19 +312,17 @@ ModulePortId ModuleManager::find_module_port(const ModuleId& module_id, const st
   /* Validate the module id */
   VTR_ASSERT(valid_module_id(module_id));
 
-  /* Iterate over the ports of the module */
-  for (const auto& port : port_ids_[module_id]) {
-    if (0 == port_name.compare(ports_[module_id][port].get_name())) {
-      /* Find it, return the id */
-      return port; 
-    }
+  auto result = port_name_lookup_[module_id].find(port_name);
+  if (result != port_name_lookup_[module_id].end()) {
+    /* Find it, return the id */
+    return result->second; 
   }
   /* Not found, return an invalid id */
   return ModulePortId::INVALID();
 }
 
 /* Find the Port information with a given port id */
-BasicPort ModuleManager::module_port(const ModuleId& module_id, const ModulePortId& port_id) const {
+const BasicPort& ModuleManager::module_port(const ModuleId& module_id, const ModulePortId& port_id) const {
   /* Validate the module and port id */
   VTR_ASSERT(valid_module_port_id(module_id, port_id));
   return ports_[module_id][port_id]; 
@@ -229,14 +330,26 @@ BasicPort ModuleManager::module_port(const ModuleId& module_id, const ModulePort
 
 /* Find the module id by a given name, return invalid if not found */
 ModuleId ModuleManager::find_module(const std::string& name) const {
-  if (name_id_map_.find(name) != name_id_map_.end()) {
+  auto result = name_id_map_.find(name);
+  if (result != name_id_map_.end()) {
     /* Find it, return the id */
-    return name_id_map_.at(name); 
+    return result->second; 
   }
   /* Not found, return an invalid id */
   return ModuleId::INVALID();
 }
 
+ModuleId ModuleManager::module_alias_target(const ModuleId& module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module));
+  return alias_targets_[module];
+}
+
+bool ModuleManager::is_module_alias(const std::string& name) const {
+  ModuleId module = find_module(name);
+  return (true == valid_module_id(module)) && (names_[module] != name);
+}
+
 /* Find the number of instances of a child module in the parent module */
 size_t ModuleManager::num_instance(const ModuleId& parent_module, const ModuleId& child_module) const {
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
@@ -260,7 +373,65 @@ std::string ModuleManager::instance_name(const ModuleId& parent_module, const Mo
   VTR_ASSERT (child_index < children_[parent_module].size());
   /* Ensure that instance id is valid */
   VTR_ASSERT (instance_id < num_instance(parent_module, child_module));
-  return child_instance_names_[parent_module][child_index][instance_id];
+
+  const ChildInstanceNames& child_instance_names = child_instance_names_[parent_module][child_index];
+  /* Names set explicitly have the priority */
+  auto name_it = child_instance_names.names.find(instance_id);
+  if (name_it != child_instance_names.names.end()) {
+    return name_it->second;
+  }
+  if ( (instance_id < child_instance_names.coordinates.size())
+    && (size_t(-1) != child_instance_names.coordinates[instance_id].x()) ) {
+    return generate_coordinate_instance_name(child_instance_names.coordinate_prefix, child_instance_names.coordinates[instance_id]);
+  }
+  return std::string();
+}
+
+/* Find the prefix of the instances of a child module which are named by coordinates */
+std::string ModuleManager::instance_coordinate_prefix(const ModuleId& parent_module, const ModuleId& child_module) const {
+  /* Validate the id of both parent and child modules */
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( valid_module_id(child_module) );
+
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT (child_index < children_[parent_module].size());
+
+  const ChildInstanceNames& child_instance_names = child_instance_names_[parent_module][child_index];
+  if (true == child_instance_names.coordinates.empty()) {
+    return std::string();
+  }
+  return child_instance_names.coordinate_prefix;
+}
+
+/* Find the coordinate after which an instance of a child module is named */
+vtr::Point<size_t> ModuleManager::instance_coordinate(const ModuleId& parent_module, const ModuleId& child_module,
+                                                      const size_t& instance_id) const {
+  /* Validate the id of both parent and child modules */
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( valid_module_id(child_module) );
+
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT (child_index < children_[parent_module].size());
+  /* Ensure that instance id is valid */
+  VTR_ASSERT (instance_id < num_instance(parent_module, child_module));
+
+  const ChildInstanceNames& child_instance_names = child_instance_names_[parent_module][child_index];
+  if (instance_id < child_instance_names.coordinates.size()) {
+    return child_instance_names.coordinates[instance_id];
+  }
+  return vtr::Point<size_t>(size_t(-1), size_t(-1));
+}
+
+/* Find the names of the instances of a child module which are set explicitly */
+const std::map<size_t, std::string>& ModuleManager::explicit_instance_names(const ModuleId& parent_module, const ModuleId& child_module) const {
+  /* Validate the id of both parent and child modules */
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( valid_module_id(child_module) );
+
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT (child_index < children_[parent_module].size());
+
+  return child_instance_names_[parent_module][child_index].names;
 }
 
 /* Find the instance id of a given instance name */
@@ -274,16 +445,41 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module, const ModuleId&
   size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT (child_index < children_[parent_module].size());
 
-  /* Search the instance name list and try to find a match */
-  for (size_t name_id = 0; name_id < child_instance_names_[parent_module][child_index].size(); ++name_id) {
-    const std::string& name = child_instance_names_[parent_module][child_index][name_id];
-    if (0 == name.compare(instance_name)) {
-      return name_id;
+  const ChildInstanceNames& child_instance_names = child_instance_names_[parent_module][child_index];
+
+  /* Search the names set explicitly */
+  auto lookup_it = child_instance_names.name_lookup.find(instance_name);
+  if (lookup_it != child_instance_names.name_lookup.end()) {
+    return lookup_it->second;
+  }
+
+  /* Search the instances named by coordinates */
+  vtr::Point<size_t> coordinate;
+  if ( (true == child_instance_names.coordinate_prefix.empty())
+    || (false == parse_coordinate_instance_name(instance_name, child_instance_names.coordinate_prefix, coordinate)) ) {
+    /* Not found, return an invalid name */
+    return size_t(-1);
+  }
+
+  const std::vector<vtr::Point<size_t>>& coordinates = child_instance_names.coordinates;
+  size_t found_instance = size_t(-1);
+  if (true == child_instance_names.coordinates_sorted) {
+    auto coord_it = std::lower_bound(coordinates.begin(), coordinates.end(), coordinate);
+    if ((coord_it != coordinates.end()) && (*coord_it == coordinate)) {
+      found_instance = coord_it - coordinates.begin();
+    }
+  } else {
+    auto coord_it = std::find(coordinates.begin(), coordinates.end(), coordinate);
+    if (coord_it != coordinates.end()) {
+      found_instance = coord_it - coordinates.begin();
     }
   }
-  
-  /* Not found, return an invalid name */
-  return size_t(-1);
+
+  /* An instance whose name is set explicitly is not named by its coordinate */
+  if (0 < child_instance_names.names.count(found_instance)) {
+    return size_t(-1);
+  }
+  return found_instance;
 }
 
 ModuleManager::e_module_port_type ModuleManager::port_type(const ModuleId& module, const ModulePortId& port) const {
@@ -317,7 +513,7 @@ bool ModuleManager::port_is_register(const ModuleId& module, const ModulePortId&
 std::string ModuleManager::port_preproc_flag(const ModuleId& module, const ModulePortId& port) const {
   /* validate both module id and port id*/
   VTR_ASSERT(valid_module_port_id(module, port));
-  return port_preproc_flags_[module][port];
+  return string_pool_.str(port_preproc_flags_[module][port]);
 }
 
 /* Find a net from an instance of a module */
@@ -342,9 +538,9 @@ ModuleNetId ModuleManager::module_instance_port_net(const ModuleId& parent_modul
   VTR_ASSERT(valid_module_port_id(child_module, child_port));
 
   /* Validate child_pin */
-  VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
+  VTR_ASSERT(child_pin < ports_[child_module][child_port].get_width());
   
-  return net_lookup_[parent_module][child_module][child_instance][child_port][child_pin];
+  return find_net_lookup_entry(parent_module, child_module, child_instance, child_port, child_pin);
 }
 
 /* Find the name of net */
@@ -352,7 +548,7 @@ std::string ModuleManager::net_name(const ModuleId& module, const ModuleNetId& n
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_names_[module][net];
+  return string_pool_.str(net_names_[module][net]);
 }
 
 /* Find the source modules of a net */
@@ -361,9 +557,9 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(const Mo
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
-  src_modules.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_modules.push_back(net_terminal_storage_[id].first);
+  src_modules.reserve(net_srcs_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_srcs_[module][net]) {
+    src_modules.push_back(terminal.module);
   }
 
   return src_modules;
@@ -374,7 +570,13 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(const Mo
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_instance_ids_[module][net];
+  vtr::vector<ModuleNetSrcId, size_t> src_instances;
+  src_instances.reserve(net_srcs_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_srcs_[module][net]) {
+    src_instances.push_back(terminal.instance);
+  }
+
+  return src_instances;
 }
 
 /* Find the source ports of a net */
@@ -383,9 +585,9 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(const
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
-  src_ports.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
-    src_ports.push_back(net_terminal_storage_[id].second);
+  src_ports.reserve(net_srcs_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_srcs_[module][net]) {
+    src_ports.push_back(terminal.port);
   }
 
   return src_ports;
@@ -396,7 +598,49 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(const ModuleI
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_pin_ids_[module][net];
+  vtr::vector<ModuleNetSrcId, size_t> src_pins;
+  src_pins.reserve(net_srcs_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_srcs_[module][net]) {
+    src_pins.push_back(terminal.pin);
+  }
+
+  return src_pins;
+}
+
+/* Find the module of a source of a net */
+ModuleId ModuleManager::net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_src) < net_srcs_[module][net].size());
+
+  return net_srcs_[module][net][net_src].module;
+}
+
+/* Find the instance id of a source of a net */
+size_t ModuleManager::net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_src) < net_srcs_[module][net].size());
+
+  return net_srcs_[module][net][net_src].instance;
+}
+
+/* Find the port of a source of a net */
+ModulePortId ModuleManager::net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_src) < net_srcs_[module][net].size());
+
+  return net_srcs_[module][net][net_src].port;
+}
+
+/* Find the pin index of a source of a net */
+size_t ModuleManager::net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_src) < net_srcs_[module][net].size());
+
+  return net_srcs_[module][net][net_src].pin;
 }
 
 /* Identify if a pin of a port in a module already exists in the net source list*/
@@ -410,11 +654,11 @@ bool ModuleManager::net_source_exist(const ModuleId& module, const ModuleNetId&
    * If a net source has the same src_module, instance_id, src_port and src_pin,
    * we can say that the source has already been added to this net!
    */
-  for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ( (src_module == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].first) 
-      && (instance_id == net_source_instances(module, net)[net_src])   
-      && (src_port == net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]].second) 
-      && (src_pin == net_source_pins(module, net)[net_src]) ) {
+  for (const ModuleNetTerminal& terminal : net_srcs_[module][net]) {
+    if ( (src_module == terminal.module) 
+      && (instance_id == terminal.instance)   
+      && (src_port == terminal.port) 
+      && (src_pin == terminal.pin) ) {
       return true;
     }
   }
@@ -429,9 +673,9 @@ vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(const Mod
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
-  sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_modules.push_back(net_terminal_storage_[id].first);
+  sink_modules.reserve(net_sinks_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_sinks_[module][net]) {
+    sink_modules.push_back(terminal.module);
   }
 
   return sink_modules;
@@ -442,7 +686,13 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_instance_ids_[module][net];
+  vtr::vector<ModuleNetSinkId, size_t> sink_instances;
+  sink_instances.reserve(net_sinks_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_sinks_[module][net]) {
+    sink_instances.push_back(terminal.instance);
+  }
+
+  return sink_instances;
 }
 
 /* Find the sink ports of a net */
@@ -451,9 +701,9 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(const M
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
-  sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
-    sink_ports.push_back(net_terminal_storage_[id].second);
+  sink_ports.reserve(net_sinks_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_sinks_[module][net]) {
+    sink_ports.push_back(terminal.port);
   }
 
   return sink_ports;
@@ -464,7 +714,49 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(const ModuleId
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_pin_ids_[module][net];
+  vtr::vector<ModuleNetSinkId, size_t> sink_pins;
+  sink_pins.reserve(net_sinks_[module][net].size());
+  for (const ModuleNetTerminal& terminal : net_sinks_[module][net]) {
+    sink_pins.push_back(terminal.pin);
+  }
+
+  return sink_pins;
+}
+
+/* Find the module of a sink of a net */
+ModuleId ModuleManager::net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_sink) < net_sinks_[module][net].size());
+
+  return net_sinks_[module][net][net_sink].module;
+}
+
+/* Find the instance id of a sink of a net */
+size_t ModuleManager::net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_sink) < net_sinks_[module][net].size());
+
+  return net_sinks_[module][net][net_sink].instance;
+}
+
+/* Find the port of a sink of a net */
+ModulePortId ModuleManager::net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_sink) < net_sinks_[module][net].size());
+
+  return net_sinks_[module][net][net_sink].port;
+}
+
+/* Find the pin index of a sink of a net */
+size_t ModuleManager::net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const {
+  /* Validate module net */
+  VTR_ASSERT(valid_module_net_id(module, net));
+  VTR_ASSERT(size_t(net_sink) < net_sinks_[module][net].size());
+
+  return net_sinks_[module][net][net_sink].pin;
 }
 
 /* Identify if a pin of a port in a module already exists in the net sink list*/
@@ -478,11 +770,11 @@ bool ModuleManager::net_sink_exist(const ModuleId& module, const ModuleNetId& ne
    * If a net sink has the same sink_module, instance_id, sink_port and sink_pin,
    * we can say that the sink has already been added to this net!
    */
-  for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ( (sink_module == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].first) 
-      && (instance_id == net_sink_instances(module, net)[net_sink])   
-      && (sink_port == net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]].second) 
-      && (sink_pin == net_sink_pins(module, net)[net_sink]) ) {
+  for (const ModuleNetTerminal& terminal : net_sinks_[module][net]) {
+    if ( (sink_module == terminal.module) 
+      && (instance_id == terminal.instance)   
+      && (sink_port == terminal.port) 
+      && (sink_pin == terminal.pin) ) {
       return true;
     }
   }
@@ -499,14 +791,27 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
   /* Try to find the child_module in the children list of parent_module*/
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      /* Found, return the number of instances */
-      return i; 
-    }
+  auto it = child_index_lookup_[parent_module].find(child_module);
+  if (it == child_index_lookup_[parent_module].end()) {
+    /* Not found: return an valid value */
+    return size_t(-1);
+  }
+  return it->second;
+}
+
+ModuleNetId& ModuleManager::find_net_lookup_entry(const ModuleId& parent_module,
+                                                  const ModuleId& child_module, const size_t& child_instance,
+                                                  const ModulePortId& child_port, const size_t& child_pin) const {
+  /* The pins of the parent module itself are in the first list */
+  size_t child_list = 0;
+  if (child_module != parent_module) {
+    size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+    VTR_ASSERT(size_t(-1) != child_index);
+    child_list = child_index + 1;
   }
-  /* Not found: return an valid value */
-  return size_t(-1);
+  size_t pin_index = child_instance * num_pins_[child_module] + port_first_pins_[child_module][child_port] + child_pin;
+  VTR_ASSERT_SAFE(pin_index < net_lookup_[parent_module][child_list].size());
+  return net_lookup_[parent_module][child_list][pin_index];
 }
 
 /******************************************************************************
@@ -514,8 +819,10 @@ size_t ModuleManager::find_child_module_index_in_parent_module(const ModuleId& p
  ******************************************************************************/
 /* Add a module */
 ModuleId ModuleManager::add_module(const std::string& name) {
+  frozen_ = false;
+
   /* Find if the name has been used. If used, return an invalid Id and report error! */
-  std::map<std::string, ModuleId>::iterator it = name_id_map_.find(name);
+  auto it = name_id_map_.find(name);
   if (it != name_id_map_.end()) {
     return ModuleId::INVALID();
   }
@@ -531,6 +838,7 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   children_.emplace_back();
   num_child_instances_.emplace_back();
   child_instance_names_.emplace_back();
+  alias_targets_.push_back(ModuleId::INVALID());
   configurable_children_.emplace_back();
   configurable_child_instances_.emplace_back();
   configurable_child_regions_.emplace_back();
@@ -549,15 +857,8 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   num_nets_.emplace_back(0);
   invalid_net_ids_.emplace_back();
   net_names_.emplace_back();
-  net_src_ids_.emplace_back();
-  net_src_terminal_ids_.emplace_back();
-  net_src_instance_ids_.emplace_back();
-  net_src_pin_ids_.emplace_back();
-
-  net_sink_ids_.emplace_back();
-  net_sink_terminal_ids_.emplace_back();
-  net_sink_instance_ids_.emplace_back();
-  net_sink_pin_ids_.emplace_back();
+  net_srcs_.emplace_back();
+  net_sinks_.emplace_back();
 
   /* Register in the name-to-id map */
   name_id_map_[name] = module;
@@ -565,11 +866,17 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   /* Build port lookup */
   port_lookup_.emplace_back();
   port_lookup_[module].resize(NUM_MODULE_PORT_TYPES);
+  port_name_lookup_.emplace_back();
+
+  /* Build fast look-up for child modules */
+  child_index_lookup_.emplace_back();
 
   /* Build fast look-up for nets */
+  port_first_pins_.emplace_back();
+  num_pins_.push_back(0);
   net_lookup_.emplace_back();
-  /* Reserve the instance 0 for the module */
-  net_lookup_[module][module].emplace_back();
+  /* Reserve the first list for the module */
+  net_lookup_[module].emplace_back();
 
   /* Return the new id */
   return module;
@@ -581,6 +888,8 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
   /* Validate the id of module */
   VTR_ASSERT( valid_module_id(module) );
 
+  frozen_ = false;
+
   /* Add port and fill port attributes */
   ModulePortId port = ModulePortId(port_ids_[module].size());
   port_ids_[module].push_back(port);
@@ -589,14 +898,33 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
   port_is_wire_[module].push_back(false);
   port_is_mappable_io_[module].push_back(false);
   port_is_register_[module].push_back(false);
-  port_preproc_flags_[module].emplace_back(); /* Create an empty string for the pre-processing flags */
+  port_preproc_flags_[module].push_back(vtr::StringPool::empty_string_id()); /* Create an empty string for the pre-processing flags */
 
   /* Update fast look-up for port */
   port_lookup_[module][port_type].push_back(port);
+  /* A name used by several ports refers to the first of them */
+  port_name_lookup_[module].emplace(ports_[module].back().get_name(), port);
 
   /* Update fast look-up for nets */
-  VTR_ASSERT_SAFE(1 == net_lookup_[module][module].size());
-  net_lookup_[module][module][0][port].resize(port_info.get_width(), ModuleNetId::INVALID());
+  size_t num_orig_pins = num_pins_[module];
+  port_first_pins_[module].push_back(num_orig_pins);
+  num_pins_[module] += ports_[module].back().get_width();
+  net_lookup_[module][0].resize(num_pins_[module], ModuleNetId::INVALID());
+
+  /* The pins of each instance of the module in its parent modules are changed,
+   * move the pins of each instance to their new positions
+   */
+  for (const ModuleId& parent_module : parents_[module]) {
+    size_t child_index = find_child_module_index_in_parent_module(parent_module, module);
+    std::vector<ModuleNetId>& instance_nets = net_lookup_[parent_module][child_index + 1];
+    std::vector<ModuleNetId> new_instance_nets(num_child_instances_[parent_module][child_index] * num_pins_[module], ModuleNetId::INVALID());
+    for (size_t instance = 0; instance < num_child_instances_[parent_module][child_index]; ++instance) {
+      std::copy(instance_nets.begin() + instance * num_orig_pins,
+                instance_nets.begin() + (instance + 1) * num_orig_pins,
+                new_instance_nets.begin() + instance * num_pins_[module]);
+    }
+    instance_nets.swap(new_instance_nets);
+  }
 
   return port;
 }
@@ -606,6 +934,24 @@ void ModuleManager::set_module_port_name(const ModuleId& module, const ModulePor
                                          const std::string& port_name) {
   /* Validate the id of module port */
   VTR_ASSERT( valid_module_port_id(module, module_port) );
+
+  /* Update the name look-up, where a name refers to the first port using it */
+  std::unordered_map<std::string, ModulePortId>& name_lookup = port_name_lookup_[module];
+  auto old_name = name_lookup.find(ports_[module][module_port].get_name());
+  if ( (old_name != name_lookup.end()) && (module_port == old_name->second) ) {
+    name_lookup.erase(old_name);
+    for (const ModulePortId& port : port_ids_[module]) {
+      if ( (port != module_port)
+        && (ports_[module][port].get_name() == ports_[module][module_port].get_name()) ) {
+        name_lookup[ports_[module][port].get_name()] = port;
+        break;
+      }
+    }
+  }
+  auto new_name = name_lookup.emplace(port_name, module_port).first;
+  if (size_t(module_port) < size_t(new_name->second)) {
+    new_name->second = module_port;
+  }
   
   ports_[module][module_port].set_name(port_name);
 }
@@ -652,7 +998,7 @@ void ModuleManager::set_port_is_register(const ModuleId& module, const std::stri
 void ModuleManager::set_port_preproc_flag(const ModuleId& module, const ModulePortId& port, const std::string& preproc_flag) {
   /* Must find something, otherwise drop an error */
   VTR_ASSERT(valid_module_port_id(module, port));
-  port_preproc_flags_[module][port] = preproc_flag;
+  port_preproc_flags_[module][port] = string_pool_.intern(preproc_flag);
 }
 
 /* Add a child module to a parent module */
@@ -661,6 +1007,8 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
   VTR_ASSERT ( valid_module_id(parent_module) );
   VTR_ASSERT ( valid_module_id(child_module) );
 
+  frozen_ = false;
+
   /* Try to find if the parent module is already in the list */
   std::vector<ModuleId>::iterator parent_it = std::find(parents_[child_module].begin(), parents_[child_module].end(), parent_module);
   if (parent_it == parents_[child_module].end()) {
@@ -668,27 +1016,64 @@ void ModuleManager::add_child_module(const ModuleId& parent_module, const Module
     parents_[child_module].push_back(parent_module);
   }
 
-  std::vector<ModuleId>::iterator child_it = std::find(children_[parent_module].begin(), children_[parent_module].end(), child_module);
-  if (child_it == children_[parent_module].end()) {
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  if (size_t(-1) == child_index) {
     /* Update the child module of parent module */
+    child_index = children_[parent_module].size();
     children_[parent_module].push_back(child_module);
+    child_index_lookup_[parent_module][child_module] = child_index;
     num_child_instances_[parent_module].push_back(1); /* By default give one */
     /* Update the instance name list */
     child_instance_names_[parent_module].emplace_back();
-    child_instance_names_[parent_module].back().emplace_back();
+    /* Create the list in the fast look-up for nets */
+    net_lookup_[parent_module].emplace_back();
   } else {
     /* Increase the counter of instances */
-    num_child_instances_[parent_module][child_it - children_[parent_module].begin()]++;
-    child_instance_names_[parent_module][child_it - children_[parent_module].begin()].emplace_back();
+    num_child_instances_[parent_module][child_index]++;
   }
 
-  /* Update fast look-up for nets */
-  size_t instance_id = net_lookup_[parent_module][child_module].size();
-  net_lookup_[parent_module][child_module].emplace_back();
-  /* Find the ports for the child module and update the fast look-up */
-  for (ModulePortId child_port : port_ids_[child_module]) {
-    net_lookup_[parent_module][child_module][instance_id][child_port].resize(ports_[child_module][child_port].get_width(), ModuleNetId::INVALID());
-  } 
+  /* Update fast look-up for nets: add the pins of the new instance */
+  net_lookup_[parent_module][child_index + 1].resize(num_child_instances_[parent_module][child_index] * num_pins_[child_module], ModuleNetId::INVALID());
+}
+
+/* Replace a child module by another one with the same pins
+ * The child index is unchanged, so that the fast look-up for nets is still valid
+ */
+void ModuleManager::replace_child_module(const ModuleId& parent_module, const ModuleId& old_child_module, const ModuleId& new_child_module) {
+  /* Validate the id of the parent and child modules */
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( valid_module_id(old_child_module) );
+  VTR_ASSERT ( valid_module_id(new_child_module) );
+  VTR_ASSERT ( num_pins_[old_child_module] == num_pins_[new_child_module] );
+
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, old_child_module);
+  VTR_ASSERT (size_t(-1) != child_index);
+  VTR_ASSERT (size_t(-1) == find_child_module_index_in_parent_module(parent_module, new_child_module));
+
+  children_[parent_module][child_index] = new_child_module;
+  child_index_lookup_[parent_module].erase(old_child_module);
+  child_index_lookup_[parent_module][new_child_module] = child_index;
+
+  /* Update the parent modules of both children */
+  parents_[old_child_module].erase(std::find(parents_[old_child_module].begin(), parents_[old_child_module].end(), parent_module));
+  parents_[new_child_module].push_back(parent_module);
+
+  std::replace(configurable_children_[parent_module].begin(), configurable_children_[parent_module].end(),
+               old_child_module, new_child_module);
+
+  /* Update the terminals of nets */
+  for (size_t inet = 0; inet < num_nets_[parent_module]; ++inet) {
+    for (ModuleNetTerminal& src : net_srcs_[parent_module][ModuleNetId(inet)]) {
+      if (old_child_module == src.module) {
+        src.module = new_child_module;
+      }
+    }
+    for (ModuleNetTerminal& sink : net_sinks_[parent_module][ModuleNetId(inet)]) {
+      if (old_child_module == sink.module) {
+        sink.module = new_child_module;
+      }
+    }
+  }
 }
 
 /* Set the instance name of a child module */
@@ -706,7 +1091,69 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
   /* We must find something! */
   VTR_ASSERT(size_t(-1) != child_index);
   /* Set the name */
-  child_instance_names_[parent_module][child_index][instance_id] = instance_name;
+  ChildInstanceNames& child_instance_names = child_instance_names_[parent_module][child_index];
+  auto name_it = child_instance_names.names.find(instance_id);
+  if (name_it != child_instance_names.names.end()) {
+    /* Remove the old name from the reverse look-up */
+    auto lookup_it = child_instance_names.name_lookup.find(name_it->second);
+    if ((lookup_it != child_instance_names.name_lookup.end()) && (instance_id == lookup_it->second)) {
+      child_instance_names.name_lookup.erase(lookup_it);
+    }
+    name_it->second = instance_name;
+  } else {
+    child_instance_names.names.emplace(instance_id, instance_name);
+  }
+  /* If a name is used by multiple instances, the first one is found in the look-up */
+  child_instance_names.name_lookup.emplace(instance_name, instance_id);
+}
+
+/* Name an instance of a child module after a coordinate */
+void ModuleManager::set_child_instance_coordinate_name(const ModuleId& parent_module, 
+                                                       const ModuleId& child_module, 
+                                                       const size_t& instance_id, 
+                                                       const std::string& prefix,
+                                                       const vtr::Point<size_t>& coordinate) {
+  /* Validate the id of both parent and child modules */
+  VTR_ASSERT ( valid_module_id(parent_module) );
+  VTR_ASSERT ( valid_module_id(child_module) );
+  /* Ensure that the instance id is in range */
+  VTR_ASSERT ( instance_id < num_instance(parent_module, child_module));
+  VTR_ASSERT ( size_t(-1) != coordinate.x() );
+  /* Try to find the child_module in the children list of parent_module*/
+  size_t child_index = find_child_module_index_in_parent_module(parent_module, child_module);
+  /* We must find something! */
+  VTR_ASSERT(size_t(-1) != child_index);
+
+  ChildInstanceNames& child_instance_names = child_instance_names_[parent_module][child_index];
+  if (true == child_instance_names.coordinate_prefix.empty()) {
+    child_instance_names.coordinate_prefix = prefix;
+  }
+  /* Instances with a different prefix can only be stored by their full names */
+  if (prefix != child_instance_names.coordinate_prefix) {
+    set_child_instance_name(parent_module, child_module, instance_id, generate_coordinate_instance_name(prefix, coordinate));
+    return;
+  }
+
+  /* The coordinate name replaces any name set explicitly */
+  auto name_it = child_instance_names.names.find(instance_id);
+  if (name_it != child_instance_names.names.end()) {
+    auto lookup_it = child_instance_names.name_lookup.find(name_it->second);
+    if ((lookup_it != child_instance_names.name_lookup.end()) && (instance_id == lookup_it->second)) {
+      child_instance_names.name_lookup.erase(lookup_it);
+    }
+    child_instance_names.names.erase(name_it);
+  }
+
+  std::vector<vtr::Point<size_t>>& coordinates = child_instance_names.coordinates;
+  /* Binary search is only possible when the coordinates are appended in ascending order */
+  if ( (instance_id != coordinates.size())
+    || ((false == coordinates.empty()) && (false == (coordinates.back() < coordinate))) ) {
+    child_instance_names.coordinates_sorted = false;
+  }
+  if (instance_id >= coordinates.size()) {
+    coordinates.resize(instance_id + 1, vtr::Point<size_t>(size_t(-1), size_t(-1)));
+  }
+  coordinates[instance_id] = coordinate;
 }
 
 /* Add a configurable child module to module
@@ -723,6 +1170,8 @@ void ModuleManager::add_configurable_child(const ModuleId& parent_module,
   /* Ensure that the instance id is in range */
   VTR_ASSERT ( child_instance < num_instance(parent_module, child_module));
 
+  frozen_ = false;
+
   configurable_children_[parent_module].push_back(child_module);
   configurable_child_instances_[parent_module].push_back(child_instance);
   configurable_child_regions_[parent_module].push_back(ConfigRegionId::INVALID());
@@ -792,19 +1241,14 @@ void ModuleManager::reserve_module_nets(const ModuleId& module,
   VTR_ASSERT ( valid_module_id(module) );
 
   net_names_[module].reserve(num_nets);
-  net_src_ids_[module].reserve(num_nets);
-  net_src_terminal_ids_[module].reserve(num_nets);
-  net_src_instance_ids_[module].reserve(num_nets);
-  net_src_pin_ids_[module].reserve(num_nets);
-
-  net_sink_ids_[module].reserve(num_nets);
-  net_sink_terminal_ids_[module].reserve(num_nets);
-  net_sink_instance_ids_[module].reserve(num_nets);
-  net_sink_pin_ids_[module].reserve(num_nets);
+  net_srcs_[module].reserve(num_nets);
+  net_sinks_[module].reserve(num_nets);
 }
 
 /* Add a net to the connection graph of the module */ 
 ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
+  frozen_ = false;
+
   /* Validate the module id */
   VTR_ASSERT ( valid_module_id(module) );
 
@@ -813,19 +1257,13 @@ ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
   num_nets_[module]++;
   
   /* Allocate net-related data structures */
-  net_names_[module].emplace_back();
-  net_src_ids_[module].emplace_back();
-  net_src_terminal_ids_[module].emplace_back();
-  net_src_instance_ids_[module].emplace_back();
-  net_src_pin_ids_[module].emplace_back();
+  net_names_[module].push_back(vtr::StringPool::empty_string_id());
+  net_srcs_[module].emplace_back();
 
   /* Reserve a source */
   reserve_module_net_sources(module, net, 1);
 
-  net_sink_ids_[module].emplace_back();
-  net_sink_terminal_ids_[module].emplace_back();
-  net_sink_instance_ids_[module].emplace_back();
-  net_sink_pin_ids_[module].emplace_back();
+  net_sinks_[module].emplace_back();
 
   /* Reserve a source */
   reserve_module_net_sinks(module, net, 1);
@@ -839,7 +1277,7 @@ void ModuleManager::set_net_name(const ModuleId& module, const ModuleNetId& net,
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  net_names_[module][net] = name;
+  net_names_[module][net] = string_pool_.intern(name);
 }
 
 void ModuleManager::reserve_module_net_sources(const ModuleId& module, const ModuleNetId& net,
@@ -847,10 +1285,7 @@ void ModuleManager::reserve_module_net_sources(const ModuleId& module, const Mod
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  net_src_ids_[module][net].reserve(num_sources);
-  net_src_terminal_ids_[module][net].reserve(num_sources);
-  net_src_instance_ids_[module][net].reserve(num_sources);
-  net_src_pin_ids_[module][net].reserve(num_sources);
+  net_srcs_[module][net].reserve(num_sources);
 }
 
 /* Add a source to a net in the connection graph */
@@ -860,9 +1295,10 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  frozen_ = false;
+
   /* Create a new id for src node */
-  ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
-  net_src_ids_[module][net].push_back(net_src);
+  ModuleNetSrcId net_src = ModuleNetSrcId(net_srcs_[module][net].size());
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(src_module));
@@ -870,39 +1306,27 @@ ModuleNetSrcId ModuleManager::add_module_net_source(const ModuleId& module, cons
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_src_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
   if (src_module == module) {
     src_instance_id = 0;
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT (src_instance_id < num_instance(module, src_module));
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } 
 
   /* Validate the pin id is in the range of the port width */
-  VTR_ASSERT(src_pin < module_port(src_module, src_port).get_width());
-  net_src_pin_ids_[module][net].push_back(src_pin);
+  VTR_ASSERT(src_pin < ports_[src_module][src_port].get_width());
+
+  ModuleNetTerminal terminal;
+  terminal.module = src_module;
+  terminal.port = src_port;
+  terminal.instance = src_instance_id;
+  terminal.pin = src_pin;
+  net_srcs_[module][net].push_back(terminal);
 
   /* Update fast look-up for nets */
-  net_lookup_[module][src_module][src_instance_id][src_port][src_pin] = net;
+  find_net_lookup_entry(module, src_module, src_instance_id, src_port, src_pin) = net;
 
   return net_src;
 }
@@ -912,10 +1336,7 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module, const Modul
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  net_sink_ids_[module][net].reserve(num_sinks);
-  net_sink_terminal_ids_[module][net].reserve(num_sinks);
-  net_sink_instance_ids_[module][net].reserve(num_sinks);
-  net_sink_pin_ids_[module][net].reserve(num_sinks);
+  net_sinks_[module][net].reserve(num_sinks);
 }
 
 /* Add a sink to a net in the connection graph */
@@ -925,9 +1346,10 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
+  frozen_ = false;
+
   /* Create a new id for sink node */
-  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
-  net_sink_ids_[module][net].push_back(net_sink);
+  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sinks_[module][net].size());
 
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(sink_module));
@@ -935,43 +1357,165 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(const ModuleId& module, const
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(net_terminal_storage_.begin(),
-                                                                          net_terminal_storage_.end(),
-                                                                          terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-   VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-   net_sink_terminal_ids_[module][net].push_back(std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
   if (sink_module == module) {
     sink_instance_id = 0;
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT (sink_instance_id < num_instance(module, sink_module));
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } 
 
   /* Validate the pin id is in the range of the port width */
-  VTR_ASSERT(sink_pin < module_port(sink_module, sink_port).get_width());
-  net_sink_pin_ids_[module][net].push_back(sink_pin);
+  VTR_ASSERT(sink_pin < ports_[sink_module][sink_port].get_width());
+
+  ModuleNetTerminal terminal;
+  terminal.module = sink_module;
+  terminal.port = sink_port;
+  terminal.instance = sink_instance_id;
+  terminal.pin = sink_pin;
+  net_sinks_[module][net].push_back(terminal);
 
   /* Update fast look-up for nets */
-  net_lookup_[module][sink_module][sink_instance_id][sink_port][sink_pin] = net;
+  find_net_lookup_entry(module, sink_module, sink_instance_id, sink_port, sink_pin) = net;
 
   return net_sink;
 }
 
+void ModuleManager::add_modules_from(const ModuleManager& other,
+                                     const std::vector<ModuleId>& other_modules,
+                                     vtr::vector<ModuleId, ModuleId>& module_map) {
+  module_map.resize(other.num_modules(), ModuleId::INVALID());
+
+  /* Create the modules and their ports first,
+   * so that the copied modules can instanciate each other
+   */
+  std::vector<ModuleId> copied_modules;
+  for (const ModuleId& other_module : other_modules) {
+    VTR_ASSERT(other.valid_module_id(other_module));
+    ModuleId module = find_module(other.names_[other_module]);
+    if (true == valid_module_id(module)) {
+      module_map[other_module] = module;
+      continue;
+    }
+
+    module = add_module(other.names_[other_module]);
+    module_map[other_module] = module;
+    copied_modules.push_back(other_module);
+    usages_[module] = other.usages_[other_module];
+
+    for (const ModulePortId& other_port : other.port_ids_[other_module]) {
+      ModulePortId port = add_port(module, other.ports_[other_module][other_port], other.port_types_[other_module][other_port]);
+      port_is_wire_[module][port] = other.port_is_wire_[other_module][other_port];
+      port_is_mappable_io_[module][port] = other.port_is_mappable_io_[other_module][other_port];
+      port_is_register_[module][port] = other.port_is_register_[other_module][other_port];
+      set_port_preproc_flag(module, port, other.port_preproc_flag(other_module, other_port));
+    }
+  }
+
+  /* Copy the child instances, configurable children and nets */
+  for (const ModuleId& other_module : copied_modules) {
+    ModuleId module = module_map[other_module];
+
+    for (size_t ichild = 0; ichild < other.children_[other_module].size(); ++ichild) {
+      ModuleId child_module = module_map[other.children_[other_module][ichild]];
+      VTR_ASSERT(valid_module_id(child_module));
+      for (size_t inst = 0; inst < other.num_child_instances_[other_module][ichild]; ++inst) {
+        add_child_module(module, child_module);
+      }
+      /* The module is new, so that the children are in the same order as the copied module */
+      VTR_ASSERT(ichild == find_child_module_index_in_parent_module(module, child_module));
+      child_instance_names_[module][ichild] = other.child_instance_names_[other_module][ichild];
+    }
+
+    for (const ModuleId& other_child : other.configurable_children_[other_module]) {
+      configurable_children_[module].push_back(module_map[other_child]);
+    }
+    configurable_child_instances_[module] = other.configurable_child_instances_[other_module];
+    configurable_child_regions_[module] = other.configurable_child_regions_[other_module];
+    config_region_ids_[module] = other.config_region_ids_[other_module];
+    config_region_children_[module] = other.config_region_children_[other_module];
+
+    reserve_module_nets(module, other.num_nets_[other_module]);
+    for (size_t inet = 0; inet < other.num_nets_[other_module]; ++inet) {
+      ModuleNetId other_net = ModuleNetId(inet);
+      ModuleNetId net = create_module_net(module);
+      set_net_name(module, net, other.net_name(other_module, other_net));
+
+      reserve_module_net_sources(module, net, other.net_srcs_[other_module][other_net].size());
+      for (const ModuleNetTerminal& src : other.net_srcs_[other_module][other_net]) {
+        add_module_net_source(module, net, module_map[src.module], src.instance, src.port, src.pin);
+      }
+      reserve_module_net_sinks(module, net, other.net_sinks_[other_module][other_net].size());
+      for (const ModuleNetTerminal& sink : other.net_sinks_[other_module][other_net]) {
+        add_module_net_sink(module, net, module_map[sink.module], sink.instance, sink.port, sink.pin);
+      }
+    }
+  }
+}
+
+void ModuleManager::set_module_alias(const ModuleId& module, const ModuleId& target_module) {
+  /* Validate the id of both modules */
+  VTR_ASSERT ( valid_module_id(module) );
+  VTR_ASSERT ( valid_module_id(target_module) );
+  VTR_ASSERT ( module != target_module );
+  /* The module should not be instanciated any more */
+  VTR_ASSERT ( true == parents_[module].empty() );
+
+  alias_targets_[module] = target_module;
+  name_id_map_[names_[module]] = target_module;
+}
+
+void ModuleManager::freeze() {
+  for (const ModuleId& module : ids_) {
+    parents_[module].shrink_to_fit();
+    children_[module].shrink_to_fit();
+    num_child_instances_[module].shrink_to_fit();
+    child_instance_names_[module].shrink_to_fit();
+    for (ChildInstanceNames& child_instance_names : child_instance_names_[module]) {
+      child_instance_names.coordinates.shrink_to_fit();
+    }
+    configurable_children_[module].shrink_to_fit();
+    configurable_child_instances_[module].shrink_to_fit();
+    configurable_child_regions_[module].shrink_to_fit();
+    config_region_ids_[module].shrink_to_fit();
+    config_region_children_[module].shrink_to_fit();
+    for (std::vector<size_t>& region_children : config_region_children_[module]) {
+      region_children.shrink_to_fit();
+    }
+
+    port_ids_[module].shrink_to_fit();
+    ports_[module].shrink_to_fit();
+    port_types_[module].shrink_to_fit();
+    port_is_mappable_io_[module].shrink_to_fit();
+    port_is_wire_[module].shrink_to_fit();
+    port_is_register_[module].shrink_to_fit();
+    port_preproc_flags_[module].shrink_to_fit();
+    for (std::vector<ModulePortId>& type_ports : port_lookup_[module]) {
+      type_ports.shrink_to_fit();
+    }
+    port_first_pins_[module].shrink_to_fit();
+
+    /* Nets are never removed, so the net ids are all contiguous */
+    VTR_ASSERT(true == invalid_net_ids_[module].empty());
+    net_names_[module].shrink_to_fit();
+    net_srcs_[module].shrink_to_fit();
+    for (auto& srcs : net_srcs_[module]) {
+      srcs.shrink_to_fit();
+    }
+    net_sinks_[module].shrink_to_fit();
+    for (auto& sinks : net_sinks_[module]) {
+      sinks.shrink_to_fit();
+    }
+    net_lookup_[module].shrink_to_fit();
+    for (std::vector<ModuleNetId>& instance_nets : net_lookup_[module]) {
+      instance_nets.shrink_to_fit();
+    }
+  }
+
+  frozen_ = true;
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
@@ -990,6 +1534,67 @@ void ModuleManager::clear_config_region(const ModuleId& parent_module) {
   config_region_children_[parent_module].clear();
 }
 
+void ModuleManager::remove_modules_from(const ModuleId& first_module) {
+  VTR_ASSERT(valid_module_id(first_module));
+
+  frozen_ = false;
+
+  for (size_t imodule = size_t(first_module); imodule < ids_.size(); ++imodule) {
+    ModuleId module(imodule);
+    /* The removed modules can only be instanciated by each other */
+    for (const ModuleId& parent : parents_[module]) {
+      VTR_ASSERT(size_t(first_module) <= size_t(parent));
+    }
+    /* Detach the removed modules from the child modules which are kept */
+    for (const ModuleId& child : children_[module]) {
+      if (size_t(first_module) <= size_t(child)) {
+        continue;
+      }
+      std::vector<ModuleId>& child_parents = parents_[child];
+      child_parents.erase(std::remove(child_parents.begin(), child_parents.end(), module), child_parents.end());
+    }
+    name_id_map_.erase(names_[module]);
+  }
+
+  size_t num_modules = size_t(first_module);
+  ids_.resize(num_modules);
+  names_.resize(num_modules);
+  usages_.resize(num_modules);
+  parents_.resize(num_modules);
+  children_.resize(num_modules);
+  num_child_instances_.resize(num_modules);
+  child_instance_names_.resize(num_modules);
+  alias_targets_.resize(num_modules);
+  configurable_children_.resize(num_modules);
+  configurable_child_instances_.resize(num_modules);
+  configurable_child_regions_.resize(num_modules);
+
+  config_region_ids_.resize(num_modules);
+  config_region_children_.resize(num_modules);
+
+  port_ids_.resize(num_modules);
+  ports_.resize(num_modules);
+  port_types_.resize(num_modules);
+  port_is_wire_.resize(num_modules);
+  port_is_mappable_io_.resize(num_modules);
+  port_is_register_.resize(num_modules);
+  port_preproc_flags_.resize(num_modules);
+
+  num_nets_.resize(num_modules);
+  invalid_net_ids_.resize(num_modules);
+  net_names_.resize(num_modules);
+  net_srcs_.resize(num_modules);
+  net_sinks_.resize(num_modules);
+
+  port_lookup_.resize(num_modules);
+  port_name_lookup_.resize(num_modules);
+  child_index_lookup_.resize(num_modules);
+
+  port_first_pins_.resize(num_modules);
+  num_pins_.resize(num_modules);
+  net_lookup_.resize(num_modules);
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
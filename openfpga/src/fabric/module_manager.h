@@ -8,6 +8,9 @@
 #include <unordered_map>
 
 #include "vtr_vector.h"
+#include "vtr_string_pool.h"
+#include "openfpga_id_iterator.h"
+#include "vtr_geometry.h"
 #include "module_manager_fwd.h"
 #include "openfpga_port.h"
 
@@ -67,63 +70,16 @@ class ModuleManager {
 
   public: /* Public Constructors */
 
-  public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
-      public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
-
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
-            return *this;
-        }
-
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
-
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
-
-      private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
-    };
-
   public: /* Types and ranges */
-    //Lazy iterator utility forward declaration
+    //Lazy iterator utility, which is shared by the data structures with ID spaces
     template<class ID>
-    class lazy_id_iterator;
+    using lazy_id_iterator = LazyIdIterator<ID>;
 
     typedef vtr::vector<ModuleId, ModuleId>::const_iterator module_iterator;
     typedef vtr::vector<ModulePortId, ModulePortId>::const_iterator module_port_iterator;
     typedef lazy_id_iterator<ModuleNetId> module_net_iterator;
-    typedef vtr::vector<ModuleNetSrcId, ModuleNetSrcId>::const_iterator module_net_src_iterator;
-    typedef vtr::vector<ModuleNetSinkId, ModuleNetSinkId>::const_iterator module_net_sink_iterator;
+    typedef lazy_id_iterator<ModuleNetSrcId> module_net_src_iterator;
+    typedef lazy_id_iterator<ModuleNetSinkId> module_net_sink_iterator;
     typedef vtr::vector<ConfigRegionId, ConfigRegionId>::const_iterator region_iterator;
 
     typedef vtr::Range<module_iterator> module_range;
@@ -140,14 +96,22 @@ class ModuleManager {
     module_port_range module_ports(const ModuleId& module) const;
     /* Find all the nets belonging to a module */
     module_net_range module_nets(const ModuleId& module) const;
-    /* Find all the child modules under a parent module */
-    std::vector<ModuleId> child_modules(const ModuleId& parent_module) const;
+    /* Find all the child modules under a parent module 
+     * Note: the returned list is valid until child modules are changed
+     */
+    const std::vector<ModuleId>& child_modules(const ModuleId& parent_module) const;
+    /* Find all the parent modules which instanciate a module */
+    const std::vector<ModuleId>& parent_modules(const ModuleId& child_module) const;
     /* Find all the instances under a parent module */
     std::vector<size_t> child_module_instances(const ModuleId& parent_module, const ModuleId& child_module) const;
-    /* Find all the configurable child modules under a parent module */
-    std::vector<ModuleId> configurable_children(const ModuleId& parent_module) const;
-    /* Find all the instances of configurable child modules under a parent module */
-    std::vector<size_t> configurable_child_instances(const ModuleId& parent_module) const;
+    /* Find all the configurable child modules under a parent module
+     * Note: the returned list is valid until configurable children are changed
+     */
+    const std::vector<ModuleId>& configurable_children(const ModuleId& parent_module) const;
+    /* Find all the instances of configurable child modules under a parent module 
+     * Note: the returned list is valid until configurable children are changed
+     */
+    const std::vector<size_t>& configurable_child_instances(const ModuleId& parent_module) const;
     /* Find the source ids of modules */
     module_net_src_range module_net_sources(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink ids of modules */
@@ -163,6 +127,10 @@ class ModuleManager {
                                                             const ConfigRegionId& region) const;
     
   public: /* Public accessors */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
+    /* Identify if the graph is frozen, i.e., compacted and not modified since, see freeze() */
+    bool frozen() const;
     size_t num_modules() const;
     size_t num_nets(const ModuleId& module) const;
     std::string module_name(const ModuleId& module_id) const;
@@ -173,14 +141,35 @@ class ModuleManager {
     /* Find a port of a module by a given name */
     ModulePortId find_module_port(const ModuleId& module_id, const std::string& port_name) const;
     /* Find the Port information with a given port id */
-    BasicPort module_port(const ModuleId& module_id, const ModulePortId& port_id) const;
-    /* Find a module by a given name */
+    const BasicPort& module_port(const ModuleId& module_id, const ModulePortId& port_id) const;
+    /* Find a module by a given name
+     * The name of a module merged into another one (see set_module_alias()) gives the other module
+     */
     ModuleId find_module(const std::string& name) const;
+    /* Find the module which a module is merged into, or an invalid id if it is not merged */
+    ModuleId module_alias_target(const ModuleId& module) const;
+    /* Identify if a name is the name of a module merged into another one */
+    bool is_module_alias(const std::string& name) const;
     /* Find the number of instances of a child module in the parent module */
     size_t num_instance(const ModuleId& parent_module, const ModuleId& child_module) const;
-    /* Find the instance name of a child module */
+    /* Find the instance name of a child module
+     * An empty name is returned if the instance is not named
+     */
     std::string instance_name(const ModuleId& parent_module, const ModuleId& child_module,
                               const size_t& instance_id) const;
+    /* Find the prefix of the instances of a child module which are named by coordinates
+     * An empty prefix is returned if no instance is named by its coordinate
+     */
+    std::string instance_coordinate_prefix(const ModuleId& parent_module, const ModuleId& child_module) const;
+    /* Find the coordinate after which an instance is named (see set_child_instance_coordinate_name())
+     * An invalid coordinate is returned if the instance is not named by a coordinate
+     */
+    vtr::Point<size_t> instance_coordinate(const ModuleId& parent_module, const ModuleId& child_module,
+                                           const size_t& instance_id) const;
+    /* Find the names of the instances of a child module which are set explicitly,
+     * which have the priority over the names generated from coordinates
+     */
+    const std::map<size_t, std::string>& explicit_instance_names(const ModuleId& parent_module, const ModuleId& child_module) const;
     /* Find the instance id of a given instance name */
     size_t instance_id(const ModuleId& parent_module, const ModuleId& child_module,
                        const std::string& instance_name) const;
@@ -208,6 +197,14 @@ class ModuleManager {
     vtr::vector<ModuleNetSrcId, ModulePortId> net_source_ports(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the source pin indices of a net */
     vtr::vector<ModuleNetSrcId, size_t> net_source_pins(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the module of a source of a net */
+    ModuleId net_source_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the instance id of a source of a net */
+    size_t net_source_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the port of a source of a net */
+    ModulePortId net_source_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
+    /* Find the pin index of a source of a net */
+    size_t net_source_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSrcId& net_src) const;
     /* Identify if a pin of a port in a module already exists in the net source list*/
     bool net_source_exist(const ModuleId& module, const ModuleNetId& net,
                           const ModuleId& src_module, const size_t& instance_id,
@@ -221,13 +218,51 @@ class ModuleManager {
     vtr::vector<ModuleNetSinkId, ModulePortId> net_sink_ports(const ModuleId& module, const ModuleNetId& net) const;
     /* Find the sink pin indices of a net */
     vtr::vector<ModuleNetSinkId, size_t> net_sink_pins(const ModuleId& module, const ModuleNetId& net) const;
+    /* Find the module of a sink of a net */
+    ModuleId net_sink_module(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Find the instance id of a sink of a net */
+    size_t net_sink_instance(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Find the port of a sink of a net */
+    ModulePortId net_sink_port(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
+    /* Find the pin index of a sink of a net */
+    size_t net_sink_pin(const ModuleId& module, const ModuleNetId& net, const ModuleNetSinkId& net_sink) const;
     /* Identify if a pin of a port in a module already exists in the net sink list*/
     bool net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                         const ModuleId& sink_module, const size_t& instance_id,
                         const ModulePortId& sink_port, const size_t& sink_pin);
 
+  private: /* Private data structures */
+    /* A terminal (either source or sink) of a net, i.e., a pin of a port of a module instance
+     * All the fields of a terminal are stored together, 
+     * so that walking through the terminals of a net only touches one array 
+     */
+    struct ModuleNetTerminal {
+      ModuleId module;
+      ModulePortId port;
+      size_t instance;
+      size_t pin;
+    };
+    /* Names of the instances of a child module in a parent module
+     * Most instances in the top-level module are named after their coordinates,
+     * e.g., grid_clb_1__2_, whose names are generated on demand from a common prefix
+     * Other names are stored as they are set, which are usually few
+     */
+    struct ChildInstanceNames {
+      std::string coordinate_prefix;
+      std::vector<vtr::Point<size_t>> coordinates;   /* Invalid for instances not named by coordinates */
+      bool coordinates_sorted = true;                /* Coordinates are added in ascending order, which enables binary search */
+      std::map<size_t, std::string> names;           /* Names set explicitly */
+      std::map<std::string, size_t> name_lookup;     /* Reverse look-up of the names set explicitly */
+      size_t memory_usage() const;
+    };
   private: /* Private accessors */
     size_t find_child_module_index_in_parent_module(const ModuleId& parent_module, const ModuleId& child_module) const;
+    /* Find the net connected to a pin of an instance in the fast look-up,
+     * instance id, port and pin should be validated by the caller
+     */
+    ModuleNetId& find_net_lookup_entry(const ModuleId& parent_module,
+                                       const ModuleId& child_module, const size_t& child_instance,
+                                       const ModulePortId& child_port, const size_t& child_pin) const;
   public: /* Public mutators */
     /* Add a module */
     ModuleId add_module(const std::string& name);
@@ -250,8 +285,18 @@ class ModuleManager {
     void set_port_preproc_flag(const ModuleId& module, const ModulePortId& port, const std::string& preproc_flag);
     /* Add a child module to a parent module */
     void add_child_module(const ModuleId& parent_module, const ModuleId& child_module);
+    /* Replace a child module of a parent module by another one, keeping the instances, their names and nets.
+     * The new child module must have the same pins and must not be a child of the parent module yet
+     */
+    void replace_child_module(const ModuleId& parent_module, const ModuleId& old_child_module, const ModuleId& new_child_module);
     /* Set the instance name of a child module */
     void set_child_instance_name(const ModuleId& parent_module, const ModuleId& child_module, const size_t& instance_id, const std::string& instance_name);
+    /* Name an instance of a child module after a coordinate, in the format of <prefix>_<x>__<y>_
+     * The name is generated on demand, which avoids storing a string for each instance
+     * All the instances named by coordinates of a child module should share the same prefix
+     */
+    void set_child_instance_coordinate_name(const ModuleId& parent_module, const ModuleId& child_module, const size_t& instance_id,
+                                            const std::string& prefix, const vtr::Point<size_t>& coordinate);
     /* Add a configurable child module to module */
     void add_configurable_child(const ModuleId& module, const ModuleId& child_module, const size_t& child_instance);
     /* Reserved a number of configurable children
@@ -304,6 +349,31 @@ class ModuleManager {
     ModuleNetSinkId add_module_net_sink(const ModuleId& module, const ModuleNetId& net,
                                         const ModuleId& sink_module, const size_t& instance_id,
                                         const ModulePortId& sink_port, const size_t& sink_pin);
+
+    /* Copy a list of modules from another module manager, in the sequence of the list
+     * This is used to merge the modules built in a private copy of the module manager
+     * - module_map maps the ids of modules in the other module manager to the ids in this module manager.
+     *   It must map all the modules which are instanciated by the copied modules but not in the list,
+     *   and it will be updated with the copied modules
+     * - A module whose name is already used in this module manager is not copied
+     *   but mapped to the existing module, which is assumed to be identical
+     */
+    void add_modules_from(const ModuleManager& other,
+                          const std::vector<ModuleId>& other_modules,
+                          vtr::vector<ModuleId, ModuleId>& module_map);
+    /* Merge a module which is not instanciated into an identical module:
+     * its name will then give the target module in find_module(),
+     * so that the modules built later instanciate the target module instead.
+     * The module is kept in the module manager but should not be output
+     */
+    void set_module_alias(const ModuleId& module, const ModuleId& target_module);
+    /* Compact the storage of the graph once it is completely built:
+     * the containers grown by the builders are shrunk to their contents.
+     * The fast look-ups are always up-to-date, so that the const accessors
+     * of a frozen graph can be called concurrently.
+     * Any mutator growing the graph afterwards unfreezes it
+     */
+    void freeze();
   public: /* Public deconstructors */
     /* This is a strong function which will remove all the configurable children 
      * under a given parent module
@@ -318,6 +388,14 @@ class ModuleManager {
      * Do NOT use unless you know what you are doing!!!
      */
     void clear_config_region(const ModuleId& parent_module);
+
+    /* This is a strong function which will remove a module and all the modules
+     * added after it, e.g., the top-level module and the decoders built for it
+     * The modules before it must not instanciate any of the removed modules
+     * It is mainly used to rebuild the top-level module with another fabric key
+     * Do NOT use unless you know what you are doing!!!
+     */
+    void remove_modules_from(const ModuleId& first_module);
   public: /* Public validators/invalidators */
     bool valid_module_id(const ModuleId& module) const;
     bool valid_module_port_id(const ModuleId& module, const ModulePortId& port) const;
@@ -339,7 +417,8 @@ class ModuleManager {
     vtr::vector<ModuleId, std::vector<ModuleId>> parents_;                 /* Parent modules that include the module */
     vtr::vector<ModuleId, std::vector<ModuleId>> children_;                /* Child modules that this module contain */
     vtr::vector<ModuleId, std::vector<size_t>> num_child_instances_;          /* Number of children instance in each child module */
-    vtr::vector<ModuleId, std::vector<std::vector<std::string>>> child_instance_names_;          /* Number of children instance in each child module */
+    vtr::vector<ModuleId, std::vector<ChildInstanceNames>> child_instance_names_;          /* Names of children instance in each child module */
+    vtr::vector<ModuleId, ModuleId> alias_targets_;                        /* Module which a module is merged into, if any */
 
     /* Configurable child modules are used to record the position of configurable modules in bitstream
      * The sequence of children in the list denotes which one is configured first, etc. 
@@ -365,7 +444,7 @@ class ModuleManager {
     vtr::vector<ModuleId, vtr::vector<ModulePortId, bool>> port_is_mappable_io_; /* If the port is mappable  to an I/O for user's implementations */ 
     vtr::vector<ModuleId, vtr::vector<ModulePortId, bool>> port_is_wire_; /* If the port is a wire, use for Verilog port definition. If enabled: <port_type> reg <port_name>  */ 
     vtr::vector<ModuleId, vtr::vector<ModulePortId, bool>> port_is_register_; /* If the port is a register, use for Verilog port definition. If enabled: <port_type> reg <port_name>  */ 
-    vtr::vector<ModuleId, vtr::vector<ModulePortId, std::string>> port_preproc_flags_; /* If a port is available only when a pre-processing flag is enabled. This is to record the pre-processing flags */ 
+    vtr::vector<ModuleId, vtr::vector<ModulePortId, vtr::StringId>> port_preproc_flags_; /* If a port is available only when a pre-processing flag is enabled. This is to record the pre-processing flags */ 
 
     /* Graph-level data: 
      * We use nets to model the connection between pins of modules and instances.  
@@ -374,33 +453,50 @@ class ModuleManager {
      */
     vtr::vector<ModuleId, size_t> num_nets_;    /* List of nets for each Module */ 
     vtr::vector<ModuleId, std::unordered_set<ModuleNetId>> invalid_net_ids_;   /* Invalid net ids */
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, std::string>> net_names_;    /* Name of net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::StringId>> net_names_;    /* Name of net */ 
 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, ModuleNetSrcId>>> net_src_ids_;  /* Unique id of the source that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_terminal_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_instance_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, size_t>>> net_src_pin_ids_;  /* Pin ids that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSrcId, ModuleNetTerminal>>> net_srcs_;  /* Terminals that drive the net */ 
+    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, ModuleNetTerminal>>> net_sinks_;  /* Terminals that the net drives */ 
 
+    /* Source and sink ids are always contiguous, these sets are always empty.
+     * They are only required by the iterators of source and sink ids
+     */
+    std::unordered_set<ModuleNetSrcId> invalid_net_src_ids_;
+    std::unordered_set<ModuleNetSinkId> invalid_net_sink_ids_;
 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, ModuleNetSinkId>>> net_sink_ids_;  /* Unique ids of the sink that the net drives */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_terminal_ids_;  /* Pin ids that the net drives */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_instance_ids_;  /* Pin ids that drive the net */ 
-    vtr::vector<ModuleId, vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>> net_sink_pin_ids_;  /* Pin ids that drive the net */ 
+    /* Pool of the net names and the pre-processing flags, 
+     * which are mostly empty or repeated across modules
+     */
+    vtr::StringPool string_pool_;
 
     /* fast look-up for module */
-    std::map<std::string, ModuleId> name_id_map_;
+    std::unordered_map<std::string, ModuleId> name_id_map_;
     /* fast look-up for ports */
     typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>> PortLookup;
     mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */ 
+    /* fast look-up for ports by name: [module_ids][port_name] -> the first port with the name */
+    vtr::vector<ModuleId, std::unordered_map<std::string, ModulePortId>> port_name_lookup_;
 
-    /* fast look-up for nets */
-    typedef vtr::vector<ModuleId, std::map<ModuleId, std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>>> NetLookup;
-    mutable NetLookup net_lookup_; /* [module_ids][module_ids][instance_ids][port_ids][pin_ids] */ 
+    /* fast look-up for child modules: [parent_module][child_module] -> index in the child list */
+    vtr::vector<ModuleId, std::unordered_map<ModuleId, size_t>> child_index_lookup_;
 
-    /* Store pairs of a module and a port, which are frequently used in net terminals
-     * (either source or sink)
+    /* Pins of all the ports of a module are indexed in a flat way,
+     * where the index of a pin is the first pin of its port plus the pin index in the port
+     */
+    vtr::vector<ModuleId, vtr::vector<ModulePortId, size_t>> port_first_pins_; /* [module_ids][port_ids] */
+    vtr::vector<ModuleId, size_t> num_pins_; /* Total number of pins of the ports of a module */
+
+    /* fast look-up for nets 
+     * For each parent module, the nets of pins are stored by child modules, 
+     * where the pins of each instance of a child module are contiguous:
+     *   [parent_module][child_index + 1][instance_id * num_pins_[child_module] + pin index]
+     * The first list is reserved for the pins of the parent module itself
      */
-    std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+    typedef vtr::vector<ModuleId, std::vector<std::vector<ModuleNetId>>> NetLookup;
+    mutable NetLookup net_lookup_; 
+
+    /* If the graph is compacted and not modified since, see freeze() */
+    bool frozen_ = false;
 };
 
 } /* end namespace openfpga */
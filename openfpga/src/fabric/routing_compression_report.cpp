@@ -0,0 +1,399 @@
+/********************************************************************
+ * This file includes functions that report how well the routing blocks
+ * of a FPGA fabric are compressed into unique modules, in order to find
+ * where the regularity of the routing architecture breaks.
+ *
+ * The size of each routing block is estimated from its routing resources:
+ *  - the module graph of a block contains its ports and routing multiplexers
+ *  - the netlist of a block contains its ports and the inputs of its multiplexers
+ * Each unique module is built and written once, so the other instances
+ * of a unique module are the savings of the compression.
+ *
+ * A location is non-mirrored when its unique module has a single instance
+ *******************************************************************/
+#include <fstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+#include "openfpga_side_manager.h"
+
+#include "routing_compression_report.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Kinds of routing blocks whose compression is reported */
+enum e_routing_block_kind {
+  ROUTING_BLOCK_SB,
+  ROUTING_BLOCK_CBX,
+  ROUTING_BLOCK_CBY,
+  ROUTING_BLOCK_GSB,
+  NUM_ROUTING_BLOCK_KINDS
+};
+static const char* ROUTING_BLOCK_KIND_NAMES[NUM_ROUTING_BLOCK_KINDS] = {"sb", "cbx", "cby", "gsb"};
+
+/* Characters of the heatmaps */
+constexpr char HEATMAP_MIRRORED = '.';
+constexpr char HEATMAP_NON_MIRRORED = 'x';
+constexpr char HEATMAP_EMPTY = ' ';
+
+/********************************************************************
+ * Estimated size of a routing block
+ *******************************************************************/
+struct t_routing_block_size {
+  bool exist = false;
+  size_t num_ports = 0;
+  size_t num_muxes = 0;
+  size_t num_mux_inputs = 0;
+
+  size_t module_graph_size() const { return num_ports + num_muxes; }
+  size_t netlist_size() const { return num_ports + num_mux_inputs; }
+
+  void add(const t_routing_block_size& other) {
+    num_ports += other.num_ports;
+    num_muxes += other.num_muxes;
+    num_mux_inputs += other.num_mux_inputs;
+  }
+};
+
+/********************************************************************
+ * Statistics of a kind of routing blocks, indexed by unique module ids
+ *******************************************************************/
+struct t_routing_compression_stats {
+  size_t num_blocks = 0;
+  size_t num_non_mirrored_blocks = 0;
+  size_t flat_module_graph_size = 0;
+  size_t flat_netlist_size = 0;
+  size_t saved_module_graph_size = 0;
+  size_t saved_netlist_size = 0;
+  std::vector<size_t> module_num_instances;
+  std::vector<vtr::Point<size_t>> module_coordinates;
+  std::vector<t_routing_block_size> module_sizes;
+  /* Rows of the heatmap, from the top to the bottom of the fabric */
+  std::vector<std::string> heatmap;
+};
+
+/********************************************************************
+ * Estimate the size of the switch block of a GSB
+ * The passing wires are not driven by multiplexers
+ *******************************************************************/
+static
+t_routing_block_size find_sb_size(const RRGSB& rr_gsb,
+                                  const RRGraph& rr_graph) {
+  t_routing_block_size sb_size;
+  sb_size.exist = rr_gsb.is_sb_exist();
+  if (false == sb_size.exist) {
+    return sb_size;
+  }
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    const e_side& gsb_side = side_manager.get_side();
+    sb_size.num_ports += rr_gsb.get_chan_width(gsb_side) + rr_gsb.get_num_opin_nodes(gsb_side);
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(gsb_side); ++itrack) {
+      if (OUT_PORT != rr_gsb.get_chan_node_direction(gsb_side, itrack)) {
+        continue;
+      }
+      if (true == rr_gsb.is_sb_node_passing_wire(rr_graph, gsb_side, itrack)) {
+        continue;
+      }
+      sb_size.num_muxes++;
+      sb_size.num_mux_inputs += rr_gsb.get_chan_node_in_edges(rr_graph, gsb_side, itrack).size();
+    }
+  }
+
+  return sb_size;
+}
+
+/********************************************************************
+ * Estimate the size of a connection block of a GSB
+ * The routing tracks pass through the connection block,
+ * while each input pin is driven by a multiplexer
+ *******************************************************************/
+static
+t_routing_block_size find_cb_size(const RRGSB& rr_gsb,
+                                  const RRGraph& rr_graph,
+                                  const t_rr_type& cb_type) {
+  t_routing_block_size cb_size;
+  cb_size.exist = rr_gsb.is_cb_exist(cb_type);
+  if (false == cb_size.exist) {
+    return cb_size;
+  }
+
+  cb_size.num_ports += 2 * rr_gsb.get_cb_chan_width(cb_type);
+  for (const e_side& ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(ipin_side); ++inode) {
+      const RRNodeId& ipin_node = rr_gsb.get_ipin_node(ipin_side, inode);
+      cb_size.num_ports++;
+      cb_size.num_muxes++;
+      cb_size.num_mux_inputs += rr_graph.node_in_edges(ipin_node).size();
+    }
+  }
+
+  return cb_size;
+}
+
+/********************************************************************
+ * Find the id of the unique module of a routing block
+ *******************************************************************/
+static
+size_t find_routing_block_unique_module_id(const DeviceRRGSB& device_rr_gsb,
+                                           const e_routing_block_kind& kind,
+                                           const vtr::Point<size_t>& gsb_coord) {
+  switch (kind) {
+    case ROUTING_BLOCK_SB:
+      return device_rr_gsb.get_sb_unique_module_id(gsb_coord);
+    case ROUTING_BLOCK_CBX:
+      return device_rr_gsb.get_cb_unique_module_id(CHANX, gsb_coord);
+    case ROUTING_BLOCK_CBY:
+      return device_rr_gsb.get_cb_unique_module_id(CHANY, gsb_coord);
+    case ROUTING_BLOCK_GSB:
+      return device_rr_gsb.get_gsb_unique_module_id(gsb_coord);
+    default:
+      VTR_ASSERT_MSG(false, "Invalid kind of routing blocks");
+  }
+  return 0;
+}
+
+static
+size_t find_routing_block_num_unique_modules(const DeviceRRGSB& device_rr_gsb,
+                                             const e_routing_block_kind& kind) {
+  switch (kind) {
+    case ROUTING_BLOCK_SB:
+      return device_rr_gsb.get_num_sb_unique_module();
+    case ROUTING_BLOCK_CBX:
+      return device_rr_gsb.get_num_cb_unique_module(CHANX);
+    case ROUTING_BLOCK_CBY:
+      return device_rr_gsb.get_num_cb_unique_module(CHANY);
+    case ROUTING_BLOCK_GSB:
+      return device_rr_gsb.get_num_gsb_unique_module();
+    default:
+      VTR_ASSERT_MSG(false, "Invalid kind of routing blocks");
+  }
+  return 0;
+}
+
+/********************************************************************
+ * Estimate the size of all the routing blocks, in parallel across
+ * the coordinates of the GSBs. The sizes are indexed by kind
+ * and then by the coordinate index x * range.y() + y
+ * A GSB is as large as its switch block and connection blocks together
+ *******************************************************************/
+static
+std::vector<std::vector<t_routing_block_size>> find_routing_block_sizes(const DeviceRRGSB& device_rr_gsb,
+                                                                        const RRGraph& rr_graph,
+                                                                        const size_t& num_threads) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  size_t num_coords = gsb_range.x() * gsb_range.y();
+  std::vector<std::vector<t_routing_block_size>> block_sizes(NUM_ROUTING_BLOCK_KINDS,
+                                                             std::vector<t_routing_block_size>(num_coords));
+
+  /* Each coordinate only writes its own sizes */
+  parallel_for(num_coords, num_threads,
+               [&](const size_t& icoord) {
+                 vtr::Point<size_t> gsb_coord(icoord / gsb_range.y(), icoord % gsb_range.y());
+                 const RRGSB& rr_gsb = device_rr_gsb.get_gsb(gsb_coord);
+                 block_sizes[ROUTING_BLOCK_SB][icoord] = find_sb_size(rr_gsb, rr_graph);
+                 block_sizes[ROUTING_BLOCK_CBX][icoord] = find_cb_size(rr_gsb, rr_graph, CHANX);
+                 block_sizes[ROUTING_BLOCK_CBY][icoord] = find_cb_size(rr_gsb, rr_graph, CHANY);
+
+                 t_routing_block_size& gsb_size = block_sizes[ROUTING_BLOCK_GSB][icoord];
+                 gsb_size.exist = device_rr_gsb.is_gsb_exist(gsb_coord);
+                 if (true == gsb_size.exist) {
+                   gsb_size.add(block_sizes[ROUTING_BLOCK_SB][icoord]);
+                   gsb_size.add(block_sizes[ROUTING_BLOCK_CBX][icoord]);
+                   gsb_size.add(block_sizes[ROUTING_BLOCK_CBY][icoord]);
+                 }
+               });
+
+  return block_sizes;
+}
+
+/********************************************************************
+ * Gather the statistics of a kind of routing blocks from their sizes
+ * The size of a unique module is the one of its first instance
+ *******************************************************************/
+static
+t_routing_compression_stats find_routing_compression_stats(const DeviceRRGSB& device_rr_gsb,
+                                                           const e_routing_block_kind& kind,
+                                                           const std::vector<t_routing_block_size>& block_sizes) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  size_t num_unique_modules = find_routing_block_num_unique_modules(device_rr_gsb, kind);
+
+  t_routing_compression_stats stats;
+  stats.module_num_instances.resize(num_unique_modules, 0);
+  stats.module_coordinates.resize(num_unique_modules);
+  stats.module_sizes.resize(num_unique_modules);
+
+  for (size_t x = 0; x < gsb_range.x(); ++x) {
+    for (size_t y = 0; y < gsb_range.y(); ++y) {
+      const t_routing_block_size& block_size = block_sizes[x * gsb_range.y() + y];
+      if (false == block_size.exist) {
+        continue;
+      }
+      vtr::Point<size_t> gsb_coord(x, y);
+      size_t module_id = find_routing_block_unique_module_id(device_rr_gsb, kind, gsb_coord);
+      VTR_ASSERT(module_id < num_unique_modules);
+      if (0 == stats.module_num_instances[module_id]) {
+        stats.module_coordinates[module_id] = gsb_coord;
+        stats.module_sizes[module_id] = block_size;
+      }
+      stats.module_num_instances[module_id]++;
+      stats.num_blocks++;
+      stats.flat_module_graph_size += block_size.module_graph_size();
+      stats.flat_netlist_size += block_size.netlist_size();
+    }
+  }
+
+  for (size_t module_id = 0; module_id < num_unique_modules; ++module_id) {
+    if (0 == stats.module_num_instances[module_id]) {
+      continue;
+    }
+    if (1 == stats.module_num_instances[module_id]) {
+      stats.num_non_mirrored_blocks++;
+    }
+    size_t num_mirrors = stats.module_num_instances[module_id] - 1;
+    stats.saved_module_graph_size += num_mirrors * stats.module_sizes[module_id].module_graph_size();
+    stats.saved_netlist_size += num_mirrors * stats.module_sizes[module_id].netlist_size();
+  }
+
+  /* Heatmap rows go from the top to the bottom, as the fabric is drawn */
+  for (size_t y = gsb_range.y(); y > 0; --y) {
+    std::string row(gsb_range.x(), HEATMAP_EMPTY);
+    for (size_t x = 0; x < gsb_range.x(); ++x) {
+      if (false == block_sizes[x * gsb_range.y() + y - 1].exist) {
+        continue;
+      }
+      size_t module_id = find_routing_block_unique_module_id(device_rr_gsb, kind, vtr::Point<size_t>(x, y - 1));
+      row[x] = (1 == stats.module_num_instances[module_id]) ? HEATMAP_NON_MIRRORED : HEATMAP_MIRRORED;
+    }
+    stats.heatmap.push_back(row);
+  }
+
+  return stats;
+}
+
+/********************************************************************
+ * Write the statistics of all the kinds of routing blocks to a JSON file
+ *
+ * Return 0 if succeed, otherwise return 1
+ *******************************************************************/
+static
+int write_routing_compression_stats_to_json_file(const std::vector<t_routing_compression_stats>& all_stats,
+                                                 const std::string& fname) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "{";
+  for (size_t kind = 0; kind < NUM_ROUTING_BLOCK_KINDS; ++kind) {
+    const t_routing_compression_stats& stats = all_stats[kind];
+    fp << (0 == kind ? "\n" : ",\n");
+    fp << "  \"" << ROUTING_BLOCK_KIND_NAMES[kind] << "\": {\n";
+    fp << "    \"num_blocks\": " << stats.num_blocks << ",\n";
+    fp << "    \"num_unique_modules\": " << stats.module_num_instances.size() << ",\n";
+    fp << "    \"num_non_mirrored_blocks\": " << stats.num_non_mirrored_blocks << ",\n";
+    fp << "    \"flat_module_graph_size\": " << stats.flat_module_graph_size << ",\n";
+    fp << "    \"saved_module_graph_size\": " << stats.saved_module_graph_size << ",\n";
+    fp << "    \"flat_netlist_size\": " << stats.flat_netlist_size << ",\n";
+    fp << "    \"saved_netlist_size\": " << stats.saved_netlist_size << ",\n";
+
+    fp << "    \"modules\": [";
+    for (size_t module_id = 0; module_id < stats.module_num_instances.size(); ++module_id) {
+      const t_routing_block_size& module_size = stats.module_sizes[module_id];
+      fp << (0 == module_id ? "\n" : ",\n");
+      fp << "      {\"id\": " << module_id;
+      fp << ", \"x\": " << stats.module_coordinates[module_id].x();
+      fp << ", \"y\": " << stats.module_coordinates[module_id].y();
+      fp << ", \"num_instances\": " << stats.module_num_instances[module_id];
+      fp << ", \"num_ports\": " << module_size.num_ports;
+      fp << ", \"num_muxes\": " << module_size.num_muxes;
+      fp << ", \"num_mux_inputs\": " << module_size.num_mux_inputs;
+      fp << "}";
+    }
+    fp << "\n    ],\n";
+
+    fp << "    \"heatmap\": [";
+    for (size_t irow = 0; irow < stats.heatmap.size(); ++irow) {
+      fp << (0 == irow ? "\n" : ",\n");
+      fp << "      \"" << stats.heatmap[irow] << "\"";
+    }
+    fp << "\n    ]\n";
+    fp << "  }";
+  }
+  fp << "\n}\n";
+
+  fp.close();
+
+  return 0;
+}
+
+/********************************************************************
+ * Report the compression of the routing blocks into unique modules:
+ * the number of instances of each unique module, the estimated savings
+ * in the module graph and the netlists, and the heatmaps of the locations
+ * which are not mirrored (shown in verbose mode)
+ * The statistics are also written to a JSON file if a name is given
+ *
+ * Return 0 if succeed, otherwise return 1
+ *******************************************************************/
+int report_routing_compression(const DeviceRRGSB& device_rr_gsb,
+                               const RRGraph& rr_graph,
+                               const bool& compact_routing_hierarchy,
+                               const std::string& json_fname,
+                               const size_t& num_threads,
+                               const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Report compression of routing hierarchy");
+
+  if (false == compact_routing_hierarchy) {
+    VTR_LOG_ERROR("The unique routing modules are not identified!\n\tPlease enable the option '--compress_routing' of the command 'build_fabric'.\n");
+    return 1;
+  }
+
+  std::vector<std::vector<t_routing_block_size>> block_sizes = find_routing_block_sizes(device_rr_gsb, rr_graph, num_threads);
+
+  std::vector<t_routing_compression_stats> all_stats;
+  for (size_t kind = 0; kind < NUM_ROUTING_BLOCK_KINDS; ++kind) {
+    all_stats.push_back(find_routing_compression_stats(device_rr_gsb, e_routing_block_kind(kind), block_sizes[kind]));
+  }
+
+  VTR_LOG("%6s %10s %10s %12s %14s %14s %14s %14s\n",
+          "Block", "Blocks", "Unique", "Non-mirrored",
+          "Graph size", "Graph saved", "Netlist size", "Netlist saved");
+  for (size_t kind = 0; kind < NUM_ROUTING_BLOCK_KINDS; ++kind) {
+    const t_routing_compression_stats& stats = all_stats[kind];
+    VTR_LOG("%6s %10lu %10lu %12lu %14lu %14lu %14lu %14lu\n",
+            ROUTING_BLOCK_KIND_NAMES[kind],
+            stats.num_blocks, stats.module_num_instances.size(), stats.num_non_mirrored_blocks,
+            stats.flat_module_graph_size, stats.saved_module_graph_size,
+            stats.flat_netlist_size, stats.saved_netlist_size);
+  }
+
+  for (size_t kind = 0; kind < NUM_ROUTING_BLOCK_KINDS; ++kind) {
+    VTR_LOGV(verbose,
+             "Non-mirrored locations of %s ('%c': non-mirrored, '%c': mirrored):\n",
+             ROUTING_BLOCK_KIND_NAMES[kind], HEATMAP_NON_MIRRORED, HEATMAP_MIRRORED);
+    for (const std::string& row : all_stats[kind].heatmap) {
+      VTR_LOGV(verbose, "\t|%s|\n", row.c_str());
+    }
+  }
+
+  if (false == json_fname.empty()) {
+    if (0 != write_routing_compression_stats_to_json_file(all_stats, json_fname)) {
+      return 1;
+    }
+    VTR_LOG("Wrote the compression of routing hierarchy to '%s'\n", json_fname.c_str());
+  }
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,27 @@
+#ifndef ROUTING_COMPRESSION_REPORT_H
+#define ROUTING_COMPRESSION_REPORT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "rr_graph_obj.h"
+#include "device_rr_gsb.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_routing_compression(const DeviceRRGSB& device_rr_gsb,
+                               const RRGraph& rr_graph,
+                               const bool& compact_routing_hierarchy,
+                               const std::string& json_fname,
+                               const size_t& num_threads,
+                               const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -14,6 +14,7 @@
 #include "openfpga_naming.h"
 
 #include "module_manager_utils.h"
+#include "bitstream_manager_utils.h"
 
 #include "build_grid_bitstream.h"
 #include "build_routing_bitstream.h"
@@ -144,6 +145,7 @@ size_t rec_estimate_device_bitstream_num_bits(const ModuleManager& module_manage
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const size_t& num_threads,
                                         const bool& verbose) {
 
   std::string timer_message = std::string("\nBuild fabric-independent bitstream for implementation '") + vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
@@ -190,6 +192,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                        openfpga_ctx.vpr_clustering_annotation(),
                        openfpga_ctx.vpr_placement_annotation(),
                        openfpga_ctx.vpr_bitstream_annotation(),
+                       num_threads,
                        verbose);
   VTR_LOGV(verbose, "Done\n");
 
@@ -204,7 +207,8 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                           openfpga_ctx.vpr_routing_annotation(),
                           vpr_ctx.device().rr_graph,
                           openfpga_ctx.device_rr_gsb(),
-                          openfpga_ctx.flow_manager().compress_routing());
+                          openfpga_ctx.flow_manager().compress_routing(),
+                          num_threads);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose,
@@ -218,4 +222,80 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   return bitstream_manager;
 }
 
+/********************************************************************
+ * Incrementally update a fabric-independent bitstream database
+ * which has been built by build_device_bitstream().
+ * Only the grids and the routing blocks of the GSBs given are regenerated,
+ * while the others are kept as they are.
+ * This is useful for Engineering Change Orders (ECO), where a few nets 
+ * are re-routed or a few blocks are re-packed.
+ *
+ * Note:
+ *   - Grids are found by their coordinates in the device grid,
+ *     and GSBs are found by their coordinates in the DeviceRRGSB
+ *   - The ids of blocks and bits are not changed
+ *
+ * The ids of the configuration bits whose values are changed are
+ * appended to changed_bits, which can be used to update a fabric-dependent bitstream
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if a grid or a GSB can not be updated, e.g., it is out of the device.
+ *    The bits changed before the error are still in changed_bits
+ *******************************************************************/
+int update_device_bitstream(BitstreamManager& bitstream_manager,
+                            const VprContext& vpr_ctx,
+                            const OpenfpgaContext& openfpga_ctx,
+                            const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                            const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                            std::vector<ConfigBitId>& changed_bits,
+                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Update fabric-independent bitstream");
+
+  /* Find the top-level block for bitstream */
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  ConfigBlockId top_block = top_blocks[0];
+  VTR_ASSERT(generate_fpga_top_module_name() == bitstream_manager.block_name(top_block));
+
+  int status = update_grid_bitstream(bitstream_manager, top_block,
+                                     openfpga_ctx.module_graph(),
+                                     openfpga_ctx.arch().circuit_lib,
+                                     openfpga_ctx.mux_lib(),
+                                     vpr_ctx.device().grid,
+                                     vpr_ctx.atom(),
+                                     openfpga_ctx.vpr_device_annotation(),
+                                     openfpga_ctx.vpr_clustering_annotation(),
+                                     openfpga_ctx.vpr_placement_annotation(),
+                                     openfpga_ctx.vpr_bitstream_annotation(),
+                                     grid_coordinates,
+                                     changed_bits,
+                                     verbose);
+  if (0 != status) {
+    return status;
+  }
+
+  status = update_routing_bitstream(bitstream_manager, top_block,
+                                    openfpga_ctx.module_graph(),
+                                    openfpga_ctx.arch().circuit_lib,
+                                    openfpga_ctx.mux_lib(),
+                                    vpr_ctx.atom(),
+                                    openfpga_ctx.vpr_device_annotation(),
+                                    openfpga_ctx.vpr_routing_annotation(),
+                                    vpr_ctx.device().rr_graph,
+                                    openfpga_ctx.device_rr_gsb(),
+                                    openfpga_ctx.flow_manager().compress_routing(),
+                                    gsb_coordinates,
+                                    changed_bits,
+                                    verbose);
+  if (0 != status) {
+    return status;
+  }
+
+  VTR_LOG("Updated %lu grids and %lu GSBs, where %lu configuration bits are changed\n",
+          grid_coordinates.size(), gsb_coordinates.size(), changed_bits.size());
+
+  return 0;
+}
+
 } /* end namespace openfpga */
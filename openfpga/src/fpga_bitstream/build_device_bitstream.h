@@ -17,8 +17,17 @@ namespace openfpga {
 
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const size_t& num_threads,
                                         const bool& verbose);
 
+int update_device_bitstream(BitstreamManager& bitstream_manager,
+                            const VprContext& vpr_ctx,
+                            const OpenfpgaContext& openfpga_ctx,
+                            const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                            const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                            std::vector<ConfigBitId>& changed_bits,
+                            const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
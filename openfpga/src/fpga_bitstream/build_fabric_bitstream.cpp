@@ -4,6 +4,8 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <functional>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -12,6 +14,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_decode.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
@@ -254,10 +257,170 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
   }
 }
 
+/********************************************************************
+ * Local addresses of the configuration bits under a module for
+ * frame-based configuration protocol, in the order of Depth-First Search.
+ * The local address of a bit contains all the address bits which are 
+ * decoded inside the module, i.e., all the address bits that are added
+ * to the head of the address code when walking down from the module.
+ * As a result, the address of a bit under any instance of a module is
+ *   <local_address_in_module> + <address_code_of_the_instance>
+ * which allows the local addresses to be built once per unique module
+ *******************************************************************/
+typedef std::map<ModuleId, std::vector<std::vector<char>>> FrameModuleLocalAddressCache;
+
+/********************************************************************
+ * Find the local addresses of the configuration bits under a module
+ * for frame-based configuration protocol. 
+ * If the module has not been visited, the local addresses are built
+ * from the given block:
+ *   - For a memory module (a leaf block), the local address of the i-th bit
+ *     is the binary code of i, decoded by the decoder inside the module,
+ *     which is the last of configurable children
+ *   - For other modules, the local address of a bit is its local address in
+ *     the child module, followed by the address code of the child, i.e.,
+ *     <dummy_codes> + <child_id>. The dummy codes (don't care bits) fill the gap 
+ *     between the address port of the child and the largest one among the children
+ *
+ * Note: 
+ *   - This function only accepts modules other than the top-level module
+ *   - References to the cache entries remain valid when new entries are inserted
+ *******************************************************************/
+static 
+const std::vector<std::vector<char>>& rec_find_frame_module_local_addresses(const BitstreamManager& bitstream_manager,
+                                                                            const ConfigBlockId& parent_block,
+                                                                            const ModuleManager& module_manager,
+                                                                            const ModuleId& parent_module,
+                                                                            const char& bitstream_dont_care_char,
+                                                                            FrameModuleLocalAddressCache& local_address_cache) {
+  FrameModuleLocalAddressCache::const_iterator cache_it = local_address_cache.find(parent_module);
+  if (cache_it != local_address_cache.end()) {
+    return cache_it->second;
+  }
+
+  std::vector<std::vector<char>> local_addresses;
+
+  const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(parent_module);
+
+  /* Leaf node (a memory module): the address comes from the decoder inside,
+   * which is the last of configurable children
+   */
+  if (0 == bitstream_manager.block_children(parent_block).size()) {
+    ModuleId decoder_module = configurable_children.back();
+    const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
+
+    size_t num_bits = bitstream_manager.block_bits(parent_block).size();
+    local_addresses.reserve(num_bits);
+    for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+      local_addresses.push_back(itobin_charvec(ibit, decoder_addr_port.get_width()));
+    }
+    return local_address_cache.emplace(parent_module, std::move(local_addresses)).first->second;
+  }
+
+  const std::vector<size_t>& configurable_child_instances = module_manager.configurable_child_instances(parent_module);
+  size_t num_configurable_children = configurable_children.size();
+
+  /* Ensure that there should be no configuration bits in the parent block */
+  VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
+
+  size_t max_child_addr_code_size = 0;
+  bool add_addr_code = true;
+  size_t decoder_addr_size = 0;
+
+  /* For only 1 configurable child, there is no frame decoder here */
+  if (1 == num_configurable_children) {
+    add_addr_code = false;
+  } else if (1 < num_configurable_children) {
+    VTR_ASSERT(2 < num_configurable_children);
+    num_configurable_children--;
+    ModuleId decoder_module = configurable_children.back();
+    const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    decoder_addr_size = module_manager.module_port(decoder_module, decoder_addr_port_id).get_width();
+
+    for (const ModuleId& child_module : configurable_children) {
+      /* Bypass any decoder module (which no configurable children */
+      if (module_manager.configurable_children(child_module).empty()) {
+        continue;
+      }
+      const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
+      max_child_addr_code_size = std::max(child_addr_port.get_width(), max_child_addr_code_size);
+    }
+  }
+
+  for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
+    ModuleId child_module = configurable_children[child_id]; 
+    size_t child_instance = configurable_child_instances[child_id]; 
+    std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
+    ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+
+    /* Address bits decoded at this level: <dummy_codes> + <child_id> */
+    std::vector<char> child_addr_code;
+    if (true == add_addr_code) {
+      const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
+      child_addr_code.assign(max_child_addr_code_size - child_addr_port.get_width(), bitstream_dont_care_char);
+      std::vector<char> addr_bits_vec = itobin_charvec(child_id, decoder_addr_size);
+      child_addr_code.insert(child_addr_code.end(), addr_bits_vec.begin(), addr_bits_vec.end());
+    }
+
+    const std::vector<std::vector<char>>& child_local_addresses = rec_find_frame_module_local_addresses(bitstream_manager, child_block,
+                                                                                                       module_manager, child_module,
+                                                                                                       bitstream_dont_care_char,
+                                                                                                       local_address_cache);
+    for (const std::vector<char>& child_local_address : child_local_addresses) {
+      std::vector<char> local_address;
+      local_address.reserve(child_local_address.size() + child_addr_code.size());
+      local_address.insert(local_address.end(), child_local_address.begin(), child_local_address.end());
+      local_address.insert(local_address.end(), child_addr_code.begin(), child_addr_code.end());
+      local_addresses.push_back(std::move(local_address));
+    }
+  }
+
+  return local_address_cache.emplace(parent_module, std::move(local_addresses)).first->second;
+}
+
+/********************************************************************
+ * Collect the configuration bits under a block in the order of
+ * Depth-First Search, which is the same order as the local addresses
+ * found by rec_find_frame_module_local_addresses()
+ *******************************************************************/
+static 
+void rec_collect_frame_module_bits(const BitstreamManager& bitstream_manager,
+                                   const ConfigBlockId& parent_block,
+                                   const ModuleManager& module_manager,
+                                   const ModuleId& parent_module,
+                                   std::vector<ConfigBitId>& config_bits) {
+  if (0 == bitstream_manager.block_children(parent_block).size()) {
+    const std::vector<ConfigBitId>& block_bits = bitstream_manager.block_bits(parent_block);
+    config_bits.insert(config_bits.end(), block_bits.begin(), block_bits.end());
+    return;
+  }
+
+  const std::vector<ModuleId>& configurable_children = module_manager.configurable_children(parent_module);
+  const std::vector<size_t>& configurable_child_instances = module_manager.configurable_child_instances(parent_module);
+  size_t num_configurable_children = configurable_children.size();
+  /* Bypass the decoder in the tail of the list */
+  if (1 < num_configurable_children) {
+    num_configurable_children--;
+  }
+
+  for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
+    ModuleId child_module = configurable_children[child_id]; 
+    size_t child_instance = configurable_child_instances[child_id]; 
+    std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
+    ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+    rec_collect_frame_module_bits(bitstream_manager, child_block, module_manager, child_module, config_bits);
+  }
+}
+
 /********************************************************************
  * This function aims to build a bitstream for frame-based configuration protocol
- * It will walk through all the configurable children under a module
- * in a recursive way, following a Depth-First Search (DFS) strategy
+ * It will walk through all the configurable children of a configuration region
+ * in the top-level module, following a Depth-First Search (DFS) strategy
  * For each configuration child, we use its instance name as a key to spot the 
  * configuration bits in bitstream manager.
  * Note that it is guarenteed that the instance name in module manager is 
@@ -271,215 +434,206 @@ void rec_build_module_fabric_dependent_memory_bank_bitstream(const BitstreamMana
  *    until the top in the hierarchy
  *
  * The address will be organized as follows:
- *  <Address_in_top> ... <Address_in_parent_module>
+ *  <Address_in_local_module> ... <Address_in_top>
  * The address will be decoded to a binary format
+ * The addresses under a child of the top-level module are the local addresses 
+ * of the child module (see rec_find_frame_module_local_addresses()),
+ * followed by the address code of the child at the top-level
  *
  * For each configuration bit, the data_in for the frame-based decoders will be 
  * the same as the configuration bit in bitstream manager.
  *******************************************************************/
 static 
-void rec_build_module_fabric_dependent_frame_bitstream(const BitstreamManager& bitstream_manager,
-                                                       const std::vector<ConfigBlockId>& parent_blocks,
+void build_top_module_fabric_dependent_frame_bitstream(const BitstreamManager& bitstream_manager,
+                                                       const ConfigBlockId& top_block,
                                                        const ModuleManager& module_manager,
                                                        const ModuleId& top_module,
                                                        const ConfigRegionId& config_region,
-                                                       const std::vector<ModuleId>& parent_modules,
                                                        const std::vector<char>& addr_code,
                                                        const char& bitstream_dont_care_char,
+                                                       FrameModuleLocalAddressCache& local_address_cache,
                                                        FabricBitstream& fabric_bitstream,
                                                        FabricBitRegionId& fabric_bitstream_region) {
+  /* Ensure that there should be no configuration bits in the top block */
+  VTR_ASSERT(0 == bitstream_manager.block_bits(top_block).size());
 
-  /* Depth-first search: if we have any children in the parent_block, 
-   * we dive to the next level first! 
-   */
-  if (0 < bitstream_manager.block_children(parent_blocks.back()).size()) {
-    const ConfigBlockId& parent_block = parent_blocks.back();
-    const ModuleId& parent_module = parent_modules.back();
-
-    std::vector<ModuleId> configurable_children;
-    std::vector<size_t> configurable_child_instances;
-    if (top_module == parent_module) {
-      configurable_children = module_manager.region_configurable_children(parent_module, config_region);
-      configurable_child_instances = module_manager.region_configurable_child_instances(parent_module, config_region);
-    } else {
-      VTR_ASSERT(top_module != parent_module);
-      configurable_children = module_manager.configurable_children(parent_module);
-      configurable_child_instances = module_manager.configurable_child_instances(parent_module);
-    }
+  std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
+  std::vector<size_t> configurable_child_instances = module_manager.region_configurable_child_instances(top_module, config_region);
 
-    size_t num_configurable_children = configurable_children.size();
+  size_t num_configurable_children = configurable_children.size();
  
-    size_t max_child_addr_code_size = 0;
-    bool add_addr_code = true;
-    ModuleId decoder_module = ModuleId::INVALID();
-
-    /* Early exit if there is no configurable children */
-    if (0 == num_configurable_children) {
-      /* Ensure that there should be no configuration bits in the parent block */
-      VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-      return;
-    }
+  size_t max_child_addr_code_size = 0;
+  bool add_addr_code = true;
+  ModuleId decoder_module = ModuleId::INVALID();
+
+  /* Early exit if there is no configurable children */
+  if (0 == num_configurable_children) {
+    return;
+  }
 
-    /* For only 1 configurable child,
-     * there is no frame decoder here, we can pass on addr code directly
+  /* For only 1 configurable child,
+   * there is no frame decoder here, we can pass on addr code directly
+   */
+  if (1 == num_configurable_children) {
+    add_addr_code = false;
+  } else {
+   /* For more than 2 children, there is a decoder in the tail of the list
+    * We will not decode that, but will access the address size from that module
+    * So, we reduce the number of children by 1
+    */
+    VTR_ASSERT(2 < num_configurable_children);
+    num_configurable_children--;
+    decoder_module = configurable_children.back();
+
+    /* The max address code size is the max address code size of all the 
+     * configurable children in all the regions
      */
-    if (1 == num_configurable_children) {
-      add_addr_code = false;
-    } else {
-     /* For more than 2 children, there is a decoder in the tail of the list
-      * We will not decode that, but will access the address size from that module
-      * So, we reduce the number of children by 1
-      */
-      VTR_ASSERT(2 < num_configurable_children);
-      num_configurable_children--;
-      decoder_module = configurable_children.back();
-
-      /* The max address code size is the max address code size of all the 
-       * configurable children in all the regions
-       */
-      for (const ModuleId& child_module : module_manager.configurable_children(parent_module)) {
-        /* Bypass any decoder module (which no configurable children */
-        if (module_manager.configurable_children(child_module).empty()) {
-          continue;
-        }
-        const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
-        max_child_addr_code_size = std::max(child_addr_port.get_width(), max_child_addr_code_size);
+    for (const ModuleId& child_module : module_manager.configurable_children(top_module)) {
+      /* Bypass any decoder module (which no configurable children */
+      if (module_manager.configurable_children(child_module).empty()) {
+        continue;
       }
+      const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
+      max_child_addr_code_size = std::max(child_addr_port.get_width(), max_child_addr_code_size);
     }
+  }
+
+  std::vector<ConfigBitId> config_bits;
+  std::vector<char> bit_addr_code;
+  for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
+    ModuleId child_module = configurable_children[child_id]; 
+    size_t child_instance = configurable_child_instances[child_id]; 
+    /* Get the instance name and ensure it is not empty */
+    std::string instance_name = module_manager.instance_name(top_module, child_module, child_instance);
+     
+    /* Find the child block that matches the instance name! */ 
+    ConfigBlockId child_block = bitstream_manager.find_child_block(top_block, instance_name); 
+    /* We must have one valid block id! */
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+
+    /* Set address, apply binary conversion from the first to the last element in the address list */
+    std::vector<char> child_addr_code = addr_code;
+
+    if (true == add_addr_code) { 
+      /* Find the address port from the decoder module */
+      const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
+      std::vector<char> addr_bits_vec = itobin_charvec(child_id, decoder_addr_port.get_width());
 
-    for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
-      ModuleId child_module = configurable_children[child_id]; 
-      size_t child_instance = configurable_child_instances[child_id]; 
-      /* Get the instance name and ensure it is not empty */
-      std::string instance_name = module_manager.instance_name(parent_module, child_module, child_instance);
-       
-      /* Find the child block that matches the instance name! */ 
-      ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name); 
-      /* We must have one valid block id! */
-      VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
-
-      /* Pass on the list of blocks, modules and address lists */
-      std::vector<ConfigBlockId> child_blocks = parent_blocks;
-      child_blocks.push_back(child_block);
-
-      std::vector<ModuleId> child_modules = parent_modules;
-      child_modules.push_back(child_module);
-
-      /* Set address, apply binary conversion from the first to the last element in the address list */
-      std::vector<char> child_addr_code = addr_code;
-
-      if (true == add_addr_code) { 
-        /* Find the address port from the decoder module */
-        const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
-        std::vector<char> addr_bits_vec = itobin_charvec(child_id, decoder_addr_port.get_width());
-
-        /* For top-level module, the child address should be added to the tail 
-         * For other modules, the child address should be added to the head
-         */
-        if (top_module == parent_module) {
-          child_addr_code.insert(child_addr_code.end(), addr_bits_vec.begin(), addr_bits_vec.end());
-        } else {
-          VTR_ASSERT_SAFE(top_module != parent_module);
-          child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
-        }
-
-        /* Note that the address port size of the child module may be smaller than the maximum
-         * of other child modules at this level.
-         * We will add dummy '0's to the head of addr_bit_vec.
-         *
-         * For example:
-         *  Decoder is the decoder to access all the child modules
-         *  whose address is decoded by the addr_bits_vec
-         *  The child modules may use part of the address lines,
-         *  we should add dummy '0' to fill the gap
-         *
-         *  Addr_code for child[0]: '000' + addr_bits_vec
-         *  Addr_code for child[1]: '00'  + addr_bits_vec 
-         *  Addr_code for child[2]: '0' + addr_bits_vec 
-         *
-         *                   Addr[6:8]
-         *                     |
-         *                     v
-         *  +-------------------------------------------+
-         *  |            Decoder Module                 |
-         *  +-------------------------------------------+
-         *   
-         *     Addr[0:2]       Addr[0:3]        Addr[0:4]
-         *        |                |               |
-         *        v                v               v
-         * +-----------+  +-------------+  +------------+
-         * | Child[0]  |  |  Child[1]   |  |  Child[2]  |
-         * +-----------+  +-------------+  +------------+
-         *
-         * Child[2] has the maximum address lines among the children
-         *
-         */
-        const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
-        if (0 < max_child_addr_code_size - child_addr_port.get_width()) {
-          /* Deposit don't care state for the dummy bits */
-          std::vector<char> dummy_codes(max_child_addr_code_size - child_addr_port.get_width(), bitstream_dont_care_char);
-          child_addr_code.insert(child_addr_code.begin(), dummy_codes.begin(), dummy_codes.end());
-        }
+      /* For top-level module, the child address should be added to the tail */
+      child_addr_code.insert(child_addr_code.end(), addr_bits_vec.begin(), addr_bits_vec.end());
+
+      /* Note that the address port size of the child module may be smaller than the maximum
+       * of other child modules at this level.
+       * We will add dummy '0's to the head of addr_bit_vec.
+       *
+       * For example:
+       *  Decoder is the decoder to access all the child modules
+       *  whose address is decoded by the addr_bits_vec
+       *  The child modules may use part of the address lines,
+       *  we should add dummy '0' to fill the gap
+       *
+       *  Addr_code for child[0]: '000' + addr_bits_vec
+       *  Addr_code for child[1]: '00'  + addr_bits_vec 
+       *  Addr_code for child[2]: '0' + addr_bits_vec 
+       *
+       *                   Addr[6:8]
+       *                     |
+       *                     v
+       *  +-------------------------------------------+
+       *  |            Decoder Module                 |
+       *  +-------------------------------------------+
+       *   
+       *     Addr[0:2]       Addr[0:3]        Addr[0:4]
+       *        |                |               |
+       *        v                v               v
+       * +-----------+  +-------------+  +------------+
+       * | Child[0]  |  |  Child[1]   |  |  Child[2]  |
+       * +-----------+  +-------------+  +------------+
+       *
+       * Child[2] has the maximum address lines among the children
+       *
+       */
+      const ModulePortId& child_addr_port_id = module_manager.find_module_port(child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+      const BasicPort& child_addr_port = module_manager.module_port(child_module, child_addr_port_id);
+      if (0 < max_child_addr_code_size - child_addr_port.get_width()) {
+        /* Deposit don't care state for the dummy bits */
+        std::vector<char> dummy_codes(max_child_addr_code_size - child_addr_port.get_width(), bitstream_dont_care_char);
+        child_addr_code.insert(child_addr_code.begin(), dummy_codes.begin(), dummy_codes.end());
       }
+    }
 
-      /* Go recursively */
-      rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager, child_blocks,
-                                                        module_manager,
-                                                        top_module,
-                                                        config_region,
-                                                        child_modules,
-                                                        child_addr_code,
-                                                        bitstream_dont_care_char,
-                                                        fabric_bitstream,
-                                                        fabric_bitstream_region);
+    /* Instances of the same module share the same local addresses, which are built only once.
+     * The address of each bit is the concatenation of its local address 
+     * and the address code of the child
+     */
+    const std::vector<std::vector<char>>& local_addresses = rec_find_frame_module_local_addresses(bitstream_manager, child_block,
+                                                                                                 module_manager, child_module,
+                                                                                                 bitstream_dont_care_char,
+                                                                                                 local_address_cache);
+    config_bits.clear();
+    config_bits.reserve(local_addresses.size());
+    rec_collect_frame_module_bits(bitstream_manager, child_block, module_manager, child_module, config_bits);
+    VTR_ASSERT(config_bits.size() == local_addresses.size());
+
+    for (size_t ibit = 0; ibit < config_bits.size(); ++ibit) {
+      bit_addr_code.assign(local_addresses[ibit].begin(), local_addresses[ibit].end());
+      bit_addr_code.insert(bit_addr_code.end(), child_addr_code.begin(), child_addr_code.end());
+
+      const FabricBitId& fabric_bit = fabric_bitstream.add_bit(config_bits[ibit]);
+
+      /* Set address */
+      fabric_bitstream.set_bit_address(fabric_bit, bit_addr_code);
+      
+      /* Set data input */
+      fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bits[ibit]));
+
+      /* Add the bit to the region */
+      fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
     }
-    /* Ensure that there should be no configuration bits in the parent block */
-    VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
-   
-    return;
   }
+}
 
-  /* Note that, reach here, it means that this is a leaf node. 
-   * A leaf node (a memory module) always has a decoder inside
-   * which is the last of configurable children.
-   * We will find the address bit and add it to addr_code
-   * Then we can add the configuration bits to the fabric_bitstream.
-   */
-  std::vector<ModuleId> configurable_children;
-  if (top_module == parent_modules.back()) {
-    configurable_children = module_manager.region_configurable_children(parent_modules.back(), config_region);
-  } else {
-    VTR_ASSERT(top_module != parent_modules.back());
-    configurable_children = module_manager.configurable_children(parent_modules.back());
+/********************************************************************
+ * Build the fabric bitstream region by region
+ * Configuration regions are independent from each other by construction.
+ * When multiple threads are used, each region is built in a private
+ * fabric bitstream, and the private fabric bitstreams are merged
+ * in the order of regions, so that the result is exactly the same 
+ * as a single-thread run
+ *******************************************************************/
+static
+void build_fabric_bitstream_regions(FabricBitstream& fabric_bitstream,
+                                    const ModuleManager& module_manager,
+                                    const ModuleId& top_module,
+                                    const size_t& num_threads,
+                                    const std::function<void(FabricBitstream&, const ConfigRegionId&)>& build_region) {
+  std::vector<ConfigRegionId> config_regions;
+  for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    config_regions.push_back(config_region);
   }
 
-  ModuleId decoder_module = configurable_children.back();
-  /* Find the address port from the decoder module */
-  const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-  const BasicPort& decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
-
-  for (size_t ibit = 0; ibit < bitstream_manager.block_bits(parent_blocks.back()).size(); ++ibit) {
-    
-    ConfigBitId config_bit = bitstream_manager.block_bits(parent_blocks.back())[ibit];
-    std::vector<char> addr_bits_vec = itobin_charvec(ibit, decoder_addr_port.get_width());
-
-    std::vector<char> child_addr_code = addr_code;
-
-    child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
+  size_t num_workers = std::min(find_num_threads(num_threads), config_regions.size());
+  if (1 >= num_workers) {
+    for (const ConfigRegionId& config_region : config_regions) {
+      build_region(fabric_bitstream, config_region);
+    }
+    return;
+  }
 
-    const FabricBitId& fabric_bit = fabric_bitstream.add_bit(config_bit);
+  /* No bits are added yet, so that private fabric bitstreams inherit the settings of addresses */
+  VTR_ASSERT(0 == fabric_bitstream.num_bits());
+  VTR_ASSERT(0 == fabric_bitstream.num_regions());
+  std::vector<FabricBitstream> region_fabric_bitstreams(config_regions.size(), fabric_bitstream);
 
-    /* Set address */
-    fabric_bitstream.set_bit_address(fabric_bit, child_addr_code);
-    
-    /* Set data input */
-    fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
+  parallel_for(config_regions.size(), num_workers,
+               [&](const size_t& iregion) {
+                 build_region(region_fabric_bitstreams[iregion], config_regions[iregion]);
+               });
 
-    /* Add the bit to the region */
-    fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
+  for (const FabricBitstream& region_fabric_bitstream : region_fabric_bitstreams) {
+    fabric_bitstream.add_sub_bitstream(region_fabric_bitstream);
   }
 }
 
@@ -493,6 +647,7 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
                                              const ConfigBlockId& top_block,
                                              const ModuleManager& module_manager,
                                              const ModuleId& top_module,
+                                             const size_t& num_threads,
                                              FabricBitstream& fabric_bitstream) {
 
   switch (config_protocol.type()) {
@@ -500,15 +655,16 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     /* Reserve bits before build-up */
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    build_fabric_bitstream_regions(fabric_bitstream, module_manager, top_module, num_threads,
+                                   [&](FabricBitstream& region_fabric_bitstream, const ConfigRegionId& config_region) {
+      FabricBitRegionId fabric_bitstream_region = region_fabric_bitstream.add_region();
       rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
                                                         module_manager, top_module, 
                                                         top_module,
                                                         config_region,
-                                                        fabric_bitstream,
+                                                        region_fabric_bitstream,
                                                         fabric_bitstream_region);
-    }
+    });
 
     break;
   }
@@ -516,16 +672,17 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     /* Reserve bits before build-up */
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    build_fabric_bitstream_regions(fabric_bitstream, module_manager, top_module, num_threads,
+                                   [&](FabricBitstream& region_fabric_bitstream, const ConfigRegionId& config_region) {
+      FabricBitRegionId fabric_bitstream_region = region_fabric_bitstream.add_region();
       rec_build_module_fabric_dependent_chain_bitstream(bitstream_manager, top_block,
                                                         module_manager, top_module, 
                                                         top_module,
                                                         config_region,
-                                                        fabric_bitstream,
+                                                        region_fabric_bitstream,
                                                         fabric_bitstream_region);
-      fabric_bitstream.reverse_region_bits(fabric_bitstream_region);
-    }
+      region_fabric_bitstream.reverse_region_bits(fabric_bitstream_region);
+    });
     break;
   }
   case CONFIG_MEM_MEMORY_BANK: { 
@@ -545,7 +702,8 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
     fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
     /* Build bitstreams by region */
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    build_fabric_bitstream_regions(fabric_bitstream, module_manager, top_module, num_threads,
+                                   [&](FabricBitstream& region_fabric_bitstream, const ConfigRegionId& config_region) {
       size_t cur_mem_index = 0;
 
       /* Find port information for local BL and WL decoder in this region */
@@ -561,7 +719,7 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
       BasicPort wl_port_info = module_manager.module_port(wl_decoder_module, wl_port);
 
       /* Build the bitstream for all the blocks in this region */
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+      FabricBitRegionId fabric_bitstream_region = region_fabric_bitstream.add_region();
       rec_build_module_fabric_dependent_memory_bank_bitstream(bitstream_manager, top_block,
                                                               module_manager, top_module, top_module, 
                                                               config_region,
@@ -570,9 +728,9 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
                                                               bl_port_info.get_width(),
                                                               wl_port_info.get_width(),
                                                               cur_mem_index,
-                                                              fabric_bitstream,
+                                                              region_fabric_bitstream,
                                                               fabric_bitstream_region);
-    }
+    });
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
@@ -583,8 +741,8 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
 
     /* Reserve bits before build-up */
     fabric_bitstream.set_use_address(true);
-    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
     fabric_bitstream.set_address_length(addr_port_info.get_width());
+    fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
     /* Avoid use don't care if there is only a region */
     char bitstream_dont_care_char = DONT_CARE_CHAR;
@@ -607,12 +765,13 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
       max_decoder_addr_size = std::max(max_decoder_addr_size, decoder_addr_port.get_width()); 
     }
 
-    for (const ConfigRegionId& config_region : module_manager.regions(top_module)) {
+    build_fabric_bitstream_regions(fabric_bitstream, module_manager, top_module, num_threads,
+                                   [&](FabricBitstream& region_fabric_bitstream, const ConfigRegionId& config_region) {
       std::vector<ModuleId> configurable_children = module_manager.region_configurable_children(top_module, config_region);
 
       /* Bypass non-configurable regions */
       if (0 == configurable_children.size()) {
-        continue;
+        return;
       }
 
       /* Find the idle address bit which should be added to the head of the address bit
@@ -635,18 +794,20 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
       VTR_ASSERT(max_decoder_addr_size >= decoder_addr_port.get_width());
       std::vector<char> idle_addr_bits(max_decoder_addr_size - decoder_addr_port.get_width(), bitstream_dont_care_char);
      
-      FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
-      rec_build_module_fabric_dependent_frame_bitstream(bitstream_manager,
-                                                        std::vector<ConfigBlockId>(1, top_block),
+      /* Local addresses are cached per region, so that threads do not share the cache */
+      FrameModuleLocalAddressCache local_address_cache;
+      FabricBitRegionId fabric_bitstream_region = region_fabric_bitstream.add_region();
+      build_top_module_fabric_dependent_frame_bitstream(bitstream_manager,
+                                                        top_block,
                                                         module_manager,
                                                         top_module,
                                                         config_region,
-                                                        std::vector<ModuleId>(1, top_module),
-	  												    idle_addr_bits,
+                                                        idle_addr_bits,
                                                         bitstream_dont_care_char,
-                                                        fabric_bitstream,
+                                                        local_address_cache,
+                                                        region_fabric_bitstream,
                                                         fabric_bitstream_region);
-    }
+    });
     break;
   }
   default:
@@ -695,6 +856,7 @@ void build_module_fabric_dependent_bitstream(const ConfigProtocol& config_protoc
 FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstream_manager,
                                                  const ModuleManager& module_manager,
                                                  const ConfigProtocol& config_protocol,
+                                                 const size_t& num_threads,
                                                  const bool& verbose) {
   FabricBitstream fabric_bitstream; 
 
@@ -715,6 +877,7 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
   build_module_fabric_dependent_bitstream(config_protocol,
                                           bitstream_manager, top_block[0],
                                           module_manager, top_module, 
+                                          num_threads,
                                           fabric_bitstream);
 
   VTR_LOGV(verbose,
@@ -724,4 +887,45 @@ FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstre
   return fabric_bitstream;
 }
 
+/********************************************************************
+ * Update the data inputs of a fabric-dependent bitstream in place
+ * after the values of a number of configuration bits are changed
+ * in the bitstream database, e.g., by update_device_bitstream()
+ *
+ * Note that only the configuration protocols using addresses store
+ * data inputs in the fabric bitstream. For the others, 
+ * the values are always read from the bitstream database, 
+ * so that nothing should be done here.
+ *******************************************************************/
+void update_fabric_dependent_bitstream(FabricBitstream& fabric_bitstream,
+                                       const BitstreamManager& bitstream_manager,
+                                       const std::vector<ConfigBitId>& changed_config_bits,
+                                       const bool& verbose) {
+  if ( (false == fabric_bitstream.use_address())
+    || (true == changed_config_bits.empty()) ) {
+    return;
+  }
+
+  /* Flag the changed configuration bits so that each fabric bit is probed in constant time */
+  std::vector<bool> config_bit_changed(bitstream_manager.num_bits(), false);
+  for (const ConfigBitId& config_bit : changed_config_bits) {
+    VTR_ASSERT(true == bitstream_manager.valid_bit_id(config_bit));
+    config_bit_changed[size_t(config_bit)] = true;
+  }
+
+  size_t num_updated_bits = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+    if (false == config_bit_changed[size_t(config_bit)]) {
+      continue;
+    }
+    fabric_bitstream.set_bit_din(fabric_bit, bitstream_manager.bit_value(config_bit));
+    num_updated_bits++;
+  }
+
+  VTR_LOGV(verbose,
+           "Updated data inputs of %lu fabric bits\n",
+           num_updated_bits);
+}
+
 } /* end namespace openfpga */
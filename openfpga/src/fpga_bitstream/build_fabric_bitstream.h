@@ -20,8 +20,14 @@ namespace openfpga {
 FabricBitstream build_fabric_dependent_bitstream(const BitstreamManager& bitstream_manager,
                                                  const ModuleManager& module_manager,
                                                  const ConfigProtocol& config_protocol,
+                                                 const size_t& num_threads,
                                                  const bool& verbose);
 
+void update_fabric_dependent_bitstream(FabricBitstream& fabric_bitstream,
+                                       const BitstreamManager& bitstream_manager,
+                                       const std::vector<ConfigBitId>& changed_config_bits,
+                                       const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
@@ -3,12 +3,14 @@
  * for grids (CLBs, heterogenerous blocks, I/Os, etc.)
  *******************************************************************/
 #include <cmath>
+#include <algorithm>
 #include <string>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -27,6 +29,7 @@
 #include "module_manager_utils.h"
 
 #include "build_mux_bitstream.h"
+#include "bitstream_manager_utils.h"
 #include "openfpga_device_grid_utils.h"
 
 #include "build_grid_bitstream.h"
@@ -225,31 +228,25 @@ void build_physical_block_pin_interc_bitstream(BitstreamManager& bitstream_manag
     bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
 
     /* Add input nets */
-    std::string input_net_ids;
-    
-    bool need_splitter = false;
+    std::vector<std::string> input_net_names;
+    input_net_names.reserve(input_nets.size());
     for (const AtomNetId& input_net : input_nets) {
-      /* Add a space as a splitter*/
-      if (true == need_splitter) {
-        input_net_ids += std::string(" ");
-      }
       if (true == atom_ctx.nlist.valid_net_id(input_net)) {
-        input_net_ids += atom_ctx.nlist.net_name(input_net);
+        input_net_names.push_back(atom_ctx.nlist.net_name(input_net));
       } else {
-        input_net_ids += std::string("unmapped");
+        input_net_names.push_back(std::string("unmapped"));
       }
-      need_splitter = true;
     }
-    bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+    bitstream_manager.add_input_nets_to_block(mux_mem_block, input_net_names);
 
     /* Add output nets */
-    std::string output_net_ids;
+    std::vector<std::string> output_net_names;
     if (true == atom_ctx.nlist.valid_net_id(output_net)) {
-      output_net_ids += atom_ctx.nlist.net_name(output_net);
+      output_net_names.push_back(atom_ctx.nlist.net_name(output_net));
     } else {
-      output_net_ids += std::string("unmapped");
+      output_net_names.push_back(std::string("unmapped"));
     }
-    bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
+    bitstream_manager.add_output_nets_to_block(mux_mem_block, output_net_names);
 
     break;
   }
@@ -456,20 +453,18 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
                                              circuit_lib.port_default_value(lut_regular_sram_ports[0]));
     /* If the physical pb contains fixed bitstream, overload here */
     if (false == physical_pb.fixed_bitstream(lut_pb_id).empty()) {
-      std::string fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
+      const std::vector<bool>& fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
       size_t start_index = physical_pb.fixed_bitstream_offset(lut_pb_id);
       /* Ensure the length matches!!! */
-      if (lut_bitstream.size() - start_index < fixed_bitstream.size()) {
-        VTR_LOG_ERROR("Unmatched length of fixed bitstream %s!Expected to be less than %ld bits\n",
-                      fixed_bitstream.c_str(),
+      if ( (start_index > lut_bitstream.size())
+        || (lut_bitstream.size() - start_index < fixed_bitstream.size()) ) {
+        VTR_LOG_ERROR("Unmatched length of fixed bitstream (%lu bits)!Expected to be less than %ld bits\n",
+                      fixed_bitstream.size(),
                       lut_bitstream.size() - start_index); 
         exit(1);
       }
       /* Overload the bitstream here */
-      for (size_t bit_index = 0; bit_index < lut_bitstream.size(); ++bit_index) {
-        VTR_ASSERT('0' == fixed_bitstream[bit_index] || '1' == fixed_bitstream[bit_index]);
-        lut_bitstream[bit_index + start_index] = ('1' == fixed_bitstream[bit_index]);
-      }
+      std::copy(fixed_bitstream.begin(), fixed_bitstream.end(), lut_bitstream.begin() + start_index);
     }
   }
   
@@ -481,21 +476,19 @@ void build_lut_bitstream(BitstreamManager& bitstream_manager,
 
       /* If the physical pb contains fixed mode-select bitstream, overload here */
       if (false == physical_pb.fixed_mode_select_bitstream(lut_pb_id).empty()) {
-        std::string fixed_mode_select_bitstream = physical_pb.fixed_mode_select_bitstream(lut_pb_id);
+        const std::vector<bool>& fixed_mode_select_bitstream = physical_pb.fixed_mode_select_bitstream(lut_pb_id);
         size_t mode_bits_start_index = physical_pb.fixed_mode_select_bitstream_offset(lut_pb_id);
         /* Ensure the length matches!!! */
-        if (mode_select_bitstream.size() - mode_bits_start_index < fixed_mode_select_bitstream.size()) {
-          VTR_LOG_ERROR("Unmatched length of fixed mode_select_bitstream %s!Expected to be less than %ld bits\n",
-                        fixed_mode_select_bitstream.c_str(),
+        if ( (mode_bits_start_index > mode_select_bitstream.size())
+          || (mode_select_bitstream.size() - mode_bits_start_index < fixed_mode_select_bitstream.size()) ) {
+          VTR_LOG_ERROR("Unmatched length of fixed mode_select_bitstream (%lu bits)!Expected to be less than %ld bits\n",
+                        fixed_mode_select_bitstream.size(),
                         mode_select_bitstream.size() - mode_bits_start_index); 
           exit(1);
         }
         /* Overload the bitstream here */
-        for (size_t bit_index = 0; bit_index < fixed_mode_select_bitstream.size(); ++bit_index) {
-          VTR_ASSERT('0' == fixed_mode_select_bitstream[bit_index] || '1' == fixed_mode_select_bitstream[bit_index]);
-          mode_select_bitstream[bit_index + mode_bits_start_index] = ('1' == fixed_mode_select_bitstream[bit_index]);
-        }
-
+        std::copy(fixed_mode_select_bitstream.begin(), fixed_mode_select_bitstream.end(),
+                  mode_select_bitstream.begin() + mode_bits_start_index);
       }
     } else { /* get default mode_bits */
       mode_select_bitstream = generate_mode_select_bitstream(device_annotation.pb_type_mode_bits(lut_pb_type));
@@ -657,14 +650,17 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
                                     const VprBitstreamAnnotation& bitstream_annotation,
                                     const DeviceGrid& grids,
                                     const vtr::Point<size_t>& grid_coord,
-                                    const e_side& border_side) {
+                                    const e_side& border_side,
+                                    const bool& io_type) {
   /* Create a block for the grid in bitstream manager */
   t_physical_tile_type_ptr grid_type = grids[grid_coord.x()][grid_coord.y()].type;
+  VTR_TRACE_SPAN("bitstream " + std::string(grid_type->name)
+                 + "[" + std::to_string(grid_coord.x()) + "][" + std::to_string(grid_coord.y()) + "]");
   std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
 
   /* Early exit if this parent module has no configurable child modules */
   std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), 
-                                                                 is_io_type(grid_type), border_side);
+                                                                 io_type, border_side);
   ModuleId grid_module = module_manager.find_module(grid_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
  
@@ -674,7 +670,7 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
   }
 
   std::string grid_block_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), 
-                                                                  is_io_type(grid_type), border_side, grid_coord);
+                                                                  io_type, border_side, grid_coord);
   ConfigBlockId grid_configurable_block = bitstream_manager.add_block(grid_block_name);
   bitstream_manager.add_child_block(top_block, grid_configurable_block);
 
@@ -682,6 +678,19 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
   bitstream_manager.reserve_child_blocks(grid_configurable_block,
                                          count_module_manager_module_configurable_children(module_manager, grid_module)); 
 
+  /* When the pins of grids are duplicated, the grid module is a wrapper of the core module
+   * of the physical tile, which includes the physical blocks
+   */
+  std::string core_module_name = generate_grid_core_module_name(grid_module_name_prefix, std::string(grid_type->name));
+  ModuleId core_module = module_manager.find_module(core_module_name);
+  if (true == module_manager.valid_module_id(core_module)) {
+    ConfigBlockId core_configurable_block = bitstream_manager.add_block(generate_grid_core_instance_name(grid_module_name_prefix, std::string(grid_type->name)));
+    bitstream_manager.add_child_block(grid_configurable_block, core_configurable_block);
+    bitstream_manager.reserve_child_blocks(core_configurable_block,
+                                           count_module_manager_module_configurable_children(module_manager, core_module)); 
+    grid_configurable_block = core_configurable_block;
+  }
+
   /* Iterate over the capacity of the grid
    * Now each physical tile may have a number of logical blocks
    * OpenFPGA only considers the physical implementation of the tiles.
@@ -733,6 +742,9 @@ void build_physical_block_bitstream(BitstreamManager& bitstream_manager,
  * Generate bitstreams for all the grids, including 
  * 1. core grids that sit in the center of the fabric
  * 2. side grids (I/O grids) that sit in the borders for the fabric
+ *
+ * Each grid is an independent job, which can be built by multiple threads.
+ * The order of grids in the bitstream is the same regardless of the number of threads
  *******************************************************************/
 void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const ConfigBlockId& top_block,
@@ -745,32 +757,36 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
                           const VprBitstreamAnnotation& bitstream_annotation,
+                          const size_t& num_threads,
                           const bool& verbose) {
 
   VTR_LOGV(verbose, "Generating bitstream for core grids...");
 
-  /* Generate bitstream for the core logic block one by one */
+  t_device_grid_summary grid_summary = build_device_grid_summary(grids);
+
+  /* Collect the core logic blocks one by one */
+  std::vector<vtr::Point<size_t>> core_coordinates;
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
-      /* Bypass EMPTY grid */
-      if (true == is_empty_type(grids[ix][iy].type)) {
-        continue;
-      } 
-      /* Skip width > 1 or height > 1 tiles (mostly heterogeneous blocks) */
-      if ( (0 < grids[ix][iy].width_offset)
-        || (0 < grids[ix][iy].height_offset) ) {
+      /* Bypass EMPTY grid, and skip width > 1 or height > 1 tiles (mostly heterogeneous blocks) */
+      if (false == grid_summary.roots[ix][iy]) {
         continue;
       }
-      /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation,
-                                     place_annotation, bitstream_annotation,
-                                     grids, grid_coord, NUM_SIDES);
+      core_coordinates.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
+
+  /* Add a grid module to top_module*/
+  build_bitstream_manager_child_blocks(bitstream_manager, top_block, core_coordinates.size(), num_threads,
+                                       [&](BitstreamManager& job_bitstream_manager, const ConfigBlockId& job_top_block, const size_t& ijob) {
+                                         build_physical_block_bitstream(job_bitstream_manager, job_top_block, module_manager,
+                                                                        circuit_lib, mux_lib,
+                                                                        atom_ctx,
+                                                                        device_annotation, cluster_annotation,
+                                                                        place_annotation, bitstream_annotation,
+                                                                        grids, core_coordinates[ijob], NUM_SIDES,
+                                                                        grid_summary.io_types[core_coordinates[ijob].x()][core_coordinates[ijob].y()]);
+                                       });
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
@@ -778,27 +794,113 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
   /* Create the coordinate range for each side of FPGA fabric */
   std::map<e_side, std::vector<vtr::Point<size_t>>> io_coordinates = generate_perimeter_grid_coordinates( grids);
 
-  /* Add instances of I/O grids to top_module */
+  /* Collect the I/O grids from each side */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> io_grids;
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
-      /* Bypass EMPTY grid */
-      if (true == is_empty_type(grids[io_coordinate.x()][io_coordinate.y()].type)) {
-        continue;
-      } 
-      /* Skip height > 1 tiles (mostly heterogeneous blocks) */
-      if ( (0 < grids[io_coordinate.x()][io_coordinate.y()].width_offset)
-        || (0 < grids[io_coordinate.x()][io_coordinate.y()].height_offset) ) {
+      /* Bypass EMPTY grid, and skip height > 1 tiles (mostly heterogeneous blocks) */
+      if (false == grid_summary.roots[io_coordinate.x()][io_coordinate.y()]) {
         continue;
       }
-      build_physical_block_bitstream(bitstream_manager, top_block, module_manager,
-                                     circuit_lib, mux_lib,
-                                     atom_ctx,
-                                     device_annotation, cluster_annotation, 
-                                     place_annotation, bitstream_annotation,
-                                     grids, io_coordinate, io_side);
+      io_grids.push_back(std::make_pair(io_coordinate, io_side));
     }
   }
+
+  /* Add instances of I/O grids to top_module */
+  build_bitstream_manager_child_blocks(bitstream_manager, top_block, io_grids.size(), num_threads,
+                                       [&](BitstreamManager& job_bitstream_manager, const ConfigBlockId& job_top_block, const size_t& ijob) {
+                                         build_physical_block_bitstream(job_bitstream_manager, job_top_block, module_manager,
+                                                                        circuit_lib, mux_lib,
+                                                                        atom_ctx,
+                                                                        device_annotation, cluster_annotation, 
+                                                                        place_annotation, bitstream_annotation,
+                                                                        grids, io_grids[ijob].first, io_grids[ijob].second,
+                                                                        grid_summary.io_types[io_grids[ijob].first.x()][io_grids[ijob].first.y()]);
+                                       });
   VTR_LOGV(verbose, "Done\n");
 }
 
+/********************************************************************
+ * Regenerate the bitstreams of a number of grids in place, 
+ * e.g., after an ECO which changes the clustering or placement results
+ * of the grids.
+ * The blocks of the grids must already exist in the bitstream manager,
+ * i.e., build_grid_bitstream() has been called.
+ * The ids of the configuration bits whose values are changed 
+ * are appended to changed_bits
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if a grid is out of the device or its blocks can not be found,
+ *    in which case the grids before it have been updated
+ *******************************************************************/
+int update_grid_bitstream(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_block,
+                          const ModuleManager& module_manager,
+                          const CircuitLibrary& circuit_lib,
+                          const MuxLibrary& mux_lib,
+                          const DeviceGrid& grids,
+                          const AtomContext& atom_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& cluster_annotation,
+                          const VprPlacementAnnotation& place_annotation,
+                          const VprBitstreamAnnotation& bitstream_annotation,
+                          const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                          std::vector<ConfigBitId>& changed_bits,
+                          const bool& verbose) {
+  for (const vtr::Point<size_t>& grid_coord : grid_coordinates) {
+    if ( (grid_coord.x() >= grids.width())
+      || (grid_coord.y() >= grids.height()) ) {
+      VTR_LOG_ERROR("Grid[%lu][%lu] is out of the device grid whose size is %lux%lu!\n",
+                    grid_coord.x(), grid_coord.y(), grids.width(), grids.height());
+      return 1;
+    }
+
+    /* Bypass EMPTY grid */
+    if (true == is_empty_type(grids[grid_coord.x()][grid_coord.y()].type)) {
+      continue;
+    } 
+    /* Skip width > 1 or height > 1 tiles (mostly heterogeneous blocks) */
+    if ( (0 < grids[grid_coord.x()][grid_coord.y()].width_offset)
+      || (0 < grids[grid_coord.x()][grid_coord.y()].height_offset) ) {
+      continue;
+    }
+
+    /* Find the border side of I/O grids, which is the same as build_grid_bitstream() */
+    e_side border_side = NUM_SIDES;
+    if (0 == grid_coord.x()) {
+      border_side = LEFT;
+    } else if (grids.width() - 1 == grid_coord.x()) {
+      border_side = RIGHT;
+    } else if (0 == grid_coord.y()) {
+      border_side = BOTTOM;
+    } else if (grids.height() - 1 == grid_coord.y()) {
+      border_side = TOP;
+    }
+
+    /* Build the grid in a private bitstream manager and copy its bits */
+    BitstreamManager grid_bitstream_manager;
+    ConfigBlockId grid_top_block = grid_bitstream_manager.create_block();
+    build_physical_block_bitstream(grid_bitstream_manager, grid_top_block, module_manager,
+                                   circuit_lib, mux_lib,
+                                   atom_ctx,
+                                   device_annotation, cluster_annotation,
+                                   place_annotation, bitstream_annotation,
+                                   grids, grid_coord, border_side,
+                                   is_io_type(grids[grid_coord.x()][grid_coord.y()].type));
+
+    size_t num_changed_bits = changed_bits.size();
+    if (0 != update_bitstream_manager_child_blocks(bitstream_manager, top_block, grid_bitstream_manager, changed_bits)) {
+      VTR_LOG_ERROR("Unable to update bitstream of grid[%lu][%lu]!\n",
+                    grid_coord.x(), grid_coord.y());
+      return 1;
+    }
+    VTR_LOGV(verbose,
+             "Updated bitstream of grid[%lu][%lu]: %lu bits changed\n",
+             grid_coord.x(), grid_coord.y(), changed_bits.size() - num_changed_bits);
+  }
+
+  return 0;
+}
+
 } /* end namespace openfpga */
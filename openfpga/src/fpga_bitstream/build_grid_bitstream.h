@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <vector>
+#include "vtr_geometry.h"
 #include "vpr_context.h"
 #include "device_grid.h"
 #include "bitstream_manager.h"
@@ -34,6 +35,22 @@ void build_grid_bitstream(BitstreamManager& bitstream_manager,
                           const VprClusteringAnnotation& cluster_annotation,
                           const VprPlacementAnnotation& place_annotation,
                           const VprBitstreamAnnotation& bitstream_annotation,
+                          const size_t& num_threads,
+                          const bool& verbose);
+
+int update_grid_bitstream(BitstreamManager& bitstream_manager,
+                          const ConfigBlockId& top_block,
+                          const ModuleManager& module_manager,
+                          const CircuitLibrary& circuit_lib,
+                          const MuxLibrary& mux_lib,
+                          const DeviceGrid& grids,
+                          const AtomContext& atom_ctx,
+                          const VprDeviceAnnotation& device_annotation,
+                          const VprClusteringAnnotation& cluster_annotation,
+                          const VprPlacementAnnotation& place_annotation,
+                          const VprBitstreamAnnotation& bitstream_annotation,
+                          const std::vector<vtr::Point<size_t>>& grid_coordinates,
+                          std::vector<ConfigBitId>& changed_bits,
                           const bool& verbose);
 
 } /* end namespace openfpga */
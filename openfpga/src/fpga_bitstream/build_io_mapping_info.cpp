@@ -53,6 +53,12 @@ IoMap build_fpga_io_mapping_info(const ModuleManager& module_manager,
     }
   }
 
+  /* The I/O location map is indexed by the port names */
+  std::vector<std::string> module_io_port_names;
+  for (const ModulePortId& module_io_port_id : module_io_ports) {
+    module_io_port_names.push_back(module_manager.module_port(top_module, module_io_port_id).get_name());
+  }
+
   /* Type mapping between VPR block and Module port */
   std::map<AtomBlockType, ModuleManager::e_module_port_type> atom_block_type_to_module_port_type;
   atom_block_type_to_module_port_type[AtomBlockType::INPAD] = ModuleManager::MODULE_GPIN_PORT;
@@ -75,14 +81,13 @@ IoMap build_fpga_io_mapping_info(const ModuleManager& module_manager,
      *         or should find a GPOUT for OUTPAD
      */ 
     std::pair<ModulePortId, size_t> mapped_module_io_info = std::make_pair(ModulePortId::INVALID(), -1);
-    for (const ModulePortId& module_io_port_id : module_io_ports) {
-      const BasicPort& module_io_port = module_manager.module_port(top_module, module_io_port_id);
+    const t_pl_loc& block_loc = place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc;
+    for (size_t iport = 0; iport < module_io_ports.size(); ++iport) {
+      const ModulePortId& module_io_port_id = module_io_ports[iport];
 
       /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t temp_io_index = io_location_map.io_index(place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-                                                      place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-                                                      place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.z,
-                                                      module_io_port.get_name());
+      size_t temp_io_index = io_location_map.io_index(block_loc.x, block_loc.y, block_loc.z,
+                                                      module_io_port_names[iport]);
 
       /* Bypass invalid index (not mapped to this GPIO port) */
       if (size_t(-1) == temp_io_index) {
@@ -22,6 +22,7 @@
 
 #include "mux_bitstream_constants.h"
 #include "build_mux_bitstream.h"
+#include "bitstream_manager_utils.h"
 #include "build_routing_bitstream.h"
 
 /* begin namespace openfpga */
@@ -104,32 +105,27 @@ void build_switch_block_mux_bitstream(BitstreamManager& bitstream_manager,
   bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
 
   /* Add input nets */
-  bool need_splitter = false;
-  std::string input_net_ids;
+  std::vector<std::string> input_net_names;
+  input_net_names.reserve(input_nets.size());
   for (const ClusterNetId& input_net : input_nets) {
-    /* Add a space as a splitter*/
-    if (true == need_splitter) {
-      input_net_ids += std::string(" ");
-    }
     AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
     if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
+      input_net_names.push_back(atom_ctx.nlist.net_name(input_atom_net));
     } else {
-      input_net_ids += std::string("unmapped");
+      input_net_names.push_back(std::string("unmapped"));
     }
-    need_splitter = true;
   }
-  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+  bitstream_manager.add_input_nets_to_block(mux_mem_block, input_net_names);
 
   /* Add output nets */
-  std::string output_net_ids;
+  std::vector<std::string> output_net_names;
   AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
   if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
+    output_net_names.push_back(atom_ctx.nlist.net_name(output_atom_net));
   } else {
-    output_net_ids += std::string("unmapped");
+    output_net_names.push_back(std::string("unmapped"));
   }
-  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
+  bitstream_manager.add_output_nets_to_block(mux_mem_block, output_net_names);
 }
 
 /********************************************************************
@@ -305,32 +301,27 @@ void build_connection_block_mux_bitstream(BitstreamManager& bitstream_manager,
   bitstream_manager.add_path_id_to_block(mux_mem_block, path_id);
 
   /* Add input nets */
-  bool need_splitter = false;
-  std::string input_net_ids;
+  std::vector<std::string> input_net_names;
+  input_net_names.reserve(input_nets.size());
   for (const ClusterNetId& input_net : input_nets) {
-    /* Add a space as a splitter*/
-    if (true == need_splitter) {
-      input_net_ids += std::string(" ");
-    }
     AtomNetId input_atom_net = atom_ctx.lookup.atom_net(input_net);
     if (true == atom_ctx.nlist.valid_net_id(input_atom_net)) {
-      input_net_ids += atom_ctx.nlist.net_name(input_atom_net);
+      input_net_names.push_back(atom_ctx.nlist.net_name(input_atom_net));
     } else {
-      input_net_ids += std::string("unmapped");
+      input_net_names.push_back(std::string("unmapped"));
     }
-    need_splitter = true;
   }
-  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+  bitstream_manager.add_input_nets_to_block(mux_mem_block, input_net_names);
 
   /* Add output nets */
-  std::string output_net_ids;
+  std::vector<std::string> output_net_names;
   AtomNetId output_atom_net = atom_ctx.lookup.atom_net(output_net);
   if (true == atom_ctx.nlist.valid_net_id(output_atom_net)) {
-    output_net_ids += atom_ctx.nlist.net_name(output_atom_net);
+    output_net_names.push_back(atom_ctx.nlist.net_name(output_atom_net));
   } else {
-    output_net_ids += std::string("unmapped");
+    output_net_names.push_back(std::string("unmapped"));
   }
-  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
+  bitstream_manager.add_output_nets_to_block(mux_mem_block, output_net_names);
 
 }
 
@@ -400,7 +391,7 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
                                       const t_rr_type& cb_type) {
    
   /* Find routing multiplexers on the sides of a Connection block where IPIN nodes locate */
-  std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
+  const std::vector<enum e_side>& cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
 
   for (size_t side = 0; side < cb_sides.size(); ++side) {
     enum e_side cb_ipin_side = cb_sides[side];
@@ -416,74 +407,133 @@ void build_connection_block_bitstream(BitstreamManager& bitstream_manager,
 }
 
 /********************************************************************
- * Create bitstream for a X-direction or Y-direction Connection Blocks
+ * Create bitstream for a X-direction or Y-direction Connection Block
+ * at a given GSB coordinate
  *******************************************************************/
 static 
-void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
-                                       const ConfigBlockId& top_configurable_block,
-                                       const ModuleManager& module_manager,
-                                       const CircuitLibrary& circuit_lib,
-                                       const MuxLibrary& mux_lib,
-                                       const AtomContext& atom_ctx,
-                                       const VprDeviceAnnotation& device_annotation,
-                                       const VprRoutingAnnotation& routing_annotation,
-                                       const RRGraph& rr_graph,
-                                       const DeviceRRGSB& device_rr_gsb,
-                                       const bool& compact_routing_hierarchy,
-                                       const t_rr_type& cb_type) {
-
-  vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
-
-  for (size_t ix = 0; ix < cb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < cb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the connection block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_cb_exist(cb_type)) {
-        continue;
-      }
-      /* Skip if the cb does not contain any configuration bits! */
-      if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
-        continue;
-      }
+void build_gsb_connection_block_bitstream(BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& top_configurable_block,
+                                          const ModuleManager& module_manager,
+                                          const CircuitLibrary& circuit_lib,
+                                          const MuxLibrary& mux_lib,
+                                          const AtomContext& atom_ctx,
+                                          const VprDeviceAnnotation& device_annotation,
+                                          const VprRoutingAnnotation& routing_annotation,
+                                          const RRGraph& rr_graph,
+                                          const DeviceRRGSB& device_rr_gsb,
+                                          const bool& compact_routing_hierarchy,
+                                          const t_rr_type& cb_type,
+                                          const vtr::Point<size_t>& gsb_coord) {
+  size_t ix = gsb_coord.x();
+  size_t iy = gsb_coord.y();
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+  /* Check if the connection block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (height > 1) 
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_cb_exist(cb_type)) {
+    return;
+  }
+  /* Skip if the cb does not contain any configuration bits! */
+  if (true == connection_block_contain_only_routing_tracks(rr_gsb, cb_type)) {
+    return;
+  }
 
-      /* Find the cb module so that we can precisely reserve child blocks */
-      vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_cb_coord(ix, iy);
-        /* Note: use GSB coordinate when inquire for unique modules!!! */
-        const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
-        unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
-        unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
-        cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
-      } 
-      ModuleId cb_module = module_manager.find_module(cb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager, cb_module)) {
-        continue;
-      } 
+  /* Find the cb module so that we can precisely reserve child blocks */
+  vtr::Point<size_t> cb_coord(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+  std::string cb_module_name = generate_connection_block_module_name(cb_type, cb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_cb_coord(ix, iy);
+    /* Note: use GSB coordinate when inquire for unique modules!!! */
+    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, unique_cb_coord);
+    unique_cb_coord.set_x(unique_mirror.get_cb_x(cb_type)); 
+    unique_cb_coord.set_y(unique_mirror.get_cb_y(cb_type)); 
+    cb_module_name = generate_connection_block_module_name(cb_type, unique_cb_coord);
+  } 
+  ModuleId cb_module = module_manager.find_module(cb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager, cb_module)) {
+    return;
+  } 
 
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId cb_configurable_block = bitstream_manager.add_block(generate_connection_block_module_name(cb_type, cb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block, cb_configurable_block);
 
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(cb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, cb_module)); 
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(cb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, cb_module)); 
   
-      build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
-                                       circuit_lib, mux_lib,
-                                       atom_ctx, device_annotation, routing_annotation,
-                                       rr_graph,
-                                       rr_gsb, cb_type);
-    }
+  build_connection_block_bitstream(bitstream_manager, cb_configurable_block, module_manager,  
+                                   circuit_lib, mux_lib,
+                                   atom_ctx, device_annotation, routing_annotation,
+                                   rr_graph,
+                                   rr_gsb, cb_type);
+}
+
+/********************************************************************
+ * Create bitstream for a switch block at a given GSB coordinate
+ *******************************************************************/
+static 
+void build_gsb_switch_block_bitstream(BitstreamManager& bitstream_manager,
+                                      const ConfigBlockId& top_configurable_block,
+                                      const ModuleManager& module_manager,
+                                      const CircuitLibrary& circuit_lib,
+                                      const MuxLibrary& mux_lib,
+                                      const AtomContext& atom_ctx,
+                                      const VprDeviceAnnotation& device_annotation,
+                                      const VprRoutingAnnotation& routing_annotation,
+                                      const RRGraph& rr_graph,
+                                      const DeviceRRGSB& device_rr_gsb,
+                                      const bool& compact_routing_hierarchy,
+                                      const vtr::Point<size_t>& gsb_coord) {
+  size_t ix = gsb_coord.x();
+  size_t iy = gsb_coord.y();
+  const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
+  /* Check if the switch block exists in the device!
+   * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
+   * We will skip those modules
+   */
+  if (false == rr_gsb.is_sb_exist()) {
+    return;
   }
+
+  vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+
+  /* Find the sb module so that we can precisely reserve child blocks */
+  std::string sb_module_name = generate_switch_block_module_name(sb_coord);
+  if (true == compact_routing_hierarchy) {
+    vtr::Point<size_t> unique_sb_coord(ix, iy);
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
+    unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
+    unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
+    sb_module_name = generate_switch_block_module_name(unique_sb_coord);
+  } 
+  ModuleId sb_module = module_manager.find_module(sb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  /* Bypass empty blocks which have none configurable children */
+  if (0 == count_module_manager_module_configurable_children(module_manager, sb_module)) {
+    return;
+  } 
+
+  /* Create a block for the bitstream which corresponds to the Switch block */
+  ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
+  /* Set switch block as a child of top block */
+  bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
+
+  /* Reserve child blocks for new created block */
+  bitstream_manager.reserve_child_blocks(sb_configurable_block,
+                                         count_module_manager_module_configurable_children(module_manager, sb_module)); 
+
+  build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
+                               circuit_lib, mux_lib,
+                               atom_ctx, device_annotation, routing_annotation,
+                               rr_graph,
+                               rr_gsb);
 }
 
 /********************************************************************
@@ -491,6 +541,9 @@ void build_connection_block_bitstreams(BitstreamManager& bitstream_manager,
  * Two major tasks: 
  * 1. Generate bitstreams for Switch Blocks
  * 2. Generate bitstreams for both X-direction and Y-direction Connection Blocks
+ *
+ * Each GSB is an independent job, which can be built by multiple threads.
+ * The order of blocks in the bitstream is the same regardless of the number of threads
  *******************************************************************/
 void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const ConfigBlockId& top_configurable_block,
@@ -502,88 +555,130 @@ void build_routing_bitstream(BitstreamManager& bitstream_manager,
                              const VprRoutingAnnotation& routing_annotation,
                              const RRGraph& rr_graph,
                              const DeviceRRGSB& device_rr_gsb,
-                             const bool& compact_routing_hierarchy) {
+                             const bool& compact_routing_hierarchy,
+                             const size_t& num_threads) {
+
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+  size_t num_gsbs = gsb_range.x() * gsb_range.y();
+  /* Jobs are indexed in the same way as a loop over x and then y */
+  auto gsb_coordinate = [&](const size_t& ijob) {
+    return vtr::Point<size_t>(ijob / gsb_range.y(), ijob % gsb_range.y());
+  };
 
   /* Generate bitstream for each switch blocks
    * To organize the bitstream in blocks, we create a block for each switch block 
    * and give names which are same as they are in top-level module managers
    */
   VTR_LOG("Generating bitstream for Switch blocks...");
-  vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  for (size_t ix = 0; ix < sb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < sb_range.y(); ++iy) {
-      const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
-      /* Check if the switch block exists in the device!
-       * Some of them do NOT exist due to heterogeneous blocks (width > 1) 
-       * We will skip those modules
-       */
-      if (false == rr_gsb.is_sb_exist()) {
-        continue;
-      }
-
-      vtr::Point<size_t> sb_coord(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-
-      /* Find the sb module so that we can precisely reserve child blocks */
-      std::string sb_module_name = generate_switch_block_module_name(sb_coord);
-      if (true == compact_routing_hierarchy) {
-        vtr::Point<size_t> unique_sb_coord(ix, iy);
-        const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(sb_coord);
-        unique_sb_coord.set_x(unique_mirror.get_sb_x()); 
-        unique_sb_coord.set_y(unique_mirror.get_sb_y()); 
-        sb_module_name = generate_switch_block_module_name(unique_sb_coord);
-      } 
-      ModuleId sb_module = module_manager.find_module(sb_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-      /* Bypass empty blocks which have none configurable children */
-      if (0 == count_module_manager_module_configurable_children(module_manager, sb_module)) {
-        continue;
-      } 
-
-      /* Create a block for the bitstream which corresponds to the Switch block */
-      ConfigBlockId sb_configurable_block = bitstream_manager.add_block(generate_switch_block_module_name(sb_coord));
-      /* Set switch block as a child of top block */
-      bitstream_manager.add_child_block(top_configurable_block, sb_configurable_block);
-
-      /* Reserve child blocks for new created block */
-      bitstream_manager.reserve_child_blocks(sb_configurable_block,
-                                             count_module_manager_module_configurable_children(module_manager, sb_module)); 
-
-      build_switch_block_bitstream(bitstream_manager, sb_configurable_block, module_manager,  
-                                   circuit_lib, mux_lib,
-                                   atom_ctx, device_annotation, routing_annotation,
-                                   rr_graph,
-                                   rr_gsb);
-    }
-  }
+  build_bitstream_manager_child_blocks(bitstream_manager, top_configurable_block, num_gsbs, num_threads,
+                                       [&](BitstreamManager& job_bitstream_manager, const ConfigBlockId& job_top_block, const size_t& ijob) {
+                                         build_gsb_switch_block_bitstream(job_bitstream_manager, job_top_block, module_manager,
+                                                                          circuit_lib, mux_lib,
+                                                                          atom_ctx, device_annotation, routing_annotation,
+                                                                          rr_graph,
+                                                                          device_rr_gsb,
+                                                                          compact_routing_hierarchy,
+                                                                          gsb_coordinate(ijob));
+                                       });
   VTR_LOG("Done\n");
 
   /* Generate bitstream for each connection blocks
    * To organize the bitstream in blocks, we create a block for each connection block 
    * and give names which are same as they are in top-level module managers
    */
-  VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
-
-  build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
-                                    atom_ctx, device_annotation, routing_annotation,
-                                    rr_graph,
-                                    device_rr_gsb,
-                                    compact_routing_hierarchy,
-                                    CHANX);
-  VTR_LOG("Done\n");
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    if (CHANX == cb_type) {
+      VTR_LOG("Generating bitstream for X-direction Connection blocks ...");
+    } else {
+      VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
+    }
 
-  VTR_LOG("Generating bitstream for Y-direction Connection blocks ...");
+    build_bitstream_manager_child_blocks(bitstream_manager, top_configurable_block, num_gsbs, num_threads,
+                                         [&](BitstreamManager& job_bitstream_manager, const ConfigBlockId& job_top_block, const size_t& ijob) {
+                                           build_gsb_connection_block_bitstream(job_bitstream_manager, job_top_block, module_manager,
+                                                                                circuit_lib, mux_lib,
+                                                                                atom_ctx, device_annotation, routing_annotation,
+                                                                                rr_graph,
+                                                                                device_rr_gsb,
+                                                                                compact_routing_hierarchy,
+                                                                                cb_type,
+                                                                                gsb_coordinate(ijob));
+                                         });
+    VTR_LOG("Done\n");
+  }
+}
 
-  build_connection_block_bitstreams(bitstream_manager, top_configurable_block, module_manager,  
-                                    circuit_lib, mux_lib,
-                                    atom_ctx, device_annotation, routing_annotation,
-                                    rr_graph,
-                                    device_rr_gsb,
-                                    compact_routing_hierarchy,
-                                    CHANY);
-  VTR_LOG("Done\n");
+/********************************************************************
+ * Regenerate the bitstreams of the switch block and connection blocks 
+ * of a number of GSBs in place, e.g., after an ECO which changes 
+ * the routing results.
+ * The blocks must already exist in the bitstream manager,
+ * i.e., build_routing_bitstream() has been called.
+ * The ids of the configuration bits whose values are changed 
+ * are appended to changed_bits
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if a GSB is out of the device or its blocks can not be found,
+ *    in which case the GSBs before it have been updated
+ *******************************************************************/
+int update_routing_bitstream(BitstreamManager& bitstream_manager,
+                             const ConfigBlockId& top_configurable_block,
+                             const ModuleManager& module_manager,
+                             const CircuitLibrary& circuit_lib,
+                             const MuxLibrary& mux_lib,
+                             const AtomContext& atom_ctx,
+                             const VprDeviceAnnotation& device_annotation,
+                             const VprRoutingAnnotation& routing_annotation,
+                             const RRGraph& rr_graph,
+                             const DeviceRRGSB& device_rr_gsb,
+                             const bool& compact_routing_hierarchy,
+                             const std::vector<vtr::Point<size_t>>& gsb_coordinates,
+                             std::vector<ConfigBitId>& changed_bits,
+                             const bool& verbose) {
+  vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
+
+  for (const vtr::Point<size_t>& gsb_coord : gsb_coordinates) {
+    if ( (gsb_coord.x() >= gsb_range.x())
+      || (gsb_coord.y() >= gsb_range.y()) ) {
+      VTR_LOG_ERROR("GSB[%lu][%lu] is out of the GSB array whose size is %lux%lu!\n",
+                    gsb_coord.x(), gsb_coord.y(), gsb_range.x(), gsb_range.y());
+      return 1;
+    }
+
+    /* Build the routing blocks in a private bitstream manager and copy their bits */
+    BitstreamManager gsb_bitstream_manager;
+    ConfigBlockId gsb_top_block = gsb_bitstream_manager.create_block();
+    build_gsb_switch_block_bitstream(gsb_bitstream_manager, gsb_top_block, module_manager,
+                                     circuit_lib, mux_lib,
+                                     atom_ctx, device_annotation, routing_annotation,
+                                     rr_graph,
+                                     device_rr_gsb,
+                                     compact_routing_hierarchy,
+                                     gsb_coord);
+    for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+      build_gsb_connection_block_bitstream(gsb_bitstream_manager, gsb_top_block, module_manager,
+                                           circuit_lib, mux_lib,
+                                           atom_ctx, device_annotation, routing_annotation,
+                                           rr_graph,
+                                           device_rr_gsb,
+                                           compact_routing_hierarchy,
+                                           cb_type,
+                                           gsb_coord);
+    }
+
+    size_t num_changed_bits = changed_bits.size();
+    if (0 != update_bitstream_manager_child_blocks(bitstream_manager, top_configurable_block, gsb_bitstream_manager, changed_bits)) {
+      VTR_LOG_ERROR("Unable to update bitstream of GSB[%lu][%lu]!\n",
+                    gsb_coord.x(), gsb_coord.y());
+      return 1;
+    }
+    VTR_LOGV(verbose,
+             "Updated bitstream of GSB[%lu][%lu]: %lu bits changed\n",
+             gsb_coord.x(), gsb_coord.y(), changed_bits.size() - num_changed_bits);
+  }
 
+  return 0;
 }
 
 } /* end namespace openfpga */
@@ -0,0 +1,137 @@
+/********************************************************************
+ * This file includes functions to encrypt a fabric bitstream file 
+ * with AES in the counter mode
+ *
+ * The key file should contain two hexadecimal strings separated
+ * by spaces or lines:
+ *  - the AES key, with 32, 48 or 64 digits for AES-128, AES-192 and AES-256
+ *  - the initial counter, with 32 digits
+ *******************************************************************/
+#include <fstream>
+#include <iterator>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+/* Headers from fpgaaesencryption library */
+#include "aes_ctr_encryption.h"
+
+#include "encrypt_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Convert a hexadecimal string to bytes, the first two digits being 
+ * the first byte. Return false if the string is not valid
+ *******************************************************************/
+static
+bool convert_hex_string_to_bytes(const std::string& hex,
+                                 std::vector<unsigned char>& bytes) {
+  if (0 != hex.size() % 2) {
+    return false;
+  }
+  bytes.clear();
+  for (size_t idigit = 0; idigit < hex.size(); idigit += 2) {
+    unsigned char byte = 0;
+    for (size_t ioffset = 0; ioffset < 2; ++ioffset) {
+      char digit = hex[idigit + ioffset];
+      byte <<= 4;
+      if (('0' <= digit) && (digit <= '9')) {
+        byte |= digit - '0';
+      } else if (('a' <= digit) && (digit <= 'f')) {
+        byte |= digit - 'a' + 10;
+      } else if (('A' <= digit) && (digit <= 'F')) {
+        byte |= digit - 'A' + 10;
+      } else {
+        return false;
+      }
+    }
+    bytes.push_back(byte);
+  }
+  return true;
+}
+
+/********************************************************************
+ * Encrypt a fabric bitstream file in place
+ * The file, in any format, is encrypted as a sequence of bytes,
+ * which can be decrypted by any AES-CTR implementation 
+ * with the same key and initial counter
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int encrypt_fabric_bitstream_file(const std::string& fname,
+                                  const std::string& key_fname,
+                                  const size_t& num_threads,
+                                  const bool& verbose) {
+  std::string timer_message = std::string("Encrypt fabric bitstream file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Read the key and the initial counter */
+  std::fstream key_fp;
+  key_fp.open(key_fname, std::fstream::in);
+  check_file_stream(key_fname.c_str(), key_fp);
+
+  std::string key_hex;
+  std::string counter_hex;
+  key_fp >> key_hex >> counter_hex;
+  key_fp.close();
+
+  std::vector<unsigned char> key;
+  if ( (false == convert_hex_string_to_bytes(key_hex, key))
+    || ((16 != key.size()) && (24 != key.size()) && (32 != key.size())) ) {
+    VTR_LOG_ERROR("Invalid AES key in file '%s'! Expect 32, 48 or 64 hexadecimal digits.\n",
+                  key_fname.c_str());
+    return 1;
+  }
+
+  std::vector<unsigned char> counter;
+  if ( (false == convert_hex_string_to_bytes(counter_hex, counter))
+    || (AES_CTR_BLOCK_SIZE != counter.size()) ) {
+    VTR_LOG_ERROR("Invalid initial counter in file '%s'! Expect %lu hexadecimal digits.\n",
+                  key_fname.c_str(), 2 * AES_CTR_BLOCK_SIZE);
+    return 1;
+  }
+  std::array<unsigned char, AES_CTR_BLOCK_SIZE> initial_counter;
+  std::copy(counter.begin(), counter.end(), initial_counter.begin());
+
+  /* Load the bitstream file */
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  check_file_stream(fname.c_str(), fp);
+  std::vector<unsigned char> data((std::istreambuf_iterator<char>(fp)), std::istreambuf_iterator<char>());
+  fp.close();
+
+  if (0 != encrypt_aes_ctr(data, key, initial_counter, num_threads, true)) {
+    return 1;
+  }
+
+  /* Overwrite the file with the encrypted data */
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  check_file_stream(fname.c_str(), fp);
+  fp.write(reinterpret_cast<const char*>(data.data()), data.size());
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write encrypted bitstream to file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Encrypted %lu bytes with AES-%lu in counter mode (hardware acceleration: %s)\n",
+           data.size(), 8 * key.size(),
+           aes_hardware_acceleration_available() ? "on" : "off");
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,23 @@
+#ifndef ENCRYPT_FABRIC_BITSTREAM_H
+#define ENCRYPT_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int encrypt_fabric_bitstream_file(const std::string& fname,
+                                  const std::string& key_fname,
+                                  const size_t& num_threads,
+                                  const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -5,11 +5,77 @@
 
 #include "vtr_assert.h"
 #include "openfpga_decode.h"
+#include "openfpga_memory_usage.h"
 #include "fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of address bits packed in a word */
+constexpr size_t ADDRESS_WORD_SIZE = 64;
+
+/**************************************************
+ * Local functions to pack/unpack addresses
+ *************************************************/
+/* Number of words to store the value (or the don't care mask) of an address */
+static 
+size_t find_address_num_words(const size_t& address_length) {
+  return (address_length + ADDRESS_WORD_SIZE - 1) / ADDRESS_WORD_SIZE;
+}
+
+/* Encode an address into a slot, which consists of 
+ * the value words followed by the don't care mask words
+ */
+static 
+void pack_address(const std::vector<char>& address,
+                  const size_t& num_words,
+                  std::vector<uint64_t>::iterator slot) {
+  std::fill(slot, slot + 2 * num_words, 0);
+  for (size_t i = 0; i < address.size(); ++i) {
+    uint64_t mask = uint64_t(1) << (i % ADDRESS_WORD_SIZE);
+    if ('1' == address[i]) {
+      slot[i / ADDRESS_WORD_SIZE] |= mask;
+    } else if (DONT_CARE_CHAR == address[i]) {
+      slot[num_words + i / ADDRESS_WORD_SIZE] |= mask;
+    } else {
+      VTR_ASSERT('0' == address[i]);
+    }
+  }
+}
+
+/* Decode an address from a slot */
+static 
+std::vector<char> unpack_address(const size_t& address_length,
+                                 const size_t& num_words,
+                                 std::vector<uint64_t>::const_iterator slot) {
+  std::vector<char> address(address_length, '0');
+  for (size_t i = 0; i < address_length; ++i) {
+    uint64_t mask = uint64_t(1) << (i % ADDRESS_WORD_SIZE);
+    if (slot[num_words + i / ADDRESS_WORD_SIZE] & mask) {
+      address[i] = DONT_CARE_CHAR;
+    } else if (slot[i / ADDRESS_WORD_SIZE] & mask) {
+      address[i] = '1';
+    }
+  }
+  return address;
+}
+
+/* Reverse the sequence of fixed-width slots in a packed array */
+static 
+void reverse_address_slots(std::vector<uint64_t>& words,
+                           const size_t& slot_size) {
+  if (0 == slot_size) {
+    return;
+  }
+  VTR_ASSERT(0 == words.size() % slot_size);
+  size_t num_slots = words.size() / slot_size;
+  for (size_t i = 0; i < num_slots / 2; ++i) {
+    std::swap_ranges(words.begin() + i * slot_size,
+                     words.begin() + (i + 1) * slot_size,
+                     words.begin() + (num_slots - 1 - i) * slot_size);
+  }
+}
+
 /**************************************************
  * Public Constructor
  *************************************************/
@@ -18,6 +84,8 @@ FabricBitstream::FabricBitstream() {
   invalid_bit_ids_.clear();
   address_length_ = 0;
   wl_address_length_ = 0;
+  address_num_words_ = 0;
+  wl_address_num_words_ = 0;
 
   num_regions_ = 0;
   invalid_region_ids_.clear();
@@ -49,7 +117,7 @@ FabricBitstream::fabric_bit_region_range FabricBitstream::regions() const {
                          fabric_bit_region_iterator(FabricBitRegionId(num_regions_), invalid_region_ids_));
 }
 
-std::vector<FabricBitId> FabricBitstream::region_bits(const FabricBitRegionId& region_id) const {
+const std::vector<FabricBitId>& FabricBitstream::region_bits(const FabricBitRegionId& region_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_region_id(region_id));
 
@@ -59,6 +127,17 @@ std::vector<FabricBitId> FabricBitstream::region_bits(const FabricBitRegionId& r
 /******************************************************************************
  * Public Accessors
  ******************************************************************************/
+size_t FabricBitstream::memory_usage() const {
+  return sizeof(FabricBitstream)
+       + heap_memory_usage(invalid_region_ids_)
+       + heap_memory_usage(region_bit_ids_)
+       + heap_memory_usage(invalid_bit_ids_)
+       + heap_memory_usage(config_bit_ids_)
+       + heap_memory_usage(bit_address_words_)
+       + heap_memory_usage(bit_wl_address_words_)
+       + heap_memory_usage(bit_dins_);
+}
+
 ConfigBitId FabricBitstream::config_bit(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
@@ -71,7 +150,8 @@ std::vector<char> FabricBitstream::bit_address(const FabricBitId& bit_id) const
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
 
-  return bit_addresses_[bit_id];
+  return unpack_address(address_length_, address_num_words_,
+                        bit_address_words_.begin() + 2 * address_num_words_ * size_t(bit_id));
 }
 
 std::vector<char> FabricBitstream::bit_bl_address(const FabricBitId& bit_id) const {
@@ -84,7 +164,41 @@ std::vector<char> FabricBitstream::bit_wl_address(const FabricBitId& bit_id) con
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
 
-  return bit_wl_addresses_[bit_id];
+  return unpack_address(wl_address_length_, wl_address_num_words_,
+                        bit_wl_address_words_.begin() + 2 * wl_address_num_words_ * size_t(bit_id));
+}
+
+size_t FabricBitstream::address_length() const {
+  return address_length_;
+}
+
+size_t FabricBitstream::wl_address_length() const {
+  return wl_address_length_;
+}
+
+size_t FabricBitstream::address_slot_num_words() const {
+  return 2 * address_num_words_;
+}
+
+size_t FabricBitstream::wl_address_slot_num_words() const {
+  return 2 * wl_address_num_words_;
+}
+
+const uint64_t* FabricBitstream::bit_address_words(const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+
+  return bit_address_words_.data() + 2 * address_num_words_ * size_t(bit_id);
+}
+
+const uint64_t* FabricBitstream::bit_wl_address_words(const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_wl_address_);
+
+  return bit_wl_address_words_.data() + 2 * wl_address_num_words_ * size_t(bit_id);
 }
 
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
@@ -110,11 +224,11 @@ void FabricBitstream::reserve_bits(const size_t& num_bits) {
   config_bit_ids_.reserve(num_bits);
  
   if (true == use_address_) {
-    bit_addresses_.reserve(num_bits);
+    bit_address_words_.reserve(2 * address_num_words_ * num_bits);
     bit_dins_.reserve(num_bits);
  
     if (true == use_wl_address_) {
-      bit_wl_addresses_.reserve(num_bits);
+      bit_wl_address_words_.reserve(2 * wl_address_num_words_ * num_bits);
     }
   }
 }
@@ -126,11 +240,11 @@ FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
   config_bit_ids_.push_back(config_bit_id);
 
   if (true == use_address_) {
-    bit_addresses_.emplace_back();
+    bit_address_words_.resize(bit_address_words_.size() + 2 * address_num_words_, 0);
     bit_dins_.emplace_back();
  
     if (true == use_wl_address_) {
-      bit_wl_addresses_.emplace_back();
+      bit_wl_address_words_.resize(bit_wl_address_words_.size() + 2 * wl_address_num_words_, 0);
     }
   }
 
@@ -143,7 +257,8 @@ void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == valid_bit_id(bit_id));
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(address_length_ == address.size());
-  bit_addresses_[bit_id] = address;
+  pack_address(address, address_num_words_,
+               bit_address_words_.begin() + 2 * address_num_words_ * size_t(bit_id));
 }
 
 void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
@@ -157,7 +272,8 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
   VTR_ASSERT(true == use_address_);
   VTR_ASSERT(true == use_wl_address_);
   VTR_ASSERT(wl_address_length_ == address.size());
-  bit_wl_addresses_[bit_id] = address;
+  pack_address(address, wl_address_num_words_,
+               bit_wl_address_words_.begin() + 2 * wl_address_num_words_ * size_t(bit_id));
 }
 
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id,
@@ -176,7 +292,10 @@ void FabricBitstream::set_use_address(const bool& enable) {
 
 void FabricBitstream::set_address_length(const size_t& length) {
   if (true == use_address_) {
+    /* The width of address slots can only be changed before any bits are added */
+    VTR_ASSERT(0 == num_bits_);
     address_length_ = length; 
+    address_num_words_ = find_address_num_words(length);
   }
 }
 
@@ -193,7 +312,10 @@ void FabricBitstream::set_use_wl_address(const bool& enable) {
 
 void FabricBitstream::set_wl_address_length(const size_t& length) {
   if (true == use_address_) {
+    /* The width of address slots can only be changed before any bits are added */
+    VTR_ASSERT(0 == num_bits_);
     wl_address_length_ = length; 
+    wl_address_num_words_ = find_address_num_words(length);
   }
 }
 
@@ -218,15 +340,47 @@ void FabricBitstream::add_bit_to_region(const FabricBitRegionId& region_id,
   region_bit_ids_[region_id].push_back(bit_id); 
 }
 
+void FabricBitstream::add_sub_bitstream(const FabricBitstream& sub_fabric_bitstream) {
+  VTR_ASSERT(use_address_ == sub_fabric_bitstream.use_address_);
+  VTR_ASSERT(use_wl_address_ == sub_fabric_bitstream.use_wl_address_);
+  VTR_ASSERT(address_length_ == sub_fabric_bitstream.address_length_);
+  VTR_ASSERT(wl_address_length_ == sub_fabric_bitstream.wl_address_length_);
+  VTR_ASSERT(true == sub_fabric_bitstream.invalid_bit_ids_.empty());
+
+  size_t bit_offset = num_bits_;
+
+  config_bit_ids_.insert(config_bit_ids_.end(),
+                         sub_fabric_bitstream.config_bit_ids_.begin(),
+                         sub_fabric_bitstream.config_bit_ids_.end());
+  bit_address_words_.insert(bit_address_words_.end(),
+                            sub_fabric_bitstream.bit_address_words_.begin(),
+                            sub_fabric_bitstream.bit_address_words_.end());
+  bit_wl_address_words_.insert(bit_wl_address_words_.end(),
+                               sub_fabric_bitstream.bit_wl_address_words_.begin(),
+                               sub_fabric_bitstream.bit_wl_address_words_.end());
+  bit_dins_.insert(bit_dins_.end(),
+                   sub_fabric_bitstream.bit_dins_.begin(),
+                   sub_fabric_bitstream.bit_dins_.end());
+  num_bits_ += sub_fabric_bitstream.num_bits_;
+
+  for (const FabricBitRegionId& sub_region : sub_fabric_bitstream.regions()) {
+    FabricBitRegionId region = add_region();
+    region_bit_ids_[region].reserve(sub_fabric_bitstream.region_bit_ids_[sub_region].size());
+    for (const FabricBitId& sub_bit : sub_fabric_bitstream.region_bit_ids_[sub_region]) {
+      region_bit_ids_[region].push_back(FabricBitId(size_t(sub_bit) + bit_offset));
+    }
+  }
+}
+
 void FabricBitstream::reverse() {
   std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
 
   if (true == use_address_) {
-    std::reverse(bit_addresses_.begin(), bit_addresses_.end());
+    reverse_address_slots(bit_address_words_, 2 * address_num_words_);
     std::reverse(bit_dins_.begin(), bit_dins_.end());
 
     if (true == use_wl_address_) {
-      std::reverse(bit_wl_addresses_.begin(), bit_wl_addresses_.end());
+      reverse_address_slots(bit_wl_address_words_, 2 * wl_address_num_words_);
     }
   }
 }
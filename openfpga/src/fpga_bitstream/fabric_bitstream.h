@@ -28,10 +28,12 @@
 #ifndef FABRIC_BITSTREAM_H
 #define FABRIC_BITSTREAM_H
 
+#include <cstdint>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
 #include "vtr_vector.h"
+#include "openfpga_id_iterator.h"
 
 #include "bitstream_manager_fwd.h"
 #include "fabric_bitstream_fwd.h"
@@ -40,57 +42,10 @@
 namespace openfpga {
 
 class FabricBitstream {
-  public: /* Type implementations */
-    /*
-     * This class (forward delcared above) is a template used to represent a lazily calculated 
-     * iterator of the specified ID type. The key assumption made is that the ID space is 
-     * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
-     *
-     * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
-     * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
-     */
-    template<class ID>
-    class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
-      public:
-        //Since we pass ID as a template to std::iterator we need to use an explicit 'typename'
-        //to bring the value_type and iterator names into scope
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
-        typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
-
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
-            : value_(init)
-            , invalid_ids_(invalid_ids) {}
-
-        //Advance to the next ID value
-        iterator operator++() {
-            value_ = ID(size_t(value_) + 1);
-            return *this;
-        }
-
-        //Advance to the previous ID value
-        iterator operator--() {
-            value_ = ID(size_t(value_) - 1);
-            return *this;
-        }
-
-        //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
-
-        friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
-        friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
-
-      private:
-        value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
-    };
-
   public: /* Types and ranges */
-    //Lazy iterator utility forward declaration
+    //Lazy iterator utility, which is shared by the data structures with ID spaces
     template<class ID>
-    class lazy_id_iterator;
+    using lazy_id_iterator = LazyIdIterator<ID>;
 
     typedef lazy_id_iterator<FabricBitId> fabric_bit_iterator;
     typedef lazy_id_iterator<FabricBitRegionId> fabric_bit_region_iterator;
@@ -109,17 +64,39 @@ class FabricBitstream {
     /* Find all the configuration regions */
     size_t num_regions() const;
     fabric_bit_region_range regions() const;
-    std::vector<FabricBitId> region_bits(const FabricBitRegionId& region_id) const;
+    const std::vector<FabricBitId>& region_bits(const FabricBitRegionId& region_id) const;
 
   public:  /* Public Accessors */
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
+
     /* Find the configuration bit id in architecture bitstream database */
     ConfigBitId config_bit(const FabricBitId& bit_id) const;
 
-    /* Find the address of bitstream */
+    /* Find the address of bitstream 
+     * The address is decoded from the packed address storage of the bit
+     */
     std::vector<char> bit_address(const FabricBitId& bit_id) const;
     std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
     std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
 
+    /* Find the width of addresses (BL and WL respectively) */
+    size_t address_length() const;
+    size_t wl_address_length() const;
+
+    /* Find the number of 64-bit words in the packed address slot of a bit,
+     * which includes both the value words and the don't care mask words 
+     */
+    size_t address_slot_num_words() const;
+    size_t wl_address_slot_num_words() const;
+
+    /* Find the packed address slot of a bit: a view on the internal storage
+     * with address_slot_num_words() words, i.e., the value words followed by 
+     * the don't care mask words 
+     */
+    const uint64_t* bit_address_words(const FabricBitId& bit_id) const;
+    const uint64_t* bit_wl_address_words(const FabricBitId& bit_id) const;
+
     /* Find the data-in of bitstream */
     char bit_din(const FabricBitId& bit_id) const;
 
@@ -163,6 +140,14 @@ class FabricBitstream {
      */
     void reverse();
 
+    /* Append all the bits and regions of another fabric bitstream
+     * Bit and region ids are shifted by the current number of bits and regions,
+     * so that the result is exactly the same as if the bits and regions
+     * were added to this fabric bitstream directly.
+     * Both fabric bitstreams should use the same types and lengths of addresses
+     */
+    void add_sub_bitstream(const FabricBitstream& sub_fabric_bitstream);
+
     /* Enable the use of address-related data 
      * When this is enabled, data allocation will be applied to these data
      * and users can access/modify the data
@@ -202,18 +187,29 @@ class FabricBitstream {
     size_t address_length_;
     size_t wl_address_length_;
 
+    /* Number of 64-bit words required to store an address (BL and WL respectively) */
+    size_t address_num_words_;
+    size_t wl_address_num_words_;
+
     /* Address bits: this is designed for memory decoders
      * Here we store the binary format of the address, which can be loaded
      * to the configuration protocol directly 
      *
-     * We use a 2-element array, as we may have a BL address and a WL address
+     * We may have a BL address and a WL address
+     *
+     * To be memory efficient, the addresses of all the bits are packed
+     * into one contiguous array of 64-bit words, where each bit owns a fixed-width slot:
+     *
+     *   |<-------- slot of bit 0 ------>|<-------- slot of bit 1 ------>| ...
+     *   +---------------+---------------+---------------+---------------+
+     *   |  value words  |  x-mask words |  value words  |  x-mask words | ...
+     *   +---------------+---------------+---------------+---------------+
      *
-     * TODO: use nested vector may cause large memory footprint 
-     *       when bitstream size increases
-     *       NEED TO THINK ABOUT A COMPACT MODELING
+     * The i-th character of an address is stored in the i-th position of the words.
+     * The x-mask indicates don't care bits, whose value position is always zero
      */
-    vtr::vector<FabricBitId, std::vector<char>> bit_addresses_;
-    vtr::vector<FabricBitId, std::vector<char>> bit_wl_addresses_;
+    std::vector<uint64_t> bit_address_words_;
+    std::vector<uint64_t> bit_wl_address_words_;
 
     /* Data input (Din) bits: this is designed for memory decoders */
     vtr::vector<FabricBitId, char> bit_dins_;
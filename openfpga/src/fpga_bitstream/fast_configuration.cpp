@@ -9,6 +9,7 @@
 #include "vtr_assert.h"
 
 #include "fabric_global_port_info_utils.h"
+#include "fabric_bitstream_utils.h"
 #include "fast_configuration.h"
 
 /* begin namespace openfpga */
@@ -62,34 +63,37 @@ bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type&
 
   size_t num_ones_to_skip = 0;
   size_t num_zeros_to_skip = 0;
+  /* Number of bits to compare with when reporting the bits to skip */
+  size_t num_bits = fabric_bitstream.num_bits();
 
   /* Branch on the type of configuration protocol */
   switch (config_protocol_type) {
   case CONFIG_MEM_STANDALONE:
     break;
   case CONFIG_MEM_SCAN_CHAIN: {
-    /* We can only skip the ones/zeros at the beginning of the bitstream */
-    /* Count how many logic '1' bits we can skip */
-    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-      if (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
-      }
-      VTR_ASSERT(true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
-      num_ones_to_skip++;
-    }
-    /* Count how many logic '0' bits we can skip */
-    for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
-      if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
-      }
-      VTR_ASSERT(false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id)));
-      num_zeros_to_skip++;
-    }
+    /* We can only skip the ones/zeros at the beginning of the bitstream 
+     * Count the bits in the same way as the bitstream writer and the testbench
+     * which skip them: the regional bitstreams are aligned to the longest one
+     * and loaded in parallel, so that the number of bits to skip is limited
+     * by the region with the fewest leading bits of a value
+     */
+    num_ones_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, true);
+    num_zeros_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, false);
+    /* The bits are skipped on each region, compared to the longest regional bitstream */
+    num_bits = find_fabric_regional_bitstream_max_size(fabric_bitstream);
     break;
   }
   case CONFIG_MEM_MEMORY_BANK:
   case CONFIG_MEM_FRAME_BASED: {
-    /* Count how many logic '1' and logic '0' bits we can skip */
+    /* Count how many logic '1' and logic '0' bits we can skip 
+     * When each configuration bit appears once in the fabric bitstream,
+     * it is the same as counting the bits in the bitstream database word by word
+     */
+    if (fabric_bitstream.num_bits() == bitstream_manager.num_bits()) {
+      num_ones_to_skip = bitstream_manager.num_bits_with_value(true);
+      num_zeros_to_skip = bitstream_manager.num_bits() - num_ones_to_skip;
+      break;
+    }
     for (const FabricBitId& bit_id : fabric_bitstream.bits()) {
       if (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
         num_zeros_to_skip++;
@@ -107,12 +111,12 @@ bool find_bit_value_to_skip_for_fast_configuration(const e_config_protocol_type&
   }
 
   VTR_LOG("Using reset will skip %g% (%lu/%lu) of configuration bitstream.\n",
-          100. * (float) num_zeros_to_skip / (float) fabric_bitstream.num_bits(),
-          num_zeros_to_skip, fabric_bitstream.num_bits());
+          100. * (float) num_zeros_to_skip / (float) num_bits,
+          num_zeros_to_skip, num_bits);
 
   VTR_LOG("Using set will skip %g% (%lu/%lu) of configuration bitstream.\n",
-          100. * (float) num_ones_to_skip / (float) fabric_bitstream.num_bits(),
-          num_ones_to_skip, fabric_bitstream.num_bits());
+          100. * (float) num_ones_to_skip / (float) num_bits,
+          num_ones_to_skip, num_bits);
 
   /* By default, we prefer to skip zeros (when the numbers are the same */
   if (num_ones_to_skip > num_zeros_to_skip) {
@@ -0,0 +1,315 @@
+/********************************************************************
+ * This file includes functions that report the statistics of the
+ * configuration bits in a fabric bitstream, i.e., the number of bits
+ * and logic '1' per configuration region, per tile type and per
+ * configuration frame, in JSON format
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+#include "openfpga_naming.h"
+
+#include "bitstream_manager_utils.h"
+#include "fabric_bitstream_utils.h"
+#include "report_fabric_bitstream_stats.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of configuration frames of a configuration chain counted by a job */
+constexpr size_t FABRIC_BITSTREAM_STATS_FRAME_CHUNK_SIZE = 4096;
+
+/********************************************************************
+ * Number of bits and of logic '1' among them
+ *******************************************************************/
+struct t_fabric_bitstream_bit_stats {
+  size_t num_bits = 0;
+  size_t num_ones = 0;
+};
+
+struct t_fabric_bitstream_tile_type_stats {
+  size_t num_tiles = 0;
+  t_fabric_bitstream_bit_stats bit_stats;
+};
+
+/********************************************************************
+ * Count the bits of each configuration region, one region per job
+ *******************************************************************/
+static
+std::vector<t_fabric_bitstream_bit_stats> find_fabric_bitstream_region_stats(const BitstreamManager& bitstream_manager,
+                                                                            const FabricBitstream& fabric_bitstream,
+                                                                            const size_t& num_threads) {
+  std::vector<t_fabric_bitstream_bit_stats> region_stats(fabric_bitstream.num_regions());
+  parallel_for(fabric_bitstream.num_regions(), num_threads,
+               [&](const size_t& iregion) {
+                 const std::vector<FabricBitId>& region_bits = fabric_bitstream.region_bits(FabricBitRegionId(iregion));
+                 region_stats[iregion].num_bits = region_bits.size();
+                 for (const FabricBitId& fabric_bit : region_bits) {
+                   region_stats[iregion].num_ones += bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+                 }
+               });
+  return region_stats;
+}
+
+/********************************************************************
+ * Count the bits of a block and all its child blocks.
+ * The bits of each block are counted word by word in the packed storage
+ *******************************************************************/
+static
+t_fabric_bitstream_bit_stats find_fabric_bitstream_block_subtree_stats(const BitstreamManager& bitstream_manager,
+                                                                       const ConfigBlockId& root_block) {
+  t_fabric_bitstream_bit_stats bit_stats;
+  std::vector<ConfigBlockId> block_stack(1, root_block);
+  while (!block_stack.empty()) {
+    ConfigBlockId block = block_stack.back();
+    block_stack.pop_back();
+    bit_stats.num_bits += bitstream_manager.block_num_bits(block);
+    bit_stats.num_ones += bitstream_manager.block_num_bits_with_value(block, true);
+    for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+      block_stack.push_back(child_block);
+    }
+  }
+  return bit_stats;
+}
+
+/********************************************************************
+ * Count the bits of each tile type, i.e., each module of the
+ * configurable children of the top-level module (grids, switch blocks
+ * and connection blocks).
+ * The subtree of each tile is counted by a job
+ *******************************************************************/
+static
+std::map<std::string, t_fabric_bitstream_tile_type_stats> find_fabric_bitstream_tile_type_stats(const BitstreamManager& bitstream_manager,
+                                                                                              const ModuleManager& module_manager,
+                                                                                              const size_t& num_threads) {
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  VTR_ASSERT(top_module_name == bitstream_manager.block_name(top_blocks[0]));
+
+  /* Find the block of each tile */
+  std::vector<ModuleId> tile_modules;
+  std::vector<ConfigBlockId> tile_blocks;
+  const std::vector<ModuleId>& child_modules = module_manager.configurable_children(top_module);
+  const std::vector<size_t>& child_instances = module_manager.configurable_child_instances(top_module);
+  for (size_t ichild = 0; ichild < child_modules.size(); ++ichild) {
+    ConfigBlockId child_block = bitstream_manager.find_child_block(top_blocks[0],
+                                                                   module_manager.instance_name(top_module, child_modules[ichild], child_instances[ichild]));
+    if (true == bitstream_manager.valid_block_id(child_block)) {
+      tile_modules.push_back(child_modules[ichild]);
+      tile_blocks.push_back(child_block);
+    }
+  }
+
+  std::vector<t_fabric_bitstream_bit_stats> tile_stats(tile_blocks.size());
+  parallel_for(tile_blocks.size(), num_threads,
+               [&](const size_t& itile) {
+                 tile_stats[itile] = find_fabric_bitstream_block_subtree_stats(bitstream_manager, tile_blocks[itile]);
+               });
+
+  std::map<std::string, t_fabric_bitstream_tile_type_stats> tile_type_stats;
+  for (size_t itile = 0; itile < tile_blocks.size(); ++itile) {
+    t_fabric_bitstream_tile_type_stats& type_stats = tile_type_stats[module_manager.module_name(tile_modules[itile])];
+    type_stats.num_tiles++;
+    type_stats.bit_stats.num_bits += tile_stats[itile].num_bits;
+    type_stats.bit_stats.num_ones += tile_stats[itile].num_ones;
+  }
+  return tile_type_stats;
+}
+
+/********************************************************************
+ * Find the number of logic '1' in each configuration frame, i.e.,
+ * the bits loaded to the fabric in a programming cycle:
+ * - With addresses (memory banks and frame-based memories), a frame
+ *   contains the bits of all the regions sharing an address.
+ *   The frames of each region are found by a job and then merged
+ * - Otherwise (configuration chains), a frame contains a bit from
+ *   each region, where the regional bitstreams are aligned to
+ *   the longest one, as in the text bitstream files.
+ *   The frames are counted by chunks, one chunk per job
+ *******************************************************************/
+static
+std::vector<size_t> find_fabric_bitstream_frame_ones(const BitstreamManager& bitstream_manager,
+                                                     const FabricBitstream& fabric_bitstream,
+                                                     const size_t& num_threads) {
+  std::vector<size_t> frame_ones;
+
+  if (true == fabric_bitstream.use_address()) {
+    std::vector<std::map<std::vector<uint64_t>, size_t>> region_frame_ones(fabric_bitstream.num_regions());
+    parallel_for(fabric_bitstream.num_regions(), num_threads,
+                 [&](const size_t& iregion) {
+                   for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(FabricBitRegionId(iregion))) {
+                     const uint64_t* addr_words = fabric_bitstream.bit_address_words(fabric_bit);
+                     std::vector<uint64_t> frame_addr(addr_words, addr_words + fabric_bitstream.address_slot_num_words());
+                     if (true == fabric_bitstream.use_wl_address()) {
+                       const uint64_t* wl_addr_words = fabric_bitstream.bit_wl_address_words(fabric_bit);
+                       frame_addr.insert(frame_addr.end(), wl_addr_words, wl_addr_words + fabric_bitstream.wl_address_slot_num_words());
+                     }
+                     region_frame_ones[iregion][frame_addr] += bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+                   }
+                 });
+
+    std::map<std::vector<uint64_t>, size_t> merged_frame_ones;
+    for (const auto& frames : region_frame_ones) {
+      for (const auto& frame : frames) {
+        merged_frame_ones[frame.first] += frame.second;
+      }
+    }
+    frame_ones.reserve(merged_frame_ones.size());
+    for (const auto& frame : merged_frame_ones) {
+      frame_ones.push_back(frame.second);
+    }
+    return frame_ones;
+  }
+
+  size_t num_frames = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  frame_ones.resize(num_frames, 0);
+
+  std::vector<size_t> region_offsets;
+  region_offsets.reserve(fabric_bitstream.num_regions());
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    region_offsets.push_back(num_frames - fabric_bitstream.region_bits(region).size());
+  }
+
+  size_t num_chunks = (num_frames + FABRIC_BITSTREAM_STATS_FRAME_CHUNK_SIZE - 1) / FABRIC_BITSTREAM_STATS_FRAME_CHUNK_SIZE;
+  parallel_for(num_chunks, num_threads,
+               [&](const size_t& ichunk) {
+                 size_t first_frame = ichunk * FABRIC_BITSTREAM_STATS_FRAME_CHUNK_SIZE;
+                 size_t last_frame = std::min(num_frames, first_frame + FABRIC_BITSTREAM_STATS_FRAME_CHUNK_SIZE);
+                 for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+                   const std::vector<FabricBitId>& region_bits = fabric_bitstream.region_bits(region);
+                   size_t offset = region_offsets[size_t(region)];
+                   /* Logic '0' is deposited in the frames before the first bit of the region */
+                   for (size_t iframe = std::max(first_frame, offset); iframe < last_frame; ++iframe) {
+                     frame_ones[iframe] += bitstream_manager.bit_value(fabric_bitstream.config_bit(region_bits[iframe - offset]));
+                   }
+                 }
+               });
+
+  return frame_ones;
+}
+
+/********************************************************************
+ * Report the statistics of the configuration bits of a fabric bitstream
+ * to a JSON file, e.g.,
+ *   {
+ *     "num_bits": 2304,
+ *     "num_ones": 620,
+ *     "regions": [
+ *       {"id": 0, "num_bits": 2304, "num_ones": 620}
+ *     ],
+ *     "tile_types": [
+ *       {"name": "grid_clb", "num_tiles": 4, "num_bits": 2160, "num_ones": 580}
+ *     ],
+ *     "num_frames": 2304,
+ *     "frame_occupancy_histogram": [
+ *       {"num_ones": 0, "num_frames": 1684},
+ *       {"num_ones": 1, "num_frames": 620}
+ *     ]
+ *   }
+ * The regions, the tiles and the frames are counted on multiple threads
+ *******************************************************************/
+int report_fabric_bitstream_stats(const BitstreamManager& bitstream_manager,
+                                  const FabricBitstream& fabric_bitstream,
+                                  const ModuleManager& module_manager,
+                                  const std::string& fname,
+                                  const size_t& num_threads,
+                                  const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to report fabric bitstream statistics!\n\tPlease specify a valid file name.\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string timer_message = std::string("Report fabric bitstream statistics into JSON file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::vector<t_fabric_bitstream_bit_stats> region_stats = find_fabric_bitstream_region_stats(bitstream_manager, fabric_bitstream, num_threads);
+  std::map<std::string, t_fabric_bitstream_tile_type_stats> tile_type_stats = find_fabric_bitstream_tile_type_stats(bitstream_manager, module_manager, num_threads);
+  std::vector<size_t> frame_ones = find_fabric_bitstream_frame_ones(bitstream_manager, fabric_bitstream, num_threads);
+
+  size_t num_ones = 0;
+  for (const t_fabric_bitstream_bit_stats& stats : region_stats) {
+    num_ones += stats.num_ones;
+  }
+
+  std::map<size_t, size_t> frame_occupancy_histogram;
+  for (const size_t& ones : frame_ones) {
+    frame_occupancy_histogram[ones]++;
+  }
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "{\n";
+  fp << "  \"num_bits\": " << fabric_bitstream.num_bits() << ",\n";
+  fp << "  \"num_ones\": " << num_ones << ",\n";
+
+  fp << "  \"regions\": [";
+  for (size_t iregion = 0; iregion < region_stats.size(); ++iregion) {
+    fp << (0 == iregion ? "\n" : ",\n");
+    fp << "    {\"id\": " << iregion;
+    fp << ", \"num_bits\": " << region_stats[iregion].num_bits;
+    fp << ", \"num_ones\": " << region_stats[iregion].num_ones << "}";
+  }
+  fp << "\n  ],\n";
+
+  fp << "  \"tile_types\": [";
+  bool first_entry = true;
+  for (const auto& type_stats : tile_type_stats) {
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "    {\"name\": \"" << type_stats.first << "\"";
+    fp << ", \"num_tiles\": " << type_stats.second.num_tiles;
+    fp << ", \"num_bits\": " << type_stats.second.bit_stats.num_bits;
+    fp << ", \"num_ones\": " << type_stats.second.bit_stats.num_ones << "}";
+  }
+  fp << "\n  ],\n";
+
+  fp << "  \"num_frames\": " << frame_ones.size() << ",\n";
+  fp << "  \"frame_occupancy_histogram\": [";
+  first_entry = true;
+  for (const auto& bin : frame_occupancy_histogram) {
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "    {\"num_ones\": " << bin.first << ", \"num_frames\": " << bin.second << "}";
+  }
+  fp << "\n  ]\n";
+  fp << "}\n";
+
+  int status = CMD_EXEC_SUCCESS;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write fabric bitstream statistics to file '%s'!\n",
+                  fname.c_str());
+    status = CMD_EXEC_FATAL_ERROR;
+  }
+
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Counted %lu logic '1' out of %lu bits in %lu regions, %lu tile types and %lu frames\n",
+           num_ones, fabric_bitstream.num_bits(),
+           region_stats.size(), tile_type_stats.size(), frame_ones.size());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef REPORT_FABRIC_BITSTREAM_STATS_H
+#define REPORT_FABRIC_BITSTREAM_STATS_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_fabric_bitstream_stats(const BitstreamManager& bitstream_manager,
+                                  const FabricBitstream& fabric_bitstream,
+                                  const ModuleManager& module_manager,
+                                  const std::string& fname,
+                                  const size_t& num_threads,
+                                  const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
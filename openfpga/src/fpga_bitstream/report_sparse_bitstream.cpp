@@ -0,0 +1,269 @@
+/********************************************************************
+ * This file includes functions that report a sparse view of the
+ * fabric-independent bitstream: only the blocks under the top-level
+ * module whose bits differ from the default bitstream of their module
+ * are reported, which are the blocks to be written in a partial
+ * reconfiguration
+ *******************************************************************/
+#include <fstream>
+#include <map>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
+#include "openfpga_version.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager_utils.h"
+
+#include "openfpga_naming.h"
+
+#include "report_sparse_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * The instances of a module under the top-level module
+ * and their bits, in the order of the configurable children
+ *******************************************************************/
+struct SparseBitstreamModule {
+  ModuleId module;
+  std::vector<ConfigBlockId> blocks;
+  std::vector<std::vector<bool>> block_bits;
+};
+
+/********************************************************************
+ * This function write header information for an XML file of sparse bitstream
+ *******************************************************************/
+static
+void report_sparse_bitstream_xml_file_head(std::fstream& fp) {
+  valid_file_stream(fp);
+
+  fp << "<!-- " << std::endl;
+  fp << "\t- Report Sparse Architecture Bitstream" << std::endl;
+  fp << "\t- Version: " << openfpga::VERSION << std::endl;
+  fp << "\t- Date: " << generate_file_time_stamp() ;
+  fp << "--> " << std::endl;
+  fp << std::endl;
+}
+
+/********************************************************************
+ * Collect the bits of a block and all its child blocks, in a Depth-First Search
+ *******************************************************************/
+static
+void rec_collect_block_bits(const BitstreamManager& bitstream_manager,
+                            const ConfigBlockId& block,
+                            std::vector<bool>& bits) {
+  std::vector<bool> block_bits = bitstream_manager.block_bit_values(block);
+  bits.insert(bits.end(), block_bits.begin(), block_bits.end());
+
+  for (const ConfigBlockId& child_block : bitstream_manager.block_children(block)) {
+    rec_collect_block_bits(bitstream_manager, child_block, bits);
+  }
+}
+
+/********************************************************************
+ * Find the default bitstream of a module, which is the most common
+ * bitstream among its instances.
+ * All the unused instances of a module get the same bits (e.g., the
+ * default paths of multiplexers), so this is the bitstream of the unused
+ * instances, unless most of the instances are used.
+ * Ties are broken by the order of the instances
+ *******************************************************************/
+static
+std::vector<bool> find_sparse_bitstream_module_default_bits(const std::vector<std::vector<bool>>& block_bits) {
+  VTR_ASSERT(!block_bits.empty());
+
+  std::map<std::vector<bool>, size_t> bits_count;
+  for (const std::vector<bool>& bits : block_bits) {
+    bits_count[bits]++;
+  }
+
+  size_t default_index = 0;
+  for (size_t iblock = 1; iblock < block_bits.size(); ++iblock) {
+    if (bits_count.at(block_bits[iblock]) > bits_count.at(block_bits[default_index])) {
+      default_index = iblock;
+    }
+  }
+
+  return block_bits[default_index];
+}
+
+/********************************************************************
+ * Write bits as a string of '0' and '1'
+ *******************************************************************/
+static
+std::string generate_sparse_bitstream_bits_string(const std::vector<bool>& bits) {
+  std::string bits_str(bits.size(), '0');
+  for (size_t ibit = 0; ibit < bits.size(); ++ibit) {
+    if (true == bits[ibit]) {
+      bits_str[ibit] = '1';
+    }
+  }
+  return bits_str;
+}
+
+/********************************************************************
+ * Report the blocks under the top-level module whose bits differ from
+ * the default bitstream of their module, to a file in XML format, e.g.,
+ *   <sparse_bitstream num_blocks="24" num_configured_blocks="3" num_bits="2304" num_configured_bits="620">
+ *     <module name="grid_clb" num_instances="4" num_configured_instances="1" num_bits_per_instance="...">
+ *       <default bits="0101..."/>
+ *       <block name="grid_clb_1__1_" num_different_bits="12" bits="0111..."/>
+ *     </module>
+ *   </sparse_bitstream>
+ *
+ * The default bitstream of each module is computed once, from all its instances.
+ * The bits of a block follow the Depth-First Search order of its child blocks,
+ * and are only written when required
+ *******************************************************************/
+int report_sparse_bitstream(const BitstreamManager& bitstream_manager,
+                            const ModuleManager& module_manager,
+                            const std::string& fname,
+                            const bool& include_bits,
+                            const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to report sparse bitstream!\n\tPlease specify a valid file name.\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string timer_message = std::string("Report sparse architecture bitstream into XML file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Get the top module name in module manager, which is our starting point */
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  /* Find the top block in bitstream manager, which has not parents */
+  std::vector<ConfigBlockId> top_blocks = find_bitstream_manager_top_blocks(bitstream_manager);
+  VTR_ASSERT(1 == top_blocks.size());
+  VTR_ASSERT(top_module_name == bitstream_manager.block_name(top_blocks[0]));
+
+  /* Group the blocks of the configurable children by module */
+  std::vector<SparseBitstreamModule> sparse_modules;
+  std::map<ModuleId, size_t> module_indices;
+  const std::vector<ModuleId>& child_modules = module_manager.configurable_children(top_module);
+  const std::vector<size_t>& child_instances = module_manager.configurable_child_instances(top_module);
+  for (size_t ichild = 0; ichild < child_modules.size(); ++ichild) {
+    std::string instance_name = module_manager.instance_name(top_module, child_modules[ichild], child_instances[ichild]);
+    ConfigBlockId child_block = bitstream_manager.find_child_block(top_blocks[0], instance_name);
+    if (false == bitstream_manager.valid_block_id(child_block)) {
+      continue;
+    }
+
+    auto result = module_indices.insert(std::make_pair(child_modules[ichild], sparse_modules.size()));
+    if (true == result.second) {
+      sparse_modules.emplace_back();
+      sparse_modules.back().module = child_modules[ichild];
+    }
+    SparseBitstreamModule& sparse_module = sparse_modules[result.first->second];
+    sparse_module.blocks.push_back(child_block);
+    sparse_module.block_bits.emplace_back();
+    rec_collect_block_bits(bitstream_manager, child_block, sparse_module.block_bits.back());
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Put down a brief introduction */
+  report_sparse_bitstream_xml_file_head(fp);
+
+  /* Format the modules first, as the head of the report counts all the blocks */
+  std::ostringstream module_ss;
+  size_t num_blocks = 0;
+  size_t num_configured_blocks = 0;
+  size_t num_bits = 0;
+  size_t num_configured_bits = 0;
+  for (const SparseBitstreamModule& sparse_module : sparse_modules) {
+    std::vector<bool> default_bits = find_sparse_bitstream_module_default_bits(sparse_module.block_bits);
+
+    std::vector<size_t> configured_blocks;
+    std::vector<size_t> num_different_bits;
+    for (size_t iblock = 0; iblock < sparse_module.blocks.size(); ++iblock) {
+      const std::vector<bool>& bits = sparse_module.block_bits[iblock];
+      VTR_ASSERT(bits.size() == default_bits.size());
+      size_t num_diffs = 0;
+      for (size_t ibit = 0; ibit < bits.size(); ++ibit) {
+        if (bits[ibit] != default_bits[ibit]) {
+          num_diffs++;
+        }
+      }
+      if (0 < num_diffs) {
+        configured_blocks.push_back(iblock);
+        num_different_bits.push_back(num_diffs);
+      }
+    }
+
+    num_blocks += sparse_module.blocks.size();
+    num_configured_blocks += configured_blocks.size();
+    num_bits += sparse_module.blocks.size() * default_bits.size();
+    num_configured_bits += configured_blocks.size() * default_bits.size();
+
+    VTR_LOGV(verbose,
+             "Module '%s': %lu out of %lu instances differ from the default bitstream\n",
+             module_manager.module_name(sparse_module.module).c_str(),
+             configured_blocks.size(), sparse_module.blocks.size());
+
+    write_tab_to_file(module_ss, 1);
+    module_ss << "<module";
+    module_ss << " name=\"" << module_manager.module_name(sparse_module.module) << "\"";
+    module_ss << " num_instances=\"" << sparse_module.blocks.size() << "\"";
+    module_ss << " num_configured_instances=\"" << configured_blocks.size() << "\"";
+    module_ss << " num_bits_per_instance=\"" << default_bits.size() << "\"";
+    module_ss << ">" << std::endl;
+
+    if (true == include_bits) {
+      write_tab_to_file(module_ss, 2);
+      module_ss << "<default bits=\"" << generate_sparse_bitstream_bits_string(default_bits) << "\"/>" << std::endl;
+    }
+
+    for (size_t iconfigured = 0; iconfigured < configured_blocks.size(); ++iconfigured) {
+      size_t iblock = configured_blocks[iconfigured];
+      write_tab_to_file(module_ss, 2);
+      module_ss << "<block";
+      module_ss << " name=\"" << bitstream_manager.block_name(sparse_module.blocks[iblock]) << "\"";
+      module_ss << " num_different_bits=\"" << num_different_bits[iconfigured] << "\"";
+      if (true == include_bits) {
+        module_ss << " bits=\"" << generate_sparse_bitstream_bits_string(sparse_module.block_bits[iblock]) << "\"";
+      }
+      module_ss << "/>" << std::endl;
+    }
+
+    write_tab_to_file(module_ss, 1);
+    module_ss << "</module>" << std::endl;
+  }
+
+  fp << "<sparse_bitstream";
+  fp << " num_blocks=\"" << num_blocks << "\"";
+  fp << " num_configured_blocks=\"" << num_configured_blocks << "\"";
+  fp << " num_bits=\"" << num_bits << "\"";
+  fp << " num_configured_bits=\"" << num_configured_bits << "\"";
+  fp << ">" << std::endl;
+  fp << module_ss.str();
+  fp << "</sparse_bitstream>" << std::endl;
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOG("%lu out of %lu blocks differ from the default bitstream of their modules, carrying %lu out of %lu bits\n",
+          num_configured_blocks, num_blocks, num_configured_bits, num_bits);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
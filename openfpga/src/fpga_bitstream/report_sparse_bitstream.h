@@ -0,0 +1,26 @@
+#ifndef REPORT_SPARSE_BITSTREAM_H
+#define REPORT_SPARSE_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include "bitstream_manager.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int report_sparse_bitstream(const BitstreamManager& bitstream_manager,
+                            const ModuleManager& module_manager,
+                            const std::string& fname,
+                            const bool& include_bits,
+                            const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,207 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to files in binary format
+ *
+ * The binary file is organized in 64-bit words, so that it can be
+ * mapped into memory (e.g., mmap) and accessed without any parsing:
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   word 0 : magic number "OFPGABIT"                   |
+ *   |   word 1 : endian marker 0x0102030405060708          |
+ *   |   word 2 : format version                            |
+ *   |   word 3 : configuration protocol type               |
+ *   |   word 4 : number of configuration regions           |
+ *   |   word 5 : total number of configuration bits        |
+ *   |   word 6 : (BL) address width in bits                |
+ *   |   word 7 : WL address width in bits                  |
+ *   |   word 8 : number of words per (BL) address slot     |
+ *   |   word 9 : number of words per WL address slot       |
+ *   +------------------------------------------------------+
+ *   | Region table (2 words per region)                    |
+ *   |   number of bits in the region                       |
+ *   |   offset (in words) of the region payload            |
+ *   +------------------------------------------------------+
+ *   | Region payloads                                      |
+ *   |   data input bits, packed by 64 bits per word        |
+ *   |   (BL) address slots, one per bit (if any)           |
+ *   |   WL address slots, one per bit (if any)             |
+ *   +------------------------------------------------------+
+ *
+ * Each address slot consists of the value words followed by
+ * the don't care mask words. The i-th bit of an address is stored
+ * in the i-th position of the words.
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "write_binary_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of bits packed in a word of the binary file */
+constexpr size_t BINARY_BITSTREAM_WORD_SIZE = 64;
+
+/* Number of words in the header of a binary file */
+constexpr size_t BINARY_BITSTREAM_NUM_HEADER_WORDS = 10;
+
+/********************************************************************
+ * Write a number of words to a binary file stream in one call
+ *******************************************************************/
+static
+void write_binary_words_to_file(std::fstream& fp,
+                                const std::vector<uint64_t>& words) {
+  fp.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+}
+
+/********************************************************************
+ * Build the payload of a configuration region,
+ * including the data input bits and address slots
+ *******************************************************************/
+static
+std::vector<uint64_t> build_binary_fabric_bitstream_region_payload(const BitstreamManager& bitstream_manager,
+                                                                   const FabricBitstream& fabric_bitstream,
+                                                                   const FabricBitRegionId& region) {
+  const std::vector<FabricBitId>& region_bits = fabric_bitstream.region_bits(region);
+
+  size_t num_din_words = (region_bits.size() + BINARY_BITSTREAM_WORD_SIZE - 1) / BINARY_BITSTREAM_WORD_SIZE;
+  size_t addr_slot_size = 0;
+  size_t wl_addr_slot_size = 0;
+  if (true == fabric_bitstream.use_address()) {
+    addr_slot_size = fabric_bitstream.address_slot_num_words();
+  }
+  if (true == fabric_bitstream.use_wl_address()) {
+    wl_addr_slot_size = fabric_bitstream.wl_address_slot_num_words();
+  }
+
+  std::vector<uint64_t> payload(num_din_words + region_bits.size() * (addr_slot_size + wl_addr_slot_size), 0);
+
+  /* Pack data input bits */
+  for (size_t ibit = 0; ibit < region_bits.size(); ++ibit) {
+    if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(region_bits[ibit]))) {
+      payload[ibit / BINARY_BITSTREAM_WORD_SIZE] |= uint64_t(1) << (ibit % BINARY_BITSTREAM_WORD_SIZE);
+    }
+  }
+
+  /* Copy address slots, which are already packed in the fabric bitstream */
+  std::vector<uint64_t>::iterator addr_it = payload.begin() + num_din_words;
+  if (0 < addr_slot_size) {
+    for (const FabricBitId& bit_id : region_bits) {
+      const uint64_t* addr_words = fabric_bitstream.bit_address_words(bit_id);
+      addr_it = std::copy(addr_words, addr_words + addr_slot_size, addr_it);
+    }
+  }
+  if (0 < wl_addr_slot_size) {
+    for (const FabricBitId& bit_id : region_bits) {
+      const uint64_t* wl_addr_words = fabric_bitstream.bit_wl_address_words(bit_id);
+      addr_it = std::copy(wl_addr_words, wl_addr_words + wl_addr_slot_size, addr_it);
+    }
+  }
+  VTR_ASSERT(addr_it == payload.end());
+
+  return payload;
+}
+
+/********************************************************************
+ * Write the fabric bitstream to a binary file
+ * Notes:
+ *   - This file is designed for bitstream downloaders which
+ *     can map the file into memory and access bits directly
+ *   - Words are written in the byte order of the host machine,
+ *     which can be detected by the endian marker in the header
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_binary_file(const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const ConfigProtocol& config_protocol,
+                                          const std::string& fname,
+                                          const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output bitstream!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  /* Build the header */
+  std::vector<uint64_t> header(BINARY_BITSTREAM_NUM_HEADER_WORDS, 0);
+  std::copy(BINARY_FABRIC_BITSTREAM_MAGIC, BINARY_FABRIC_BITSTREAM_MAGIC + sizeof(uint64_t), reinterpret_cast<char*>(&header[0]));
+  header[1] = BINARY_FABRIC_BITSTREAM_ENDIAN_MARKER;
+  header[2] = BINARY_FABRIC_BITSTREAM_VERSION;
+  header[3] = config_protocol.type();
+  header[4] = fabric_bitstream.num_regions();
+  header[5] = fabric_bitstream.num_bits();
+  if (true == fabric_bitstream.use_address()) {
+    header[6] = fabric_bitstream.address_length();
+    header[8] = fabric_bitstream.address_slot_num_words();
+  }
+  if (true == fabric_bitstream.use_wl_address()) {
+    header[7] = fabric_bitstream.wl_address_length();
+    header[9] = fabric_bitstream.wl_address_slot_num_words();
+  }
+
+  /* Build the region table, where the payload size of each region can be
+   * calculated from its number of bits without building the payload
+   */
+  std::vector<uint64_t> region_table;
+  region_table.reserve(2 * fabric_bitstream.num_regions());
+
+  size_t curr_offset = header.size() + 2 * fabric_bitstream.num_regions();
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    size_t num_region_bits = fabric_bitstream.region_bits(region).size();
+    region_table.push_back(num_region_bits);
+    region_table.push_back(curr_offset);
+    curr_offset += (num_region_bits + BINARY_BITSTREAM_WORD_SIZE - 1) / BINARY_BITSTREAM_WORD_SIZE
+                 + num_region_bits * (header[8] + header[9]);
+  }
+
+  /* Output to the file, each part is written in one call 
+   * Payloads are built and written region by region to limit memory usage
+   */
+  write_binary_words_to_file(fp, header);
+  write_binary_words_to_file(fp, region_table);
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    std::vector<uint64_t> region_payload = build_binary_fabric_bitstream_region_payload(bitstream_manager, fabric_bitstream, region);
+    VTR_ASSERT(region_table[2 * size_t(region) + 1] + region_payload.size() <= curr_offset);
+    write_binary_words_to_file(fp, region_payload);
+  }
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write bitstream to binary file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted %lu configuration bits to binary file: %s\n",
+           fabric_bitstream.num_bits(),
+           fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
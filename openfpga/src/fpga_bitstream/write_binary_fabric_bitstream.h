@@ -0,0 +1,36 @@
+#ifndef WRITE_BINARY_FABRIC_BITSTREAM_H
+#define WRITE_BINARY_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "config_protocol.h"
+
+/********************************************************************
+ * Constants for the binary fabric bitstream file format
+ *******************************************************************/
+constexpr char BINARY_FABRIC_BITSTREAM_MAGIC[] = "OFPGABIT";
+constexpr uint64_t BINARY_FABRIC_BITSTREAM_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t BINARY_FABRIC_BITSTREAM_VERSION = 1;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_bitstream_to_binary_file(const BitstreamManager& bitstream_manager,
+                                          const FabricBitstream& fabric_bitstream,
+                                          const ConfigProtocol& config_protocol,
+                                          const std::string& fname,
+                                          const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
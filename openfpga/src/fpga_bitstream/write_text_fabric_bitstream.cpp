@@ -13,6 +13,8 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
+#include "openfpga_gzip_stream.h"
 #include "openfpga_version.h"
 
 #include "openfpga_naming.h"
@@ -25,19 +27,19 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Size of the buffer (in characters) to be filled before writing to files */
+constexpr size_t TEXT_BITSTREAM_BUFFER_SIZE = 1 << 20;
+
 /********************************************************************
  * This function write header information to a bitstream file
  *******************************************************************/
 static 
-void write_fabric_bitstream_text_file_head(std::fstream& fp) {
+void write_fabric_bitstream_text_file_head(std::ostream& fp) {
   valid_file_stream(fp);
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
   fp << "// Fabric bitstream" << std::endl;
   fp << "// Version: " << openfpga::VERSION << std::endl;
-  fp << "// Date: " << std::ctime(&end_time);
+  fp << "// Date: " << generate_file_time_stamp();
 }
 
 /********************************************************************
@@ -48,7 +50,7 @@ void write_fabric_bitstream_text_file_head(std::fstream& fp) {
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_flatten_fabric_bitstream_to_text_file(std::fstream& fp,
+int write_flatten_fabric_bitstream_to_text_file(std::ostream& fp,
                                                 const BitstreamManager& bitstream_manager,
                                                 const FabricBitstream& fabric_bitstream) {
   if (false == valid_file_stream(fp)) {
@@ -70,12 +72,18 @@ int write_flatten_fabric_bitstream_to_text_file(std::fstream& fp,
  * Write the fabric bitstream fitting a configuration chain protocol
  * to a plain text file 
  *
+ * The regional bitstreams are aligned to the longest one, 
+ * by depositing logic '0' at the head of shorter ones (see details in 
+ * build_config_chain_fabric_bitstream_by_region()).
+ * Instead of building the aligned bitstreams, each region keeps a cursor 
+ * on its bits and the lines are streamed to the file through a buffer
+ *
  * Return:
  *  - 0 if succeed
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_config_chain_fabric_bitstream_to_text_file(std::fstream& fp,
+int write_config_chain_fabric_bitstream_to_text_file(std::ostream& fp,
                                                      const bool& fast_configuration,
                                                      const bool& bit_value_to_skip,
                                                      const BitstreamManager& bitstream_manager,
@@ -83,7 +91,6 @@ int write_config_chain_fabric_bitstream_to_text_file(std::fstream& fp,
   int status = 0;
 
   size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
-  ConfigChainFabricBitstream regional_bitstreams = build_config_chain_fabric_bitstream_by_region(bitstream_manager, fabric_bitstream);
 
   /* For fast configuration, the bitstream size counts from the first bit '1' */
   size_t num_bits_to_skip = 0;
@@ -99,15 +106,36 @@ int write_config_chain_fabric_bitstream_to_text_file(std::fstream& fp,
   fp << "// Bitstream length: " << regional_bitstream_max_size - num_bits_to_skip << std::endl;
   fp << "// Bitstream width (LSB -> MSB): " << fabric_bitstream.num_regions() << std::endl;
 
-  /* Output bitstream data */
+  /* Cursor of each region: the index of the line where its first bit is placed */
+  std::vector<size_t> region_offsets;
+  region_offsets.reserve(fabric_bitstream.num_regions());
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    region_offsets.push_back(regional_bitstream_max_size - fabric_bitstream.region_bits(region).size());
+  }
+
+  /* Output bitstream data, flush the buffer to the file in large blocks */
+  std::string buffer;
+  buffer.reserve(TEXT_BITSTREAM_BUFFER_SIZE + fabric_bitstream.num_regions() + 1);
   for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size; ++ibit) { 
-    for (const auto& region_bitstream : regional_bitstreams) {
-      fp << region_bitstream[ibit];
+    for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+      size_t offset = region_offsets[size_t(region)];
+      if (ibit < offset) {
+        buffer.push_back('0');
+      } else if (true == bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bitstream.region_bits(region)[ibit - offset]))) {
+        buffer.push_back('1');
+      } else {
+        buffer.push_back('0');
+      }
     }
     if (ibit < regional_bitstream_max_size - 1) {
-      fp << std::endl;
+      buffer.push_back('\n');
+    }
+    if (TEXT_BITSTREAM_BUFFER_SIZE <= buffer.size()) {
+      fp.write(buffer.data(), buffer.size());
+      buffer.clear();
     }
   }
+  fp.write(buffer.data(), buffer.size());
 
   return status;
 }
@@ -121,7 +149,7 @@ int write_config_chain_fabric_bitstream_to_text_file(std::fstream& fp,
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_memory_bank_fabric_bitstream_to_text_file(std::fstream& fp,
+int write_memory_bank_fabric_bitstream_to_text_file(std::ostream& fp,
                                                     const bool& fast_configuration,
                                                     const bool& bit_value_to_skip,
                                                     const FabricBitstream& fabric_bitstream) {
@@ -139,7 +167,12 @@ int write_memory_bank_fabric_bitstream_to_text_file(std::fstream& fp,
   /* Identify and output bitstream size information */
   size_t num_bits_to_skip = 0;
   if (true == fast_configuration) {
-    num_bits_to_skip = fabric_bits_by_addr.size() - find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+    /* Count on the bitstream which has been reorganized, rather than building it again */
+    for (const auto& addr_din_pair : fabric_bits_by_addr) {
+      if (true == is_fabric_bit_dins_to_skip(addr_din_pair.second, bit_value_to_skip)) {
+        num_bits_to_skip++;
+      }
+    }
     VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
     VTR_LOG("Fast configuration will skip %g% (%lu/%lu) of configuration bitstream.\n",
             100. * (float) num_bits_to_skip / (float) fabric_bits_by_addr.size(),
@@ -161,7 +194,7 @@ int write_memory_bank_fabric_bitstream_to_text_file(std::fstream& fp,
      * the programming cycle can be skipped!
      */
     if (true == fast_configuration) {
-      if (addr_din_pair.second == std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+      if (true == is_fabric_bit_dins_to_skip(addr_din_pair.second, bit_value_to_skip)) {
         continue;
       }
     }
@@ -189,7 +222,7 @@ int write_memory_bank_fabric_bitstream_to_text_file(std::fstream& fp,
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_frame_based_fabric_bitstream_to_text_file(std::fstream& fp,
+int write_frame_based_fabric_bitstream_to_text_file(std::ostream& fp,
                                                     const bool& fast_configuration,
                                                     const bool& bit_value_to_skip,
                                                     const FabricBitstream& fabric_bitstream) {
@@ -206,7 +239,12 @@ int write_frame_based_fabric_bitstream_to_text_file(std::fstream& fp,
   /* Identify and output bitstream size information */
   size_t num_bits_to_skip = 0;
   if (true == fast_configuration) {
-    num_bits_to_skip = fabric_bits_by_addr.size() - find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+    /* Count on the bitstream which has been reorganized, rather than building it again */
+    for (const auto& addr_din_pair : fabric_bits_by_addr) {
+      if (true == is_fabric_bit_dins_to_skip(addr_din_pair.second, bit_value_to_skip)) {
+        num_bits_to_skip++;
+      }
+    }
     VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
     VTR_LOG("Fast configuration will skip %g% (%lu/%lu) of configuration bitstream.\n",
             100. * (float) num_bits_to_skip / (float) fabric_bits_by_addr.size(),
@@ -224,7 +262,7 @@ int write_frame_based_fabric_bitstream_to_text_file(std::fstream& fp,
      * the programming cycle can be skipped!
      */
     if (true == fast_configuration) {
-      if (addr_din_pair.second == std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+      if (true == is_fabric_bit_dins_to_skip(addr_din_pair.second, bit_value_to_skip)) {
         continue;
       }
     }
@@ -260,6 +298,8 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
                                         const FabricGlobalPortInfo& global_ports,
                                         const std::string& fname,
                                         const bool& fast_configuration,
+                                        const bool& compress,
+                                        const size_t& num_threads,
                                         const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
@@ -269,11 +309,21 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
   std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into plain text file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  /* Create the file stream 
+   * When compression is enabled, the contents are compressed 
+   * by a gzip stream buffer before reaching the file
+   */
+  std::fstream fp_file;
+  std::ios_base::openmode fp_mode = std::fstream::out | std::fstream::trunc;
+  if (true == compress) {
+    fp_mode |= std::fstream::binary;
+  }
+  fp_file.open(fname, fp_mode);
+
+  check_file_stream(fname.c_str(), fp_file);
 
-  check_file_stream(fname.c_str(), fp);
+  GzipStreamBuffer gzip_buffer(fp_file, num_threads);
+  std::ostream fp(compress ? static_cast<std::streambuf*>(&gzip_buffer) : fp_file.rdbuf());
 
   bool apply_fast_configuration = is_fast_configuration_applicable(global_ports) && fast_configuration;
   if (fast_configuration && apply_fast_configuration != fast_configuration) {
@@ -328,8 +378,14 @@ int write_fabric_bitstream_to_text_file(const BitstreamManager& bitstream_manage
   /* Print an end to the file here */
   fp << std::endl;
 
+  if ((true == compress) && (false == gzip_buffer.finish())) {
+    VTR_LOG_ERROR("Fail to compress bitstream to file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
   /* Close file handler */
-  fp.close();
+  fp_file.close();
 
   VTR_LOGV(verbose,
            "Outputted %lu configuration bits to plain text file: %s\n",
@@ -10,15 +10,19 @@
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_vector.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_decode.h"
+#include "openfpga_time_stamp.h"
+#include "openfpga_gzip_stream.h"
+#include "openfpga_parallel.h"
 
 /* Headers from archopenfpga library */
 
 #include "openfpga_naming.h"
 
-#include "bitstream_manager_utils.h"
 #include "write_xml_fabric_bitstream.h"
 
 /* begin namespace openfpga */
@@ -28,21 +32,86 @@ namespace openfpga {
  * This function write header information to a bitstream file
  *******************************************************************/
 static 
-void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
+void write_fabric_bitstream_xml_file_head(std::ostream& fp) {
   valid_file_stream(fp);
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
   fp << "<!--" << std::endl;
   fp << "\t- Fabric bitstream" << std::endl;
   fp << "\t- Author: Xifan TANG" << std::endl;
   fp << "\t- Organization: University of Utah" << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << generate_file_time_stamp() ;
   fp << "-->" << std::endl;
   fp << std::endl;
 }
 
+/* Number of bits formatted at once by a thread */
+constexpr size_t XML_FABRIC_BITSTREAM_CHUNK_SIZE = 4096;
+
+/********************************************************************
+ * Find the hierarchical path of a block, ending with a dot, e.g., 
+ *   top.next.block.
+ * The path of each block is built once from the path of its parent 
+ * and cached, as all the bits of the same block share the path
+ *******************************************************************/
+static 
+const std::string& find_cached_block_path_prefix(const BitstreamManager& bitstream_manager,
+                                                 const ConfigBlockId& block,
+                                                 vtr::vector<ConfigBlockId, std::string>& block_path_prefixes) {
+  /* A path is never empty once built */
+  std::string& path_prefix = block_path_prefixes[block];
+  if (false == path_prefix.empty()) {
+    return path_prefix;
+  }
+
+  const ConfigBlockId& parent_block = bitstream_manager.block_parent(block);
+  if (true == bitstream_manager.valid_block_id(parent_block)) {
+    path_prefix = find_cached_block_path_prefix(bitstream_manager, parent_block, block_path_prefixes);
+  }
+  path_prefix += bitstream_manager.block_name(block);
+  path_prefix += '.';
+
+  return path_prefix;
+}
+
+/********************************************************************
+ * Build the hierarchical paths of all the blocks, so that 
+ * they can be shared by the threads writing the bits
+ *******************************************************************/
+static 
+vtr::vector<ConfigBlockId, std::string> build_block_path_prefixes(const BitstreamManager& bitstream_manager) {
+  vtr::vector<ConfigBlockId, std::string> block_path_prefixes(bitstream_manager.num_blocks());
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    find_cached_block_path_prefix(bitstream_manager, block, block_path_prefixes);
+  }
+  return block_path_prefixes;
+}
+
+/********************************************************************
+ * Write an address decoded from its packed slot (value words followed 
+ * by the don't care mask words) without unpacking it into a vector
+ * The buffer is reused between the bits
+ *******************************************************************/
+static 
+void write_fabric_bit_address_to_xml_file(std::ostream& fp,
+                                          const uint64_t* slot,
+                                          const size_t& slot_num_words,
+                                          const size_t& address_length,
+                                          std::string& address_buffer) {
+  constexpr size_t WORD_SIZE = 64;
+  const size_t num_words = slot_num_words / 2;
+
+  address_buffer.assign(address_length, '0');
+  for (size_t i = 0; i < address_length; ++i) {
+    uint64_t mask = uint64_t(1) << (i % WORD_SIZE);
+    if (slot[num_words + i / WORD_SIZE] & mask) {
+      address_buffer[i] = DONT_CARE_CHAR;
+    } else if (slot[i / WORD_SIZE] & mask) {
+      address_buffer[i] = '1';
+    }
+  }
+  fp.write(address_buffer.data(), address_buffer.size());
+}
+
 /********************************************************************
  * Write a configuration bit into a plain text file
  * General format
@@ -67,12 +136,15 @@ void write_fabric_bitstream_xml_file_head(std::fstream& fp) {
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_fabric_config_bit_to_xml_file(std::fstream& fp,
+int write_fabric_config_bit_to_xml_file(std::ostream& fp,
                                         const BitstreamManager& bitstream_manager,
                                         const FabricBitstream& fabric_bitstream,
                                         const FabricBitId& fabric_bit,
                                         const e_config_protocol_type& config_type,
-                                        const int& xml_hierarchy_depth) {
+                                        const int& xml_hierarchy_depth,
+                                        const std::string& mem_out_name,
+                                        const vtr::vector<ConfigBlockId, std::string>& block_path_prefixes,
+                                        std::string& address_buffer) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
@@ -86,18 +158,10 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
   /* Output hierarchy of this parent*/
   const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
   const ConfigBlockId& config_block = bitstream_manager.bit_parent_block(config_bit);
-  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block); 
-  std::string hie_path;
-  for (const ConfigBlockId& temp_block : block_hierarchy) {
-    hie_path += bitstream_manager.block_name(temp_block);
-    hie_path += std::string(".");
-  }
-  hie_path += generate_configurable_memory_data_out_name();
-  hie_path += std::string("[");
-  hie_path += std::to_string(find_bitstream_manager_config_bit_index_in_parent_block(bitstream_manager, config_bit));
-  hie_path += std::string("]");
-
-  fp << " path=\"" << hie_path << "\">\n";
+  /* Bits of a block are contiguous, the index is the offset to the first bit of the block */
+  fp << " path=\"" << block_path_prefixes[config_block];
+  fp << mem_out_name << "[" << size_t(config_bit) - size_t(bitstream_manager.block_first_bit(config_block)) << "]";
+  fp << "\">\n";
 
   switch (config_type) {
   case CONFIG_MEM_STANDALONE: 
@@ -107,25 +171,28 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
     /* Bit line address */
     write_tab_to_file(fp, xml_hierarchy_depth + 1);
     fp << "<bl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_bl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    write_fabric_bit_address_to_xml_file(fp, fabric_bitstream.bit_address_words(fabric_bit),
+                                         fabric_bitstream.address_slot_num_words(),
+                                         fabric_bitstream.address_length(),
+                                         address_buffer);
     fp << "\"/>\n";   
  
     write_tab_to_file(fp, xml_hierarchy_depth + 1);
     fp << "<wl address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_wl_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    write_fabric_bit_address_to_xml_file(fp, fabric_bitstream.bit_wl_address_words(fabric_bit),
+                                         fabric_bitstream.wl_address_slot_num_words(),
+                                         fabric_bitstream.wl_address_length(),
+                                         address_buffer);
     fp << "\"/>\n";   
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
     write_tab_to_file(fp, xml_hierarchy_depth + 1);
     fp << "<frame address=\"";
-    for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-      fp << addr_bit;
-    }
+    write_fabric_bit_address_to_xml_file(fp, fabric_bitstream.bit_address_words(fabric_bit),
+                                         fabric_bitstream.address_slot_num_words(),
+                                         fabric_bitstream.address_length(),
+                                         address_buffer);
     fp << "\"/>\n";   
     break;
   }
@@ -143,23 +210,26 @@ int write_fabric_config_bit_to_xml_file(std::fstream& fp,
 
 /********************************************************************
  * Write the fabric bitstream in a specific configuration region to an XML file 
+ * The bits are formatted by chunks in parallel and written in order
  *
  * Return:
  *  - 0 if succeed
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_fabric_regional_config_bit_to_xml_file(std::fstream& fp,
+int write_fabric_regional_config_bit_to_xml_file(std::ostream& fp,
                                                  const BitstreamManager& bitstream_manager,
                                                  const FabricBitstream& fabric_bitstream,
                                                  const FabricBitRegionId& fabric_region,
                                                  const e_config_protocol_type& config_type,
-                                                 const int& xml_hierarchy_depth) {
+                                                 const int& xml_hierarchy_depth,
+                                                 const vtr::vector<ConfigBlockId, std::string>& block_path_prefixes,
+                                                 const size_t& num_threads) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
 
-  int status = 0;
+  const std::string mem_out_name = generate_configurable_memory_data_out_name();
 
   write_tab_to_file(fp, xml_hierarchy_depth);
   fp << "<region ";
@@ -168,15 +238,27 @@ int write_fabric_regional_config_bit_to_xml_file(std::fstream& fp,
   fp << "\"";
   fp << ">\n";
 
-  for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(fabric_region)) {
-    status = write_fabric_config_bit_to_xml_file(fp, bitstream_manager,
-                                                 fabric_bitstream,
-                                                 fabric_bit,
-                                                 config_type,
-                                                 xml_hierarchy_depth + 1);
-    if (1 == status) {
-      return status;
+  const std::vector<FabricBitId>& region_bits = fabric_bitstream.region_bits(fabric_region);
+  int status = parallel_write_chunks(fp, region_bits.size(), XML_FABRIC_BITSTREAM_CHUNK_SIZE, num_threads,
+                                     [&](std::ostream& chunk_fp, const size_t& begin, const size_t& end) {
+    std::string address_buffer;
+    for (size_t ibit = begin; ibit < end; ++ibit) {
+      int bit_status = write_fabric_config_bit_to_xml_file(chunk_fp, bitstream_manager,
+                                                           fabric_bitstream,
+                                                           region_bits[ibit],
+                                                           config_type,
+                                                           xml_hierarchy_depth + 1,
+                                                           mem_out_name,
+                                                           block_path_prefixes,
+                                                           address_buffer);
+      if (0 != bit_status) {
+        return bit_status;
+      }
     }
+    return 0;
+  });
+  if (0 != status) {
+    return status;
   }
 
   write_tab_to_file(fp, xml_hierarchy_depth);
@@ -200,6 +282,8 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
                                        const FabricBitstream& fabric_bitstream,
                                        const ConfigProtocol& config_protocol,
                                        const std::string& fname,
+                                       const bool& compress,
+                                       const size_t& num_threads,
                                        const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
@@ -209,11 +293,21 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
   std::string timer_message = std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) + std::string(" fabric bitstream into xml file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  /* Create the file stream 
+   * When compression is enabled, the contents are compressed 
+   * by a gzip stream buffer before reaching the file
+   */
+  std::fstream fp_file;
+  std::ios_base::openmode fp_mode = std::fstream::out | std::fstream::trunc;
+  if (true == compress) {
+    fp_mode |= std::fstream::binary;
+  }
+  fp_file.open(fname, fp_mode);
+
+  check_file_stream(fname.c_str(), fp_file);
 
-  check_file_stream(fname.c_str(), fp);
+  GzipStreamBuffer gzip_buffer(fp_file, num_threads);
+  std::ostream fp(compress ? static_cast<std::streambuf*>(&gzip_buffer) : fp_file.rdbuf());
 
   /* Write XML head */
   write_fabric_bitstream_xml_file_head(fp);
@@ -221,14 +315,19 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
   int xml_hierarchy_depth = 0;
   fp << "<fabric_bitstream>\n";
 
-  /* Output fabric bitstream to the file */
+  /* Output fabric bitstream to the file 
+   * The paths of the blocks are shared by all the regions
+   */
+  vtr::vector<ConfigBlockId, std::string> block_path_prefixes = build_block_path_prefixes(bitstream_manager);
   int status = 0;
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     status = write_fabric_regional_config_bit_to_xml_file(fp, bitstream_manager,
                                                           fabric_bitstream,
                                                           region,
                                                           config_protocol.type(),
-                                                          xml_hierarchy_depth + 1);
+                                                          xml_hierarchy_depth + 1,
+                                                          block_path_prefixes,
+                                                          num_threads);
     if (1 == status) {
       break;
     }
@@ -237,8 +336,14 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
   /* Print an end to the file here */
   fp << "</fabric_bitstream>\n";
 
+  if ((true == compress) && (false == gzip_buffer.finish())) {
+    VTR_LOG_ERROR("Fail to compress bitstream to file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
   /* Close file handler */
-  fp.close();
+  fp_file.close();
 
   VTR_LOGV(verbose,
            "Outputted %lu configuration bits to XML file: %s\n",
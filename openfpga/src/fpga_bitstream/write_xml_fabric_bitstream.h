@@ -21,6 +21,8 @@ int write_fabric_bitstream_to_xml_file(const BitstreamManager& bitstream_manager
                                        const FabricBitstream& fabric_bitstream,
                                        const ConfigProtocol& config_protocol,
                                        const std::string& fname,
+                                       const bool& compress,
+                                       const size_t& num_threads,
                                        const bool& verbose);
 
 } /* end namespace openfpga */
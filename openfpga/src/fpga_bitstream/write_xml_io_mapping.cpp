@@ -13,6 +13,8 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
+#include "openfpga_parallel.h"
 
 /* Headers from archopenfpga library */
 #include "openfpga_naming.h"
@@ -25,20 +27,20 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of I/O mapping pairs formatted at once by a thread */
+constexpr size_t XML_IO_MAPPING_CHUNK_SIZE = 4096;
+
 /********************************************************************
  * This function write header information to an I/O mapping file
  *******************************************************************/
 static 
 void write_io_mapping_xml_file_head(std::fstream& fp) {
   valid_file_stream(fp);
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
 
   fp << "<!--" << std::endl;
   fp << "\t- I/O mapping" << std::endl;
   fp << "\t- Version: " << openfpga::VERSION << std::endl;
-  fp << "\t- Date: " << std::ctime(&end_time) ;
+  fp << "\t- Date: " << generate_file_time_stamp() ;
   fp << "-->" << std::endl;
   fp << std::endl;
 }
@@ -51,10 +53,10 @@ void write_io_mapping_xml_file_head(std::fstream& fp) {
  *  - 1 if critical errors occured
  *******************************************************************/
 static 
-int write_io_mapping_pair_to_xml_file(std::fstream& fp,
+int write_io_mapping_pair_to_xml_file(std::ostream& fp,
                                       const IoMap& io_map,
                                       const IoMapId& io_map_id,
-                                      int xml_hierarchy_depth) {
+                                      const int& xml_hierarchy_depth) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
@@ -86,6 +88,8 @@ int write_io_mapping_pair_to_xml_file(std::fstream& fp,
  *   - This file is designed for users to learn 
  *     - what nets are mapped to each I/O is mapped, io[0] -> netA
  *     - what directionality is applied to each I/O, io[0] -> input
+ *   - The I/O mapping pairs are formatted by chunks in parallel
+ *     and written in order
  *
  * Return:
  *  - 0 if succeed
@@ -93,6 +97,7 @@ int write_io_mapping_pair_to_xml_file(std::fstream& fp,
  *******************************************************************/
 int write_io_mapping_to_xml_file(const IoMap& io_map,
                                  const std::string& fname,
+                                 const size_t& num_threads,
                                  const bool& verbose) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
@@ -115,25 +120,27 @@ int write_io_mapping_to_xml_file(const IoMap& io_map,
   int xml_hierarchy_depth = 0;
   fp << "<io_mapping>\n";
 
-  /* Output fabric bitstream to the file */
-  int status = 0;
-  int io_map_cnt = 0;
-  for (const auto& io_map_id : io_map.io_map()) {
-    status = write_io_mapping_pair_to_xml_file(fp,
-                                               io_map, io_map_id,
-                                               xml_hierarchy_depth + 1);
-    io_map_cnt++;
-    if (1 == status) {
-      break;
+  /* Output I/O mapping pairs to the file */
+  std::vector<IoMapId> io_map_ids(io_map.io_map().begin(), io_map.io_map().end());
+  int status = parallel_write_chunks(fp, io_map_ids.size(), XML_IO_MAPPING_CHUNK_SIZE, num_threads,
+                                     [&](std::ostream& chunk_fp, const size_t& begin, const size_t& end) {
+    for (size_t imap = begin; imap < end; ++imap) {
+      int pair_status = write_io_mapping_pair_to_xml_file(chunk_fp,
+                                                          io_map, io_map_ids[imap],
+                                                          xml_hierarchy_depth + 1);
+      if (0 != pair_status) {
+        return pair_status;
+      }
     }
-  }
+    return 0;
+  });
 
   /* Print an end to the file here */
   fp << "</io_mapping>\n";
 
   VTR_LOGV(verbose,
-           "Outputted %d I/O mapping to file '%s'\n",
-           io_map_cnt,
+           "Outputted %lu I/O mapping to file '%s'\n",
+           io_map_ids.size(),
            fname.c_str());
 
   /* Close file handler */
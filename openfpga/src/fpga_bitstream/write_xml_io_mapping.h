@@ -18,6 +18,7 @@ namespace openfpga {
 
 int write_io_mapping_to_xml_file(const IoMap& io_map,
                                  const std::string& fname,
+                                 const size_t& num_threads,
                                  const bool& verbose);
 
 } /* end namespace openfpga */
@@ -19,16 +19,71 @@
 #include "openfpga_device_grid_utils.h"
 
 #include "sdc_writer_utils.h" 
+#include "sdc_module_path.h" 
 #include "analysis_sdc_writer_utils.h" 
 #include "analysis_sdc_grid_writer.h" 
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find a wildcard which matches the names of all the instances
+ * of a child module under a parent module, e.g., fle_* for fle_0 and fle_1
+ * The wildcard is the common prefix of the instance names,
+ * and it must not match any instance of other child modules
+ *
+ * Return an empty string if there is no such wildcard
+ *******************************************************************/
+static 
+std::string find_analysis_sdc_child_instance_wildcard(const ModuleManager& module_manager,
+                                                      const ModuleId& parent_module,
+                                                      const ModuleId& child_module) {
+  std::vector<std::string> instance_names;
+  for (const size_t& inst : module_manager.child_module_instances(parent_module, child_module)) {
+    instance_names.push_back(module_manager.instance_name(parent_module, child_module, inst));
+    /* Must have a valid instance name!!! */
+    VTR_ASSERT(false == instance_names.back().empty()); 
+  }
+  if (2 > instance_names.size()) {
+    return std::string();
+  }
+
+  std::string prefix = instance_names.front();
+  for (const std::string& instance_name : instance_names) {
+    size_t common_length = 0;
+    while ( (common_length < prefix.length())
+         && (common_length < instance_name.length())
+         && (prefix[common_length] == instance_name[common_length]) ) {
+      ++common_length;
+    }
+    prefix.resize(common_length);
+  }
+  if (true == prefix.empty()) {
+    return std::string();
+  }
+
+  for (const ModuleId& other_module : module_manager.child_modules(parent_module)) {
+    if (other_module == child_module) {
+      continue;
+    }
+    for (const size_t& inst : module_manager.child_module_instances(parent_module, other_module)) {
+      if (0 == module_manager.instance_name(parent_module, other_module, inst).compare(0, prefix.length(), prefix)) {
+        return std::string();
+      }
+    }
+  }
+
+  return prefix + std::string("*");
+}
+
 /********************************************************************
  * Recursively visit all the pb_types in the hierarchy 
  * and disable all the ports
  *
+ * When compact SDC is required, all the instances of a child pb_type
+ * are disabled at once with a wildcard on their instance names,
+ * as they are all unused. Comments are skipped as well.
+ *
  * Note: it is a must to disable all the ports in all the child pb_types!
  * This can prohibit timing analyzer to consider any FF-to-FF path or 
  * combinatinal path inside an unused grid, when finding critical paths!!!
@@ -38,8 +93,9 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
                                                           const VprDeviceAnnotation& device_annotation,
                                                           const ModuleManager& module_manager,
                                                           const ModuleId& parent_module,
-                                                          const std::string& hierarchy_name,
-                                                          t_pb_graph_node* physical_pb_graph_node) {
+                                                          SdcModulePath& module_path,
+                                                          t_pb_graph_node* physical_pb_graph_node,
+                                                          const bool& compact_unused_resources) {
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
   /* Validate file stream */
@@ -48,12 +104,14 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
   /* Disable all the ports of current module (parent_module)!
    * Hierarchy name already includes the instance name of parent_module 
    */
-  fp << "#######################################" << std::endl; 
-  fp << "# Disable all the ports for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl; 
+  if (false == compact_unused_resources) {
+    fp << "#######################################" << std::endl; 
+    fp << "# Disable all the ports for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
+    fp << "#######################################" << std::endl; 
+  }
 
   fp << "set_disable_timing ";
-  fp << hierarchy_name; 
+  fp << module_path.path(); 
   fp << "*";
   fp << std::endl;
 
@@ -73,16 +131,31 @@ void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(std::fstream& fp,
     ModuleId child_module = module_manager.find_module(child_module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(child_module));
 
+    /* All the instances share the same pb_graph hierarchy, visit only the first one */
+    if (true == compact_unused_resources) {
+      std::string child_instance_wildcard = find_analysis_sdc_child_instance_wildcard(module_manager, parent_module, child_module);
+      if (false == child_instance_wildcard.empty()) {
+        module_path.push_instance(child_instance_wildcard);
+        rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation, module_manager, child_module, module_path, 
+                                                             &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][0]),
+                                                             compact_unused_resources);
+        module_path.pop_instance();
+        continue;
+      }
+    }
+
     /* Each child may exist multiple times in the hierarchy*/
     for (int inst = 0; inst < physical_mode->pb_type_children[ichild].num_pb; ++inst) {
       std::string child_instance_name = module_manager.instance_name(parent_module, child_module, module_manager.child_module_instances(parent_module, child_module)[inst]);
       /* Must have a valid instance name!!! */
       VTR_ASSERT(false == child_instance_name.empty()); 
 
-      std::string updated_hierarchy_name = hierarchy_name + child_instance_name + std::string("/");
+      module_path.push_instance(child_instance_name);
 
-      rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation, module_manager, child_module, updated_hierarchy_name, 
-                                                           &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][inst])); 
+      rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation, module_manager, child_module, module_path, 
+                                                           &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][inst]),
+                                                           compact_unused_resources); 
+      module_path.pop_instance();
     }
   }
 }
@@ -123,12 +196,67 @@ void disable_pb_graph_node_unused_pin(std::fstream& fp,
   fp << std::endl;
 }
 
+/********************************************************************
+ * Disable the unused pins of a port of a pb_graph_node (parent_module)
+ * Unused pins with consecutive indices are merged into a bus range,
+ * so that one SDC command can disable them all
+ *******************************************************************/
+static
+void disable_pb_graph_node_unused_port_pin_ranges(std::fstream& fp, 
+                                                  const ModuleManager& module_manager,
+                                                  const ModuleId& parent_module,
+                                                  const std::string& hierarchy_name,
+                                                  t_pb_graph_pin* pb_graph_pins,
+                                                  const int& num_pins,
+                                                  const PhysicalPb& physical_pb,
+                                                  const PhysicalPbId& pb_id) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  if (0 == num_pins) {
+    return;
+  }
+    
+  /* Find the module port by name */
+  std::string module_port_name = generate_pb_type_port_name(pb_graph_pins[0].port);
+  ModulePortId module_port = module_manager.find_module_port(parent_module, module_port_name);
+  VTR_ASSERT(true == module_manager.valid_module_port_id(parent_module, module_port));
+  BasicPort port_to_disable = module_manager.module_port(parent_module, module_port);
+
+  int range_start = -1;
+  for (int ipin = 0; ipin <= num_pins; ++ipin) {
+    /* Identify if the pb_graph_pin has been used or not, a virtual used pin ends the last range */
+    bool unused_pin = (ipin < num_pins)
+                   && (AtomNetId::INVALID() == physical_pb.pb_graph_pin_atom_net(pb_id, &(pb_graph_pins[ipin])));
+    if ( (true == unused_pin)
+      && ( (-1 == range_start) || (pb_graph_pins[ipin].pin_number == pb_graph_pins[ipin - 1].pin_number + 1) ) ) {
+      if (-1 == range_start) {
+        range_start = ipin;
+      }
+      continue;
+    }
+
+    /* Reach here, the current range has ended. Disable timing analysis for the pins */
+    if (-1 != range_start) {
+      port_to_disable.set_width(pb_graph_pins[range_start].pin_number, pb_graph_pins[ipin - 1].pin_number);
+      fp << "set_disable_timing ";
+      fp << hierarchy_name; 
+      fp << generate_sdc_port(port_to_disable);
+      fp << std::endl;
+    }
+    range_start = (true == unused_pin) ? ipin : -1;
+  }
+}
+
 /********************************************************************
  * Disable unused input ports and output ports of this pb_graph_node (parent_module) 
  * This function will iterate over all the input pins, output pins
  * of the physical_pb_graph_node, and check if they are mapped
  * For unused pins, we will find the port in parent_module
  * and then print SDC commands to disable them
+ *
+ * When compact SDC is required, the unused pins are disabled
+ * by bus ranges rather than one by one, and comments are skipped
  *******************************************************************/
 static
 void disable_pb_graph_node_unused_pins(std::fstream& fp, 
@@ -136,10 +264,36 @@ void disable_pb_graph_node_unused_pins(std::fstream& fp,
                                        const ModuleId& parent_module,
                                        const std::string& hierarchy_name,
                                        t_pb_graph_node* physical_pb_graph_node,
-                                       const PhysicalPb& physical_pb) {
+                                       const PhysicalPb& physical_pb,
+                                       const bool& compact_unused_resources) {
   const PhysicalPbId& pb_id = physical_pb.find_pb(physical_pb_graph_node);
   VTR_ASSERT(true == physical_pb.valid_pb_id(pb_id));
 
+  if (true == compact_unused_resources) {
+    for (int iport = 0; iport < physical_pb_graph_node->num_input_ports; ++iport) {
+      disable_pb_graph_node_unused_port_pin_ranges(fp, module_manager, parent_module,
+                                                   hierarchy_name,
+                                                   physical_pb_graph_node->input_pins[iport],
+                                                   physical_pb_graph_node->num_input_pins[iport],
+                                                   physical_pb, pb_id);
+    }
+    for (int iport = 0; iport < physical_pb_graph_node->num_output_ports; ++iport) {
+      disable_pb_graph_node_unused_port_pin_ranges(fp, module_manager, parent_module,
+                                                   hierarchy_name,
+                                                   physical_pb_graph_node->output_pins[iport],
+                                                   physical_pb_graph_node->num_output_pins[iport],
+                                                   physical_pb, pb_id);
+    }
+    for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports; ++iport) {
+      disable_pb_graph_node_unused_port_pin_ranges(fp, module_manager, parent_module,
+                                                   hierarchy_name,
+                                                   physical_pb_graph_node->clock_pins[iport],
+                                                   physical_pb_graph_node->num_clock_pins[iport],
+                                                   physical_pb, pb_id);
+    }
+    return;
+  }
+
   fp << "#######################################" << std::endl; 
   fp << "# Disable unused pins for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
   fp << "#######################################" << std::endl; 
@@ -187,11 +341,14 @@ void disable_pb_graph_node_unused_mux_inputs(std::fstream& fp,
                                              const ModuleId& parent_module,
                                              const std::string& hierarchy_name,
                                              t_pb_graph_node* physical_pb_graph_node,
-                                             const PhysicalPb& physical_pb) {
+                                             const PhysicalPb& physical_pb,
+                                             const bool& compact_unused_resources) {
 
-  fp << "#######################################" << std::endl; 
-  fp << "# Disable unused mux_inputs for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
-  fp << "#######################################" << std::endl; 
+  if (false == compact_unused_resources) {
+    fp << "#######################################" << std::endl; 
+    fp << "# Disable unused mux_inputs for pb_graph_node " << physical_pb_graph_node->pb_type->name << "[" << physical_pb_graph_node->placement_index << "]" << std::endl;
+    fp << "#######################################" << std::endl; 
+  }
 
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
@@ -395,14 +552,16 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
                                                                    const VprDeviceAnnotation& device_annotation,
                                                                    const ModuleManager& module_manager,
                                                                    const ModuleId& parent_module,
-                                                                   const std::string& hierarchy_name,
+                                                                   SdcModulePath& module_path,
                                                                    t_pb_graph_node* physical_pb_graph_node,
-                                                                   const PhysicalPb& physical_pb) {
+                                                                   const PhysicalPb& physical_pb,
+                                                                   const bool& compact_unused_resources) {
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
   /* Disable unused input ports and output ports of this pb_graph_node (parent_module) */
   disable_pb_graph_node_unused_pins(fp, module_manager, parent_module,
-                                    hierarchy_name, physical_pb_graph_node, physical_pb); 
+                                    module_path.path(), physical_pb_graph_node, physical_pb,
+                                    compact_unused_resources); 
 
   /* Return if this is the primitive pb_type 
    * Note: this must return before we disable any unused inputs of routing multiplexer!
@@ -415,8 +574,8 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
   /* Disable unused inputs of routing multiplexers of this pb_graph_node */
   disable_pb_graph_node_unused_mux_inputs(fp, device_annotation,
                                           module_manager, parent_module, 
-                                          hierarchy_name, physical_pb_graph_node,
-                                          physical_pb);
+                                          module_path.path(), physical_pb_graph_node,
+                                          physical_pb, compact_unused_resources);
 
 
   t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
@@ -435,12 +594,13 @@ void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(std::fstream&
       /* Must have a valid instance name!!! */
       VTR_ASSERT(false == child_instance_name.empty()); 
 
-      std::string updated_hierarchy_name = hierarchy_name + child_instance_name + std::string("/");
+      module_path.push_instance(child_instance_name);
 
       rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, device_annotation,
-                                                                    module_manager, child_module, updated_hierarchy_name, 
+                                                                    module_manager, child_module, module_path, 
                                                                     &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ichild][inst]), 
-                                                                    physical_pb); 
+                                                                    physical_pb, compact_unused_resources); 
+      module_path.pop_instance();
     }
   }
 }
@@ -469,9 +629,11 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
                                                           const VprDeviceAnnotation& device_annotation,
                                                           const ModuleManager& module_manager,
                                                           const std::string& grid_instance_name,
+                                                          const std::string& core_instance_name,
                                                           const size_t& grid_z,
                                                           const PhysicalPb& physical_pb,
-                                                          const bool& unused_block) {
+                                                          const bool& unused_block,
+                                                          const bool& compact_unused_resources) {
   /* If the block is partially unused, we should have a physical pb */
   if (false == unused_block) {
     VTR_ASSERT(false == physical_pb.empty());
@@ -492,29 +654,35 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
   VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
 
   /* Print comments */
-  fp << "#######################################" << std::endl; 
- 
-  if (true == unused_block) {
-    fp << "# Disable Timing for unused grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
-  } else {
-    VTR_ASSERT_SAFE(false == unused_block);
-    fp << "# Disable Timing for unused resources in grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
-  }
+  if (false == compact_unused_resources) {
+    fp << "#######################################" << std::endl; 
+   
+    if (true == unused_block) {
+      fp << "# Disable Timing for unused grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
+    } else {
+      VTR_ASSERT_SAFE(false == unused_block);
+      fp << "# Disable Timing for unused resources in grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "][" << grid_z << "]" << std::endl;
+    }
 
-  fp << "#######################################" << std::endl; 
+    fp << "#######################################" << std::endl; 
+  }
 
-  std::string hierarchy_name = grid_instance_name + std::string("/") + pb_instance_name + std::string("/");
+  SdcModulePath module_path(grid_instance_name);
+  if (false == core_instance_name.empty()) {
+    module_path.push_instance(core_instance_name);
+  }
+  module_path.push_instance(pb_instance_name);
 
   /* Go recursively through the pb_graph hierarchy, and disable all the ports level by level */
   if (true == unused_block) {
     rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation,
-                                                         module_manager, pb_module, hierarchy_name,
-                                                         pb_graph_head); 
+                                                         module_manager, pb_module, module_path,
+                                                         pb_graph_head, compact_unused_resources); 
   } else { 
     VTR_ASSERT_SAFE(false == unused_block);
     rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(fp, device_annotation,
-                                                                  module_manager, pb_module, hierarchy_name,
-                                                                  pb_graph_head, physical_pb); 
+                                                                  module_manager, pb_module, module_path,
+                                                                  pb_graph_head, physical_pb, compact_unused_resources); 
   }
 }
 
@@ -522,16 +690,21 @@ void print_analysis_sdc_disable_pb_block_unused_resources(std::fstream& fp,
  * Disable the timing for a fully unused grid!
  * This is very straightforward!
  * Just walk through each pb_type and disable all the ports using wildcards
+ *
+ * When compact SDC is required and all the blocks of the grid are unused,
+ * the blocks are disabled at once with a wildcard on their instance names
  *******************************************************************/
 static 
 void print_analysis_sdc_disable_unused_grid(std::fstream& fp, 
                                             const vtr::Point<size_t>& grid_coordinate,
                                             const DeviceGrid& grids, 
+                                            const t_device_grid_summary& grid_summary,
                                             const VprDeviceAnnotation& device_annotation,
                                             const VprClusteringAnnotation& cluster_annotation,
                                             const VprPlacementAnnotation& place_annotation,
                                             const ModuleManager& module_manager,
-                                            const e_side& border_side) {
+                                            const e_side& border_side,
+                                            const bool& compact_unused_resources) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -540,28 +713,65 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
    * 1. EMPTY type, which is by nature unused
    * 2. Offset > 0, which has already been processed when offset = 0
    */
-  if ( (true == is_empty_type(grid_type))
-    || (0 < grids[grid_coordinate.x()][grid_coordinate.y()].width_offset)
-    || (0 < grids[grid_coordinate.x()][grid_coordinate.y()].height_offset) ) {
+  if (false == grid_summary.roots[grid_coordinate.x()][grid_coordinate.y()]) {
     return;
   }
+  bool io_type = grid_summary.io_types[grid_coordinate.x()][grid_coordinate.y()];
 
   /* Find an unique name to the grid instane
    * Note: this must be consistent with the instance name we used in build_top_module()!!!
    */
   /* TODO: validate that the instance name is used in module manager!!! */
   std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
-  std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side);
-  std::string grid_instance_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), is_io_type(grid_type), border_side, grid_coordinate);
+  std::string grid_module_name = generate_grid_block_module_name(grid_module_name_prefix, std::string(grid_type->name), io_type, border_side);
+  std::string grid_instance_name = generate_grid_block_instance_name(grid_module_name_prefix, std::string(grid_type->name), io_type, border_side, grid_coordinate);
 
   ModuleId grid_module = module_manager.find_module(grid_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
 
+  /* When the pins of grids are duplicated, the physical blocks are in the core module of the grid */
+  std::string core_instance_name;
+  ModuleId core_module = module_manager.find_module(generate_grid_core_module_name(grid_module_name_prefix, std::string(grid_type->name)));
+  if (true == module_manager.valid_module_id(core_module)) {
+    core_instance_name = generate_grid_core_instance_name(grid_module_name_prefix, std::string(grid_type->name));
+    grid_module = core_module;
+  }
+
   /* Print comments */
   fp << "#######################################" << std::endl; 
   fp << "# Disable Timing for grid[" << grid_coordinate.x() << "][" << grid_coordinate.y() << "]" << std::endl;
   fp << "#######################################" << std::endl; 
 
+  if (true == compact_unused_resources) {
+    bool unused_grid = true;
+    for (const ClusterBlockId& blk_id : place_annotation.grid_blocks(grid_coordinate)) {
+      if (ClusterBlockId::INVALID() != blk_id) { 
+        unused_grid = false;
+        break;
+      }
+    }
+
+    VTR_ASSERT(1 == grid_type->equivalent_sites.size());
+    t_pb_graph_node* pb_graph_head = grid_type->equivalent_sites[0]->pb_graph_head; 
+    VTR_ASSERT(nullptr != pb_graph_head);
+    ModuleId pb_module = module_manager.find_module(generate_physical_block_module_name(pb_graph_head->pb_type));
+    VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+    std::string pb_instance_wildcard = find_analysis_sdc_child_instance_wildcard(module_manager, grid_module, pb_module);
+
+    if ( (true == unused_grid)
+      && (false == pb_instance_wildcard.empty()) ) {
+      SdcModulePath module_path(grid_instance_name);
+      if (false == core_instance_name.empty()) {
+        module_path.push_instance(core_instance_name);
+      }
+      module_path.push_instance(pb_instance_wildcard);
+      rec_print_analysis_sdc_disable_unused_pb_graph_nodes(fp, device_annotation,
+                                                           module_manager, pb_module, module_path,
+                                                           pb_graph_head, compact_unused_resources); 
+      return;
+    }
+  }
+
   /* For used grid, find the unused rr_node in the local rr_graph 
    * and then disable each port which is not used
    * as well as the unused inputs of routing multiplexers!
@@ -572,15 +782,15 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
       const PhysicalPb& physical_pb = cluster_annotation.physical_pb(blk_id);
       print_analysis_sdc_disable_pb_block_unused_resources(fp, grid_type, grid_coordinate,
                                                            device_annotation,
-                                                           module_manager, grid_instance_name, grid_z,
-                                                           physical_pb, false);
+                                                           module_manager, grid_instance_name, core_instance_name, grid_z,
+                                                           physical_pb, false, compact_unused_resources);
     } else {
       VTR_ASSERT(ClusterBlockId::INVALID() == blk_id);
       /* For unused grid, disable all the pins in the physical_pb_type */
       print_analysis_sdc_disable_pb_block_unused_resources(fp, grid_type, grid_coordinate,
                                                            device_annotation, 
-                                                           module_manager, grid_instance_name, grid_z,
-                                                           PhysicalPb(), true);
+                                                           module_manager, grid_instance_name, core_instance_name, grid_z,
+                                                           PhysicalPb(), true, compact_unused_resources);
     }
     grid_z++;
   }
@@ -607,20 +817,27 @@ void print_analysis_sdc_disable_unused_grid(std::fstream& fp,
  * During timing analysis, the path from inputA to output should be considered
  * while the path from inputB to output should NOT be considered!!!
  *
+ * When compact SDC is required, the unused pins are disabled by bus ranges
+ * and the unused instances are disabled by wildcards,
+ * which reduces the size of SDC files by far
  *******************************************************************/
 void print_analysis_sdc_disable_unused_grids(std::fstream& fp, 
                                              const DeviceGrid& grids, 
                                              const VprDeviceAnnotation& device_annotation,
                                              const VprClusteringAnnotation& cluster_annotation,
                                              const VprPlacementAnnotation& place_annotation,
-                                             const ModuleManager& module_manager) {
+                                             const ModuleManager& module_manager,
+                                             const bool& compact_unused_resources) {
+
+  t_device_grid_summary grid_summary = build_device_grid_summary(grids);
 
   /* Process unused core grids */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       print_analysis_sdc_disable_unused_grid(fp, vtr::Point<size_t>(ix, iy),
-                                             grids, device_annotation, cluster_annotation, place_annotation,
-                                             module_manager, NUM_SIDES);
+                                             grids, grid_summary, device_annotation, cluster_annotation, place_annotation,
+                                             module_manager, NUM_SIDES,
+                                             compact_unused_resources);
     }
   }
 
@@ -632,8 +849,9 @@ void print_analysis_sdc_disable_unused_grids(std::fstream& fp,
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       print_analysis_sdc_disable_unused_grid(fp, io_coordinate,
-                                             grids, device_annotation, cluster_annotation, place_annotation,
-                                             module_manager, io_side);
+                                             grids, grid_summary, device_annotation, cluster_annotation, place_annotation,
+                                             module_manager, io_side,
+                                             compact_unused_resources);
     }
   }
 }
@@ -14,6 +14,7 @@ AnalysisSdcOption::AnalysisSdcOption(const std::string& sdc_dir) {
   flatten_names_ = false;
   time_unit_ = 1.;
   generate_sdc_analysis_ = false;
+  compact_unused_resources_ = false;
 }
 
 /********************************************************************
@@ -35,6 +36,10 @@ bool AnalysisSdcOption::generate_sdc_analysis() const {
   return generate_sdc_analysis_;
 }
 
+bool AnalysisSdcOption::compact_unused_resources() const {
+  return compact_unused_resources_;
+}
+
 /********************************************************************
  * Public mutators
  ********************************************************************/
@@ -54,4 +59,8 @@ void AnalysisSdcOption::set_generate_sdc_analysis(const bool& generate_sdc_analy
   generate_sdc_analysis_ = generate_sdc_analysis;
 }
 
+void AnalysisSdcOption::set_compact_unused_resources(const bool& compact_unused_resources) {
+  compact_unused_resources_ = compact_unused_resources;
+}
+
 } /* end namespace openfpga */
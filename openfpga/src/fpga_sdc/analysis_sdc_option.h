@@ -19,16 +19,20 @@ class AnalysisSdcOption {
     bool flatten_names() const;
     float time_unit() const;
     bool generate_sdc_analysis() const;
+    bool compact_unused_resources() const;
   public: /* Public mutators */
     void set_sdc_dir(const std::string& sdc_dir);
     void set_flatten_names(const bool& flatten_names);
     void set_time_unit(const float& time_unit);
     void set_generate_sdc_analysis(const bool& generate_sdc_analysis);
+    void set_compact_unused_resources(const bool& compact_unused_resources);
   private: /* Internal data */
     std::string sdc_dir_;
     bool generate_sdc_analysis_; 
     bool flatten_names_; 
     float time_unit_;
+    /* Merge the constraints on unused resources to bus ranges and wildcards */
+    bool compact_unused_resources_;
 };
 
 } /* end namespace openfpga */
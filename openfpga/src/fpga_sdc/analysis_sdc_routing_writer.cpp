@@ -123,7 +123,7 @@ void print_analysis_sdc_disable_cb_unused_resources(std::fstream& fp,
   std::map<std::string, AtomNetId> mux_instance_to_net_map;
 
   /* Disable all the output port (grid input pins), which are not used by benchmark */
-  std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
+  const std::vector<enum e_side>& cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
 
   for (size_t side = 0; side < cb_sides.size(); ++side) {
     enum e_side cb_ipin_side = cb_sides[side];
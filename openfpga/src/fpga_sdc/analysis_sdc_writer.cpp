@@ -291,7 +291,8 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
                                           openfpga_ctx.vpr_device_annotation(),
                                           openfpga_ctx.vpr_clustering_annotation(),
                                           openfpga_ctx.vpr_placement_annotation(),
-                                          openfpga_ctx.module_graph());
+                                          openfpga_ctx.module_graph(),
+                                          option.compact_unused_resources());
 
   /* Close file handler */
   fp.close();
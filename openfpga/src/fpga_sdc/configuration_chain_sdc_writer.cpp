@@ -9,6 +9,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -23,11 +24,222 @@
 #include "openfpga_naming.h"
 
 #include "sdc_writer_utils.h"
+#include "sdc_module_path.h"
 #include "configuration_chain_sdc_writer.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The first and the last Configuration Chain Flip-flop (CCFF) in the
+ * configurable subtree of a module, with their paths relative to the module
+ * The path of a module which is a CCFF itself is empty
+ *******************************************************************/
+struct ConfigurableChainEnds {
+  ModuleId head_module;
+  std::string head_path;
+  ModuleId tail_module;
+  std::string tail_path;
+};
+
+/********************************************************************
+ * Find the instance name of a configurable child of a module
+ *******************************************************************/
+static 
+std::string find_configurable_child_instance_name(const ModuleManager& module_manager, 
+                                                  const ModuleId& parent_module,
+                                                  const size_t& child_index) {
+  ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
+  size_t child_instance_id = module_manager.configurable_child_instances(parent_module)[child_index];
+  std::string child_instance_name = module_manager.instance_name(parent_module, child_module_id, child_instance_id);
+  if (true == child_instance_name.empty()) {
+    child_instance_name = generate_instance_name(module_manager.module_name(child_module_id), child_instance_id);
+  }
+  return child_instance_name;
+}
+
+/********************************************************************
+ * Print the SDC commands to constrain the link from the first output
+ * of a CCFF to the inputs of the next CCFF in the chain
+ * Only the first output port is considered,
+ * being consistent with build_memory_module.cpp:395
+ *******************************************************************/
+static 
+void print_pnr_sdc_constrain_configurable_chain_link(std::fstream& fp, 
+                                                     const float& tmax,
+                                                     const float& tmin,
+                                                     const ModuleManager& module_manager, 
+                                                     const ModuleId& src_module,
+                                                     const std::string& src_path,
+                                                     const ModuleId& des_module,
+                                                     const std::string& des_path) {
+  std::vector<BasicPort> output_ports = module_manager.module_ports_by_type(src_module, ModuleManager::MODULE_OUTPUT_PORT);
+  if (true == output_ports.empty()) {
+    return;
+  }
+
+  for (const BasicPort& input_port : module_manager.module_ports_by_type(des_module, ModuleManager::MODULE_INPUT_PORT)) {
+    print_pnr_sdc_constrain_max_delay(fp, 
+                                      src_path, 
+                                      output_ports[0].get_name(),
+                                      des_path, 
+                                      input_port.get_name(),
+                                      tmax);
+
+    print_pnr_sdc_constrain_min_delay(fp, 
+                                      src_path, 
+                                      output_ports[0].get_name(),
+                                      des_path, 
+                                      input_port.get_name(),
+                                      tmin);
+  }
+}
+
+/********************************************************************
+ * Find the ends of the configuration chain in each module,
+ * visiting each unique module only once
+ *******************************************************************/
+static 
+const ConfigurableChainEnds& find_configurable_chain_ends(const ModuleManager& module_manager, 
+                                                          const ModuleId& module,
+                                                          vtr::vector<ModuleId, ConfigurableChainEnds>& chain_ends) {
+  if (ModuleId::INVALID() != chain_ends[module].head_module) {
+    return chain_ends[module];
+  }
+
+  const std::vector<ModuleId>& children = module_manager.configurable_children(module);
+  if (true == children.empty()) {
+    chain_ends[module].head_module = module;
+    chain_ends[module].tail_module = module;
+    return chain_ends[module];
+  }
+
+  const ConfigurableChainEnds& head_child_ends = find_configurable_chain_ends(module_manager, children.front(), chain_ends);
+  const ConfigurableChainEnds& tail_child_ends = find_configurable_chain_ends(module_manager, children.back(), chain_ends);
+
+  ConfigurableChainEnds& ends = chain_ends[module];
+  ends.head_module = head_child_ends.head_module;
+  ends.head_path = find_configurable_child_instance_name(module_manager, module, 0) + std::string("/") + head_child_ends.head_path;
+  ends.tail_module = tail_child_ends.tail_module;
+  ends.tail_path = find_configurable_child_instance_name(module_manager, module, children.size() - 1) + std::string("/") + tail_child_ends.tail_path;
+  return ends;
+}
+
+/********************************************************************
+ * Collect the hierarchical paths of the instances of each module
+ * in the configurable subtree of a module, 
+ * as well as the modules in the order of their first visit
+ *******************************************************************/
+static 
+void rec_find_configurable_chain_instances(const ModuleManager& module_manager, 
+                                           const ModuleId& parent_module,
+                                           SdcModulePath& module_path,
+                                           vtr::vector<ModuleId, std::vector<std::string>>& instance_paths,
+                                           std::vector<ModuleId>& modules) {
+  for (size_t child_index = 0; child_index < module_manager.configurable_children(parent_module).size(); ++child_index) {
+    ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
+    /* CCFFs have no links inside */
+    if (true == module_manager.configurable_children(child_module_id).empty()) {
+      continue;
+    }
+
+    module_path.push_instance(find_configurable_child_instance_name(module_manager, parent_module, child_index));
+    if (true == instance_paths[child_module_id].empty()) {
+      modules.push_back(child_module_id);
+    }
+    /* Remove the trailing '/' of the path */
+    instance_paths[child_module_id].push_back(module_path.path().substr(0, module_path.path().size() - 1));
+
+    rec_find_configurable_chain_instances(module_manager, child_module_id, module_path, instance_paths, modules);
+    module_path.pop_instance();
+  }
+}
+
+/********************************************************************
+ * Print the SDC commands to constrain the links between the configurable
+ * children of a module, i.e., from the last CCFF of a child to the first
+ * CCFF of the next child. The paths are relative to the module.
+ * The links inside the children are constrained by their own modules
+ *******************************************************************/
+static 
+void print_pnr_sdc_constrain_module_configurable_chain(std::fstream& fp, 
+                                                       const float& tmax,
+                                                       const float& tmin,
+                                                       const ModuleManager& module_manager, 
+                                                       const ModuleId& module,
+                                                       const std::string& module_path,
+                                                       vtr::vector<ModuleId, ConfigurableChainEnds>& chain_ends) {
+  const std::vector<ModuleId>& children = module_manager.configurable_children(module);
+  for (size_t child_index = 1; child_index < children.size(); ++child_index) {
+    const ConfigurableChainEnds& src_ends = find_configurable_chain_ends(module_manager, children[child_index - 1], chain_ends);
+    const ConfigurableChainEnds& des_ends = find_configurable_chain_ends(module_manager, children[child_index], chain_ends);
+    print_pnr_sdc_constrain_configurable_chain_link(fp, tmax, tmin, module_manager,
+                                                    src_ends.tail_module,
+                                                    module_path + find_configurable_child_instance_name(module_manager, module, child_index - 1) + std::string("/") + src_ends.tail_path,
+                                                    des_ends.head_module,
+                                                    module_path + find_configurable_child_instance_name(module_manager, module, child_index) + std::string("/") + des_ends.head_path);
+  }
+}
+
+/********************************************************************
+ * Print SDC commands to constrain the configuration chain
+ * in a hierarchical way:
+ * the links inside each unique module are printed only once,
+ * and are applied to all the instances of the module by scoping
+ * them with 'current_instance', e.g.,
+ *
+ *   foreach instance {
+ *     fpga_top/grid_clb_1__1_
+ *     fpga_top/grid_clb_1__2_
+ *   } {
+ *     current_instance $instance
+ *     set_max_delay -from logical_tile_clb_mode_clb__0/.../ccff_tail ...
+ *   }
+ *   current_instance
+ *
+ * Only the links between the children of the top-level module
+ * are printed with full hierarchical paths
+ *******************************************************************/
+static 
+void print_pnr_sdc_constrain_hierarchical_configurable_chain(std::fstream& fp, 
+                                                             const float& tmax,
+                                                             const float& tmin,
+                                                             const ModuleManager& module_manager, 
+                                                             const ModuleId& top_module) {
+  vtr::vector<ModuleId, ConfigurableChainEnds> chain_ends(module_manager.num_modules(), ConfigurableChainEnds{ModuleId::INVALID(), std::string(), ModuleId::INVALID(), std::string()});
+
+  vtr::vector<ModuleId, std::vector<std::string>> instance_paths(module_manager.num_modules());
+  std::vector<ModuleId> modules;
+  SdcModulePath module_path(module_manager.module_name(top_module));
+  rec_find_configurable_chain_instances(module_manager, top_module, module_path, instance_paths, modules);
+
+  for (const ModuleId& module : modules) {
+    /* Modules with a single configurable child have no link of their own */
+    if (2 > module_manager.configurable_children(module).size()) {
+      continue;
+    }
+
+    fp << "##################################################" << std::endl;
+    fp << "# Configurable chain inside module " << module_manager.module_name(module) << std::endl;
+    fp << "##################################################" << std::endl;
+    fp << "foreach instance {" << std::endl;
+    for (const std::string& instance_path : instance_paths[module]) {
+      fp << "  " << instance_path << std::endl;
+    }
+    fp << "} {" << std::endl;
+    fp << "current_instance $instance" << std::endl;
+    print_pnr_sdc_constrain_module_configurable_chain(fp, tmax, tmin, module_manager, module, std::string(), chain_ends);
+    fp << "}" << std::endl;
+    fp << "current_instance" << std::endl;
+    fp << std::endl;
+  }
+
+  fp << "##################################################" << std::endl;
+  fp << "# Configurable chain inside module " << module_manager.module_name(top_module) << std::endl;
+  fp << "##################################################" << std::endl;
+  print_pnr_sdc_constrain_module_configurable_chain(fp, tmax, tmin, module_manager, top_module, module_path.path(), chain_ends);
+}
+
 /********************************************************************
  * Print SDC commands to constrain the timing between outputs and inputs
  * of all the configurable memory modules
@@ -43,6 +255,8 @@ namespace openfpga {
  * It will iterate over all the configurable children under each module
  * and print a SDC command
  *
+ * The path of the parent module is updated in place when going
+ * down to a child, and restored when coming back
  *******************************************************************/
 static 
 void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp, 
@@ -50,33 +264,24 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
                                                     const float& tmin,
                                                     const ModuleManager& module_manager, 
                                                     const ModuleId& parent_module,
-                                                    const std::string& parent_module_path,
+                                                    SdcModulePath& module_path,
                                                     std::string& previous_module_path,
                                                     ModuleId& previous_module) {
 
   /* For each configurable child, we will go one level down in priority */
   for (size_t child_index = 0; child_index < module_manager.configurable_children(parent_module).size(); ++child_index) {
-    std::string child_module_path = parent_module_path;
     ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
-    size_t child_instance_id = module_manager.configurable_child_instances(parent_module)[child_index];
-    std::string child_instance_name;
-    if (true == module_manager.instance_name(parent_module, child_module_id, child_instance_id).empty()) {
-      child_instance_name = generate_instance_name(module_manager.module_name(child_module_id), child_instance_id);
-    } else {
-      child_instance_name = module_manager.instance_name(parent_module, child_module_id, child_instance_id);
-    }
 
-    child_module_path += child_instance_name;
-    
-    child_module_path = format_dir_path(child_module_path);
+    module_path.push_instance(find_configurable_child_instance_name(module_manager, parent_module, child_index));
 
     rec_print_pnr_sdc_constrain_configurable_chain(fp,
                                                    tmax, tmin,
                                                    module_manager, 
                                                    child_module_id, 
-                                                   child_module_path,
+                                                   module_path,
                                                    previous_module_path,
                                                    previous_module);
+    module_path.pop_instance();
   }
 
   /* If there is no configurable children any more, this is a leaf module, print a SDC command for disable timing */
@@ -87,39 +292,15 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
   /* Validate file stream */
   valid_file_stream(fp);
 
-  /* Disable timing for each output port of this module */
+  /* Constrain the link from the previous CCFF to this one */
   if (!previous_module_path.empty()) {
-    bool first_port = true;
-    for (const BasicPort& output_port : module_manager.module_ports_by_type(previous_module, ModuleManager::MODULE_OUTPUT_PORT)) {
-      /* Only the first output port will be considered,
-       * being consistent with build_memory_module.cpp:395
-       */
-      if (false == first_port) {
-        continue;
-      }
-
-      for (const BasicPort& input_port : module_manager.module_ports_by_type(parent_module, ModuleManager::MODULE_INPUT_PORT)) {
-        print_pnr_sdc_constrain_max_delay(fp, 
-                                          previous_module_path, 
-                                          output_port.get_name(),
-                                          parent_module_path, 
-                                          input_port.get_name(),
-                                          tmax);
-
-        print_pnr_sdc_constrain_min_delay(fp, 
-                                          previous_module_path, 
-                                          output_port.get_name(),
-                                          parent_module_path, 
-                                          input_port.get_name(),
-                                          tmin);
-      }
-      
-      first_port = false;
-    }
+    print_pnr_sdc_constrain_configurable_chain_link(fp, tmax, tmin, module_manager,
+                                                    previous_module, previous_module_path,
+                                                    parent_module, module_path.path());
   }
 
-  /* Update previous module */
-  previous_module_path = parent_module_path;
+  /* Update previous module, where the assignment reuses the buffer of the previous path */
+  previous_module_path = module_path.path();
   previous_module = parent_module;
 }
 
@@ -128,11 +309,15 @@ void rec_print_pnr_sdc_constrain_configurable_chain(std::fstream& fp,
  * Break combinational loops in FPGA fabric, which mainly come from
  * configurable memory cells. 
  * To handle this, we disable the outputs of memory cells
+ * When flatten is enabled, each link of the chain is printed
+ * with full hierarchical paths, otherwise the links inside each 
+ * unique module are printed once and scoped to its instances
  *******************************************************************/
 void print_pnr_sdc_constrain_configurable_chain(const std::string& sdc_fname,
                                                 const float& time_unit,
                                                 const float& max_delay,
                                                 const float& min_delay,
+                                                const bool& flatten,
                                                 const ModuleManager& module_manager) {
 
   /* Create the directory */
@@ -158,13 +343,22 @@ void print_pnr_sdc_constrain_configurable_chain(const std::string& sdc_fname,
   ModuleId top_module = module_manager.find_module(top_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(top_module));
 
+  if (false == flatten) {
+    print_pnr_sdc_constrain_hierarchical_configurable_chain(fp,
+                                                            max_delay, min_delay, 
+                                                            module_manager, top_module);
+    fp.close();
+    return;
+  }
+
   /* Go recursively in the module manager, starting from the top-level module: instance id of the top-level module is 0 by default */
   std::string previous_module_path;
   ModuleId previous_module = ModuleId::INVALID();
+  SdcModulePath module_path(module_manager.module_name(top_module));
   rec_print_pnr_sdc_constrain_configurable_chain(fp,
                                                  max_delay, min_delay, 
                                                  module_manager, top_module, 
-                                                 format_dir_path(module_manager.module_name(top_module)),
+                                                 module_path,
                                                  previous_module_path,
                                                  previous_module);
 
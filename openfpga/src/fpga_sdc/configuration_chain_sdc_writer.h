@@ -19,6 +19,7 @@ void print_pnr_sdc_constrain_configurable_chain(const std::string& sdc_fname,
                                                 const float& time_unit,
                                                 const float& max_delay,
                                                 const float& min_delay,
+                                                const bool& flatten,
                                                 const ModuleManager& module_manager);
 
 } /* end namespace openfpga */
@@ -20,6 +20,7 @@
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_interconnect_types.h"
 #include "vpr_utils.h"
@@ -539,23 +540,30 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                          const VprDeviceAnnotation& device_annotation,
                                          const ModuleManager& module_manager,
                                          const ModuleId& top_module,
-                                         const bool& constrain_zero_delay_paths) {
+                                         const bool& constrain_zero_delay_paths,
+                                         const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constraining grid timing for P&R flow");
 
   std::string root_path = format_dir_path(module_manager.module_name(top_module));
 
-  for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+  /* The SDC files of different physical tiles are independent from each other.
+   * Note that the I/O modules on different sides of a tile share the same pb_types,
+   * so they are kept in the same thread
+   */
+  parallel_for(device_ctx.physical_tile_types.size(), num_threads,
+               [&](const size_t& itile) {
+    const t_physical_tile_type& physical_tile = device_ctx.physical_tile_types[itile];
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
-      continue;
+      return;
     }
 
     VTR_ASSERT(1 == physical_tile.equivalent_sites.size());
     t_pb_graph_node* pb_graph_head = physical_tile.equivalent_sites[0]->pb_graph_head;
     if (nullptr == pb_graph_head) {
-      continue;
+      return;
     }
 
     if (true == is_io_type(&physical_tile)) {
@@ -613,7 +621,7 @@ void print_pnr_sdc_constrain_grid_timing(const std::string& sdc_dir,
                                                   pb_graph_head,
                                                   constrain_zero_delay_paths);
     }
-  }
+  });
 }
 
 } /* end namespace openfpga */
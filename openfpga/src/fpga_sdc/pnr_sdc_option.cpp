@@ -23,6 +23,7 @@ PnrSdcOption::PnrSdcOption(const std::string& sdc_dir) {
   constrain_routing_multiplexer_outputs_ = false;
   constrain_switch_block_outputs_ = false;
   constrain_zero_delay_paths_ = false;
+  num_threads_ = 1;
 }
 
 /********************************************************************
@@ -94,6 +95,10 @@ bool PnrSdcOption::constrain_zero_delay_paths() const {
   return constrain_zero_delay_paths_;
 }
 
+size_t PnrSdcOption::num_threads() const {
+  return num_threads_;
+}
+
 /********************************************************************
  * Public mutators
  ********************************************************************/
@@ -163,4 +168,8 @@ void PnrSdcOption::set_constrain_zero_delay_paths(const bool& constrain_zero_del
   constrain_zero_delay_paths_ = constrain_zero_delay_paths;
 }
 
+void PnrSdcOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 } /* end namespace openfpga */
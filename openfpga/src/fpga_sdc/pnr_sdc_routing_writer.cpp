@@ -20,6 +20,7 @@
 #include "openfpga_port.h"
 #include "openfpga_side_manager.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 #include "mux_utils.h"
 
@@ -45,26 +46,31 @@ float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
 }
 
 /********************************************************************
- * Set timing constraints between the inputs and outputs of a routing
+ * A timing constraint between an input and an output of a routing module.
+ * The constraint does not depend on the instance path of the module,
+ * so that it can be shared by all the mirrors of a unique module
+ *******************************************************************/
+struct PnrSdcPortDelay {
+  std::string src_port;
+  std::string sink_port;
+  float delay;
+};
+
+/********************************************************************
+ * Find timing constraints between the inputs and outputs of a routing
  * multiplexer in a Switch Block
  *******************************************************************/
 static 
-void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
-                                           const float& time_unit,
-                                           const bool& hierarchical,
-                                           const std::string& module_path,
-                                           const ModuleManager& module_manager,
-                                           const ModuleId& sb_module, 
-                                           const VprDeviceAnnotation& device_annotation,
-                                           const DeviceGrid& grids,
-                                           const RRGraph& rr_graph,
-                                           const RRGSB& rr_gsb,
-                                           const e_side& output_node_side,
-                                           const RRNodeId& output_rr_node,
-                                           const bool& constrain_zero_delay_paths) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
+void find_pnr_sdc_sb_mux_port_delays(std::vector<PnrSdcPortDelay>& port_delays,
+                                     const ModuleManager& module_manager,
+                                     const ModuleId& sb_module, 
+                                     const VprDeviceAnnotation& device_annotation,
+                                     const DeviceGrid& grids,
+                                     const RRGraph& rr_graph,
+                                     const RRGSB& rr_gsb,
+                                     const e_side& output_node_side,
+                                     const RRNodeId& output_rr_node,
+                                     const bool& constrain_zero_delay_paths) {
   VTR_ASSERT(  ( CHANX == rr_graph.node_type(output_rr_node) )
             || ( CHANY == rr_graph.node_type(output_rr_node) ));
 
@@ -96,6 +102,10 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
     edge_counter++;
   }
 
+  BasicPort sink_port(module_manager.module_port(sb_module, module_output_port.first).get_name(),
+                      module_output_port.second,
+                      module_output_port.second);
+
   /* Find the starting points */
   for (const ModulePinInfo& module_input_port : module_input_ports) {
     /* If we have a zero-delay path to contrain, we will skip unless users want so */
@@ -108,35 +118,65 @@ void print_pnr_sdc_constrain_sb_mux_timing(std::fstream& fp,
                        module_input_port.second,
                        module_input_port.second);
 
-    BasicPort sink_port(module_manager.module_port(sb_module, module_output_port.first).get_name(),
-                        module_output_port.second,
-                        module_output_port.second);
+    port_delays.push_back({generate_sdc_port(src_port),
+                           generate_sdc_port(sink_port),
+                           switch_delays[module_input_port]});
+  }
+}
 
-    /* Constrain a path */
-    if (false == hierarchical) {
-      print_pnr_sdc_constrain_max_delay(fp,
-                                        module_path,
-                                        generate_sdc_port(src_port),
-                                        module_path,
-                                        generate_sdc_port(sink_port),
-                                        switch_delays[module_input_port] / time_unit);
+/********************************************************************
+ * Find timing constraints between the inputs and outputs of a SB,
+ * which are connected by routing multiplexers with the given delays
+ * specified in architectural XML file
+ *
+ * The constraints are expressed by the ports of the SB module,
+ * which are the same for all the mirrors of the SB
+ *******************************************************************/
+static 
+std::vector<PnrSdcPortDelay> find_pnr_sdc_sb_port_delays(const ModuleManager& module_manager,
+                                                         const VprDeviceAnnotation& device_annotation,
+                                                         const DeviceGrid& grids,
+                                                         const RRGraph& rr_graph,
+                                                         const RRGSB& rr_gsb,
+                                                         const bool& constrain_zero_delay_paths) {
+  std::vector<PnrSdcPortDelay> port_delays;
 
-    } else {
-      VTR_ASSERT_SAFE(true == hierarchical);
-      print_pnr_sdc_constrain_max_delay(fp,
-                                        std::string(),
-                                        generate_sdc_port(src_port),
-                                        std::string(),
-                                        generate_sdc_port(sink_port),
-                                        switch_delays[module_input_port] / time_unit);
+  vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+  std::string sb_module_name = generate_switch_block_module_name(gsb_coordinate);
+  ModuleId sb_module = module_manager.find_module(sb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
+      const RRNodeId& chan_rr_node = rr_gsb.get_chan_node(side_manager.get_side(), itrack);
+      /* We only care the output port and it should indicate a SB mux */
+      if (OUT_PORT != rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) { 
+        continue; 
+      }
+      /* Constrain thru wires */
+      if (false != rr_gsb.is_sb_node_passing_wire(rr_graph, side_manager.get_side(), itrack)) {
+        continue;
+      } 
+      /* This is a MUX, constrain all the paths from an input to an output */
+      find_pnr_sdc_sb_mux_port_delays(port_delays,
+                                      module_manager, sb_module, 
+                                      device_annotation,
+                                      grids,
+                                      rr_graph,
+                                      rr_gsb,
+                                      side_manager.get_side(),
+                                      chan_rr_node,
+                                      constrain_zero_delay_paths);
     }
   }
+
+  return port_delays;
 }
 
 /********************************************************************
- * Set timing constraints between the inputs and outputs of SBs, 
- * which are connected by routing multiplexers with the given delays
- * specified in architectural XML file
+ * Output the timing constraints of a SB to its SDC file,
+ * with the ports prefixed by the instance path of the SB
  *
  * To enable block by block timing constraining, we generate the SDC
  * file for each unique SB module
@@ -146,16 +186,13 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
                                        const float& time_unit,
                                        const bool& hierarchical,
                                        const std::string& module_path,
-                                       const ModuleManager& module_manager,
-                                       const VprDeviceAnnotation& device_annotation,
-                                       const DeviceGrid& grids,
-                                       const RRGraph& rr_graph,
                                        const RRGSB& rr_gsb,
-                                       const bool& constrain_zero_delay_paths) {
+                                       const std::vector<PnrSdcPortDelay>& port_delays) {
 
   /* Create the file name for Verilog netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-  std::string sdc_fname(sdc_dir + generate_switch_block_module_name(gsb_coordinate) + std::string(SDC_FILE_NAME_POSTFIX));
+  std::string sb_module_name = generate_switch_block_module_name(gsb_coordinate);
+  std::string sdc_fname(sdc_dir + sb_module_name + std::string(SDC_FILE_NAME_POSTFIX));
 
   /* Create the file stream */
   std::fstream fp;
@@ -164,42 +201,24 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
   /* Validate file stream */
   check_file_stream(sdc_fname.c_str(), fp);
 
-  std::string sb_module_name = generate_switch_block_module_name(gsb_coordinate);
-  ModuleId sb_module = module_manager.find_module(sb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
   /* Generate the descriptions*/
   print_sdc_file_header(fp, std::string("Constrain timing of Switch Block " + sb_module_name + " for PnR"));
 
   /* Print time unit for the SDC file */
   print_sdc_timescale(fp, time_unit_to_string(time_unit));
 
-  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
-    SideManager side_manager(side);
-    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(side_manager.get_side()); ++itrack) {
-      const RRNodeId& chan_rr_node = rr_gsb.get_chan_node(side_manager.get_side(), itrack);
-      /* We only care the output port and it should indicate a SB mux */
-      if (OUT_PORT != rr_gsb.get_chan_node_direction(side_manager.get_side(), itrack)) { 
-        continue; 
-      }
-      /* Constrain thru wires */
-      if (false != rr_gsb.is_sb_node_passing_wire(rr_graph, side_manager.get_side(), itrack)) {
-        continue;
-      } 
-      /* This is a MUX, constrain all the paths from an input to an output */
-      print_pnr_sdc_constrain_sb_mux_timing(fp,
-                                            time_unit,
-                                            hierarchical,
-                                            module_path,
-                                            module_manager, sb_module, 
-                                            device_annotation,
-                                            grids,
-                                            rr_graph,
-                                            rr_gsb,
-                                            side_manager.get_side(),
-                                            chan_rr_node,
-                                            constrain_zero_delay_paths);
-    }
+  /* Constrain each path, where hierarchical SDC has no instance path */
+  std::string instance_path;
+  if (false == hierarchical) {
+    instance_path = module_path;
+  }
+  for (const PnrSdcPortDelay& port_delay : port_delays) {
+    print_pnr_sdc_constrain_max_delay(fp,
+                                      instance_path,
+                                      port_delay.src_port,
+                                      instance_path,
+                                      port_delay.sink_port,
+                                      port_delay.delay / time_unit);
   }
 
   /* Close file handler */
@@ -209,6 +228,10 @@ void print_pnr_sdc_constrain_sb_timing(const std::string& sdc_dir,
 /********************************************************************
  * Print SDC timing constraints for Switch blocks
  * This function is designed for flatten routing hierarchy
+ *
+ * When the unique SBs have been identified, the timing constraints
+ * are found once per unique SB and shared by all its mirrors,
+ * since only the instance paths differ in their SDC files
  *******************************************************************/
 void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -219,43 +242,85 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
+  /* Find the timing constraints of each unique SB */
+  std::vector<std::vector<PnrSdcPortDelay>> unique_sb_port_delays(device_rr_gsb.get_num_sb_unique_module());
+  std::map<const RRGSB*, size_t> unique_sb_indices;
+  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+    unique_sb_indices[&device_rr_gsb.get_sb_unique_module(isb)] = isb;
+  }
+  parallel_for(device_rr_gsb.get_num_sb_unique_module(), num_threads,
+               [&](const size_t& isb) {
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
+    if (false == unique_mirror.is_sb_exist()) {
+      return;
+    }
+    unique_sb_port_delays[isb] = find_pnr_sdc_sb_port_delays(module_manager,
+                                                             device_annotation,
+                                                             grids,
+                                                             rr_graph,
+                                                             unique_mirror,
+                                                             constrain_zero_delay_paths);
+  });
+
   /* Get the range of SB array */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
-  /* Go for each SB */
+  /* Collect all the SBs, whose SDC files are independent from each other */
+  std::vector<const RRGSB*> sb_gsbs;
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       if (false == rr_gsb.is_sb_exist()) {
         continue;
       }
+      sb_gsbs.push_back(&rr_gsb);
+    }
+  }
 
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-      std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
+  /* Go for each SB */
+  parallel_for(sb_gsbs.size(), num_threads,
+               [&](const size_t& isb) {
+    const RRGSB& rr_gsb = *sb_gsbs[isb];
+
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    std::string sb_instance_name = generate_switch_block_module_name(gsb_coordinate); 
 
-      ModuleId sb_module = module_manager.find_module(sb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+    ModuleId sb_module = module_manager.find_module(sb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
 
-      std::string module_path = format_dir_path(root_path) + sb_instance_name;
+    std::string module_path = format_dir_path(root_path) + sb_instance_name;
 
+    /* Reuse the timing constraints of the unique mirror if available */
+    if (true == unique_sb_indices.empty()) {
       print_pnr_sdc_constrain_sb_timing(sdc_dir,
                                         time_unit,
                                         hierarchical,
                                         module_path,
-                                        module_manager,
-                                        device_annotation,
-                                        grids,
-                                        rr_graph,
                                         rr_gsb,
-                                        constrain_zero_delay_paths);
+                                        find_pnr_sdc_sb_port_delays(module_manager,
+                                                                    device_annotation,
+                                                                    grids,
+                                                                    rr_graph,
+                                                                    rr_gsb,
+                                                                    constrain_zero_delay_paths));
+      return;
     }
-  }
+
+    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(gsb_coordinate);
+    print_pnr_sdc_constrain_sb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      rr_gsb,
+                                      unique_sb_port_delays[unique_sb_indices.at(&unique_mirror)]);
+  });
 }
 
 /********************************************************************
@@ -271,17 +336,20 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Switch Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+  /* The SDC files of unique SBs are independent from each other */
+  parallel_for(device_rr_gsb.get_num_sb_unique_module(), num_threads,
+               [&](const size_t& isb) {
     const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
     if (false == rr_gsb.is_sb_exist()) {
-      continue;
+      return;
     }
 
     /* Find all the sb instance under this module
@@ -299,13 +367,14 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                       time_unit,
                                       hierarchical,
                                       module_path,
-                                      module_manager,
-                                      device_annotation,
-                                      grids,
-                                      rr_graph,
                                       rr_gsb,
-                                      constrain_zero_delay_paths);
-  }
+                                      find_pnr_sdc_sb_port_delays(module_manager,
+                                                                  device_annotation,
+                                                                  grids,
+                                                                  rr_graph,
+                                                                  rr_gsb,
+                                                                  constrain_zero_delay_paths));
+  });
 }
 
 /********************************************************************
@@ -510,7 +579,7 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
   }
 
   /* Contrain each multiplexers inside the connection block */
-  std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
+  const std::vector<enum e_side>& cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
 
   for (size_t side = 0; side < cb_sides.size(); ++side) {
     enum e_side cb_ipin_side = cb_sides[side];
@@ -532,7 +601,6 @@ void print_pnr_sdc_constrain_cb_timing(const std::string& sdc_dir,
   /* Close file handler */
   fp.close();
 }
-
 /********************************************************************
  * Iterate over all the connection blocks in a device
  * and print SDC file for each of them 
@@ -548,12 +616,15 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
                                                        const t_rr_type& cb_type,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   std::string root_path = module_manager.module_name(top_module);
 
+  /* Collect all the CBs, whose SDC files are independent from each other */
+  std::vector<const RRGSB*> cb_gsbs;
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
       /* Check if the connection block exists in the device!
@@ -564,31 +635,36 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
       if (false == rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
+      cb_gsbs.push_back(&rr_gsb);
+    }
+  }
 
-      /* Find all the cb instance under this module
-       * Create a regular expression to include these instance names 
-       */
-      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
-      std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
-      ModuleId cb_module = module_manager.find_module(cb_instance_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+  parallel_for(cb_gsbs.size(), num_threads,
+               [&](const size_t& icb) {
+    const RRGSB& rr_gsb = *cb_gsbs[icb];
 
-      std::string module_path = format_dir_path(root_path) + cb_instance_name;
+    /* Find all the cb instance under this module
+     * Create a regular expression to include these instance names 
+     */
+    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
+    std::string cb_instance_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
+    ModuleId cb_module = module_manager.find_module(cb_instance_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
-      print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                        time_unit,
-                                        hierarchical,
-                                        module_path,
-                                        module_manager,
-                                        device_annotation, 
-                                        grids, 
-                                        rr_graph, 
-                                        rr_gsb, 
-                                        cb_type,
-                                        constrain_zero_delay_paths);
+    std::string module_path = format_dir_path(root_path) + cb_instance_name;
 
-    }
-  }
+    print_pnr_sdc_constrain_cb_timing(sdc_dir,
+                                      time_unit,
+                                      hierarchical,
+                                      module_path,
+                                      module_manager,
+                                      device_annotation, 
+                                      grids, 
+                                      rr_graph, 
+                                      rr_gsb, 
+                                      cb_type,
+                                      constrain_zero_delay_paths);
+  });
 }
 
 /********************************************************************
@@ -604,7 +680,8 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
@@ -617,7 +694,8 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                     rr_graph,
                                                     device_rr_gsb,
                                                     CHANX,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    num_threads);
 
   print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_dir, time_unit,
                                                     hierarchical, 
@@ -627,7 +705,8 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                     rr_graph,
                                                     device_rr_gsb,
                                                     CHANY,
-                                                    constrain_zero_delay_paths);
+                                                    constrain_zero_delay_paths,
+                                                    num_threads);
 }
 
 /********************************************************************
@@ -643,65 +722,42 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths) {
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads) {
 
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Write SDC for constrain Connection Block timing for P&R flow");
 
   std::string root_path = module_manager.module_name(top_module);
 
-  /* Print SDC for unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
+  /* Print SDC for unique X- and Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    parallel_for(device_rr_gsb.get_num_cb_unique_module(cb_type), num_threads,
+                 [&](const size_t& icb) {
+      const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, icb);
 
-    /* Find all the cb instance under this module
-     * Create a regular expression to include these instance names 
-     */
-    vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(CHANX), unique_mirror.get_cb_y(CHANX));
-    std::string cb_module_name = generate_connection_block_module_name(CHANX, gsb_coordinate); 
-    ModuleId cb_module = module_manager.find_module(cb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-    std::string module_path = format_dir_path(root_path) + cb_module_name;
-
-    print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                      time_unit,
-                                      hierarchical,
-                                      module_path,
-                                      module_manager,
-                                      device_annotation, 
-                                      grids, 
-                                      rr_graph, 
-                                      unique_mirror, 
-                                      CHANX,
-                                      constrain_zero_delay_paths);
-  }
-
-  /* Print SDC for unique Y-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    /* Find all the cb instance under this module
-     * Create a regular expression to include these instance names 
-     */
-    vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(CHANY), unique_mirror.get_cb_y(CHANY));
-    std::string cb_module_name = generate_connection_block_module_name(CHANY, gsb_coordinate); 
-    ModuleId cb_module = module_manager.find_module(cb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
+      /* Find all the cb instance under this module
+       * Create a regular expression to include these instance names 
+       */
+      vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type));
+      std::string cb_module_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
+      ModuleId cb_module = module_manager.find_module(cb_module_name);
+      VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
 
-    std::string module_path = format_dir_path(root_path) + cb_module_name;
+      std::string module_path = format_dir_path(root_path) + cb_module_name;
 
-    print_pnr_sdc_constrain_cb_timing(sdc_dir,
-                                      time_unit,
-                                      hierarchical,
-                                      module_path,
-                                      module_manager,
-                                      device_annotation, 
-                                      grids, 
-                                      rr_graph, 
-                                      unique_mirror, 
-                                      CHANY,
-                                      constrain_zero_delay_paths);
+      print_pnr_sdc_constrain_cb_timing(sdc_dir,
+                                        time_unit,
+                                        hierarchical,
+                                        module_path,
+                                        module_manager,
+                                        device_annotation, 
+                                        grids, 
+                                        rr_graph, 
+                                        unique_mirror, 
+                                        cb_type,
+                                        constrain_zero_delay_paths);
+    });
   }
 }
 
@@ -28,7 +28,8 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -39,7 +40,8 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -50,7 +52,8 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_dir,
                                                        const float& time_unit,
@@ -61,7 +64,8 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(const std::string& sdc_di
                                                        const DeviceGrid& grids,
                                                        const RRGraph& rr_graph,
                                                        const DeviceRRGSB& device_rr_gsb,
-                                                       const bool& constrain_zero_delay_paths);
+                                                       const bool& constrain_zero_delay_paths,
+                                                       const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -387,7 +387,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         device_ctx.grid,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_sb_timing(sdc_options.sdc_dir(),
@@ -399,7 +400,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         device_ctx.grid,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     }
   }
 
@@ -410,7 +412,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
     print_pnr_sdc_routing_sb_hierarchy(sdc_options.sdc_dir(),
                                        module_manager,
                                        top_module,
-                                       device_rr_gsb);
+                                       device_rr_gsb,
+                                       sdc_options.num_threads());
   }
 
   /* Output routing constraints for Connection Blocks */
@@ -425,7 +428,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         device_ctx.grid,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     } else {
 	  VTR_ASSERT_SAFE (false == compact_routing_hierarchy);
       print_pnr_sdc_flatten_routing_constrain_cb_timing(sdc_options.sdc_dir(),
@@ -437,7 +441,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                                         device_ctx.grid,
                                                         device_ctx.rr_graph,
                                                         device_rr_gsb,
-                                                        sdc_options.constrain_zero_delay_paths());
+                                                        sdc_options.constrain_zero_delay_paths(),
+                                                        sdc_options.num_threads());
     }
   }
 
@@ -449,13 +454,15 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                        module_manager,
                                        top_module,
                                        CHANX,
-                                       device_rr_gsb);
+                                       device_rr_gsb,
+                                       sdc_options.num_threads());
 
     print_pnr_sdc_routing_cb_hierarchy(sdc_options.sdc_dir(),
                                        module_manager,
                                        top_module,
                                        CHANY,
-                                       device_rr_gsb);
+                                       device_rr_gsb,
+                                       sdc_options.num_threads());
   }
 
   /* Output Timing constraints for Programmable blocks */
@@ -467,7 +474,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                         device_annotation,
                                         module_manager,
                                         top_module,
-                                        sdc_options.constrain_zero_delay_paths());
+                                        sdc_options.constrain_zero_delay_paths(),
+                                        sdc_options.num_threads());
   }
 
   if ( (true == sdc_options.constrain_grid())
@@ -476,7 +484,8 @@ void print_pnr_sdc(const PnrSdcOption& sdc_options,
                                  device_ctx,
                                  device_annotation,
                                  module_manager,
-                                 top_module);
+                                 top_module,
+                                 sdc_options.num_threads());
 
   }
 }
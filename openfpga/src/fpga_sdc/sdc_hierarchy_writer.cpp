@@ -1,6 +1,12 @@
 /***************************************************************************************
  * Output instance hierarchy in SDC to file formats
+ *
+ * The entries of unique modules are formatted in parallel and written 
+ * in the order of the unique modules, so that the files do not depend
+ * on the number of threads
  ***************************************************************************************/
+#include <sstream>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -8,6 +14,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 #include "openfpga_reserved_words.h"
 #include "openfpga_naming.h"
@@ -21,6 +28,33 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of unique modules formatted by a thread at once */
+constexpr size_t SDC_HIERARCHY_CHUNK_SIZE = 16;
+
+/***************************************************************************************
+ * Write a module and all its instances under the top-level module
+ * The instances are enumerated by their ids, without searching the children of the top
+ ***************************************************************************************/
+static 
+void print_pnr_sdc_top_child_module_hierarchy(std::ostream& fp,
+                                              const ModuleManager& module_manager,
+                                              const ModuleId& top_module,
+                                              const std::string& module_name) {
+  ModuleId module = module_manager.find_module(module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(module));
+
+  fp << "- " << module_name << ":" << "\n";
+
+  /* Go through all the instance */
+  size_t num_instances = module_manager.num_instance(top_module, module);
+  for (size_t instance_id = 0; instance_id < num_instances; ++instance_id) {
+    fp << "  ";
+    fp << "- " << module_manager.instance_name(top_module, module, instance_id) << "\n";  
+  } 
+
+  fp << "\n";
+}
+
 /***************************************************************************************
  * Write the hierarchy of Switch Block module and its instances to a plain text file
  * e.g.,
@@ -36,7 +70,8 @@ namespace openfpga {
 void print_pnr_sdc_routing_sb_hierarchy(const std::string& sdc_dir,
                                         const ModuleManager& module_manager,
                                         const ModuleId& top_module,
-                                        const DeviceRRGSB& device_rr_gsb) {
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const size_t& num_threads) {
 
   std::string fname(sdc_dir + std::string(SDC_SB_HIERARCHY_FILE_NAME));
 
@@ -61,35 +96,21 @@ void print_pnr_sdc_routing_sb_hierarchy(const std::string& sdc_dir,
   /* Validate the file stream */
   check_file_stream(fname.c_str(), fp);
 
-  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
-    if (false == rr_gsb.is_sb_exist()) {
-      continue;
-    }
-
-    /* Find all the sb instance under this module
-     * Create a regular expression to include these instance names 
-     */
-    vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-    std::string sb_module_name = generate_switch_block_module_name(gsb_coordinate); 
-
-    ModuleId sb_module = module_manager.find_module(sb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
-
-    /* Create the file name for SDC */
-    std::string sdc_fname(sdc_dir + generate_switch_block_module_name(gsb_coordinate) + std::string(SDC_FILE_NAME_POSTFIX));
-
-    fp << "- " << sb_module_name << ":" << "\n";
-
-    /* Go through all the instance */
-    for (const size_t& instance_id : module_manager.child_module_instances(top_module, sb_module)) {
-      std::string sb_instance_name = module_manager.instance_name(top_module, sb_module, instance_id);
-      fp << "  ";
-      fp << "- " << sb_instance_name << "\n";  
-    } 
+  parallel_write_chunks(fp, device_rr_gsb.get_num_sb_unique_module(), SDC_HIERARCHY_CHUNK_SIZE, num_threads,
+                        [&](std::ostream& chunk_fp, const size_t& begin, const size_t& end) {
+    for (size_t isb = begin; isb < end; ++isb) {
+      const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(isb);
+      if (false == rr_gsb.is_sb_exist()) {
+        continue;
+      }
 
-    fp << "\n";
-  }
+      /* Find all the sb instance under this module */
+      vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+      print_pnr_sdc_top_child_module_hierarchy(chunk_fp, module_manager, top_module,
+                                               generate_switch_block_module_name(gsb_coordinate));
+    }
+    return 0;
+  });
 
   /* close a file */
   fp.close();
@@ -111,7 +132,8 @@ void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
                                         const ModuleManager& module_manager,
                                         const ModuleId& top_module,
                                         const t_rr_type& cb_type,
-                                        const DeviceRRGSB& device_rr_gsb) {
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const size_t& num_threads) {
 
   std::string fname(sdc_dir);
   if (CHANX == cb_type) {
@@ -143,31 +165,18 @@ void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
   check_file_stream(fname.c_str(), fp);
 
   /* Print SDC for unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, icb);
-
-    /* Find all the cb instance under this module
-     * Create a regular expression to include these instance names 
-     */
-    vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type));
-    std::string cb_module_name = generate_connection_block_module_name(cb_type, gsb_coordinate); 
-    ModuleId cb_module = module_manager.find_module(cb_module_name);
-    VTR_ASSERT(true == module_manager.valid_module_id(cb_module));
-
-    /* Create the file name for SDC */
-    std::string sdc_fname(sdc_dir + generate_connection_block_module_name(cb_type, gsb_coordinate) + std::string(SDC_FILE_NAME_POSTFIX));
-
-    fp << "- " << cb_module_name << ":" << "\n";
-
-    /* Go through all the instance */
-    for (const size_t& instance_id : module_manager.child_module_instances(top_module, cb_module)) {
-      std::string cb_instance_name = module_manager.instance_name(top_module, cb_module, instance_id);
-      fp << "  ";
-      fp << "- " << cb_instance_name << "\n";  
-    } 
-
-    fp << "\n";
-  }
+  parallel_write_chunks(fp, device_rr_gsb.get_num_cb_unique_module(cb_type), SDC_HIERARCHY_CHUNK_SIZE, num_threads,
+                        [&](std::ostream& chunk_fp, const size_t& begin, const size_t& end) {
+    for (size_t icb = begin; icb < end; ++icb) {
+      const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(cb_type, icb);
+
+      /* Find all the cb instance under this module */
+      vtr::Point<size_t> gsb_coordinate(unique_mirror.get_cb_x(cb_type), unique_mirror.get_cb_y(cb_type));
+      print_pnr_sdc_top_child_module_hierarchy(chunk_fp, module_manager, top_module,
+                                               generate_connection_block_module_name(cb_type, gsb_coordinate));
+    }
+    return 0;
+  });
 
   /* close a file */
   fp.close();
@@ -182,7 +191,7 @@ void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
  * This file is mainly used by hierarchical P&R flow 
  *******************************************************************/
 static 
-void rec_print_pnr_sdc_grid_pb_graph_hierarchy(std::fstream& fp,
+void rec_print_pnr_sdc_grid_pb_graph_hierarchy(std::ostream& fp,
                                                const size_t& depth,
                                                const ModuleManager& module_manager,
                                                const ModuleId& parent_pb_module,
@@ -245,6 +254,43 @@ void rec_print_pnr_sdc_grid_pb_graph_hierarchy(std::fstream& fp,
   } 
 }
 
+/***************************************************************************************
+ * Write the hierarchy of the physical blocks under an instance of grid module
+ * When the pins of grids are duplicated, the physical blocks are in the core module of the grid,
+ * whose instance is written before
+ ***************************************************************************************/
+static 
+void print_pnr_sdc_grid_instance_hierarchy(std::ostream& fp,
+                                           const ModuleManager& module_manager,
+                                           const ModuleId& grid_module,
+                                           t_physical_tile_type_ptr physical_tile,
+                                           const VprDeviceAnnotation& device_annotation,
+                                           t_pb_graph_node* pb_graph_head) {
+  std::string core_module_name = generate_grid_core_module_name(std::string(GRID_MODULE_NAME_PREFIX), std::string(physical_tile->name));
+  ModuleId core_module = module_manager.find_module(core_module_name);
+  if (false == module_manager.valid_module_id(core_module)) {
+    rec_print_pnr_sdc_grid_pb_graph_hierarchy(fp,
+                                              2,
+                                              module_manager, 
+                                              grid_module, 
+                                              device_annotation,
+                                              pb_graph_head);
+    return;
+  }
+
+  write_space_to_file(fp, 2 * 2);
+  fp << "- " << core_module_name << ":" << "\n";
+  write_space_to_file(fp, 2 * 2);
+  fp << "  ";
+  fp << "- " << generate_grid_core_instance_name(std::string(GRID_MODULE_NAME_PREFIX), std::string(physical_tile->name)) << ":" << "\n";
+
+  rec_print_pnr_sdc_grid_pb_graph_hierarchy(fp,
+                                            4,
+                                            module_manager, 
+                                            core_module, 
+                                            device_annotation,
+                                            pb_graph_head);
+}
 
 /***************************************************************************************
  * Write the hierarchy of grid module and its instances to a plain text file
@@ -262,7 +308,8 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
                                   const DeviceContext& device_ctx,
                                   const VprDeviceAnnotation& device_annotation,
                                   const ModuleManager& module_manager,
-                                  const ModuleId& top_module) {
+                                  const ModuleId& top_module,
+                                  const size_t& num_threads) {
 
   std::string fname(sdc_dir + std::string(SDC_GRID_HIERARCHY_FILE_NAME));
 
@@ -287,7 +334,9 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
   /* Validate the file stream */
   check_file_stream(fname.c_str(), fp);
 
-  std::string root_path = format_dir_path(module_manager.module_name(top_module));
+  /* Collect the grid modules first, so that they can be formatted in parallel */
+  std::vector<std::string> grid_module_names;
+  std::vector<const t_physical_tile_type*> grid_module_tiles;
 
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
@@ -313,65 +362,59 @@ void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
 
-
       /* Generate the grid module name */
       for (const e_side& io_type_side : io_type_sides) {
-        std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
-                                                                       std::string(physical_tile.name),
-                                                                       is_io_type(&physical_tile),
-                                                                       io_type_side);
-        /* Find the module Id */
-        ModuleId grid_module = module_manager.find_module(grid_module_name);
-        VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
-
-        fp << "- " << grid_module_name << ":" << "\n";
-
-        /* Go through all the instance */
-        for (const size_t& instance_id : module_manager.child_module_instances(top_module, grid_module)) {
-          std::string grid_instance_name = module_manager.instance_name(top_module, grid_module, instance_id);
-          fp << "  ";
-          fp << "- " << grid_instance_name << ":" << "\n";  
-
-          rec_print_pnr_sdc_grid_pb_graph_hierarchy(fp,
-                                                    2,
-                                                    module_manager, 
-                                                    grid_module, 
-                                                    device_annotation,
-                                                    pb_graph_head);
-        } 
-        fp << "\n";
-
+        grid_module_names.push_back(generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
+                                                                    std::string(physical_tile.name),
+                                                                    is_io_type(&physical_tile),
+                                                                    io_type_side));
+        grid_module_tiles.push_back(&physical_tile);
       }
     } else {
       /* For CLB and heterogenenous blocks */
-      std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
-                                                                     std::string(physical_tile.name),
-                                                                     is_io_type(&physical_tile),
-                                                                     NUM_SIDES);
+      grid_module_names.push_back(generate_grid_block_module_name(std::string(GRID_MODULE_NAME_PREFIX), 
+                                                                  std::string(physical_tile.name),
+                                                                  is_io_type(&physical_tile),
+                                                                  NUM_SIDES));
+      grid_module_tiles.push_back(&physical_tile);
+    }
+  }
+
+  parallel_write_chunks(fp, grid_module_names.size(), 1, num_threads,
+                        [&](std::ostream& chunk_fp, const size_t& begin, const size_t& end) {
+    for (size_t imodule = begin; imodule < end; ++imodule) {
+      const t_physical_tile_type* physical_tile = grid_module_tiles[imodule];
+
       /* Find the module Id */
-      ModuleId grid_module = module_manager.find_module(grid_module_name);
+      ModuleId grid_module = module_manager.find_module(grid_module_names[imodule]);
       VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
 
-      fp << "- " << grid_module_name << ":" << "\n";
+      /* The pb hierarchy is the same for all the instances of a grid module,
+       * so it is formatted only once 
+       */
+      std::ostringstream pb_hierarchy;
+      print_pnr_sdc_grid_instance_hierarchy(pb_hierarchy,
+                                            module_manager, 
+                                            grid_module, 
+                                            physical_tile,
+                                            device_annotation,
+                                            physical_tile->equivalent_sites[0]->pb_graph_head);
+      const std::string pb_hierarchy_str = pb_hierarchy.str();
 
-      /* Go through all the instance */
-      for (const size_t& instance_id : module_manager.child_module_instances(top_module, grid_module)) {
-        std::string grid_instance_name = module_manager.instance_name(top_module, grid_module, instance_id);
-        fp << "  ";
-        fp << "- " << grid_instance_name << ":" << "\n";  
+      chunk_fp << "- " << grid_module_names[imodule] << ":" << "\n";
 
-        rec_print_pnr_sdc_grid_pb_graph_hierarchy(fp,
-                                                  2,
-                                                  module_manager, 
-                                                  grid_module, 
-                                                  device_annotation,
-                                                  pb_graph_head);
+      /* Go through all the instance */
+      size_t num_instances = module_manager.num_instance(top_module, grid_module);
+      for (size_t instance_id = 0; instance_id < num_instances; ++instance_id) {
+        chunk_fp << "  ";
+        chunk_fp << "- " << module_manager.instance_name(top_module, grid_module, instance_id) << ":" << "\n";  
+        chunk_fp << pb_hierarchy_str;
       } 
 
-      fp << "\n";
-
+      chunk_fp << "\n";
     }
-  }
+    return 0;
+  });
 
   /* close a file */
   fp.close();
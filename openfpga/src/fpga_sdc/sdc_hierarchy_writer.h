@@ -17,19 +17,22 @@ namespace openfpga {
 void print_pnr_sdc_routing_sb_hierarchy(const std::string& sdc_dir,
                                         const ModuleManager& module_manager,
                                         const ModuleId& top_module,
-                                        const DeviceRRGSB& device_rr_gsb);
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const size_t& num_threads);
 
 void print_pnr_sdc_routing_cb_hierarchy(const std::string& sdc_dir,
                                         const ModuleManager& module_manager,
                                         const ModuleId& top_module,
                                         const t_rr_type& cb_type,
-                                        const DeviceRRGSB& device_rr_gsb);
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const size_t& num_threads);
 
 void print_pnr_sdc_grid_hierarchy(const std::string& sdc_dir,
                                   const DeviceContext& device_ctx,
                                   const VprDeviceAnnotation& device_annotation,
                                   const ModuleManager& module_manager,
-                                  const ModuleId& top_module);
+                                  const ModuleId& top_module,
+                                  const size_t& num_threads);
 
 
 } /* end namespace openfpga */
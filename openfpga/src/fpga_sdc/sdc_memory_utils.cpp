@@ -14,6 +14,7 @@
 #include "openfpga_naming.h"
 
 #include "sdc_writer_utils.h"
+#include "sdc_module_path.h"
 
 #include "sdc_memory_utils.h"
 
@@ -35,12 +36,16 @@ namespace openfpga {
  *     It will straightforwardly output the instance name and port name
  *     This function will try to apply wildcard to names
  *     so that SDC file size can be minimal 
+ *
+ * The path of the parent module is updated in place when going
+ * down to a child, and restored when coming back
  *******************************************************************/
+static 
 void rec_print_pnr_sdc_disable_configurable_memory_module_output(std::fstream& fp, 
                                                                  const bool& flatten_names,
                                                                  const ModuleManager& module_manager, 
                                                                  const ModuleId& parent_module,
-                                                                 const std::string& parent_module_path) {
+                                                                 SdcModulePath& module_path) {
 
   /* Build wildcard names for the instance names of multiple-instanced-blocks (MIB) 
    * We will find all the instance names and see there are common prefix 
@@ -50,7 +55,6 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(std::fstream& f
 
   /* For each configurable child, we will go one level down in priority */
   for (size_t child_index = 0; child_index < module_manager.configurable_children(parent_module).size(); ++child_index) {
-    std::string child_module_path = parent_module_path;
     ModuleId child_module_id = module_manager.configurable_children(parent_module)[child_index];
     size_t child_instance_id = module_manager.configurable_child_instances(parent_module)[child_index];
     std::string child_instance_name;
@@ -75,19 +79,18 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(std::fstream& f
         continue;
       }
 
-      child_module_path += wildcard_str.data();
+      module_path.push_instance(wildcard_str.data());
  
       wildcard_names[child_module_id].push_back(wildcard_str.data());
     } else {
-      child_module_path += child_instance_name;
+      module_path.push_instance(child_instance_name);
     }
     
-    child_module_path = format_dir_path(child_module_path);
-
     rec_print_pnr_sdc_disable_configurable_memory_module_output(fp, flatten_names,
                                                                 module_manager, 
                                                                 child_module_id, 
-                                                                child_module_path);
+                                                                module_path);
+    module_path.pop_instance();
   }
 
   /* If there is no configurable children any more, this is a leaf module, print a SDC command for disable timing */
@@ -101,9 +104,26 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(std::fstream& f
   /* Disable timing for each output port of this module */
   for (const BasicPort& output_port : module_manager.module_ports_by_type(parent_module, ModuleManager::MODULE_OUTPUT_PORT)) {
     fp << "set_disable_timing ";
-    fp << parent_module_path << output_port.get_name();
+    fp << module_path.path() << output_port.get_name();
     fp << std::endl;
   }
 }
 
+/********************************************************************
+ * Print SDC commands to disable outputs of all the configurable memory modules
+ * under a parent module, whose path is given
+ * See the recursive function above for details
+ *******************************************************************/
+void rec_print_pnr_sdc_disable_configurable_memory_module_output(std::fstream& fp, 
+                                                                 const bool& flatten_names,
+                                                                 const ModuleManager& module_manager, 
+                                                                 const ModuleId& parent_module,
+                                                                 const std::string& parent_module_path) {
+  SdcModulePath module_path(parent_module_path);
+  rec_print_pnr_sdc_disable_configurable_memory_module_output(fp, flatten_names,
+                                                              module_manager,
+                                                              parent_module,
+                                                              module_path);
+}
+
 } /* end namespace openfpga */
@@ -0,0 +1,48 @@
+/********************************************************************
+ * Member functions for class SdcModulePath
+ ********************************************************************/
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "sdc_module_path.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Public Constructors
+ ********************************************************************/
+SdcModulePath::SdcModulePath(const std::string& root_path) {
+  path_ = format_dir_path(root_path);
+}
+
+/********************************************************************
+ * Public accessors
+ ********************************************************************/
+const std::string& SdcModulePath::path() const {
+  return path_;
+}
+
+size_t SdcModulePath::depth() const {
+  return instance_offsets_.size();
+}
+
+/********************************************************************
+ * Public mutators
+ ********************************************************************/
+void SdcModulePath::push_instance(const std::string& instance_name) {
+  VTR_ASSERT(false == instance_name.empty());
+  instance_offsets_.push_back(path_.size());
+  path_ += instance_name;
+  path_.push_back('/');
+}
+
+void SdcModulePath::pop_instance() {
+  VTR_ASSERT(false == instance_offsets_.empty());
+  path_.resize(instance_offsets_.back());
+  instance_offsets_.pop_back();
+}
+
+} /* end namespace openfpga */
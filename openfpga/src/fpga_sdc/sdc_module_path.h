@@ -0,0 +1,40 @@
+#ifndef SDC_MODULE_PATH_H
+#define SDC_MODULE_PATH_H
+
+/********************************************************************
+ * A builder of the hierarchical paths of module instances in SDC files,
+ * e.g., fpga_top/grid_clb_1_1/logical_tile_clb_mode_clb__0/
+ *
+ * The path is kept in a single buffer, while the offset of each
+ * instance in the buffer is stacked. Going one level down in the
+ * module graph appends an instance name to the buffer, and going back
+ * simply truncates the buffer. As such, recursive SDC writers do not
+ * have to copy the full path at each level of the hierarchy
+ ********************************************************************/
+#include <string>
+#include <vector>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+class SdcModulePath {
+  public: /* Public Constructors */
+    explicit SdcModulePath(const std::string& root_path);
+  public: /* Public accessors */
+    /* The full path, which always ends with a '/' unless it is empty */
+    const std::string& path() const;
+    size_t depth() const;
+  public: /* Public mutators */
+    /* Go one level down to an instance */
+    void push_instance(const std::string& instance_name);
+    /* Go one level up to the parent instance */
+    void pop_instance();
+  private: /* Internal data */
+    std::string path_;
+    /* The size of the path before each instance is pushed */
+    std::vector<size_t> instance_offsets_;
+};
+
+} /* end namespace openfpga */
+
+#endif
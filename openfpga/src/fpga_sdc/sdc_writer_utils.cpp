@@ -11,10 +11,12 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
 #include "openfpga_wildcard_string.h"
 
 #include "openfpga_naming.h"
 
+#include "sdc_module_path.h"
 #include "sdc_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -28,16 +30,13 @@ void print_sdc_file_header(std::fstream& fp,
 
   valid_file_stream(fp);
 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
   fp << "#############################################" << std::endl;
   fp << "#\tSynopsys Design Constraints (SDC)" << std::endl;
   fp << "#\tFor FPGA fabric " << std::endl;
   fp << "#\tDescription: " << usage << std::endl;
   fp << "#\tAuthor: Xifan TANG " << std::endl;
   fp << "#\tOrganization: University of Utah " << std::endl;
-  fp << "#\tDate: " << std::ctime(&end_time);
+  fp << "#\tDate: " << generate_file_time_stamp();
   fp << "#############################################" << std::endl;
   fp << std::endl;
 }
@@ -307,6 +306,9 @@ void print_sdc_set_port_output_delay(std::fstream& fp,
  * It will iterate over all the configurable children under each module
  * and print a SDC command to disable its outputs
  *
+ * The path of the parent module is updated in place when going
+ * down to a child, and restored when coming back
+ *
  * Return code:
  *   0: success
  *   1: fatal error occurred
@@ -319,12 +321,13 @@ void print_sdc_set_port_output_delay(std::fstream& fp,
  *     This function will try to apply wildcard to names
  *     so that SDC file size can be minimal 
  *******************************************************************/
+static 
 int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp, 
                                                   const bool& flatten_names,
                                                   const ModuleManager& module_manager, 
                                                   const ModuleId& parent_module,
                                                   const ModuleId& module_to_disable,
-                                                  const std::string& parent_module_path,
+                                                  SdcModulePath& module_path,
                                                   const std::string& disable_port_name) {
 
   if (false == valid_file_stream(fp)) {
@@ -342,8 +345,6 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
 
     /* Iterate over the child instances*/
     for (const size_t& child_instance : module_manager.child_module_instances(parent_module, child_module)) {
-      std::string child_module_path = parent_module_path;
-
       std::string child_instance_name;
       if (true == module_manager.instance_name(parent_module, child_module, child_instance).empty()) {
         child_instance_name = generate_instance_name(module_manager.module_name(child_module), child_instance);
@@ -366,23 +367,22 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
           continue;
         }
 
-        child_module_path += wildcard_str.data();
+        module_path.push_instance(wildcard_str.data());
  
         wildcard_names[child_module].push_back(wildcard_str.data());
       } else {
-        child_module_path += child_instance_name;
+        module_path.push_instance(child_instance_name);
       }
       
-      child_module_path = format_dir_path(child_module_path);
-
       /* If this is NOT the MUX module we want, we go recursively */
       if (module_to_disable != child_module) {
         int status = rec_print_sdc_disable_timing_for_module_ports(fp, flatten_names,
                                                                    module_manager, 
                                                                    child_module, 
                                                                    module_to_disable,
-                                                                   child_module_path,
+                                                                   module_path,
                                                                    disable_port_name);
+        module_path.pop_instance();
         if (1 == status) {
           return 1; /* FATAL ERRORS */
         }
@@ -398,12 +398,39 @@ int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp,
         return 1; /* FATAL ERRORS */
       }
       fp << "set_disable_timing ";
-      fp << child_module_path << module_manager.module_port(module_to_disable, port_to_disable).get_name();
+      fp << module_path.path() << module_manager.module_port(module_to_disable, port_to_disable).get_name();
       fp << std::endl;
+
+      module_path.pop_instance();
     }
   }
 
   return 0; /* Success */
 }
 
+/********************************************************************
+ * Print SDC commands to disable a given port of modules
+ * under a parent module, whose path is given
+ * See the recursive function above for details
+ *
+ * Return code:
+ *   0: success
+ *   1: fatal error occurred
+ *******************************************************************/
+int rec_print_sdc_disable_timing_for_module_ports(std::fstream& fp, 
+                                                  const bool& flatten_names,
+                                                  const ModuleManager& module_manager, 
+                                                  const ModuleId& parent_module,
+                                                  const ModuleId& module_to_disable,
+                                                  const std::string& parent_module_path,
+                                                  const std::string& disable_port_name) {
+  SdcModulePath module_path(parent_module_path);
+  return rec_print_sdc_disable_timing_for_module_ports(fp, flatten_names,
+                                                       module_manager,
+                                                       parent_module,
+                                                       module_to_disable,
+                                                       module_path,
+                                                       disable_port_name);
+}
+
 } /* end namespace openfpga */
@@ -22,6 +22,7 @@
 #include "spice_auxiliary_netlists.h"
 
 /* Header file for this source file */
+#include "netlist_write_profiler.h"
 #include "spice_api.h"
 
 /* begin namespace openfpga */
@@ -78,41 +79,56 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
    */
   int status = CMD_EXEC_SUCCESS;
 
-  status = print_spice_submodule(netlist_manager,
-                                 module_manager,
-                                 openfpga_arch,
-                                 mux_lib,
-                                 submodule_dir_path);
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "submodules", std::string(SPICE_FILE_HEADER_DATE_PREFIX));
+    status = print_spice_submodule(netlist_manager,
+                                   module_manager,
+                                   openfpga_arch,
+                                   mux_lib,
+                                   submodule_dir_path);
+  }
  
   if (CMD_EXEC_SUCCESS != status) {
     return status;
   }
 
   /* Generate routing blocks */
-  if (true == options.compress_routing()) {
-    print_spice_unique_routing_modules(netlist_manager,
-                                       module_manager,
-                                       device_rr_gsb,
-                                       rr_dir_path);
-  } else {
-    VTR_ASSERT(false == options.compress_routing());
-    print_spice_flatten_routing_modules(netlist_manager,
-                                        module_manager,
-                                        device_rr_gsb,
-                                        rr_dir_path);
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "routing", std::string(SPICE_FILE_HEADER_DATE_PREFIX));
+    if (true == options.compress_routing()) {
+      print_spice_unique_routing_modules(netlist_manager,
+                                         module_manager,
+                                         device_rr_gsb,
+                                         rr_dir_path,
+                                         options);
+    } else {
+      VTR_ASSERT(false == options.compress_routing());
+      print_spice_flatten_routing_modules(netlist_manager,
+                                          module_manager,
+                                          device_rr_gsb,
+                                          rr_dir_path,
+                                          options);
+    }
   }
 
   /* Generate grids */
-  print_spice_grids(netlist_manager,
-                    module_manager,
-                    device_ctx, device_annotation,
-                    lb_dir_path,
-                    options.verbose_output());
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "grids", std::string(SPICE_FILE_HEADER_DATE_PREFIX));
+    print_spice_grids(netlist_manager,
+                      module_manager,
+                      device_ctx, device_annotation,
+                      lb_dir_path,
+                      options.num_threads(),
+                      options.verbose_output());
+  }
 
   /* Generate FPGA fabric */
-  print_spice_top_module(netlist_manager,
-                         module_manager,
-                         src_dir_path);
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "top_module", std::string(SPICE_FILE_HEADER_DATE_PREFIX));
+    print_spice_top_module(netlist_manager,
+                           module_manager,
+                           src_dir_path);
+  }
 
   /* Generate an netlist including all the fabric-related netlists */
   print_spice_fabric_include_netlist(const_cast<const NetlistManager &>(netlist_manager),
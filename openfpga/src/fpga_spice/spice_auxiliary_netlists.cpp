@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 #include "circuit_library_utils.h"
@@ -36,7 +37,7 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
   std::string spice_fname = src_dir + std::string(FABRIC_INCLUDE_SPICE_NETLIST_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -56,28 +57,28 @@ void print_spice_fabric_include_netlist(const NetlistManager& netlist_manager,
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the CLB, heterogeneous block modules */
   print_spice_comment(fp, std::string("Include logic block netlists"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::LOGIC_BLOCK_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include all the routing architecture modules */
   print_spice_comment(fp, std::string("Include routing module netlists"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::ROUTING_MODULE_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Include FPGA top module */
   print_spice_comment(fp, std::string("Include fabric top-level netlists"));
   for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(NetlistManager::TOP_MODULE_NETLIST)) {
     print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
   }
-  fp << std::endl;
+  fp << "\n";
 
   /* Close the file stream */
   fp.close();
@@ -4,7 +4,6 @@
  ***********************************************/
 #include <fstream>
 #include <cmath>
-#include <iomanip>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -20,6 +19,7 @@
 
 #include "spice_constants.h"
 #include "spice_writer_utils.h"
+#include "spice_transistor_wrapper.h"
 #include "spice_buffer.h"
 
 /* begin namespace openfpga */
@@ -58,38 +58,64 @@ int print_spice_powergated_inverter_pmos_modeling(std::fstream& fp,
   size_t last_enb_pin;
   for (const auto& power_gate_pin : circuit_lib.pins(enb_port)) {
     BasicPort enb_pin(circuit_lib.port_prefix(enb_port), power_gate_pin, power_gate_pin);
-    fp << "Xpmos_powergate_" << trans_name_postfix << "_pin_" << power_gate_pin << " ";
+    std::string& line = find_spice_line_buffer();
+    line += "Xpmos_powergate_";
+    line += trans_name_postfix;
+    line += "_pin_";
+    line += std::to_string(power_gate_pin);
+    line += ' ';
     /* For the first pin, we should connect it to local VDD*/
     if (true == first_enb_pin) {
-      fp << output_port_name << "_pmos_pg_" << power_gate_pin << " "; 
-      fp << generate_spice_port(enb_pin) << " "; 
-      fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
-      fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
+      line += output_port_name;
+      line += "_pmos_pg_";
+      line += std::to_string(power_gate_pin);
+      line += ' '; 
+      append_spice_port(line, enb_pin);
+      line += ' '; 
+      line += SPICE_SUBCKT_VDD_PORT_NAME;
+      line += ' '; 
+      line += SPICE_SUBCKT_VDD_PORT_NAME;
+      line += ' '; 
       first_enb_pin = false;
     } else {
       VTR_ASSERT_SAFE(false == first_enb_pin);
-      fp << output_port_name << "_pmos_pg_" << last_enb_pin << " "; 
-      fp << generate_spice_port(enb_pin) << " "; 
-      fp << output_port_name << "_pmos_pg_" << power_gate_pin << " "; 
-      fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
+      line += output_port_name;
+      line += "_pmos_pg_";
+      line += std::to_string(last_enb_pin);
+      line += ' '; 
+      append_spice_port(line, enb_pin);
+      line += ' '; 
+      line += output_port_name;
+      line += "_pmos_pg_";
+      line += std::to_string(power_gate_pin);
+      line += ' '; 
+      line += SPICE_SUBCKT_VDD_PORT_NAME;
+      line += ' '; 
     }
-    fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_PMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-    fp << " W=" << std::setprecision(10) << trans_width;
-    fp << "\n";
+    append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, trans_width);
+    print_spice_line(fp, line);
 
     /* Cache the last pin*/
     last_enb_pin = power_gate_pin;
   }
 
   /* Write transistor pairs using the technology model */
-  fp << "Xpmos_" << trans_name_postfix << " ";
-  fp << output_port_name << " "; 
-  fp << input_port_name << " "; 
-  fp << output_port_name << "_pmos_pg_" << circuit_lib.pins(enb_port).back() << " "; 
-  fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
-  fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_PMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-  fp << " W=" << std::setprecision(10) << trans_width;
-  fp << "\n";
+  std::string& line = find_spice_line_buffer();
+  line += "Xpmos_";
+  line += trans_name_postfix;
+  line += ' ';
+  line += output_port_name;
+  line += ' '; 
+  line += input_port_name;
+  line += ' '; 
+  line += output_port_name;
+  line += "_pmos_pg_";
+  line += std::to_string(circuit_lib.pins(enb_port).back());
+  line += ' '; 
+  line += SPICE_SUBCKT_VDD_PORT_NAME;
+  line += ' '; 
+  append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, trans_width);
+  print_spice_line(fp, line);
 
   return CMD_EXEC_SUCCESS;
 }
@@ -124,37 +150,63 @@ int print_spice_powergated_inverter_nmos_modeling(std::fstream& fp,
   size_t last_en_pin;
   for (const auto& power_gate_pin : circuit_lib.pins(en_port)) {
     BasicPort en_pin(circuit_lib.port_prefix(en_port), power_gate_pin, power_gate_pin);
-    fp << "Xnmos_powergate_" << trans_name_postfix << "_pin_" << power_gate_pin << " ";
+    std::string& line = find_spice_line_buffer();
+    line += "Xnmos_powergate_";
+    line += trans_name_postfix;
+    line += "_pin_";
+    line += std::to_string(power_gate_pin);
+    line += ' ';
     /* For the first pin, we should connect it to local VDD*/
     if (true == first_en_pin) {
-      fp << output_port_name << "_nmos_pg_" << power_gate_pin << " "; 
-      fp << generate_spice_port(en_pin) << " "; 
-      fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
-      fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
+      line += output_port_name;
+      line += "_nmos_pg_";
+      line += std::to_string(power_gate_pin);
+      line += ' '; 
+      append_spice_port(line, en_pin);
+      line += ' '; 
+      line += SPICE_SUBCKT_GND_PORT_NAME;
+      line += ' '; 
+      line += SPICE_SUBCKT_GND_PORT_NAME;
+      line += ' '; 
       first_en_pin = false;
     } else {
       VTR_ASSERT_SAFE(false == first_en_pin);
-      fp << output_port_name << "_nmos_pg_" << last_en_pin << " "; 
-      fp << circuit_lib.port_prefix(en_port) << " "; 
-      fp << output_port_name << "_nmos_pg_" << power_gate_pin << " "; 
-      fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
+      line += output_port_name;
+      line += "_nmos_pg_";
+      line += std::to_string(last_en_pin);
+      line += ' '; 
+      line += circuit_lib.port_prefix(en_port);
+      line += ' '; 
+      line += output_port_name;
+      line += "_nmos_pg_";
+      line += std::to_string(power_gate_pin);
+      line += ' '; 
+      line += SPICE_SUBCKT_GND_PORT_NAME;
+      line += ' '; 
     }
-    fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_NMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-    fp << " W=" << std::setprecision(10) << trans_width;
-    fp << "\n";
+    append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, trans_width);
+    print_spice_line(fp, line);
 
     /* Cache the last pin*/
     last_en_pin = power_gate_pin;
   }
 
-  fp << "Xnmos_" << trans_name_postfix << " ";
-  fp << output_port_name << " "; 
-  fp << input_port_name << " "; 
-  fp << output_port_name << " _nmos_pg_" << circuit_lib.pins(en_port).back() << " "; 
-  fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
-  fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_NMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-  fp << " W=" << std::setprecision(10) << trans_width;
-  fp << "\n";
+  std::string& line = find_spice_line_buffer();
+  line += "Xnmos_";
+  line += trans_name_postfix;
+  line += ' ';
+  line += output_port_name;
+  line += ' '; 
+  line += input_port_name;
+  line += ' '; 
+  line += output_port_name;
+  line += " _nmos_pg_";
+  line += std::to_string(circuit_lib.pins(en_port).back());
+  line += ' '; 
+  line += SPICE_SUBCKT_GND_PORT_NAME;
+  line += ' '; 
+  append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, trans_width);
+  print_spice_line(fp, line);
 
   return CMD_EXEC_SUCCESS;
 }
@@ -247,19 +299,12 @@ int print_spice_powergated_inverter_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
   float total_pmos_width = circuit_lib.buffer_size(circuit_model)
                          * tech_lib.model_pn_ratio(tech_model)
                          * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-  float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
-  for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-    float curr_bin_width = regular_pmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_pmos_bins - 1) 
-       && (0. != last_pmos_bin_width)) {
-      curr_bin_width = last_pmos_bin_width;
-    }
+  std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
+  for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = pmos_bin_widths[ibin];
     status = print_spice_powergated_inverter_pmos_modeling(fp,
                                                            std::to_string(ibin),
                                                            circuit_lib.port_prefix(input_ports[0]), 
@@ -278,18 +323,11 @@ int print_spice_powergated_inverter_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
   float total_nmos_width = circuit_lib.buffer_size(circuit_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
-  for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-    float curr_bin_width = regular_nmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_nmos_bins - 1) 
-       && (0. != last_nmos_bin_width)) {
-      curr_bin_width = last_nmos_bin_width;
-    }
+  std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
+  for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = nmos_bin_widths[ibin];
 
     status = print_spice_powergated_inverter_nmos_modeling(fp,
                                                            std::to_string(ibin),
@@ -335,14 +373,20 @@ int print_spice_regular_inverter_pmos_modeling(std::fstream& fp,
   }
 
   /* Write transistor pairs using the technology model */
-  fp << "Xpmos_" << trans_name_postfix << " ";
-  fp << output_port_name << " "; 
-  fp << input_port_name << " "; 
-  fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
-  fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
-  fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_PMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-  fp << " W=" << std::setprecision(10) << trans_width;
-  fp << "\n";
+  std::string& line = find_spice_line_buffer();
+  line += "Xpmos_";
+  line += trans_name_postfix;
+  line += ' ';
+  line += output_port_name;
+  line += ' '; 
+  line += input_port_name;
+  line += ' '; 
+  line += SPICE_SUBCKT_VDD_PORT_NAME;
+  line += ' '; 
+  line += SPICE_SUBCKT_VDD_PORT_NAME;
+  line += ' '; 
+  append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, trans_width);
+  print_spice_line(fp, line);
 
   return CMD_EXEC_SUCCESS;
 }
@@ -371,14 +415,20 @@ int print_spice_regular_inverter_nmos_modeling(std::fstream& fp,
     return CMD_EXEC_FATAL_ERROR;
   }
 
-  fp << "Xnmos_" << trans_name_postfix << " ";
-  fp << output_port_name << " "; 
-  fp << input_port_name << " "; 
-  fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
-  fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
-  fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_NMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-  fp << " W=" << std::setprecision(10) << trans_width;
-  fp << "\n";
+  std::string& line = find_spice_line_buffer();
+  line += "Xnmos_";
+  line += trans_name_postfix;
+  line += ' ';
+  line += output_port_name;
+  line += ' '; 
+  line += input_port_name;
+  line += ' '; 
+  line += SPICE_SUBCKT_GND_PORT_NAME;
+  line += ' '; 
+  line += SPICE_SUBCKT_GND_PORT_NAME;
+  line += ' '; 
+  append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, trans_width);
+  print_spice_line(fp, line);
 
   return CMD_EXEC_SUCCESS;
 }
@@ -441,19 +491,12 @@ int print_spice_regular_inverter_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
   float total_pmos_width = circuit_lib.buffer_size(circuit_model)
                            * tech_lib.model_pn_ratio(tech_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-  float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
-  for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-    float curr_bin_width = regular_pmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_pmos_bins - 1) 
-       && (0. != last_pmos_bin_width)) {
-      curr_bin_width = last_pmos_bin_width;
-    }
+  std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
+  for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = pmos_bin_widths[ibin];
 
     status = print_spice_regular_inverter_pmos_modeling(fp,
                                                         std::to_string(ibin),
@@ -471,19 +514,12 @@ int print_spice_regular_inverter_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
   float total_nmos_width = circuit_lib.buffer_size(circuit_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-  for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-    float curr_bin_width = regular_nmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_nmos_bins - 1) 
-       && (0. != last_nmos_bin_width)) {
-      curr_bin_width = last_nmos_bin_width;
-    }
+  std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
+
+  for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = nmos_bin_widths[ibin];
 
     status = print_spice_regular_inverter_nmos_modeling(fp,
                                                         std::to_string(ibin),
@@ -643,20 +679,13 @@ int print_spice_powergated_buffer_subckt(std::fstream& fp,
      * Try to size transistors to the max width for each bin
      * The last bin may not reach the max width 
      */
-    float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
     float total_pmos_width = buffer_widths[level]
                              * tech_lib.model_pn_ratio(tech_model)
                              * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-    int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-    float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
-
-    for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-      float curr_bin_width = regular_pmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_pmos_bins - 1) 
-         && (0. != last_pmos_bin_width)) {
-        curr_bin_width = last_pmos_bin_width;
-      }
+    std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
+
+    for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = pmos_bin_widths[ibin];
 
       std::string name_postfix = std::string("level") + std::to_string(level) + std::string("_bin") + std::to_string(ibin);
 
@@ -678,19 +707,12 @@ int print_spice_powergated_buffer_subckt(std::fstream& fp,
      * Try to size transistors to the max width for each bin
      * The last bin may not reach the max width 
      */
-    float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
     float total_nmos_width = buffer_widths[level]
                              * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-    int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-    float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-    for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-      float curr_bin_width = regular_nmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_nmos_bins - 1) 
-         && (0. != last_nmos_bin_width)) {
-        curr_bin_width = last_nmos_bin_width;
-      }
+    std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
+
+    for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = nmos_bin_widths[ibin];
 
       std::string name_postfix = std::string("level") + std::to_string(level) + std::string("_bin") + std::to_string(ibin);
 
@@ -799,20 +821,13 @@ int print_spice_regular_buffer_subckt(std::fstream& fp,
      * Try to size transistors to the max width for each bin
      * The last bin may not reach the max width 
      */
-    float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
     float total_pmos_width = buffer_widths[level]
                              * tech_lib.model_pn_ratio(tech_model)
                              * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-    int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-    float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
-
-    for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-      float curr_bin_width = regular_pmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_pmos_bins - 1) 
-         && (0. != last_pmos_bin_width)) {
-        curr_bin_width = last_pmos_bin_width;
-      }
+    std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
+
+    for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = pmos_bin_widths[ibin];
 
       std::string name_postfix = std::string("level") + std::to_string(level) + std::string("_bin") + std::to_string(ibin);
 
@@ -832,19 +847,12 @@ int print_spice_regular_buffer_subckt(std::fstream& fp,
      * Try to size transistors to the max width for each bin
      * The last bin may not reach the max width 
      */
-    float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
     float total_nmos_width = buffer_widths[level]
                               * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-    int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-    float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-    for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-      float curr_bin_width = regular_nmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_nmos_bins - 1) 
-         && (0. != last_nmos_bin_width)) {
-        curr_bin_width = last_nmos_bin_width;
-      }
+    std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
+
+    for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = nmos_bin_widths[ibin];
 
       std::string name_postfix = std::string("level") + std::to_string(level) + std::string("_bin") + std::to_string(ibin);
 
@@ -5,6 +5,7 @@
 constexpr size_t SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE = 10;
 
 constexpr char* SPICE_NETLIST_FILE_POSTFIX = ".sp";
+constexpr char* SPICE_FILE_HEADER_DATE_PREFIX = "*\tDate: "; // the line of time stamp in file headers, which is ignored when hashing netlists
 
 constexpr char* TRANSISTOR_WRAPPER_POSTFIX = "_wrapper";
 
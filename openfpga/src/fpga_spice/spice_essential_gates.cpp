@@ -17,6 +17,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 #include "circuit_library_utils.h"
@@ -87,7 +88,7 @@ int print_spice_supply_wrappers(NetlistManager& netlist_manager,
   /* Create file stream */
   std::string spice_fname = submodule_dir + std::string(SUPPLY_WRAPPER_SPICE_FILE_NAME);
   
-  std::fstream fp;
+  BufferedFileStream fp;
   
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -173,7 +174,7 @@ int print_spice_essential_gates(NetlistManager& netlist_manager,
     /* Create file stream */
     std::string spice_fname = submodule_dir + circuit_lib.model_name(circuit_model) + std::string(SPICE_NETLIST_FILE_POSTFIX);
   
-    std::fstream fp;
+    BufferedFileStream fp;
   
     /* Create the file stream */
     fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
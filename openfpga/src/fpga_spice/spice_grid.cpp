@@ -5,6 +5,7 @@
 /* System header files */
 #include <vector>
 #include <fstream>
+#include <utility>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -16,7 +17,9 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -86,7 +89,7 @@ void print_spice_primitive_block(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -106,7 +109,12 @@ void print_spice_primitive_block(NetlistManager& netlist_manager,
            module_manager.module_name(primitive_module).c_str());
   
   /* Write the spice module */
-  write_spice_subckt_to_file(fp, module_manager, primitive_module);
+  if (true == module_manager.is_module_alias(primitive_module_name)) {
+    /* Merged into an identical module, which is written in another netlist */
+    print_spice_comment(fp, std::string("Module " + primitive_module_name + " is merged into identical module " + module_manager.module_name(primitive_module)));
+  } else {
+    write_spice_subckt_to_file(fp, module_manager, primitive_module);
+  }
 
   /* Close file handler */
   fp.close();
@@ -194,7 +202,7 @@ void rec_print_spice_logical_tile(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -216,7 +224,12 @@ void rec_print_spice_logical_tile(NetlistManager& netlist_manager,
   print_spice_comment(fp, std::string("BEGIN Physical programmable logic block SPICE subckt: " + std::string(physical_pb_type->name)));
 
   /* Write the spice module */
-  write_spice_subckt_to_file(fp, module_manager, pb_module);
+  if (true == module_manager.is_module_alias(pb_module_name)) {
+    /* Merged into an identical module, which is written in another netlist */
+    print_spice_comment(fp, std::string("Module " + pb_module_name + " is merged into identical module " + module_manager.module_name(pb_module)));
+  } else {
+    write_spice_subckt_to_file(fp, module_manager, pb_module);
+  }
 
   print_spice_comment(fp, std::string("END Physical programmable logic block SPICE subckt: " + std::string(physical_pb_type->name)));
 
@@ -274,11 +287,11 @@ void print_spice_logical_tile_netlist(NetlistManager& netlist_manager,
  * the I/O block locates at.
  *****************************************************************************/
 static 
-void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
-                                       const ModuleManager& module_manager,
-                                       const std::string& subckt_dir,
-                                       t_physical_tile_type_ptr phy_block_type,
-                                       const e_side& border_side) {
+std::string print_spice_physical_tile_netlist(const ModuleManager& module_manager,
+                                              const std::string& subckt_dir,
+                                              t_physical_tile_type_ptr phy_block_type,
+                                              const e_side& border_side,
+                                              const bool& include_core_module) {
   /* Check code: if this is an IO block, the border side MUST be valid */
   if (true == is_io_type(phy_block_type)) {
     VTR_ASSERT(NUM_SIDES != border_side);
@@ -293,25 +306,28 @@ void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
                                                              std::string(SPICE_NETLIST_FILE_POSTFIX))
                            );
 
-  /* Echo status */
-  if (true == is_io_type(phy_block_type)) {
-    SideManager side_manager(border_side);
-    VTR_LOG("Writing SPICE Netlist '%s' for physical tile '%s' at %s side ...",
-            spice_fname.c_str(), phy_block_type->name, 
-            side_manager.c_str());
-  } else { 
-    VTR_LOG("Writing SPICE Netlist '%s' for physical_tile '%s'...",
-            spice_fname.c_str(), phy_block_type->name);
-  }
-
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
 
   print_spice_file_header(fp, std::string("SPICE subckts for physical tile: " + std::string(phy_block_type->name) + "]")); 
 
+  /* When the pins of grids are duplicated, the grid modules of the physical tile
+   * are wrappers of a core module, which is written with the first one
+   */
+  std::string core_module_name = generate_grid_core_module_name(std::string(GRID_SPICE_FILE_NAME_PREFIX), std::string(phy_block_type->name));
+  ModuleId core_module = module_manager.find_module(core_module_name);
+  if ( (true == include_core_module)
+    && (true == module_manager.valid_module_id(core_module))
+    && (false == module_manager.is_module_alias(core_module_name)) ) {
+    print_spice_comment(fp, std::string("BEGIN Grid core SPICE subckt: " + core_module_name));
+    write_spice_subckt_to_file(fp, module_manager, core_module);
+    print_spice_comment(fp, std::string("END Grid core SPICE subckt: " + core_module_name));
+    fp << "\n";
+  }
+
   /* Create a Verilog Module for the top-level physical block, and add to module manager */
   std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_SPICE_FILE_NAME_PREFIX), std::string(phy_block_type->name), is_io_type(phy_block_type), border_side);
   ModuleId grid_module = module_manager.find_module(grid_module_name); 
@@ -319,22 +335,33 @@ void print_spice_physical_tile_netlist(NetlistManager& netlist_manager,
 
   /* Write the spice module */
   print_spice_comment(fp, std::string("BEGIN Grid SPICE subckt: " + module_manager.module_name(grid_module)));
-  write_spice_subckt_to_file(fp, module_manager, grid_module);
+  if (true == module_manager.is_module_alias(grid_module_name)) {
+    /* Merged into an identical module, which is written in another netlist */
+    print_spice_comment(fp, std::string("Module " + grid_module_name + " is merged into identical module " + module_manager.module_name(grid_module)));
+  } else {
+    write_spice_subckt_to_file(fp, module_manager, grid_module);
+  }
 
   print_spice_comment(fp, std::string("END Grid SPICE subckt: " + module_manager.module_name(grid_module)));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  /* Echo status in one message, as physical tiles may be written by multiple threads */
+  if (true == is_io_type(phy_block_type)) {
+    SideManager side_manager(border_side);
+    VTR_LOG("Writing SPICE Netlist '%s' for physical tile '%s' at %s side ...Done\n",
+            spice_fname.c_str(), phy_block_type->name, 
+            side_manager.c_str());
+  } else { 
+    VTR_LOG("Writing SPICE Netlist '%s' for physical_tile '%s'...Done\n",
+            spice_fname.c_str(), phy_block_type->name);
+  }
 
-  VTR_LOG("Done\n");
+  return spice_fname;
 }
 
 /*****************************************************************************
@@ -348,6 +375,7 @@ void print_spice_grids(NetlistManager& netlist_manager,
                        const DeviceContext& device_ctx,
                        const VprDeviceAnnotation& device_annotation,
                        const std::string& subckt_dir,
+                       const size_t& num_threads,
                        const bool& verbose) {
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
@@ -383,6 +411,7 @@ void print_spice_grids(NetlistManager& netlist_manager,
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<std::pair<t_physical_tile_type_ptr, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -399,22 +428,34 @@ void print_spice_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_spice_physical_tile_netlist(netlist_manager,
-                                          module_manager,
-                                          subckt_dir, 
-                                          &physical_tile,
-                                          io_type_side);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       } 
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_spice_physical_tile_netlist(netlist_manager,
-                                        module_manager,
-                                        subckt_dir, 
-                                        &physical_tile,
-                                        NUM_SIDES);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+
+  /* Each physical tile is written to a separated file, which can be done in parallel.
+   * Netlists are added to the netlist manager in the same order as a single-thread run
+   */
+  std::vector<std::string> physical_tile_fnames(physical_tiles.size());
+  parallel_for(physical_tiles.size(), num_threads,
+               [&](const size_t& itile) {
+    physical_tile_fnames[itile] = print_spice_physical_tile_netlist(module_manager,
+                                                                    subckt_dir, 
+                                                                    physical_tiles[itile].first,
+                                                                    physical_tiles[itile].second,
+                                                                    (0 == itile) || (physical_tiles[itile - 1].first != physical_tiles[itile].first));
+  });
+
+  /* Add fname to the netlist name list */
+  for (const std::string& spice_fname : physical_tile_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  }
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
@@ -96,23 +96,16 @@ int print_spice_and_gate_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
   float total_pmos_width = 1. /* TODO: allow users to define gate strength */
                            * tech_lib.model_pn_ratio(tech_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-  float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
+  std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
 
 
   /* Output the PMOS network */
   for (const auto& input_port : input_ports) {
-    for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-      float curr_bin_width = regular_pmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_pmos_bins - 1) 
-         && (0. != last_pmos_bin_width)) {
-        curr_bin_width = last_pmos_bin_width;
-      }
+    for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = pmos_bin_widths[ibin];
 
       status = print_spice_generic_pmos_modeling(fp,
                                                  std::to_string(ibin),
@@ -132,21 +125,14 @@ int print_spice_and_gate_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
   float total_nmos_width = 1. /* TODO: allow users to define gate strength */
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
+  std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
 
   /* Output the NMOS network */
   for (size_t input_id = 0; input_id < input_ports.size(); ++input_id) {
-    for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-      float curr_bin_width = regular_nmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_nmos_bins - 1) 
-         && (0. != last_nmos_bin_width)) {
-        curr_bin_width = last_nmos_bin_width;
-      }
+    for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = nmos_bin_widths[ibin];
 
       /* Depending on the input id, we assign different port names to source/drain */
       std::string source_port_name;
@@ -254,23 +240,16 @@ int print_spice_or_gate_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
   float total_pmos_width = 1. /* TODO: allow users to define gate strength */
                            * tech_lib.model_pn_ratio(tech_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-  float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
+  std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
 
 
   /* Output the PMOS network */
   for (size_t input_id = 0; input_id < input_ports.size(); ++input_id) {
-    for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-      float curr_bin_width = regular_pmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_pmos_bins - 1) 
-         && (0. != last_pmos_bin_width)) {
-        curr_bin_width = last_pmos_bin_width;
-      }
+    for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = pmos_bin_widths[ibin];
 
       /* Depending on the input id, we assign different port names to source/drain */
       std::string source_port_name;
@@ -308,21 +287,14 @@ int print_spice_or_gate_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
   float total_nmos_width = 1. /* TODO: allow users to define gate strength */
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
+  std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
 
   /* Output the NMOS network */
   for (const auto& input_port : input_ports) {
-    for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-      float curr_bin_width = regular_nmos_bin_width;
-      /* For last bin, we need an irregular width */
-      if ((ibin == num_nmos_bins - 1) 
-         && (0. != last_nmos_bin_width)) {
-        curr_bin_width = last_nmos_bin_width;
-      }
+    for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+      const float& curr_bin_width = nmos_bin_widths[ibin];
 
       status = print_spice_generic_nmos_modeling(fp,
                                                  std::to_string(ibin),
@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -40,7 +41,7 @@ int print_spice_submodule_luts(NetlistManager& netlist_manager,
 
   std::string spice_fname = submodule_dir + std::string(LUTS_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -63,7 +64,7 @@ void print_spice_mux_memory_module(const ModuleManager& module_manager,
     write_spice_subckt_to_file(fp, module_manager, mem_module);
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -107,7 +108,7 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
   std::string spice_fname(submodule_dir + std::string(MEMORIES_SPICE_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -177,7 +178,7 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
     write_spice_subckt_to_file(fp, module_manager, mem_module);
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Close the file stream */
@@ -21,6 +21,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
@@ -76,7 +77,7 @@ void generate_spice_mux_branch_subckt(const ModuleManager& module_manager,
     VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
     write_spice_subckt_to_file(fp, module_manager, mux_module);
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -119,7 +120,7 @@ void generate_spice_mux_subckt(const ModuleManager& module_manager,
     VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
     write_spice_subckt_to_file(fp, module_manager, mux_module);
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -152,7 +153,7 @@ int print_spice_submodule_mux_primitives(NetlistManager& netlist_manager,
   std::string spice_fname(submodule_dir + std::string(MUX_PRIMITIVES_SPICE_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -174,9 +175,11 @@ int print_spice_submodule_mux_primitives(NetlistManager& netlist_manager,
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
     /* Create a mux graph for the branch circuit */
     std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
-    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
-      generate_spice_mux_branch_subckt(module_manager, circuit_lib, fp, mux_circuit_model, 
+    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes,
+     * named after the circuit model sharing them
+     */
+    for (const MuxGraph& branch_mux_graph : branch_mux_graphs) {
+      generate_spice_mux_branch_subckt(module_manager, circuit_lib, fp, mux_lib.branch_circuit_model(mux_circuit_model), 
                                        branch_mux_graph,
                                        branch_mux_module_is_outputted);
     }
@@ -210,7 +213,7 @@ int print_spice_submodule_mux_top_subckt(NetlistManager& netlist_manager,
   std::string spice_fname(submodule_dir + std::string(MUXES_SPICE_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
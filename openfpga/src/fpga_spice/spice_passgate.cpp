@@ -77,19 +77,12 @@ int print_spice_pass_transistor_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
   float total_nmos_width = circuit_lib.pass_gate_logic_nmos_size(circuit_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-  for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-    float curr_bin_width = regular_nmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_nmos_bins - 1) 
-       && (0. != last_nmos_bin_width)) {
-      curr_bin_width = last_nmos_bin_width;
-    }
+  std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
+
+  for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = nmos_bin_widths[ibin];
 
     status = print_spice_generic_nmos_modeling(fp,
                                                std::to_string(ibin),
@@ -165,18 +158,11 @@ int print_spice_transmission_gate_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_pmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
   float total_pmos_width = circuit_lib.pass_gate_logic_pmos_size(circuit_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_PMOS);
-  int num_pmos_bins = std::ceil(total_pmos_width / regular_pmos_bin_width);
-  float last_pmos_bin_width = std::fmod(total_pmos_width, regular_pmos_bin_width);
-  for (int ibin = 0; ibin < num_pmos_bins; ++ibin) { 
-    float curr_bin_width = regular_pmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_pmos_bins - 1) 
-       && (0. != last_pmos_bin_width)) {
-      curr_bin_width = last_pmos_bin_width;
-    }
+  std::vector<float> pmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, total_pmos_width);
+  for (size_t ibin = 0; ibin < pmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = pmos_bin_widths[ibin];
 
     status = print_spice_generic_pmos_modeling(fp,
                                                std::to_string(ibin),
@@ -195,19 +181,12 @@ int print_spice_transmission_gate_subckt(std::fstream& fp,
    * Try to size transistors to the max width for each bin
    * The last bin may not reach the max width 
    */
-  float regular_nmos_bin_width = tech_lib.transistor_model_max_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
   float total_nmos_width = circuit_lib.pass_gate_logic_nmos_size(circuit_model)
                            * tech_lib.transistor_model_min_width(tech_model, TECH_LIB_TRANSISTOR_NMOS);
-  int num_nmos_bins = std::ceil(total_nmos_width / regular_nmos_bin_width);
-  float last_nmos_bin_width = std::fmod(total_nmos_width, regular_nmos_bin_width);
-
-  for (int ibin = 0; ibin < num_nmos_bins; ++ibin) { 
-    float curr_bin_width = regular_nmos_bin_width;
-    /* For last bin, we need an irregular width */
-    if ((ibin == num_nmos_bins - 1) 
-       && (0. != last_nmos_bin_width)) {
-      curr_bin_width = last_nmos_bin_width;
-    }
+  std::vector<float> nmos_bin_widths = find_spice_transistor_bin_widths(tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, total_nmos_width);
+
+  for (size_t ibin = 0; ibin < nmos_bin_widths.size(); ++ibin) { 
+    const float& curr_bin_width = nmos_bin_widths[ibin];
 
     status = print_spice_generic_nmos_modeling(fp,
                                                std::to_string(ibin),
@@ -2,6 +2,10 @@
  * This file includes functions that are used for 
  * SPICE generation of FPGA routing architecture (global routing) 
  *********************************************************************/
+#include <string>
+#include <utility>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -9,6 +13,8 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
+#include "openfpga_parallel.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -75,17 +81,16 @@ namespace openfpga {
  *              
  ********************************************************************/
 static 
-void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                      const ModuleManager& module_manager, 
-                                                      const std::string& subckt_dir, 
-                                                      const RRGSB& rr_gsb,
-                                                      const t_rr_type& cb_type) {
+std::string print_spice_routing_connection_box_unique_module(const ModuleManager& module_manager, 
+                                                             const std::string& subckt_dir, 
+                                                             const RRGSB& rr_gsb,
+                                                             const t_rr_type& cb_type) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
   std::string spice_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -100,15 +105,12 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
   write_spice_subckt_to_file(fp, module_manager, cb_module);
  
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return spice_fname;
 }
 
 /*********************************************************************
@@ -175,16 +177,15 @@ void print_spice_routing_connection_box_unique_module(NetlistManager& netlist_ma
  *
  ********************************************************************/
 static 
-void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const std::string& subckt_dir, 
-                                                  const RRGSB& rr_gsb) {
+std::string print_spice_routing_switch_box_unique_module(const ModuleManager& module_manager, 
+                                                         const std::string& subckt_dir, 
+                                                         const RRGSB& rr_gsb) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string spice_fname(subckt_dir + generate_routing_block_netlist_name(SB_SPICE_FILE_NAME_PREFIX, gsb_coordinate, std::string(SPICE_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -201,22 +202,58 @@ void print_spice_routing_switch_box_unique_module(NetlistManager& netlist_manage
   /* Close file handler */
   fp.close();
 
+  return spice_fname;
+}
+
+/********************************************************************
+ * Print the netlists of a list of routing blocks, each to a separated file.
+ * A routing block is a switch block when its type is NUM_RR_TYPES,
+ * otherwise it is a connection block of the given type.
+ *
+ * The netlists are written by a number of threads, which follows
+ * print_verilog_routing_block_netlists() of FPGA-Verilog:
+ * file names are added to the netlist manager in the order of the
+ * routing blocks afterwards, the same as a single-thread run
+ *******************************************************************/
+static 
+void print_spice_routing_block_netlists(NetlistManager& netlist_manager,
+                                        const ModuleManager& module_manager, 
+                                        const std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_blocks,
+                                        const std::string& subckt_dir,
+                                        const FabricSpiceOption& options) {
+  std::vector<std::string> spice_fnames(routing_blocks.size());
+
+  parallel_for(routing_blocks.size(), options.num_threads(),
+               [&](const size_t& iblock) {
+    const RRGSB& rr_gsb = *routing_blocks[iblock].first;
+    const t_rr_type& block_type = routing_blocks[iblock].second;
+    if (NUM_RR_TYPES == block_type) {
+      spice_fnames[iblock] = print_spice_routing_switch_box_unique_module(module_manager,
+                                                                          subckt_dir, 
+                                                                          rr_gsb);
+    } else {
+      spice_fnames[iblock] = print_spice_routing_connection_box_unique_module(module_manager,
+                                                                              subckt_dir, 
+                                                                              rr_gsb, block_type);
+    }
+  });
+
   /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  for (const std::string& spice_fname : spice_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(spice_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * and collect those to be printed as a module 
  *******************************************************************/
 static 
-void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                  const ModuleManager& module_manager, 
-                                                  const DeviceRRGSB& device_rr_gsb,
-                                                  const std::string& subckt_dir,
-                                                  const t_rr_type& cb_type) {
+void collect_spice_flatten_connection_blocks(std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_blocks,
+                                             const DeviceRRGSB& device_rr_gsb,
+                                             const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -230,10 +267,7 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       rr_gsb, cb_type);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, cb_type));
     }
   }
 }
@@ -250,9 +284,10 @@ void print_spice_flatten_connection_block_modules(NetlistManager& netlist_manage
 void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
-                                         const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+                                         const std::string& subckt_dir,
+                                         const FabricSpiceOption& options) {
+  /* Routing blocks are printed in the order of switch blocks, X- and Y-direction connection blocks */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -263,26 +298,18 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager, 
-                                                   subckt_dir, 
-                                                   rr_gsb);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
+  collect_spice_flatten_connection_blocks(routing_blocks, device_rr_gsb, CHANX);
+  collect_spice_flatten_connection_blocks(routing_blocks, device_rr_gsb, CHANY);
 
-  print_spice_flatten_connection_block_modules(netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
-
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
-   */
+  print_spice_routing_block_netlists(netlist_manager,
+                                     module_manager,
+                                     routing_blocks,
+                                     subckt_dir,
+                                     options);
 }
 
 
@@ -297,49 +324,37 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
  * the option compact_routing_hierarchy is turned on!!!
  *******************************************************************/
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
-                                          const ModuleManager& module_manager,
-                                          const DeviceRRGSB& device_rr_gsb,
-                                          const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+                                        const ModuleManager& module_manager,
+                                        const DeviceRRGSB& device_rr_gsb,
+                                        const std::string& subckt_dir,
+                                        const FabricSpiceOption& options) {
+  /* Routing blocks are printed in the order of switch blocks, X- and Y-direction connection blocks */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
+  routing_blocks.reserve(device_rr_gsb.get_num_sb_unique_module()
+                       + device_rr_gsb.get_num_cb_unique_module(CHANX)
+                       + device_rr_gsb.get_num_cb_unique_module(CHANY));
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(netlist_manager,
-                                                 module_manager,
-                                                 subckt_dir, 
-                                                 unique_mirror);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_sb_unique_module(isb), NUM_RR_TYPES));
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager,
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANX);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_cb_unique_module(CHANX, icb), CHANX));
   }
 
-  /* Build unique X-direction connection block modules */
+  /* Build unique Y-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(netlist_manager, 
-                                                     module_manager,
-                                                     subckt_dir, 
-                                                     unique_mirror, CHANY);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_cb_unique_module(CHANY, icb), CHANY));
   }
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-   */
+  print_spice_routing_block_netlists(netlist_manager,
+                                     module_manager,
+                                     routing_blocks,
+                                     subckt_dir,
+                                     options);
+
   VTR_LOG("\n");
 }
 
@@ -71,20 +71,20 @@ BasicPort generate_spice_port_for_module_net(const ModuleManager& module_manager
    * if we have a source module is the current module, this is not local wire 
    */
   for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id == module_manager.net_source_modules(module_id, module_net)[src_id]) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
       /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index = module_manager.net_source_pins(module_id, module_net)[src_id];
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
       return BasicPort(module_manager.module_port(module_id, net_src_port).get_name(), src_pin_index, src_pin_index);
     }
   }
 
   /* Check all the sink modules of the net */
   for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id == module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
       /* Here, this is not a local wire, return the port name of the sink_port */
-      ModulePortId net_sink_port = module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index = module_manager.net_sink_pins(module_id, module_net)[sink_id];
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
       return BasicPort(module_manager.module_port(module_id, net_sink_port).get_name(), sink_pin_index, sink_pin_index);
     }
   }
@@ -96,13 +96,13 @@ BasicPort generate_spice_port_for_module_net(const ModuleManager& module_manager
   VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
 
   /* Get the source module */
-  ModuleId net_src_module = module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
+  ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
   /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_instance = module_manager.net_source_instance(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the port id */
-  ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)]; 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the pin id */
-  size_t net_src_pin = module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
 
   /* Load user-defined name if we have it */
   if (false == module_manager.net_name(module_id, module_net).empty()) {
@@ -136,14 +136,14 @@ void print_spice_subckt_output_short_connection(std::fstream& fp,
 
   /* We have found a module input, now check all the sink modules of the net */
   for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id != sink_module) {
       continue;
     }
 
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+    ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+    size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
     BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
     /* For the first module output, this is the source port, we do nothing and go to the next */
@@ -183,27 +183,27 @@ void print_spice_subckt_local_short_connection(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module = module_manager.net_source_modules(module_id, module_net)[net_src];
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id != src_module) {
       continue;
     }
     /* Find the source port and pin information */
     print_spice_comment(fp, std::string("Net source id " + std::to_string(size_t(net_src))));
-    ModulePortId src_port_id = module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin = module_manager.net_source_pins(module_id, module_net)[net_src];
+    ModulePortId src_port_id = module_manager.net_source_port(module_id, module_net, net_src);
+    size_t src_pin = module_manager.net_source_pin(module_id, module_net, net_src);
     BasicPort src_port(module_manager.module_port(module_id, src_port_id).get_name(), src_pin, src_pin);
 
     /* We have found a module input, now check all the sink modules of the net */
     for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
       if (module_id != sink_module) {
         continue;
       }
 
       /* Find the sink port and pin information */
       print_spice_comment(fp, std::string("Net sink id " + std::to_string(size_t(net_sink))));
-      ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+      ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+      size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
       BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
       /* We need to print a wire connection here */
@@ -375,7 +375,7 @@ void write_spice_instance_to_file(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          fp << "\n";
           new_line = true;
           fit_one_line = false;
         }
@@ -401,7 +401,7 @@ void write_spice_instance_to_file(std::fstream& fp,
   new_line = false;
   if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
     pin_cnt = 0;
-    fp << std::endl;
+    fp << "\n";
     new_line = true;
     fit_one_line = false;
   }
@@ -410,14 +410,14 @@ void write_spice_instance_to_file(std::fstream& fp,
    * if port print cannot fit one line, we create a new line for the module for a clean format
    */
   if (false == fit_one_line) {
-    fp << std::endl;
+    fp << "\n";
     fp << "+";
   }
   write_space_to_file(fp, 1);
   fp << module_manager.module_name(child_module);
   
   /* Print an end to the instance */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -438,10 +438,10 @@ void write_spice_subckt_to_file(std::fstream& fp,
   print_spice_subckt_definition(fp, module_manager, module_id);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print local connection (from module inputs to output! */
   print_spice_comment(fp, std::string("BEGIN Local short connections"));
@@ -453,7 +453,7 @@ void write_spice_subckt_to_file(std::fstream& fp,
  
   print_spice_comment(fp, std::string("END Local output short connections"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print instances */
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
@@ -461,7 +461,7 @@ void write_spice_subckt_to_file(std::fstream& fp,
       /* Print an instance */
       write_spice_instance_to_file(fp, module_manager, module_id, child_module, instance); 
       /* Print an empty line as splitter */
-      fp << std::endl;
+      fp << "\n";
     }
   }
 
@@ -469,7 +469,7 @@ void write_spice_subckt_to_file(std::fstream& fp,
   print_spice_subckt_end(fp, module_manager.module_name(module_id)); 
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
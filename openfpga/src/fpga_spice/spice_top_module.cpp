@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 
@@ -49,7 +50,7 @@ void print_spice_top_module(NetlistManager& netlist_manager,
           spice_fname.c_str());
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(spice_fname.c_str(), fp);
@@ -60,7 +61,7 @@ void print_spice_top_module(NetlistManager& netlist_manager,
   write_spice_subckt_to_file(fp, module_manager, top_module);
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
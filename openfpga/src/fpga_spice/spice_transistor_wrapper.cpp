@@ -4,7 +4,6 @@
  ***********************************************/
 #include <fstream>
 #include <cmath>
-#include <iomanip>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -15,6 +14,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "circuit_library_utils.h"
 
@@ -47,12 +47,16 @@ int print_spice_transistor_model_wrapper(std::fstream& fp,
        itype < NUM_TECH_LIB_TRANSISTOR_TYPES;
        ++itype) {
     const e_tech_lib_transistor_type& trans_type = static_cast<e_tech_lib_transistor_type>(itype); 
-    fp << ".subckt ";
-    fp << tech_lib.transistor_model_name(model, trans_type) << TRANSISTOR_WRAPPER_POSTFIX; 
-    fp << " drain gate source bulk";
-    fp << " L=" << std::setprecision(10) << tech_lib.transistor_model_chan_length(model, trans_type); 
-    fp << " W=" << std::setprecision(10) << tech_lib.transistor_model_min_width(model, trans_type); 
-    fp << "\n";
+    std::string& line = find_spice_line_buffer();
+    line += ".subckt ";
+    line += tech_lib.transistor_model_name(model, trans_type);
+    line += TRANSISTOR_WRAPPER_POSTFIX; 
+    line += " drain gate source bulk";
+    line += " L=";
+    append_spice_float(line, tech_lib.transistor_model_chan_length(model, trans_type)); 
+    line += " W=";
+    append_spice_float(line, tech_lib.transistor_model_min_width(model, trans_type)); 
+    print_spice_line(fp, line);
 
     fp << tech_lib.model_ref(model);
     fp << "1";
@@ -76,7 +80,7 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
                                    const std::string& submodule_dir) {
   std::string spice_fname = submodule_dir + std::string(TRANSISTORS_SPICE_FILE_NAME);
 
-  std::fstream fp;
+  BufferedFileStream fp;
 
   /* Create the file stream */
   fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
@@ -114,6 +118,47 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Split a transistor into bins to compact layout:
+ * Try to size transistors to the max width for each bin
+ * The last bin may not reach the max width 
+ *
+ * The widths are computed once for a transistor, and shared by
+ * all the netlist writers, so that they are always the same
+ * for a given total width 
+ *******************************************************************/
+std::vector<float> find_spice_transistor_bin_widths(const TechnologyLibrary& tech_lib,
+                                                    const TechnologyModelId& tech_model,
+                                                    const e_tech_lib_transistor_type& transistor_type,
+                                                    const float& total_width) {
+  float regular_bin_width = tech_lib.transistor_model_max_width(tech_model, transistor_type);
+  int num_bins = std::ceil(total_width / regular_bin_width);
+  float last_bin_width = std::fmod(total_width, regular_bin_width);
+
+  std::vector<float> bin_widths(num_bins, regular_bin_width);
+  /* For last bin, we need an irregular width */
+  if ((0 < num_bins) && (0. != last_bin_width)) {
+    bin_widths.back() = last_bin_width;
+  }
+  return bin_widths;
+}
+
+/********************************************************************
+ * Append the wrapper of a transistor model and the width of 
+ * a transistor instance to a line, e.g.,
+ *   <model_name>_wrapper W=<width>
+ *******************************************************************/
+void append_spice_transistor_wrapper_model(std::string& line,
+                                           const TechnologyLibrary& tech_lib,
+                                           const TechnologyModelId& tech_model,
+                                           const e_tech_lib_transistor_type& transistor_type,
+                                           const float& trans_width) {
+  line += tech_lib.transistor_model_name(tech_model, transistor_type);
+  line += TRANSISTOR_WRAPPER_POSTFIX; 
+  line += " W=";
+  append_spice_float(line, trans_width);
+}
+
 /********************************************************************
  * Generate the SPICE modeling for the PMOS part of a logic gate
  *
@@ -140,14 +185,20 @@ int print_spice_generic_pmos_modeling(std::fstream& fp,
   }
 
   /* Write transistor pairs using the technology model */
-  fp << "Xpmos_" << trans_name_postfix << " ";
-  fp << input_port_name << " "; 
-  fp << gate_port_name << " "; 
-  fp << output_port_name << " "; 
-  fp << SPICE_SUBCKT_VDD_PORT_NAME << " "; 
-  fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_PMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-  fp << " W=" << std::setprecision(10) << trans_width;
-  fp << "\n";
+  std::string& line = find_spice_line_buffer();
+  line += "Xpmos_";
+  line += trans_name_postfix;
+  line += ' ';
+  line += input_port_name;
+  line += ' '; 
+  line += gate_port_name;
+  line += ' '; 
+  line += output_port_name;
+  line += ' '; 
+  line += SPICE_SUBCKT_VDD_PORT_NAME;
+  line += ' '; 
+  append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_PMOS, trans_width);
+  print_spice_line(fp, line);
 
   return CMD_EXEC_SUCCESS;
 }
@@ -174,14 +225,20 @@ int print_spice_generic_nmos_modeling(std::fstream& fp,
     return CMD_EXEC_FATAL_ERROR;
   }
 
-  fp << "Xnmos_" << trans_name_postfix << " ";
-  fp << input_port_name << " "; 
-  fp << gate_port_name << " "; 
-  fp << output_port_name << " "; 
-  fp << SPICE_SUBCKT_GND_PORT_NAME << " "; 
-  fp << tech_lib.transistor_model_name(tech_model, TECH_LIB_TRANSISTOR_NMOS) << TRANSISTOR_WRAPPER_POSTFIX; 
-  fp << " W=" << std::setprecision(10) << trans_width;
-  fp << "\n";
+  std::string& line = find_spice_line_buffer();
+  line += "Xnmos_";
+  line += trans_name_postfix;
+  line += ' ';
+  line += input_port_name;
+  line += ' '; 
+  line += gate_port_name;
+  line += ' '; 
+  line += output_port_name;
+  line += ' '; 
+  line += SPICE_SUBCKT_GND_PORT_NAME;
+  line += ' '; 
+  append_spice_transistor_wrapper_model(line, tech_lib, tech_model, TECH_LIB_TRANSISTOR_NMOS, trans_width);
+  print_spice_line(fp, line);
 
   return CMD_EXEC_SUCCESS;
 }
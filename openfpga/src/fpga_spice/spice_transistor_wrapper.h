@@ -6,6 +6,7 @@
  *******************************************************************/
 #include <string>
 #include <map>
+#include <vector>
 #include "netlist_manager.h"
 #include "technology_library.h"
 
@@ -20,6 +21,17 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
                                    const TechnologyLibrary& tech_lib,
                                    const std::string& submodule_dir);
 
+std::vector<float> find_spice_transistor_bin_widths(const TechnologyLibrary& tech_lib,
+                                                    const TechnologyModelId& tech_model,
+                                                    const e_tech_lib_transistor_type& transistor_type,
+                                                    const float& total_width);
+
+void append_spice_transistor_wrapper_model(std::string& line,
+                                           const TechnologyLibrary& tech_lib,
+                                           const TechnologyModelId& tech_model,
+                                           const e_tech_lib_transistor_type& transistor_type,
+                                           const float& trans_width);
+
 int print_spice_generic_pmos_modeling(std::fstream& fp,
                                       const std::string& trans_name_postfix,
                                       const std::string& input_port_name,
@@ -3,10 +3,11 @@
  * used Spice writers 
  ***********************************************/
 #include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <ctime>
 #include <string>
 #include <fstream>
-#include <iomanip>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -17,6 +18,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
 
 #include "spice_constants.h"
 #include "spice_writer_utils.h"
@@ -24,6 +26,76 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Number of significant digits of the floating-point numbers in netlists */
+constexpr int SPICE_FLOAT_PRECISION = 10;
+
+/************************************************
+ * Find the line buffer of the calling thread, which is empty
+ * The buffer is reused between the lines, so that formatting
+ * a line does not allocate memory once the buffer is large enough
+ * Each thread has its own buffer, as netlists may be written in parallel,
+ * and a line should be printed before starting another one
+ ***********************************************/
+std::string& find_spice_line_buffer() {
+  static thread_local std::string line;
+  line.clear();
+  return line;
+}
+
+/************************************************
+ * Append a floating-point number to a line
+ * The format is the same as a stream with std::setprecision(10),
+ * i.e., %.10g, so that netlists are not changed.
+ * Integral values, e.g., transistor widths, which are the most common,
+ * are converted without going through printf()
+ ***********************************************/
+void append_spice_float(std::string& line,
+                        const float& value) {
+  /* Below 1e10, an integral value has no more than 10 digits and is printed as an integer */
+  if ((std::fabs(value) < 1e9) && (value == std::trunc(value))) {
+    if (std::signbit(value)) {
+      line += '-';
+    }
+    line += std::to_string(static_cast<long>(std::fabs(value)));
+    return;
+  }
+
+  char str[32];
+  int len = std::snprintf(str, sizeof(str), "%.*g", SPICE_FLOAT_PRECISION, static_cast<double>(value));
+  VTR_ASSERT((0 < len) && (len < int(sizeof(str))));
+  line.append(str, len);
+}
+
+/************************************************
+ * Append a port to a line, see generate_spice_port()
+ ***********************************************/
+void append_spice_port(std::string& line,
+                       const BasicPort& port,
+                       const bool& omit_pin_zero) {
+  VTR_ASSERT(1 == port.get_width());
+
+  line += port.get_name();
+
+  if ((true == omit_pin_zero)
+     && (0 == port.get_lsb())) {
+    return;
+  }
+
+  line += '[';
+  line += std::to_string(port.get_lsb());
+  line += ']';
+}
+
+/************************************************
+ * Write a line formatted in a buffer to a file at once,
+ * with an end of line
+ ***********************************************/
+void print_spice_line(std::fstream& fp,
+                      std::string& line) {
+  line += '\n';
+  fp.write(line.data(), line.size());
+}
+
 /************************************************
  * Generate header comments for a Spice netlist
  * include the description 
@@ -31,18 +103,15 @@ namespace openfpga {
 void print_spice_file_header(std::fstream& fp,
                              const std::string& usage) {
   VTR_ASSERT(true == valid_file_stream(fp));
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "*********************************************" << std::endl;
-  fp << "*\tFPGA-SPICE Netlist" << std::endl;
-  fp << "*\tDescription: " << usage << std::endl;
-  fp << "*\tAuthor: Xifan TANG" << std::endl;
-  fp << "*\tOrganization: University of Utah" << std::endl;
-  fp << "*\tDate: " << std::ctime(&end_time) ;
-  fp << "*********************************************" << std::endl;
-  fp << std::endl;
+
+  fp << "*********************************************" << "\n";
+  fp << "*\tFPGA-SPICE Netlist" << "\n";
+  fp << "*\tDescription: " << usage << "\n";
+  fp << "*\tAuthor: Xifan TANG" << "\n";
+  fp << "*\tOrganization: University of Utah" << "\n";
+  fp << SPICE_FILE_HEADER_DATE_PREFIX << generate_file_time_stamp() ;
+  fp << "*********************************************" << "\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -52,7 +121,7 @@ void print_spice_include_netlist(std::fstream& fp,
                                  const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".include \"" << netlist_name << "\"" << std::endl; 
+  fp << ".include \"" << netlist_name << "\"" << "\n"; 
 }
 
 /************************************************
@@ -63,9 +132,9 @@ void print_spice_comment(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   std::string comment_cover(comment.length() + 4, '*');
-  fp << comment_cover << std::endl;
-  fp << "* " << comment << " *" << std::endl;
-  fp << comment_cover << std::endl;
+  fp << comment_cover << "\n";
+  fp << "* " << comment << " *" << "\n";
+  fp << comment_cover << "\n";
 }
 
 
@@ -77,19 +146,8 @@ void print_spice_comment(std::fstream& fp,
  ***********************************************/
 std::string generate_spice_port(const BasicPort& port,
                                 const bool& omit_pin_zero) {
-  VTR_ASSERT(1 == port.get_width());
-
-  std::string ret = port.get_name();
-
-  if ((true == omit_pin_zero)
-     && (0 == port.get_lsb())) {
-    return ret;
-  }
-
-  ret += "[";
-  ret += std::to_string(port.get_lsb());
-  ret += "]";
-
+  std::string ret;
+  append_spice_port(ret, port, omit_pin_zero);
   return ret;
 }
 
@@ -106,8 +164,10 @@ void print_spice_subckt_definition(std::fstream& fp,
 
   print_spice_comment(fp, std::string("SPICE module for " + module_manager.module_name(module_id)));
 
+  /* The definition is formatted in a line buffer, including its continuation lines */
+  std::string& line = find_spice_line_buffer();
   std::string module_head_line = ".subckt " + module_manager.module_name(module_id) + " ";
-  fp << module_head_line;
+  line += module_head_line;
 
   /* Port sequence: global, inout, input, output and clock ports, */
   bool new_line = false;
@@ -123,12 +183,12 @@ void print_spice_subckt_definition(std::fstream& fp,
       for (const auto& pin : port.pins()) {
 
         if (true == new_line) {
-          std::string port_whitespace(module_head_line.length() - 2, ' ');
-          fp << "+ " << port_whitespace;
+          line += "+ ";
+          line.append(module_head_line.length() - 2, ' ');
         }
  
         if (0 != pin_cnt) {
-          write_space_to_file(fp, 1);
+          line += ' ';
         }
         
         BasicPort port_pin(port.get_name(), pin, pin);
@@ -141,7 +201,7 @@ void print_spice_subckt_definition(std::fstream& fp,
            && (0 == pin)) {
           omit_pin_zero = true;
         }
-        fp << generate_spice_port(port_pin, omit_pin_zero);
+        append_spice_port(line, port_pin, omit_pin_zero);
 
         /* Increase the counter */
         pin_cnt++;
@@ -150,7 +210,7 @@ void print_spice_subckt_definition(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          line += '\n';
           new_line = true;
         }
       }
@@ -163,16 +223,16 @@ void print_spice_subckt_definition(std::fstream& fp,
      * TODO: the supply ports should be derived from module manager
      */
     if (true == new_line) {
-      std::string port_whitespace(module_head_line.length() - 2, ' ');
-      fp << "+ " << port_whitespace;
+      line += "+ ";
+      line.append(module_head_line.length() - 2, ' ');
     }
-    write_space_to_file(fp, 1);
-    fp << SPICE_SUBCKT_VDD_PORT_NAME;
-    write_space_to_file(fp, 1);
-    fp << SPICE_SUBCKT_GND_PORT_NAME;
+    line += ' ';
+    line += SPICE_SUBCKT_VDD_PORT_NAME;
+    line += ' ';
+    line += SPICE_SUBCKT_GND_PORT_NAME;
   }
 
-  fp << std::endl;
+  print_spice_line(fp, line);
 }
 
 /************************************************
@@ -182,9 +242,9 @@ void print_spice_subckt_end(std::fstream& fp,
                             const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << ".ends" << std::endl;
+  fp << ".ends" << "\n";
   print_spice_comment(fp, std::string("***** END SPICE module for " + module_name + " *****"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /************************************************
@@ -197,11 +257,18 @@ void print_spice_resistor(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Set an unique name to the resistor */
-  fp << "R" << input_port << "_to_"  << output_port;
-  fp << " " << input_port;
-  fp << " " << output_port;
-  fp << " " << std::setprecision(10) << resistance;
-  fp << std::endl;
+  std::string& line = find_spice_line_buffer();
+  line += 'R';
+  line += input_port;
+  line += "_to_";
+  line += output_port;
+  line += ' ';
+  line += input_port;
+  line += ' ';
+  line += output_port;
+  line += ' ';
+  append_spice_float(line, resistance);
+  print_spice_line(fp, line);
 }
 
 /************************************************
@@ -214,11 +281,18 @@ void print_spice_capacitor(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Set an unique name to the capacitor */
-  fp << "C" << input_port << "_to_"  << output_port;
-  fp << " " << input_port;
-  fp << " " << output_port;
-  fp << " " << std::setprecision(10) << capacitance;
-  fp << std::endl;
+  std::string& line = find_spice_line_buffer();
+  line += 'C';
+  line += input_port;
+  line += "_to_";
+  line += output_port;
+  line += ' ';
+  line += input_port;
+  line += ' ';
+  line += output_port;
+  line += ' ';
+  append_spice_float(line, capacitance);
+  print_spice_line(fp, line);
 }
 
 /************************************************
@@ -261,9 +335,12 @@ void print_spice_subckt_instance(std::fstream& fp,
     VTR_ASSERT(ModulePortId::INVALID() != module_port_id);
   }
 
-  /* Print instance name */
+  /* Print instance name
+   * The instance is formatted in a line buffer, including its continuation lines 
+   */
+  std::string& line = find_spice_line_buffer();
   std::string instance_head_line = "X " + instance_name + " ";
-  fp << instance_head_line;
+  line += instance_head_line;
   
   /* Port sequence: global, inout, input, output and clock ports, */
   bool fit_one_line = true;
@@ -292,12 +369,12 @@ void print_spice_subckt_instance(std::fstream& fp,
       for (const auto& pin : port_to_print.pins()) {
 
         if (true == new_line) {
-          std::string port_whitespace(instance_head_line.length() - 2, ' ');
-          fp << "+ " << port_whitespace;
+          line += "+ ";
+          line.append(instance_head_line.length() - 2, ' ');
         }
  
         if (0 != pin_cnt) {
-          write_space_to_file(fp, 1);
+          line += ' ';
         }
         
         BasicPort port_pin(port.get_name(), pin, pin);
@@ -311,7 +388,7 @@ void print_spice_subckt_instance(std::fstream& fp,
           omit_pin_zero = true;
         }
 
-        fp << generate_spice_port(port_pin, omit_pin_zero);
+        append_spice_port(line, port_pin, omit_pin_zero);
 
         /* Increase the counter */
         pin_cnt++;
@@ -320,7 +397,7 @@ void print_spice_subckt_instance(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          line += '\n';
           new_line = true;
           fit_one_line = false;
         }
@@ -332,13 +409,13 @@ void print_spice_subckt_instance(std::fstream& fp,
    * TODO: the supply ports should be derived from module manager
    */
   if (true == new_line) {
-    std::string port_whitespace(instance_head_line.length() - 2, ' ');
-    fp << "+ " << port_whitespace;
+    line += "+ ";
+    line.append(instance_head_line.length() - 2, ' ');
   }
-  write_space_to_file(fp, 1);
-  fp << SPICE_SUBCKT_VDD_PORT_NAME;
-  write_space_to_file(fp, 1);
-  fp << SPICE_SUBCKT_GND_PORT_NAME;
+  line += ' ';
+  line += SPICE_SUBCKT_VDD_PORT_NAME;
+  line += ' ';
+  line += SPICE_SUBCKT_GND_PORT_NAME;
 
   pin_cnt += 2;
 
@@ -346,7 +423,7 @@ void print_spice_subckt_instance(std::fstream& fp,
   new_line = false;
   if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
     pin_cnt = 0;
-    fp << std::endl;
+    line += '\n';
     new_line = true;
     fit_one_line = false;
   }
@@ -355,14 +432,14 @@ void print_spice_subckt_instance(std::fstream& fp,
    * if port print cannot fit one line, we create a new line for the module for a clean format
    */
   if (false == fit_one_line) {
-    fp << std::endl;
-    fp << "+";
+    line += '\n';
+    line += '+';
   }
-  write_space_to_file(fp, 1);
-  fp << module_manager.module_name(module_id);
+  line += ' ';
+  line += module_manager.module_name(module_id);
   
   /* Print an end to the instance */
-  fp << std::endl;
+  print_spice_line(fp, line);
 }
 
 } /* end namespace openfpga */
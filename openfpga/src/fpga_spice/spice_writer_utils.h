@@ -26,10 +26,23 @@ namespace openfpga {
 /* Tips: for naming your function in this header/source file
  * If a function outputs to a file, its name should begin with "print_spice"
  * If a function creates a string without outputting to a file, its name should begin with "generate_spice"
+ * If a function appends to a line buffer, its name should begin with "append_spice"
  * Please show respect to this naming convention, in order to keep a clean header/source file
  * as well maintain a easy way to identify the functions
  */
 
+std::string& find_spice_line_buffer();
+
+void append_spice_float(std::string& line,
+                        const float& value);
+
+void append_spice_port(std::string& line,
+                       const BasicPort& port,
+                       const bool& omit_pin_zero = false);
+
+void print_spice_line(std::fstream& fp,
+                      std::string& line);
+
 void print_spice_file_header(std::fstream& fp,
                              const std::string& usage);
 
@@ -19,6 +19,11 @@ FabricVerilogOption::FabricVerilogOption() {
   compress_routing_ = false;
   print_user_defined_template_ = false;
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
+  num_threads_ = 1;
+  incremental_ = false;
+  compact_top_module_ = false;
+  fast_sim_models_ = false;
+  verilator_friendly_ = false;
   verbose_output_ = false;
 }
 
@@ -49,6 +54,27 @@ e_verilog_default_net_type FabricVerilogOption::default_net_type() const {
   return default_net_type_;
 }
 
+size_t FabricVerilogOption::num_threads() const {
+  return num_threads_;
+}
+
+bool FabricVerilogOption::incremental() const {
+  return incremental_;
+}
+
+bool FabricVerilogOption::compact_top_module() const {
+  return compact_top_module_;
+}
+
+bool FabricVerilogOption::fast_sim_models() const {
+  /* Compiled simulators always use the behavioral models of multiplexers */
+  return fast_sim_models_ || verilator_friendly_;
+}
+
+bool FabricVerilogOption::verilator_friendly() const {
+  return verilator_friendly_;
+}
+
 bool FabricVerilogOption::verbose_output() const {
   return verbose_output_;
 }
@@ -90,6 +116,26 @@ void FabricVerilogOption::set_default_net_type(const std::string& default_net_ty
   }
 }
 
+void FabricVerilogOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void FabricVerilogOption::set_incremental(const bool& enabled) {
+  incremental_ = enabled;
+}
+
+void FabricVerilogOption::set_compact_top_module(const bool& enabled) {
+  compact_top_module_ = enabled;
+}
+
+void FabricVerilogOption::set_fast_sim_models(const bool& enabled) {
+  fast_sim_models_ = enabled;
+}
+
+void FabricVerilogOption::set_verilator_friendly(const bool& enabled) {
+  verilator_friendly_ = enabled;
+}
+
 void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
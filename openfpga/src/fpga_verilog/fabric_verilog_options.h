@@ -24,6 +24,11 @@ class FabricVerilogOption {
     bool compress_routing() const;
     e_verilog_default_net_type default_net_type() const;
     bool print_user_defined_template() const;
+    size_t num_threads() const;
+    bool incremental() const;
+    bool compact_top_module() const;
+    bool fast_sim_models() const;
+    bool verilator_friendly() const;
     bool verbose_output() const;
   public: /* Public mutators */
     void set_output_directory(const std::string& output_dir);
@@ -32,6 +37,11 @@ class FabricVerilogOption {
     void set_compress_routing(const bool& enabled);
     void set_print_user_defined_template(const bool& enabled);
     void set_default_net_type(const std::string& default_net_type);
+    void set_num_threads(const size_t& num_threads);
+    void set_incremental(const bool& enabled);
+    void set_compact_top_module(const bool& enabled);
+    void set_fast_sim_models(const bool& enabled);
+    void set_verilator_friendly(const bool& enabled);
     void set_verbose_output(const bool& enabled);
   private: /* Internal Data */
     std::string output_directory_;
@@ -40,6 +50,11 @@ class FabricVerilogOption {
     bool compress_routing_;
     bool print_user_defined_template_;
     e_verilog_default_net_type default_net_type_;
+    size_t num_threads_;
+    bool incremental_;
+    bool compact_top_module_;
+    bool fast_sim_models_;
+    bool verilator_friendly_;
     bool verbose_output_;
 };
 
@@ -14,6 +14,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_naming.h"
 
 #include "device_rr_gsb.h"
 #include "verilog_constants.h"
@@ -29,6 +30,7 @@
 #include "verilog_simulation_info_writer.h"
 
 /* Header file for this source file */
+#include "netlist_write_profiler.h"
 #include "verilog_api.h"
 
 /* begin namespace openfpga */
@@ -86,6 +88,12 @@ void fpga_fabric_verilog(ModuleManager &module_manager,
   print_verilog_preprocessing_flags_netlist(std::string(src_dir_path),
                                             options);
 
+  /* Print the configuration of compiled simulation with Verilator */
+  if (true == options.verilator_friendly()) {
+    print_verilator_config_file(std::string(src_dir_path),
+                                options.incremental());
+  }
+
   /* Generate primitive Verilog modules, which are corner stones of FPGA fabric
    * Note that this function MUST be called before Verilog generation of
    * core logic (i.e., logic blocks and routing resources) !!!
@@ -93,45 +101,58 @@ void fpga_fabric_verilog(ModuleManager &module_manager,
    * the module manager.
    * Without the modules in the module manager, core logic generation is not possible!!!
    */
-  print_verilog_submodule(module_manager, netlist_manager,
-                          mux_lib, decoder_lib, circuit_lib,
-                          submodule_dir_path,
-                          options);
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "submodules", std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
+    print_verilog_submodule(module_manager, netlist_manager,
+                            mux_lib, decoder_lib, circuit_lib,
+                            submodule_dir_path,
+                            options);
+  }
 
   /* Generate routing blocks */
-  if (true == options.compress_routing()) {
-    print_verilog_unique_routing_modules(netlist_manager,
-                                         const_cast<const ModuleManager &>(module_manager),
-                                         device_rr_gsb,
-                                         rr_dir_path,
-                                         options);
-  } else {
-    VTR_ASSERT(false == options.compress_routing());
-    print_verilog_flatten_routing_modules(netlist_manager,
-                                          const_cast<const ModuleManager &>(module_manager),
-                                          device_rr_gsb,
-                                          rr_dir_path,
-                                          options);
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "routing", std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
+    if (true == options.compress_routing()) {
+      print_verilog_unique_routing_modules(netlist_manager,
+                                           const_cast<const ModuleManager &>(module_manager),
+                                           device_rr_gsb,
+                                           rr_dir_path,
+                                           options);
+    } else {
+      VTR_ASSERT(false == options.compress_routing());
+      print_verilog_flatten_routing_modules(netlist_manager,
+                                            const_cast<const ModuleManager &>(module_manager),
+                                            device_rr_gsb,
+                                            rr_dir_path,
+                                            options);
+    }
   }
 
   /* Generate grids */
-  print_verilog_grids(netlist_manager,
-                      const_cast<const ModuleManager &>(module_manager),
-                      device_ctx, device_annotation,
-                      lb_dir_path,
-                      options,
-                      options.verbose_output());
-
-  /* Generate FPGA fabric */
-  print_verilog_top_module(netlist_manager,
-                           const_cast<const ModuleManager &>(module_manager),
-                           src_dir_path,
-                           options);
+  {
+    NetlistWriteProfiler profiler(netlist_manager, "grids", std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
+    print_verilog_grids(netlist_manager,
+                        const_cast<const ModuleManager &>(module_manager),
+                        device_ctx, device_annotation,
+                        lb_dir_path,
+                        options,
+                        options.verbose_output());
+  }
+
+  /* Generate FPGA fabric, unless only a part of the fabric is built without the top-level module */
+  if (true == module_manager.valid_module_id(module_manager.find_module(generate_fpga_top_module_name()))) {
+    NetlistWriteProfiler profiler(netlist_manager, "top_module", std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
+    print_verilog_top_module(netlist_manager,
+                             const_cast<const ModuleManager &>(module_manager),
+                             src_dir_path,
+                             options);
+  }
 
   /* Generate an netlist including all the fabric-related netlists */
   print_verilog_fabric_include_netlist(const_cast<const NetlistManager &>(netlist_manager),
                                        src_dir_path,
-                                       circuit_lib);
+                                       circuit_lib,
+                                       options.incremental());
 
   /* Given a brief stats on how many Verilog modules have been written to files */
   VTR_LOGV(options.verbose_output(),
@@ -174,9 +195,19 @@ int fpga_verilog_full_testbench(const ModuleManager &module_manager,
   print_verilog_simulation_preprocessing_flags(std::string(src_dir_path),
                                                options);
 
+  /* The backdoor is only available for configuration chains */
+  std::string config_backdoor_file_path;
+  if (true == options.config_backdoor()) {
+    if (CONFIG_MEM_SCAN_CHAIN == config_protocol.type()) {
+      config_backdoor_file_path = src_dir_path + netlist_name + std::string(CONFIG_BACKDOOR_MEMORY_FILE_POSTFIX);
+    } else {
+      VTR_LOG_WARN("Configuration backdoor is only applicable to configuration chains, and is ignored!\n");
+    }
+  }
+
   /* Generate full testbench for verification, including configuration phase and operating phase */
   std::string top_testbench_file_path = src_dir_path + netlist_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX);
-  print_verilog_full_testbench(module_manager,
+  status = print_verilog_full_testbench(module_manager,
                               bitstream_manager, fabric_bitstream,
                               circuit_lib,
                               config_protocol,
@@ -184,6 +215,7 @@ int fpga_verilog_full_testbench(const ModuleManager &module_manager,
                               atom_ctx, place_ctx,
                               pin_constraints,
                               bitstream_file,
+                              config_backdoor_file_path,
                               io_location_map,
                               netlist_annotation,
                               netlist_name,
@@ -197,6 +229,11 @@ int fpga_verilog_full_testbench(const ModuleManager &module_manager,
                                            options.fabric_netlist_file_path(),
                                            options.reference_benchmark_file_path());
 
+  /* Generate the C++ harness to run the testbench compiled by Verilator */
+  if (true == options.verilator_friendly()) {
+    print_verilator_testbench_harness(src_dir_path, netlist_name);
+  }
+
   return status;
 }
 
@@ -230,6 +267,11 @@ int fpga_verilog_preconfigured_fabric_wrapper(const ModuleManager &module_manage
 
   /* Generate wrapper module for FPGA fabric (mapped by the input benchmark and pre-configured testbench for verification */
   std::string formal_verification_top_netlist_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX);
+  /* The bitstream memory file is kept aside the wrapper netlist, if required */
+  std::string bitstream_memory_file_path;
+  if (true == options.bitstream_memory_file()) {
+    bitstream_memory_file_path = src_dir_path + netlist_name + std::string(FORMAL_VERIFICATION_BITSTREAM_MEMORY_FILE_POSTFIX);
+  }
   status = print_verilog_preconfig_top_module(module_manager, bitstream_manager,
                                               config_protocol,
                                               circuit_lib, fabric_global_port_info,
@@ -239,6 +281,7 @@ int fpga_verilog_preconfigured_fabric_wrapper(const ModuleManager &module_manage
                                               netlist_annotation,
                                               netlist_name,
                                               formal_verification_top_netlist_file_path,
+                                              bitstream_memory_file_path,
                                               options);
 
   return status;
@@ -301,6 +344,7 @@ int fpga_verilog_preconfigured_testbench(const ModuleManager &module_manager,
  ********************************************************************/
 int fpga_verilog_simulation_task_info(const ModuleManager &module_manager,
                                       const BitstreamManager &bitstream_manager,
+                                      const FabricBitstream &fabric_bitstream,
                                       const AtomContext &atom_ctx,
                                       const PlacementContext &place_ctx,
                                       const IoLocationMap &io_location_map,
@@ -322,6 +366,14 @@ int fpga_verilog_simulation_task_info(const ModuleManager &module_manager,
   /* Generate exchangeable files which contains simulation settings */
   std::string simulation_ini_file_name = options.simulation_ini_path();
   VTR_ASSERT(true != options.simulation_ini_path().empty());
+
+  /* The configuration clock cycles estimate the runtime of each simulation shard */
+  size_t num_config_clock_cycles = calculate_num_config_clock_cycles(config_protocol.type(),
+                                                                     false,
+                                                                     false,
+                                                                     bitstream_manager,
+                                                                     fabric_bitstream);
+
   print_verilog_simulation_info(simulation_ini_file_name,
                                 netlist_name,
                                 src_dir_path,
@@ -331,7 +383,11 @@ int fpga_verilog_simulation_task_info(const ModuleManager &module_manager,
                                 bitstream_manager.num_bits(),
                                 simulation_setting.num_clock_cycles(),
                                 simulation_setting.programming_clock_frequency(),
-                                simulation_setting.default_operating_clock_frequency());
+                                simulation_setting.default_operating_clock_frequency(),
+                                options.random_seed(),
+                                options.num_random_partitions(),
+                                options.num_simulation_shards(),
+                                num_config_clock_cycles);
 
   return status;
 }
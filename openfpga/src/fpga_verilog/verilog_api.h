@@ -80,6 +80,7 @@ int fpga_verilog_preconfigured_testbench(const ModuleManager &module_manager,
 
 int fpga_verilog_simulation_task_info(const ModuleManager &module_manager,
                                       const BitstreamManager &bitstream_manager,
+                                      const FabricBitstream &fabric_bitstream,
                                       const AtomContext &atom_ctx,
                                       const PlacementContext &place_ctx,
                                       const IoLocationMap &io_location_map,
@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 
 #include "openfpga_naming.h"
 #include "circuit_library_utils.h"
@@ -32,11 +33,12 @@ namespace openfpga {
  *******************************************************************/
 void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir,
-                                          const CircuitLibrary& circuit_lib) {
+                                          const CircuitLibrary& circuit_lib,
+                                          const bool& incremental) {
   std::string verilog_fname = src_dir + std::string(FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -169,7 +171,7 @@ void print_verilog_preprocessing_flags_netlist(const std::string& src_dir,
   std::string verilog_fname = src_dir + std::string(DEFINES_VERILOG_FILE_NAME);
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(fabric_verilog_opts.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
@@ -184,6 +186,12 @@ void print_verilog_preprocessing_flags_netlist(const std::string& src_dir,
     fp << std::endl;
   } 
 
+  /* To use the behavioral models of multiplexers */
+  if (true == fabric_verilog_opts.fast_sim_models()) {
+    print_verilog_define_flag(fp, std::string(VERILOG_FAST_SIM_MODELS_PREPROC_FLAG), 1);
+    fp << std::endl;
+  } 
+
   /* Close the file stream */
   fp.close();
 }
@@ -247,4 +255,97 @@ void print_verilog_simulation_preprocessing_flags(const std::string& src_dir,
   fp.close();
 }
 
+/********************************************************************
+ * Print a Verilator configuration file which waives the warnings 
+ * that are expected on FPGA fabric netlists, so that they can be 
+ * compiled as they are, e.g.,
+ *   verilator fabric_verilator.vlt fabric_netlists.v ...
+ * - The routing multiplexers may form combinational loops
+ *   when they are not configured
+ * - The configuration memories may be modeled by latches
+ *******************************************************************/
+void print_verilator_config_file(const std::string& src_dir,
+                                 const bool& incremental) {
+  std::string config_fname = src_dir + std::string(VERILATOR_CONFIG_FILE_NAME);
+
+  /* Create the file stream */
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
+  fp.open(config_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(config_fname.c_str(), fp);
+
+  /* Print the title, without the time scale of Verilog file headers */
+  fp << "//\tDescription: Verilator configuration for FPGA fabric netlists" << std::endl;
+  fp << std::endl;
+
+  fp << "`verilator_config" << std::endl;
+  fp << std::endl;
+  fp << "lint_off -rule UNOPTFLAT" << std::endl;
+  fp << "lint_off -rule LATCH" << std::endl;
+
+  /* Close the file stream */
+  fp.close();
+}
+
+/********************************************************************
+ * Print a C++ harness to run a full testbench compiled by Verilator
+ * The testbench has no ports and is driven by its own delays,
+ * so the harness only advances the time until the testbench finishes.
+ * The plusargs of the testbench, e.g., +random_seed=<int>,
+ * are given on the command line of the simulator
+ *******************************************************************/
+void print_verilator_testbench_harness(const std::string& src_dir,
+                                       const std::string& circuit_name) {
+  std::string harness_fname = src_dir + circuit_name + std::string(VERILATOR_HARNESS_FILE_POSTFIX);
+  std::string testbench_name = circuit_name + std::string(AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX);
+  std::string model_name = std::string("V") + testbench_name;
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(harness_fname, std::fstream::out | std::fstream::trunc);
+
+  /* Validate the file stream */
+  check_file_stream(harness_fname.c_str(), fp);
+
+  /* Print the title */
+  fp << "//\tDescription: Verilator harness of the full testbench '" << testbench_name << "'" << std::endl;
+  fp << "// Build and run, e.g.," << std::endl;
+  fp << "//   verilator --cc --exe --build --timing --threads <num_threads> -j 0" << std::endl;
+  fp << "//     --top-module " << testbench_name << " " << VERILATOR_CONFIG_FILE_NAME << std::endl; 
+  fp << "//     " << circuit_name << TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX;
+  fp << " " << circuit_name << VERILATOR_HARNESS_FILE_POSTFIX << std::endl;
+  fp << "//   obj_dir/" << model_name << " +" << VERILOG_TESTBENCH_RANDOM_SEED_NAME << "=<int>" << std::endl;
+  fp << std::endl;
+
+  fp << "#include <memory>" << std::endl;
+  fp << std::endl;
+  fp << "#include \"verilated.h\"" << std::endl;
+  fp << "#include \"" << model_name << ".h\"" << std::endl;
+  fp << std::endl;
+
+  fp << "int main(int argc, char** argv) {" << std::endl;
+  fp << "  const std::unique_ptr<VerilatedContext> context{new VerilatedContext};" << std::endl;
+  fp << "  context->commandArgs(argc, argv);" << std::endl;
+  fp << std::endl;
+  fp << "  const std::unique_ptr<" << model_name << "> testbench{new " << model_name << "{context.get()}};" << std::endl;
+  fp << std::endl;
+  fp << "  while (!context->gotFinish()) {" << std::endl;
+  fp << "    testbench->eval();" << std::endl;
+  fp << "    if (!testbench->eventsPending()) {" << std::endl;
+  fp << "      break;" << std::endl;
+  fp << "    }" << std::endl;
+  fp << "    context->time(testbench->nextTimeSlot());" << std::endl;
+  fp << "  }" << std::endl;
+  fp << std::endl;
+  fp << "  testbench->final();" << std::endl;
+  fp << std::endl;
+  fp << "  /* The testbench calls $finish at the end of the simulation */" << std::endl;
+  fp << "  return context->gotFinish() ? 0 : 1;" << std::endl;
+  fp << "}" << std::endl;
+
+  /* Close the file stream */
+  fp.close();
+}
+
 } /* end namespace openfpga */
@@ -19,7 +19,8 @@ namespace openfpga {
 
 void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir,
-                                          const CircuitLibrary& circuit_lib);
+                                          const CircuitLibrary& circuit_lib,
+                                          const bool& incremental);
 
 void print_verilog_testbench_include_netlists(const std::string& src_dir,
                                               const std::string& circuit_name,
@@ -32,6 +33,12 @@ void print_verilog_preprocessing_flags_netlist(const std::string& src_dir,
 void print_verilog_simulation_preprocessing_flags(const std::string& src_dir,
                                                   const VerilogTestbenchOption& verilog_testbench_opts);
 
+void print_verilator_config_file(const std::string& src_dir,
+                                 const bool& incremental);
+
+void print_verilator_testbench_harness(const std::string& src_dir,
+                                       const std::string& circuit_name);
+
 } /* end namespace openfpga */
 
 #endif 
@@ -1,14 +1,18 @@
 #ifndef VERILOG_CONSTANTS_H
 #define VERILOG_CONSTANTS_H
 
+#include <cstddef>
+
 /* global parameters for dumping synthesizable verilog */
 
 constexpr char* VERILOG_NETLIST_FILE_POSTFIX = ".v";
+constexpr char* VERILOG_FILE_HEADER_DATE_PREFIX = "//\tDate: "; // the line of time stamp in file headers, which is ignored when comparing netlists
 constexpr float VERILOG_SIM_TIMESCALE = 1e-9; // Verilog Simulation time scale (minimum time unit) : 1ns
 
 constexpr char* VERILOG_TIMING_PREPROC_FLAG = "ENABLE_TIMING"; // the flag to enable timing definition during compilation
 constexpr char* VERILOG_SIGNAL_INIT_PREPROC_FLAG = "ENABLE_SIGNAL_INITIALIZATION"; // the flag to enable signal initialization during compilation
 constexpr char* VERILOG_FORMAL_VERIFICATION_PREPROC_FLAG = "ENABLE_FORMAL_VERIFICATION"; // the flag to enable formal verification during compilation
+constexpr char* VERILOG_FAST_SIM_MODELS_PREPROC_FLAG = "ENABLE_FAST_SIM_MODELS"; // the flag to use the behavioral models of multiplexers for fast simulation
 constexpr char* INITIAL_SIMULATION_FLAG = "INITIAL_SIMULATION"; // the flag to enable initial functional verification
 constexpr char* AUTOCHECKED_SIMULATION_FLAG = "AUTOCHECKED_SIMULATION"; // the flag to enable autochecked functional verification
 constexpr char* FORMAL_SIMULATION_FLAG = "FORMAL_SIMULATION"; // the flag to enable formal functional verification
@@ -19,13 +23,23 @@ constexpr char* MODELSIM_SIMULATION_TIME_UNIT = "ms";
 constexpr char* ICARUS_SIMULATOR_FLAG = "ICARUS_SIMULATOR"; // the flag to enable specific Verilog code in testbenches
 // End of Icarus variables and flag
 
+constexpr char* VERILOG_TESTBENCH_RANDOM_SEED_NAME = "random_seed"; // the seed of random stimulus, which can be overwritten by a plusarg of the same name
+constexpr int VERILOG_TESTBENCH_DEFAULT_RANDOM_SEED = 0;
+constexpr char* VERILOG_TESTBENCH_OUTPUT_VECTOR_PREFIX = "tb_outputs"; // the prefix of the vectors packing all the benchmark outputs, followed by the postfix of the output ports
+constexpr size_t VERILOG_RANDOM_WORD_SIZE = 32; // the number of bits generated by each call to $random
+
 constexpr char* FABRIC_INCLUDE_VERILOG_NETLIST_FILE_NAME = "fabric_netlists.v";
 constexpr char* TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX = "_include_netlists.v";
 constexpr char* VERILOG_TOP_POSTFIX = "_top.v";
 constexpr char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX = "_top_formal_verification.v"; 
+constexpr char* FORMAL_VERIFICATION_BITSTREAM_MEMORY_FILE_POSTFIX = "_top_formal_verification_bitstream.mem"; 
+constexpr char* CONFIG_BACKDOOR_MEMORY_FILE_POSTFIX = "_config_backdoor.mem"; 
 constexpr char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix */ 
 constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_autocheck_top_tb.v"; /* !!! must be consist with the modelsim_autocheck_testbench_module_postfix */ 
+constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX = "_autocheck_top_tb";
 constexpr char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX = "_formal_random_top_tb.v"; 
+constexpr char* VERILATOR_CONFIG_FILE_NAME = "fabric_verilator.vlt"; // the configuration file waiving the Verilator warnings on fabric netlists
+constexpr char* VERILATOR_HARNESS_FILE_POSTFIX = "_verilator_main.cpp"; // the C++ harness running the full testbench compiled by Verilator
 constexpr char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
 constexpr char* DEFINES_VERILOG_SIMULATION_FILE_NAME = "define_simulation.v";
 constexpr char* SUBMODULE_VERILOG_FILE_NAME = "sub_module.v";
@@ -44,6 +58,8 @@ constexpr char* USER_DEFINED_TEMPLATE_VERILOG_FILE_NAME = "user_defined_template
 
 constexpr char* VERILOG_MUX_BASIS_POSTFIX = "_basis";
 constexpr char* VERILOG_MEM_POSTFIX = "_mem";
+constexpr char* VERILOG_WIRE_ARRAY_POSTFIX = "_array"; // the postfix of wire arrays and instance arrays in compact modules
+constexpr char* VERILOG_INSTANCE_ARRAY_GENVAR = "iarray"; // the loop variable of instance arrays in compact modules
 
 constexpr char* SB_VERILOG_FILE_NAME_PREFIX = "sb_";
 constexpr char* LOGICAL_MODULE_VERILOG_FILE_NAME_PREFIX = "logical_tile_";
@@ -52,6 +68,7 @@ constexpr char* GRID_VERILOG_FILE_NAME_PREFIX = "grid_";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_POSTFIX = "_top_formal_verification";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX = "_fm";
 constexpr char* FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME = "U0_formal_verification";
+constexpr char* FORMAL_VERIFICATION_BITSTREAM_MEMORY_NAME = "bitstream_mem";
 
 constexpr char* FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX = "_top_formal_verification_random_tb";
 
@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 #include "openfpga_decode.h"
 
 #include "decoder_library_utils.h"
@@ -19,6 +20,7 @@
 
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
+#include "verilog_module_writer.h"
 #include "verilog_decoders.h"
 
 /* begin namespace openfpga */
@@ -112,19 +114,19 @@ void print_verilog_mux_local_decoder_module(std::fstream& fp,
    * The rest of addr codes 3'b110, 3'b111 will be decoded to data=8'b0_0000;
    */
 
-  fp << "\t" << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
-  fp << "\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << "\t" << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")\n";
+  fp << "\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(i, data_size)); 
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
   fp << "\t\t" << "default : ";
   fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size - 1, data_size)); 
-  fp << ";" << std::endl;
-  fp << "\t" << "endcase" << std::endl;
+  fp << ";\n";
+  fp << "\t" << "endcase\n";
 
   print_verilog_wire_connection(fp, data_inv_port, data_port, true);
   
@@ -166,11 +168,12 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
                                                 const MuxLibrary& mux_lib,
                                                 const CircuitLibrary& circuit_lib,
                                                 const std::string& submodule_dir,
-                                                const e_verilog_default_net_type& default_net_type) {
+                                                const e_verilog_default_net_type& default_net_type,
+                                                const bool& incremental) {
   std::string verilog_fname(submodule_dir + std::string(LOCAL_ENCODER_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -305,15 +308,15 @@ void print_verilog_arch_decoder_module(std::fstream& fp,
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
+    fp << ") begin\n";
     fp << "\tif ((" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) && ("; 
     fp << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << " == 1'b0))"; 
-    fp << " begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 1)) << ";" << std::endl; 
-    fp << "\t" << "end else begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << std::endl; 
-    fp << "\t" << "end" << std::endl;
-    fp << "end" << std::endl;
+    fp << " begin\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 1)) << ";\n"; 
+    fp << "\t" << "end else begin\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";\n"; 
+    fp << "\t" << "end\n";
+    fp << "end\n";
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -346,32 +349,32 @@ void print_verilog_arch_decoder_module(std::fstream& fp,
 
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-  fp << ") begin" << std::endl;
-  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << ") begin\n";
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin\n";
+  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     fp << "\t\t\t" << generate_verilog_constant_values(itobin_vec(i, addr_size)); 
     fp << " : ";
     fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(i, data_size)); 
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
   /* Different from MUX decoder, we assign default values which is all zero */
   fp << "\t\t\t" << "default"; 
   fp << " : ";
   fp << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size, data_size)); 
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\t\t" << "endcase" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << "\t\t" << "endcase\n";
+  fp << "\t" << "end\n";
 
   /* If enable is not active, we should give all zero */
-  fp << "\t" << "else begin" << std::endl;
+  fp << "\t" << "else begin\n";
   fp << "\t\t" << generate_verilog_port_constant_values(data_port, ito1hot_vec(data_size, data_size)); 
-  fp << ";" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << ";\n";
+  fp << "\t" << "end\n";
   
-  fp << "end" << std::endl;
+  fp << "end\n";
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
     print_verilog_wire_connection(fp, data_inv_port, data_port, true);
@@ -462,13 +465,13 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   if (1 == data_size) {
     fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
     fp << " or " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
-    fp << ") begin" << std::endl;
-    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";" << std::endl; 
-    fp << "\t" << "end else begin" << std::endl;
-    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";" << std::endl; 
-    fp << "\t" << "end" << std::endl;
-    fp << "end" << std::endl;
+    fp << ") begin\n";
+    fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin\n";
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, din_port) << ";\n"; 
+    fp << "\t" << "end else begin\n";
+    fp << "\t\t" << generate_verilog_port_constant_values(data_port, std::vector<size_t>(1, 0)) << ";\n"; 
+    fp << "\t" << "end\n";
+    fp << "end\n";
 
     /* Depend on if the inverted data output port is needed or not */
     if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -488,15 +491,15 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   fp << "always@(" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, enable_port);
   fp << ", " << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
-  fp << ") begin" << std::endl;
+  fp << ") begin\n";
 
-  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin" << std::endl;
+  fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port) << " == 1'b1) begin\n";
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
   fp << " = ";
   std::string high_res_str = "{" + std::to_string(data_port.get_width()) + "{1'bz}}";
   fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")" << std::endl;
+  fp << ";\n";
+  fp << "\t\t" << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")\n";
   /* Create a string for addr and data */
   for (size_t i = 0; i < data_size; ++i) {
     BasicPort cur_data_port(data_port.get_name(), i, i);
@@ -505,7 +508,7 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_data_port); 
     fp << " = ";
     fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port); 
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
   /* Different from MUX decoder, we assign default values which is all zero */
   fp << "\t\t\t" << "default"; 
@@ -513,20 +516,20 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
   fp << " = ";
   fp << high_res_str;
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\t\t" << "endcase" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << "\t\t" << "endcase\n";
+  fp << "\t" << "end\n";
 
   /* If enable is not active, we should give all zero */
-  fp << "\t" << "else begin" << std::endl;
+  fp << "\t" << "else begin\n";
   fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port); 
   fp << " = ";
   fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << ";\n";
+  fp << "\t" << "end\n";
   
-  fp << "end" << std::endl;
+  fp << "end\n";
 
 
   if (true == decoder_lib.use_data_inv_port(decoder)) {
@@ -548,16 +551,19 @@ void print_verilog_arch_decoder_with_data_in_module(std::fstream& fp,
  * Therefore, behavioral Verilog is used and the local decoders should be synthesized 
  * before running the back-end flow for FPGA fabric 
  * See more details in the function print_verilog_arch_decoder() for more details
+ * Wide memory decoders built as a tree of smaller decoders are outputted
+ * structurally, as their leaf decoders are outputted by this function as well
  ***************************************************************************************/
 void print_verilog_submodule_arch_decoders(const ModuleManager& module_manager,
                                            NetlistManager& netlist_manager,
                                            const DecoderLibrary& decoder_lib,
                                            const std::string& submodule_dir,
-                                           const e_verilog_default_net_type& default_net_type) {
+                                           const e_verilog_default_net_type& default_net_type,
+                                           const bool& incremental) {
   std::string verilog_fname(submodule_dir + std::string(ARCH_ENCODER_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -570,7 +576,15 @@ void print_verilog_submodule_arch_decoders(const ModuleManager& module_manager,
 
   /* Generate Verilog modules for the found unique local encoders */
   for (const auto& decoder : decoder_lib.decoders()) {
+    std::string module_name = generate_memory_decoder_subckt_name(decoder_lib.addr_size(decoder), decoder_lib.data_size(decoder));
     if (true == decoder_lib.use_data_in(decoder)) {
+      module_name = generate_memory_decoder_with_data_in_subckt_name(decoder_lib.addr_size(decoder), decoder_lib.data_size(decoder));
+    }
+    ModuleId module_id = module_manager.find_module(module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(module_id));
+    if (false == module_manager.child_modules(module_id).empty()) {
+      write_verilog_module_to_file(fp, module_manager, module_id, true, default_net_type);
+    } else if (true == decoder_lib.use_data_in(decoder)) {
       print_verilog_arch_decoder_with_data_in_module(fp, module_manager, decoder_lib, decoder, default_net_type);
     } else {
       print_verilog_arch_decoder_module(fp, module_manager, decoder_lib, decoder, default_net_type);
@@ -28,13 +28,15 @@ void print_verilog_submodule_mux_local_decoders(const ModuleManager& module_mana
                                                 const MuxLibrary& mux_lib,
                                                 const CircuitLibrary& circuit_lib,
                                                 const std::string& submodule_dir,
-                                                const e_verilog_default_net_type& default_net_type);
+                                                const e_verilog_default_net_type& default_net_type,
+                                                const bool& incremental);
 
 void print_verilog_submodule_arch_decoders(const ModuleManager& module_manager,
                                            NetlistManager& netlist_manager,
                                            const DecoderLibrary& decoder_lib,
                                            const std::string& submodule_dir,
-                                           const e_verilog_default_net_type& default_net_type);
+                                           const e_verilog_default_net_type& default_net_type,
+                                           const bool& incremental);
 
 
 } /* end namespace openfpga */
@@ -3,8 +3,11 @@
  * (CLBs, I/Os, heterogeneous blocks etc.) 
  *******************************************************************/
 /* System header files */
+#include <algorithm>
 #include <vector>
+#include <set>
 #include <fstream>
+#include <utility>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -16,7 +19,9 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -90,7 +95,7 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -109,7 +114,10 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
           "Writing Verilog codes of logical tile primitive block '%s'...",
            module_manager.module_name(primitive_module).c_str());
   
-  /* Write the verilog module */
+  /* Write the verilog module, which may be the identical module that this one is merged into */
+  if (true == module_manager.is_module_alias(primitive_module_name)) {
+    print_verilog_comment(fp, std::string("Module " + primitive_module_name + " is merged into identical module " + module_manager.module_name(primitive_module)));
+  }
   write_verilog_module_to_file(fp,
                                module_manager,
                                primitive_module,
@@ -141,6 +149,14 @@ void print_verilog_primitive_block(NetlistManager& netlist_manager,
  * Note: DFS is the right way. Do NOT use BFS.
  * DFS can guarantee that all the sub-modules can be registered properly
  * to its parent in module manager  
+ *
+ * Note: each pb_type has its own module, unless it has been merged into
+ * an identical module (see build_fabric --merge_identical_grid_modules),
+ * in which case several pb_types resolve to the same module.
+ * The modules whose netlists have been written are recorded in
+ * 'written_modules'. A pb_type whose module has been written is skipped
+ * with its whole sub-tree, as the child modules of an identical module
+ * are the same and have been written along with it
  *******************************************************************/
 static 
 void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
@@ -148,6 +164,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                                     const VprDeviceAnnotation& device_annotation,
                                     const std::string& subckt_dir,
                                     t_pb_graph_node* physical_pb_graph_node,
+                                    std::set<ModuleId>& written_modules,
                                     const FabricVerilogOption& options,
                                     const bool& verbose) {
 
@@ -161,6 +178,19 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   /* Get the pb_type definition related to the node */
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type; 
 
+  /* Generate the name of the Verilog module for this pb_type */
+  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
+  ModuleId pb_module = module_manager.find_module(pb_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+
+  /* Bypass the pb_type (and its children) if its module has been written */
+  if (0 < written_modules.count(pb_module)) {
+    VTR_LOGV(verbose,
+             "Skip pb_type '%s' whose module '%s' has been written\n",
+             physical_pb_type->name, module_manager.module_name(pb_module).c_str());
+    return;
+  }
+
   /* Find the mode that physical implementation of a pb_type */
   t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
 
@@ -174,6 +204,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                                      module_manager, device_annotation,
                                      subckt_dir, 
                                      &(physical_pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][0]),
+                                     written_modules,
                                      options,
                                      verbose);
     }
@@ -187,6 +218,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
                                   physical_pb_graph_node, 
                                   options, 
                                   verbose);
+    written_modules.insert(pb_module);
     /* Finish for primitive node, return */
     return;
   }
@@ -202,20 +234,13 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
 
   print_verilog_file_header(fp, std::string("Verilog modules for pb_type: " + std::string(physical_pb_type->name))); 
 
-  /* Generate the name of the Verilog module for this pb_type */
-  std::string pb_module_name = generate_physical_block_module_name(physical_pb_type);
-
-  /* Register the Verilog module in module manager */
-  ModuleId pb_module = module_manager.find_module(pb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
-
   VTR_LOGV(verbose,
           "Writing Verilog codes of pb_type '%s'...",
            module_manager.module_name(pb_module).c_str());
@@ -223,7 +248,10 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   /* Comment lines */
   print_verilog_comment(fp, std::string("----- BEGIN Physical programmable logic block Verilog module: " + std::string(physical_pb_type->name) + " -----"));
 
-  /* Write the verilog module */
+  /* Write the verilog module, which may be the identical module that this one is merged into */
+  if (true == module_manager.is_module_alias(pb_module_name)) {
+    print_verilog_comment(fp, std::string("Module " + pb_module_name + " is merged into identical module " + module_manager.module_name(pb_module)));
+  }
   write_verilog_module_to_file(fp,
                                module_manager,
                                pb_module,
@@ -239,6 +267,7 @@ void rec_print_verilog_logical_tile(NetlistManager& netlist_manager,
   NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  written_modules.insert(pb_module);
 
   VTR_LOGV(verbose, "Done\n");
 }
@@ -253,6 +282,7 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
                                         const VprDeviceAnnotation& device_annotation,
                                         const std::string& subckt_dir,
                                         t_pb_graph_node* pb_graph_head,
+                                        std::set<ModuleId>& written_modules,
                                         const FabricVerilogOption& options,
                                         const bool& verbose) {
 
@@ -272,6 +302,7 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
                                  device_annotation, 
                                  subckt_dir,
                                  pb_graph_head,
+                                 written_modules,
                                  options,
                                  verbose);
 
@@ -288,12 +319,12 @@ void print_verilog_logical_tile_netlist(NetlistManager& netlist_manager,
  * the I/O block locates at.
  *****************************************************************************/
 static 
-void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
-                                         const ModuleManager& module_manager,
-                                         const std::string& subckt_dir,
-                                         t_physical_tile_type_ptr phy_block_type,
-                                         const e_side& border_side,
-                                         const FabricVerilogOption& options) {
+std::string print_verilog_physical_tile_netlist(const ModuleManager& module_manager,
+                                                const std::string& subckt_dir,
+                                                t_physical_tile_type_ptr phy_block_type,
+                                                const e_side& border_side,
+                                                const bool& include_core_module,
+                                                const FabricVerilogOption& options) {
   /* Give a name to the Verilog netlist */
   /* Create the file name for Verilog */
   std::string verilog_fname(subckt_dir 
@@ -303,25 +334,32 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
                                                              std::string(VERILOG_NETLIST_FILE_POSTFIX))
                            );
 
-  /* Echo status */
-  if (true == is_io_type(phy_block_type)) {
-    SideManager side_manager(border_side);
-    VTR_LOG("Writing Verilog Netlist '%s' for physical tile '%s' at %s side ...",
-            verilog_fname.c_str(), phy_block_type->name, 
-            side_manager.c_str());
-  } else { 
-    VTR_LOG("Writing Verilog Netlist '%s' for physical_tile '%s'...",
-            verilog_fname.c_str(), phy_block_type->name);
-  }
-
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
 
   print_verilog_file_header(fp, std::string("Verilog modules for physical tile: " + std::string(phy_block_type->name) + "]")); 
 
+  /* When the pins of grids are duplicated, the grid modules of the physical tile
+   * are wrappers of a core module, which is written with the first one
+   */
+  std::string core_module_name = generate_grid_core_module_name(std::string(GRID_VERILOG_FILE_NAME_PREFIX), std::string(phy_block_type->name));
+  ModuleId core_module = module_manager.find_module(core_module_name);
+  if ( (true == include_core_module)
+    && (true == module_manager.valid_module_id(core_module))
+    && (false == module_manager.is_module_alias(core_module_name)) ) {
+    print_verilog_comment(fp, std::string("----- BEGIN Grid core Verilog module: " + core_module_name + " -----"));
+    write_verilog_module_to_file(fp,
+                                 module_manager,
+                                 core_module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+    print_verilog_comment(fp, std::string("----- END Grid core Verilog module: " + core_module_name + " -----"));
+    fp << "\n";
+  }
+
   /* Create a Verilog Module for the top-level physical block, and add to module manager */
   std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_VERILOG_FILE_NAME_PREFIX), std::string(phy_block_type->name), is_io_type(phy_block_type), border_side);
   ModuleId grid_module = module_manager.find_module(grid_module_name); 
@@ -329,26 +367,75 @@ void print_verilog_physical_tile_netlist(NetlistManager& netlist_manager,
 
   /* Write the verilog module */
   print_verilog_comment(fp, std::string("----- BEGIN Grid Verilog module: " + module_manager.module_name(grid_module) + " -----"));
-  write_verilog_module_to_file(fp,
-                               module_manager,
-                               grid_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  if (true == module_manager.is_module_alias(grid_module_name)) {
+    /* Merged into an identical module, which is written in another netlist */
+    print_verilog_comment(fp, std::string("Module " + grid_module_name + " is merged into identical module " + module_manager.module_name(grid_module)));
+  } else {
+    write_verilog_module_to_file(fp,
+                                 module_manager,
+                                 grid_module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+  }
 
   print_verilog_comment(fp, std::string("----- END Grid Verilog module: " + module_manager.module_name(grid_module) + " -----"));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  /* Echo status in one message, as physical tiles may be written by multiple threads */
+  if (true == is_io_type(phy_block_type)) {
+    SideManager side_manager(border_side);
+    VTR_LOG("Writing Verilog Netlist '%s' for physical tile '%s' at %s side ...Done\n",
+            verilog_fname.c_str(), phy_block_type->name, 
+            side_manager.c_str());
+  } else { 
+    VTR_LOG("Writing Verilog Netlist '%s' for physical_tile '%s'...Done\n",
+            verilog_fname.c_str(), phy_block_type->name);
+  }
+
+  return verilog_fname;
+}
 
+/*****************************************************************************
+ * Write the netlists of the logical tiles whose pb_graphs are given
+ * Write modules for all the pb_types/pb_graph_nodes
+ * use a Depth-First Search Algorithm to print the sub-modules 
+ * Note: DFS is the right way. Do NOT use BFS.
+ * DFS can guarantee that all the sub-modules can be registered properly
+ * to its parent in module manager  
+ * Each module is written once over all the logical tiles: the pb_types
+ * which are merged into an identical module are not written again
+ *
+ * Return the number of modules which are written
+ ****************************************************************************/
+size_t print_verilog_logical_tiles(NetlistManager& netlist_manager,
+                                   const ModuleManager& module_manager,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const std::string& subckt_dir,
+                                   const std::vector<t_pb_graph_node*>& pb_graph_heads,
+                                   const FabricVerilogOption& options,
+                                   const bool& verbose) {
+  std::set<ModuleId> written_modules;
+  VTR_LOG("Writing logical tiles...");
+  VTR_LOGV(verbose, "\n");
+  for (t_pb_graph_node* pb_graph_head : pb_graph_heads) {
+    print_verilog_logical_tile_netlist(netlist_manager,
+                                       module_manager,
+                                       device_annotation,
+                                       subckt_dir,
+                                       pb_graph_head,
+                                       written_modules,
+                                       options,
+                                       verbose);
+  }
+  VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
+
+  return written_modules.size();
 }
 
 /*****************************************************************************
@@ -367,30 +454,26 @@ void print_verilog_grids(NetlistManager& netlist_manager,
   /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
   std::vector<std::string> netlist_names;
 
-  /* Enumerate the types of logical tiles, and build a module for each 
-   * Write modules for all the pb_types/pb_graph_nodes
-   * use a Depth-First Search Algorithm to print the sub-modules 
-   * Note: DFS is the right way. Do NOT use BFS.
-   * DFS can guarantee that all the sub-modules can be registered properly
-   * to its parent in module manager  
-   */
-  VTR_LOG("Writing logical tiles...");
-  VTR_LOGV(verbose, "\n");
+  /* Enumerate the types of logical tiles, and build a module for each */
+  std::vector<t_pb_graph_node*> pb_graph_heads;
   for (const t_logical_block_type& logical_tile : device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_verilog_logical_tile_netlist(netlist_manager,
-                                       module_manager,
-                                       device_annotation,
-                                       subckt_dir,
-                                       logical_tile.pb_graph_head,
-                                       options,
-                                       verbose);
+    /* Bypass the logical tiles which are not built, e.g., in a partial fabric */
+    if (false == module_manager.valid_module_id(module_manager.find_module(generate_physical_block_module_name(logical_tile.pb_graph_head->pb_type)))) {
+      continue;
+    }
+    pb_graph_heads.push_back(logical_tile.pb_graph_head);
   }
-  VTR_LOG("Writing logical tiles...");
-  VTR_LOG("Done\n");
+  print_verilog_logical_tiles(netlist_manager,
+                              module_manager,
+                              device_annotation,
+                              subckt_dir,
+                              pb_graph_heads,
+                              options,
+                              verbose);
 
   VTR_LOG("\n");
 
@@ -399,6 +482,7 @@ void print_verilog_grids(NetlistManager& netlist_manager,
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<std::pair<t_physical_tile_type_ptr, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
     if (true == is_empty_type(&physical_tile)) {
@@ -415,24 +499,47 @@ void print_verilog_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides = find_physical_io_tile_located_sides(device_ctx.grid,
                                                                            &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_verilog_physical_tile_netlist(netlist_manager,
-                                            module_manager,
-                                            subckt_dir, 
-                                            &physical_tile,
-                                            io_type_side,
-                                            options);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       } 
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_verilog_physical_tile_netlist(netlist_manager,
-                                          module_manager,
-                                          subckt_dir, 
-                                          &physical_tile,
-                                          NUM_SIDES,
-                                          options);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+
+  /* Bypass the physical tiles which are not built, e.g., in a partial fabric */
+  physical_tiles.erase(std::remove_if(physical_tiles.begin(), physical_tiles.end(),
+                                      [&](const std::pair<t_physical_tile_type_ptr, e_side>& physical_tile) {
+                                        std::string grid_module_name = generate_grid_block_module_name(std::string(GRID_VERILOG_FILE_NAME_PREFIX),
+                                                                                                       std::string(physical_tile.first->name),
+                                                                                                       is_io_type(physical_tile.first),
+                                                                                                       physical_tile.second);
+                                        return false == module_manager.valid_module_id(module_manager.find_module(grid_module_name));
+                                      }),
+                       physical_tiles.end());
+
+  /* Each physical tile is written to a separated file, which can be done in parallel.
+   * Netlists are added to the netlist manager in the same order as a single-thread run
+   * The core module of a physical tile, if any, is written with its first grid module
+   */
+  std::vector<std::string> physical_tile_fnames(physical_tiles.size());
+  parallel_for(physical_tiles.size(), options.num_threads(),
+               [&](const size_t& itile) {
+    physical_tile_fnames[itile] = print_verilog_physical_tile_netlist(module_manager,
+                                                                      subckt_dir, 
+                                                                      physical_tiles[itile].first,
+                                                                      physical_tiles[itile].second,
+                                                                      (0 == itile) || (physical_tiles[itile - 1].first != physical_tiles[itile].first),
+                                                                      options);
+  });
+
+  /* Add fname to the netlist name list */
+  for (const std::string& verilog_fname : physical_tile_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::LOGIC_BLOCK_NETLIST);
+  }
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <string>
+#include <vector>
 #include "vpr_context.h"
 #include "module_manager.h"
 #include "netlist_manager.h"
@@ -18,6 +19,14 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+size_t print_verilog_logical_tiles(NetlistManager& netlist_manager,
+                                   const ModuleManager& module_manager,
+                                   const VprDeviceAnnotation& device_annotation,
+                                   const std::string& subckt_dir,
+                                   const std::vector<t_pb_graph_node*>& pb_graph_heads,
+                                   const FabricVerilogOption& options,
+                                   const bool& verbose);
+
 void print_verilog_grids(NetlistManager& netlist_manager,
                          const ModuleManager& module_manager,
                          const DeviceContext& device_ctx,
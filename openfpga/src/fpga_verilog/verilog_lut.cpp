@@ -10,6 +10,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 
 #include "mux_graph.h"
 #include "module_manager.h"
@@ -36,7 +37,7 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
                                   const FabricVerilogOption& options) {
   std::string verilog_fname = submodule_dir + std::string(LUTS_VERILOG_FILE_NAME);
 
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
 
   /* Create the file stream */
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 
 #include "mux_graph.h"
 #include "module_manager.h"
@@ -63,7 +64,7 @@ void print_verilog_mux_memory_module(const ModuleManager& module_manager,
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -107,7 +108,7 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
   std::string verilog_fname(submodule_dir + std::string(MEMORIES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -184,7 +185,7 @@ void print_verilog_submodule_memories(const ModuleManager& module_manager,
                                  options.default_net_type());
 
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
   }
 
   /* Close the file stream */
@@ -8,6 +8,9 @@
  * Please use const keyword to restrict this!
  *******************************************************************/
 #include <algorithm>
+#include <cstdlib>
+#include <tuple>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -19,6 +22,7 @@
 #include "openfpga_naming.h"
 
 #include "module_manager_utils.h"
+#include "verilog_constants.h"
 #include "verilog_port_types.h"
 #include "verilog_writer_utils.h"
 #include "verilog_module_writer.h"
@@ -70,10 +74,10 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
    * if we have a source module is the current module, this is not local wire 
    */
   for (ModuleNetSrcId src_id : module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id == module_manager.net_source_modules(module_id, module_net)[src_id]) {
+    if (module_id == module_manager.net_source_module(module_id, module_net, src_id)) {
       /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index = module_manager.net_source_pins(module_id, module_net)[src_id];
+      ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, src_id);
+      size_t src_pin_index = module_manager.net_source_pin(module_id, module_net, src_id);
       port_to_return.set(module_manager.module_port(module_id, net_src_port));
       port_to_return.set_width(src_pin_index, src_pin_index);
       port_to_return.set_origin_port_width(module_manager.module_port(module_id, net_src_port).get_width());
@@ -83,10 +87,10 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
 
   /* Check all the sink modules of the net */
   for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id == module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+    if (module_id == module_manager.net_sink_module(module_id, module_net, sink_id)) {
       /* Here, this is not a local wire, return the port name of the sink_port */
-      ModulePortId net_sink_port = module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index = module_manager.net_sink_pins(module_id, module_net)[sink_id];
+      ModulePortId net_sink_port = module_manager.net_sink_port(module_id, module_net, sink_id);
+      size_t sink_pin_index = module_manager.net_sink_pin(module_id, module_net, sink_id);
       port_to_return.set(module_manager.module_port(module_id, net_sink_port));
       port_to_return.set_width(sink_pin_index, sink_pin_index);
       port_to_return.set_origin_port_width(module_manager.module_port(module_id, net_sink_port).get_width());
@@ -101,13 +105,13 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
 
   /* Get the source module */
-  ModuleId net_src_module = module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
+  ModuleId net_src_module = module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0));
   /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_instance = module_manager.net_source_instance(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the port id */
-  ModulePortId net_src_port = module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)]; 
+  ModulePortId net_src_port = module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)); 
   /* Get the pin id */
-  size_t net_src_pin = module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)]; 
+  size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
 
   /* Load user-defined name if we have it */
   if (false == module_manager.net_name(module_id, module_net).empty()) {
@@ -124,17 +128,43 @@ BasicPort generate_verilog_port_for_module_net(const ModuleManager& module_manag
   return port_to_return;
 }
 
+/********************************************************************
+ * Hash function for the key of local wires without user-defined names,
+ * which is the source module, instance and port of the net
+ *******************************************************************/
+typedef std::tuple<ModuleId, size_t, ModulePortId> t_verilog_local_wire_key;
+
+struct VerilogLocalWireKeyHash {
+  size_t operator()(const t_verilog_local_wire_key& key) const {
+    size_t hash = std::hash<size_t>()(size_t(std::get<0>(key)));
+    hash ^= std::hash<size_t>()(std::get<1>(key)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<size_t>()(size_t(std::get<2>(key))) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+  }
+};
+
 /********************************************************************
  * Find all the nets that are going to be local wires
  * And organize it in a vector of ports
  * Verilog wire writter function will use the output of this function
  * to write up local wire declaration in Verilog format
+ *
+ * Nets sharing the same name are merged to a single wire whose
+ * LSB (MSB) is the minimum (maximum) pin index of the nets.
+ * To avoid building a name for each net, the nets are first grouped
+ * in hash tables, by their user-defined names or by their source
+ * terminals (module, instance and port), from which names are built only once.
  *******************************************************************/
 static 
 std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(const ModuleManager& module_manager,
                                                                               const ModuleId& module_id) {
   std::map<std::string, std::vector<BasicPort>> local_wires;
 
+  /* Wires found so far, and their indices in the hash tables */
+  std::vector<BasicPort> wire_candidates;
+  std::unordered_map<std::string, size_t> named_wire_indices;
+  std::unordered_map<t_verilog_local_wire_key, size_t, VerilogLocalWireKeyHash> unnamed_wire_indices;
+
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
     /* Bypass dangling nets:
@@ -153,30 +183,43 @@ std::map<std::string, std::vector<BasicPort>> find_verilog_module_local_wires(co
     if (false == module_net_is_local_wire(module_manager, module_id, module_net)) {
       continue;
     }
-    /* Find the name for this local wire */
-    BasicPort local_wire_candidate = generate_verilog_port_for_module_net(module_manager, module_id, module_net);
-    /* Cache the net name, try to find it in the cache.
-     * If you can find one, it means this port may be mergeable, try to do merging. If merge fail, add to the local wire list
-     * If you cannot find one, it means that this port is not mergeable, add to the local wire list immediately.
-     */
-    std::map<std::string, std::vector<BasicPort>>::iterator it = local_wires.find(local_wire_candidate.get_name());
-    bool merged = false;
-    if (it != local_wires.end()) {
-      /* Try to merge to one the port in the list that can absorb the current local wire */
-      for (BasicPort& local_wire : local_wires[local_wire_candidate.get_name()]) {
-        /* check if the candidate can be combined to an existing local wire */
-        if (true == two_verilog_ports_mergeable(local_wire, local_wire_candidate)) {
-          /* Merge the ports */
-          local_wire = merge_two_verilog_ports(local_wire, local_wire_candidate);
-          merged = true;
-          break;
-        } 
-      }
+
+    /* Each net must only one 1 source, see generate_verilog_port_for_module_net() */ 
+    VTR_ASSERT(1 == module_manager.net_source_modules(module_id, module_net).size());
+    size_t net_src_pin = module_manager.net_source_pin(module_id, module_net, ModuleNetSrcId(0)); 
+
+    /* Find the wire in the hash tables, the port is created only for the first net */
+    size_t wire_index = wire_candidates.size();
+    const std::string& net_name = module_manager.net_name(module_id, module_net);
+    if (false == net_name.empty()) {
+      wire_index = named_wire_indices.insert(std::make_pair(net_name, wire_index)).first->second;
+    } else {
+      t_verilog_local_wire_key wire_key(module_manager.net_source_module(module_id, module_net, ModuleNetSrcId(0)),
+                                        module_manager.net_source_instance(module_id, module_net, ModuleNetSrcId(0)),
+                                        module_manager.net_source_port(module_id, module_net, ModuleNetSrcId(0)));
+      wire_index = unnamed_wire_indices.insert(std::make_pair(wire_key, wire_index)).first->second;
     }
 
-    /* If not merged/not found in the cache, push the port to the list */
-    if (false == merged) {
-      local_wires[local_wire_candidate.get_name()].push_back(local_wire_candidate);
+    if (wire_candidates.size() == wire_index) {
+      wire_candidates.push_back(generate_verilog_port_for_module_net(module_manager, module_id, module_net));
+      continue;
+    }
+
+    /* Extend the wire to cover the pin */
+    BasicPort& wire_candidate = wire_candidates[wire_index];
+    wire_candidate.set_width(std::min(wire_candidate.get_lsb(), net_src_pin),
+                             std::max(wire_candidate.get_msb(), net_src_pin));
+  }
+
+  /* A user-defined name may be the same as a name built from source terminals,
+   * merge the wires as well in this case
+   */
+  for (const BasicPort& wire_candidate : wire_candidates) {
+    std::vector<BasicPort>& wires = local_wires[wire_candidate.get_name()];
+    if (true == wires.empty()) {
+      wires.push_back(wire_candidate);
+    } else {
+      wires[0] = merge_two_verilog_ports(wires[0], wire_candidate);
     }
   }
 
@@ -233,14 +276,14 @@ void print_verilog_module_output_short_connection(std::fstream& fp,
 
   /* We have found a module input, now check all the sink modules of the net */
   for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-    ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id != sink_module) {
       continue;
     }
 
     /* Find the sink port and pin information */
-    ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-    size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+    ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+    size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
     BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
     /* For the first module output, this is the source port, we do nothing and go to the next */
@@ -273,27 +316,27 @@ void print_verilog_module_local_short_connection(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   for (ModuleNetSrcId net_src : module_manager.module_net_sources(module_id, module_net)) {
-    ModuleId src_module = module_manager.net_source_modules(module_id, module_net)[net_src];
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id != src_module) {
       continue;
     }
     /* Find the source port and pin information */
     print_verilog_comment(fp, std::string("----- Net source id " + std::to_string(size_t(net_src)) + " -----"));
-    ModulePortId src_port_id = module_manager.net_source_ports(module_id, module_net)[net_src];
-    size_t src_pin = module_manager.net_source_pins(module_id, module_net)[net_src];
+    ModulePortId src_port_id = module_manager.net_source_port(module_id, module_net, net_src);
+    size_t src_pin = module_manager.net_source_pin(module_id, module_net, net_src);
     BasicPort src_port(module_manager.module_port(module_id, src_port_id).get_name(), src_pin, src_pin);
 
     /* We have found a module input, now check all the sink modules of the net */
     for (ModuleNetSinkId net_sink : module_manager.module_net_sinks(module_id, module_net)) {
-      ModuleId sink_module = module_manager.net_sink_modules(module_id, module_net)[net_sink];
+      ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
       if (module_id != sink_module) {
         continue;
       }
 
       /* Find the sink port and pin information */
       print_verilog_comment(fp, std::string("----- Net sink id " + std::to_string(size_t(net_sink)) + " -----"));
-      ModulePortId sink_port_id = module_manager.net_sink_ports(module_id, module_net)[net_sink];
-      size_t sink_pin = module_manager.net_sink_pins(module_id, module_net)[net_sink];
+      ModulePortId sink_port_id = module_manager.net_sink_port(module_id, module_net, net_sink);
+      size_t sink_pin = module_manager.net_sink_pin(module_id, module_net, net_sink);
       BasicPort sink_port(module_manager.module_port(module_id, sink_port_id).get_name(), sink_pin, sink_pin);
 
       /* We need to print a wire connection here */
@@ -396,32 +439,23 @@ void write_verilog_instance_to_file(std::fstream& fp,
    * if we have an instance name, use it;
    * if not, we use a default name <name>_<num_instance_in_parent_module> 
    */
-  if (true == module_manager.instance_name(parent_module, child_module, instance_id).empty()) {
-    fp << generate_instance_name(module_manager.module_name(child_module), instance_id) << " (" << std::endl;
-  } else {
-    fp << module_manager.instance_name(parent_module, child_module, instance_id) << " (" << std::endl;
-  }
-
-  /* Print each port with/without explicit port map */
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type> port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
-  /* Port sequence: global, inout, input, output and clock ports, */
+  std::string instance_name = module_manager.instance_name(parent_module, child_module, instance_id);
+  if (true == instance_name.empty()) {
+    append_instance_name(instance_name, module_manager.module_name(child_module), instance_id);
+  }
+  fp << instance_name << " (\n";
+
+  /* Print each port with/without explicit port map
+   * Port sequence: global, inout, input, output and clock ports,
+   * which follows the order of port types in module manager
+   */
   size_t port_cnt = 0;
-  for (const auto& kv : port_type2type_map) {
-    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, kv.first)) {
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, ModuleManager::e_module_port_type(port_type))) {
       BasicPort child_port = module_manager.module_port(child_module, child_port_id);
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
       /* Print port */
       fp << "\t\t";
@@ -432,7 +466,7 @@ void write_verilog_instance_to_file(std::fstream& fp,
 
       /* Create the port name and width to be used by the instance */
       std::vector<BasicPort> instance_ports; 
-      std::vector<bool> instance_ports_is_single_bit; 
+      instance_ports.reserve(child_port.get_width());
       for (size_t child_pin : child_port.pins()) {
         /* Find the net linked to the pin */
         ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
@@ -465,7 +499,7 @@ void write_verilog_instance_to_file(std::fstream& fp,
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
@@ -488,7 +522,7 @@ void write_verilog_module_to_file(std::fstream& fp,
   print_verilog_module_declaration(fp, module_manager, module_id, default_net_type);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
    
   /* Print internal wires */
   std::map<std::string, std::vector<BasicPort>> local_wires = find_verilog_module_local_wires(module_manager, module_id);
@@ -500,12 +534,12 @@ void write_verilog_module_to_file(std::fstream& fp,
         && (0 == local_wire.get_lsb())) {
         continue;
       }
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";\n";
     }
   }
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print local connection (from module inputs to output! */
   print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
@@ -517,7 +551,7 @@ void write_verilog_module_to_file(std::fstream& fp,
  
   print_verilog_comment(fp, std::string("----- END Local output short connections -----"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print instances */
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
@@ -525,7 +559,482 @@ void write_verilog_module_to_file(std::fstream& fp,
       /* Print an instance */
       write_verilog_instance_to_file(fp, module_manager, module_id, child_module, instance, use_explicit_port_map); 
       /* Print an empty line as splitter */
-      fp << std::endl;
+      fp << "\n";
+    }
+  }
+
+  /* Print an end for the module */
+  print_verilog_module_end(fp, module_manager.module_name(module_id)); 
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+}
+
+/********************************************************************
+ * The following functions write a compact Verilog module, where the
+ * instances of a child module are written in generate-for loops
+ * as long as their connections are regular.
+ *
+ * In a compact module, local wires are declared as wire arrays,
+ * one array per port of child modules, whose words are indexed by
+ * the instances driving the wires:
+ *   wire [<lsb>:<msb>] <child_module>_<port>_array [0:<num_instances - 1>];
+ * Undriven pins of a child port are connected to the wire array
+ * <child_module>__undriven_<port>_array in the same way.
+ * As such, each pin of an instance is connected to a bit of a signal,
+ * which is a wire array, a local wire with a user-defined name
+ * or a port of the module.
+ *
+ * Consecutive instances of a child module are written in a loop
+ * when the word and bit indices of every pin are affine functions
+ * of the instance index, for example:
+ *   generate
+ *   for (iarray = 0; iarray < 4; iarray = iarray + 1) begin : cbx_1__1__2__array
+ *     cbx_1__1_ inst (
+ *       .chanx_left_in(sb_1__1__chanx_right_out_array[2 + iarray][0:19]),
+ *       ...);
+ *   end
+ *   endgenerate
+ *
+ * Note that instances in loops are renamed as <block_name>[<index>].inst,
+ * so that hierarchical paths through them are different from
+ * those in the module written by write_verilog_module_to_file()
+ *******************************************************************/
+
+/* A signal which the pins of instances are connected to */
+struct VerilogCompactSignal {
+  BasicPort range;  /* name and bit range of a word */
+  size_t num_words; /* 0 if the signal is not a wire array */
+  bool declared;    /* false for the ports of the module */
+};
+
+/* The word and bit of a signal connected to a pin,
+ * which is also used to store the increments of the indices between instances
+ */
+struct VerilogCompactPin {
+  size_t signal;
+  int word;
+  int bit;
+};
+
+/* The signals of a compact module and their fast lookups */
+struct VerilogCompactSignals {
+  std::vector<VerilogCompactSignal> signals;
+  std::map<std::pair<ModuleId, ModulePortId>, size_t> wire_arrays;
+  std::map<std::pair<ModuleId, ModulePortId>, size_t> undriven_wire_arrays;
+  std::map<ModulePortId, size_t> module_ports;
+  std::unordered_map<std::string, size_t> named_wires;
+};
+
+static 
+size_t add_verilog_compact_signal(VerilogCompactSignals& compact_signals,
+                                  const std::string& name,
+                                  const BasicPort& range,
+                                  const size_t& num_words,
+                                  const bool& declared) {
+  VerilogCompactSignal signal;
+  signal.range = BasicPort(name, range.get_lsb(), range.get_msb());
+  signal.num_words = num_words;
+  signal.declared = declared;
+  compact_signals.signals.push_back(signal);
+  return compact_signals.signals.size() - 1;
+}
+
+/********************************************************************
+ * Find the signal bit that a pin of an instance is connected to
+ * New signals are added to the list when they are found the first time
+ * The rules follow generate_verilog_port_for_module_net()
+ *******************************************************************/
+static 
+VerilogCompactPin find_verilog_compact_instance_pin(VerilogCompactSignals& compact_signals,
+                                                    const ModuleManager& module_manager,
+                                                    const ModuleId& parent_module,
+                                                    const ModuleId& child_module,
+                                                    const size_t& instance_id,
+                                                    const ModulePortId& child_port_id,
+                                                    const size_t& child_pin) {
+  VerilogCompactPin pin;
+  ModuleNetId net = module_manager.module_instance_port_net(parent_module, child_module, instance_id, 
+                                                            child_port_id, child_pin);
+
+  /* Undriven pins are connected to the wire array of the child port */
+  if (ModuleNetId::INVALID() == net) {
+    std::pair<ModuleId, ModulePortId> key(child_module, child_port_id);
+    auto result = compact_signals.undriven_wire_arrays.find(key);
+    if (result == compact_signals.undriven_wire_arrays.end()) {
+      const BasicPort& child_port = module_manager.module_port(child_module, child_port_id);
+      std::string name = module_manager.module_name(child_module) + std::string("__undriven_") + child_port.get_name() + std::string(VERILOG_WIRE_ARRAY_POSTFIX);
+      size_t signal = add_verilog_compact_signal(compact_signals, name, child_port,
+                                                 module_manager.num_instance(parent_module, child_module), true);
+      result = compact_signals.undriven_wire_arrays.insert(std::make_pair(key, signal)).first;
+    }
+    pin.signal = result->second;
+    pin.word = instance_id;
+    pin.bit = child_pin;
+    return pin;
+  }
+
+  /* Nets which are linked to the module are connected to its ports */
+  ModulePortId module_port_id = ModulePortId::INVALID();
+  for (ModuleNetSrcId src_id : module_manager.module_net_sources(parent_module, net)) {
+    if (parent_module == module_manager.net_source_module(parent_module, net, src_id)) {
+      module_port_id = module_manager.net_source_port(parent_module, net, src_id);
+      pin.bit = module_manager.net_source_pin(parent_module, net, src_id);
+      break;
+    }
+  }
+  if (ModulePortId::INVALID() == module_port_id) {
+    for (ModuleNetSinkId sink_id : module_manager.module_net_sinks(parent_module, net)) {
+      if (parent_module == module_manager.net_sink_module(parent_module, net, sink_id)) {
+        module_port_id = module_manager.net_sink_port(parent_module, net, sink_id);
+        pin.bit = module_manager.net_sink_pin(parent_module, net, sink_id);
+        break;
+      }
+    }
+  }
+  if (ModulePortId::INVALID() != module_port_id) {
+    auto result = compact_signals.module_ports.find(module_port_id);
+    if (result == compact_signals.module_ports.end()) {
+      const BasicPort& module_port = module_manager.module_port(parent_module, module_port_id);
+      size_t signal = add_verilog_compact_signal(compact_signals, module_port.get_name(), module_port, 0, false);
+      result = compact_signals.module_ports.insert(std::make_pair(module_port_id, signal)).first;
+    }
+    pin.signal = result->second;
+    pin.word = 0;
+    return pin;
+  }
+
+  /* Reach here, this is a local wire, which must have only one source */
+  VTR_ASSERT(1 == module_manager.net_source_modules(parent_module, net).size());
+  ModuleId net_src_module = module_manager.net_source_module(parent_module, net, ModuleNetSrcId(0));
+  size_t net_src_instance = module_manager.net_source_instance(parent_module, net, ModuleNetSrcId(0)); 
+  ModulePortId net_src_port = module_manager.net_source_port(parent_module, net, ModuleNetSrcId(0)); 
+  size_t net_src_pin = module_manager.net_source_pin(parent_module, net, ModuleNetSrcId(0)); 
+  pin.bit = net_src_pin;
+
+  /* Local wires with user-defined names are declared as they are */
+  const std::string& net_name = module_manager.net_name(parent_module, net);
+  if (false == net_name.empty()) {
+    auto result = compact_signals.named_wires.find(net_name);
+    if (result == compact_signals.named_wires.end()) {
+      size_t signal = add_verilog_compact_signal(compact_signals, net_name, BasicPort(net_name, net_src_pin, net_src_pin), 0, true);
+      result = compact_signals.named_wires.insert(std::make_pair(net_name, signal)).first;
+    } else {
+      BasicPort& range = compact_signals.signals[result->second].range;
+      range.set_width(std::min(range.get_lsb(), net_src_pin), std::max(range.get_msb(), net_src_pin));
+    }
+    pin.signal = result->second;
+    pin.word = 0;
+    return pin;
+  }
+
+  /* Other local wires are the words of the wire array of the source port */
+  std::pair<ModuleId, ModulePortId> key(net_src_module, net_src_port);
+  auto result = compact_signals.wire_arrays.find(key);
+  if (result == compact_signals.wire_arrays.end()) {
+    const BasicPort& src_port = module_manager.module_port(net_src_module, net_src_port);
+    std::string name = module_manager.module_name(net_src_module) + std::string("_") + src_port.get_name() + std::string(VERILOG_WIRE_ARRAY_POSTFIX);
+    size_t signal = add_verilog_compact_signal(compact_signals, name, src_port,
+                                               module_manager.num_instance(parent_module, net_src_module), true);
+    result = compact_signals.wire_arrays.insert(std::make_pair(key, signal)).first;
+  }
+  pin.signal = result->second;
+  pin.word = net_src_instance;
+  return pin;
+}
+
+/********************************************************************
+ * Find the signal bits connected to all the pins of an instance
+ * Pins are ordered by port types, ports and pins, in the same way
+ * as the instance is written
+ *******************************************************************/
+static 
+std::vector<VerilogCompactPin> find_verilog_compact_instance_pins(VerilogCompactSignals& compact_signals,
+                                                                  const ModuleManager& module_manager,
+                                                                  const ModuleId& parent_module,
+                                                                  const ModuleId& child_module,
+                                                                  const size_t& instance_id) {
+  std::vector<VerilogCompactPin> pins;
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, ModuleManager::e_module_port_type(port_type))) {
+      for (const size_t& child_pin : module_manager.module_port(child_module, child_port_id).pins()) {
+        pins.push_back(find_verilog_compact_instance_pin(compact_signals, module_manager,
+                                                         parent_module, child_module, instance_id,
+                                                         child_port_id, child_pin));
+      }
+    }
+  }
+  return pins;
+}
+
+/********************************************************************
+ * Find the increments of the word and bit indices of each pin
+ * from an instance to the next one
+ * Return false if the pins of the two instances are not connected
+ * to the same signals, which can not be written in a loop
+ *******************************************************************/
+static 
+bool find_verilog_compact_pin_increments(std::vector<VerilogCompactPin>& increments,
+                                         const std::vector<VerilogCompactPin>& first_pins,
+                                         const std::vector<VerilogCompactPin>& next_pins) {
+  VTR_ASSERT(first_pins.size() == next_pins.size());
+  increments.resize(first_pins.size());
+  for (size_t ipin = 0; ipin < first_pins.size(); ++ipin) {
+    if (first_pins[ipin].signal != next_pins[ipin].signal) {
+      return false;
+    }
+    increments[ipin].signal = first_pins[ipin].signal;
+    increments[ipin].word = next_pins[ipin].word - first_pins[ipin].word;
+    increments[ipin].bit = next_pins[ipin].bit - first_pins[ipin].bit;
+  }
+  return true;
+}
+
+/********************************************************************
+ * Identify if the pins of an instance, which is the given distance away
+ * from the first instance of a loop, follow the increments of the loop
+ *******************************************************************/
+static 
+bool verilog_compact_pins_follow_increments(const std::vector<VerilogCompactPin>& first_pins,
+                                            const std::vector<VerilogCompactPin>& increments,
+                                            const std::vector<VerilogCompactPin>& pins,
+                                            const int& distance) {
+  for (size_t ipin = 0; ipin < pins.size(); ++ipin) {
+    if ( (first_pins[ipin].signal != pins[ipin].signal)
+      || (first_pins[ipin].word + distance * increments[ipin].word != pins[ipin].word)
+      || (first_pins[ipin].bit + distance * increments[ipin].bit != pins[ipin].bit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Generate an index <base> + <increment>*<genvar> for instance arrays
+ *******************************************************************/
+static 
+std::string generate_verilog_compact_index(const int& base,
+                                           const int& increment) {
+  std::string index = std::to_string(base);
+  if (0 == increment) {
+    return index;
+  }
+  index += (0 < increment) ? " + " : " - ";
+  if (1 != std::abs(increment)) {
+    index += std::to_string(std::abs(increment)) + std::string("*");
+  }
+  index += VERILOG_INSTANCE_ARRAY_GENVAR;
+  return index;
+}
+
+/********************************************************************
+ * Generate the connection of a port of an instance, where the pins
+ * in the range [pin_begin, pin_end) are merged into part-selects
+ * as much as possible, e.g., {<signal>[<word>][<lsb>:<msb>], ...}
+ *******************************************************************/
+static 
+std::string generate_verilog_compact_port_connection(const VerilogCompactSignals& compact_signals,
+                                                     const std::vector<VerilogCompactPin>& pins,
+                                                     const std::vector<VerilogCompactPin>& increments,
+                                                     const size_t& pin_begin,
+                                                     const size_t& pin_end) {
+  VTR_ASSERT(pin_begin < pin_end);
+
+  std::vector<std::string> segments;
+  size_t segment_begin = pin_begin;
+  for (size_t ipin = pin_begin + 1; ipin <= pin_end; ++ipin) {
+    /* Extend the segment as long as the pin is the next bit of the same word */
+    if ( (ipin < pin_end)
+      && (pins[ipin].signal == pins[ipin - 1].signal)
+      && (pins[ipin].word == pins[ipin - 1].word)
+      && (pins[ipin].bit == pins[ipin - 1].bit + 1)
+      && (increments[ipin].word == increments[ipin - 1].word)
+      && (increments[ipin].bit == increments[ipin - 1].bit)) {
+      continue;
+    }
+    const VerilogCompactPin& first_pin = pins[segment_begin];
+    const VerilogCompactSignal& signal = compact_signals.signals[first_pin.signal];
+    std::string segment = signal.range.get_name();
+    if (0 < signal.num_words) {
+      segment += "[" + generate_verilog_compact_index(first_pin.word, increments[segment_begin].word) + "]";
+    }
+    segment += "[" + generate_verilog_compact_index(first_pin.bit, increments[segment_begin].bit);
+    if (ipin - 1 != segment_begin) {
+      segment += ":" + generate_verilog_compact_index(pins[ipin - 1].bit, increments[segment_begin].bit);
+    }
+    segment += "]";
+    segments.push_back(segment);
+    segment_begin = ipin;
+  }
+
+  if (1 == segments.size()) {
+    return segments[0];
+  }
+
+  std::string connection("{");
+  for (size_t iseg = 0; iseg < segments.size(); ++iseg) {
+    if (0 < iseg) {
+      connection += ", ";
+    }
+    connection += segments[iseg];
+  }
+  connection += "}";
+  return connection;
+}
+
+/********************************************************************
+ * Write an instance of a compact module to a file,
+ * which is either an explicit instance or the body of a loop
+ *******************************************************************/
+static 
+void write_verilog_compact_instance_to_file(std::fstream& fp,
+                                            const VerilogCompactSignals& compact_signals,
+                                            const ModuleManager& module_manager,
+                                            const ModuleId& child_module,
+                                            const std::string& instance_name,
+                                            const std::vector<VerilogCompactPin>& pins,
+                                            const std::vector<VerilogCompactPin>& increments,
+                                            const bool& use_explicit_port_map,
+                                            const std::string& indent) {
+  fp << indent << "\t" << module_manager.module_name(child_module) << " " << instance_name << " (\n";
+
+  size_t port_cnt = 0;
+  size_t pin_begin = 0;
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const ModulePortId& child_port_id : module_manager.module_port_ids_by_type(child_module, ModuleManager::e_module_port_type(port_type))) {
+      const BasicPort& child_port = module_manager.module_port(child_module, child_port_id);
+      if (0 != port_cnt) {
+        fp << ",\n"; 
+      }
+      fp << indent << "\t\t";
+      if (true == use_explicit_port_map) {
+        fp << "." << child_port.get_name() << "(";
+      }
+      fp << generate_verilog_compact_port_connection(compact_signals, pins, increments,
+                                                     pin_begin, pin_begin + child_port.get_width());
+      if (true == use_explicit_port_map) {
+        fp << ")";
+      }
+      pin_begin += child_port.get_width();
+      port_cnt++;
+    }
+  }
+  VTR_ASSERT(pin_begin == pins.size());
+
+  fp << ");\n";
+}
+
+/********************************************************************
+ * Write a Verilog module to a file in a compact way,
+ * where regular instance arrays are written in generate-for loops
+ * See the comments above for details
+ * Note that file stream must be valid 
+ *******************************************************************/
+void write_verilog_compact_module_to_file(std::fstream& fp,
+                                          const ModuleManager& module_manager,
+                                          const ModuleId& module_id,
+                                          const bool& use_explicit_port_map,
+                                          const e_verilog_default_net_type& default_net_type) {
+
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  /* Ensure we have a valid module_id */
+  VTR_ASSERT(module_manager.valid_module_id(module_id)); 
+
+  /* Print module declaration */
+  print_verilog_module_declaration(fp, module_manager, module_id, default_net_type);
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Find all the signals to be declared before writing instances */
+  VerilogCompactSignals compact_signals;
+  for (ModuleId child_module : module_manager.child_modules(module_id)) {
+    for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
+      find_verilog_compact_instance_pins(compact_signals, module_manager, module_id, child_module, instance);
+    }
+  }
+
+  /* Print internal wires and wire arrays */
+  for (const VerilogCompactSignal& signal : compact_signals.signals) {
+    if (false == signal.declared) {
+      continue;
+    }
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, signal.range);
+    if (0 < signal.num_words) {
+      fp << " [0:" << signal.num_words - 1 << "]";
+    }
+    fp << ";\n";
+  }
+  fp << "genvar " << VERILOG_INSTANCE_ARRAY_GENVAR << ";\n";
+
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print local connection (from module inputs to output! */
+  print_verilog_comment(fp, std::string("----- BEGIN Local short connections -----"));
+  print_verilog_module_local_short_connections(fp, module_manager, module_id);
+  print_verilog_comment(fp, std::string("----- END Local short connections -----"));
+
+  print_verilog_comment(fp, std::string("----- BEGIN Local output short connections -----"));
+  print_verilog_module_output_short_connections(fp, module_manager, module_id);
+ 
+  print_verilog_comment(fp, std::string("----- END Local output short connections -----"));
+  /* Print an empty line as splitter */
+  fp << "\n";
+
+  /* Print instances, child module by child module */
+  for (ModuleId child_module : module_manager.child_modules(module_id)) {
+    std::vector<std::vector<VerilogCompactPin>> instance_pins;
+    for (size_t instance : module_manager.child_module_instances(module_id, child_module)) {
+      VTR_ASSERT(instance == instance_pins.size());
+      instance_pins.push_back(find_verilog_compact_instance_pins(compact_signals, module_manager, module_id, child_module, instance));
+    }
+
+    std::vector<VerilogCompactPin> increments;
+    for (size_t first = 0; first < instance_pins.size(); ) {
+      /* Find the longest loop starting from the instance */
+      size_t num_loop_instances = 1;
+      if ( (first + 1 < instance_pins.size())
+        && (true == find_verilog_compact_pin_increments(increments, instance_pins[first], instance_pins[first + 1]))) {
+        num_loop_instances = 2;
+        while ( (first + num_loop_instances < instance_pins.size())
+             && (true == verilog_compact_pins_follow_increments(instance_pins[first], increments,
+                                                                instance_pins[first + num_loop_instances],
+                                                                num_loop_instances))) {
+          num_loop_instances++;
+        }
+      }
+
+      if (1 == num_loop_instances) {
+        /* Print an explicit instance, following write_verilog_instance_to_file() */
+        std::string instance_name = module_manager.instance_name(module_id, child_module, first);
+        if (true == instance_name.empty()) {
+          instance_name = generate_instance_name(module_manager.module_name(child_module), first);
+        }
+        increments.assign(instance_pins[first].size(), VerilogCompactPin{0, 0, 0});
+        write_verilog_compact_instance_to_file(fp, compact_signals, module_manager, child_module, instance_name,
+                                               instance_pins[first], increments, use_explicit_port_map,
+                                               std::string());
+      } else {
+        std::string block_name = generate_instance_name(module_manager.module_name(child_module), first) + std::string(VERILOG_WIRE_ARRAY_POSTFIX);
+        fp << "\tgenerate\n";
+        fp << "\tfor (" << VERILOG_INSTANCE_ARRAY_GENVAR << " = 0; ";
+        fp << VERILOG_INSTANCE_ARRAY_GENVAR << " < " << num_loop_instances << "; ";
+        fp << VERILOG_INSTANCE_ARRAY_GENVAR << " = " << VERILOG_INSTANCE_ARRAY_GENVAR << " + 1) begin : " << block_name << "\n";
+        write_verilog_compact_instance_to_file(fp, compact_signals, module_manager, child_module, std::string("inst"),
+                                               instance_pins[first], increments, use_explicit_port_map,
+                                               std::string("\t"));
+        fp << "\tend\n";
+        fp << "\tendgenerate\n";
+      }
+      /* Print an empty line as splitter */
+      fp << "\n";
+
+      first += num_loop_instances;
     }
   }
 
@@ -533,10 +1042,10 @@ void write_verilog_module_to_file(std::fstream& fp,
   print_verilog_module_end(fp, module_manager.module_name(module_id)); 
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 } /* end namespace openfpga */
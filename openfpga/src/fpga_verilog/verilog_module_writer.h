@@ -21,6 +21,12 @@ void write_verilog_module_to_file(std::fstream& fp,
                                   const bool& use_explicit_port_map,
                                   const e_verilog_default_net_type& default_net_type);
 
+void write_verilog_compact_module_to_file(std::fstream& fp,
+                                          const ModuleManager& module_manager,
+                                          const ModuleId& module_id,
+                                          const bool& use_explicit_port_map,
+                                          const e_verilog_default_net_type& default_net_type);
+
 } /* end namespace openfpga */
 
 #endif
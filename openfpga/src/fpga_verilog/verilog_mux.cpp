@@ -21,6 +21,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 
 #include "mux_graph.h"
 #include "module_manager.h"
@@ -58,11 +59,11 @@ void generate_verilog_cmos_mux_branch_body_behavioral(std::fstream& fp,
   /* Add an internal register for the output */
   BasicPort outreg_port("out_reg", mux_graph.num_outputs());
   /* Print the port */
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << std::endl; 
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";\n"; 
 
   /* Generate the case-switch table */
-  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << std::endl; 
-  fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")" << std::endl;
+  fp << "\talways @(" << generate_verilog_port(VERILOG_PORT_CONKT, input_port) << ", " << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")\n"; 
+  fp << "\tcase (" << generate_verilog_port(VERILOG_PORT_CONKT, mem_port) << ")\n";
 
   /* Output the netlist following the connections in mux_graph */
   /* Iterate over the inputs */
@@ -93,21 +94,21 @@ void generate_verilog_cmos_mux_branch_body_behavioral(std::fstream& fp,
         case_code[size_t(mux_mem)] = '0';
       }
       fp << case_code << ": " << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-      fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";" << std::endl;
+      fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_input_port) << ";\n";
     }
   }
 
   /* Default case: outputs are at high-impedance state 'z' */
   std::string default_case(mux_graph.num_outputs(), 'z');
   fp << "\t\tdefault: " << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
-  fp << mux_graph.num_outputs() << "'b" << default_case << ";" << std::endl;
+  fp << mux_graph.num_outputs() << "'b" << default_case << ";\n";
 
   /* End the case */
-  fp << "\tendcase" << std::endl;
+  fp << "\tendcase\n";
 
   /* Wire registers to output ports */
   fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " = ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << ";\n";
 }
 
 /*********************************************************************
@@ -411,7 +412,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   /* Add an internal register for the output */
   BasicPort outreg_port("out_reg", mux_graph.num_inputs());
   /* Print the port */
-  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";" << std::endl; 
+  fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, outreg_port) << ";\n"; 
 
   /* Print the internal logics */
   fp << "\t" << "always @(";
@@ -419,7 +420,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   fp << ", ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, wl_port); 
   fp << ")";
-  fp << " begin" << std::endl;
+  fp << " begin\n";
 
   /* Only when the last bit of wl is enabled, 
    * the propagating path can be changed 
@@ -465,7 +466,7 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
   }
 
   /* Finish the if clause */
-  fp << ") begin" << std::endl;
+  fp << ") begin\n";
 
   for (const auto& mux_input : mux_graph.inputs()) {
     /* First if clause need tabs */
@@ -476,26 +477,26 @@ void generate_verilog_rram_mux_branch_body_behavioral(std::fstream& fp,
     /* Create a temp port of a BLB bit */
     BasicPort cur_blb_port(blb_port.get_name(), size_t(mux_graph.input_id(mux_input)), size_t(mux_graph.input_id(mux_input)));
     fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_blb_port); 
-    fp << ") begin" << std::endl;
+    fp << ") begin\n";
     fp << "\t\t\t\t" << "assign ";
   fp << outreg_port.get_name(); 
-    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";" << std::endl;
+    fp << " = " << size_t(mux_graph.input_id(mux_input)) << ";\n";
     fp << "\t\t\t" << "end else ";
   }
-  fp << "begin" << std::endl;
+  fp << "begin\n";
   fp << "\t\t\t\t" << "assign ";
   fp << outreg_port.get_name(); 
-  fp << " = 0;" << std::endl;
-  fp << "\t\t\t" << "end" << std::endl;
-  fp << "\t\t" << "end" << std::endl;
-  fp << "\t" << "end" << std::endl;
+  fp << " = 0;\n";
+  fp << "\t\t\t" << "end\n";
+  fp << "\t\t" << "end\n";
+  fp << "\t" << "end\n";
  
   fp << "\t" << "assign ";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << " = "; 
   fp << input_port.get_name() << "[";
   fp << outreg_port.get_name(); 
-  fp << "];" << std::endl;
+  fp << "];\n";
 }
 
 /*********************************************************************
@@ -614,7 +615,7 @@ void generate_verilog_mux_branch_module(ModuleManager& module_manager,
                                    use_explicit_port_map || circuit_lib.dump_explicit_port_map(mux_model),
                                    default_net_type);
       /* Add an empty line as a splitter */
-      fp << std::endl;
+      fp << "\n";
     } else {
       /* Behavioral verilog requires customized generation */
       print_verilog_cmos_mux_branch_module_behavioral(module_manager,
@@ -707,7 +708,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
       print_verilog_comment(fp, std::string("---- BEGIN short-wire a multiplexing structure input to a constant value -----"));
       print_verilog_wire_constant_values(fp, instance_output_port, std::vector<size_t>(1, const_value));
       print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure input to a constant value -----"));
-      fp << std::endl;
+      fp << "\n";
       continue; /* Finish here */
     }
 
@@ -719,7 +720,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
       print_verilog_wire_connection(fp, instance_output_port, instance_input_port, false);      
 
       print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure input to MUX module input -----"));
-      fp << std::endl;
+      fp << "\n";
       continue; /* Finish here */
     }
 
@@ -734,7 +735,7 @@ void generate_verilog_cmos_mux_module_input_buffers(ModuleManager& module_manage
     print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, instance_input_port, instance_output_port);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of an input buffer module -----"));
-    fp << std::endl;
+    fp << "\n";
   } 
 }
 
@@ -798,7 +799,7 @@ void generate_verilog_cmos_mux_module_output_buffers(ModuleManager& module_manag
         print_verilog_wire_connection(fp, instance_output_port, instance_input_port, false);      
 
         print_verilog_comment(fp, std::string("---- END short-wire a multiplexing structure output to MUX module output -----"));
-        fp << std::endl;
+        fp << "\n";
         continue; /* Finish here */
       }
 
@@ -813,7 +814,7 @@ void generate_verilog_cmos_mux_module_output_buffers(ModuleManager& module_manag
       print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, instance_input_port, instance_output_port);
 
       print_verilog_comment(fp, std::string("---- END Instanciation of an output buffer module -----"));
-      fp << std::endl;
+      fp << "\n";
     }
   }
 }
@@ -853,16 +854,16 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
   for (size_t level = 0; level < mux_graph.num_levels(); ++level) {
     /* Print the internal wires located at this level */
     BasicPort internal_wire_port(generate_mux_node_name(level, false), mux_graph.num_nodes_at_level(level));
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port) << ";" << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_port) << ";\n";
     /* Identify if an intermediate buffer is needed */
     if (false == inter_buffer_location_map[level]) { 
       continue;
     }
     BasicPort internal_wire_buffered_port(generate_mux_node_name(level, true), mux_graph.num_nodes_at_level(level));
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port) << std::endl;
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, internal_wire_buffered_port) << "\n";
   }
   print_verilog_comment(fp, std::string("---- END Internal wires of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << "\n";
 
   /* Iterate over all the internal nodes and output nodes in the mux graph */
   for (const auto& node : mux_graph.non_input_nodes()) {
@@ -879,10 +880,8 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     /* Get the nodes which drive the root_node */
     std::vector<MuxNodeId> input_nodes; 
     for (const auto& edge : mux_graph.node_in_edges(node)) {
-      /* Get the nodes drive the edge */
-      for (const auto& src_node : mux_graph.edge_src_nodes(edge)) {
-        input_nodes.push_back(src_node);
-      }
+      /* Get the node drives the edge */
+      input_nodes.push_back(mux_graph.edge_src_node(edge));
     }
     /* Number of inputs should match the branch_input_size!!! */
     VTR_ASSERT(input_nodes.size() == branch_size);
@@ -927,7 +926,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_input_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_input_port, branch_node_input_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_input_port, branch_node_input_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_input_ports).size());
@@ -979,7 +978,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_blb_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_blb_port, branch_node_blb_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_blb_port, branch_node_blb_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_blb_ports).size());
@@ -1020,7 +1019,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
      * output a local wire */
     if (1 < combine_verilog_ports(branch_node_wl_ports).size()) {
       /* Print a local wire for the merged ports */
-      fp << "\t" << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports) << std::endl;
+      fp << "\t" << generate_verilog_local_wire(instance_wl_port, branch_node_wl_ports) << "\n";
     } else {
       /* Safety check */
       VTR_ASSERT(1 == combine_verilog_ports(branch_node_wl_ports).size());
@@ -1041,7 +1040,7 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     module_manager.add_child_module(module_id, branch_module_id);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of a branch RRAM-based MUX module -----"));
-    fp << std::endl;
+    fp << "\n";
 
     if (false == inter_buffer_location_map[output_node_level]) {
       continue; /* No need for intermediate buffers */
@@ -1060,11 +1059,11 @@ void generate_verilog_rram_mux_module_multiplexing_structure(ModuleManager& modu
     print_verilog_buffer_instance(fp, module_manager, circuit_lib, module_id, buffer_model, buffer_instance_input_port, buffer_instance_output_port);
 
     print_verilog_comment(fp, std::string("---- END Instanciation of an intermediate buffer module -----"));
-    fp << std::endl;
+    fp << "\n";
   }
 
   print_verilog_comment(fp, std::string("---- END Internal Logic of a RRAM-based MUX module -----"));
-  fp << std::endl;
+  fp << "\n";
 }
 
 /*********************************************************************
@@ -1200,10 +1199,131 @@ void generate_verilog_rram_mux_module(ModuleManager& module_manager,
   print_verilog_module_end(fp, module_name);
 }
 
+/*********************************************************************
+ * Identify if a behavioral model for fast simulation can be written
+ * for a CMOS multiplexer. The following multiplexers are only written
+ * in structural Verilog:
+ * - the multiplexers of LUTs, which may have intermediate buffers 
+ *   and fracturable outputs
+ * - the multiplexers built with standard cell MUX2, 
+ *   whose functions are defined by users 
+ * - the multiplexers with local encoders
+ *********************************************************************/
+static 
+bool is_verilog_cmos_mux_fast_sim_model_supported(const CircuitLibrary& circuit_lib,
+                                                  const CircuitModelId& mux_model,
+                                                  const MuxGraph& mux_graph) {
+  if (CIRCUIT_MODEL_MUX != circuit_lib.model_type(mux_model)) {
+    return false;
+  }
+  if (CIRCUIT_MODEL_PASSGATE != circuit_lib.model_type(circuit_lib.pass_gate_logic_model(mux_model))) {
+    return false;
+  }
+  if (true == circuit_lib.mux_use_local_encoder(mux_model)) {
+    return false;
+  }
+  return 1 == mux_graph.num_outputs();
+}
+
+/*********************************************************************
+ * Generate the expression of the signal at a node of a multiplexer,
+ * following the paths of the mux graph from the node to the inputs.
+ * Each branch selects the input whose pass-gate is enabled by the
+ * memory bits, and outputs a high-impedance state when no input is 
+ * selected, like the pass-gates do.
+ * Compiled simulators do not model high-impedance states, 
+ * so a logic 0 can be output instead
+ *********************************************************************/
+static 
+std::string generate_verilog_cmos_mux_node_fast_sim_expr(const CircuitLibrary& circuit_lib,
+                                                         const CircuitModelId& mux_model, 
+                                                         const MuxGraph& mux_graph,
+                                                         const MuxNodeId& node,
+                                                         const BasicPort& input_port,
+                                                         const BasicPort& mem_port,
+                                                         const bool& no_high_impedance) {
+  if (true == mux_graph.is_node_input(node)) {
+    MuxInputId input_id = mux_graph.input_id(node);
+    /* The last input may be wired to a constant value */
+    if ( (MuxInputId(mux_graph.num_inputs() - 1) == input_id) 
+      && (true == circuit_lib.mux_add_const_input(mux_model)) ) {
+      return std::string("1'b") + std::to_string(circuit_lib.mux_const_input_value(mux_model));
+    }
+    std::string input_expr = generate_verilog_port(VERILOG_PORT_CONKT, BasicPort(input_port.get_name(), size_t(input_id), size_t(input_id)));
+    if ( (true == circuit_lib.is_input_buffered(mux_model))
+      && (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_lib.input_buffer_model(mux_model))) ) {
+      input_expr = "~" + input_expr;
+    }
+    return input_expr;
+  }
+
+  std::string node_expr("(");
+  for (const auto& edge : mux_graph.node_in_edges(node)) {
+    MuxMemId mem = mux_graph.find_edge_mem(edge);
+    if (true == mux_graph.is_edge_use_inv_mem(edge)) {
+      node_expr += "~";
+    }
+    node_expr += generate_verilog_port(VERILOG_PORT_CONKT, BasicPort(mem_port.get_name(), size_t(mem), size_t(mem)));
+    node_expr += " ? ";
+    node_expr += generate_verilog_cmos_mux_node_fast_sim_expr(circuit_lib, mux_model, mux_graph, mux_graph.edge_src_node(edge), input_port, mem_port, no_high_impedance);
+    node_expr += " : ";
+  }
+  node_expr += (true == no_high_impedance) ? "1'b0)" : "1'bz)";
+
+  return node_expr;
+}
+
+/*********************************************************************
+ * Generate a behavioral model of a CMOS multiplexer for fast simulation
+ * The model has the same ports as the structural netlist, and drives the
+ * output with a single continuous assignment, selecting the input 
+ * whose path in the mux graph is enabled by the memory bits
+ * Only the regular memory ports are used, as the pass-gates of the
+ * structural netlist, which are driven by both regular and inverted
+ * memory ports, are configured by complementary values
+ *********************************************************************/
+static 
+void generate_verilog_cmos_mux_module_fast_sim_model(const ModuleManager& module_manager,
+                                                     const CircuitLibrary& circuit_lib, 
+                                                     std::fstream& fp, 
+                                                     const ModuleId& mux_module, 
+                                                     const CircuitModelId& mux_model, 
+                                                     const MuxGraph& mux_graph,
+                                                     const e_verilog_default_net_type& default_net_type,
+                                                     const bool& no_high_impedance) {
+  std::vector<CircuitPortId> mux_input_ports = circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_INPUT, true);
+  std::vector<CircuitPortId> mux_output_ports = circuit_lib.model_ports_by_type(mux_model, CIRCUIT_MODEL_PORT_OUTPUT, false);
+  std::vector<CircuitPortId> mux_sram_ports = find_circuit_regular_sram_ports(circuit_lib, mux_model);
+  VTR_ASSERT(1 == mux_input_ports.size());
+  VTR_ASSERT(1 == mux_output_ports.size());
+  VTR_ASSERT(1 == mux_sram_ports.size());
+
+  BasicPort input_port = module_manager.module_port(mux_module, module_manager.find_module_port(mux_module, circuit_lib.port_prefix(mux_input_ports[0])));
+  BasicPort output_port = module_manager.module_port(mux_module, module_manager.find_module_port(mux_module, circuit_lib.port_prefix(mux_output_ports[0])));
+  BasicPort mem_port = module_manager.module_port(mux_module, module_manager.find_module_port(mux_module, circuit_lib.port_prefix(mux_sram_ports[0])));
+
+  std::string output_expr = generate_verilog_cmos_mux_node_fast_sim_expr(circuit_lib, mux_model, mux_graph, mux_graph.outputs()[0], input_port, mem_port, no_high_impedance);
+  if ( (true == circuit_lib.is_output_buffered(mux_model))
+    && (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_lib.output_buffer_model(mux_model))) ) {
+    output_expr = "~" + output_expr;
+  }
+
+  print_verilog_module_declaration(fp, module_manager, mux_module, default_net_type);
+
+  print_verilog_comment(fp, std::string("---- Behavioral model for fast simulation -----"));
+  fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " = " << output_expr << ";\n";
+
+  print_verilog_module_end(fp, module_manager.module_name(mux_module));
+}
 
 /***********************************************
  * Generate Verilog codes modeling a multiplexer 
  * with the given graph-level description
+ * When fast simulation models are required, a behavioral
+ * model is written besides the structural netlist, 
+ * and selected by a preprocessing flag.
+ * The behavioral model never outputs a high-impedance state 
+ * when the netlists are friendly to Verilator
  **********************************************/
 static 
 void generate_verilog_mux_module(ModuleManager& module_manager,
@@ -1212,7 +1332,9 @@ void generate_verilog_mux_module(ModuleManager& module_manager,
                                  const CircuitModelId& mux_model, 
                                  const MuxGraph& mux_graph,
                                  const bool& use_explicit_port_map,
-                                 const e_verilog_default_net_type& default_net_type) {
+                                 const e_verilog_default_net_type& default_net_type,
+                                 const bool& fast_sim_models,
+                                 const bool& verilator_friendly) {
   std::string module_name = generate_mux_subckt_name(circuit_lib, mux_model, 
                                                      find_mux_num_datapath_inputs(circuit_lib, mux_model, mux_graph.num_inputs()), 
                                                      std::string(""));
@@ -1223,13 +1345,23 @@ void generate_verilog_mux_module(ModuleManager& module_manager,
     /* Use Verilog writer to print the module to file */
     ModuleId mux_module = module_manager.find_module(module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
+    bool use_fast_sim_model = fast_sim_models
+                           && is_verilog_cmos_mux_fast_sim_model_supported(circuit_lib, mux_model, mux_graph);
+    if (true == use_fast_sim_model) {
+      print_verilog_preprocessing_flag(fp, std::string(VERILOG_FAST_SIM_MODELS_PREPROC_FLAG));
+      generate_verilog_cmos_mux_module_fast_sim_model(module_manager, circuit_lib, fp, mux_module, mux_model, mux_graph, default_net_type, verilator_friendly);
+      fp << "`else\n";
+    }
     write_verilog_module_to_file(fp, module_manager, mux_module, 
                                   ( use_explicit_port_map 
                                  || circuit_lib.dump_explicit_port_map(mux_model) 
                                  || circuit_lib.dump_explicit_port_map(circuit_lib.pass_gate_logic_model(mux_model)) ), 
                                  default_net_type);
+    if (true == use_fast_sim_model) {
+      print_verilog_endif(fp);
+    }
     /* Add an empty line as a splitter */
-    fp << std::endl;
+    fp << "\n";
     break;
   }
   case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -1265,7 +1397,7 @@ void print_verilog_submodule_mux_primitives(ModuleManager& module_manager,
   std::string verilog_fname(submodule_dir + std::string(MUX_PRIMITIVES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -1287,9 +1419,11 @@ void print_verilog_submodule_mux_primitives(ModuleManager& module_manager,
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux); 
     /* Create a mux graph for the branch circuit */
     std::vector<MuxGraph> branch_mux_graphs = mux_graph.build_mux_branch_graphs();
-    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
+    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes,
+     * named after the circuit model sharing them
+     */
     for (auto branch_mux_graph : branch_mux_graphs) {
-      generate_verilog_mux_branch_module(module_manager, circuit_lib, fp, mux_circuit_model, 
+      generate_verilog_mux_branch_module(module_manager, circuit_lib, fp, mux_lib.branch_circuit_model(mux_circuit_model), 
                                          branch_mux_graph,
                                          options.explicit_port_mapping(),
                                          options.default_net_type(),
@@ -1323,7 +1457,7 @@ void print_verilog_submodule_mux_top_modules(ModuleManager& module_manager,
   std::string verilog_fname(submodule_dir + std::string(MUXES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -1345,7 +1479,9 @@ void print_verilog_submodule_mux_top_modules(ModuleManager& module_manager,
                                 mux_circuit_model,
                                 mux_graph,
                                 options.explicit_port_mapping(),
-                                options.default_net_type());
+                                options.default_net_type(),
+                                options.fast_sim_models(),
+                                options.verilator_friendly());
   }
 
   /* Close the file stream */
@@ -3,6 +3,7 @@
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
 #include <fstream>
+#include <algorithm>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -15,7 +16,6 @@
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
 
-#include "bitstream_manager_utils.h"
 #include "openfpga_atom_netlist_utils.h"
 
 #include "openfpga_naming.h"
@@ -220,18 +220,9 @@ void print_verilog_preconfig_top_module_assign_bitstream(std::fstream &fp,
       continue;
     }
     /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-    /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
+    std::string bit_hierarchy_path = find_verilog_testbench_config_block_hierarchy_path(module_manager, top_module,
+                                                                                        bitstream_manager, config_block_id,
+                                                                                        std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
 
     /* Find the bit index in the parent block */
     BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
@@ -254,18 +245,9 @@ void print_verilog_preconfig_top_module_assign_bitstream(std::fstream &fp,
         continue;
       }
       /* Build the hierarchical path of the configuration bit in modules */
-      std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-      /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-      /* Ensure that this is the module we want to drop! */
-      VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-      block_hierarchy.erase(block_hierarchy.begin());
-      /* Build the full hierarchy path */
-      std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-      for (const ConfigBlockId &temp_block : block_hierarchy) {
-        bit_hierarchy_path += std::string(".");
-        bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-      }
-      bit_hierarchy_path += std::string(".");
+      std::string bit_hierarchy_path = find_verilog_testbench_config_block_hierarchy_path(module_manager, top_module,
+                                                                                          bitstream_manager, config_block_id,
+                                                                                          std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
 
       /* Find the bit index in the parent block */
       BasicPort config_datab_port(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(),
@@ -307,18 +289,9 @@ void print_verilog_preconfig_top_module_deposit_bitstream(std::fstream &fp,
       continue;
     }
     /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
-    /* Drop the first block, which is the top module, it should be replaced by the instance name here */
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
+    std::string bit_hierarchy_path = find_verilog_testbench_config_block_hierarchy_path(module_manager, top_module,
+                                                                                        bitstream_manager, config_block_id,
+                                                                                        std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
 
     /* Find the bit index in the parent block */
     BasicPort config_data_port(bit_hierarchy_path + generate_configurable_memory_data_out_name(),
@@ -352,6 +325,118 @@ void print_verilog_preconfig_top_module_deposit_bitstream(std::fstream &fp,
   print_verilog_comment(fp, std::string("----- End deposit bitstream to configuration memories -----"));
 }
 
+/********************************************************************
+ * Impose the bitstream on the configuration memories through a memory file
+ * Each configuration block takes a row of the memory file, which is
+ * loaded by '$readmemb' to a memory in the pre-configured top module.
+ * The configuration memories are then driven by the rows of the memory,
+ * so that the netlist does not spell out any bit of the bitstream:
+ * 1. iVerilog Icarus uses 'assign' at mem port and 'force' at mem_inv port
+ * 2. Other simulators use '$deposit' at both ports
+ * The mem_inv ports are driven by inverted rows, which are not in the file
+ *
+ * Example of a row:
+ *   FPGA fabric        : U0.grid_clb_1_1.<...>.mem_out[0:3]
+ *   Memory file        : 0110
+ *   Pre-configured top : bitstream_mem[2][3:0]
+ *
+ * Return:
+ *  - CMD_EXEC_SUCCESS if succeed
+ *  - CMD_EXEC_FATAL_ERROR if the memory file can not be written
+ *******************************************************************/
+static
+int print_verilog_preconfig_top_module_load_bitstream_memory(std::fstream &fp,
+                                                             const ModuleManager &module_manager,
+                                                             const ModuleId &top_module,
+                                                             const BitstreamManager &bitstream_manager,
+                                                             const bool& output_datab_bits,
+                                                             const std::string& memory_fname) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Collect the configuration blocks, each of which takes a row in the memory */
+  std::vector<ConfigBlockId> config_blocks;
+  size_t memory_width = 0;
+  for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
+    /* We only cares blocks with configuration bits */
+    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
+      continue;
+    }
+    config_blocks.push_back(config_block_id);
+    memory_width = std::max(memory_width, bitstream_manager.block_bits(config_block_id).size());
+  }
+
+  if (true == config_blocks.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* Output the memory file: the first bit of a block is the most significant bit of its row */
+  if (CMD_EXEC_SUCCESS != write_verilog_testbench_config_block_memory_file(memory_fname, bitstream_manager, config_blocks)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  print_verilog_comment(fp, std::string("----- Begin load bitstream memory file to configuration memories -----"));
+
+  std::string memory_name(FORMAL_VERIFICATION_BITSTREAM_MEMORY_NAME);
+  fp << "\treg [" << memory_width - 1 << ":0] " << memory_name;
+  fp << " [0:" << config_blocks.size() - 1 << "];\n";
+
+  /* Rows of the memory which drives the ports of each block, as well as the inverted rows */
+  std::vector<BasicPort> config_data_ports;
+  std::vector<BasicPort> config_datab_ports;
+  std::vector<std::string> memory_rows;
+  for (size_t irow = 0; irow < config_blocks.size(); ++irow) {
+    std::string bit_hierarchy_path = find_verilog_testbench_config_block_hierarchy_path(module_manager, top_module,
+                                                                                        bitstream_manager, config_blocks[irow],
+                                                                                        std::string(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME));
+    size_t num_bits = bitstream_manager.block_bits(config_blocks[irow]).size();
+    config_data_ports.push_back(BasicPort(bit_hierarchy_path + generate_configurable_memory_data_out_name(), num_bits));
+    config_datab_ports.push_back(BasicPort(bit_hierarchy_path + generate_configurable_memory_inverted_data_out_name(), num_bits));
+    memory_rows.push_back(memory_name + "[" + std::to_string(irow) + "][" + std::to_string(num_bits - 1) + ":0]");
+  }
+
+  print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG));
+
+  /* Use assign syntax for Icarus simulator */
+  for (size_t irow = 0; irow < config_blocks.size(); ++irow) {
+    fp << "\tassign " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_ports[irow]);
+    fp << " = " << memory_rows[irow] << ";\n";
+  }
+
+  fp << "initial begin\n";
+  fp << "\t$readmemb(\"" << memory_fname << "\", " << memory_name << ");\n";
+  if (true == output_datab_bits) {
+    for (size_t irow = 0; irow < config_blocks.size(); ++irow) {
+      fp << "\tforce " << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_ports[irow]);
+      fp << " = ~" << memory_rows[irow] << ";\n";
+    }
+  }
+  fp << "end\n";
+
+  fp << "`else\n";
+
+  /* Use deposit syntax for other simulators, which must be done after the memory is loaded */
+  fp << "initial begin\n";
+  fp << "\t$readmemb(\"" << memory_fname << "\", " << memory_name << ");\n";
+  for (size_t irow = 0; irow < config_blocks.size(); ++irow) {
+    fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_data_ports[irow]);
+    fp << ", " << memory_rows[irow] << ");\n";
+    /* Skip datab ports if specified */
+    if (false == output_datab_bits) {
+      continue;
+    }
+    fp << "\t$deposit(" << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_ports[irow]);
+    fp << ", ~" << memory_rows[irow] << ");\n";
+  }
+  fp << "end\n";
+
+  print_verilog_endif(fp);
+
+  print_verilog_comment(fp, std::string("----- End load bitstream memory file to configuration memories -----"));
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Impose the bitstream on the configuration memories
  * We branch here for different simulators:
@@ -359,12 +444,13 @@ void print_verilog_preconfig_top_module_deposit_bitstream(std::fstream &fp,
  * 2. Mentor Modelsim prefers using '$deposit' syntax to do so
  *******************************************************************/
 static 
-void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
-                                                       const ModuleManager &module_manager,
-                                                       const ModuleId &top_module,
-                                                       const CircuitLibrary& circuit_lib,
-                                                       const CircuitModelId& mem_model,
-                                                       const BitstreamManager &bitstream_manager) {
+int print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
+                                                      const ModuleManager &module_manager,
+                                                      const ModuleId &top_module,
+                                                      const CircuitLibrary& circuit_lib,
+                                                      const CircuitModelId& mem_model,
+                                                      const BitstreamManager &bitstream_manager,
+                                                      const std::string& bitstream_memory_fname) {
 
   /* Skip the datab port if there is only 1 output port in memory model
    * Currently, it assumes that the data output port is always defined while datab is optional
@@ -377,6 +463,14 @@ void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
     output_datab_bits = false;
   }
 
+  /* Load the bitstream from a memory file when it is specified */
+  if (false == bitstream_memory_fname.empty()) {
+    return print_verilog_preconfig_top_module_load_bitstream_memory(fp, module_manager, top_module,
+                                                                    bitstream_manager,
+                                                                    output_datab_bits,
+                                                                    bitstream_memory_fname);
+  }
+
   print_verilog_comment(fp, std::string("----- Begin load bitstream to configuration memories -----"));
 
   print_verilog_preprocessing_flag(fp, std::string(ICARUS_SIMULATOR_FLAG));
@@ -396,6 +490,8 @@ void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
   print_verilog_endif(fp);
 
   print_verilog_comment(fp, std::string("----- End load bitstream to configuration memories -----"));
+
+  return CMD_EXEC_SUCCESS;
 }
 
 /********************************************************************
@@ -429,6 +525,10 @@ void print_verilog_preconfig_top_module_load_bitstream(std::fstream &fp,
  * the port map of input benchmark.
  * It includes wires to force constant values to part of FPGA datapath I/Os
  * All these are hard to implement as a module in module manager
+ *
+ * When a bitstream memory file name is given, the bitstream is written
+ * to the memory file and loaded by the module, instead of being
+ * imposed bit by bit in the netlist
  *******************************************************************/
 int print_verilog_preconfig_top_module(const ModuleManager &module_manager,
                                        const BitstreamManager &bitstream_manager,
@@ -442,6 +542,7 @@ int print_verilog_preconfig_top_module(const ModuleManager &module_manager,
                                        const VprNetlistAnnotation &netlist_annotation,
                                        const std::string &circuit_name,
                                        const std::string &verilog_fname,
+                                       const std::string &bitstream_memory_fname,
                                        const VerilogTestbenchOption& options) {
   std::string timer_message = std::string("Write pre-configured FPGA top-level Verilog netlist for design '") + circuit_name + std::string("'");
 
@@ -503,9 +604,13 @@ int print_verilog_preconfig_top_module(const ModuleManager &module_manager,
   VTR_ASSERT(true == circuit_lib.valid_model_id(sram_model));
 
   /* Assign FPGA internal SRAM/Memory ports to bitstream values */
-  print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
-                                                    circuit_lib, sram_model, 
-                                                    bitstream_manager);
+  status = print_verilog_preconfig_top_module_load_bitstream(fp, module_manager, top_module,
+                                                             circuit_lib, sram_model, 
+                                                             bitstream_manager,
+                                                             bitstream_memory_fname);
+  if (CMD_EXEC_FATAL_ERROR == status) {
+    return status;
+  }
 
   /* Add signal initialization */
   print_verilog_testbench_signal_initialization(fp,
@@ -36,6 +36,7 @@ int print_verilog_preconfig_top_module(const ModuleManager& module_manager,
                                        const VprNetlistAnnotation& netlist_annotation,
                                        const std::string& circuit_name,
                                        const std::string& verilog_fname,
+                                       const std::string& bitstream_memory_fname,
                                        const VerilogTestbenchOption& options);
 
 } /* end namespace openfpga */
@@ -2,6 +2,10 @@
  * This file includes functions that are used for 
  * Verilog generation of FPGA routing architecture (global routing) 
  *********************************************************************/
+#include <string>
+#include <utility>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -9,6 +13,8 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
+#include "openfpga_parallel.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -75,18 +81,17 @@ namespace openfpga {
  *              
  ********************************************************************/
 static 
-void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_manager,
-                                                        const ModuleManager& module_manager, 
-                                                        const std::string& subckt_dir, 
-                                                        const RRGSB& rr_gsb,
-                                                        const t_rr_type& cb_type,
-                                                        const FabricVerilogOption& options) {
+std::string print_verilog_routing_connection_box_unique_module(const ModuleManager& module_manager, 
+                                                               const std::string& subckt_dir, 
+                                                               const RRGSB& rr_gsb,
+                                                               const t_rr_type& cb_type,
+                                                               const FabricVerilogOption& options) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type), rr_gsb.get_cb_y(cb_type));
   std::string verilog_fname(subckt_dir + generate_connection_block_netlist_name(cb_type, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -104,15 +109,12 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
                                options.default_net_type());
  
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  return verilog_fname;
 }
 
 /*********************************************************************
@@ -179,17 +181,16 @@ void print_verilog_routing_connection_box_unique_module(NetlistManager& netlist_
  *
  ********************************************************************/
 static 
-void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
-                                                    const std::string& subckt_dir, 
-                                                    const RRGSB& rr_gsb,
-                                                    const FabricVerilogOption& options) {
+std::string print_verilog_routing_switch_box_unique_module(const ModuleManager& module_manager, 
+                                                           const std::string& subckt_dir, 
+                                                           const RRGSB& rr_gsb,
+                                                           const FabricVerilogOption& options) {
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   std::string verilog_fname(subckt_dir + generate_routing_block_netlist_name(SB_VERILOG_FILE_NAME_PREFIX, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -210,23 +211,79 @@ void print_verilog_routing_switch_box_unique_module(NetlistManager& netlist_mana
   /* Close file handler */
   fp.close();
 
+  return verilog_fname;
+}
+
+/********************************************************************
+ * Print the netlists of a list of routing blocks, each to a separated file.
+ * A routing block is a switch block when its type is NUM_RR_TYPES,
+ * otherwise it is a connection block of the given type.
+ *
+ * The netlists are independent from each other, and are written by
+ * a number of threads. Each thread only records the file names,
+ * which are added to the netlist manager in the order of the
+ * routing blocks afterwards, so that the netlist manager is
+ * always the same as a single-thread run
+ *******************************************************************/
+static 
+void print_verilog_routing_block_netlists(NetlistManager& netlist_manager,
+                                          const ModuleManager& module_manager, 
+                                          const std::vector<std::pair<const RRGSB*, t_rr_type>>& fabric_routing_blocks,
+                                          const std::string& subckt_dir,
+                                          const FabricVerilogOption& options) {
+  /* Bypass the routing blocks whose modules are not built, e.g., in a partial fabric */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
+  routing_blocks.reserve(fabric_routing_blocks.size());
+  for (const auto& routing_block : fabric_routing_blocks) {
+    const RRGSB& rr_gsb = *routing_block.first;
+    std::string module_name;
+    if (NUM_RR_TYPES == routing_block.second) {
+      module_name = generate_switch_block_module_name(vtr::Point<size_t>(rr_gsb.get_sb_x(), rr_gsb.get_sb_y()));
+    } else {
+      module_name = generate_connection_block_module_name(routing_block.second,
+                                                          vtr::Point<size_t>(rr_gsb.get_cb_x(routing_block.second), rr_gsb.get_cb_y(routing_block.second)));
+    }
+    if (false == module_manager.valid_module_id(module_manager.find_module(module_name))) {
+      continue;
+    }
+    routing_blocks.push_back(routing_block);
+  }
+
+  std::vector<std::string> verilog_fnames(routing_blocks.size());
+
+  parallel_for(routing_blocks.size(), options.num_threads(),
+               [&](const size_t& iblock) {
+    const RRGSB& rr_gsb = *routing_blocks[iblock].first;
+    const t_rr_type& block_type = routing_blocks[iblock].second;
+    if (NUM_RR_TYPES == block_type) {
+      verilog_fnames[iblock] = print_verilog_routing_switch_box_unique_module(module_manager,
+                                                                              subckt_dir, 
+                                                                              rr_gsb, 
+                                                                              options);
+    } else {
+      verilog_fnames[iblock] = print_verilog_routing_connection_box_unique_module(module_manager,
+                                                                                  subckt_dir, 
+                                                                                  rr_gsb, block_type,  
+                                                                                  options);
+    }
+  });
+
   /* Add fname to the netlist name list */
-  NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
-  VTR_ASSERT(NetlistId::INVALID() != nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  for (const std::string& verilog_fname : verilog_fnames) {
+    NetlistId nlist_id = netlist_manager.add_netlist(verilog_fname);
+    VTR_ASSERT(NetlistId::INVALID() != nlist_id);
+    netlist_manager.set_netlist_type(nlist_id, NetlistManager::ROUTING_MODULE_NETLIST);
+  }
 }
 
 /********************************************************************
  * Iterate over all the connection blocks in a device
- * and build a module for each of them 
+ * and collect those to be printed as a module 
  *******************************************************************/
 static 
-void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_manager,
-                                                    const ModuleManager& module_manager, 
-                                                    const DeviceRRGSB& device_rr_gsb,
-                                                    const std::string& subckt_dir,
-                                                    const t_rr_type& cb_type,
-                                                    const FabricVerilogOption& options) {
+void collect_flatten_connection_blocks(std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_blocks,
+                                       const DeviceRRGSB& device_rr_gsb,
+                                       const t_rr_type& cb_type) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
@@ -240,11 +297,7 @@ void print_verilog_flatten_connection_block_modules(NetlistManager& netlist_mana
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                         module_manager,
-                                                         subckt_dir, 
-                                                         rr_gsb, cb_type,  
-                                                         options);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, cb_type));
     }
   }
 }
@@ -263,8 +316,8 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
                                            const DeviceRRGSB& device_rr_gsb,
                                            const std::string& subckt_dir,
                                            const FabricVerilogOption& options) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+  /* Routing blocks are printed in the order of switch blocks, X- and Y-direction connection blocks */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -275,37 +328,18 @@ void print_verilog_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist()) {
         continue;
       }
-      print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                     module_manager, 
-                                                     subckt_dir, 
-                                                     rr_gsb, 
-                                                     options);
+      routing_blocks.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  print_verilog_flatten_connection_block_modules(netlist_manager,
-                                                 module_manager,
-                                                 device_rr_gsb,
-                                                 subckt_dir,
-                                                 CHANX,
-                                                 options);
-
-  print_verilog_flatten_connection_block_modules(netlist_manager,
-                                                 module_manager,
-                                                 device_rr_gsb,
-                                                 subckt_dir,
-                                                 CHANY,
-                                                 options);
-
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_verilog_netlist_include_header_file(netlist_names,
-                                            subckt_dir.c_str(),
-                                            ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
-   */
+  collect_flatten_connection_blocks(routing_blocks, device_rr_gsb, CHANX);
+  collect_flatten_connection_blocks(routing_blocks, device_rr_gsb, CHANY);
+
+  print_verilog_routing_block_netlists(netlist_manager,
+                                       module_manager,
+                                       routing_blocks,
+                                       subckt_dir,
+                                       options);
 }
 
 
@@ -324,49 +358,33 @@ void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
                                           const DeviceRRGSB& device_rr_gsb,
                                           const std::string& subckt_dir,
                                           const FabricVerilogOption& options) {
-  /* Create a vector to contain all the Verilog netlist names that have been generated in this function */
-  std::vector<std::string> netlist_names;
+  /* Routing blocks are printed in the order of switch blocks, X- and Y-direction connection blocks */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_blocks;
+  routing_blocks.reserve(device_rr_gsb.get_num_sb_unique_module()
+                       + device_rr_gsb.get_num_cb_unique_module(CHANX)
+                       + device_rr_gsb.get_num_cb_unique_module(CHANY));
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_verilog_routing_switch_box_unique_module(netlist_manager,
-                                                   module_manager,
-                                                   subckt_dir, 
-                                                   unique_mirror, 
-                                                   options);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_sb_unique_module(isb), NUM_RR_TYPES));
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager,
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANX,  
-                                                       options);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_cb_unique_module(CHANX, icb), CHANX));
   }
 
-  /* Build unique X-direction connection block modules */
+  /* Build unique Y-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY); ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_verilog_routing_connection_box_unique_module(netlist_manager, 
-                                                       module_manager,
-                                                       subckt_dir, 
-                                                       unique_mirror, CHANY,  
-                                                       options);
+    routing_blocks.push_back(std::make_pair(&device_rr_gsb.get_cb_unique_module(CHANY, icb), CHANY));
   }
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_verilog_netlist_include_header_file(netlist_names,
-                                            subckt_dir.c_str(),
-                                            ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-   */
+  print_verilog_routing_block_netlists(netlist_manager,
+                                       module_manager,
+                                       routing_blocks,
+                                       subckt_dir,
+                                       options);
+
   VTR_LOG("\n");
 }
 
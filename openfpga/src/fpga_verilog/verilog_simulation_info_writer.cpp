@@ -26,9 +26,51 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/*********************************************************************
+ * Add the seeds of the partitions [first_partition, first_partition + num_partitions)
+ * of random stimulus to the simulation deck
+ * The seeds are numbered from 0 in the deck, while their values follow
+ * the index of their partitions among all the partitions
+ ********************************************************************/
+static
+void add_simulation_random_partitions(mINI::INIStructure& ini,
+                                      const int& random_seed,
+                                      const size_t& first_partition,
+                                      const size_t& num_partitions) {
+  ini["SIMULATION_DECK"]["NUM_RANDOM_PARTITIONS"] = std::to_string(num_partitions);
+  for (size_t ipart = 0; ipart < num_partitions; ++ipart) {
+    ini["SIMULATION_DECK"]["RANDOM_SEED" + std::to_string(ipart)] = std::to_string(random_seed + int(first_partition + ipart));
+  }
+}
+
+/*********************************************************************
+ * Find the name of the ini file of a simulation shard,
+ * e.g., <dir>/simulation_deck_shard0.ini for <dir>/simulation_deck.ini
+ ********************************************************************/
+static
+std::string find_simulation_shard_ini_fname(const std::string& ini_fname,
+                                            const size_t& ishard) {
+  std::string shard_postfix = std::string("_shard") + std::to_string(ishard);
+
+  size_t ext_pos = ini_fname.rfind('.');
+  size_t dir_pos = ini_fname.find_last_of("/\\");
+  if ( (std::string::npos == ext_pos)
+    || ((std::string::npos != dir_pos) && (ext_pos < dir_pos)) ) {
+    return ini_fname + shard_postfix;
+  }
+  return ini_fname.substr(0, ext_pos) + shard_postfix + ini_fname.substr(ext_pos);
+}
+
 /*********************************************************************
  * Top-level function to write an ini file which contains exchangeable
  * information, in order to interface different Verilog simulators
+ *
+ * When more than one simulation shard is required, the partitions of
+ * random stimulus are split into contiguous and disjoint ranges, one per
+ * shard. Each shard has its own ini file, which contains the same
+ * simulation deck with only the seeds of its partitions, as well as an
+ * estimate of its simulation time. The top-level ini file lists the
+ * ini files of the shards.
  ********************************************************************/
 void print_verilog_simulation_info(const std::string& ini_fname,
                                    const std::string& circuit_name,
@@ -41,7 +83,11 @@ void print_verilog_simulation_info(const std::string& ini_fname,
                                    const size_t& num_program_clock_cycles,
                                    const int& num_operating_clock_cycles,
                                    const float& prog_clock_freq,
-                                   const float& op_clock_freq) {
+                                   const float& op_clock_freq,
+                                   const int& random_seed,
+                                   const size_t& num_random_partitions,
+                                   const size_t& num_simulation_shards,
+                                   const size_t& num_config_clock_cycles) {
 
   std::string timer_message = std::string("Write exchangeable file containing simulation information '") + ini_fname + std::string("'");
 
@@ -80,6 +126,13 @@ void print_verilog_simulation_info(const std::string& ini_fname,
   ini["SIMULATION_DECK"]["VERILOG_FILE2"] = std::string(circuit_name + std::string(TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX));
   ini["SIMULATION_DECK"]["CONFIG_PROTOCOL"] = std::string(CONFIG_PROTOCOL_TYPE_STRING[config_protocol_type]);
 
+  /* Partitions of random stimulus: each partition is simulated with its own seed,
+   * which is passed to testbenches by a plusarg, e.g., +random_seed=<int>
+   * The seeds are added once the simulation deck is complete, since shards
+   * only have the seeds of their own partitions
+   */
+  ini["SIMULATION_DECK"]["RANDOM_SEED_PLUSARG"] = std::string(VERILOG_TESTBENCH_RANDOM_SEED_NAME);
+
   /* Information required by UVM */
   if (CONFIG_MEM_FRAME_BASED == config_protocol_type) {
     /* Find the top_module */
@@ -141,6 +194,37 @@ void print_verilog_simulation_info(const std::string& ini_fname,
     }
   }
 
+  /* Write the simulation shards */
+  VTR_ASSERT(0 < num_simulation_shards && num_simulation_shards <= num_random_partitions);
+  if (1 < num_simulation_shards) {
+    /* Simulation time of a single partition, including its configuration phase */
+    float partition_time_period = find_simulation_time_period(1E-3,
+                                                              num_config_clock_cycles,
+                                                              1. / prog_clock_freq,
+                                                              num_operating_clock_cycles,
+                                                              1. / op_clock_freq);
+
+    for (size_t ishard = 0; ishard < num_simulation_shards; ++ishard) {
+      size_t first_partition = ishard * num_random_partitions / num_simulation_shards;
+      size_t num_shard_partitions = (ishard + 1) * num_random_partitions / num_simulation_shards - first_partition;
+      std::string shard_ini_fname = find_simulation_shard_ini_fname(ini_fname, ishard);
+
+      mINI::INIStructure shard_ini = ini;
+      shard_ini["SIMULATION_DECK"]["SHARD_INDEX"] = std::to_string(ishard);
+      shard_ini["SIMULATION_DECK"]["NUM_SHARDS"] = std::to_string(num_simulation_shards);
+      add_simulation_random_partitions(shard_ini, random_seed, first_partition, num_shard_partitions);
+      shard_ini["SIMULATION_DECK"]["EXPECTED_SIMTIME"] = std::to_string(partition_time_period * num_shard_partitions);
+
+      mINI::INIFile shard_file(shard_ini_fname);
+      shard_file.generate(shard_ini, true);
+
+      ini["SIMULATION_DECK"]["SHARD" + std::to_string(ishard)] = shard_ini_fname;
+    }
+    ini["SIMULATION_DECK"]["NUM_SHARDS"] = std::to_string(num_simulation_shards);
+  }
+
+  add_simulation_random_partitions(ini, random_seed, 0, num_random_partitions);
+
   mINI::INIFile file(ini_fname);
   file.generate(ini, true);
 }
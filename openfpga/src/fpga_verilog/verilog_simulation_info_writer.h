@@ -28,7 +28,11 @@ void print_verilog_simulation_info(const std::string& ini_fname,
                                    const size_t& num_program_clock_cycles,
                                    const int& num_operating_clock_cycles,
                                    const float& prog_clock_freq,
-                                   const float& op_clock_freq);
+                                   const float& op_clock_freq,
+                                   const int& random_seed,
+                                   const size_t& num_random_partitions,
+                                   const size_t& num_simulation_shards,
+                                   const size_t& num_config_clock_cycles);
 
 } /* end namespace openfpga */
 
@@ -49,14 +49,16 @@ void print_verilog_submodule(ModuleManager& module_manager,
                                      netlist_manager,
                                      submodule_dir,
                                      circuit_lib,
-                                     fpga_verilog_opts.default_net_type());
+                                     fpga_verilog_opts.default_net_type(),
+                                     fpga_verilog_opts.incremental());
 
   /* Decoders for architecture */
   print_verilog_submodule_arch_decoders(const_cast<const ModuleManager&>(module_manager),
                                         netlist_manager, 
                                         decoder_lib, 
                                         submodule_dir,
-                                        fpga_verilog_opts.default_net_type());
+                                        fpga_verilog_opts.default_net_type(),
+                                        fpga_verilog_opts.incremental());
 
   /* Routing multiplexers */
   /* NOTE: local decoders generation must go before the MUX generation!!! 
@@ -66,7 +68,8 @@ void print_verilog_submodule(ModuleManager& module_manager,
                                              netlist_manager, 
                                              mux_lib, circuit_lib, 
                                              submodule_dir,
-                                             fpga_verilog_opts.default_net_type());
+                                             fpga_verilog_opts.default_net_type(),
+                                             fpga_verilog_opts.incremental());
   print_verilog_submodule_muxes(module_manager, netlist_manager, mux_lib, circuit_lib,
                                 submodule_dir,
                                 fpga_verilog_opts);
@@ -82,7 +85,8 @@ void print_verilog_submodule(ModuleManager& module_manager,
   print_verilog_submodule_wires(const_cast<const ModuleManager&>(module_manager),
                                 netlist_manager, circuit_lib,
                                 submodule_dir,
-                                fpga_verilog_opts.default_net_type());
+                                fpga_verilog_opts.default_net_type(),
+                                fpga_verilog_opts.incremental());
 
   /* 4. Memories */
   print_verilog_submodule_memories(const_cast<const ModuleManager&>(module_manager),
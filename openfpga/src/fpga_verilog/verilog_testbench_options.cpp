@@ -16,12 +16,20 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   output_directory_.clear();
   fabric_netlist_file_path_.clear();
   reference_benchmark_file_path_.clear();
+  config_backdoor_ = false;
+  num_config_backdoor_protocol_bits_ = 64;
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
   print_top_testbench_ = false;
   simulation_ini_path_.clear();
   explicit_port_mapping_ = false;
   support_icarus_simulator_ = false;
+  bitstream_memory_file_ = false;
+  random_seed_ = 0;
+  num_random_partitions_ = 1;
+  num_simulation_shards_ = 1;
+  verilator_friendly_ = false;
+  runtime_bitstream_ = false;
   include_signal_init_ = false;
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
   verbose_output_ = false;
@@ -58,6 +66,14 @@ bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::config_backdoor() const {
+  return config_backdoor_;
+}
+
+size_t VerilogTestbenchOption::num_config_backdoor_protocol_bits() const {
+  return num_config_backdoor_protocol_bits_;
+}
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -78,6 +94,30 @@ bool VerilogTestbenchOption::support_icarus_simulator() const {
   return support_icarus_simulator_;
 }
 
+bool VerilogTestbenchOption::bitstream_memory_file() const {
+  return bitstream_memory_file_;
+}
+
+int VerilogTestbenchOption::random_seed() const {
+  return random_seed_;
+}
+
+size_t VerilogTestbenchOption::num_random_partitions() const {
+  return num_random_partitions_;
+}
+
+size_t VerilogTestbenchOption::num_simulation_shards() const {
+  return num_simulation_shards_;
+}
+
+bool VerilogTestbenchOption::verilator_friendly() const {
+  return verilator_friendly_;
+}
+
+bool VerilogTestbenchOption::runtime_bitstream() const {
+  return runtime_bitstream_;
+}
+
 e_verilog_default_net_type VerilogTestbenchOption::default_net_type() const {
   return default_net_type_;
 }
@@ -114,6 +154,14 @@ void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_config_backdoor(const bool& enabled) {
+  config_backdoor_ = enabled;
+}
+
+void VerilogTestbenchOption::set_num_config_backdoor_protocol_bits(const size_t& num_bits) {
+  num_config_backdoor_protocol_bits_ = num_bits;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(const bool& enabled) {
   print_preconfig_top_testbench_ = enabled
                                  && (!reference_benchmark_file_path_.empty());
@@ -146,6 +194,32 @@ void VerilogTestbenchOption::set_support_icarus_simulator(const bool& enabled) {
   support_icarus_simulator_ = enabled;
 }
 
+void VerilogTestbenchOption::set_bitstream_memory_file(const bool& enabled) {
+  bitstream_memory_file_ = enabled;
+}
+
+void VerilogTestbenchOption::set_random_seed(const int& seed) {
+  random_seed_ = seed;
+}
+
+void VerilogTestbenchOption::set_num_random_partitions(const size_t& num_partitions) {
+  VTR_ASSERT(0 < num_partitions);
+  num_random_partitions_ = num_partitions;
+}
+
+void VerilogTestbenchOption::set_num_simulation_shards(const size_t& num_shards) {
+  VTR_ASSERT(0 < num_shards);
+  num_simulation_shards_ = num_shards;
+}
+
+void VerilogTestbenchOption::set_verilator_friendly(const bool& enabled) {
+  verilator_friendly_ = enabled;
+}
+
+void VerilogTestbenchOption::set_runtime_bitstream(const bool& enabled) {
+  runtime_bitstream_ = enabled;
+}
+
 void VerilogTestbenchOption::set_default_net_type(const std::string& default_net_type) {
   /* Decode from net type string */;
   if (default_net_type == std::string(VERILOG_DEFAULT_NET_TYPE_STRING[VERILOG_DEFAULT_NET_TYPE_NONE])) {
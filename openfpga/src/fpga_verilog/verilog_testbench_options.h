@@ -27,6 +27,8 @@ class VerilogTestbenchOption {
     std::string fabric_netlist_file_path() const;
     std::string reference_benchmark_file_path() const;
     bool fast_configuration() const;
+    bool config_backdoor() const;
+    size_t num_config_backdoor_protocol_bits() const;
     bool print_formal_verification_top_netlist() const;
     bool print_preconfig_top_testbench() const;
     bool print_top_testbench() const;
@@ -35,6 +37,12 @@ class VerilogTestbenchOption {
     bool explicit_port_mapping() const;
     bool include_signal_init() const;
     bool support_icarus_simulator() const;
+    bool bitstream_memory_file() const;
+    int random_seed() const;
+    size_t num_random_partitions() const;
+    size_t num_simulation_shards() const;
+    bool verilator_friendly() const;
+    bool runtime_bitstream() const;
     e_verilog_default_net_type default_net_type() const;
     bool verbose_output() const;
   public: /* Public validator */
@@ -55,11 +63,24 @@ class VerilogTestbenchOption {
     /* The preconfig top testbench generation can be enabled only when formal verification top netlist is enabled */
     void set_print_preconfig_top_testbench(const bool& enabled);
     void set_fast_configuration(const bool& enabled);
+    /* With the configuration backdoor, the configuration chains are loaded by hierarchical assignments,
+     * except the bits at their heads, which are loaded and checked through the configuration protocol
+     */
+    void set_config_backdoor(const bool& enabled);
+    void set_num_config_backdoor_protocol_bits(const size_t& num_bits);
     void set_print_top_testbench(const bool& enabled);
     void set_print_simulation_ini(const std::string& simulation_ini_path);
     void set_explicit_port_mapping(const bool& enabled);
     void set_include_signal_init(const bool& enabled);
     void set_support_icarus_simulator(const bool& enabled);
+    void set_bitstream_memory_file(const bool& enabled);
+    void set_random_seed(const int& seed);
+    /* Each partition of random stimulus is simulated with a different seed */
+    void set_num_random_partitions(const size_t& num_partitions);
+    /* The partitions of random stimulus are split into shards, each of which has its own simulation task file */
+    void set_num_simulation_shards(const size_t& num_shards);
+    void set_verilator_friendly(const bool& enabled);
+    void set_runtime_bitstream(const bool& enabled);
     void set_default_net_type(const std::string& default_net_type);
     void set_verbose_output(const bool& enabled);
   private: /* Internal Data */
@@ -67,6 +88,8 @@ class VerilogTestbenchOption {
     std::string fabric_netlist_file_path_;
     std::string reference_benchmark_file_path_;
     bool fast_configuration_;
+    bool config_backdoor_;
+    size_t num_config_backdoor_protocol_bits_;
     bool print_formal_verification_top_netlist_;
     bool print_preconfig_top_testbench_;
     bool print_top_testbench_;
@@ -74,6 +97,12 @@ class VerilogTestbenchOption {
     std::string simulation_ini_path_;
     bool explicit_port_mapping_;
     bool support_icarus_simulator_;
+    bool bitstream_memory_file_;
+    int random_seed_;
+    size_t num_random_partitions_;
+    size_t num_simulation_shards_;
+    bool verilator_friendly_;
+    bool runtime_bitstream_;
     bool include_signal_init_;
     e_verilog_default_net_type default_net_type_;
     bool verbose_output_;
@@ -11,10 +11,14 @@
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "command_exit_codes.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 
@@ -22,6 +26,7 @@
 
 #include "module_manager_utils.h"
 #include "fabric_global_port_info_utils.h"
+#include "bitstream_manager_utils.h"
 
 #include "verilog_constants.h"
 #include "verilog_writer_utils.h"
@@ -165,6 +170,12 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
     }
   }
 
+  /* The I/O location map is indexed by the port names */
+  std::vector<std::string> module_io_port_names;
+  for (const ModulePortId& module_io_port_id : module_io_ports) {
+    module_io_port_names.push_back(module_manager.module_port(top_module, module_io_port_id).get_name());
+  }
+
   /* Keep tracking which I/Os have been used */
   std::map<ModulePortId, std::vector<bool>> io_used;
   for (const ModulePortId& module_io_port_id :  module_io_ports) {
@@ -195,14 +206,13 @@ void print_verilog_testbench_connect_fpga_ios(std::fstream& fp,
      *         or should find a GPOUT for OUTPAD
      */ 
     std::pair<ModulePortId, size_t> mapped_module_io_info = std::make_pair(ModulePortId::INVALID(), -1);
-    for (const ModulePortId& module_io_port_id : module_io_ports) {
-      const BasicPort& module_io_port = module_manager.module_port(top_module, module_io_port_id);
+    const t_pl_loc& block_loc = place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc;
+    for (size_t iport = 0; iport < module_io_ports.size(); ++iport) {
+      const ModulePortId& module_io_port_id = module_io_ports[iport];
 
       /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t temp_io_index = io_location_map.io_index(place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-                                                      place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-                                                      place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.z,
-                                                      module_io_port.get_name());
+      size_t temp_io_index = io_location_map.io_index(block_loc.x, block_loc.y, block_loc.z,
+                                                      module_io_port_names[iport]);
 
       /* Bypass invalid index (not mapped to this GPIO port) */
       if (size_t(-1) == temp_io_index) {
@@ -360,9 +370,109 @@ std::vector<BasicPort> generate_verilog_testbench_clock_port(const std::vector<s
   return clock_ports;
 }
 
+/********************************************************************
+ * Find the names of the output I/Os of a benchmark, 
+ * in the order of the bits of the output vectors in testbenches
+ *******************************************************************/
+static 
+std::vector<std::string> find_verilog_testbench_output_names(const AtomContext& atom_ctx,
+                                                             const VprNetlistAnnotation& netlist_annotation) {
+  std::vector<std::string> output_names;
+
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    /* Only care about output atom blocks ! */
+    if (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) {
+      continue;
+    }
+
+    /* The block may be renamed as it contains special characters which violate Verilog syntax */
+    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
+      output_names.push_back(netlist_annotation.block_name(atom_blk));
+    } else {
+      output_names.push_back(atom_ctx.nlist.block_name(atom_blk));
+    }
+  }
+
+  return output_names;
+}
+
+/********************************************************************
+ * Find the names of the input I/Os of a benchmark which are driven
+ * by random stimulus, i.e., all the inputs except clocks and the nets
+ * mapped to global reset ports of the FPGA fabric
+ *******************************************************************/
+static 
+std::vector<std::string> find_verilog_testbench_random_input_names(const AtomContext& atom_ctx,
+                                                                   const VprNetlistAnnotation& netlist_annotation,
+                                                                   const ModuleManager& module_manager,
+                                                                   const FabricGlobalPortInfo& global_ports,
+                                                                   const PinConstraints& pin_constraints,
+                                                                   const std::vector<std::string>& clock_port_names) {
+  std::vector<std::string> input_names;
+
+  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    /* Only care about input atom blocks ! */
+    if (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) {
+      continue;
+    }
+
+    /* The block may be renamed as it contains special characters which violate Verilog syntax */
+    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
+    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
+      block_name = netlist_annotation.block_name(atom_blk);
+    } 
+
+    /* Bypass clock ports because their stimulus cannot be random */
+    if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), block_name)) {
+      continue;
+    }
+
+    /* Bypass any constained net that are mapped to a global port of the FPGA fabric
+     * because their stimulus cannot be random
+     */
+    if (true == port_is_fabric_global_reset_port(global_ports, module_manager, pin_constraints.net_pin(block_name))) { 
+      continue;
+    }
+
+    input_names.push_back(block_name);
+  }
+
+  return input_names;
+}
+
+/********************************************************************
+ * Print a concatenation of single-bit signals, one signal per line, e.g.,
+ *   {
+ *     a<postfix>,
+ *     b<postfix>
+ *   }
+ * The first signal is the most significant bit
+ *******************************************************************/
+static 
+void print_verilog_testbench_concatenation(std::fstream& fp,
+                                           const std::string& indent,
+                                           const std::vector<std::string>& names,
+                                           const std::string& postfix) {
+  fp << "{\n";
+  for (size_t ibit = 0; ibit < names.size(); ++ibit) {
+    fp << indent << "\t" << names[ibit] << postfix;
+    if (ibit < names.size() - 1) {
+      fp << ",";
+    }
+    fp << "\n";
+  }
+  fp << indent << "}";
+}
+
 /********************************************************************
  * Print Verilog codes to check the equivalence of output vectors 
  *
+ * The outputs of the FPGA and the benchmark are packed into two vectors,
+ * which are compared once per clock cycle. 
+ * Only when the vectors differ, each bit is checked for a mismatch
+ * (a 'x' in the benchmark outputs is a don't care) and reported.
+ * A mismatch is counted once, when the check flag of the bit rises.
+ *
  * Restriction: this function only supports single clock benchmarks!
  *******************************************************************/
 void print_verilog_testbench_check(std::fstream& fp,
@@ -387,6 +497,24 @@ void print_verilog_testbench_check(std::fstream& fp,
 
   std::vector<BasicPort> clock_ports = generate_verilog_testbench_clock_port(clock_port_names, default_clock_name);
 
+  std::vector<std::string> output_names = find_verilog_testbench_output_names(atom_ctx, netlist_annotation);
+
+  /* Pack the outputs into vectors, so that they are compared at once */
+  BasicPort fpga_outputs_port(std::string(VERILOG_TESTBENCH_OUTPUT_VECTOR_PREFIX) + fpga_port_postfix, output_names.size());
+  BasicPort benchmark_outputs_port(std::string(VERILOG_TESTBENCH_OUTPUT_VECTOR_PREFIX) + benchmark_port_postfix, output_names.size());
+  BasicPort check_flags_port(std::string(VERILOG_TESTBENCH_OUTPUT_VECTOR_PREFIX) + check_flag_port_postfix, output_names.size());
+
+  if (0 < output_names.size()) {
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, fpga_outputs_port) << " = ";
+    print_verilog_testbench_concatenation(fp, std::string("\t"), output_names, fpga_port_postfix);
+    fp << ";" << std::endl;
+
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_WIRE, benchmark_outputs_port) << " = ";
+    print_verilog_testbench_concatenation(fp, std::string("\t"), output_names, benchmark_port_postfix);
+    fp << ";" << std::endl;
+    fp << std::endl;
+  }
+
   print_verilog_comment(fp, std::string("----- Skip the first falling edge of clock, it is for initialization -------"));
 
   BasicPort sim_start_port(simulation_start_counter_name, 1);
@@ -405,61 +533,40 @@ void print_verilog_testbench_check(std::fstream& fp,
   fp << "\t\tif (1'b1 == " << generate_verilog_port(VERILOG_PORT_CONKT, sim_start_port) << ") begin" << std::endl;
   fp << "\t\t";
   print_verilog_register_connection(fp, sim_start_port, sim_start_port, true);
-  fp << "\t\tend else begin" << std::endl;
 
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
-      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
-      continue;
+  if (0 < output_names.size()) {
+    fp << "\t\tend else if (" << generate_verilog_port(VERILOG_PORT_CONKT, fpga_outputs_port);
+    fp << " !== " << generate_verilog_port(VERILOG_PORT_CONKT, benchmark_outputs_port) << ") begin" << std::endl;
+
+    /* Per-bit checks, only reached when the vectors differ */
+    for (size_t ibit = 0; ibit < output_names.size(); ++ibit) {
+      const std::string& block_name = output_names[ibit];
+      BasicPort check_flag_pin(check_flags_port.get_name(), ibit, ibit);
+
+      fp << "\t\t\tif(!(" << block_name << fpga_port_postfix;
+      fp << " === " << block_name << benchmark_port_postfix;
+      fp << ") && !(" << block_name << benchmark_port_postfix;
+      fp << " === 1'bx)) begin" << std::endl;
+      fp << "\t\t\t\tif (1'b0 == " << generate_verilog_port(VERILOG_PORT_CONKT, check_flag_pin) << ") begin" << std::endl;
+      fp << "\t\t\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;" << std::endl;
+      fp << "\t\t\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix << " at time = " << std::string("%t") << "\", $realtime);" << std::endl;
+      fp << "\t\t\t\tend" << std::endl;
+      fp << "\t\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, check_flag_pin) << " <= 1'b1;" << std::endl;
+      fp << "\t\t\tend else begin" << std::endl;
+      fp << "\t\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, check_flag_pin) << " <= 1'b0;" << std::endl;
+      fp << "\t\t\tend" << std::endl; 
     }
 
-    /* The block may be renamed as it contains special characters which violate Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    } 
-
-    if (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk)) {
-     fp << "\t\t\tif(!(" << block_name << fpga_port_postfix;
-     fp << " === " << block_name << benchmark_port_postfix;
-     fp << ") && !(" << block_name << benchmark_port_postfix;
-     fp << " === 1'bx)) begin" << std::endl;
-     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << " <= 1'b1;" << std::endl;
-     fp << "\t\t\tend else begin" << std::endl;
-     fp << "\t\t\t\t" << block_name << check_flag_port_postfix << "<= 1'b0;" << std::endl;
-     fp << "\t\t\tend" << std::endl; 
-    }
-  } 
+    fp << "\t\tend else begin" << std::endl;
+    fp << "\t\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, check_flags_port);
+    fp << " <= {" << output_names.size() << "{1'b0}};" << std::endl;
+  }
   fp << "\t\tend" << std::endl;
   fp << "\tend" << std::endl;
 
   /* Add an empty line as splitter */
   fp << std::endl;
 
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Only care about output atom blocks ! */
-    if (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) {
-      continue;
-    }
-
-    /* The block may be renamed as it contains special characters which violate Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    } 
-
-    fp << "\talways@(posedge " << block_name << check_flag_port_postfix << ") begin" << std::endl;
-    fp << "\t\tif(" << block_name << check_flag_port_postfix << ") begin" << std::endl;
-    fp << "\t\t\t" << error_counter_name << " = " << error_counter_name << " + 1;" << std::endl;
-    fp << "\t\t\t$display(\"Mismatch on " << block_name << fpga_port_postfix << " at time = " << std::string("%t") << "\", $realtime);" << std::endl;
-    fp << "\t\tend" << std::endl;
-    fp << "\tend" << std::endl;
-
-    /* Add an empty line as splitter */
-    fp << std::endl;
-  }
-
   /* Condition ends */
   print_verilog_endif(fp);
 
@@ -527,6 +634,12 @@ void print_verilog_testbench_clock_stimuli(std::fstream& fp,
 /********************************************************************
  * Generate random stimulus for the input ports (non-clock signals)
  * For clock signals, please use print_verilog_testbench_clock_stimuli
+ *
+ * The random vectors are generated from a seed, which can be
+ * changed at simulation time without recompiling the testbench, e.g.,
+ *   +random_seed=<int>
+ * so that a testbench can be simulated in many independent partitions
+ * of random vectors, each of which is reproducible by its seed
  *******************************************************************/
 void print_verilog_testbench_random_stimuli(std::fstream& fp,
                                             const AtomContext& atom_ctx,
@@ -540,60 +653,40 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  print_verilog_comment(fp, std::string("----- Input Initialization -------"));
+  print_verilog_comment(fp, std::string("----- Random seed which can be overwritten by the plusarg '+" + std::string(VERILOG_TESTBENCH_RANDOM_SEED_NAME) + "=<int>' -------"));
+  fp << "\tinteger " << VERILOG_TESTBENCH_RANDOM_SEED_NAME << " = " << VERILOG_TESTBENCH_DEFAULT_RANDOM_SEED << ";\n";
+  fp << "\tinitial begin\n";
+  fp << "\t\tif ($value$plusargs(\"" << VERILOG_TESTBENCH_RANDOM_SEED_NAME << "=%d\", " << VERILOG_TESTBENCH_RANDOM_SEED_NAME << ")) begin\n";
+  fp << "\t\t\t$display(\"Random seed: %d\", " << VERILOG_TESTBENCH_RANDOM_SEED_NAME << ");\n";
+  fp << "\t\tend\n";
+  fp << "\tend\n";
 
-  fp << "\tinitial begin" << std::endl;
+  /* Add an empty line as splitter */
+  fp << "\n";
 
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
-      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
-      continue;
-    }
+  std::vector<std::string> input_names = find_verilog_testbench_random_input_names(atom_ctx, netlist_annotation,
+                                                                                   module_manager, global_ports,
+                                                                                   pin_constraints, clock_port_names);
+  size_t num_outputs = find_verilog_testbench_output_names(atom_ctx, netlist_annotation).size();
 
-    /* The block may be renamed as it contains special characters which violate Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    } 
-
-    /* Bypass clock ports because their stimulus cannot be random */
-    if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), block_name)) {
-      continue;
-    }
+  print_verilog_comment(fp, std::string("----- Input Initialization -------"));
 
-    /* Bypass any constained net that are mapped to a global port of the FPGA fabric
-     * because their stimulus cannot be random
-     */
-    if (true == port_is_fabric_global_reset_port(global_ports, module_manager, pin_constraints.net_pin(block_name))) { 
-      continue;
-    }
+  fp << "\tinitial begin" << std::endl;
 
-    /* TODO: find the clock inputs will be initialized later */
-    if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name << " <= 1'b0;" << std::endl;
-    }
+  /* TODO: find the clock inputs will be initialized later */
+  if (0 < input_names.size()) {
+    fp << "\t\t";
+    print_verilog_testbench_concatenation(fp, std::string("\t\t"), input_names, std::string());
+    fp << " <= {" << input_names.size() << "{1'b0}};" << std::endl;
   }
 
   /* Add an empty line as splitter */
   fp << std::endl;
   
   /* Set 0 to registers for checking flags */
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) {
-      continue;
-    }
-
-    /* The block may be renamed as it contains special characters which violate Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    } 
-
-    /* Each logical block assumes a single-width port */
-    BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1); 
-    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, output_port) << " <= 1'b0;" << std::endl;
+  if (0 < num_outputs) {
+    BasicPort check_flags_port(std::string(VERILOG_TESTBENCH_OUTPUT_VECTOR_PREFIX) + check_flag_port_postfix, num_outputs);
+    fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, check_flags_port) << " <= {" << num_outputs << "{1'b0}};" << std::endl;
   }
 
   fp << "\tend" << std::endl;
@@ -611,35 +704,21 @@ void print_verilog_testbench_random_stimuli(std::fstream& fp,
   VTR_ASSERT(1 <= clock_ports.size());
   fp << "\talways@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, clock_ports[0]) << ") begin" << std::endl;
 
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* Bypass non-I/O atom blocks ! */
-    if ( (AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk))
-      && (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) ) {
-      continue;
-    }
-
-    /* The block may be renamed as it contains special characters which violate Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    } 
-
-    /* Bypass clock ports because their stimulus cannot be random */
-    if (clock_port_names.end() != std::find(clock_port_names.begin(), clock_port_names.end(), block_name)) {
-      continue;
-    }
-
-    /* Bypass any constained net that are mapped to a global port of the FPGA fabric
-     * because their stimulus cannot be random
-     */
-    if (true == port_is_fabric_global_reset_port(global_ports, module_manager, pin_constraints.net_pin(block_name))) { 
-      continue;
-    }
-
-    /* TODO: find the clock inputs will be initialized later */
-    if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
-      fp << "\t\t" << block_name << " <= $random;" << std::endl;
+  /* All the inputs are assigned at once from as few random words as possible,
+   * the extra most significant bits of the words are truncated 
+   */
+  if (0 < input_names.size()) {
+    size_t num_random_words = (input_names.size() + VERILOG_RANDOM_WORD_SIZE - 1) / VERILOG_RANDOM_WORD_SIZE;
+    fp << "\t\t";
+    print_verilog_testbench_concatenation(fp, std::string("\t\t"), input_names, std::string());
+    fp << " <= {";
+    for (size_t iword = 0; iword < num_random_words; ++iword) {
+      if (0 < iword) {
+        fp << ", ";
+      }
+      fp << "$random(" << VERILOG_TESTBENCH_RANDOM_SEED_NAME << ")";
     }
+    fp << "};" << std::endl;
   }
 
   fp << "\tend" << std::endl;
@@ -748,21 +827,11 @@ void print_verilog_testbench_shared_ports(std::fstream& fp,
 
   /* Instantiate register for output comparison */
   print_verilog_comment(fp, std::string("----- Output vectors checking flags -------"));
-  for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-    /* We care only those logic blocks which are output I/Os */
-    if (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk)) {
-      continue;
-    }
-
-    /* The block may be renamed as it contains special characters which violate Verilog syntax */
-    std::string block_name = atom_ctx.nlist.block_name(atom_blk);
-    if (true == netlist_annotation.is_block_renamed(atom_blk)) {
-      block_name = netlist_annotation.block_name(atom_blk);
-    } 
-
-    /* Each logical block assumes a single-width port */
-    BasicPort output_port(std::string(block_name + check_flag_port_postfix), 1); 
-    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, output_port) << ";" << std::endl;
+  size_t num_outputs = find_verilog_testbench_output_names(atom_ctx, netlist_annotation).size();
+  if (0 < num_outputs) {
+    /* One flag per output, packed in the same order as the output vectors */
+    BasicPort check_flags_port(std::string(VERILOG_TESTBENCH_OUTPUT_VECTOR_PREFIX) + check_flag_port_postfix, num_outputs); 
+    fp << "\t" << generate_verilog_port(VERILOG_PORT_REG, check_flags_port) << ";" << std::endl;
   }
 
   /* Add an empty line as splitter */
@@ -928,4 +997,66 @@ void print_verilog_testbench_signal_initialization(std::fstream& fp,
   fp << "`endif" << std::endl;
 }
 
+/********************************************************************
+ * Build the hierarchical path of a configuration block
+ * from the instance of the FPGA fabric in a testbench
+ * The path ends with a dot, so that port names can be appended directly
+ *******************************************************************/
+std::string find_verilog_testbench_config_block_hierarchy_path(const ModuleManager& module_manager,
+                                                               const ModuleId& top_module,
+                                                               const BitstreamManager& bitstream_manager,
+                                                               const ConfigBlockId& config_block_id,
+                                                               const std::string& top_instance_name) {
+  std::vector<ConfigBlockId> block_hierarchy = find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id);
+  /* Drop the first block, which is the top module, it should be replaced by the instance name here */
+  /* Ensure that this is the module we want to drop! */
+  VTR_ASSERT(0 == module_manager.module_name(top_module).compare(bitstream_manager.block_name(block_hierarchy[0])));
+  block_hierarchy.erase(block_hierarchy.begin());
+  /* Build the full hierarchy path */
+  std::string bit_hierarchy_path(top_instance_name);
+  for (const ConfigBlockId& temp_block : block_hierarchy) {
+    bit_hierarchy_path += std::string(".");
+    bit_hierarchy_path += bitstream_manager.block_name(temp_block);
+  }
+  bit_hierarchy_path += std::string(".");
+
+  return bit_hierarchy_path;
+}
+
+/********************************************************************
+ * Output the bitstream of configuration blocks to a memory file,
+ * which can be loaded by '$readmemb' in testbenches
+ * Each block takes a row, whose most significant bit is the first bit of the block
+ *
+ * Return:
+ *  - CMD_EXEC_SUCCESS if succeed
+ *  - CMD_EXEC_FATAL_ERROR if the memory file can not be written
+ *******************************************************************/
+int write_verilog_testbench_config_block_memory_file(const std::string& memory_fname,
+                                                     const BitstreamManager& bitstream_manager,
+                                                     const std::vector<ConfigBlockId>& config_blocks) {
+  BufferedFileStream mem_fp;
+  mem_fp.open(memory_fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(memory_fname.c_str(), mem_fp);
+
+  mem_fp << "// Bitstream of configuration blocks, one block per row\n";
+  for (const ConfigBlockId& config_block_id : config_blocks) {
+    for (const ConfigBitId config_bit : bitstream_manager.block_bits(config_block_id)) {
+      mem_fp << (bitstream_manager.bit_value(config_bit) ? '1' : '0');
+    }
+    mem_fp << "\n";
+  }
+
+  bool mem_fp_good = mem_fp.good();
+  mem_fp.close();
+  if (false == mem_fp_good) {
+    VTR_LOG_ERROR("Fail to write bitstream memory file '%s'!\n",
+                  memory_fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
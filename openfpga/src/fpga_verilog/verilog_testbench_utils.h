@@ -15,6 +15,7 @@
 #include "fabric_global_port_info.h"
 #include "pin_constraints.h"
 #include "simulation_setting.h"
+#include "bitstream_manager.h"
 
 /********************************************************************
  * Function declaration
@@ -103,6 +104,16 @@ void print_verilog_testbench_signal_initialization(std::fstream& fp,
                                                    const ModuleManager& module_manager,
                                                    const ModuleId& top_module);
 
+std::string find_verilog_testbench_config_block_hierarchy_path(const ModuleManager& module_manager,
+                                                               const ModuleId& top_module,
+                                                               const BitstreamManager& bitstream_manager,
+                                                               const ConfigBlockId& config_block_id,
+                                                               const std::string& top_instance_name);
+
+int write_verilog_testbench_config_block_memory_file(const std::string& memory_fname,
+                                                     const BitstreamManager& bitstream_manager,
+                                                     const std::vector<ConfigBlockId>& config_blocks);
+
 } /* end namespace openfpga */
 
 #endif
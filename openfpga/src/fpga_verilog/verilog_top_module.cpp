@@ -12,6 +12,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 
 #include "openfpga_naming.h"
 
@@ -51,7 +52,7 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
           verilog_fname.c_str());
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(options.incremental(), std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
@@ -59,14 +60,22 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
   print_verilog_file_header(fp, std::string("Top-level Verilog module for FPGA")); 
 
   /* Write the module content in Verilog format */
-  write_verilog_module_to_file(fp,
-                               module_manager,
-                               top_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  if (true == options.compact_top_module()) {
+    write_verilog_compact_module_to_file(fp,
+                                         module_manager,
+                                         top_module,
+                                         options.explicit_port_mapping(),
+                                         options.default_net_type());
+  } else {
+    write_verilog_module_to_file(fp,
+                                 module_manager,
+                                 top_module,
+                                 options.explicit_port_mapping(),
+                                 options.default_net_type());
+  }
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 
   /* Close file handler */
   fp.close();
@@ -5,12 +5,15 @@
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
+#include <map>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+#include "command_exit_codes.h"
+
 /* Headers from openfpgautil library */
 #include "openfpga_port.h"
 #include "openfpga_digest.h"
@@ -66,8 +69,9 @@ constexpr char* TOP_TB_BITSTREAM_MEM_REG_NAME = "bit_mem";
 constexpr char* TOP_TB_BITSTREAM_INDEX_REG_NAME = "bit_index";
 constexpr char* TOP_TB_BITSTREAM_ITERATOR_REG_NAME = "ibit";
 constexpr char* TOP_TB_BITSTREAM_SKIP_FLAG_REG_NAME = "skip_bits";
-
-constexpr char* AUTOCHECK_TOP_TESTBENCH_VERILOG_MODULE_POSTFIX = "_autocheck_top_tb";
+constexpr char* TOP_TB_BACKDOOR_MEM_REG_NAME = "backdoor_mem";
+constexpr char* TOP_TB_BITSTREAM_FILE_REG_NAME = "bitstream_file";
+constexpr size_t TOP_TB_BITSTREAM_FILE_MAX_LENGTH = 1024;
 
 /********************************************************************
  * Generate a simulation clock port name
@@ -825,7 +829,6 @@ void print_verilog_top_testbench_ports(std::fstream& fp,
  * the number of non-zero data points in the fabric bitstream
  * Note that this will not applicable to configuration chain!!!
  *******************************************************************/
-static
 size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz_type,
                                          const bool& fast_configuration,
                                          const bool& bit_value_to_skip,
@@ -867,7 +870,7 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
     break;
   case CONFIG_MEM_MEMORY_BANK: {
     /* For fast configuration, we will skip all the zero data points */
-    num_config_clock_cycles = 1 + build_memory_bank_fabric_bitstream_by_address(fabric_bitstream).size();
+    num_config_clock_cycles = 1 + find_memory_bank_fabric_bitstream_size(fabric_bitstream);
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
       num_config_clock_cycles = 1 + find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
@@ -879,7 +882,7 @@ size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz
     break;
   }
   case CONFIG_MEM_FRAME_BASED: {
-    num_config_clock_cycles = 1 + build_frame_based_fabric_bitstream_by_address(fabric_bitstream).size();
+    num_config_clock_cycles = 1 + find_frame_based_fabric_bitstream_size(fabric_bitstream);
     if (true == fast_configuration) {
       size_t full_num_config_clock_cycles = num_config_clock_cycles;
       num_config_clock_cycles = 1 + find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
@@ -1148,6 +1151,47 @@ void print_verilog_top_testbench_configuration_protocol_stimulus(std::fstream& f
   }
 }
 
+/********************************************************************
+ * Print the declaration of the register holding the path of the bitstream file,
+ * when the bitstream file is chosen when the simulation starts
+ *******************************************************************/
+static
+void print_verilog_full_testbench_bitstream_file_register(std::fstream& fp,
+                                                          const std::string& bitstream_file) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  /* Reserve a few characters for the paths given at runtime */
+  size_t max_length = std::max(bitstream_file.size(), size_t(TOP_TB_BITSTREAM_FILE_MAX_LENGTH));
+
+  print_verilog_comment(fp, std::string("----- Bitstream file, which can be overwritten by the plusarg '+") + std::string(TOP_TB_BITSTREAM_FILE_REG_NAME) + std::string("=<path>' -----"));
+  fp << "reg [" << 8 * max_length << ":1] " << TOP_TB_BITSTREAM_FILE_REG_NAME << ";" << std::endl;
+  fp << std::endl;
+}
+
+/********************************************************************
+ * Print the statements loading the bitstream file to the virtual memory 
+ * in an initial block. 
+ * When the bitstream is chosen at runtime, the file is given by a plusarg,
+ * which is read in the same initial block to avoid races with the loading, 
+ * and the bitstream file given to the testbench generator is the default file 
+ *******************************************************************/
+static
+void print_verilog_full_testbench_readmemb(std::fstream& fp,
+                                           const std::string& bitstream_file,
+                                           const bool& runtime_bitstream) {
+  if (false == runtime_bitstream) {
+    fp << "$readmemb(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+    return;
+  }
+
+  fp << "if (!$value$plusargs(\"" << TOP_TB_BITSTREAM_FILE_REG_NAME << "=%s\", " << TOP_TB_BITSTREAM_FILE_REG_NAME << ")) begin" << std::endl;
+  fp << "\t\t" << TOP_TB_BITSTREAM_FILE_REG_NAME << " = \"" << bitstream_file << "\";" << std::endl;
+  fp << "\tend" << std::endl;
+  fp << "\t$display(\"Load bitstream file: %0s\", " << TOP_TB_BITSTREAM_FILE_REG_NAME << ");" << std::endl;
+  fp << "\t$readmemb(" << TOP_TB_BITSTREAM_FILE_REG_NAME << ", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a flatten memory (standalone) configuration protocol
  * We will load the bitstream in the second clock cycle, right after the first reset cycle
@@ -1155,6 +1199,7 @@ void print_verilog_top_testbench_configuration_protocol_stimulus(std::fstream& f
 static
 void print_verilog_full_testbench_vanilla_bitstream(std::fstream& fp,
                                                     const std::string& bitstream_file,
+                                                    const bool& runtime_bitstream,
                                                     const ModuleManager& module_manager,
                                                     const ModuleId& top_module,
                                                     const FabricBitstream& fabric_bitstream) {
@@ -1202,7 +1247,7 @@ void print_verilog_full_testbench_vanilla_bitstream(std::fstream& fp,
 
   print_verilog_comment(fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  print_verilog_full_testbench_readmemb(fp, bitstream_file, runtime_bitstream);
   fp << std::endl;
 
   fp << "\t\t@(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin" << std::endl;
@@ -1243,6 +1288,24 @@ void print_verilog_full_testbench_vanilla_bitstream(std::fstream& fp,
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
+/********************************************************************
+ * Find the number of rows of the bitstream file of a configuration chain,
+ * which skips the leading bits for fast configuration
+ *******************************************************************/
+static
+size_t find_configuration_chain_bitstream_file_length(const bool& fast_configuration,
+                                                      const bool& bit_value_to_skip,
+                                                      const BitstreamManager& bitstream_manager,
+                                                      const FabricBitstream& fabric_bitstream) {
+  size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  size_t num_bits_to_skip = 0;
+  if (true == fast_configuration) {
+    num_bits_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
+  }
+  VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+  return regional_bitstream_max_size - num_bits_to_skip;
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a configuration chain protocol
  * where configuration bits are programming in serial (one by one)
@@ -1258,6 +1321,7 @@ void print_verilog_full_testbench_vanilla_bitstream(std::fstream& fp,
 static
 void print_verilog_full_testbench_configuration_chain_bitstream(std::fstream& fp,
                                                                 const std::string& bitstream_file,
+                                                                const bool& runtime_bitstream,
                                                                 const bool& fast_configuration,
                                                                 const bool& bit_value_to_skip,
                                                                 const ModuleManager& module_manager,
@@ -1269,18 +1333,12 @@ void print_verilog_full_testbench_configuration_chain_bitstream(std::fstream& fp
 
   print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase -----");
 
-  /* Find the longest bitstream */
-  size_t regional_bitstream_max_size = find_fabric_regional_bitstream_max_size(fabric_bitstream);
-
   /* For fast configuration, the bitstream size counts from the first bit '1' */
-  size_t num_bits_to_skip = 0;
-  if (true == fast_configuration) {
-    num_bits_to_skip = find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, bit_value_to_skip);
-  }
-  VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+  size_t bitstream_length = find_configuration_chain_bitstream_file_length(fast_configuration, bit_value_to_skip,
+                                                                           bitstream_manager, fabric_bitstream);
 
   /* Define a constant for the bitstream length */
-  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), regional_bitstream_max_size - num_bits_to_skip); 
+  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), bitstream_length); 
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE), fabric_bitstream.num_regions()); 
 
   /* Initial value should be the first configuration bits
@@ -1309,7 +1367,7 @@ void print_verilog_full_testbench_configuration_chain_bitstream(std::fstream& fp
   print_verilog_comment(fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  print_verilog_full_testbench_readmemb(fp, bitstream_file, runtime_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Configuration chain default input -----");
@@ -1428,6 +1486,166 @@ void print_verilog_full_testbench_configuration_chain_bitstream(std::fstream& fp
   print_verilog_comment(fp, "----- End bitstream loading during configuration phase -----");
 }
 
+/********************************************************************
+ * Print stimulus for a FPGA fabric with a configuration chain protocol,
+ * where the configuration chains are loaded through a backdoor:
+ * 1. Only the last rows of the bitstream file are shifted through
+ *    the configuration protocol, which are loaded to the memory cells
+ *    at the heads of the configuration chains.
+ *    When the configuration phase ends, the values of these memory cells
+ *    are checked against the bitstream.
+ * 2. All the configuration memories are then forced to the bitstream 
+ *    by hierarchical assignments, whose values are loaded from a memory file,
+ *    where each configuration block takes a row.
+ *
+ * Because the bits reaching the heads of the chains are the last ones 
+ * to be shifted in a complete configuration, the chains are in the
+ * same state as a complete configuration, after a number of clock cycles
+ * which does not depend on the length of the chains.
+ *
+ * For example, with 2 bits loaded through the protocol:
+ *   Bitstream file : row 0, row 1, ..., row N-2, row N-1
+ *                                       |        |
+ *                                       v        v
+ *   Chain          : head -> cell 0 (row N-1) -> cell 1 (row N-2) -> ... -> tail
+ *
+ * Return:
+ *  - CMD_EXEC_SUCCESS if succeed
+ *  - CMD_EXEC_FATAL_ERROR if the memory file can not be written
+ *******************************************************************/
+static
+int print_verilog_full_testbench_configuration_chain_backdoor_bitstream(std::fstream& fp,
+                                                                        const std::string& bitstream_file,
+                                                                        const std::string& backdoor_memory_file,
+                                                                        const size_t& bitstream_length,
+                                                                        const size_t& num_protocol_bits,
+                                                                        const bool& output_datab_bits,
+                                                                        const ModuleManager& module_manager,
+                                                                        const ModuleId& top_module,
+                                                                        const BitstreamManager& bitstream_manager,
+                                                                        const FabricBitstream& fabric_bitstream) {
+  /* Validate the file stream */
+  valid_file_stream(fp);
+
+  VTR_ASSERT(num_protocol_bits <= bitstream_length);
+
+  /* Collect the configuration blocks, each of which takes a row in the memory */
+  std::vector<ConfigBlockId> config_blocks;
+  size_t memory_width = 0;
+  for (const ConfigBlockId& config_block_id : bitstream_manager.blocks()) {
+    /* We only cares blocks with configuration bits */
+    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
+      continue;
+    }
+    config_blocks.push_back(config_block_id);
+    memory_width = std::max(memory_width, bitstream_manager.block_bits(config_block_id).size());
+  }
+
+  if (CMD_EXEC_SUCCESS != write_verilog_testbench_config_block_memory_file(backdoor_memory_file, bitstream_manager, config_blocks)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  print_verilog_comment(fp, "----- Begin bitstream loading during configuration phase through the backdoor -----");
+
+  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), bitstream_length); 
+  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE), fabric_bitstream.num_regions()); 
+
+  ModulePortId cc_head_port_id = module_manager.find_module_port(top_module, generate_configuration_chain_head_name());
+  BasicPort config_chain_head_port = module_manager.module_port(top_module, cc_head_port_id);
+  std::vector<size_t> initial_values(config_chain_head_port.get_width(), 0);
+
+  print_verilog_comment(fp, "----- Virtual memory to store the bitstream from external file -----");
+  fp << "reg [0:`" << TOP_TB_BITSTREAM_WIDTH_VARIABLE << " - 1] ";
+  fp << TOP_TB_BITSTREAM_MEM_REG_NAME << "[0:`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - 1];";
+  fp << std::endl;
+
+  fp << "reg [$clog2(`" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << "):0] " << TOP_TB_BITSTREAM_INDEX_REG_NAME << ";" << std::endl;
+
+  print_verilog_comment(fp, "----- Virtual memory to store the bitstream of configuration blocks -----");
+  if (false == config_blocks.empty()) {
+    fp << "reg [" << memory_width - 1 << ":0] " << TOP_TB_BACKDOOR_MEM_REG_NAME;
+    fp << "[0:" << config_blocks.size() - 1 << "];" << std::endl;
+  }
+
+  print_verilog_comment(fp, "----- Preload bitstream files to virtual memories -----");
+  fp << "initial begin" << std::endl;
+  fp << "\t$readmemb(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");" << std::endl;
+  if (false == config_blocks.empty()) {
+    fp << "\t$readmemb(\"" << backdoor_memory_file << "\", " << TOP_TB_BACKDOOR_MEM_REG_NAME << ");" << std::endl;
+  }
+
+  print_verilog_comment(fp, "----- Configuration chain default input -----");
+  fp << "\t" << generate_verilog_port_constant_values(config_chain_head_port, initial_values, true) << ";" << std::endl;
+
+  print_verilog_comment(fp, "----- Only the last bits are loaded through the configuration protocol -----");
+  fp << "\t" << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= `" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << " - " << num_protocol_bits << ";" << std::endl;
+  fp << "end" << std::endl;
+
+  BasicPort prog_clock_port(std::string(TOP_TB_PROG_CLOCK_PORT_NAME) + std::string(TOP_TB_CLOCK_REG_POSTFIX), 1);
+  BasicPort config_done_port(std::string(TOP_TB_CONFIG_DONE_PORT_NAME), 1);
+  fp << "always @(negedge " << generate_verilog_port(VERILOG_PORT_CONKT, prog_clock_port) << ") begin" << std::endl;
+  fp << "\tif (" << TOP_TB_BITSTREAM_INDEX_REG_NAME << " >= `" << TOP_TB_BITSTREAM_LENGTH_VARIABLE << ") begin" << std::endl;
+  fp << "\t\t" << generate_verilog_port_constant_values(config_done_port, std::vector<size_t>(config_done_port.get_width(), 1), true) << ";" << std::endl;
+  fp << "\tend else begin" << std::endl;
+  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, config_chain_head_port); 
+  fp << " <= " << TOP_TB_BITSTREAM_MEM_REG_NAME << "[" << TOP_TB_BITSTREAM_INDEX_REG_NAME << "];" << std::endl;
+  fp << "\t\t" << TOP_TB_BITSTREAM_INDEX_REG_NAME << " <= " << TOP_TB_BITSTREAM_INDEX_REG_NAME << " + 1;" << std::endl;
+  fp << "\tend" << std::endl;
+  fp << "end" << std::endl;
+
+  /* Hierarchical paths to the configuration blocks */
+  std::vector<std::string> block_hierarchy_paths;
+  block_hierarchy_paths.reserve(config_blocks.size());
+  for (const ConfigBlockId& config_block_id : config_blocks) {
+    block_hierarchy_paths.push_back(find_verilog_testbench_config_block_hierarchy_path(module_manager, top_module,
+                                                                                      bitstream_manager, config_block_id,
+                                                                                      std::string(TOP_TESTBENCH_FPGA_INSTANCE_NAME)));
+  }
+
+  fp << "always @(posedge " << generate_verilog_port(VERILOG_PORT_CONKT, config_done_port) << ") begin" << std::endl;
+
+  print_verilog_comment(fp, "----- Check the memory cells loaded through the configuration protocol -----");
+  std::map<ConfigBlockId, size_t> block_rows;
+  for (size_t irow = 0; irow < config_blocks.size(); ++irow) {
+    block_rows[config_blocks[irow]] = irow;
+  }
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    const std::vector<FabricBitId>& region_bits = fabric_bitstream.region_bits(region);
+    /* The last bits of a region are shifted to the head of its chain */
+    for (size_t ibit = 0; ibit < std::min(num_protocol_bits, region_bits.size()); ++ibit) {
+      ConfigBitId config_bit = fabric_bitstream.config_bit(region_bits[region_bits.size() - 1 - ibit]);
+      ConfigBlockId config_block = bitstream_manager.bit_parent_block(config_bit);
+      size_t pin = size_t(config_bit) - size_t(bitstream_manager.block_first_bit(config_block));
+      BasicPort config_data_pin(block_hierarchy_paths[block_rows.at(config_block)] + generate_configurable_memory_data_out_name(), pin, pin);
+      std::string expected_value = std::string("1'b") + (bitstream_manager.bit_value(config_bit) ? "1" : "0");
+
+      fp << "\tif (" << expected_value << " !== " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_pin) << ") begin" << std::endl;
+      fp << "\t\t$display(\"Error: Configuration bit " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_pin);
+      fp << " is %b while " << expected_value << " is expected!\", " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_pin) << ");" << std::endl;
+      fp << "\t\t" << TOP_TESTBENCH_ERROR_COUNTER << " = " << TOP_TESTBENCH_ERROR_COUNTER << " + 1;" << std::endl;
+      fp << "\tend" << std::endl;
+    }
+  }
+
+  print_verilog_comment(fp, "----- Force all the configuration memories to the bitstream -----");
+  for (size_t irow = 0; irow < config_blocks.size(); ++irow) {
+    size_t num_bits = bitstream_manager.block_bits(config_blocks[irow]).size();
+    std::string memory_row = std::string(TOP_TB_BACKDOOR_MEM_REG_NAME) + "[" + std::to_string(irow) + "][" + std::to_string(num_bits - 1) + ":0]";
+    BasicPort config_data_port(block_hierarchy_paths[irow] + generate_configurable_memory_data_out_name(), num_bits);
+    fp << "\tforce " << generate_verilog_port(VERILOG_PORT_CONKT, config_data_port) << " = " << memory_row << ";" << std::endl;
+    if (true == output_datab_bits) {
+      BasicPort config_datab_port(block_hierarchy_paths[irow] + generate_configurable_memory_inverted_data_out_name(), num_bits);
+      fp << "\tforce " << generate_verilog_port(VERILOG_PORT_CONKT, config_datab_port) << " = ~" << memory_row << ";" << std::endl;
+    }
+  }
+
+  fp << "end" << std::endl;
+
+  print_verilog_comment(fp, "----- End bitstream loading during configuration phase through the backdoor -----");
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Print stimulus for a FPGA fabric with a memory bank configuration protocol
  * where configuration bits are programming in serial (one by one)
@@ -1435,6 +1653,7 @@ void print_verilog_full_testbench_configuration_chain_bitstream(std::fstream& fp
 static
 void print_verilog_full_testbench_memory_bank_bitstream(std::fstream& fp,
                                                         const std::string& bitstream_file,
+                                                        const bool& runtime_bitstream,
                                                         const bool& fast_configuration,
                                                         const bool& bit_value_to_skip,
                                                         const ModuleManager& module_manager,
@@ -1443,15 +1662,18 @@ void print_verilog_full_testbench_memory_bank_bitstream(std::fstream& fp,
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  MemoryBankFabricBitstream fabric_bits_by_addr = build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
-  /* For fast configuration, identify the final bitstream size to be used */
-  size_t num_bits_to_skip = 0;
+  /* Find the bitstream size, i.e., the number of addresses across regions.
+   * Only the size is required here, as the bitstream is loaded from the external file.
+   * The size is counted on packed addresses, without reorganizing the fabric bitstream 
+   * For fast configuration, the addresses to be skipped are excluded
+   */
+  size_t bitstream_size = 0;
   if (true == fast_configuration) {
-    num_bits_to_skip = fabric_bits_by_addr.size() - find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+    bitstream_size = find_memory_bank_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+  } else {
+    bitstream_size = find_memory_bank_fabric_bitstream_size(fabric_bitstream);
   }
-  VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
+  VTR_ASSERT(0 < bitstream_size);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -1473,7 +1695,7 @@ void print_verilog_full_testbench_memory_bank_bitstream(std::fstream& fp,
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
   /* Define a constant for the bitstream length */
-  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), fabric_bits_by_addr.size() - num_bits_to_skip); 
+  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), bitstream_size); 
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE), bl_addr_port.get_width() + wl_addr_port.get_width() + din_port.get_width()); 
 
   /* Declare local variables for bitstream loading in Verilog */
@@ -1487,7 +1709,7 @@ void print_verilog_full_testbench_memory_bank_bitstream(std::fstream& fp,
   print_verilog_comment(fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  print_verilog_full_testbench_readmemb(fp, bitstream_file, runtime_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
@@ -1576,6 +1798,7 @@ void print_verilog_full_testbench_memory_bank_bitstream(std::fstream& fp,
 static
 void print_verilog_full_testbench_frame_decoder_bitstream(std::fstream& fp,
                                                           const std::string& bitstream_file,
+                                                          const bool& runtime_bitstream,
                                                           const bool& fast_configuration,
                                                           const bool& bit_value_to_skip,
                                                           const ModuleManager& module_manager,
@@ -1584,15 +1807,18 @@ void print_verilog_full_testbench_frame_decoder_bitstream(std::fstream& fp,
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  /* Reorganize the fabric bitstream by the same address across regions */
-  FrameFabricBitstream fabric_bits_by_addr = build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
-
-  /* For fast configuration, identify the final bitstream size to be used */
-  size_t num_bits_to_skip = 0;
+  /* Find the bitstream size, i.e., the number of addresses across regions.
+   * Only the size is required here, as the bitstream is loaded from the external file.
+   * The size is counted on packed addresses, without reorganizing the fabric bitstream 
+   * For fast configuration, the addresses to be skipped are excluded
+   */
+  size_t bitstream_size = 0;
   if (true == fast_configuration) {
-    num_bits_to_skip = fabric_bits_by_addr.size() - find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+    bitstream_size = find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, bit_value_to_skip);
+  } else {
+    bitstream_size = find_frame_based_fabric_bitstream_size(fabric_bitstream);
   }
-  VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
+  VTR_ASSERT(0 < bitstream_size);
 
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
@@ -1609,7 +1835,7 @@ void print_verilog_full_testbench_frame_decoder_bitstream(std::fstream& fp,
   std::vector<size_t> initial_din_values(din_port.get_width(), 0);
 
   /* Define a constant for the bitstream length */
-  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), fabric_bits_by_addr.size() - num_bits_to_skip); 
+  print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_LENGTH_VARIABLE), bitstream_size); 
   print_verilog_define_flag(fp, std::string(TOP_TB_BITSTREAM_WIDTH_VARIABLE), addr_port.get_width() + din_port.get_width()); 
 
   /* Declare local variables for bitstream loading in Verilog */
@@ -1623,7 +1849,7 @@ void print_verilog_full_testbench_frame_decoder_bitstream(std::fstream& fp,
   print_verilog_comment(fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  print_verilog_full_testbench_readmemb(fp, bitstream_file, runtime_bitstream);
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Address port default input -----");
@@ -1706,6 +1932,7 @@ void print_verilog_full_testbench_frame_decoder_bitstream(std::fstream& fp,
 static
 void print_verilog_full_testbench_bitstream(std::fstream& fp,
                                             const std::string& bitstream_file,
+                                            const bool& runtime_bitstream,
                                             const e_config_protocol_type& config_protocol_type,
                                             const bool& fast_configuration,
                                             const bool& bit_value_to_skip,
@@ -1719,6 +1946,7 @@ void print_verilog_full_testbench_bitstream(std::fstream& fp,
   case CONFIG_MEM_STANDALONE:
     print_verilog_full_testbench_vanilla_bitstream(fp,
                                                    bitstream_file,
+                                                   runtime_bitstream,
                                                    module_manager,
                                                    top_module,
                                                    fabric_bitstream);
@@ -1726,6 +1954,7 @@ void print_verilog_full_testbench_bitstream(std::fstream& fp,
     break;
   case CONFIG_MEM_SCAN_CHAIN:
     print_verilog_full_testbench_configuration_chain_bitstream(fp, bitstream_file,
+                                                               runtime_bitstream,
                                                                fast_configuration, 
                                                                bit_value_to_skip,
                                                                module_manager, top_module,
@@ -1734,6 +1963,7 @@ void print_verilog_full_testbench_bitstream(std::fstream& fp,
     break;
   case CONFIG_MEM_MEMORY_BANK:
     print_verilog_full_testbench_memory_bank_bitstream(fp, bitstream_file,
+                                                       runtime_bitstream,
                                                        fast_configuration, 
                                                        bit_value_to_skip,
                                                        module_manager, top_module,
@@ -1741,6 +1971,7 @@ void print_verilog_full_testbench_bitstream(std::fstream& fp,
     break;
   case CONFIG_MEM_FRAME_BASED:
     print_verilog_full_testbench_frame_decoder_bitstream(fp, bitstream_file,
+                                                         runtime_bitstream,
                                                          fast_configuration, 
                                                          bit_value_to_skip,
                                                          module_manager, top_module,
@@ -1871,6 +2102,7 @@ int print_verilog_full_testbench(const ModuleManager& module_manager,
                                  const PlacementContext& place_ctx,
                                  const PinConstraints& pin_constraints,
                                  const std::string& bitstream_file,
+                                 const std::string& config_backdoor_memory_file,
                                  const IoLocationMap& io_location_map,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
@@ -1942,6 +2174,22 @@ int print_verilog_full_testbench(const ModuleManager& module_manager,
                                                                      bitstream_manager,
                                                                      fabric_bitstream);
 
+  /* The configuration chains are loaded through the backdoor when a memory file is given,
+   * where only the bits at the heads of the chains take configuration clock cycles
+   */
+  bool use_config_backdoor = (false == config_backdoor_memory_file.empty())
+                          && (CONFIG_MEM_SCAN_CHAIN == config_protocol.type());
+  size_t config_chain_bitstream_length = 0;
+  size_t num_config_backdoor_protocol_bits = 0;
+  if (true == use_config_backdoor) {
+    config_chain_bitstream_length = find_configuration_chain_bitstream_file_length(apply_fast_configuration, bit_value_to_skip,
+                                                                                   bitstream_manager, fabric_bitstream);
+    num_config_backdoor_protocol_bits = std::min(options.num_config_backdoor_protocol_bits(), config_chain_bitstream_length);
+    VTR_LOG("Configuration backdoor reduces number of configuration clock cycles from %lu to %lu\n",
+            num_config_clock_cycles, 1 + num_config_backdoor_protocol_bits);
+    num_config_clock_cycles = 1 + num_config_backdoor_protocol_bits;
+  }
+
   /* Generate stimuli for general control signals */
   print_verilog_top_testbench_generic_stimulus(fp,
                                                simulation_parameters,
@@ -2013,13 +2261,33 @@ int print_verilog_full_testbench(const ModuleManager& module_manager,
                                                  explicit_port_mapping);
 
   /* load bitstream to FPGA fabric in a configuration phase */
-  print_verilog_full_testbench_bitstream(fp,
-                                         bitstream_file,
-                                         config_protocol.type(),
-                                         apply_fast_configuration,
-                                         bit_value_to_skip,
-                                         module_manager, top_module,
-                                         bitstream_manager, fabric_bitstream);
+  if (true == use_config_backdoor) {
+    /* The inverted data ports exist only when the memory model has them */
+    bool output_datab_bits = (1 < circuit_lib.model_ports_by_type(config_protocol.memory_model(), CIRCUIT_MODEL_PORT_OUTPUT).size());
+    int status = print_verilog_full_testbench_configuration_chain_backdoor_bitstream(fp, bitstream_file,
+                                                                                     config_backdoor_memory_file,
+                                                                                     config_chain_bitstream_length,
+                                                                                     num_config_backdoor_protocol_bits,
+                                                                                     output_datab_bits,
+                                                                                     module_manager, top_module,
+                                                                                     bitstream_manager, fabric_bitstream);
+    if (CMD_EXEC_SUCCESS != status) {
+      fp.close();
+      return status;
+    }
+  } else {
+    if (true == options.runtime_bitstream()) {
+      print_verilog_full_testbench_bitstream_file_register(fp, bitstream_file);
+    }
+    print_verilog_full_testbench_bitstream(fp,
+                                           bitstream_file,
+                                           options.runtime_bitstream(),
+                                           config_protocol.type(),
+                                           apply_fast_configuration,
+                                           bit_value_to_skip,
+                                           module_manager, top_module,
+                                           bitstream_manager, fabric_bitstream);
+  }
 
   /* Add signal initialization: 
    * Bypass writing codes to files due to the autogenerated codes are very large.
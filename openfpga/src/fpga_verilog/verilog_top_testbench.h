@@ -26,6 +26,12 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+size_t calculate_num_config_clock_cycles(const e_config_protocol_type& sram_orgz_type,
+                                         const bool& fast_configuration,
+                                         const bool& bit_value_to_skip,
+                                         const BitstreamManager& bitstream_manager,
+                                         const FabricBitstream& fabric_bitstream);
+
 int print_verilog_full_testbench(const ModuleManager& module_manager,
                                  const BitstreamManager& bitstream_manager,
                                  const FabricBitstream& fabric_bitstream,
@@ -36,6 +42,7 @@ int print_verilog_full_testbench(const ModuleManager& module_manager,
                                  const PlacementContext& place_ctx,
                                  const PinConstraints& pin_constraints,
                                  const std::string& bitstream_file,
+                                 const std::string& config_backdoor_memory_file,
                                  const IoLocationMap& io_location_map,
                                  const VprNetlistAnnotation& netlist_annotation,
                                  const std::string& circuit_name,
@@ -11,6 +11,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_incremental_file_stream.h"
 
 #include "module_manager.h"
 #include "module_manager_utils.h"
@@ -74,8 +75,8 @@ void print_verilog_wire_module(const ModuleManager& module_manager,
   BasicPort module_output_port = module_manager.module_port(wire_module, module_output_port_id);
 
   /* Print wire declaration for the inputs and outputs */
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";" << std::endl;
-  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";" << std::endl;
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_input_port) << ";\n";
+  fp << generate_verilog_port(VERILOG_PORT_WIRE, module_output_port) << ";\n";
 
   /* Direct shortcut */
   print_verilog_wire_connection(fp, module_output_port, module_input_port, false);
@@ -87,7 +88,7 @@ void print_verilog_wire_module(const ModuleManager& module_manager,
   print_verilog_module_end(fp, circuit_lib.model_name(wire_model));
 
   /* Add an empty line as a splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -97,11 +98,12 @@ void print_verilog_submodule_wires(const ModuleManager& module_manager,
                                    NetlistManager& netlist_manager,
                                    const CircuitLibrary& circuit_lib,
                                    const std::string& submodule_dir,
-                                   const e_verilog_default_net_type& default_net_type) {
+                                   const e_verilog_default_net_type& default_net_type,
+                                   const bool& incremental) {
   std::string verilog_fname(submodule_dir + std::string(WIRES_VERILOG_FILE_NAME));
 
   /* Create the file stream */
-  std::fstream fp;
+  IncrementalFileStream fp(incremental, std::string(VERILOG_FILE_HEADER_DATE_PREFIX));
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   check_file_stream(verilog_fname.c_str(), fp);
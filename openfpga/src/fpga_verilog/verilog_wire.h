@@ -23,7 +23,8 @@ void print_verilog_submodule_wires(const ModuleManager& module_manager,
                                    NetlistManager& netlist_manager,
                                    const CircuitLibrary& circuit_lib,
                                    const std::string& submodule_dir,
-                                   const e_verilog_default_net_type& default_net_type);
+                                   const e_verilog_default_net_type& default_net_type,
+                                   const bool& incremental);
 
 } /* end namespace openfpga */
 
@@ -17,6 +17,8 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_time_stamp.h"
+#include "openfpga_buffered_file_stream.h"
 
 #include "openfpga_naming.h"
 #include "circuit_library_utils.h"
@@ -33,9 +35,9 @@ void print_verilog_default_net_type_declaration(std::fstream& fp,
                                                 const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "//----- Default net type -----" << std::endl;
-  fp << "`default_nettype " << VERILOG_DEFAULT_NET_TYPE_STRING[default_net_type] << std::endl;
-  fp << std::endl;
+  fp << "//----- Default net type -----\n";
+  fp << "`default_nettype " << VERILOG_DEFAULT_NET_TYPE_STRING[default_net_type] << "\n";
+  fp << "\n";
 }
 
 /************************************************
@@ -45,20 +47,17 @@ void print_verilog_default_net_type_declaration(std::fstream& fp,
 void print_verilog_file_header(std::fstream& fp,
                                const std::string& usage) {
   VTR_ASSERT(true == valid_file_stream(fp));
- 
-  auto end = std::chrono::system_clock::now(); 
-  std::time_t end_time = std::chrono::system_clock::to_time_t(end);
-
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//\tFPGA Synthesizable Verilog Netlist" << std::endl;
-  fp << "//\tDescription: " << usage << std::endl;
-  fp << "//\tAuthor: Xifan TANG" << std::endl;
-  fp << "//\tOrganization: University of Utah" << std::endl;
-  fp << "//\tDate: " << std::ctime(&end_time) ;
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//----- Time scale -----" << std::endl;
-  fp << "`timescale 1ns / 1ps" << std::endl;
-  fp << std::endl;
+
+  fp << "//-------------------------------------------\n";
+  fp << "//\tFPGA Synthesizable Verilog Netlist\n";
+  fp << "//\tDescription: " << usage << "\n";
+  fp << "//\tAuthor: Xifan TANG\n";
+  fp << "//\tOrganization: University of Utah\n";
+  fp << VERILOG_FILE_HEADER_DATE_PREFIX << generate_file_time_stamp() ;
+  fp << "//-------------------------------------------\n";
+  fp << "//----- Time scale -----\n";
+  fp << "`timescale 1ns / 1ps\n";
+  fp << "\n";
 }
 
 /********************************************************************
@@ -68,7 +67,7 @@ void print_verilog_include_netlist(std::fstream& fp,
                                    const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`include \"" << netlist_name << "\"" << std::endl; 
+  fp << "`include \"" << netlist_name << "\"\n"; 
 }
 
 /********************************************************************
@@ -79,7 +78,7 @@ void print_verilog_define_flag(std::fstream& fp,
                                const int& flag_value) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`define " << flag_name << " " << flag_value << std::endl; 
+  fp << "`define " << flag_name << " " << flag_value << "\n"; 
 }
 
 /************************************************
@@ -102,7 +101,7 @@ void print_verilog_comment(std::fstream& fp,
                            const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "// " << comment << std::endl;
+  fp << "// " << comment << "\n";
 }
 
 /************************************************
@@ -112,7 +111,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
                                       const std::string& preproc_flag) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`ifdef " << preproc_flag << std::endl;
+  fp << "`ifdef " << preproc_flag << "\n";
 }
 
 /************************************************
@@ -121,7 +120,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`endif" << std::endl;
+  fp << "`endif\n";
 }
 
 /************************************************
@@ -156,7 +155,7 @@ void print_verilog_module_definition(std::fstream& fp,
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
 
       if (true == printed_ifdef) {
@@ -189,7 +188,7 @@ void print_verilog_module_definition(std::fstream& fp,
       port_cnt++;
     }
   }
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /************************************************
@@ -225,9 +224,9 @@ void print_verilog_module_ports(std::fstream& fp,
       }
 
       /* Print port */
-      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----" << std::endl; 
+      fp << "//----- " << module_manager.module_port_type_str(kv.first)  << " -----\n"; 
       fp << generate_verilog_port(kv.second, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -238,8 +237,8 @@ void print_verilog_module_ports(std::fstream& fp,
 
   /* Output any port that is also wire connection when default net type is not wire! */
   if (VERILOG_DEFAULT_NET_TYPE_WIRE != default_net_type) {
-    fp << std::endl;
-    fp << "//----- BEGIN wire-connection ports -----" << std::endl; 
+    fp << "\n";
+    fp << "//----- BEGIN wire-connection ports -----\n"; 
     for (const auto& kv : port_type2type_map) {
       for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
         /* Skip the ports that are not registered */
@@ -258,7 +257,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
         /* Print port */
         fp << generate_verilog_port(VERILOG_PORT_WIRE, port);
-        fp << ";" << std::endl;
+        fp << ";\n";
 
         if (false == preproc_flag.empty()) {
           /* Print an endif to pair the ifdef */
@@ -266,13 +265,13 @@ void print_verilog_module_ports(std::fstream& fp,
         }
       }
     }
-    fp << "//----- END wire-connection ports -----" << std::endl; 
-    fp << std::endl;
+    fp << "//----- END wire-connection ports -----\n"; 
+    fp << "\n";
   }
  
   /* Output any port that is registered */
-  fp << std::endl;
-  fp << "//----- BEGIN Registered ports -----" << std::endl; 
+  fp << "\n";
+  fp << "//----- BEGIN Registered ports -----\n"; 
   for (const auto& kv : port_type2type_map) {
     for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
       /* Skip the ports that are not registered */
@@ -291,7 +290,7 @@ void print_verilog_module_ports(std::fstream& fp,
 
       /* Print port */
       fp << generate_verilog_port(VERILOG_PORT_REG, port);
-      fp << ";" << std::endl;
+      fp << ";\n";
 
       if (false == preproc_flag.empty()) {
         /* Print an endif to pair the ifdef */
@@ -299,8 +298,8 @@ void print_verilog_module_ports(std::fstream& fp,
       }
     }
   }
-  fp << "//----- END Registered ports -----" << std::endl; 
-  fp << std::endl;
+  fp << "//----- END Registered ports -----\n"; 
+  fp << "\n";
 }
 
 /************************************************
@@ -363,27 +362,18 @@ void print_verilog_module_instance(std::fstream& fp,
   /* Print module name */
   fp << "\t" << module_manager.module_name(module_id) << " ";
   /* Print instance name */
-  fp << instance_name << " (" << std::endl;
+  fp << instance_name << " (\n";
   
-  /* Print each port with/without explicit port map */
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type> port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
-  /* Port sequence: global, inout, input, output and clock ports, */
+  /* Print each port with/without explicit port map
+   * Port sequence: global, inout, input, output and clock ports,
+   * which follows the order of port types in module manager
+   */
   size_t port_cnt = 0;
-  for (const auto& kv : port_type2type_map) {
-    for (const auto& port : module_manager.module_ports_by_type(module_id, kv.first)) {
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    for (const auto& port : module_manager.module_ports_by_type(module_id, ModuleManager::e_module_port_type(port_type))) {
       if (0 != port_cnt) {
         /* Do not dump a comma for the first port */
-        fp << "," << std::endl; 
+        fp << ",\n"; 
       }
       /* Print port */
       fp << "\t\t";
@@ -392,17 +382,15 @@ void print_verilog_module_instance(std::fstream& fp,
         fp << "." << port.get_name() << "(";
       }
       /* Try to find the instanced port name in the name map */
-      if (port2port_name_map.find(port.get_name()) != port2port_name_map.end()) {
+      auto port_name_result = port2port_name_map.find(port.get_name());
+      if (port_name_result != port2port_name_map.end()) {
         /* Found it, we assign the port name */ 
         /* TODO: make sure the port width matches! */
-        ModulePortId module_port_id = module_manager.find_module_port(module_id, port.get_name());
-        /* Get the port from module */
-        BasicPort module_port = module_manager.module_port(module_id, module_port_id);
-        VTR_ASSERT(module_port.get_width() == port2port_name_map.at(port.get_name()).get_width());
-        fp << generate_verilog_port(kv.second, port2port_name_map.at(port.get_name()));
+        VTR_ASSERT(port.get_width() == port_name_result->second.get_width());
+        fp << generate_verilog_port(VERILOG_PORT_CONKT, port_name_result->second);
       } else {
         /* Not found, we give the default port name */
-        fp << generate_verilog_port(kv.second, port);
+        fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
       }
       /* if explicit port map is required, output the pair of branket */
       if (true == use_explicit_port_map) {
@@ -413,7 +401,7 @@ void print_verilog_module_instance(std::fstream& fp,
   }
   
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 
@@ -447,9 +435,9 @@ void print_verilog_module_end(std::fstream& fp,
                               const std::string& module_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "endmodule" << std::endl;
+  fp << "endmodule\n";
   print_verilog_comment(fp, std::string("----- END Verilog module for " + module_name + " -----"));
-  fp << std::endl;
+  fp << "\n";
 
   /* Reset default net type to be none */
   print_verilog_default_net_type_declaration(fp,
@@ -462,12 +450,12 @@ void print_verilog_module_end(std::fstream& fp,
 std::string generate_verilog_port(const enum e_dump_verilog_port_type& verilog_port_type,
                                   const BasicPort& port_info,
                                   const bool& must_print_port_size) {  
-  std::string verilog_line;
-
   /* Ensure the port type is valid */
   VTR_ASSERT(verilog_port_type < NUM_VERILOG_PORT_TYPES);
 
-  std::string size_str = "[" + std::to_string(port_info.get_lsb()) + ":" + std::to_string(port_info.get_msb()) + "]";
+  /* Build the string in place, as this is called for every port in netlists */
+  std::string verilog_line;
+  verilog_line.reserve(port_info.get_name().size() + 32);
 
   /* Only connection require a format of <port_name>[<lsb>:<msb>]
    * others require a format of <port_type> [<lsb>:<msb>] <port_name> 
@@ -483,18 +471,28 @@ std::string generate_verilog_port(const enum e_dump_verilog_port_type& verilog_p
      *   The original port width is the reference to backtrace the defintion of the port
      * - When LSB == MSB, we can use a simplified format <port_type>[<lsb>]
      */
+    verilog_line += port_info.get_name();
     if ((false == must_print_port_size)
      && (1 == port_info.get_width())
      && (0 == port_info.get_lsb())
      && (1 == port_info.get_origin_port_width())) {
-      size_str.clear();
-    } else if ((1 == port_info.get_width())) {
-      size_str = "[" + std::to_string(port_info.get_lsb()) + "]";
+      return verilog_line;
     }
-    verilog_line = port_info.get_name() + size_str;
+    verilog_line += "[";
+    verilog_line += std::to_string(port_info.get_lsb());
+    if (1 != port_info.get_width()) {
+      verilog_line += ":";
+      verilog_line += std::to_string(port_info.get_msb());
+    }
+    verilog_line += "]";
   } else { 
-    verilog_line = VERILOG_PORT_TYPE_STRING[verilog_port_type]; 
-    verilog_line += " " + size_str + " " + port_info.get_name();
+    verilog_line += VERILOG_PORT_TYPE_STRING[verilog_port_type]; 
+    verilog_line += " [";
+    verilog_line += std::to_string(port_info.get_lsb());
+    verilog_line += ":";
+    verilog_line += std::to_string(port_info.get_msb());
+    verilog_line += "] ";
+    verilog_line += port_info.get_name();
   }
 
   return verilog_line;
@@ -600,7 +598,9 @@ std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports) {
     return generate_verilog_port(VERILOG_PORT_CONKT, merged_ports[0], false);  
   }
 
-  std::string verilog_line = "{";
+  std::string verilog_line;
+  verilog_line.reserve(merged_ports.size() * 32);
+  verilog_line += "{";
   for (const auto& port : merged_ports) {
     /* The first port does not need a comma */
     if (&port != &merged_ports[0]) {
@@ -755,7 +755,7 @@ void print_verilog_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "assign ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -772,7 +772,7 @@ void print_verilog_deposit_wire_constant_values(std::fstream& fp,
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << ", ";
   fp << generate_verilog_constant_values(const_values);
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
@@ -788,7 +788,7 @@ void print_verilog_force_wire_constant_values(std::fstream& fp,
   fp << "\t";
   fp << "force ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -815,7 +815,7 @@ void print_verilog_wire_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -841,7 +841,7 @@ void print_verilog_register_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 
@@ -997,7 +997,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     /* Generate the name of local wire for the CCFF inputs, CCFF output and inverted output */
     /* [0] => CCFF input */
     BasicPort ccff_config_bus_port(generate_local_config_bus_port_name(), port_size);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";" << std::endl; 
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port) << ";\n"; 
     /* Connect first CCFF to the head */
     /* Head is always a 1-bit port */
     BasicPort ccff_head_port(generate_sram_port_name(sram_orgz_type, CIRCUIT_MODEL_PORT_INPUT), 1); 
@@ -1019,7 +1019,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
     sram_ports.push_back(BasicPort(generate_sram_local_port_name(circuit_lib, sram_model, sram_orgz_type, CIRCUIT_MODEL_PORT_OUTPUT), port_size));
     /* Print local wire definition */
     for (const auto& sram_port : sram_ports) {
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";" << std::endl; 
+      fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";\n"; 
     }
 
     break;
@@ -1107,10 +1107,10 @@ void print_verilog_local_config_bus(std::fstream& fp,
      */
     BasicPort config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";\n";
     BasicPort inverted_config_port(generate_local_sram_port_name(prefix, instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                    num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port) << ";\n";
     break;
   }
   default:
@@ -1178,26 +1178,26 @@ void print_verilog_rram_mux_config_bus(std::fstream& fp,
     /* Print configuration bus to group reserved BL/WLs */
     BasicPort reserved_bl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_BL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";\n";
     BasicPort reserved_wl_bus(generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_WL), 
                               num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";\n";
 
     /* Print configuration bus to group BL/WLs */
     BasicPort bl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 0, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";\n";
     BasicPort wl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model, mux_size, 1, false), 
                      num_conf_bits + num_reserved_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";\n";
 
     /* Print bus to group SRAM outputs, this is to interface memory cells to routing multiplexers */
     BasicPort sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_INPUT), 
                           num_conf_bits);
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";\n";
     BasicPort inverted_sram_output_bus(generate_mux_sram_port_name(circuit_lib, mux_model, mux_size, mux_instance_id, CIRCUIT_MODEL_PORT_OUTPUT), 
                                        num_conf_bits); 
-    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";" << std::endl;
+    fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus) << ";\n";
 
     /* Get the SRAM model of the mux_model */
     std::vector<CircuitModelId> sram_models = find_circuit_sram_models(circuit_lib, mux_model);
@@ -1317,13 +1317,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
   
   /* if flip_value is the same as initial value, we do not need to flip the signal ! */
   if (flip_value != initial_value) {
@@ -1331,13 +1331,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_values(port.get_width(), flip_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_values);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 
@@ -1360,21 +1360,21 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
+  fp << "initial\n";
 
   write_tab_to_file(fp, 1);
-  fp << "begin" << std::endl;
+  fp << "begin\n";
 
   write_tab_to_file(fp, 1);
   std::vector<size_t> initial_values(port.get_width(), initial_value);
 
   write_tab_to_file(fp, 1);
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 2);
   fp << "#" << std::setprecision(10) << initial_delay;
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 2);
   fp << "forever "; 
@@ -1382,13 +1382,13 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   fp << " = "; 
   fp << "#" << std::setprecision(10) << pulse_width;
   fp << " ~" << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
   
   write_tab_to_file(fp, 1);
-  fp << "end" << std::endl;
+  fp << "end\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1412,17 +1412,17 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   /* Set a wait condition if specified */
   if (false == wait_condition.empty()) {
-    fp << "\twait(" << wait_condition << ")" << std::endl;
+    fp << "\twait(" << wait_condition << ")\n";
   }
   
   /* Number of flip conditions and values should match */
@@ -1432,13 +1432,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp,
     std::vector<size_t> port_flip_value(port.get_width(), flip_values[ipulse]);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_value);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1462,25 +1462,25 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
 
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   fp << "always";
 
   /* Set a wait condition if specified */
   if (true == wait_condition.empty()) {
-    fp << std::endl;
+    fp << "\n";
   } else {
-    fp << " wait(" << wait_condition << ")" << std::endl;
+    fp << " wait(" << wait_condition << ")\n";
   }
 
-  fp << "\tbegin" << std::endl;
+  fp << "\tbegin\n";
   fp << "\t\t" << "#" << std::setprecision(10) << pulse_width;
 
   fp << "\t";
@@ -1488,12 +1488,12 @@ void print_verilog_clock_stimuli(std::fstream& fp,
   fp << " = ";
   fp << "~";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << "\n";
 }
 
 /********************************************************************
@@ -1507,7 +1507,7 @@ void print_verilog_netlist_include_header_file(const std::vector<std::string>& n
   std::string verilog_fname(std::string(subckt_dir) + std::string(header_file_name));
 
   /* Create the file stream */
-  std::fstream fp;
+  BufferedFileStream fp;
   fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
 
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -1517,7 +1517,7 @@ void print_verilog_netlist_include_header_file(const std::vector<std::string>& n
 
   /* Output file names */
   for (const std::string& netlist_name : netlists_to_be_included) {
-    fp << "`include \"" << netlist_name << "\"" << std::endl;
+    fp << "`include \"" << netlist_name << "\"\n";
   }
 
   /* close file stream */
@@ -4,6 +4,10 @@
 /* Header file from vtrutil library */
 #include "vtr_time.h"
 #include "vtr_log.h"
+#include "vtr_trace.h"
+
+/* Header file from libopenfpgautil library */
+#include "openfpga_time_stamp.h"
 
 /* Header file from libopenfpgashell library */
 #include "command_parser.h"
@@ -21,6 +25,7 @@
 
 #include "openfpga_title.h"
 #include "openfpga_context.h"
+#include "openfpga_command_utils.h"
 
 /********************************************************************
  * Main function to start OpenFPGA shell interface
@@ -45,6 +50,31 @@ int main(int argc, char** argv) {
   openfpga::CommandOptionId opt_batch_exec = start_cmd.add_option("batch_execution", false, "Launch OpenFPGA in batch  mode when running scripts");
   start_cmd.set_option_short_name(opt_batch_exec, "batch");
 
+  /* '--server': launch the server mode, which executes the scripts given by standard input.
+   * The script given by '--file' is executed before, whose results are shared by all the scripts
+   */
+  openfpga::CommandOptionId opt_server_mode = start_cmd.add_option("server", false, "Launch OpenFPGA in server mode, which executes the script files given by standard input");
+
+  /* '--server_jobs': number of scripts to execute at the same time in server mode */
+  openfpga::CommandOptionId opt_server_jobs = start_cmd.add_option("server_jobs", false, "Number of scripts to execute at the same time in server mode. By default, it is 1");
+  start_cmd.set_option_require_value(opt_server_jobs, openfpga::OPT_INT);
+
+  /* '--threads': number of threads used by the commands by default, same as 'set_num_threads' */
+  openfpga::CommandOptionId opt_threads = start_cmd.add_option("threads", false, "Number of threads used by the commands by default. Use 0 for all the cores of the machine. By default, it is 1");
+  start_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* '--deterministic': omit the time stamps in the headers of output files,
+   * so that two runs on the same inputs write byte-identical files
+   */
+  openfpga::CommandOptionId opt_deterministic = start_cmd.add_option("deterministic", false, "Omit the time stamps in the headers of output files, so that two runs on the same inputs, whatever the number of threads, write byte-identical files");
+
+  /* '--trace_file': record the spans of the commands and hot paths, written as a Chrome trace (JSON) */
+  openfpga::CommandOptionId opt_trace_file = start_cmd.add_option("trace_file", false, "Write the spans of the commands and of their hot paths to a Chrome trace (JSON) file, which can be loaded in chrome://tracing or perfetto. Requires OpenFPGA to be compiled with VTR_ENABLE_TRACING");
+  start_cmd.set_option_require_value(opt_trace_file, openfpga::OPT_STRING);
+
+  /* '--full_teardown': destroy all the data before exiting, e.g., to check memory leaks */
+  openfpga::CommandOptionId opt_full_teardown = start_cmd.add_option("full_teardown", false, "Destroy all the data before exiting, e.g., to check memory leaks. By default, the batch and server modes exit without destroying the data, which takes long for large designs");
+
   /* '--version', -v': print version information */
   openfpga::CommandOptionId opt_version = start_cmd.add_option("version", false, "Show OpenFPGA version");
   start_cmd.set_option_short_name(opt_version, "v");
@@ -107,6 +137,52 @@ int main(int argc, char** argv) {
       print_openfpga_version_info();
       return 0;
     }
+    if (true == start_cmd_context.option_enable(start_cmd, opt_threads)) {
+      int num_threads = openfpga::find_command_num_threads(openfpga_context.flow_manager(),
+                                                           start_cmd, start_cmd_context,
+                                                           start_cmd.option_name(opt_threads));
+      if (0 > num_threads) {
+        return 1;
+      }
+      openfpga_context.mutable_flow_manager().set_num_threads(num_threads);
+    }
+    openfpga::set_deterministic_output(start_cmd_context.option_enable(start_cmd, opt_deterministic));
+    if (true == start_cmd_context.option_enable(start_cmd, opt_trace_file)) {
+      vtr::start_tracing(start_cmd_context.option_value(start_cmd, opt_trace_file));
+    }
+    /* The batch and server modes exit as soon as the outputs are flushed,
+     * without destroying the data, unless a full teardown is required
+     */
+    bool full_teardown = start_cmd_context.option_enable(start_cmd, opt_full_teardown);
+    /* Start a server, after executing the setup script if provided */
+    if (true == start_cmd_context.option_enable(start_cmd, opt_server_mode)) {
+      shell.set_fast_exit(false == full_teardown);
+      int num_jobs = 1;
+      if (true == start_cmd_context.option_enable(start_cmd, opt_server_jobs)) {
+        num_jobs = std::atoi(start_cmd_context.option_value(start_cmd, opt_server_jobs).c_str());
+        if (0 >= num_jobs) {
+          VTR_LOG_ERROR("Invalid number of server jobs '%d' which should be a positive number!\n",
+                        num_jobs);
+          return 1;
+        }
+      }
+      if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
+        shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
+                              openfpga_context,
+                              true);
+      }
+      size_t num_failed_scripts = shell.run_server_mode(openfpga_context, num_jobs);
+      /* Any script which fails is an error of the server, as well as the errors of the setup script */
+      int server_exit_code = shell.exit_code();
+      if (0 < num_failed_scripts) {
+        server_exit_code = 1;
+      }
+      if (true == shell.fast_exit()) {
+        shell.exit_process(server_exit_code);
+      }
+      return server_exit_code;
+    } 
+
     /* Start a shell */ 
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
 
@@ -115,9 +191,14 @@ int main(int argc, char** argv) {
     } 
 
     if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
+      bool batch_mode = start_cmd_context.option_enable(start_cmd, opt_batch_exec);
+      shell.set_fast_exit((true == batch_mode) && (false == full_teardown));
       shell.run_script_mode(start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
                             openfpga_context,
-                            start_cmd_context.option_enable(start_cmd, opt_batch_exec));
+                            batch_mode);
+      if (true == shell.fast_exit()) {
+        shell.exit_process(shell.exit_code());
+      }
       return shell.exit_code();
     }
     /* Reach here there is something wrong, show the help desk */
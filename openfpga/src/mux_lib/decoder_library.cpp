@@ -62,14 +62,9 @@ DecoderId DecoderLibrary::find_decoder(const size_t& addr_size,
                                        const bool& use_enable, 
                                        const bool& use_data_in, 
                                        const bool& use_data_inv_port) const {
-  for (auto decoder : decoders()) {
-    if (  (addr_size == addr_sizes_[decoder])
-       && (data_size == data_sizes_[decoder])
-       && (use_enable == use_enable_[decoder])
-       && (use_data_in == use_data_in_[decoder])
-       && (use_data_inv_port == use_data_inv_port_[decoder]) ) {
-      return decoder;
-    }
+  auto result = decoder_lookup_.find(std::make_tuple(addr_size, data_size, use_enable, use_data_in, use_data_inv_port));
+  if (result != decoder_lookup_.end()) {
+    return result->second;
   }
 
   /* Not found, return an invalid id by default */
@@ -103,6 +98,9 @@ DecoderId DecoderLibrary::add_decoder(const size_t& addr_size,
   use_data_in_.push_back(use_data_in);
   use_data_inv_port_.push_back(use_data_inv_port);
 
+  /* Keep the first decoder if there are duplicated ones, as a linear search would find */
+  decoder_lookup_.insert(std::make_pair(std::make_tuple(addr_size, data_size, use_enable, use_data_in, use_data_inv_port), decoder));
+
   return decoder;
 }
 
@@ -22,7 +22,11 @@
 #ifndef DECODER_LIBRARY_H
 #define DECODER_LIBRARY_H
 
+#include <tuple>
+#include <unordered_map>
+
 #include "vtr_vector.h"
+#include "vtr_hash.h"
 #include "vtr_range.h"
 #include "decoder_library_fwd.h"
 
@@ -78,6 +82,22 @@ class DecoderLibrary {
                           const bool& use_data_in, 
                           const bool& use_data_inv_port);
     
+  private: /* Types of the fast look-up */
+    /* Specification of a decoder: addr size, data size, use_enable, use_data_in, use_data_inv_port */
+    typedef std::tuple<size_t, size_t, bool, bool, bool> DecoderKey;
+
+    struct DecoderKeyHash {
+      size_t operator()(const DecoderKey& key) const {
+        size_t hash = 0;
+        vtr::hash_combine(hash, std::get<0>(key));
+        vtr::hash_combine(hash, std::get<1>(key));
+        vtr::hash_combine(hash, std::get<2>(key));
+        vtr::hash_combine(hash, std::get<3>(key));
+        vtr::hash_combine(hash, std::get<4>(key));
+        return hash;
+      }
+    };
+
   private: /* Internal Data */
     vtr::vector<DecoderId, DecoderId> decoder_ids_;
     vtr::vector<DecoderId, size_t> addr_sizes_;
@@ -85,6 +105,9 @@ class DecoderLibrary {
     vtr::vector<DecoderId, bool> use_enable_;
     vtr::vector<DecoderId, bool> use_data_in_;
     vtr::vector<DecoderId, bool> use_data_inv_port_;
+
+    /* Fast look-up to find a decoder by its specification */
+    std::unordered_map<DecoderKey, DecoderId, DecoderKeyHash> decoder_lookup_;
 };
 
 } /* End namespace openfpga*/
@@ -33,9 +33,6 @@ MuxGraph::MuxGraph(const CircuitLibrary& circuit_lib,
   build_mux_graph(circuit_lib, circuit_model, mux_size);
 } 
 
-/**************************************************
- * Private Constructors
- *************************************************/
 /* Create an empty graph */
 MuxGraph::MuxGraph() {
   return;
@@ -49,27 +46,11 @@ MuxGraph::node_range MuxGraph::nodes() const {
   return vtr::make_range(node_ids_.begin(), node_ids_.end());
 }
 
-/* Find the non-input nodes */
-std::vector<MuxNodeId> MuxGraph::non_input_nodes() const {
+/* Find the non-input nodes, level by level */
+const std::vector<MuxNodeId>& MuxGraph::non_input_nodes() const {
   /* Must be an valid graph */
   VTR_ASSERT_SAFE(valid_mux_graph());
-  std::vector<MuxNodeId> node_list;
-  
-  /* Build the node list, level by level */
-  for (size_t level = 0; level < num_node_levels(); ++level) {
-    for (size_t node_type = 0; node_type < size_t(NUM_MUX_NODE_TYPES); ++node_type) {
-      /* Bypass any nodes which are not OUTPUT and INTERNAL */
-      if (size_t(MUX_INPUT_NODE) == node_type) { 
-        continue;
-      }
-      /* Reach here, this is either an OUTPUT or INTERNAL node */ 
-      for (auto node : node_lookup_[level][node_type]) { 
-        node_list.push_back(node); 
-      }
-    }
-  }
-
-  return node_list;
+  return non_input_nodes_;
 }
 
 MuxGraph::edge_range MuxGraph::edges() const {
@@ -104,48 +85,28 @@ std::vector<size_t> MuxGraph::node_levels() const {
 size_t MuxGraph::num_inputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
-  /* Sum up the number of INPUT nodes in each level */
-  size_t num_inputs = 0;
-  for (auto node_per_level : node_lookup_) {
-    num_inputs += node_per_level[MUX_INPUT_NODE].size();
-  }
-  return num_inputs;
+  return input_nodes_.size();
 }
 
-/* Return the node ids of all the inputs of the multiplexer */
-std::vector<MuxNodeId> MuxGraph::inputs() const {
-  std::vector<MuxNodeId> input_nodes; 
+/* Return the node ids of all the inputs of the multiplexer, level by level */
+const std::vector<MuxNodeId>& MuxGraph::inputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
-  /* Add the input nodes in each level */
-  for (auto node_per_level : node_lookup_) {
-    input_nodes.insert(input_nodes.end(), node_per_level[MUX_INPUT_NODE].begin(), node_per_level[MUX_INPUT_NODE].end());
-  }
-  return input_nodes;
+  return input_nodes_;
 }
 
 /* Find the number of outputs in the MUX graph */
 size_t MuxGraph::num_outputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
-  /* Sum up the number of INPUT nodes in each level */
-  size_t num_outputs = 0;
-  for (auto node_per_level : node_lookup_) {
-    num_outputs += node_per_level[MUX_OUTPUT_NODE].size();
-  }
-  return num_outputs;
+  return output_nodes_.size();
 }
 
-/* Return the node ids of all the outputs of the multiplexer */
-std::vector<MuxNodeId> MuxGraph::outputs() const {
-  std::vector<MuxNodeId> output_nodes; 
+/* Return the node ids of all the outputs of the multiplexer, level by level */
+const std::vector<MuxNodeId>& MuxGraph::outputs() const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_mux_graph());
-  /* Add the output nodes in each level */
-  for (auto node_per_level : node_lookup_) {
-    output_nodes.insert(output_nodes.end(), node_per_level[MUX_OUTPUT_NODE].begin(), node_per_level[MUX_OUTPUT_NODE].end());
-  }
-  return output_nodes;
+  return output_nodes_;
 }
 
 /* Find the edge between two MUX nodes */
@@ -156,11 +117,9 @@ std::vector<MuxEdgeId> MuxGraph::find_edges(const MuxNodeId& from_node, const Mu
   VTR_ASSERT(valid_node_id(to_node));
 
   for (const auto& edge : node_out_edges_[from_node]) {
-    for (const auto& cand : edge_sink_nodes_[edge]) {
-      if (cand == to_node) {
-        /* This is the wanted edge, add to list */
-        edges.push_back(edge);
-      }
+    if (edge_sink_node_[edge] == to_node) {
+      /* This is the wanted edge, add to list */
+      edges.push_back(edge);
     }
   }
 
@@ -198,7 +157,7 @@ size_t MuxGraph::num_memory_bits_at_level(const size_t& level) const {
 }
 
 /* Return memory id at level */
-std::vector<MuxMemId> MuxGraph::memories_at_level(const size_t& level) const {
+const std::vector<MuxMemId>& MuxGraph::memories_at_level(const size_t& level) const {
   /* need to check if the graph is valid or not */
   VTR_ASSERT_SAFE(valid_level(level));
   VTR_ASSERT_SAFE(valid_mux_graph());
@@ -233,17 +192,17 @@ size_t MuxGraph::node_index_at_level(const MuxNodeId& node) const {
 }
 
 /* Find the  input edges for a node */
-std::vector<MuxEdgeId> MuxGraph::node_in_edges(const MuxNodeId& node) const {
+const std::vector<MuxEdgeId>& MuxGraph::node_in_edges(const MuxNodeId& node) const {
   /* validate the node */
   VTR_ASSERT(valid_node_id(node));
   return node_in_edges_[node];
 }
 
-/* Find the input nodes for a edge */
-std::vector<MuxNodeId> MuxGraph::edge_src_nodes(const MuxEdgeId& edge) const {
+/* Find the input node for a edge */
+MuxNodeId MuxGraph::edge_src_node(const MuxEdgeId& edge) const {
   /* validate the edge */
   VTR_ASSERT(valid_edge_id(edge));
-  return edge_src_nodes_[edge];
+  return edge_src_node_[edge];
 }
 
 /* Find the mem that control the edge */
@@ -357,9 +316,8 @@ MuxGraph MuxGraph::subgraph(const MuxNodeId& root_node) const {
   /* Add input nodes and edges to subgraph */
   size_t input_cnt = 0;
   for (auto edge_origin : this->node_in_edges_[root_node]) {
-    VTR_ASSERT_SAFE(1 == edge_src_nodes_[edge_origin].size());
     /* Add nodes */
-    MuxNodeId from_node_origin = this->edge_src_nodes_[edge_origin][0];
+    MuxNodeId from_node_origin = this->edge_src_node_[edge_origin];
     MuxNodeId from_node_subgraph = mux_graph.add_node(MUX_INPUT_NODE);
     /* Configure the nodes */
     mux_graph.node_levels_[from_node_subgraph] = 0;
@@ -593,11 +551,8 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(const MuxInputId& input
       mem_bits[mem] = true;
     }
 
-    /* each edge must have 1 fan-out */
-    VTR_ASSERT_SAFE (1 == edge_sink_nodes_[edge].size());
-
     /* Get the fan-out node */
-    MuxNodeId next_node = edge_sink_nodes_[edge][0]; 
+    MuxNodeId next_node = edge_sink_node_[edge]; 
 
     /* If next node is the output node we want, we can finish here */
     if (next_node == node_id(output_id)) {
@@ -670,11 +625,8 @@ MuxInputId MuxGraph::find_input_node_driven_by_output_node(const std::map<MuxMem
     /* We must have a valid next edge */
     VTR_ASSERT(MuxEdgeId::INVALID() != next_edge);
 
-    /* each edge must have 1 fan-out */
-    VTR_ASSERT_SAFE (1 == edge_src_nodes_[next_edge].size());
-
     /* Get the fan-in node */
-    MuxNodeId next_node = edge_src_nodes_[next_edge][0]; 
+    MuxNodeId next_node = edge_src_node_[next_edge]; 
 
     /* If next node is an input node, we can finish here */
     if (true == is_node_input(next_node)) {
@@ -727,13 +679,11 @@ MuxEdgeId MuxGraph::add_edge(const MuxNodeId& from_node, const MuxNodeId& to_nod
 
   /* update the edge-node connections */
   VTR_ASSERT(valid_node_id(from_node));
-  edge_src_nodes_.emplace_back();
-  edge_src_nodes_[edge].push_back(from_node);
+  edge_src_node_.push_back(from_node);
   node_out_edges_[from_node].push_back(edge);
 
   VTR_ASSERT(valid_node_id(to_node));
-  edge_sink_nodes_.emplace_back();
-  edge_sink_nodes_[edge].push_back(to_node);
+  edge_sink_node_.push_back(to_node);
   node_in_edges_[to_node].push_back(edge);
 
   return edge;
@@ -1131,6 +1081,21 @@ void MuxGraph::build_node_lookup() {
   for (auto node : nodes()) {
     node_lookup_[node_levels_[node]][size_t(node_types_[node])].push_back(node);
   }
+
+  /* Flatten the inputs, outputs and the other nodes level by level,
+   * so that the accessors return them without building a list for each query
+   */
+  for (const auto& node_per_level : node_lookup_) {
+    input_nodes_.insert(input_nodes_.end(), node_per_level[MUX_INPUT_NODE].begin(), node_per_level[MUX_INPUT_NODE].end());
+    output_nodes_.insert(output_nodes_.end(), node_per_level[MUX_OUTPUT_NODE].begin(), node_per_level[MUX_OUTPUT_NODE].end());
+    for (size_t node_type = 0; node_type < size_t(NUM_MUX_NODE_TYPES); ++node_type) {
+      /* Bypass any nodes which are not OUTPUT and INTERNAL */
+      if (size_t(MUX_INPUT_NODE) == node_type) { 
+        continue;
+      }
+      non_input_nodes_.insert(non_input_nodes_.end(), node_per_level[node_type].begin(), node_per_level[node_type].end());
+    }
+  }
 }
 
 /* Build fast mem lookup */
@@ -1155,6 +1120,9 @@ void MuxGraph::build_mem_lookup() {
 /* Invalidate (empty) the node fast lookup*/
 void MuxGraph::invalidate_node_lookup() {
   node_lookup_.clear();
+  input_nodes_.clear();
+  output_nodes_.clear();
+  non_input_nodes_.clear();
 }
 
 /* Invalidate (empty) the mem fast lookup*/
@@ -1236,11 +1204,7 @@ bool MuxGraph::valid_mux_graph() const {
       MuxNodeId next_node = node;
       while ( 0 < node_out_edges_[next_node].size() ) {
         MuxEdgeId edge = node_out_edges_[next_node][0];
-        /* each edge must have 1 fan-out */
-        if (1 != edge_sink_nodes_[edge].size()) {
-          return false;
-        }
-        next_node = edge_sink_nodes_[edge][0]; 
+        next_node = edge_sink_node_[edge]; 
       }
       if (MUX_OUTPUT_NODE != node_types_[next_node]) {
         return false;
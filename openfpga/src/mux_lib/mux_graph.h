@@ -59,13 +59,12 @@ class MuxGraph {
     MuxGraph(const CircuitLibrary& circuit_lib, 
              const CircuitModelId& circuit_model,
              const size_t& mux_size); 
-  private: /* Private Constructors*/
-    /* Create an empty graph */
+    /* Create an empty graph, as a placeholder in MuxLibrary before the graph is built */
     MuxGraph();
   public: /* Public accessors: Aggregates */
     node_range nodes() const;
     /* Find the non-input nodes */
-    std::vector<MuxNodeId> non_input_nodes() const;
+    const std::vector<MuxNodeId>& non_input_nodes() const;
     edge_range edges() const;
     mem_range memories() const;
     /* Find the number of levels in terms of the multiplexer */
@@ -75,10 +74,10 @@ class MuxGraph {
   public: /* Public accessors: Data query */
     /* Find the number of inputs in the MUX graph */
     size_t num_inputs() const;
-    std::vector<MuxNodeId> inputs() const;
+    const std::vector<MuxNodeId>& inputs() const;
     /* Find the number of outputs in the MUX graph */
     size_t num_outputs() const;
-    std::vector<MuxNodeId> outputs() const;
+    const std::vector<MuxNodeId>& outputs() const;
     /* Find the edge between two MUX nodes */
     std::vector<MuxEdgeId> find_edges(const MuxNodeId& from_node, const MuxNodeId& to_node) const;
     /* Find the number of levels in the MUX graph */
@@ -89,7 +88,7 @@ class MuxGraph {
     /* Find the number of SRAMs at a level in the MUX graph */
     size_t num_memory_bits_at_level(const size_t& level) const;
     /* Return memory id at level */
-    std::vector<MuxMemId> memories_at_level(const size_t& level) const;
+    const std::vector<MuxMemId>& memories_at_level(const size_t& level) const;
     /* Find the number of nodes at a given level in the MUX graph */
     size_t num_nodes_at_level(const size_t& level) const;
     /* Find the level of a node */
@@ -97,9 +96,9 @@ class MuxGraph {
     /* Find the index of a node at its level */
     size_t node_index_at_level(const MuxNodeId& node) const;
     /* Find the input edges for a node */
-    std::vector<MuxEdgeId> node_in_edges(const MuxNodeId& node) const;
-    /* Find the input nodes for a edge */
-    std::vector<MuxNodeId> edge_src_nodes(const MuxEdgeId& edge) const;
+    const std::vector<MuxEdgeId>& node_in_edges(const MuxNodeId& node) const;
+    /* Find the input node for a edge */
+    MuxNodeId edge_src_node(const MuxEdgeId& edge) const;
     /* Find the mem that control the edge */
     MuxMemId find_edge_mem(const MuxEdgeId& edge) const;
     /* Identify if the edge is controlled by the inverted output of a mem */
@@ -192,8 +191,8 @@ class MuxGraph {
     vtr::vector<MuxNodeId, std::vector<MuxEdgeId>> node_out_edges_;      /* ids of outgoing edges from each node */
 
     vtr::vector<MuxEdgeId, MuxEdgeId> edge_ids_;                        /* Unique ids for each edge */
-    vtr::vector<MuxEdgeId, std::vector<MuxNodeId>> edge_src_nodes_;     /* source nodes drive this edge */
-    vtr::vector<MuxEdgeId, std::vector<MuxNodeId>> edge_sink_nodes_;    /* sink nodes this edge drives */
+    vtr::vector<MuxEdgeId, MuxNodeId> edge_src_node_;                  /* source node drives this edge, each edge has only one */
+    vtr::vector<MuxEdgeId, MuxNodeId> edge_sink_node_;                 /* sink node this edge drives, each edge has only one */
     vtr::vector<MuxEdgeId, CircuitModelId> edge_models_; /* type of each edge: tgate/pass-gate */
     vtr::vector<MuxEdgeId, MuxMemId> edge_mem_ids_;                   /* ids of memory bit that control the edge */
     vtr::vector<MuxEdgeId, bool> edge_inv_mem_;                       /* if the edge is controlled by an inverted output of a memory bit */
@@ -204,6 +203,10 @@ class MuxGraph {
     /* fast look-up */
     typedef std::vector<std::vector<std::vector<MuxNodeId>>> NodeLookup;
     mutable NodeLookup node_lookup_; /* [num_levels][num_types][num_nodes_per_level] */ 
+    /* nodes flattened from node_lookup_ level by level */
+    std::vector<MuxNodeId> input_nodes_;
+    std::vector<MuxNodeId> output_nodes_;
+    std::vector<MuxNodeId> non_input_nodes_;
     typedef std::vector<std::vector<MuxMemId>> MemLookup;
     mutable MemLookup mem_lookup_; /* [num_levels][num_mems_per_level] */ 
 };
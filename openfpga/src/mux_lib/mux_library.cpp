@@ -3,8 +3,16 @@
  * data structures in mux_library.h
  *************************************************/
 
+#include <algorithm>
+#include <map>
+#include <tuple>
+
 #include "vtr_assert.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+#include "circuit_library_utils.h"
 #include "mux_library.h"
 
 /* begin namespace openfpga */
@@ -27,8 +35,6 @@ MuxLibrary::mux_range MuxLibrary::muxes() const {
 /* Get a MUX graph (read-only) */
 MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model, 
                             const size_t& mux_size) const {
-  /* Make sure we have a valid mux look-up */
-  VTR_ASSERT_SAFE(valid_mux_lookup());
   /* Validate circuit model id and mux_size */
   VTR_ASSERT_SAFE(valid_mux_size(circuit_model, mux_size));
 
@@ -56,11 +62,40 @@ size_t MuxLibrary::max_mux_size() const {
   return max_mux_size;
 }
 
+/* Get the memory bits which route an input to the only output of a mux */
+vtr::vector<MuxMemId, bool> MuxLibrary::decoded_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  const MuxGraph& mux_graph = mux_graphs_[mux_id];
+  VTR_ASSERT(size_t(input_id) < mux_graph.num_inputs());
+
+  const std::vector<bool>& decode_table = mux_decode_tables_[mux_id];
+  size_t num_mems = mux_graph.num_memory_bits();
+  VTR_ASSERT(mux_graph.num_inputs() * num_mems == decode_table.size());
+
+  auto first_bit = decode_table.begin() + size_t(input_id) * num_mems;
+  vtr::vector<MuxMemId, bool> mem_bits(num_mems);
+  std::copy(first_bit, first_bit + num_mems, mem_bits.begin());
+  return mem_bits;
+}
+
+/* Get the circuit model which names the branch modules of a mux circuit model */
+CircuitModelId MuxLibrary::branch_circuit_model(const CircuitModelId& circuit_model) const {
+  VTR_ASSERT_SAFE(valid_mux_circuit_model_id(circuit_model));
+  if ( (size_t(circuit_model) < branch_circuit_models_.size())
+    && (CircuitModelId::INVALID() != branch_circuit_models_[circuit_model]) ) {
+    return branch_circuit_models_[circuit_model];
+  }
+  return circuit_model;
+}
+
 /**************************************************
- * Private mutators:
+ * Public mutators:
  *************************************************/
-/* Add a mux to the library */
-void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model, const size_t& mux_size) {
+/* Add a mux to the library
+ * Only the circuit model and the size are recorded here,
+ * so that each unique mux is built once by build_mux_graphs()
+ */
+void MuxLibrary::add_mux(const CircuitModelId& circuit_model, const size_t& mux_size) {
   /* First, check if there is already an existing graph */
   if (valid_mux_size(circuit_model, mux_size)) {
     return;
@@ -70,52 +105,168 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId
   MuxId mux = MuxId(mux_ids_.size());
   /* Push to the node list */
   mux_ids_.push_back(mux);
-  /* Add a mux graph */
-  mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
+  /* Reserve an empty mux graph */
+  mux_graphs_.emplace_back();
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
+  mux_sizes_.push_back(mux_size);
+  /* Decode tables are built with the mux graphs */
+  mux_decode_tables_.emplace_back();
 
   /* update mux_lookup*/
+  if (size_t(circuit_model) >= mux_lookup_.size()) {
+    mux_lookup_.resize(size_t(circuit_model) + 1);
+  }
+  if (mux_size >= mux_lookup_[circuit_model].size()) {
+    mux_lookup_[circuit_model].resize(mux_size + 1, MuxId::INVALID());
+  }
   mux_lookup_[circuit_model][mux_size] = mux;
 } 
 
+/* Build the graphs of all the muxes in the library
+ * Each mux only touches its own graph and decode table, 
+ * so that the muxes can be built in parallel
+ */
+void MuxLibrary::build_mux_graphs(const CircuitLibrary& circuit_lib, const size_t& num_threads) {
+  parallel_for(mux_ids_.size(), num_threads, [&](const size_t& imux) {
+    MuxId mux = mux_ids_[MuxId(imux)];
+    mux_graphs_[mux] = MuxGraph(circuit_lib, mux_circuit_models_[mux], mux_sizes_[mux]);
+    build_decode_table(mux);
+  });
+
+  build_branch_circuit_models(circuit_lib);
+}
+
 /**************************************************
- * Private accessors: validator and invalidators
+ * Private mutators:
  *************************************************/
-bool MuxLibrary::valid_mux_id(const MuxId& mux) const {
-  return size_t(mux) < mux_ids_.size() && mux_ids_[mux] == mux;
+/* Precompute the memory bits for each input of a mux with only one output,
+ * so that the bitstream of a mux is a copy from the table
+ * rather than a search on the mux graph
+ */
+void MuxLibrary::build_decode_table(const MuxId& mux) {
+  const MuxGraph& mux_graph = mux_graphs_[mux];
+  std::vector<bool>& decode_table = mux_decode_tables_[mux];
+  decode_table.clear();
+  /* Bypass the muxes with multiple outputs */
+  if (1 != mux_graph.outputs().size()) {
+    return;
+  }
+  MuxOutputId output_id = mux_graph.output_id(mux_graph.outputs()[0]);
+  decode_table.reserve(mux_graph.num_inputs() * mux_graph.num_memory_bits());
+  for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+    vtr::vector<MuxMemId, bool> mem_bits = mux_graph.decode_memory_bits(MuxInputId(input), output_id);
+    decode_table.insert(decode_table.end(), mem_bits.begin(), mem_bits.end());
+  }
 }
 
-bool MuxLibrary::valid_mux_lookup() const {
-  return mux_lookup_.empty();
+/* Structural signature of a branch graph: 
+ * the input, the memory bit and the use of inverted memory bit of each edge 
+ */
+static 
+std::vector<size_t> mux_branch_graph_signature(const MuxGraph& branch_graph) {
+  std::vector<size_t> signature;
+  for (const MuxEdgeId& edge : branch_graph.node_in_edges(branch_graph.outputs()[0])) {
+    signature.push_back(size_t(branch_graph.input_id(branch_graph.edge_src_node(edge))));
+    signature.push_back(size_t(branch_graph.find_edge_mem(edge)));
+    signature.push_back(size_t(branch_graph.is_edge_use_inv_mem(edge)));
+  }
+  return signature;
 }
 
-bool MuxLibrary::valid_mux_circuit_model_id(const CircuitModelId& circuit_model) const {
-  MuxLookup::iterator it = mux_lookup_.find(circuit_model);
-  return (it != mux_lookup_.end());
-}
+/* Find the circuit models whose branch modules can be shared
+ * Branch modules are named by circuit model, input size and memory size.
+ * A circuit model shares the branch modules of a previous circuit model when
+ * - both are CMOS circuit models of the same type, built with the same pass-gate logic 
+ *   and written in the same style, so that their branch modules are the same
+ *   for a given branch graph
+ * - their branch graphs with the same input size and memory size are structurally identical
+ */
+void MuxLibrary::build_branch_circuit_models(const CircuitLibrary& circuit_lib) {
+  branch_circuit_models_.clear();
+  branch_circuit_models_.resize(mux_lookup_.size(), CircuitModelId::INVALID());
 
-bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model, const size_t& mux_size) const {
-  if (false == valid_mux_circuit_model_id(circuit_model)) {
-    return false;
+  /* Collect the signatures of unique branch graphs for each circuit model, in the order of muxes */
+  typedef std::map<std::pair<size_t, size_t>, std::vector<size_t>> BranchSignatures;
+  std::vector<CircuitModelId> circuit_models;
+  std::map<CircuitModelId, BranchSignatures> model_branches;
+  for (const MuxId& mux : mux_ids_) {
+    CircuitModelId circuit_model = mux_circuit_models_[mux];
+    if (model_branches.end() == model_branches.find(circuit_model)) {
+      circuit_models.push_back(circuit_model);
+    }
+    BranchSignatures& branches = model_branches[circuit_model];
+    for (const MuxGraph& branch_graph : mux_graphs_[mux].build_mux_branch_graphs()) {
+      branches[std::make_pair(branch_graph.num_inputs(), branch_graph.num_memory_bits())] = mux_branch_graph_signature(branch_graph);
+    }
+  }
+
+  /* Circuit models sharing branch modules, with the union of their branch graphs */
+  typedef std::tuple<enum e_circuit_model_type, CircuitModelId, bool, bool, size_t> BranchModuleStyle;
+  std::map<BranchModuleStyle, std::vector<std::pair<CircuitModelId, BranchSignatures>>> shared_branches;
+  for (const CircuitModelId& circuit_model : circuit_models) {
+    if (CIRCUIT_MODEL_DESIGN_CMOS != circuit_lib.design_tech_type(circuit_model)) {
+      continue;
+    }
+    /* Behavioral branch modules use the default value of memory bits */
+    size_t mem_default_val = 0;
+    if (false == circuit_lib.dump_structural_verilog(circuit_model)) { 
+      std::vector<CircuitPortId> regular_sram_ports = find_circuit_regular_sram_ports(circuit_lib, circuit_model); 
+      if (1 != regular_sram_ports.size()) {
+        continue;
+      }
+      mem_default_val = circuit_lib.port_default_value(regular_sram_ports[0]);
+    }
+    BranchModuleStyle style = std::make_tuple(circuit_lib.model_type(circuit_model),
+                                              circuit_lib.pass_gate_logic_model(circuit_model),
+                                              circuit_lib.dump_structural_verilog(circuit_model),
+                                              circuit_lib.dump_explicit_port_map(circuit_model),
+                                              mem_default_val);
+
+    const BranchSignatures& branches = model_branches[circuit_model];
+    bool shared = false;
+    for (auto& candidate : shared_branches[style]) {
+      /* Branch graphs with the same sizes must be the same */
+      bool conflict = false;
+      for (const auto& branch : branches) {
+        auto result = candidate.second.find(branch.first);
+        if ( (result != candidate.second.end())
+          && (result->second != branch.second) ) {
+          conflict = true;
+          break;
+        }
+      }
+      if (true == conflict) {
+        continue;
+      }
+      candidate.second.insert(branches.begin(), branches.end());
+      branch_circuit_models_[circuit_model] = candidate.first;
+      shared = true;
+      break;
+    }
+    if (false == shared) {
+      shared_branches[style].push_back(std::make_pair(circuit_model, branches));
+    }
   }
-  std::map<size_t, MuxId>::iterator it = mux_lookup_[circuit_model].find(mux_size);
-  return (it != mux_lookup_[circuit_model].end());
 }
 
 /**************************************************
- * Private mutators: validator and invalidators
+ * Private accessors: validator and invalidators
  *************************************************/
+bool MuxLibrary::valid_mux_id(const MuxId& mux) const {
+  return size_t(mux) < mux_ids_.size() && mux_ids_[mux] == mux;
+}
 
-/* Build fast node lookup */
-void MuxLibrary::build_mux_lookup() {
-  /* Invalidate the mux lookup if necessary */
-  invalidate_mux_lookup();
+bool MuxLibrary::valid_mux_circuit_model_id(const CircuitModelId& circuit_model) const {
+  return size_t(circuit_model) < mux_lookup_.size() && !mux_lookup_[circuit_model].empty();
 }
 
-/* Invalidate (empty) the mux fast lookup*/
-void MuxLibrary::invalidate_mux_lookup() {
-  mux_lookup_.clear();
+bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model, const size_t& mux_size) const {
+  if (false == valid_mux_circuit_model_id(circuit_model)) {
+    return false;
+  }
+  return mux_size < mux_lookup_[circuit_model].size() 
+      && MuxId::INVALID() != mux_lookup_[circuit_model][mux_size];
 }
 
 } /* end namespace openfpga */
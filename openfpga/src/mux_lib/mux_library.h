@@ -10,7 +10,7 @@
 #ifndef MUX_LIBRARY_H
 #define MUX_LIBRARY_H
 
-#include <map>
+#include <vector>
 #include "mux_graph.h"
 #include "mux_library_fwd.h"
 
@@ -32,31 +32,53 @@ class MuxLibrary {
     CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
     /* Find the mux sizes */
     size_t max_mux_size() const;
+    /* Get the memory bits which route an input to the only output of a mux,
+     * which are precomputed by build_decode_tables()
+     */
+    vtr::vector<MuxMemId, bool> decoded_memory_bits(const MuxId& mux_id, const MuxInputId& input_id) const;
+    /* Get the circuit model which names the branch modules of a mux circuit model,
+     * so that structurally identical branch modules are shared among circuit models
+     */
+    CircuitModelId branch_circuit_model(const CircuitModelId& circuit_model) const;
   public:  /* Public mutators */
-    /* Add a mux to the library */
-    void add_mux(const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model, const size_t& mux_size); 
+    /* Add a mux to the library, whose graph is built by build_mux_graphs() */
+    void add_mux(const CircuitModelId& circuit_model, const size_t& mux_size); 
+    /* Build the graphs of the muxes which are added to the library
+     * and precompute the memory bits for each input of the muxes with only one output
+     */
+    void build_mux_graphs(const CircuitLibrary& circuit_lib, const size_t& num_threads);
   public:  /* Public validators */
     bool valid_mux_id(const MuxId& mux) const;
   private:  /* Private accessors */
-    bool valid_mux_lookup() const;
     bool valid_mux_circuit_model_id(const CircuitModelId& circuit_model) const;
     bool valid_mux_size(const CircuitModelId& circuit_model, const size_t& mux_size) const;
-  private:  /* Private mutators: mux_lookup */
-    void build_mux_lookup();
-    /* Invalidate (empty) the mux fast lookup*/
-    void invalidate_mux_lookup();
+  private:  /* Private mutators */
+    void build_decode_table(const MuxId& mux);
+    void build_branch_circuit_models(const CircuitLibrary& circuit_lib);
   private:  /* Internal data */
     /* MUX graph-based desription */
     vtr::vector<MuxId, MuxId> mux_ids_; /* Unique identifier for each mux graph */
     vtr::vector<MuxId, MuxGraph> mux_graphs_; /* Graphs describing MUX internal structures */
     vtr::vector<MuxId, CircuitModelId> mux_circuit_models_; /* circuit model id in circuit library */
+    vtr::vector<MuxId, size_t> mux_sizes_; /* datapath mux size which the graph is built for */
+
+    /* Memory bits decoded for each input of a mux, packed input by input.
+     * Empty for the muxes with multiple outputs, e.g., fracturable LUTs
+     */
+    vtr::vector<MuxId, std::vector<bool>> mux_decode_tables_;
+
+    /* Circuit model whose branch modules are shared by each mux circuit model,
+     * INVALID() for the circuit models which do not share any branch module
+     */
+    vtr::vector<CircuitModelId, CircuitModelId> branch_circuit_models_;
 
     /* Local encoder description */
     //vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs describing MUX internal structures */
 
-    /* a fast look-up to search mux_graphs with given circuit model and mux size */
-    typedef std::map<CircuitModelId, std::map<size_t, MuxId>> MuxLookup;
-    mutable MuxLookup mux_lookup_; 
+    /* a fast look-up to search mux_graphs with given circuit model and mux size,
+     * indexed by circuit model and then by mux size, MuxId::INVALID() for missing muxes
+     */
+    vtr::vector<CircuitModelId, std::vector<MuxId>> mux_lookup_; 
 };
 
 } /* end namespace openfpga */
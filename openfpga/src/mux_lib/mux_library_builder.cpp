@@ -30,7 +30,6 @@ namespace openfpga {
  *******************************************************************/
 static 
 void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const CircuitLibrary& circuit_lib,
                                     const VprDeviceAnnotation& vpr_device_annotation, 
                                     MuxLibrary& mux_lib) {
   /* The routing path is. 
@@ -63,7 +62,7 @@ void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
      
       VTR_ASSERT(CircuitModelId::INVALID() != rr_switch_circuit_model);
       /* Add the mux to mux_library */
-      mux_lib.add_mux(circuit_lib, rr_switch_circuit_model, vpr_device_ctx.rr_graph.node_in_edges(node).size()); 
+      mux_lib.add_mux(rr_switch_circuit_model, vpr_device_ctx.rr_graph.node_in_edges(node).size()); 
       break;
     }
     default:
@@ -83,7 +82,6 @@ void build_routing_arch_mux_library(const DeviceContext& vpr_device_ctx,
 static 
 void build_pb_graph_pin_interconnect_mux_library(t_pb_graph_pin* pb_graph_pin, 
                                                  t_mode* interconnect_mode,
-                                                 const CircuitLibrary& circuit_lib,
                                                  const VprDeviceAnnotation& vpr_device_annotation,
                                                  MuxLibrary& mux_lib) {
   /* Find the interconnect in the physical mode that drives this pin */
@@ -97,7 +95,7 @@ void build_pb_graph_pin_interconnect_mux_library(t_pb_graph_pin* pb_graph_pin,
   const CircuitModelId& interc_circuit_model = vpr_device_annotation.interconnect_circuit_model(physical_interc);
   VTR_ASSERT(CircuitModelId::INVALID() != interc_circuit_model); 
   /* Add the mux model to library */
-  mux_lib.add_mux(circuit_lib, interc_circuit_model, mux_size);
+  mux_lib.add_mux(interc_circuit_model, mux_size);
 }
 
 /********************************************************************
@@ -106,7 +104,6 @@ void build_pb_graph_pin_interconnect_mux_library(t_pb_graph_pin* pb_graph_pin,
  ********************************************************************/
 static 
 void rec_build_vpr_physical_pb_graph_node_mux_library(t_pb_graph_node* pb_graph_node,
-                                                      const CircuitLibrary& circuit_lib,
                                                       const VprDeviceAnnotation& vpr_device_annotation,
                                                       MuxLibrary& mux_lib) {
   /* Find the number of inputs for each interconnect of this pb_graph_node
@@ -122,7 +119,6 @@ void rec_build_vpr_physical_pb_graph_node_mux_library(t_pb_graph_node* pb_graph_
     for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(&(pb_graph_node->input_pins[iport][ipin]), 
                                                   parent_physical_mode,
-                                                  circuit_lib,
                                                   vpr_device_annotation,
                                                   mux_lib);
     }
@@ -132,7 +128,6 @@ void rec_build_vpr_physical_pb_graph_node_mux_library(t_pb_graph_node* pb_graph_
     for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(&(pb_graph_node->clock_pins[iport][ipin]), 
                                                   parent_physical_mode,
-                                                  circuit_lib,
                                                   vpr_device_annotation,
                                                   mux_lib);
     }
@@ -152,7 +147,6 @@ void rec_build_vpr_physical_pb_graph_node_mux_library(t_pb_graph_node* pb_graph_
     for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(&(pb_graph_node->output_pins[iport][ipin]), 
                                                   physical_mode,
-                                                  circuit_lib,
                                                   vpr_device_annotation,
                                                   mux_lib);
     }
@@ -162,7 +156,7 @@ void rec_build_vpr_physical_pb_graph_node_mux_library(t_pb_graph_node* pb_graph_
   for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
     for (int jpb = 0; jpb < physical_mode->pb_type_children[ipb].num_pb; ++jpb) {
       rec_build_vpr_physical_pb_graph_node_mux_library(&(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]), 
-                                                       circuit_lib, vpr_device_annotation,
+                                                       vpr_device_annotation,
                                                        mux_lib);
     }
   }
@@ -188,7 +182,7 @@ void build_lut_mux_library(MuxLibrary& mux_lib,
     /* MUX size = 2^lut_size */
     size_t lut_mux_size = (size_t)pow(2., (double)(circuit_lib.port_size(input_ports[0])));
     /* Add mux to the mux library */
-    mux_lib.add_mux(circuit_lib, circuit_model, lut_mux_size);
+    mux_lib.add_mux(circuit_model, lut_mux_size);
   }
 }
 
@@ -199,14 +193,15 @@ void build_lut_mux_library(MuxLibrary& mux_lib,
  * All the statistics are stored in a linked list, as a return value
  */
 MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const OpenfpgaContext& openfpga_ctx) {
+                                    const OpenfpgaContext& openfpga_ctx,
+                                    const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build a library of physical multiplexers");
 
   /* MuxLibrary to store the information of Multiplexers*/
   MuxLibrary mux_lib;
 
   /* Step 1: We should check the multiplexer spice models defined in routing architecture.*/
-  build_routing_arch_mux_library(vpr_device_ctx, openfpga_ctx.arch().circuit_lib, 
+  build_routing_arch_mux_library(vpr_device_ctx,
                                  openfpga_ctx.vpr_device_annotation(),
                                  mux_lib);
 
@@ -217,7 +212,6 @@ MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
       continue;
     }
     rec_build_vpr_physical_pb_graph_node_mux_library(lb_type.pb_graph_head,
-                                                     openfpga_ctx.arch().circuit_lib,
                                                      openfpga_ctx.vpr_device_annotation(),
                                                      mux_lib); 
   }
@@ -225,6 +219,11 @@ MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
   /* Step 3: count the size of multiplexer that will be used in LUTs*/
   build_lut_mux_library(mux_lib, openfpga_ctx.arch().circuit_lib); 
 
+  /* Step 4: build the graph of each unique multiplexer found above
+   * and precompute the memory bits of the routing multiplexers
+   */
+  mux_lib.build_mux_graphs(openfpga_ctx.arch().circuit_lib, num_threads);
+
   VTR_LOG("Built a multiplexer library of %lu physical multiplexers.\n",
           mux_lib.muxes().size());
   VTR_LOG("Maximum multiplexer size is %lu.\n",
@@ -7,10 +7,14 @@
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "pb_type_utils.h"
 
 #include "build_physical_lb_rr_graph.h"
 #include "check_lb_rr_graph.h"
+#include "physical_lb_rr_graph_cache.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -282,8 +286,7 @@ void rec_build_physical_lb_rr_edge_for_pb_graph_node(t_pb_graph_node* pb_graph_n
  ***************************************************************************************/
 static 
 LbRRGraph build_lb_type_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head,
-                                             const VprDeviceAnnotation& device_annotation,
-                                             const bool& verbose) {
+                                             const VprDeviceAnnotation& device_annotation) {
   LbRRGraph lb_rr_graph;
 
   /* TODO: ensure we have an empty lb_rr_graph */
@@ -365,48 +368,82 @@ LbRRGraph build_lb_type_physical_lb_rr_graph(t_pb_graph_node* pb_graph_head,
     }
   }
 
-  VTR_LOGV(verbose,
-           "\n\tNumber of nodes: %lu\n",
-           lb_rr_graph.nodes().size());
-
-  VTR_LOGV(verbose,
-           "\tNumber of edges: %lu\n",
-           lb_rr_graph.edges().size());
-
   return lb_rr_graph;
 }
 
 /***************************************************************************************
  * This functio will create physical lb_rr_graph for each pb_graph considering physical modes only
  * the lb_rr_graph willbe added to device annotation
+ * The graphs only depend on the architectures, which can be loaded from a cache file
+ * if it is built from the same architectures, otherwise they are built from scratch,
+ * one logical tile per thread, and written to the cache
  ***************************************************************************************/
 void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
                                  VprDeviceAnnotation& device_annotation,
+                                 const std::string& arch_id,
+                                 const std::string& cache_fname,
+                                 const size_t& num_threads,
                                  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build routing resource graph for the physical implementation of logical tile");
 
-  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
-    /* By pass nullptr for pb_graph head */
-    if (nullptr == lb_type.pb_graph_head) {
-      continue;
-    }
+  /* Graphs are indexed by logical tiles, and are empty for those without pb_graph */
+  std::vector<LbRRGraph> lb_rr_graphs(device_ctx.logical_block_types.size());
 
-    VTR_LOGV(verbose,
-             "Building routing resource graph for logical tile '%s'...",
-             lb_type.pb_graph_head->pb_type->name);
+  bool cache_loaded = false;
+  if (false == cache_fname.empty()) {
+    cache_loaded = (0 == read_physical_lb_rr_graphs_from_binary_file(device_ctx,
+                                                                     lb_rr_graphs,
+                                                                     arch_id,
+                                                                     cache_fname,
+                                                                     verbose));
+  }
+
+  if (false == cache_loaded) {
+    std::vector<char> lb_rr_graph_status(lb_rr_graphs.size(), true);
+    parallel_for(lb_rr_graphs.size(), find_num_threads(num_threads),
+                 [&](const size_t& itype) {
+      t_pb_graph_node* pb_graph_head = device_ctx.logical_block_types[itype].pb_graph_head;
+      /* By pass nullptr for pb_graph head */
+      if (nullptr == pb_graph_head) {
+        return;
+      }
+      lb_rr_graphs[itype] = build_lb_type_physical_lb_rr_graph(pb_graph_head, const_cast<const VprDeviceAnnotation&>(device_annotation));
+      /* Check the rr_graph */
+      lb_rr_graph_status[itype] = (true == lb_rr_graphs[itype].validate())
+                               && (true == check_lb_rr_graph(lb_rr_graphs[itype]));
+    });
+
+    for (size_t itype = 0; itype < lb_rr_graphs.size(); ++itype) {
+      if (false == bool(lb_rr_graph_status[itype])) {
+        VTR_LOG_ERROR("Invalid routing resource graph for logical tile '%s'!\n",
+                      device_ctx.logical_block_types[itype].pb_graph_head->pb_type->name);
+        exit(1);
+      }
+    }
 
-    const LbRRGraph& lb_rr_graph = build_lb_type_physical_lb_rr_graph(lb_type.pb_graph_head, const_cast<const VprDeviceAnnotation&>(device_annotation), verbose); 
-    /* Check the rr_graph */
-    if (false == lb_rr_graph.validate()) {
-      exit(1);
+    /* A failure in writing the cache does not affect the repacking */
+    if (false == cache_fname.empty()) {
+      write_physical_lb_rr_graphs_to_binary_file(device_ctx,
+                                                 lb_rr_graphs,
+                                                 arch_id,
+                                                 cache_fname,
+                                                 verbose);
     }
-    if (false == check_lb_rr_graph(lb_rr_graph)) {
-      exit(1);
+  }
+
+  for (size_t itype = 0; itype < lb_rr_graphs.size(); ++itype) {
+    t_pb_graph_node* pb_graph_head = device_ctx.logical_block_types[itype].pb_graph_head;
+    if (nullptr == pb_graph_head) {
+      continue;
     }
-    VTR_LOGV(verbose, 
-             "Check routing resource graph for logical tile passed\n");
 
-    device_annotation.add_physical_lb_rr_graph(lb_type.pb_graph_head, lb_rr_graph);
+    VTR_LOGV(verbose,
+             "Built routing resource graph for logical tile '%s' (nodes: %lu, edges: %lu)\n",
+             pb_graph_head->pb_type->name,
+             lb_rr_graphs[itype].nodes().size(),
+             lb_rr_graphs[itype].edges().size());
+
+    device_annotation.add_physical_lb_rr_graph(pb_graph_head, lb_rr_graphs[itype]);
   }
 
   VTR_LOGV(verbose, "Done\n");
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 
@@ -16,6 +17,9 @@ namespace openfpga {
 
 void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
                                  VprDeviceAnnotation& device_annotation,
+                                 const std::string& arch_id,
+                                 const std::string& cache_fname,
+                                 const size_t& num_threads,
                                  const bool& verbose);
 
 } /* end namespace openfpga */
@@ -8,6 +8,9 @@
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "openfpga_naming.h"
 
 #include "lut_utils.h"
@@ -190,17 +193,22 @@ void build_physical_pb_lut_truth_tables(PhysicalPb& physical_pb,
  * Note that the truth table built here is different from the atom
  * netlists in VPR context. We consider fracturable LUT features
  * and LUTs operating as wires
+ * The truth tables of a clustered block only depend on its own physical pb,
+ * so that clustered blocks are processed with a number of threads
  ***************************************************************************************/
 void build_physical_lut_truth_tables(VprClusteringAnnotation& cluster_annotation,
                                      const AtomContext& atom_ctx,
                                      const ClusteringContext& cluster_ctx,
                                      const VprDeviceAnnotation& device_annotation,
                                      const CircuitLibrary& circuit_lib,
+                                     const size_t& num_threads,
                                      const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build truth tables for physical LUTs");
 
-  for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
-    PhysicalPb& physical_pb = cluster_annotation.mutable_physical_pb(blk_id);
+  std::vector<ClusterBlockId> blocks(cluster_ctx.clb_nlist.blocks().begin(),
+                                     cluster_ctx.clb_nlist.blocks().end());
+  parallel_for(blocks.size(), find_num_threads(num_threads), [&](const size_t& iblk) {
+    PhysicalPb& physical_pb = cluster_annotation.mutable_physical_pb(blocks[iblk]);
     /* Find the LUT physical pb id */
     for (const PhysicalPbId& primitive_pb : physical_pb.primitive_pbs()) {
       CircuitModelId circuit_model = device_annotation.pb_type_circuit_model(physical_pb.pb_graph_node(primitive_pb)->pb_type);
@@ -212,7 +220,7 @@ void build_physical_lut_truth_tables(VprClusteringAnnotation& cluster_annotation
       /* Reach here, we have a LUT to deal with. Find the truth tables that mapped to the LUT */
       build_physical_pb_lut_truth_tables(physical_pb, primitive_pb, atom_ctx, device_annotation, circuit_lib, verbose);
     }
-  }
+  });
 }
 
 } /* end namespace openfpga */
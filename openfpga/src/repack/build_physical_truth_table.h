@@ -22,6 +22,7 @@ void build_physical_lut_truth_tables(VprClusteringAnnotation& cluster_annotation
                                      const ClusteringContext& cluster_ctx,
                                      const VprDeviceAnnotation& device_annotation,
                                      const CircuitLibrary& circuit_lib,
+                                     const size_t& num_threads,
                                      const bool& verbose);
 
 } /* end namespace openfpga */
@@ -1,6 +1,8 @@
 /******************************************************************************
  * Memember functions for data structure LbRouter
  ******************************************************************************/
+#include <algorithm>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -22,6 +24,9 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_typ
   routing_status_.resize(lb_rr_graph.nodes().size());
   explored_node_tb_.resize(lb_rr_graph.nodes().size());
   explore_id_index_ = 1;
+  route_id_ = 0;
+
+  num_used_traces_ = 0;
 
   lb_type_ = lb_type;
 
@@ -48,6 +53,16 @@ AtomNetId LbRouter::net_atom_net_id(const NetId& net) const {
   return lb_net_atom_net_ids_[net]; 
 }
 
+const std::vector<LbRRNodeId>& LbRouter::net_sources(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sources_[net]; 
+}
+
+const std::vector<LbRRNodeId>& LbRouter::net_sinks(const NetId& net) const {
+  VTR_ASSERT(true == valid_net_id(net));
+  return lb_net_sinks_[net]; 
+}
+
 std::vector<LbRRNodeId> LbRouter::find_congested_rr_nodes(const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
@@ -67,6 +82,10 @@ bool LbRouter::is_routed() const {
   return is_routed_;
 }
 
+const LbRouter::t_route_stats& LbRouter::route_stats() const {
+  return route_stats_;
+}
+
 std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   VTR_ASSERT(true == is_routed());
   VTR_ASSERT(true == valid_net_id(net));
@@ -74,8 +93,8 @@ std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   std::vector<LbRRNodeId> routed_nodes;
 
   for (size_t isrc = 0; isrc < lb_net_sources_[net].size(); ++isrc) { 
-    t_trace* rt_tree = lb_net_rt_trees_[net][isrc];
-    if (nullptr == rt_tree) {
+    TraceId rt_tree = lb_net_rt_trees_[net][isrc];
+    if (TraceId::INVALID() == rt_tree) {
       return routed_nodes;
     }
     /* Walk through the routing tree of the net */
@@ -106,31 +125,31 @@ bool LbRouter::is_route_success(const LbRRGraph& lb_rr_graph) const {
   return true;
 }
 
-LbRouter::t_trace* LbRouter::find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index) {
-  t_trace* cur;
-  if (rt->current_node == rt_index) {
+LbRouter::TraceId LbRouter::find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const {
+  TraceId cur;
+  if (traces_[rt].current_node == rt_index) {
     return rt;
   } else {
-    for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-      cur = find_node_in_rt(&rt->next_nodes[i], rt_index);
-      if (cur != nullptr) {
+    for (const TraceId& next : traces_[rt].next_nodes) {
+      cur = find_node_in_rt(next, rt_index);
+      if (TraceId::INVALID() != cur) {
         return cur;
       }
     }
   }
-  return nullptr;
+  return TraceId::INVALID();
 }
 
-bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const {
+bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, const TraceId& rt) const {
   t_mode* cur_mode = nullptr;
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(rt->current_node, rt->next_nodes[i].current_node);
+  for (const TraceId& next : traces_[rt].next_nodes) {
+    std::vector<LbRREdgeId> edges = lb_rr_graph.find_edge(traces_[rt].current_node, traces_[next].current_node);
     VTR_ASSERT(1 == edges.size());
     t_mode* new_mode = lb_rr_graph.edge_mode(edges[0]);
     if (cur_mode != nullptr && cur_mode != new_mode) {
       return true;
     }
-    if (route_has_conflict(lb_rr_graph, &rt->next_nodes[i]) == true) {
+    if (route_has_conflict(lb_rr_graph, next) == true) {
       return true;
     }
     cur_mode = new_mode;
@@ -139,13 +158,13 @@ bool LbRouter::route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) con
   return false;
 }
 
-void LbRouter::rec_collect_trace_nodes(const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const {
-  if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(), trace->current_node)) {
-    routed_nodes.push_back(trace->current_node);
+void LbRouter::rec_collect_trace_nodes(const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const {
+  if (routed_nodes.end() == std::find(routed_nodes.begin(), routed_nodes.end(), traces_[trace].current_node)) {
+    routed_nodes.push_back(traces_[trace].current_node);
   }
 
-  for (const t_trace& next : trace->next_nodes) {
-    rec_collect_trace_nodes(&next, routed_nodes);
+  for (const TraceId& next : traces_[trace].next_nodes) {
+    rec_collect_trace_nodes(next, routed_nodes);
   }
 }
 
@@ -165,7 +184,7 @@ LbRouter::NetId LbRouter::create_net_to_route(const std::vector<LbRRNodeId>& sou
   
   lb_net_sources_.push_back(sources);
   lb_net_sinks_.push_back(terminals);
-  lb_net_rt_trees_.push_back(std::vector<t_trace*>(sources.size(), nullptr));
+  lb_net_rt_trees_.push_back(std::vector<TraceId>(sources.size(), TraceId::INVALID()));
 
   return net;
 }
@@ -207,6 +226,21 @@ void LbRouter::set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
       }
     }
   }
+
+  /* Precompute the modes and out edges to expand nodes, which are fixed from now on
+   * The lists of out edges keep their memory when the router is reused
+   */
+  node_expand_modes_.resize(lb_rr_graph.nodes().size());
+  node_expand_out_edges_.resize(lb_rr_graph.nodes().size());
+  for (const LbRRNodeId& node : lb_rr_graph.nodes()) {
+    node_expand_modes_[node] = find_node_expand_mode(lb_rr_graph, node);
+    node_expand_out_edges_[node].clear();
+    for (const LbRREdgeId& edge : lb_rr_graph.node_out_edges(node)) {
+      if (node_expand_modes_[node] == lb_rr_graph.edge_mode(edge)) {
+        node_expand_out_edges_[node].push_back(edge);
+      }
+    }
+  }
 }
 
 bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
@@ -236,9 +270,12 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
       continue;
     }
 
+    if (TraceId::INVALID() != lb_net_rt_trees_[net_idx][isrc]) {
+      route_stats_.num_ripups++;
+    }
     commit_remove_rt(lb_rr_graph, lb_net_rt_trees_[net_idx][isrc], RT_REMOVE, mode_map);
     free_net_rt(lb_net_rt_trees_[net_idx][isrc]);
-    lb_net_rt_trees_[net_idx][isrc] = nullptr;
+    lb_net_rt_trees_[net_idx][isrc] = TraceId::INVALID();
     add_source_to_rt(net_idx, isrc);
 
     /* Route each sink of net */
@@ -369,6 +406,30 @@ bool LbRouter::try_route_net(const LbRRGraph& lb_rr_graph,
   return route_succeed;
 }
 
+void LbRouter::reset(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_type) {
+  clear_nets();
+  reset_illegal_modes();
+  pq_.clear();
+
+  /* Reallocate only when the routing resource graph is different */
+  if (false == matched_lb_rr_graph(lb_rr_graph)) {
+    routing_status_.clear();
+    routing_status_.resize(lb_rr_graph.nodes().size());
+    explored_node_tb_.clear();
+    explored_node_tb_.resize(lb_rr_graph.nodes().size());
+    node_expand_modes_.clear();
+    node_expand_out_edges_.clear();
+  }
+
+  lb_type_ = lb_type;
+
+  is_routed_ = false;
+  mode_status_ = t_mode_selection_status();
+  route_stats_ = t_route_stats();
+
+  pres_con_fac_ = 1;
+}
+
 bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
                          const AtomNetlist& atom_nlist,
                          const bool& verbosity) {
@@ -387,9 +448,11 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   mode_status_.is_mode_conflict = false;
   mode_status_.try_expand_all_modes = false;
 
+  route_stats_ = t_route_stats();
+
   t_expansion_node exp_node;
 
-  reset_explored_node_tb();
+  advance_explored_node_tb();
 
   /* Reset current routing */
   reset_net_rt();
@@ -401,6 +464,7 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
    * Cap the total number of iterations tried so that if a solution does not exist, then the router won't run indefinitely */
   pres_con_fac_ = params_.pres_fac;
   for (int iter = 0; iter < params_.max_iterations && !is_routed_ && !is_impossible; iter++) {
+    route_stats_.num_iterations++;
     unsigned int inet;
     /* Iterate across all nets internal to logic block */
     for (inet = 0; inet < lb_net_ids_.size() && !is_impossible; inet++) {
@@ -552,16 +616,16 @@ bool LbRouter::check_edge_for_route_conflicts(std::unordered_map<const t_pb_grap
 }
 
 void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
-                                t_trace* rt,
+                                const TraceId& rt,
                                 const e_commit_remove& op,
                                 std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map) {
   int incr;
 
-  if (nullptr == rt) {
+  if (TraceId::INVALID() == rt) {
     return;
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is being used or removed */
   if (op == RT_COMMIT) {
@@ -580,12 +644,12 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
   t_pb_graph_pin* driver_pin = lb_rr_graph.node_pb_graph_pin(inode);
 
   /* Recursively update route tree */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
+  for (const TraceId& next : traces_[rt].next_nodes) {
     // Check to see if there is no mode conflict between previous nets.
     // A conflict is present if there are differing modes between a pb_graph_node
     // and its children.
     if (op == RT_COMMIT && mode_status_.try_expand_all_modes) {
-      const LbRRNodeId& node = rt->next_nodes[i].current_node;
+      const LbRRNodeId& node = traces_[next].current_node;
       t_pb_graph_pin* pin = lb_rr_graph.node_pb_graph_pin(node);
 
       if (check_edge_for_route_conflicts(mode_map, driver_pin, pin)) {
@@ -593,20 +657,20 @@ void LbRouter::commit_remove_rt(const LbRRGraph& lb_rr_graph,
       }
     }
 
-    commit_remove_rt(lb_rr_graph, &rt->next_nodes[i], op, mode_map);
+    commit_remove_rt(lb_rr_graph, next, op, mode_map);
   }
 }
 
 bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
-                                 t_trace* rt) {
+                                 const TraceId& rt) {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
-  if (rt == nullptr) {
+  if (TraceId::INVALID() == rt) {
     return false; /* Net is not routed, therefore must route net */
   }
 
-  LbRRNodeId inode = rt->current_node;
+  LbRRNodeId inode = traces_[rt].current_node;
 
   /* Determine if node is overused */
   if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
@@ -615,8 +679,8 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
   }
 
   /* Recursively check that rest of route tree does not have a conflict */
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    if (!is_skip_route_net(lb_rr_graph, &rt->next_nodes[i])) {
+  for (const TraceId& next : traces_[rt].next_nodes) {
+    if (!is_skip_route_net(lb_rr_graph, next)) {
       return false;
     }
   }
@@ -625,14 +689,13 @@ bool LbRouter::is_skip_route_net(const LbRRGraph& lb_rr_graph,
   return true;
 }
 
-bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId& irt_net) {
+bool LbRouter::add_to_rt(const TraceId& rt, const LbRRNodeId& node_index, const NetId& irt_net) {
   std::vector<LbRRNodeId> trace_forward;
-  t_trace* link_node;
-  t_trace curr_node;
+  TraceId link_node;
 
   /* Store path all the way back to route tree */
   LbRRNodeId rt_index = node_index;
-  while (explored_node_tb_[rt_index].inet != irt_net) {
+  while (explored_node_net(rt_index) != irt_net) {
     trace_forward.push_back(rt_index);
     rt_index = explored_node_tb_[rt_index].prev_index;
     VTR_ASSERT(rt_index != LbRRNodeId::INVALID());
@@ -640,7 +703,7 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
 
   /* Find rt_index on the route tree */
   link_node = find_node_in_rt(rt, rt_index);
-  if (link_node == nullptr) {
+  if (TraceId::INVALID() == link_node) {
     VTR_LOG("Link node is nullptr. Routing impossible");
     return true;
   }
@@ -649,9 +712,10 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
   LbRRNodeId trace_index;
   while (!trace_forward.empty()) {
     trace_index = trace_forward.back();
-    curr_node.current_node = trace_index;
-    link_node->next_nodes.push_back(curr_node);
-    link_node = &link_node->next_nodes.back();
+    /* Allocate before accessing the arena, which may be reallocated */
+    TraceId curr_node = alloc_trace(trace_index);
+    traces_[link_node].next_nodes.push_back(curr_node);
+    link_node = curr_node;
     trace_forward.pop_back();
   }
 
@@ -660,12 +724,11 @@ bool LbRouter::add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId&
 
 void LbRouter::add_source_to_rt(const NetId& inet, const size_t& isrc) {
   /* TODO: Validate net id */
-  VTR_ASSERT(nullptr == lb_net_rt_trees_[inet][isrc]);
-  lb_net_rt_trees_[inet][isrc] = new t_trace;
-  lb_net_rt_trees_[inet][isrc]->current_node = lb_net_sources_[inet][isrc];
+  VTR_ASSERT(TraceId::INVALID() == lb_net_rt_trees_[inet][isrc]);
+  lb_net_rt_trees_[inet][isrc] = alloc_trace(lb_net_sources_[inet][isrc]);
 }
 
-void LbRouter::expand_rt_rec(t_trace* rt,
+void LbRouter::expand_rt_rec(const TraceId& rt,
                              const LbRRNodeId& prev_index, 
                              const NetId& irt_net,
                              const int& explore_id_index) {
@@ -673,17 +736,18 @@ void LbRouter::expand_rt_rec(t_trace* rt,
 
   /* Perhaps should use a cost other than zero */
   enode.cost = 0;
-  enode.node_index = rt->current_node;
+  enode.node_index = traces_[rt].current_node;
   enode.prev_index = prev_index;
   pq_.push(enode);
   explored_node_tb_[enode.node_index].inet = irt_net;
+  explored_node_tb_[enode.node_index].route_id = route_id_;
   explored_node_tb_[enode.node_index].explored_id = OPEN;
   explored_node_tb_[enode.node_index].enqueue_id = explore_id_index;
   explored_node_tb_[enode.node_index].enqueue_cost = 0;
   explored_node_tb_[enode.node_index].prev_index = prev_index;
 
-  for (unsigned int i = 0; i < rt->next_nodes.size(); i++) {
-    expand_rt_rec(&rt->next_nodes[i], rt->current_node, irt_net, explore_id_index);
+  for (const TraceId& next : traces_[rt].next_nodes) {
+    expand_rt_rec(next, traces_[rt].current_node, irt_net, explore_id_index);
   }
 }
 
@@ -707,7 +771,16 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
   int usage;
   float incr_cost;
 
-  for (const LbRREdgeId& iedge : lb_rr_graph.node_out_edges(cur_inode, mode)) {
+  /* Use the precomputed out edges if the node is expanded in its default mode */
+  std::vector<LbRREdgeId> mode_out_edges;
+  const std::vector<LbRREdgeId>* out_edges = &mode_out_edges;
+  if ((true == is_node_expand_ready()) && (mode == node_expand_modes_[cur_inode])) {
+    out_edges = &node_expand_out_edges_[cur_inode];
+  } else {
+    mode_out_edges = lb_rr_graph.node_out_edges(cur_inode, mode);
+  }
+
+  for (const LbRREdgeId& iedge : *out_edges) {
     /* Init new expansion node */
     enode.prev_index = cur_inode;
     enode.node_index = lb_rr_graph.edge_sink_node(iedge);
@@ -724,20 +797,13 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph,
 
     /* Adjust cost so that higher fanout nets prefer higher fanout routing nodes while lower fanout nets prefer lower fanout routing nodes */
     float fanout_factor = 1.0;
-    t_mode* next_mode = routing_status_[enode.node_index].mode;
-    /* Assume first mode if a mode hasn't been forced. */
-    if (nullptr == next_mode) {
-      /* If the node is mapped to a nullptr pb_graph_pin, this is a special SINK. Use nullptr mode */
-      if (nullptr == lb_rr_graph.node_pb_graph_pin(enode.node_index)) {
-        next_mode = nullptr;
-      } else if (true == is_primitive_pb_type(lb_rr_graph.node_pb_graph_pin(enode.node_index)->parent_node->pb_type)) {
-      /* For primitive node, we give nullptr as default */
-        next_mode = nullptr;
-      } else {
-        next_mode = &(lb_rr_graph.node_pb_graph_pin(enode.node_index)->parent_node->pb_type->modes[0]);
-      }
+    size_t next_num_out_edges = 0;
+    if (true == is_node_expand_ready()) {
+      next_num_out_edges = node_expand_out_edges_[enode.node_index].size();
+    } else {
+      next_num_out_edges = lb_rr_graph.node_out_edges(enode.node_index, find_node_expand_mode(lb_rr_graph, enode.node_index)).size();
     }
-    if (lb_rr_graph.node_out_edges(enode.node_index, next_mode).size() > 1) {
+    if (next_num_out_edges > 1) {
       fanout_factor = 0.85 + (0.25 / net_fanout);
     } else {
       fanout_factor = 1.15 - (0.25 / net_fanout);
@@ -781,15 +847,11 @@ void LbRouter::expand_node(const LbRRGraph& lb_rr_graph,
 
   LbRRNodeId cur_node = exp_node.node_index;
   float cur_cost = exp_node.cost;
-  t_mode* mode = routing_status_[cur_node].mode;
-  if (nullptr == mode) {
-    if (nullptr == lb_rr_graph.node_pb_graph_pin(cur_node)) {
-      mode = nullptr;
-    } else if (true == is_primitive_pb_type(lb_rr_graph.node_pb_graph_pin(cur_node)->parent_node->pb_type)) {
-      mode = nullptr;
-    } else {
-      mode = &(lb_rr_graph.node_pb_graph_pin(cur_node)->parent_node->pb_type->modes[0]);
-    }
+  t_mode* mode = nullptr;
+  if (true == is_node_expand_ready()) {
+    mode = node_expand_modes_[cur_node];
+  } else {
+    mode = find_node_expand_mode(lb_rr_graph, cur_node);
   }
 
   /*
@@ -875,6 +937,8 @@ bool LbRouter::try_expand_nodes(const AtomNetlist& atom_nlist,
         VTR_LOG("\n");
       }
     } else {
+      route_stats_.max_pq_size = std::max(route_stats_.max_pq_size, pq_.size());
+      route_stats_.num_expanded_nodes++;
       exp_node = pq_.top();
       pq_.pop();
       LbRRNodeId exp_inode = exp_node.node_index;
@@ -903,6 +967,35 @@ bool LbRouter::try_expand_nodes(const AtomNetlist& atom_nlist,
 /**************************************************
  * Private validators
  *************************************************/
+LbRouter::NetId LbRouter::explored_node_net(const LbRRNodeId& node) const {
+  if (route_id_ != explored_node_tb_[node].route_id) {
+    return NetId::INVALID();
+  }
+  return explored_node_tb_[node].inet;
+}
+
+t_mode* LbRouter::find_node_expand_mode(const LbRRGraph& lb_rr_graph, const LbRRNodeId& node) const {
+  t_mode* mode = routing_status_[node].mode;
+  /* Assume first mode if a mode hasn't been forced. */
+  if (nullptr == mode) {
+    /* If the node is mapped to a nullptr pb_graph_pin, this is a special SINK. Use nullptr mode */
+    if (nullptr == lb_rr_graph.node_pb_graph_pin(node)) {
+      mode = nullptr;
+    } else if (true == is_primitive_pb_type(lb_rr_graph.node_pb_graph_pin(node)->parent_node->pb_type)) {
+    /* For primitive node, we give nullptr as default */
+      mode = nullptr;
+    } else {
+      mode = &(lb_rr_graph.node_pb_graph_pin(node)->parent_node->pb_type->modes[0]);
+    }
+  }
+  return mode;
+}
+
+bool LbRouter::is_node_expand_ready() const {
+  return (node_expand_modes_.size() == routing_status_.size())
+      && (node_expand_out_edges_.size() == routing_status_.size());
+}
+
 bool LbRouter::matched_lb_rr_graph(const LbRRGraph& lb_rr_graph) const {
   return ( (routing_status_.size() == lb_rr_graph.nodes().size())
         && (explored_node_tb_.size() == lb_rr_graph.nodes().size()) );
@@ -986,18 +1079,35 @@ void LbRouter::reset_explored_node_tb() {
     explored_node.prev_index = LbRRNodeId::INVALID();
     explored_node.explored_id = OPEN;
     explored_node.inet = NetId::INVALID();
+    explored_node.route_id = OPEN;
     explored_node.enqueue_id = OPEN;
     explored_node.enqueue_cost = 0;
   }
 }
 
+/* Start a new routing on the explored node table
+ * The nodes explored by previous routings become stale by advancing the identifiers,
+ * so that the whole table is cleared only upon overflow
+ */
+void LbRouter::advance_explored_node_tb() {
+  explore_id_index_++;
+  route_id_++;
+  if ((explore_id_index_ > 2000000000) || (route_id_ > 2000000000)) {
+    /* overflow protection */
+    reset_explored_node_tb();
+    explore_id_index_ = 1;
+    route_id_ = 1;
+  }
+}
+
+/* Traces of all the nets are returned to the arena at once */
 void LbRouter::reset_net_rt() {
   for (const NetId& inet : lb_net_ids_) {
     for (size_t isrc = 0; isrc < lb_net_sources_[inet].size(); ++isrc) {
-      free_net_rt(lb_net_rt_trees_[inet][isrc]);
-      lb_net_rt_trees_[inet][isrc] = nullptr;
+      lb_net_rt_trees_[inet][isrc] = TraceId::INVALID();
     }
   }
+  reset_traces();
 }
 
 void LbRouter::reset_routing_status() {
@@ -1008,7 +1118,6 @@ void LbRouter::reset_routing_status() {
 }
 
 void LbRouter::clear_nets() {
-  /* TODO: Trace should no longer use pointers */
   reset_net_rt();
 
   lb_net_ids_.clear();
@@ -1020,25 +1129,40 @@ void LbRouter::clear_nets() {
   lb_net_rt_trees_.clear();
 }
 
-void LbRouter::free_net_rt(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
+/* Reuse a freed trace if any, otherwise take the next available one in the arena
+ * The list of next nodes keeps its memory from the previous use
+ */
+LbRouter::TraceId LbRouter::alloc_trace(const LbRRNodeId& node) {
+  TraceId trace;
+  if (false == free_traces_.empty()) {
+    trace = free_traces_.back();
+    free_traces_.pop_back();
+  } else {
+    if (num_used_traces_ == traces_.size()) {
+      traces_.emplace_back();
     }
-    lb_trace->next_nodes.clear();
-    delete lb_trace;
+    trace = TraceId(num_used_traces_);
+    num_used_traces_++;
   }
+  traces_[trace].current_node = node;
+  traces_[trace].next_nodes.clear();
+  return trace;
 }
 
-void LbRouter::free_lb_trace(t_trace* lb_trace) {
-  if (lb_trace != nullptr) {
-    for (unsigned int i = 0; i < lb_trace->next_nodes.size(); i++) {
-      free_lb_trace(&lb_trace->next_nodes[i]);
+void LbRouter::free_net_rt(const TraceId& lb_trace) {
+  if (TraceId::INVALID() != lb_trace) {
+    for (const TraceId& next : traces_[lb_trace].next_nodes) {
+      free_net_rt(next);
     }
-    lb_trace->next_nodes.clear();
+    free_traces_.push_back(lb_trace);
   }
 }
 
+void LbRouter::reset_traces() {
+  num_used_traces_ = 0;
+  free_traces_.clear();
+}
+
 void LbRouter::reset_illegal_modes() {
   illegal_modes_.clear();
 }
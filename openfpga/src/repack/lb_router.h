@@ -66,6 +66,9 @@ namespace openfpga {
  *  // Here is an example to check which nodes are mapped to the 'net' created before
  *  std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
  *
+ *  // Reuse the router for another set of nets, without reallocating its internal data
+ *  lb_router.reset(lb_rr_graph, lb_type);
+ *
  *******************************************************************/
 
 
@@ -73,6 +76,8 @@ class LbRouter {
   public: /* Strong ids */
     struct net_id_tag;
     typedef vtr::StrongId<net_id_tag> NetId;
+    struct trace_id_tag;
+    typedef vtr::StrongId<trace_id_tag> TraceId;
   public: /* Types and ranges */
     typedef vtr::vector<NetId, NetId>::const_iterator net_iterator;
     typedef vtr::Range<net_iterator> net_range;
@@ -99,10 +104,11 @@ class LbRouter {
      * A net is implemented using routing resource nodes. 
      * The t_lb_trace data structure records one of the nodes used by the net and the connections
      * to other nodes
+     * Traces are allocated from the arena of the router, and refer to each other by ids
      ***************************************************************************/
     struct t_trace {
       LbRRNodeId current_node;            /* current t_lb_type_rr_node used by net */
-      std::vector<t_trace> next_nodes; /* index of previous edge that drives current node */
+      std::vector<TraceId> next_nodes; /* traces of the nodes driven by current node */
     };
 
     /**************************************************************************
@@ -147,7 +153,8 @@ class LbRouter {
     struct t_explored_node_stats {
       LbRRNodeId prev_index;     /* Prevous node that drives this one */
       int explored_id;    /* ID used to determine if this node has been explored */
-      NetId inet;           /* net index of route tree */
+      NetId inet;           /* net index of route tree, which is valid only when route_id is the current one */
+      int route_id;       /* ID used to determine if the net index is set in the current routing */
       int enqueue_id;     /* ID used ot determine if this node has been pushed on exploration priority queue */
       float enqueue_cost; /* cost of node pused on exploration priority queue */
     
@@ -156,6 +163,7 @@ class LbRouter {
         explored_id = OPEN;
         enqueue_id = OPEN;
         inet = NetId::INVALID();
+        route_id = OPEN;
         enqueue_cost = 0;
       }
     };
@@ -173,6 +181,16 @@ class LbRouter {
       }
     };
 
+    /**************************************************************************
+     * Statistics of a call to try_route(), which are used to profile the router
+     ***************************************************************************/
+    struct t_route_stats {
+      size_t num_iterations = 0;     /* Number of routing iterations */
+      size_t num_expanded_nodes = 0; /* Number of nodes popped from the priority queue */
+      size_t num_ripups = 0;         /* Number of routing trees removed to be rerouted */
+      size_t max_pq_size = 0;        /* Peak size of the priority queue */
+    };
+
     // TODO: check if this hacky class memory reserve thing is still necessary, if not, then delete
     /* Packing uses a priority queue that requires a large number of elements.  
      * This backdoor
@@ -216,6 +234,10 @@ class LbRouter {
     /* Return the atom net id for a net to be routed */
     AtomNetId net_atom_net_id(const NetId& net) const;    
 
+    /* Return the source and sink nodes of a net to be routed */
+    const std::vector<LbRRNodeId>& net_sources(const NetId& net) const;
+    const std::vector<LbRRNodeId>& net_sinks(const NetId& net) const;
+
     /**
      * Find all the routing resource nodes that are over-used, which they are used more than their capacity
      * This function is call to collect the nodes and router can reroute these net
@@ -225,6 +247,9 @@ class LbRouter {
     /* Show if a valid routing solution has been founded or not */
     bool is_routed() const;
 
+    /* Return the statistics of the last routing */
+    const t_route_stats& route_stats() const;
+
     /**
      * Get the routing results for a Net 
      */
@@ -250,6 +275,14 @@ class LbRouter {
     void set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
                                const VprDeviceAnnotation& device_annotation);
 
+    /**
+     * Clear all the nets and routing results, so that the router can be reused
+     * to route another logical block on the given routing resource graph
+     * The memory allocated for the routing resource graph is reused
+     * when it has the same size as the one used before
+     */
+    void reset(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_type);
+
     /**
      * Perform routing algorithm on a given logical tile routing resource graph
      * Note: the lb_rr_graph must be the same as you initilized the router!!!
@@ -266,14 +299,23 @@ class LbRouter {
 
     /**
      * Try to find a node in the routing traces recursively
-     * If not found, will return an empty pointer
+     * If not found, will return an invalid id
      */
-    t_trace* find_node_in_rt(t_trace* rt, const LbRRNodeId& rt_index);
+    TraceId find_node_in_rt(const TraceId& rt, const LbRRNodeId& rt_index) const;
 
-    bool route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const;
+    bool route_has_conflict(const LbRRGraph& lb_rr_graph, const TraceId& rt) const;
+
+    /* Find the net of route tree which a node belongs to in the current routing */
+    NetId explored_node_net(const LbRRNodeId& node) const;
+
+    /* Find the mode in which a node is expanded during routing */
+    t_mode* find_node_expand_mode(const LbRRGraph& lb_rr_graph, const LbRRNodeId& node) const;
+
+    /* Show if the modes and out edges to expand nodes are precomputed by set_physical_pb_modes() */
+    bool is_node_expand_ready() const;
 
     /* Recursively find all the nodes in the trace */
-    void rec_collect_trace_nodes(const t_trace* trace, std::vector<LbRRNodeId>& routed_nodes) const;
+    void rec_collect_trace_nodes(const TraceId& trace, std::vector<LbRRNodeId>& routed_nodes) const;
 
   private : /* Private mutators */
     /*It is possible that a net may connect multiple times to a logically equivalent set of primitive pins.
@@ -290,13 +332,13 @@ class LbRouter {
                                         const t_pb_graph_pin* driver_pin,
                                         const t_pb_graph_pin* pin);
     void commit_remove_rt(const LbRRGraph& lb_rr_graph,
-                          t_trace* rt,
+                          const TraceId& rt,
                           const e_commit_remove& op,
                           std::unordered_map<const t_pb_graph_node*, const t_mode*>& mode_map);
-    bool is_skip_route_net(const LbRRGraph& lb_rr_graph, t_trace* rt);
-    bool add_to_rt(t_trace* rt, const LbRRNodeId& node_index, const NetId& irt_net);
+    bool is_skip_route_net(const LbRRGraph& lb_rr_graph, const TraceId& rt);
+    bool add_to_rt(const TraceId& rt, const LbRRNodeId& node_index, const NetId& irt_net);
     void add_source_to_rt(const NetId& inet, const size_t& isrc);
-    void expand_rt_rec(t_trace* rt,
+    void expand_rt_rec(const TraceId& rt,
                        const LbRRNodeId& prev_index, 
                        const NetId& irt_net,
                        const int& explore_id_index);
@@ -348,13 +390,17 @@ class LbRouter {
 
   private :  /* Private initializer and cleaner */
     void reset_explored_node_tb();
+    void advance_explored_node_tb();
     void reset_net_rt();
     void reset_routing_status();
     void reset_illegal_modes();
 
     void clear_nets();
-    void free_net_rt(t_trace* lb_trace);
-    void free_lb_trace(t_trace* lb_trace);
+
+    /* Allocate a trace from the arena, and return traces to the arena */
+    TraceId alloc_trace(const LbRRNodeId& node);
+    void free_net_rt(const TraceId& lb_trace);
+    void reset_traces();
 
   private : /* Stores all data needed by intra-logic cluster_ctx.blocks router */
     /* Logical Netlist Info */
@@ -377,16 +423,34 @@ class LbRouter {
     vtr::vector<NetId, std::vector<LbRRNodeId>> lb_net_sinks_;
 
     /* Route tree head for each source of each net */
-    vtr::vector<NetId, std::vector<t_trace*>> lb_net_rt_trees_;
+    vtr::vector<NetId, std::vector<TraceId>> lb_net_rt_trees_;
+
+    /* Arena of the traces of all the route trees
+     * Traces are never deallocated, so that their memory is reused between routings:
+     * - traces [0..num_used_traces_-1] have been used, among which the freed ones are in free_traces_
+     * - the other traces are available 
+     */
+    vtr::vector<TraceId, t_trace> traces_;
+    size_t num_used_traces_;
+    std::vector<TraceId> free_traces_;
 
     /* Logical-to-physical mapping info */
     vtr::vector<LbRRNodeId, t_routing_status> routing_status_; /* [0..lb_type_graph->size()-1] Stats for each logic cluster_ctx.blocks rr node instance */
 
+    /* Mode to expand each node and the out edges of the node in the mode,
+     * which are precomputed when modes are set, so that the routing does not
+     * look up the modes through pb_graph_pins and filter the edges of nodes
+     */
+    vtr::vector<LbRRNodeId, t_mode*> node_expand_modes_;
+    vtr::vector<LbRRNodeId, std::vector<LbRREdgeId>> node_expand_out_edges_;
+
     /* Stores state info during Pathfinder iterative routing */
     vtr::vector<LbRRNodeId, t_explored_node_stats> explored_node_tb_; /* [0..lb_type_graph->size()-1] Stores mode exploration and traceback info for nodes */
 
     int explore_id_index_;                 /* used in conjunction with node_traceback to determine whether or not a location has been explored.  By using a unique identifier every route, I don't have to clear the previous route exploration */
 
+    int route_id_;                         /* unique identifier of each call to try_route(), so that the explored nodes of previous routings do not have to be cleared */
+
     /* Current type */
     t_logical_block_type_ptr lb_type_;
 
@@ -399,6 +463,9 @@ class LbRouter {
     /* Stores the mode selection status when expanding the edges */
     t_mode_selection_status mode_status_;
 
+    /* Stores the statistics of the last routing */
+    t_route_stats route_stats_;
+
     /* Stores state info of the priority queue in expanding edges during route */
     reservable_pq<t_expansion_node, std::vector<t_expansion_node>, compare_expansion_node> pq_;
 
@@ -74,9 +74,25 @@ void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
                                            const LbRouter& lb_router,
                                            const LbRRGraph& lb_rr_graph) {
   /* Get mapping routing nodes per net */
+  std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
   for (const LbRouter::NetId& net : lb_router.nets()) {
-    std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
-    for (const LbRRNodeId& node : routed_nodes) {
+    net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+  }
+  save_lb_router_results_to_physical_pb(phy_pb, lb_router, net_routed_nodes, lb_rr_graph);
+}
+
+/***************************************************************************************
+ * Save the routed nodes of each net, which are found by a LbRouter on the same nets
+ * (not necessarily the given router), to the physical pb
+ * The atom nets are those of the nets in the given router
+ ***************************************************************************************/
+void save_lb_router_results_to_physical_pb(PhysicalPb& phy_pb,
+                                           const LbRouter& lb_router,
+                                           const std::vector<std::vector<LbRRNodeId>>& net_routed_nodes,
+                                           const LbRRGraph& lb_rr_graph) {
+  VTR_ASSERT(net_routed_nodes.size() == lb_router.nets().size());
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    for (const LbRRNodeId& node : net_routed_nodes[size_t(net)]) {
       t_pb_graph_pin* pb_graph_pin = lb_rr_graph.node_pb_graph_pin(node);
       if (nullptr == pb_graph_pin) {
         continue;
@@ -0,0 +1,403 @@
+/********************************************************************
+ * This file includes functions to save the physical lb_rr_graphs of
+ * all the logical tiles to a binary cache file, and to load them back,
+ * so that the graphs are not built again for each design
+ *
+ * The file is a sequence of 64-bit words and strings, where
+ * a string is a word of its length followed by its characters
+ * (not padded):
+ *
+ *   +------------------------------------------------------+
+ *   | Header                                               |
+ *   |   magic number "OFPGALRR"                            |
+ *   |   endian marker 0x0102030405060708                   |
+ *   |   format version                                     |
+ *   |   architecture id (string)                           |
+ *   |   number of logical tiles                            |
+ *   +------------------------------------------------------+
+ *   | Graphs, logical tile by logical tile                 |
+ *   |   number of nodes                                    |
+ *   |     per node: type, capacity, pin index, cost        |
+ *   |   number of edges                                    |
+ *   |     per edge: source node, sink node, mode index,    |
+ *   |               cost                                   |
+ *   +------------------------------------------------------+
+ *
+ * The pb_graph pins and the modes are pointers to the pb_graph of VPR,
+ * which are stored by their indices in a walk through the pb_graph
+ * (see rec_collect_physical_lb_rr_graph_cache_pins()).
+ * Index 0 represents a null pointer.
+ * Costs are stored by the bits of single-precision floats.
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "physical_lb_rr_graph_cache.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Collect all the pins and modes of a pb_graph in a fixed order,
+ * so that they can be refered by indices in the cache.
+ * Modes are shared by the instances of a pb_type, so the caller
+ * should only consider the first occurance of each mode
+ *******************************************************************/
+static
+void rec_collect_physical_lb_rr_graph_cache_pins(t_pb_graph_node* pb_graph_node,
+                                                 std::vector<t_pb_graph_pin*>& pins,
+                                                 std::vector<t_mode*>& modes) {
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
+      pins.push_back(&(pb_graph_node->input_pins[iport][ipin]));
+    }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
+      pins.push_back(&(pb_graph_node->output_pins[iport][ipin]));
+    }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; ++iport) {
+    for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
+      pins.push_back(&(pb_graph_node->clock_pins[iport][ipin]));
+    }
+  }
+
+  t_pb_type* pb_type = pb_graph_node->pb_type;
+  for (int imode = 0; imode < pb_type->num_modes; ++imode) {
+    modes.push_back(&(pb_type->modes[imode]));
+    for (int ichild = 0; ichild < pb_type->modes[imode].num_pb_type_children; ++ichild) {
+      for (int inst = 0; inst < pb_type->modes[imode].pb_type_children[ichild].num_pb; ++inst) {
+        rec_collect_physical_lb_rr_graph_cache_pins(&(pb_graph_node->child_pb_graph_nodes[imode][ichild][inst]),
+                                                    pins, modes);
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Append a word, a cost or a string to the buffer of a cache
+ *******************************************************************/
+static
+void append_physical_lb_rr_graph_cache_word(std::string& buffer,
+                                            const uint64_t& word) {
+  buffer.append(reinterpret_cast<const char*>(&word), sizeof(uint64_t));
+}
+
+static
+void append_physical_lb_rr_graph_cache_cost(std::string& buffer,
+                                            const float& cost) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &cost, sizeof(float));
+  append_physical_lb_rr_graph_cache_word(buffer, bits);
+}
+
+static
+void append_physical_lb_rr_graph_cache_string(std::string& buffer,
+                                              const std::string& str) {
+  append_physical_lb_rr_graph_cache_word(buffer, str.size());
+  buffer.append(str);
+}
+
+/********************************************************************
+ * Write the physical lb_rr_graphs of all the logical tiles to a binary cache file
+ * The graphs are indexed by the logical tiles of the device context,
+ * and should be empty for the logical tiles without a pb_graph
+ * The file can be read back by read_physical_lb_rr_graphs_from_binary_file()
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_physical_lb_rr_graphs_to_binary_file(const DeviceContext& device_ctx,
+                                               const std::vector<LbRRGraph>& lb_rr_graphs,
+                                               const std::string& arch_id,
+                                               const std::string& fname,
+                                               const bool& verbose) {
+  VTR_ASSERT(lb_rr_graphs.size() == device_ctx.logical_block_types.size());
+
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output physical lb_rr_graph cache!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message = std::string("Write physical lb_rr_graph cache into binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  std::string buffer(PHYSICAL_LB_RR_GRAPH_CACHE_MAGIC, sizeof(uint64_t));
+  append_physical_lb_rr_graph_cache_word(buffer, PHYSICAL_LB_RR_GRAPH_CACHE_ENDIAN_MARKER);
+  append_physical_lb_rr_graph_cache_word(buffer, PHYSICAL_LB_RR_GRAPH_CACHE_VERSION);
+  append_physical_lb_rr_graph_cache_string(buffer, arch_id);
+  append_physical_lb_rr_graph_cache_word(buffer, lb_rr_graphs.size());
+
+  for (size_t itype = 0; itype < lb_rr_graphs.size(); ++itype) {
+    const LbRRGraph& lb_rr_graph = lb_rr_graphs[itype];
+
+    std::map<t_pb_graph_pin*, size_t> pin_indices;
+    std::map<t_mode*, size_t> mode_indices;
+    t_pb_graph_node* pb_graph_head = device_ctx.logical_block_types[itype].pb_graph_head;
+    if (nullptr != pb_graph_head) {
+      std::vector<t_pb_graph_pin*> pins;
+      std::vector<t_mode*> modes;
+      rec_collect_physical_lb_rr_graph_cache_pins(pb_graph_head, pins, modes);
+      for (size_t ipin = 0; ipin < pins.size(); ++ipin) {
+        pin_indices.insert(std::make_pair(pins[ipin], ipin + 1));
+      }
+      for (size_t imode = 0; imode < modes.size(); ++imode) {
+        mode_indices.insert(std::make_pair(modes[imode], imode + 1));
+      }
+    }
+    pin_indices[nullptr] = 0;
+    mode_indices[nullptr] = 0;
+
+    append_physical_lb_rr_graph_cache_word(buffer, lb_rr_graph.nodes().size());
+    for (const LbRRNodeId& node : lb_rr_graph.nodes()) {
+      append_physical_lb_rr_graph_cache_word(buffer, lb_rr_graph.node_type(node));
+      append_physical_lb_rr_graph_cache_word(buffer, lb_rr_graph.node_capacity(node));
+      append_physical_lb_rr_graph_cache_word(buffer, pin_indices.at(lb_rr_graph.node_pb_graph_pin(node)));
+      append_physical_lb_rr_graph_cache_cost(buffer, lb_rr_graph.node_intrinsic_cost(node));
+    }
+
+    append_physical_lb_rr_graph_cache_word(buffer, lb_rr_graph.edges().size());
+    for (const LbRREdgeId& edge : lb_rr_graph.edges()) {
+      append_physical_lb_rr_graph_cache_word(buffer, size_t(lb_rr_graph.edge_src_node(edge)));
+      append_physical_lb_rr_graph_cache_word(buffer, size_t(lb_rr_graph.edge_sink_node(edge)));
+      append_physical_lb_rr_graph_cache_word(buffer, mode_indices.at(lb_rr_graph.edge_mode(edge)));
+      append_physical_lb_rr_graph_cache_cost(buffer, lb_rr_graph.edge_intrinsic_cost(edge));
+    }
+
+    /* Flush graph by graph to limit memory usage */
+    fp.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write physical lb_rr_graph cache to binary file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Outputted physical lb_rr_graphs of %lu logical tiles to cache file: %s\n",
+           lb_rr_graphs.size(),
+           fname.c_str());
+
+  return status;
+}
+
+/********************************************************************
+ * A cursor on the content of a cache file
+ * Reading beyond the end of the content will mark the cursor as failed
+ * and return zeros or empty strings
+ *******************************************************************/
+class PhysicalLbRRGraphCacheCursor {
+  public: /* Public constructor */
+    explicit PhysicalLbRRGraphCacheCursor(const std::string& content)
+      : content_(content), offset_(0), failed_(false) {}
+
+  public: /* Public mutators */
+    uint64_t read_word() {
+      uint64_t word = 0;
+      if ((true == failed_) || (content_.size() - offset_ < sizeof(uint64_t))) {
+        failed_ = true;
+        return word;
+      }
+      std::memcpy(&word, content_.data() + offset_, sizeof(uint64_t));
+      offset_ += sizeof(uint64_t);
+      return word;
+    }
+
+    float read_cost() {
+      uint32_t bits = read_word();
+      float cost = 0.;
+      std::memcpy(&cost, &bits, sizeof(float));
+      return cost;
+    }
+
+    std::string read_string() {
+      uint64_t length = read_word();
+      if ((true == failed_) || (content_.size() - offset_ < length)) {
+        failed_ = true;
+        return std::string();
+      }
+      std::string str = content_.substr(offset_, length);
+      offset_ += length;
+      return str;
+    }
+
+  public: /* Public accessors */
+    bool failed() const { return failed_; }
+    bool finished() const { return offset_ == content_.size(); }
+
+  private: /* Internal data */
+    const std::string& content_;
+    size_t offset_;
+    bool failed_;
+};
+
+/********************************************************************
+ * Read the nodes and edges of a physical lb_rr_graph
+ * Return false if the content is not valid
+ *******************************************************************/
+static
+bool read_physical_lb_rr_graph_cache_graph(PhysicalLbRRGraphCacheCursor& cursor,
+                                           t_pb_graph_node* pb_graph_head,
+                                           LbRRGraph& lb_rr_graph) {
+  std::vector<t_pb_graph_pin*> pins(1, nullptr);
+  std::vector<t_mode*> modes(1, nullptr);
+  if (nullptr != pb_graph_head) {
+    rec_collect_physical_lb_rr_graph_cache_pins(pb_graph_head, pins, modes);
+  }
+
+  size_t num_nodes = cursor.read_word();
+  if (true == cursor.failed()) {
+    return false;
+  }
+  for (size_t inode = 0; inode < num_nodes; ++inode) {
+    uint64_t type = cursor.read_word();
+    uint64_t capacity = cursor.read_word();
+    size_t pin_index = cursor.read_word();
+    float cost = cursor.read_cost();
+    if ((true == cursor.failed())
+       || (NUM_LB_RR_TYPES <= type)
+       || (pin_index >= pins.size())) {
+      return false;
+    }
+    LbRRNodeId node = lb_rr_graph.create_node(e_lb_rr_type(type));
+    lb_rr_graph.set_node_capacity(node, capacity);
+    if (nullptr != pins[pin_index]) {
+      lb_rr_graph.set_node_pb_graph_pin(node, pins[pin_index]);
+    }
+    lb_rr_graph.set_node_intrinsic_cost(node, cost);
+  }
+
+  size_t num_edges = cursor.read_word();
+  if (true == cursor.failed()) {
+    return false;
+  }
+  for (size_t iedge = 0; iedge < num_edges; ++iedge) {
+    LbRRNodeId src_node = LbRRNodeId(cursor.read_word());
+    LbRRNodeId sink_node = LbRRNodeId(cursor.read_word());
+    size_t mode_index = cursor.read_word();
+    float cost = cursor.read_cost();
+    if ((true == cursor.failed())
+       || (false == lb_rr_graph.valid_node_id(src_node))
+       || (false == lb_rr_graph.valid_node_id(sink_node))
+       || (mode_index >= modes.size())) {
+      return false;
+    }
+    LbRREdgeId edge = lb_rr_graph.create_edge(src_node, sink_node, modes[mode_index]);
+    lb_rr_graph.set_edge_intrinsic_cost(edge, cost);
+  }
+
+  return true;
+}
+
+/********************************************************************
+ * Read the physical lb_rr_graphs of all the logical tiles from a binary cache file
+ * The graphs are loaded only if the architecture id matches the given one,
+ * otherwise the graphs are not touched, so that the caller can
+ * build them from scratch
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if the cache can not be loaded
+ *******************************************************************/
+int read_physical_lb_rr_graphs_from_binary_file(const DeviceContext& device_ctx,
+                                                std::vector<LbRRGraph>& lb_rr_graphs,
+                                                const std::string& arch_id,
+                                                const std::string& fname,
+                                                const bool& verbose) {
+  std::string timer_message = std::string("Read physical lb_rr_graph cache from binary file '") + fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Load the file */
+  std::ifstream fp(fname, std::ifstream::binary | std::ifstream::ate);
+  if (!fp.is_open()) {
+    VTR_LOG_WARN("Unable to open physical lb_rr_graph cache file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  std::string content(fp.tellg(), '\0');
+  fp.seekg(0);
+  fp.read(&content[0], content.size());
+  if (!fp.good()) {
+    VTR_LOG_WARN("Fail to read physical lb_rr_graph cache file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  fp.close();
+
+  /* Check the header */
+  PhysicalLbRRGraphCacheCursor cursor(content);
+  uint64_t magic = cursor.read_word();
+  if ((true == cursor.failed())
+     || (0 != std::memcmp(&magic, PHYSICAL_LB_RR_GRAPH_CACHE_MAGIC, sizeof(uint64_t)))
+     || (PHYSICAL_LB_RR_GRAPH_CACHE_ENDIAN_MARKER != cursor.read_word())) {
+    VTR_LOG_WARN("File '%s' is not a physical lb_rr_graph cache or written by a machine with a different byte order!\n",
+                  fname.c_str());
+    return 1;
+  }
+  uint64_t version = cursor.read_word();
+  if (PHYSICAL_LB_RR_GRAPH_CACHE_VERSION != version) {
+    VTR_LOG_WARN("Unsupported version '%lu' of physical lb_rr_graph cache file '%s' (expect '%lu')!\n",
+                  version, fname.c_str(), PHYSICAL_LB_RR_GRAPH_CACHE_VERSION);
+    return 1;
+  }
+  if ((arch_id != cursor.read_string())
+     || (device_ctx.logical_block_types.size() != cursor.read_word())) {
+    VTR_LOG_WARN("Physical lb_rr_graph cache file '%s' is built from different architectures!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  /* Build the graphs aside, so that they are not touched when the cache is not valid */
+  std::vector<LbRRGraph> cache_lb_rr_graphs(device_ctx.logical_block_types.size());
+  bool valid_content = true;
+  for (size_t itype = 0; itype < cache_lb_rr_graphs.size(); ++itype) {
+    valid_content = read_physical_lb_rr_graph_cache_graph(cursor,
+                                                          device_ctx.logical_block_types[itype].pb_graph_head,
+                                                          cache_lb_rr_graphs[itype]);
+    if ((false == valid_content) || (false == cache_lb_rr_graphs[itype].validate())) {
+      valid_content = false;
+      break;
+    }
+  }
+
+  if ((false == valid_content) || (false == cursor.finished())) {
+    VTR_LOG_WARN("Physical lb_rr_graph cache file '%s' is corrupted!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  lb_rr_graphs = std::move(cache_lb_rr_graphs);
+
+  VTR_LOGV(verbose,
+           "Loaded physical lb_rr_graphs of %lu logical tiles from cache file: %s\n",
+           lb_rr_graphs.size(),
+           fname.c_str());
+
+  return 0;
+}
+
+} /* end namespace openfpga */
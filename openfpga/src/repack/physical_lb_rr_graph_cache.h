@@ -0,0 +1,41 @@
+#ifndef PHYSICAL_LB_RR_GRAPH_CACHE_H
+#define PHYSICAL_LB_RR_GRAPH_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "vpr_context.h"
+#include "lb_rr_graph.h"
+
+/********************************************************************
+ * Constants for the binary file format of physical lb_rr_graph caches
+ *******************************************************************/
+constexpr char PHYSICAL_LB_RR_GRAPH_CACHE_MAGIC[] = "OFPGALRR";
+constexpr uint64_t PHYSICAL_LB_RR_GRAPH_CACHE_ENDIAN_MARKER = 0x0102030405060708;
+constexpr uint64_t PHYSICAL_LB_RR_GRAPH_CACHE_VERSION = 1;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_physical_lb_rr_graphs_to_binary_file(const DeviceContext& device_ctx,
+                                               const std::vector<LbRRGraph>& lb_rr_graphs,
+                                               const std::string& arch_id,
+                                               const std::string& fname,
+                                               const bool& verbose);
+
+int read_physical_lb_rr_graphs_from_binary_file(const DeviceContext& device_ctx,
+                                                std::vector<LbRRGraph>& lb_rr_graphs,
+                                                const std::string& arch_id,
+                                                const std::string& fname,
+                                                const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -102,7 +102,7 @@ std::vector<size_t> PhysicalPb::mode_bits(const PhysicalPbId& pb) const {
   return mode_bits_[pb];
 }
 
-std::string PhysicalPb::fixed_bitstream(const PhysicalPbId& pb) const {
+const std::vector<bool>& PhysicalPb::fixed_bitstream(const PhysicalPbId& pb) const {
   VTR_ASSERT(true == valid_pb_id(pb));
   return fixed_bitstreams_[pb];
 }
@@ -112,7 +112,7 @@ size_t PhysicalPb::fixed_bitstream_offset(const PhysicalPbId& pb) const {
   return fixed_bitstream_offsets_[pb];
 }
 
-std::string PhysicalPb::fixed_mode_select_bitstream(const PhysicalPbId& pb) const {
+const std::vector<bool>& PhysicalPb::fixed_mode_select_bitstream(const PhysicalPbId& pb) const {
   VTR_ASSERT(true == valid_pb_id(pb));
   return fixed_mode_select_bitstreams_[pb];
 }
@@ -232,7 +232,7 @@ void PhysicalPb::set_wire_lut_output(const PhysicalPbId& pb,
 }
 
 void PhysicalPb::set_fixed_bitstream(const PhysicalPbId& pb,
-                                     const std::string& fixed_bitstream) {
+                                     const std::vector<bool>& fixed_bitstream) {
   VTR_ASSERT(true == valid_pb_id(pb)); 
   fixed_bitstreams_[pb] = fixed_bitstream;
 }
@@ -244,7 +244,7 @@ void PhysicalPb::set_fixed_bitstream_offset(const PhysicalPbId& pb,
 }
 
 void PhysicalPb::set_fixed_mode_select_bitstream(const PhysicalPbId& pb,
-                                                 const std::string& fixed_bitstream) {
+                                                 const std::vector<bool>& fixed_bitstream) {
   VTR_ASSERT(true == valid_pb_id(pb)); 
   fixed_mode_select_bitstreams_[pb] = fixed_bitstream;
 }
@@ -54,9 +54,9 @@ class PhysicalPb {
                             const t_pb_graph_pin* pb_graph_pin) const;
     std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable> truth_tables(const PhysicalPbId& pb) const;
     std::vector<size_t> mode_bits(const PhysicalPbId& pb) const;
-    std::string fixed_bitstream(const PhysicalPbId& pb) const;
+    const std::vector<bool>& fixed_bitstream(const PhysicalPbId& pb) const;
     size_t fixed_bitstream_offset(const PhysicalPbId& pb) const;
-    std::string fixed_mode_select_bitstream(const PhysicalPbId& pb) const;
+    const std::vector<bool>& fixed_mode_select_bitstream(const PhysicalPbId& pb) const;
     size_t fixed_mode_select_bitstream_offset(const PhysicalPbId& pb) const;
   public: /* Public mutators */
     PhysicalPbId create_pb(const t_pb_graph_node* pb_graph_node);
@@ -77,11 +77,11 @@ class PhysicalPb {
                              const t_pb_graph_pin* pb_graph_pin,
                              const bool& wire_lut_output);
     void set_fixed_bitstream(const PhysicalPbId& pb,
-                             const std::string& fixed_bitstream);
+                             const std::vector<bool>& fixed_bitstream);
     void set_fixed_bitstream_offset(const PhysicalPbId& pb,
                                     const size_t& offset);
     void set_fixed_mode_select_bitstream(const PhysicalPbId& pb,
-                                         const std::string& fixed_bitstream);
+                                         const std::vector<bool>& fixed_bitstream);
     void set_fixed_mode_select_bitstream_offset(const PhysicalPbId& pb,
                                                 const size_t& offset);
   public: /* Public validators/invalidators */
@@ -106,10 +106,11 @@ class PhysicalPb {
 
     vtr::vector<PhysicalPbId, std::vector<size_t>> mode_bits_;
 
-    vtr::vector<PhysicalPbId, std::string> fixed_bitstreams_;
+    /* Bitstreams from the eblif file, which are decoded once for each atom block in repack */
+    vtr::vector<PhysicalPbId, std::vector<bool>> fixed_bitstreams_;
     vtr::vector<PhysicalPbId, size_t> fixed_bitstream_offsets_;
 
-    vtr::vector<PhysicalPbId, std::string> fixed_mode_select_bitstreams_;
+    vtr::vector<PhysicalPbId, std::vector<bool>> fixed_mode_select_bitstreams_;
     vtr::vector<PhysicalPbId, size_t> fixed_mode_select_bitstream_offsets_;
 
     /* Fast lookup */
@@ -2,10 +2,17 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <algorithm>
+#include <map>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 
 /* Headers from vpr library */
 #include "vpr_utils.h"
@@ -15,6 +22,7 @@
 #include "lb_router.h"
 #include "lb_router_utils.h"
 #include "physical_pb_utils.h"
+#include "repack_stats_writer.h"
 #include "repack.h"
 
 /* begin namespace openfpga */
@@ -655,25 +663,76 @@ void add_lb_router_nets(LbRouter& lb_router,
            net_counter);
 }
 
+/***************************************************************************************
+ * Routing results of clustered blocks, which are reused by the clustered blocks
+ * of the same logical block type to be routed with the same nets.
+ * The key is the sources and sinks of each net, see find_lb_router_nets_key()
+ * The value is the routed nodes of each net
+ ***************************************************************************************/
+typedef std::map<std::vector<size_t>, std::vector<std::vector<LbRRNodeId>>> LbRouteCache;
+
+/***************************************************************************************
+ * Find the key of the nets to be routed by a router in a route cache
+ * The routing only depends on the routing resource graph, the physical modes
+ * and the sources and sinks of the nets in order, while atom nets are not considered.
+ * Therefore, the routing results can be reused for the clustered blocks of 
+ * the same logical block type whose nets have the same sources and sinks 
+ ***************************************************************************************/
+static 
+std::vector<size_t> find_lb_router_nets_key(const LbRouter& lb_router) {
+  std::vector<size_t> key;
+  key.push_back(lb_router.nets().size());
+  for (const LbRouter::NetId& net : lb_router.nets()) {
+    key.push_back(lb_router.net_sources(net).size());
+    for (const LbRRNodeId& node : lb_router.net_sources(net)) {
+      key.push_back(size_t(node));
+    }
+    key.push_back(lb_router.net_sinks(net).size());
+    for (const LbRRNodeId& node : lb_router.net_sinks(net)) {
+      key.push_back(size_t(node));
+    }
+  }
+  return key;
+}
+
 /***************************************************************************************
  * Repack a clustered block in the physical mode
  * This function will do 
  * - Find the lb_rr_graph that is affiliated to the clustered block 
  *   and initilize the logcial tile router 
+ *   The router of each logical block type is reused between clustered blocks,
+ *   to avoid reallocating its internal data for every clustered block
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation 
  * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in clustering annotation
+ *   The routing is skipped if the routing results of another clustered block
+ *   with the same nets to be routed can be found in the route cache
+ * - Output routing results to data structure PhysicalPb
+ *
+ * Note:
+ * - The clustering annotation is read-only here, so that clustered blocks can be
+ *   repacked in parallel. The caller should store the PhysicalPb in clustering annotation
+ *
+ * Return true if the routing succeeds
+ * The statistics of the router and the wall time are recorded in the cluster stats
  ***************************************************************************************/
 static 
-void repack_cluster(const AtomContext& atom_ctx,
+bool repack_cluster(const AtomContext& atom_ctx,
                     const ClusteringContext& clustering_ctx,
                     const VprDeviceAnnotation& device_annotation,
-                    VprClusteringAnnotation& clustering_annotation,
+                    const VprClusteringAnnotation& clustering_annotation,
                     const VprBitstreamAnnotation& bitstream_annotation,
                     const RepackDesignConstraints& design_constraints,
                     const ClusterBlockId& block_id,
+                    std::map<t_logical_block_type_ptr, LbRouter>& lb_routers,
+                    std::map<t_logical_block_type_ptr, LbRouteCache>& lb_route_caches,
+                    PhysicalPb& phy_pb,
+                    t_repack_cluster_stats& cluster_stats,
                     const bool& verbose) {
+  VTR_TRACE_SPAN("repack " + clustering_ctx.clb_nlist.block_name(block_id));
+  vtr::Timer timer;
+  cluster_stats.block = block_id;
+
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type = clustering_ctx.clb_nlist.block_type(block_id);
   t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
@@ -683,16 +742,22 @@ void repack_cluster(const AtomContext& atom_ctx,
   const LbRRGraph& lb_rr_graph = device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose,
+           "Repack clustered block '%s'...\n",
+           clustering_ctx.clb_nlist.block_name(block_id).c_str());
 
   /* Initialize the router */
-  LbRouter lb_router(lb_rr_graph, lb_type);
+  auto router_result = lb_routers.find(lb_type);
+  if (lb_routers.end() == router_result) {
+    router_result = lb_routers.emplace(lb_type, LbRouter(lb_rr_graph, lb_type)).first;
+  } else {
+    router_result->second.reset(lb_rr_graph, lb_type);
+  }
+  LbRouter& lb_router = router_result->second;
 
   /* Add nets to be routed with source and terminals */
   add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-                     clustering_ctx, const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                     clustering_ctx, clustering_annotation,
                      design_constraints,
                      block_id, verbose);
 
@@ -701,18 +766,33 @@ void repack_cluster(const AtomContext& atom_ctx,
    */
   lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation); 
 
-  /* Run the router */
-  bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+  /* Run the router, unless the same nets have been routed */
+  LbRouteCache& lb_route_cache = lb_route_caches[lb_type];
+  std::vector<size_t> nets_key = find_lb_router_nets_key(lb_router);
+  auto cache_result = lb_route_cache.find(nets_key);
+  cluster_stats.num_nets = lb_router.nets().size();
+  if (lb_route_cache.end() != cache_result) {
+    VTR_LOGV(verbose, "Reuse the routing results of a clustered block with the same nets\n");
+    cluster_stats.route_cache_hit = true;
+  } else {
+    bool route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+    cluster_stats.route_stats = lb_router.route_stats();
+
+    if (false == route_success) {
+      cluster_stats.wall_time_sec = timer.elapsed_sec();
+      VTR_LOGV(verbose, "Reroute failed\n");
+      return false;
+    }
+    VTR_LOGV(verbose, "Reroute succeed\n");
 
-  if (false == route_success) {
-    VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    std::vector<std::vector<LbRRNodeId>> net_routed_nodes;
+    for (const LbRouter::NetId& net : lb_router.nets()) {
+      net_routed_nodes.push_back(lb_router.net_routed_nodes(net));
+    }
+    cache_result = lb_route_cache.emplace(nets_key, net_routed_nodes).first;
   }
-  VTR_ASSERT(true == route_success);
-  VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
   alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_update_physical_pb_from_operating_pb(phy_pb,
                                            clustering_ctx.clb_nlist.block_pb(block_id),
@@ -722,17 +802,25 @@ void repack_cluster(const AtomContext& atom_ctx,
                                            bitstream_annotation,
                                            verbose);
   /* Save routing results */
-  save_lb_router_results_to_physical_pb(phy_pb, lb_router, lb_rr_graph);
+  save_lb_router_results_to_physical_pb(phy_pb, lb_router, cache_result->second, lb_rr_graph);
   VTR_LOGV(verbose, "Saved results in physical pb\n");
 
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
+  cluster_stats.wall_time_sec = timer.elapsed_sec();
+
+  /* Log in one line, so that the logs of parallel runs are not mixed */
+  VTR_LOG("Repack clustered block '%s'...Done\n",
+          clustering_ctx.clb_nlist.block_name(block_id).c_str());
 
-  VTR_LOG("Done\n");
+  return true;
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ * Clustered blocks are independent from each other, and are repacked with a number of threads.
+ * Each thread repacks a contiguous range of clustered blocks with its own routers and route caches.
+ * The physical pbs are moved to clustering annotation by each thread,
+ * as they are allocated for all the clustered blocks in advance
+ * The statistics of repacking are reported when a file name is given
  ***************************************************************************************/
 static 
 void repack_clusters(const AtomContext& atom_ctx,
@@ -741,16 +829,62 @@ void repack_clusters(const AtomContext& atom_ctx,
                      VprClusteringAnnotation& clustering_annotation,
                      const VprBitstreamAnnotation& bitstream_annotation,
                      const RepackDesignConstraints& design_constraints,
+                     const std::string& report_stats_fname,
+                     const size_t& num_threads,
                      const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Repack clustered blocks to physical implementation of logical tile");
 
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, 
-                   device_annotation,
-                   clustering_annotation, 
-                   bitstream_annotation,
-                   design_constraints,
-                   blk_id, verbose);
+  std::vector<ClusterBlockId> blocks(clustering_ctx.clb_nlist.blocks().begin(),
+                                     clustering_ctx.clb_nlist.blocks().end());
+  /* Allocate the physical pbs in advance, so that each thread can add its physical pbs */
+  size_t num_block_ids = 0;
+  for (const ClusterBlockId& blk_id : blocks) {
+    num_block_ids = std::max(num_block_ids, size_t(blk_id) + 1);
+  }
+  clustering_annotation.reserve_physical_pbs(num_block_ids);
+  /* Use char rather than bool, as std::vector<bool> can not be written by multiple threads */
+  std::vector<char> route_success(blocks.size(), false);
+  std::vector<t_repack_cluster_stats> cluster_stats(blocks.size());
+
+  size_t num_shards = std::min(find_num_threads(num_threads), blocks.size());
+  parallel_for(num_shards, num_shards, [&](const size_t& ishard) {
+    std::map<t_logical_block_type_ptr, LbRouter> lb_routers;
+    std::map<t_logical_block_type_ptr, LbRouteCache> lb_route_caches;
+    for (size_t iblk = ishard * blocks.size() / num_shards;
+         iblk < (ishard + 1) * blocks.size() / num_shards;
+         ++iblk) {
+      PhysicalPb phy_pb;
+      route_success[iblk] = repack_cluster(atom_ctx, clustering_ctx,
+                                           device_annotation,
+                                           const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+                                           bitstream_annotation,
+                                           design_constraints,
+                                           blocks[iblk], lb_routers, lb_route_caches, phy_pb,
+                                           cluster_stats[iblk],
+                                           verbose);
+      /* Add the pb to clustering context */
+      if (true == bool(route_success[iblk])) {
+        clustering_annotation.add_physical_pb(blocks[iblk], std::move(phy_pb));
+      }
+    }
+  });
+
+  bool repack_success = true;
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    if (false == route_success[iblk]) {
+      VTR_LOG_ERROR("Failed to repack clustered block '%s'!\n",
+                    clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+      repack_success = false;
+    }
+  }
+
+  if (false == report_stats_fname.empty()) {
+    print_repack_stats_summary(clustering_ctx, cluster_stats);
+    write_repack_stats_to_json_file(clustering_ctx, cluster_stats, report_stats_fname, verbose);
+  }
+
+  if (false == repack_success) {
+    exit(1);
   }
 }
 
@@ -810,11 +944,18 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const VprBitstreamAnnotation& bitstream_annotation,
                        const RepackDesignConstraints& design_constraints,
                        const CircuitLibrary& circuit_lib,
+                       const std::string& arch_id,
+                       const std::string& lb_rr_graph_cache_fname,
+                       const std::string& report_stats_fname,
+                       const size_t& num_threads,
                        const bool& verbose) {
 
   /* build the routing resource graph for each logical tile */
   build_physical_lb_rr_graphs(device_ctx,
                               device_annotation,
+                              arch_id,
+                              lb_rr_graph_cache_fname,
+                              num_threads,
                               verbose);
 
   /* Call the LbRouter to re-pack each clustered block to physical implementation */ 
@@ -823,6 +964,8 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                   clustering_annotation, 
                   bitstream_annotation,
                   design_constraints,
+                  report_stats_fname,
+                  num_threads,
                   verbose);
 
   /* Annnotate wire LUTs that are ONLY created by repacker!!!
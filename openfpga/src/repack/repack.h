@@ -27,6 +27,10 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const VprBitstreamAnnotation& bitstream_annotation,
                        const RepackDesignConstraints& design_constraints,
                        const CircuitLibrary& circuit_lib,
+                       const std::string& arch_id,
+                       const std::string& lb_rr_graph_cache_fname,
+                       const std::string& report_stats_fname,
+                       const size_t& num_threads,
                        const bool& verbose);
 
 } /* end namespace openfpga */
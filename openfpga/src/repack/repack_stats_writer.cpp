@@ -0,0 +1,263 @@
+/********************************************************************
+ * This file includes functions to report the statistics of repacking
+ * clustered blocks, in a text summary and in JSON format,
+ * in order to find the clustered blocks which are slow to repack
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+
+#include "repack_stats_writer.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Upper bounds (in seconds) of the bins of wall time histograms,
+ * the last bin is for all the clustered blocks slower than the last bound
+ */
+static const std::vector<float> REPACK_STATS_WALL_TIME_BOUNDS = {1e-5, 1e-4, 1e-3, 1e-2, 1e-1, 1.};
+
+/* Number of the slowest clustered blocks shown in the text summary */
+constexpr size_t REPACK_STATS_NUM_SLOWEST_CLUSTERS = 10;
+
+/********************************************************************
+ * Statistics aggregated for the clustered blocks of a logical tile
+ *******************************************************************/
+struct t_repack_lb_type_stats {
+  size_t num_clusters = 0;
+  size_t num_route_cache_hits = 0;
+  size_t num_expanded_nodes = 0;
+  float total_wall_time_sec = 0.;
+  float max_wall_time_sec = 0.;
+};
+
+static
+std::map<std::string, t_repack_lb_type_stats> find_repack_lb_type_stats(const ClusteringContext& clustering_ctx,
+                                                                         const std::vector<t_repack_cluster_stats>& cluster_stats) {
+  std::map<std::string, t_repack_lb_type_stats> lb_type_stats;
+  for (const t_repack_cluster_stats& stats : cluster_stats) {
+    t_repack_lb_type_stats& type_stats = lb_type_stats[clustering_ctx.clb_nlist.block_type(stats.block)->name];
+    type_stats.num_clusters++;
+    type_stats.num_route_cache_hits += stats.route_cache_hit;
+    type_stats.num_expanded_nodes += stats.route_stats.num_expanded_nodes;
+    type_stats.total_wall_time_sec += stats.wall_time_sec;
+    type_stats.max_wall_time_sec = std::max(type_stats.max_wall_time_sec, stats.wall_time_sec);
+  }
+  return lb_type_stats;
+}
+
+/********************************************************************
+ * Count the clustered blocks in each bin of wall time
+ *******************************************************************/
+static
+std::vector<size_t> find_repack_wall_time_histogram(const std::vector<t_repack_cluster_stats>& cluster_stats) {
+  std::vector<size_t> histogram(REPACK_STATS_WALL_TIME_BOUNDS.size() + 1, 0);
+  for (const t_repack_cluster_stats& stats : cluster_stats) {
+    size_t ibin = std::upper_bound(REPACK_STATS_WALL_TIME_BOUNDS.begin(), REPACK_STATS_WALL_TIME_BOUNDS.end(), stats.wall_time_sec)
+                - REPACK_STATS_WALL_TIME_BOUNDS.begin();
+    histogram[ibin]++;
+  }
+  return histogram;
+}
+
+/********************************************************************
+ * Count the clustered blocks by the number of routing iterations
+ * Clustered blocks reusing the routing results have no iteration
+ *******************************************************************/
+static
+std::map<size_t, size_t> find_repack_iteration_histogram(const std::vector<t_repack_cluster_stats>& cluster_stats) {
+  std::map<size_t, size_t> histogram;
+  for (const t_repack_cluster_stats& stats : cluster_stats) {
+    histogram[stats.route_stats.num_iterations]++;
+  }
+  return histogram;
+}
+
+/********************************************************************
+ * Print a summary of the statistics of repacking:
+ * - the statistics of each logical tile
+ * - the histogram of wall time and routing iterations
+ * - the slowest clustered blocks
+ *******************************************************************/
+void print_repack_stats_summary(const ClusteringContext& clustering_ctx,
+                                const std::vector<t_repack_cluster_stats>& cluster_stats) {
+  VTR_LOG("Repack statistics of %lu clustered blocks\n", cluster_stats.size());
+
+  VTR_LOG("\tLogical tile statistics:\n");
+  for (const auto& type_stats : find_repack_lb_type_stats(clustering_ctx, cluster_stats)) {
+    VTR_LOG("\t\t%s: %lu blocks (%lu routes reused), %lu nodes expanded, total time %g sec, max time %g sec\n",
+            type_stats.first.c_str(),
+            type_stats.second.num_clusters,
+            type_stats.second.num_route_cache_hits,
+            type_stats.second.num_expanded_nodes,
+            type_stats.second.total_wall_time_sec,
+            type_stats.second.max_wall_time_sec);
+  }
+
+  VTR_LOG("\tWall time histogram:\n");
+  std::vector<size_t> wall_time_histogram = find_repack_wall_time_histogram(cluster_stats);
+  for (size_t ibin = 0; ibin < wall_time_histogram.size(); ++ibin) {
+    if (ibin < REPACK_STATS_WALL_TIME_BOUNDS.size()) {
+      VTR_LOG("\t\t< %g sec: %lu blocks\n", REPACK_STATS_WALL_TIME_BOUNDS[ibin], wall_time_histogram[ibin]);
+    } else {
+      VTR_LOG("\t\t>= %g sec: %lu blocks\n", REPACK_STATS_WALL_TIME_BOUNDS.back(), wall_time_histogram[ibin]);
+    }
+  }
+
+  VTR_LOG("\tRouting iteration histogram:\n");
+  for (const auto& bin : find_repack_iteration_histogram(cluster_stats)) {
+    VTR_LOG("\t\t%lu iterations: %lu blocks\n", bin.first, bin.second);
+  }
+
+  std::vector<size_t> slowest_clusters(cluster_stats.size());
+  for (size_t istats = 0; istats < cluster_stats.size(); ++istats) {
+    slowest_clusters[istats] = istats;
+  }
+  size_t num_slowest_clusters = std::min(REPACK_STATS_NUM_SLOWEST_CLUSTERS, slowest_clusters.size());
+  std::partial_sort(slowest_clusters.begin(), slowest_clusters.begin() + num_slowest_clusters, slowest_clusters.end(),
+                    [&](const size_t& lhs, const size_t& rhs) {
+                      return cluster_stats[lhs].wall_time_sec > cluster_stats[rhs].wall_time_sec;
+                    });
+  VTR_LOG("\tSlowest clustered blocks:\n");
+  for (size_t istats = 0; istats < num_slowest_clusters; ++istats) {
+    const t_repack_cluster_stats& stats = cluster_stats[slowest_clusters[istats]];
+    VTR_LOG("\t\t%s (%s): %g sec, %lu nets, %lu iterations, %lu nodes expanded, %lu rip-ups, peak queue size %lu\n",
+            clustering_ctx.clb_nlist.block_name(stats.block).c_str(),
+            clustering_ctx.clb_nlist.block_type(stats.block)->name,
+            stats.wall_time_sec,
+            stats.num_nets,
+            stats.route_stats.num_iterations,
+            stats.route_stats.num_expanded_nodes,
+            stats.route_stats.num_ripups,
+            stats.route_stats.max_pq_size);
+  }
+}
+
+/********************************************************************
+ * Quote a string for JSON, escaping the characters that are not allowed
+ *******************************************************************/
+static
+std::string generate_json_string(const std::string& str) {
+  std::string json_str("\"");
+  for (const char& ch : str) {
+    if (('"' == ch) || ('\\' == ch)) {
+      json_str += '\\';
+    }
+    json_str += ch;
+  }
+  json_str += "\"";
+  return json_str;
+}
+
+/********************************************************************
+ * Report the statistics of repacking to a JSON file, including
+ * the statistics of each logical tile, the histograms
+ * and the statistics of each clustered block
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_repack_stats_to_json_file(const ClusteringContext& clustering_ctx,
+                                    const std::vector<t_repack_cluster_stats>& cluster_stats,
+                                    const std::string& fname,
+                                    const bool& verbose) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR("Received empty file name to output repack statistics!\n\tPlease specify a valid file name.\n");
+    return 1;
+  }
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  fp << "{\n";
+  fp << "  \"num_clusters\": " << cluster_stats.size() << ",\n";
+
+  fp << "  \"lb_types\": [";
+  bool first_entry = true;
+  for (const auto& type_stats : find_repack_lb_type_stats(clustering_ctx, cluster_stats)) {
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "    {";
+    fp << "\"name\": " << generate_json_string(type_stats.first);
+    fp << ", \"num_clusters\": " << type_stats.second.num_clusters;
+    fp << ", \"num_route_cache_hits\": " << type_stats.second.num_route_cache_hits;
+    fp << ", \"num_expanded_nodes\": " << type_stats.second.num_expanded_nodes;
+    fp << ", \"total_wall_time_sec\": " << type_stats.second.total_wall_time_sec;
+    fp << ", \"max_wall_time_sec\": " << type_stats.second.max_wall_time_sec;
+    fp << "}";
+  }
+  fp << "\n  ],\n";
+
+  /* The last bin has no upper bound */
+  fp << "  \"wall_time_histogram\": [";
+  std::vector<size_t> wall_time_histogram = find_repack_wall_time_histogram(cluster_stats);
+  for (size_t ibin = 0; ibin < wall_time_histogram.size(); ++ibin) {
+    fp << (0 == ibin ? "\n" : ",\n");
+    fp << "    {\"max_wall_time_sec\": ";
+    if (ibin < REPACK_STATS_WALL_TIME_BOUNDS.size()) {
+      fp << REPACK_STATS_WALL_TIME_BOUNDS[ibin];
+    } else {
+      fp << "null";
+    }
+    fp << ", \"num_clusters\": " << wall_time_histogram[ibin] << "}";
+  }
+  fp << "\n  ],\n";
+
+  fp << "  \"iteration_histogram\": [";
+  first_entry = true;
+  for (const auto& bin : find_repack_iteration_histogram(cluster_stats)) {
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "    {\"num_iterations\": " << bin.first << ", \"num_clusters\": " << bin.second << "}";
+  }
+  fp << "\n  ],\n";
+
+  fp << "  \"clusters\": [";
+  first_entry = true;
+  for (const t_repack_cluster_stats& stats : cluster_stats) {
+    fp << (first_entry ? "\n" : ",\n");
+    first_entry = false;
+    fp << "    {";
+    fp << "\"name\": " << generate_json_string(clustering_ctx.clb_nlist.block_name(stats.block));
+    fp << ", \"lb_type\": " << generate_json_string(clustering_ctx.clb_nlist.block_type(stats.block)->name);
+    fp << ", \"num_nets\": " << stats.num_nets;
+    fp << ", \"route_cache_hit\": " << (stats.route_cache_hit ? "true" : "false");
+    fp << ", \"num_iterations\": " << stats.route_stats.num_iterations;
+    fp << ", \"num_expanded_nodes\": " << stats.route_stats.num_expanded_nodes;
+    fp << ", \"num_ripups\": " << stats.route_stats.num_ripups;
+    fp << ", \"max_pq_size\": " << stats.route_stats.max_pq_size;
+    fp << ", \"wall_time_sec\": " << stats.wall_time_sec;
+    fp << "}";
+  }
+  fp << "\n  ]\n";
+  fp << "}\n";
+
+  int status = 0;
+  if (!fp.good()) {
+    VTR_LOG_ERROR("Fail to write repack statistics to file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+
+  fp.close();
+
+  VTR_LOGV(verbose,
+           "Reported the repack statistics of %lu clustered blocks to file: %s\n",
+           cluster_stats.size(),
+           fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,41 @@
+#ifndef REPACK_STATS_WRITER_H
+#define REPACK_STATS_WRITER_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+#include "vpr_context.h"
+#include "lb_router.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Statistics of repacking a clustered block
+ *******************************************************************/
+struct t_repack_cluster_stats {
+  ClusterBlockId block = ClusterBlockId::INVALID();
+  size_t num_nets = 0;
+  /* True if the routing results are reused from another clustered block */
+  bool route_cache_hit = false;
+  LbRouter::t_route_stats route_stats;
+  float wall_time_sec = 0.;
+};
+
+void print_repack_stats_summary(const ClusteringContext& clustering_ctx,
+                                const std::vector<t_repack_cluster_stats>& cluster_stats);
+
+int write_repack_stats_to_json_file(const ClusteringContext& clustering_ctx,
+                                    const std::vector<t_repack_cluster_stats>& cluster_stats,
+                                    const std::string& fname,
+                                    const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
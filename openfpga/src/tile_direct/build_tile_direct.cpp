@@ -3,6 +3,8 @@
  * between tiles (programmable blocks) 
  ***************************************************************************************/
 
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
@@ -22,12 +24,43 @@
 namespace openfpga {
 
 /***************************************************************************************
- * Parse the from tile name from the direct definition  
+ * A tile port of a direct definition, which is parsed once for each direct definition
+ *   - the name of the tile type, and the tile type of the device with this name
+ *     (nullptr if the device has no such tile type)
+ *   - the port, and the pin ids of the tile type that it includes,
+ *     before checking the sides where the pins are located
+ ***************************************************************************************/
+struct t_direct_tile_port {
+  std::string tile_name;
+  t_physical_tile_type_ptr tile_type = nullptr;
+  BasicPort port;
+  std::vector<size_t> pin_ids;
+};
+
+/***************************************************************************************
+ * Coordinates of the grids of each tile type in the device, so that the grids of a type
+ * are found without walking through the device grid
+ *   - coords: all the coordinates, in the order of x then y  [tile_type_index][...]
+ *   - column_ys: y of the grids in each column, in increasing order  [tile_type_index][x][...]
+ *   - row_xs: x of the grids in each row, in increasing order  [tile_type_index][y][...]
+ * The coordinates include the offsets of the tiles larger than one grid
+ ***************************************************************************************/
+struct t_tile_type_coordinates {
+  std::vector<std::vector<vtr::Point<size_t>>> coords;
+  std::vector<std::vector<std::vector<size_t>>> column_ys;
+  std::vector<std::vector<std::vector<size_t>>> row_xs;
+};
+
+/***************************************************************************************
+ * Parse a tile port from the direct definition  
  * The definition string should be in the following format:
  *   <tile_type_name>.<pin_name>[<pin_lsb>:<pin_msb>]  
  ***************************************************************************************/
 static 
-std::string parse_direct_tile_name(const std::string& direct_tile_inf) {
+t_direct_tile_port parse_direct_tile_port(const DeviceContext& device_ctx,
+                                          const std::string& direct_tile_inf) {
+  t_direct_tile_port direct_tile_port;
+
   StringToken tokenizer(direct_tile_inf);
   std::vector<std::string> tokens = tokenizer.split('.');
   /* We should have only 2 elements and the first is tile name */
@@ -36,25 +69,111 @@ std::string parse_direct_tile_name(const std::string& direct_tile_inf) {
                   direct_tile_inf.c_str());
   }
 
-  return tokens[0];
+  direct_tile_port.tile_name = tokens[0];
+  direct_tile_port.port = PortParser(tokens[1]).port();
+
+  for (const t_physical_tile_type& physical_tile : device_ctx.physical_tile_types) {
+    if (direct_tile_port.tile_name == std::string(physical_tile.name)) {
+      direct_tile_port.tile_type = &physical_tile;
+      break;
+    }
+  }
+  if (nullptr == direct_tile_port.tile_type) {
+    return direct_tile_port;
+  }
+
+  /* Walk through the port of the tile */
+  const BasicPort& tile_port = direct_tile_port.port;
+  for (const t_physical_tile_port& physical_tile_port : direct_tile_port.tile_type->ports) {
+    if (std::string(physical_tile_port.name) != tile_port.get_name()) {
+      continue;
+    }
+    /* If the wanted port is invalid, it assumes that we want the full port */
+    if (false == tile_port.is_valid()) {
+      for (int ipin = 0; ipin < physical_tile_port.num_pins; ++ipin) {
+        int pin_id = physical_tile_port.absolute_first_pin_index + ipin;
+        VTR_ASSERT(pin_id < direct_tile_port.tile_type->num_pins);
+        direct_tile_port.pin_ids.push_back(pin_id);
+      }
+      continue;
+    }
+    /* Find the LSB and MSB of the pin */
+    VTR_ASSERT_SAFE(true == tile_port.is_valid());
+    BasicPort ref_port(physical_tile_port.name, physical_tile_port.num_pins); 
+    if (false == ref_port.contained(tile_port)) {
+      VTR_LOG_ERROR("Defined direct port '%s[%lu:%lu]' is out of range for physical port '%s[%lu:%lu]'!\n",
+                    tile_port.get_name().c_str(),
+                    tile_port.get_lsb(), tile_port.get_msb(),
+                    ref_port.get_name().c_str(),
+                    ref_port.get_lsb(), ref_port.get_msb());
+      exit(1);
+    }
+    for (const size_t& ipin : tile_port.pins()) {
+      int pin_id = physical_tile_port.absolute_first_pin_index + ipin;
+      VTR_ASSERT(pin_id < direct_tile_port.tile_type->num_pins);
+      direct_tile_port.pin_ids.push_back(pin_id);
+    }
+  }
+
+  return direct_tile_port;
 }
 
 /***************************************************************************************
- * Parse the pin name and port MSB/LSB from the direct definition  
- * The definition string should be in the following format:
- *   <tile_type_name>.<pin_name>[<pin_lsb>:<pin_msb>]  
+ * Index the coordinates of the grids of each tile type in the device grid
  ***************************************************************************************/
 static 
-std::string parse_direct_port(const std::string& direct_tile_inf) {
-  StringToken tokenizer(direct_tile_inf);
-  std::vector<std::string> tokens = tokenizer.split('.');
-  /* We should have only 2 elements and the first is tile name */
-  if (2 != tokens.size()) {
-    VTR_LOG_ERROR("Invalid definition on direct tile '%s'!\n\tExpect <tile_type_name>.<pin_name>[<pin_lsb>:<pin_msb>].\n",
-                  direct_tile_inf.c_str());
+t_tile_type_coordinates build_tile_type_coordinates(const DeviceContext& device_ctx) {
+  t_tile_type_coordinates tile_type_coords;
+
+  size_t num_tile_types = device_ctx.physical_tile_types.size();
+  tile_type_coords.coords.resize(num_tile_types);
+  tile_type_coords.column_ys.resize(num_tile_types, std::vector<std::vector<size_t>>(device_ctx.grid.width()));
+  tile_type_coords.row_xs.resize(num_tile_types, std::vector<std::vector<size_t>>(device_ctx.grid.height()));
+
+  for (size_t x = 0; x < device_ctx.grid.width(); ++x) {
+    for (size_t y = 0; y < device_ctx.grid.height(); ++y) {
+      /* Bypass empty grid */
+      if (true == is_empty_type(device_ctx.grid[x][y].type)) {
+        continue;
+      }
+      size_t type_index = device_ctx.grid[x][y].type->index;
+      VTR_ASSERT(type_index < num_tile_types);
+      tile_type_coords.coords[type_index].push_back(vtr::Point<size_t>(x, y));
+      tile_type_coords.column_ys[type_index][x].push_back(y);
+      /* Rows are filled in the order of x, so they are sorted as well */
+      tile_type_coords.row_xs[type_index][y].push_back(x);
+    }
   }
 
-  return tokens[1];
+  return tile_type_coords;
+}
+
+/***************************************************************************************
+ * Find the first coordinate of a sorted list in the range [begin, end),
+ * starting from begin (increasing search) or from end - 1 (decreasing search)
+ * Return end if no coordinate is in the range
+ ***************************************************************************************/
+static 
+size_t find_first_coordinate_in_range(const std::vector<size_t>& sorted_coords,
+                                      const size_t& begin,
+                                      const size_t& end,
+                                      const bool& increasing) {
+  if (end <= begin) {
+    return end;
+  }
+  if (true == increasing) {
+    std::vector<size_t>::const_iterator it = std::lower_bound(sorted_coords.begin(), sorted_coords.end(), begin);
+    if ( (it != sorted_coords.end()) && (*it < end) ) {
+      return *it;
+    }
+    return end;
+  }
+  /* The last coordinate smaller than end */
+  std::vector<size_t>::const_iterator it = std::lower_bound(sorted_coords.begin(), sorted_coords.end(), end);
+  if ( (it != sorted_coords.begin()) && (*(it - 1) >= begin) ) {
+    return *(it - 1);
+  }
+  return end;
 }
 
 /***************************************************************************************
@@ -79,58 +198,23 @@ bool is_pin_locate_at_physical_tile_side(t_physical_tile_type_ptr physical_tile,
 }
 
 /***************************************************************************************
- * Find the pin ids of a physical tile based on the given port name, LSB and MSB 
+ * Find the pin ids of a direct tile port which are located 
+ * on a given side of a grid of the tile type
  ***************************************************************************************/
 static 
-std::vector<size_t> find_physical_tile_pin_id(t_physical_tile_type_ptr physical_tile, 
-                                              const size_t& pin_width_offset,
-                                              const size_t& pin_height_offset,
-                                              const BasicPort& tile_port,
+std::vector<size_t> find_physical_tile_pin_id(const t_grid_tile& grid, 
+                                              const t_direct_tile_port& direct_tile_port,
                                               const e_side& pin_side) {
-  std::vector<size_t> pin_ids;
+  VTR_ASSERT(grid.type == direct_tile_port.tile_type);
 
-  /* Walk through the port of the tile */
-  for (const t_physical_tile_port& physical_tile_port : physical_tile->ports) {
-    if (std::string(physical_tile_port.name) != tile_port.get_name()) {
-      continue;
-    }
-    /* If the wanted port is invalid, it assumes that we want the full port */
-    if (false == tile_port.is_valid()) {
-      for (int ipin = 0; ipin < physical_tile_port.num_pins; ++ipin) {
-        int pin_id = physical_tile_port.absolute_first_pin_index + ipin;
-        VTR_ASSERT(pin_id < physical_tile->num_pins);
-        /* Check if the pin is located on the wanted side */
-        if (true == is_pin_locate_at_physical_tile_side(physical_tile,
-                                                        pin_width_offset,
-                                                        pin_height_offset,
-                                                        pin_id, pin_side)) {
-          pin_ids.push_back(pin_id);
-        }
-      }
-      continue;
-    }
-    /* Find the LSB and MSB of the pin */
-    VTR_ASSERT_SAFE(true == tile_port.is_valid());
-    BasicPort ref_port(physical_tile_port.name, physical_tile_port.num_pins); 
-    if (false == ref_port.contained(tile_port)) {
-      VTR_LOG_ERROR("Defined direct port '%s[%lu:%lu]' is out of range for physical port '%s[%lu:%lu]'!\n",
-                    tile_port.get_name().c_str(),
-                    tile_port.get_lsb(), tile_port.get_msb(),
-                    ref_port.get_name().c_str(),
-                    ref_port.get_lsb(), ref_port.get_msb());
-      exit(1);
-    }
-    for (const size_t& ipin : tile_port.pins()) {
-      int pin_id = physical_tile_port.absolute_first_pin_index + ipin;
-      VTR_ASSERT(pin_id < physical_tile->num_pins);
-      /* Check if the pin is located on the wanted side */
-      if (true == is_pin_locate_at_physical_tile_side(physical_tile,
-                                                      pin_width_offset,
-                                                      pin_height_offset,
-                                                      pin_id, pin_side)) {
-
-        pin_ids.push_back(pin_id);
-      }
+  std::vector<size_t> pin_ids;
+  for (const size_t& pin_id : direct_tile_port.pin_ids) {
+    /* Check if the pin is located on the wanted side */
+    if (true == is_pin_locate_at_physical_tile_side(grid.type,
+                                                    grid.width_offset,
+                                                    grid.height_offset,
+                                                    pin_id, pin_side)) {
+      pin_ids.push_back(pin_id);
     }
   }
 
@@ -147,22 +231,45 @@ bool is_grid_coordinate_exist_in_device(const DeviceGrid& device_grid,
 }
 
 /********************************************************************
- * Find the coordinate of a grid in a specific column 
- * with a given type
- * This function will return the coordinate of the grid that satifies
- * the type requirement
+ * Find the coordinate of the first grid with a given type 
+ * in a specific column, among the core grids from y = 1 to y = ny,
+ * searching from y = 1 (increasing) or from y = ny
+ * This function will return an invalid coordinate if no grid
+ * satifies the type requirement
  *******************************************************************/
 static 
-vtr::Point<size_t> find_grid_coordinate_given_type(const DeviceGrid& grids,
-                                                   const std::vector<vtr::Point<size_t>>& candidate_coords, 
-                                                   const std::string& wanted_grid_type_name) {
-  for (vtr::Point<size_t> coord : candidate_coords) {
-    /* If the next column is not longer in device range, we can return */
-    if (false == is_grid_coordinate_exist_in_device(grids, coord)) {
-      continue;
+vtr::Point<size_t> find_column_grid_coordinate_given_type(const DeviceGrid& grids,
+                                                          const t_tile_type_coordinates& tile_type_coords,
+                                                          t_physical_tile_type_ptr wanted_grid_type,
+                                                          const size_t& x,
+                                                          const bool& increasing) {
+  if (nullptr != wanted_grid_type) {
+    size_t y = find_first_coordinate_in_range(tile_type_coords.column_ys[wanted_grid_type->index][x],
+                                              1, grids.height() - 1, increasing);
+    if (y < grids.height() - 1) {
+      return vtr::Point<size_t>(x, y);
     }
-    if (wanted_grid_type_name == std::string(grids[coord.x()][coord.y()].type->name)) {
-      return coord;
+  }
+  /* Return an valid coordinate */
+  return vtr::Point<size_t>(grids.width(), grids.height()); 
+}
+
+/********************************************************************
+ * Find the coordinate of the first grid with a given type 
+ * in a specific row, among the core grids from x = 1 to x = nx,
+ * searching from x = 1 (increasing) or from x = nx
+ *******************************************************************/
+static 
+vtr::Point<size_t> find_row_grid_coordinate_given_type(const DeviceGrid& grids,
+                                                       const t_tile_type_coordinates& tile_type_coords,
+                                                       t_physical_tile_type_ptr wanted_grid_type,
+                                                       const size_t& y,
+                                                       const bool& increasing) {
+  if (nullptr != wanted_grid_type) {
+    size_t x = find_first_coordinate_in_range(tile_type_coords.row_xs[wanted_grid_type->index][y],
+                                              1, grids.width() - 1, increasing);
+    if (x < grids.width() - 1) {
+      return vtr::Point<size_t>(x, y);
     }
   }
   /* Return an valid coordinate */
@@ -175,14 +282,18 @@ vtr::Point<size_t> find_grid_coordinate_given_type(const DeviceGrid& grids,
  *******************************************************************/
 static 
 vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& grids,
+                                                            const t_tile_type_coordinates& tile_type_coords,
                                                             const vtr::Point<size_t>& src_coord,
-                                                            const std::string des_tile_type_name,
+                                                            t_physical_tile_type_ptr des_tile_type,
                                                             const ArchDirect& arch_direct,
                                                             const ArchDirectId& arch_direct_id) {
   vtr::Point<size_t> des_coord(grids.width(), grids.height());
 
   std::vector<size_t> first_search_space;
-  std::vector<size_t> second_search_space;
+  /* The second search space covers all the core grids of a column/row,
+   * and is searched in increasing coordinates unless reversed 
+   */
+  bool second_search_increasing = true;
 
   /* Cross column connection from Bottom to Top on Right 
    * The next column may NOT have the grid type we want!
@@ -228,9 +339,6 @@ vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& gr
      *  | Grid | 1
      *  +------+
      */
-    for (size_t iy = 1 ; iy < grids.height() - 1; ++iy) {
-      second_search_space.push_back(iy);
-    }
 
     /* For negative direction, our second search space will be in y-direction:
      *
@@ -245,7 +353,7 @@ vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& gr
      *  +------+
      */
     if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
+      second_search_increasing = false;
     }
   }
 
@@ -300,9 +408,6 @@ vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& gr
      *  | Grid |<------| Grid |
      *  +------+       +------+
      */
-    for (size_t ix = 1 ; ix < grids.width() - 1; ++ix) {
-      second_search_space.push_back(ix);
-    }
 
     /* For negative direction,
      * our second search space will be in x-direction:
@@ -313,22 +418,19 @@ vtr::Point<size_t> find_inter_direct_destination_coordinate(const DeviceGrid& gr
      *  +------+       +------+
      */
     if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
+      second_search_increasing = false;
     }
   }
 
   for (size_t ix : first_search_space) {
-    std::vector<vtr::Point<size_t>> next_col_row_coords;
-    for (size_t iy : second_search_space) {
-      if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-        next_col_row_coords.push_back(vtr::Point<size_t>(ix, iy));
-      } else {
-        VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
-        /* For cross-row connection, our search space is flipped */
-        next_col_row_coords.push_back(vtr::Point<size_t>(iy, ix));
-      }
+    vtr::Point<size_t> des_coord_cand;
+    if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
+      des_coord_cand = find_column_grid_coordinate_given_type(grids, tile_type_coords, des_tile_type, ix, second_search_increasing);
+    } else {
+      VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
+      /* For cross-row connection, our search space is flipped */
+      des_coord_cand = find_row_grid_coordinate_given_type(grids, tile_type_coords, des_tile_type, ix, second_search_increasing);
     }
-    vtr::Point<size_t> des_coord_cand = find_grid_coordinate_given_type(grids, next_col_row_coords, des_tile_type_name); 
     /* For a valid coordinate, we can return */
     if (true == is_grid_coordinate_exist_in_device(grids, des_coord_cand)) {
       return des_coord_cand;
@@ -382,103 +484,95 @@ static
 void build_inner_column_row_tile_direct(TileDirect& tile_direct,
                                         const t_direct_inf& vpr_direct,
                                         const DeviceContext& device_ctx,
+                                        const t_tile_type_coordinates& tile_type_coords,
+                                        const t_direct_tile_port& from_direct_port,
+                                        const t_direct_tile_port& to_direct_port,
                                         const ArchDirectId& arch_direct_id,
                                         const bool& verbose) {
   /* Get the source tile and pin information */
-  std::string from_tile_name = parse_direct_tile_name(std::string(vpr_direct.from_pin));
-  PortParser from_tile_port_parser(parse_direct_port(std::string(vpr_direct.from_pin)));
-  const BasicPort& from_tile_port = from_tile_port_parser.port();
+  const std::string& from_tile_name = from_direct_port.tile_name;
+  const BasicPort& from_tile_port = from_direct_port.port;
 
   /* Get the sink tile and pin information */
-  std::string to_tile_name = parse_direct_tile_name(std::string(vpr_direct.to_pin));
-  PortParser to_tile_port_parser(parse_direct_port(std::string(vpr_direct.to_pin)));
-  const BasicPort& to_tile_port = to_tile_port_parser.port();
+  const std::string& to_tile_name = to_direct_port.tile_name;
+  const BasicPort& to_tile_port = to_direct_port.port;
 
-  /* Walk through the device fabric and find the grid that fit the source */
-  for (size_t x = 0; x < device_ctx.grid.width(); ++x) {
-    for (size_t y = 0; y < device_ctx.grid.height(); ++y) {
-      /* Bypass empty grid */
-      if (true == is_empty_type(device_ctx.grid[x][y].type)) {
+  /* Bypass the direct whose source tile is not in the device */
+  if (nullptr == from_direct_port.tile_type) {
+    return;
+  }
+
+  /* Walk through the grids of the device fabric that fit the source */
+  for (const vtr::Point<size_t>& from_coord : tile_type_coords.coords[from_direct_port.tile_type->index]) {
+    size_t x = from_coord.x();
+    size_t y = from_coord.y();
+    /* Search all the sides, the from pin may locate any side!
+     * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
+     * This should be reported to VPR!!!
+     */
+    for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
+    
+      /* Try to find the pin in this tile */
+      std::vector<size_t> from_pins = find_physical_tile_pin_id(device_ctx.grid[x][y],
+                                                                from_direct_port,
+                                                                from_side);
+      /* If nothing found, we can continue */
+      if (0 == from_pins.size()) {
+        continue;
+      }
+      
+      /* We should try to the sink grid for inner-column/row direct connections */
+      vtr::Point<size_t> from_grid_coord(x, y);
+      vtr::Point<size_t> to_grid_coord(x + vpr_direct.x_offset, y + vpr_direct.y_offset);
+      if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
         continue;
       }
 
-      /* Bypass the grid that does not fit the from_tile name */
-      if (from_tile_name != std::string(device_ctx.grid[x][y].type->name)) {
+      /* Bypass the grid that does not fit the to_tile name */
+      if (to_direct_port.tile_type != device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type) {
         continue;
       }
 
-      /* Search all the sides, the from pin may locate any side!
-       * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
+      /* Search all the sides, the to pin may locate any side!
+       * Note: the vpr_direct.to_side is NUM_SIDES, which is unintialized
        * This should be reported to VPR!!!
        */
-      for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-      
+      for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
+
         /* Try to find the pin in this tile */
-        std::vector<size_t> from_pins = find_physical_tile_pin_id(device_ctx.grid[x][y].type,
-                                                                  device_ctx.grid[x][y].width_offset,
-                                                                  device_ctx.grid[x][y].height_offset,
-                                                                  from_tile_port,
-                                                                  from_side);
+        std::vector<size_t> to_pins = find_physical_tile_pin_id(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()],
+                                                                to_direct_port,
+                                                                to_side);
         /* If nothing found, we can continue */
-        if (0 == from_pins.size()) {
-          continue;
-        }
-        
-        /* We should try to the sink grid for inner-column/row direct connections */
-        vtr::Point<size_t> from_grid_coord(x, y);
-        vtr::Point<size_t> to_grid_coord(x + vpr_direct.x_offset, y + vpr_direct.y_offset);
-        if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
+        if (0 == to_pins.size()) {
           continue;
         }
 
-        /* Bypass the grid that does not fit the from_tile name */
-        if (to_tile_name != std::string(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type->name)) {
-          continue;
+        /* If from port and to port do not match in sizes, error out */
+        if (from_pins.size() != to_pins.size()) {
+          report_direct_from_port_and_to_port_mismatch(vpr_direct, from_tile_port, to_tile_port);
+          exit(1);
         }
 
-        /* Search all the sides, the to pin may locate any side!
-         * Note: the vpr_direct.to_side is NUM_SIDES, which is unintialized
-         * This should be reported to VPR!!!
-         */
-        for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
-
-          /* Try to find the pin in this tile */
-          std::vector<size_t> to_pins = find_physical_tile_pin_id(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
-                                                                  device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
-                                                                  device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
-                                                                  to_tile_port,
-                                                                  to_side);
-          /* If nothing found, we can continue */
-          if (0 == to_pins.size()) {
-            continue;
-          }
-
-          /* If from port and to port do not match in sizes, error out */
-          if (from_pins.size() != to_pins.size()) {
-            report_direct_from_port_and_to_port_mismatch(vpr_direct, from_tile_port, to_tile_port);
-            exit(1);
-          }
-
-          /* Now add the tile direct */
-          for (size_t ipin = 0; ipin < from_pins.size(); ++ipin) {
-            VTR_LOGV(verbose,
-                     "Built a inner-column/row tile-to-tile direct from %s[%lu][%lu].%s[%lu] at side '%s' to %s[%lu][%lu].%s[%lu] at side '%s'\n",
-                     from_tile_name.c_str(), x, y,
-                     from_tile_port.get_name().c_str(), from_pins[ipin],
-                     SIDE_STRING[from_side],
-                     to_tile_name.c_str(),
-                     to_grid_coord.x(), to_grid_coord.y(),
-                     to_tile_port.get_name().c_str(), to_pins[ipin],
-                     SIDE_STRING[to_side]
-                     );
-            TileDirectId tile_direct_id = tile_direct.add_direct(from_grid_coord,
-                                                                 from_side,
-                                                                 from_pins[ipin],
-                                                                 to_grid_coord,
-                                                                 to_side,
-                                                                 to_pins[ipin]);
-            tile_direct.set_arch_direct_id(tile_direct_id, arch_direct_id);
-          }
+        /* Now add the tile direct */
+        for (size_t ipin = 0; ipin < from_pins.size(); ++ipin) {
+          VTR_LOGV(verbose,
+                   "Built a inner-column/row tile-to-tile direct from %s[%lu][%lu].%s[%lu] at side '%s' to %s[%lu][%lu].%s[%lu] at side '%s'\n",
+                   from_tile_name.c_str(), x, y,
+                   from_tile_port.get_name().c_str(), from_pins[ipin],
+                   SIDE_STRING[from_side],
+                   to_tile_name.c_str(),
+                   to_grid_coord.x(), to_grid_coord.y(),
+                   to_tile_port.get_name().c_str(), to_pins[ipin],
+                   SIDE_STRING[to_side]
+                   );
+          TileDirectId tile_direct_id = tile_direct.add_direct(from_grid_coord,
+                                                               from_side,
+                                                               from_pins[ipin],
+                                                               to_grid_coord,
+                                                               to_side,
+                                                               to_pins[ipin]);
+          tile_direct.set_arch_direct_id(tile_direct_id, arch_direct_id);
         }
       }
     }
@@ -522,19 +616,20 @@ static
 void build_inter_column_row_tile_direct(TileDirect& tile_direct,
                                         const t_direct_inf& vpr_direct,
                                         const DeviceContext& device_ctx,
+                                        const t_tile_type_coordinates& tile_type_coords,
+                                        const t_direct_tile_port& from_direct_port,
+                                        const t_direct_tile_port& to_direct_port,
                                         const ArchDirect& arch_direct,
                                         const ArchDirectId& arch_direct_id,
                                         const bool& verbose) {
 
   /* Get the source tile and pin information */
-  std::string from_tile_name = parse_direct_tile_name(std::string(vpr_direct.from_pin));
-  PortParser from_tile_port_parser(parse_direct_port(std::string(vpr_direct.from_pin)));
-  const BasicPort& from_tile_port = from_tile_port_parser.port();
+  const std::string& from_tile_name = from_direct_port.tile_name;
+  const BasicPort& from_tile_port = from_direct_port.port;
 
   /* Get the sink tile and pin information */
-  std::string to_tile_name = parse_direct_tile_name(std::string(vpr_direct.to_pin));
-  PortParser to_tile_port_parser(parse_direct_port(std::string(vpr_direct.to_pin)));
-  const BasicPort& to_tile_port = to_tile_port_parser.port();
+  const std::string& to_tile_name = to_direct_port.tile_name;
+  const BasicPort& to_tile_port = to_direct_port.port;
 
   /* Go through the direct connection list, see if we need intra-column/row connection here */
   if ( (INTER_COLUMN != arch_direct.type(arch_direct_id))
@@ -558,18 +653,13 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
    */
   if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
     for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-      /* For negative y- direction, we should start from y = ny */
-      for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-        next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-      }
-      /* For positive y- direction, we should start from y = 1 */
-      if (NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-        std::reverse(next_col_src_grid_coords.begin(), next_col_src_grid_coords.end());
-      }
+      /* For negative y- direction, we should start from y = ny
+       * For positive y- direction, we should start from y = 1
+       */
+      bool increasing = (NEGATIVE_DIR != arch_direct.y_dir(arch_direct_id));
 
       /* Bypass the grid that does not fit the from_tile name */
-      vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(device_ctx.grid, next_col_src_grid_coords, from_tile_name); 
+      vtr::Point<size_t> from_grid_coord = find_column_grid_coordinate_given_type(device_ctx.grid, tile_type_coords, from_direct_port.tile_type, ix, increasing); 
       /* Skip if we do not have a valid coordinate for source CLB/heterogeneous block */
       if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
         continue;
@@ -582,10 +672,8 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
       for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
       
         /* Try to find the pin in this tile */
-        std::vector<size_t> from_pins = find_physical_tile_pin_id(device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].type,
-                                                                 device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].width_offset,
-                                                                 device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].height_offset,
-                                                                 from_tile_port,
+        std::vector<size_t> from_pins = find_physical_tile_pin_id(device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()],
+                                                                 from_direct_port,
                                                                  from_side);
         /* If nothing found, we can continue */
         if (0 == from_pins.size()) {
@@ -593,7 +681,7 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
         }
 
         /* For a valid coordinate, we can find the coordinate of the destination clb */
-         vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
+         vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, tile_type_coords, from_grid_coord, to_direct_port.tile_type, arch_direct, arch_direct_id);
          /* If destination clb is valid, we should add something */
         if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
            continue;
@@ -606,10 +694,8 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
         for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
 
           /* Try to find the pin in this tile */
-          std::vector<size_t> to_pins = find_physical_tile_pin_id(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
-                                                                  device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
-                                                                  device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
-                                                                  to_tile_port,
+          std::vector<size_t> to_pins = find_physical_tile_pin_id(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()],
+                                                                  to_direct_port,
                                                                   to_side);
           /* If nothing found, we can continue */
           if (0 == to_pins.size()) {
@@ -662,17 +748,12 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
    * 
    */
   for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-    std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-    /* For negative x- direction, we should start from x = nx */
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-    }
-    /* For positive x- direction, we should start from x = 1 */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(next_col_src_grid_coords.begin(), next_col_src_grid_coords.end());
-    }
+    /* For negative x- direction, we should start from x = 1
+     * For positive x- direction, we should start from x = nx
+     */
+    bool increasing = (POSITIVE_DIR != arch_direct.x_dir(arch_direct_id));
 
-    vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(device_ctx.grid, next_col_src_grid_coords, from_tile_name); 
+    vtr::Point<size_t> from_grid_coord = find_row_grid_coordinate_given_type(device_ctx.grid, tile_type_coords, from_direct_port.tile_type, iy, increasing); 
     /* Skip if we do not have a valid coordinate for source CLB/heterogeneous block */
     if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
       continue;
@@ -685,10 +766,8 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
     for (const e_side& from_side : {TOP, RIGHT, BOTTOM, LEFT}) {
       
       /* Try to find the pin in this tile */
-      std::vector<size_t> from_pins = find_physical_tile_pin_id(device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].type,
-                                                                device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].width_offset,
-                                                                device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()].height_offset,
-                                                                from_tile_port,
+      std::vector<size_t> from_pins = find_physical_tile_pin_id(device_ctx.grid[from_grid_coord.x()][from_grid_coord.y()],
+                                                                from_direct_port,
                                                                 from_side);
       /* If nothing found, we can continue */
       if (0 == from_pins.size()) {
@@ -696,7 +775,7 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
       }
 
       /* For a valid coordinate, we can find the coordinate of the destination clb */
-      vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, from_grid_coord, to_tile_name, arch_direct, arch_direct_id);
+      vtr::Point<size_t> to_grid_coord = find_inter_direct_destination_coordinate(device_ctx.grid, tile_type_coords, from_grid_coord, to_direct_port.tile_type, arch_direct, arch_direct_id);
       /* If destination clb is valid, we should add something */
       if (false == is_grid_coordinate_exist_in_device(device_ctx.grid, to_grid_coord)) {
         continue;
@@ -709,10 +788,8 @@ void build_inter_column_row_tile_direct(TileDirect& tile_direct,
       for (const e_side& to_side : {TOP, RIGHT, BOTTOM, LEFT}) {
 
         /* Try to find the pin in this tile */
-        std::vector<size_t> to_pins = find_physical_tile_pin_id(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].type,
-                                                                device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].width_offset,
-                                                                device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()].height_offset,
-                                                                to_tile_port,
+        std::vector<size_t> to_pins = find_physical_tile_pin_id(device_ctx.grid[to_grid_coord.x()][to_grid_coord.y()],
+                                                                to_direct_port,
                                                                 to_side);
         /* If nothing found, we can continue */
         if (0 == to_pins.size()) {
@@ -763,6 +840,9 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
 
   TileDirect tile_direct;
 
+  /* Index the grids of each tile type, so that the directs do not walk through the device grid */
+  t_tile_type_coordinates tile_type_coords = build_tile_type_coordinates(device_ctx);
+
   /* Walk through each direct definition in the VPR arch */
   for (int idirect = 0; idirect < device_ctx.arch->num_directs; ++idirect) {
     ArchDirectId arch_direct_id = arch_direct.direct(std::string(device_ctx.arch->Directs[idirect].name));
@@ -771,16 +851,26 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
                     device_ctx.arch->Directs[idirect].name);
       exit(1);
     }
+    /* Parse the source and sink tile ports once for both kinds of directs */
+    t_direct_tile_port from_direct_port = parse_direct_tile_port(device_ctx, std::string(device_ctx.arch->Directs[idirect].from_pin));
+    t_direct_tile_port to_direct_port = parse_direct_tile_port(device_ctx, std::string(device_ctx.arch->Directs[idirect].to_pin));
+
     /* Build from original VPR arch definition */
     build_inner_column_row_tile_direct(tile_direct,
                                        device_ctx.arch->Directs[idirect],
                                        device_ctx,
+                                       tile_type_coords,
+                                       from_direct_port,
+                                       to_direct_port,
                                        arch_direct_id,
                                        verbose);
     /* Build from OpenFPGA arch definition */ 
     build_inter_column_row_tile_direct(tile_direct,
                                        device_ctx.arch->Directs[idirect],
                                        device_ctx,
+                                       tile_type_coords,
+                                       from_direct_port,
+                                       to_direct_port,
                                        arch_direct,
                                        arch_direct_id,
                                        verbose);
@@ -6,6 +6,8 @@
  ***********************************************************************/
 
 #include <algorithm>
+#include <map>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -33,6 +35,44 @@ size_t find_fabric_regional_bitstream_max_size(const FabricBitstream& fabric_bit
   return regional_bitstream_max_size;
 }
 
+/********************************************************************
+ * Count the number of leading fabric bits in a list whose values are the given one.
+ * The fabric bits of a leaf block are consecutive, whose configuration bits are also
+ * consecutive in the bitstream manager (see build_fabric_bitstream.cpp).
+ * Therefore, the values can be compared word by word for each leaf block,
+ * instead of bit by bit.
+ * The mapping is checked on every bit of a run, as checking only the ends
+ * can not detect a run whose bits are reordered. A run stops at the first
+ * fabric bit which does not map to the next configuration bit
+ *******************************************************************/
+size_t find_fabric_bitstream_leading_bits_with_value(const FabricBitstream& fabric_bitstream,
+                                                     const BitstreamManager& bitstream_manager,
+                                                     const std::vector<FabricBitId>& fabric_bits,
+                                                     const bool& value) {
+  size_t ibit = 0;
+  while (ibit < fabric_bits.size()) {
+    ConfigBitId config_bit = fabric_bitstream.config_bit(fabric_bits[ibit]);
+    ConfigBlockId block = bitstream_manager.bit_parent_block(config_bit);
+    size_t max_num_run_bits = size_t(bitstream_manager.block_first_bit(block)) + bitstream_manager.block_num_bits(block) - size_t(config_bit);
+    max_num_run_bits = std::min(max_num_run_bits, fabric_bits.size() - ibit);
+
+    /* Only the fabric bits which follow the configuration bits are compared in packed words */
+    size_t num_run_bits = 1;
+    while ( (num_run_bits < max_num_run_bits)
+         && (size_t(fabric_bitstream.config_bit(fabric_bits[ibit + num_run_bits])) == size_t(config_bit) + num_run_bits) ) {
+      num_run_bits++;
+    }
+
+    size_t num_equal_bits = bitstream_manager.num_leading_bits_with_value(config_bit, num_run_bits, value);
+    ibit += num_equal_bits;
+    if (num_equal_bits < num_run_bits) {
+      break;
+    }
+  }
+
+  return ibit;
+}
+
 /********************************************************************
  * For fast configuration, the number of bits to be skipped
  * depends on each regional bitstream
@@ -50,13 +90,9 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(const Fabric
 
   size_t num_bits_to_skip = size_t(-1);
   for (const auto& region : fabric_bitstream.regions()) {
-    size_t curr_region_num_bits_to_skip = 0;
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      if (bit_value_to_skip != bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id))) {
-        break;
-      }
-      curr_region_num_bits_to_skip++;
-    }
+    size_t curr_region_num_bits_to_skip = find_fabric_bitstream_leading_bits_with_value(fabric_bitstream, bitstream_manager,
+                                                                                        fabric_bitstream.region_bits(region),
+                                                                                        bit_value_to_skip);
     /* For regional bitstream which is short than the longest region bitstream,
      * The number of bits to skip 
      */
@@ -104,6 +140,354 @@ ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(const B
   return regional_bitstreams;
 }
 
+/********************************************************************
+ * A grouping engine for fabric bits which share the same address
+ * across configuration regions.
+ * Addresses are decoded to integer keys, where the first character
+ * of an address string is the most significant bit of a key, 
+ * so that the ascending order of keys is the same as 
+ * the lexicographical order of address strings.
+ * A key wider than 64 bits spans several words, 
+ * where the first word is the most significant one.
+ *
+ * When the key space is small enough compared to the number of bits,
+ * a flat lookup table is used, whose iteration naturally follows 
+ * the ascending order of keys. 
+ * Otherwise, a hash table is used and groups are sorted on request.
+ * Keys of several words are placed in an ordered map.
+ *******************************************************************/
+/* Maximum ratio between the key space and the number of bits to use a flat lookup table */
+constexpr size_t FABRIC_BIT_GROUP_FLAT_TABLE_RATIO = 4;
+
+class FabricBitAddressGroups {
+  public: /* Public constructor */
+    FabricBitAddressGroups(const size_t& key_width,
+                           const size_t& num_bits,
+                           const size_t& num_regions) {
+      key_width_ = key_width;
+      num_key_words_ = std::max(size_t(1), (key_width + 63) / 64);
+      num_regions_ = num_regions;
+      num_din_words_ = (num_regions + 63) / 64;
+      /* The flat lookup table is only affordable for keys of a single word */
+      use_flat_table_ = (key_width < 64)
+                     && ((uint64_t(1) << key_width) <= FABRIC_BIT_GROUP_FLAT_TABLE_RATIO * num_bits + 1); 
+      if (true == use_flat_table_) {
+        flat_table_.resize(uint64_t(1) << key_width, size_t(-1));
+      } else if (1 == num_key_words_) {
+        hash_table_.reserve(num_bits);
+      }
+      group_key_words_.reserve(num_bits * num_key_words_);
+      group_din_words_.reserve(num_bits * num_din_words_);
+    }
+
+  public: /* Public accessors */
+    size_t key_width() const {
+      return key_width_;
+    }
+
+    size_t num_key_words() const {
+      return num_key_words_;
+    }
+
+    size_t num_groups() const {
+      return group_key_words_.size() / num_key_words_;
+    }
+
+    /* The words of the key of a group, the most significant word first */
+    const uint64_t* group_key_words(const size_t& group) const {
+      return &group_key_words_[group * num_key_words_];
+    }
+
+    /* Unpack the data inputs of a group, where the i-th element is the din of the i-th region */
+    std::vector<bool> group_dins(const size_t& group) const {
+      std::vector<bool> dins(num_regions_, false);
+      const uint64_t* din_words = &group_din_words_[group * num_din_words_];
+      for (size_t region = 0; region < num_regions_; ++region) {
+        dins[region] = (0 != ((din_words[region / 64] >> (region % 64)) & 1));
+      }
+      return dins;
+    }
+
+    /* Check if the data inputs of all the regions are the given value,
+     * by comparing the packed words directly 
+     */
+    bool group_dins_all_equal(const size_t& group, const bool& value) const {
+      const uint64_t* din_words = &group_din_words_[group * num_din_words_];
+      for (size_t iword = 0; iword < num_din_words_; ++iword) {
+        uint64_t valid_mask = ~uint64_t(0);
+        if ((iword == num_din_words_ - 1) && (0 != num_regions_ % 64)) {
+          valid_mask = (uint64_t(1) << (num_regions_ % 64)) - 1;
+        }
+        uint64_t expected_word = (true == value) ? valid_mask : uint64_t(0);
+        if (expected_word != (din_words[iword] & valid_mask)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /* Find all the groups in the ascending order of keys if required */
+    std::vector<size_t> groups(const bool& sort_by_key) const {
+      std::vector<size_t> ordered_groups;
+      ordered_groups.reserve(num_groups());
+      if ((true == sort_by_key) && (true == use_flat_table_)) {
+        for (const size_t& group : flat_table_) {
+          if (size_t(-1) != group) {
+            ordered_groups.push_back(group);
+          }
+        }
+        return ordered_groups;
+      }
+      if ((true == sort_by_key) && (1 < num_key_words_)) {
+        for (const auto& wide_group : wide_table_) {
+          ordered_groups.push_back(wide_group.second);
+        }
+        return ordered_groups;
+      }
+      for (size_t group = 0; group < num_groups(); ++group) {
+        ordered_groups.push_back(group);
+      }
+      if (true == sort_by_key) {
+        std::sort(ordered_groups.begin(), ordered_groups.end(),
+                  [&](const size_t& lhs, const size_t& rhs) {
+                    return group_key_words_[lhs] < group_key_words_[rhs];
+                  });
+      }
+      return ordered_groups;
+    }
+
+  public: /* Public mutators */
+    /* Place a data input to the group of a given key, create the group if not exist */
+    void add_din(const uint64_t* key_words, const size_t& region, const bool& din) {
+      size_t group = size_t(-1);
+      if (true == use_flat_table_) {
+        group = flat_table_[key_words[0]];
+        if (size_t(-1) == group) {
+          group = create_group(key_words);
+          flat_table_[key_words[0]] = group;
+        }
+      } else if (1 == num_key_words_) {
+        auto result = hash_table_.find(key_words[0]);
+        if (result == hash_table_.end()) {
+          group = create_group(key_words);
+          hash_table_[key_words[0]] = group;
+        } else {
+          group = result->second;
+        }
+      } else {
+        std::vector<uint64_t> wide_key(key_words, key_words + num_key_words_);
+        auto result = wide_table_.find(wide_key);
+        if (result == wide_table_.end()) {
+          group = create_group(key_words);
+          wide_table_[wide_key] = group;
+        } else {
+          group = result->second;
+        }
+      }
+      uint64_t& din_word = group_din_words_[group * num_din_words_ + region / 64];
+      uint64_t din_mask = uint64_t(1) << (region % 64);
+      if (true == din) {
+        din_word |= din_mask;
+      } else {
+        din_word &= ~din_mask;
+      }
+    }
+
+    /* Place a data input to all the keys covered by don't care bits */
+    void add_din_with_dont_care(const uint64_t* key_words, const uint64_t* dont_care_words,
+                                const size_t& region, const bool& din) {
+      if (1 == num_key_words_) {
+        /* Walk through all the subsets of the don't care mask */
+        uint64_t sub_mask = dont_care_words[0];
+        while (true) {
+          uint64_t sub_key = key_words[0] | sub_mask;
+          add_din(&sub_key, region, din);
+          if (0 == sub_mask) {
+            break;
+          }
+          sub_mask = (sub_mask - 1) & dont_care_words[0];
+        }
+        return;
+      }
+
+      /* Find the don't care bits, the least significant first,
+       * and walk through their combinations in the same order as a single word
+       */
+      std::vector<std::pair<size_t, uint64_t>> dont_care_bits;
+      for (size_t iword = num_key_words_; iword > 0; --iword) {
+        for (size_t ibit = 0; ibit < 64; ++ibit) {
+          if (0 != ((dont_care_words[iword - 1] >> ibit) & 1)) {
+            dont_care_bits.push_back(std::make_pair(iword - 1, uint64_t(1) << ibit));
+          }
+        }
+      }
+      VTR_ASSERT(dont_care_bits.size() < 64);
+
+      std::vector<uint64_t> sub_key(num_key_words_);
+      uint64_t combination = (uint64_t(1) << dont_care_bits.size()) - 1;
+      while (true) {
+        std::copy(key_words, key_words + num_key_words_, sub_key.begin());
+        for (size_t idc = 0; idc < dont_care_bits.size(); ++idc) {
+          if (0 != ((combination >> idc) & 1)) {
+            sub_key[dont_care_bits[idc].first] |= dont_care_bits[idc].second;
+          }
+        }
+        add_din(sub_key.data(), region, din);
+        if (0 == combination) {
+          break;
+        }
+        combination--;
+      }
+    }
+
+  private: /* Private mutators */
+    size_t create_group(const uint64_t* key_words) {
+      /* This is a new bit, allocate the words for all the regions
+       * and deposit '0' to all the bits
+       */
+      group_key_words_.insert(group_key_words_.end(), key_words, key_words + num_key_words_);
+      group_din_words_.resize(group_din_words_.size() + num_din_words_, 0);
+      return num_groups() - 1;
+    }
+
+  private: /* Internal data */
+    size_t key_width_;
+    /* Number of words to store the key of a group */
+    size_t num_key_words_;
+    size_t num_regions_;
+    /* Number of words to store the data inputs of a group */
+    size_t num_din_words_;
+    bool use_flat_table_;
+    std::vector<size_t> flat_table_;
+    std::unordered_map<uint64_t, size_t> hash_table_;
+    std::map<std::vector<uint64_t>, size_t> wide_table_;
+    /* Keys of all the groups, packed by num_key_words_ per group */
+    std::vector<uint64_t> group_key_words_;
+    /* Data inputs of all the groups, packed by 64 regions per word */
+    std::vector<uint64_t> group_din_words_;
+};
+
+/********************************************************************
+ * Decode a packed address slot (see FabricBitstream) into the bits
+ * [key_offset, key_offset + addr_length) of a key, counted from its most 
+ * significant bit, as well as into a mask of don't care bits,
+ * following the bit order required by FabricBitAddressGroups
+ *******************************************************************/
+static 
+void decode_fabric_bit_address_key(const uint64_t* addr_words,
+                                   const size_t& addr_length,
+                                   const size_t& key_width,
+                                   const size_t& key_offset,
+                                   uint64_t* key_words,
+                                   uint64_t* dont_care_words) {
+  /* An address slot has the value words followed by the same number of mask words */
+  size_t addr_num_words = (addr_length + 63) / 64;
+  size_t num_key_words = std::max(size_t(1), (key_width + 63) / 64);
+  for (size_t i = 0; i < addr_length; ++i) {
+    size_t key_pos = key_width - 1 - (key_offset + i);
+    size_t key_word = num_key_words - 1 - key_pos / 64;
+    key_words[key_word] |= ((addr_words[i / 64] >> (i % 64)) & 1) << (key_pos % 64);
+    dont_care_words[key_word] |= ((addr_words[addr_num_words + i / 64] >> (i % 64)) & 1) << (key_pos % 64);
+  }
+}
+
+/********************************************************************
+ * Encode the bits [key_offset, key_offset + addr_length) of a key
+ * (of an address group), counted from its most significant bit,
+ * to an address string 
+ *******************************************************************/
+static 
+std::string encode_fabric_bit_address_key(const uint64_t* key_words,
+                                          const size_t& key_width,
+                                          const size_t& key_offset,
+                                          const size_t& addr_length) {
+  size_t num_key_words = std::max(size_t(1), (key_width + 63) / 64);
+  std::string addr_str(addr_length, '0');
+  for (size_t i = 0; i < addr_length; ++i) {
+    size_t key_pos = key_width - 1 - (key_offset + i);
+    if (1 == ((key_words[num_key_words - 1 - key_pos / 64] >> (key_pos % 64)) & 1)) {
+      addr_str[i] = '1';
+    }
+  }
+  return addr_str;
+}
+
+/********************************************************************
+ * Group the fabric bits for frame-based protocol by addresses,
+ * where don't care bits in addresses are expanded
+ *******************************************************************/
+static 
+FabricBitAddressGroups build_frame_based_fabric_bit_address_groups(const FabricBitstream& fabric_bitstream) {
+  size_t addr_length = fabric_bitstream.address_length();
+  FabricBitAddressGroups addr_groups(addr_length, fabric_bitstream.num_bits(), fabric_bitstream.num_regions());
+
+  std::vector<uint64_t> key_words(addr_groups.num_key_words());
+  std::vector<uint64_t> dont_care_words(addr_groups.num_key_words());
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+      std::fill(key_words.begin(), key_words.end(), 0);
+      std::fill(dont_care_words.begin(), dont_care_words.end(), 0);
+      decode_fabric_bit_address_key(fabric_bitstream.bit_address_words(bit_id), addr_length,
+                                    addr_length, 0,
+                                    key_words.data(), dont_care_words.data());
+      /* Expand all the don't care bits and place the config bit */
+      addr_groups.add_din_with_dont_care(key_words.data(), dont_care_words.data(), size_t(region), fabric_bitstream.bit_din(bit_id));
+    }
+  }
+
+  return addr_groups;
+}
+
+/********************************************************************
+ * Group the fabric bits for memory bank protocol by the concatenation
+ * of BL and WL addresses
+ *******************************************************************/
+static 
+FabricBitAddressGroups build_memory_bank_fabric_bit_address_groups(const FabricBitstream& fabric_bitstream) {
+  size_t bl_addr_length = fabric_bitstream.address_length();
+  size_t wl_addr_length = fabric_bitstream.wl_address_length();
+  size_t key_width = bl_addr_length + wl_addr_length;
+  FabricBitAddressGroups addr_groups(key_width, fabric_bitstream.num_bits(), fabric_bitstream.num_regions());
+
+  std::vector<uint64_t> key_words(addr_groups.num_key_words());
+  std::vector<uint64_t> dont_care_words(addr_groups.num_key_words());
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+      std::fill(key_words.begin(), key_words.end(), 0);
+      std::fill(dont_care_words.begin(), dont_care_words.end(), 0);
+      decode_fabric_bit_address_key(fabric_bitstream.bit_address_words(bit_id), bl_addr_length,
+                                    key_width, 0,
+                                    key_words.data(), dont_care_words.data());
+      decode_fabric_bit_address_key(fabric_bitstream.bit_wl_address_words(bit_id), wl_addr_length,
+                                    key_width, bl_addr_length,
+                                    key_words.data(), dont_care_words.data());
+      /* Memory bank addresses do not have any don't care bits */
+      VTR_ASSERT_SAFE(dont_care_words.size() == size_t(std::count(dont_care_words.begin(), dont_care_words.end(), 0)));
+
+      /* Place the config bit */
+      addr_groups.add_din(key_words.data(), size_t(region), fabric_bitstream.bit_din(bit_id));
+    }
+  }
+
+  return addr_groups;
+}
+
+/********************************************************************
+ * Count the number of address groups which cannot be skipped 
+ * by fast configuration, i.e., whose data inputs are not all the value to skip
+ *******************************************************************/
+static 
+size_t find_fabric_bit_address_groups_size_not_to_skip(const FabricBitAddressGroups& addr_groups,
+                                                       const bool& bit_value_to_skip) {
+  size_t num_groups = 0;
+  for (size_t group = 0; group < addr_groups.num_groups(); ++group) {
+    if (false == addr_groups.group_dins_all_equal(group, bit_value_to_skip)) {
+      num_groups++;
+    }
+  }
+  return num_groups;
+}
+
 /********************************************************************
  * Reorganize the fabric bitstream for frame-based protocol
  * by the same address across regions:
@@ -113,39 +497,35 @@ ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(const B
  * An example:
  *   000000 1011
  *
- * Note: the std::map may cause large memory footprint for large bitstream databases!
+ * Bits are grouped by integer keys decoded from addresses (see FabricBitAddressGroups).
+ * When sorting is required, the groups follow the lexicographical order of address strings.
  *******************************************************************/
-FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream) {
-  FrameFabricBitstream fabric_bits_by_addr;
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      /* Create string for address */
-      std::string addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-        addr_str.push_back(addr_bit);
-      }
+FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                   const bool& sort_by_address) {
+  size_t addr_length = fabric_bitstream.address_length();
+  FabricBitAddressGroups addr_groups = build_frame_based_fabric_bit_address_groups(fabric_bitstream);
 
-      /* Expand all the don't care bits */
-      for (const std::string& curr_addr_str : expand_dont_care_bin_str(addr_str)) {
-        /* Place the config bit */
-        auto result = fabric_bits_by_addr.find(curr_addr_str);
-        if (result == fabric_bits_by_addr.end()) {
-          /* This is a new bit, resize the vector to the number of regions
-           * and deposit '0' to all the bits
-           */
-          fabric_bits_by_addr[curr_addr_str] = std::vector<bool>(fabric_bitstream.regions().size(), false);
-          fabric_bits_by_addr[curr_addr_str][size_t(region)] = fabric_bitstream.bit_din(bit_id);
-        } else {
-          VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-          result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-        }
-      }
-    }
+  FrameFabricBitstream fabric_bits_by_addr;
+  fabric_bits_by_addr.reserve(addr_groups.num_groups());
+  for (const size_t& group : addr_groups.groups(sort_by_address)) {
+    fabric_bits_by_addr.emplace_back(encode_fabric_bit_address_key(addr_groups.group_key_words(group),
+                                                                   addr_groups.key_width(), 0, addr_length),
+                                     addr_groups.group_dins(group));
   }
   
   return fabric_bits_by_addr;
 }
 
+/********************************************************************
+ * Find the number of unique addresses for frame-based protocol,
+ * which is the size of the bitstream reorganized by 
+ * build_frame_based_fabric_bitstream_by_address(),
+ * without creating any address string
+ *******************************************************************/
+size_t find_frame_based_fabric_bitstream_size(const FabricBitstream& fabric_bitstream) {
+  return build_frame_based_fabric_bit_address_groups(fabric_bitstream).num_groups();
+}
+
 /********************************************************************
  * For fast configuration, the number of bits to be skipped
  * the rule to skip any configuration bit should consider the whole data input values.
@@ -163,28 +543,14 @@ FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricB
  *     Region 1: 0 
  *     Region 2: 0 
  *   This bit can be skipped if the bit_value_to_skip is 0
+ *
+ * The data inputs are compared in packed words, 
+ * without creating any address string
  *******************************************************************/
 size_t find_frame_based_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
                                                                  const bool& bit_value_to_skip) {
-  FrameFabricBitstream fabric_bits_by_addr = build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
-
-  size_t num_bits = 0;
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
-    bool skip_curr_bits = true;
-    for (const bool& bit : addr_din_pair.second) {
-      if (bit_value_to_skip != bit) {
-        skip_curr_bits = false;
-        break;
-      }
-    }
-
-    if (false == skip_curr_bits) {
-      num_bits++;
-    }
-  }
-
-  return num_bits;
+  return find_fabric_bit_address_groups_size_not_to_skip(build_frame_based_fabric_bit_address_groups(fabric_bitstream),
+                                                         bit_value_to_skip);
 }
 
 /********************************************************************
@@ -196,42 +562,39 @@ size_t find_frame_based_fast_configuration_fabric_bitstream_size(const FabricBit
  * An example:
  *   000000  00000 1011
  *
- * Note: the std::map may cause large memory footprint for large bitstream databases!
+ * Bits are grouped by integer keys decoded from the concatenation 
+ * of BL and WL addresses (see FabricBitAddressGroups).
+ * When sorting is required, the groups follow the lexicographical order 
+ * of BL address strings and then WL address strings.
  *******************************************************************/
-MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream) {
-  MemoryBankFabricBitstream fabric_bits_by_addr;
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      /* Create string for BL address */
-      std::string bl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-        bl_addr_str.push_back(addr_bit);
-      }
+MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                        const bool& sort_by_address) {
+  size_t bl_addr_length = fabric_bitstream.address_length();
+  size_t wl_addr_length = fabric_bitstream.wl_address_length();
+  FabricBitAddressGroups addr_groups = build_memory_bank_fabric_bit_address_groups(fabric_bitstream);
 
-      /* Create string for WL address */
-      std::string wl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-        wl_addr_str.push_back(addr_bit);
-      }
-
-      /* Place the config bit */
-      auto result = fabric_bits_by_addr.find(std::make_pair(bl_addr_str, wl_addr_str));
-      if (result == fabric_bits_by_addr.end()) {
-        /* This is a new bit, resize the vector to the number of regions
-         * and deposit '0' to all the bits
-         */
-        fabric_bits_by_addr[std::make_pair(bl_addr_str, wl_addr_str)] = std::vector<bool>(fabric_bitstream.regions().size(), false);
-        fabric_bits_by_addr[std::make_pair(bl_addr_str, wl_addr_str)][size_t(region)] = fabric_bitstream.bit_din(bit_id);
-      } else {
-        VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-        result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-      }
-    }
+  MemoryBankFabricBitstream fabric_bits_by_addr;
+  fabric_bits_by_addr.reserve(addr_groups.num_groups());
+  for (const size_t& group : addr_groups.groups(sort_by_address)) {
+    const uint64_t* key_words = addr_groups.group_key_words(group);
+    fabric_bits_by_addr.emplace_back(std::make_pair(encode_fabric_bit_address_key(key_words, addr_groups.key_width(), 0, bl_addr_length),
+                                                    encode_fabric_bit_address_key(key_words, addr_groups.key_width(), bl_addr_length, wl_addr_length)),
+                                     addr_groups.group_dins(group));
   }
 
   return fabric_bits_by_addr;
 }
 
+/********************************************************************
+ * Find the number of unique pairs of BL and WL addresses for memory banks,
+ * which is the size of the bitstream reorganized by 
+ * build_memory_bank_fabric_bitstream_by_address(),
+ * without creating any address string
+ *******************************************************************/
+size_t find_memory_bank_fabric_bitstream_size(const FabricBitstream& fabric_bitstream) {
+  return build_memory_bank_fabric_bit_address_groups(fabric_bitstream).num_groups();
+}
+
 /********************************************************************
  * For fast configuration, the number of bits to be skipped
  * the rule to skip any configuration bit should consider the whole data input values.
@@ -251,28 +614,23 @@ MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const Fa
  *     Region 1: 0 
  *     Region 2: 0 
  *   This bit can be skipped if the bit_value_to_skip is 0
+ *
+ * The data inputs are compared in packed words, 
+ * without creating any address string
  *******************************************************************/
 size_t find_memory_bank_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
                                                                  const bool& bit_value_to_skip) {
-  MemoryBankFabricBitstream fabric_bits_by_addr = build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
-
-  size_t num_bits = 0;
-
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
-    bool skip_curr_bits = true;
-    for (const bool& bit : addr_din_pair.second) {
-      if (bit_value_to_skip != bit) {
-        skip_curr_bits = false;
-        break;
-      }
-    }
-
-    if (false == skip_curr_bits) {
-      num_bits++;
-    }
-  }
+  return find_fabric_bit_address_groups_size_not_to_skip(build_memory_bank_fabric_bit_address_groups(fabric_bitstream),
+                                                         bit_value_to_skip);
+}
 
-  return num_bits;
+/********************************************************************
+ * Check if the data inputs of an address (across all the regions) 
+ * can be skipped by fast configuration, i.e., all the values are the one to skip
+ *******************************************************************/
+bool is_fabric_bit_dins_to_skip(const std::vector<bool>& dins,
+                                const bool& bit_value_to_skip) {
+  return dins.end() == std::find(dins.begin(), dins.end(), !bit_value_to_skip);
 }
 
 } /* end namespace openfpga */
@@ -21,6 +21,11 @@ namespace openfpga {
 
 size_t find_fabric_regional_bitstream_max_size(const FabricBitstream& fabric_bitstream);
 
+size_t find_fabric_bitstream_leading_bits_with_value(const FabricBitstream& fabric_bitstream,
+                                                     const BitstreamManager& bitstream_manager,
+                                                     const std::vector<FabricBitId>& fabric_bits,
+                                                     const bool& value);
+
 size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(const FabricBitstream& fabric_bitstream,
                                                                     const BitstreamManager& bitstream_manager,
                                                                     const bool& bit_value_to_skip);
@@ -30,20 +35,33 @@ typedef std::vector<std::vector<bool>> ConfigChainFabricBitstream;
 ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(const BitstreamManager& bitstream_manager,
                                                                          const FabricBitstream& fabric_bitstream);
 
-/* Alias to a specific organization of bitstreams for frame-based configuration protocol */
-typedef std::map<std::string, std::vector<bool>> FrameFabricBitstream;
-FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream);
+/* Alias to a specific organization of bitstreams for frame-based configuration protocol:
+ * a list of pairs of an address and the data inputs of all the regions 
+ */
+typedef std::vector<std::pair<std::string, std::vector<bool>>> FrameFabricBitstream;
+FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                   const bool& sort_by_address = true);
+
+size_t find_frame_based_fabric_bitstream_size(const FabricBitstream& fabric_bitstream);
 
 size_t find_frame_based_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
                                                                  const bool& bit_value_to_skip);
 
-/* Alias to a specific organization of bitstreams for memory bank configuration protocol */
-typedef std::map<std::pair<std::string, std::string>, std::vector<bool>> MemoryBankFabricBitstream;
-MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream);
+/* Alias to a specific organization of bitstreams for memory bank configuration protocol:
+ * a list of pairs of (BL address, WL address) and the data inputs of all the regions 
+ */
+typedef std::vector<std::pair<std::pair<std::string, std::string>, std::vector<bool>>> MemoryBankFabricBitstream;
+MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(const FabricBitstream& fabric_bitstream,
+                                                                        const bool& sort_by_address = true);
+
+size_t find_memory_bank_fabric_bitstream_size(const FabricBitstream& fabric_bitstream);
 
 size_t find_memory_bank_fast_configuration_fabric_bitstream_size(const FabricBitstream& fabric_bitstream,
                                                                  const bool& bit_value_to_skip);
 
+bool is_fabric_bit_dins_to_skip(const std::vector<bool>& dins,
+                                const bool& bit_value_to_skip);
+
 } /* end namespace openfpga */
 
 #endif
@@ -3,6 +3,7 @@
  * especially their truth tables, in the OpenFPGA context
  *******************************************************************/
 #include <cmath>
+#include <cstdint>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -263,115 +264,76 @@ bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table) {
   return on_set;
 }
 
+/* Number of LUT bitstream bits packed in a word */
+constexpr size_t LUT_BITSTREAM_WORD_SIZE = 64;
+
+/* Number of LUT inputs whose minterms are decoded inside a word */
+constexpr size_t LUT_BITSTREAM_WORD_NUM_INPUTS = 6;
+
+/* For the i-th input of a LUT, the positions in a word 
+ * whose SRAM index have the i-th bit set to '1' 
+ */
+constexpr uint64_t LUT_BITSTREAM_INPUT_MASKS[LUT_BITSTREAM_WORD_NUM_INPUTS] = {
+  0xAAAAAAAAAAAAAAAA, 0xCCCCCCCCCCCCCCCC, 0xF0F0F0F0F0F0F0F0,
+  0xFF00FF00FF00FF00, 0xFFFF0000FFFF0000, 0xFFFFFFFF00000000 
+};
+
 /********************************************************************
- * Complete a line in truth table with a given lut size
- * Due to the size of truth table may be less than the lut size.
+ * Find the SRAM bits covered by a line of truth table, 
+ * i.e., a cube where don't care inputs are expanded to both '0' and '1'
+ * The SRAM bits are packed in words, where the i-th bit of the SRAM index 
+ * is '1' when the i-th input is '0' (a 1-lut passes sram1 when input = 0)
+ * For the first 6 inputs, the SRAM bits are selected inside each word by masks
+ * For the other inputs, the SRAM bits are selected by the indices of words
+ *
+ * Note that the size of truth table line may be less than the lut size.
  * i.e. in LUT-6 architecture, there exists LUT1-6 in technology-mapped netlists
  * So, in truth table line, there may be 10- 1
- * In this case, we should complete it by --10- 1
+ * The missing inputs are considered as don't care, i.e., --10- 1
  *******************************************************************/
 static 
-std::vector<vtr::LogicValue> complete_truth_table_line(const size_t& lut_size,
-                                                       const std::vector<vtr::LogicValue>& tt_line) {
-  std::vector<vtr::LogicValue> ret;
-
+void build_lut_truth_table_line_cube(std::vector<uint64_t>& cube,
+                                     const size_t& lut_size,
+                                     const std::vector<vtr::LogicValue>& tt_line) {
   VTR_ASSERT(0 < tt_line.size());
-
-  /* Complete the truth table line*/
   size_t cover_len = tt_line.size() - 1; 
   VTR_ASSERT(cover_len <= lut_size);
 
-  /* Copy the original truth table line */ 
-  ret = tt_line;
-  /* Kick out the last value for now as it is the output value */
-  ret.pop_back();
-
-  /* Add the number of '-' we should add in the back !!! */
-  for (size_t j = cover_len; j < lut_size; ++j) {
-    ret.push_back(vtr::LogicValue::DONT_CARE);
-  }
-
-  /* Copy the original truth table line */ 
-  ret.push_back(tt_line.back());
-
-  /* Check if the size of ret matches our expectation */
-  VTR_ASSERT(lut_size + 1 == ret.size());
-  
-  return ret;
-}
-
-/********************************************************************
- * For each lut_bit_lines, we should recover the truth table,
- * and then set the sram bits to "1" if the truth table defines so.
- * Start_point: the position we start converting don't care sign '-'
- *              to explicit '0' or '1'
- *******************************************************************/
-static 
-void rec_build_lut_bitstream_per_line(std::vector<bool>& lut_bitstream, 
-                                      const size_t& lut_size,
-                                      const std::vector<vtr::LogicValue>& tt_line,
-                                      const size_t& start_point) {
-  std::vector<vtr::LogicValue> temp_line = tt_line;
-
-  /* Check the length of sram bits and truth table line */
-  VTR_ASSERT(lut_size + 1 == tt_line.size()); /* lut_size + '1|0' */
-
-  /* End of truth_table_line should be "space" and "1" */ 
-  VTR_ASSERT( (vtr::LogicValue::TRUE == tt_line.back())
-           || (vtr::LogicValue::FALSE == tt_line.back()) );
-
-  /* Make sure before start point there is no '-' */
-  VTR_ASSERT(start_point < tt_line.size());
-  for (size_t i = 0; i < start_point; ++i) {
-    VTR_ASSERT(vtr::LogicValue::DONT_CARE != tt_line[i]);
-  }
-
-  /* Configure sram bits recursively */
-  for (size_t i = start_point; i < lut_size; ++i) {
-    if (vtr::LogicValue::DONT_CARE == tt_line[i]) {
-      /* if we find a dont_care, we don't do configure now but recursively*/
-      /* '0' branch */
-      temp_line[i] = vtr::LogicValue::FALSE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      /* '1' branch */
-      temp_line[i] = vtr::LogicValue::TRUE; 
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line, start_point + 1);
-      return; 
-    }
+  /* Only the first (2^lut_size) bits are valid when there is a single word */
+  uint64_t word_mask = ~uint64_t(0);
+  if (lut_size < LUT_BITSTREAM_WORD_NUM_INPUTS) {
+    word_mask = (uint64_t(1) << (size_t(1) << lut_size)) - 1;
   }
+  /* Masks of the SRAM bits selected by the indices of words */
+  size_t word_index_mask = 0;
+  size_t word_index_value = 0;
 
-  /* TODO: Use MuxGraph to decode this!!! */
-  /* Decode bitstream only when there are only 0 or 1 in the truth table */
-  size_t sram_id = 0;
-  for (size_t i = 0; i < lut_size; ++i) {
-    /* Should be either '0' or '1' */
+  for (size_t i = 0; i < cover_len; ++i) {
+    uint64_t input_mask = 0;
     switch (tt_line[i]) {
     case vtr::LogicValue::FALSE :
-      /* We assume the 1-lut pass sram1 when input = 0 */
-      sram_id += (size_t)pow(2., (double)(i));
+      input_mask = ~uint64_t(0);
       break;
     case vtr::LogicValue::TRUE :
-      /* We assume the 1-lut pass sram0 when input = 1 */
       break;
     case vtr::LogicValue::DONT_CARE :
+      continue;
     default :
       VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                     "Invalid truth_table bit '%s', should be [0|1|]!\n",
+                     "Invalid truth_table bit '%s', should be [0|1|-]!\n",
                      vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]); 
       exit(1);
     }
+    if (i < LUT_BITSTREAM_WORD_NUM_INPUTS) {
+      word_mask &= ~(input_mask ^ LUT_BITSTREAM_INPUT_MASKS[i]);
+    } else {
+      word_index_mask |= size_t(1) << (i - LUT_BITSTREAM_WORD_NUM_INPUTS);
+      word_index_value |= (input_mask & 1) << (i - LUT_BITSTREAM_WORD_NUM_INPUTS);
+    }
   }
-  /* Set the sram bit to '1'*/
-  VTR_ASSERT(sram_id < lut_bitstream.size());
-  if (vtr::LogicValue::TRUE == tt_line.back()) {
-    lut_bitstream[sram_id] = true; /* on set*/
-  } else if (vtr::LogicValue::FALSE == tt_line.back()) {
-    lut_bitstream[sram_id] = false; /* off set */
-  } else {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, 
-                   "Invalid truth_table_line ending '%s'!\n",
-                   vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
-    exit(1);
+
+  for (size_t iword = 0; iword < cube.size(); ++iword) {
+    cube[iword] = ((iword & word_index_mask) == word_index_value) ? word_mask : 0;
   }
 }
 
@@ -380,6 +342,12 @@ void rec_build_lut_bitstream_per_line(std::vector<bool>& lut_bitstream,
  * As truth tables may come from different logic blocks, truth tables could be in on and off sets
  * We first build a base SRAM bits, where different parts are set to tbe on/off sets 
  * Then, we can decode SRAM bits as regular process 
+ *
+ * The SRAM bits are built in words, where each line of truth table
+ * is applied to all the bits it covers with a few word operations,
+ * without expanding the don't care inputs one by one.
+ * Lines are applied in order, so that a later line overwrites the bits of earlier lines.
+ * A LUT6 or a smaller LUT fits in a single word
  *******************************************************************/
 static 
 std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTable& truth_table,
@@ -387,8 +355,7 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
                                                     const size_t& default_sram_bit_value) {
   size_t lut_size = lut_mux_graph.num_memory_bits();
   size_t bitstream_size = lut_mux_graph.num_inputs();
-  std::vector<bool> lut_bitstream(bitstream_size, false);
-  AtomNetlist::TruthTable completed_truth_table;
+  VTR_ASSERT((size_t(1) << lut_size) == bitstream_size);
   bool on_set = false;
   bool off_set = false;
 
@@ -414,24 +381,38 @@ std::vector<bool> build_single_output_lut_bitstream(const AtomNetlist::TruthTabl
     off_set = !on_set;
   }
 
-  /* Read in truth table lines, decode one by one */
-  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
-    /* Complete the truth table line by line*/
-    completed_truth_table.push_back(complete_truth_table_line(lut_size, tt_line));
-  }
+  /* Initial all the bits in the bitstream 
+   * By default, the lut_bitstream is initialize for on_set
+   * For off set, it should be flipped
+   */
+  size_t num_words = (bitstream_size + LUT_BITSTREAM_WORD_SIZE - 1) / LUT_BITSTREAM_WORD_SIZE;
+  std::vector<uint64_t> lut_bitstream_words(num_words, (true == off_set) ? ~uint64_t(0) : 0);
+  std::vector<uint64_t> cube(num_words, 0);
 
-  /* Initial all the bits in the bitstream */
-  if (true == off_set) {
-    /* By default, the lut_bitstream is initialize for on_set
-     * For off set, it should be flipped
-     */
-    lut_bitstream.clear(); 
-    lut_bitstream.resize(bitstream_size, true);
+  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
+    build_lut_truth_table_line_cube(cube, lut_size, tt_line);
+    /* Set the sram bits covered by the line */
+    if (vtr::LogicValue::TRUE == tt_line.back()) {
+      /* on set */
+      for (size_t iword = 0; iword < num_words; ++iword) {
+        lut_bitstream_words[iword] |= cube[iword];
+      }
+    } else if (vtr::LogicValue::FALSE == tt_line.back()) {
+      /* off set */
+      for (size_t iword = 0; iword < num_words; ++iword) {
+        lut_bitstream_words[iword] &= ~cube[iword];
+      }
+    } else {
+      VTR_LOGF_ERROR(__FILE__, __LINE__, 
+                     "Invalid truth_table_line ending '%s'!\n",
+                     vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
+      exit(1);
+    }
   }
 
-  for (const std::vector<vtr::LogicValue>& tt_line : completed_truth_table) {
-    /* Update the truth table, sram_bits */
-    rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, tt_line, 0);
+  std::vector<bool> lut_bitstream(bitstream_size, false);
+  for (size_t ibit = 0; ibit < bitstream_size; ++ibit) {
+    lut_bitstream[ibit] = (1 == ((lut_bitstream_words[ibit / LUT_BITSTREAM_WORD_SIZE] >> (ibit % LUT_BITSTREAM_WORD_SIZE)) & 1));
   }
 
   return lut_bitstream;
@@ -451,7 +432,7 @@ std::vector<bool> build_frac_lut_bitstream(const CircuitLibrary& circuit_lib,
   /* Initialization */
   std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(), default_sram_bit_value);
 
-  for (const std::pair<const t_pb_graph_pin*, AtomNetlist::TruthTable>& element : truth_tables) {
+  for (const std::pair<const t_pb_graph_pin* const, AtomNetlist::TruthTable>& element : truth_tables) {
     /* Find the corresponding circuit model output port and assoicated lut_output_mask */
     CircuitPortId lut_model_output_port = device_annotation.pb_circuit_port(element.first->port);
     size_t lut_frac_level = circuit_lib.port_lut_frac_level(lut_model_output_port);
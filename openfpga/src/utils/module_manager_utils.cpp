@@ -76,6 +76,18 @@ void reserve_module_manager_module_nets(ModuleManager& module_manager,
   module_manager.reserve_module_nets(parent_module, num_nets);
 }
 
+/******************************************************************************
+ * Reserve a number of module nets for a given module
+ * on top of the nets which have been added to the module
+ * This is used by net builders which can count the nets to be created 
+ * before adding them, so that the net list grows in one step
+ ******************************************************************************/
+void reserve_module_manager_additional_module_nets(ModuleManager& module_manager, 
+                                                   const ModuleId& module,
+                                                   const size_t& num_additional_nets) {
+  module_manager.reserve_module_nets(module, module_manager.num_nets(module) + num_additional_nets);
+}
+
 /******************************************************************************
  * Count the 'actual' number of configurable children for a module in module manager
  * A 'true' configurable children should have a number of configurable children as well
@@ -446,7 +458,8 @@ bool module_net_is_local_wire(const ModuleManager& module_manager,
   /* Check all the sink modules of the net, 
    * if we have a source module is the current module, this is not local wire 
    */
-  for (ModuleId src_module : module_manager.net_source_modules(module_id, module_net)) {
+  for (const ModuleNetSrcId& net_src : module_manager.module_net_sources(module_id, module_net)) {
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id == src_module) {
       /* Here, this is not a local wire */
       return false;
@@ -454,7 +467,8 @@ bool module_net_is_local_wire(const ModuleManager& module_manager,
   }
 
   /* Check all the sink modules of the net */
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
+  for (const ModuleNetSinkId& net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id == sink_module) {
       /* Here, this is not a local wire */
       return false;
@@ -483,7 +497,8 @@ bool module_net_include_output_short_connection(const ModuleManager& module_mana
                                                 const ModuleId& module_id, const ModuleNetId& module_net) {
   /* Check all the sink modules of the net */
   size_t contain_num_module_output = 0;
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
+  for (const ModuleNetSinkId& net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id == sink_module) {
       contain_num_module_output++;
     }
@@ -513,7 +528,8 @@ bool module_net_include_local_short_connection(const ModuleManager& module_manag
    * if we have a source module is the current module, this is not local wire 
    */
   bool contain_module_input = false;
-  for (ModuleId src_module : module_manager.net_source_modules(module_id, module_net)) {
+  for (const ModuleNetSrcId& net_src : module_manager.module_net_sources(module_id, module_net)) {
+    ModuleId src_module = module_manager.net_source_module(module_id, module_net, net_src);
     if (module_id == src_module) {
       contain_module_input = true;
       break;
@@ -522,7 +538,8 @@ bool module_net_include_local_short_connection(const ModuleManager& module_manag
 
   /* Check all the sink modules of the net */
   bool contain_module_output = false;
-  for (ModuleId sink_module : module_manager.net_sink_modules(module_id, module_net)) {
+  for (const ModuleNetSinkId& net_sink : module_manager.module_net_sinks(module_id, module_net)) {
+    ModuleId sink_module = module_manager.net_sink_module(module_id, module_net, net_sink);
     if (module_id == sink_module) {
       contain_module_output = true;
       break;
@@ -828,6 +845,9 @@ void add_module_nets_cmos_flatten_memory_config_bus(ModuleManager& module_manage
   /* Get the pin id for source port */
   BasicPort net_src_port = module_manager.module_port(net_src_module_id, net_src_port_id); 
 
+  /* Each pin of the source port drives a net, reserve them all at once */
+  reserve_module_manager_additional_module_nets(module_manager, parent_module, net_src_port.get_width());
+
   for (size_t mem_index = 0; mem_index < module_manager.configurable_children(parent_module).size(); ++mem_index) {
     ModuleId net_sink_module_id;
     size_t net_sink_instance_id;
@@ -1513,6 +1533,13 @@ void add_module_io_ports_from_child_modules(ModuleManager& module_manager,
     }
   } 
 
+  /* Each pin of the GPIO ports is connected by a net, reserve them all at once */
+  size_t num_gpio_nets = 0;
+  for (const BasicPort& gpio_port_to_add : gpio_ports_to_add) {
+    num_gpio_nets += gpio_port_to_add.get_width();
+  }
+  reserve_module_manager_additional_module_nets(module_manager, module_id, num_gpio_nets);
+
   /* Set up a counter for each type of GPIO port */
   std::vector<size_t> gpio_port_lsb(gpio_ports_to_add.size(), 0);
   /* Add module nets to connect the GPIOs of the module to the GPIOs of the sub module */
@@ -1636,6 +1663,13 @@ void add_module_global_input_ports_from_child_modules(ModuleManager& module_mana
     global_port_ids.push_back(port_id);
   } 
 
+  /* Each pin of the global ports drives a net, reserve them all at once */
+  size_t num_global_nets = 0;
+  for (const BasicPort& global_port_to_add : global_ports_to_add) {
+    num_global_nets += global_port_to_add.get_width();
+  }
+  reserve_module_manager_additional_module_nets(module_manager, module_id, num_global_nets);
+
   /* Count the number of sinks for each global port */
   std::map<ModulePortId, size_t> port_sink_count;
   for (const ModuleId& child : module_manager.child_modules(module_id)) {
@@ -1670,8 +1704,8 @@ void add_module_global_input_ports_from_child_modules(ModuleManager& module_mana
         /* For each pin of the child port, create a net and do wiring */
         for (size_t pin_id = 0; pin_id < child_global_port.pins().size(); ++pin_id) {
           /* Reach here, it means this is the port we want, create a net and configure its source and sink */
-          ModuleNetId net = create_module_source_pin_net(module_manager, module_id, module_id, 0, module_global_port_id, module_global_port.pins()[pin_id]); 
-          module_manager.reserve_module_net_sinks(module_id, net, port_sink_count[module_global_port_id]);
+          ModuleNetId net = create_module_source_pin_net(module_manager, module_id, module_id, 0, module_global_port_id, module_global_port.pins()[pin_id],
+                                                         port_sink_count[module_global_port_id]); 
           module_manager.add_module_net_sink(module_id, net, child, child_instance, child_global_port_id, child_global_port.pins()[pin_id]); 
           /* We finish for this child gpio port */
         }
@@ -1806,6 +1840,33 @@ ModuleNetId create_module_source_pin_net(ModuleManager& module_manager,
   return net;
 }
 
+/********************************************************************
+ * Try to create a net for the source pin, like the function above,
+ * and reserve a number of sinks when the net is newly created
+ * This is used when the fan-out of the source pin is known in advance,
+ * so that the sink list of a high fan-out net does not grow pin by pin
+ *******************************************************************/
+ModuleNetId create_module_source_pin_net(ModuleManager& module_manager,
+                                         const ModuleId& cur_module_id,
+                                         const ModuleId& src_module_id,
+                                         const size_t& src_instance_id,
+                                         const ModulePortId& src_module_port_id,
+                                         const size_t& src_pin_id,
+                                         const size_t& num_reserved_sinks) {
+  ModuleNetId net = module_manager.module_instance_port_net(cur_module_id,
+                                                            src_module_id, src_instance_id, 
+                                                            src_module_port_id, src_pin_id);
+  if (ModuleNetId::INVALID() == net) { 
+    net = module_manager.create_module_net(cur_module_id);
+    module_manager.add_module_net_source(cur_module_id, net,
+                                         src_module_id, src_instance_id,
+                                         src_module_port_id, src_pin_id);
+    module_manager.reserve_module_net_sinks(cur_module_id, net, num_reserved_sinks);
+  }
+
+  return net;
+}
+
 /********************************************************************
  * Add a bus of nets to a module (cur_module_id)
  * Note: 
@@ -37,6 +37,10 @@ constexpr std::array<ModuleManager::e_module_port_type, 3> MODULE_IO_PORT_TYPES
 void reserve_module_manager_module_nets(ModuleManager& module_manager, 
                                         const ModuleId& module);
 
+void reserve_module_manager_additional_module_nets(ModuleManager& module_manager, 
+                                                   const ModuleId& module,
+                                                   const size_t& num_additional_nets);
+
 size_t count_module_manager_module_configurable_children(const ModuleManager& module_manager, 
                                                          const ModuleId& module);
 
@@ -160,6 +164,14 @@ ModuleNetId create_module_source_pin_net(ModuleManager& module_manager,
                                          const ModulePortId& src_module_port_id,
                                          const size_t& src_pin_id);
 
+ModuleNetId create_module_source_pin_net(ModuleManager& module_manager,
+                                         const ModuleId& cur_module_id,
+                                         const ModuleId& src_module_id,
+                                         const size_t& src_instance_id,
+                                         const ModulePortId& src_module_port_id,
+                                         const size_t& src_pin_id,
+                                         const size_t& num_reserved_sinks);
+
 void add_module_bus_nets(ModuleManager& module_manager,
                          const ModuleId& cur_module_id,
                          const ModuleId& src_module_id,
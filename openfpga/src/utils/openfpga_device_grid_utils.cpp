@@ -8,6 +8,10 @@
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from vpr library */
+#include "vpr_utils.h"
+
+#include "openfpga_naming.h"
 #include "openfpga_device_grid_utils.h"
 
 /* begin namespace openfpga */
@@ -60,4 +64,43 @@ std::map<e_side, std::vector<vtr::Point<size_t>>> generate_perimeter_grid_coordi
   return io_coordinates;
 }
 
+/********************************************************************
+ * Summarize the grids of a device in dense matrices
+ * The I/O flag is found once for each physical tile type
+ *******************************************************************/
+t_device_grid_summary build_device_grid_summary(const DeviceGrid& grids) {
+  t_device_grid_summary grid_summary;
+  grid_summary.type_indices.resize({grids.width(), grids.height()}, -1);
+  grid_summary.roots.resize({grids.width(), grids.height()}, false);
+  grid_summary.io_types.resize({grids.width(), grids.height()}, false);
+  grid_summary.border_sides.resize({grids.width(), grids.height()}, NUM_SIDES);
+
+  vtr::Point<size_t> device_size(grids.width(), grids.height());
+  std::vector<int> type_io_flags; /* [type_index], -1 if not found yet */
+
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      vtr::Point<size_t> grid_coordinate(ix, iy);
+      grid_summary.border_sides[ix][iy] = find_grid_border_side(device_size, grid_coordinate);
+
+      t_physical_tile_type_ptr grid_type = grids[ix][iy].type;
+      if (true == is_empty_type(grid_type)) {
+        continue;
+      }
+      grid_summary.type_indices[ix][iy] = grid_type->index;
+      grid_summary.roots[ix][iy] = (0 == grids[ix][iy].width_offset) && (0 == grids[ix][iy].height_offset);
+
+      if (size_t(grid_type->index) >= type_io_flags.size()) {
+        type_io_flags.resize(grid_type->index + 1, -1);
+      }
+      if (-1 == type_io_flags[grid_type->index]) {
+        type_io_flags[grid_type->index] = is_io_type(grid_type) ? 1 : 0;
+      }
+      grid_summary.io_types[ix][iy] = (1 == type_io_flags[grid_type->index]);
+    }
+  }
+
+  return grid_summary;
+}
+
 } /* end namespace openfpga */
@@ -9,6 +9,7 @@
 #include <map>
 #include "device_grid.h"
 #include "vtr_geometry.h"
+#include "vtr_ndmatrix.h"
 
 /********************************************************************
  * Function declaration
@@ -20,8 +21,24 @@ namespace openfpga {
 /* A constant array to walk through FPGA border sides clockwise*/
 constexpr std::array<e_side, 4> FPGA_SIDES_CLOCKWISE{TOP, RIGHT, BOTTOM, LEFT};
 
+/* A dense summary of the grids of a device, which is computed once for a pass
+ * walking through the grids, so that the tile type of each grid is not queried repeatedly
+ *  - type_indices: the index of the physical tile type of each grid, -1 for empty grids
+ *  - roots: if a grid is the root of a non-empty tile, i.e., its width and height offsets are zero
+ *  - io_types: if the physical tile type of a grid is an I/O
+ *  - border_sides: the border side of each grid (see find_grid_border_side()), NUM_SIDES for core grids
+ */
+struct t_device_grid_summary {
+  vtr::Matrix<int> type_indices;
+  vtr::Matrix<bool> roots;
+  vtr::Matrix<bool> io_types;
+  vtr::Matrix<e_side> border_sides;
+};
+
 std::map<e_side, std::vector<vtr::Point<size_t>>> generate_perimeter_grid_coordinates(const DeviceGrid& grids);
 
+t_device_grid_summary build_device_grid_summary(const DeviceGrid& grids);
+
 } /* end namespace openfpga */
 
 #endif
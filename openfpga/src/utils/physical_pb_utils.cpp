@@ -3,14 +3,12 @@
  * data structures
  ***********************************************************************/
 #include <algorithm>
+#include <cstdlib>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
-/* Headers from openfpgautil library */
-#include "openfpga_tokenizer.h"
-
 #include "openfpga_naming.h"
 #include "lut_utils.h"
 #include "pb_type_utils.h"
@@ -276,6 +274,50 @@ void mark_physical_pb_wired_lut_outputs(PhysicalPb& phy_pb,
   }
 }
 
+/************************************************************************
+ * Find the bitstream of an atom block which is given by a parameter
+ * or an attribute in the eblif file, and decode it to bits
+ * Return false if the atom block has no such parameter or attribute
+ ***********************************************************************/
+static 
+bool find_atom_block_eblif_bitstream(const AtomContext& atom_ctx,
+                                     const AtomBlockId& atom_blk,
+                                     const VprBitstreamAnnotation::t_eblif_bitstream& eblif_bitstream,
+                                     std::vector<bool>& bitstream) {
+  const std::string* bitstream_value = nullptr;
+  if (false == eblif_bitstream.is_attr) {
+    for (const auto& param_search : atom_ctx.nlist.block_params(atom_blk)) {
+      if (param_search.first == eblif_bitstream.identifier) {
+        bitstream_value = &(param_search.second);
+        break;
+      }
+    }
+  } else {
+    for (const auto& attr_search : atom_ctx.nlist.block_attrs(atom_blk)) {
+      if (attr_search.first == eblif_bitstream.identifier) {
+        bitstream_value = &(attr_search.second);
+        break;
+      }
+    }
+  }
+  if (nullptr == bitstream_value) {
+    return false;
+  }
+
+  bitstream.clear();
+  bitstream.reserve(bitstream_value->size());
+  for (const char& bit : *bitstream_value) {
+    if (('0' != bit) && ('1' != bit)) {
+      VTR_LOG_ERROR("Invalid bitstream '%s' of atom block '%s' in eblif file, which should contain only '0' and '1'!\n",
+                    bitstream_value->c_str(),
+                    atom_ctx.nlist.block_name(atom_blk).c_str());
+      exit(1);
+    }
+    bitstream.push_back('1' == bit);
+  }
+  return true;
+}
+
 /************************************************************************
  * Synchronize mapping results from an operating pb to a physical pb
  ***********************************************************************/
@@ -308,62 +350,23 @@ void rec_update_physical_pb_from_operating_pb(PhysicalPb& phy_pb,
     /* if the operating pb type has bitstream annotation,
      * bind the bitstream value from atom block to the physical pb 
      */
-    if (VprBitstreamAnnotation::e_bitstream_source_type::BITSTREAM_SOURCE_EBLIF == bitstream_annotation.pb_type_bitstream_source(pb_type)) {
-      StringToken tokenizer = bitstream_annotation.pb_type_bitstream_content(pb_type);
-      std::vector<std::string> tokens = tokenizer.split(" ");
-      /* FIXME: The token-level check should be done much earlier!!! */
-      VTR_ASSERT(2 == tokens.size());
-      /* The token is typically organized as <.param|.attr> <identifier string> */
-      if (std::string(".param") == tokens[0]) {
-        for (const auto& param_search : atom_ctx.nlist.block_params(atom_blk)) {
-          /* Bypass unmatched parameter identifier */
-          if (param_search.first != tokens[1]) {
-            continue;
-          }
-          phy_pb.set_fixed_bitstream(physical_pb, param_search.second); 
-          phy_pb.set_fixed_bitstream_offset(physical_pb, bitstream_annotation.pb_type_bitstream_offset(pb_type));
-        }
-      } else if (std::string(".attr") == tokens[0]) {
-        for (const auto& attr_search : atom_ctx.nlist.block_attrs(atom_blk)) {
-          /* Bypass unmatched parameter identifier */
-          if (attr_search.first == tokens[1]) {
-            continue;
-          }
-          phy_pb.set_fixed_bitstream(physical_pb, attr_search.second); 
-          phy_pb.set_fixed_bitstream_offset(physical_pb, bitstream_annotation.pb_type_bitstream_offset(pb_type));
-        }
-      }
+    const VprBitstreamAnnotation::t_eblif_bitstream* eblif_bitstream = bitstream_annotation.pb_type_eblif_bitstream(pb_type);
+    std::vector<bool> fixed_bitstream;
+    if ( (nullptr != eblif_bitstream)
+      && (true == find_atom_block_eblif_bitstream(atom_ctx, atom_blk, *eblif_bitstream, fixed_bitstream)) ) {
+      phy_pb.set_fixed_bitstream(physical_pb, fixed_bitstream); 
+      phy_pb.set_fixed_bitstream_offset(physical_pb, eblif_bitstream->offset);
     }
 
-    
     /* if the operating pb type has mode-select bitstream annotation,
      * bind the bitstream value from atom block to the physical pb 
      */
-    if (VprBitstreamAnnotation::e_bitstream_source_type::BITSTREAM_SOURCE_EBLIF == bitstream_annotation.pb_type_mode_select_bitstream_source(pb_type)) {
-      StringToken tokenizer = bitstream_annotation.pb_type_mode_select_bitstream_content(pb_type);
-      std::vector<std::string> tokens = tokenizer.split(" ");
-      /* FIXME: The token-level check should be done much earlier!!! */
-      VTR_ASSERT(2 == tokens.size());
-      /* The token is typically organized as <.param|.attr> <identifier string> */
-      if (std::string(".param") == tokens[0]) {
-        for (const auto& param_search : atom_ctx.nlist.block_params(atom_blk)) {
-          /* Bypass unmatched parameter identifier */
-          if (param_search.first != tokens[1]) {
-            continue;
-          }
-          phy_pb.set_fixed_mode_select_bitstream(physical_pb, param_search.second); 
-          phy_pb.set_fixed_mode_select_bitstream_offset(physical_pb, bitstream_annotation.pb_type_mode_select_bitstream_offset(pb_type));
-        }
-      } else if (std::string(".attr") == tokens[0]) {
-        for (const auto& attr_search : atom_ctx.nlist.block_attrs(atom_blk)) {
-          /* Bypass unmatched parameter identifier */
-          if (attr_search.first == tokens[1]) {
-            continue;
-          }
-          phy_pb.set_fixed_mode_select_bitstream(physical_pb, attr_search.second); 
-          phy_pb.set_fixed_mode_select_bitstream_offset(physical_pb, bitstream_annotation.pb_type_mode_select_bitstream_offset(pb_type));
-        }
-      }
+    const VprBitstreamAnnotation::t_eblif_bitstream* mode_select_eblif_bitstream = bitstream_annotation.pb_type_mode_select_eblif_bitstream(pb_type);
+    std::vector<bool> fixed_mode_select_bitstream;
+    if ( (nullptr != mode_select_eblif_bitstream)
+      && (true == find_atom_block_eblif_bitstream(atom_ctx, atom_blk, *mode_select_eblif_bitstream, fixed_mode_select_bitstream)) ) {
+      phy_pb.set_fixed_mode_select_bitstream(physical_pb, fixed_mode_select_bitstream); 
+      phy_pb.set_fixed_mode_select_bitstream_offset(physical_pb, mode_select_eblif_bitstream->offset);
     }
 
     /* Iterate over ports and annotate the atom pins */
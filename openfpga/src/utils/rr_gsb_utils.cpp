@@ -22,7 +22,7 @@ bool connection_block_contain_only_routing_tracks(const RRGSB& rr_gsb,
   bool routing_track_only = true;
 
   /* Find routing multiplexers on the sides of a Connection block where IPIN nodes locate */
-  std::vector<enum e_side> cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
+  const std::vector<enum e_side>& cb_sides = rr_gsb.get_cb_ipin_sides(cb_type);
 
   for (size_t side = 0; side < cb_sides.size(); ++side) {
     enum e_side cb_ipin_side = cb_sides[side];
@@ -0,0 +1,255 @@
+/********************************************************************
+ * Unit test functions to validate the binary format of
+ * architecture bitstream:
+ * 1. a bitstream database written in binary format and read back
+ *    should be the same as the original one and as the one
+ *    written and read back in XML format
+ * 2. a corrupted binary file should be rejected by the reader
+ *******************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "bitstream_manager_utils.h"
+#include "read_xml_arch_bitstream.h"
+#include "write_xml_arch_bitstream.h"
+#include "read_binary_arch_bitstream.h"
+#include "write_binary_arch_bitstream.h"
+
+static const char* TEST_XML_FILE_NAME = "test_binary_arch_bitstream.xml";
+static const char* TEST_BINARY_FILE_NAME = "test_binary_arch_bitstream.bin";
+
+/********************************************************************
+ * Build a bitstream database with a few levels of blocks,
+ * where the memory blocks share the same names under different parents,
+ * some blocks have path ids and nets, and some blocks have so many bits
+ * that their bits are packed in several 64-bit words
+ *******************************************************************/
+static
+openfpga::BitstreamManager build_test_arch_bitstream() {
+  openfpga::BitstreamManager bitstream_manager;
+
+  openfpga::ConfigBlockId top_block = bitstream_manager.add_block("fpga_top");
+  size_t num_bits = 0;
+  for (const std::string& grid_name : std::vector<std::string>({"grid_clb_1__1_", "grid_clb_1__2_", "grid_io_top_1__3_"})) {
+    openfpga::ConfigBlockId grid_block = bitstream_manager.add_block(grid_name);
+    bitstream_manager.add_child_block(top_block, grid_block);
+
+    openfpga::ConfigBlockId mux_block = bitstream_manager.add_block("mux_tree_size4_0_");
+    bitstream_manager.add_child_block(grid_block, mux_block);
+
+    for (const std::string& mem_name : std::vector<std::string>({"mem_0_", "mem_1_"})) {
+      openfpga::ConfigBlockId mem_block = bitstream_manager.add_block(mem_name);
+      bitstream_manager.add_child_block(mux_block, mem_block);
+      /* Path ids and nets are only given to the blocks with bits, as build_device_bitstream does */
+      if (std::string("mem_0_") == mem_name) {
+        bitstream_manager.add_path_id_to_block(mem_block, int(num_bits % 4));
+        bitstream_manager.add_input_nets_to_block(mem_block, {"net_a", "unmapped", grid_name + std::string("_in"), "net_a"});
+        bitstream_manager.add_output_nets_to_block(mem_block, {grid_name + std::string("_out")});
+      }
+      /* Blocks are of 3 to 135 bits */
+      std::vector<bool> mem_bits(3 + 44 * (num_bits % 4), false);
+      for (size_t ibit = 0; ibit < mem_bits.size(); ++ibit) {
+        mem_bits[ibit] = (0 == (num_bits + ibit) % 3);
+      }
+      bitstream_manager.add_block_bits(mem_block, mem_bits);
+      num_bits += mem_bits.size();
+    }
+  }
+
+  return bitstream_manager;
+}
+
+/********************************************************************
+ * Compare two blocks and their children, in the same hierarchy
+ *******************************************************************/
+static
+int rec_compare_arch_bitstream_blocks(const openfpga::BitstreamManager& ref_bitstream_manager,
+                                      const openfpga::ConfigBlockId& ref_block,
+                                      const openfpga::BitstreamManager& test_bitstream_manager,
+                                      const openfpga::ConfigBlockId& test_block) {
+  int num_err = 0;
+
+  std::string block_name = ref_bitstream_manager.block_name(ref_block);
+  if (block_name != test_bitstream_manager.block_name(test_block)) {
+    VTR_LOG_ERROR("Block '%s' is read as '%s'!\n",
+                  block_name.c_str(), test_bitstream_manager.block_name(test_block).c_str());
+    num_err++;
+  }
+  if ( (ref_bitstream_manager.valid_block_path_id(ref_block) != test_bitstream_manager.valid_block_path_id(test_block))
+    || (ref_bitstream_manager.block_path_id(ref_block) != test_bitstream_manager.block_path_id(test_block)) ) {
+    VTR_LOG_ERROR("Path id of block '%s' is read as %d while expect %d!\n",
+                  block_name.c_str(),
+                  test_bitstream_manager.block_path_id(test_block),
+                  ref_bitstream_manager.block_path_id(ref_block));
+    num_err++;
+  }
+  if ( (ref_bitstream_manager.block_input_nets(ref_block) != test_bitstream_manager.block_input_nets(test_block))
+    || (ref_bitstream_manager.block_output_nets(ref_block) != test_bitstream_manager.block_output_nets(test_block)) ) {
+    VTR_LOG_ERROR("Nets of block '%s' are not read correctly!\n",
+                  block_name.c_str());
+    num_err++;
+  }
+  if (ref_bitstream_manager.block_bit_values(ref_block) != test_bitstream_manager.block_bit_values(test_block)) {
+    VTR_LOG_ERROR("Bits of block '%s' are not read correctly!\n",
+                  block_name.c_str());
+    num_err++;
+  }
+
+  std::vector<openfpga::ConfigBlockId> ref_children = ref_bitstream_manager.block_children(ref_block);
+  std::vector<openfpga::ConfigBlockId> test_children = test_bitstream_manager.block_children(test_block);
+  if (ref_children.size() != test_children.size()) {
+    VTR_LOG_ERROR("Block '%s' has %lu children while expect %lu!\n",
+                  block_name.c_str(), test_children.size(), ref_children.size());
+    return num_err + 1;
+  }
+  for (size_t ichild = 0; ichild < ref_children.size(); ++ichild) {
+    num_err += rec_compare_arch_bitstream_blocks(ref_bitstream_manager, ref_children[ichild],
+                                                 test_bitstream_manager, test_children[ichild]);
+  }
+
+  return num_err;
+}
+
+static
+int compare_arch_bitstreams(const openfpga::BitstreamManager& ref_bitstream_manager,
+                            const openfpga::BitstreamManager& test_bitstream_manager) {
+  if ( (ref_bitstream_manager.num_blocks() != test_bitstream_manager.num_blocks())
+    || (ref_bitstream_manager.num_bits() != test_bitstream_manager.num_bits()) ) {
+    VTR_LOG_ERROR("Read %lu blocks and %lu bits while expect %lu blocks and %lu bits!\n",
+                  test_bitstream_manager.num_blocks(), test_bitstream_manager.num_bits(),
+                  ref_bitstream_manager.num_blocks(), ref_bitstream_manager.num_bits());
+    return 1;
+  }
+
+  std::vector<openfpga::ConfigBlockId> ref_top_blocks = openfpga::find_bitstream_manager_top_blocks(ref_bitstream_manager);
+  std::vector<openfpga::ConfigBlockId> test_top_blocks = openfpga::find_bitstream_manager_top_blocks(test_bitstream_manager);
+  if (ref_top_blocks.size() != test_top_blocks.size()) {
+    VTR_LOG_ERROR("Read %lu top blocks while expect %lu!\n",
+                  test_top_blocks.size(), ref_top_blocks.size());
+    return 1;
+  }
+
+  int num_err = 0;
+  for (size_t iblk = 0; iblk < ref_top_blocks.size(); ++iblk) {
+    num_err += rec_compare_arch_bitstream_blocks(ref_bitstream_manager, ref_top_blocks[iblk],
+                                                 test_bitstream_manager, test_top_blocks[iblk]);
+  }
+  return num_err;
+}
+
+/********************************************************************
+ * Write the bitstream database in binary and XML formats, read them back
+ * and check that they are the same as the original one
+ *******************************************************************/
+static
+int test_binary_arch_bitstream_round_trip() {
+  int num_err = 0;
+
+  openfpga::BitstreamManager bitstream_manager = build_test_arch_bitstream();
+
+  openfpga::write_xml_architecture_bitstream(bitstream_manager, std::string(TEST_XML_FILE_NAME));
+  openfpga::BitstreamManager xml_bitstream_manager = openfpga::read_xml_architecture_bitstream(TEST_XML_FILE_NAME);
+
+  if (0 != openfpga::write_binary_architecture_bitstream(bitstream_manager, std::string(TEST_BINARY_FILE_NAME))) {
+    VTR_LOG_ERROR("Fail to write the binary file!\n");
+    return num_err + 1;
+  }
+  openfpga::BitstreamManager binary_bitstream_manager;
+  if (0 != openfpga::read_binary_architecture_bitstream(binary_bitstream_manager, TEST_BINARY_FILE_NAME)) {
+    VTR_LOG_ERROR("Fail to read the binary file!\n");
+    return num_err + 1;
+  }
+
+  num_err += compare_arch_bitstreams(bitstream_manager, binary_bitstream_manager);
+  num_err += compare_arch_bitstreams(xml_bitstream_manager, binary_bitstream_manager);
+
+  /* The binary file keeps the block and bit ids */
+  for (const openfpga::ConfigBlockId& block : bitstream_manager.blocks()) {
+    if ( (bitstream_manager.block_name(block) != binary_bitstream_manager.block_name(block))
+      || (bitstream_manager.block_bits(block) != binary_bitstream_manager.block_bits(block)) ) {
+      VTR_LOG_ERROR("Block '%lu' has a different id after read!\n",
+                    size_t(block));
+      num_err++;
+    }
+  }
+
+  std::remove(TEST_XML_FILE_NAME);
+  std::remove(TEST_BINARY_FILE_NAME);
+
+  return num_err;
+}
+
+/********************************************************************
+ * List a child of the top block twice in a binary file,
+ * and check that the reader reports an error without
+ * touching the bitstream database
+ *******************************************************************/
+static
+int test_binary_arch_bitstream_duplicated_child() {
+  int num_err = 0;
+
+  openfpga::BitstreamManager bitstream_manager = build_test_arch_bitstream();
+  if (0 != openfpga::write_binary_architecture_bitstream(bitstream_manager, std::string(TEST_BINARY_FILE_NAME))) {
+    VTR_LOG_ERROR("Fail to write the binary file!\n");
+    return num_err + 1;
+  }
+
+  /* Load the file and corrupt the child table */
+  std::vector<uint64_t> words;
+  {
+    std::ifstream fp(TEST_BINARY_FILE_NAME, std::ifstream::binary | std::ifstream::ate);
+    words.resize(size_t(fp.tellg()) / sizeof(uint64_t));
+    fp.seekg(0);
+    fp.read(reinterpret_cast<char*>(words.data()), words.size() * sizeof(uint64_t));
+  }
+  size_t child_table_offset = BINARY_ARCH_BITSTREAM_NUM_HEADER_WORDS + BINARY_ARCH_BITSTREAM_NUM_BLOCK_WORDS * words[3];
+  /* The top block is the first block, whose children are listed first */
+  const uint64_t* top_block_words = words.data() + BINARY_ARCH_BITSTREAM_NUM_HEADER_WORDS;
+  VTR_ASSERT(2 <= top_block_words[8]);
+  words[child_table_offset + top_block_words[7] + 1] = words[child_table_offset + top_block_words[7]];
+  {
+    std::ofstream fp(TEST_BINARY_FILE_NAME, std::ofstream::binary | std::ofstream::trunc);
+    fp.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+  }
+
+  openfpga::BitstreamManager read_bitstream_manager = build_test_arch_bitstream();
+  if (0 == openfpga::read_binary_architecture_bitstream(read_bitstream_manager, TEST_BINARY_FILE_NAME)) {
+    VTR_LOG_ERROR("A binary file with a duplicated child is accepted!\n");
+    num_err++;
+  }
+  num_err += compare_arch_bitstreams(bitstream_manager, read_bitstream_manager);
+
+  std::remove(TEST_BINARY_FILE_NAME);
+
+  return num_err;
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(argc == 1);
+  VTR_ASSERT(argv != nullptr);
+
+  int num_err = 0;
+
+  int num_case_err = test_binary_arch_bitstream_round_trip();
+  VTR_LOG("Round trip of binary architecture bitstream: %s\n",
+          (0 == num_case_err) ? "passed" : "failed");
+  num_err += num_case_err;
+
+  num_case_err = test_binary_arch_bitstream_duplicated_child();
+  VTR_LOG("Binary architecture bitstream with a duplicated child: %s\n",
+          (0 == num_case_err) ? "passed" : "failed");
+  num_err += num_case_err;
+
+  if (0 < num_err) {
+    VTR_LOG_ERROR("Failed with %d errors!\n", num_err);
+    return 1;
+  }
+  VTR_LOG("All the tests passed!\n");
+  return 0;
+}
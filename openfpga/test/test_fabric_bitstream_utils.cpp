@@ -0,0 +1,372 @@
+/********************************************************************
+ * Unit test functions to validate the reorganization of fabric bitstreams
+ * by addresses, for frame-based and memory bank protocols,
+ * with addresses which are narrower and wider than a 64-bit word.
+ * The result is compared to a reference which groups the bits
+ * directly by their address strings
+ * The leading bits to skip for configuration chains are also checked
+ * on fabric bits which do not follow the configuration bits,
+ * as well as the bit value selected by fast configuration
+ * on configuration chains of several regions
+ *******************************************************************/
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_decode.h"
+
+#include "fabric_bitstream_utils.h"
+#include "fast_configuration.h"
+
+/* A fixed seed so that the test is reproducible */
+constexpr unsigned TEST_RANDOM_SEED = 2021;
+
+/* Reference of a reorganized bitstream: the data inputs of all the regions,
+ * indexed and sorted by address strings
+ */
+typedef std::map<std::string, std::vector<bool>> RefFabricBitstream;
+
+static
+std::vector<char> generate_random_address(std::mt19937& rng,
+                                          const size_t& length,
+                                          const size_t& num_dont_care_bits) {
+  std::vector<char> address(length, '0');
+  for (size_t i = 0; i < length; ++i) {
+    address[i] = (0 == rng() % 2) ? '0' : '1';
+  }
+  for (size_t i = 0; i < num_dont_care_bits; ++i) {
+    address[rng() % length] = openfpga::DONT_CARE_CHAR;
+  }
+  return address;
+}
+
+/* Place a data input to all the addresses covered by don't care bits */
+static
+void add_ref_din(RefFabricBitstream& ref_bitstream,
+                 std::string address,
+                 const size_t& num_regions,
+                 const size_t& region,
+                 const bool& din) {
+  size_t dont_care_pos = address.find(openfpga::DONT_CARE_CHAR);
+  if (std::string::npos != dont_care_pos) {
+    for (const char& bit : {'0', '1'}) {
+      address[dont_care_pos] = bit;
+      add_ref_din(ref_bitstream, address, num_regions, region, din);
+    }
+    return;
+  }
+  auto result = ref_bitstream.insert(std::make_pair(address, std::vector<bool>(num_regions, false)));
+  result.first->second[region] = din;
+}
+
+/********************************************************************
+ * Build a frame-based fabric bitstream with random addresses
+ * (including don't care bits), and check the reorganization against the reference
+ *******************************************************************/
+static
+int test_frame_based_fabric_bitstream(const size_t& addr_length,
+                                      const size_t& num_regions,
+                                      const size_t& num_bits_per_region,
+                                      std::mt19937& rng) {
+  openfpga::FabricBitstream fabric_bitstream;
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_address_length(addr_length);
+
+  RefFabricBitstream ref_bitstream;
+  size_t num_config_bits = 0;
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    openfpga::FabricBitRegionId region = fabric_bitstream.add_region();
+    for (size_t ibit = 0; ibit < num_bits_per_region; ++ibit) {
+      openfpga::FabricBitId bit = fabric_bitstream.add_bit(openfpga::ConfigBitId(num_config_bits++));
+      std::vector<char> address = generate_random_address(rng, addr_length, ibit % 3);
+      bool din = (0 == rng() % 2);
+      fabric_bitstream.set_bit_address(bit, address);
+      fabric_bitstream.set_bit_din(bit, din);
+      fabric_bitstream.add_bit_to_region(region, bit);
+      add_ref_din(ref_bitstream, std::string(address.begin(), address.end()), num_regions, size_t(region), din);
+    }
+  }
+
+  openfpga::FrameFabricBitstream fabric_bits_by_addr = openfpga::build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+  if (ref_bitstream.size() != fabric_bits_by_addr.size()
+     || ref_bitstream.size() != openfpga::find_frame_based_fabric_bitstream_size(fabric_bitstream)) {
+    VTR_LOG_ERROR("Frame-based bitstream with %lu-bit addresses: expect %lu addresses but get %lu!\n",
+                  addr_length, ref_bitstream.size(), fabric_bits_by_addr.size());
+    return 1;
+  }
+
+  size_t num_not_to_skip = 0;
+  size_t iaddr = 0;
+  for (const auto& ref_addr : ref_bitstream) {
+    if ((ref_addr.first != fabric_bits_by_addr[iaddr].first)
+       || (ref_addr.second != fabric_bits_by_addr[iaddr].second)) {
+      VTR_LOG_ERROR("Frame-based bitstream with %lu-bit addresses: mismatch on address '%s'!\n",
+                    addr_length, ref_addr.first.c_str());
+      return 1;
+    }
+    if (false == openfpga::is_fabric_bit_dins_to_skip(ref_addr.second, false)) {
+      num_not_to_skip++;
+    }
+    iaddr++;
+  }
+
+  if (num_not_to_skip != openfpga::find_frame_based_fast_configuration_fabric_bitstream_size(fabric_bitstream, false)) {
+    VTR_LOG_ERROR("Frame-based bitstream with %lu-bit addresses: wrong size for fast configuration!\n",
+                  addr_length);
+    return 1;
+  }
+
+  VTR_LOG("Frame-based bitstream with %lu-bit addresses: %lu addresses are correct\n",
+          addr_length, ref_bitstream.size());
+  return 0;
+}
+
+/********************************************************************
+ * Build a memory bank fabric bitstream with random BL and WL addresses,
+ * and check the reorganization against the reference
+ *******************************************************************/
+static
+int test_memory_bank_fabric_bitstream(const size_t& bl_addr_length,
+                                      const size_t& wl_addr_length,
+                                      const size_t& num_regions,
+                                      const size_t& num_bits_per_region,
+                                      std::mt19937& rng) {
+  openfpga::FabricBitstream fabric_bitstream;
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_use_wl_address(true);
+  fabric_bitstream.set_bl_address_length(bl_addr_length);
+  fabric_bitstream.set_wl_address_length(wl_addr_length);
+
+  /* The BL and WL addresses are separated by a space in the reference,
+   * which sorts before any address bit as the BL addresses have the same length
+   */
+  RefFabricBitstream ref_bitstream;
+  size_t num_config_bits = 0;
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    openfpga::FabricBitRegionId region = fabric_bitstream.add_region();
+    for (size_t ibit = 0; ibit < num_bits_per_region; ++ibit) {
+      openfpga::FabricBitId bit = fabric_bitstream.add_bit(openfpga::ConfigBitId(num_config_bits++));
+      std::vector<char> bl_address = generate_random_address(rng, bl_addr_length, 0);
+      std::vector<char> wl_address = generate_random_address(rng, wl_addr_length, 0);
+      bool din = (0 == rng() % 2);
+      fabric_bitstream.set_bit_bl_address(bit, bl_address);
+      fabric_bitstream.set_bit_wl_address(bit, wl_address);
+      fabric_bitstream.set_bit_din(bit, din);
+      fabric_bitstream.add_bit_to_region(region, bit);
+      add_ref_din(ref_bitstream,
+                  std::string(bl_address.begin(), bl_address.end()) + std::string(" ") + std::string(wl_address.begin(), wl_address.end()),
+                  num_regions, size_t(region), din);
+    }
+  }
+
+  openfpga::MemoryBankFabricBitstream fabric_bits_by_addr = openfpga::build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+  if (ref_bitstream.size() != fabric_bits_by_addr.size()
+     || ref_bitstream.size() != openfpga::find_memory_bank_fabric_bitstream_size(fabric_bitstream)) {
+    VTR_LOG_ERROR("Memory bank bitstream with %lu-bit BL and %lu-bit WL addresses: expect %lu addresses but get %lu!\n",
+                  bl_addr_length, wl_addr_length, ref_bitstream.size(), fabric_bits_by_addr.size());
+    return 1;
+  }
+
+  size_t iaddr = 0;
+  for (const auto& ref_addr : ref_bitstream) {
+    std::string addr = fabric_bits_by_addr[iaddr].first.first + std::string(" ") + fabric_bits_by_addr[iaddr].first.second;
+    if ((ref_addr.first != addr)
+       || (ref_addr.second != fabric_bits_by_addr[iaddr].second)) {
+      VTR_LOG_ERROR("Memory bank bitstream with %lu-bit BL and %lu-bit WL addresses: mismatch on address '%s'!\n",
+                    bl_addr_length, wl_addr_length, ref_addr.first.c_str());
+      return 1;
+    }
+    iaddr++;
+  }
+
+  VTR_LOG("Memory bank bitstream with %lu-bit BL and %lu-bit WL addresses: %lu addresses are correct\n",
+          bl_addr_length, wl_addr_length, ref_bitstream.size());
+  return 0;
+}
+
+/********************************************************************
+ * Build a configuration chain whose fabric bits map to the configuration bits
+ * of a block in a shuffled order, and check the leading bits with a value
+ * against the values read bit by bit in the order of the fabric bits
+ *******************************************************************/
+static
+int test_leading_fabric_bits_with_value(const size_t& num_bits,
+                                        std::mt19937& rng) {
+  openfpga::BitstreamManager bitstream_manager;
+  openfpga::ConfigBlockId block = bitstream_manager.add_block(std::string("fpga_top"));
+  bitstream_manager.add_block_bits(block, std::vector<bool>(num_bits, false));
+
+  /* Swap two configuration bits in the middle, while keeping the ends in order */
+  std::vector<size_t> config_bit_order(num_bits);
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    config_bit_order[ibit] = ibit;
+  }
+  size_t swapped_bit = 1 + rng() % (num_bits - 3);
+  std::swap(config_bit_order[swapped_bit], config_bit_order[swapped_bit + 1]);
+  /* The second bit of the swapped pair is read first in the order of fabric bits */
+  bitstream_manager.set_bit_value(openfpga::ConfigBitId(swapped_bit + 1), true);
+
+  openfpga::FabricBitstream fabric_bitstream;
+  std::vector<openfpga::FabricBitId> fabric_bits;
+  for (const size_t& config_bit : config_bit_order) {
+    fabric_bits.push_back(fabric_bitstream.add_bit(openfpga::ConfigBitId(config_bit)));
+  }
+
+  size_t ref_num_bits = 0;
+  while (false == bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bits[ref_num_bits]))) {
+    ref_num_bits++;
+  }
+
+  size_t num_leading_bits = openfpga::find_fabric_bitstream_leading_bits_with_value(fabric_bitstream, bitstream_manager,
+                                                                                   fabric_bits, false);
+  if (ref_num_bits != num_leading_bits) {
+    VTR_LOG_ERROR("Configuration chain of %lu bits: expect %lu leading bits to skip but get %lu!\n",
+                  num_bits, ref_num_bits, num_leading_bits);
+    return 1;
+  }
+
+  VTR_LOG("Configuration chain of %lu bits: %lu leading bits to skip are correct\n",
+          num_bits, num_leading_bits);
+  return 0;
+}
+
+/********************************************************************
+ * Build a configuration chain with a regional bitstream of given values
+ * in each region, and check the number of bits to skip for each value
+ * as well as the value selected by fast configuration
+ * against a reference, which aligns the regional bitstreams to the longest one:
+ * the bits before a shorter regional bitstream can take any value,
+ * and the bits to skip are limited by the region with the fewest leading bits
+ *******************************************************************/
+static
+int test_config_chain_fast_configuration(const std::vector<std::vector<bool>>& regional_values) {
+  openfpga::BitstreamManager bitstream_manager;
+  openfpga::ConfigBlockId block = bitstream_manager.add_block(std::string("fpga_top"));
+  openfpga::FabricBitstream fabric_bitstream;
+
+  size_t num_config_bits = 0;
+  size_t max_regional_size = 0;
+  std::vector<bool> block_values;
+  for (const std::vector<bool>& values : regional_values) {
+    block_values.insert(block_values.end(), values.begin(), values.end());
+  }
+  bitstream_manager.add_block_bits(block, block_values);
+  for (const std::vector<bool>& values : regional_values) {
+    openfpga::FabricBitRegionId region = fabric_bitstream.add_region();
+    for (size_t ibit = 0; ibit < values.size(); ++ibit) {
+      fabric_bitstream.add_bit_to_region(region, fabric_bitstream.add_bit(openfpga::ConfigBitId(num_config_bits++)));
+    }
+    max_regional_size = std::max(max_regional_size, values.size());
+  }
+
+  /* Both reset and set ports are defined for programming, so that the bit value to skip is selected */
+  openfpga::FabricGlobalPortInfo global_ports;
+  for (const bool& is_set : {false, true}) {
+    FabricGlobalPortId global_port = global_ports.create_global_port(openfpga::ModulePortId(size_t(is_set)));
+    global_ports.set_global_port_is_prog(global_port, true);
+    global_ports.set_global_port_is_set(global_port, is_set);
+    global_ports.set_global_port_is_reset(global_port, !is_set);
+  }
+
+  int num_errors = 0;
+  std::map<bool, size_t> ref_num_bits_to_skip;
+  for (const bool& value : {false, true}) {
+    ref_num_bits_to_skip[value] = max_regional_size;
+    for (const std::vector<bool>& values : regional_values) {
+      size_t num_region_bits = max_regional_size - values.size();
+      while ((num_region_bits < max_regional_size)
+          && (value == values[num_region_bits + values.size() - max_regional_size])) {
+        num_region_bits++;
+      }
+      ref_num_bits_to_skip[value] = std::min(ref_num_bits_to_skip[value], num_region_bits);
+    }
+    size_t num_bits_to_skip = openfpga::find_configuration_chain_fabric_bitstream_size_to_be_skipped(fabric_bitstream, bitstream_manager, value);
+    if (ref_num_bits_to_skip[value] != num_bits_to_skip) {
+      VTR_LOG_ERROR("Configuration chain of %lu regions: expect %lu bits of '%d' to skip but get %lu!\n",
+                    regional_values.size(), ref_num_bits_to_skip[value], value, num_bits_to_skip);
+      num_errors++;
+    }
+  }
+
+  /* Zeros are preferred when the same number of bits are skipped */
+  bool ref_bit_value_to_skip = (ref_num_bits_to_skip[true] > ref_num_bits_to_skip[false]);
+  bool bit_value_to_skip = openfpga::find_bit_value_to_skip_for_fast_configuration(CONFIG_MEM_SCAN_CHAIN, global_ports,
+                                                                                  bitstream_manager, fabric_bitstream);
+  if (ref_bit_value_to_skip != bit_value_to_skip) {
+    VTR_LOG_ERROR("Configuration chain of %lu regions: expect to skip bits of '%d' but get '%d'!\n",
+                  regional_values.size(), ref_bit_value_to_skip, bit_value_to_skip);
+    num_errors++;
+  }
+
+  if (0 == num_errors) {
+    VTR_LOG("Configuration chain of %lu regions: skipping %lu bits of '%d' is correct\n",
+            regional_values.size(), ref_num_bits_to_skip[bit_value_to_skip], bit_value_to_skip);
+  }
+  return num_errors;
+}
+
+static
+std::vector<std::vector<bool>> generate_random_regional_values(std::mt19937& rng,
+                                                              const size_t& num_regions,
+                                                              const size_t& max_num_bits_per_region) {
+  std::vector<std::vector<bool>> regional_values(num_regions);
+  for (std::vector<bool>& values : regional_values) {
+    values.resize(1 + rng() % max_num_bits_per_region);
+    /* A leading run of the same value, followed by random values */
+    bool leading_value = (0 == rng() % 2);
+    size_t num_leading_bits = rng() % values.size();
+    for (size_t ibit = 0; ibit < values.size(); ++ibit) {
+      values[ibit] = (ibit < num_leading_bits) ? leading_value : (0 == rng() % 2);
+    }
+  }
+  return regional_values;
+}
+
+int main(int argc, const char** argv) {
+  /* This test does not require any argument */
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  std::mt19937 rng(TEST_RANDOM_SEED);
+
+  int num_errors = 0;
+  /* Addresses of a single word, with a flat lookup table and a hash table respectively,
+   * and addresses on the word boundary and wider
+   */
+  for (const size_t& addr_length : std::vector<size_t>{4, 20, 63, 64, 65, 70, 130}) {
+    num_errors += test_frame_based_fabric_bitstream(addr_length, 3, 200, rng);
+  }
+  /* BL and WL addresses whose concatenation is wider than a word */
+  for (const auto& addr_lengths : std::vector<std::pair<size_t, size_t>>{{3, 4}, {30, 33}, {32, 32}, {40, 40}, {70, 5}}) {
+    num_errors += test_memory_bank_fabric_bitstream(addr_lengths.first, addr_lengths.second, 3, 200, rng);
+  }
+  /* Shuffled bits within a word and across words */
+  for (const size_t& num_bits : std::vector<size_t>{8, 64, 200}) {
+    num_errors += test_leading_fabric_bits_with_value(num_bits, rng);
+  }
+
+  /* The first region is all zeros and shorter than the second one, which starts with ones:
+   * no zero can be skipped on the second region, while ones can be skipped on both regions
+   */
+  num_errors += test_config_chain_fast_configuration({{false, false, false, false},
+                                                      {true, true, true, true, true, false}});
+  for (const size_t& num_regions : std::vector<size_t>{1, 2, 4}) {
+    for (size_t itest = 0; itest < 10; ++itest) {
+      num_errors += test_config_chain_fast_configuration(generate_random_regional_values(rng, num_regions, 20));
+    }
+  }
+
+  if (0 != num_errors) {
+    VTR_LOG_ERROR("%d tests failed!\n", num_errors);
+    return 1;
+  }
+
+  VTR_LOG("All the tests passed\n");
+  return 0;
+}
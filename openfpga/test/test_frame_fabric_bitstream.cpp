@@ -0,0 +1,357 @@
+/********************************************************************
+ * Unit test functions to validate the fabric-dependent bitstream
+ * of frame-based configuration protocol:
+ * the addresses built from the local addresses cached per module
+ * should be the same as those built by walking down every instance
+ * in the hierarchy, which is how the addresses were built originally
+ *******************************************************************/
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_decode.h"
+#include "openfpga_reserved_words.h"
+
+#include "openfpga_naming.h"
+#include "build_fabric_bitstream.h"
+
+/* A configuration bit and its address in a region, as the reference builder finds */
+struct RefFrameBit {
+  openfpga::ConfigBitId config_bit;
+  std::vector<char> address;
+};
+
+/********************************************************************
+ * Reference builder: walk through all the configurable children
+ * under a module in a recursive way, adding the address bits
+ * of each level to the address code, without any cache
+ *******************************************************************/
+static
+void rec_build_ref_frame_bitstream(const openfpga::BitstreamManager& bitstream_manager,
+                                   const openfpga::ConfigBlockId& parent_block,
+                                   const openfpga::ModuleManager& module_manager,
+                                   const openfpga::ModuleId& top_module,
+                                   const openfpga::ConfigRegionId& config_region,
+                                   const openfpga::ModuleId& parent_module,
+                                   const std::vector<char>& addr_code,
+                                   const char& bitstream_dont_care_char,
+                                   std::vector<RefFrameBit>& ref_bits) {
+  std::vector<openfpga::ModuleId> configurable_children;
+  std::vector<size_t> configurable_child_instances;
+  if (top_module == parent_module) {
+    configurable_children = module_manager.region_configurable_children(parent_module, config_region);
+    configurable_child_instances = module_manager.region_configurable_child_instances(parent_module, config_region);
+  } else {
+    configurable_children = module_manager.configurable_children(parent_module);
+    configurable_child_instances = module_manager.configurable_child_instances(parent_module);
+  }
+
+  /* Leaf node: the address comes from the decoder inside, which is the last of configurable children */
+  if (0 == bitstream_manager.block_children(parent_block).size()) {
+    openfpga::ModuleId decoder_module = configurable_children.back();
+    openfpga::ModulePortId decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+    openfpga::BasicPort decoder_addr_port = module_manager.module_port(decoder_module, decoder_addr_port_id);
+    for (size_t ibit = 0; ibit < bitstream_manager.block_bits(parent_block).size(); ++ibit) {
+      std::vector<char> bit_addr_code = addr_code;
+      std::vector<char> addr_bits_vec = openfpga::itobin_charvec(ibit, decoder_addr_port.get_width());
+      bit_addr_code.insert(bit_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
+      ref_bits.push_back({bitstream_manager.block_bits(parent_block)[ibit], bit_addr_code});
+    }
+    return;
+  }
+
+  size_t num_configurable_children = configurable_children.size();
+  size_t max_child_addr_code_size = 0;
+  bool add_addr_code = true;
+  openfpga::ModuleId decoder_module = openfpga::ModuleId::INVALID();
+
+  if (0 == num_configurable_children) {
+    return;
+  }
+
+  if (1 == num_configurable_children) {
+    add_addr_code = false;
+  } else {
+    num_configurable_children--;
+    decoder_module = configurable_children.back();
+    for (const openfpga::ModuleId& child_module : module_manager.configurable_children(parent_module)) {
+      if (module_manager.configurable_children(child_module).empty()) {
+        continue;
+      }
+      openfpga::ModulePortId child_addr_port_id = module_manager.find_module_port(child_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+      max_child_addr_code_size = std::max(module_manager.module_port(child_module, child_addr_port_id).get_width(), max_child_addr_code_size);
+    }
+  }
+
+  for (size_t child_id = 0; child_id < num_configurable_children; ++child_id) {
+    openfpga::ModuleId child_module = configurable_children[child_id];
+    std::string instance_name = module_manager.instance_name(parent_module, child_module, configurable_child_instances[child_id]);
+    openfpga::ConfigBlockId child_block = bitstream_manager.find_child_block(parent_block, instance_name);
+    VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
+
+    std::vector<char> child_addr_code = addr_code;
+    if (true == add_addr_code) {
+      openfpga::ModulePortId decoder_addr_port_id = module_manager.find_module_port(decoder_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+      std::vector<char> addr_bits_vec = openfpga::itobin_charvec(child_id, module_manager.module_port(decoder_module, decoder_addr_port_id).get_width());
+      /* The child address is added to the tail at the top-level and to the head elsewhere */
+      if (top_module == parent_module) {
+        child_addr_code.insert(child_addr_code.end(), addr_bits_vec.begin(), addr_bits_vec.end());
+      } else {
+        child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(), addr_bits_vec.end());
+      }
+      openfpga::ModulePortId child_addr_port_id = module_manager.find_module_port(child_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+      size_t child_addr_size = module_manager.module_port(child_module, child_addr_port_id).get_width();
+      std::vector<char> dummy_codes(max_child_addr_code_size - child_addr_size, bitstream_dont_care_char);
+      child_addr_code.insert(child_addr_code.begin(), dummy_codes.begin(), dummy_codes.end());
+    }
+
+    rec_build_ref_frame_bitstream(bitstream_manager, child_block,
+                                  module_manager, top_module, config_region, child_module,
+                                  child_addr_code, bitstream_dont_care_char,
+                                  ref_bits);
+  }
+}
+
+/********************************************************************
+ * Multi-level frame-based fabric under test:
+ *   - Memory modules with their decoders inside and a number of bits
+ *   - Tiles whose configurable children are memory modules and a decoder,
+ *     where the memory modules have different address sizes
+ *   - A tile with a single memory module and no decoder
+ *   - A top-level module with two regions, each of which has a decoder,
+ *     where the address sizes of the decoders are different
+ * The tiles and the memory modules are instanciated several times,
+ * so that the cached local addresses are reused
+ *******************************************************************/
+struct TestFrameFabric {
+  openfpga::ModuleManager module_manager;
+  openfpga::BitstreamManager bitstream_manager;
+  openfpga::ModuleId top_module;
+  openfpga::ConfigBlockId top_block;
+  size_t num_bits = 0;
+};
+
+static
+openfpga::ModuleId add_test_frame_module(openfpga::ModuleManager& module_manager,
+                                         const std::string& name,
+                                         const size_t& addr_size) {
+  openfpga::ModuleId module = module_manager.add_module(name);
+  module_manager.add_port(module, openfpga::BasicPort(std::string(openfpga::DECODER_ADDRESS_PORT_NAME), addr_size), openfpga::ModuleManager::MODULE_INPUT_PORT);
+  return module;
+}
+
+/* Add a configurable child to a module, with a unique instance name */
+static
+void add_test_frame_child(openfpga::ModuleManager& module_manager,
+                          const openfpga::ModuleId& parent_module,
+                          const openfpga::ModuleId& child_module) {
+  size_t child_instance = module_manager.num_instance(parent_module, child_module);
+  module_manager.add_child_module(parent_module, child_module);
+  module_manager.set_child_instance_name(parent_module, child_module, child_instance,
+                                         module_manager.module_name(child_module) + std::string("_") + std::to_string(child_instance) + std::string("_"));
+  module_manager.add_configurable_child(parent_module, child_module, child_instance);
+}
+
+/* Add a memory module with the decoder inside */
+static
+openfpga::ModuleId add_test_frame_memory(openfpga::ModuleManager& module_manager,
+                                         const std::string& name,
+                                         const size_t& addr_size) {
+  openfpga::ModuleId mem_module = add_test_frame_module(module_manager, name, addr_size);
+  add_test_frame_child(module_manager, mem_module, add_test_frame_module(module_manager, std::string("decoder_") + name, addr_size));
+  return mem_module;
+}
+
+/********************************************************************
+ * Build the blocks under a block, one for each configurable child
+ * other than decoders, named by the instance names.
+ * A memory module, whose only configurable child is a decoder, has bits
+ *******************************************************************/
+static
+void rec_build_test_frame_blocks(TestFrameFabric& fabric,
+                                 const openfpga::ModuleId& parent_module,
+                                 const openfpga::ConfigBlockId& parent_block) {
+  const std::vector<openfpga::ModuleId>& configurable_children = fabric.module_manager.configurable_children(parent_module);
+  const std::vector<size_t>& configurable_child_instances = fabric.module_manager.configurable_child_instances(parent_module);
+
+  if ( (1 == configurable_children.size())
+    && (true == fabric.module_manager.configurable_children(configurable_children[0]).empty()) ) {
+    /* Leave the last address unused, as a memory module whose size is not a power of 2 does */
+    openfpga::ModulePortId addr_port_id = fabric.module_manager.find_module_port(parent_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+    size_t num_block_bits = (size_t(1) << fabric.module_manager.module_port(parent_module, addr_port_id).get_width()) - 1;
+    std::vector<bool> block_bits;
+    for (size_t ibit = 0; ibit < num_block_bits; ++ibit) {
+      block_bits.push_back(0 == (fabric.num_bits + ibit) % 3);
+    }
+    fabric.bitstream_manager.add_block_bits(parent_block, block_bits);
+    fabric.num_bits += block_bits.size();
+    return;
+  }
+
+  for (size_t ichild = 0; ichild < configurable_children.size(); ++ichild) {
+    /* Bypass any decoder module (which no configurable children */
+    if (true == fabric.module_manager.configurable_children(configurable_children[ichild]).empty()) {
+      continue;
+    }
+    openfpga::ConfigBlockId child_block = fabric.bitstream_manager.add_block(fabric.module_manager.instance_name(parent_module, configurable_children[ichild], configurable_child_instances[ichild]));
+    fabric.bitstream_manager.add_child_block(parent_block, child_block);
+    rec_build_test_frame_blocks(fabric, configurable_children[ichild], child_block);
+  }
+}
+
+static
+void build_test_frame_fabric(TestFrameFabric& fabric) {
+  openfpga::ModuleManager& module_manager = fabric.module_manager;
+
+  /* Memory modules with 2-bit and 3-bit addresses */
+  openfpga::ModuleId mem_a = add_test_frame_memory(module_manager, "mem_a", 2);
+  openfpga::ModuleId mem_b = add_test_frame_memory(module_manager, "mem_b", 3);
+
+  /* A tile with memory modules of different address sizes and a decoder */
+  openfpga::ModuleId tile = add_test_frame_module(module_manager, "tile", 5);
+  add_test_frame_child(module_manager, tile, mem_a);
+  add_test_frame_child(module_manager, tile, mem_b);
+  add_test_frame_child(module_manager, tile, mem_a);
+  add_test_frame_child(module_manager, tile, add_test_frame_module(module_manager, "decoder_tile", 2));
+
+  /* A tile with a single memory module and no decoder */
+  openfpga::ModuleId small_tile = add_test_frame_module(module_manager, "small_tile", 2);
+  add_test_frame_child(module_manager, small_tile, mem_a);
+
+  /* Region 0: tile, tile, small_tile with a 2-bit decoder
+   * Region 1: tile, small_tile with a 1-bit decoder
+   */
+  fabric.top_module = add_test_frame_module(module_manager, openfpga::generate_fpga_top_module_name(), 7);
+  std::vector<std::vector<openfpga::ModuleId>> region_children = {
+    {tile, tile, small_tile, add_test_frame_module(module_manager, "decoder_region0", 2)},
+    {tile, small_tile, add_test_frame_module(module_manager, "decoder_region1", 1)}
+  };
+  for (const std::vector<openfpga::ModuleId>& children : region_children) {
+    openfpga::ConfigRegionId config_region = module_manager.add_config_region(fabric.top_module);
+    for (const openfpga::ModuleId& child_module : children) {
+      size_t config_child_id = module_manager.configurable_children(fabric.top_module).size();
+      add_test_frame_child(module_manager, fabric.top_module, child_module);
+      module_manager.add_configurable_child_to_region(fabric.top_module, config_region, child_module,
+                                                      module_manager.configurable_child_instances(fabric.top_module)[config_child_id],
+                                                      config_child_id);
+    }
+  }
+
+  fabric.top_block = fabric.bitstream_manager.add_block(openfpga::generate_fpga_top_module_name());
+  rec_build_test_frame_blocks(fabric, fabric.top_module, fabric.top_block);
+}
+
+static
+int test_frame_fabric_bitstream(const size_t& num_threads) {
+  int num_err = 0;
+
+  TestFrameFabric fabric;
+  build_test_frame_fabric(fabric);
+
+  ConfigProtocol config_protocol;
+  config_protocol.set_type(CONFIG_MEM_FRAME_BASED);
+  config_protocol.set_num_regions(fabric.module_manager.regions(fabric.top_module).size());
+
+  openfpga::FabricBitstream fabric_bitstream = openfpga::build_fabric_dependent_bitstream(fabric.bitstream_manager,
+                                                                                         fabric.module_manager,
+                                                                                         config_protocol,
+                                                                                         num_threads,
+                                                                                         false);
+
+  if (fabric.num_bits != fabric_bitstream.num_bits()) {
+    VTR_LOG_ERROR("Expect %lu fabric bits but %lu are built!\n",
+                  fabric.num_bits, fabric_bitstream.num_bits());
+    num_err++;
+  }
+
+  /* Build the reference region by region, in the same way as the fabric bitstream */
+  const openfpga::ModuleId& top_module = fabric.top_module;
+  const openfpga::ConfigBlockId& top_block = fabric.top_block;
+  size_t max_decoder_addr_size = 0;
+  for (const openfpga::ConfigRegionId& config_region : fabric.module_manager.regions(top_module)) {
+    openfpga::ModuleId decoder_module = fabric.module_manager.region_configurable_children(top_module, config_region).back();
+    openfpga::ModulePortId decoder_addr_port_id = fabric.module_manager.find_module_port(decoder_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+    max_decoder_addr_size = std::max(max_decoder_addr_size, fabric.module_manager.module_port(decoder_module, decoder_addr_port_id).get_width());
+  }
+
+  std::vector<openfpga::FabricBitRegionId> fabric_regions(fabric_bitstream.regions().begin(), fabric_bitstream.regions().end());
+  if (fabric_regions.size() != fabric.module_manager.regions(top_module).size()) {
+    VTR_LOG_ERROR("Expect %lu fabric bitstream regions but %lu are built!\n",
+                  fabric.module_manager.regions(top_module).size(), fabric_regions.size());
+    return num_err + 1;
+  }
+
+  size_t num_dont_care_bits = 0;
+  size_t iregion = 0;
+  for (const openfpga::ConfigRegionId& config_region : fabric.module_manager.regions(top_module)) {
+    openfpga::ModuleId decoder_module = fabric.module_manager.region_configurable_children(top_module, config_region).back();
+    openfpga::ModulePortId decoder_addr_port_id = fabric.module_manager.find_module_port(decoder_module, std::string(openfpga::DECODER_ADDRESS_PORT_NAME));
+    std::vector<char> idle_addr_bits(max_decoder_addr_size - fabric.module_manager.module_port(decoder_module, decoder_addr_port_id).get_width(), openfpga::DONT_CARE_CHAR);
+
+    std::vector<RefFrameBit> ref_bits;
+    rec_build_ref_frame_bitstream(fabric.bitstream_manager, top_block,
+                                  fabric.module_manager, top_module, config_region, top_module,
+                                  idle_addr_bits, openfpga::DONT_CARE_CHAR,
+                                  ref_bits);
+
+    const std::vector<openfpga::FabricBitId>& region_bits = fabric_bitstream.region_bits(fabric_regions[iregion]);
+    if (ref_bits.size() != region_bits.size()) {
+      VTR_LOG_ERROR("Expect %lu fabric bits in region %lu but %lu are built!\n",
+                    ref_bits.size(), iregion, region_bits.size());
+      num_err++;
+      iregion++;
+      continue;
+    }
+    for (size_t ibit = 0; ibit < ref_bits.size(); ++ibit) {
+      const openfpga::FabricBitId& fabric_bit = region_bits[ibit];
+      std::vector<char> address = fabric_bitstream.bit_address(fabric_bit);
+      num_dont_care_bits += std::count(address.begin(), address.end(), openfpga::DONT_CARE_CHAR);
+      if ( (ref_bits[ibit].config_bit != fabric_bitstream.config_bit(fabric_bit))
+        || (ref_bits[ibit].address != address)
+        || (fabric.bitstream_manager.bit_value(ref_bits[ibit].config_bit) != fabric_bitstream.bit_din(fabric_bit)) ) {
+        VTR_LOG_ERROR("Fabric bit %lu in region %lu is '%s' for configuration bit %lu while the reference is '%s' for configuration bit %lu!\n",
+                      ibit, iregion,
+                      std::string(address.begin(), address.end()).c_str(),
+                      size_t(fabric_bitstream.config_bit(fabric_bit)),
+                      std::string(ref_bits[ibit].address.begin(), ref_bits[ibit].address.end()).c_str(),
+                      size_t(ref_bits[ibit].config_bit));
+        num_err++;
+      }
+    }
+    iregion++;
+  }
+
+  /* The fabric under test is meaningful only if there are dummy codes in the addresses */
+  if (0 == num_dont_care_bits) {
+    VTR_LOG_ERROR("Expect don't care bits in the addresses but none is found!\n");
+    num_err++;
+  }
+
+  return num_err;
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(argc == 1);
+  VTR_ASSERT(argv != nullptr);
+
+  int num_err = 0;
+  for (const size_t& num_threads : {1, 2}) {
+    int num_case_err = test_frame_fabric_bitstream(num_threads);
+    VTR_LOG("Building frame-based fabric bitstream with %lu threads: %s\n",
+            num_threads,
+            (0 == num_case_err) ? "passed" : "failed");
+    num_err += num_case_err;
+  }
+
+  if (0 < num_err) {
+    VTR_LOG_ERROR("Failed with %d errors!\n", num_err);
+    return 1;
+  }
+  VTR_LOG("All the tests passed!\n");
+  return 0;
+}
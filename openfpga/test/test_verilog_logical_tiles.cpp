@@ -0,0 +1,195 @@
+/********************************************************************
+ * Unit test functions to validate that the Verilog netlists of
+ * logical tiles are written once for each module:
+ * the pb_types which are merged into an identical module
+ * (see build_fabric --merge_identical_grid_modules) are skipped
+ * with their children, while the other pb_types are all written
+ *******************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+#include "openfpga_naming.h"
+#include "verilog_constants.h"
+#include "verilog_grid.h"
+
+/* Names of the top-level pb_types of the logical tiles under test */
+static const std::vector<std::string> TEST_TILE_NAMES = {"clb_a", "clb_b"};
+static const char* TEST_MODE_NAME = "physical";
+static const char* TEST_PRIMITIVE_NAME = "ff";
+
+/* A logical tile: a top-level pb_type with a physical mode,
+ * which contains a single primitive
+ */
+struct TestLogicalTile {
+  t_pb_type top_pb_type;
+  t_mode physical_mode;
+  t_pb_type primitive_pb_type;
+
+  t_pb_graph_node top_node;
+  t_pb_graph_node primitive_node;
+  t_pb_graph_node* primitive_nodes;
+  t_pb_graph_node** mode_children;
+};
+
+static
+void build_test_logical_tile(TestLogicalTile& tile,
+                             const std::string& name,
+                             openfpga::VprDeviceAnnotation& device_annotation) {
+  tile.top_pb_type.name = const_cast<char*>(name.c_str());
+  tile.top_pb_type.num_pb = 1;
+  tile.top_pb_type.modes = &tile.physical_mode;
+  tile.top_pb_type.num_modes = 1;
+
+  tile.physical_mode.name = const_cast<char*>(TEST_MODE_NAME);
+  tile.physical_mode.pb_type_children = &tile.primitive_pb_type;
+  tile.physical_mode.num_pb_type_children = 1;
+  tile.physical_mode.parent_pb_type = &tile.top_pb_type;
+  tile.physical_mode.index = 0;
+
+  tile.primitive_pb_type.name = const_cast<char*>(TEST_PRIMITIVE_NAME);
+  tile.primitive_pb_type.num_pb = 1;
+  tile.primitive_pb_type.parent_mode = &tile.physical_mode;
+
+  tile.top_node = t_pb_graph_node();
+  tile.top_node.pb_type = &tile.top_pb_type;
+  tile.primitive_node = t_pb_graph_node();
+  tile.primitive_node.pb_type = &tile.primitive_pb_type;
+  tile.primitive_node.parent_pb_graph_node = &tile.top_node;
+  tile.primitive_nodes = &tile.primitive_node;
+  tile.mode_children = &tile.primitive_nodes;
+  tile.top_node.child_pb_graph_nodes = &tile.mode_children;
+
+  device_annotation.add_pb_type_physical_mode(&tile.top_pb_type, &tile.physical_mode);
+}
+
+/* Build the modules of a logical tile, which is the parent of its primitive */
+static
+void build_test_logical_tile_modules(openfpga::ModuleManager& module_manager,
+                                     TestLogicalTile& tile) {
+  openfpga::ModuleId primitive_module = module_manager.add_module(openfpga::generate_physical_block_module_name(&tile.primitive_pb_type));
+  module_manager.add_port(primitive_module, openfpga::BasicPort("Q", 1), openfpga::ModuleManager::MODULE_OUTPUT_PORT);
+  openfpga::ModuleId top_module = module_manager.add_module(openfpga::generate_physical_block_module_name(&tile.top_pb_type));
+  module_manager.add_port(top_module, openfpga::BasicPort("O", 1), openfpga::ModuleManager::MODULE_OUTPUT_PORT);
+  module_manager.add_child_module(top_module, primitive_module);
+}
+
+static
+std::vector<std::string> test_netlist_names(TestLogicalTile& tile) {
+  return {openfpga::generate_logical_tile_netlist_name(std::string(), &tile.primitive_node, std::string(VERILOG_NETLIST_FILE_POSTFIX)),
+          openfpga::generate_logical_tile_netlist_name(std::string(), &tile.top_node, std::string(VERILOG_NETLIST_FILE_POSTFIX))};
+}
+
+static
+bool file_exists(const std::string& fname) {
+  std::ifstream fp(fname);
+  return fp.good();
+}
+
+/********************************************************************
+ * Write the netlists of two identical logical tiles, whose modules
+ * are merged or not, and check which netlists are written
+ *******************************************************************/
+static
+int test_print_verilog_logical_tiles(const bool& merge_modules) {
+  int num_err = 0;
+
+  openfpga::VprDeviceAnnotation device_annotation;
+  std::vector<TestLogicalTile> tiles(TEST_TILE_NAMES.size());
+  std::vector<t_pb_graph_node*> pb_graph_heads;
+  for (size_t itile = 0; itile < tiles.size(); ++itile) {
+    build_test_logical_tile(tiles[itile], TEST_TILE_NAMES[itile], device_annotation);
+    pb_graph_heads.push_back(&(tiles[itile].top_node));
+    for (const std::string& fname : test_netlist_names(tiles[itile])) {
+      std::remove(fname.c_str());
+    }
+  }
+
+  openfpga::ModuleManager module_manager;
+  for (TestLogicalTile& tile : tiles) {
+    build_test_logical_tile_modules(module_manager, tile);
+  }
+
+  if (true == merge_modules) {
+    /* Merge the second tile into the first one, as build_fabric does:
+     * the parent uses the target child module before its children are merged
+     */
+    openfpga::ModuleId top_module = module_manager.find_module(openfpga::generate_physical_block_module_name(&tiles[1].top_pb_type));
+    openfpga::ModuleId primitive_module = module_manager.find_module(openfpga::generate_physical_block_module_name(&tiles[1].primitive_pb_type));
+    openfpga::ModuleId target_top_module = module_manager.find_module(openfpga::generate_physical_block_module_name(&tiles[0].top_pb_type));
+    openfpga::ModuleId target_primitive_module = module_manager.find_module(openfpga::generate_physical_block_module_name(&tiles[0].primitive_pb_type));
+    module_manager.replace_child_module(top_module, primitive_module, target_primitive_module);
+    module_manager.set_module_alias(primitive_module, target_primitive_module);
+    module_manager.set_module_alias(top_module, target_top_module);
+  }
+
+  openfpga::NetlistManager netlist_manager;
+  openfpga::FabricVerilogOption options;
+  size_t num_written_modules = openfpga::print_verilog_logical_tiles(netlist_manager,
+                                                                     module_manager,
+                                                                     device_annotation,
+                                                                     std::string(),
+                                                                     pb_graph_heads,
+                                                                     options,
+                                                                     false);
+
+  /* Only the first tile is written when the modules are merged */
+  size_t num_written_tiles = (true == merge_modules) ? 1 : tiles.size();
+  if (2 * num_written_tiles != num_written_modules) {
+    VTR_LOG_ERROR("Expect %lu modules to be written but %lu are written!\n",
+                  2 * num_written_tiles, num_written_modules);
+    num_err++;
+  }
+  if (2 * num_written_tiles != netlist_manager.netlists().size()) {
+    VTR_LOG_ERROR("Expect %lu netlists to be listed but %lu are listed!\n",
+                  2 * num_written_tiles, netlist_manager.netlists().size());
+    num_err++;
+  }
+  for (size_t itile = 0; itile < tiles.size(); ++itile) {
+    for (const std::string& fname : test_netlist_names(tiles[itile])) {
+      bool expect_written = (itile < num_written_tiles);
+      if (expect_written != file_exists(fname)) {
+        VTR_LOG_ERROR("Netlist '%s' is %s while it is expected %s!\n",
+                      fname.c_str(),
+                      file_exists(fname) ? "written" : "not written",
+                      expect_written ? "to be written" : "to be skipped");
+        num_err++;
+      }
+      if (expect_written != netlist_manager.valid_netlist_id(netlist_manager.find_netlist(fname))) {
+        VTR_LOG_ERROR("Netlist '%s' is wrongly %s in the netlist manager!\n",
+                      fname.c_str(),
+                      expect_written ? "missing" : "listed");
+        num_err++;
+      }
+      std::remove(fname.c_str());
+    }
+  }
+
+  return num_err;
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(argc == 1);
+  VTR_ASSERT(argv != nullptr);
+
+  int num_err = 0;
+  for (const bool& merge_modules : {false, true}) {
+    int num_case_err = test_print_verilog_logical_tiles(merge_modules);
+    VTR_LOG("Writing logical tiles with %s modules: %s\n",
+            merge_modules ? "merged" : "distinct",
+            (0 == num_case_err) ? "passed" : "failed");
+    num_err += num_case_err;
+  }
+
+  if (0 < num_err) {
+    VTR_LOG_ERROR("Failed with %d errors!\n", num_err);
+    return 1;
+  }
+  VTR_LOG("All the tests passed!\n");
+  return 0;
+}
@@ -17,6 +17,7 @@ run-task basic_tests/full_testbench/configuration_chain_use_setb --debug --show_
 run-task basic_tests/full_testbench/configuration_chain_use_set_reset --debug --show_thread_logs
 run-task basic_tests/full_testbench/configuration_chain_config_enable_scff --debug --show_thread_logs
 run-task basic_tests/full_testbench/multi_region_configuration_chain --debug --show_thread_logs
+run-task basic_tests/full_testbench/balanced_multi_region_configuration_chain --debug --show_thread_logs
 run-task basic_tests/full_testbench/fast_configuration_chain --debug --show_thread_logs
 run-task basic_tests/full_testbench/fast_configuration_chain_use_set --debug --show_thread_logs
 run-task basic_tests/full_testbench/smart_fast_configuration_chain --debug --show_thread_logs
@@ -20,6 +20,9 @@ run-task fpga_bitstream/generate_bitstream/device_96x96 --debug --show_thread_lo
 echo -e "Testing loading architecture bitstream from an external file";
 run-task fpga_bitstream/load_external_architecture_bitstream --debug --show_thread_logs
 
+echo -e "Testing comparing and patching architecture bitstream with the one of another design";
+run-task fpga_bitstream/diff_architecture_bitstream --debug --show_thread_logs
+
 echo -e "Testing repacker capability in identifying wire LUTs";
 run-task fpga_bitstream/repack_wire_lut --debug --show_thread_logs
 
@@ -115,11 +115,16 @@ run-task fpga_verilog/verilog_netlist_formats/implicit_verilog_default_nettype_w
 echo -e "Testing explicit Verilog generation";
 run-task fpga_verilog/verilog_netlist_formats/explicit_port_mapping_default_nettype_wire --debug --show_thread_logs
 
+echo -e "Testing Verilog generation with compact top-level module, against the flat one on the same fabric and designs";
+run-task fpga_verilog/top_module_formats/flat_top_module --debug --show_thread_logs
+run-task fpga_verilog/top_module_formats/compact_top_module --debug --show_thread_logs
+
 echo -e "Testing Verilog generation with flatten routing modules";
 run-task fpga_verilog/flatten_routing --debug --show_thread_logs
 
 echo -e "Testing Verilog generation with duplicated grid output pins";
 run-task fpga_verilog/duplicated_grid_pin --debug --show_thread_logs
+run-task fpga_verilog/duplicated_grid_pin_io --debug --show_thread_logs
 
 echo -e "Testing Verilog generation with spy output pads";
 run-task fpga_verilog/spypad --debug --show_thread_logs
@@ -0,0 +1,31 @@
+#!/bin/bash
+
+set -e
+source openfpga.sh
+PYTHON_EXEC=python3.8
+###############################################
+# OpenFPGA Shell with VPR8
+##############################################
+echo -e "Scalability regression tests";
+
+echo -e "Testing fabric generation of large devices with configuration chain";
+run-task scalability/scan_chain/compress_routing --debug --show_thread_logs
+run-task scalability/scan_chain/flatten_routing --debug --show_thread_logs
+
+echo -e "Testing fabric generation of large devices with memory banks";
+run-task scalability/memory_bank/compress_routing --debug --show_thread_logs
+run-task scalability/memory_bank/flatten_routing --debug --show_thread_logs
+
+echo -e "Testing fabric generation of large devices with frame-based configuration";
+run-task scalability/frame_based/compress_routing --debug --show_thread_logs
+run-task scalability/frame_based/flatten_routing --debug --show_thread_logs
+
+echo -e "Collecting the runtime and memory of the scalability tests";
+${PYTHON_EXEC} openfpga_flow/scripts/collect_scalability_results.py \
+  openfpga_flow/tasks/scalability/scan_chain/compress_routing \
+  openfpga_flow/tasks/scalability/scan_chain/flatten_routing \
+  openfpga_flow/tasks/scalability/memory_bank/compress_routing \
+  openfpga_flow/tasks/scalability/memory_bank/flatten_routing \
+  openfpga_flow/tasks/scalability/frame_based/compress_routing \
+  openfpga_flow/tasks/scalability/frame_based/flatten_routing \
+  --output scalability_result.csv
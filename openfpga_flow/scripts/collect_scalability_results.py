@@ -0,0 +1,181 @@
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Script Name   : collect_scalability_results.py
+# Description   : This script collects the runtime profiles of the
+#                 scalability tasks, which sweep the size of fixed devices,
+#                 and reports how the wall time and peak memory of each
+#                 OpenFPGA shell command scale with the number of tiles
+# Args          : python3 collect_scalability_results.py --help
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+
+import os
+import sys
+import re
+import csv
+import glob
+import json
+import math
+import argparse
+import logging
+from collections import OrderedDict
+
+if sys.version_info[0] < 3:
+    raise Exception("collect_scalability_results script must be using Python 3")
+
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Configure logging system
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+logging.basicConfig(level=logging.INFO, stream=sys.stdout,
+                    format="%(levelname)5s - %(message)s")
+logger = logging.getLogger('OpenFPGA_Scalability_logs')
+
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+# Read commandline arguments
+# = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
+parser = argparse.ArgumentParser()
+parser.add_argument('tasks', nargs='+',
+                    help="Directories of the scalability tasks, " +
+                    "whose latest runs are collected")
+parser.add_argument('--profile_file', type=str, default="runtime_profile.json",
+                    help="Name of the runtime profile written by the " +
+                    "'report_runtime' command in each run directory")
+parser.add_argument('--output', type=str, default="scalability_result.csv",
+                    help="CSV file of the runtime and memory of each command")
+parser.add_argument('--superlinear_threshold', type=float, default=1.2,
+                    help="A command whose wall time grows faster than " +
+                    "(number of tiles)^threshold is reported. Default = 1.2")
+parser.add_argument('--min_wall_time', type=float, default=1.0,
+                    help="Commands faster than this wall time (in seconds) " +
+                    "on the largest device are not reported. Default = 1.0")
+args = parser.parse_args()
+
+
+def parse_device_size(label):
+    """ Find the number of tiles of a device from its label, e.g., 10x10 """
+    match = re.match(r"^(\d+)x(\d+)$", label)
+    if not match:
+        return None
+    return int(match.group(1)) * int(match.group(2))
+
+
+def read_task_profiles(task_dir):
+    """
+    Read the runtime profiles of the latest run of a task
+    The run directories are organized as <arch>/<benchmark>/<script_param>,
+    where the label of the script parameters is the device layout
+    Return a dictionary of profiles indexed by the number of tiles
+    """
+    profiles = {}
+    pattern = os.path.join(task_dir, "latest", "*", "*", "*", args.profile_file)
+    for profile_file in sorted(glob.glob(pattern)):
+        label = os.path.basename(os.path.dirname(profile_file))
+        num_tiles = parse_device_size(label)
+        if num_tiles is None:
+            logger.warning("Skip run '%s' which is not a device layout",
+                           os.path.dirname(profile_file))
+            continue
+        with open(profile_file, encoding='utf-8') as fp:
+            profile = json.load(fp)
+        profile["label"] = label
+        profiles[num_tiles] = profile
+    return profiles
+
+
+def sum_command_profiles(profile):
+    """
+    Sum the profile of the executions of each command,
+    as a command may be executed several times by a script
+    """
+    commands = OrderedDict()
+    for cmd in profile["commands"]:
+        entry = commands.setdefault(cmd["name"], {"wall_time_sec": 0.,
+                                                  "cpu_time_sec": 0.,
+                                                  "delta_max_rss_mib": 0.})
+        entry["wall_time_sec"] += cmd["wall_time_sec"]
+        entry["cpu_time_sec"] += cmd["cpu_time_sec"]
+        entry["delta_max_rss_mib"] = max(entry["delta_max_rss_mib"],
+                                         cmd["delta_max_rss_mib"])
+    return commands
+
+
+def scaling_exponent(num_tiles_a, value_a, num_tiles_b, value_b):
+    """
+    Exponent k such that value grows as (number of tiles)^k
+    between two devices, or None if it can not be measured
+    """
+    if (value_a <= 0.) or (value_b <= 0.) or (num_tiles_a == num_tiles_b):
+        return None
+    return math.log(value_b / value_a) / math.log(num_tiles_b / num_tiles_a)
+
+
+def main():
+    rows = []
+    superlinear = []
+    for task_dir in args.tasks:
+        task_name = os.path.normpath(task_dir)
+        profiles = read_task_profiles(task_dir)
+        if not profiles:
+            logger.warning("No runtime profile found for task '%s'", task_name)
+            continue
+
+        sizes = sorted(profiles.keys())
+        commands = {size: sum_command_profiles(profiles[size]) for size in sizes}
+        for isize, size in enumerate(sizes):
+            prev_size = sizes[isize - 1] if isize > 0 else None
+            for name, entry in commands[size].items():
+                exponent = None
+                if prev_size is not None and name in commands[prev_size]:
+                    exponent = scaling_exponent(prev_size,
+                                                commands[prev_size][name]["wall_time_sec"],
+                                                size, entry["wall_time_sec"])
+                rows.append(OrderedDict([
+                    ("task", task_name),
+                    ("device", profiles[size]["label"]),
+                    ("num_tiles", size),
+                    ("command", name),
+                    ("wall_time_sec", entry["wall_time_sec"]),
+                    ("cpu_time_sec", entry["cpu_time_sec"]),
+                    ("delta_max_rss_mib", entry["delta_max_rss_mib"]),
+                    ("max_rss_mib", profiles[size]["max_rss_mib"]),
+                    ("wall_time_exponent",
+                     "" if exponent is None else "%.2f" % exponent)]))
+
+        # Report the commands which scale super-linearly between
+        # the smallest and the largest devices
+        if len(sizes) < 2:
+            continue
+        first, last = sizes[0], sizes[-1]
+        for name, entry in commands[last].items():
+            if name not in commands[first]:
+                continue
+            if entry["wall_time_sec"] < args.min_wall_time:
+                continue
+            exponent = scaling_exponent(first, commands[first][name]["wall_time_sec"],
+                                        last, entry["wall_time_sec"])
+            if exponent is not None and exponent > args.superlinear_threshold:
+                superlinear.append((task_name, name, exponent,
+                                    entry["wall_time_sec"]))
+
+    if not rows:
+        logger.error("No runtime profile is collected")
+        return 1
+
+    with open(args.output, 'w', newline='') as csvfile:
+        writer = csv.DictWriter(csvfile, fieldnames=list(rows[0].keys()))
+        writer.writeheader()
+        writer.writerows(rows)
+    logger.info("Written the runtime and memory of %d command runs to '%s'",
+                len(rows), args.output)
+
+    if superlinear:
+        logger.info("Commands whose wall time scales faster than " +
+                    "(number of tiles)^%.2f:", args.superlinear_threshold)
+        for task_name, name, exponent, wall_time in superlinear:
+            logger.info("  %s: %s (exponent %.2f, %.1f s on the largest device)",
+                        task_name, name, exponent, wall_time)
+    else:
+        logger.info("All the commands scale linearly with the number of tiles")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -82,6 +82,8 @@ void SetupVPR(const t_options* Options,
     FileNameOpts->ArchFile = Options->ArchFile;
     FileNameOpts->BlifFile = Options->BlifFile;
     FileNameOpts->NetFile = Options->NetFile;
+    FileNameOpts->NetCacheFile = Options->NetCacheFile;
+    FileNameOpts->PlaceCacheFile = Options->PlaceCacheFile;
     FileNameOpts->PlaceFile = Options->PlaceFile;
     FileNameOpts->RouteFile = Options->RouteFile;
     FileNameOpts->ActFile = Options->ActFile;
@@ -167,6 +169,10 @@ void SetupVPR(const t_options* Options,
     SetupPackerOpts(*Options, PackerOpts);
     RoutingArch->write_rr_graph_filename = Options->write_rr_graph_file;
     RoutingArch->read_rr_graph_filename = Options->read_rr_graph_file;
+    RoutingArch->rr_graph_cache_filename = Options->rr_graph_cache_file;
+    RoutingArch->num_workers = Options->num_workers;
+    RoutingArch->freeze_rr_graph = Options->freeze_rr_graph;
+    RoutingArch->check_level = Options->check_level;
 
     //Setup the default flow, if no specific stages specified
     //do all
@@ -335,6 +341,7 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->max_router_iterations = Options.max_router_iterations;
     RouterOpts->init_wirelength_abort_threshold = Options.router_init_wirelength_abort_threshold;
     RouterOpts->min_incremental_reroute_fanout = Options.min_incremental_reroute_fanout;
+    RouterOpts->incremental_route_file = Options.incremental_route_file;
     RouterOpts->incr_reroute_delay_ripup = Options.incr_reroute_delay_ripup;
     RouterOpts->pres_fac_mult = Options.pres_fac_mult;
     RouterOpts->route_type = Options.RouteType;
@@ -374,14 +381,19 @@ static void SetupRouterOpts(const t_options& Options, t_router_opts* RouterOpts)
     RouterOpts->router_debug_net = Options.router_debug_net;
     RouterOpts->router_debug_sink_rr = Options.router_debug_sink_rr;
     RouterOpts->lookahead_type = Options.router_lookahead_type;
+    RouterOpts->router_heap = Options.router_heap;
     RouterOpts->max_convergence_count = Options.router_max_convergence_count;
     RouterOpts->reconvergence_cpd_threshold = Options.router_reconvergence_cpd_threshold;
     RouterOpts->first_iteration_timing_report_file = Options.router_first_iteration_timing_report_file;
+    RouterOpts->parallel_routing = Options.parallel_routing;
+    RouterOpts->num_workers = Options.num_workers;
 
     RouterOpts->strict_checks = Options.strict_checks;
+    RouterOpts->check_level = Options.check_level;
 
     RouterOpts->write_router_lookahead = Options.write_router_lookahead;
     RouterOpts->read_router_lookahead = Options.read_router_lookahead;
+    RouterOpts->router_lookahead_cache_file = Options.router_lookahead_cache_file;
 }
 
 static void SetupAnnealSched(const t_options& Options,
@@ -452,6 +464,8 @@ void SetupPackerOpts(const t_options& Options,
     PackerOpts->packer_algorithm = PACK_GREEDY; /* DEFAULT */
 
     PackerOpts->device_layout = Options.device_layout;
+
+    PackerOpts->num_workers = Options.num_workers;
 }
 
 static void SetupNetlistOpts(const t_options& Options, t_netlist_opts& NetlistOpts) {
@@ -483,6 +497,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
     PlacerOpts->place_algorithm = Options.PlaceAlgorithm;
 
     PlacerOpts->pad_loc_file = Options.pad_loc_file;
+    PlacerOpts->initial_placement = Options.initial_placement;
     PlacerOpts->pad_loc_type = Options.pad_loc_type;
 
     PlacerOpts->place_chan_width = Options.PlaceChanWidth;
@@ -501,6 +516,7 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
     PlacerOpts->tsu_abs_margin = Options.place_tsu_abs_margin;
     PlacerOpts->delay_model_type = Options.place_delay_model;
     PlacerOpts->delay_model_reducer = Options.place_delay_model_reducer;
+    PlacerOpts->incremental_timing_analysis = Options.place_incremental_timing_analysis;
 
     //TODO: document?
     PlacerOpts->place_freq = PLACE_ONCE; /* DEFAULT */
@@ -509,6 +525,8 @@ static void SetupPlacerOpts(const t_options& Options, t_placer_opts* PlacerOpts)
 
     PlacerOpts->rlim_escape_fraction = Options.place_rlim_escape_fraction;
     PlacerOpts->move_stats_file = Options.place_move_stats_file;
+    PlacerOpts->parallel_placement = Options.parallel_placement;
+    PlacerOpts->num_workers = Options.num_workers;
 
     PlacerOpts->strict_checks = Options.strict_checks;
 
@@ -0,0 +1,481 @@
+/*********************************************************************
+ * This file defines the functions to read and write the clustered
+ * blocks of a packed netlist in a binary format, using the capnproto
+ * schema VprPackedNetlist (see libs/libvtrcapnproto/packed_netlist.capnp).
+ *
+ * The binary netlist stores what read_netlist() loads from the .net file
+ * for each clustered block: its tree of physical blocks, the routes of
+ * its pins and the pin rotations. The ports and nets of the clustered
+ * netlist, the routes of the pins driven inside the blocks and the
+ * mapping to the atom netlist are then built in the same way as for
+ * the .net file, by the caller.
+ ********************************************************************/
+#include <limits>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_util.h"
+#include "vtr_memory.h"
+
+#include "vpr_error.h"
+#include "vpr_utils.h"
+#include "globals.h"
+
+#include "binary_packed_netlist.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "packed_netlist.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void write_binary_packed_netlist(const std::string& /*file_name*/,
+                                 const ClusteredNetlist& /*clb_nlist*/,
+                                 const std::string& /*netlist_id*/) {
+    VPR_THROW(VPR_ERROR_NET_F, "write_binary_packed_netlist " DISABLE_ERROR);
+}
+
+bool read_binary_packed_netlist(const std::string& /*file_name*/,
+                                ClusteredNetlist& /*clb_nlist*/,
+                                const std::string& /*netlist_id*/,
+                                int* /*num_primitives*/) {
+    VPR_THROW(VPR_ERROR_NET_F, "read_binary_packed_netlist " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* The state of a child pb after loading the .net file */
+static VprPackedNetlistPbState find_pb_state(const t_pb* pb) {
+    if (nullptr == pb->pb_graph_node) {
+        return VprPackedNetlistPbState::UNUSED;
+    }
+    /* Only the children processed by read_netlist() refer to their parent */
+    if (nullptr == pb->parent_pb) {
+        return VprPackedNetlistPbState::OPEN;
+    }
+    return VprPackedNetlistPbState::EXPANDED;
+}
+
+/* Count the entries of an expanded pb and of its children */
+static size_t count_binary_pbs(const t_pb* pb) {
+    size_t num_pbs = 1;
+    if (0 == pb->pb_graph_node->pb_type->num_modes) {
+        return num_pbs;
+    }
+    const t_mode& mode = pb->pb_graph_node->pb_type->modes[pb->mode];
+    for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+        for (int inst = 0; inst < mode.pb_type_children[ichild].num_pb; ++inst) {
+            const t_pb* child_pb = &pb->child_pbs[ichild][inst];
+            if (VprPackedNetlistPbState::EXPANDED == find_pb_state(child_pb)) {
+                num_pbs += count_binary_pbs(child_pb);
+            } else {
+                ++num_pbs;
+            }
+        }
+    }
+    return num_pbs;
+}
+
+/* Find the pins of a pb whose atom pin index is rotated */
+static std::vector<std::pair<int, int>> find_pb_pin_rotations(const t_pb* pb) {
+    std::vector<std::pair<int, int>> rotations;
+    const t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
+
+    auto add_port_rotations = [&](t_pb_graph_pin** pins, int num_ports, const int* num_pins) {
+        for (int iport = 0; iport < num_ports; ++iport) {
+            for (int ipin = 0; ipin < num_pins[iport]; ++ipin) {
+                const t_pb_graph_pin* gpin = &pins[iport][ipin];
+                BitIndex atom_pin_index = pb->atom_pin_bit_index(gpin);
+                if (atom_pin_index != (BitIndex)gpin->pin_number) {
+                    rotations.emplace_back(gpin->pin_count_in_cluster, atom_pin_index);
+                }
+            }
+        }
+    };
+    add_port_rotations(pb_graph_node->input_pins, pb_graph_node->num_input_ports, pb_graph_node->num_input_pins);
+    add_port_rotations(pb_graph_node->output_pins, pb_graph_node->num_output_ports, pb_graph_node->num_output_pins);
+    add_port_rotations(pb_graph_node->clock_pins, pb_graph_node->num_clock_ports, pb_graph_node->num_clock_pins);
+
+    return rotations;
+}
+
+/* Write an expanded pb and its children in pre-order */
+static void write_binary_pb(::capnp::List<VprPackedNetlistPb>::Builder& pbs,
+                            size_t& ipb,
+                            const t_pb* pb) {
+    auto pb_data = pbs[ipb++];
+    pb_data.setState(VprPackedNetlistPbState::EXPANDED);
+    pb_data.setHasName(nullptr != pb->name);
+    if (nullptr != pb->name) {
+        pb_data.setName(pb->name);
+    }
+    pb_data.setMode(pb->mode);
+
+    std::vector<std::pair<int, int>> rotations = find_pb_pin_rotations(pb);
+    auto rotations_data = pb_data.initPinRotations(rotations.size());
+    for (size_t irot = 0; irot < rotations.size(); ++irot) {
+        rotations_data[irot].setPin(rotations[irot].first);
+        rotations_data[irot].setAtomPinIndex(rotations[irot].second);
+    }
+
+    if (0 == pb->pb_graph_node->pb_type->num_modes) {
+        return;
+    }
+    const t_mode& mode = pb->pb_graph_node->pb_type->modes[pb->mode];
+    for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+        for (int inst = 0; inst < mode.pb_type_children[ichild].num_pb; ++inst) {
+            const t_pb* child_pb = &pb->child_pbs[ichild][inst];
+            VprPackedNetlistPbState state = find_pb_state(child_pb);
+            if (VprPackedNetlistPbState::EXPANDED == state) {
+                write_binary_pb(pbs, ipb, child_pb);
+            } else {
+                pbs[ipb++].setState(state);
+            }
+        }
+    }
+}
+
+/************************ Subroutine definitions ****************************/
+void write_binary_packed_netlist(const std::string& file_name,
+                                 const ClusteredNetlist& clb_nlist,
+                                 const std::string& netlist_id) {
+    vtr::ScopedStartFinishTimer timer("Write binary packed netlist to '" + file_name + "'");
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    ::capnp::MallocMessageBuilder builder;
+    auto netlist = builder.initRoot<VprPackedNetlist>();
+    netlist.setId(netlist_id);
+
+    /* Number the nets in their first use, so that only the used nets are stored */
+    vtr::vector<AtomNetId, int> net_indices(atom_ctx.nlist.nets().size(), OPEN);
+    std::vector<AtomNetId> used_nets;
+
+    auto blocks = netlist.initBlocks(clb_nlist.blocks().size());
+    for (const ClusterBlockId& blk : clb_nlist.blocks()) {
+        const t_pb* pb = clb_nlist.block_pb(blk);
+        auto block_data = blocks[size_t(blk)];
+
+        block_data.setType(clb_nlist.block_type(blk) - &device_ctx.logical_block_types[0]);
+        block_data.setNumInputPorts(clb_nlist.block_input_ports(blk).size());
+        block_data.setNumOutputPorts(clb_nlist.block_output_ports(blk).size());
+        block_data.setNumClockPorts(clb_nlist.block_clock_ports(blk).size());
+
+        auto routes = block_data.initRoutes(pb->pb_route.size());
+        size_t iroute = 0;
+        for (const auto& pin_route : pb->pb_route) {
+            const t_pb_route& route = pin_route.second;
+            auto route_data = routes[iroute++];
+            route_data.setPin(pin_route.first);
+            route_data.setDriverPin(route.driver_pb_pin_id);
+            /* The nets of the pins driven inside the block are derived on load */
+            int net_index = OPEN;
+            if ((OPEN == route.driver_pb_pin_id) && (route.atom_net_id)) {
+                if (OPEN == net_indices[route.atom_net_id]) {
+                    net_indices[route.atom_net_id] = used_nets.size();
+                    used_nets.push_back(route.atom_net_id);
+                }
+                net_index = net_indices[route.atom_net_id];
+            }
+            route_data.setNet(net_index);
+            route_data.setGraphPin(route.pb_graph_pin ? route.pb_graph_pin->pin_count_in_cluster : OPEN);
+        }
+
+        auto pbs = block_data.initPbs(count_binary_pbs(pb));
+        size_t ipb = 0;
+        write_binary_pb(pbs, ipb, pb);
+        VTR_ASSERT(pbs.size() == ipb);
+    }
+
+    auto net_names = netlist.initNetNames(used_nets.size());
+    for (size_t inet = 0; inet < used_nets.size(); ++inet) {
+        net_names.set(inet, atom_ctx.nlist.net_name(used_nets[inet]));
+    }
+
+    writeMessageToFile(file_name, &builder);
+
+    VTR_LOG("Wrote %lu clustered blocks and %lu nets to binary packed netlist '%s'\n",
+            clb_nlist.blocks().size(), used_nets.size(), file_name.c_str());
+}
+
+/********************************************************************
+ * Check the pb entries of an expanded pb and of its children,
+ * and move to the entry after them
+ *******************************************************************/
+static bool valid_binary_pb(const ::capnp::List<VprPackedNetlistPb>::Reader& pbs,
+                            size_t& ipb,
+                            const t_pb_graph_node* pb_graph_node,
+                            const int& num_pins) {
+    auto pb_data = pbs[ipb++];
+    const t_pb_type* pb_type = pb_graph_node->pb_type;
+    /* A primitive pb is found in the atom netlist by its name */
+    if ((0 == pb_type->num_modes) && (false == pb_data.getHasName())) {
+        return false;
+    }
+    if ((0 > pb_data.getMode()) || (std::max(1, pb_type->num_modes) <= pb_data.getMode())) {
+        return false;
+    }
+    for (const auto& rotation_data : pb_data.getPinRotations()) {
+        if ((0 > rotation_data.getPin()) || (num_pins <= rotation_data.getPin())
+            || (0 > rotation_data.getAtomPinIndex())) {
+            return false;
+        }
+    }
+
+    if (0 == pb_type->num_modes) {
+        return true;
+    }
+    const t_mode& mode = pb_type->modes[pb_data.getMode()];
+    for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+        for (int inst = 0; inst < mode.pb_type_children[ichild].num_pb; ++inst) {
+            if (pbs.size() <= ipb) {
+                return false;
+            }
+            if (VprPackedNetlistPbState::EXPANDED != pbs[ipb].getState()) {
+                ++ipb;
+                continue;
+            }
+            if (false == valid_binary_pb(pbs, ipb, &pb_graph_node->child_pb_graph_nodes[pb_data.getMode()][ichild][inst], num_pins)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/********************************************************************
+ * Check the content of a binary packed netlist before touching the
+ * clustered netlist, so that the caller can load the .net file instead
+ * when the file is not valid
+ *******************************************************************/
+static bool valid_binary_packed_netlist(const VprPackedNetlist::Reader& netlist) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    for (const auto& net_name : netlist.getNetNames()) {
+        if (!atom_ctx.nlist.find_net(net_name.cStr())) {
+            return false;
+        }
+    }
+
+    int num_nets = netlist.getNetNames().size();
+    for (const auto& block_data : netlist.getBlocks()) {
+        if (device_ctx.logical_block_types.size() <= block_data.getType()) {
+            return false;
+        }
+        const t_logical_block_type& type = device_ctx.logical_block_types[block_data.getType()];
+        if (nullptr == type.pb_graph_head) {
+            return false;
+        }
+        if ((size_t)type.pb_type->num_ports != (size_t)block_data.getNumInputPorts() + block_data.getNumOutputPorts() + block_data.getNumClockPorts()) {
+            return false;
+        }
+
+        int num_pins = type.pb_graph_head->total_pb_pins;
+        for (const auto& route_data : block_data.getRoutes()) {
+            if ((0 > route_data.getPin()) || (num_pins <= route_data.getPin())
+                || (OPEN > route_data.getDriverPin()) || (num_pins <= route_data.getDriverPin())
+                || (OPEN > route_data.getNet()) || (num_nets <= route_data.getNet())
+                || (OPEN > route_data.getGraphPin()) || (num_pins <= route_data.getGraphPin())) {
+                return false;
+            }
+        }
+
+        auto pbs = block_data.getPbs();
+        if ((0 == pbs.size())
+            || (VprPackedNetlistPbState::EXPANDED != pbs[0].getState())
+            || (false == pbs[0].getHasName())) {
+            return false;
+        }
+        size_t ipb = 0;
+        if ((false == valid_binary_pb(pbs, ipb, type.pb_graph_head, num_pins))
+            || (pbs.size() != ipb)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/********************************************************************
+ * Load an expanded pb and its children, as processPb() does from the
+ * .net file. The name and mode of the pb are set by the caller
+ *******************************************************************/
+static void load_binary_pb(const ::capnp::List<VprPackedNetlistPb>::Reader& pbs,
+                           size_t& ipb,
+                           t_pb* pb,
+                           const ClusterBlockId& index,
+                           t_pb_graph_pin** pin_lookup,
+                           int* num_primitives) {
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
+    auto pb_data = pbs[ipb++];
+    for (const auto& rotation_data : pb_data.getPinRotations()) {
+        pb->set_atom_pin_bit_index(pin_lookup[rotation_data.getPin()], rotation_data.getAtomPinIndex());
+    }
+
+    const t_pb_type* pb_type = pb->pb_graph_node->pb_type;
+    if (0 == pb_type->num_modes) {
+        /* A primitive type */
+        AtomBlockId blk_id = atom_ctx.nlist.find_block(pb->name);
+        if (!blk_id) {
+            VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                            ".blif file and binary packed netlist do not match, encountered unknown primitive %s.\n",
+                            pb->name);
+        }
+        atom_ctx.lookup.set_atom_pb(blk_id, pb);
+        atom_ctx.lookup.set_atom_clb(blk_id, index);
+
+        (*num_primitives)++;
+        return;
+    }
+
+    const t_mode& mode = pb_type->modes[pb->mode];
+    alloc_child_pbs(pb, mode);
+
+    for (int ichild = 0; ichild < mode.num_pb_type_children; ++ichild) {
+        for (int inst = 0; inst < mode.pb_type_children[ichild].num_pb; ++inst) {
+            t_pb* child_pb = &pb->child_pbs[ichild][inst];
+            auto child_data = pbs[ipb];
+            if (VprPackedNetlistPbState::UNUSED == child_data.getState()) {
+                ++ipb;
+                continue;
+            }
+            child_pb->pb_graph_node = &pb->pb_graph_node->child_pb_graph_nodes[pb->mode][ichild][inst];
+            if (VprPackedNetlistPbState::OPEN == child_data.getState()) {
+                ++ipb;
+                continue;
+            }
+            if (true == child_data.getHasName()) {
+                child_pb->name = vtr::strdup(child_data.getName().cStr());
+            }
+            child_pb->mode = child_data.getMode();
+            child_pb->parent_pb = pb;
+            load_binary_pb(pbs, ipb, child_pb, index, pin_lookup, num_primitives);
+        }
+    }
+}
+
+/********************************************************************
+ * Load the clustered blocks of a binary packed netlist to an empty
+ * clustered netlist: the blocks, their ports, their trees of pbs and
+ * the routes of the pins which are read from the .net file.
+ * The binary netlist is loaded only if its id matches the given one
+ *
+ * Return true if the netlist is loaded, otherwise the clustered netlist
+ * is not touched
+ *******************************************************************/
+bool read_binary_packed_netlist(const std::string& file_name,
+                                ClusteredNetlist& clb_nlist,
+                                const std::string& netlist_id,
+                                int* num_primitives) {
+    VTR_ASSERT(0 == clb_nlist.blocks().size());
+
+    if (false == vtr::file_exists(file_name.c_str())) {
+        return false;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Read binary packed netlist from '" + file_name + "'");
+
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& atom_ctx = g_vpr_ctx.atom();
+
+    MmapFile f(file_name);
+
+    /* The netlist of a large design easily exceeds the default traversal limit */
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    ::capnp::FlatArrayMessageReader reader(f.getData(), options);
+
+    VprPackedNetlist::Reader netlist = reader.getRoot<VprPackedNetlist>();
+    if (netlist_id != std::string(netlist.getId().cStr())) {
+        VTR_LOG_WARN("Binary packed netlist '%s' is written from a different .net file, architecture or atom netlist!\n",
+                     file_name.c_str());
+        return false;
+    }
+    if (false == valid_binary_packed_netlist(netlist)) {
+        VTR_LOG_WARN("Binary packed netlist '%s' is corrupted!\n",
+                     file_name.c_str());
+        return false;
+    }
+
+    std::vector<AtomNetId> nets;
+    nets.reserve(netlist.getNetNames().size());
+    for (const auto& net_name : netlist.getNetNames()) {
+        nets.push_back(atom_ctx.nlist.find_net(net_name.cStr()));
+    }
+
+    /* The look-ups from the indices of pins to the pb_graph pins of each block type */
+    std::vector<t_pb_graph_pin**> pin_lookups(device_ctx.logical_block_types.size(), nullptr);
+
+    for (const auto& block_data : netlist.getBlocks()) {
+        const t_logical_block_type* type = &device_ctx.logical_block_types[block_data.getType()];
+        t_pb_graph_pin**& pin_lookup = pin_lookups[block_data.getType()];
+        if (nullptr == pin_lookup) {
+            pin_lookup = alloc_and_load_pb_graph_pin_lookup_from_index(type);
+        }
+
+        auto pbs = block_data.getPbs();
+        t_pb* pb = new t_pb;
+        pb->name = vtr::strdup(pbs[0].getName().cStr());
+        pb->child_pbs_arena = clb_nlist.pb_arena();
+        ClusterBlockId index = clb_nlist.create_block(pb->name, pb, type);
+        pb->pb_graph_node = type->pb_graph_head;
+        pb->mode = pbs[0].getMode();
+
+        /* The routes are sorted by pin in the file, as in the pb_route */
+        auto routes = block_data.getRoutes();
+        std::vector<std::pair<int, t_pb_route>> pin_routes(routes.size());
+        for (size_t iroute = 0; iroute < routes.size(); ++iroute) {
+            auto route_data = routes[iroute];
+            pin_routes[iroute].first = route_data.getPin();
+            t_pb_route& route = pin_routes[iroute].second;
+            route.driver_pb_pin_id = route_data.getDriverPin();
+            if (OPEN != route_data.getNet()) {
+                route.atom_net_id = nets[route_data.getNet()];
+            }
+            if (OPEN != route_data.getGraphPin()) {
+                route.pb_graph_pin = pin_lookup[route_data.getGraphPin()];
+            }
+        }
+        pb->pb_route = t_pb_routes(std::move(pin_routes));
+
+        /* Create the ports in the same order as the .net file loader */
+        const t_pb_type* pb_type = type->pb_type;
+        size_t num_input_ports = block_data.getNumInputPorts();
+        size_t num_output_ports = num_input_ports + block_data.getNumOutputPorts();
+        for (int iport = 0; iport < pb_type->num_ports; ++iport) {
+            PortType port_type = PortType::CLOCK;
+            if ((size_t)iport < num_input_ports) {
+                port_type = PortType::INPUT;
+            } else if ((size_t)iport < num_output_ports) {
+                port_type = PortType::OUTPUT;
+            }
+            clb_nlist.create_port(index, pb_type->ports[iport].name, pb_type->ports[iport].num_pins, port_type);
+        }
+
+        size_t ipb = 0;
+        load_binary_pb(pbs, ipb, pb, index, pin_lookup, num_primitives);
+        VTR_ASSERT(pbs.size() == ipb);
+    }
+
+    for (t_pb_graph_pin** pin_lookup : pin_lookups) {
+        free_pb_graph_pin_lookup_from_index(pin_lookup);
+    }
+
+    VTR_LOG("Read %lu clustered blocks and %lu nets from binary packed netlist '%s'\n",
+            clb_nlist.blocks().size(), nets.size(), file_name.c_str());
+
+    return true;
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
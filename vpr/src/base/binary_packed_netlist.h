@@ -0,0 +1,22 @@
+/*********************************************************************
+ * This function reads and writes the clustered blocks of a packed
+ * netlist in a binary format, which can be loaded much faster than
+ * parsing the .net file again
+ ********************************************************************/
+
+#ifndef BINARY_PACKED_NETLIST_H
+#define BINARY_PACKED_NETLIST_H
+
+#include <string>
+#include "clustered_netlist.h"
+
+void write_binary_packed_netlist(const std::string& file_name,
+                                 const ClusteredNetlist& clb_nlist,
+                                 const std::string& netlist_id);
+
+bool read_binary_packed_netlist(const std::string& file_name,
+                                ClusteredNetlist& clb_nlist,
+                                const std::string& netlist_id,
+                                int* num_primitives);
+
+#endif
@@ -11,7 +11,8 @@
  *
  */
 ClusteredNetlist::ClusteredNetlist(std::string name, std::string id)
-    : Netlist<ClusterBlockId, ClusterPortId, ClusterPinId, ClusterNetId>(name, id) {}
+    : Netlist<ClusterBlockId, ClusterPortId, ClusterPinId, ClusterNetId>(name, id)
+    , pb_arena_(std::make_shared<PbArena>()) {}
 
 /*
  *
@@ -194,6 +195,10 @@ void ClusteredNetlist::set_net_is_global(ClusterNetId net_id, bool state) {
     net_is_global_[net_id] = state;
 }
 
+PbArena* ClusteredNetlist::pb_arena() {
+    return pb_arena_.get();
+}
+
 void ClusteredNetlist::remove_block_impl(const ClusterBlockId blk_id) {
     //Remove & invalidate pointers
     free_pb(block_pbs_[blk_id]);
@@ -276,6 +281,20 @@ void ClusteredNetlist::shrink_to_fit_impl() {
     net_is_global_.shrink_to_fit();
 }
 
+void ClusteredNetlist::reserve_impl(size_t num_blocks, size_t /*num_ports*/, size_t num_pins, size_t num_nets) {
+    //Block data
+    block_pbs_.reserve(num_blocks);
+    block_types_.reserve(num_blocks);
+    block_logical_pins_.reserve(num_blocks);
+
+    //Pin data
+    pin_logical_index_.reserve(num_pins);
+
+    //Net data
+    net_is_ignored_.reserve(num_nets);
+    net_is_global_.reserve(num_nets);
+}
+
 /*
  *
  * Sanity Checks
@@ -103,8 +103,11 @@
  * Refer to netlist.h for more information.
  *
  */
+#include <memory>
+
 #include "vpr_types.h"
 #include "vpr_utils.h"
+#include "pb_arena.h"
 
 #include "vtr_util.h"
 
@@ -200,6 +203,10 @@ class ClusteredNetlist : public Netlist<ClusterBlockId, ClusterPortId, ClusterPi
     //Sets the flag in net_is_global_ = state
     void set_net_is_global(ClusterNetId net_id, bool state);
 
+    //Returns the arena for the children of the pbs of the blocks (see t_pb::child_pbs_arena),
+    //which lives as long as the netlist or any copy of it
+    PbArena* pb_arena();
+
   private: //Private Members
     /*
      * Netlist compression/optimization
@@ -213,6 +220,9 @@ class ClusteredNetlist : public Netlist<ClusterBlockId, ClusterPortId, ClusterPi
     //Shrinks internal data structures to required size to reduce memory consumption
     void shrink_to_fit_impl() override;
 
+    //Reserves internal data structures for the expected number of components
+    void reserve_impl(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) override;
+
     /*
      * Component removal
      */
@@ -251,6 +261,9 @@ class ClusteredNetlist : public Netlist<ClusterBlockId, ClusterPortId, ClusterPi
     //Nets
     vtr::vector_map<ClusterNetId, bool> net_is_ignored_; //Boolean mapping indicating if the net is ignored
     vtr::vector_map<ClusterNetId, bool> net_is_global_;  //Boolean mapping indicating if the net is global
+
+    //Arena of the pbs, shared by the copies of the netlist as its block pbs are
+    std::shared_ptr<PbArena> pb_arena_;
 };
 
 #endif
@@ -729,6 +729,15 @@ class Netlist {
     //  value    : The new value for the specified parameter on the specified block
     void set_block_param(const BlockId blk_id, const std::string& name, const std::string& value);
 
+    //Reserves the internal data structures for the specified number of components,
+    //so that they are not re-allocated while a large netlist is built.
+    //The numbers are only hints: more components can still be created
+    //  num_blocks : The expected number of blocks
+    //  num_ports  : The expected number of ports
+    //  num_pins   : The expected number of pins
+    //  num_nets   : The expected number of nets
+    void reserve(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets);
+
     //Merges sink_net into driver_net
     //After merging driver_net will contain all the sinks of sink_net
     //  driver_net: The net which includes the driver pin
@@ -901,6 +910,7 @@ class Netlist {
     //The functions follow the Non-Virtual Interface (NVI) idiom, and
     //are called from this class in their respective non-impl() functions.
     virtual void shrink_to_fit_impl() = 0;
+    virtual void reserve_impl(size_t num_blocks, size_t num_ports, size_t num_pins, size_t num_nets) = 0;
 
     virtual bool validate_block_sizes_impl(size_t num_blocks) const = 0;
     virtual bool validate_port_sizes_impl(size_t num_ports) const = 0;
@@ -72,7 +72,8 @@
 //
 //VPR stores names internally generally following BLIF conventions.  As a result these names need
 //to be escaped when generating Verilog or SDF.  This is handled with escape_verilog_identifier()
-//and escape_sdf_identifier() functions.
+//and escape_sdf_identifier() functions, which escape the names as they are written to the output
+//stream, rather than building an escaped copy of every name.
 //
 //Primitives
 //==========
@@ -97,6 +98,20 @@
  * CLOCK
  * };*/
 
+//An identifier escaped for verilog when written to an output stream
+struct VerilogIdentifier {
+    const std::string& identifier;
+};
+
+//An identifier escaped for SDF when written to an output stream
+struct SdfIdentifier {
+    const std::string& identifier;
+};
+
+//Size of the buffers of the output files, large enough so that the many small
+//writes of the netlists are grouped in few system calls
+constexpr size_t NETLIST_WRITER_BUFFER_SIZE = 1 << 20;
+
 //
 // File local function declarations
 //
@@ -107,10 +122,12 @@ void print_blif_port(std::ostream& os, size_t& unconn_count, const std::string&
 void print_verilog_port(std::ostream& os, const std::string& port_name, const std::vector<std::string>& nets, PortType type, int depth);
 
 std::string create_unconn_net(size_t& unconn_count);
-std::string escape_verilog_identifier(const std::string id);
-std::string escape_sdf_identifier(const std::string id);
+VerilogIdentifier escape_verilog_identifier(const std::string& id);
+SdfIdentifier escape_sdf_identifier(const std::string& id);
+std::ostream& operator<<(std::ostream& os, const VerilogIdentifier& id);
+std::ostream& operator<<(std::ostream& os, const SdfIdentifier& id);
 bool is_special_sdf_char(char c);
-std::string join_identifier(std::string lhs, std::string rhs);
+std::string join_identifier(const std::string& lhs, const std::string& rhs);
 
 //
 //
@@ -1027,7 +1044,7 @@ class NetlistWriterVisitor : public NetlistVisitor {
     //The wire is recorded and instantiated by the top level output routines.
     std::string make_inst_wire(AtomNetId atom_net_id,  //The id of the net in the atom netlist
                                tatum::NodeId tnode_id, //The tnode associated with the primitive pin
-                               std::string inst_name,  //The name of the instance associated with the pin
+                               const std::string& inst_name, //The name of the instance associated with the pin
                                PortType port_type,     //The port direction
                                int port_idx,           //The instance port index
                                int pin_idx) {          //The instance pin index
@@ -1998,9 +2015,20 @@ void netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDe
     VTR_LOG("Writing Implementation Netlist: %s\n", blif_filename.c_str());
     VTR_LOG("Writing Implementation SDF    : %s\n", sdf_filename.c_str());
 
-    std::ofstream verilog_os(verilog_filename);
-    std::ofstream blif_os(blif_filename);
-    std::ofstream sdf_os(sdf_filename);
+    //The buffers must be set before the files are opened, and outlive the streams
+    std::vector<char> verilog_buf(NETLIST_WRITER_BUFFER_SIZE);
+    std::vector<char> blif_buf(NETLIST_WRITER_BUFFER_SIZE);
+    std::vector<char> sdf_buf(NETLIST_WRITER_BUFFER_SIZE);
+
+    std::ofstream verilog_os;
+    std::ofstream blif_os;
+    std::ofstream sdf_os;
+    verilog_os.rdbuf()->pubsetbuf(verilog_buf.data(), verilog_buf.size());
+    blif_os.rdbuf()->pubsetbuf(blif_buf.data(), blif_buf.size());
+    sdf_os.rdbuf()->pubsetbuf(sdf_buf.data(), sdf_buf.size());
+    verilog_os.open(verilog_filename);
+    blif_os.open(blif_filename);
+    sdf_os.open(sdf_filename);
 
     NetlistWriterVisitor visitor(verilog_os, blif_os, sdf_os, delay_calc);
 
@@ -2015,12 +2043,7 @@ void netlist_writer(const std::string basename, std::shared_ptr<const AnalysisDe
 
 //Returns a blank string for indenting the given depth
 std::string indent(size_t depth) {
-    std::string indent_ = "    ";
-    std::string new_indent;
-    for (size_t i = 0; i < depth; ++i) {
-        new_indent += indent_;
-    }
-    return new_indent;
+    return std::string(4 * depth, ' ');
 }
 
 //Returns the delay in pico-seconds from a floating point delay
@@ -2119,7 +2142,14 @@ void print_verilog_port(std::ostream& os, const std::string& port_name, const st
 }
 
 //Escapes the given identifier to be safe for verilog
-std::string escape_verilog_identifier(const std::string identifier) {
+//
+//The identifier is escaped when the result is written to a stream, so the
+//identifier must outlive the result (e.g. by writing it in the same statement)
+VerilogIdentifier escape_verilog_identifier(const std::string& identifier) {
+    return {identifier};
+}
+
+std::ostream& operator<<(std::ostream& os, const VerilogIdentifier& id) {
     //Verilog allows escaped identifiers
     //
     //The escaped identifiers start with a literal back-slash '\'
@@ -2128,11 +2158,11 @@ std::string escape_verilog_identifier(const std::string identifier) {
     //We pre-pend the escape back-slash and append a space to avoid
     //the identifier gobbling up adjacent characters like commas which
     //are not actually part of the identifier
-    std::string prefix = "\\";
-    std::string suffix = " ";
-    std::string escaped_name = prefix + identifier + suffix;
+    os.put('\\');
+    os.write(id.identifier.data(), id.identifier.size());
+    os.put(' ');
 
-    return escaped_name;
+    return os;
 }
 
 //Returns true if c is categorized as a special character in SDF
@@ -2166,25 +2196,41 @@ bool is_special_sdf_char(char c) {
 }
 
 //Escapes the given identifier to be safe for sdf
-std::string escape_sdf_identifier(const std::string identifier) {
+//
+//As for escape_verilog_identifier(), the identifier is escaped when the
+//result is written to a stream
+SdfIdentifier escape_sdf_identifier(const std::string& identifier) {
+    return {identifier};
+}
+
+std::ostream& operator<<(std::ostream& os, const SdfIdentifier& id) {
     //SDF allows escaped characters
     //
     //We look at each character in the string and escape it if it is
-    //a special character
-    std::string escaped_name;
-
-    for (char c : identifier) {
-        if (is_special_sdf_char(c)) {
+    //a special character. The characters between the special ones are
+    //written at once.
+    const std::string& identifier = id.identifier;
+    size_t run_begin = 0;
+
+    for (size_t i = 0; i < identifier.size(); ++i) {
+        if (is_special_sdf_char(identifier[i])) {
+            os.write(identifier.data() + run_begin, i - run_begin);
             //Escape the special character
-            escaped_name += '\\';
+            os.put('\\');
+            run_begin = i;
         }
-        escaped_name += c;
     }
+    os.write(identifier.data() + run_begin, identifier.size() - run_begin);
 
-    return escaped_name;
+    return os;
 }
 
 //Joins two identifier strings
-std::string join_identifier(std::string lhs, std::string rhs) {
-    return lhs + '_' + rhs;
+std::string join_identifier(const std::string& lhs, const std::string& rhs) {
+    std::string joined;
+    joined.reserve(lhs.size() + 1 + rhs.size());
+    joined += lhs;
+    joined += '_';
+    joined += rhs;
+    return joined;
 }
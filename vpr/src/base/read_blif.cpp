@@ -42,13 +42,25 @@
 
 vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue);
 
+//The expected number of netlist components of a BLIF file, used to
+//reserve the netlist before it is built
+struct BlifNetlistCounts {
+    size_t num_blocks = 0;
+    size_t num_ports = 0;
+    size_t num_pins = 0;
+    size_t num_nets = 0;
+};
+
+static BlifNetlistCounts count_blif_netlist_components(const char* blif_file);
+
 struct BlifAllocCallback : public blifparse::Callback {
   public:
-    BlifAllocCallback(e_circuit_format blif_format, AtomNetlist& main_netlist, const std::string netlist_id, const t_model* user_models, const t_model* library_models)
+    BlifAllocCallback(e_circuit_format blif_format, AtomNetlist& main_netlist, const std::string netlist_id, const t_model* user_models, const t_model* library_models, const BlifNetlistCounts& netlist_counts)
         : main_netlist_(main_netlist)
         , netlist_id_(netlist_id)
         , user_arch_models_(user_models)
         , library_arch_models_(library_models)
+        , netlist_counts_(netlist_counts)
         , blif_format_(blif_format) {
         VTR_ASSERT(blif_format_ == e_circuit_format::BLIF
                    || blif_format_ == e_circuit_format::EBLIF);
@@ -72,6 +84,12 @@ struct BlifAllocCallback : public blifparse::Callback {
 
         blif_models_.emplace_back(model_name, netlist_id_);
         blif_models_black_box_.emplace_back(false);
+        if (blif_models_.size() == 1) {
+            //The first model is usually the main one, which holds (nearly) all
+            //the components of the file. The other models are small black-boxes
+            blif_models_.back().reserve(netlist_counts_.num_blocks, netlist_counts_.num_ports,
+                                        netlist_counts_.num_pins, netlist_counts_.num_nets);
+        }
         ended_ = false;
         set_curr_block(AtomBlockId::INVALID()); //This statement doesn't define a block, so mark invalid
     }
@@ -625,6 +643,7 @@ struct BlifAllocCallback : public blifparse::Callback {
     const std::string netlist_id_; //Unique identifier based on the contents of the blif file
     const t_model* user_arch_models_ = nullptr;
     const t_model* library_arch_models_ = nullptr;
+    const BlifNetlistCounts netlist_counts_;
 
     size_t unique_subckt_name_counter_ = 0;
 
@@ -655,6 +674,143 @@ vtr::LogicValue to_vtr_logic_value(blifparse::LogicValue val) {
     return new_val;
 }
 
+//Quickly scans a BLIF file to estimate the number of blocks, ports, pins
+//and nets of its netlist, without parsing it.
+//
+//The file is read by large chunks and each character is visited once,
+//so this costs a small fraction of the parse. The estimates are exact for
+//.inputs, .outputs, .names and .latch, while the ports of a .subckt are
+//counted by distinct consecutive port names and its outputs are not
+//known, so the nets of subckt outputs are left out.
+static BlifNetlistCounts count_blif_netlist_components(const char* blif_file) {
+    enum class Directive {
+        NONE, //Single-output cover lines, and directives which create no component
+        INPUTS,
+        OUTPUTS,
+        NAMES,
+        LATCH,
+        SUBCKT
+    };
+
+    BlifNetlistCounts counts;
+
+    FILE* infile = std::fopen(blif_file, "r");
+    if (!infile) {
+        //The error is reported by the parser
+        return counts;
+    }
+
+    Directive directive = Directive::NONE;
+    size_t num_line_tokens = 0;
+    std::string token;
+    std::string prev_subckt_port;
+    bool in_token = false;
+    bool in_comment = false;
+    bool continued = false; //A '\' was seen, which continues the line if a new line follows
+
+    auto end_token = [&]() {
+        if (!in_token) {
+            return;
+        }
+        in_token = false;
+        if (num_line_tokens == 0) {
+            if (token == ".inputs") {
+                directive = Directive::INPUTS;
+            } else if (token == ".outputs") {
+                directive = Directive::OUTPUTS;
+            } else if (token == ".names") {
+                directive = Directive::NAMES;
+            } else if (token == ".latch") {
+                directive = Directive::LATCH;
+            } else if (token == ".subckt") {
+                directive = Directive::SUBCKT;
+                prev_subckt_port.clear();
+            } else {
+                directive = Directive::NONE;
+            }
+        } else if (directive == Directive::INPUTS) {
+            //A block with a single-bit output port, and its net
+            counts.num_blocks++;
+            counts.num_ports++;
+            counts.num_pins++;
+            counts.num_nets++;
+        } else if (directive == Directive::OUTPUTS) {
+            //A block with a single-bit input port, whose net is driven by another block
+            counts.num_blocks++;
+            counts.num_ports++;
+            counts.num_pins++;
+        } else if (directive == Directive::SUBCKT && num_line_tokens > 1) {
+            //A 'port=net' connection
+            counts.num_pins++;
+            std::string port = token.substr(0, token.find_first_of("=["));
+            if (port != prev_subckt_port) {
+                counts.num_ports++;
+                prev_subckt_port = port;
+            }
+        }
+        num_line_tokens++;
+        token.clear();
+    };
+
+    auto end_line = [&]() {
+        end_token();
+        if (directive == Directive::NAMES && num_line_tokens > 1) {
+            //A block with an input and an output port, and the net of its output
+            counts.num_blocks++;
+            counts.num_ports += 2;
+            counts.num_pins += num_line_tokens - 1;
+            counts.num_nets++;
+        } else if (directive == Directive::LATCH && num_line_tokens > 2) {
+            //A block with data, clock and output ports, and the net of its output
+            counts.num_blocks++;
+            counts.num_ports += 3;
+            counts.num_pins += 3;
+            counts.num_nets++;
+        } else if (directive == Directive::SUBCKT && num_line_tokens > 1) {
+            counts.num_blocks++;
+        }
+        directive = Directive::NONE;
+        num_line_tokens = 0;
+    };
+
+    std::vector<char> buf(1 << 20);
+    size_t num_read;
+    while ((num_read = std::fread(buf.data(), 1, buf.size(), infile)) > 0) {
+        for (size_t ichar = 0; ichar < num_read; ++ichar) {
+            char c = buf[ichar];
+            if (c == '\n') {
+                if (continued && !in_comment) {
+                    //Line continuation
+                    continued = false;
+                    continue;
+                }
+                in_comment = false;
+                continued = false;
+                end_line();
+            } else if (in_comment) {
+                continue;
+            } else if (c == '#') {
+                end_token();
+                in_comment = true;
+            } else if (c == '\\') {
+                end_token();
+                continued = true;
+            } else if (c == ' ' || c == '\t' || c == '\r') {
+                end_token();
+            } else {
+                continued = false;
+                in_token = true;
+                token.push_back(c);
+            }
+        }
+    }
+    end_line();
+
+    std::fclose(infile);
+
+    return counts;
+}
+
 AtomNetlist read_blif(e_circuit_format circuit_format,
                       const char* blif_file,
                       const t_model* user_models,
@@ -662,7 +818,11 @@ AtomNetlist read_blif(e_circuit_format circuit_format,
     AtomNetlist netlist;
     std::string netlist_id = vtr::secure_digest_file(blif_file);
 
-    BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models);
+    //Reserve the netlist from a quick pre-scan, so that its storage does not
+    //grow (and get copied) many times while parsing large netlists
+    BlifNetlistCounts netlist_counts = count_blif_netlist_components(blif_file);
+
+    BlifAllocCallback alloc_callback(circuit_format, netlist, netlist_id, user_models, library_models, netlist_counts);
     blifparse::blif_parse_filename(blif_file, alloc_callback);
 
     return netlist;
@@ -31,9 +31,16 @@
 #include "read_xml_util.h"
 #include "read_netlist.h"
 #include "pb_type_graph.h"
+#include "binary_packed_netlist.h"
 
 static const char* netlist_file_name = nullptr;
 
+static void read_netlist_blocks(const char* net_file,
+                                const t_arch* arch,
+                                bool verify_file_digests,
+                                int* num_primitives,
+                                ClusteredNetlist* clb_nlist);
+
 static int processPorts(pugi::xml_node Parent, t_pb* pb, t_pb_routes& pb_route, const pugiutil::loc_data& loc_data);
 
 static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* pb, t_pb_routes& pb_route, int* num_primitives, const pugiutil::loc_data& loc_data, ClusteredNetlist* clb_nlist);
@@ -64,14 +71,14 @@ static void set_atom_pin_mapping(const ClusteredNetlist& clb_nlist, const AtomBl
 /**
  * Initializes the clb_nlist with info from a netlist
  * net_file - Name of the netlist file to read
+ * net_cache_file - Name of the binary netlist file which caches the netlist file (optional)
  */
 ClusteredNetlist read_netlist(const char* net_file,
                               const t_arch* arch,
                               bool verify_file_digests,
+                              const std::string& net_cache_file,
                               int verbosity) {
     clock_t begin = clock();
-    size_t bcount = 0;
-    std::vector<std::string> circuit_inputs, circuit_outputs, circuit_clocks;
 
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
 
@@ -83,6 +90,102 @@ ClusteredNetlist read_netlist(const char* net_file,
     //Save an identifier for the netlist based on it's contents
     auto clb_nlist = ClusteredNetlist(net_file, vtr::secure_digest_file(net_file));
 
+    //Reset atom/pb mapping (it is reloaded from the packed netlist file)
+    for (auto blk_id : atom_ctx.nlist.blocks())
+        atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
+
+    //The binary netlist is only loaded if it is written from the same netlist file, architecture and atom netlist
+    std::string net_cache_id = vtr::string_fmt("%s;%s;%s", clb_nlist.netlist_id().c_str(),
+                                               arch->architecture_id, atom_ctx.nlist.netlist_id().c_str());
+    bool net_cache_loaded = false;
+    if (!net_cache_file.empty()) {
+        net_cache_loaded = read_binary_packed_netlist(net_cache_file, clb_nlist, net_cache_id, &num_primitives);
+    }
+    if (net_cache_loaded) {
+        for (auto blk_id : clb_nlist.blocks()) {
+            load_internal_to_block_net_nums(clb_nlist.block_type(blk_id), clb_nlist.block_pb(blk_id)->pb_route);
+        }
+    } else {
+        read_netlist_blocks(net_file, arch, verify_file_digests, &num_primitives, &clb_nlist);
+    }
+
+    VTR_ASSERT(num_primitives >= 0);
+    VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.nlist.blocks().size());
+
+    /* Error check */
+    for (auto blk_id : atom_ctx.nlist.blocks()) {
+        if (atom_ctx.lookup.atom_pb(blk_id) == nullptr) {
+            VPR_FATAL_ERROR(VPR_ERROR_NET_F,
+                            ".blif file and .net file do not match, .net file missing atom %s.\n",
+                            atom_ctx.nlist.block_name(blk_id).c_str());
+        }
+    }
+    /* TODO: Add additional check to make sure net connections match */
+    mark_constant_generators(clb_nlist, verbosity);
+
+    load_external_nets_and_cb(clb_nlist);
+
+    /* TODO: create this function later
+     * check_top_IO_matches_IO_blocks(circuit_inputs, circuit_outputs, circuit_clocks, blist, bcount); */
+
+    /* load mapping between external nets and all nets */
+    for (auto net_id : atom_ctx.nlist.nets()) {
+        atom_ctx.lookup.set_atom_clb_net(net_id, ClusterNetId::INVALID());
+    }
+
+    //Save the mapping between clb and atom nets
+    for (auto clb_net_id : clb_nlist.nets()) {
+        AtomNetId net_id = atom_ctx.nlist.find_net(clb_nlist.net_name(clb_net_id));
+        VTR_ASSERT(net_id);
+        atom_ctx.lookup.set_atom_clb_net(net_id, clb_net_id);
+    }
+
+    /* load mapping between atom pins and pb_graph_pins */
+    load_atom_pin_mapping(clb_nlist);
+
+    clock_t end = clock();
+
+    VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
+
+    if (!net_cache_file.empty() && !net_cache_loaded) {
+        write_binary_packed_netlist(net_cache_file, clb_nlist, net_cache_id);
+    }
+
+    size_t num_pb_route_used = 0;
+    size_t num_pb_route_alloc = 0;
+    size_t num_pb_pins = 0;
+    for (auto clb : clb_nlist.blocks()) {
+        t_pb* pb = clb_nlist.block_pb(clb);
+
+        for (int ipin = 0; ipin < pb->pb_graph_node->total_pb_pins; ++ipin) {
+            if (pb->pb_route.count(ipin)) {
+                ++num_pb_route_alloc;
+                if (pb->pb_route[ipin].atom_net_id) {
+                    ++num_pb_route_used;
+                }
+            }
+            ++num_pb_pins;
+        }
+    }
+
+    return clb_nlist;
+}
+
+/**
+ * Loads the clustered blocks of a netlist file, with their internal nets
+ * net_file - Name of the netlist file to read
+ * num_primitives - Number of primitives in the loaded blocks
+ */
+static void read_netlist_blocks(const char* net_file,
+                                const t_arch* arch,
+                                bool verify_file_digests,
+                                int* num_primitives,
+                                ClusteredNetlist* clb_nlist) {
+    size_t bcount = 0;
+    std::vector<std::string> circuit_inputs, circuit_outputs, circuit_clocks;
+
+    auto& atom_ctx = g_vpr_ctx.mutable_atom();
+
     pugi::xml_document doc;
     pugiutil::loc_data loc_data;
     try {
@@ -175,10 +278,6 @@ ClusteredNetlist read_netlist(const char* net_file,
 
         /* Parse all CLB blocks and all nets*/
 
-        //Reset atom/pb mapping (it is reloaded from the packed netlist file)
-        for (auto blk_id : atom_ctx.nlist.blocks())
-            atom_ctx.lookup.set_atom_pb(blk_id, nullptr);
-
         //Count the number of blocks for allocation
         bcount = pugiutil::count_children(top, "block", loc_data, pugiutil::ReqOpt::OPTIONAL);
         if (bcount == 0)
@@ -187,71 +286,15 @@ ClusteredNetlist read_netlist(const char* net_file,
         /* Process netlist */
         unsigned i = 0;
         for (auto curr_block = top.child("block"); curr_block; curr_block = curr_block.next_sibling("block")) {
-            processComplexBlock(curr_block, ClusterBlockId(i), &num_primitives, loc_data, &clb_nlist);
+            processComplexBlock(curr_block, ClusterBlockId(i), num_primitives, loc_data, clb_nlist);
             i++;
         }
         VTR_ASSERT(bcount == i);
-        VTR_ASSERT(clb_nlist.blocks().size() == i);
-        VTR_ASSERT(num_primitives >= 0);
-        VTR_ASSERT(static_cast<size_t>(num_primitives) == atom_ctx.nlist.blocks().size());
-
-        /* Error check */
-        for (auto blk_id : atom_ctx.nlist.blocks()) {
-            if (atom_ctx.lookup.atom_pb(blk_id) == nullptr) {
-                VPR_FATAL_ERROR(VPR_ERROR_NET_F,
-                                ".blif file and .net file do not match, .net file missing atom %s.\n",
-                                atom_ctx.nlist.block_name(blk_id).c_str());
-            }
-        }
-        /* TODO: Add additional check to make sure net connections match */
-        mark_constant_generators(clb_nlist, verbosity);
-
-        load_external_nets_and_cb(clb_nlist);
+        VTR_ASSERT(clb_nlist->blocks().size() == i);
     } catch (pugiutil::XmlError& e) {
         vpr_throw(VPR_ERROR_NET_F, e.filename_c_str(), e.line(),
                   "Error loading post-pack netlist (%s)", e.what());
     }
-
-    /* TODO: create this function later
-     * check_top_IO_matches_IO_blocks(circuit_inputs, circuit_outputs, circuit_clocks, blist, bcount); */
-
-    /* load mapping between external nets and all nets */
-    for (auto net_id : atom_ctx.nlist.nets()) {
-        atom_ctx.lookup.set_atom_clb_net(net_id, ClusterNetId::INVALID());
-    }
-
-    //Save the mapping between clb and atom nets
-    for (auto clb_net_id : clb_nlist.nets()) {
-        AtomNetId net_id = atom_ctx.nlist.find_net(clb_nlist.net_name(clb_net_id));
-        VTR_ASSERT(net_id);
-        atom_ctx.lookup.set_atom_clb_net(net_id, clb_net_id);
-    }
-
-    /* load mapping between atom pins and pb_graph_pins */
-    load_atom_pin_mapping(clb_nlist);
-
-    clock_t end = clock();
-
-    VTR_LOG("Finished loading packed FPGA netlist file (took %g seconds).\n", (float)(end - begin) / CLOCKS_PER_SEC);
-
-    size_t num_pb_route_used = 0;
-    size_t num_pb_route_alloc = 0;
-    size_t num_pb_pins = 0;
-    for (auto clb : clb_nlist.blocks()) {
-        t_pb* pb = clb_nlist.block_pb(clb);
-
-        for (int ipin = 0; ipin < pb->pb_graph_node->total_pb_pins; ++ipin) {
-            if (pb->pb_route.count(ipin)) {
-                ++num_pb_route_alloc;
-                if (pb->pb_route[ipin].atom_net_id) {
-                    ++num_pb_route_used;
-                }
-            }
-            ++num_pb_pins;
-        }
-    }
-
-    return clb_nlist;
 }
 
 /**
@@ -293,6 +336,7 @@ static void processComplexBlock(pugi::xml_node clb_block,
         if (strcmp(type.name, tokens[0].data) == 0) {
             t_pb* pb = new t_pb;
             pb->name = vtr::strdup(block_name.value());
+            pb->child_pbs_arena = clb_nlist->pb_arena();
             clb_nlist->create_block(block_name.value(), pb, &type);
             pb_type = clb_nlist->block_type(index)->pb_type;
             found = true;
@@ -443,10 +487,7 @@ static void processPb(pugi::xml_node Parent, const ClusterBlockId index, t_pb* p
     } else {
         /* process children of child if exists */
 
-        pb->child_pbs = new t_pb*[pb_type->modes[pb->mode].num_pb_type_children];
-        for (i = 0; i < pb_type->modes[pb->mode].num_pb_type_children; i++) {
-            pb->child_pbs[i] = new t_pb[pb_type->modes[pb->mode].pb_type_children[i].num_pb];
-        }
+        alloc_child_pbs(pb, pb_type->modes[pb->mode]);
 
         /* Populate info for each physical block */
         for (auto child = Parent.child("block"); child; child = child.next_sibling("block")) {
@@ -8,11 +8,13 @@
 #ifndef READ_NETLIST_H
 #define READ_NETLIST_H
 
+#include <string>
 #include "vpr_types.h"
 
 ClusteredNetlist read_netlist(const char* net_file,
                               const t_arch* arch,
                               bool verify_file_digests,
+                              const std::string& net_cache_file,
                               int verbosity);
 
 #endif
@@ -308,6 +308,37 @@ struct ParsePlaceAlgorithm {
     }
 };
 
+struct ParseInitialPlacement {
+    ConvertedValue<e_initial_placement> from_str(std::string str) {
+        ConvertedValue<e_initial_placement> conv_value;
+        if (str == "random")
+            conv_value.set_value(e_initial_placement::RANDOM);
+        else if (str == "analytic")
+            conv_value.set_value(e_initial_placement::ANALYTIC);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '" << str << "' to e_initial_placement (expected one of: " << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_initial_placement val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_initial_placement::RANDOM)
+            conv_value.set_value("random");
+        else {
+            VTR_ASSERT(val == e_initial_placement::ANALYTIC);
+            conv_value.set_value("analytic");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"random", "analytic"};
+    }
+};
+
 struct ParseClusterSeed {
     ConvertedValue<e_cluster_seed> from_str(std::string str) {
         ConvertedValue<e_cluster_seed> conv_value;
@@ -645,6 +676,74 @@ struct ParseRouteBBUpdate {
     }
 };
 
+struct ParseCheckLevel {
+    ConvertedValue<e_check_level> from_str(std::string str) {
+        ConvertedValue<e_check_level> conv_value;
+        if (str == "full")
+            conv_value.set_value(e_check_level::FULL);
+        else if (str == "sampled")
+            conv_value.set_value(e_check_level::SAMPLED);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '"
+                << str
+                << "' to e_check_level (expected one of: "
+                << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_check_level val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_check_level::FULL)
+            conv_value.set_value("full");
+        else {
+            VTR_ASSERT(val == e_check_level::SAMPLED);
+            conv_value.set_value("sampled");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"full", "sampled"};
+    }
+};
+
+struct ParseRouterHeap {
+    ConvertedValue<e_heap_type> from_str(std::string str) {
+        ConvertedValue<e_heap_type> conv_value;
+        if (str == "binary")
+            conv_value.set_value(e_heap_type::BINARY_HEAP);
+        else if (str == "four_ary")
+            conv_value.set_value(e_heap_type::FOUR_ARY_HEAP);
+        else {
+            std::stringstream msg;
+            msg << "Invalid conversion from '"
+                << str
+                << "' to e_heap_type (expected one of: "
+                << argparse::join(default_choices(), ", ") << ")";
+            conv_value.set_error(msg.str());
+        }
+        return conv_value;
+    }
+
+    ConvertedValue<std::string> to_str(e_heap_type val) {
+        ConvertedValue<std::string> conv_value;
+        if (val == e_heap_type::BINARY_HEAP)
+            conv_value.set_value("binary");
+        else {
+            VTR_ASSERT(val == e_heap_type::FOUR_ARY_HEAP);
+            conv_value.set_value("four_ary");
+        }
+        return conv_value;
+    }
+
+    std::vector<std::string> default_choices() {
+        return {"binary", "four_ary"};
+    }
+};
+
 struct ParseRouterLookahead {
     ConvertedValue<e_router_lookahead> from_str(std::string str) {
         ConvertedValue<e_router_lookahead> conv_value;
@@ -937,6 +1036,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument<bool, ParseOnOff>(args.device_only, "--device_only")
+        .help(
+            "Only builds the device grid and the routing resource graph, without reading the circuit"
+            " or running packing, placement and routing (useful to generate a fabric without any design)."
+            " The circuit name is only used to name output files."
+            " Requires a fixed device layout (--device) and a fixed channel width (--route_chan_width)")
+        .default_value("off")
+        .action(argparse::Action::STORE_TRUE)
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<bool, ParseOnOff>(args.strict_checks, "--strict_checks")
         .help(
             "Controls whether VPR enforces some consistency checks strictly (as errors) or treats them as warnings."
@@ -948,6 +1057,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("on")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    gen_grp.add_argument<e_check_level, ParseCheckLevel>(args.check_level, "--check_level")
+        .help(
+            "Controls how much of the routing resource graph and of the routing is checked once built:\n"
+            " * full: all the nodes, edges and nets are checked\n"
+            " * sampled: only a fixed sample of the nodes and nets (one out of 16) is checked,"
+            " which is much faster on large devices and designs\n"
+            "The checks run in parallel, using the number of workers given by --num_workers.")
+        .default_value("full")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     gen_grp.add_argument<std::string>(args.disable_errors, "--disable_errors")
         .help(
             "Parses a list of functions for which the errors are going to be treated as warnings.\n"
@@ -999,10 +1118,29 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Path to packed netlist file")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.NetCacheFile, "--net_cache")
+        .help(
+            "Caches the packed netlist in the specified binary file (e.g., fpga.net.bin)."
+            " The packing is loaded from the file if it was written from the same packed netlist file,"
+            " architecture and circuit, otherwise the packed netlist file is parsed and the binary file is written."
+            " Requires VPR to be compiled with VTR_ENABLE_CAPNPROTO=ON")
+        .metavar("NET_CACHE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.PlaceFile, "--place_file")
         .help("Path to placement file")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.PlaceCacheFile, "--place_cache")
+        .help(
+            "Caches the placement in the specified binary file (e.g., fpga.place.bin)."
+            " The placement is loaded from the file if it was written from the same placement file,"
+            " packed netlist and device, otherwise the placement file is parsed and the binary file is written."
+            " The binary file is also written when the placement is generated."
+            " Requires VPR to be compiled with VTR_ENABLE_CAPNPROTO=ON")
+        .metavar("PLACE_CACHE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.RouteFile, "--route_file")
         .help("Path to routing file")
         .show_in(argparse::ShowIn::HELP_ONLY);
@@ -1011,18 +1149,38 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Path to timing constraints file in SDC format")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.TraceFile, "--trace_file")
+        .help(
+            "Writes the spans of the hot paths (e.g. router iterations, placer temperatures) to the specified"
+            " Chrome trace (JSON) file, which can be loaded in chrome://tracing or https://ui.perfetto.dev."
+            " Requires VPR to be compiled with VTR_ENABLE_TRACING=ON")
+        .metavar("TRACE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_rr_graph_file, "--read_rr_graph")
         .help(
             "The routing resource graph file to load."
-            " The loaded routing resource graph overrides any routing architecture specified in the architecture file.")
+            " The loaded routing resource graph overrides any routing architecture specified in the architecture file."
+            " Files with the .xml.gz extension are decompressed from gzip format.")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
     file_grp.add_argument(args.write_rr_graph_file, "--write_rr_graph")
-        .help("Writes the routing resource graph to the specified file")
+        .help(
+            "Writes the routing resource graph to the specified file."
+            " The file is compressed in gzip format if its name ends with .gz (e.g., rr_graph.xml.gz).")
         .metavar("RR_GRAPH_FILE")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.rr_graph_cache_file, "--rr_graph_cache")
+        .help(
+            "Caches the tileable routing resource graph in the specified binary file (e.g., fpga.rr.bin)."
+            " The graph is loaded from the file if it was built from the same architecture and channel widths,"
+            " otherwise the graph is built and written to the file."
+            " Requires VPR to be compiled with VTR_ENABLE_CAPNPROTO=ON")
+        .metavar("RR_GRAPH_CACHE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_router_lookahead, "--read_router_lookahead")
         .help(
             "Reads the lookahead data from the specified file instead of computing it.")
@@ -1032,6 +1190,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .help("Writes the lookahead data to the specified file.")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    file_grp.add_argument(args.router_lookahead_cache_file, "--router_lookahead_cache")
+        .help(
+            "Caches the map router lookahead in the specified binary file (e.g., fpga.lookahead.bin)."
+            " The lookahead is loaded from the file if it was computed from the same routing resource graph,"
+            " otherwise the lookahead is computed and written to the file."
+            " Requires VPR to be compiled with VTR_ENABLE_CAPNPROTO=ON")
+        .metavar("ROUTER_LOOKAHEAD_CACHE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     file_grp.add_argument(args.read_placement_delay_lookup, "--read_placement_delay_lookup")
         .help(
             "Reads the placement delay lookup from the specified file instead of computing it.")
@@ -1289,6 +1456,18 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .choices({"bounding_box", "path_timing_driven"})
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument<e_initial_placement, ParseInitialPlacement>(args.initial_placement, "--initial_placement")
+        .help(
+            "Controls how the blocks are placed before the annealing:\n"
+            " * random: at random locations\n"
+            " * analytic: at the legalized locations of a force-directed solution,"
+            " where the I/Os and the fixed blocks pull the other blocks through the nets."
+            " The annealing then starts at a lower temperature, estimated from the"
+            " cost changes of moves around this placement, which shortens the annealing.")
+        .default_value("random")
+        .choices({"random", "analytic"})
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     place_grp.add_argument(args.PlaceChanWidth, "--place_chan_width")
         .help(
             "Sets the assumed channel width during placement. "
@@ -1310,6 +1489,16 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_grp.add_argument<bool, ParseOnOff>(args.parallel_placement, "--parallel_placement")
+        .help(
+            "Evaluates batches of independent moves (which affect disjoint locations and nets)"
+            " at the same time, using the number of workers given by --num_workers."
+            " The moves are accepted one after another in a fixed order,"
+            " so the placement does not depend on the number of workers"
+            " (but differs from the placement with this option off).")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& place_timing_grp = parser.add_argument_group("timing-driven placement options");
 
     place_timing_grp.add_argument(args.PlaceTimingTradeoff, "--timing_tradeoff")
@@ -1405,6 +1594,14 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    place_timing_grp.add_argument<bool, ParseOnOff>(args.place_incremental_timing_analysis, "--place_incremental_timing_analysis")
+        .help(
+            "Controls whether the timing analyses during placement only re-analyze the parts"
+            " of the timing graph affected by the connections whose delays changed since the"
+            " previous analysis. The results are the same as with full timing analyses.")
+        .default_value("on")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& route_grp = parser.add_argument_group("routing options");
 
     route_grp.add_argument(args.max_router_iterations, "--max_router_iterations")
@@ -1490,6 +1687,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("off")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument<bool, ParseOnOff>(args.freeze_rr_graph, "--freeze_rr_graph")
+        .help(
+            "Freezes the routing resource graph once it is built,"
+            " storing its edges, ptc numbers and node look-up in compact arrays."
+            " This speeds up the queries of the router and reduces memory usage,"
+            " while the graph can no longer be modified")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_grp.add_argument<e_router_algorithm, ParseRouterAlgorithm>(args.RouterAlgorithm, "--router_algorithm")
         .help(
             "Specifies the router algorithm to use.\n"
@@ -1504,6 +1710,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("16")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_grp.add_argument(args.incremental_route_file, "--incremental_route")
+        .help(
+            "Routes incrementally from the specified .route file of a previous run (e.g., after a small netlist or placement change)."
+            " The nets whose terminals are unchanged keep their previous routing, which also seeds the congestion costs;"
+            " only the other nets (and those found congested) are re-routed."
+            " Requires the timing-driven router and the same routing resource graph as the previous run")
+        .metavar("ROUTE_FILE")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     auto& route_timing_grp = parser.add_argument_group("timing-driven routing options");
 
     route_timing_grp.add_argument(args.astar_fac, "--astar_fac")
@@ -1599,6 +1814,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("classic")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<e_heap_type, ParseRouterHeap>(args.router_heap, "--router_heap")
+        .help(
+            "Controls the priority queue of the nodes expanded by the timing-driven router.\n"
+            " * binary: A binary heap, which may hold several entries of the same node\n"
+            " * four_ary: A 4-ary heap indexed by node, which holds at most one entry per node\n"
+            "             and updates it when a cheaper path to the node is found\n")
+        .default_value("binary")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_max_convergence_count, "--router_max_convergence_count")
         .help(
             "Controls how many times the router is allowed to converge to a legal routing before halting."
@@ -1620,6 +1844,15 @@ argparse::ArgumentParser create_arg_parser(std::string prog_name, t_options& arg
         .default_value("")
         .show_in(argparse::ShowIn::HELP_ONLY);
 
+    route_timing_grp.add_argument<bool, ParseOnOff>(args.parallel_routing, "--parallel_routing")
+        .help(
+            "Routes the nets of disjoint regions of the device at the same time,"
+            " using the number of workers given by --num_workers."
+            " Nets crossing the regions are routed first, one after another."
+            " The routing does not depend on the number of workers.")
+        .default_value("off")
+        .show_in(argparse::ShowIn::HELP_ONLY);
+
     route_timing_grp.add_argument(args.router_debug_net, "--router_debug_net")
         .help(
             "Controls when router debugging is enabled.\n"
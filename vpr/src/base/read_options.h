@@ -12,13 +12,16 @@ struct t_options {
     argparse::ArgValue<std::string> ArchFile;
     argparse::ArgValue<std::string> CircuitName;
     argparse::ArgValue<std::string> NetFile;
+    argparse::ArgValue<std::string> NetCacheFile;
     argparse::ArgValue<std::string> PlaceFile;
+    argparse::ArgValue<std::string> PlaceCacheFile;
     argparse::ArgValue<std::string> RouteFile;
     argparse::ArgValue<std::string> BlifFile;
     argparse::ArgValue<std::string> ActFile;
     argparse::ArgValue<std::string> PowerFile;
     argparse::ArgValue<std::string> CmosTechFile;
     argparse::ArgValue<std::string> SDCFile;
+    argparse::ArgValue<std::string> TraceFile;
 
     argparse::ArgValue<e_circuit_format> circuit_format;
 
@@ -26,12 +29,14 @@ struct t_options {
     argparse::ArgValue<std::string> pad_loc_file;
     argparse::ArgValue<std::string> write_rr_graph_file;
     argparse::ArgValue<std::string> read_rr_graph_file;
+    argparse::ArgValue<std::string> rr_graph_cache_file;
 
     argparse::ArgValue<std::string> write_placement_delay_lookup;
     argparse::ArgValue<std::string> read_placement_delay_lookup;
 
     argparse::ArgValue<std::string> write_router_lookahead;
     argparse::ArgValue<std::string> read_router_lookahead;
+    argparse::ArgValue<std::string> router_lookahead_cache_file;
 
     /* Stage Options */
     argparse::ArgValue<bool> do_packing;
@@ -58,7 +63,9 @@ struct t_options {
     argparse::ArgValue<e_clock_modeling> clock_modeling;
     argparse::ArgValue<bool> two_stage_clock_routing;
     argparse::ArgValue<bool> exit_before_pack;
+    argparse::ArgValue<bool> device_only;
     argparse::ArgValue<bool> strict_checks;
+    argparse::ArgValue<e_check_level> check_level;
     argparse::ArgValue<std::string> disable_errors;
     argparse::ArgValue<std::string> suppress_warnings;
     argparse::ArgValue<bool> allow_dangling_combinational_nodes;
@@ -97,10 +104,12 @@ struct t_options {
     argparse::ArgValue<float> PlaceAlphaT;
     argparse::ArgValue<sched_type> anneal_sched_type;
     argparse::ArgValue<e_place_algorithm> PlaceAlgorithm;
+    argparse::ArgValue<e_initial_placement> initial_placement;
     argparse::ArgValue<e_pad_loc_type> pad_loc_type;
     argparse::ArgValue<int> PlaceChanWidth;
     argparse::ArgValue<float> place_rlim_escape_fraction;
     argparse::ArgValue<std::string> place_move_stats_file;
+    argparse::ArgValue<bool> parallel_placement;
 
     /* Timing-driven placement options only */
     argparse::ArgValue<float> PlaceTimingTradeoff;
@@ -117,6 +126,7 @@ struct t_options {
     argparse::ArgValue<PlaceDelayModelType> place_delay_model;
     argparse::ArgValue<e_reducer> place_delay_model_reducer;
     argparse::ArgValue<std::string> allowed_tiles_for_delay_model;
+    argparse::ArgValue<bool> place_incremental_timing_analysis;
 
     /* Router Options */
     argparse::ArgValue<int> max_router_iterations;
@@ -131,8 +141,10 @@ struct t_options {
     argparse::ArgValue<int> RouteChanWidth;
     argparse::ArgValue<int> min_route_chan_width_hint; //Hint to binary search router about what the min chan width is
     argparse::ArgValue<bool> verify_binary_search;
+    argparse::ArgValue<bool> freeze_rr_graph;
     argparse::ArgValue<e_router_algorithm> RouterAlgorithm;
     argparse::ArgValue<int> min_incremental_reroute_fanout;
+    argparse::ArgValue<std::string> incremental_route_file;
 
     /* Timing-driven router options only */
     argparse::ArgValue<float> astar_fac;
@@ -149,9 +161,11 @@ struct t_options {
     argparse::ArgValue<int> router_debug_net;
     argparse::ArgValue<int> router_debug_sink_rr;
     argparse::ArgValue<e_router_lookahead> router_lookahead_type;
+    argparse::ArgValue<e_heap_type> router_heap;
     argparse::ArgValue<int> router_max_convergence_count;
     argparse::ArgValue<float> router_reconvergence_cpd_threshold;
     argparse::ArgValue<std::string> router_first_iteration_timing_report_file;
+    argparse::ArgValue<bool> parallel_routing;
 
     /* Analysis options */
     argparse::ArgValue<bool> full_stats;
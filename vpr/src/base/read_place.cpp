@@ -1,11 +1,13 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <limits>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
 #include "vtr_log.h"
 #include "vtr_digest.h"
+#include "vtr_time.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -15,10 +17,56 @@
 #include "read_place.h"
 #include "read_xml_arch_file.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "placement.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+static void read_place_file(const char* net_file,
+                            const char* place_file,
+                            bool verify_file_digests,
+                            const DeviceGrid& grid);
+
+static bool read_place_cache(const std::string& place_cache_file,
+                             const std::string& place_cache_id);
+
+/* The id of a binary placement: the placement file, the packed netlist and the device grid it is written from */
+static std::string find_place_cache_id(const std::string& placement_id,
+                                       const DeviceGrid& grid) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    return vtr::string_fmt("%s;%s;%zux%zu", placement_id.c_str(), cluster_ctx.clb_nlist.netlist_id().c_str(),
+                           grid.width(), grid.height());
+}
+
 void read_place(const char* net_file,
                 const char* place_file,
+                const std::string& place_cache_file,
                 bool verify_file_digests,
                 const DeviceGrid& grid) {
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    //The binary placement is only loaded if it is written from the same placement file
+    if (!place_cache_file.empty() && vtr::file_exists(place_file)) {
+        std::string placement_id = vtr::secure_digest_file(place_file);
+        if (read_place_cache(place_cache_file, find_place_cache_id(placement_id, grid))) {
+            place_ctx.placement_id = placement_id;
+            return;
+        }
+    }
+
+    read_place_file(net_file, place_file, verify_file_digests, grid);
+
+    if (!place_cache_file.empty()) {
+        write_place_cache(place_cache_file, grid);
+    }
+}
+
+static void read_place_file(const char* net_file,
+                            const char* place_file,
+                            bool verify_file_digests,
+                            const DeviceGrid& grid) {
     std::ifstream fstream(place_file);
     if (!fstream) {
         VPR_FATAL_ERROR(VPR_ERROR_PLACE_F,
@@ -318,3 +366,98 @@ void print_place(const char* net_file,
     //Calculate the ID of the placement
     place_ctx.placement_id = vtr::secure_digest_file(place_file);
 }
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void write_place_cache(const std::string& /*place_cache_file*/,
+                       const DeviceGrid& /*grid*/) {
+    VPR_THROW(VPR_ERROR_PLACE_F, "write_place_cache " DISABLE_ERROR);
+}
+
+static bool read_place_cache(const std::string& /*place_cache_file*/,
+                             const std::string& /*place_cache_id*/) {
+    VPR_THROW(VPR_ERROR_PLACE_F, "read_place_cache " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* Writes the block locations of the current placement to a binary placement,
+ * identified by the placement file the placement is loaded from or written to */
+void write_place_cache(const std::string& place_cache_file,
+                       const DeviceGrid& grid) {
+    vtr::ScopedStartFinishTimer timer("Write binary placement to '" + place_cache_file + "'");
+
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+    VTR_ASSERT(place_ctx.block_locs.size() == cluster_ctx.clb_nlist.blocks().size());
+
+    ::capnp::MallocMessageBuilder builder;
+    auto placement = builder.initRoot<VprPlacement>();
+    placement.setId(find_place_cache_id(place_ctx.placement_id, grid));
+
+    size_t num_blocks = cluster_ctx.clb_nlist.blocks().size();
+    auto x = placement.initX(num_blocks);
+    auto y = placement.initY(num_blocks);
+    auto sub_tile = placement.initSubTile(num_blocks);
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        const t_pl_loc& loc = place_ctx.block_locs[blk_id].loc;
+        x.set(size_t(blk_id), loc.x);
+        y.set(size_t(blk_id), loc.y);
+        sub_tile.set(size_t(blk_id), loc.z);
+    }
+
+    writeMessageToFile(place_cache_file, &builder);
+}
+
+/* Loads the block locations from a binary placement if its id matches,
+ * otherwise the placement is not touched */
+static bool read_place_cache(const std::string& place_cache_file,
+                             const std::string& place_cache_id) {
+    if (!vtr::file_exists(place_cache_file.c_str())) {
+        return false;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Read binary placement from '" + place_cache_file + "'");
+
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    MmapFile f(place_cache_file);
+
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    ::capnp::FlatArrayMessageReader reader(f.getData(), options);
+
+    VprPlacement::Reader placement = reader.getRoot<VprPlacement>();
+    if (place_cache_id != std::string(placement.getId().cStr())) {
+        VTR_LOG_WARN("Binary placement '%s' is written from a different placement file, packed netlist or device!\n",
+                     place_cache_file.c_str());
+        return false;
+    }
+
+    size_t num_blocks = cluster_ctx.clb_nlist.blocks().size();
+    auto x = placement.getX();
+    auto y = placement.getY();
+    auto sub_tile = placement.getSubTile();
+    if (num_blocks != x.size() || num_blocks != y.size() || num_blocks != sub_tile.size()) {
+        VTR_LOG_WARN("Binary placement '%s' is corrupted!\n",
+                     place_cache_file.c_str());
+        return false;
+    }
+
+    place_ctx.block_locs.resize(num_blocks);
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        t_pl_loc& loc = place_ctx.block_locs[blk_id].loc;
+        loc.x = x[size_t(blk_id)];
+        loc.y = y[size_t(blk_id)];
+        loc.z = sub_tile[size_t(blk_id)];
+    }
+
+    return true;
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -1,12 +1,18 @@
 #ifndef READ_PLACE_H
 #define READ_PLACE_H
 
+#include <string>
+
 void read_place(
     const char* net_file,
     const char* place_file,
+    const std::string& place_cache_file,
     bool verify_file_hashes,
     const DeviceGrid& grid);
 
+void write_place_cache(const std::string& place_cache_file,
+                       const DeviceGrid& grid);
+
 void print_place(const char* net_file,
                  const char* net_id,
                  const char* place_file);
@@ -9,6 +9,7 @@
  * formats are incorrect or when the routing file does not match
  * other file's information*/
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <cstdio>
@@ -49,6 +50,8 @@ static void process_global_blocks(std::ifstream& fp, ClusterNetId inet, const ch
 static void format_coordinates(int& x, int& y, std::string coord, ClusterNetId net, const char* filename, const int lineno);
 static void format_pin_info(std::string& pb_name, std::string& port_name, int& pb_pin_num, std::string input);
 static std::string format_name(std::string name);
+static bool parse_incremental_route_node(const std::vector<std::string>& tokens, RRNodeId& node, int& iswitch);
+static bool is_incremental_route_reusable(ClusterNetId net_id, const std::vector<std::pair<RRNodeId, int>>& route);
 
 /*************Global Functions****************************/
 bool read_route(const char* route_file, const t_router_opts& router_opts, bool verify_file_digests) {
@@ -126,6 +129,106 @@ bool read_route(const char* route_file, const t_router_opts& router_opts, bool v
     return is_feasible;
 }
 
+std::vector<ClusterNetId> read_incremental_route(const char* route_file) {
+    /* Loads the traceback of the nets of a previous .route file which can be kept as
+     * they are, i.e., the nets whose routing still matches the rr graph and which still
+     * connect the same source and sinks (their blocks were not moved or modified).
+     * Unlike read_route(), any mismatch is not an error, but leaves the net unrouted
+     * so that the router re-routes it. Nets are matched by name, as the ids of the
+     * nets may change with the netlist. Returns the nets whose routing was loaded. */
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    VTR_LOG("Begin loading the previous routing from '%s' for incremental routing.\n", route_file);
+
+    std::ifstream fp;
+    fp.open(route_file);
+    if (!fp.is_open()) {
+        vpr_throw(VPR_ERROR_ROUTE, route_file, 0,
+                  "Cannot open %s routing file", route_file);
+    }
+
+    //Traceback (node and switch) of each net found, and whether all its nodes are valid
+    vtr::vector<ClusterNetId, std::vector<std::pair<RRNodeId, int>>> prev_routes(cluster_ctx.clb_nlist.nets().size());
+    vtr::vector<ClusterNetId, bool> valid_routes(cluster_ctx.clb_nlist.nets().size(), false);
+
+    ClusterNetId curr_net = ClusterNetId::INVALID();
+    std::string input;
+    int lineno = 0;
+    while (std::getline(fp, input)) {
+        ++lineno;
+        std::vector<std::string> tokens = vtr::split(input);
+        if (tokens.empty() || tokens[0][0] == '#') {
+            continue; //Skip blank and commented lines
+        }
+
+        if (tokens[0] == "Array" && tokens.size() > 4 && tokens[1] == "size:"
+            && (vtr::atou(tokens[2].c_str()) != device_ctx.grid.width() || vtr::atou(tokens[4].c_str()) != device_ctx.grid.height())) {
+            VTR_LOGF_WARN(route_file, lineno,
+                          "Device dimensions %sx%s do not match the given %lux%lu: all the nets are re-routed\n",
+                          tokens[2].c_str(), tokens[4].c_str(), device_ctx.grid.width(), device_ctx.grid.height());
+            fp.close();
+            return std::vector<ClusterNetId>();
+        } else if (tokens[0] == "Net" && tokens.size() > 2) {
+            curr_net = ClusterNetId::INVALID();
+            //Global nets (whose name ends with a colon) are never routed
+            if (tokens[2].length() > 2 && tokens[2].back() == ')') {
+                ClusterNetId net_id = cluster_ctx.clb_nlist.find_net(format_name(tokens[2]));
+                if (net_id && !cluster_ctx.clb_nlist.net_is_ignored(net_id) && prev_routes[net_id].empty()) {
+                    curr_net = net_id;
+                    valid_routes[curr_net] = true;
+                }
+            }
+        } else if (tokens[0] == "Node:" && curr_net) {
+            RRNodeId node;
+            int iswitch;
+            if (valid_routes[curr_net] && parse_incremental_route_node(tokens, node, iswitch)) {
+                prev_routes[curr_net].emplace_back(node, iswitch);
+            } else {
+                valid_routes[curr_net] = false;
+            }
+        }
+    }
+    fp.close();
+
+    std::vector<ClusterNetId> loaded_nets;
+    size_t num_routed_nets = 0;
+    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            continue;
+        }
+        ++num_routed_nets;
+        if (!valid_routes[net_id] || !is_incremental_route_reusable(net_id, prev_routes[net_id])) {
+            continue;
+        }
+
+        VTR_ASSERT(route_ctx.trace[net_id].head == nullptr);
+        t_trace* tail = nullptr;
+        for (const auto& elem : prev_routes[net_id]) {
+            t_trace* tptr = alloc_trace_data();
+            tptr->index = elem.first;
+            tptr->iswitch = elem.second;
+            tptr->next = nullptr;
+            if (tail) {
+                tail->next = tptr;
+            } else {
+                route_ctx.trace[net_id].head = tptr;
+            }
+            tail = tptr;
+            route_ctx.trace_nodes[net_id].insert(elem.first);
+        }
+        route_ctx.trace[net_id].tail = tail;
+
+        loaded_nets.push_back(net_id);
+    }
+
+    VTR_LOG("Kept the previous routing of %zu of %zu nets, the other %zu nets are re-routed\n",
+            loaded_nets.size(), num_routed_nets, num_routed_nets - loaded_nets.size());
+
+    return loaded_nets;
+}
+
 static void process_route(std::ifstream& fp, const char* filename, int& lineno) {
     /*Walks through every net and add the routing appropriately*/
     std::string input;
@@ -425,6 +528,103 @@ static void format_pin_info(std::string& pb_name, std::string& port_name, int& p
     }
 }
 
+/*Parse a node line of a .route file for incremental routing, returning false
+ *(rather than throwing like process_nodes) if it does not match the rr graph*/
+static bool parse_incremental_route_node(const std::vector<std::string>& tokens, RRNodeId& node, int& iswitch) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    if (tokens.size() < 4) {
+        return false;
+    }
+
+    int inode = atoi(tokens[1].c_str());
+    node = RRNodeId(inode);
+    if (inode < 0 || !rr_graph.valid_node_id(node)) {
+        return false;
+    }
+
+    if (tokens[2] != rr_node_typename[rr_graph.node_type(node)]) {
+        return false;
+    }
+
+    int x, y, x2, y2;
+    if (2 != sscanf(tokens[3].c_str(), "(%d,%d)", &x, &y)) {
+        return false;
+    }
+    x2 = x;
+    y2 = y;
+    size_t offset = 0;
+    if (tokens.size() > 5 && tokens[4] == "to") {
+        if (2 != sscanf(tokens[5].c_str(), "(%d,%d)", &x2, &y2)) {
+            return false;
+        }
+        offset = 2;
+    }
+    if (rr_graph.node_xlow(node) != x || rr_graph.node_ylow(node) != y
+        || rr_graph.node_xhigh(node) != x2 || rr_graph.node_yhigh(node) != y2) {
+        return false;
+    }
+
+    if (tokens.size() <= 5 + offset || rr_graph.node_ptc_num(node) != atoi(tokens[5 + offset].c_str())) {
+        return false;
+    }
+
+    //The switch follows the pb pin info of the OPINs and IPINs
+    auto switch_token = std::find(tokens.begin() + 6 + offset, tokens.end(), std::string("Switch:"));
+    if (switch_token == tokens.end() || switch_token + 1 == tokens.end()) {
+        return false;
+    }
+    iswitch = atoi((switch_token + 1)->c_str());
+
+    return iswitch == OPEN || (iswitch >= 0 && rr_graph.valid_switch_id(RRSwitchId(iswitch)));
+}
+
+/*Check that the previous routing of a net connects its current source to all its current
+ *sinks through edges of the rr graph, i.e., the net and its placement were not changed*/
+static bool is_incremental_route_reusable(ClusterNetId net_id, const std::vector<std::pair<RRNodeId, int>>& route) {
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& route_ctx = g_vpr_ctx.routing();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+    const std::vector<RRNodeId>& terminals = route_ctx.net_rr_terminals[net_id];
+
+    if (route.empty() || terminals.empty() || route[0].first != terminals[0]) {
+        return false;
+    }
+
+    std::unordered_set<RRNodeId> route_nodes;
+    std::vector<RRNodeId> route_sinks;
+    for (size_t ielem = 0; ielem < route.size(); ++ielem) {
+        RRNodeId node = route[ielem].first;
+        if (ielem > 0) {
+            if (route[ielem - 1].second == OPEN) {
+                //A new branch starts from a node already in the routing
+                if (!route_nodes.count(node)) {
+                    return false;
+                }
+                continue;
+            } else if (rr_graph.find_edges(route[ielem - 1].first, node).empty()) {
+                return false;
+            }
+        }
+        if (rr_graph.node_type(node) == SINK) {
+            if (route[ielem].second != OPEN) {
+                return false;
+            }
+            route_sinks.push_back(node);
+        }
+        route_nodes.insert(node);
+    }
+    if (route.back().second != OPEN) {
+        return false;
+    }
+
+    std::vector<RRNodeId> net_sinks(terminals.begin() + 1, terminals.end());
+    std::sort(route_sinks.begin(), route_sinks.end());
+    std::sort(net_sinks.begin(), net_sinks.end());
+    return route_sinks == net_sinks;
+}
+
 /*Return actual name by extracting it out of the form of (name)*/
 static std::string format_name(std::string name) {
     if (name.length() > 2) {
@@ -8,4 +8,6 @@
 
 bool read_route(const char* route_file, const t_router_opts& RouterOpts, bool verify_file_digests);
 
+std::vector<ClusterNetId> read_incremental_route(const char* route_file);
+
 #endif /* READ_ROUTE_H */
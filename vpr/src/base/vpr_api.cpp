@@ -19,6 +19,7 @@
 #include "vtr_log.h"
 #include "vtr_version.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
 #include "vtr_path.h"
 
 #include "vpr_types.h"
@@ -75,6 +76,8 @@
 
 #include "arch_util.h"
 
+#include "openfpga_simd_dispatch.h"
+
 #include "log.h"
 #include "iostream"
 
@@ -207,10 +210,16 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
 #else
     //No parallel execution support
     if (num_workers != 1) {
-        VTR_LOG_WARN("VPR was compiled without parallel execution support, ignoring the specified number of workers (%zu)",
+        VTR_LOG_WARN("VPR was compiled without parallel execution support, the specified number of workers (%zu) is only used to build tileable routing resource graphs, to compute the router lookahead map, by the parallel routing, placement and packing, and by the timing analysis",
                      options->num_workers.value());
     }
 #endif
+    VprParallelWalker::set_num_threads(num_workers);
+    VTR_LOG("Using the %s kernels\n", openfpga::simd_level_name(openfpga::simd_level()).c_str());
+
+    if (!options->TraceFile.value().empty()) {
+        vtr::start_tracing(options->TraceFile.value());
+    }
 
     vpr_setup->TimingEnabled = options->timing_analysis;
     vpr_setup->device_layout = options->device_layout;
@@ -218,6 +227,7 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     vpr_setup->clock_modeling = options->clock_modeling;
     vpr_setup->two_stage_clock_routing = options->two_stage_clock_routing;
     vpr_setup->exit_before_pack = options->exit_before_pack;
+    vpr_setup->device_only = options->device_only;
 
     VTR_LOG("\n");
     VTR_LOG("Architecture file: %s\n", options->ArchFile.value().c_str());
@@ -279,6 +289,10 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
              &vpr_setup->SaveGraphics,
              &vpr_setup->PowerOpts);
 
+    /* The tileable rr_graph builder uses its own threads, whatever the execution engine is, so pass the number of workers resolved above */
+    vpr_setup->RoutingArch.num_workers = num_workers;
+    vpr_setup->RouterOpts.num_workers = num_workers;
+
     /* Check inputs are reasonable */
     CheckArch(*arch);
 
@@ -292,6 +306,12 @@ void vpr_init_with_options(const t_options* options, t_vpr_setup* vpr_setup, t_a
     /* flush any messages to user still in stdout that hasn't gotten displayed */
     fflush(stdout);
 
+    /* Only the device is built, there is no circuit to read */
+    if (vpr_setup->device_only) {
+        ShowSetup(*vpr_setup);
+        return;
+    }
+
     /* Read blif file and sweep unused components */
     auto& atom_ctx = g_vpr_ctx.mutable_atom();
     atom_ctx.nlist = read_and_process_circuit(options->circuit_format,
@@ -343,6 +363,10 @@ bool vpr_flow(t_vpr_setup& vpr_setup, t_arch& arch) {
         return true;
     }
 
+    if (vpr_setup.device_only) {
+        return vpr_device_only_flow(vpr_setup, arch);
+    }
+
     { //Pack
         bool pack_success = vpr_pack_flow(vpr_setup, arch);
 
@@ -385,6 +409,32 @@ void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& arch) {
     }
 }
 
+/*
+ * Build the device grid and the routing resource graph only,
+ * without any circuit, e.g., to generate a fabric for any design.
+ * The device size and the channel width can not be found from
+ * the circuit, and should be given by the options
+ */
+bool vpr_device_only_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
+    if (vpr_setup.device_layout == "auto") {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "A fixed device layout (--device) is required to build the device only\n");
+    }
+    if (vpr_setup.RouterOpts.fixed_channel_width == NO_FIXED_CHANNEL_WIDTH) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "A fixed channel width (--route_chan_width) is required to build the device only\n");
+    }
+
+    vtr::ScopedStartFinishTimer timer("Create Device");
+    vpr_create_device_grid(vpr_setup, arch);
+
+    vpr_setup_clock_networks(vpr_setup, arch);
+
+    vpr_create_rr_graph(vpr_setup, arch, vpr_setup.RouterOpts.fixed_channel_width);
+
+    return true;
+}
+
 /*
  * Allocs globals: chan_width_x, chan_width_y, device_ctx.grid
  * Depends on num_clbs, pins_per_clb */
@@ -567,6 +617,7 @@ void vpr_load_packing(t_vpr_setup& vpr_setup, const t_arch& arch) {
     cluster_ctx.clb_nlist = read_netlist(vpr_setup.FileNameOpts.NetFile.c_str(),
                                          &arch,
                                          vpr_setup.FileNameOpts.verify_file_digests,
+                                         vpr_setup.FileNameOpts.NetCacheFile,
                                          vpr_setup.PackerOpts.pack_verbosity);
 
     process_constant_nets(cluster_ctx.clb_nlist, vpr_setup.constant_net_method, vpr_setup.PackerOpts.pack_verbosity);
@@ -620,6 +671,10 @@ void vpr_place(t_vpr_setup& vpr_setup, const t_arch& arch) {
     print_place(filename_opts.NetFile.c_str(),
                 cluster_ctx.clb_nlist.netlist_id().c_str(),
                 filename_opts.PlaceFile.c_str());
+
+    if (!filename_opts.PlaceCacheFile.empty()) {
+        write_place_cache(filename_opts.PlaceCacheFile, g_vpr_ctx.device().grid);
+    }
 }
 
 void vpr_load_placement(t_vpr_setup& vpr_setup, const t_arch& arch) {
@@ -630,7 +685,7 @@ void vpr_load_placement(t_vpr_setup& vpr_setup, const t_arch& arch) {
     const auto& filename_opts = vpr_setup.FileNameOpts;
 
     //Load an existing placement from a file
-    read_place(filename_opts.NetFile.c_str(), filename_opts.PlaceFile.c_str(), filename_opts.verify_file_digests, device_ctx.grid);
+    read_place(filename_opts.NetFile.c_str(), filename_opts.PlaceFile.c_str(), filename_opts.PlaceCacheFile, filename_opts.verify_file_digests, device_ctx.grid);
 
     //Ensure placement macros are loaded so that they can be drawn after placement (e.g. during routing)
     place_ctx.pl_macros = alloc_and_load_placement_macros(arch.Directs, arch.num_directs);
@@ -688,7 +743,7 @@ RouteStatus vpr_route_flow(t_vpr_setup& vpr_setup, const t_arch& arch) {
         std::string graphics_msg;
         if (route_status.success()) {
             //Sanity check the routing
-            check_route(router_opts.route_type);
+            check_route(router_opts.route_type, router_opts.check_level);
             get_serial_num();
 
             //Update status
@@ -738,6 +793,8 @@ RouteStatus vpr_route_fixed_W(t_vpr_setup& vpr_setup,
             vpr_setup.RouterOpts.lookahead_type,
             vpr_setup.RouterOpts.write_router_lookahead,
             vpr_setup.RouterOpts.read_router_lookahead,
+            vpr_setup.RouterOpts.router_lookahead_cache_file,
+            vpr_setup.RouterOpts.num_workers,
             vpr_setup.Segments);
     }
 
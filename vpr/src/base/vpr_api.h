@@ -83,6 +83,7 @@ void vpr_analysis(t_vpr_setup& vpr_setup, const t_arch& Arch, const RouteStatus&
 
 void vpr_create_device(t_vpr_setup& vpr_setup, const t_arch& Arch);                   //Create the device (grid + rr graph)
 void vpr_create_device_grid(const t_vpr_setup& vpr_setup, const t_arch& Arch);        //Create the device grid
+bool vpr_device_only_flow(t_vpr_setup& vpr_setup, const t_arch& arch);                 //Create the device (grid + rr graph) without any circuit
 void vpr_create_rr_graph(t_vpr_setup& vpr_setup, const t_arch& arch, int chan_width); //Create routing graph at specified channel width
 
 void vpr_init_graphics(const t_vpr_setup& vpr_setup, const t_arch& arch);
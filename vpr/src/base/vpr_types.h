@@ -111,11 +111,21 @@ enum class e_router_lookahead {
     NO_OP    //A no-operation lookahead which always returns zero
 };
 
+enum class e_heap_type {
+    BINARY_HEAP,  //Binary heap which may hold several entries of the same node
+    FOUR_ARY_HEAP //4-ary heap indexed by node, with at most one entry per node (updated by decrease-key)
+};
+
 enum class e_route_bb_update {
     STATIC, //Router net bounding boxes are not updated
     DYNAMIC //Rotuer net bounding boxes are updated
 };
 
+enum class e_check_level {
+    FULL,   //Check all the nodes, edges and nets of the rr graph and the routing
+    SAMPLED //Check a fixed sample of them (one out of CHECK_SAMPLE_STRIDE)
+};
+
 enum class e_const_gen_inference {
     NONE,    //No constant generator inference
     COMB,    //Only combinational constant generator inference
@@ -215,6 +225,7 @@ class t_pack_molecule;
 struct t_pb_stats;
 struct t_pb_route;
 struct t_chain_info;
+class PbArena;
 
 typedef vtr::flat_map2<int, t_pb_route> t_pb_routes;
 
@@ -239,6 +250,8 @@ class t_pb {
     t_pb** child_pbs = nullptr; /* children pbs attached to this pb [0..num_child_pb_types - 1][0..child_type->num_pb - 1] */
     t_pb* parent_pb = nullptr;  /* pointer to parent node */
 
+    PbArena* child_pbs_arena = nullptr; /* arena of child_pbs (see alloc_child_pbs()), which is inherited by the children. child_pbs are allocated with new if nullptr */
+
     t_pb_stats* pb_stats = nullptr; /* statistics for current pb */
 
     /* Representation of intra-logic block routing, t_pb_route describes all internal hierarchy routing.
@@ -432,6 +445,12 @@ enum e_pad_loc_type {
     USER
 };
 
+/* How are the movable blocks placed before the annealing? */
+enum class e_initial_placement {
+    RANDOM,  //Random locations
+    ANALYTIC //Legalized force-directed solution, annealed from a lower temperature
+};
+
 /* Power data for t_netlist structure */
 struct t_net_power {
     /* Signal probability - long term probability that signal is logic-high*/
@@ -651,7 +670,9 @@ struct t_file_name_opts {
     std::string CircuitName;
     std::string BlifFile;
     std::string NetFile;
+    std::string NetCacheFile;
     std::string PlaceFile;
+    std::string PlaceCacheFile;
     std::string RouteFile;
     std::string ActFile;
     std::string PowerFile;
@@ -713,6 +734,7 @@ struct t_packer_opts {
     e_stage_action doPacking;
     enum e_packer_algorithm packer_algorithm;
     std::string device_layout;
+    size_t num_workers; //Number of threads computing the gains of the candidate molecules
 };
 
 /* Annealing schedule information for the placer.  The schedule type      *
@@ -784,6 +806,7 @@ struct t_placer_opts {
     int place_chan_width;
     enum e_pad_loc_type pad_loc_type;
     std::string pad_loc_file;
+    e_initial_placement initial_placement;
     enum pfreq place_freq;
     int recompute_crit_iter;
     bool enable_timing_computations;
@@ -794,9 +817,12 @@ struct t_placer_opts {
     e_stage_action doPlacement;
     float rlim_escape_fraction;
     std::string move_stats_file;
+    bool parallel_placement; //Evaluate the independent moves of a batch at the same time
+    size_t num_workers;      //Number of threads of the parallel placement
 
     PlaceDelayModelType delay_model_type;
     e_reducer delay_model_reducer;
+    bool incremental_timing_analysis; //Only re-analyze the timing of the changed connections
 
     float delay_offset;
     int delay_ramp_delta_threshold;
@@ -916,6 +942,7 @@ struct t_router_opts {
     float bend_cost;
     int max_router_iterations;
     int min_incremental_reroute_fanout;
+    std::string incremental_route_file; //Keep the routing of the unchanged nets of this .route file
     e_incr_reroute_delay_ripup incr_reroute_delay_ripup;
     int bb_factor;
     enum e_route_type route_type;
@@ -946,13 +973,18 @@ struct t_router_opts {
     int router_debug_net;
     int router_debug_sink_rr;
     e_router_lookahead lookahead_type;
+    e_heap_type router_heap;
     int max_convergence_count;
     float reconvergence_cpd_threshold;
     std::string first_iteration_timing_report_file;
     bool strict_checks;
+    bool parallel_routing; //Route the nets of disjoint regions of the device at the same time
+    size_t num_workers;    //Number of threads of the parallel routing
+    e_check_level check_level; //Whether check_route() checks all the nets or only a sample of them
 
     std::string write_router_lookahead;
     std::string read_router_lookahead;
+    std::string router_lookahead_cache_file; //Load the lookahead map from this file if computed from the same rr graph, otherwise write it
 };
 
 struct t_analysis_opts {
@@ -996,6 +1028,13 @@ struct t_analysis_opts {
  * read_rr_graph_filename: File to read the RR graph from (overrides        *
  *                         architecture)                                    *
  * write_rr_graph_filename: File to write the RR graph to after generation  *
+ * rr_graph_cache_filename: Binary file to cache the tileable RR graph      *
+ * num_workers: Number of threads to build the edges of the tileable RR     *
+ *              graph, to write the RR graph and to estimate the power      *
+ *              (0 means all the cores)                                     *
+ * freeze_rr_graph: Store the RR graph in compact arrays once it is built   *
+ * check_level: Whether all the nodes of the RR graph are checked once it   *
+ *              is built, or only a sample of them                          *
  *                                                                          */
 
 struct t_det_routing_arch {
@@ -1023,6 +1062,11 @@ struct t_det_routing_arch {
 
     std::string read_rr_graph_filename;
     std::string write_rr_graph_filename;
+    std::string rr_graph_cache_filename;
+
+    size_t num_workers;
+    bool freeze_rr_graph;
+    e_check_level check_level;
 };
 
 
@@ -1279,6 +1323,7 @@ struct t_vpr_setup {
     e_clock_modeling clock_modeling;           //How clocks should be handled
     bool two_stage_clock_routing;              //How clocks should be routed in the presence of a dedicated clock network
     bool exit_before_pack;                     //Exits early before starting packing (useful for collecting statistics without running/loading any stages)
+    bool device_only;                          //Only builds the device grid and the routing resource graph, without reading the circuit
 };
 
 class RouteStatus {
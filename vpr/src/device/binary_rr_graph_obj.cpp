@@ -0,0 +1,248 @@
+/*********************************************************************
+ * This file defines the functions to read and write the nodes and edges
+ * of a RRGraph object in a binary format, using the capnproto schema
+ * VprRrGraphObj (see libs/libvtrcapnproto/rr_graph_obj.capnp).
+ *
+ * Nodes and edges are stored in contiguous lists, which are mapped
+ * from the file by mmap when reading. The switches and segments of the
+ * RRGraph are not stored: they should be created before reading, in the
+ * same order as they were created when writing.
+ ********************************************************************/
+#include <algorithm>
+#include <limits>
+
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+#include "vtr_util.h"
+
+#include "vpr_error.h"
+#include "rr_node.h"
+#include "globals.h"
+
+#include "binary_rr_graph_obj.h"
+
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "rr_graph_obj.capnp.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+void write_binary_rr_graph_obj(const std::string& /*file_name*/,
+                               const RRGraph& /*rr_graph*/,
+                               const std::string& /*rr_graph_id*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "write_binary_rr_graph_obj " DISABLE_ERROR);
+}
+
+bool read_binary_rr_graph_obj(const std::string& /*file_name*/,
+                              RRGraph& /*rr_graph*/,
+                              const std::string& /*rr_graph_id*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "read_binary_rr_graph_obj " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+/* Only CHANX and CHANY nodes have a ptc number per position along the node */
+static bool is_chan_rr_type(const t_rr_type& type) {
+    return (CHANX == type) || (CHANY == type);
+}
+
+/************************ Subroutine definitions ****************************/
+void write_binary_rr_graph_obj(const std::string& file_name,
+                               const RRGraph& rr_graph,
+                               const std::string& rr_graph_id) {
+    vtr::ScopedStartFinishTimer timer("Write binary rr_graph to '" + file_name + "'");
+
+    auto& device_ctx = g_vpr_ctx.device();
+
+    /* Count the ptc numbers first, so that the lists are allocated only once */
+    size_t num_ptcs = 0;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        num_ptcs += is_chan_rr_type(rr_graph.node_type(node)) ? rr_graph.node_track_ids(node).size() : 1;
+    }
+
+    ::capnp::MallocMessageBuilder builder;
+    auto graph = builder.initRoot<VprRrGraphObj>();
+    graph.setId(rr_graph_id);
+
+    auto nodes = graph.initNodes(rr_graph.nodes().size());
+    auto ptc_nums = graph.initPtcNums(num_ptcs);
+    size_t ptc_offset = 0;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        auto node_data = nodes[size_t(node)];
+        t_rr_type type = rr_graph.node_type(node);
+        node_data.setType(type);
+        node_data.setXlow(rr_graph.node_xlow(node));
+        node_data.setYlow(rr_graph.node_ylow(node));
+        node_data.setXhigh(rr_graph.node_xhigh(node));
+        node_data.setYhigh(rr_graph.node_yhigh(node));
+        node_data.setCapacity(rr_graph.node_capacity(node));
+        node_data.setCostIndex(rr_graph.node_cost_index(node));
+        node_data.setDirection(is_chan_rr_type(type) ? rr_graph.node_direction(node) : NO_DIRECTION);
+        node_data.setSide(((IPIN == type) || (OPIN == type)) ? rr_graph.node_side(node) : NUM_SIDES);
+        node_data.setR(rr_graph.node_R(node));
+        node_data.setC(rr_graph.node_C(node));
+
+        short rc_data_index = rr_graph.node_rc_data_index(node);
+        node_data.setHasRcData(0 <= rc_data_index);
+        if (0 <= rc_data_index) {
+            node_data.setRcDataR(device_ctx.rr_rc_data[rc_data_index].R);
+            node_data.setRcDataC(device_ctx.rr_rc_data[rc_data_index].C);
+        }
+
+        node_data.setFirstPtc(ptc_offset);
+        if (true == is_chan_rr_type(type)) {
+            std::vector<short> track_ids = rr_graph.node_track_ids(node);
+            for (const short& track_id : track_ids) {
+                ptc_nums.set(ptc_offset++, track_id);
+            }
+            node_data.setNumPtcs(track_ids.size());
+        } else {
+            ptc_nums.set(ptc_offset++, rr_graph.node_ptc_num(node));
+            node_data.setNumPtcs(1);
+        }
+    }
+    VTR_ASSERT(num_ptcs == ptc_offset);
+
+    auto edges = graph.initEdges(rr_graph.edges().size());
+    for (const RREdgeId& edge : rr_graph.edges()) {
+        auto edge_data = edges[size_t(edge)];
+        edge_data.setSrcNode(size_t(rr_graph.edge_src_node(edge)));
+        edge_data.setSinkNode(size_t(rr_graph.edge_sink_node(edge)));
+        edge_data.setSwitchId(size_t(rr_graph.edge_switch(edge)));
+    }
+
+    writeMessageToFile(file_name, &builder);
+
+    VTR_LOG("Wrote %lu nodes and %lu edges to binary rr_graph '%s'\n",
+            rr_graph.nodes().size(), rr_graph.edges().size(), file_name.c_str());
+}
+
+/********************************************************************
+ * Check the content of a binary rr_graph before touching the RRGraph,
+ * so that the RRGraph is left empty for the caller to build it from
+ * scratch when the file is not valid
+ *******************************************************************/
+static bool valid_binary_rr_graph_obj(const VprRrGraphObj::Reader& graph,
+                                      const RRGraph& rr_graph) {
+    auto nodes = graph.getNodes();
+    auto ptc_nums = graph.getPtcNums();
+    for (const auto& node_data : nodes) {
+        if ((NUM_RR_TYPES <= node_data.getType())
+            || (NUM_DIRECTIONS <= node_data.getDirection())
+            || (NUM_SIDES < node_data.getSide())
+            || (ptc_nums.size() < (size_t)node_data.getFirstPtc() + node_data.getNumPtcs())) {
+            return false;
+        }
+        size_t num_ptcs = 1;
+        if (true == is_chan_rr_type(t_rr_type(node_data.getType()))) {
+            num_ptcs = std::max(node_data.getXhigh() - node_data.getXlow(), node_data.getYhigh() - node_data.getYlow()) + 1;
+        }
+        if (num_ptcs != node_data.getNumPtcs()) {
+            return false;
+        }
+    }
+
+    for (const auto& edge_data : graph.getEdges()) {
+        if ((nodes.size() <= edge_data.getSrcNode())
+            || (nodes.size() <= edge_data.getSinkNode())
+            || (false == rr_graph.valid_switch_id(RRSwitchId(edge_data.getSwitchId())))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/********************************************************************
+ * Load the nodes and edges of a binary rr_graph to a RRGraph which
+ * contains only switches and segments
+ * The rr_graph is loaded only if its id matches the given one
+ *
+ * Return true if the rr_graph is loaded, otherwise the RRGraph is not touched
+ *******************************************************************/
+bool read_binary_rr_graph_obj(const std::string& file_name,
+                              RRGraph& rr_graph,
+                              const std::string& rr_graph_id) {
+    VTR_ASSERT(0 == rr_graph.nodes().size());
+    VTR_ASSERT(0 == rr_graph.edges().size());
+
+    if (false == vtr::file_exists(file_name.c_str())) {
+        return false;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Read binary rr_graph from '" + file_name + "'");
+
+    MmapFile f(file_name);
+
+    /* A rr_graph of a large device easily exceeds the default traversal limit */
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    ::capnp::FlatArrayMessageReader reader(f.getData(), options);
+
+    VprRrGraphObj::Reader graph = reader.getRoot<VprRrGraphObj>();
+    if (rr_graph_id != std::string(graph.getId().cStr())) {
+        VTR_LOG_WARN("Binary rr_graph '%s' is built from different architectures or options!\n",
+                     file_name.c_str());
+        return false;
+    }
+    if (false == valid_binary_rr_graph_obj(graph, rr_graph)) {
+        VTR_LOG_WARN("Binary rr_graph '%s' is corrupted!\n",
+                     file_name.c_str());
+        return false;
+    }
+
+    auto nodes = graph.getNodes();
+    auto ptc_nums = graph.getPtcNums();
+    rr_graph.reserve_nodes(nodes.size());
+    for (const auto& node_data : nodes) {
+        t_rr_type type = t_rr_type(node_data.getType());
+        const RRNodeId& node = rr_graph.create_node(type);
+        rr_graph.set_node_bounding_box(node, vtr::Rect<short>(node_data.getXlow(), node_data.getYlow(),
+                                                              node_data.getXhigh(), node_data.getYhigh()));
+        rr_graph.set_node_capacity(node, node_data.getCapacity());
+        rr_graph.set_node_cost_index(node, node_data.getCostIndex());
+        if (true == is_chan_rr_type(type)) {
+            rr_graph.set_node_direction(node, e_direction(node_data.getDirection()));
+        }
+        if ((IPIN == type) || (OPIN == type)) {
+            rr_graph.set_node_side(node, e_side(node_data.getSide()));
+        }
+        rr_graph.set_node_R(node, node_data.getR());
+        rr_graph.set_node_C(node, node_data.getC());
+        if (true == node_data.getHasRcData()) {
+            rr_graph.set_node_rc_data_index(node, find_create_rr_rc_data(node_data.getRcDataR(), node_data.getRcDataC()));
+        }
+
+        size_t first_ptc = node_data.getFirstPtc();
+        rr_graph.set_node_ptc_num(node, ptc_nums[first_ptc]);
+        /* The ptc numbers of a routing track are ordered from its (xlow, ylow) */
+        for (size_t iptc = 1; iptc < node_data.getNumPtcs(); ++iptc) {
+            vtr::Point<size_t> node_offset(node_data.getXlow() + (CHANX == type ? iptc : 0),
+                                           node_data.getYlow() + (CHANY == type ? iptc : 0));
+            rr_graph.add_node_track_num(node, node_offset, ptc_nums[first_ptc + iptc]);
+        }
+    }
+
+    auto edges = graph.getEdges();
+    rr_graph.reserve_edges(edges.size());
+    for (const auto& edge_data : edges) {
+        rr_graph.create_edge(RRNodeId(edge_data.getSrcNode()),
+                             RRNodeId(edge_data.getSinkNode()),
+                             RRSwitchId(edge_data.getSwitchId()));
+    }
+
+    VTR_LOG("Read %lu nodes and %lu edges from binary rr_graph '%s'\n",
+            rr_graph.nodes().size(), rr_graph.edges().size(), file_name.c_str());
+
+    return true;
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
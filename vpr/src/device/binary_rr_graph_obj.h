@@ -0,0 +1,21 @@
+/*********************************************************************
+ * This function reads and writes the nodes and edges of a RRGraph
+ * object in a binary format, which can be loaded much faster than
+ * building or parsing the RRGraph again
+ ********************************************************************/
+
+#ifndef BINARY_RR_GRAPH_OBJ_H
+#define BINARY_RR_GRAPH_OBJ_H
+
+#include <string>
+#include "rr_graph_obj.h"
+
+void write_binary_rr_graph_obj(const std::string& file_name,
+                               const RRGraph& rr_graph,
+                               const std::string& rr_graph_id);
+
+bool read_binary_rr_graph_obj(const std::string& file_name,
+                              RRGraph& rr_graph,
+                              const std::string& rr_graph_id);
+
+#endif
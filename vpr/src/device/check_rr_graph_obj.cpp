@@ -2,6 +2,7 @@
 
 #include "vtr_log.h"
 
+#include "parallel_check.h"
 #include "check_rr_graph_obj.h"
 
 /*********************************************************************** 
@@ -42,13 +43,23 @@ static bool check_rr_graph_node_duplicated_edges(const RRGraph& rr_graph,
  * Check the whole Routing Resource Graph  
  * identify and report any duplicated edges between two nodes 
  **********************************************************************/
-static bool check_rr_graph_duplicated_edges(const RRGraph& rr_graph) {
+static bool check_rr_graph_duplicated_edges(const RRGraph& rr_graph,
+                                            const std::vector<RRNodeId>& nodes,
+                                            const e_check_level& check_level) {
     bool no_duplication = true;
     /* For each node:
      * Search input edges, see there are two edges with same id or address 
+     * The nodes are searched in parallel, and only the nodes with
+     * duplicated edges are reported, in the order of their ids
      */
-    for (const auto& node : rr_graph.nodes()) {
-        if (false == check_rr_graph_node_duplicated_edges(rr_graph, node)) {
+    std::vector<size_t> invalid_nodes = parallel_find_invalid(nodes.size(), check_level, [&](size_t inode) {
+        std::vector<RREdgeId> in_edges(rr_graph.node_in_edges(nodes[inode]).begin(),
+                                       rr_graph.node_in_edges(nodes[inode]).end());
+        std::sort(in_edges.begin(), in_edges.end());
+        return in_edges.end() != std::adjacent_find(in_edges.begin(), in_edges.end());
+    });
+    for (const size_t& inode : invalid_nodes) {
+        if (false == check_rr_graph_node_duplicated_edges(rr_graph, nodes[inode])) {
             no_duplication = false;
         }
     }
@@ -60,22 +71,26 @@ static bool check_rr_graph_duplicated_edges(const RRGraph& rr_graph) {
  * Identify and report any dangling node (nodes without any fan-in or fan-out)
  * in the RRGraph
  **********************************************************************/
-static bool check_rr_graph_dangling_nodes(const RRGraph& rr_graph) {
+static bool check_rr_graph_dangling_nodes(const RRGraph& rr_graph,
+                                         const std::vector<RRNodeId>& nodes,
+                                         const e_check_level& check_level) {
     bool no_dangling = true;
     /* For each node: 
      * check if the number of input edges and output edges are both 0
      * If so, this is a dangling nodes and report 
      */
-    for (auto node : rr_graph.nodes()) {
-        if ((0 == rr_graph.node_fan_in(node))
-            && (0 == rr_graph.node_fan_out(node))) {
-            /* Print a warning! */
-            VTR_LOG_WARN("Node %d is dangling (zero fan-in and zero fan-out)!\n",
-                         node);
-            VTR_LOG_WARN("Node details for debugging:\n");
-            rr_graph.print_node(node);
-            no_dangling = false;
-        }
+    std::vector<size_t> invalid_nodes = parallel_find_invalid(nodes.size(), check_level, [&](size_t inode) {
+        return (0 == rr_graph.node_fan_in(nodes[inode]))
+               && (0 == rr_graph.node_fan_out(nodes[inode]));
+    });
+    for (const size_t& inode : invalid_nodes) {
+        const RRNodeId& node = nodes[inode];
+        /* Print a warning! */
+        VTR_LOG_WARN("Node %d is dangling (zero fan-in and zero fan-out)!\n",
+                     node);
+        VTR_LOG_WARN("Node details for debugging:\n");
+        rr_graph.print_node(node);
+        no_dangling = false;
     }
 
     return no_dangling;
@@ -85,26 +100,30 @@ static bool check_rr_graph_dangling_nodes(const RRGraph& rr_graph) {
  * check if all the source nodes are in the right condition:
  * 1. zero fan-in and non-zero fanout
  **********************************************************************/
-static bool check_rr_graph_source_nodes(const RRGraph& rr_graph) {
+static bool check_rr_graph_source_nodes(const RRGraph& rr_graph,
+                                        const std::vector<RRNodeId>& nodes,
+                                        const e_check_level& check_level) {
     bool invalid_sources = false;
     /* For each node: 
      * check if the number of input edges and output edges are both 0
      * If so, this is a dangling nodes and report 
      */
-    for (auto node : rr_graph.nodes()) {
+    std::vector<size_t> invalid_nodes = parallel_find_invalid(nodes.size(), check_level, [&](size_t inode) {
         /* Pass nodes whose types are not SOURCE */
-        if (SOURCE != rr_graph.node_type(node)) {
-            continue;
-        }
-        if ((0 != rr_graph.node_fan_in(node))
-            || (0 == rr_graph.node_fan_out(node))) {
-            /* Print a warning! */
-            VTR_LOG_WARN("Source node %d is invalid (should have zero fan-in and non-zero fan-out)!\n",
-                         size_t(node));
-            VTR_LOG_WARN("Node details for debugging:\n");
-            rr_graph.print_node(node);
-            invalid_sources = true;
+        if (SOURCE != rr_graph.node_type(nodes[inode])) {
+            return false;
         }
+        return (0 != rr_graph.node_fan_in(nodes[inode]))
+               || (0 == rr_graph.node_fan_out(nodes[inode]));
+    });
+    for (const size_t& inode : invalid_nodes) {
+        const RRNodeId& node = nodes[inode];
+        /* Print a warning! */
+        VTR_LOG_WARN("Source node %d is invalid (should have zero fan-in and non-zero fan-out)!\n",
+                     size_t(node));
+        VTR_LOG_WARN("Node details for debugging:\n");
+        rr_graph.print_node(node);
+        invalid_sources = true;
     }
 
     return !invalid_sources;
@@ -114,26 +133,30 @@ static bool check_rr_graph_source_nodes(const RRGraph& rr_graph) {
  * check if all the sink nodes are in the right condition:
  * 1. non-zero fan-in and zero fanout
  **********************************************************************/
-static bool check_rr_graph_sink_nodes(const RRGraph& rr_graph) {
+static bool check_rr_graph_sink_nodes(const RRGraph& rr_graph,
+                                      const std::vector<RRNodeId>& nodes,
+                                      const e_check_level& check_level) {
     bool invalid_sinks = false;
     /* For each node: 
      * check if the number of input edges and output edges are both 0
      * If so, this is a dangling nodes and report 
      */
-    for (auto node : rr_graph.nodes()) {
+    std::vector<size_t> invalid_nodes = parallel_find_invalid(nodes.size(), check_level, [&](size_t inode) {
         /* Pass nodes whose types are not SINK */
-        if (SINK != rr_graph.node_type(node)) {
-            continue;
-        }
-        if ((0 == rr_graph.node_fan_in(node))
-            || (0 != rr_graph.node_fan_out(node))) {
-            /* Print a warning! */
-            VTR_LOG_WARN("Sink node %s is invalid (should have non-zero fan-in and zero fan-out)!\n",
-                         node);
-            VTR_LOG_WARN("Node details for debugging:\n");
-            rr_graph.print_node(node);
-            invalid_sinks = true;
+        if (SINK != rr_graph.node_type(nodes[inode])) {
+            return false;
         }
+        return (0 == rr_graph.node_fan_in(nodes[inode]))
+               || (0 != rr_graph.node_fan_out(nodes[inode]));
+    });
+    for (const size_t& inode : invalid_nodes) {
+        const RRNodeId& node = nodes[inode];
+        /* Print a warning! */
+        VTR_LOG_WARN("Sink node %s is invalid (should have non-zero fan-in and zero fan-out)!\n",
+                     node);
+        VTR_LOG_WARN("Node details for debugging:\n");
+        rr_graph.print_node(node);
+        invalid_sinks = true;
     }
 
     return !invalid_sinks;
@@ -151,36 +174,33 @@ static bool check_rr_graph_sink_nodes(const RRGraph& rr_graph) {
  * On the other hand, it is suggested that developers to create their 
  * own checking function for the rr_graph, to guarantee their routers
  * will work properly.
+ *
+ * The nodes are checked in parallel, and with the sampled check level
+ * only a fixed subset of them is checked
  **********************************************************************/
-bool check_rr_graph(const RRGraph& rr_graph) {
+bool check_rr_graph(const RRGraph& rr_graph,
+                    const e_check_level& check_level) {
     size_t num_err = 0;
 
-    if (false == check_rr_graph_duplicated_edges(rr_graph)) {
+    /* Index the valid nodes so that they can be split among the threads */
+    std::vector<RRNodeId> nodes(rr_graph.nodes().begin(), rr_graph.nodes().end());
+
+    if (false == check_rr_graph_duplicated_edges(rr_graph, nodes, check_level)) {
         VTR_LOG_WARN("Fail in checking duplicated edges !\n");
         num_err++;
     }
 
-    if (false == check_rr_graph_dangling_nodes(rr_graph)) {
+    if (false == check_rr_graph_dangling_nodes(rr_graph, nodes, check_level)) {
         VTR_LOG_WARN("Fail in checking dangling nodes !\n");
         num_err++;
     }
 
-    if (false == check_rr_graph_source_nodes(rr_graph)) {
-        VTR_LOG_WARN("Fail in checking source nodes!\n");
-        num_err++;
-    }
-
-    if (false == check_rr_graph_sink_nodes(rr_graph)) {
-        VTR_LOG_WARN("Fail in checking sink nodes!\n");
-        num_err++;
-    }
-
-    if (false == check_rr_graph_source_nodes(rr_graph)) {
+    if (false == check_rr_graph_source_nodes(rr_graph, nodes, check_level)) {
         VTR_LOG_WARN("Fail in checking source nodes!\n");
         num_err++;
     }
 
-    if (false == check_rr_graph_sink_nodes(rr_graph)) {
+    if (false == check_rr_graph_sink_nodes(rr_graph, nodes, check_level)) {
         VTR_LOG_WARN("Fail in checking sink nodes!\n");
         num_err++;
     }
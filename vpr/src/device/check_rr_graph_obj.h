@@ -5,7 +5,9 @@
  * the function declaration
  */
 #include "rr_graph_obj.h"
+#include "vpr_types.h"
 
-bool check_rr_graph(const RRGraph& rr_graph);
+bool check_rr_graph(const RRGraph& rr_graph,
+                    const e_check_level& check_level);
 
 #endif
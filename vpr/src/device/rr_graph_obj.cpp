@@ -12,6 +12,7 @@
 #include "vtr_log.h"
 #include "vtr_util.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
 #include "rr_graph_obj.h"
 #include "rr_graph_obj_utils.h"
 
@@ -27,6 +28,59 @@ RRGraph::RRGraph()
 /********************************************************************
  * Accessors
  *******************************************************************/
+size_t RRGraph::memory_usage() const {
+    size_t usage = sizeof(RRGraph)
+                 + openfpga::heap_memory_usage(invalid_node_ids_)
+                 + openfpga::heap_memory_usage(node_types_)
+                 + openfpga::heap_memory_usage(node_bounding_boxes_)
+                 + openfpga::heap_memory_usage(node_capacities_)
+                 + openfpga::heap_memory_usage(node_ptc_nums_)
+                 + openfpga::heap_memory_usage(node_cost_indices_)
+                 + openfpga::heap_memory_usage(node_directions_)
+                 + openfpga::heap_memory_usage(node_sides_)
+                 + openfpga::heap_memory_usage(node_Rs_)
+                 + openfpga::heap_memory_usage(node_Cs_)
+                 + openfpga::heap_memory_usage(node_rc_data_indices_)
+                 + openfpga::heap_memory_usage(node_segments_)
+                 + openfpga::heap_memory_usage(node_num_in_edges_)
+                 + openfpga::heap_memory_usage(node_num_out_edges_)
+                 + openfpga::heap_memory_usage(node_num_non_configurable_in_edges_)
+                 + openfpga::heap_memory_usage(node_num_non_configurable_out_edges_)
+                 + openfpga::heap_memory_usage(node_edges_)
+                 + openfpga::heap_memory_usage(invalid_edge_ids_)
+                 + openfpga::heap_memory_usage(edge_src_nodes_)
+                 + openfpga::heap_memory_usage(edge_sink_nodes_)
+                 + openfpga::heap_memory_usage(edge_switches_)
+                 + openfpga::heap_memory_usage(switch_ids_)
+                 + openfpga::heap_memory_usage(switches_)
+                 + openfpga::heap_memory_usage(segment_ids_)
+                 + openfpga::heap_memory_usage(segments_)
+                 + openfpga::heap_memory_usage(frozen_node_edge_offsets_)
+                 + openfpga::heap_memory_usage(frozen_node_ptc_offsets_)
+                 + openfpga::heap_memory_usage(frozen_node_ptc_nums_)
+                 + frozen_node_lookup_offsets_.size() * sizeof(size_t)
+                 + frozen_node_lookup_num_ptcs_.size() * sizeof(size_t)
+                 + openfpga::heap_memory_usage(frozen_node_lookup_);
+
+    /* The edges of each node, which are pooled when the graph is frozen */
+    size_t num_node_edges = 0;
+    for (const RRNodeId& node : nodes()) {
+        num_node_edges += node_num_in_edges_[node] + node_num_out_edges_[node];
+    }
+    usage += num_node_edges * sizeof(RREdgeId);
+
+    usage += node_lookup_.size() * sizeof(std::vector<std::vector<RRNodeId>>);
+    for (size_t i = 0; i < node_lookup_.dim_size(0); ++i) {
+        for (size_t j = 0; j < node_lookup_.dim_size(1); ++j) {
+            for (size_t k = 0; k < node_lookup_.dim_size(2); ++k) {
+                usage += openfpga::heap_memory_usage(node_lookup_[i][j][k]);
+            }
+        }
+    }
+
+    return usage;
+}
+
 RRGraph::lazy_node_range RRGraph::nodes() const {
     return vtr::make_range(lazy_node_iterator(RRNodeId(0), invalid_node_ids_),
                            lazy_node_iterator(RRNodeId(num_nodes_), invalid_node_ids_));
@@ -145,6 +199,9 @@ short RRGraph::node_capacity(const RRNodeId& node) const {
 
 short RRGraph::node_ptc_num(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
+    if (true == frozen_) {
+        return frozen_node_ptc_nums_[frozen_node_ptc_offsets_[node]];
+    }
     return node_ptc_nums_[node][0];
 }
 
@@ -169,6 +226,10 @@ std::vector<short> RRGraph::node_track_ids(const RRNodeId& node) const {
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY,
                    "Track number valid only for CHANX/CHANY RR nodes");
     VTR_ASSERT_SAFE(valid_node_id(node));
+    if (true == frozen_) {
+        return std::vector<short>(frozen_node_ptc_nums_.begin() + frozen_node_ptc_offsets_[node],
+                                  frozen_node_ptc_nums_.begin() + frozen_node_ptc_offsets_[RRNodeId(size_t(node) + 1)]);
+    }
     return node_ptc_nums_[node];
 }
 
@@ -218,22 +279,22 @@ RRSegmentId RRGraph::node_segment(const RRNodeId& node) const {
 RRGraph::edge_range RRGraph::node_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node] + node_num_out_edges_[node]);
+    return vtr::make_range(node_edge_array(node),
+                           node_edge_array(node) + node_num_in_edges_[node] + node_num_out_edges_[node]);
 }
 
 RRGraph::edge_range RRGraph::node_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node]);
+    return vtr::make_range(node_edge_array(node),
+                           node_edge_array(node) + node_num_in_edges_[node]);
 }
 
 RRGraph::edge_range RRGraph::node_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]),
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node]);
+    return vtr::make_range((node_edge_array(node) + node_num_in_edges_[node]),
+                           (node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node]);
 }
 
 /* Get the list of configurable edges from the input edges of a given node 
@@ -242,8 +303,8 @@ RRGraph::edge_range RRGraph::node_out_edges(const RRNodeId& node) const {
 RRGraph::edge_range RRGraph::node_configurable_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get(),
-                           node_edges_[node].get() + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]);
+    return vtr::make_range(node_edge_array(node),
+                           node_edge_array(node) + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node]);
 }
 
 /* Get the list of non configurable edges from the input edges of a given node 
@@ -252,8 +313,8 @@ RRGraph::edge_range RRGraph::node_configurable_in_edges(const RRNodeId& node) co
 RRGraph::edge_range RRGraph::node_non_configurable_in_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range(node_edges_[node].get() + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node],
-                           node_edges_[node].get() + node_num_in_edges_[node]);
+    return vtr::make_range(node_edge_array(node) + node_num_in_edges_[node] - node_num_non_configurable_in_edges_[node],
+                           node_edge_array(node) + node_num_in_edges_[node]);
 }
 
 /* Get the list of configurable edges from the output edges of a given node 
@@ -262,8 +323,8 @@ RRGraph::edge_range RRGraph::node_non_configurable_in_edges(const RRNodeId& node
 RRGraph::edge_range RRGraph::node_configurable_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]),
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node]);
+    return vtr::make_range((node_edge_array(node) + node_num_in_edges_[node]),
+                           (node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node]);
 }
 
 /* Get the list of non configurable edges from the output edges of a given node 
@@ -272,8 +333,8 @@ RRGraph::edge_range RRGraph::node_configurable_out_edges(const RRNodeId& node) c
 RRGraph::edge_range RRGraph::node_non_configurable_out_edges(const RRNodeId& node) const {
     VTR_ASSERT_SAFE(valid_node_id(node));
 
-    return vtr::make_range((node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node],
-                           (node_edges_[node].get() + node_num_in_edges_[node]) + node_num_out_edges_[node]);
+    return vtr::make_range((node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node] - node_num_non_configurable_out_edges_[node],
+                           (node_edge_array(node) + node_num_in_edges_[node]) + node_num_out_edges_[node]);
 }
 
 //Edge attributes
@@ -358,6 +419,10 @@ std::vector<RREdgeId> RRGraph::find_edges(const RRNodeId& src_node, const RRNode
 }
 
 RRNodeId RRGraph::find_node(const short& x, const short& y, const t_rr_type& type, const int& ptc, const e_side& side) const {
+    if (true == frozen_) {
+        return find_frozen_node(x, y, type, ptc, side);
+    }
+
     initialize_fast_node_lookup();
 
     size_t itype = type;
@@ -411,6 +476,16 @@ short RRGraph::chan_num_tracks(const short& x, const short& y, const t_rr_type&
     /* Must be CHANX or CHANY */
     VTR_ASSERT_MSG(CHANX == type || CHANY == type,
                    "Required node_type to be CHANX or CHANY!");
+
+    if (true == frozen_) {
+        if ((x < 0) || (size_t(x) >= frozen_node_lookup_num_ptcs_.dim_size(0))
+            || (y < 0) || (size_t(y) >= frozen_node_lookup_num_ptcs_.dim_size(1))
+            || (size_t(type) >= frozen_node_lookup_num_ptcs_.dim_size(2))) {
+            return 0;
+        }
+        return frozen_node_lookup_num_ptcs_[x][y][type];
+    }
+
     initialize_fast_node_lookup();
 
     /* Check if x, y, type and ptc is valid */
@@ -767,6 +842,10 @@ bool RRGraph::is_dirty() const {
     return dirty_;
 }
 
+bool RRGraph::is_frozen() const {
+    return frozen_;
+}
+
 void RRGraph::set_dirty() {
     dirty_ = true;
 }
@@ -823,6 +902,8 @@ void RRGraph::reserve_segments(const size_t& num_segments) {
 
 /* Mutators */
 RRNodeId RRGraph::create_node(const t_rr_type& type) {
+    VTR_ASSERT_MSG(false == frozen_, "Can not create nodes in a frozen RRGraph");
+
     /* Allocate an ID */
     RRNodeId node_id = RRNodeId(num_nodes_);
     /* Expand range of node ids */
@@ -858,6 +939,7 @@ RRNodeId RRGraph::create_node(const t_rr_type& type) {
 }
 
 RREdgeId RRGraph::create_edge(const RRNodeId& source, const RRNodeId& sink, const RRSwitchId& switch_id, const bool& fake_switch) {
+    VTR_ASSERT_MSG(false == frozen_, "Can not create edges in a frozen RRGraph");
     VTR_ASSERT(valid_node_id(source));
     VTR_ASSERT(valid_node_id(sink));
     if (false == fake_switch) {
@@ -917,6 +999,8 @@ RRSegmentId RRGraph::create_segment(const t_segment_inf& segment_info) {
  * The compress() function should be called to physically remove the node 
  */
 void RRGraph::remove_node(const RRNodeId& node) {
+    VTR_ASSERT_MSG(false == frozen_, "Can not remove nodes from a frozen RRGraph");
+
     //Invalidate all connected edges
     // TODO: consider removal of self-loop edges?
     for (auto edge : node_in_edges(node)) {
@@ -927,7 +1011,10 @@ void RRGraph::remove_node(const RRNodeId& node) {
     }
 
     //Mark node invalid
-    invalid_node_ids_.insert(node);
+    if (invalid_node_ids_.size() < num_nodes_) {
+        invalid_node_ids_.resize(num_nodes_, false);
+    }
+    invalid_node_ids_[size_t(node)] = true;
 
     //Invalidate the node look-up
     invalidate_fast_node_lookup();
@@ -940,6 +1027,8 @@ void RRGraph::remove_node(const RRNodeId& node) {
  * The compress() function should be called to physically remove the edge 
  */
 void RRGraph::remove_edge(const RREdgeId& edge) {
+    VTR_ASSERT_MSG(false == frozen_, "Can not remove edges from a frozen RRGraph");
+
     RRNodeId src_node = edge_src_node(edge);
     RRNodeId sink_node = edge_sink_node(edge);
 
@@ -960,7 +1049,10 @@ void RRGraph::remove_edge(const RREdgeId& edge) {
     }
 
     /* Mark edge invalid */
-    invalid_edge_ids_.insert(edge);
+    if (invalid_edge_ids_.size() < num_edges_) {
+        invalid_edge_ids_.resize(num_edges_, false);
+    }
+    invalid_edge_ids_[size_t(edge)] = true;
 
     set_dirty();
 }
@@ -1009,6 +1101,7 @@ void RRGraph::set_node_capacity(const RRNodeId& node, const short& capacity) {
 
 void RRGraph::set_node_ptc_num(const RRNodeId& node, const short& ptc) {
     VTR_ASSERT(valid_node_id(node));
+    VTR_ASSERT_MSG(false == frozen_, "Can not change ptc numbers in a frozen RRGraph");
 
     /* For CHANX and CHANY, we will resize the ptc num to length of the node
      * For other nodes, we will always assign the first element
@@ -1049,6 +1142,7 @@ void RRGraph::add_node_track_num(const RRNodeId& node,
                                  const vtr::Point<size_t>& node_offset,
                                  const short& track_id) {
     VTR_ASSERT(valid_node_id(node));
+    VTR_ASSERT_MSG(false == frozen_, "Can not change ptc numbers in a frozen RRGraph");
     VTR_ASSERT_MSG(node_type(node) == CHANX || node_type(node) == CHANY, "Track number valid only for CHANX/CHANY RR nodes");
 
     if ((size_t)node_length(node) + 1 != node_ptc_nums_[node].size()) {
@@ -1113,6 +1207,8 @@ void RRGraph::set_node_segment(const RRNodeId& node, const RRSegmentId& segment_
     node_segments_[node] = segment_id;
 }
 void RRGraph::rebuild_node_edges() {
+    VTR_ASSERT_MSG(false == frozen_, "Can not rebuild node edges in a frozen RRGraph");
+
     node_edges_.resize(nodes().size());
     node_num_in_edges_.resize(nodes().size(), 0);
     node_num_out_edges_.resize(nodes().size(), 0);
@@ -1316,19 +1412,140 @@ bool RRGraph::valid_fast_node_lookup() const {
 }
 
 void RRGraph::initialize_fast_node_lookup() const {
-    if (!valid_fast_node_lookup()) {
+    /* A frozen RRGraph uses its flat fast look-up instead */
+    if ((false == frozen_) && (!valid_fast_node_lookup())) {
         build_fast_node_lookup();
     }
 }
 
+/* Number of slots per ptc number in the flat fast look-up of a frozen RRGraph:
+ * only IPIN and OPIN nodes are indexed by side, the other nodes are always at side NUM_SIDES
+ */
+static size_t frozen_node_lookup_num_sides(const size_t& itype) {
+    if ((IPIN == itype) || (OPIN == itype)) {
+        return NUM_SIDES + 1;
+    }
+    return 1;
+}
+
+RREdgeId* RRGraph::node_edge_array(const RRNodeId& node) const {
+    if (true == frozen_) {
+        return frozen_node_edges_.get() + frozen_node_edge_offsets_[node];
+    }
+    return node_edges_[node].get();
+}
+
+RRNodeId RRGraph::find_frozen_node(const short& x, const short& y, const t_rr_type& type, const int& ptc, const e_side& side) const {
+    size_t itype = type;
+    size_t iside = side;
+
+    /* Check if x, y, type and ptc, side is valid */
+    if ((x < 0) || (size_t(x) >= frozen_node_lookup_num_ptcs_.dim_size(0))
+        || (y < 0) || (size_t(y) >= frozen_node_lookup_num_ptcs_.dim_size(1))
+        || (itype >= frozen_node_lookup_num_ptcs_.dim_size(2))
+        || (ptc < 0) || (size_t(ptc) >= frozen_node_lookup_num_ptcs_[x][y][itype])) {
+        return RRNodeId::INVALID();
+    }
+
+    size_t num_sides = frozen_node_lookup_num_sides(itype);
+    if (1 == num_sides) {
+        if (NUM_SIDES != iside) {
+            return RRNodeId::INVALID();
+        }
+        iside = 0;
+    } else if (num_sides <= iside) {
+        return RRNodeId::INVALID();
+    }
+
+    return frozen_node_lookup_[frozen_node_lookup_offsets_[x][y][itype] + size_t(ptc) * num_sides + iside];
+}
+
+void RRGraph::freeze() {
+    if (true == frozen_) {
+        return;
+    }
+    VTR_ASSERT_MSG(false == is_dirty(), "Compress the RRGraph before freezing it");
+    VTR_ASSERT(validate_node_sizes());
+
+    /* The fast look-up is built from the ptc numbers, which are pooled afterwards */
+    initialize_fast_node_lookup();
+
+    /* Pool the edges of all the nodes */
+    frozen_node_edge_offsets_.resize(num_nodes_);
+    size_t num_node_edges = 0;
+    for (const RRNodeId& node : nodes()) {
+        frozen_node_edge_offsets_[node] = num_node_edges;
+        num_node_edges += node_num_in_edges_[node] + node_num_out_edges_[node];
+    }
+    frozen_node_edges_ = std::make_unique<RREdgeId[]>(num_node_edges);
+    for (const RRNodeId& node : nodes()) {
+        std::copy(node_edges_[node].get(),
+                  node_edges_[node].get() + node_num_in_edges_[node] + node_num_out_edges_[node],
+                  frozen_node_edges_.get() + frozen_node_edge_offsets_[node]);
+    }
+    node_edges_.clear();
+    node_edges_.shrink_to_fit();
+
+    /* Pool the ptc numbers of all the nodes */
+    frozen_node_ptc_offsets_.resize(num_nodes_ + 1);
+    size_t num_ptcs = 0;
+    for (const RRNodeId& node : nodes()) {
+        frozen_node_ptc_offsets_[node] = num_ptcs;
+        num_ptcs += node_ptc_nums_[node].size();
+    }
+    frozen_node_ptc_offsets_[RRNodeId(num_nodes_)] = num_ptcs;
+    frozen_node_ptc_nums_.reserve(num_ptcs);
+    for (const RRNodeId& node : nodes()) {
+        frozen_node_ptc_nums_.insert(frozen_node_ptc_nums_.end(), node_ptc_nums_[node].begin(), node_ptc_nums_[node].end());
+    }
+    node_ptc_nums_.clear();
+    node_ptc_nums_.shrink_to_fit();
+
+    /* Flatten the fast look-up */
+    frozen_node_lookup_offsets_.resize({node_lookup_.dim_size(0), node_lookup_.dim_size(1), node_lookup_.dim_size(2)});
+    frozen_node_lookup_num_ptcs_.resize({node_lookup_.dim_size(0), node_lookup_.dim_size(1), node_lookup_.dim_size(2)});
+    size_t num_slots = 0;
+    for (size_t x = 0; x < node_lookup_.dim_size(0); ++x) {
+        for (size_t y = 0; y < node_lookup_.dim_size(1); ++y) {
+            for (size_t itype = 0; itype < node_lookup_.dim_size(2); ++itype) {
+                frozen_node_lookup_offsets_[x][y][itype] = num_slots;
+                frozen_node_lookup_num_ptcs_[x][y][itype] = node_lookup_[x][y][itype].size();
+                num_slots += node_lookup_[x][y][itype].size() * frozen_node_lookup_num_sides(itype);
+            }
+        }
+    }
+    frozen_node_lookup_.resize(num_slots, RRNodeId::INVALID());
+    for (size_t x = 0; x < node_lookup_.dim_size(0); ++x) {
+        for (size_t y = 0; y < node_lookup_.dim_size(1); ++y) {
+            for (size_t itype = 0; itype < node_lookup_.dim_size(2); ++itype) {
+                size_t num_sides = frozen_node_lookup_num_sides(itype);
+                for (size_t ptc = 0; ptc < node_lookup_[x][y][itype].size(); ++ptc) {
+                    const std::vector<RRNodeId>& side_nodes = node_lookup_[x][y][itype][ptc];
+                    for (size_t iside = 0; iside < side_nodes.size(); ++iside) {
+                        if (RRNodeId::INVALID() == side_nodes[iside]) {
+                            continue;
+                        }
+                        size_t islot = (1 == num_sides) ? 0 : iside;
+                        VTR_ASSERT((1 == num_sides) ? (NUM_SIDES == iside) : (iside < num_sides));
+                        frozen_node_lookup_[frozen_node_lookup_offsets_[x][y][itype] + ptc * num_sides + islot] = side_nodes[iside];
+                    }
+                }
+            }
+        }
+    }
+    node_lookup_.clear();
+
+    frozen_ = true;
+}
+
 bool RRGraph::valid_node_id(const RRNodeId& node) const {
     return (size_t(node) < num_nodes_)
-           && (!invalid_node_ids_.count(node));
+           && ((size_t(node) >= invalid_node_ids_.size()) || (false == invalid_node_ids_[size_t(node)]));
 }
 
 bool RRGraph::valid_edge_id(const RREdgeId& edge) const {
     return (size_t(edge) < num_edges_)
-           && (!invalid_edge_ids_.count(edge));
+           && ((size_t(edge) >= invalid_edge_ids_.size()) || (false == invalid_edge_ids_[size_t(edge)]));
 }
 
 /* check if a given switch id is valid or not */
@@ -1360,7 +1577,7 @@ bool RRGraph::validate_node_sizes() const {
     return node_types_.size() == num_nodes_
            && node_bounding_boxes_.size() == num_nodes_
            && node_capacities_.size() == num_nodes_
-           && node_ptc_nums_.size() == num_nodes_
+           && (frozen_ ? frozen_node_ptc_offsets_.size() == num_nodes_ + 1 : node_ptc_nums_.size() == num_nodes_)
            && node_cost_indices_.size() == num_nodes_
            && node_directions_.size() == num_nodes_
            && node_sides_.size() == num_nodes_
@@ -1369,7 +1586,7 @@ bool RRGraph::validate_node_sizes() const {
            && node_segments_.size() == num_nodes_
            && node_num_non_configurable_in_edges_.size() == num_nodes_
            && node_num_non_configurable_out_edges_.size() == num_nodes_
-           && node_edges_.size() == num_nodes_;
+           && (frozen_ ? frozen_node_edge_offsets_.size() == num_nodes_ : node_edges_.size() == num_nodes_);
 }
 
 bool RRGraph::validate_edge_sizes() const {
@@ -1387,6 +1604,8 @@ bool RRGraph::validate_segment_sizes() const {
 }
 
 void RRGraph::compress() {
+    VTR_ASSERT_MSG(false == frozen_, "Can not compress a frozen RRGraph");
+
     vtr::vector<RRNodeId, RRNodeId> node_id_map(num_nodes_);
     vtr::vector<RREdgeId, RREdgeId> edge_id_map(num_edges_);
 
@@ -1516,6 +1735,16 @@ void RRGraph::clear_nodes() {
 
     /* clean node_look_up */
     node_lookup_.clear();
+
+    /* clean the storage of a frozen RRGraph */
+    frozen_ = false;
+    frozen_node_edge_offsets_.clear();
+    frozen_node_edges_.reset();
+    frozen_node_ptc_offsets_.clear();
+    frozen_node_ptc_nums_.clear();
+    frozen_node_lookup_offsets_.clear();
+    frozen_node_lookup_num_ptcs_.clear();
+    frozen_node_lookup_.clear();
 }
 
 /* Empty all the vectors related to edges */
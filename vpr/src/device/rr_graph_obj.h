@@ -238,6 +238,9 @@ class RRGraph {
     RRGraph();
 
   public: /* Accessors */
+    /* Estimated memory (in bytes) of the graph and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
+
     /* Aggregates: create range-based loops for nodes/edges/switches/segments
      * To iterate over the nodes/edges/switches/segments in a RRGraph, 
      *    using a range-based loop is suggested.
@@ -573,6 +576,12 @@ class RRGraph {
      */
     bool is_dirty() const;
 
+    /* This flag is raised when the RRGraph is frozen by freeze(),
+     * i.e., its nodes, edges and fast look-up are stored in compact arrays
+     * and no more nodes or edges can be added or removed
+     */
+    bool is_frozen() const;
+
   public:                                        /* Echos */
     void print_node(const RRNodeId& node) const; /* Print the detailed information of a node */
 
@@ -752,6 +761,22 @@ class RRGraph {
      */
     void compress();
 
+    /* Freeze the RRGraph once it is completely built, so that the queries
+     * on nodes and edges, e.g., by router and timing analyzer, are faster and
+     * consume less memory:
+     *  - the edges of all the nodes are pooled in a single array, where
+     *    each node refers to its edges by an offset (CSR format)
+     *  - the ptc numbers of all the nodes are pooled in a single array
+     *  - the fast look-up is flattened into a single array, indexed by
+     *    the offset of each (x, y, type) and then by ptc number and side
+     * Accessors behave the same on a frozen RRGraph, while nodes and edges
+     * can not be created or removed any more until the RRGraph is cleared.
+     *
+     * The RRGraph should be clean (see compress()) and its node edges
+     * should be built (see rebuild_node_edges()) before freezing
+     */
+    void freeze();
+
     /* top-level function to free, should be called when to delete a RRGraph */
     void clear();
     
@@ -763,12 +788,14 @@ class RRGraph {
      * This class (forward delcared above) is a template used to represent a lazily calculated 
      * iterator of the specified ID type. The key assumption made is that the ID space is 
      * contiguous and can be walked by incrementing the underlying ID value. To account for 
-     * invalid IDs, it keeps a reference to the invalid ID set and returns ID::INVALID() for
-     * ID values in the set.
+     * invalid IDs, it keeps a reference to the invalid ID flags and returns ID::INVALID() for
+     * ID values which are flagged.
+     * The flags are empty as long as no node/edge is removed (or after compress()),
+     * so that walking through the IDs is as fast as walking through a plain array.
      *
      * It is used to lazily create an iteration range (e.g. as returned by RRGraph::edges() RRGraph::nodes())
      * just based on the count of allocated elements (i.e. RRGraph::num_nodes_ or RRGraph::num_edges_),
-     * and the set of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
+     * and the flags of any invalid IDs (i.e. RRGraph::invalid_node_ids_, RRGraph::invalid_edge_ids_).
      */
     template<class ID>
     class lazy_id_iterator : public std::iterator<std::bidirectional_iterator_tag, ID> {
@@ -778,7 +805,7 @@ class RRGraph {
         typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::value_type value_type;
         typedef typename std::iterator<std::bidirectional_iterator_tag, ID>::iterator iterator;
 
-        lazy_id_iterator(value_type init, const std::unordered_set<ID>& invalid_ids)
+        lazy_id_iterator(value_type init, const std::vector<bool>& invalid_ids)
             : value_(init)
             , invalid_ids_(invalid_ids) {}
 
@@ -795,14 +822,16 @@ class RRGraph {
         }
 
         //Dereference the iterator
-        value_type operator*() const { return (invalid_ids_.count(value_)) ? ID::INVALID() : value_; }
+        value_type operator*() const {
+            return ((false == invalid_ids_.empty()) && (size_t(value_) < invalid_ids_.size()) && (true == invalid_ids_[size_t(value_)])) ? ID::INVALID() : value_;
+        }
 
         friend bool operator==(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return lhs.value_ == rhs.value_; }
         friend bool operator!=(const lazy_id_iterator<ID> lhs, const lazy_id_iterator<ID> rhs) { return !(lhs == rhs); }
 
       private:
         value_type value_;
-        const std::unordered_set<ID>& invalid_ids_;
+        const std::vector<bool>& invalid_ids_;
     };
 
   private: /* Internal free functions */
@@ -827,6 +856,10 @@ class RRGraph {
     bool valid_fast_node_lookup() const;
     void initialize_fast_node_lookup() const;
 
+    /* Accessors to the storage of a frozen RRGraph */
+    RREdgeId* node_edge_array(const RRNodeId& node) const;
+    RRNodeId find_frozen_node(const short& x, const short& y, const t_rr_type& type, const int& ptc, const e_side& side) const;
+
     /* Graph property Validation */
     bool validate_sizes() const;
     bool validate_node_sizes() const;
@@ -864,8 +897,11 @@ class RRGraph {
 
   private: /* Internal Data */
     /* Node related data */
-    size_t num_nodes_;                              /* Range of node ids */
-    std::unordered_set<RRNodeId> invalid_node_ids_; /* Invalid edge ids */
+    size_t num_nodes_; /* Range of node ids */
+    /* Flags of invalid node ids, indexed by node ids
+     * Only allocated when a node is removed, and empty when there is no invalid node
+     */
+    std::vector<bool> invalid_node_ids_;
 
     vtr::vector<RRNodeId, t_rr_type> node_types_;
 
@@ -921,7 +957,10 @@ class RRGraph {
      * the number of edges could be >10 times larger than the number of nodes! 
      */
     unsigned long num_edges_;                         
-    std::unordered_set<RREdgeId> invalid_edge_ids_;   /* Invalid edge ids */
+    /* Flags of invalid edge ids, indexed by edge ids
+     * Only allocated when an edge is removed, and empty when there is no invalid edge
+     */
+    std::vector<bool> invalid_edge_ids_;
     vtr::vector<RREdgeId, RRNodeId> edge_src_nodes_;
     vtr::vector<RREdgeId, RRNodeId> edge_sink_nodes_;
     vtr::vector<RREdgeId, RRSwitchId> edge_switches_;
@@ -951,6 +990,31 @@ class RRGraph {
      */
     typedef vtr::NdMatrix<std::vector<std::vector<RRNodeId>>, 3> NodeLookup;
     mutable NodeLookup node_lookup_;
+
+    /* Compact storage of a frozen RRGraph, which replaces
+     * node_edges_, node_ptc_nums_ and node_lookup_ (see freeze())
+     */
+    bool frozen_ = false;
+
+    /* The edges of a node are in frozen_node_edges_, starting from frozen_node_edge_offsets_[node],
+     * and sorted in the same sub-ranges as node_edges_[node]
+     */
+    vtr::vector<RRNodeId, size_t> frozen_node_edge_offsets_;
+    std::unique_ptr<RREdgeId[]> frozen_node_edges_;
+
+    /* The ptc numbers of a node are in frozen_node_ptc_nums_, in the range
+     * [frozen_node_ptc_offsets_[node], frozen_node_ptc_offsets_[node + 1])
+     */
+    vtr::vector<RRNodeId, size_t> frozen_node_ptc_offsets_;
+    std::vector<short> frozen_node_ptc_nums_;
+
+    /* The nodes of (x, y, type) are in frozen_node_lookup_, starting from frozen_node_lookup_offsets_[x][y][type],
+     * for each ptc number in [0..frozen_node_lookup_num_ptcs_[x][y][type]-1]
+     * with a slot per side (0..NUM_SIDES) for IPIN and OPIN, and a single slot for the other types
+     */
+    vtr::NdMatrix<size_t, 3> frozen_node_lookup_offsets_;
+    vtr::NdMatrix<size_t, 3> frozen_node_lookup_num_ptcs_;
+    std::vector<RRNodeId> frozen_node_lookup_;
 };
 
 #endif
@@ -7,6 +7,7 @@
  ********************************************************************/
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <string.h>
 #include <iomanip>
@@ -27,70 +28,74 @@ using namespace std;
 constexpr int FLOAT_PRECISION = std::numeric_limits<float>::max_digits10;
 
 /*********************** External Subroutines to this module *******************/
-void write_rr_channel(fstream &fp);
-void write_rr_grid(fstream &fp);
-void write_rr_block_types(fstream &fp);
+void write_rr_channel(ostream& fp);
+void write_rr_grid(ostream& fp);
+void write_rr_block_types(ostream& fp);
+void write_rr_graph_items(ostream& fp, const size_t& num_items, const size_t& num_threads, const std::function<void(std::ostream&, const size_t&)>& write_item);
 
 /************************ Subroutine definitions ****************************/
 static 
-void add_metadata_to_xml(std::fstream& fp, const char* tab_prefix, const t_metadata_dict& meta) {
-    fp << tab_prefix << "<metadata>" << std::endl;
+void add_metadata_to_xml(std::ostream& fp, const char* tab_prefix, const t_metadata_dict& meta) {
+    fp << tab_prefix << "<metadata>" << '\n';
 
     for (const auto& meta_elem : meta) {
         const std::string& key = meta_elem.first;
         const std::vector<t_metadata_value>& values = meta_elem.second;
         for (const auto& value : values) {
             fp << tab_prefix << "\t<meta name=\"" << key << "\"";
-            fp << ">" << value.as_string() << "</meta>" << std::endl;
+            fp << ">" << value.as_string() << "</meta>" << '\n';
         }
     }
-    fp << tab_prefix << "</metadata>" << std::endl;
+    fp << tab_prefix << "</metadata>" << '\n';
 }
 
 /* All relevant rr node info is written out to the graph.
  * This includes location, timing, and segment info
+ * The nodes are formatted in parallel, and written in order
  */
 static 
-void write_rr_graph_node(fstream &fp, const RRGraph& rr_graph) {
+void write_rr_graph_node(fstream &fp, const RRGraph& rr_graph, const size_t& num_threads) {
   /* TODO: we should make it function full independent from device_ctx !!! */
   auto& device_ctx = g_vpr_ctx.device();
 
   fp << "\t<rr_nodes>" << endl;
 
-  for (auto node : rr_graph.nodes()) {
-    fp << "\t\t<node";
-    fp << " id=\"" << rr_graph.node_index(node);
-    fp << "\" type=\"" << rr_node_typename[rr_graph.node_type(node)];
+  std::vector<RRNodeId> nodes(rr_graph.nodes().begin(), rr_graph.nodes().end());
+  write_rr_graph_items(fp, nodes.size(), num_threads, [&](std::ostream& os, const size_t& inode) {
+    const RRNodeId& node = nodes[inode];
+    os << "\t\t<node";
+    os << " id=\"" << rr_graph.node_index(node);
+    os << "\" type=\"" << rr_node_typename[rr_graph.node_type(node)];
     if (CHANX == rr_graph.node_type(node) || CHANY == rr_graph.node_type(node)) {
-      fp << "\" direction=\"" << DIRECTION_STRING_WRITE_XML[rr_graph.node_direction(node)];
+      os << "\" direction=\"" << DIRECTION_STRING_WRITE_XML[rr_graph.node_direction(node)];
     }
-    fp << "\" capacity=\"" << rr_graph.node_capacity(node);
-    fp << "\">" << endl;
-    fp << "\t\t\t<loc";
-    fp << " xlow=\"" << rr_graph.node_xlow(node);
-    fp << "\" ylow=\"" << rr_graph.node_ylow(node);
-    fp << "\" xhigh=\"" << rr_graph.node_xhigh(node);
-    fp << "\" yhigh=\"" << rr_graph.node_yhigh(node);
+    os << "\" capacity=\"" << rr_graph.node_capacity(node);
+    os << "\">" << '\n';
+    os << "\t\t\t<loc";
+    os << " xlow=\"" << rr_graph.node_xlow(node);
+    os << "\" ylow=\"" << rr_graph.node_ylow(node);
+    os << "\" xhigh=\"" << rr_graph.node_xhigh(node);
+    os << "\" yhigh=\"" << rr_graph.node_yhigh(node);
     if (IPIN == rr_graph.node_type(node) || OPIN == rr_graph.node_type(node)) {
-      fp << "\" side=\"" << SIDE_STRING[rr_graph.node_side(node)];
+      os << "\" side=\"" << SIDE_STRING[rr_graph.node_side(node)];
     }
-    fp << "\" ptc=\"" << rr_graph.node_ptc_num(node) ;
-    fp << "\"/>" << endl;
-    fp << "\t\t\t<timing R=\"" << setprecision(FLOAT_PRECISION) << rr_graph.node_R(node)
-            << "\" C=\"" << setprecision(FLOAT_PRECISION) << rr_graph.node_C(node) << "\"/>" << endl;
+    os << "\" ptc=\"" << rr_graph.node_ptc_num(node) ;
+    os << "\"/>" << '\n';
+    os << "\t\t\t<timing R=\"" << setprecision(FLOAT_PRECISION) << rr_graph.node_R(node)
+            << "\" C=\"" << setprecision(FLOAT_PRECISION) << rr_graph.node_C(node) << "\"/>" << '\n';
 
     if (RRSegmentId::INVALID() != rr_graph.node_segment(node)) {
-      fp << "\t\t\t<segment segment_id=\"" << size_t(rr_graph.node_segment(node)) << "\"/>" << endl;
+      os << "\t\t\t<segment segment_id=\"" << size_t(rr_graph.node_segment(node)) << "\"/>" << '\n';
     }
 
     const auto iter = device_ctx.rr_node_metadata.find(rr_graph.node_index(node));
     if(iter != device_ctx.rr_node_metadata.end()) {
       const t_metadata_dict & meta = iter->second;
-      add_metadata_to_xml(fp, "\t\t\t", meta);
+      add_metadata_to_xml(os, "\t\t\t", meta);
     }
 
-    fp << "\t\t</node>" << endl;
-  }
+    os << "\t\t</node>" << '\n';
+  });
 
   fp << "\t</rr_nodes>" << endl << endl;
 
@@ -163,17 +168,18 @@ void write_rr_graph_switches(fstream &fp, const RRGraph& rr_graph) {
 
 /* Edges connecting to each rr node is printed out. The two nodes
  * it connects to are also printed
+ * The edges of the nodes are formatted in parallel, and written in order
  */
 static 
-void write_rr_graph_edges(fstream &fp, const RRGraph& rr_graph) {
+void write_rr_graph_edges(fstream &fp, const RRGraph& rr_graph, const size_t& num_threads) {
   auto& device_ctx = g_vpr_ctx.device();
   fp << "\t<rr_edges>" << endl;
 
-  for (auto node : rr_graph.nodes()) {
-    /* Sort the edges by the ids of sink nodes */
-    std::vector<RREdgeId> sorted_out_edge_ids;
+  std::vector<RRNodeId> nodes(rr_graph.nodes().begin(), rr_graph.nodes().end());
+  write_rr_graph_items(fp, nodes.size(), num_threads, [&](std::ostream& os, const size_t& inode) {
+    const RRNodeId& node = nodes[inode];
     for (auto edge: rr_graph.node_out_edges(node)) {
-      fp << "\t\t<edge src_node=\"" << rr_graph.node_index(node) <<
+      os << "\t\t<edge src_node=\"" << rr_graph.node_index(node) <<
             "\" sink_node=\"" << rr_graph.node_index(rr_graph.edge_sink_node(edge)) <<
             "\" switch_id=\"" << rr_graph.switch_index(rr_graph.edge_switch(edge)) << "\"";
 
@@ -182,25 +188,25 @@ void write_rr_graph_edges(fstream &fp, const RRGraph& rr_graph) {
                                                           rr_graph.node_index(rr_graph.edge_sink_node(edge)),
                                                           rr_graph.switch_index(rr_graph.edge_switch(edge))) );
       if(iter != device_ctx.rr_edge_metadata.end()) {
-        fp << ">" << endl;
+        os << ">" << '\n';
 
         const t_metadata_dict & meta = iter->second;
-        add_metadata_to_xml(fp, "\t\t\t", meta);
+        add_metadata_to_xml(os, "\t\t\t", meta);
         wrote_edge_metadata = true;
       }
 
       if(wrote_edge_metadata == false) {
-        fp << "/>" << endl;
+        os << "/>" << '\n';
       } else {
-        fp << "\t\t</edge>" << endl;
+        os << "\t\t</edge>" << '\n';
       }
     }
-  }
+  });
   fp << "\t</rr_edges>" << endl << endl;
 }
 
 /* This function is used to write the rr_graph into xml format into a a file with name: file_name */
-void write_xml_rr_graph_obj(const char *file_name, const RRGraph& rr_graph) {
+void write_xml_rr_graph_obj(const char *file_name, const RRGraph& rr_graph, const size_t& num_threads) {
     fstream fp;
     fp.open(file_name, fstream::out | fstream::trunc);
 
@@ -226,8 +232,8 @@ void write_xml_rr_graph_obj(const char *file_name, const RRGraph& rr_graph) {
     write_rr_graph_segments(fp, rr_graph);
     write_rr_block_types(fp);
     write_rr_grid(fp);
-    write_rr_graph_node(fp, rr_graph);
-    write_rr_graph_edges(fp, rr_graph);
+    write_rr_graph_node(fp, rr_graph, num_threads);
+    write_rr_graph_edges(fp, rr_graph, num_threads);
     fp << "</rr_graph>";
 
     fp.close();
@@ -7,6 +7,7 @@
 #ifndef WRITE_XML_RR_GRAPH_OBJ_H
 #define WRITE_XML_RR_GRAPH_OBJ_H
 
-void write_xml_rr_graph_obj(const char *file_name, const RRGraph& rr_graph);
+//The nodes and edges are formatted with num_threads threads (0 for all the cores)
+void write_xml_rr_graph_obj(const char *file_name, const RRGraph& rr_graph, const size_t& num_threads);
 
 #endif
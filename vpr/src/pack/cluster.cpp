@@ -70,8 +70,11 @@
 #include "tatum/report/graphviz_dot_writer.hpp"
 #include "tatum/TimingReporter.hpp"
 
+#include "openfpga_parallel.h"
+
 #define AAPACK_MAX_HIGH_FANOUT_EXPLORE 10 /* For high-fanout nets that are ignored, consider a maximum of this many sinks, must be less than packer_opts.feasible_block_array_size */
 #define AAPACK_MAX_TRANSITIVE_EXPLORE 40  /* When investigating transitive fanout connections in packing, consider a maximum of this many molecules, must be less than packer_opts.feasible_block_array_size */
+#define AAPACK_MIN_PARALLEL_GAIN_MOLECULES 64 /* The gains of fewer candidate molecules are computed by a single thread, as the threads would cost more than they save */
 
 //Constant allowing all cluster pins to be used
 const t_ext_pin_util FULL_EXTERNAL_PIN_UTIL(1., 1.);
@@ -140,6 +143,9 @@ static t_molecule_link* memory_pool; /*Declared here so I can free easily.*/
  * so this should take care of all multiple connections.                */
 static std::unordered_map<AtomNetId, int> net_output_feeds_driving_block_input;
 
+/* Number of threads computing the gains of the candidate molecules of a cluster */
+static size_t gain_num_threads = 1;
+
 /*****************************************/
 /*local functions*/
 /*****************************************/
@@ -150,8 +156,13 @@ static void check_for_duplicate_inputs ();
 
 static bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb);
 
+static void add_molecules_to_pb_stats_candidates(const std::vector<t_pack_molecule*>& molecules,
+                                                 t_pb* pb,
+                                                 int max_queue_size);
+
 static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                                std::map<AtomBlockId, float>& gain,
+                                                float molecule_gain,
+                                                std::vector<float>& feasible_block_gains,
                                                 t_pb* pb,
                                                 int max_queue_size);
 
@@ -322,7 +333,7 @@ static std::vector<AtomBlockId> initialize_seed_atoms(const e_cluster_seed seed_
 
 static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules, const std::vector<AtomBlockId> seed_atoms);
 
-static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain);
+static float get_molecule_gain(const t_pack_molecule* molecule, const std::map<AtomBlockId, float>& blk_gain);
 static int compare_molecule_gain(const void* a, const void* b);
 int net_sinks_reachable_in_cluster(const t_pb_graph_pin* driver_pb_gpin, const int depth, const AtomNetId net_id);
 
@@ -396,6 +407,8 @@ std::map<t_logical_block_type_ptr, size_t> do_clustering(const t_packer_opts& pa
 
     const int verbosity = packer_opts.pack_verbosity;
 
+    gain_num_threads = packer_opts.num_workers;
+
     std::map<t_logical_block_type_ptr, size_t> num_used_type_instances;
 
     bool is_cluster_legal;
@@ -809,8 +822,33 @@ static bool is_atom_blk_in_pb(const AtomBlockId blk_id, const t_pb* pb) {
 }
 
 /* Add blk to list of feasible blocks sorted according to gain */
+/* Adds the feasible candidate molecules to the (empty) queue of candidates of a cluster.
+ * The gains of the molecules only read the gains of the atom blocks to the cluster,
+ * so they are computed in parallel. The queue is then filled serially with the
+ * gains computed, in the order of the molecules, as if they were added one by one. */
+static void add_molecules_to_pb_stats_candidates(const std::vector<t_pack_molecule*>& molecules,
+                                                 t_pb* pb,
+                                                 int max_queue_size) {
+    VTR_ASSERT(pb->pb_stats->num_feasible_blocks == 0);
+
+    std::vector<float> molecule_gains(molecules.size());
+    size_t num_threads = (molecules.size() < AAPACK_MIN_PARALLEL_GAIN_MOLECULES) ? 1 : gain_num_threads;
+    openfpga::parallel_for(molecules.size(), num_threads, [&](const size_t& imol) {
+        molecule_gains[imol] = get_molecule_gain(molecules[imol], pb->pb_stats->gain);
+    });
+
+    std::vector<float> feasible_block_gains(max_queue_size);
+    for (size_t imol = 0; imol < molecules.size(); imol++) {
+        add_molecule_to_pb_stats_candidates(molecules[imol], molecule_gains[imol], feasible_block_gains, pb, max_queue_size);
+    }
+}
+
+/* Inserts a molecule of the given gain in the queue of candidates of a cluster,
+ * sorted by increasing gain. feasible_block_gains holds the gains of the molecules
+ * of the queue. */
 static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
-                                                std::map<AtomBlockId, float>& gain,
+                                                float molecule_gain,
+                                                std::vector<float>& feasible_block_gains,
                                                 t_pb* pb,
                                                 int max_queue_size) {
     int i, j;
@@ -823,32 +861,38 @@ static void add_molecule_to_pb_stats_candidates(t_pack_molecule* molecule,
 
     if (pb->pb_stats->num_feasible_blocks >= max_queue_size - 1) {
         /* maximum size for array, remove smallest gain element and sort */
-        if (get_molecule_gain(molecule, gain) > get_molecule_gain(pb->pb_stats->feasible_blocks[0], gain)) {
+        if (molecule_gain > feasible_block_gains[0]) {
             /* single loop insertion sort */
             for (j = 0; j < pb->pb_stats->num_feasible_blocks - 1; j++) {
-                if (get_molecule_gain(molecule, gain) <= get_molecule_gain(pb->pb_stats->feasible_blocks[j + 1], gain)) {
+                if (molecule_gain <= feasible_block_gains[j + 1]) {
                     pb->pb_stats->feasible_blocks[j] = molecule;
+                    feasible_block_gains[j] = molecule_gain;
                     break;
                 } else {
                     pb->pb_stats->feasible_blocks[j] = pb->pb_stats->feasible_blocks[j + 1];
+                    feasible_block_gains[j] = feasible_block_gains[j + 1];
                 }
             }
             if (j == pb->pb_stats->num_feasible_blocks - 1) {
                 pb->pb_stats->feasible_blocks[j] = molecule;
+                feasible_block_gains[j] = molecule_gain;
             }
         }
     } else {
         /* Expand array and single loop insertion sort */
         for (j = pb->pb_stats->num_feasible_blocks - 1; j >= 0; j--) {
-            if (get_molecule_gain(pb->pb_stats->feasible_blocks[j], gain) > get_molecule_gain(molecule, gain)) {
+            if (feasible_block_gains[j] > molecule_gain) {
                 pb->pb_stats->feasible_blocks[j + 1] = pb->pb_stats->feasible_blocks[j];
+                feasible_block_gains[j + 1] = feasible_block_gains[j];
             } else {
                 pb->pb_stats->feasible_blocks[j + 1] = molecule;
+                feasible_block_gains[j + 1] = molecule_gain;
                 break;
             }
         }
         if (j < 0) {
             pb->pb_stats->feasible_blocks[0] = molecule;
+            feasible_block_gains[0] = molecule_gain;
         }
         pb->pb_stats->num_feasible_blocks++;
     }
@@ -1223,14 +1267,7 @@ static bool cleanup_pb(t_pb* pb) {
 
         /* Free if can */
         if (can_free) {
-            for (int i = 0; i < mode->num_pb_type_children; ++i) {
-                if (pb->child_pbs[i] != nullptr) {
-                    delete[] pb->child_pbs[i];
-                }
-            }
-
-            delete[] pb->child_pbs;
-            pb->child_pbs = nullptr;
+            free_child_pbs(pb, *mode);
             pb->mode = 0;
 
             if (pb->name) {
@@ -1488,11 +1525,9 @@ static enum e_block_pack_status try_place_atom_block_rec(const t_pb_graph_node*
         parent_pb->mode = pb_graph_node->pb_type->parent_mode->index;
         set_reset_pb_modes(router_data, parent_pb, true);
         const t_mode* mode = &parent_pb->pb_graph_node->pb_type->modes[parent_pb->mode];
-        parent_pb->child_pbs = new t_pb*[mode->num_pb_type_children];
+        alloc_child_pbs(parent_pb, *mode);
 
         for (i = 0; i < mode->num_pb_type_children; i++) {
-            parent_pb->child_pbs[i] = new t_pb[mode->pb_type_children[i].num_pb];
-
             for (j = 0; j < mode->pb_type_children[i].num_pb; j++) {
                 parent_pb->child_pbs[i][j].parent_pb = parent_pb;
 
@@ -2061,6 +2096,7 @@ static void start_new_cluster(t_cluster_placement_stats* cluster_placement_stats
         pb->pb_graph_node = type->pb_graph_head;
         alloc_and_load_pb_stats(pb, feasible_block_array_size);
         pb->parent_pb = nullptr;
+        pb->child_pbs_arena = clb_nlist->pb_arena();
 
         *router_data = alloc_and_load_router_data(&lb_type_rr_graphs[type->index], type);
 
@@ -2224,6 +2260,8 @@ void add_cluster_molecule_candidates_by_connectivity_and_timing(t_pb* cur_pb,
 
     auto& atom_ctx = g_vpr_ctx.atom();
 
+    /* The feasibility checks update the lists of free primitives, so only the gains are computed in parallel */
+    std::vector<t_pack_molecule*> molecules;
     for (AtomBlockId blk_id : cur_pb->pb_stats->marked_blocks) {
         if (atom_ctx.lookup.atom_clb(blk_id) == ClusterBlockId::INVALID()) {
             auto rng = atom_molecules.equal_range(blk_id);
@@ -2244,13 +2282,14 @@ void add_cluster_molecule_candidates_by_connectivity_and_timing(t_pb* cur_pb,
                         }
                     }
                     if (success) {
-                        add_molecule_to_pb_stats_candidates(molecule,
-                                                            cur_pb->pb_stats->gain, cur_pb, feasible_block_array_size);
+                        molecules.push_back(molecule);
                     }
                 }
             }
         }
     }
+
+    add_molecules_to_pb_stats_candidates(molecules, cur_pb, feasible_block_array_size);
 }
 
 void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
@@ -2267,6 +2306,7 @@ void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
     auto& atom_ctx = g_vpr_ctx.atom();
 
     int count = 0;
+    std::vector<t_pack_molecule*> molecules;
     for (auto pin_id : atom_ctx.nlist.net_pins(net_id)) {
         if (count >= AAPACK_MAX_HIGH_FANOUT_EXPLORE) {
             break;
@@ -2293,14 +2333,14 @@ void add_cluster_molecule_candidates_by_highfanout_connectivity(t_pb* cur_pb,
                         }
                     }
                     if (success) {
-                        add_molecule_to_pb_stats_candidates(molecule,
-                                                            cur_pb->pb_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_HIGH_FANOUT_EXPLORE));
+                        molecules.push_back(molecule);
                         count++;
                     }
                 }
             }
         }
     }
+    add_molecules_to_pb_stats_candidates(molecules, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_HIGH_FANOUT_EXPLORE));
     cur_pb->pb_stats->tie_break_high_fanout_net = AtomNetId::INVALID(); /* Mark off that this high fanout net has been considered */
 }
 
@@ -2324,6 +2364,7 @@ void add_cluster_molecule_candidates_by_transitive_connectivity(t_pb* cur_pb,
                                       clb_inter_blk_nets,
                                       transitive_fanout_threshold);
     /* Only consider candidates that pass a very simple legality check */
+    std::vector<t_pack_molecule*> molecules;
     for (const auto& transitive_candidate : cur_pb->pb_stats->transitive_fanout_candidates) {
         t_pack_molecule* molecule = transitive_candidate.second;
         if (molecule->valid) {
@@ -2341,11 +2382,11 @@ void add_cluster_molecule_candidates_by_transitive_connectivity(t_pb* cur_pb,
                 }
             }
             if (success) {
-                add_molecule_to_pb_stats_candidates(molecule,
-                                                    cur_pb->pb_stats->gain, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_TRANSITIVE_EXPLORE));
+                molecules.push_back(molecule);
             }
         }
     }
+    add_molecules_to_pb_stats_candidates(molecules, cur_pb, std::min(feasible_block_array_size, AAPACK_MAX_TRANSITIVE_EXPLORE));
 }
 
 /*****************************************/
@@ -2804,7 +2845,7 @@ static t_pack_molecule* get_highest_gain_seed_molecule(int* seedindex, const std
  * + molecule_base_gain*some_factor
  * - introduced_input_nets_of_unrelated_blocks_pulled_in_by_molecule*some_other_factor
  */
-static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId, float>& blk_gain) {
+static float get_molecule_gain(const t_pack_molecule* molecule, const std::map<AtomBlockId, float>& blk_gain) {
     float gain;
     int i;
     int num_introduced_inputs_of_indirectly_related_block;
@@ -2815,8 +2856,9 @@ static float get_molecule_gain(t_pack_molecule* molecule, std::map<AtomBlockId,
     for (i = 0; i < get_array_size_of_molecule(molecule); i++) {
         auto blk_id = molecule->atom_block_ids[i];
         if (blk_id) {
-            if (blk_gain.count(blk_id) > 0) {
-                gain += blk_gain[blk_id];
+            auto gain_itr = blk_gain.find(blk_id);
+            if (gain_itr != blk_gain.end()) {
+                gain += gain_itr->second;
             } else {
                 /* This block has no connection with current cluster, penalize molecule for having this block
                  */
@@ -1,8 +1,14 @@
+#include <algorithm>
+#include <limits>
+
 #include "vtr_memory.h"
 #include "vtr_random.h"
+#include "vtr_geometry.h"
 
 #include "globals.h"
 #include "read_place.h"
+#include "place_macro.h"
+#include "compressed_grid.h"
 #include "initial_placement.h"
 
 /* The maximum number of tries when trying to place a carry chain at a    *
@@ -10,6 +16,11 @@
  * legal position and place it during initial placement.                  */
 #define MAX_NUM_TRIES_TO_PLACE_MACROS_RANDOMLY 4
 
+/* The number of iterations of the force-directed solve of the analytic   *
+ * initial placement, which moves each block to the average of the        *
+ * centers of its nets (weighted by the inverse of their fanouts).        */
+#define NUM_ANALYTIC_PLACEMENT_ITERATIONS 50
+
 static t_pl_loc** legal_pos = nullptr; /* [0..device_ctx.num_block_types-1][0..type_tsize - 1] */
 static int* num_legal_pos = nullptr;   /* [0..num_legal_pos-1] */
 
@@ -29,6 +40,13 @@ static t_physical_tile_type_ptr pick_placement_type(t_logical_block_type_ptr log
                                                     int num_needed_types,
                                                     int* free_locations);
 
+static void analytic_initial_placement();
+static vtr::vector<ClusterBlockId, bool> find_analytic_movable_blocks();
+static vtr::vector<ClusterBlockId, vtr::Point<float>> solve_analytic_block_positions(const vtr::vector<ClusterBlockId, bool>& is_movable);
+static void place_analytic_macro(const t_pl_macro& pl_macro, const vtr::vector<ClusterBlockId, vtr::Point<float>>& positions);
+static bool find_nearest_free_location(const t_compressed_block_grid& compressed_grid, vtr::Point<float> target, t_pl_loc& to);
+static int find_nearest_compressed_coord(const std::vector<int>& compressed_to_grid, float coord);
+
 static void alloc_legal_placement_locations() {
     auto& device_ctx = g_vpr_ctx.device();
     auto& place_ctx = g_vpr_ctx.mutable_placement();
@@ -346,12 +364,291 @@ static t_physical_tile_type_ptr pick_placement_type(t_logical_block_type_ptr log
     return nullptr;
 }
 
+/* Replaces the random locations of the movable blocks with an analytic placement.
+ * The I/Os and the fixed blocks stay where they are, and anchor a force-directed
+ * solve of the locations of the other blocks. The macros are then legalized at the
+ * free head location closest to their solved location, and the other blocks at the
+ * free location closest to their solved location (in the compressed grid of their
+ * type), from the center of the design outwards. */
+static void analytic_initial_placement() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.mutable_placement();
+
+    vtr::vector<ClusterBlockId, bool> is_movable = find_analytic_movable_blocks();
+    vtr::vector<ClusterBlockId, vtr::Point<float>> positions = solve_analytic_block_positions(is_movable);
+
+    /* Remove the movable blocks from the grid */
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (!is_movable[blk_id]) {
+            continue;
+        }
+        t_pl_loc loc = place_ctx.block_locs[blk_id].loc;
+        VTR_ASSERT(place_ctx.grid_blocks[loc.x][loc.y].blocks[loc.z] == blk_id);
+        place_ctx.grid_blocks[loc.x][loc.y].blocks[loc.z] = EMPTY_BLOCK_ID;
+        place_ctx.grid_blocks[loc.x][loc.y].usage--;
+        place_ctx.block_locs[blk_id].loc = t_pl_loc();
+    }
+
+    /* Macros are harder to place.  Do them first, the largest ones first */
+    std::vector<t_pl_macro> sorted_pl_macros(place_ctx.pl_macros.begin(), place_ctx.pl_macros.end());
+    std::stable_sort(sorted_pl_macros.begin(), sorted_pl_macros.end(),
+                     [](const t_pl_macro& lhs, const t_pl_macro& rhs) {
+                         return lhs.members.size() > rhs.members.size();
+                     });
+    for (const t_pl_macro& pl_macro : sorted_pl_macros) {
+        if (is_movable[pl_macro.members[0].blk_index]) {
+            place_analytic_macro(pl_macro, positions);
+        }
+    }
+
+    /* Place the other blocks from the center of the design outwards, so
+     * that the blocks solved at the same location spread around it */
+    std::vector<ClusterBlockId> sorted_blocks;
+    vtr::Point<float> center(0., 0.);
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        if (is_movable[blk_id] && place_ctx.block_locs[blk_id].loc.x == OPEN) {
+            sorted_blocks.push_back(blk_id);
+            center.set(center.x() + positions[blk_id].x(), center.y() + positions[blk_id].y());
+        }
+    }
+    if (!sorted_blocks.empty()) {
+        center.set(center.x() / sorted_blocks.size(), center.y() / sorted_blocks.size());
+    }
+    auto center_dist = [&](const ClusterBlockId blk_id) {
+        float dx = positions[blk_id].x() - center.x();
+        float dy = positions[blk_id].y() - center.y();
+        return dx * dx + dy * dy;
+    };
+    std::stable_sort(sorted_blocks.begin(), sorted_blocks.end(),
+                     [&](const ClusterBlockId lhs, const ClusterBlockId rhs) {
+                         return center_dist(lhs) < center_dist(rhs);
+                     });
+
+    std::vector<t_compressed_block_grid> compressed_block_grids = create_compressed_block_grids();
+    for (auto blk_id : sorted_blocks) {
+        auto logical_block = cluster_ctx.clb_nlist.block_type(blk_id);
+
+        t_pl_loc to;
+        if (!find_nearest_free_location(compressed_block_grids[logical_block->index], positions[blk_id], to)) {
+            VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                            "Initial placement failed.\n"
+                            "Could not place block %s (#%zu); no free locations of type %s (#%d).\n",
+                            cluster_ctx.clb_nlist.block_name(blk_id).c_str(), size_t(blk_id), logical_block->name, logical_block->index);
+        }
+
+        place_ctx.grid_blocks[to.x][to.y].blocks[to.z] = blk_id;
+        place_ctx.grid_blocks[to.x][to.y].usage++;
+
+        place_ctx.block_locs[blk_id].loc = to;
+    }
+}
+
+/* The blocks moved by the analytic placement: all the blocks but the I/Os and the
+ * fixed blocks, as well as the macros including such blocks */
+static vtr::vector<ClusterBlockId, bool> find_analytic_movable_blocks() {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    vtr::vector<ClusterBlockId, bool> is_movable(cluster_ctx.clb_nlist.blocks().size(), false);
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        is_movable[blk_id] = !place_ctx.block_locs[blk_id].is_fixed && !is_io_type(physical_tile_type(blk_id));
+    }
+
+    for (const t_pl_macro& pl_macro : place_ctx.pl_macros) {
+        bool is_macro_movable = true;
+        for (const auto& member : pl_macro.members) {
+            is_macro_movable &= is_movable[member.blk_index];
+        }
+        for (const auto& member : pl_macro.members) {
+            is_movable[member.blk_index] = is_macro_movable;
+        }
+    }
+
+    return is_movable;
+}
+
+/* Solve the locations of the movable blocks, starting from their current locations.
+ * Each iteration moves the blocks to the average of the centers of their nets, each
+ * weighted by the inverse of its fanout, like a star model of the nets. */
+static vtr::vector<ClusterBlockId, vtr::Point<float>> solve_analytic_block_positions(const vtr::vector<ClusterBlockId, bool>& is_movable) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    vtr::vector<ClusterBlockId, vtr::Point<float>> positions(cluster_ctx.clb_nlist.blocks().size());
+    for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+        positions[blk_id].set(place_ctx.block_locs[blk_id].loc.x, place_ctx.block_locs[blk_id].loc.y);
+    }
+
+    vtr::vector<ClusterNetId, vtr::Point<float>> net_centers(cluster_ctx.clb_nlist.nets().size());
+    for (int iter = 0; iter < NUM_ANALYTIC_PLACEMENT_ITERATIONS; ++iter) {
+        for (auto net_id : cluster_ctx.clb_nlist.nets()) {
+            if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+                continue;
+            }
+            float x = 0.;
+            float y = 0.;
+            for (ClusterPinId pin_id : cluster_ctx.clb_nlist.net_pins(net_id)) {
+                ClusterBlockId blk_id = cluster_ctx.clb_nlist.pin_block(pin_id);
+                x += positions[blk_id].x();
+                y += positions[blk_id].y();
+            }
+            size_t num_pins = cluster_ctx.clb_nlist.net_pins(net_id).size();
+            net_centers[net_id].set(x / num_pins, y / num_pins);
+        }
+
+        for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
+            if (!is_movable[blk_id]) {
+                continue;
+            }
+            float x = 0.;
+            float y = 0.;
+            float weight = 0.;
+            for (ClusterPinId pin_id : cluster_ctx.clb_nlist.block_pins(blk_id)) {
+                ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(pin_id);
+                if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+                    continue;
+                }
+                float net_weight = 1. / std::max<size_t>(1, cluster_ctx.clb_nlist.net_sinks(net_id).size());
+                x += net_weight * net_centers[net_id].x();
+                y += net_weight * net_centers[net_id].y();
+                weight += net_weight;
+            }
+            if (weight > 0.) {
+                positions[blk_id].set(x / weight, y / weight);
+            }
+        }
+    }
+
+    return positions;
+}
+
+/* Place a macro at the legal head location closest to its solved location */
+static void place_analytic_macro(const t_pl_macro& pl_macro, const vtr::vector<ClusterBlockId, vtr::Point<float>>& positions) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    //The solved location of the head is the average of those of the members, less their offsets
+    float head_x = 0.;
+    float head_y = 0.;
+    for (const auto& member : pl_macro.members) {
+        head_x += positions[member.blk_index].x() - member.offset.x;
+        head_y += positions[member.blk_index].y() - member.offset.y;
+    }
+    head_x /= pl_macro.members.size();
+    head_y /= pl_macro.members.size();
+
+    ClusterBlockId blk_id = pl_macro.members[0].blk_index;
+    auto block_type = cluster_ctx.clb_nlist.block_type(blk_id);
+    for (auto tile_type : block_type->equivalent_tiles) { //Try each possible tile type
+        int itype = tile_type->index;
+
+        std::vector<int> sorted_pos(num_legal_pos[itype]);
+        for (int ipos = 0; ipos < num_legal_pos[itype]; ipos++) {
+            sorted_pos[ipos] = ipos;
+        }
+        auto head_dist = [&](const int ipos) {
+            float dx = legal_pos[itype][ipos].x - head_x;
+            float dy = legal_pos[itype][ipos].y - head_y;
+            return dx * dx + dy * dy;
+        };
+        std::stable_sort(sorted_pos.begin(), sorted_pos.end(),
+                         [&](const int lhs, const int rhs) {
+                             return head_dist(lhs) < head_dist(rhs);
+                         });
+
+        for (int ipos : sorted_pos) {
+            if (try_place_macro(itype, ipos, pl_macro)) {
+                return;
+            }
+        }
+    }
+
+    VPR_FATAL_ERROR(VPR_ERROR_PLACE,
+                    "Initial placement failed.\n"
+                    "Could not place macro length %zu with head block %s (#%zu); not enough free locations.\n",
+                    pl_macro.members.size(), cluster_ctx.clb_nlist.block_name(blk_id).c_str(), size_t(blk_id));
+}
+
+/* Find the free location closest to the target, looking at the locations of the
+ * compressed grid by rings of increasing size around the target. Returns false if
+ * there is no free location. */
+static bool find_nearest_free_location(const t_compressed_block_grid& compressed_grid, vtr::Point<float> target, t_pl_loc& to) {
+    auto& place_ctx = g_vpr_ctx.placement();
+
+    int num_cx = compressed_grid.compressed_to_grid_x.size();
+    int num_cy = compressed_grid.compressed_to_grid_y.size();
+    if (num_cx == 0 || num_cy == 0) {
+        return false;
+    }
+
+    int cx_target = find_nearest_compressed_coord(compressed_grid.compressed_to_grid_x, target.x());
+    int cy_target = find_nearest_compressed_coord(compressed_grid.compressed_to_grid_y, target.y());
+
+    float best_dist = std::numeric_limits<float>::infinity();
+    auto try_location = [&](int cx, int cy) {
+        if (cx < 0 || cx >= num_cx || cy < 0 || cy >= num_cy) {
+            return;
+        }
+        auto itr = compressed_grid.grid[cx].find(cy);
+        if (itr == compressed_grid.grid[cx].end()) {
+            return;
+        }
+        const t_type_loc& loc = itr->second;
+        const auto& blocks = place_ctx.grid_blocks[loc.x][loc.y].blocks;
+        for (size_t z = 0; z < blocks.size(); ++z) {
+            if (blocks[z] == EMPTY_BLOCK_ID) {
+                float dx = loc.x - target.x();
+                float dy = loc.y - target.y();
+                if (dx * dx + dy * dy < best_dist) {
+                    best_dist = dx * dx + dy * dy;
+                    to = t_pl_loc(loc.x, loc.y, z);
+                }
+                break;
+            }
+        }
+    };
+
+    int max_radius = std::max(num_cx, num_cy);
+    for (int radius = 0; radius <= max_radius; ++radius) {
+        for (int cx = cx_target - radius; cx <= cx_target + radius; ++cx) {
+            if (cx == cx_target - radius || cx == cx_target + radius) {
+                for (int cy = cy_target - radius; cy <= cy_target + radius; ++cy) {
+                    try_location(cx, cy);
+                }
+            } else {
+                try_location(cx, cy_target - radius);
+                try_location(cx, cy_target + radius);
+            }
+        }
+        //The closest location of the first ring with a free location is close enough
+        if (best_dist < std::numeric_limits<float>::infinity()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* The compressed coordinate whose grid coordinate is the closest to coord */
+static int find_nearest_compressed_coord(const std::vector<int>& compressed_to_grid, float coord) {
+    auto itr = std::lower_bound(compressed_to_grid.begin(), compressed_to_grid.end(), coord);
+    if (itr == compressed_to_grid.end()) {
+        return compressed_to_grid.size() - 1;
+    }
+    int icoord = std::distance(compressed_to_grid.begin(), itr);
+    if (icoord > 0 && coord - compressed_to_grid[icoord - 1] < *itr - coord) {
+        --icoord;
+    }
+    return icoord;
+}
+
 void initial_placement(enum e_pad_loc_type pad_loc_type,
-                       const char* pad_loc_file) {
+                       const char* pad_loc_file,
+                       e_initial_placement initial_placement_type) {
     /* Randomly places the blocks to create an initial placement. We rely on
      * the legal_pos array already being loaded.  That legal_pos[itype] is an
      * array that gives every legal value of (x,y,z) that can accommodate a block.
      * The number of such locations is given by num_legal_pos[itype].
+     * The analytic initial placement then improves the locations of the movable blocks.
      */
 
     // Loading legal placement locations
@@ -424,6 +721,10 @@ void initial_placement(enum e_pad_loc_type pad_loc_type,
     /* Restore legal_pos */
     load_legal_placement_locations();
 
+    if (initial_placement_type == e_initial_placement::ANALYTIC) {
+        analytic_initial_placement();
+    }
+
 #ifdef VERBOSE
     VTR_LOG("At end of initial_placement.\n");
     if (getEchoEnabled() && isEchoFileEnabled(E_ECHO_INITIAL_CLB_PLACEMENT)) {
@@ -4,6 +4,7 @@
 #include "vpr_types.h"
 
 void initial_placement(enum e_pad_loc_type pad_loc_type,
-                       const char* pad_loc_file);
+                       const char* pad_loc_file,
+                       e_initial_placement initial_placement_type);
 
 #endif
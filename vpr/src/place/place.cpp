@@ -2,12 +2,14 @@
 #include <cmath>
 #include <memory>
 #include <fstream>
+#include <unordered_set>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_util.h"
 #include "vtr_random.h"
 #include "vtr_geometry.h"
+#include "vtr_trace.h"
 
 #include "vpr_types.h"
 #include "vpr_error.h"
@@ -38,9 +40,12 @@
 #include "VprTimingGraphResolver.h"
 #include "timing_util.h"
 #include "timing_info.h"
+#include "IncrementalSetupTimingAnalyzer.h"
 #include "tatum/echo_writer.hpp"
 #include "tatum/TimingReporter.hpp"
 
+#include "openfpga_parallel.h"
+
 using std::max;
 using std::min;
 
@@ -96,6 +101,22 @@ struct t_placer_prev_inverse_costs {
     double timing_cost;
 };
 
+/* A move of a batch of the parallel placement (see parallel_placement_inner_loop) */
+struct t_parallel_swap {
+    t_parallel_swap(size_t max_blocks)
+        : blocks_affected(max_blocks) {}
+
+    t_pl_blocks_to_be_moved blocks_affected;
+    std::vector<ClusterNetId> nets_to_update;
+    double delta_c = 0.;
+    double bb_delta_c = 0.;
+    double timing_delta_c = 0.;
+};
+
+/* Maximum number of moves evaluated at the same time by the parallel placement.  *
+ * It does not depend on the number of workers, so that the placement does not.   */
+constexpr size_t PARALLEL_PLACE_MAX_BATCH_SIZE = 32;
+
 constexpr float INVALID_DELAY = std::numeric_limits<float>::quiet_NaN();
 
 constexpr double MAX_INV_TIMING_COST = 1.e9;
@@ -135,6 +156,12 @@ static vtr::vector<ClusterNetId, double*> temp_point_to_point_timing_cost;
 static vtr::vector<ClusterNetId, float*> point_to_point_delay;
 static vtr::vector<ClusterNetId, float*> temp_point_to_point_delay;
 
+/* The incremental timing analyzer of the placement (if enabled), and the sink pins */
+/* of the connections whose delays changed since its last update              */
+static std::shared_ptr<IncrementalSetupTimingAnalyzer> incremental_timing_analyzer;
+static std::vector<ClusterPinId> changed_delay_pins;
+static vtr::vector<ClusterPinId, bool> is_changed_delay_pin;
+
 /* [0..cluster_ctx.clb_nlist.blocks().size()-1][0..pins_per_clb-1]. Indicates which pin on the net */
 /* this block corresponds to, this is only required during timing-driven */
 /* placement. It is used to allow us to update individual connections on */
@@ -280,8 +307,8 @@ static void free_fast_cost_update();
 
 static double comp_bb_cost(e_cost_methods method);
 
-static void update_move_nets(int num_nets_affected);
-static void reset_move_nets(int num_nets_affected);
+static void update_move_nets(const std::vector<ClusterNetId>& nets_to_update);
+static void reset_move_nets(const std::vector<ClusterNetId>& nets_to_update);
 
 static e_move_result try_swap(float t,
                               t_placer_costs* costs,
@@ -294,6 +321,36 @@ static e_move_result try_swap(float t,
                               enum e_place_algorithm place_algorithm,
                               float timing_tradeoff);
 
+static e_create_move propose_swap(float rlim,
+                                  float rlim_escape_fraction,
+                                  MoveGenerator& move_generator,
+                                  t_pl_blocks_to_be_moved& blocks_affected);
+
+static e_move_result abort_swap(float t,
+                                MoveGenerator& move_generator,
+                                t_pl_blocks_to_be_moved& blocks_affected,
+                                const char* reason);
+
+static double evaluate_swap(const t_placer_prev_inverse_costs* prev_inverse_costs,
+                            const t_pl_blocks_to_be_moved& blocks_affected,
+                            const PlaceDelayModel* delay_model,
+                            enum e_place_algorithm place_algorithm,
+                            float timing_tradeoff,
+                            std::vector<ClusterNetId>& nets_to_update,
+                            double& bb_delta_c,
+                            double& timing_delta_c);
+
+static e_move_result finalize_swap(float t,
+                                   double delta_c,
+                                   double bb_delta_c,
+                                   double timing_delta_c,
+                                   t_placer_costs* costs,
+                                   const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                   MoveGenerator& move_generator,
+                                   t_pl_blocks_to_be_moved& blocks_affected,
+                                   enum e_place_algorithm place_algorithm,
+                                   const std::vector<ClusterNetId>& nets_to_update);
+
 static void check_place(const t_placer_costs& costs,
                         const PlaceDelayModel* delay_model,
                         enum e_place_algorithm place_algorithm);
@@ -315,6 +372,14 @@ static float starting_t(t_placer_costs* costs,
                         t_pl_blocks_to_be_moved& blocks_affected,
                         const t_placer_opts& placer_opts);
 
+static float trial_moves_starting_t(t_placer_prev_inverse_costs* prev_inverse_costs,
+                                    int move_lim,
+                                    float rlim,
+                                    const PlaceDelayModel* delay_model,
+                                    MoveGenerator& move_generator,
+                                    t_pl_blocks_to_be_moved& blocks_affected,
+                                    const t_placer_opts& placer_opts);
+
 static void update_t(float* t, float rlim, float success_rat, t_annealing_sched annealing_sched);
 
 static void update_rlim(float* rlim, float success_rat, const DeviceGrid& grid);
@@ -331,6 +396,10 @@ static float comp_td_point_to_point_delay(const PlaceDelayModel* delay_model, Cl
 
 static void comp_td_point_to_point_delays(const PlaceDelayModel* delay_model);
 
+static void set_point_to_point_delay(ClusterNetId net_id, int ipin, float delay);
+
+static void update_placement_timing(SetupTimingInfo& timing_info, const ClusteredPinAtomPinsLookup& netlist_pin_lookup);
+
 static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected);
 
 static bool driven_by_moved_block(const ClusterNetId net, const t_pl_blocks_to_be_moved& blocks_affected);
@@ -343,13 +412,14 @@ static void get_non_updateable_bb(ClusterNetId net_id, t_bb* bb_coord_new);
 
 static void update_bb(ClusterNetId net_id, t_bb* bb_coord_new, t_bb* bb_edge_new, int xold, int yold, int xnew, int ynew);
 
-static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
-                                               const t_pl_blocks_to_be_moved& blocks_affected,
-                                               const PlaceDelayModel* delay_model,
-                                               double& bb_delta_c,
-                                               double& timing_delta_c);
+static void find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
+                                                const t_pl_blocks_to_be_moved& blocks_affected,
+                                                const PlaceDelayModel* delay_model,
+                                                std::vector<ClusterNetId>& nets_to_update,
+                                                double& bb_delta_c,
+                                                double& timing_delta_c);
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets);
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update);
 
 static void update_net_bb(const ClusterNetId net,
                           const t_pl_blocks_to_be_moved& blocks_affected,
@@ -392,6 +462,29 @@ static void placement_inner_loop(float t,
                                  t_pl_blocks_to_be_moved& blocks_affected,
                                  SetupTimingInfo& timing_info);
 
+static void parallel_placement_inner_loop(float t,
+                                          float rlim,
+                                          const t_placer_opts& placer_opts,
+                                          int move_lim,
+                                          float crit_exponent,
+                                          int inner_recompute_limit,
+                                          t_placer_statistics* stats,
+                                          t_placer_costs* costs,
+                                          t_placer_prev_inverse_costs* prev_inverse_costs,
+                                          int* moves_since_cost_recompute,
+                                          const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                          const PlaceDelayModel* delay_model,
+                                          MoveGenerator& move_generator,
+                                          t_pl_blocks_to_be_moved& blocks_affected,
+                                          SetupTimingInfo& timing_info);
+
+static bool is_swap_independent(const t_pl_blocks_to_be_moved& blocks_affected,
+                                std::unordered_set<t_pl_loc>& batch_locs,
+                                vtr::vector<ClusterNetId, int>& net_batch_ids,
+                                int batch_id);
+
+static void record_swap_result(e_move_result swap_result, const t_placer_costs& costs, t_placer_statistics* stats);
+
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts, const PlaceDelayModel* delay_model, t_placer_costs* costs);
 
 static void calc_placer_stats(t_placer_statistics& stats, float& success_rat, double& std_dev, const t_placer_costs& costs, const int move_lim);
@@ -485,7 +578,7 @@ void try_place(const t_placer_opts& placer_opts,
     alloc_and_load_placement_structs(placer_opts.place_cost_exp, placer_opts,
                                      directs, num_directs);
 
-    initial_placement(placer_opts.pad_loc_type, placer_opts.pad_loc_file.c_str());
+    initial_placement(placer_opts.pad_loc_type, placer_opts.pad_loc_file.c_str(), placer_opts.initial_placement);
 
     // Update physical pin values
     for (auto block_id : cluster_ctx.clb_nlist.blocks()) {
@@ -518,9 +611,17 @@ void try_place(const t_placer_opts& placer_opts,
         placement_delay_calc = std::make_shared<PlacementDelayCalculator>(atom_ctx.nlist, atom_ctx.lookup, point_to_point_delay);
         placement_delay_calc->set_tsu_margin_relative(placer_opts.tsu_rel_margin);
         placement_delay_calc->set_tsu_margin_absolute(placer_opts.tsu_abs_margin);
-        timing_info = make_setup_timing_info(placement_delay_calc);
+        if (placer_opts.incremental_timing_analysis) {
+            auto& timing_ctx = g_vpr_ctx.timing();
+            incremental_timing_analyzer = std::make_shared<IncrementalSetupTimingAnalyzer>(*timing_ctx.graph, *timing_ctx.constraints, *placement_delay_calc);
+            is_changed_delay_pin.clear();
+            is_changed_delay_pin.resize(cluster_ctx.clb_nlist.pins().size(), false);
+            timing_info = make_setup_timing_info(placement_delay_calc, incremental_timing_analyzer);
+        } else {
+            timing_info = make_setup_timing_info(placement_delay_calc);
+        }
 
-        timing_info->update();
+        update_placement_timing(*timing_info, netlist_pin_lookup);
         timing_info->set_warn_unconstrained(false); //Don't warn again about unconstrained nodes again during placement
 
         //Initial slack estimates
@@ -629,6 +730,7 @@ void try_place(const t_placer_opts& placer_opts,
 
     /* Outer loop of the simmulated annealing begins */
     while (exit_crit(t, costs.cost, annealing_sched) == 0) {
+        VTR_TRACE_SPAN("place temperature " + std::to_string(num_temps));
         if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
             costs.cost = 1;
         }
@@ -760,7 +862,7 @@ void try_place(const t_placer_opts& placer_opts,
         //Final timing estimate
         VTR_ASSERT(timing_info);
 
-        timing_info->update(); //Tatum
+        update_placement_timing(*timing_info, netlist_pin_lookup); //Tatum
         critical_path = timing_info->least_slack_critical_path();
 
         if (isEchoFileEnabled(E_ECHO_FINAL_PLACEMENT_TIMING_GRAPH)) {
@@ -821,6 +923,10 @@ void try_place(const t_placer_opts& placer_opts,
     }
 
     free_try_swap_arrays();
+
+    incremental_timing_analyzer.reset();
+    changed_delay_pins.clear();
+    is_changed_delay_pin.clear();
 }
 
 /* Function to recompute the criticalities before the inner loop of the annealing */
@@ -847,7 +953,7 @@ static void outer_loop_recompute_criticalities(const t_placer_opts& placer_opts,
         VTR_ASSERT(num_connections > 0);
 
         //Per-temperature timing update
-        timing_info.update();
+        update_placement_timing(timing_info, netlist_pin_lookup);
         load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
 
         /*recompute costs from scratch, based on new criticalities */
@@ -887,6 +993,14 @@ static void placement_inner_loop(float t,
     stats->sum_of_squares = 0.;
     stats->success_sum = 0;
 
+    if (placer_opts.parallel_placement) {
+        parallel_placement_inner_loop(t, rlim, placer_opts, move_lim, crit_exponent,
+                                      inner_recompute_limit, stats, costs, prev_inverse_costs,
+                                      moves_since_cost_recompute, netlist_pin_lookup, delay_model,
+                                      move_generator, blocks_affected, timing_info);
+        return;
+    }
+
     inner_crit_iter_count = 1;
 
     /* Inner loop begins */
@@ -899,19 +1013,7 @@ static void placement_inner_loop(float t,
                                              placer_opts.place_algorithm,
                                              placer_opts.timing_tradeoff);
 
-        if (swap_result == ACCEPTED) {
-            /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
-            stats->success_sum++;
-            stats->av_cost += costs->cost;
-            stats->av_bb_cost += costs->bb_cost;
-            stats->av_timing_cost += costs->timing_cost;
-            stats->sum_of_squares += (costs->cost) * (costs->cost);
-            num_swap_accepted++;
-        } else if (swap_result == ABORTED) {
-            num_swap_aborted++;
-        } else { // swap_result == REJECTED
-            num_swap_rejected++;
-        }
+        record_swap_result(swap_result, *costs, stats);
 
         if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
             /* Do we want to re-timing analyze the circuit to get updated slack and criticality values?
@@ -928,7 +1030,7 @@ static void placement_inner_loop(float t,
                  * criticalities; then update the timing cost since it will change.
                  */
                 //Inner loop timing update
-                timing_info.update();
+                update_placement_timing(timing_info, netlist_pin_lookup);
                 load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
 
                 comp_td_costs(delay_model, &costs->timing_cost);
@@ -957,6 +1059,179 @@ static void placement_inner_loop(float t,
     /* Inner loop ends */
 }
 
+/* Inner loop of the simulated annealing, which proposes the moves by batches and   *
+ * evaluates the moves of a batch in parallel. A batch ends before the first move   *
+ * whose locations or nets overlap those of a previous move of the batch, so the    *
+ * moves of a batch do not depend on each other. The move proposals, the           *
+ * acceptance decisions (which use the random number generator) and the commits     *
+ * are done one after another in the order of the proposals, so the placement is   *
+ * reproducible and does not depend on the number of workers.                       *
+ * The criticalities and the costs are only recomputed between batches.            */
+static void parallel_placement_inner_loop(float t,
+                                          float rlim,
+                                          const t_placer_opts& placer_opts,
+                                          int move_lim,
+                                          float crit_exponent,
+                                          int inner_recompute_limit,
+                                          t_placer_statistics* stats,
+                                          t_placer_costs* costs,
+                                          t_placer_prev_inverse_costs* prev_inverse_costs,
+                                          int* moves_since_cost_recompute,
+                                          const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                          const PlaceDelayModel* delay_model,
+                                          MoveGenerator& move_generator,
+                                          t_pl_blocks_to_be_moved& blocks_affected,
+                                          SetupTimingInfo& timing_info) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    size_t num_threads = openfpga::find_num_threads(placer_opts.num_workers);
+
+    std::vector<t_parallel_swap> batch(PARALLEL_PLACE_MAX_BATCH_SIZE, t_parallel_swap(blocks_affected.moved_blocks.size()));
+    for (t_parallel_swap& swap : batch) {
+        swap.nets_to_update.reserve(cluster_ctx.clb_nlist.nets().size());
+    }
+
+    //Locations and nets of the moves of the current batch
+    std::unordered_set<t_pl_loc> batch_locs;
+    vtr::vector<ClusterNetId, int> net_batch_ids(cluster_ctx.clb_nlist.nets().size(), OPEN);
+    int batch_id = 0;
+
+    int moves_since_crit_recompute = 0;
+
+    /* Inner loop begins */
+    int inner_iter = 0;
+    while (inner_iter < move_lim) {
+        batch_locs.clear();
+        ++batch_id;
+
+        /* Propose the moves of the batch. Aborted moves count as moves but are not evaluated */
+        size_t num_swaps = 0;
+        int num_moves = 0;
+        while (num_swaps < batch.size() && inner_iter + num_moves < move_lim) {
+            t_pl_blocks_to_be_moved& swap_blocks = batch[num_swaps].blocks_affected;
+
+            e_create_move create_move_outcome = propose_swap(rlim, placer_opts.rlim_escape_fraction,
+                                                             move_generator, swap_blocks);
+            if (create_move_outcome == e_create_move::ABORT) {
+                record_swap_result(abort_swap(t, move_generator, swap_blocks, "illegal move"), *costs, stats);
+                ++num_moves;
+                continue;
+            }
+            VTR_ASSERT(create_move_outcome == e_create_move::VALID);
+
+            if (!is_swap_independent(swap_blocks, batch_locs, net_batch_ids, batch_id)) {
+                //This move was proposed from the locations before the previous moves of the batch,
+                //which may be committed: it is discarded rather than postponed to the next batch.
+                //Discarded moves are not counted, so that each temperature evaluates move_lim moves.
+                VTR_ASSERT(num_swaps > 0);
+                LOG_MOVE_STATS_PROPOSED(t, swap_blocks);
+                clear_move_blocks(swap_blocks);
+                LOG_MOVE_STATS_OUTCOME(std::numeric_limits<float>::quiet_NaN(),
+                                       std::numeric_limits<float>::quiet_NaN(),
+                                       std::numeric_limits<float>::quiet_NaN(),
+                                       "ABORTED", "dependent parallel move");
+                break;
+            }
+            ++num_swaps;
+            ++num_moves;
+        }
+
+        /* Evaluate the moves of the batch at the same time */
+        openfpga::parallel_for(num_swaps, num_threads, [&](const size_t& iswap) {
+            t_parallel_swap& swap = batch[iswap];
+            swap.bb_delta_c = 0.;
+            swap.timing_delta_c = 0.;
+            swap.delta_c = evaluate_swap(prev_inverse_costs, swap.blocks_affected, delay_model,
+                                         placer_opts.place_algorithm, placer_opts.timing_tradeoff,
+                                         swap.nets_to_update, swap.bb_delta_c, swap.timing_delta_c);
+        });
+
+        /* Accept or reject the moves in the order of their proposals */
+        for (size_t iswap = 0; iswap < num_swaps; ++iswap) {
+            t_parallel_swap& swap = batch[iswap];
+            e_move_result swap_result = finalize_swap(t, swap.delta_c, swap.bb_delta_c, swap.timing_delta_c,
+                                                      costs, prev_inverse_costs, move_generator, swap.blocks_affected,
+                                                      placer_opts.place_algorithm, swap.nets_to_update);
+            record_swap_result(swap_result, *costs, stats);
+        }
+
+        inner_iter += num_moves;
+
+        if (placer_opts.place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+            /* Re-timing analyze the circuit once in a while (see placement_inner_loop())
+             * but not after the last batch */
+            moves_since_crit_recompute += num_moves;
+            if (moves_since_crit_recompute >= inner_recompute_limit && inner_iter < move_lim) {
+                moves_since_crit_recompute = 0;
+
+                update_placement_timing(timing_info, netlist_pin_lookup);
+                load_criticalities(timing_info, crit_exponent, netlist_pin_lookup);
+
+                comp_td_costs(delay_model, &costs->timing_cost);
+            }
+        }
+
+        /* Prevent round-off error from accumulating (see placement_inner_loop()) */
+        *moves_since_cost_recompute += num_moves;
+        if (*moves_since_cost_recompute > MAX_MOVES_BEFORE_RECOMPUTE) {
+            recompute_costs_from_scratch(placer_opts, delay_model, costs);
+            *moves_since_cost_recompute = 0;
+        }
+    }
+    /* Inner loop ends */
+}
+
+//Returns whether the move in blocks_affected neither moves from or to a location,
+//nor changes a net of the previous moves of the batch. If so, records its locations
+//in batch_locs and its nets in net_batch_ids.
+static bool is_swap_independent(const t_pl_blocks_to_be_moved& blocks_affected,
+                                std::unordered_set<t_pl_loc>& batch_locs,
+                                vtr::vector<ClusterNetId, int>& net_batch_ids,
+                                int batch_id) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        const t_pl_moved_block& moved_block = blocks_affected.moved_blocks[iblk];
+        if (batch_locs.count(moved_block.old_loc) || batch_locs.count(moved_block.new_loc)) {
+            return false;
+        }
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(moved_block.block_num)) {
+            ClusterNetId net_id = cluster_ctx.clb_nlist.pin_net(blk_pin);
+            if (!cluster_ctx.clb_nlist.net_is_ignored(net_id) && net_batch_ids[net_id] == batch_id) {
+                return false;
+            }
+        }
+    }
+
+    for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
+        const t_pl_moved_block& moved_block = blocks_affected.moved_blocks[iblk];
+        batch_locs.insert(moved_block.old_loc);
+        batch_locs.insert(moved_block.new_loc);
+        for (ClusterPinId blk_pin : cluster_ctx.clb_nlist.block_pins(moved_block.block_num)) {
+            net_batch_ids[cluster_ctx.clb_nlist.pin_net(blk_pin)] = batch_id;
+        }
+    }
+
+    return true;
+}
+
+//Updates the statistics useful for the annealing schedule with the outcome of a move
+static void record_swap_result(e_move_result swap_result, const t_placer_costs& costs, t_placer_statistics* stats) {
+    if (swap_result == ACCEPTED) {
+        /* Move was accepted.  Update statistics that are useful for the annealing schedule. */
+        stats->success_sum++;
+        stats->av_cost += costs.cost;
+        stats->av_bb_cost += costs.bb_cost;
+        stats->av_timing_cost += costs.timing_cost;
+        stats->sum_of_squares += (costs.cost) * (costs.cost);
+        num_swap_accepted++;
+    } else if (swap_result == ABORTED) {
+        num_swap_aborted++;
+    } else { // swap_result == REJECTED
+        num_swap_rejected++;
+    }
+}
+
 static void recompute_costs_from_scratch(const t_placer_opts& placer_opts, const PlaceDelayModel* delay_model, t_placer_costs* costs) {
     double new_bb_cost = recompute_bb_cost();
     if (fabs(new_bb_cost - costs->bb_cost) > costs->bb_cost * ERROR_TOL) {
@@ -1096,6 +1371,12 @@ static float starting_t(t_placer_costs* costs,
 
     move_lim = min(max_moves, (int)cluster_ctx.clb_nlist.blocks().size());
 
+    if (placer_opts.initial_placement == e_initial_placement::ANALYTIC) {
+        //Accepting all the moves would scramble the analytic placement
+        return trial_moves_starting_t(prev_inverse_costs, move_lim, rlim, delay_model,
+                                      move_generator, blocks_affected, placer_opts);
+    }
+
     num_accepted = 0;
     av = 0.;
     sum_of_squares = 0.;
@@ -1143,11 +1424,63 @@ static float starting_t(t_placer_costs* costs,
     return (20. * std_dev);
 }
 
-static void update_move_nets(int num_nets_affected) {
+//Finds the starting temperature of an initial placement which is already good,
+//from the cost changes of trial moves which are evaluated but never kept.
+//The temperature is the standard deviation of the cost changes, which accepts
+//most of the moves which do not make the placement much worse, so that the
+//anneal refines the initial placement rather than starts it over.
+static float trial_moves_starting_t(t_placer_prev_inverse_costs* prev_inverse_costs,
+                                    int move_lim,
+                                    float rlim,
+                                    const PlaceDelayModel* delay_model,
+                                    MoveGenerator& move_generator,
+                                    t_pl_blocks_to_be_moved& blocks_affected,
+                                    const t_placer_opts& placer_opts) {
+    int num_evaluated = 0;
+    double av = 0.;
+    double sum_of_squares = 0.;
+
+    for (int i = 0; i < move_lim; i++) {
+        e_create_move create_move_outcome = propose_swap(rlim, placer_opts.rlim_escape_fraction, move_generator, blocks_affected);
+        if (create_move_outcome == e_create_move::ABORT) {
+            abort_swap(HUGE_POSITIVE_FLOAT, move_generator, blocks_affected, "illegal move");
+            num_swap_aborted++;
+            continue;
+        }
+
+        double bb_delta_c = 0;
+        double timing_delta_c = 0;
+        double delta_c = evaluate_swap(prev_inverse_costs, blocks_affected, delay_model,
+                                       placer_opts.place_algorithm, placer_opts.timing_tradeoff,
+                                       ts_nets_to_update, bb_delta_c, timing_delta_c);
+
+        //Undo the move
+        reset_move_nets(ts_nets_to_update);
+        revert_move_blocks(blocks_affected);
+        clear_move_blocks(blocks_affected);
+
+        num_evaluated++;
+        av += delta_c;
+        sum_of_squares += delta_c * delta_c;
+        num_swap_rejected++;
+    }
+
+    if (num_evaluated != 0)
+        av /= num_evaluated;
+
+    double std_dev = get_std_dev(num_evaluated, sum_of_squares, av);
+
+#ifdef VERBOSE
+    VTR_LOG("std_dev: %g, average delta cost: %g, starting temp: %g\n", std_dev, av, std_dev);
+#endif
+
+    return std_dev;
+}
+
+static void update_move_nets(const std::vector<ClusterNetId>& nets_to_update) {
     /* update net cost functions and reset flags. */
     auto& cluster_ctx = g_vpr_ctx.clustering();
-    for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+    for (ClusterNetId net_id : nets_to_update) {
 
         bb_coords[net_id] = ts_bb_coord_new[net_id];
         if (cluster_ctx.clb_nlist.net_sinks(net_id).size() >= SMALL_NET)
@@ -1161,10 +1494,9 @@ static void update_move_nets(int num_nets_affected) {
     }
 }
 
-static void reset_move_nets(int num_nets_affected) {
+static void reset_move_nets(const std::vector<ClusterNetId>& nets_to_update) {
     /* Reset the net cost function flags first. */
-    for (int inet_affected = 0; inet_affected < num_nets_affected; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
+    for (ClusterNetId net_id : nets_to_update) {
         temp_net_cost[net_id] = -1;
         bb_updated_before[net_id] = NOT_UPDATED_YET;
     }
@@ -1186,16 +1518,33 @@ static e_move_result try_swap(float t,
      * Returns whether the swap is accepted, rejected or aborted.        *
      * Passes back the new value of the cost functions.                  */
 
-    num_ts_called++;
+    //Generate a new move (perturbation) used to explore the space of possible placements
+    e_create_move create_move_outcome = propose_swap(rlim, rlim_escape_fraction, move_generator, blocks_affected);
 
-    MoveOutcomeStats move_outcome_stats;
+    if (create_move_outcome == e_create_move::ABORT) {
+        //Proposed move is not legal -- give up on this move
+        return abort_swap(t, move_generator, blocks_affected, "illegal move");
+    }
 
-    /* I'm using negative values of temp_net_cost as a flag, so DO NOT   *
-     * use cost functions that can go negative.                          */
+    VTR_ASSERT(create_move_outcome == e_create_move::VALID);
 
-    double delta_c = 0; /* Change in cost due to this swap. */
     double bb_delta_c = 0;
     double timing_delta_c = 0;
+    double delta_c = evaluate_swap(prev_inverse_costs, blocks_affected, delay_model,
+                                   place_algorithm, timing_tradeoff,
+                                   ts_nets_to_update, bb_delta_c, timing_delta_c);
+
+    return finalize_swap(t, delta_c, bb_delta_c, timing_delta_c,
+                         costs, prev_inverse_costs, move_generator, blocks_affected,
+                         place_algorithm, ts_nets_to_update);
+}
+
+//Proposes a new move in blocks_affected, which may not be legal (ABORT)
+static e_create_move propose_swap(float rlim,
+                                  float rlim_escape_fraction,
+                                  MoveGenerator& move_generator,
+                                  t_pl_blocks_to_be_moved& blocks_affected) {
+    num_ts_called++;
 
     //Allow some fraction of moves to not be restricted by rlim,
     //in the hopes of better escaping local minima
@@ -1203,95 +1552,129 @@ static e_move_result try_swap(float t,
         rlim = std::numeric_limits<float>::infinity();
     }
 
-    //Generate a new move (perturbation) used to explore the space of possible placements
-    e_create_move create_move_outcome = move_generator.propose_move(blocks_affected, rlim);
+    return move_generator.propose_move(blocks_affected, rlim);
+}
 
+//Gives up on the move in blocks_affected, which is not evaluated
+static e_move_result abort_swap(float t,
+                                MoveGenerator& move_generator,
+                                t_pl_blocks_to_be_moved& blocks_affected,
+                                const char* reason) {
     LOG_MOVE_STATS_PROPOSED(t, blocks_affected);
 
-    e_move_result move_outcome = ABORTED;
-
-    if (create_move_outcome == e_create_move::ABORT) {
-        //Proposed move is not legal -- give up on this move
-        clear_move_blocks(blocks_affected);
+    clear_move_blocks(blocks_affected);
 
-        LOG_MOVE_STATS_OUTCOME(std::numeric_limits<float>::quiet_NaN(),
-                               std::numeric_limits<float>::quiet_NaN(),
-                               std::numeric_limits<float>::quiet_NaN(),
-                               "ABORTED", "illegal move");
+    LOG_MOVE_STATS_OUTCOME(std::numeric_limits<float>::quiet_NaN(),
+                           std::numeric_limits<float>::quiet_NaN(),
+                           std::numeric_limits<float>::quiet_NaN(),
+                           "ABORTED", reason);
 
-        move_outcome = ABORTED;
-    } else {
-        VTR_ASSERT(create_move_outcome == e_create_move::VALID);
-
-        /*
-         * To make evaluating the move simpler (e.g. calculating changed bounding box),
-         * we first move the blocks to thier new locations (apply the move to
-         * place_ctx.block_locs) and then computed the change in cost. If the move is
-         * accepted, the inverse look-up in place_ctx.grid_blocks is updated (committing
-         * the move). If the move is rejected the blocks are returned to their original
-         * positions (reverting place_ctx.block_locs to its original state).
-         *
-         * Note that the inverse look-up place_ctx.grid_blocks is only updated
-         * after move acceptance is determined, and so should not be used when
-         * evaluating a move.
-         */
+    MoveOutcomeStats move_outcome_stats;
+    move_outcome_stats.outcome = ABORTED;
+    move_generator.process_outcome(move_outcome_stats);
 
-        //Update the block positions
-        apply_move_blocks(blocks_affected);
+    return ABORTED;
+}
 
-        // Find all the nets affected by this swap and update their costs
-        int num_nets_affected = find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, bb_delta_c, timing_delta_c);
-        if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-            /*in this case we redefine delta_c as a combination of timing and bb.  *
-             *additionally, we normalize all values, therefore delta_c is in       *
-             *relation to 1*/
+//Applies the move in blocks_affected to place_ctx.block_locs, and computes the change
+//in the costs. Returns the change in the total cost.
+//
+//Only the moved blocks and the nets recorded in nets_to_update are modified, so that
+//moves with disjoint locations and nets can be evaluated at the same time.
+static double evaluate_swap(const t_placer_prev_inverse_costs* prev_inverse_costs,
+                            const t_pl_blocks_to_be_moved& blocks_affected,
+                            const PlaceDelayModel* delay_model,
+                            enum e_place_algorithm place_algorithm,
+                            float timing_tradeoff,
+                            std::vector<ClusterNetId>& nets_to_update,
+                            double& bb_delta_c,
+                            double& timing_delta_c) {
+    /* I'm using negative values of temp_net_cost as a flag, so DO NOT   *
+     * use cost functions that can go negative.                          */
 
-            delta_c = (1 - timing_tradeoff) * bb_delta_c * prev_inverse_costs->bb_cost
-                      + timing_tradeoff * timing_delta_c * prev_inverse_costs->timing_cost;
-        } else {
-            delta_c = bb_delta_c;
-        }
+    /*
+     * To make evaluating the move simpler (e.g. calculating changed bounding box),
+     * we first move the blocks to thier new locations (apply the move to
+     * place_ctx.block_locs) and then computed the change in cost. If the move is
+     * accepted, the inverse look-up in place_ctx.grid_blocks is updated (committing
+     * the move). If the move is rejected the blocks are returned to their original
+     * positions (reverting place_ctx.block_locs to its original state).
+     *
+     * Note that the inverse look-up place_ctx.grid_blocks is only updated
+     * after move acceptance is determined, and so should not be used when
+     * evaluating a move.
+     */
 
-        /* 1 -> move accepted, 0 -> rejected. */
-        move_outcome = assess_swap(delta_c, t);
+    //Update the block positions
+    apply_move_blocks(blocks_affected);
 
-        if (move_outcome == ACCEPTED) {
-            costs->cost += delta_c;
-            costs->bb_cost += bb_delta_c;
+    // Find all the nets affected by this swap and update their costs
+    find_affected_nets_and_update_costs(place_algorithm, blocks_affected, delay_model, nets_to_update, bb_delta_c, timing_delta_c);
+    if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+        /*in this case we redefine delta_c as a combination of timing and bb.  *
+         *additionally, we normalize all values, therefore delta_c is in       *
+         *relation to 1*/
 
-            if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
-                /*update the point_to_point_timing_cost and point_to_point_delay
-                 * values from the temporary values */
-                costs->timing_cost += timing_delta_c;
+        return (1 - timing_tradeoff) * bb_delta_c * prev_inverse_costs->bb_cost
+               + timing_tradeoff * timing_delta_c * prev_inverse_costs->timing_cost;
+    }
+    return bb_delta_c;
+}
 
-                update_td_cost(blocks_affected);
-            }
+//Accepts or rejects an evaluated move, and commits or reverts it accordingly
+static e_move_result finalize_swap(float t,
+                                   double delta_c,
+                                   double bb_delta_c,
+                                   double timing_delta_c,
+                                   t_placer_costs* costs,
+                                   const t_placer_prev_inverse_costs* prev_inverse_costs,
+                                   MoveGenerator& move_generator,
+                                   t_pl_blocks_to_be_moved& blocks_affected,
+                                   enum e_place_algorithm place_algorithm,
+                                   const std::vector<ClusterNetId>& nets_to_update) {
+    LOG_MOVE_STATS_PROPOSED(t, blocks_affected);
 
-            /* update net cost functions and reset flags. */
-            update_move_nets(num_nets_affected);
+    /* 1 -> move accepted, 0 -> rejected. */
+    e_move_result move_outcome = assess_swap(delta_c, t);
 
-            /* Update clb data structures since we kept the move. */
-            commit_move_blocks(blocks_affected);
+    if (move_outcome == ACCEPTED) {
+        costs->cost += delta_c;
+        costs->bb_cost += bb_delta_c;
 
-        } else { /* Move was rejected.  */
-                 /* Reset the net cost function flags first. */
-            reset_move_nets(num_nets_affected);
+        if (place_algorithm == PATH_TIMING_DRIVEN_PLACE) {
+            /*update the point_to_point_timing_cost and point_to_point_delay
+             * values from the temporary values */
+            costs->timing_cost += timing_delta_c;
 
-            /* Restore the place_ctx.block_locs data structures to their state before the move. */
-            revert_move_blocks(blocks_affected);
+            update_td_cost(blocks_affected);
         }
 
-        move_outcome_stats.delta_cost_norm = delta_c;
-        move_outcome_stats.delta_bb_cost_norm = bb_delta_c * prev_inverse_costs->bb_cost;
-        move_outcome_stats.delta_timing_cost_norm = timing_delta_c * prev_inverse_costs->timing_cost;
+        /* update net cost functions and reset flags. */
+        update_move_nets(nets_to_update);
+
+        /* Update clb data structures since we kept the move. */
+        commit_move_blocks(blocks_affected);
 
-        move_outcome_stats.delta_bb_cost_abs = bb_delta_c;
-        move_outcome_stats.delta_timing_cost_abs = timing_delta_c;
+    } else { /* Move was rejected.  */
+             /* Reset the net cost function flags first. */
+        reset_move_nets(nets_to_update);
 
-        LOG_MOVE_STATS_OUTCOME(delta_c, bb_delta_c, timing_delta_c,
-                               (move_outcome ? "ACCEPTED" : "REJECTED"), "");
+        /* Restore the place_ctx.block_locs data structures to their state before the move. */
+        revert_move_blocks(blocks_affected);
     }
 
+    MoveOutcomeStats move_outcome_stats;
+
+    move_outcome_stats.delta_cost_norm = delta_c;
+    move_outcome_stats.delta_bb_cost_norm = bb_delta_c * prev_inverse_costs->bb_cost;
+    move_outcome_stats.delta_timing_cost_norm = timing_delta_c * prev_inverse_costs->timing_cost;
+
+    move_outcome_stats.delta_bb_cost_abs = bb_delta_c;
+    move_outcome_stats.delta_timing_cost_abs = timing_delta_c;
+
+    LOG_MOVE_STATS_OUTCOME(delta_c, bb_delta_c, timing_delta_c,
+                           (move_outcome ? "ACCEPTED" : "REJECTED"), "");
+
     move_outcome_stats.outcome = move_outcome;
 
     move_generator.process_outcome(move_outcome_stats);
@@ -1309,18 +1692,17 @@ static e_move_result try_swap(float t,
 
 //Puts all the nets changed by the current swap into nets_to_update,
 //and updates their bounding box.
-//
-//Returns the number of affected nets.
-static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
-                                               const t_pl_blocks_to_be_moved& blocks_affected,
-                                               const PlaceDelayModel* delay_model,
-                                               double& bb_delta_c,
-                                               double& timing_delta_c) {
+static void find_affected_nets_and_update_costs(e_place_algorithm place_algorithm,
+                                                const t_pl_blocks_to_be_moved& blocks_affected,
+                                                const PlaceDelayModel* delay_model,
+                                                std::vector<ClusterNetId>& nets_to_update,
+                                                double& bb_delta_c,
+                                                double& timing_delta_c) {
     VTR_ASSERT_SAFE(bb_delta_c == 0.);
     VTR_ASSERT_SAFE(timing_delta_c == 0.);
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
-    int num_affected_nets = 0;
+    nets_to_update.clear();
 
     //Go through all the blocks moved
     for (int iblk = 0; iblk < blocks_affected.num_moved_blocks; iblk++) {
@@ -1335,7 +1717,7 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
                 continue; //TODO: do we require anyting special here for global nets. "Global nets are assumed to span the whole chip, and do not effect costs"
 
             //Record effected nets
-            record_affected_net(net_id, num_affected_nets);
+            record_affected_net(net_id, nets_to_update);
 
             //Update the net bounding boxes
             //
@@ -1353,22 +1735,17 @@ static int find_affected_nets_and_update_costs(e_place_algorithm place_algorithm
     /* Now update the bounding box costs (since the net bounding boxes are up-to-date).
      * The cost is only updated once per net.
      */
-    for (int inet_affected = 0; inet_affected < num_affected_nets; inet_affected++) {
-        ClusterNetId net_id = ts_nets_to_update[inet_affected];
-
+    for (ClusterNetId net_id : nets_to_update) {
         temp_net_cost[net_id] = get_net_cost(net_id, &ts_bb_coord_new[net_id]);
         bb_delta_c += temp_net_cost[net_id] - net_cost[net_id];
     }
-
-    return num_affected_nets;
 }
 
-static void record_affected_net(const ClusterNetId net, int& num_affected_nets) {
+static void record_affected_net(const ClusterNetId net, std::vector<ClusterNetId>& nets_to_update) {
     //Record effected nets
     if (temp_net_cost[net] < 0.) {
         //Net not marked yet.
-        ts_nets_to_update[num_affected_nets] = net;
-        num_affected_nets++;
+        nets_to_update.push_back(net);
 
         //Flag to say we've marked this net.
         temp_net_cost[net] = 1.;
@@ -1537,11 +1914,48 @@ static void comp_td_point_to_point_delays(const PlaceDelayModel* delay_model) {
 
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
         for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ++ipin) {
-            point_to_point_delay[net_id][ipin] = comp_td_point_to_point_delay(delay_model, net_id, ipin);
+            set_point_to_point_delay(net_id, ipin, comp_td_point_to_point_delay(delay_model, net_id, ipin));
         }
     }
 }
 
+//Sets the delay of a connection, recording its sink pin for the next incremental
+//timing analysis if the delay changes
+static void set_point_to_point_delay(ClusterNetId net_id, int ipin, float delay) {
+    if (incremental_timing_analyzer && point_to_point_delay[net_id][ipin] != delay) {
+        ClusterPinId pin_id = g_vpr_ctx.clustering().clb_nlist.net_pin(net_id, ipin);
+        if (!is_changed_delay_pin[pin_id]) {
+            is_changed_delay_pin[pin_id] = true;
+            changed_delay_pins.push_back(pin_id);
+        }
+    }
+    point_to_point_delay[net_id][ipin] = delay;
+}
+
+//Updates the timing analysis after the point_to_point_delay changes. With the
+//incremental analyzer, the timing edges of the connections whose delays changed
+//(the input edges of the atom pins of their sink pins) are invalidated first.
+static void update_placement_timing(SetupTimingInfo& timing_info, const ClusteredPinAtomPinsLookup& netlist_pin_lookup) {
+    if (incremental_timing_analyzer) {
+        auto& atom_ctx = g_vpr_ctx.atom();
+        auto& timing_graph = *g_vpr_ctx.timing().graph;
+
+        for (ClusterPinId pin_id : changed_delay_pins) {
+            for (AtomPinId atom_pin : netlist_pin_lookup.connected_atom_pins(pin_id)) {
+                tatum::NodeId tnode = atom_ctx.lookup.atom_pin_tnode(atom_pin);
+                if (!tnode) continue;
+                for (tatum::EdgeId edge : timing_graph.node_in_edges(tnode)) {
+                    incremental_timing_analyzer->invalidate_edge(edge);
+                }
+            }
+            is_changed_delay_pin[pin_id] = false;
+        }
+    }
+    changed_delay_pins.clear();
+
+    timing_info.update();
+}
+
 /* Update the point_to_point_timing_cost values from the temporary *
  * values for all connections that have changed.                   */
 static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
@@ -1560,7 +1974,7 @@ static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
                 //This net is being driven by a moved block, recompute
                 //all point to point connections on this net.
                 for (size_t ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-                    point_to_point_delay[net_id][ipin] = temp_point_to_point_delay[net_id][ipin];
+                    set_point_to_point_delay(net_id, ipin, temp_point_to_point_delay[net_id][ipin]);
                     temp_point_to_point_delay[net_id][ipin] = INVALID_DELAY;
                     point_to_point_timing_cost[net_id][ipin] = temp_point_to_point_timing_cost[net_id][ipin];
                     temp_point_to_point_timing_cost[net_id][ipin] = INVALID_DELAY;
@@ -1573,7 +1987,7 @@ static void update_td_cost(const t_pl_blocks_to_be_moved& blocks_affected) {
                 if (!driven_by_moved_block(net_id, blocks_affected)) {
                     int net_pin = cluster_ctx.clb_nlist.pin_net_index(pin_id);
 
-                    point_to_point_delay[net_id][net_pin] = temp_point_to_point_delay[net_id][net_pin];
+                    set_point_to_point_delay(net_id, net_pin, temp_point_to_point_delay[net_id][net_pin]);
                     temp_point_to_point_delay[net_id][net_pin] = INVALID_DELAY;
                     point_to_point_timing_cost[net_id][net_pin] = temp_point_to_point_timing_cost[net_id][net_pin];
                     temp_point_to_point_timing_cost[net_id][net_pin] = INVALID_DELAY;
@@ -1614,7 +2028,7 @@ static void comp_td_costs(const PlaceDelayModel* delay_model, double* timing_cos
             float conn_delay = comp_td_point_to_point_delay(delay_model, net_id, ipin);
             float conn_timing_cost = conn_delay * get_timing_place_crit(net_id, ipin);
 
-            point_to_point_delay[net_id][ipin] = conn_delay;
+            set_point_to_point_delay(net_id, ipin, conn_delay);
             temp_point_to_point_delay[net_id][ipin] = INVALID_DELAY;
 
             point_to_point_timing_cost[net_id][ipin] = conn_timing_cost;
@@ -1821,7 +2235,7 @@ static void alloc_and_load_try_swap_structs() {
 
     ts_bb_coord_new.resize(num_nets, t_bb());
     ts_bb_edge_new.resize(num_nets, t_bb());
-    ts_nets_to_update.resize(num_nets, ClusterNetId::INVALID());
+    ts_nets_to_update.reserve(num_nets);
 
     auto& place_ctx = g_vpr_ctx.mutable_placement();
     place_ctx.compressed_block_grids = create_compressed_block_grids();
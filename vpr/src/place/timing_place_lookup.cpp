@@ -149,6 +149,8 @@ std::unique_ptr<PlaceDelayModel> compute_place_delay_model(const t_placer_opts&
         router_opts.lookahead_type,
         router_opts.write_router_lookahead,
         router_opts.read_router_lookahead,
+        router_opts.router_lookahead_cache_file,
+        router_opts.num_workers,
         segment_inf);
     RouterDelayProfiler route_profiler(router_lookahead);
 
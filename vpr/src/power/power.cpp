@@ -47,10 +47,17 @@
 #include "rr_graph.h"
 #include "vpr_utils.h"
 
+#include "openfpga_parallel.h"
+
 /************************* DEFINES **********************************/
 #define CONVERT_NM_PER_M 1000000000
 #define CONVERT_UM_PER_M 1000000
 
+/* Number of items (blocks or routing resources) estimated by a thread at once,
+ * and number of chunks per thread whose logs are kept in memory at once */
+#define POWER_PARALLEL_CHUNK_SIZE 256
+#define POWER_PARALLEL_CHUNKS_PER_THREAD 4
+
 /************************* ENUMS ************************************/
 typedef enum {
     POWER_BREAKDOWN_ENTRY_TYPE_TITLE = 0,
@@ -69,9 +76,15 @@ static vtr::vector<RRNodeId, t_rr_node_power> rr_node_power;
 static void power_usage_routing(t_power_usage* power_usage,
                                 const t_det_routing_arch* routing_arch,
                                 const std::vector<t_segment_inf>& segment_inf);
+static void power_usage_routing_node(t_power_usage* power_usage,
+                                     float* sb_buffer_size,
+                                     float* cb_buffer_size,
+                                     const RRNodeId& rr_node_idx,
+                                     const t_det_routing_arch* routing_arch,
+                                     const std::vector<t_segment_inf>& segment_inf);
 
 /* Tiles */
-static void power_usage_blocks(t_power_usage* power_usage);
+static void power_usage_blocks(t_power_usage* power_usage, size_t num_threads);
 static void power_usage_pb(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node* pb_node, ClusterBlockId iblk);
 static void power_usage_primitive(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node* pb_graph_node, ClusterBlockId iblk);
 static void power_reset_tile_usage();
@@ -114,6 +127,8 @@ void power_uninit_pb_pins_rec(t_pb_graph_node* pb_node);
 void power_pb_pins_init();
 void power_pb_pins_uninit();
 void power_routing_init(const t_det_routing_arch* routing_arch);
+template<typename Func>
+static void power_usage_parallel_for(size_t num_items, size_t num_threads, const Func& estimate_item);
 
 /************************* FUNCTION DEFINITIONS *********************/
 /**
@@ -487,8 +502,8 @@ static void power_usage_pb(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node
                                                 pb_node, iblk);
             power_component_add_usage(&power_usage_bufs_wires,
                                       POWER_COMPONENT_PB_BUFS_WIRE);
-            power_add_usage(&pb_node->pb_type->pb_type_power->power_usage_bufs_wires,
-                            &power_usage_bufs_wires);
+            power_add_shared_usage(&pb_node->pb_type->pb_type_power->power_usage_bufs_wires,
+                                   &power_usage_bufs_wires);
             power_add_usage(power_usage, &power_usage_bufs_wires);
         }
 
@@ -510,8 +525,8 @@ static void power_usage_pb(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node
                                       POWER_COMPONENT_PB_INTERC_MUXES);
 
             // Add to power of this mode
-            power_add_usage(&pb_node->pb_type->modes[pb_mode].mode_power->power_usage,
-                            &power_usage_local_muxes);
+            power_add_shared_usage(&pb_node->pb_type->modes[pb_mode].mode_power->power_usage,
+                                   &power_usage_local_muxes);
         }
 
         /* Add power for children */
@@ -543,12 +558,12 @@ static void power_usage_pb(t_power_usage* power_usage, t_pb* pb, t_pb_graph_node
             power_add_usage(power_usage, &power_usage_children);
 
             // Add to power of this mode
-            power_add_usage(&pb_node->pb_type->modes[pb_mode].mode_power->power_usage,
-                            &power_usage_children);
+            power_add_shared_usage(&pb_node->pb_type->modes[pb_mode].mode_power->power_usage,
+                                   &power_usage_children);
         }
     }
 
-    power_add_usage(&pb_node->pb_type->pb_type_power->power_usage, power_usage);
+    power_add_shared_usage(&pb_node->pb_type->pb_type_power->power_usage, power_usage);
 }
 
 /* Resets the power stats for all physical blocks */
@@ -590,9 +605,55 @@ static void power_reset_tile_usage() {
 }
 
 /*
- * Calcultes the power usage of all tiles in the FPGA
+ * Calls estimate_item for all the items (blocks or routing resources) in the
+ * range [0, num_items), with a number of threads (0 for all the cores).
+ *
+ * The items are estimated by chunks, whose additions to the shared power usages
+ * and messages are recorded in logs (see power_add_shared_usage), and applied in
+ * the order of the items, so that the results are exactly those of a serial
+ * estimation. The multiplexer architectures are all built by power_init, so that
+ * the threads only read them.
  */
-static void power_usage_blocks(t_power_usage* power_usage) {
+template<typename Func>
+static void power_usage_parallel_for(size_t num_items, size_t num_threads, const Func& estimate_item) {
+    size_t num_chunks = (num_items + POWER_PARALLEL_CHUNK_SIZE - 1) / POWER_PARALLEL_CHUNK_SIZE;
+    num_threads = openfpga::find_num_threads(num_threads);
+
+    if (num_threads == 1 || num_chunks <= 1) {
+        for (size_t item = 0; item < num_items; item++) {
+            estimate_item(item);
+        }
+        return;
+    }
+
+    size_t num_batch_chunks = POWER_PARALLEL_CHUNKS_PER_THREAD * num_threads;
+    std::vector<t_power_usage_log> chunk_logs(std::min(num_chunks, num_batch_chunks));
+
+    for (size_t first_chunk = 0; first_chunk < num_chunks; first_chunk += num_batch_chunks) {
+        size_t num_chunks_in_batch = std::min(num_batch_chunks, num_chunks - first_chunk);
+
+        openfpga::parallel_for(num_chunks_in_batch, num_threads, [&](const size_t& ichunk) {
+            size_t begin = (first_chunk + ichunk) * POWER_PARALLEL_CHUNK_SIZE;
+            size_t end = std::min(num_items, begin + POWER_PARALLEL_CHUNK_SIZE);
+
+            power_set_usage_log(&chunk_logs[ichunk]);
+            for (size_t item = begin; item < end; item++) {
+                estimate_item(item);
+            }
+            power_set_usage_log(nullptr);
+        });
+
+        for (size_t ichunk = 0; ichunk < num_chunks_in_batch; ichunk++) {
+            power_apply_usage_log(&chunk_logs[ichunk]);
+        }
+    }
+}
+
+/*
+ * Calcultes the power usage of all tiles in the FPGA,
+ * with a number of threads (0 for all the cores)
+ */
+static void power_usage_blocks(t_power_usage* power_usage, size_t num_threads) {
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
@@ -603,6 +664,14 @@ static void power_usage_blocks(t_power_usage* power_usage) {
 
     t_logical_block_type_ptr logical_block;
 
+    /* The blocks of all the tiles, whose power is estimated in parallel */
+    struct t_power_tile_block {
+        t_pb* pb;
+        t_logical_block_type_ptr logical_block;
+        ClusterBlockId iblk;
+    };
+    std::vector<t_power_tile_block> tile_blocks;
+
     /* Loop through all grid locations */
     for (size_t x = 0; x < device_ctx.grid.width(); x++) {
         for (size_t y = 0; y < device_ctx.grid.height(); y++) {
@@ -616,7 +685,6 @@ static void power_usage_blocks(t_power_usage* power_usage) {
 
             for (int z = 0; z < physical_tile->capacity; z++) {
                 t_pb* pb = nullptr;
-                t_power_usage pb_power;
 
                 ClusterBlockId iblk = place_ctx.grid_blocks[x][y].blocks[z];
 
@@ -627,13 +695,19 @@ static void power_usage_blocks(t_power_usage* power_usage) {
                     logical_block = pick_best_logical_type(physical_tile);
                 }
 
-                /* Calculate power of this CLB */
-                power_usage_pb(&pb_power, pb, logical_block->pb_graph_head, iblk);
-                power_add_usage(power_usage, &pb_power);
+                tile_blocks.push_back({pb, logical_block, iblk});
             }
         }
     }
-    return;
+
+    power_usage_parallel_for(tile_blocks.size(), num_threads, [&](size_t iblock) {
+        const t_power_tile_block& tile_block = tile_blocks[iblock];
+        t_power_usage pb_power;
+
+        /* Calculate power of this CLB */
+        power_usage_pb(&pb_power, tile_block.pb, tile_block.logical_block->pb_graph_head, tile_block.iblk);
+        power_add_shared_usage(power_usage, &pb_power);
+    });
 }
 
 /**
@@ -855,174 +929,205 @@ static void power_usage_routing(t_power_usage* power_usage,
         }
     }
 
-    /* Calculate power of all routing entities */
-    for (const RRNodeId& rr_node_idx : device_ctx.rr_graph.nodes()) {
-        t_power_usage sub_power_usage;
-        const RRGraph& rr_graph = device_ctx.rr_graph;
-        t_rr_node_power* node_power = &rr_node_power[rr_node_idx];
-        float C_wire;
-        float buffer_size;
-        int connectionbox_fanout;
-        int switchbox_fanout;
-        //float C_per_seg_split;
-        int wire_length;
+    /* Calculate power of all routing entities, in parallel. The sizes of the
+     * buffers of the switch and connection boxes are summed in order afterwards */
+    std::vector<RRNodeId> rr_nodes(device_ctx.rr_graph.nodes().begin(), device_ctx.rr_graph.nodes().end());
+    std::vector<float> sb_buffer_sizes(rr_nodes.size(), -1.);
+    std::vector<float> cb_buffer_sizes(rr_nodes.size(), -1.);
+
+    power_usage_parallel_for(rr_nodes.size(), routing_arch->num_workers, [&](size_t inode) {
+        power_usage_routing_node(power_usage, &sb_buffer_sizes[inode], &cb_buffer_sizes[inode],
+                                 rr_nodes[inode], routing_arch, segment_inf);
+    });
+
+    for (size_t inode = 0; inode < rr_nodes.size(); inode++) {
+        if (sb_buffer_sizes[inode] >= 0.) {
+            power_ctx.commonly_used->num_sb_buffers++;
+            power_ctx.commonly_used->total_sb_buffer_size += sb_buffer_sizes[inode];
+        }
+        if (cb_buffer_sizes[inode] >= 0.) {
+            power_ctx.commonly_used->num_cb_buffers++;
+            power_ctx.commonly_used->total_cb_buffer_size += cb_buffer_sizes[inode];
+        }
+    }
+}
 
-        switch (rr_graph.node_type(rr_node_idx)) {
-            case SOURCE:
-            case SINK:
-            case OPIN:
-                /* No power usage for these types */
-                break;
-            case IPIN:
-                /* This is part of the connectionbox.  The connection box is comprised of:
-                 *  - Driver (accounted for at end of CHANX/Y - see below)
-                 *  - Multiplexor */
+/*
+ * Calculates the power usage of a routing resource, and adds it to power_usage
+ * - sb_buffer_size, cb_buffer_size: (Return values) The sizes of the switch box
+ *   and connection box buffers of the resource, if any (unchanged otherwise)
+ */
+static void power_usage_routing_node(t_power_usage* power_usage,
+                                     float* sb_buffer_size,
+                                     float* cb_buffer_size,
+                                     const RRNodeId& rr_node_idx,
+                                     const t_det_routing_arch* routing_arch,
+                                     const std::vector<t_segment_inf>& segment_inf) {
+    auto& power_ctx = g_vpr_ctx.power();
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+    t_power_usage sub_power_usage;
+    t_rr_node_power* node_power = &rr_node_power[rr_node_idx];
+    float C_wire;
+    float buffer_size;
+    int connectionbox_fanout;
+    int switchbox_fanout;
+    //float C_per_seg_split;
+    int wire_length;
+
+    switch (rr_graph.node_type(rr_node_idx)) {
+        case SOURCE:
+        case SINK:
+        case OPIN:
+            /* No power usage for these types */
+            break;
+        case IPIN:
+            /* This is part of the connectionbox.  The connection box is comprised of:
+             *  - Driver (accounted for at end of CHANX/Y - see below)
+             *  - Multiplexor */
 
-                if (rr_graph.node_in_edges(rr_node_idx).size()) {
-                    VTR_ASSERT(node_power->in_dens);
-                    VTR_ASSERT(node_power->in_prob);
-
-                    /* Multiplexor */
-                    power_usage_mux_multilevel(&sub_power_usage,
-                                               power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
-                                                                  power_ctx.arch->mux_transistor_size),
-                                               node_power->in_prob, node_power->in_dens,
-                                               node_power->selected_input, true,
-                                               power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
-                }
-                break;
-            case CHANX:
-            case CHANY:
-                /* This is a wire driven by a switchbox, which includes:
-                 * 	- The Multiplexor at the beginning of the wire
-                 * 	- A buffer, after the mux to drive the wire
-                 * 	- The wire itself
-                 * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+            if (rr_graph.node_in_edges(rr_node_idx).size()) {
                 VTR_ASSERT(node_power->in_dens);
                 VTR_ASSERT(node_power->in_prob);
 
-                wire_length = 0;
-                if (rr_graph.node_type(rr_node_idx) == CHANX) {
-                    wire_length = rr_graph.node_xhigh(rr_node_idx) - rr_graph.node_xlow(rr_node_idx) + 1;
-                } else if (rr_graph.node_type(rr_node_idx) == CHANY) {
-                    wire_length = rr_graph.node_yhigh(rr_node_idx) - rr_graph.node_ylow(rr_node_idx) + 1;
-                }
-                C_wire = wire_length
-                         * segment_inf[device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_node_idx)].seg_index].Cmetal;
-                //(double)power_ctx.commonly_used->tile_length);
-                VTR_ASSERT(node_power->selected_input < rr_graph.node_in_edges(rr_node_idx).size());
-
                 /* Multiplexor */
                 power_usage_mux_multilevel(&sub_power_usage,
                                            power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
                                                               power_ctx.arch->mux_transistor_size),
                                            node_power->in_prob, node_power->in_dens,
-                                           node_power->selected_input, true, power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
+                                           node_power->selected_input, true,
+                                           power_ctx.solution_inf.T_crit);
+                power_add_shared_usage(power_usage, &sub_power_usage);
                 power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_SB);
+                                          POWER_COMPONENT_ROUTE_CB);
+            }
+            break;
+        case CHANX:
+        case CHANY:
+            /* This is a wire driven by a switchbox, which includes:
+             * 	- The Multiplexor at the beginning of the wire
+             * 	- A buffer, after the mux to drive the wire
+             * 	- The wire itself
+             * 	- A buffer at the end of the wire, going to switchbox/connectionbox */
+            VTR_ASSERT(node_power->in_dens);
+            VTR_ASSERT(node_power->in_prob);
+
+            wire_length = 0;
+            if (rr_graph.node_type(rr_node_idx) == CHANX) {
+                wire_length = rr_graph.node_xhigh(rr_node_idx) - rr_graph.node_xlow(rr_node_idx) + 1;
+            } else if (rr_graph.node_type(rr_node_idx) == CHANY) {
+                wire_length = rr_graph.node_yhigh(rr_node_idx) - rr_graph.node_ylow(rr_node_idx) + 1;
+            }
+            C_wire = wire_length
+                     * segment_inf[device_ctx.rr_indexed_data[rr_graph.node_cost_index(rr_node_idx)].seg_index].Cmetal;
+            //(double)power_ctx.commonly_used->tile_length);
+            VTR_ASSERT(node_power->selected_input < rr_graph.node_in_edges(rr_node_idx).size());
+
+            /* Multiplexor */
+            power_usage_mux_multilevel(&sub_power_usage,
+                                       power_get_mux_arch(rr_graph.node_in_edges(rr_node_idx).size(),
+                                                          power_ctx.arch->mux_transistor_size),
+                                       node_power->in_prob, node_power->in_dens,
+                                       node_power->selected_input, true, power_ctx.solution_inf.T_crit);
+            power_add_shared_usage(power_usage, &sub_power_usage);
+            power_component_add_usage(&sub_power_usage,
+                                      POWER_COMPONENT_ROUTE_SB);
+
+            /* Buffer Size */
+            switch (device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_type) {
+                case POWER_BUFFER_TYPE_AUTO:
+                    /*
+                     * C_per_seg_split = ((float) node->num_edges
+                     * power_ctx.commonly_used->INV_1X_C_in + C_wire);
+                     * // / (float) power_ctx.arch->seg_buffer_split;
+                     * buffer_size = power_buffer_size_from_logical_effort(
+                     * C_per_seg_split);
+                     * buffer_size = std::max(buffer_size, 1.0F);
+                     */
+                    buffer_size = power_calc_buffer_size_from_Cout(device_ctx.rr_switch_inf[node_power->driver_switch_type].Cout);
+                    break;
+                case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
+                    buffer_size = device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_size;
+                    buffer_size = std::max(buffer_size, 1.0F);
+                    break;
+                case POWER_BUFFER_TYPE_NONE:
+                    buffer_size = 0.;
+                    break;
+                default:
+                    buffer_size = 0.;
+                    VTR_ASSERT(0);
+                    break;
+            }
 
-                /* Buffer Size */
-                switch (device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_type) {
-                    case POWER_BUFFER_TYPE_AUTO:
-                        /*
-                         * C_per_seg_split = ((float) node->num_edges
-                         * power_ctx.commonly_used->INV_1X_C_in + C_wire);
-                         * // / (float) power_ctx.arch->seg_buffer_split;
-                         * buffer_size = power_buffer_size_from_logical_effort(
-                         * C_per_seg_split);
-                         * buffer_size = std::max(buffer_size, 1.0F);
-                         */
-                        buffer_size = power_calc_buffer_size_from_Cout(device_ctx.rr_switch_inf[node_power->driver_switch_type].Cout);
-                        break;
-                    case POWER_BUFFER_TYPE_ABSOLUTE_SIZE:
-                        buffer_size = device_ctx.rr_switch_inf[node_power->driver_switch_type].power_buffer_size;
-                        buffer_size = std::max(buffer_size, 1.0F);
-                        break;
-                    case POWER_BUFFER_TYPE_NONE:
-                        buffer_size = 0.;
-                        break;
-                    default:
-                        buffer_size = 0.;
-                        VTR_ASSERT(0);
-                        break;
-                }
+            *sb_buffer_size = buffer_size;
 
-                power_ctx.commonly_used->num_sb_buffers++;
-                power_ctx.commonly_used->total_sb_buffer_size += buffer_size;
+            /*
+             * power_ctx.commonly_used->num_sb_buffers +=
+             * power_ctx.arch->seg_buffer_split;
+             * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
+             * power_ctx.arch->seg_buffer_split;
+             */
 
-                /*
-                 * power_ctx.commonly_used->num_sb_buffers +=
-                 * power_ctx.arch->seg_buffer_split;
-                 * power_ctx.commonly_used->total_sb_buffer_size += buffer_size
-                 * power_ctx.arch->seg_buffer_split;
-                 */
+            /* Buffer */
+            power_usage_buffer(&sub_power_usage, buffer_size,
+                               node_power->in_prob[node_power->selected_input],
+                               node_power->in_dens[node_power->selected_input], true,
+                               power_ctx.solution_inf.T_crit);
+            power_add_shared_usage(power_usage, &sub_power_usage);
+            power_component_add_usage(&sub_power_usage,
+                                      POWER_COMPONENT_ROUTE_SB);
+
+            /* Wire Capacitance */
+            power_usage_wire(&sub_power_usage, C_wire,
+                             clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
+            power_add_shared_usage(power_usage, &sub_power_usage);
+            power_component_add_usage(&sub_power_usage,
+                                      POWER_COMPONENT_ROUTE_GLB_WIRE);
+
+            /* Determine types of switches that this wire drives */
+            connectionbox_fanout = 0;
+            switchbox_fanout = 0;
+            for (const RREdgeId& iedge : rr_graph.node_out_edges(rr_node_idx)) {
+                if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->wire_to_rr_ipin_switch) {
+                    connectionbox_fanout++;
+                } else if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->delayless_switch) {
+                    /* Do nothing */
+                } else {
+                    switchbox_fanout++;
+                }
+            }
 
-                /* Buffer */
+            /* Buffer to next Switchbox */
+            if (switchbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
                 power_usage_buffer(&sub_power_usage, buffer_size,
-                                   node_power->in_prob[node_power->selected_input],
-                                   node_power->in_dens[node_power->selected_input], true,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input], false,
                                    power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
+                power_add_shared_usage(power_usage, &sub_power_usage);
                 power_component_add_usage(&sub_power_usage,
                                           POWER_COMPONENT_ROUTE_SB);
+            }
 
-                /* Wire Capacitance */
-                power_usage_wire(&sub_power_usage, C_wire,
-                                 clb_net_density(node_power->net_num), power_ctx.solution_inf.T_crit);
-                power_add_usage(power_usage, &sub_power_usage);
-                power_component_add_usage(&sub_power_usage,
-                                          POWER_COMPONENT_ROUTE_GLB_WIRE);
-
-                /* Determine types of switches that this wire drives */
-                connectionbox_fanout = 0;
-                switchbox_fanout = 0;
-                for (const RREdgeId& iedge : rr_graph.node_out_edges(rr_node_idx)) {
-                    if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->wire_to_rr_ipin_switch) {
-                        connectionbox_fanout++;
-                    } else if ((short)size_t(rr_graph.edge_switch(iedge)) == routing_arch->delayless_switch) {
-                        /* Do nothing */
-                    } else {
-                        switchbox_fanout++;
-                    }
-                }
-
-                /* Buffer to next Switchbox */
-                if (switchbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(switchbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input], false,
-                                       power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_SB);
-                }
-
-                /* Driver for ConnectionBox */
-                if (connectionbox_fanout) {
-                    buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
+            /* Driver for ConnectionBox */
+            if (connectionbox_fanout) {
+                buffer_size = power_buffer_size_from_logical_effort(connectionbox_fanout * power_ctx.commonly_used->NMOS_1X_C_d);
 
-                    power_usage_buffer(&sub_power_usage, buffer_size,
-                                       1 - node_power->in_prob[node_power->selected_input],
-                                       node_power->in_dens[node_power->selected_input],
-                                       false, power_ctx.solution_inf.T_crit);
-                    power_add_usage(power_usage, &sub_power_usage);
-                    power_component_add_usage(&sub_power_usage,
-                                              POWER_COMPONENT_ROUTE_CB);
+                power_usage_buffer(&sub_power_usage, buffer_size,
+                                   1 - node_power->in_prob[node_power->selected_input],
+                                   node_power->in_dens[node_power->selected_input],
+                                   false, power_ctx.solution_inf.T_crit);
+                power_add_shared_usage(power_usage, &sub_power_usage);
+                power_component_add_usage(&sub_power_usage,
+                                          POWER_COMPONENT_ROUTE_CB);
 
-                    power_ctx.commonly_used->num_cb_buffers++;
-                    power_ctx.commonly_used->total_cb_buffer_size += buffer_size;
-                }
-                break;
-            default:
-                power_log_msg(POWER_LOG_WARNING,
-                              "The global routing-resource graph contains an unknown node type.");
-                break;
-        }
+                *cb_buffer_size = buffer_size;
+            }
+            break;
+        default:
+            power_log_msg(POWER_LOG_WARNING,
+                          "The global routing-resource graph contains an unknown node type.");
+            break;
     }
 }
 
@@ -1739,7 +1844,7 @@ e_power_ret_code power_total(float* run_time_s, const t_vpr_setup& vpr_setup, co
     power_component_add_usage(&sub_power_usage, POWER_COMPONENT_CLOCK);
 
     /* CLBs */
-    power_usage_blocks(&clb_power_usage);
+    power_usage_blocks(&clb_power_usage, routing_arch->num_workers);
     power_add_usage(&total_power, &clb_power_usage);
     power_component_add_usage(&clb_power_usage, POWER_COMPONENT_PB);
 
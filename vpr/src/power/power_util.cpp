@@ -34,6 +34,9 @@
 
 /************************* GLOBALS **********************************/
 
+/* The log of the calling thread, if any (see power_set_usage_log) */
+static thread_local t_power_usage_log* f_power_usage_log = nullptr;
+
 /************************* FUNCTION DECLARATIONS*********************/
 static void log_msg(t_log* log_ptr, const char* msg);
 static void init_mux_arch_default(t_mux_arch* mux_arch, int levels, int num_inputs, float transistor_size);
@@ -54,6 +57,44 @@ void power_add_usage(t_power_usage* dest, const t_power_usage* src) {
     dest->leakage += src->leakage;
 }
 
+/**
+ * Adds a power usage to a power usage which may be shared by the threads
+ * estimating the power of different parts of the FPGA.
+ * If the calling thread has a log, the addition is recorded in it instead.
+ */
+void power_add_shared_usage(t_power_usage* dest, const t_power_usage* src) {
+    if (f_power_usage_log) {
+        f_power_usage_log->additions.emplace_back(dest, *src);
+    } else {
+        power_add_usage(dest, src);
+    }
+}
+
+/**
+ * Sets the log of the shared power usage additions and of the messages of
+ * the calling thread (nullptr to apply them directly)
+ */
+void power_set_usage_log(t_power_usage_log* usage_log) {
+    f_power_usage_log = usage_log;
+}
+
+/**
+ * Applies the additions and the messages recorded by a log, in the order they
+ * were recorded, and clears it
+ */
+void power_apply_usage_log(t_power_usage_log* usage_log) {
+    VTR_ASSERT(usage_log != f_power_usage_log);
+
+    for (const auto& addition : usage_log->additions) {
+        power_add_usage(addition.first, &addition.second);
+    }
+    for (const auto& message : usage_log->messages) {
+        power_log_msg(message.first, message.second.c_str());
+    }
+    usage_log->additions.clear();
+    usage_log->messages.clear();
+}
+
 void power_scale_usage(t_power_usage* power_usage, float scale_factor) {
     power_usage->dynamic *= scale_factor;
     power_usage->leakage *= scale_factor;
@@ -68,6 +109,11 @@ float power_perc_dynamic(t_power_usage* power_usage) {
 }
 
 void power_log_msg(e_power_log_type log_type, const char* msg) {
+    if (f_power_usage_log) {
+        f_power_usage_log->messages.emplace_back(log_type, msg);
+        return;
+    }
+
     auto& power_ctx = g_vpr_ctx.power();
     log_msg(&power_ctx.output->logs[log_type], msg);
 }
@@ -23,11 +23,26 @@
 #define __POWER_UTIL_H__
 
 /************************* INCLUDES *********************************/
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "power.h"
 #include "power_components.h"
 #include "atom_netlist.h"
 #include "clustered_netlist.h"
 
+/************************* STRUCTS **********************************/
+
+/* The additions to the power usages shared by the whole FPGA (e.g., of the
+ * components or of the pb types) and the messages, recorded by a thread which
+ * estimates the power of a part of the FPGA, to be applied later in a
+ * deterministic order (see power_set_usage_log) */
+struct t_power_usage_log {
+    std::vector<std::pair<t_power_usage*, t_power_usage>> additions;
+    std::vector<std::pair<e_power_log_type, std::string>> messages;
+};
+
 /************************* FUNCTION DECLARATIONS ********************/
 
 /* Pins */
@@ -41,6 +56,9 @@ void pb_foreach_pin(t_pb_graph_node* pb_node,
 /* Power Usage */
 void power_zero_usage(t_power_usage* power_usage);
 void power_add_usage(t_power_usage* dest, const t_power_usage* src);
+void power_add_shared_usage(t_power_usage* dest, const t_power_usage* src);
+void power_set_usage_log(t_power_usage_log* usage_log);
+void power_apply_usage_log(t_power_usage_log* usage_log);
 void power_scale_usage(t_power_usage* power_usage, float scale_factor);
 float power_sum_usage(t_power_usage* power_usage);
 float power_perc_dynamic(t_power_usage* power_usage);
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <unordered_set>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -15,44 +16,38 @@
 #include "read_xml_arch_file.h"
 #include "route_tree_type.h"
 #include "route_tree_timing.h"
+#include "parallel_check.h"
 
 /******************** Subroutines local to this module **********************/
 static void check_node_and_range(const RRNodeId& inode, enum e_route_type route_type);
 static void check_source(const RRNodeId& inode, ClusterNetId net_id);
-static void check_sink(const RRNodeId& inode, ClusterNetId net_id, bool* pin_done);
+static void check_sink(const RRNodeId& inode, ClusterNetId net_id, std::vector<bool>& pin_done);
 static void check_switch(t_trace* tptr, int num_switch);
 static bool check_adjacent(const RRNodeId& from_node, const RRNodeId& to_node);
 static int chanx_chany_adjacent(const RRNodeId& chanx_node, const RRNodeId& chany_node);
-static void reset_flags(ClusterNetId inet, vtr::vector<RRNodeId, bool>& connected_to_route);
 static void check_locally_used_clb_opins(const t_clb_opins_used& clb_opins_used_locally,
                                          enum e_route_type route_type);
 
 static bool check_non_configurable_edges(ClusterNetId net, const t_non_configurable_rr_sets& non_configurable_rr_sets);
 static void check_net_for_stubs(ClusterNetId net);
+static void check_net_route(ClusterNetId net_id,
+                            enum e_route_type route_type,
+                            const t_non_configurable_rr_sets& non_configurable_rr_sets);
 
 /************************ Subroutine definitions ****************************/
 
-void check_route(enum e_route_type route_type) {
+void check_route(enum e_route_type route_type, e_check_level check_level) {
     /* This routine checks that a routing:  (1) Describes a properly         *
      * connected path for each net, (2) this path connects all the           *
      * pins spanned by that net, and (3) that no routing resources are       *
      * oversubscribed (the occupancy of everything is recomputed from        *
      * scratch).                                                             */
 
-    int max_pins;
-    RRNodeId inode, prev_node;
-    unsigned int ipin;
-    bool valid, connects;
-    vtr::vector<RRNodeId, bool> connected_to_route; /* [0 .. device_ctx.rr_nodes.size()-1] */
-    t_trace* tptr;
-    bool* pin_done;
+    bool valid;
 
-    auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& route_ctx = g_vpr_ctx.routing();
 
-    const int num_switches = device_ctx.rr_switch_inf.size();
-
     VTR_LOG("\n");
     VTR_LOG("Checking to ensure routing is legal...\n");
 
@@ -71,109 +66,121 @@ void check_route(enum e_route_type route_type) {
 
     auto non_configurable_rr_sets = identify_non_configurable_rr_sets();
 
-    connected_to_route.resize(device_ctx.rr_graph.nodes().size(), false);
+    /* Now check that all nets are indeed connected. The nets only read the  *
+     * routing and are checked in parallel, the error of the net with the    *
+     * lowest id is reported.                                                */
+    std::vector<ClusterNetId> nets(cluster_ctx.clb_nlist.nets().begin(), cluster_ctx.clb_nlist.nets().end());
+    parallel_check(nets.size(), check_level, [&](size_t inet) {
+        check_net_route(nets[inet], route_type, non_configurable_rr_sets);
+    });
 
-    max_pins = 0;
-    for (auto net_id : cluster_ctx.clb_nlist.nets())
-        max_pins = std::max(max_pins, (int)cluster_ctx.clb_nlist.net_pins(net_id).size());
-
-    pin_done = (bool*)vtr::malloc(max_pins * sizeof(bool));
+    if (check_level == e_check_level::SAMPLED) {
+        VTR_LOG("Checked one net out of %zu.\n", CHECK_SAMPLE_STRIDE);
+    }
+    VTR_LOG("Completed routing consistency check successfully.\n");
+    VTR_LOG("\n");
+}
 
-    /* Now check that all nets are indeed connected. */
-    for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || cluster_ctx.clb_nlist.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
-            continue;
+/* Checks that the routing of a net is a connected path from its SOURCE to  *
+ * all its SINKs.                                                           */
+static void check_net_route(ClusterNetId net_id,
+                            enum e_route_type route_type,
+                            const t_non_configurable_rr_sets& non_configurable_rr_sets) {
+    RRNodeId inode, prev_node;
+    bool connects;
+    std::unordered_set<RRNodeId> connected_to_route; /* Nodes already in the path of the net */
+    t_trace* tptr;
 
-        for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++)
-            pin_done[ipin] = false;
+    auto& device_ctx = g_vpr_ctx.device();
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
 
-        /* Check the SOURCE of the net. */
-        tptr = route_ctx.trace[net_id].head;
-        if (tptr == nullptr) {
-            VPR_ERROR(VPR_ERROR_ROUTE,
-                      "in check_route: net %d has no routing.\n", size_t(net_id));
-        }
+    const int num_switches = device_ctx.rr_switch_inf.size();
 
-        inode = tptr->index;
-        check_node_and_range(inode, route_type);
-        check_switch(tptr, num_switches);
-        connected_to_route[inode] = true; /* Mark as in path. */
+    if (cluster_ctx.clb_nlist.net_is_ignored(net_id) || cluster_ctx.clb_nlist.net_sinks(net_id).size() == 0) /* Skip ignored nets. */
+        return;
 
-        check_source(inode, net_id);
-        pin_done[0] = true;
+    std::vector<bool> pin_done(cluster_ctx.clb_nlist.net_pins(net_id).size(), false);
 
-        prev_node = inode;
-        int prev_switch = tptr->iswitch;
-        tptr = tptr->next;
+    /* Check the SOURCE of the net. */
+    tptr = route_ctx.trace[net_id].head;
+    if (tptr == nullptr) {
+        VPR_ERROR(VPR_ERROR_ROUTE,
+                  "in check_route: net %d has no routing.\n", size_t(net_id));
+        return;
+    }
 
-        /* Check the rest of the net */
-        size_t num_sinks = 0;
-        while (tptr != nullptr) {
-            inode = tptr->index;
-            check_node_and_range(inode, route_type);
-            check_switch(tptr, num_switches);
+    inode = tptr->index;
+    check_node_and_range(inode, route_type);
+    check_switch(tptr, num_switches);
+    connected_to_route.insert(inode); /* Mark as in path. */
 
-            if (prev_switch == OPEN) { //Start of a new branch
-                if (connected_to_route[inode] == false) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: node %d does not link into existing routing for net %d.\n", size_t(inode), size_t(net_id));
-                }
-            } else { //Continuing along existing branch
-                connects = check_adjacent(prev_node, inode);
-                if (!connects) {
-                    VPR_ERROR(VPR_ERROR_ROUTE,
-                              "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
-                              "  %s\n"
-                              "  %s\n",
-                              size_t(net_id),
-                              describe_rr_node(prev_node).c_str(),
-                              describe_rr_node(inode).c_str());
-                }
+    check_source(inode, net_id);
+    pin_done[0] = true;
 
-                connected_to_route[inode] = true; /* Mark as in path. */
+    prev_node = inode;
+    int prev_switch = tptr->iswitch;
+    tptr = tptr->next;
 
-                if (device_ctx.rr_graph.node_type(inode) == SINK) {
-                    check_sink(inode, net_id, pin_done);
-                    num_sinks += 1;
-                }
+    /* Check the rest of the net */
+    size_t num_sinks = 0;
+    while (tptr != nullptr) {
+        inode = tptr->index;
+        check_node_and_range(inode, route_type);
+        check_switch(tptr, num_switches);
 
-            } /* End of prev_node type != SINK */
-            prev_node = inode;
-            prev_switch = tptr->iswitch;
-            tptr = tptr->next;
-        } /* End while */
+        if (prev_switch == OPEN) { //Start of a new branch
+            if (connected_to_route.count(inode) == 0) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: node %d does not link into existing routing for net %d.\n", size_t(inode), size_t(net_id));
+            }
+        } else { //Continuing along existing branch
+            connects = check_adjacent(prev_node, inode);
+            if (!connects) {
+                VPR_ERROR(VPR_ERROR_ROUTE,
+                          "in check_route: found non-adjacent segments in traceback while checking net %d:\n"
+                          "  %s\n"
+                          "  %s\n",
+                          size_t(net_id),
+                          describe_rr_node(prev_node).c_str(),
+                          describe_rr_node(inode).c_str());
+            }
 
-        if (num_sinks != cluster_ctx.clb_nlist.net_sinks(net_id).size()) {
-            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                            "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
-                            size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str(),
-                            num_sinks, cluster_ctx.clb_nlist.net_sinks(net_id).size());
-        }
+            connected_to_route.insert(inode); /* Mark as in path. */
 
-        for (ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
-            if (pin_done[ipin] == false) {
-                VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
-                                "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+            if (device_ctx.rr_graph.node_type(inode) == SINK) {
+                check_sink(inode, net_id, pin_done);
+                num_sinks += 1;
             }
-        }
 
-        check_non_configurable_edges(net_id, non_configurable_rr_sets);
+        } /* End of prev_node type != SINK */
+        prev_node = inode;
+        prev_switch = tptr->iswitch;
+        tptr = tptr->next;
+    } /* End while */
 
-        check_net_for_stubs(net_id);
+    if (num_sinks != cluster_ctx.clb_nlist.net_sinks(net_id).size()) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                        "in check_route: net %zu (%s) has %zu SINKs (expected %zu).\n",
+                        size_t(net_id), cluster_ctx.clb_nlist.net_name(net_id).c_str(),
+                        num_sinks, cluster_ctx.clb_nlist.net_sinks(net_id).size());
+    }
 
-        reset_flags(net_id, connected_to_route);
+    for (unsigned int ipin = 0; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ipin++) {
+        if (pin_done[ipin] == false) {
+            VPR_FATAL_ERROR(VPR_ERROR_ROUTE,
+                            "in check_route: net %zu does not connect to pin %d.\n", size_t(net_id), ipin);
+        }
+    }
 
-    } /* End for each net */
+    check_non_configurable_edges(net_id, non_configurable_rr_sets);
 
-    free(pin_done);
-    connected_to_route.clear();
-    VTR_LOG("Completed routing consistency check successfully.\n");
-    VTR_LOG("\n");
+    check_net_for_stubs(net_id);
 }
 
 /* Checks that this SINK node is one of the terminals of inet, and marks   *
  * the appropriate pin as being reached.                                   */
-static void check_sink(const RRNodeId& inode, ClusterNetId net_id, bool* pin_done) {
+static void check_sink(const RRNodeId& inode, ClusterNetId net_id, std::vector<bool>& pin_done) {
     auto& device_ctx = g_vpr_ctx.device();
     auto& cluster_ctx = g_vpr_ctx.clustering();
     auto& place_ctx = g_vpr_ctx.placement();
@@ -289,26 +296,6 @@ static void check_switch(t_trace* tptr, int num_switch) {
     }
 }
 
-static void reset_flags(ClusterNetId inet, vtr::vector<RRNodeId, bool>& connected_to_route) {
-    /* This routine resets the flags of all the channel segments contained *
-     * in the traceback of net inet to 0.  This allows us to check the     *
-     * next net for connectivity (and the default state of the flags       *
-     * should always be zero after they have been used).                   */
-
-    t_trace* tptr;
-    RRNodeId inode;
-
-    auto& route_ctx = g_vpr_ctx.routing();
-
-    tptr = route_ctx.trace[inet].head;
-
-    while (tptr != nullptr) {
-        inode = tptr->index;
-        connected_to_route[inode] = false; /* Not in routed path now. */
-        tptr = tptr->next;
-    }
-}
-
 static bool check_adjacent(const RRNodeId& from_node, const RRNodeId& to_node) {
     /* This routine checks if the rr_node to_node is reachable from from_node.   *
      * It returns true if is reachable and false if it is not.  Check_node has   *
@@ -828,10 +815,18 @@ void check_net_for_stubs(ClusterNetId net) {
 bool StubFinder::CheckNet(ClusterNetId net) {
     stub_nodes_.clear();
 
+    //The nets may be checked by worker threads, so the route tree is built
+    //on its own free lists, which are released afterwards
+    t_route_tree_storage storage;
+    swap_thread_route_tree_storage(storage);
+
     t_rt_node* rt_root = traceback_to_route_tree(net);
     RecurseTree(rt_root);
     free_route_tree(rt_root);
 
+    swap_thread_route_tree_storage(storage);
+    free_route_tree_storage(storage);
+
     return !stub_nodes_.empty();
 }
 
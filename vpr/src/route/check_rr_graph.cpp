@@ -6,6 +6,7 @@
 
 #include "globals.h"
 #include "rr_graph.h"
+#include "parallel_check.h"
 #include "check_rr_graph.h"
 
 /*********************** Subroutines local to this module *******************/
@@ -18,11 +19,14 @@ static bool has_adjacent_channel(const RRGraph& rr_graph, const RRNodeId& node,
 
 static void check_rr_edge(const RREdgeId& from_edge, const RRNodeId& to_node);
 
+static bool is_uninitialized_rr_node(const RRNodeId& inode);
+
 /************************ Subroutine definitions ****************************/
 
 void check_rr_graph(const t_graph_type graph_type,
                     const DeviceGrid& grid,
-                    const std::vector<t_physical_tile_type>& types) {
+                    const std::vector<t_physical_tile_type>& types,
+                    const e_check_level check_level) {
     e_route_type route_type = DETAILED;
     if (graph_type == GRAPH_GLOBAL) {
         route_type = GLOBAL;
@@ -34,13 +38,30 @@ void check_rr_graph(const t_graph_type graph_type,
     auto switch_types_from_current_to_node = vtr::vector<RRNodeId, unsigned char>(device_ctx.rr_graph.nodes().size());
     const int num_rr_switches = device_ctx.rr_switch_inf.size();
 
+    /* The fan-in of every node is checked below, so the edges to the nodes are *
+     * all counted, even if only a sample of the nodes is checked.              */
     for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
+        if (is_uninitialized_rr_node(inode)) {
+            continue;
+        }
+        for (const RREdgeId& iedge : device_ctx.rr_graph.node_out_edges(inode)) {
+            RRNodeId to_node = device_ctx.rr_graph.edge_sink_node(iedge);
+            if (device_ctx.rr_graph.valid_node_id(to_node)) {
+                total_edges_to_node[to_node]++;
+            }
+        }
+    }
+
+    /* The nodes are independent and checked in parallel. The error of the node *
+     * with the lowest id is reported.                                          */
+    std::vector<RRNodeId> nodes(device_ctx.rr_graph.nodes().begin(), device_ctx.rr_graph.nodes().end());
+
+    parallel_check(nodes.size(), check_level, [&](size_t node_index) {
+        const RRNodeId& inode = nodes[node_index];
 
         /* Ignore any uninitialized rr_graph nodes */
-        if ((device_ctx.rr_graph.node_type(inode) == SOURCE)
-            && (device_ctx.rr_graph.node_xlow(inode) == 0) && (device_ctx.rr_graph.node_ylow(inode) == 0)
-            && (device_ctx.rr_graph.node_xhigh(inode) == 0) && (device_ctx.rr_graph.node_yhigh(inode) == 0)) {
-            continue;
+        if (is_uninitialized_rr_node(inode)) {
+            return;
         }
 
         t_rr_type rr_type = device_ctx.rr_graph.node_type(inode);
@@ -63,7 +84,6 @@ void check_rr_graph(const t_graph_type graph_type,
             check_rr_edge(iedge, to_node);
 
             edges_from_current_to_node[to_node].push_back(iedge);
-            total_edges_to_node[to_node]++;
 
             auto switch_type = size_t(device_ctx.rr_graph.edge_switch(iedge));
 
@@ -137,7 +157,7 @@ void check_rr_graph(const t_graph_type graph_type,
             }
         }
 
-    } /* End for all rr_nodes */
+    }); /* End for all rr_nodes */
 
     /* I built a list of how many edges went to everything in the code above -- *
      * now I check that everything is reachable.                                */
@@ -198,6 +218,14 @@ void check_rr_graph(const t_graph_type graph_type,
     }
 }
 
+static bool is_uninitialized_rr_node(const RRNodeId& inode) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    return (device_ctx.rr_graph.node_type(inode) == SOURCE)
+           && (device_ctx.rr_graph.node_xlow(inode) == 0) && (device_ctx.rr_graph.node_ylow(inode) == 0)
+           && (device_ctx.rr_graph.node_xhigh(inode) == 0) && (device_ctx.rr_graph.node_yhigh(inode) == 0);
+}
+
 static bool rr_node_is_global_clb_ipin(const RRNodeId& inode) {
     /* Returns true if inode refers to a global CLB input pin node.   */
 
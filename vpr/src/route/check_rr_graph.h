@@ -5,7 +5,8 @@
 
 void check_rr_graph(const t_graph_type graph_type,
                     const DeviceGrid& grid,
-                    const std::vector<t_physical_tile_type>& types);
+                    const std::vector<t_physical_tile_type>& types,
+                    const e_check_level check_level);
 
 void check_rr_node(const RRNodeId& inode, enum e_route_type route_type, const DeviceContext& device_ctx);
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <unordered_map>
+#include <memory>
 #include "route_tree_type.h"
 #include "vpr_types.h"
 #include "timing_info.h"
@@ -12,13 +13,34 @@
 // lookup and persistent scratch-space resources used for incremental reroute through
 // pruning the route tree of large fanouts. Instead of rerouting to each sink of a congested net,
 // reroute only the connections to the ones that did not have a legal connection the previous time
+//
+// The lookups indexed by nets are shared by the copies of the resources, while each
+// copy has its own scratch-space for the net being routed. Therefore, copies can
+// route different nets on different threads.
 class Connection_based_routing_resources {
-    // Incremental reroute resources --------------
-    // conceptually works like rr_sink_node_to_pin[inet][sink_rr_node_index] to get the pin index for that net
-    // each net maps SINK node index -> PIN index for net
-    // only need to be built once at the start since the SINK nodes never change
-    // the reverse lookup of route_ctx.net_rr_terminals
-    vtr::vector<ClusterNetId, std::unordered_map<int, int>> rr_sink_node_to_pin;
+    struct t_net_lookups {
+        // Incremental reroute resources --------------
+        // conceptually works like rr_sink_node_to_pin[inet][sink_rr_node_index] to get the pin index for that net
+        // each net maps SINK node index -> PIN index for net
+        // only need to be built once at the start since the SINK nodes never change
+        // the reverse lookup of route_ctx.net_rr_terminals
+        vtr::vector<ClusterNetId, std::unordered_map<int, int>> rr_sink_node_to_pin;
+
+        // Targeted reroute resources --------------
+        // whether or not a connection should be forcibly rerouted the next iteration
+        // takes [inet][sink_rr_node_index] and returns whether that connection should be rerouted or not
+        /* reroute connection if all of the following are true:
+         * 1. current critical path delay grew from the last stable critical path delay significantly
+         * 2. the connection is critical enough
+         * 3. the connection is suboptimal, in comparison to lower_bound_connection_delay
+         */
+        vtr::vector<ClusterNetId, std::unordered_map<int, bool>> forcible_reroute_connection_flag;
+
+        // the optimal delay for a connection [inet][ipin] ([0...num_net][1...num_pin])
+        // determined after the first routing iteration when only optimizing for timing delay
+        vtr::vector<ClusterNetId, std::vector<float>> lower_bound_connection_delay;
+    };
+    std::shared_ptr<t_net_lookups> net_lookups;
 
     // a property of each net, but only valid after pruning the previous route tree
     // the "targets" in question can be either rr_node indices or pin indices, the
@@ -54,19 +76,6 @@ class Connection_based_routing_resources {
 
     // Targeted reroute resources --------------
   private:
-    // whether or not a connection should be forcibly rerouted the next iteration
-    // takes [inet][sink_rr_node_index] and returns whether that connection should be rerouted or not
-    /* reroute connection if all of the following are true:
-     * 1. current critical path delay grew from the last stable critical path delay significantly
-     * 2. the connection is critical enough
-     * 3. the connection is suboptimal, in comparison to lower_bound_connection_delay
-     */
-    vtr::vector<ClusterNetId, std::unordered_map<int, bool>> forcible_reroute_connection_flag;
-
-    // the optimal delay for a connection [inet][ipin] ([0...num_net][1...num_pin])
-    // determined after the first routing iteration when only optimizing for timing delay
-    vtr::vector<ClusterNetId, std::vector<float>> lower_bound_connection_delay;
-
     // the current net that's being routed
     ClusterNetId current_inet;
 
@@ -108,9 +117,9 @@ class Connection_based_routing_resources {
 
     // get whether the connection to rr_sink_node of current_inet should be forcibly rerouted (can either assign or just read)
     bool should_force_reroute_connection(int rr_sink_node) const {
-        auto itr = forcible_reroute_connection_flag[current_inet].find(rr_sink_node);
+        auto itr = net_lookups->forcible_reroute_connection_flag[current_inet].find(rr_sink_node);
 
-        if (itr == forcible_reroute_connection_flag[current_inet].end()) {
+        if (itr == net_lookups->forcible_reroute_connection_flag[current_inet].end()) {
             return false; //A non-SINK end of a branch
         }
         return itr->second;
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <vector>
 #include <iostream>
+#include <mutex>
 
 #include "vtr_assert.h"
 #include "vtr_util.h"
@@ -30,6 +31,9 @@
 #include "echo_files.h"
 
 #include "route_profiling.h"
+#include "read_route.h"
+#include "check_route.h"
+#include "net_delay.h"
 
 #include "timing_util.h"
 #include "RoutingDelayCalculator.h"
@@ -44,22 +48,33 @@ struct t_trace_branch {
 
 /**************** Static variables local to route_common.c ******************/
 
-static t_heap** heap; /* Indexed from [1..heap_size] */
-static int heap_size; /* Number of slots in the heap array */
-static int heap_tail; /* Index of first unused slot in the heap array */
+/* The heap is local to each thread, so that several threads can route   *
+ * nets at the same time. A thread starts with an empty heap, and may work *
+ * on a heap owned by the caller through swap_thread_heap_storage().       */
+static thread_local t_heap** heap = nullptr; /* Indexed from [1..heap_size] */
+static thread_local int heap_size = 0;       /* Number of slots in the heap array */
+static thread_local int heap_tail = 1;       /* Index of first unused slot in the heap array */
+
+/* The kind of heap used by the router, shared by all the threads. The 4-ary  *
+ * heap holds at most one entry per node, whose position in the heap array is *
+ * kept in heap_node_pos (0 when the node is not on the heap).                 */
+static e_heap_type router_heap_type = e_heap_type::BINARY_HEAP;
+static thread_local vtr::vector<RRNodeId, int> heap_node_pos;
 
 /* For managing my own list of currently free heap data structures.     */
-static t_heap* heap_free_head = nullptr;
+static thread_local t_heap* heap_free_head = nullptr;
 /* For keeping track of the sudo malloc memory for the heap*/
-static vtr::t_chunk heap_ch;
+static thread_local vtr::t_chunk heap_ch;
 
-/* For managing my own list of currently free trace data structures.    */
+/* For managing my own list of currently free trace data structures.    *
+ * The traces are shared by the threads, so that the list is locked.    */
 static t_trace* trace_free_head = nullptr;
 /* For keeping track of the sudo malloc memory for the trace*/
 static vtr::t_chunk trace_ch;
+static std::mutex trace_mutex;
 
 static int num_trace_allocated = 0; /* To watch for memory leaks. */
-static int num_heap_allocated = 0;
+static thread_local int num_heap_allocated = 0;
 static int num_linked_f_pointer_allocated = 0;
 
 /*  The numbering relation between the channels and clbs is:				*
@@ -106,6 +121,8 @@ bool validate_traceback_recurr(t_trace* trace, std::set<RRNodeId>& seen_rr_nodes
 static bool validate_trace_nodes(t_trace* head, const std::unordered_set<RRNodeId>& trace_nodes);
 static float get_single_rr_cong_cost(const RRNodeId& inode);
 
+static void reserve_heap_data(int num_heap_data);
+
 /************************** Subroutine definitions ***************************/
 
 void save_routing(vtr::vector<ClusterNetId, t_trace*>& best_routing,
@@ -305,6 +322,9 @@ bool try_route(int width_fac,
     /* Allocate and load additional rr_graph information needed only by the router. */
     alloc_and_load_rr_node_route_structs();
 
+    /* The breadth-first router relies on several heap entries per node (see invalidate_heap_entries) */
+    set_router_heap_type(router_opts.router_algorithm == BREADTH_FIRST ? e_heap_type::BINARY_HEAP : router_opts.router_heap);
+
     init_route_structs(router_opts.bb_factor);
 
     if (cluster_ctx.clb_nlist.nets().empty()) {
@@ -313,10 +333,23 @@ bool try_route(int width_fac,
 
     if (router_opts.router_algorithm == BREADTH_FIRST) {
         VTR_LOG("Confirming router algorithm: BREADTH_FIRST.\n");
+        if (!router_opts.incremental_route_file.empty()) {
+            VTR_LOG_WARN("Incremental routing is only supported by the timing-driven router: all the nets are re-routed\n");
+        }
         success = try_breadth_first_route(router_opts);
     } else { /* TIMING_DRIVEN route */
         VTR_LOG("Confirming router algorithm: TIMING_DRIVEN.\n");
 
+        if (!router_opts.incremental_route_file.empty()) {
+            //Start from the previous routing of the unchanged nets, which are only
+            //re-routed if congested (see should_route_net()). Their occupancy seeds
+            //the present congestion costs seen by the nets which are re-routed.
+            std::vector<ClusterNetId> loaded_nets = read_incremental_route(router_opts.incremental_route_file.c_str());
+            recompute_occupancy_from_scratch();
+            pathfinder_update_cost(router_opts.initial_pres_fac, router_opts.acc_fac);
+            load_net_delay_from_routing(net_delay, loaded_nets);
+        }
+
         IntraLbPbPinLookup intra_lb_pb_pin_lookup(device_ctx.logical_block_types);
         ClusteredPinAtomPinsLookup netlist_pin_lookup(cluster_ctx.clb_nlist, intra_lb_pb_pin_lookup);
 
@@ -483,6 +516,17 @@ void init_heap(const DeviceGrid& grid) {
     heap = (t_heap**)vtr::malloc(heap_size * sizeof(t_heap*));
     heap--; /* heap stores from [1..heap_size] */
     heap_tail = 1;
+
+    /* The 4-ary heap updates the entries of the nodes already on the heap,  *
+     * so that the free list rarely grows beyond the initial heap size.     */
+    if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+        reserve_heap_data(heap_size);
+    }
+}
+
+void set_router_heap_type(e_heap_type heap_type) {
+    VTR_ASSERT(is_empty_heap());
+    router_heap_type = heap_type;
 }
 
 /* Call this before you route any nets.  It frees any old traceback and   *
@@ -954,11 +998,8 @@ void free_trace_structs() {
     }
 }
 
-void free_route_structs() {
-    /* Frees the temporary storage needed only during the routing.  The  *
-     * final routing result is not freed.                                */
-    auto& route_ctx = g_vpr_ctx.mutable_routing();
-
+static void free_heap() {
+    /* Frees the heap of the calling thread and its free list */
     if (heap != nullptr) {
         //Free the individiaul heap elements (calls destructors)
         for (int i = 1; i < num_heap_allocated; i++) {
@@ -983,12 +1024,48 @@ void free_route_structs() {
 
         heap_free_head = nullptr;
     }
+
+    /*free the memory chunks that were used by heap and linked f pointer */
+    free_chunk_memory(&heap_ch);
+
+    heap_node_pos.clear();
+    heap_node_pos.shrink_to_fit();
+}
+
+void free_route_structs() {
+    /* Frees the temporary storage needed only during the routing.  The  *
+     * final routing result is not freed.                                */
+    auto& route_ctx = g_vpr_ctx.mutable_routing();
+
+    free_heap();
+
     if (route_ctx.route_bb.size() != 0) {
         route_ctx.route_bb.clear();
     }
+}
 
-    /*free the memory chunks that were used by heap and linked f pointer */
-    free_chunk_memory(&heap_ch);
+void swap_thread_heap_storage(t_heap_storage& storage) {
+    /* Exchanges the heap of the calling thread with the given one. Swapping *
+     * again gives the thread its own heap back.                            */
+    std::swap(heap, storage.heap);
+    std::swap(heap_size, storage.heap_size);
+    std::swap(heap_tail, storage.heap_tail);
+    std::swap(heap_free_head, storage.heap_free_head);
+    std::swap(heap_ch, storage.heap_ch);
+    std::swap(num_heap_allocated, storage.num_heap_allocated);
+    std::swap(heap_node_pos, storage.heap_node_pos);
+}
+
+void init_heap_storage(t_heap_storage& storage, const DeviceGrid& grid) {
+    swap_thread_heap_storage(storage);
+    init_heap(grid);
+    swap_thread_heap_storage(storage);
+}
+
+void free_heap_storage(t_heap_storage& storage) {
+    swap_thread_heap_storage(storage);
+    free_heap();
+    swap_thread_heap_storage(storage);
 }
 
 /* Frees the data structures needed to save a routing.                     */
@@ -1210,6 +1287,104 @@ size_t right(size_t i);
 size_t size();
 void expand_heap_if_full();
 
+/* The 4-ary heap is stored from [1..heap_tail-1] as the binary heap, the *
+ * children of i are [4*i-2..4*i+1]. A wider heap is shallower, and the   *
+ * children of a node share a cache line when sifting down.              */
+static size_t four_ary_parent(size_t i) { return (i + 2) >> 2; }
+static size_t four_ary_first_child(size_t i) { return (i << 2) - 2; }
+
+// places an entry at a position of the 4-ary heap and records its position
+static void four_ary_place(size_t i, t_heap* const hptr) {
+    heap[i] = hptr;
+    if (hptr->index != RRNodeId::INVALID()) {
+        heap_node_pos[hptr->index] = i;
+    }
+}
+
+static void four_ary_sift_up(size_t leaf, t_heap* const node) {
+    while (leaf > 1 && node->cost < heap[four_ary_parent(leaf)]->cost) {
+        four_ary_place(leaf, heap[four_ary_parent(leaf)]);
+        leaf = four_ary_parent(leaf);
+    }
+    four_ary_place(leaf, node);
+}
+
+static void four_ary_sift_down(size_t hole, t_heap* const node) {
+    size_t child = four_ary_first_child(hole);
+    while ((int)child < heap_tail) {
+        size_t last_child = std::min(child + 4, (size_t)heap_tail);
+        size_t smallest = child;
+        for (size_t i = child + 1; i < last_child; ++i) {
+            if (heap[i]->cost < heap[smallest]->cost)
+                smallest = i;
+        }
+        if (!(heap[smallest]->cost < node->cost))
+            break;
+        four_ary_place(hole, heap[smallest]);
+        hole = smallest;
+        child = four_ary_first_child(hole);
+    }
+    four_ary_place(hole, node);
+}
+
+// returns the position of a node on the 4-ary heap, or 0 if it is not on the heap
+static int four_ary_find(const RRNodeId& inode) {
+    VTR_ASSERT_SAFE(inode != RRNodeId::INVALID());
+    if (size_t(inode) >= heap_node_pos.size()) {
+        heap_node_pos.resize(std::max(g_vpr_ctx.device().rr_graph.nodes().size(), size_t(inode) + 1), 0);
+    }
+    return heap_node_pos[inode];
+}
+
+// moves the path of hptr to the entry of the same node at position pos, if it is cheaper.
+// hptr is freed in any case. Returns true if the entry is updated
+static bool four_ary_update(int pos, t_heap* const hptr) {
+    t_heap* entry = heap[pos];
+    VTR_ASSERT_SAFE(entry->index == hptr->index);
+    bool cheaper = hptr->cost < entry->cost;
+    if (cheaper) {
+        entry->cost = hptr->cost;
+        entry->backward_path_cost = hptr->backward_path_cost;
+        entry->R_upstream = hptr->R_upstream;
+        entry->u.prev = hptr->u.prev;
+    }
+    free_heap_data(hptr);
+    return cheaper;
+}
+
+static void four_ary_add_to_heap(t_heap* const hptr) {
+    int pos = four_ary_find(hptr->index);
+    if (pos != 0) {
+        // decrease-key: the node is kept once on the heap with its cheapest path
+        if (four_ary_update(pos, hptr)) {
+            four_ary_sift_up(pos, heap[pos]);
+        }
+        return;
+    }
+    expand_heap_if_full();
+    ++heap_tail;
+    four_ary_sift_up(heap_tail - 1, hptr);
+}
+
+static t_heap* four_ary_get_heap_head() {
+    t_heap* cheapest;
+    do {
+        if (heap_tail == 1) { /* Empty heap. */
+            VTR_LOG_WARN("Empty heap occurred in get_heap_head.\n");
+            return (nullptr);
+        }
+
+        cheapest = heap[1];
+        --heap_tail;
+        if (heap_tail > 1) {
+            four_ary_sift_down(1, heap[heap_tail]);
+        }
+    } while (cheapest->index == RRNodeId::INVALID()); /* Get another one if invalid entry. */
+
+    heap_node_pos[cheapest->index] = 0;
+    return (cheapest);
+}
+
 size_t parent(size_t i) { return i >> 1; }
 // child indices of a heap
 size_t left(size_t i) { return i << 1; }
@@ -1236,6 +1411,14 @@ void sift_down(size_t hole) {
 // runs in O(n) time by sifting down; the least work is done on the most elements: 1 swap for bottom layer, 2 swap for 2nd, ... lgn swap for top
 // 1*(n/2) + 2*(n/4) + 3*(n/8) + ... + lgn*1 = 2n (sum of i/2^i)
 void build_heap() {
+    if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+        // the nodes after the parent of the last entry are leaves
+        if (heap_tail > 2) {
+            for (size_t i = four_ary_parent(heap_tail - 1); i != 0; --i)
+                four_ary_sift_down(i, heap[i]);
+        }
+        return;
+    }
     // second half of heap are leaves
     for (size_t i = heap_tail >> 1; i != 0; --i)
         sift_down(i);
@@ -1262,6 +1445,18 @@ void expand_heap_if_full() {
 
 // adds an element to the back of heap and expand if necessary, but does not maintain heap property
 void push_back(t_heap* const hptr) {
+    if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+        int pos = four_ary_find(hptr->index);
+        if (pos != 0) {
+            // the heap property is restored by build_heap
+            four_ary_update(pos, hptr);
+            return;
+        }
+        expand_heap_if_full();
+        four_ary_place(heap_tail, hptr);
+        ++heap_tail;
+        return;
+    }
     expand_heap_if_full();
     heap[heap_tail] = hptr;
     ++heap_tail;
@@ -1287,6 +1482,13 @@ void push_back_node(const RRNodeId& inode, float total_cost, const RRNodeId& pre
 }
 
 bool is_valid() {
+    if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+        for (size_t i = 2; (int)i < heap_tail; ++i) {
+            if (heap[i]->cost < heap[four_ary_parent(i)]->cost) return false;
+            if (heap[i]->index != RRNodeId::INVALID() && heap_node_pos[heap[i]->index] != (int)i) return false;
+        }
+        return true;
+    }
     for (size_t i = 1; (int)i <= heap_tail >> 1; ++i) {
         if ((int)left(i) < heap_tail && heap[left(i)]->cost < heap[i]->cost) return false;
         if ((int)right(i) < heap_tail && heap[right(i)]->cost < heap[i]->cost) return false;
@@ -1334,6 +1536,10 @@ void verify_extract_top() {
 } // namespace heap_
 // adds to heap and maintains heap quality
 void add_to_heap(t_heap* hptr) {
+    if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+        heap_::four_ary_add_to_heap(hptr);
+        return;
+    }
     heap_::expand_heap_if_full();
     // start with undefined hole
     ++heap_tail;
@@ -1351,6 +1557,10 @@ get_heap_head() {
      * heap is empty.  Invalid (index == OPEN) entries on the heap are never     *
      * returned -- they are just skipped over.                                   */
 
+    if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+        return heap_::four_ary_get_heap_head();
+    }
+
     t_heap* cheapest;
     size_t hole, child;
 
@@ -1380,8 +1590,12 @@ get_heap_head() {
 }
 
 void empty_heap() {
-    for (int i = 1; i < heap_tail; i++)
+    for (int i = 1; i < heap_tail; i++) {
+        if (router_heap_type == e_heap_type::FOUR_ARY_HEAP && heap[i]->index != RRNodeId::INVALID()) {
+            heap_node_pos[heap[i]->index] = 0;
+        }
         free_heap_data(heap[i]);
+    }
 
     heap_tail = 1;
 }
@@ -1415,6 +1629,20 @@ void free_heap_data(t_heap* hptr) {
     num_heap_allocated--;
 }
 
+static void reserve_heap_data(int num_heap_data) {
+    /* Puts heap data structures on the free list up-front, so that the router *
+     * does not allocate them while expanding nodes.                            */
+    int num_free = 0;
+    for (t_heap* hptr = heap_free_head; hptr != nullptr && num_free < num_heap_data; hptr = hptr->u.next) {
+        num_free++;
+    }
+    for (; num_free < num_heap_data; num_free++) {
+        t_heap* hptr = vtr::chunk_new<t_heap>(&heap_ch);
+        hptr->u.next = heap_free_head;
+        heap_free_head = hptr;
+    }
+}
+
 void invalidate_heap_entries(const RRNodeId& sink_node, const RRNodeId& ipin_node) {
     /* Marks all the heap entries consisting of sink_node, where it was reached *
      * via ipin_node, as invalid (OPEN).  Used only by the breadth_first router *
@@ -1423,6 +1651,9 @@ void invalidate_heap_entries(const RRNodeId& sink_node, const RRNodeId& ipin_nod
     for (int i = 1; i < heap_tail; i++) {
         if (heap[i]->index == sink_node) {
             if (heap[i]->u.prev.node == ipin_node) {
+                if (router_heap_type == e_heap_type::FOUR_ARY_HEAP) {
+                    heap_node_pos[sink_node] = 0;
+                }
                 heap[i]->index = RRNodeId::INVALID(); /* Invalid. */
                 break;
             }
@@ -1434,6 +1665,7 @@ t_trace*
 alloc_trace_data() {
     t_trace* temp_ptr;
 
+    std::lock_guard<std::mutex> lock(trace_mutex);
     if (trace_free_head == nullptr) { /* No elements on the free list */
         trace_free_head = (t_trace*)vtr::chunk_malloc(sizeof(t_trace), &trace_ch);
         trace_free_head->next = nullptr;
@@ -1447,6 +1679,7 @@ alloc_trace_data() {
 void free_trace_data(t_trace* tptr) {
     /* Puts the traceback structure pointed to by tptr on the free list. */
 
+    std::lock_guard<std::mutex> lock(trace_mutex);
     tptr->next = trace_free_head;
     trace_free_head = tptr;
     num_trace_allocated--;
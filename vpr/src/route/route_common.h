@@ -3,6 +3,7 @@
 #include <vector>
 #include "clustered_netlist.h"
 #include "vtr_vector.h"
+#include "vtr_memory.h"
 #include "rr_graph_obj.h"
 
 /* Used by the heap as its fundamental data structure.
@@ -121,6 +122,27 @@ void reset_rr_node_route_structs();
 void free_trace_structs();
 
 void init_heap(const DeviceGrid& grid);
+
+/* Selects the kind of heap used by the router. It applies to the heaps of all *
+ * the threads, and should only be changed while the heaps are empty.          */
+void set_router_heap_type(e_heap_type heap_type);
+
+/* A heap of the router with its free list. The heap functions work on the    *
+ * heap of the calling thread, which can be exchanged with a heap storage so  *
+ * that a thread routes with a heap owned by the caller.                      */
+struct t_heap_storage {
+    t_heap** heap = nullptr;
+    int heap_size = 0;
+    int heap_tail = 1;
+    t_heap* heap_free_head = nullptr;
+    vtr::t_chunk heap_ch;
+    int num_heap_allocated = 0;
+    vtr::vector<RRNodeId, int> heap_node_pos;
+};
+
+void init_heap_storage(t_heap_storage& storage, const DeviceGrid& grid);
+void free_heap_storage(t_heap_storage& storage);
+void swap_thread_heap_storage(t_heap_storage& storage);
 void reserve_locally_used_opins(float pres_fac, float acc_fac, bool rip_up_local_opins);
 
 void free_chunk_memory_trace();
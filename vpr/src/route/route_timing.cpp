@@ -4,10 +4,13 @@
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
+#include <mutex>
+#include <memory>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_trace.h"
 
 #include "vpr_utils.h"
 #include "vpr_types.h"
@@ -37,6 +40,8 @@
 
 #include "tatum/TimingReporter.hpp"
 
+#include "openfpga_parallel.h"
+
 #define CONGESTED_SLOPE_VAL -0.04
 
 enum class RouterCongestionMode {
@@ -44,6 +49,82 @@ enum class RouterCongestionMode {
     CONFLICTED
 };
 
+//The bounding box of a high fanout net is localized around the existing routing
+//close to the target, and expanded by this number of tiles
+constexpr int HIGH_FANOUT_BB_FAC = 3;
+
+//The device is cut in halves recursively PARALLEL_ROUTE_PARTITION_DEPTH times,
+//i.e., into 2^PARALLEL_ROUTE_PARTITION_DEPTH regions at the lowest level.
+//The depth does not depend on the number of threads, so that the same nets are
+//routed by the same regions, in the same order, whatever the number of threads
+constexpr size_t PARALLEL_ROUTE_PARTITION_DEPTH = 4;
+
+//A region of the device for the parallel routing.
+//The region is cut in two halves, which are its sub-regions.
+//The nets whose footprint crosses the cut line are routed by the region
+//itself, and the other nets by the sub-region containing their footprint.
+//The sub-regions are routed after the region, at the same time.
+//The footprint of a net contains all the RR nodes its routing may touch,
+//so that nets of disjoint regions never touch the same RR nodes.
+struct t_route_partition {
+    t_bb region;
+    std::vector<ClusterNetId> nets;
+    std::vector<size_t> dependencies; //The parent region
+};
+
+//What a region brings back from the parallel routing
+struct t_route_partition_result {
+    bool is_routable = true;
+    RouterStats router_stats;
+    std::vector<ClusterNetId> rerouted_nets;
+};
+
+//Heap, route tree free lists and scratch-space of a thread routing a region
+struct t_route_partition_storage {
+    t_heap_storage heap;
+    t_route_tree_storage route_tree;
+    std::vector<float> pin_criticality;
+    std::vector<t_rt_node*> rt_node_of_sink;
+};
+
+//The storages used by the parallel routing, which are handed out to
+//the regions being routed and reused for all the routing iterations.
+//There are never more storages than threads routing at the same time.
+class RoutePartitionStoragePool {
+  public:
+    ~RoutePartitionStoragePool() {
+        for (auto& storage : storages_) {
+            free_heap_storage(storage->heap);
+            free_route_tree_storage(storage->route_tree);
+        }
+    }
+
+    t_route_partition_storage* acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_storages_.empty()) {
+            int max_pins_per_net = std::max(get_max_pins_per_net(), 1);
+            storages_.emplace_back(std::make_unique<t_route_partition_storage>());
+            init_heap_storage(storages_.back()->heap, g_vpr_ctx.device().grid);
+            storages_.back()->pin_criticality.resize(max_pins_per_net);
+            storages_.back()->rt_node_of_sink.resize(max_pins_per_net, nullptr);
+            return storages_.back().get();
+        }
+        t_route_partition_storage* storage = free_storages_.back();
+        free_storages_.pop_back();
+        return storage;
+    }
+
+    void release(t_route_partition_storage* storage) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_storages_.push_back(storage);
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<t_route_partition_storage>> storages_;
+    std::vector<t_route_partition_storage*> free_storages_;
+};
+
 class WirelengthInfo {
   public:
     WirelengthInfo(size_t available = 0u, size_t used = 0u)
@@ -130,7 +211,8 @@ struct RoutingMetrics {
 
 //Run-time flag to control when router debug information is printed
 //Note only enables debug output if compiled with VTR_ENABLE_DEBUG_LOGGING defined
-bool f_router_debug = false;
+//Each thread routing nets has its own flag
+thread_local bool f_router_debug = false;
 
 /******************** Subroutines local to route_timing.c ********************/
 
@@ -312,6 +394,30 @@ static void prune_unused_non_configurable_nets(CBRR& connections_inf);
 
 static bool same_non_config_node_set(const RRNodeId& from_node, const RRNodeId& to_node);
 
+static bool is_parallel_routing_supported(const t_router_opts& router_opts);
+static int find_max_rr_node_span();
+static t_bb calc_net_routing_footprint(ClusterNetId net_id, int max_node_span, const t_router_opts& router_opts);
+static size_t build_route_partitions(const t_bb& region,
+                                     const std::vector<ClusterNetId>& nets,
+                                     const vtr::vector<ClusterNetId, t_bb>& net_footprints,
+                                     size_t depth,
+                                     size_t parent,
+                                     std::vector<t_route_partition>& partitions);
+static bool try_parallel_timing_driven_route_nets(const std::vector<ClusterNetId>& sorted_nets,
+                                                  int itry,
+                                                  float pres_fac,
+                                                  int max_node_span,
+                                                  const t_router_opts& router_opts,
+                                                  CBRR& connections_inf,
+                                                  RouterStats& router_stats,
+                                                  vtr::vector<ClusterNetId, float*>& net_delay,
+                                                  const RouterLookahead& router_lookahead,
+                                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                                  std::shared_ptr<SetupTimingInfo> timing_info,
+                                                  route_budgets& budgeting_inf,
+                                                  RoutePartitionStoragePool& storage_pool,
+                                                  std::vector<ClusterNetId>& rerouted_nets);
+
 /************************ Subroutine definitions *****************************/
 bool try_timing_driven_route(const t_router_opts& router_opts,
                              const t_analysis_opts& analysis_opts,
@@ -374,6 +480,8 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         router_opts.lookahead_type,
         router_opts.write_router_lookahead,
         router_opts.read_router_lookahead,
+        router_opts.router_lookahead_cache_file,
+        router_opts.num_workers,
         segment_inf);
 
     /*
@@ -389,6 +497,13 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
 
     size_t available_wirelength = calculate_wirelength_available();
 
+    /*
+     * Parallel routing of the nets of disjoint regions
+     */
+    bool parallel_routing = router_opts.parallel_routing && is_parallel_routing_supported(router_opts);
+    int max_node_span = parallel_routing ? find_max_rr_node_span() : 0;
+    RoutePartitionStoragePool partition_storage_pool;
+
     /*
      * Routing status and metrics
      */
@@ -422,6 +537,7 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
     int num_net_bounding_boxes_updated = 0;
     int itry_since_last_convergence = -1;
     for (itry = 1; itry <= router_opts.max_router_iterations; ++itry) {
+        VTR_TRACE_SPAN("route iteration " + std::to_string(itry));
         RouterStats router_iteration_stats;
         std::vector<ClusterNetId> rerouted_nets;
 
@@ -452,28 +568,48 @@ bool try_timing_driven_route(const t_router_opts& router_opts,
         /*
          * Route each net
          */
-        for (auto net_id : sorted_nets) {
-            bool was_rerouted = false;
-            bool is_routable = try_timing_driven_route_net(net_id,
-                                                           itry,
-                                                           pres_fac,
-                                                           router_opts,
-                                                           connections_inf,
-                                                           router_iteration_stats,
-                                                           route_structs.pin_criticality,
-                                                           route_structs.rt_node_of_sink,
-                                                           net_delay,
-                                                           *router_lookahead,
-                                                           netlist_pin_lookup,
-                                                           route_timing_info,
-                                                           budgeting_inf,
-                                                           was_rerouted);
+        if (parallel_routing) {
+            bool is_routable = try_parallel_timing_driven_route_nets(sorted_nets,
+                                                                     itry,
+                                                                     pres_fac,
+                                                                     max_node_span,
+                                                                     router_opts,
+                                                                     connections_inf,
+                                                                     router_iteration_stats,
+                                                                     net_delay,
+                                                                     *router_lookahead,
+                                                                     netlist_pin_lookup,
+                                                                     route_timing_info,
+                                                                     budgeting_inf,
+                                                                     partition_storage_pool,
+                                                                     rerouted_nets);
             if (!is_routable) {
                 return (false); //Impossible to route
             }
+        } else {
+            for (auto net_id : sorted_nets) {
+                bool was_rerouted = false;
+                bool is_routable = try_timing_driven_route_net(net_id,
+                                                               itry,
+                                                               pres_fac,
+                                                               router_opts,
+                                                               connections_inf,
+                                                               router_iteration_stats,
+                                                               route_structs.pin_criticality,
+                                                               route_structs.rt_node_of_sink,
+                                                               net_delay,
+                                                               *router_lookahead,
+                                                               netlist_pin_lookup,
+                                                               route_timing_info,
+                                                               budgeting_inf,
+                                                               was_rerouted);
+                if (!is_routable) {
+                    return (false); //Impossible to route
+                }
 
-            if (was_rerouted) {
-                rerouted_nets.push_back(net_id);
+                if (was_rerouted) {
+                    rerouted_nets.push_back(net_id);
+                }
             }
         }
 
@@ -829,6 +965,270 @@ bool try_timing_driven_route_net(ClusterNetId net_id,
     return (is_routed);
 }
 
+//Routes the nets of an iteration in parallel.
+//
+//The device is cut in halves recursively, and the nets whose footprint lies in
+//a half are routed by this half (see t_route_partition). The nets crossing the
+//first cut line are routed first, by the calling thread only. Then the halves
+//route their crossing nets at the same time, and so on down to the smallest
+//regions. Since the regions routed at the same time are disjoint, their nets
+//never touch the same RR nodes, and the routing is the same whatever the number
+//of threads, as if the regions were routed one after another.
+//
+//Each thread routes with its own heap, route tree free lists and scratch-space.
+static bool try_parallel_timing_driven_route_nets(const std::vector<ClusterNetId>& sorted_nets,
+                                                  int itry,
+                                                  float pres_fac,
+                                                  int max_node_span,
+                                                  const t_router_opts& router_opts,
+                                                  CBRR& connections_inf,
+                                                  RouterStats& router_stats,
+                                                  vtr::vector<ClusterNetId, float*>& net_delay,
+                                                  const RouterLookahead& router_lookahead,
+                                                  const ClusteredPinAtomPinsLookup& netlist_pin_lookup,
+                                                  std::shared_ptr<SetupTimingInfo> timing_info,
+                                                  route_budgets& budgeting_inf,
+                                                  RoutePartitionStoragePool& storage_pool,
+                                                  std::vector<ClusterNetId>& rerouted_nets) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    //The footprints follow the bounding boxes and the routing of the nets,
+    //so the regions are built again for each iteration
+    vtr::vector<ClusterNetId, t_bb> net_footprints(cluster_ctx.clb_nlist.nets().size());
+    for (auto net_id : sorted_nets) {
+        net_footprints[net_id] = calc_net_routing_footprint(net_id, max_node_span, router_opts);
+    }
+
+    size_t num_threads = openfpga::find_num_threads(router_opts.num_workers);
+
+    t_bb device_region;
+    device_region.xmin = 0;
+    device_region.ymin = 0;
+    device_region.xmax = grid.width() - 1;
+    device_region.ymax = grid.height() - 1;
+
+    std::vector<t_route_partition> partitions;
+    build_route_partitions(device_region, sorted_nets, net_footprints, PARALLEL_ROUTE_PARTITION_DEPTH, size_t(-1), partitions);
+
+    std::vector<std::vector<size_t>> partition_dependencies;
+    partition_dependencies.reserve(partitions.size());
+    for (const auto& partition : partitions) {
+        partition_dependencies.push_back(partition.dependencies);
+    }
+
+    std::vector<t_route_partition_result> partition_results(partitions.size());
+    openfpga::parallel_task_graph(partition_dependencies, num_threads, [&](const size_t& ipartition) {
+        t_route_partition_result& result = partition_results[ipartition];
+        if (partitions[ipartition].nets.empty()) {
+            return;
+        }
+
+        t_route_partition_storage* storage = storage_pool.acquire();
+        swap_thread_heap_storage(storage->heap);
+        swap_thread_route_tree_storage(storage->route_tree);
+
+        //The copy shares the net look-ups, but has its own scratch-space
+        CBRR partition_connections_inf = connections_inf;
+
+        for (auto net_id : partitions[ipartition].nets) {
+            bool was_rerouted = false;
+            result.is_routable = try_timing_driven_route_net(net_id,
+                                                             itry,
+                                                             pres_fac,
+                                                             router_opts,
+                                                             partition_connections_inf,
+                                                             result.router_stats,
+                                                             storage->pin_criticality.data(),
+                                                             storage->rt_node_of_sink.data(),
+                                                             net_delay,
+                                                             router_lookahead,
+                                                             netlist_pin_lookup,
+                                                             timing_info,
+                                                             budgeting_inf,
+                                                             was_rerouted);
+            if (!result.is_routable) {
+                break;
+            }
+
+            if (was_rerouted) {
+                result.rerouted_nets.push_back(net_id);
+            }
+        }
+
+        swap_thread_route_tree_storage(storage->route_tree);
+        swap_thread_heap_storage(storage->heap);
+        storage_pool.release(storage);
+    });
+
+    //Gather the results in the order of the regions, so that they do not depend on the threads
+    bool is_routable = true;
+    for (const auto& result : partition_results) {
+        is_routable &= result.is_routable;
+
+        router_stats.connections_routed += result.router_stats.connections_routed;
+        router_stats.nets_routed += result.router_stats.nets_routed;
+        router_stats.heap_pushes += result.router_stats.heap_pushes;
+        router_stats.heap_pops += result.router_stats.heap_pops;
+
+        rerouted_nets.insert(rerouted_nets.end(), result.rerouted_nets.begin(), result.rerouted_nets.end());
+    }
+
+    return is_routable;
+}
+
+//Creates the region of the parallel routing, and its sub-regions down to the given depth.
+//The nets are given in the order they should be routed, which is kept for each region.
+//Returns the index of the region created.
+static size_t build_route_partitions(const t_bb& region,
+                                     const std::vector<ClusterNetId>& nets,
+                                     const vtr::vector<ClusterNetId, t_bb>& net_footprints,
+                                     size_t depth,
+                                     size_t parent,
+                                     std::vector<t_route_partition>& partitions) {
+    size_t ipartition = partitions.size();
+    partitions.emplace_back();
+    partitions[ipartition].region = region;
+    if (parent != size_t(-1)) {
+        partitions[ipartition].dependencies.push_back(parent);
+    }
+
+    int width = region.xmax - region.xmin + 1;
+    int height = region.ymax - region.ymin + 1;
+
+    //Small regions or regions with few nets are not worth to be cut
+    if (depth == 0 || nets.size() < 2 || std::max(width, height) < 2) {
+        partitions[ipartition].nets = nets;
+        return ipartition;
+    }
+
+    //Cut the longest dimension of the region in its middle
+    t_bb low_region = region;
+    t_bb high_region = region;
+    if (width >= height) {
+        low_region.xmax = region.xmin + width / 2 - 1;
+        high_region.xmin = low_region.xmax + 1;
+    } else {
+        low_region.ymax = region.ymin + height / 2 - 1;
+        high_region.ymin = low_region.ymax + 1;
+    }
+
+    auto is_inside = [](const t_bb& footprint, const t_bb& bb) {
+        return footprint.xmin >= bb.xmin && footprint.xmax <= bb.xmax
+               && footprint.ymin >= bb.ymin && footprint.ymax <= bb.ymax;
+    };
+
+    std::vector<ClusterNetId> low_nets;
+    std::vector<ClusterNetId> high_nets;
+    for (auto net_id : nets) {
+        if (is_inside(net_footprints[net_id], low_region)) {
+            low_nets.push_back(net_id);
+        } else if (is_inside(net_footprints[net_id], high_region)) {
+            high_nets.push_back(net_id);
+        } else {
+            partitions[ipartition].nets.push_back(net_id);
+        }
+    }
+
+    build_route_partitions(low_region, low_nets, net_footprints, depth - 1, ipartition, partitions);
+    build_route_partitions(high_region, high_nets, net_footprints, depth - 1, ipartition, partitions);
+
+    return ipartition;
+}
+
+//Returns the region containing all the RR nodes the routing of a net may touch:
+//  * the RR nodes of its current routing, which is ripped up, and
+//  * the RR nodes the router may expand, which are not strictly outside of
+//    its bounding box (localized and expanded for high fanout nets), and may
+//    therefore extend beyond the bounding box by up to the longest RR node span
+static t_bb calc_net_routing_footprint(ClusterNetId net_id, int max_node_span, const t_router_opts& router_opts) {
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+    auto& route_ctx = g_vpr_ctx.routing();
+    auto& grid = g_vpr_ctx.device().grid;
+
+    t_bb footprint;
+    footprint.xmin = 0;
+    footprint.ymin = 0;
+    footprint.xmax = grid.width() - 1;
+    footprint.ymax = grid.height() - 1;
+
+    //Clock nets pre-routed to the virtual clock root may go anywhere,
+    //and ignored nets are not routed at all: keep them in the whole device
+    if (cluster_ctx.clb_nlist.net_is_ignored(net_id)
+        || (cluster_ctx.clb_nlist.net_is_global(net_id) && router_opts.two_stage_clock_routing)) {
+        return footprint;
+    }
+
+    t_bb bb = route_ctx.route_bb[net_id];
+    if (route_ctx.trace[net_id].head) {
+        t_bb route_bb = calc_current_bb(route_ctx.trace[net_id].head);
+        bb.xmin = std::min(bb.xmin, route_bb.xmin);
+        bb.ymin = std::min(bb.ymin, route_bb.ymin);
+        bb.xmax = std::max(bb.xmax, route_bb.xmax);
+        bb.ymax = std::max(bb.ymax, route_bb.ymax);
+    }
+
+    int margin = max_node_span;
+    if (is_high_fanout(cluster_ctx.clb_nlist.net_sinks(net_id).size(), router_opts.high_fanout_threshold)) {
+        margin += HIGH_FANOUT_BB_FAC;
+    }
+
+    footprint.xmin = std::max(footprint.xmin, bb.xmin - margin);
+    footprint.ymin = std::max(footprint.ymin, bb.ymin - margin);
+    footprint.xmax = std::min(footprint.xmax, bb.xmax + margin);
+    footprint.ymax = std::min(footprint.ymax, bb.ymax + margin);
+
+    return footprint;
+}
+
+//Returns the largest number of tiles an RR node extends over beyond its low location
+static int find_max_rr_node_span() {
+    auto& rr_graph = g_vpr_ctx.device().rr_graph;
+
+    int max_node_span = 0;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        max_node_span = std::max<int>(max_node_span, rr_graph.node_xhigh(node) - rr_graph.node_xlow(node));
+        max_node_span = std::max<int>(max_node_span, rr_graph.node_yhigh(node) - rr_graph.node_ylow(node));
+    }
+    return max_node_span;
+}
+
+//Returns true if the nets of disjoint regions can be routed at the same time,
+//otherwise reports why the nets are routed one after another
+static bool is_parallel_routing_supported(const t_router_opts& router_opts) {
+    auto& device_ctx = g_vpr_ctx.device();
+
+    size_t num_threads = openfpga::find_num_threads(router_opts.num_workers);
+    if (num_threads < 2) {
+        VTR_LOG("Parallel routing requires more than one worker (see --num_workers), nets are routed serially\n");
+        return false;
+    }
+
+#ifdef PROFILE
+    VTR_LOG_WARN("Parallel routing is not supported when the router is profiled, nets are routed serially\n");
+    return false;
+#endif
+
+    //Nodes connected by non-configurable edges are used together,
+    //wherever they are, so that nets can not be kept in regions
+    if (!device_ctx.rr_non_config_node_sets.empty()) {
+        VTR_LOG_WARN("Parallel routing is not supported with non-configurable edges, nets are routed serially\n");
+        return false;
+    }
+
+    //The base costs of pass transistors depend on the fanout of the net being routed,
+    //which is different for each thread
+    for (size_t index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
+        if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) {
+            VTR_LOG_WARN("Parallel routing is not supported with pass transistor switches, nets are routed serially\n");
+            return false;
+        }
+    }
+
+    VTR_LOG("Routing nets of disjoint regions in parallel with up to %zu threads\n", num_threads);
+    return true;
+}
+
 /*
  * NOTE:
  * Suggest using a timing_driven_route_structs struct. Memory is managed for you
@@ -1513,7 +1913,7 @@ vtr::vector<RRNodeId, t_heap> timing_driven_find_all_shortest_paths_from_route_t
     //Add the route tree to the heap with no specific target node
     RRNodeId target_node = RRNodeId::INVALID();
     auto router_lookahead = make_router_lookahead(e_router_lookahead::NO_OP,
-                                                  /*write_lookahead=*/"", /*read_lookahead=*/"",
+                                                  /*write_lookahead=*/"", /*read_lookahead=*/"", /*lookahead_cache=*/"", /*num_threads=*/1,
                                                   /*segment_inf=*/{});
     add_route_tree_to_heap(rt_root, target_node, cost_params, *router_lookahead, router_stats);
     heap_::build_heap(); // via sifting down everything
@@ -1535,7 +1935,7 @@ static vtr::vector<RRNodeId, t_heap> timing_driven_find_all_shortest_paths_from_
                                                                            std::vector<RRNodeId>& modified_rr_node_inf,
                                                                            RouterStats& router_stats) {
     auto router_lookahead = make_router_lookahead(e_router_lookahead::NO_OP,
-                                                  /*write_lookahead=*/"", /*read_lookahead=*/"",
+                                                  /*write_lookahead=*/"", /*read_lookahead=*/"", /*lookahead_cache=*/"", /*num_threads=*/1,
                                                   /*segment_inf=*/{});
 
     auto& device_ctx = g_vpr_ctx.device();
@@ -1914,7 +2314,6 @@ static t_bb add_high_fanout_route_tree_to_heap(t_rt_node* rt_root, const RRNodeI
 static t_bb adjust_highfanout_bounding_box(t_bb highfanout_bb) {
     t_bb bb = highfanout_bb;
 
-    constexpr int HIGH_FANOUT_BB_FAC = 3;
     bb.xmin -= HIGH_FANOUT_BB_FAC;
     bb.ymin -= HIGH_FANOUT_BB_FAC;
     bb.xmax += HIGH_FANOUT_BB_FAC;
@@ -2253,11 +2652,13 @@ void update_rr_base_costs(int fanout) {
     /* Other reasonable values for factor include fanout and 1 */
     factor = sqrt(fanout);
 
+    /* Only pass transistors depend on the fanout. The base costs of the other *
+     * rr_nodes are never changed, and always equal to their saved values, so  *
+     * that they are not written: nets can be routed by several threads when  *
+     * there is no pass transistor.                                            */
     for (index = CHANX_COST_INDEX_START; index < device_ctx.rr_indexed_data.size(); index++) {
         if (device_ctx.rr_indexed_data[index].T_quadratic > 0.) { /* pass transistor */
             device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost * factor;
-        } else {
-            device_ctx.rr_indexed_data[index].base_cost = device_ctx.rr_indexed_data[index].saved_base_cost;
         }
     }
 }
@@ -2360,7 +2761,8 @@ static bool early_exit_heuristic(const t_router_opts& router_opts, const Wirelen
 
 // incremental rerouting resources class definitions
 Connection_based_routing_resources::Connection_based_routing_resources()
-    : current_inet(NO_PREVIOUS)
+    : net_lookups(std::make_shared<t_net_lookups>())
+    , current_inet(NO_PREVIOUS)
     , // not routing to a specific net yet (note that NO_PREVIOUS is not unsigned, so will be largest unsigned)
     last_stable_critical_path_delay{0.0f}
     , critical_path_growth_tolerance{1.001f}
@@ -2386,15 +2788,15 @@ Connection_based_routing_resources::Connection_based_routing_resources()
     reached_rt_sinks.reserve(max_sink_pins_per_net);
 
     size_t routing_num_nets = cluster_ctx.clb_nlist.nets().size();
-    rr_sink_node_to_pin.resize(routing_num_nets);
-    lower_bound_connection_delay.resize(routing_num_nets);
-    forcible_reroute_connection_flag.resize(routing_num_nets);
+    net_lookups->rr_sink_node_to_pin.resize(routing_num_nets);
+    net_lookups->lower_bound_connection_delay.resize(routing_num_nets);
+    net_lookups->forcible_reroute_connection_flag.resize(routing_num_nets);
 
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
         // unordered_map<int,int> net_node_to_pin;
-        auto& net_node_to_pin = rr_sink_node_to_pin[net_id];
-        auto& net_lower_bound_connection_delay = lower_bound_connection_delay[net_id];
-        auto& net_forcible_reroute_connection_flag = forcible_reroute_connection_flag[net_id];
+        auto& net_node_to_pin = net_lookups->rr_sink_node_to_pin[net_id];
+        auto& net_lower_bound_connection_delay = net_lookups->lower_bound_connection_delay[net_id];
+        auto& net_forcible_reroute_connection_flag = net_lookups->forcible_reroute_connection_flag[net_id];
 
         unsigned int num_pins = cluster_ctx.clb_nlist.net_pins(net_id).size();
         net_node_to_pin.reserve(num_pins - 1);                      // not looking up on the SOURCE pin
@@ -2417,7 +2819,7 @@ void Connection_based_routing_resources::convert_sink_nodes_to_net_pins(std::vec
 
     VTR_ASSERT(current_inet != ClusterNetId::INVALID()); // not uninitialized
 
-    const auto& node_to_pin_mapping = rr_sink_node_to_pin[current_inet];
+    const auto& node_to_pin_mapping = net_lookups->rr_sink_node_to_pin[current_inet];
 
     for (size_t s = 0; s < rr_sink_nodes.size(); ++s) {
         auto mapping = node_to_pin_mapping.find(rr_sink_nodes[s]);
@@ -2437,7 +2839,7 @@ void Connection_based_routing_resources::put_sink_rt_nodes_in_net_pins_lookup(co
     VTR_ASSERT(current_inet != ClusterNetId::INVALID());
 
     // a net specific mapping from node index to pin index
-    const auto& node_to_pin_mapping = rr_sink_node_to_pin[current_inet];
+    const auto& node_to_pin_mapping = net_lookups->rr_sink_node_to_pin[current_inet];
 
     for (t_rt_node* rt_node : sink_rt_nodes) {
         /* Xifan Tang - TODO: should use RRNodeId later */
@@ -2456,7 +2858,7 @@ bool Connection_based_routing_resources::sanity_check_lookup() const {
     auto& route_ctx = g_vpr_ctx.routing();
 
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        const auto& net_node_to_pin = rr_sink_node_to_pin[net_id];
+        const auto& net_node_to_pin = net_lookups->rr_sink_node_to_pin[net_id];
 
         for (auto mapping : net_node_to_pin) {
             auto sanity = net_node_to_pin.find(mapping.first);
@@ -2478,7 +2880,7 @@ void Connection_based_routing_resources::set_lower_bound_connection_delays(vtr::
     auto& cluster_ctx = g_vpr_ctx.clustering();
 
     for (auto net_id : cluster_ctx.clb_nlist.nets()) {
-        auto& net_lower_bound_connection_delay = lower_bound_connection_delay[net_id];
+        auto& net_lower_bound_connection_delay = net_lookups->lower_bound_connection_delay[net_id];
 
         for (unsigned int ipin = 1; ipin < cluster_ctx.clb_nlist.net_pins(net_id).size(); ++ipin) {
             net_lower_bound_connection_delay.push_back(net_delay[net_id][ipin]);
@@ -2508,15 +2910,15 @@ bool Connection_based_routing_resources::forcibly_reroute_connections(float max_
 
             //Clear any forced re-routing from the previuos iteration
             /* Xifan Tang - TODO: should use RRNodeId later */
-            forcible_reroute_connection_flag[net_id][size_t(rr_sink_node)] = false;
+            net_lookups->forcible_reroute_connection_flag[net_id][size_t(rr_sink_node)] = false;
 
             // skip if connection is internal to a block such that SOURCE->OPIN->IPIN->SINK directly, which would have 0 time delay
-            if (lower_bound_connection_delay[net_id][ipin - 1] == 0)
+            if (net_lookups->lower_bound_connection_delay[net_id][ipin - 1] == 0)
                 continue;
 
             // update if more optimal connection found
-            if (net_delay[net_id][ipin] < lower_bound_connection_delay[net_id][ipin - 1]) {
-                lower_bound_connection_delay[net_id][ipin - 1] = net_delay[net_id][ipin];
+            if (net_delay[net_id][ipin] < net_lookups->lower_bound_connection_delay[net_id][ipin - 1]) {
+                net_lookups->lower_bound_connection_delay[net_id][ipin - 1] = net_delay[net_id][ipin];
                 continue;
             }
 
@@ -2526,11 +2928,11 @@ bool Connection_based_routing_resources::forcibly_reroute_connections(float max_
                 continue;
 
             // skip if connection's delay is close to optimal
-            if (net_delay[net_id][ipin] < (lower_bound_connection_delay[net_id][ipin - 1] * connection_delay_optimality_tolerance))
+            if (net_delay[net_id][ipin] < (net_lookups->lower_bound_connection_delay[net_id][ipin - 1] * connection_delay_optimality_tolerance))
                 continue;
 
             /* Xifan Tang - TODO: should use RRNodeId later */
-            forcible_reroute_connection_flag[net_id][size_t(rr_sink_node)] = true;
+            net_lookups->forcible_reroute_connection_flag[net_id][size_t(rr_sink_node)] = true;
             // note that we don't set forcible_reroute_connection_flag to false when the converse is true
             // resetting back to false will be done during tree pruning, after the sink has been legally reached
             any_connection_rerouted = true;
@@ -2544,14 +2946,14 @@ bool Connection_based_routing_resources::forcibly_reroute_connections(float max_
 }
 
 void Connection_based_routing_resources::clear_force_reroute_for_connection(int rr_sink_node) {
-    forcible_reroute_connection_flag[current_inet][rr_sink_node] = false;
+    net_lookups->forcible_reroute_connection_flag[current_inet][rr_sink_node] = false;
     profiling::perform_forced_reroute();
 }
 
 void Connection_based_routing_resources::clear_force_reroute_for_net() {
     VTR_ASSERT(current_inet != ClusterNetId::INVALID());
 
-    auto& net_flags = forcible_reroute_connection_flag[current_inet];
+    auto& net_flags = net_lookups->forcible_reroute_connection_flag[current_inet];
     for (auto& force_reroute_flag : net_flags) {
         if (force_reroute_flag.second) {
             force_reroute_flag.second = false;
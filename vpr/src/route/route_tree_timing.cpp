@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <cmath>
 #include <vector>
+#include <utility>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -29,13 +30,18 @@
 
 static vtr::vector<RRNodeId, t_rt_node*> rr_node_to_rt_node; /* [0..device_ctx.rr_graph.nodes().size()-1] */
 
-/* Frees lists for fast addition and deletion of nodes and edges. */
+/* Frees lists for fast addition and deletion of nodes and edges.
+ * They are local to each thread, so that several threads can build route
+ * trees at the same time. A thread may work on the free lists of the caller
+ * through swap_thread_route_tree_storage().                                 */
 
-static t_rt_node* rt_node_free_list = nullptr;
-static t_linked_rt_edge* rt_edge_free_list = nullptr;
+static thread_local t_rt_node* rt_node_free_list = nullptr;
+static thread_local t_linked_rt_edge* rt_edge_free_list = nullptr;
 
 /********************** Subroutines local to this module *********************/
 
+static void free_route_tree_free_lists();
+
 static t_rt_node* alloc_rt_node();
 
 static void free_rt_node(t_rt_node* rt_node);
@@ -93,11 +99,31 @@ void free_route_tree_timing_structs() {
     /* Frees the structures needed to build routing trees, and really frees
      * (i.e. calls free) all the data on the free lists.                         */
 
+    rr_node_to_rt_node.clear();
+
+    free_route_tree_free_lists();
+}
+
+void swap_thread_route_tree_storage(t_route_tree_storage& storage) {
+    /* Exchanges the free lists of the calling thread with the given ones.
+     * Swapping again gives the thread its own free lists back.                 */
+    std::swap(rt_node_free_list, storage.rt_node_free_list);
+    std::swap(rt_edge_free_list, storage.rt_edge_free_list);
+}
+
+void free_route_tree_storage(t_route_tree_storage& storage) {
+    swap_thread_route_tree_storage(storage);
+    free_route_tree_free_lists();
+    swap_thread_route_tree_storage(storage);
+}
+
+static void free_route_tree_free_lists() {
+    /* Really frees (i.e. calls free) all the data on the free lists of the
+     * calling thread.                                                           */
+
     t_rt_node *rt_node, *next_node;
     t_linked_rt_edge *rt_edge, *next_edge;
 
-    rr_node_to_rt_node.clear();
-
     rt_node = rt_node_free_list;
 
     while (rt_node != nullptr) {
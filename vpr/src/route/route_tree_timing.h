@@ -13,6 +13,17 @@ bool alloc_route_tree_timing_structs(bool exists_ok = false);
 
 void free_route_tree_timing_structs();
 
+//Free lists of the route tree nodes and edges. The route tree functions use the
+//free lists of the calling thread, which can be exchanged with a storage so that
+//a thread builds route trees with free lists owned by the caller.
+struct t_route_tree_storage {
+    t_rt_node* rt_node_free_list = nullptr;
+    t_linked_rt_edge* rt_edge_free_list = nullptr;
+};
+
+void free_route_tree_storage(t_route_tree_storage& storage);
+void swap_thread_route_tree_storage(t_route_tree_storage& storage);
+
 t_rt_node* init_route_tree_to_source(ClusterNetId inet);
 
 void free_route_tree(t_rt_node* rt_node);
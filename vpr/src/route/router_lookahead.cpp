@@ -8,11 +8,13 @@
 static int get_expected_segs_to_target(const RRNodeId& inode, const RRNodeId& target_node, int* num_segs_ortho_dir_ptr);
 static int round_up(float x);
 
-static std::unique_ptr<RouterLookahead> make_router_lookahead_object(e_router_lookahead router_lookahead_type) {
+static std::unique_ptr<RouterLookahead> make_router_lookahead_object(e_router_lookahead router_lookahead_type,
+                                                                     const std::string& lookahead_cache,
+                                                                     size_t num_threads) {
     if (router_lookahead_type == e_router_lookahead::CLASSIC) {
         return std::make_unique<ClassicLookahead>();
     } else if (router_lookahead_type == e_router_lookahead::MAP) {
-        return std::make_unique<MapLookahead>();
+        return std::make_unique<MapLookahead>(lookahead_cache, num_threads);
     } else if (router_lookahead_type == e_router_lookahead::NO_OP) {
         return std::make_unique<NoOpLookahead>();
     }
@@ -25,8 +27,10 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(
     e_router_lookahead router_lookahead_type,
     std::string write_lookahead,
     std::string read_lookahead,
+    std::string lookahead_cache,
+    size_t num_threads,
     const std::vector<t_segment_inf>& segment_inf) {
-    std::unique_ptr<RouterLookahead> router_lookahead = make_router_lookahead_object(router_lookahead_type);
+    std::unique_ptr<RouterLookahead> router_lookahead = make_router_lookahead_object(router_lookahead_type, lookahead_cache, num_threads);
 
     if (read_lookahead.empty()) {
         router_lookahead->compute(segment_inf);
@@ -102,7 +106,15 @@ float MapLookahead::get_expected_cost(const RRNodeId& current_node, const RRNode
 }
 
 void MapLookahead::compute(const std::vector<t_segment_inf>& segment_inf) {
-    compute_router_lookahead(segment_inf.size());
+    compute_router_lookahead(segment_inf.size(), cache_file_, num_threads_);
+}
+
+void MapLookahead::read(const std::string& file) {
+    read_router_lookahead(file);
+}
+
+void MapLookahead::write(const std::string& file) const {
+    write_router_lookahead(file);
 }
 
 float NoOpLookahead::get_expected_cost(const RRNodeId& /*current_node*/, const RRNodeId& /*target_node*/, const t_conn_cost_params& /*params*/, float /*R_upstream*/) const {
@@ -203,6 +215,8 @@ const RouterLookahead* get_cached_router_lookahead(
     e_router_lookahead router_lookahead_type,
     std::string write_lookahead,
     std::string read_lookahead,
+    std::string lookahead_cache,
+    size_t num_threads,
     const std::vector<t_segment_inf>& segment_inf) {
     auto& router_ctx = g_vpr_ctx.routing();
 
@@ -222,6 +236,8 @@ const RouterLookahead* get_cached_router_lookahead(
                 router_lookahead_type,
                 write_lookahead,
                 read_lookahead,
+                lookahead_cache,
+                num_threads,
                 segment_inf));
     }
 }
@@ -36,6 +36,8 @@ std::unique_ptr<RouterLookahead> make_router_lookahead(
     e_router_lookahead router_lookahead_type,
     std::string write_lookahead,
     std::string read_lookahead,
+    std::string lookahead_cache,
+    size_t num_threads,
     const std::vector<t_segment_inf>& segment_inf);
 
 // Clear router lookahead cache (e.g. when changing or free rrgraph).
@@ -49,6 +51,8 @@ const RouterLookahead* get_cached_router_lookahead(
     e_router_lookahead router_lookahead_type,
     std::string write_lookahead,
     std::string read_lookahead,
+    std::string lookahead_cache,
+    size_t num_threads,
     const std::vector<t_segment_inf>& segment_inf);
 
 class ClassicLookahead : public RouterLookahead {
@@ -69,15 +73,23 @@ class ClassicLookahead : public RouterLookahead {
 };
 
 class MapLookahead : public RouterLookahead {
+  public:
+    // The map is loaded from the cache file (if not empty) when it was
+    // computed from the same rr graph, otherwise the cache file is updated.
+    // The map is computed with the given number of threads (0 means all the cores)
+    MapLookahead(const std::string& cache_file, size_t num_threads)
+        : cache_file_(cache_file)
+        , num_threads_(num_threads) {}
+
   protected:
     float get_expected_cost(const RRNodeId& node, const RRNodeId& target_node, const t_conn_cost_params& params, float R_upstream) const override;
     void compute(const std::vector<t_segment_inf>& segment_inf) override;
-    void read(const std::string& /*file*/) override {
-        VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read unimplemented");
-    }
-    void write(const std::string& /*file*/) const override {
-        VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write unimplemented");
-    }
+    void read(const std::string& file) override;
+    void write(const std::string& file) const override;
+
+  private:
+    std::string cache_file_;
+    size_t num_threads_;
 };
 
 class NoOpLookahead : public RouterLookahead {
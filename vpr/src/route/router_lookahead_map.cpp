@@ -14,6 +14,11 @@
  */
 
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <vector>
 #include <queue>
 #include <ctime>
@@ -25,9 +30,20 @@
 #include "vtr_log.h"
 #include "vtr_assert.h"
 #include "vtr_time.h"
+#include "vtr_util.h"
+#include "vtr_digest.h"
 #include "rr_graph_obj_util.h"
+#include "openfpga_parallel.h"
 #include "router_lookahead_map.h"
 
+#ifdef VTR_ENABLE_CAPNPROTO
+#    include "capnp/serialize.h"
+#    include "map_lookahead.capnp.h"
+#    include "ndmatrix_serdes.h"
+#    include "mmap_file.h"
+#    include "serdes_utils.h"
+#endif /* VTR_ENABLE_CAPNPROTO */
+
 /* the cost map is computed by running a Dijkstra search from channel segment rr nodes at the specified reference coordinate */
 #define REF_X 3
 #define REF_Y 3
@@ -97,6 +113,12 @@ class Expansion_Cost_Entry {
             this->cost_vector.push_back(cost_entry);
         }
     }
+    /* adds the entries of another expansion in their order, as if they were added to this one */
+    void add_cost_entries(const Expansion_Cost_Entry& other) {
+        for (const Cost_Entry& cost_entry : other.cost_vector) {
+            this->add_cost_entry(cost_entry.delay, cost_entry.congestion);
+        }
+    }
     void clear_cost_entries() {
         this->cost_vector.clear();
     }
@@ -184,6 +206,54 @@ typedef vtr::NdMatrix<Cost_Entry, 4> t_cost_map; //[0..1][[0..num_seg_types-1]0.
  * the list at each coordinate is later boiled down to a single representative cost entry to be stored in the final cost map */
 typedef vtr::Matrix<Expansion_Cost_Entry> t_routing_cost_map; //[0..device_ctx.grid.width()-1][0..device_ctx.grid.height()-1]
 
+/* a start node of the Dijkstra expansions, at a sample reference coordinate */
+struct t_dijkstra_sample {
+    RRNodeId start_node_ind;
+    int start_x;
+    int start_y;
+};
+
+/* the per-node state of a Dijkstra expansion. It is allocated once for each thread and
+ * only the nodes touched by an expansion are reset afterwards */
+struct t_dijkstra_scratch {
+    /* a list of boolean flags (one for each rr node) to figure out if a certain node has already been expanded */
+    vtr::vector<RRNodeId, bool> node_expanded;
+    /* for each node keep a list of the cost with which that node has been visited (used to determine whether to push
+     * a candidate node onto the expansion queue */
+    vtr::vector<RRNodeId, float> node_visited_costs;
+    /* the nodes whose flags or costs are set by the current expansion */
+    std::vector<RRNodeId> touched_nodes;
+};
+
+/* the scratch spaces of the threads running the Dijkstra expansions.
+ * There are never more scratch spaces than threads running at the same time */
+class DijkstraScratchPool {
+  public:
+    t_dijkstra_scratch* acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_scratches_.empty()) {
+            size_t num_nodes = g_vpr_ctx.device().rr_graph.nodes().size();
+            scratches_.emplace_back(std::make_unique<t_dijkstra_scratch>());
+            scratches_.back()->node_expanded.resize(num_nodes, false);
+            scratches_.back()->node_visited_costs.resize(num_nodes, -1.0);
+            return scratches_.back().get();
+        }
+        t_dijkstra_scratch* scratch = free_scratches_.back();
+        free_scratches_.pop_back();
+        return scratch;
+    }
+
+    void release(t_dijkstra_scratch* scratch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_scratches_.push_back(scratch);
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<t_dijkstra_scratch>> scratches_;
+    std::vector<t_dijkstra_scratch*> free_scratches_;
+};
+
 /******** File-Scope Variables ********/
 /* The cost map */
 t_cost_map f_cost_map;
@@ -191,13 +261,21 @@ t_cost_map f_cost_map;
 /******** File-Scope Functions ********/
 static void alloc_cost_map(int num_segments);
 static void free_cost_map();
+/* runs the Dijkstra expansions of all the segment and channel types to fill the cost map */
+static void build_cost_map(int num_segments, size_t num_threads);
+/* returns an id of the rr graph and the options from which the cost map is computed */
+static std::string find_router_lookahead_map_id(int num_segments);
+/* loads the cost map from a file if its id matches (an empty id matches any file), returns false otherwise */
+static bool load_cost_map(const std::string& file, const std::string& lookahead_id);
+/* writes the cost map to a file along with its id */
+static void save_cost_map(const std::string& file, const std::string& lookahead_id);
 /* returns index of a node from which to start routing */
 static RRNodeId get_start_node_ind(int start_x, int start_y, int target_x, int target_y, t_rr_type rr_type, int seg_index, int track_offset);
 /* runs Dijkstra's algorithm from specified node until all nodes have been visited. Each time a pin is visited, the delay/congestion information
  * to that pin is stored is added to an entry in the routing_cost_map */
-static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_y, t_routing_cost_map& routing_cost_map);
+static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_y, t_routing_cost_map& routing_cost_map, t_dijkstra_scratch& scratch);
 /* iterates over the children of the specified node and selectively pushes them onto the priority queue */
-static void expand_dijkstra_neighbours(PQ_Entry parent_entry, vtr::vector<RRNodeId, float>& node_visited_costs, vtr::vector<RRNodeId, bool>& node_expanded, std::priority_queue<PQ_Entry>& pq);
+static void expand_dijkstra_neighbours(PQ_Entry parent_entry, t_dijkstra_scratch& scratch, std::priority_queue<PQ_Entry>& pq);
 /* sets the lookahead cost map entries based on representative cost entries from routing_cost_map */
 static void set_lookahead_map_costs(int segment_index, e_rr_type chan_type, t_routing_cost_map& routing_cost_map);
 /* fills in missing lookahead map entries by copying the cost of the closest valid entry */
@@ -241,8 +319,41 @@ float get_lookahead_map_cost(const RRNodeId& from_node_ind, const RRNodeId& to_n
 }
 
 /* Computes the lookahead map to be used by the router. If a map was computed prior to this, a new one will not be computed again.
- * The rr graph must have been built before calling this function. */
-void compute_router_lookahead(int num_segments) {
+ * The rr graph must have been built before calling this function.
+ * When a cache file is given, the map is loaded from it if it was computed from the same rr graph,
+ * otherwise the map is computed and written to the cache file. */
+void compute_router_lookahead(int num_segments, const std::string& lookahead_cache_file, size_t num_threads) {
+    std::string lookahead_id;
+    if (!lookahead_cache_file.empty()) {
+        lookahead_id = find_router_lookahead_map_id(num_segments);
+        if (load_cost_map(lookahead_cache_file, lookahead_id)) {
+            return;
+        }
+    }
+
+    build_cost_map(num_segments, num_threads);
+
+    if (!lookahead_cache_file.empty()) {
+        save_cost_map(lookahead_cache_file, lookahead_id);
+    }
+}
+
+/* Reads the lookahead map from the specified file instead of computing it */
+void read_router_lookahead(const std::string& file) {
+    if (!load_cost_map(file, std::string())) {
+        VPR_FATAL_ERROR(VPR_ERROR_ROUTE, "Failed to read the router lookahead map from '%s'\n", file.c_str());
+    }
+}
+
+/* Writes the lookahead map to the specified file */
+void write_router_lookahead(const std::string& file) {
+    save_cost_map(file, find_router_lookahead_map_id(f_cost_map.dim_size(1)));
+}
+
+/* The expansions from the sample start nodes are independent: each one runs on its own thread with
+ * its own scratch space and cost map, and the cost maps are then merged in the order of the samples,
+ * so that the lookahead is the same whatever the number of threads */
+static void build_cost_map(int num_segments, size_t num_threads) {
     vtr::ScopedStartFinishTimer timer("Computing router lookahead map");
 
     f_cost_map.clear();
@@ -253,12 +364,13 @@ void compute_router_lookahead(int num_segments) {
     free_cost_map();
     alloc_cost_map(num_segments);
 
+    num_threads = openfpga::find_num_threads(num_threads);
+    DijkstraScratchPool scratch_pool;
+
     /* run Dijkstra's algorithm for each segment type & channel type combination */
     for (int iseg = 0; iseg < num_segments; iseg++) {
         for (e_rr_type chan_type : {CHANX, CHANY}) {
-            /* allocate the cost map for this iseg/chan_type */
-            t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
-
+            std::vector<t_dijkstra_sample> samples;
             for (int ref_inc = 0; ref_inc < 3; ref_inc++) {
                 for (int track_offset = 0; track_offset < MAX_TRACK_OFFSET; track_offset += 2) {
                     /* get the rr node index from which to start routing */
@@ -270,11 +382,32 @@ void compute_router_lookahead(int num_segments) {
                         continue;
                     }
 
-                    /* run Dijkstra's algorithm */
-                    run_dijkstra(start_node_ind, REF_X + ref_inc, REF_Y + ref_inc, routing_cost_map);
+                    samples.push_back({start_node_ind, REF_X + ref_inc, REF_Y + ref_inc});
                 }
             }
 
+            /* run Dijkstra's algorithm from each sample */
+            std::vector<t_routing_cost_map> sample_cost_maps(samples.size());
+            openfpga::parallel_for(samples.size(), num_threads, [&](const size_t& isample) {
+                const t_dijkstra_sample& sample = samples[isample];
+                sample_cost_maps[isample] = t_routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
+
+                t_dijkstra_scratch* scratch = scratch_pool.acquire();
+                run_dijkstra(sample.start_node_ind, sample.start_x, sample.start_y, sample_cost_maps[isample], *scratch);
+                scratch_pool.release(scratch);
+            });
+
+            /* allocate the cost map for this iseg/chan_type, and merge the costs of the samples into it */
+            t_routing_cost_map routing_cost_map({device_ctx.grid.width(), device_ctx.grid.height()});
+            for (t_routing_cost_map& sample_cost_map : sample_cost_maps) {
+                for (size_t ix = 0; ix < routing_cost_map.dim_size(0); ix++) {
+                    for (size_t iy = 0; iy < routing_cost_map.dim_size(1); iy++) {
+                        routing_cost_map[ix][iy].add_cost_entries(sample_cost_map[ix][iy]);
+                    }
+                }
+                sample_cost_map.clear();
+            }
+
             /* boil down the cost list in routing_cost_map at each coordinate to a representative cost entry and store it in the lookahead
              * cost map */
             set_lookahead_map_costs(iseg, chan_type, routing_cost_map);
@@ -347,14 +480,10 @@ static void free_cost_map() {
 
 /* runs Dijkstra's algorithm from specified node until all nodes have been visited. Each time a pin is visited, the delay/congestion information
  * to that pin is stored is added to an entry in the routing_cost_map */
-static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_y, t_routing_cost_map& routing_cost_map) {
+static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_y, t_routing_cost_map& routing_cost_map, t_dijkstra_scratch& scratch) {
     auto& device_ctx = g_vpr_ctx.device();
 
-    /* a list of boolean flags (one for each rr node) to figure out if a certain node has already been expanded */
-    vtr::vector<RRNodeId, bool> node_expanded(device_ctx.rr_graph.nodes().size(), false);
-    /* for each node keep a list of the cost with which that node has been visited (used to determine whether to push
-     * a candidate node onto the expansion queue */
-    vtr::vector<RRNodeId, float> node_visited_costs(device_ctx.rr_graph.nodes().size(), -1.0);
+    vtr::vector<RRNodeId, bool>& node_expanded = scratch.node_expanded;
     /* a priority queue for expansion */
     std::priority_queue<PQ_Entry> pq;
 
@@ -362,6 +491,7 @@ static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_
     PQ_Entry first_entry(start_node_ind, UNDEFINED, 0, 0, 0, true);
 
     pq.push(first_entry);
+    scratch.touched_nodes.push_back(start_node_ind);
 
     /* now do routing */
     while (!pq.empty()) {
@@ -388,15 +518,25 @@ static void run_dijkstra(const RRNodeId& start_node_ind, int start_x, int start_
             }
         }
 
-        expand_dijkstra_neighbours(current, node_visited_costs, node_expanded, pq);
+        expand_dijkstra_neighbours(current, scratch, pq);
         node_expanded[node_ind] = true;
     }
+
+    /* leave the scratch space clean for the next expansion */
+    for (const RRNodeId& node : scratch.touched_nodes) {
+        scratch.node_expanded[node] = false;
+        scratch.node_visited_costs[node] = -1.0;
+    }
+    scratch.touched_nodes.clear();
 }
 
 /* iterates over the children of the specified node and selectively pushes them onto the priority queue */
-static void expand_dijkstra_neighbours(PQ_Entry parent_entry, vtr::vector<RRNodeId, float>& node_visited_costs, vtr::vector<RRNodeId, bool>& node_expanded, std::priority_queue<PQ_Entry>& pq) {
+static void expand_dijkstra_neighbours(PQ_Entry parent_entry, t_dijkstra_scratch& scratch, std::priority_queue<PQ_Entry>& pq) {
     auto& device_ctx = g_vpr_ctx.device();
 
+    vtr::vector<RRNodeId, float>& node_visited_costs = scratch.node_visited_costs;
+    vtr::vector<RRNodeId, bool>& node_expanded = scratch.node_expanded;
+
     RRNodeId parent_ind = parent_entry.rr_node_ind;
 
     for (const RREdgeId& iedge : device_ctx.rr_graph.node_out_edges(parent_ind)) {
@@ -419,6 +559,9 @@ static void expand_dijkstra_neighbours(PQ_Entry parent_entry, vtr::vector<RRNode
         }
 
         /* finally, record the cost with which the child was visited and put the child entry on the queue */
+        if (node_visited_costs[child_node_ind] < 0) {
+            scratch.touched_nodes.push_back(child_node_ind);
+        }
         node_visited_costs[child_node_ind] = child_entry.cost;
         pq.push(child_entry);
     }
@@ -676,3 +819,145 @@ static void print_cost_map() {
         }
     }
 }
+
+/* mixes a value into a 64-bit FNV-1a hash */
+static void hash_combine_fnv1a(uint64_t& hash, uint64_t value) {
+    for (int ibyte = 0; ibyte < 8; ibyte++) {
+        hash ^= (value >> (8 * ibyte)) & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+}
+
+static void hash_combine_fnv1a(uint64_t& hash, float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    hash_combine_fnv1a(hash, uint64_t(bits));
+}
+
+/* returns an id of the rr graph and the options from which the cost map is computed.
+ * The id covers everything the Dijkstra expansions look at: the nodes (in creation order, which
+ * decides the start nodes), their fan-outs, the indexed data which provides the delay and congestion
+ * of each node, and the constants of this file */
+static std::string find_router_lookahead_map_id(int num_segments) {
+    auto& device_ctx = g_vpr_ctx.device();
+    const RRGraph& rr_graph = device_ctx.rr_graph;
+
+    uint64_t rr_graph_hash = 0xcbf29ce484222325ULL;
+    for (const RRNodeId& node : rr_graph.nodes()) {
+        t_rr_type type = rr_graph.node_type(node);
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(type));
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(rr_graph.node_xlow(node)));
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(rr_graph.node_ylow(node)));
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(rr_graph.node_xhigh(node)));
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(rr_graph.node_yhigh(node)));
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(rr_graph.node_cost_index(node)));
+        if (type == CHANX || type == CHANY) {
+            hash_combine_fnv1a(rr_graph_hash, uint64_t(rr_graph.node_direction(node)));
+        }
+        for (const RREdgeId& edge : rr_graph.node_out_edges(node)) {
+            hash_combine_fnv1a(rr_graph_hash, uint64_t(size_t(rr_graph.edge_sink_node(edge))));
+        }
+    }
+    for (const t_rr_indexed_data& indexed_data : device_ctx.rr_indexed_data) {
+        hash_combine_fnv1a(rr_graph_hash, uint64_t(indexed_data.seg_index));
+        hash_combine_fnv1a(rr_graph_hash, indexed_data.T_linear);
+        hash_combine_fnv1a(rr_graph_hash, indexed_data.base_cost);
+    }
+
+    std::stringstream lookahead_inputs;
+    lookahead_inputs << "device=" << device_ctx.grid.width() << "x" << device_ctx.grid.height() << "\n";
+    lookahead_inputs << "segments=" << num_segments << "\n";
+    lookahead_inputs << "rr_graph=" << rr_graph.nodes().size() << "," << rr_graph.edges().size() << "," << std::hex << rr_graph_hash << std::dec << "\n";
+    lookahead_inputs << "ref=" << REF_X << "," << REF_Y << "," << MAX_TRACK_OFFSET << "," << REPRESENTATIVE_ENTRY_METHOD << "\n";
+
+    return vtr::secure_digest_stream(lookahead_inputs);
+}
+
+// When writing capnp targetted serialization, always allow compilation when
+// VTR_ENABLE_CAPNPROTO=OFF.  Generally this means throwing an exception
+// instead.
+//
+#ifndef VTR_ENABLE_CAPNPROTO
+
+#    define DISABLE_ERROR                              \
+        "is disable because VTR_ENABLE_CAPNPROTO=OFF." \
+        "Re-compile with CMake option VTR_ENABLE_CAPNPROTO=ON to enable."
+
+static bool load_cost_map(const std::string& /*file*/, const std::string& /*lookahead_id*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::read " DISABLE_ERROR);
+}
+
+static void save_cost_map(const std::string& /*file*/, const std::string& /*lookahead_id*/) {
+    VPR_THROW(VPR_ERROR_ROUTE, "MapLookahead::write " DISABLE_ERROR);
+}
+
+#else /* VTR_ENABLE_CAPNPROTO */
+
+static void ToCostEntry(Cost_Entry* out, const VprCostEntry::Reader& in) {
+    out->delay = in.getDelay();
+    out->congestion = in.getCongestion();
+}
+
+static void FromCostEntry(VprCostEntry::Builder* out, const Cost_Entry& in) {
+    out->setDelay(in.delay);
+    out->setCongestion(in.congestion);
+}
+
+static bool load_cost_map(const std::string& file, const std::string& lookahead_id) {
+    if (!vtr::file_exists(file.c_str())) {
+        return false;
+    }
+
+    vtr::ScopedStartFinishTimer timer("Read router lookahead map from '" + file + "'");
+
+    MmapFile f(file);
+
+    /* The cost map of a large device easily exceeds the default traversal limit */
+    ::capnp::ReaderOptions options;
+    options.traversalLimitInWords = std::numeric_limits<uint64_t>::max();
+    ::capnp::FlatArrayMessageReader reader(f.getData(), options);
+
+    auto lookahead = reader.getRoot<VprMapLookahead>();
+    if (!lookahead_id.empty() && lookahead_id != std::string(lookahead.getId().cStr())) {
+        VTR_LOG_WARN("Router lookahead map '%s' is computed from a different rr graph!\n",
+                     file.c_str());
+        return false;
+    }
+
+    t_cost_map cost_map;
+    ToNdMatrix<4, VprCostEntry, Cost_Entry>(&cost_map, lookahead.getCostMap(), ToCostEntry);
+
+    /* The map must cover all the segments and relative coordinates queried by the router */
+    auto& device_ctx = g_vpr_ctx.device();
+    int max_seg_index = -1;
+    for (const t_rr_indexed_data& indexed_data : device_ctx.rr_indexed_data) {
+        max_seg_index = std::max(max_seg_index, indexed_data.seg_index);
+    }
+    if (cost_map.dim_size(0) != 2
+        || int(cost_map.dim_size(1)) <= max_seg_index
+        || cost_map.dim_size(2) != device_ctx.grid.width()
+        || cost_map.dim_size(3) != device_ctx.grid.height()) {
+        VTR_LOG_WARN("Router lookahead map '%s' does not fit the device!\n",
+                     file.c_str());
+        return false;
+    }
+
+    f_cost_map = std::move(cost_map);
+
+    return true;
+}
+
+static void save_cost_map(const std::string& file, const std::string& lookahead_id) {
+    vtr::ScopedStartFinishTimer timer("Write router lookahead map to '" + file + "'");
+
+    ::capnp::MallocMessageBuilder builder;
+    auto lookahead = builder.initRoot<VprMapLookahead>();
+    lookahead.setId(lookahead_id);
+
+    auto cost_map = lookahead.getCostMap();
+    FromNdMatrix<4, VprCostEntry, Cost_Entry>(&cost_map, f_cost_map, FromCostEntry);
+
+    writeMessageToFile(file, &builder);
+}
+
+#endif /* VTR_ENABLE_CAPNPROTO */
@@ -1,8 +1,19 @@
 #pragma once
 
+#include <string>
+
 /* Computes the lookahead map to be used by the router. If a map was computed prior to this, a new one will not be computed again.
- * The rr graph must have been built before calling this function. */
-void compute_router_lookahead(int num_segments);
+ * The rr graph must have been built before calling this function.
+ * When a cache file is given, the map is loaded from it if it was computed from the same rr graph,
+ * otherwise the map is computed and written to the cache file.
+ * The expansions are run with the given number of threads (0 means all the cores). */
+void compute_router_lookahead(int num_segments, const std::string& lookahead_cache_file, size_t num_threads);
+
+/* Reads the lookahead map from the specified file instead of computing it */
+void read_router_lookahead(const std::string& file);
+
+/* Writes the lookahead map to the specified file */
+void write_router_lookahead(const std::string& file);
 
 /* queries the lookahead_map (should have been computed prior to routing) to get the expected cost
  * from the specified source to the specified target */
@@ -277,6 +277,7 @@ static void build_rr_graph(const t_graph_type graph_type,
                            const t_direct_inf* directs,
                            const int num_directs,
                            int* wire_to_rr_ipin_switch,
+                           const e_check_level check_level,
                            int* Warnings);
 
 /******************* Subroutine definitions *******************************/
@@ -306,7 +307,8 @@ void create_rr_graph(const t_graph_type graph_type,
                          segment_inf,
                          base_cost_type,
                          &det_routing_arch->wire_to_rr_ipin_switch,
-                         det_routing_arch->read_rr_graph_filename.c_str());
+                         det_routing_arch->read_rr_graph_filename.c_str(),
+                         det_routing_arch->check_level);
 
             /* Xifan Tang - Create rr_graph object: load rr_nodes to the object */
             //convert_rr_graph(segment_inf);
@@ -321,6 +323,10 @@ void create_rr_graph(const t_graph_type graph_type,
         free_rr_graph();
 
         if (GRAPH_UNIDIR_TILEABLE != graph_type) {
+            if (!det_routing_arch->rr_graph_cache_filename.empty()) {
+                VTR_LOG_WARN("Binary rr_graph cache '%s' is only applicable to tileable routing architectures and is ignored\n",
+                             det_routing_arch->rr_graph_cache_filename.c_str());
+            }
             build_rr_graph(graph_type,
                            block_types,
                            grid,
@@ -340,6 +346,7 @@ void create_rr_graph(const t_graph_type graph_type,
                            trim_obs_channels,
                            directs, num_directs,
                            &det_routing_arch->wire_to_rr_ipin_switch,
+                           det_routing_arch->check_level,
                            Warnings);
 
           if (clock_modeling == DEDICATED_NETWORK) {
@@ -368,6 +375,9 @@ void create_rr_graph(const t_graph_type graph_type,
                                                     &det_routing_arch->wire_to_rr_ipin_switch,
                                                     trim_obs_channels, /* Allow/Prohibit through tracks across multi-height and multi-width grids */
                                                     false, /* Do not allow passing tracks to be wired to the same routing channels */
+                                                    det_routing_arch->rr_graph_cache_filename,
+                                                    det_routing_arch->num_workers,
+                                                    det_routing_arch->check_level,
                                                     Warnings);
         }
 
@@ -379,14 +389,19 @@ void create_rr_graph(const t_graph_type graph_type,
 
     print_rr_graph_stats();
 
+    /* The graph is complete, switch it to the compact storage for routing */
+    if (true == det_routing_arch->freeze_rr_graph) {
+        g_vpr_ctx.mutable_device().rr_graph.freeze();
+    }
+
     //Write out rr graph file if needed
     if (!det_routing_arch->write_rr_graph_filename.empty()) {
-        write_rr_graph(det_routing_arch->write_rr_graph_filename.c_str(), segment_inf);
+        write_rr_graph(det_routing_arch->write_rr_graph_filename.c_str(), segment_inf, det_routing_arch->num_workers);
 
         /* Just to test the writer of rr_graph_obj, give a filename in a fixed style*/
         std::string rr_graph_obj_filename(det_routing_arch->write_rr_graph_filename);
         rr_graph_obj_filename += std::string(".obj");
-        write_xml_rr_graph_obj(rr_graph_obj_filename.c_str(), device_ctx.rr_graph);
+        write_xml_rr_graph_obj(rr_graph_obj_filename.c_str(), device_ctx.rr_graph, det_routing_arch->num_workers);
     }
 }
 
@@ -431,6 +446,7 @@ static void build_rr_graph(const t_graph_type graph_type,
                            const t_direct_inf* directs,
                            const int num_directs,
                            int* wire_to_rr_ipin_switch,
+                           const e_check_level check_level,
                            int* Warnings) {
     vtr::ScopedStartFinishTimer timer("Build routing resource graph");
 
@@ -781,9 +797,9 @@ static void build_rr_graph(const t_graph_type graph_type,
                   "Fundamental errors occurred when validating rr_graph object!\n");
     }
 
-    check_rr_graph(graph_type, grid, types);
+    check_rr_graph(graph_type, grid, types, check_level);
     /* Error out if advanced checker of rr_graph fails */
-    if (false == check_rr_graph(device_ctx.rr_graph)) {
+    if (false == check_rr_graph(device_ctx.rr_graph, check_level)) {
         vpr_throw(VPR_ERROR_ROUTE,
                   __FILE__,
                   __LINE__,
@@ -15,7 +15,10 @@
 
 #include <string.h>
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <sstream>
 #include <utility>
 
@@ -29,6 +32,7 @@
 
 #include "pugixml.hpp"
 #include "pugixml_util.hpp"
+#include "openfpga_gzip_stream.h"
 #include "read_xml_arch_file.h"
 #include "read_xml_util.h"
 #include "globals.h"
@@ -50,13 +54,29 @@
 #include "rr_graph_reader.h"
 
 /*********************** Subroutines local to this module *******************/
+//An edge of the <rr_edges> section, as read from the file
+struct t_rr_edge_record {
+    RRNodeId src_node;
+    RRNodeId sink_node;
+    int switch_id;
+};
+
+//A <meta> of an edge, as read from the file
+struct t_rr_edge_meta_record {
+    size_t edge_index; //Index of the edge in the list of edge records
+    std::string key;
+    std::string value;
+};
+
+bool stream_rr_edges(std::vector<char>& buffer, std::vector<t_rr_edge_record>& edges, std::vector<t_rr_edge_meta_record>& edge_metas);
+void read_rr_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, std::vector<t_rr_edge_record>& edges, std::vector<t_rr_edge_meta_record>& edge_metas);
 void process_switches(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
 void verify_segments(pugi::xml_node parent, const pugiutil::loc_data& loc_data, const std::vector<t_segment_inf>& segment_inf);
 void verify_blocks(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
 void process_blocks(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
 void verify_grid(pugi::xml_node parent, const pugiutil::loc_data& loc_data, const DeviceGrid& grid);
 void process_nodes(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
-void process_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, int* wire_to_rr_ipin_switch, const int num_rr_switches);
+void process_edges(const std::vector<t_rr_edge_record>& edges, const std::vector<t_rr_edge_meta_record>& edge_metas, int* wire_to_rr_ipin_switch, const int num_rr_switches);
 void process_channels(t_chan_width& chan_width, const DeviceGrid& grid, pugi::xml_node parent, const pugiutil::loc_data& loc_data);
 void process_rr_node_indices(const DeviceGrid& grid);
 void process_seg_id(pugi::xml_node parent, const pugiutil::loc_data& loc_data);
@@ -72,24 +92,55 @@ void load_rr_file(const t_graph_type graph_type,
                   const std::vector<t_segment_inf>& segment_inf,
                   const enum e_base_cost_type base_cost_type,
                   int* wire_to_rr_ipin_switch,
-                  const char* read_rr_graph_name) {
+                  const char* read_rr_graph_name,
+                  const e_check_level check_level) {
     vtr::ScopedStartFinishTimer timer("Loading routing resource graph");
 
     const char* Prop;
     pugi::xml_node next_component;
 
+    //Contents of the file, which are parsed in place by the document
+    std::vector<char> buffer;
     pugi::xml_document doc;
     pugiutil::loc_data loc_data;
 
-    if (vtr::check_file_name_extension(read_rr_graph_name, ".xml") == false) {
+    //The edges, if they are streamed from the file rather than loaded in the document
+    std::vector<t_rr_edge_record> edges;
+    std::vector<t_rr_edge_meta_record> edge_metas;
+    bool edges_streamed = false;
+
+    //A file written with the .gz extension is compressed in gzip format (see write_rr_graph)
+    bool compressed = vtr::check_file_name_extension(read_rr_graph_name, ".xml.gz");
+    if (vtr::check_file_name_extension(read_rr_graph_name, ".xml") == false && compressed == false) {
         VTR_LOG_WARN(
             "RR graph file '%s' may be in incorrect format. "
-            "Expecting .xml format\n",
+            "Expecting .xml or .xml.gz format\n",
             read_rr_graph_name);
     }
     try {
-        //parse the file
-        loc_data = pugiutil::load_xml(doc, read_rr_graph_name);
+        //Read the file
+        if (compressed) {
+            if (!openfpga::read_gzip_file(std::string(read_rr_graph_name), buffer)) {
+                throw pugiutil::XmlError("Unable to decompress XML file '" + std::string(read_rr_graph_name) + "'", read_rr_graph_name);
+            }
+        } else {
+            std::ifstream file(read_rr_graph_name, std::ios::binary);
+            if (!file) {
+                throw pugiutil::XmlError("Unable to open XML file '" + std::string(read_rr_graph_name) + "'", read_rr_graph_name);
+            }
+            file.seekg(0, std::ios::end);
+            buffer.resize(file.tellg());
+            file.seekg(0, std::ios::beg);
+            file.read(buffer.data(), buffer.size());
+            file.close();
+        }
+
+        //The edges are most of the file: they are streamed into compact records,
+        //and left out of the document, which would take several times more memory
+        edges_streamed = stream_rr_edges(buffer, edges, edge_metas);
+
+        //parse the rest of the file
+        loc_data = pugiutil::load_xml_inplace(doc, read_rr_graph_name, buffer.data(), buffer.size());
 
         auto& device_ctx = g_vpr_ctx.mutable_device();
 
@@ -162,7 +213,13 @@ void load_rr_file(const t_graph_type graph_type,
         process_switches(next_component, loc_data);
 
         next_component = get_single_child(rr_graph, "rr_edges", loc_data);
-        process_edges(next_component, loc_data, wire_to_rr_ipin_switch, numSwitches);
+        if (!edges_streamed) {
+            read_rr_edges(next_component, loc_data, edges, edge_metas);
+        }
+        process_edges(edges, edge_metas, wire_to_rr_ipin_switch, numSwitches);
+        edges.clear();
+        edges.shrink_to_fit();
+        edge_metas.clear();
 
         //Partition the rr graph edges for efficient access to configurable/non-configurable
         //edge subsets. Must be done after RR switches have been allocated
@@ -190,9 +247,9 @@ void load_rr_file(const t_graph_type graph_type,
         device_ctx.chan_width = nodes_per_chan;
         device_ctx.read_rr_graph_filename = std::string(read_rr_graph_name);
 
-        check_rr_graph(graph_type, grid, device_ctx.physical_tile_types);
+        check_rr_graph(graph_type, grid, device_ctx.physical_tile_types, check_level);
         /* Error out if advanced checker of rr_graph fails */
-        if (false == check_rr_graph(device_ctx.rr_graph)) {
+        if (false == check_rr_graph(device_ctx.rr_graph, check_level)) {
             vpr_throw(VPR_ERROR_ROUTE,
                       __FILE__,
                       __LINE__,
@@ -417,21 +474,382 @@ void process_nodes(pugi::xml_node parent, const pugiutil::loc_data& loc_data) {
     }
 }
 
+/* A minimal scanner of the <rr_edges> section of a rr graph file, which only
+ * accepts the format written by write_rr_graph (edges with optional metadata,
+ * and comments). Any other construct makes the caller fall back to the document,
+ * which reports the errors with their line numbers.
+ */
+class RREdgeScanner {
+  public:
+    RREdgeScanner(const char* begin, const char* end)
+        : pos_(begin)
+        , end_(end) {}
+
+    //Reads all the edges of the section, or returns false if the section is not
+    //in the expected format
+    bool scan(std::vector<t_rr_edge_record>& edges, std::vector<t_rr_edge_meta_record>& edge_metas) {
+        while (skip_misc()) {
+            if (!starts_with_tag("edge")) {
+                return false;
+            }
+            t_rr_edge_record edge;
+            bool has_src = false, has_sink = false, has_switch = false;
+            bool empty_tag = false;
+            std::string name, value;
+            while (scan_attribute(name, value, empty_tag)) {
+                unsigned long number = 0;
+                if (name == "src_node") {
+                    has_src = to_uint(value, number);
+                    edge.src_node = RRNodeId(number);
+                } else if (name == "sink_node") {
+                    has_sink = to_uint(value, number);
+                    edge.sink_node = RRNodeId(number);
+                } else if (name == "switch_id") {
+                    has_switch = to_uint(value, number) && number <= size_t(std::numeric_limits<int>::max());
+                    edge.switch_id = number;
+                }
+            }
+            if (failed_ || !has_src || !has_sink || !has_switch) {
+                return false;
+            }
+            edges.push_back(edge);
+
+            if (!empty_tag && !scan_edge_children(edges.size() - 1, edge_metas)) {
+                return false;
+            }
+        }
+        return !failed_;
+    }
+
+  private:
+    //Skips white spaces and comments, and returns false at the end of the section
+    bool skip_misc() {
+        while (pos_ < end_) {
+            if (is_space(*pos_)) {
+                ++pos_;
+            } else if (starts_with("<!--")) {
+                const char* comment_end = find("-->");
+                if (!comment_end) {
+                    failed_ = true;
+                    return false;
+                }
+                pos_ = comment_end + 3;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //Consumes the opening of a tag, e.g., '<edge'
+    bool starts_with_tag(const char* tag) {
+        size_t len = strlen(tag);
+        if (*pos_ != '<' || size_t(end_ - pos_) < len + 2 || strncmp(pos_ + 1, tag, len) != 0) {
+            return false;
+        }
+        char next = pos_[len + 1];
+        if (!is_space(next) && next != '>' && next != '/') {
+            return false;
+        }
+        pos_ += len + 1;
+        return true;
+    }
+
+    //Consumes a closing tag, e.g., '</edge>'
+    bool closes_tag(const char* tag) {
+        size_t len = strlen(tag);
+        if (size_t(end_ - pos_) < len + 3 || strncmp(pos_, "</", 2) != 0 || strncmp(pos_ + 2, tag, len) != 0) {
+            return false;
+        }
+        pos_ += len + 2;
+        skip_spaces();
+        if (pos_ >= end_ || *pos_ != '>') {
+            failed_ = true;
+            return false;
+        }
+        ++pos_;
+        return true;
+    }
+
+    //Reads the next attribute of the current tag, or returns false at the end of
+    //the tag (telling if it is an empty tag, i.e. '/>')
+    bool scan_attribute(std::string& name, std::string& value, bool& empty_tag) {
+        skip_spaces();
+        if (pos_ >= end_) {
+            failed_ = true;
+            return false;
+        }
+        if (*pos_ == '>') {
+            ++pos_;
+            empty_tag = false;
+            return false;
+        }
+        if (*pos_ == '/') {
+            if (pos_ + 1 >= end_ || pos_[1] != '>') {
+                failed_ = true;
+                return false;
+            }
+            pos_ += 2;
+            empty_tag = true;
+            return false;
+        }
+        const char* name_begin = pos_;
+        while (pos_ < end_ && !is_space(*pos_) && *pos_ != '=' && *pos_ != '>' && *pos_ != '/') {
+            ++pos_;
+        }
+        name.assign(name_begin, pos_);
+        skip_spaces();
+        if (name.empty() || pos_ >= end_ || *pos_ != '=') {
+            failed_ = true;
+            return false;
+        }
+        ++pos_;
+        skip_spaces();
+        if (pos_ >= end_ || (*pos_ != '"' && *pos_ != '\'')) {
+            failed_ = true;
+            return false;
+        }
+        char quote = *pos_++;
+        const char* value_begin = pos_;
+        while (pos_ < end_ && *pos_ != quote) {
+            ++pos_;
+        }
+        if (pos_ >= end_) {
+            failed_ = true;
+            return false;
+        }
+        if (!decode_text(value_begin, pos_, value)) {
+            failed_ = true;
+            return false;
+        }
+        ++pos_;
+        return true;
+    }
+
+    //Reads the <metadata> of an edge, up to its closing tag
+    bool scan_edge_children(size_t edge_index, std::vector<t_rr_edge_meta_record>& edge_metas) {
+        bool has_metadata = false;
+        while (skip_misc()) {
+            if (closes_tag("edge")) {
+                return true;
+            }
+            if (failed_ || has_metadata || !starts_with_tag("metadata")) {
+                return false;
+            }
+            has_metadata = true;
+
+            std::string name, value;
+            bool empty_tag = false;
+            if (scan_attribute(name, value, empty_tag) || failed_) {
+                return false;
+            }
+            if (empty_tag) {
+                continue;
+            }
+            while (skip_misc()) {
+                if (closes_tag("metadata")) {
+                    break;
+                }
+                if (failed_ || !starts_with_tag("meta") || !scan_meta(edge_index, edge_metas)) {
+                    return false;
+                }
+            }
+            if (failed_) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    //Reads a <meta name="key">value</meta>, after its opening '<meta'
+    bool scan_meta(size_t edge_index, std::vector<t_rr_edge_meta_record>& edge_metas) {
+        t_rr_edge_meta_record meta;
+        meta.edge_index = edge_index;
+        bool has_name = false;
+        bool empty_tag = false;
+        std::string name, value;
+        while (scan_attribute(name, value, empty_tag)) {
+            if (name == "name") {
+                meta.key = value;
+                has_name = true;
+            }
+        }
+        if (failed_ || !has_name) {
+            return false;
+        }
+        if (!empty_tag) {
+            const char* text_begin = pos_;
+            while (pos_ < end_ && *pos_ != '<') {
+                ++pos_;
+            }
+            if (!decode_text(text_begin, pos_, meta.value) || !closes_tag("meta")) {
+                return false;
+            }
+        }
+        edge_metas.push_back(meta);
+        return true;
+    }
+
+    //Decodes the predefined entities of a text, as the document does
+    static bool decode_text(const char* begin, const char* end, std::string& text) {
+        text.clear();
+        for (const char* c = begin; c < end; ++c) {
+            if (*c == '<') {
+                return false;
+            }
+            if (*c != '&') {
+                text.push_back(*c);
+                continue;
+            }
+            static const std::pair<const char*, char> entities[] = {{"&lt;", '<'}, {"&gt;", '>'}, {"&amp;", '&'}, {"&apos;", '\''}, {"&quot;", '"'}};
+            bool decoded = false;
+            for (const auto& entity : entities) {
+                size_t len = strlen(entity.first);
+                if (size_t(end - c) >= len && strncmp(c, entity.first, len) == 0) {
+                    text.push_back(entity.second);
+                    c += len - 1;
+                    decoded = true;
+                    break;
+                }
+            }
+            if (!decoded) {
+                //Character references are left to the document
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool to_uint(const std::string& value, unsigned long& number) {
+        if (value.empty() || !std::isdigit(static_cast<unsigned char>(value[0]))) {
+            return false;
+        }
+        char* value_end = nullptr;
+        number = std::strtoul(value.c_str(), &value_end, 10);
+        return *value_end == '\0';
+    }
+
+    static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    void skip_spaces() {
+        while (pos_ < end_ && is_space(*pos_)) {
+            ++pos_;
+        }
+    }
+
+    bool starts_with(const char* str) const {
+        size_t len = strlen(str);
+        return size_t(end_ - pos_) >= len && strncmp(pos_, str, len) == 0;
+    }
+
+    const char* find(const char* str) const {
+        const char* found = std::search(pos_, end_, str, str + strlen(str));
+        return (found == end_) ? nullptr : found;
+    }
+
+  private:
+    const char* pos_;
+    const char* end_;
+    bool failed_ = false;
+};
+
+/* Streams the edges of the <rr_edges> section of the contents of a rr graph file
+ * into edge records. The section is then blanked in the buffer (keeping its line
+ * breaks, so that the line numbers of the document are unchanged), so that the
+ * document does not hold the edges.
+ * Returns false, without changing the buffer, if the section is not found or
+ * is not in the format written by write_rr_graph: the edges are then read
+ * from the document.
+ */
+bool stream_rr_edges(std::vector<char>& buffer, std::vector<t_rr_edge_record>& edges, std::vector<t_rr_edge_meta_record>& edge_metas) {
+    const char* begin = buffer.data();
+    const char* end = buffer.data() + buffer.size();
+
+    //Find the opening and closing tags of the section
+    const std::string open_tag = "<rr_edges";
+    const char* section_begin = begin;
+    while (true) {
+        section_begin = std::search(section_begin, end, open_tag.begin(), open_tag.end());
+        if (section_begin == end) {
+            return false;
+        }
+        section_begin += open_tag.size();
+        if (section_begin < end && (*section_begin == '>' || *section_begin == ' ' || *section_begin == '\t' || *section_begin == '\n' || *section_begin == '\r')) {
+            break;
+        }
+    }
+    section_begin = std::find(section_begin, end, '>');
+    if (section_begin == end || *(section_begin - 1) == '/') {
+        //An empty section is left to the document
+        return false;
+    }
+    ++section_begin;
+
+    const std::string close_tag = "</rr_edges";
+    const char* section_end = std::search(section_begin, end, close_tag.begin(), close_tag.end());
+    if (section_end == end) {
+        return false;
+    }
+
+    //A section without edges is left to the document, which reports it
+    RREdgeScanner scanner(section_begin, section_end);
+    if (!scanner.scan(edges, edge_metas) || edges.empty()) {
+        edges.clear();
+        edge_metas.clear();
+        return false;
+    }
+
+    for (char* c = buffer.data() + (section_begin - begin); c < buffer.data() + (section_end - begin); ++c) {
+        if (*c != '\n' && *c != '\r') {
+            *c = ' ';
+        }
+    }
+
+    return true;
+}
+
+/* Reads the edges of the <rr_edges> section of the document into edge records */
+void read_rr_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, std::vector<t_rr_edge_record>& edges, std::vector<t_rr_edge_meta_record>& edge_metas) {
+    pugi::xml_node edge_node = get_first_child(parent, "edge", loc_data);
+    while (edge_node) {
+        t_rr_edge_record edge;
+        edge.src_node = RRNodeId(get_attribute(edge_node, "src_node", loc_data).as_uint());
+        edge.sink_node = RRNodeId(get_attribute(edge_node, "sink_node", loc_data).as_uint());
+        edge.switch_id = get_attribute(edge_node, "switch_id", loc_data).as_int();
+        edges.push_back(edge);
+
+        // Read the metadata for the edge
+        auto metadata = get_single_child(edge_node, "metadata", loc_data, pugiutil::OPTIONAL);
+        if (metadata) {
+            auto edges_meta = get_first_child(metadata, "meta", loc_data);
+            while (edges_meta) {
+                t_rr_edge_meta_record meta;
+                meta.edge_index = edges.size() - 1;
+                meta.key = get_attribute(edges_meta, "name", loc_data).as_string();
+                meta.value = edges_meta.child_value();
+                edge_metas.push_back(meta);
+
+                edges_meta = edges_meta.next_sibling(edges_meta.name());
+            }
+        }
+
+        edge_node = edge_node.next_sibling(edge_node.name()); //Next edge
+    }
+}
+
 /*Loads the edges information from file into vpr. Nodes and switches must be loaded
  * before calling this function*/
-void process_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, int* wire_to_rr_ipin_switch, const int num_rr_switches) {
+void process_edges(const std::vector<t_rr_edge_record>& edges, const std::vector<t_rr_edge_meta_record>& edge_metas, int* wire_to_rr_ipin_switch, const int num_rr_switches) {
     auto& device_ctx = g_vpr_ctx.mutable_device();
-    pugi::xml_node edges;
 
-    edges = get_first_child(parent, "edge", loc_data);
     //count the number of edges and store it in a vector
     vtr::vector<RRNodeId, size_t> num_edges_for_node;
     num_edges_for_node.resize(device_ctx.rr_graph.nodes().size(), 0);
 
-    unsigned long num_edges_to_reserve = 0;
-
-    while (edges) {
-        RRNodeId source_node = RRNodeId(get_attribute(edges, "src_node", loc_data).as_uint());
+    for (const t_rr_edge_record& edge : edges) {
+        RRNodeId source_node = edge.src_node;
         if (false == device_ctx.rr_graph.valid_node_id(source_node)) {
             VPR_FATAL_ERROR(VPR_ERROR_OTHER,
                             "source_node %d is larger than rr_nodes.size() %d",
@@ -439,11 +857,8 @@ void process_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, in
         }
 
         num_edges_for_node[source_node]++;
-        num_edges_to_reserve++;
-        edges = edges.next_sibling(edges.name());
     }
 
-    //reset this vector in order to start count for num edges again
     for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
         /* uint16_t is the data type for each type of edges in RRGraph object 
          * Multiplied by 4 is due to the fact that each node has 4 groups of edges
@@ -455,13 +870,12 @@ void process_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, in
                             "source node %d edge count %d is too high",
                             size_t(inode), num_edges_for_node[inode]);
         }
-        num_edges_for_node[inode] = 0;
     }
+    num_edges_for_node.clear();
 
     /* Reserve the memory for edges */
-    device_ctx.rr_graph.reserve_edges(num_edges_to_reserve);
+    device_ctx.rr_graph.reserve_edges(edges.size());
 
-    edges = get_first_child(parent, "edge", loc_data);
     /*initialize a vector that keeps track of the number of wire to ipin switches
      * There should be only one wire to ipin switch. In case there are more, make sure to
      * store the most frequent switch */
@@ -470,10 +884,12 @@ void process_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, in
     //first is index, second is count
     std::pair<int, int> most_frequent_switch(-1, 0);
 
-    while (edges) {
-        RRNodeId source_node = RRNodeId(get_attribute(edges, "src_node", loc_data).as_uint());
-        RRNodeId sink_node = RRNodeId(get_attribute(edges, "sink_node", loc_data).as_uint());
-        int switch_id = get_attribute(edges, "switch_id", loc_data).as_int();
+    //The metadata records are in the order of their edges
+    size_t imeta = 0;
+    for (size_t iedge = 0; iedge < edges.size(); ++iedge) {
+        RRNodeId source_node = edges[iedge].src_node;
+        RRNodeId sink_node = edges[iedge].sink_node;
+        int switch_id = edges[iedge].switch_id;
 
         if (false == device_ctx.rr_graph.valid_node_id(sink_node)) {
             VPR_FATAL_ERROR(VPR_ERROR_OTHER,
@@ -501,25 +917,13 @@ void process_edges(pugi::xml_node parent, const pugiutil::loc_data& loc_data, in
         //set edge in correct rr_node data structure
         device_ctx.rr_graph.create_edge(source_node, sink_node, RRSwitchId(switch_id));
 
-        // Read the metadata for the edge
-        auto metadata = get_single_child(edges, "metadata", loc_data, pugiutil::OPTIONAL);
-        if (metadata) {
-            auto edges_meta = get_first_child(metadata, "meta", loc_data);
-            while (edges_meta) {
-                auto key = get_attribute(edges_meta, "name", loc_data).as_string();
-
-                vpr::add_rr_edge_metadata(size_t(source_node), size_t(sink_node), switch_id,
-                                          key, edges_meta.child_value());
-
-                edges_meta = edges_meta.next_sibling(edges_meta.name());
-            }
+        // Load the metadata for the edge
+        for (; imeta < edge_metas.size() && edge_metas[imeta].edge_index == iedge; ++imeta) {
+            vpr::add_rr_edge_metadata(size_t(source_node), size_t(sink_node), switch_id,
+                                      edge_metas[imeta].key, edge_metas[imeta].value);
         }
-        num_edges_for_node[source_node]++;
-
-        edges = edges.next_sibling(edges.name()); //Next edge
     }
     *wire_to_rr_ipin_switch = most_frequent_switch.first;
-    num_edges_for_node.clear();
     count_for_wire_to_ipin_switches.clear();
 }
 
@@ -5,11 +5,18 @@
  * children tags such as timing, location, or some general
  * details. Each tag has attributes to describe them */
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
 #include <string.h>
 #include <iomanip>
 #include <limits>
+#include <memory>
+#include "vtr_util.h"
+#include "openfpga_gzip_stream.h"
+#include "openfpga_parallel.h"
 #include "vpr_error.h"
 #include "globals.h"
 #include "read_xml_arch_file.h"
@@ -22,26 +29,38 @@
  * float -> string -> float conversions */
 constexpr int FLOAT_PRECISION = std::numeric_limits<float>::max_digits10;
 /*********************** Subroutines local to this module *******************/
-void write_rr_channel(std::fstream& fp);
-void write_rr_node(std::fstream& fp);
-void write_rr_switches(std::fstream& fp);
-void write_rr_grid(std::fstream& fp);
-void write_rr_edges(std::fstream& fp);
-void write_rr_block_types(std::fstream& fp);
-void write_rr_segments(std::fstream& fp, const std::vector<t_segment_inf>& segment_inf);
+void write_rr_channel(std::ostream& fp);
+void write_rr_node(std::ostream& fp, const size_t& num_threads);
+void write_rr_switches(std::ostream& fp);
+void write_rr_grid(std::ostream& fp);
+void write_rr_edges(std::ostream& fp, const size_t& num_threads);
+void write_rr_graph_items(std::ostream& fp, const size_t& num_items, const size_t& num_threads, const std::function<void(std::ostream&, const size_t&)>& write_item);
+void write_rr_block_types(std::ostream& fp);
+void write_rr_segments(std::ostream& fp, const std::vector<t_segment_inf>& segment_inf);
 
 /************************ Subroutine definitions ****************************/
 
-/* This function is used to write the rr_graph into xml format into a a file with name: file_name */
-void write_rr_graph(const char* file_name, const std::vector<t_segment_inf>& segment_inf) {
-    std::fstream fp;
-    fp.open(file_name, std::fstream::out | std::fstream::trunc);
+/* This function is used to write the rr_graph into xml format into a a file with name: file_name
+ * The file is compressed in gzip format if its name ends with ".gz" */
+void write_rr_graph(const char* file_name, const std::vector<t_segment_inf>& segment_inf, const size_t& num_threads) {
+    bool compress = vtr::check_file_name_extension(file_name, ".gz");
+
+    std::fstream file;
+    file.open(file_name, std::fstream::out | std::fstream::trunc | std::fstream::binary);
 
     /* Prints out general info for easy error checking*/
-    if (!fp.is_open() || !fp.good()) {
+    if (!file.is_open() || !file.good()) {
         VPR_FATAL_ERROR(VPR_ERROR_OTHER,
                         "couldn't open file \"%s\" for generating RR graph file\n", file_name);
     }
+
+    /* The sections are written to the file directly, or through a gzip compressor */
+    std::unique_ptr<openfpga::GzipStreamBuffer> gzip_buffer;
+    if (compress) {
+        gzip_buffer = std::unique_ptr<openfpga::GzipStreamBuffer>(new openfpga::GzipStreamBuffer(file, num_threads));
+    }
+    std::ostream fp(compress ? static_cast<std::streambuf*>(gzip_buffer.get()) : file.rdbuf());
+
     std::cout << "Writing RR graph" << std::endl;
     fp << "<rr_graph tool_name=\"vpr\" tool_version=\"" << vtr::VERSION << "\" tool_comment=\"Generated from arch file "
        << get_arch_file_name() << "\">" << std::endl;
@@ -52,34 +71,67 @@ void write_rr_graph(const char* file_name, const std::vector<t_segment_inf>& seg
     write_rr_segments(fp, segment_inf);
     write_rr_block_types(fp);
     write_rr_grid(fp);
-    write_rr_node(fp);
-    write_rr_edges(fp);
+    write_rr_node(fp, num_threads);
+    write_rr_edges(fp, num_threads);
     fp << "</rr_graph>";
 
-    fp.close();
+    if (compress && !gzip_buffer->finish()) {
+        VPR_FATAL_ERROR(VPR_ERROR_OTHER,
+                        "couldn't compress RR graph file \"%s\"\n", file_name);
+    }
+    file.close();
 
     std::cout << "Finished generating RR graph file named " << file_name << std::endl
               << std::endl;
 }
 
-static void add_metadata_to_xml(std::fstream& fp, const char* tab_prefix, const t_metadata_dict& meta) {
-    fp << tab_prefix << "<metadata>" << std::endl;
+static void add_metadata_to_xml(std::ostream& fp, const char* tab_prefix, const t_metadata_dict& meta) {
+    fp << tab_prefix << "<metadata>" << '\n';
 
     for (const auto& meta_elem : meta) {
         const std::string& key = meta_elem.first;
         const std::vector<t_metadata_value>& values = meta_elem.second;
         for (const auto& value : values) {
             fp << tab_prefix << "\t<meta name=\"" << key << "\"";
-            fp << ">" << value.as_string() << "</meta>" << std::endl;
+            fp << ">" << value.as_string() << "</meta>" << '\n';
+        }
+    }
+    fp << tab_prefix << "</metadata>" << '\n';
+}
+
+/* Writes the items (e.g., nodes or edges) of a section of the rr graph in their
+ * order, where write_item formats an item into a stream.
+ * The items are formatted by chunks in parallel, into buffers which are then
+ * written in order. The buffers are written by batches, so that only a few
+ * chunks are held in memory at a time */
+void write_rr_graph_items(std::ostream& fp, const size_t& num_items, const size_t& num_threads, const std::function<void(std::ostream&, const size_t&)>& write_item) {
+    constexpr size_t CHUNK_SIZE = 4096;
+    size_t num_chunks = (num_items + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    size_t num_workers = openfpga::find_num_threads(num_threads);
+    size_t batch_size = 4 * num_workers;
+
+    std::vector<std::string> buffers(std::min(batch_size, num_chunks));
+    for (size_t first_chunk = 0; first_chunk < num_chunks; first_chunk += batch_size) {
+        size_t num_batch_chunks = std::min(batch_size, num_chunks - first_chunk);
+        openfpga::parallel_for(num_batch_chunks, num_workers, [&](const size_t& ichunk) {
+            std::ostringstream chunk_stream;
+            size_t begin = (first_chunk + ichunk) * CHUNK_SIZE;
+            size_t end = std::min(num_items, begin + CHUNK_SIZE);
+            for (size_t iitem = begin; iitem < end; ++iitem) {
+                write_item(chunk_stream, iitem);
+            }
+            buffers[ichunk] = chunk_stream.str();
+        });
+        for (size_t ichunk = 0; ichunk < num_batch_chunks; ++ichunk) {
+            fp.write(buffers[ichunk].data(), buffers[ichunk].size());
         }
     }
-    fp << tab_prefix << "</metadata>" << std::endl;
 }
 
 /* Channel info in device_ctx.chan_width is written in xml format.
  * A general summary of the min and max values of the channels are first printed. Every
  * x and y channel list is printed out in its own attribute*/
-void write_rr_channel(std::fstream& fp) {
+void write_rr_channel(std::ostream& fp) {
     auto& device_ctx = g_vpr_ctx.device();
     fp << "\t<channels>" << std::endl;
     fp << "\t\t<channel chan_width_max =\"" << device_ctx.chan_width.max << "\" x_min=\"" << device_ctx.chan_width.x_min << "\" y_min=\"" << device_ctx.chan_width.y_min << "\" x_max=\"" << device_ctx.chan_width.x_max << "\" y_max=\"" << device_ctx.chan_width.y_max << "\"/>" << std::endl;
@@ -97,46 +149,46 @@ void write_rr_channel(std::fstream& fp) {
 
 /* All relevant rr node info is written out to the graph.
  * This includes location, timing, and segment info*/
-void write_rr_node(std::fstream& fp) {
+void write_rr_node(std::ostream& fp, const size_t& num_threads) {
     auto& device_ctx = g_vpr_ctx.device();
 
     fp << "\t<rr_nodes>" << std::endl;
 
-    for (size_t inode = 0; inode < device_ctx.rr_nodes.size(); inode++) {
+    write_rr_graph_items(fp, device_ctx.rr_nodes.size(), num_threads, [&](std::ostream& os, const size_t& inode) {
         auto& node = device_ctx.rr_nodes[inode];
-        fp << "\t\t<node";
-        fp << " id=\"" << inode;
-        fp << "\" type=\"" << node.type_string();
+        os << "\t\t<node";
+        os << " id=\"" << inode;
+        os << "\" type=\"" << node.type_string();
         if (node.type() == CHANX || node.type() == CHANY) {
-            fp << "\" direction=\"" << node.direction_string();
+            os << "\" direction=\"" << node.direction_string();
         }
-        fp << "\" capacity=\"" << node.capacity();
-        fp << "\">" << std::endl;
-        fp << "\t\t\t<loc";
-        fp << " xlow=\"" << node.xlow();
-        fp << "\" ylow=\"" << node.ylow();
-        fp << "\" xhigh=\"" << node.xhigh();
-        fp << "\" yhigh=\"" << node.yhigh();
+        os << "\" capacity=\"" << node.capacity();
+        os << "\">" << '\n';
+        os << "\t\t\t<loc";
+        os << " xlow=\"" << node.xlow();
+        os << "\" ylow=\"" << node.ylow();
+        os << "\" xhigh=\"" << node.xhigh();
+        os << "\" yhigh=\"" << node.yhigh();
         if (node.type() == IPIN || node.type() == OPIN) {
-            fp << "\" side=\"" << node.side_string();
+            os << "\" side=\"" << node.side_string();
         }
-        fp << "\" ptc=\"" << node.ptc_num();
-        fp << "\"/>" << std::endl;
-        fp << "\t\t\t<timing R=\"" << std::setprecision(FLOAT_PRECISION) << node.R()
-           << "\" C=\"" << std::setprecision(FLOAT_PRECISION) << node.C() << "\"/>" << std::endl;
+        os << "\" ptc=\"" << node.ptc_num();
+        os << "\"/>" << '\n';
+        os << "\t\t\t<timing R=\"" << std::setprecision(FLOAT_PRECISION) << node.R()
+           << "\" C=\"" << std::setprecision(FLOAT_PRECISION) << node.C() << "\"/>" << '\n';
 
         if (device_ctx.rr_indexed_data[node.cost_index()].seg_index != -1) {
-            fp << "\t\t\t<segment segment_id=\"" << device_ctx.rr_indexed_data[node.cost_index()].seg_index << "\"/>" << std::endl;
+            os << "\t\t\t<segment segment_id=\"" << device_ctx.rr_indexed_data[node.cost_index()].seg_index << "\"/>" << '\n';
         }
 
         const auto iter = device_ctx.rr_node_metadata.find(inode);
         if (iter != device_ctx.rr_node_metadata.end()) {
             const t_metadata_dict& meta = iter->second;
-            add_metadata_to_xml(fp, "\t\t\t", meta);
+            add_metadata_to_xml(os, "\t\t\t", meta);
         }
 
-        fp << "\t\t</node>" << std::endl;
-    }
+        os << "\t\t</node>" << '\n';
+    });
 
     fp << "\t</rr_nodes>" << std::endl
        << std::endl;
@@ -144,7 +196,7 @@ void write_rr_node(std::fstream& fp) {
 
 /* Segment information in the t_segment_inf data structure is written out.
  * Information includes segment id, name, and optional timing parameters*/
-void write_rr_segments(std::fstream& fp, const std::vector<t_segment_inf>& segment_inf) {
+void write_rr_segments(std::ostream& fp, const std::vector<t_segment_inf>& segment_inf) {
     fp << "\t<segments>" << std::endl;
 
     for (size_t iseg = 0; iseg < segment_inf.size(); iseg++) {
@@ -158,7 +210,7 @@ void write_rr_segments(std::fstream& fp, const std::vector<t_segment_inf>& segme
 
 /* Switch info is written out into xml format. This includes
  * general, sizing, and optional timing information*/
-void write_rr_switches(std::fstream& fp) {
+void write_rr_switches(std::ostream& fp) {
     auto& device_ctx = g_vpr_ctx.device();
     fp << "\t<switches>" << std::endl;
 
@@ -197,7 +249,7 @@ void write_rr_switches(std::fstream& fp) {
 
 /* Block information is printed out in xml format. This includes general,
  * pin class, and pins */
-void write_rr_block_types(std::fstream& fp) {
+void write_rr_block_types(std::ostream& fp) {
     auto& device_ctx = g_vpr_ctx.device();
     fp << "\t<block_types>" << std::endl;
 
@@ -245,7 +297,7 @@ void write_rr_block_types(std::fstream& fp) {
 
 /* Grid information is printed out in xml format. Each grid location
  * and its relevant information is included*/
-void write_rr_grid(std::fstream& fp) {
+void write_rr_grid(std::ostream& fp) {
     auto& device_ctx = g_vpr_ctx.device();
 
     fp << "\t<grid>" << std::endl;
@@ -263,32 +315,32 @@ void write_rr_grid(std::fstream& fp) {
 
 /* Edges connecting to each rr node is printed out. The two nodes
  * it connects to are also printed*/
-void write_rr_edges(std::fstream& fp) {
+void write_rr_edges(std::ostream& fp, const size_t& num_threads) {
     auto& device_ctx = g_vpr_ctx.device();
     fp << "\t<rr_edges>" << std::endl;
 
-    for (size_t inode = 0; inode < device_ctx.rr_nodes.size(); inode++) {
+    write_rr_graph_items(fp, device_ctx.rr_nodes.size(), num_threads, [&](std::ostream& os, const size_t& inode) {
         auto& node = device_ctx.rr_nodes[inode];
         for (t_edge_size iedge = 0; iedge < node.num_edges(); iedge++) {
-            fp << "\t\t<edge src_node=\"" << inode << "\" sink_node=\"" << node.edge_sink_node(iedge) << "\" switch_id=\"" << node.edge_switch(iedge) << "\"";
+            os << "\t\t<edge src_node=\"" << inode << "\" sink_node=\"" << node.edge_sink_node(iedge) << "\" switch_id=\"" << node.edge_switch(iedge) << "\"";
 
             bool wrote_edge_metadata = false;
             const auto iter = device_ctx.rr_edge_metadata.find(std::make_tuple(inode, node.edge_sink_node(iedge), node.edge_switch(iedge)));
             if (iter != device_ctx.rr_edge_metadata.end()) {
-                fp << ">" << std::endl;
+                os << ">" << '\n';
 
                 const t_metadata_dict& meta = iter->second;
-                add_metadata_to_xml(fp, "\t\t\t", meta);
+                add_metadata_to_xml(os, "\t\t\t", meta);
                 wrote_edge_metadata = true;
             }
 
             if (wrote_edge_metadata == false) {
-                fp << "/>" << std::endl;
+                os << "/>" << '\n';
             } else {
-                fp << "\t\t</edge>" << std::endl;
+                os << "\t\t</edge>" << '\n';
             }
         }
-    }
+    });
     fp << "\t</rr_edges>" << std::endl
        << std::endl;
 }
@@ -6,6 +6,7 @@
 #ifndef RR_GRAPH_WRITER_H
 #define RR_GRAPH_WRITER_H
 
-void write_rr_graph(const char* file_name, const std::vector<t_segment_inf>& segment_inf);
+//The nodes and edges are formatted with num_threads threads (0 for all the cores)
+void write_rr_graph(const char* file_name, const std::vector<t_segment_inf>& segment_inf, const size_t& num_threads);
 
 #endif
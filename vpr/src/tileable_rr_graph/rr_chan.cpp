@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "openfpga_memory_usage.h"
 #include "rr_chan.h"
 
 /* namespace openfpga begins */
@@ -27,6 +28,12 @@ RRChan::RRChan() {
 /************************************************************************
  * Accessors
  ***********************************************************************/
+size_t RRChan::memory_usage() const {
+  return sizeof(RRChan)
+       + heap_memory_usage(nodes_)
+       + heap_memory_usage(node_segments_);
+}
+
 t_rr_type RRChan::get_type() const {
   return type_;
 }
@@ -1,12 +1,16 @@
 /************************************************************************
  * Member functions for class RRGSB
  ***********************************************************************/
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_log.h"
 #include "vtr_assert.h"
+#include "vtr_hash.h"
 
 /* Headers from openfpgautil library */
 #include "openfpga_side_manager.h"
+#include "openfpga_memory_usage.h"
 
 #include "openfpga_rr_graph_utils.h"
 
@@ -42,6 +46,24 @@ RRGSB::RRGSB(const RRGSB& src) {
 /************************************************************************
  * Accessors
  ***********************************************************************/
+size_t RRGSB::memory_usage() const {
+  /* The memory of a shared routing channel is split between its owners */
+  size_t chan_memory = 0;
+  for (const std::shared_ptr<const ChanData>& chan_data : chan_node_) {
+    chan_memory += (chan_data->chan.memory_usage()
+                  + heap_memory_usage(chan_data->segment_ids)
+                  + heap_memory_usage(chan_data->segment_node_ids)) / chan_data.use_count();
+  }
+
+  return sizeof(RRGSB)
+       + heap_memory_usage(chan_node_)
+       + chan_memory
+       + heap_memory_usage(chan_node_direction_)
+       + heap_memory_usage(chan_node_in_edges_)
+       + heap_memory_usage(ipin_node_)
+       + heap_memory_usage(opin_node_);
+}
+
 /* Get the number of sides of this SB */
 size_t RRGSB::get_num_sides() const {
   VTR_ASSERT (validate_num_sides());
@@ -52,14 +74,14 @@ size_t RRGSB::get_num_sides() const {
 size_t RRGSB::get_chan_width(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
-  return chan_node_[side_manager.to_size_t()].get_chan_width(); 
+  return chan_node_[side_manager.to_size_t()]->chan.get_chan_width(); 
 }
 
 /* Get the number of routing tracks on a side */
 t_rr_type RRGSB::get_chan_type(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
-  return chan_node_[side_manager.to_size_t()].get_type(); 
+  return chan_node_[side_manager.to_size_t()]->chan.get_type(); 
 }
 
 /* Get the maximum number of routing tracks on all sides */
@@ -78,29 +100,22 @@ size_t RRGSB::get_cb_chan_width(const t_rr_type& cb_type) const {
 }
 
 /* Get the sides of ipin_nodes belong to the cb */
-std::vector<enum e_side> RRGSB::get_cb_ipin_sides(const t_rr_type& cb_type) const {
+const std::vector<enum e_side>& RRGSB::get_cb_ipin_sides(const t_rr_type& cb_type) const {
   VTR_ASSERT (validate_cb_type(cb_type));
   
-  std::vector<enum e_side> ipin_sides;
-
-  /* Make sure a clean start */
-  ipin_sides.clear();
+  /* The sides are the same for all the GSBs, so they are shared */
+  static const std::vector<enum e_side> chanx_ipin_sides = {TOP, BOTTOM};
+  static const std::vector<enum e_side> chany_ipin_sides = {RIGHT, LEFT};
 
   switch(cb_type) {
   case CHANX:
-    ipin_sides.push_back(TOP);
-    ipin_sides.push_back(BOTTOM);
-    break;
+    return chanx_ipin_sides;
   case CHANY:
-    ipin_sides.push_back(RIGHT);
-    ipin_sides.push_back(LEFT);
-    break;
+    return chany_ipin_sides;
   default: 
     VTR_LOG("Invalid type of connection block!\n");
     exit(1);
   }
-
-  return ipin_sides;
 }
 
 /* Get the direction of a rr_node at a given side and track_id */
@@ -118,20 +133,32 @@ enum PORTS RRGSB::get_chan_node_direction(const e_side& side, const size_t& trac
 }
 
 /* Get a list of segments used in this routing channel */
-std::vector<RRSegmentId> RRGSB::get_chan_segment_ids(const e_side& side) const {
+const std::vector<RRSegmentId>& RRGSB::get_chan_segment_ids(const e_side& side) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
  
   /* Ensure the side is valid in the context of this switch block */ 
   VTR_ASSERT( validate_side(side) );
 
-  return chan_node_[side_manager.to_size_t()].get_segment_ids(); 
+  return chan_node_[side_manager.to_size_t()]->segment_ids; 
 }
 
 /* Get a list of rr_nodes whose sed_id is specified */
-std::vector<size_t> RRGSB::get_chan_node_ids_by_segment_ids(const e_side& side,
-                                                              const RRSegmentId& seg_id) const {
-  return chan_node_[size_t(side)].get_node_ids_by_segment_ids(seg_id);
+const std::vector<size_t>& RRGSB::get_chan_node_ids_by_segment_ids(const e_side& side,
+                                                                     const RRSegmentId& seg_id) const {
+  VTR_ASSERT( validate_side(side) );
+
+  /* A channel only uses a few segments, so a linear search is fast enough */
+  const ChanData& chan_data = *chan_node_[size_t(side)];
+  for (size_t iseg = 0; iseg < chan_data.segment_ids.size(); ++iseg) {
+    if (seg_id == chan_data.segment_ids[iseg]) {
+      return chan_data.segment_node_ids[iseg];
+    }
+  }
+
+  /* The segment is not used by the channel */
+  static const std::vector<size_t> empty_node_ids;
+  return empty_node_ids;
 } 
 
 /* get a rr_node at a given side and track_id */
@@ -145,12 +172,12 @@ RRNodeId RRGSB::get_chan_node(const e_side& side, const size_t& track_id) const
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT( validate_track_id(side, track_id) );
   
-  return chan_node_[side_manager.to_size_t()].get_node(track_id); 
+  return chan_node_[side_manager.to_size_t()]->chan.get_node(track_id); 
 } 
 
-std::vector<RREdgeId> RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph, 
-                                                    const e_side& side,
-                                                    const size_t& track_id) const {
+RRGSB::edge_range RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph, 
+                                                const e_side& side,
+                                                const size_t& track_id) const {
   SideManager side_manager(side);
   VTR_ASSERT(side_manager.validate());
  
@@ -164,18 +191,19 @@ std::vector<RREdgeId> RRGSB::get_chan_node_in_edges(const RRGraph& rr_graph,
   VTR_ASSERT(OUT_PORT == get_chan_node_direction(side, track_id));
 
   /* if sorted, we give sorted edges
-   * if not sorted, we give the empty vector
+   * if not sorted, we give the edges in the rr_graph
    */
   if (0 == chan_node_in_edges_.size()) {
-    std::vector<RREdgeId> unsorted_edges;
-    for (const RREdgeId& edge : rr_graph.node_in_edges(get_chan_node(side, track_id))) {
-      unsorted_edges.push_back(edge);
-    }
-
-    return unsorted_edges;
+    RRGraph::edge_range unsorted_edges = rr_graph.node_in_edges(get_chan_node(side, track_id));
+    return edge_range(unsorted_edges.begin(), unsorted_edges.end());
   } 
 
-  return chan_node_in_edges_[side_manager.to_size_t()][track_id];
+  const std::vector<RREdgeId>& sorted_edges = chan_node_in_edges_[side_manager.to_size_t()][track_id];
+  return edge_range(sorted_edges.data(), sorted_edges.data() + sorted_edges.size());
+}
+
+bool RRGSB::is_chan_node_in_edges_sorted() const {
+  return 0 != chan_node_in_edges_.size();
 }
 
 /* get the segment id of a channel rr_node */
@@ -189,7 +217,7 @@ RRSegmentId RRGSB::get_chan_node_segment(const e_side& side, const size_t& track
   /* Ensure the track is valid in the context of this switch block at a specific side */ 
   VTR_ASSERT( validate_track_id(side, track_id) );
   
-  return chan_node_[side_manager.to_size_t()].get_node_segment(track_id); 
+  return chan_node_[side_manager.to_size_t()]->chan.get_node_segment(track_id); 
 } 
 
 /* Get the number of IPIN rr_nodes on a side */
@@ -243,7 +271,7 @@ int RRGSB::get_cb_chan_node_index(const t_rr_type& cb_type, const RRNodeId& node
 /* Get the node index in the array, return -1 if not found */
 int RRGSB::get_chan_node_index(const e_side& node_side, const RRNodeId& node) const {
   VTR_ASSERT (validate_side(node_side));
-  return chan_node_[size_t(node_side)].get_node_track_id(node); 
+  return chan_node_[size_t(node_side)]->chan.get_node_track_id(node); 
 }
 
 /* Get the node index in the array, return -1 if not found */
@@ -262,7 +290,7 @@ int RRGSB::get_node_index(const RRGraph& rr_graph,
   case CHANX:
   case CHANY:
     for (size_t inode = 0; inode < get_chan_width(node_side); ++inode){
-      if ((node == chan_node_[size_t(node_side)].get_node(inode))
+      if ((node == chan_node_[size_t(node_side)]->chan.get_node(inode))
         /* Check if direction meets specification */
         &&(node_direction == chan_node_direction_[size_t(node_side)][inode])) {
         cnt++;
@@ -363,7 +391,7 @@ bool RRGSB::is_cb_mirror(const RRGraph& rr_graph, const RRGSB& cand, const t_rr_
   enum e_side chan_side = get_cb_chan_side(cb_type);
 
   /* check the numbers/directionality of channel rr_nodes */
-  if ( false == chan_node_[size_t(chan_side)].is_mirror(rr_graph, cand.chan_node_[size_t(chan_side)]) ) {
+  if ( false == chan_node_[size_t(chan_side)]->chan.is_mirror(rr_graph, cand.chan_node_[size_t(chan_side)]->chan) ) {
      return false;
   }
 
@@ -556,7 +584,7 @@ bool RRGSB::is_sb_side_segment_mirror(const RRGraph& rr_graph, const RRGSB& cand
 bool RRGSB::is_sb_side_mirror(const RRGraph& rr_graph, const RRGSB& cand, const e_side& side) const {
 
   /* get a list of segments */
-  std::vector<RRSegmentId> seg_ids = chan_node_[size_t(side)].get_segment_ids();
+  const std::vector<RRSegmentId>& seg_ids = chan_node_[size_t(side)]->segment_ids;
 
   for (size_t iseg = 0; iseg < seg_ids.size(); ++iseg) {
     if (false == is_sb_side_segment_mirror(rr_graph, cand, side, seg_ids[iseg])) {
@@ -585,6 +613,93 @@ bool RRGSB::is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const {
   return true;
 }
 
+/* Get the signature of the switch block, which follows the checks of is_sb_mirror() */
+size_t RRGSB::get_sb_signature(const RRGraph& rr_graph) const {
+  size_t signature = 0;
+  vtr::hash_combine(signature, get_num_sides());
+
+  for (size_t side = 0; side < get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side node_side = side_manager.get_side();
+
+    vtr::hash_combine(signature, get_chan_width(node_side));
+    /* A side without routing tracks is not compared (see is_sb_side_mirror()) */
+    if (0 == get_chan_width(node_side)) {
+      continue;
+    }
+
+    for (size_t itrack = 0; itrack < get_chan_width(node_side); ++itrack) {
+      vtr::hash_combine(signature, size_t(get_chan_node_direction(node_side, itrack)));
+      /* Only the fan-in of OUT_PORT rr_nodes is compared */
+      if (OUT_PORT != get_chan_node_direction(node_side, itrack)) {
+        continue;
+      }
+      bool is_short_conkt = is_sb_node_passing_wire(rr_graph, node_side, itrack);
+      vtr::hash_combine(signature, is_short_conkt);
+      if (true == is_short_conkt) {
+        continue;
+      }
+
+      edge_range node_in_edges = get_chan_node_in_edges(rr_graph, node_side, itrack);
+      vtr::hash_combine(signature, node_in_edges.size());
+      for (const RREdgeId& edge : node_in_edges) {
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        int src_node_id;
+        enum e_side src_node_side;
+        get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+        vtr::hash_combine(signature, size_t(rr_graph.node_type(src_node)));
+        vtr::hash_combine(signature, size_t(rr_graph.edge_switch(edge)));
+        vtr::hash_combine(signature, size_t(src_node_side));
+        vtr::hash_combine(signature, src_node_id);
+      }
+    }
+
+    vtr::hash_combine(signature, get_num_opin_nodes(node_side));
+    vtr::hash_combine(signature, get_num_ipin_nodes(node_side));
+  }
+
+  return signature;
+}
+
+/* Get the signature of a connection block, which follows the checks of is_cb_mirror() */
+size_t RRGSB::get_cb_signature(const RRGraph& rr_graph, const t_rr_type& cb_type) const {
+  size_t signature = 0;
+  vtr::hash_combine(signature, get_cb_chan_width(cb_type));
+
+  enum e_side chan_side = get_cb_chan_side(cb_type);
+  const RRChan& chan = chan_node_[size_t(chan_side)]->chan;
+  vtr::hash_combine(signature, size_t(chan.get_type()));
+  for (size_t inode = 0; inode < chan.get_chan_width(); ++inode) {
+    vtr::hash_combine(signature, size_t(rr_graph.node_type(chan.get_node(inode))));
+    vtr::hash_combine(signature, size_t(rr_graph.node_direction(chan.get_node(inode))));
+    vtr::hash_combine(signature, size_t(chan.get_node_segment(inode)));
+  }
+
+  for (const e_side& ipin_side : get_cb_ipin_sides(cb_type)) {
+    vtr::hash_combine(signature, get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < get_num_ipin_nodes(ipin_side); ++inode) {
+      RRNodeId node = get_ipin_node(ipin_side, inode);
+      vtr::hash_combine(signature, rr_graph.node_in_edges(node).size());
+      for (const RREdgeId& edge : rr_graph.node_in_edges(node)) {
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        vtr::hash_combine(signature, size_t(rr_graph.node_type(src_node)));
+        vtr::hash_combine(signature, size_t(rr_graph.edge_switch(edge)));
+        if ((CHANX == rr_graph.node_type(src_node)) || (CHANY == rr_graph.node_type(src_node))) {
+          vtr::hash_combine(signature, get_chan_node_index(chan_side, src_node));
+        } else if (OPIN == rr_graph.node_type(src_node)) {
+          int src_node_id;
+          enum e_side src_node_side;
+          get_node_side_and_index(rr_graph, src_node, OUT_PORT, src_node_side, src_node_id);
+          vtr::hash_combine(signature, size_t(src_node_side));
+          vtr::hash_combine(signature, src_node_id);
+        }
+      }
+    }
+  }
+
+  return signature;
+}
+
 /* Public Accessors: Cooridinator conversion */
 
 /* get the x coordinate of this GSB */
@@ -741,7 +856,8 @@ void RRGSB::set(const RRGSB& src) {
     /* Copy chan_nodes */
     /* skip if there is no channel width */
     if ( 0 < src.get_chan_width(side_manager.get_side()) ) {
-      this->chan_node_[side_manager.get_side()].set(src.chan_node_[side_manager.get_side()]);
+      /* The channel data is never modified, so it is shared with the source */
+      this->chan_node_[side_manager.get_side()] = src.chan_node_[side_manager.get_side()];
       /* Copy chan_node_direction_*/
       this->chan_node_direction_[side_manager.get_side()].clear();
       for (size_t inode = 0; inode < src.get_chan_width(side_manager.get_side()); ++inode) {
@@ -771,7 +887,7 @@ void RRGSB::set_coordinate(const size_t& x, const size_t& y) {
 /* Allocate the vectors with the given number of sides */
 void RRGSB::init_num_sides(const size_t& num_sides) {
   /* Initialize the vectors */
-  chan_node_.resize(num_sides);
+  chan_node_.resize(num_sides, empty_chan_data());
   chan_node_direction_.resize(num_sides);
   ipin_node_.resize(num_sides);
   opin_node_.resize(num_sides);
@@ -785,7 +901,20 @@ void RRGSB::add_chan_node(const e_side& node_side,
   VTR_ASSERT(validate_side(node_side));
 
   /* fill the dedicated element in the vector */
-  chan_node_[size_t(node_side)].set(rr_chan);
+  /* Build the segment lists of the channel, so that the accessors do not rebuild them for each query */
+  std::shared_ptr<ChanData> chan_data = std::make_shared<ChanData>();
+  chan_data->chan.set(rr_chan);
+  for (size_t inode = 0; inode < rr_chan.get_chan_width(); ++inode) {
+    RRSegmentId seg_id = rr_chan.get_node_segment(inode);
+    std::vector<RRSegmentId>::iterator it = std::find(chan_data->segment_ids.begin(), chan_data->segment_ids.end(), seg_id);
+    if (it == chan_data->segment_ids.end()) {
+      chan_data->segment_ids.push_back(seg_id);
+      chan_data->segment_node_ids.emplace_back();
+      it = chan_data->segment_ids.end() - 1;
+    }
+    chan_data->segment_node_ids[std::distance(chan_data->segment_ids.begin(), it)].push_back(inode);
+  }
+  chan_node_[size_t(node_side)] = chan_data;
   chan_node_direction_[size_t(node_side)].resize(rr_chan_dir.size());
   for (size_t inode = 0; inode < rr_chan_dir.size(); ++inode) {
     chan_node_direction_[size_t(node_side)][inode] = rr_chan_dir[inode];
@@ -812,7 +941,7 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph,
   std::map<size_t, std::map<size_t, RREdgeId>> from_grid_edge_map;
   std::map<size_t, std::map<size_t, RREdgeId>> from_track_edge_map;
 
-  const RRNodeId& chan_node = chan_node_[size_t(chan_side)].get_node(track_id); 
+  const RRNodeId& chan_node = chan_node_[size_t(chan_side)]->chan.get_node(track_id); 
   
   /* Count the edges and ensure every of them has been sorted */
   size_t edge_counter = 0;
@@ -867,7 +996,7 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph,
     }
  
     /* Edges from routing tracks are the 2nd part */
-    for (size_t itrack = 0; itrack < chan_node_[side].get_chan_width(); ++itrack) {
+    for (size_t itrack = 0; itrack < chan_node_[side]->chan.get_chan_width(); ++itrack) {
       if ( (0 < from_track_edge_map.count(side))
         && (0 < from_track_edge_map.at(side).count(itrack)) ) {
         chan_node_in_edges_[size_t(chan_side)][track_id].push_back(from_track_edge_map[side][itrack]);
@@ -884,8 +1013,8 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph) {
 
   for (size_t side = 0; side < get_num_sides(); ++side) {
     SideManager side_manager(side);
-    chan_node_in_edges_[side].resize(chan_node_[side].get_chan_width());
-    for (size_t track_id = 0; track_id < chan_node_[side].get_chan_width(); ++track_id) {
+    chan_node_in_edges_[side].resize(chan_node_[side]->chan.get_chan_width());
+    for (size_t track_id = 0; track_id < chan_node_[side]->chan.get_chan_width(); ++track_id) {
       /* Only sort the output nodes and bypass passing wires */
       if ( (OUT_PORT == chan_node_direction_[side][track_id])
         && (false == is_sb_node_passing_wire(rr_graph, side_manager.get_side(), track_id)) ) {  
@@ -895,6 +1024,58 @@ void RRGSB::sort_chan_node_in_edges(const RRGraph& rr_graph) {
   }
 }
 
+void RRGSB::set_chan_node_in_edges(const e_side& chan_side,
+                                   const size_t& track_id,
+                                   const std::vector<RREdgeId>& in_edges) {
+  VTR_ASSERT(validate_side(chan_side));
+  VTR_ASSERT(validate_track_id(chan_side, track_id));
+  VTR_ASSERT(OUT_PORT == chan_node_direction_[size_t(chan_side)][track_id]);
+
+  /* Allocate on the first call, as sort_chan_node_in_edges() does */
+  if (0 == chan_node_in_edges_.size()) {
+    chan_node_in_edges_.resize(get_num_sides());
+    for (size_t side = 0; side < get_num_sides(); ++side) {
+      chan_node_in_edges_[side].resize(chan_node_[side]->chan.get_chan_width());
+    }
+  }
+
+  chan_node_in_edges_[size_t(chan_side)][track_id] = in_edges;
+}
+
+/* Share the routing channel of a side of another GSB, when both sides contain
+ * the same routing tracks. The directions of the tracks are not shared,
+ * as they depend on the side of the GSB
+ */
+bool RRGSB::share_chan_node(const e_side& node_side,
+                            const RRGSB& src,
+                            const e_side& src_side) {
+  VTR_ASSERT(validate_side(node_side));
+  VTR_ASSERT(src.validate_side(src_side));
+
+  const std::shared_ptr<const ChanData>& chan_data = chan_node_[size_t(node_side)];
+  const std::shared_ptr<const ChanData>& src_chan_data = src.chan_node_[size_t(src_side)];
+  if (chan_data == src_chan_data) {
+    return true;
+  }
+
+  const RRChan& chan = chan_data->chan;
+  const RRChan& src_chan = src_chan_data->chan;
+  if ( (0 == chan.get_chan_width())
+    || (chan.get_type() != src_chan.get_type())
+    || (chan.get_chan_width() != src_chan.get_chan_width()) ) {
+    return false;
+  }
+  for (size_t itrack = 0; itrack < chan.get_chan_width(); ++itrack) {
+    if ( (chan.get_node(itrack) != src_chan.get_node(itrack))
+      || (chan.get_node_segment(itrack) != src_chan.get_node_segment(itrack)) ) {
+      return false;
+    }
+  }
+
+  chan_node_[size_t(node_side)] = src_chan_data;
+  return true;
+}
+
 /************************************************************************
  * Public Mutators: clean-up functions
  ***********************************************************************/
@@ -905,7 +1086,6 @@ void RRGSB::clear() {
   /* Clear the inner vector of each matrix */
   for (size_t side = 0; side < get_num_sides(); ++side) {
     chan_node_direction_[side].clear();
-    chan_node_[side].clear();
     ipin_node_[side].clear();
     opin_node_[side].clear();
   }  
@@ -919,7 +1099,7 @@ void RRGSB::clear() {
 void RRGSB::clear_chan_nodes(const e_side& node_side) {
   VTR_ASSERT(validate_side(node_side));
   
-  chan_node_[size_t(node_side)].clear();
+  chan_node_[size_t(node_side)] = empty_chan_data();
   chan_node_direction_[size_t(node_side)].clear();
 } 
 
@@ -944,6 +1124,14 @@ void RRGSB::clear_one_side(const e_side& node_side) {
   clear_opin_nodes(node_side);
 } 
 
+/************************************************************************
+ * Internal Accessors
+ ***********************************************************************/
+std::shared_ptr<const RRGSB::ChanData> RRGSB::empty_chan_data() {
+  static const std::shared_ptr<const ChanData> empty_data = std::make_shared<ChanData>();
+  return empty_data;
+}
+
 /************************************************************************
  * Internal Accessors: identify mirrors
  ***********************************************************************/
@@ -974,8 +1162,8 @@ bool RRGSB::is_sb_node_mirror(const RRGraph& rr_graph,
   }
 
   /* Use unsorted/sorted edges */
-  std::vector<RREdgeId> node_in_edges = get_chan_node_in_edges(rr_graph, node_side, track_id);
-  std::vector<RREdgeId> cand_node_in_edges = cand.get_chan_node_in_edges(rr_graph, node_side, track_id);
+  edge_range node_in_edges = get_chan_node_in_edges(rr_graph, node_side, track_id);
+  edge_range cand_node_in_edges = cand.get_chan_node_in_edges(rr_graph, node_side, track_id);
 
   /* For non-passing wires, check driving rr_nodes */
   if (node_in_edges.size() != cand_node_in_edges.size()) {
@@ -985,8 +1173,8 @@ bool RRGSB::is_sb_node_mirror(const RRGraph& rr_graph,
   VTR_ASSERT(node_in_edges.size() == cand_node_in_edges.size());
 
   for (size_t iedge = 0; iedge < node_in_edges.size(); ++iedge) {
-    RREdgeId src_edge = node_in_edges[iedge];
-    RREdgeId src_cand_edge = cand_node_in_edges[iedge];
+    RREdgeId src_edge = node_in_edges.begin()[iedge];
+    RREdgeId src_cand_edge = cand_node_in_edges.begin()[iedge];
     RRNodeId src_node = rr_graph.edge_src_node(src_edge);
     RRNodeId src_cand_node = rr_graph.edge_src_node(src_cand_edge);
     /* node type should be the same  */
@@ -1030,20 +1218,13 @@ bool RRGSB::is_cb_node_mirror(const RRGraph& rr_graph,
     return false;
   }
 
-  std::vector<RREdgeId> node_in_edges;
-  for (const RREdgeId& edge : rr_graph.node_in_edges(node)) {
-    node_in_edges.push_back(edge);
-  }
-
-  std::vector<RREdgeId> cand_node_in_edges;
-  for (const RREdgeId& edge : rr_graph.node_in_edges(cand_node)) {
-    cand_node_in_edges.push_back(edge);
-  }
+  RRGraph::edge_range node_in_edges = rr_graph.node_in_edges(node);
+  RRGraph::edge_range cand_node_in_edges = rr_graph.node_in_edges(cand_node);
   VTR_ASSERT(node_in_edges.size() == cand_node_in_edges.size());
 
   for (size_t iedge = 0; iedge < node_in_edges.size(); ++iedge) {
-    RREdgeId src_edge = node_in_edges[iedge];
-    RREdgeId src_cand_edge = cand_node_in_edges[iedge];
+    RREdgeId src_edge = node_in_edges.begin()[iedge];
+    RREdgeId src_cand_edge = cand_node_in_edges.begin()[iedge];
     RRNodeId src_node = rr_graph.edge_src_node(src_edge);
     RRNodeId src_cand_node = rr_graph.edge_src_node(src_cand_edge);
     /* node type should be the same  */
@@ -1131,7 +1312,7 @@ bool RRGSB::validate_track_id(const e_side& side, const size_t& track_id) const
     return false;
   } 
   
-  return ( ( track_id < chan_node_[size_t(side)].get_chan_width()) 
+  return ( ( track_id < chan_node_[size_t(side)]->chan.get_chan_width()) 
         && ( track_id < chan_node_direction_[size_t(side)].size()) );
 }
 
@@ -6,6 +6,9 @@
  *******************************************************************/
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
+#include "vtr_range.h"
+
+#include <memory>
 
 #include "rr_chan.h"
 
@@ -51,13 +54,26 @@ namespace openfpga {
  * num_conf_bits: number of configuration bits this switch block requires
  *******************************************************************/
 class RRGSB {
+  public: /* Types */
+    /* Read-only view on the incoming edges of a channel node,
+     * which points into the GSB or the rr_graph without any copy
+     */
+    typedef vtr::Range<const RREdgeId*> edge_range;
+  private: /* Types */
+    struct ChanData; /* See the internal data */
   public: /* Contructors */
     RRGSB(const RRGSB&);/* Copy constructor */
+    RRGSB(RRGSB&&) = default;/* Move constructor */
     RRGSB();/* Default constructor */
+    RRGSB& operator=(const RRGSB&) = default;
+    RRGSB& operator=(RRGSB&&) = default;
   public: /* Accessors */
     /* Get the number of sides of this SB */
     size_t get_num_sides() const; 
 
+    /* Estimated memory (in bytes) of the object and its containers, see openfpga_memory_usage.h */
+    size_t memory_usage() const;
+
     /* Get the number of routing tracks on a side */
     size_t get_chan_width(const e_side& side) const; 
  
@@ -71,25 +87,28 @@ class RRGSB {
     size_t get_cb_chan_width(const t_rr_type& cb_type) const; 
 
     /* Get the sides of CB ipins in the array */
-    std::vector<enum e_side> get_cb_ipin_sides(const t_rr_type& cb_type) const; 
+    const std::vector<enum e_side>& get_cb_ipin_sides(const t_rr_type& cb_type) const; 
 
     /* Get the direction of a rr_node at a given side and track_id */
     enum PORTS get_chan_node_direction(const e_side& side, const size_t& track_id) const; 
 
     /* Get a list of segments used in this routing channel */
-    std::vector<RRSegmentId> get_chan_segment_ids(const e_side& side) const; 
+    const std::vector<RRSegmentId>& get_chan_segment_ids(const e_side& side) const; 
 
-    /* Get a list of segments used in this routing channel */
-    std::vector<size_t> get_chan_node_ids_by_segment_ids(const e_side& side,
-                                                         const RRSegmentId& seg_id) const; 
+    /* Get the list of track ids of a routing channel whose segment is specified */
+    const std::vector<size_t>& get_chan_node_ids_by_segment_ids(const e_side& side,
+                                                                const RRSegmentId& seg_id) const; 
 
     /* get a rr_node at a given side and track_id */
     RRNodeId get_chan_node(const e_side& side, const size_t& track_id) const; 
 
     /* get all the sorted incoming edges for a rr_node at a given side and track_id */
-    std::vector<RREdgeId> get_chan_node_in_edges(const RRGraph& rr_graph, 
-                                                 const e_side& side,
-                                                 const size_t& track_id) const; 
+    edge_range get_chan_node_in_edges(const RRGraph& rr_graph, 
+                                      const e_side& side,
+                                      const size_t& track_id) const; 
+
+    /* Check if the incoming edges of the routing channel rr_nodes are sorted */
+    bool is_chan_node_in_edges_sorted() const;
 
     /* get the segment id of a channel rr_node */
     RRSegmentId get_chan_node_segment(const e_side& side, const size_t& track_id) const; 
@@ -167,6 +186,18 @@ class RRGSB {
      */
     bool is_sb_mirror(const RRGraph& rr_graph, const RRGSB& cand) const; 
 
+    /* Get a structural signature of the switch block,
+     * which hashes everything compared by is_sb_mirror()
+     * Mirrors always have the same signature, so only the switch blocks
+     * with the same signature need to be compared by is_sb_mirror()
+     */
+    size_t get_sb_signature(const RRGraph& rr_graph) const;
+
+    /* Get a structural signature of a connection block,
+     * which hashes everything compared by is_cb_mirror()
+     */
+    size_t get_cb_signature(const RRGraph& rr_graph, const t_rr_type& cb_type) const;
+
   public: /* Cooridinator conversion and output  */
     size_t get_x() const; /* get the x coordinate of this switch block */
     size_t get_y() const; /* get the y coordinate of this switch block */
@@ -210,6 +241,21 @@ class RRGSB {
     /* Sort all the incoming edges for routing channel rr_node */
     void sort_chan_node_in_edges(const RRGraph& rr_graph);
 
+    /* Set the sorted incoming edges of a routing channel rr_node,
+     * e.g., which are sorted by sort_chan_node_in_edges() in a previous run
+     */
+    void set_chan_node_in_edges(const e_side& chan_side,
+                                const size_t& track_id,
+                                const std::vector<RREdgeId>& in_edges);
+
+    /* Share the routing channel of a side of another GSB, when both sides
+     * contain the same routing tracks, so that the channel is stored once.
+     * Return true if the channel is shared
+     */
+    bool share_chan_node(const e_side& node_side,
+                         const RRGSB& src,
+                         const e_side& src_side);
+
   public: /* Mutators: cleaners */
     void clear();
 
@@ -232,6 +278,9 @@ class RRGSB {
                                  const size_t& track_id);
 
   private: /* internal functions */
+    /* The channel data of the sides without routing tracks */
+    static std::shared_ptr<const ChanData> empty_chan_data();
+
     bool is_sb_node_mirror(const RRGraph& rr_graph,
                            const RRGSB& cand,
                            const e_side& node_side, 
@@ -259,8 +308,21 @@ class RRGSB {
     /* Routing channel data
      * Each GSB may have four sides of routing track nodes
      */
-    /* Node id in rr_graph denoting each routing track */
-    std::vector<RRChan>  chan_node_;
+    /* A routing channel with the segments used by the routing tracks,
+     * in their order of appearance, and the track ids of each of these segments
+     *   segment_node_ids: [segment_index_in_gsb_context][0..num_tracks-1]
+     * The data is never modified once built, so that it can be shared
+     * by the two GSBs around a routing channel (see share_chan_node())
+     */
+    struct ChanData {
+      RRChan chan;
+      std::vector<RRSegmentId> segment_ids;
+      std::vector<std::vector<size_t>> segment_node_ids;
+    };
+    /* Node id in rr_graph denoting each routing track, and its segments
+     * An empty channel is shared by all the sides without routing tracks
+     */
+    std::vector<std::shared_ptr<const ChanData>> chan_node_;
 
     /* Direction of a port when the channel node appear in the GSB module */
     std::vector<std::vector<PORTS>>  chan_node_direction_; 
@@ -6,11 +6,14 @@
  *  rr_graph is called tileable, which brings significant advantage in 
  *  producing large FPGA fabrics.
  ***********************************************************************/
+#include <sstream>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
 #include "vtr_log.h"
 #include "vtr_memory.h"
+#include "vtr_digest.h"
 
 #include "vpr_error.h"
 #include "vpr_utils.h"
@@ -18,6 +21,7 @@
 #include "rr_graph.h"
 #include "check_rr_graph.h"
 #include "check_rr_graph_obj.h"
+#include "binary_rr_graph_obj.h"
 
 #include "rr_graph_builder_utils.h"
 #include "tileable_chan_details_builder.h"
@@ -30,6 +34,185 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/************************************************************************
+ * Identify the inputs from which the nodes and edges of a tileable
+ * rr_graph are built. The identifier is a secure digest, which is used
+ * to key the binary rr_graph cache
+ ***********************************************************************/
+static 
+std::string find_tileable_rr_graph_id(const DeviceGrid& grids,
+                                      const vtr::Point<size_t>& device_chan_width,
+                                      const e_switch_block_type& sb_type, const int& Fs, 
+                                      const e_switch_block_type& sb_subtype, const int& subFs, 
+                                      const std::vector<t_segment_inf>& segment_inf,
+                                      const int& delayless_switch, 
+                                      const int& wire_to_arch_ipin_switch,
+                                      const int& num_directs,
+                                      const bool& through_channel,
+                                      const bool& wire_opposite_side) {
+  const DeviceContext& device_ctx = g_vpr_ctx.device();
+
+  std::stringstream rr_graph_inputs;
+  rr_graph_inputs << "vpr_arch=" << device_ctx.arch->architecture_id << "\n";
+  rr_graph_inputs << "device=" << grids.width() << "x" << grids.height() << "\n";
+  rr_graph_inputs << "chan_width=" << device_chan_width.x() << "," << device_chan_width.y() << "\n";
+  rr_graph_inputs << "sb=" << sb_type << "," << Fs << "," << sb_subtype << "," << subFs << "\n";
+  rr_graph_inputs << "segments=" << segment_inf.size() << "\n";
+  rr_graph_inputs << "switches=" << device_ctx.num_arch_switches << "," << delayless_switch << "," << wire_to_arch_ipin_switch << "\n";
+  rr_graph_inputs << "directs=" << num_directs << "\n";
+  rr_graph_inputs << "through_channel=" << through_channel << "\n";
+  rr_graph_inputs << "wire_opposite_side=" << wire_opposite_side << "\n";
+
+  return vtr::secure_digest_stream(rr_graph_inputs);
+}
+
+/************************************************************************
+ * Create the nodes and edges of a tileable rr_graph, where the edges
+ * still use the architecture switches (step 6 of the builder below)
+ ***********************************************************************/
+static 
+void build_tileable_rr_graph_nodes_and_edges(RRGraph& rr_graph,
+                                             std::map<RRNodeId, std::vector<size_t>>& rr_node_track_ids,
+                                             const std::vector<t_physical_tile_type>& types,
+                                             const DeviceGrid& grids,
+                                             const vtr::Point<size_t>& device_chan_width,
+                                             const int& max_chan_width,
+                                             const e_switch_block_type& sb_type, const int& Fs, 
+                                             const e_switch_block_type& sb_subtype, const int& subFs, 
+                                             const std::vector<t_segment_inf>& segment_inf,
+                                             const int& delayless_switch, 
+                                             const RRSwitchId& wire_to_ipin_rr_switch,
+                                             const RRSwitchId& delayless_rr_switch,
+                                             const t_direct_inf *directs, 
+                                             const int& num_directs,
+                                             const bool& through_channel,
+                                             const bool& wire_opposite_side,
+                                             const size_t& num_threads,
+                                             int *Warnings) { 
+  /* A temp data about the driver switch ids for each rr_node */
+  vtr::vector<RRNodeId, RRSwitchId> rr_node_driver_switches; 
+
+  /************************
+   * Allocate the rr_nodes 
+   ************************/
+  alloc_tileable_rr_graph_nodes(rr_graph,
+                                rr_node_driver_switches,
+                                grids,
+                                device_chan_width,
+                                segment_inf,
+                                through_channel);
+
+  /************************
+   * Create all the rr_nodes 
+   ************************/
+  create_tileable_rr_graph_nodes(rr_graph,
+                                 rr_node_driver_switches,
+                                 rr_node_track_ids,
+                                 grids,
+                                 device_chan_width,
+                                 segment_inf,
+                                 wire_to_ipin_rr_switch,
+                                 delayless_rr_switch,
+                                 through_channel);
+
+  /************************************************************************
+   * Create the connectivity of OPINs
+   *   a. Evenly assign connections to OPINs to routing tracks
+   *   b. the connection pattern should be same across the fabric
+   *
+   * Create the connectivity of IPINs 
+   *   a. Evenly assign connections from routing tracks to IPINs
+   *   b. the connection pattern should be same across the fabric
+   ***********************************************************************/
+  /* get maximum number of pins across all blocks */
+  int max_pins = types[0].num_pins;
+  for (const auto& type : types) {
+    if (is_empty_type(&type)) {
+      continue;
+    }
+
+    if (type.num_pins > max_pins) {
+      max_pins = type.num_pins;
+    }
+  }
+    
+  /* Fc assignment still uses the old function from VPR.
+   * Should use tileable version so that we have can have full control
+   */
+  std::vector<size_t> num_tracks = get_num_tracks_per_seg_type(max_chan_width / 2, segment_inf, false);  
+  int* sets_per_seg_type = (int*)vtr::malloc(sizeof(int) * segment_inf.size());
+  VTR_ASSERT(num_tracks.size() == segment_inf.size());
+  for (size_t iseg = 0; iseg < num_tracks.size(); ++iseg) {
+    sets_per_seg_type[iseg] = num_tracks[iseg];
+  }
+
+  bool Fc_clipped = false;
+  /* [0..num_types-1][0..num_pins-1] */
+  std::vector<vtr::Matrix<int>> Fc_in;
+  Fc_in = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
+                                   e_fc_type::IN, UNI_DIRECTIONAL, &Fc_clipped);
+  if (Fc_clipped) {
+    *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
+  }
+
+  Fc_clipped = false;
+  /* [0..num_types-1][0..num_pins-1] */
+  std::vector<vtr::Matrix<int>> Fc_out;
+  Fc_out = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
+                                    e_fc_type::OUT, UNI_DIRECTIONAL, &Fc_clipped);
+
+  if (Fc_clipped) {
+    *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
+  }
+
+  /************************************************************************
+   * Build the connections tile by tile:
+   * We classify rr_nodes into a general switch block (GSB) data structure
+   * where we create edges to each rr_nodes in the GSB with respect to
+   * Fc_in and Fc_out, switch block patterns 
+   * In addition, we will also handle direct-connections:
+   * Add edges that bridge OPINs and IPINs to the rr_graph
+   ***********************************************************************/
+  /* Create edges for a tileable rr_graph */
+  build_rr_graph_edges(rr_graph,
+                       rr_node_driver_switches,
+                       grids,
+                       device_chan_width,
+                       segment_inf, 
+                       Fc_in, Fc_out,
+                       sb_type, Fs, sb_subtype, subFs,
+                       wire_opposite_side,
+                       num_threads);
+
+  /************************************************************************
+   * Build direction connection lists
+   * TODO: use tile direct builder
+   ***********************************************************************/
+  /* Create data structure of direct-connections */
+  t_clb_to_clb_directs* clb_to_clb_directs = NULL;
+  if (num_directs > 0) {
+    clb_to_clb_directs = alloc_and_load_clb_to_clb_directs(directs, num_directs, delayless_switch);
+  }
+  std::vector<t_direct_inf> arch_directs;
+  std::vector<t_clb_to_clb_directs> clb2clb_directs;
+  for (int idirect = 0; idirect < num_directs; ++idirect) {
+    arch_directs.push_back(directs[idirect]);
+    clb2clb_directs.push_back(clb_to_clb_directs[idirect]);
+  }
+
+  build_rr_graph_direct_connections(rr_graph, grids, delayless_rr_switch, 
+                                    arch_directs, clb2clb_directs);
+
+  /************************************************************************
+   * Free all temp stucts 
+   ***********************************************************************/
+  free(sets_per_seg_type);
+
+  if (nullptr != clb_to_clb_directs) {
+    free(clb_to_clb_directs);
+  }
+}
+
 /************************************************************************
  * Main function of this file
  * Builder for a detailed uni-directional tileable rr_graph
@@ -85,6 +268,9 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                                     int* wire_to_rr_ipin_switch,
                                     const bool& through_channel,
                                     const bool& wire_opposite_side,
+                                    const std::string& rr_graph_cache_file,
+                                    const size_t& num_threads,
+                                    const e_check_level& check_level,
                                     int *Warnings) { 
 
   vtr::ScopedStartFinishTimer timer("Build tileable routing resource graph");
@@ -137,126 +323,57 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
   VTR_ASSERT(true == device_ctx.rr_graph.valid_switch_id(wire_to_ipin_rr_switch)); 
   VTR_ASSERT(true == device_ctx.rr_graph.valid_switch_id(delayless_rr_switch)); 
 
-  /* A temp data about the driver switch ids for each rr_node */
-  vtr::vector<RRNodeId, RRSwitchId> rr_node_driver_switches; 
-
   /* A temp data about the track ids for each CHANX and CHANY rr_node */
   std::map<RRNodeId, std::vector<size_t>> rr_node_track_ids;
 
-  /************************
-   * Allocate the rr_nodes 
-   ************************/
-  alloc_tileable_rr_graph_nodes(device_ctx.rr_graph,
-                                rr_node_driver_switches,
-                                grids,
-                                device_chan_width,
-                                segment_inf,
-                                through_channel);
-
-  /************************
-   * Create all the rr_nodes 
-   ************************/
-  create_tileable_rr_graph_nodes(device_ctx.rr_graph,
-                                 rr_node_driver_switches,
-                                 rr_node_track_ids,
-                                 grids,
-                                 device_chan_width,
-                                 segment_inf,
-                                 wire_to_ipin_rr_switch,
-                                 delayless_rr_switch,
-                                 through_channel);
-
-  /************************************************************************
-   * Create the connectivity of OPINs
-   *   a. Evenly assign connections to OPINs to routing tracks
-   *   b. the connection pattern should be same across the fabric
-   *
-   * Create the connectivity of IPINs 
-   *   a. Evenly assign connections from routing tracks to IPINs
-   *   b. the connection pattern should be same across the fabric
-   ***********************************************************************/
   /* Global routing uses a single longwire track */
   int max_chan_width = find_unidir_routing_channel_width(chan_width.max);
   VTR_ASSERT(max_chan_width > 0);
 
-  /* get maximum number of pins across all blocks */
-  int max_pins = types[0].num_pins;
-  for (const auto& type : types) {
-    if (is_empty_type(&type)) {
-      continue;
-    }
-
-    if (type.num_pins > max_pins) {
-      max_pins = type.num_pins;
-    }
-  }
-    
-  /* Fc assignment still uses the old function from VPR.
-   * Should use tileable version so that we have can have full control
-   */
-  std::vector<size_t> num_tracks = get_num_tracks_per_seg_type(max_chan_width / 2, segment_inf, false);  
-  int* sets_per_seg_type = (int*)vtr::malloc(sizeof(int) * segment_inf.size());
-  VTR_ASSERT(num_tracks.size() == segment_inf.size());
-  for (size_t iseg = 0; iseg < num_tracks.size(); ++iseg) {
-    sets_per_seg_type[iseg] = num_tracks[iseg];
-  }
-
-  bool Fc_clipped = false;
-  /* [0..num_types-1][0..num_pins-1] */
-  std::vector<vtr::Matrix<int>> Fc_in;
-  Fc_in = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
-                                   e_fc_type::IN, UNI_DIRECTIONAL, &Fc_clipped);
-  if (Fc_clipped) {
-    *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
-  }
-
-  Fc_clipped = false;
-  /* [0..num_types-1][0..num_pins-1] */
-  std::vector<vtr::Matrix<int>> Fc_out;
-  Fc_out = alloc_and_load_actual_fc(types, max_pins, segment_inf, sets_per_seg_type, max_chan_width,
-                                    e_fc_type::OUT, UNI_DIRECTIONAL, &Fc_clipped);
-
-  if (Fc_clipped) {
-    *Warnings |= RR_GRAPH_WARN_FC_CLIPPED;
+  /************************
+   * Load the rr_nodes and edges from the binary rr_graph cache if it is
+   * built from the same inputs, otherwise create them and update the cache
+   ************************/
+  bool rr_graph_cache_loaded = false;
+  std::string rr_graph_id;
+  if (false == rr_graph_cache_file.empty()) {
+    rr_graph_id = find_tileable_rr_graph_id(grids, device_chan_width,
+                                            sb_type, Fs, sb_subtype, subFs,
+                                            segment_inf,
+                                            delayless_switch, wire_to_arch_ipin_switch,
+                                            num_directs,
+                                            through_channel, wire_opposite_side);
+    rr_graph_cache_loaded = read_binary_rr_graph_obj(rr_graph_cache_file, device_ctx.rr_graph, rr_graph_id);
   }
 
-  /************************************************************************
-   * Build the connections tile by tile:
-   * We classify rr_nodes into a general switch block (GSB) data structure
-   * where we create edges to each rr_nodes in the GSB with respect to
-   * Fc_in and Fc_out, switch block patterns 
-   * In addition, we will also handle direct-connections:
-   * Add edges that bridge OPINs and IPINs to the rr_graph
-   ***********************************************************************/
-  /* Create edges for a tileable rr_graph */
-  build_rr_graph_edges(device_ctx.rr_graph,
-                       rr_node_driver_switches,
-                       grids,
-                       device_chan_width,
-                       segment_inf, 
-                       Fc_in, Fc_out,
-                       sb_type, Fs, sb_subtype, subFs,
-                       wire_opposite_side);
-
-  /************************************************************************
-   * Build direction connection lists
-   * TODO: use tile direct builder
-   ***********************************************************************/
-  /* Create data structure of direct-connections */
-  t_clb_to_clb_directs* clb_to_clb_directs = NULL;
-  if (num_directs > 0) {
-    clb_to_clb_directs = alloc_and_load_clb_to_clb_directs(directs, num_directs, delayless_switch);
-  }
-  std::vector<t_direct_inf> arch_directs;
-  std::vector<t_clb_to_clb_directs> clb2clb_directs;
-  for (int idirect = 0; idirect < num_directs; ++idirect) {
-    arch_directs.push_back(directs[idirect]);
-    clb2clb_directs.push_back(clb_to_clb_directs[idirect]);
+  if (true == rr_graph_cache_loaded) {
+    /* The track ids of a routing track node are the same as its ptc numbers */
+    for (const RRNodeId& inode : device_ctx.rr_graph.nodes()) {
+      if ( (CHANX != device_ctx.rr_graph.node_type(inode))
+        && (CHANY != device_ctx.rr_graph.node_type(inode)) ) {
+        continue;
+      }
+      std::vector<short> track_ids = device_ctx.rr_graph.node_track_ids(inode);
+      rr_node_track_ids[inode] = std::vector<size_t>(track_ids.begin(), track_ids.end());
+    }
+  } else {
+    build_tileable_rr_graph_nodes_and_edges(device_ctx.rr_graph,
+                                            rr_node_track_ids,
+                                            types, grids,
+                                            device_chan_width, max_chan_width,
+                                            sb_type, Fs, sb_subtype, subFs,
+                                            segment_inf,
+                                            delayless_switch,
+                                            wire_to_ipin_rr_switch, delayless_rr_switch,
+                                            directs, num_directs,
+                                            through_channel, wire_opposite_side,
+                                            num_threads,
+                                            Warnings);
+    if (false == rr_graph_cache_file.empty()) {
+      write_binary_rr_graph_obj(rr_graph_cache_file, device_ctx.rr_graph, rr_graph_id);
+    }
   }
 
-  build_rr_graph_direct_connections(device_ctx.rr_graph, grids, delayless_rr_switch, 
-                                    arch_directs, clb2clb_directs);
-
   /* First time to build edges so that we can remap the architecture switch to rr_switch
    * This is a must-do before function alloc_and_load_rr_switch_inf() 
    */
@@ -306,24 +423,15 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
               "Fundamental errors occurred when validating rr_graph object!\n");
   }
 
-  check_rr_graph(GRAPH_UNIDIR, grids, types);
+  check_rr_graph(GRAPH_UNIDIR, grids, types, check_level);
   /* Error out if advanced checker of rr_graph fails */
-  if (false == check_rr_graph(device_ctx.rr_graph)) {
+  if (false == check_rr_graph(device_ctx.rr_graph, check_level)) {
     vpr_throw(VPR_ERROR_ROUTE,
               __FILE__,
               __LINE__,
               "Advanced checking rr_graph object fails! Routing may still work "
               "but not smooth\n");
   }
-
-  /************************************************************************
-   * Free all temp stucts 
-   ***********************************************************************/
-  free(sets_per_seg_type);
-
-  if (nullptr != clb_to_clb_directs) {
-    free(clb_to_clb_directs);
-  }
 }
 
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <string>
 #include <vector>
 
 #include "physical_types.h"
@@ -32,6 +33,9 @@ void build_tileable_unidir_rr_graph(const std::vector<t_physical_tile_type>& typ
                                     int* wire_to_rr_ipin_switch,
                                     const bool& through_channel,
                                     const bool& wire_opposite_side,
+                                    const std::string& rr_graph_cache_file,
+                                    const size_t& num_threads,
+                                    const e_check_level& check_level,
                                     int *Warnings); 
 
 } /* end namespace openfpga */
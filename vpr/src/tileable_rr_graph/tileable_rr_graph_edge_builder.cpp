@@ -11,6 +11,9 @@
 
 #include "vpr_utils.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 #include "rr_graph_builder_utils.h"
 #include "tileable_rr_graph_gsb.h"
 #include "tileable_rr_graph_edge_builder.h"
@@ -86,6 +89,12 @@ void build_rr_graph_edges_for_sink_nodes(RRGraph& rr_graph,
  * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks)
  * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks)
  * 3. create edges between OPINs and IPINs (direct-connections)
+ *
+ * The edges of each GSB depend only on the nodes around the GSB,
+ * so that GSBs are processed on multiple threads, each of which
+ * collects the edges of a GSB in a separated list.
+ * The lists are then added to the rr_graph in the order of GSBs, 
+ * so that the edge ids are the same whatever the number of threads is
  ***********************************************************************/
 void build_rr_graph_edges(RRGraph& rr_graph, 
                           const vtr::vector<RRNodeId, RRSwitchId>& rr_node_driver_switches,
@@ -96,45 +105,64 @@ void build_rr_graph_edges(RRGraph& rr_graph,
                           const std::vector<vtr::Matrix<int>>& Fc_out,
                           const e_switch_block_type& sb_type, const int& Fs,
                           const e_switch_block_type& sb_subtype, const int& subFs,
-                          const bool& wire_opposite_side) {
+                          const bool& wire_opposite_side,
+                          const size_t& num_threads) {
 
   /* Create edges for SOURCE and SINK nodes for a tileable rr_graph */
   build_rr_graph_edges_for_source_nodes(rr_graph, rr_node_driver_switches, grids);
   build_rr_graph_edges_for_sink_nodes(rr_graph, rr_node_driver_switches, grids);
 
   vtr::Point<size_t> gsb_range(grids.width() - 2, grids.height() - 2);
+  size_t num_gsb_y = gsb_range.y() + 1;
+
+  /* Edges to be created for each GSB, indexed by ix * num_gsb_y + iy.
+   * Note that the fast look-up of the rr_graph has been built by 
+   * the SOURCE and SINK edge builders, so that finding nodes
+   * is read-only on the threads
+   */
+  std::vector<t_rr_edge_info_set> gsb_edges_to_create((gsb_range.x() + 1) * num_gsb_y);
 
   /* Go Switch Block by Switch Block */
-  for (size_t ix = 0; ix <= gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy <= gsb_range.y(); ++iy) { 
-      //vpr_printf(TIO_MESSAGE_INFO, "Building edges for GSB[%lu][%lu]\n", ix, iy);
-
-      vtr::Point<size_t> gsb_coord(ix, iy);
-      /* Create a GSB object */
-      const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
-                                                      device_chan_width, segment_inf,
-                                                      gsb_coord);
-
-      /* adapt the track_to_ipin_lookup for the GSB nodes */      
-      t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
-      track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
-
-      /* adapt the opin_to_track_map for the GSB nodes */      
-      t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
-      opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out);
-
-      /* adapt the switch_block_conn for the GSB nodes */      
-      t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
-      sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb, 
-                                             sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
-                                             segment_inf);
-
-      /* Build edges for a GSB */
-      build_edges_for_one_tileable_rr_gsb(rr_graph, rr_gsb,
-                                          track2ipin_map, opin2track_map, 
-                                          sb_conn, rr_node_driver_switches);
-      /* Finish this GSB, go to the next*/
+  parallel_for(gsb_edges_to_create.size(), num_threads, [&](const size_t& igsb) {
+    vtr::Point<size_t> gsb_coord(igsb / num_gsb_y, igsb % num_gsb_y);
+    /* Create a GSB object */
+    const RRGSB& rr_gsb = build_one_tileable_rr_gsb(grids, rr_graph,
+                                                    device_chan_width, segment_inf,
+                                                    gsb_coord);
+
+    /* adapt the track_to_ipin_lookup for the GSB nodes */      
+    t_track2pin_map track2ipin_map; /* [0..track_gsb_side][0..num_tracks][ipin_indices] */
+    track2ipin_map = build_gsb_track_to_ipin_map(rr_graph, rr_gsb, grids, segment_inf, Fc_in);
+
+    /* adapt the opin_to_track_map for the GSB nodes */      
+    t_pin2track_map opin2track_map; /* [0..gsb_side][0..num_opin_node][track_indices] */
+    opin2track_map = build_gsb_opin_to_track_map(rr_graph, rr_gsb, grids, segment_inf, Fc_out);
+
+    /* adapt the switch_block_conn for the GSB nodes */      
+    t_track2track_map sb_conn; /* [0..from_gsb_side][0..chan_width-1][track_indices] */
+    sb_conn = build_gsb_track_to_track_map(rr_graph, rr_gsb, 
+                                           sb_type, Fs, sb_subtype, subFs, wire_opposite_side, 
+                                           segment_inf);
+
+    /* Build edges for a GSB */
+    build_edges_for_one_tileable_rr_gsb(gsb_edges_to_create[igsb], rr_gsb,
+                                        track2ipin_map, opin2track_map, 
+                                        sb_conn, rr_node_driver_switches);
+    /* Finish this GSB, go to the next*/
+  });
+
+  /* Add all the edges to the rr_graph at once */
+  size_t num_edges = rr_graph.edges().size();
+  for (const t_rr_edge_info_set& rr_edges_to_create : gsb_edges_to_create) {
+    num_edges += rr_edges_to_create.size();
+  }
+  rr_graph.reserve_edges(num_edges);
+  for (t_rr_edge_info_set& rr_edges_to_create : gsb_edges_to_create) {
+    for (const t_rr_edge_info& rr_edge : rr_edges_to_create) {
+      rr_graph.create_edge(rr_edge.from_node, rr_edge.to_node, RRSwitchId(rr_edge.switch_type));
     }
+    /* Release the memory as early as possible */
+    t_rr_edge_info_set().swap(rr_edges_to_create);
   }
 }
 
@@ -31,7 +31,8 @@ void build_rr_graph_edges(RRGraph& rr_graph,
                           const std::vector<vtr::Matrix<int>>& Fc_out,
                           const e_switch_block_type& sb_type, const int& Fs,
                           const e_switch_block_type& sb_subtype, const int& subFs,
-                          const bool& wire_opposite_side);
+                          const bool& wire_opposite_side,
+                          const size_t& num_threads);
 
 void build_rr_graph_direct_connections(RRGraph& rr_graph, 
                                        const DeviceGrid& grids, 
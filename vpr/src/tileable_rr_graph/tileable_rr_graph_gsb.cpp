@@ -919,8 +919,10 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
  * 1. create edges between CHANX | CHANY and IPINs (connections inside connection blocks) 
  * 2. create edges between OPINs, CHANX and CHANY (connections inside switch blocks) 
  * 3. create edges between OPINs and IPINs (direct-connections) 
+ * The edges are appended to a list, instead of the rr_graph, 
+ * so that GSBs can be processed in parallel
  ***********************************************************************/
-void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
+void build_edges_for_one_tileable_rr_gsb(t_rr_edge_info_set& rr_edges_to_create, 
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
                                          const t_pin2track_map& opin2track_map,
@@ -939,7 +941,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       /* 1. create edges between OPINs and CHANX|CHANY, using opin2track_map */
       /* add edges to the opin_node */
       for (const RRNodeId& track_node : opin2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(opin_node, track_node, rr_node_driver_switches[track_node]);
+        rr_edges_to_create.emplace_back(opin_node, track_node, size_t(rr_node_driver_switches[track_node]));
       }
     }
 
@@ -953,7 +955,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
       for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
         const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
         for (const RRNodeId& ipin_node : track2ipin_map[gsb_side][inode]) {
-          rr_graph.create_edge(chan_node, ipin_node, rr_node_driver_switches[ipin_node]);
+          rr_edges_to_create.emplace_back(chan_node, ipin_node, size_t(rr_node_driver_switches[ipin_node]));
         }
       }
     }
@@ -962,7 +964,7 @@ void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph,
     for (size_t inode = 0; inode < rr_gsb.get_chan_width(gsb_side); ++inode) {
       const RRNodeId& chan_node = rr_gsb.get_chan_node(gsb_side, inode); 
       for (const RRNodeId& track_node : track2track_map[gsb_side][inode]) {
-        rr_graph.create_edge(chan_node, track_node, rr_node_driver_switches[track_node]);
+        rr_edges_to_create.emplace_back(chan_node, track_node, size_t(rr_node_driver_switches[track_node]));
       }
     }
   }
@@ -991,14 +993,14 @@ void build_gsb_one_ipin_track2pin_map(const RRGraph& rr_graph,
   /* Get a list of segment_ids*/
   enum e_side chan_side = rr_gsb.get_cb_chan_side(ipin_side);
   SideManager chan_side_manager(chan_side);
-  std::vector<RRSegmentId> seg_list = rr_gsb.get_chan_segment_ids(chan_side);
+  const std::vector<RRSegmentId>& seg_list = rr_gsb.get_chan_segment_ids(chan_side);
   size_t chan_width = rr_gsb.get_chan_width(chan_side);
   SideManager ipin_side_manager(ipin_side);
   const RRNodeId& ipin_node = rr_gsb.get_ipin_node(ipin_side, ipin_node_id);
 
   for (size_t iseg = 0; iseg < seg_list.size(); ++iseg) {
     /* Get a list of node that have the segment id */
-    std::vector<size_t> track_list = rr_gsb.get_chan_node_ids_by_segment_ids(chan_side, seg_list[iseg]);
+    const std::vector<size_t>& track_list = rr_gsb.get_chan_node_ids_by_segment_ids(chan_side, seg_list[iseg]);
     /* Refine the track_list: keep those will have connection blocks in the GSB */
     std::vector<size_t> actual_track_list;
     for (size_t inode = 0; inode < track_list.size(); ++inode) {
@@ -1083,14 +1085,14 @@ void build_gsb_one_opin_pin2track_map(const RRGraph& rr_graph,
                                       const std::vector<t_segment_inf>& segment_inf, 
                                       t_pin2track_map& opin2track_map) {
   /* Get a list of segment_ids*/
-  std::vector<RRSegmentId> seg_list = rr_gsb.get_chan_segment_ids(opin_side);
+  const std::vector<RRSegmentId>& seg_list = rr_gsb.get_chan_segment_ids(opin_side);
   enum e_side chan_side = opin_side;
   size_t chan_width = rr_gsb.get_chan_width(chan_side);
   SideManager opin_side_manager(opin_side);
 
   for (size_t iseg = 0; iseg < seg_list.size(); ++iseg) {
     /* Get a list of node that have the segment id */
-    std::vector<size_t> track_list = rr_gsb.get_chan_node_ids_by_segment_ids(chan_side, seg_list[iseg]);
+    const std::vector<size_t>& track_list = rr_gsb.get_chan_node_ids_by_segment_ids(chan_side, seg_list[iseg]);
     /* Refine the track_list: keep those will have connection blocks in the GSB */
     std::vector<size_t> actual_track_list;
     for (size_t inode = 0; inode < track_list.size(); ++inode) {
@@ -14,6 +14,9 @@
 
 #include "rr_gsb.h"
 #include "rr_graph_obj.h"
+/* The edge list type is from VPR, which requires the definition of DeviceContext */
+#include "vpr_context.h"
+#include "rr_graph2.h"
 #include "clb2clb_directs.h"
 
 /********************************************************************
@@ -48,7 +51,7 @@ RRGSB build_one_tileable_rr_gsb(const DeviceGrid& grids,
                                 const std::vector<t_segment_inf>& segment_inf,
                                 const vtr::Point<size_t>& gsb_coordinate);
 
-void build_edges_for_one_tileable_rr_gsb(RRGraph& rr_graph, 
+void build_edges_for_one_tileable_rr_gsb(t_rr_edge_info_set& rr_edges_to_create, 
                                          const RRGSB& rr_gsb,
                                          const t_track2pin_map& track2ipin_map,
                                          const t_pin2track_map& opin2track_map,
@@ -0,0 +1,233 @@
+#include <limits>
+
+#include "IncrementalSetupTimingAnalyzer.h"
+
+#include "tatum/base/validate_timing_graph_constraints.hpp"
+
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+//Above this fraction of the timing graph nodes to re-analyze, a full update
+//(whose traversals are simpler and parallel) is faster than an incremental one
+static constexpr float MAX_INCREMENTAL_DIRTY_NODE_FRACTION = 0.25;
+
+IncrementalSetupTimingAnalyzer::IncrementalSetupTimingAnalyzer(const tatum::TimingGraph& timing_graph,
+                                                               const tatum::TimingConstraints& timing_constraints,
+                                                               const tatum::DelayCalculator& delay_calculator)
+    : timing_graph_(timing_graph)
+    , timing_constraints_(timing_constraints)
+    , delay_calculator_(delay_calculator)
+    , setup_visitor_(timing_graph_.nodes().size(), timing_graph_.edges().size()) {
+    tatum::validate_timing_graph_constraints(timing_graph_, timing_constraints_);
+
+    size_t num_nodes = timing_graph_.nodes().size();
+
+    node_levels_.resize(num_nodes, 0);
+    for (tatum::LevelId level : timing_graph_.levels()) {
+        for (tatum::NodeId node : timing_graph_.level_nodes(level)) {
+            node_levels_[size_t(node)] = size_t(level);
+        }
+    }
+    dirty_level_nodes_.resize(timing_graph_.levels().size());
+
+    is_edge_invalidated_.resize(timing_graph_.edges().size(), false);
+    is_node_dirty_.resize(num_nodes, false);
+    is_node_required_dirty_.resize(num_nodes, false);
+
+    profiling_data_["total_analysis_sec"] = 0.;
+    profiling_data_["analysis_sec"] = 0.;
+    profiling_data_["num_full_updates"] = 0.;
+    profiling_data_["num_incremental_updates"] = 0.;
+}
+
+void IncrementalSetupTimingAnalyzer::invalidate_edge(tatum::EdgeId edge) {
+    if (full_update_needed_ || is_edge_invalidated_[size_t(edge)]) {
+        return;
+    }
+    is_edge_invalidated_[size_t(edge)] = true;
+    invalidated_edges_.push_back(edge);
+}
+
+void IncrementalSetupTimingAnalyzer::invalidate_all() {
+    full_update_needed_ = true;
+}
+
+double IncrementalSetupTimingAnalyzer::get_profiling_data_impl(std::string key) const {
+    auto iter = profiling_data_.find(key);
+    if (iter == profiling_data_.end()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return iter->second;
+}
+
+void IncrementalSetupTimingAnalyzer::update_setup_timing_impl() {
+    vtr::Timer timer;
+
+    if (full_update_needed_ || !incremental_update()) {
+        full_update();
+        profiling_data_["num_full_updates"] += 1;
+    } else {
+        profiling_data_["num_incremental_updates"] += 1;
+    }
+
+    for (tatum::EdgeId edge : invalidated_edges_) {
+        is_edge_invalidated_[size_t(edge)] = false;
+    }
+    invalidated_edges_.clear();
+    full_update_needed_ = false;
+
+    double analysis_sec = timer.elapsed_sec();
+    profiling_data_["analysis_sec"] = analysis_sec;
+    profiling_data_["total_analysis_sec"] += analysis_sec;
+}
+
+void IncrementalSetupTimingAnalyzer::full_update() {
+    full_walker_.do_reset(timing_graph_, setup_visitor_);
+
+    full_walker_.do_arrival_pre_traversal(timing_graph_, timing_constraints_, setup_visitor_);
+    full_walker_.do_arrival_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor_);
+
+    full_walker_.do_required_pre_traversal(timing_graph_, timing_constraints_, setup_visitor_);
+    full_walker_.do_required_traversal(timing_graph_, timing_constraints_, delay_calculator_, setup_visitor_);
+
+    full_walker_.do_update_slack(timing_graph_, delay_calculator_, setup_visitor_);
+}
+
+bool IncrementalSetupTimingAnalyzer::incremental_update() {
+    if (!mark_dirty_nodes()) {
+        clear_dirty_nodes();
+        return false;
+    }
+
+    //Since the tags of the dirty nodes are cleared, both their arrival and required
+    //times are re-computed. Their non-dirty fanins and fanouts are up-to-date.
+    for (tatum::NodeId node : dirty_nodes_) {
+        setup_visitor_.do_reset_node(node);
+        dirty_level_nodes_[node_levels_[size_t(node)]].push_back(node);
+    }
+
+    //Arrival times
+    for (tatum::NodeId node : dirty_level_nodes_[0]) {
+        setup_visitor_.do_arrival_pre_traverse_node(timing_graph_, timing_constraints_, node);
+    }
+    for (const auto& level_nodes : dirty_level_nodes_) {
+        for (tatum::NodeId node : level_nodes) {
+            setup_visitor_.do_arrival_traverse_node(timing_graph_, timing_constraints_, delay_calculator_, node);
+        }
+    }
+
+    //Required times (the required times of the sinks are set by the arrival traversal)
+    for (auto iter = dirty_level_nodes_.rbegin(); iter != dirty_level_nodes_.rend(); ++iter) {
+        for (tatum::NodeId node : *iter) {
+            setup_visitor_.do_required_traverse_node(timing_graph_, timing_constraints_, delay_calculator_, node);
+        }
+    }
+
+    //Slacks, of the dirty nodes and of all the edges driven by them (which are the
+    //input edges of the dirty nodes and of their fanouts)
+    std::vector<tatum::NodeId> slack_nodes = dirty_nodes_;
+    for (tatum::NodeId node : dirty_nodes_) {
+        for (tatum::EdgeId edge : timing_graph_.node_out_edges(node)) {
+            tatum::NodeId sink_node = timing_graph_.edge_sink_node(edge);
+            if (!is_node_dirty_[size_t(sink_node)]) {
+                is_node_dirty_[size_t(sink_node)] = true;
+                slack_nodes.push_back(sink_node);
+            }
+        }
+    }
+    for (tatum::NodeId node : slack_nodes) {
+        for (tatum::EdgeId edge : timing_graph_.node_in_edges(node)) {
+            setup_visitor_.do_reset_edge(edge);
+        }
+        //The slacks of the non-dirty nodes are unchanged, and merging them again keeps them
+        setup_visitor_.do_slack_traverse_node(timing_graph_, delay_calculator_, node);
+    }
+    for (tatum::NodeId node : slack_nodes) {
+        is_node_dirty_[size_t(node)] = false;
+    }
+    dirty_nodes_.clear();
+    for (auto& level_nodes : dirty_level_nodes_) {
+        level_nodes.clear();
+    }
+
+    return true;
+}
+
+bool IncrementalSetupTimingAnalyzer::mark_dirty_nodes() {
+    size_t max_dirty_nodes = MAX_INCREMENTAL_DIRTY_NODE_FRACTION * timing_graph_.nodes().size();
+    std::vector<tatum::NodeId> queue;
+
+    //The arrival times change in the fanout cone of the changed edges
+    for (tatum::EdgeId edge : invalidated_edges_) {
+        mark_dirty_node(timing_graph_.edge_sink_node(edge), queue);
+    }
+    while (!queue.empty()) {
+        tatum::NodeId node = queue.back();
+        queue.pop_back();
+
+        if (timing_graph_.node_type(node) == tatum::NodeType::CPIN) {
+            //A change of the clock network, which affects all the capture points
+            return false;
+        }
+        if (dirty_nodes_.size() > max_dirty_nodes) {
+            return false;
+        }
+
+        for (tatum::EdgeId edge : timing_graph_.node_out_edges(node)) {
+            mark_dirty_node(timing_graph_.edge_sink_node(edge), queue);
+        }
+    }
+
+    //The required times change in the fanin cone of the changed edges. The nodes
+    //of the arrival cone may also be in it, so the visited nodes are tracked apart
+    std::vector<tatum::NodeId> required_nodes;
+    auto mark_required_node = [&](tatum::NodeId node) {
+        if (is_node_required_dirty_[size_t(node)]) {
+            return;
+        }
+        is_node_required_dirty_[size_t(node)] = true;
+        required_nodes.push_back(node);
+        queue.push_back(node);
+        if (!is_node_dirty_[size_t(node)]) {
+            is_node_dirty_[size_t(node)] = true;
+            dirty_nodes_.push_back(node);
+        }
+    };
+    for (tatum::EdgeId edge : invalidated_edges_) {
+        mark_required_node(timing_graph_.edge_src_node(edge));
+    }
+    while (!queue.empty() && dirty_nodes_.size() <= max_dirty_nodes) {
+        tatum::NodeId node = queue.back();
+        queue.pop_back();
+
+        //Required times are not propagated through the clock network
+        if (timing_graph_.node_type(node) == tatum::NodeType::CPIN) continue;
+
+        for (tatum::EdgeId edge : timing_graph_.node_in_edges(node)) {
+            tatum::NodeId src_node = timing_graph_.edge_src_node(edge);
+            if (timing_graph_.node_type(src_node) == tatum::NodeType::CPIN) continue;
+            mark_required_node(src_node);
+        }
+    }
+    for (tatum::NodeId node : required_nodes) {
+        is_node_required_dirty_[size_t(node)] = false;
+    }
+
+    return dirty_nodes_.size() <= max_dirty_nodes;
+}
+
+void IncrementalSetupTimingAnalyzer::mark_dirty_node(tatum::NodeId node, std::vector<tatum::NodeId>& queue) {
+    if (is_node_dirty_[size_t(node)]) {
+        return;
+    }
+    is_node_dirty_[size_t(node)] = true;
+    dirty_nodes_.push_back(node);
+    queue.push_back(node);
+}
+
+void IncrementalSetupTimingAnalyzer::clear_dirty_nodes() {
+    for (tatum::NodeId node : dirty_nodes_) {
+        is_node_dirty_[size_t(node)] = false;
+    }
+    dirty_nodes_.clear();
+}
@@ -0,0 +1,88 @@
+#ifndef VPR_INCREMENTAL_SETUP_TIMING_ANALYZER_H
+#define VPR_INCREMENTAL_SETUP_TIMING_ANALYZER_H
+#include <map>
+#include <string>
+#include <vector>
+
+#include "tatum/TimingGraph.hpp"
+#include "tatum/TimingConstraints.hpp"
+#include "tatum/SetupAnalysis.hpp"
+#include "tatum/analyzers/SetupTimingAnalyzer.hpp"
+#include "tatum/delay_calc/DelayCalculator.hpp"
+
+#include "timing_info.h"
+
+//A setup timing analyzer which only re-analyzes the parts of the timing graph
+//affected by the edges whose delays changed since the last update (as reported
+//by invalidate_edge()), and gives the same results as a full analysis.
+//
+//The arrival times can only change in the fanout cone of the changed edges, and
+//the required times in the fanin cone of their source nodes. The nodes of these
+//cones are re-analyzed level by level, and the slacks are re-computed on their
+//edges and those of their fanouts.
+//
+//A full analysis is done instead on the first update, after invalidate_all(),
+//when the cones cover a large part of the timing graph, and when a changed edge
+//drives the clock network (which moves the required times of all the capture points).
+class IncrementalSetupTimingAnalyzer : public tatum::SetupTimingAnalyzer {
+  public:
+    IncrementalSetupTimingAnalyzer(const tatum::TimingGraph& timing_graph,
+                                   const tatum::TimingConstraints& timing_constraints,
+                                   const tatum::DelayCalculator& delay_calculator);
+
+    //Records that the delay of an edge changed since the last update
+    void invalidate_edge(tatum::EdgeId edge);
+
+    //Requests a full analysis on the next update
+    void invalidate_all();
+
+  protected:
+    //TimingAnalyzer
+    void update_timing_impl() override { update_setup_timing(); }
+    double get_profiling_data_impl(std::string key) const override;
+    size_t num_unconstrained_startpoints_impl() const override { return full_walker_.num_unconstrained_startpoints(); }
+    size_t num_unconstrained_endpoints_impl() const override { return full_walker_.num_unconstrained_endpoints(); }
+
+    //SetupTimingAnalyzer
+    void update_setup_timing_impl() override;
+    tatum::TimingTags::tag_range setup_tags_impl(tatum::NodeId node_id) const override { return setup_visitor_.setup_tags(node_id); }
+    tatum::TimingTags::tag_range setup_tags_impl(tatum::NodeId node_id, tatum::TagType type) const override { return setup_visitor_.setup_tags(node_id, type); }
+    tatum::TimingTags::tag_range setup_edge_slacks_impl(tatum::EdgeId edge_id) const override { return setup_visitor_.setup_edge_slacks(edge_id); }
+    tatum::TimingTags::tag_range setup_node_slacks_impl(tatum::NodeId node_id) const override { return setup_visitor_.setup_node_slacks(node_id); }
+
+  private:
+    void full_update();
+
+    //Re-analyzes the cones of the changed edges, or returns false (without
+    //changing the analysis) if a full update is needed instead
+    bool incremental_update();
+
+    //Marks the nodes of the cones to re-analyze in dirty_nodes_, or returns false
+    //if a full update is needed instead
+    bool mark_dirty_nodes();
+    void mark_dirty_node(tatum::NodeId node, std::vector<tatum::NodeId>& queue);
+    void clear_dirty_nodes();
+
+  private:
+    const tatum::TimingGraph& timing_graph_;
+    const tatum::TimingConstraints& timing_constraints_;
+    const tatum::DelayCalculator& delay_calculator_;
+    tatum::SetupAnalysis setup_visitor_;
+    TimingAnalysisWalker full_walker_;
+
+    std::vector<size_t> node_levels_; //[0..num_nodes-1]
+
+    bool full_update_needed_ = true;
+    std::vector<tatum::EdgeId> invalidated_edges_;
+    std::vector<bool> is_edge_invalidated_;
+
+    //Scratch data of the incremental updates
+    std::vector<tatum::NodeId> dirty_nodes_;
+    std::vector<bool> is_node_dirty_;
+    std::vector<bool> is_node_required_dirty_;
+    std::vector<std::vector<tatum::NodeId>> dirty_level_nodes_;
+
+    std::map<std::string, double> profiling_data_;
+};
+
+#endif
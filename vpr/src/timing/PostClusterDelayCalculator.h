@@ -74,6 +74,11 @@ class PostClusterDelayCalculator : public tatum::DelayCalculator {
     float tsu_margin_rel_ = 1.0;
     float tsu_margin_abs_ = 0.0e-12;
 
+    //The caches are sized for all the timing edges on construction, and are never resized
+    //while timing is analyzed: each entry is only read and written by the calls for its own
+    //edge. Since a parallel graph walker only asks for the delays of an edge from the node at
+    //one end of the edge during a traversal, the delays may be calculated concurrently from
+    //the nodes of a level. (clear_cache() and the setters must not be called during an analysis.)
     mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_min_delay_cache_;
     mutable vtr::vector<tatum::EdgeId, tatum::Time> edge_max_delay_cache_;
     mutable vtr::vector<tatum::EdgeId, tatum::Time> driver_clb_min_delay_cache_;
@@ -0,0 +1,131 @@
+#ifndef VPR_PARALLEL_WALKER_H
+#define VPR_PARALLEL_WALKER_H
+#include <algorithm>
+
+#include "tatum/graph_walkers/TimingGraphWalker.hpp"
+#include "tatum/graph_visitors/GraphVisitor.hpp"
+#include "tatum/TimingGraph.hpp"
+
+#include "openfpga_parallel.h"
+
+//A timing graph walker which traverses the timing graph in a levelized manner,
+//like tatum::ParallelWalker, but processes the nodes of each level in parallel
+//on the shared thread pool of OpenFPGA, so that timing analysis is parallel
+//even when Tatum is built without TBB.
+//
+//The number of threads is shared by all the walkers, and is set once from
+//--num_workers (see set_num_threads()).
+//
+//The visitors and delay calculators must be safe to call concurrently on the
+//nodes of a level: each node only writes its own tags, and the delay of an edge
+//is only requested by the node at one end of the edge during a traversal.
+class VprParallelWalker : public tatum::TimingGraphWalker {
+  public:
+    //Sets the number of threads of all the walkers (0 for all the cores)
+    static void set_num_threads(size_t num_threads) { num_threads_ref() = num_threads; }
+    static size_t num_threads() { return num_threads_ref(); }
+
+  protected:
+    void do_arrival_pre_traversal_impl(const tatum::TimingGraph& tg, const tatum::TimingConstraints& tc, tatum::GraphVisitor& visitor) override {
+        tatum::LevelId first_level = *tg.levels().begin();
+        auto nodes = tg.level_nodes(first_level);
+
+        num_unconstrained_startpoints_ = count_nodes(nodes, [&](tatum::NodeId node) {
+            return !visitor.do_arrival_pre_traverse_node(tg, tc, node);
+        });
+    }
+
+    void do_required_pre_traversal_impl(const tatum::TimingGraph& tg, const tatum::TimingConstraints& tc, tatum::GraphVisitor& visitor) override {
+        auto nodes = tg.logical_outputs();
+
+        num_unconstrained_endpoints_ = count_nodes(nodes, [&](tatum::NodeId node) {
+            return !visitor.do_required_pre_traverse_node(tg, tc, node);
+        });
+    }
+
+    void do_arrival_traversal_impl(const tatum::TimingGraph& tg, const tatum::TimingConstraints& tc, const tatum::DelayCalculator& dc, tatum::GraphVisitor& visitor) override {
+        for (tatum::LevelId level_id : tg.levels()) {
+            for_each_item(tg.level_nodes(level_id), [&](tatum::NodeId node) {
+                visitor.do_arrival_traverse_node(tg, tc, dc, node);
+            });
+        }
+    }
+
+    void do_required_traversal_impl(const tatum::TimingGraph& tg, const tatum::TimingConstraints& tc, const tatum::DelayCalculator& dc, tatum::GraphVisitor& visitor) override {
+        for (tatum::LevelId level_id : tg.reversed_levels()) {
+            for_each_item(tg.level_nodes(level_id), [&](tatum::NodeId node) {
+                visitor.do_required_traverse_node(tg, tc, dc, node);
+            });
+        }
+    }
+
+    void do_update_slack_impl(const tatum::TimingGraph& tg, const tatum::DelayCalculator& dc, tatum::GraphVisitor& visitor) override {
+        for_each_item(tg.nodes(), [&](tatum::NodeId node) {
+            visitor.do_slack_traverse_node(tg, dc, node);
+        });
+    }
+
+    void do_reset_impl(const tatum::TimingGraph& tg, tatum::GraphVisitor& visitor) override {
+        for_each_item(tg.nodes(), [&](tatum::NodeId node) {
+            visitor.do_reset_node(node);
+        });
+        for_each_item(tg.edges(), [&](tatum::EdgeId edge) {
+            visitor.do_reset_edge(edge);
+        });
+    }
+
+    size_t num_unconstrained_startpoints_impl() const override { return num_unconstrained_startpoints_; }
+    size_t num_unconstrained_endpoints_impl() const override { return num_unconstrained_endpoints_; }
+
+  private:
+    //The items (nodes or edges) are processed by chunks, so that the threads do not
+    //synchronize for each item, and small levels are processed by the calling thread
+    static constexpr size_t CHUNK_SIZE = 256;
+
+    template<typename Range, typename Func>
+    static void for_each_item(const Range& items, const Func& func) {
+        size_t num_items = items.size();
+        size_t num_chunks = (num_items + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        openfpga::parallel_for(num_chunks, (num_chunks > 1) ? num_threads() : 1, [&](const size_t& ichunk) {
+            auto begin = items.begin() + ichunk * CHUNK_SIZE;
+            auto end = items.begin() + std::min(num_items, (ichunk + 1) * CHUNK_SIZE);
+            for (auto iter = begin; iter != end; ++iter) {
+                func(*iter);
+            }
+        });
+    }
+
+    //Counts the nodes for which pred is true, calling it on each node
+    template<typename Range, typename Pred>
+    static size_t count_nodes(const Range& nodes, const Pred& pred) {
+        size_t num_nodes = nodes.size();
+        size_t num_chunks = (num_nodes + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        return openfpga::parallel_reduce<size_t>(
+            num_chunks, (num_chunks > 1) ? num_threads() : 1, 0,
+            [&](const size_t& ichunk) {
+                size_t count = 0;
+                auto begin = nodes.begin() + ichunk * CHUNK_SIZE;
+                auto end = nodes.begin() + std::min(num_nodes, (ichunk + 1) * CHUNK_SIZE);
+                for (auto iter = begin; iter != end; ++iter) {
+                    if (pred(*iter)) {
+                        ++count;
+                    }
+                }
+                return count;
+            },
+            [](const size_t& lhs, const size_t& rhs) { return lhs + rhs; });
+    }
+
+    static size_t& num_threads_ref() {
+        static size_t num_threads = 1;
+        return num_threads;
+    }
+
+  private:
+    size_t num_unconstrained_startpoints_ = 0;
+    size_t num_unconstrained_endpoints_ = 0;
+};
+
+#endif
@@ -88,6 +88,21 @@ void load_net_delay_from_routing(vtr::vector<ClusterNetId, float*>& net_delay) {
     }
 }
 
+void load_net_delay_from_routing(vtr::vector<ClusterNetId, float*>& net_delay,
+                                 const std::vector<ClusterNetId>& nets) {
+    /* Same as above, but only loads the delays of the given nets, *
+     * e.g., those whose routing was loaded from a previous run.   */
+    auto& cluster_ctx = g_vpr_ctx.clustering();
+
+    for (auto net_id : nets) {
+        if (cluster_ctx.clb_nlist.net_is_ignored(net_id)) {
+            load_one_constant_net_delay(net_delay, net_id, 0.);
+        } else {
+            load_one_net_delay(net_delay, net_id);
+        }
+    }
+}
+
 static void load_one_net_delay(vtr::vector<ClusterNetId, float*>& net_delay, ClusterNetId net_id) {
     /* This routine loads delay values for one net in                            *
      * net_delay[net_id][1..num_pins-1]. First, from the traceback, it           *
@@ -6,11 +6,28 @@
 #include "tatum/analyzer_factory.hpp"
 #include "tatum/timing_paths.hpp"
 #include "timing_util.h"
+#include "VprParallelWalker.h"
+
+//The graph walker of the timing analyzers.
+//With TBB, Tatum's parallel walker runs on the TBB scheduler (whose number of threads
+//is set from --num_workers). Otherwise, the nodes of each level are processed on the
+//thread pool of OpenFPGA by VprParallelWalker.
+#ifdef TATUM_USE_TBB
+using TimingAnalysisWalker = tatum::ParallelWalker;
+#else
+using TimingAnalysisWalker = VprParallelWalker;
+#endif
 
 //Create a SetupTimingInfo for the given delay calculator
 template<class DelayCalc>
 std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator);
 
+//Create a SetupTimingInfo for the given delay calculator, which uses the given
+//analyzer (which must have been created with the same delay calculator)
+template<class DelayCalc>
+std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator,
+                                                        std::shared_ptr<tatum::SetupTimingAnalyzer> analyzer);
+
 //Create a HoldTimingInfo for the given delay calculator
 template<class DelayCalc>
 std::unique_ptr<HoldTimingInfo> make_hold_timing_info(std::shared_ptr<DelayCalc> delay_calculator);
@@ -145,7 +162,15 @@ template<class DelayCalc>
 std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
-    std::shared_ptr<tatum::SetupTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    std::shared_ptr<tatum::SetupTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::SetupAnalysis, TimingAnalysisWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+
+    return std::make_unique<ConcreteSetupTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
+}
+
+template<class DelayCalc>
+std::unique_ptr<SetupTimingInfo> make_setup_timing_info(std::shared_ptr<DelayCalc> delay_calculator,
+                                                        std::shared_ptr<tatum::SetupTimingAnalyzer> analyzer) {
+    auto& timing_ctx = g_vpr_ctx.timing();
 
     return std::make_unique<ConcreteSetupTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
 }
@@ -154,7 +179,7 @@ template<class DelayCalc>
 std::unique_ptr<HoldTimingInfo> make_hold_timing_info(std::shared_ptr<DelayCalc> delay_calculator) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
-    std::shared_ptr<tatum::HoldTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    std::shared_ptr<tatum::HoldTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::HoldAnalysis, TimingAnalysisWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
 
     return std::make_unique<ConcreteHoldTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
 }
@@ -163,7 +188,7 @@ template<class DelayCalc>
 std::unique_ptr<SetupHoldTimingInfo> make_setup_hold_timing_info(std::shared_ptr<DelayCalc> delay_calculator) {
     auto& timing_ctx = g_vpr_ctx.timing();
 
-    std::shared_ptr<tatum::SetupHoldTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, tatum::ParallelWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
+    std::shared_ptr<tatum::SetupHoldTimingAnalyzer> analyzer = tatum::AnalyzerFactory<tatum::SetupHoldAnalysis, TimingAnalysisWalker>::make(*timing_ctx.graph, *timing_ctx.constraints, *delay_calculator);
 
     return std::make_unique<ConcreteSetupHoldTimingInfo<DelayCalc>>(timing_ctx.graph, timing_ctx.constraints, delay_calculator, analyzer);
 }
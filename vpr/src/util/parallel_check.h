@@ -0,0 +1,100 @@
+#ifndef PARALLEL_CHECK_H
+#define PARALLEL_CHECK_H
+
+/* Helpers to run the independent legality checks of the rr_graph and of the
+ * routing (one per node, edge or net) in parallel when VPR is built with TBB.
+ *
+ * With e_check_level::SAMPLED, only one item out of CHECK_SAMPLE_STRIDE is
+ * checked (the same ones on every run). */
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include "vpr_types.h"
+
+#if defined(VPR_USE_TBB)
+#    include <tbb/blocked_range.h>
+#    include <tbb/enumerable_thread_specific.h>
+#    include <tbb/parallel_for.h>
+#endif
+
+constexpr size_t CHECK_SAMPLE_STRIDE = 16;
+
+inline bool is_item_checked(e_check_level check_level, size_t item) {
+    return check_level == e_check_level::FULL || item % CHECK_SAMPLE_STRIDE == 0;
+}
+
+/* Runs check(item) on the items [0, num_items) to check, which report their
+ * errors by throwing. Each thread keeps the first error of its items, and the
+ * error of the lowest item is re-thrown once all the threads are done, so the
+ * error reported does not depend on the scheduling */
+template<typename CheckFunc>
+void parallel_check(size_t num_items, e_check_level check_level, const CheckFunc& check) {
+#if defined(VPR_USE_TBB)
+    typedef std::pair<size_t, std::exception_ptr> t_item_error;
+    tbb::enumerable_thread_specific<t_item_error> thread_errors(t_item_error(num_items, nullptr));
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_items), [&](const tbb::blocked_range<size_t>& range) {
+        t_item_error& error = thread_errors.local();
+        //Items after the first error of the thread are not needed
+        for (size_t item = range.begin(); item < range.end() && item < error.first; ++item) {
+            if (!is_item_checked(check_level, item)) continue;
+            try {
+                check(item);
+            } catch (...) {
+                error = t_item_error(item, std::current_exception());
+            }
+        }
+    });
+
+    t_item_error first_error(num_items, nullptr);
+    for (const t_item_error& error : thread_errors) {
+        if (error.first < first_error.first) {
+            first_error = error;
+        }
+    }
+    if (first_error.second) {
+        std::rethrow_exception(first_error.second);
+    }
+#else
+    for (size_t item = 0; item < num_items; ++item) {
+        if (!is_item_checked(check_level, item)) continue;
+        check(item);
+    }
+#endif
+}
+
+/* Returns, in increasing order, the items to check in [0, num_items) for which
+ * is_invalid(item) is true, so the caller can report them in a fixed order */
+template<typename InvalidFunc>
+std::vector<size_t> parallel_find_invalid(size_t num_items, e_check_level check_level, const InvalidFunc& is_invalid) {
+    std::vector<size_t> invalid_items;
+#if defined(VPR_USE_TBB)
+    tbb::enumerable_thread_specific<std::vector<size_t>> thread_invalid_items;
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_items), [&](const tbb::blocked_range<size_t>& range) {
+        std::vector<size_t>& items = thread_invalid_items.local();
+        for (size_t item = range.begin(); item < range.end(); ++item) {
+            if (is_item_checked(check_level, item) && is_invalid(item)) {
+                items.push_back(item);
+            }
+        }
+    });
+
+    for (const std::vector<size_t>& items : thread_invalid_items) {
+        invalid_items.insert(invalid_items.end(), items.begin(), items.end());
+    }
+    std::sort(invalid_items.begin(), invalid_items.end());
+#else
+    for (size_t item = 0; item < num_items; ++item) {
+        if (is_item_checked(check_level, item) && is_invalid(item)) {
+            invalid_items.push_back(item);
+        }
+    }
+#endif
+    return invalid_items;
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include <new>
+
+#include "vtr_assert.h"
+
+#include "vpr_types.h"
+#include "pb_arena.h"
+
+PbArena::~PbArena() {
+    //The pbs given back are reset rather than destroyed, so every pb is destroyed here once
+    for (const auto& block : pb_blocks_) {
+        for (int ipb = 0; ipb < block.second; ++ipb) {
+            block.first[ipb].~t_pb();
+        }
+    }
+    vtr::free_chunk_memory(&chunk_);
+}
+
+t_pb* PbArena::alloc_pbs(int num_pbs) {
+    VTR_ASSERT(num_pbs > 0);
+
+    auto free_it = free_pbs_.find(num_pbs);
+    if (free_it != free_pbs_.end() && !free_it->second.empty()) {
+        t_pb* pbs = free_it->second.back();
+        free_it->second.pop_back();
+        return pbs;
+    }
+
+    t_pb* pbs = static_cast<t_pb*>(vtr::chunk_malloc(num_pbs * sizeof(t_pb), &chunk_));
+    for (int ipb = 0; ipb < num_pbs; ++ipb) {
+        new (&pbs[ipb]) t_pb();
+    }
+    pb_blocks_.emplace_back(pbs, num_pbs);
+    return pbs;
+}
+
+t_pb** PbArena::alloc_pb_arrays(int num_arrays) {
+    VTR_ASSERT(num_arrays > 0);
+
+    t_pb** arrays = nullptr;
+    auto free_it = free_pb_arrays_.find(num_arrays);
+    if (free_it != free_pb_arrays_.end() && !free_it->second.empty()) {
+        arrays = free_it->second.back();
+        free_it->second.pop_back();
+    } else {
+        arrays = static_cast<t_pb**>(vtr::chunk_malloc(num_arrays * sizeof(t_pb*), &chunk_));
+    }
+    for (int iarray = 0; iarray < num_arrays; ++iarray) {
+        arrays[iarray] = nullptr;
+    }
+    return arrays;
+}
+
+void PbArena::free_pbs(t_pb* pbs, int num_pbs) {
+    for (int ipb = 0; ipb < num_pbs; ++ipb) {
+        pbs[ipb].~t_pb();
+        new (&pbs[ipb]) t_pb();
+    }
+    free_pbs_[num_pbs].push_back(pbs);
+}
+
+void PbArena::free_pb_arrays(t_pb** arrays, int num_arrays) {
+    free_pb_arrays_[num_arrays].push_back(arrays);
+}
@@ -0,0 +1,55 @@
+#ifndef PB_ARENA_H
+#define PB_ARENA_H
+
+/* An arena for the children of the pb trees (t_pb::child_pbs) of a clustered
+ * netlist.
+ *
+ * The arrays of pbs and of pointers to them are carved out of large chunks
+ * (vtr::chunk_malloc()), rather than allocated one by one with new, so that
+ * building the pb trees is mostly a pointer bump, and the pbs of a cluster
+ * are close to each other in memory for the pb walkers.
+ *
+ * Arrays given back to the arena (e.g. by the packer when a molecule does not
+ * fit) are reset and reused by the next allocations of the same size. All the
+ * chunks are released at once when the arena is destroyed. */
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "vtr_memory.h"
+
+class t_pb;
+
+class PbArena {
+  public:
+    PbArena() = default;
+    ~PbArena();
+
+    //No copy, the pbs are owned by the arena
+    PbArena(const PbArena&) = delete;
+    PbArena& operator=(const PbArena&) = delete;
+
+    //Returns an array of num_pbs default constructed pbs
+    t_pb* alloc_pbs(int num_pbs);
+
+    //Returns an array of num_arrays null pointers, e.g. to the arrays of pbs
+    //of each child type of a mode
+    t_pb** alloc_pb_arrays(int num_arrays);
+
+    //Give back arrays allocated by the arena, the pbs are reset
+    void free_pbs(t_pb* pbs, int num_pbs);
+    void free_pb_arrays(t_pb** arrays, int num_arrays);
+
+  private:
+    vtr::t_chunk chunk_;
+
+    //All the arrays of pbs, whose pbs are destroyed with the arena
+    std::vector<std::pair<t_pb*, int>> pb_blocks_;
+
+    //Arrays given back, by size
+    std::unordered_map<int, std::vector<t_pb*>> free_pbs_;
+    std::unordered_map<int, std::vector<t_pb**>> free_pb_arrays_;
+};
+
+#endif
@@ -14,6 +14,7 @@
 #include "physical_types.h"
 #include "globals.h"
 #include "vpr_utils.h"
+#include "pb_arena.h"
 #include "cluster_placement.h"
 #include "place_macro.h"
 #include "string.h"
@@ -1390,6 +1391,57 @@ int num_ext_inputs_atom_block(AtomBlockId blk_id) {
     return (ext_inps);
 }
 
+/* Allocates the arrays of children of a pb for the given mode, from the arena
+ * of the pb if any. The children are default constructed, except for their
+ * arena which is the one of the pb */
+void alloc_child_pbs(t_pb* pb, const t_mode& mode) {
+    VTR_ASSERT(pb->child_pbs == nullptr);
+
+    if (pb->child_pbs_arena) {
+        pb->child_pbs = pb->child_pbs_arena->alloc_pb_arrays(mode.num_pb_type_children);
+    } else {
+        pb->child_pbs = new t_pb*[mode.num_pb_type_children];
+    }
+    for (int i = 0; i < mode.num_pb_type_children; i++) {
+        if (pb->child_pbs_arena) {
+            pb->child_pbs[i] = pb->child_pbs_arena->alloc_pbs(mode.pb_type_children[i].num_pb);
+        } else {
+            pb->child_pbs[i] = new t_pb[mode.pb_type_children[i].num_pb];
+        }
+        for (int j = 0; j < mode.pb_type_children[i].num_pb; j++) {
+            pb->child_pbs[i][j].child_pbs_arena = pb->child_pbs_arena;
+        }
+    }
+}
+
+/* Frees the arrays of children of a pb allocated by alloc_child_pbs() for the
+ * given mode. The children should already be freed with free_pb() if needed */
+void free_child_pbs(t_pb* pb, const t_mode& mode) {
+    if (pb->child_pbs == nullptr) {
+        return;
+    }
+
+    for (int i = 0; i < mode.num_pb_type_children; i++) {
+        if (pb->child_pbs[i] == nullptr) {
+            continue;
+        }
+        //Free children (num_pb)
+        if (pb->child_pbs_arena) {
+            pb->child_pbs_arena->free_pbs(pb->child_pbs[i], mode.pb_type_children[i].num_pb);
+        } else {
+            delete[] pb->child_pbs[i];
+        }
+    }
+
+    //Free child pointers (modes)
+    if (pb->child_pbs_arena) {
+        pb->child_pbs_arena->free_pb_arrays(pb->child_pbs, mode.num_pb_type_children);
+    } else {
+        delete[] pb->child_pbs;
+    }
+    pb->child_pbs = nullptr;
+}
+
 void free_pb(t_pb* pb) {
     if (pb == nullptr) {
         return;
@@ -1413,17 +1465,8 @@ void free_pb(t_pb* pb) {
                     free_pb(&pb->child_pbs[i][j]);
                 }
             }
-            if (pb->child_pbs[i]) {
-                //Free children (num_pb)
-                delete[] pb->child_pbs[i];
-            }
-        }
-        if (pb->child_pbs) {
-            //Free child pointers (modes)
-            delete[] pb->child_pbs;
         }
-
-        pb->child_pbs = nullptr;
+        free_child_pbs(pb, pb_type->modes[mode]);
 
     } else {
         /* Primitive */
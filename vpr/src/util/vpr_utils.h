@@ -143,6 +143,8 @@ void parse_direct_pin_name(char* src_string, int line, int* start_pin_index, int
 
 void free_pb_stats(t_pb* pb);
 void free_pb(t_pb* pb);
+void alloc_child_pbs(t_pb* pb, const t_mode& mode);
+void free_child_pbs(t_pb* pb, const t_mode& mode);
 void revalid_molecules(const t_pb* pb, const std::multimap<AtomBlockId, t_pack_molecule*>& atom_molecules);
 
 void print_switch_usage();
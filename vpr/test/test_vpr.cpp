@@ -141,7 +141,7 @@ TEST_CASE("read_rr_graph_metadata", "[vpr]") {
         vpr::add_rr_node_metadata(src_inode, "node", "test node");
         vpr::add_rr_edge_metadata(src_inode, sink_inode, switch_id, "edge", "test edge");
 
-        write_rr_graph(kRrGraphFile, vpr_setup.Segments);
+        write_rr_graph(kRrGraphFile, vpr_setup.Segments, 1);
         vpr_free_all(arch, vpr_setup);
     }
 